@@ -133,6 +133,9 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
 
         // Hook up a timer to send this child's status to the Monitor once per second
         setUpStatusToMonitor();
+
+        // and tell the monitor as soon as the event loop runs, so that it stops starting others in this child's place
+        QMetaObject::invokeMethod(this, "sendStatusPacketToACM", Qt::QueuedConnection);
     }
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::CreateAssignment, this, "handleCreateAssignmentPacket");
@@ -180,7 +183,8 @@ void AssignmentClient::aboutToQuit() {
 
     DependencyManager::destroy<ScriptEngines>();
 
-    // clear the log handler so that Qt doesn't call the destructor on LogHandler
+    // write out what is still queued, then clear the log handler so that Qt doesn't call the destructor on LogHandler
+    LogHandler::getInstance().setShouldLogAsynchronously(false);
     qInstallMessageHandler(0);
 }
 
@@ -200,10 +204,17 @@ void AssignmentClient::sendStatusPacketToACM() {
         assignmentType = _currentAssignment->getType();
     }
 
-    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus, sizeof(assignmentType) + NUM_BYTES_RFC4122_UUID);
+    // a child is ready for an assignment once it knows where to ask for one
+    qint64 processID = QCoreApplication::applicationPid();
+    quint8 isReady = !_currentAssignment && !_assignmentServerSocket.getAddress().isNull();
+
+    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus,
+                                         NUM_BYTES_RFC4122_UUID + sizeof(assignmentType) + sizeof(processID) + sizeof(isReady));
 
     statusPacket->write(_childAssignmentUUID.toRfc4122());
     statusPacket->writePrimitive(assignmentType);
+    statusPacket->writePrimitive(processID);
+    statusPacket->writePrimitive(isReady);
     
     nodeList->sendPacket(std::move(statusPacket), _assignmentClientMonitorSocket);
 }
@@ -249,6 +260,11 @@ void AssignmentClient::handleCreateAssignmentPacket(QSharedPointer<ReceivedMessa
         qDebug(assigmnentclient) << "Received an assignment -" << *_currentAssignment;
         _isAssigned = true;
 
+        // the monitor starts another spare to take this child's place right away
+        if (!_assignmentClientMonitorSocket.isNull()) {
+            sendStatusPacketToACM();
+        }
+
         auto nodeList = DependencyManager::get<NodeList>();
 
         // switch our DomainHandler hostname and port to whoever sent us the assignment
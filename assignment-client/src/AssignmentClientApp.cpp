@@ -45,8 +45,9 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     setApplicationName("assignment-client");
     setApplicationVersion(BuildInfo::VERSION);
 
-    // use the verbose message handler in Logging
+    // use the verbose message handler in Logging, written from the log thread so logging never holds up a mixer frame
     qInstallMessageHandler(LogHandler::verboseMessageHandler);
+    LogHandler::getInstance().setShouldLogAsynchronously(true);
 
     // parse command-line
     QCommandLineParser parser;
@@ -87,6 +88,11 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     const QCommandLineOption maxChildsOption(ASSIGNMENT_MAX_FORKS_OPTION, "maximum number of children", "child-count");
     parser.addOption(maxChildsOption);
 
+    const QCommandLineOption sparesOption(ASSIGNMENT_NUM_SPARES_OPTION,
+                                          "number of idle children to keep started and ready for an assignment (default 1)",
+                                          "child-count");
+    parser.addOption(sparesOption);
+
     const QCommandLineOption monitorPortOption(ASSIGNMENT_CLIENT_MONITOR_PORT_OPTION, "assignment-client monitor port", "port");
     parser.addOption(monitorPortOption);
 
@@ -124,6 +130,11 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
         maxForks = parser.value(maxChildsOption).toInt();
     }
 
+    unsigned int numSpares = 1;
+    if (parser.isSet(sparesOption)) {
+        numSpares = parser.value(sparesOption).toInt();
+    }
+
     unsigned short monitorPort = 0;
     if (parser.isSet(monitorPortOption)) {
         monitorPort = parser.value(monitorPortOption).toUShort();
@@ -212,8 +223,8 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
 
     DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
 
-    if (numForks || minForks || maxForks) {
-        AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks,
+    if (numForks || minForks || maxForks || parser.isSet(sparesOption)) {
+        AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks, numSpares,
                                                                         requestAssignmentType, assignmentPool,
                                                                         listenPort, walletUUID, assignmentServerHostname,
                                                                         assignmentServerPort, httpStatusPort, logDirectory);
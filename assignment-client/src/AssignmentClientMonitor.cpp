@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <memory>
 #include <signal.h>
 
@@ -17,6 +18,7 @@
 
 #include <AddressManager.h>
 #include <LogHandler.h>
+#include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 
 #include "AssignmentClientMonitor.h"
@@ -28,9 +30,13 @@
 const QString ASSIGNMENT_CLIENT_MONITOR_TARGET_NAME = "assignment-client-monitor";
 const int WAIT_FOR_CHILD_MSECS = 1000;
 
+// a child that hasn't said it is ready by then counts as a spare if it is talking to us at all, as ready as it will get
+const quint64 CHILD_STARTUP_TIMEOUT_USECS = 30 * USECS_PER_SECOND;
+
 AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmentClientForks,
                                                  const unsigned int minAssignmentClientForks,
                                                  const unsigned int maxAssignmentClientForks,
+                                                 const unsigned int numSpares,
                                                  Assignment::Type requestAssignmentType, QString assignmentPool,
                                                  quint16 listenPort, QUuid walletUUID, QString assignmentServerHostname,
                                                  quint16 assignmentServerPort, quint16 httpStatusServerPort, QString logDirectory) :
@@ -38,6 +44,7 @@ AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmen
     _numAssignmentClientForks(numAssignmentClientForks),
     _minAssignmentClientForks(minAssignmentClientForks),
     _maxAssignmentClientForks(maxAssignmentClientForks),
+    _numSpares(numSpares),
     _requestAssignmentType(requestAssignmentType),
     _assignmentPool(assignmentPool),
     _walletUUID(walletUUID),
@@ -66,8 +73,12 @@ AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmen
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AssignmentClientStatus, this, "handleChildStatusPacket");
 
-    // use QProcess to fork off a process for each of the child assignment clients
-    for (unsigned int i = 0; i < _numAssignmentClientForks; i++) {
+    // use QProcess to fork off a process for each of the child assignment clients, with at least the spares to start
+    unsigned int numInitialForks = std::max(_numAssignmentClientForks, _numSpares);
+    if (_maxAssignmentClientForks) {
+        numInitialForks = std::min(numInitialForks, _maxAssignmentClientForks);
+    }
+    for (unsigned int i = 0; i < numInitialForks; i++) {
         spawnChildClient();
     }
 
@@ -127,7 +138,8 @@ void AssignmentClientMonitor::stopChildProcesses() {
 void AssignmentClientMonitor::aboutToQuit() {
     stopChildProcesses();
 
-    // clear the log handler so that Qt doesn't call the destructor on LogHandler
+    // write out what is still queued, then clear the log handler so that Qt doesn't call the destructor on LogHandler
+    LogHandler::getInstance().setShouldLogAsynchronously(false);
     qInstallMessageHandler(0);
 }
 
@@ -226,7 +238,13 @@ void AssignmentClientMonitor::spawnChildClient() {
 
         qDebug() << "Spawned a child client with PID" << assignmentClient->processId();
 
-        _childProcesses.insert(assignmentClient->processId(), { assignmentClient, stdoutPath, stderrPath });
+        ACProcess child;
+        child.process = assignmentClient;
+        child.logStdoutPath = stdoutPath;
+        child.logStderrPath = stderrPath;
+        child.state = ACProcess::Starting;
+        child.spawnTime = usecTimestampNow();
+        _childProcesses.insert(pid, child);
     }
 }
 
@@ -234,36 +252,49 @@ void AssignmentClientMonitor::checkSpares() {
     auto nodeList = DependencyManager::get<NodeList>();
     QUuid aSpareId = "";
     unsigned int spareCount = 0;
-    unsigned int totalCount = 0;
+    unsigned int startingCount = 0;
+    unsigned int totalCount = _childProcesses.size();
 
     nodeList->removeSilentNodes();
 
-    nodeList->eachNode([&](const SharedNodePointer& node) {
-        AssignmentClientChildData* childData = static_cast<AssignmentClientChildData*>(node->getLinkedData());
-        totalCount ++;
-        if (childData->getChildType() == Assignment::Type::AllTypes) {
-            ++spareCount;
-            aSpareId = node->getUUID();
+    quint64 now = usecTimestampNow();
+    for (auto& child : _childProcesses) {
+        bool isStarting = child.state == ACProcess::Starting && now - child.spawnTime < CHILD_STARTUP_TIMEOUT_USECS;
+        if (isStarting) {
+            // on its way to being a spare, don't start another for it
+            ++startingCount;
+        } else if (child.state != ACProcess::Assigned && !child.nodeID.isNull()) {
+            // a spare that went silent can't take an assignment anymore
+            if (nodeList->nodeWithUUID(child.nodeID)) {
+                ++spareCount;
+                aSpareId = child.nodeID;
+            }
         }
-    });
+    }
 
     // Spawn or kill children, as needed.  If --min or --max weren't specified, allow the child count
     // to drift up or down as far as needed.
-    if (spareCount < 1 || totalCount < _minAssignmentClientForks) {
-        if (!_maxAssignmentClientForks || totalCount < _maxAssignmentClientForks) {
-            spawnChildClient();
+    unsigned int comingSpares = spareCount + startingCount;
+    while (comingSpares < _numSpares || totalCount < _minAssignmentClientForks) {
+        if (_maxAssignmentClientForks && totalCount >= _maxAssignmentClientForks) {
+            break;
         }
+        spawnChildClient();
+        ++comingSpares;
+        ++totalCount;
     }
 
-    if (spareCount > 1) {
+    if (spareCount > _numSpares) {
         if (!_minAssignmentClientForks || totalCount > _minAssignmentClientForks) {
             // kill aSpareId
             qDebug() << "asking child" << aSpareId << "to exit.";
             SharedNodePointer childNode = nodeList->nodeWithUUID(aSpareId);
-            childNode->activateLocalSocket();
+            if (childNode) {
+                childNode->activateLocalSocket();
 
-            auto diePacket = NLPacket::create(PacketType::StopNode, 0);
-            nodeList->sendPacket(std::move(diePacket), *childNode);
+                auto diePacket = NLPacket::create(PacketType::StopNode, 0);
+                nodeList->sendPacket(std::move(diePacket), *childNode);
+            }
         }
     }
 }
@@ -289,9 +320,10 @@ void AssignmentClientMonitor::handleChildStatusPacket(QSharedPointer<ReceivedMes
                 matchingNode = DependencyManager::get<LimitedNodeList>()->addOrUpdateNode(senderID, NodeType::Unassigned,
                                                                                           senderSockAddr, senderSockAddr);
 
-                auto childData = std::unique_ptr<AssignmentClientChildData>
+                auto newChildData = std::unique_ptr<AssignmentClientChildData>
                     { new AssignmentClientChildData(Assignment::Type::AllTypes) };
-                matchingNode->setLinkedData(std::move(childData));
+                childData = newChildData.get();
+                matchingNode->setLinkedData(std::move(newChildData));
             } else {
                 // tell unknown assignment-client child to exit.
                 qDebug() << "Asking unknown child at" << senderSockAddr << "to exit.";
@@ -318,6 +350,31 @@ void AssignmentClientMonitor::handleChildStatusPacket(QSharedPointer<ReceivedMes
 
         // note when this child talked
         matchingNode->setLastHeardMicrostamp(usecTimestampNow());
+
+        // which of our processes this is, and whether it is ready for an assignment
+        qint64 processID = 0;
+        quint8 isReady = 0;
+        if (message->getBytesLeftToRead() >= (qint64) (sizeof(processID) + sizeof(isReady))) {
+            message->readPrimitive(&processID);
+            message->readPrimitive(&isReady);
+        }
+
+        auto child = _childProcesses.find(processID);
+        if (child != _childProcesses.end()) {
+            auto previousState = child->state;
+
+            child->nodeID = senderID;
+            if (assignmentType != Assignment::Type::AllTypes) {
+                child->state = ACProcess::Assigned;
+            } else if (isReady) {
+                child->state = ACProcess::Ready;
+            }
+
+            if (previousState != ACProcess::Assigned && child->state == ACProcess::Assigned) {
+                // a spare was taken, start the one that replaces it now rather than at the next check
+                QMetaObject::invokeMethod(this, "checkSpares", Qt::QueuedConnection);
+            }
+        }
     }
 }
 
@@ -330,7 +387,10 @@ bool AssignmentClientMonitor::handleHTTPRequest(HTTPConnection* connection, cons
         for (auto& ac : _childProcesses) {
             QJsonObject server;
 
+            static const char* STATE_NAMES[] = { "starting", "ready", "assigned" };
+
             server["pid"] = ac.process->processId();
+            server["state"] = STATE_NAMES[ac.state];
             server["logStdout"] = ac.logStdoutPath;
             server["logStderr"] = ac.logStderrPath;
 
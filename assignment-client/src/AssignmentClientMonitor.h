@@ -27,16 +27,26 @@
 extern const char* NUM_FORKS_PARAMETER;
 
 struct ACProcess {
+    enum State {
+        Starting, // spawned, but not ready to take an assignment yet
+        Ready, // idle and asking for an assignment, a warm spare
+        Assigned
+    };
+
     QProcess* process; // looks like a dangling pointer, but is parented by the AssignmentClientMonitor 
     QString logStdoutPath;
     QString logStderrPath;
+    State state;
+    quint64 spawnTime; // usecs
+    QUuid nodeID; // of the child's status packets, once it has sent one
 };
 
 class AssignmentClientMonitor : public QObject, public HTTPRequestHandler {
     Q_OBJECT
 public:
     AssignmentClientMonitor(const unsigned int numAssignmentClientForks, const unsigned int minAssignmentClientForks,
-                            const unsigned int maxAssignmentClientForks, Assignment::Type requestAssignmentType,
+                            const unsigned int maxAssignmentClientForks, const unsigned int numSpares,
+                            Assignment::Type requestAssignmentType,
                             QString assignmentPool, quint16 listenPort, QUuid walletUUID, QString assignmentServerHostname,
                             quint16 assignmentServerPort, quint16 httpStatusServerPort, QString logDirectory);
     ~AssignmentClientMonitor();
@@ -65,6 +75,7 @@ private:
     const unsigned int _numAssignmentClientForks;
     const unsigned int _minAssignmentClientForks;
     const unsigned int _maxAssignmentClientForks;
+    const unsigned int _numSpares; // the children kept started and ready for an assignment
 
     Assignment::Type _requestAssignmentType;
     QString _assignmentPool;
@@ -0,0 +1,246 @@
+//
+//  AssetMappingStore.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetMappingStore.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+static const QString REMOVED_KEY = "removed";
+static const QString SET_KEY = "set";
+
+// the journal is not compacted before it has at least this many entries, however few the mappings
+static const size_t MIN_ENTRIES_TO_COMPACT = 1000;
+
+static QByteArray changeToJournalEntry(const AssetMappingStore::Change& change) {
+    QJsonObject set;
+    for (const auto& mapping : change.set) {
+        set.insert(mapping.first, mapping.second);
+    }
+
+    QJsonObject entry;
+    entry[REMOVED_KEY] = QJsonArray::fromStringList(change.removed);
+    entry[SET_KEY] = set;
+
+    return QJsonDocument(entry).toJson(QJsonDocument::Compact) + '\n';
+}
+
+static AssetMappingStore::Change changeFromJournalEntry(const QJsonObject& entry) {
+    AssetMappingStore::Change change;
+
+    for (const auto& path : entry[REMOVED_KEY].toArray()) {
+        change.removed << path.toString();
+    }
+
+    auto set = entry[SET_KEY].toObject();
+    for (auto it = set.constBegin(); it != set.constEnd(); ++it) {
+        change.set[it.key()] = it.value().toString();
+    }
+
+    return change;
+}
+
+bool AssetMappingStore::load(const QString& snapshotPath, const QString& journalPath) {
+    _snapshotPath = snapshotPath;
+    _journal.setFileName(journalPath);
+
+    if (!loadSnapshot() || !replayJournal()) {
+        return false;
+    }
+
+    if (!_journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCritical() << "Failed to open mapping journal at" << journalPath;
+        return false;
+    }
+
+    // start from a snapshot of everything, a journal cut short by a crash is never appended to
+    if (_numJournalEntries > 0 && !compact()) {
+        return false;
+    }
+
+    qInfo() << "Loaded" << _mappings.size() << "mappings from map file at" << _snapshotPath;
+    return true;
+}
+
+bool AssetMappingStore::loadSnapshot() {
+    QFile mapFile { _snapshotPath };
+    if (!mapFile.exists()) {
+        qInfo() << "No existing mappings loaded from file since no file was found at" << _snapshotPath;
+        return true;
+    }
+
+    if (mapFile.open(QIODevice::ReadOnly)) {
+        QJsonParseError error;
+
+        auto jsonDocument = QJsonDocument::fromJson(mapFile.readAll(), &error);
+
+        if (error.error == QJsonParseError::NoError) {
+            auto jsonObject = jsonDocument.object();
+
+            Change change;
+            for (auto it = jsonObject.constBegin(); it != jsonObject.constEnd(); ++it) {
+                // drop any mappings that don't match the expected format
+                if (!isValidPath(it.key())) {
+                    qWarning() << "Will not keep mapping for" << it.key() << "since it is not a valid path.";
+                } else if (!isValidHash(it.value().toString())) {
+                    qWarning() << "Will not keep mapping for" << it.key() << "since it does not have a valid hash.";
+                } else {
+                    change.set[it.key()] = it.value().toString();
+                }
+            }
+
+            apply(change, nullptr);
+            return true;
+        }
+    }
+
+    qCritical() << "Failed to read mapping file at" << _snapshotPath;
+    return false;
+}
+
+bool AssetMappingStore::replayJournal() {
+    if (!_journal.exists()) {
+        return true;
+    }
+
+    if (!_journal.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to read mapping journal at" << _journal.fileName();
+        return false;
+    }
+
+    while (!_journal.atEnd()) {
+        auto line = _journal.readLine();
+
+        QJsonParseError error;
+        auto entry = QJsonDocument::fromJson(line, &error);
+
+        if (error.error != QJsonParseError::NoError || !line.endsWith('\n')) {
+            // only the last entry can be cut short, it was never applied
+            qWarning() << "Dropping an incomplete entry at the end of the mapping journal at" << _journal.fileName();
+            break;
+        }
+
+        apply(changeFromJournalEntry(entry.object()), nullptr);
+        ++_numJournalEntries;
+    }
+
+    _journal.close();
+    return true;
+}
+
+bool AssetMappingStore::compact() {
+    QJsonObject jsonObject;
+    for (const auto& mapping : _mappings) {
+        jsonObject.insert(mapping.first, mapping.second);
+    }
+
+    // the snapshot is replaced whole, a crash leaves either the old one or the new one
+    QSaveFile mapFile { _snapshotPath };
+    if (!mapFile.open(QIODevice::WriteOnly) || mapFile.write(QJsonDocument(jsonObject).toJson()) == -1
+        || !mapFile.commit()) {
+        qWarning() << "Failed to write JSON mappings to file at" << _snapshotPath;
+        return false;
+    }
+
+    // the journal entries are all in the snapshot now, they'd give the same mappings if they were replayed over it
+    if (!_journal.resize(0)) {
+        qWarning() << "Failed to empty mapping journal at" << _journal.fileName();
+        return false;
+    }
+    _numJournalEntries = 0;
+
+    qDebug() << "Wrote JSON mappings to file at" << _snapshotPath;
+    return true;
+}
+
+AssetHash AssetMappingStore::getMapping(const AssetPath& path) const {
+    auto it = _mappings.find(path);
+    return it != _mappings.end() ? it->second : AssetHash();
+}
+
+AssetMappingStore::Range AssetMappingStore::getFolder(const AssetPath& folder) const {
+    auto begin = _mappings.lower_bound(folder);
+    auto end = begin;
+    while (end != _mappings.end() && end->first.startsWith(folder)) {
+        ++end;
+    }
+    return { begin, end };
+}
+
+bool AssetMappingStore::commit(const Change& change, QSet<AssetHash>* unmappedHashes) {
+    if (change.isEmpty()) {
+        return true;
+    }
+
+    if (!_journal.isOpen()) {
+        qWarning() << "Cannot persist a mapping change without a mapping journal";
+        return false;
+    }
+
+    auto entry = changeToJournalEntry(change);
+    auto journalSize = _journal.size();
+
+    if (_journal.write(entry) != entry.size() || !_journal.flush()) {
+        qWarning() << "Failed to append to mapping journal at" << _journal.fileName();
+
+        // the next entry can't follow a partial one
+        _journal.resize(journalSize);
+        return false;
+    }
+
+    apply(change, unmappedHashes);
+    ++_numJournalEntries;
+
+    // a snapshot costs as much as the entries it replaces, written this rarely it costs each change a constant time
+    if (_numJournalEntries >= std::max(MIN_ENTRIES_TO_COMPACT, _mappings.size())) {
+        compact();
+    }
+
+    return true;
+}
+
+void AssetMappingStore::apply(const Change& change, QSet<AssetHash>* unmappedHashes) {
+    auto removeUse = [&](const AssetHash& hash) {
+        auto it = _hashUses.find(hash);
+        if (it != _hashUses.end() && --it.value() == 0) {
+            _hashUses.erase(it);
+            if (unmappedHashes) {
+                *unmappedHashes << hash;
+            }
+        }
+    };
+
+    for (const auto& path : change.removed) {
+        auto it = _mappings.find(path);
+        if (it != _mappings.end()) {
+            removeUse(it->second);
+            _mappings.erase(it);
+        }
+    }
+
+    for (const auto& mapping : change.set) {
+        auto& hash = _mappings[mapping.first];
+        if (!hash.isEmpty()) {
+            removeUse(hash);
+        }
+        hash = mapping.second;
+        ++_hashUses[hash];
+
+        if (unmappedHashes) {
+            unmappedHashes->remove(hash);
+        }
+    }
+}
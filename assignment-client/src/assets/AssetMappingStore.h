@@ -0,0 +1,78 @@
+//
+//  AssetMappingStore.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AssetMappingStore_h
+#define hifi_AssetMappingStore_h
+
+#include <utility>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+
+#include <AssetUtils.h>
+
+// The mappings of the asset server, sorted by path so the mappings of a folder are next to each other, and persisted as
+// a snapshot (the map file) and a journal of the changes made since it was written. A change costs one line appended to
+// the journal, the snapshot is only written again once the journal has grown as long as the mappings.
+//
+// The journal holds the paths each change removed and the mappings it set rather than the operation that made it, so
+// replaying it over a snapshot that already has some of it gives the same mappings.
+class AssetMappingStore {
+public:
+    // The changes of one operation, persisted and applied all together or not at all.
+    // The paths are removed before the mappings are set.
+    struct Change {
+        AssetPathList removed;
+        AssetMapping set;
+
+        bool isEmpty() const { return removed.isEmpty() && set.empty(); }
+    };
+
+    using Range = std::pair<AssetMapping::const_iterator, AssetMapping::const_iterator>;
+
+    // Loads the snapshot and replays the journal over it, false if either can't be read
+    bool load(const QString& snapshotPath, const QString& journalPath);
+
+    const AssetMapping& getMappings() const { return _mappings; }
+    size_t size() const { return _mappings.size(); }
+
+    // empty if the path has no mapping
+    AssetHash getMapping(const AssetPath& path) const;
+    // the mappings of the paths in the folder, in order
+    Range getFolder(const AssetPath& folder) const;
+
+    bool isMapped(const AssetHash& hash) const { return _hashUses.contains(hash); }
+
+    // Persists the change then applies it, false and nothing changed if it could not be persisted.
+    // The hashes no mapping uses anymore after it are added to unmappedHashes.
+    bool commit(const Change& change, QSet<AssetHash>* unmappedHashes = nullptr);
+
+private:
+    void apply(const Change& change, QSet<AssetHash>* unmappedHashes);
+
+    bool loadSnapshot();
+    bool replayJournal();
+    // writes the snapshot of the mappings and empties the journal
+    bool compact();
+
+    AssetMapping _mappings;
+    // the number of mappings to each hash
+    QHash<AssetHash, int> _hashUses;
+
+    QString _snapshotPath;
+    QFile _journal;
+    size_t _numJournalEntries { 0 };
+};
+
+#endif // hifi_AssetMappingStore_h
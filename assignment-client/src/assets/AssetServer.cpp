@@ -26,13 +26,17 @@
 #include "NetworkLogging.h"
 #include "NodeType.h"
 #include "SendAssetTask.h"
+#include "UploadAssetStream.h"
 #include "UploadAssetTask.h"
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
-    _taskPool(this)
+    _taskPool(this),
+    _getRequestsMetric(Metrics::counter("hifi_asset_server_get_requests_total", "Requests for the data of an asset")),
+    _uploadRequestsMetric(Metrics::counter("hifi_asset_server_upload_requests_total", "Uploads of an asset")),
+    _activeTasksMetric(Metrics::gauge("hifi_asset_server_active_tasks", "Transfers being read or written"))
 {
 
     // Most of the work will be I/O bound, reading from disk and constructing packet objects,
@@ -43,7 +47,8 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AssetGet, this, "handleAssetGet");
     packetReceiver.registerListener(PacketType::AssetGetInfo, this, "handleAssetGetInfo");
-    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload");
+    // uploads are delivered from their first packet, the ones of many packets are written out as they arrive
+    packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload", true);
     packetReceiver.registerListener(PacketType::AssetMappingOperation, this, "handleAssetMappingOperation");
 }
 
@@ -89,6 +94,20 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    static const QString BATCHED_SEND_OPTION = "batched_send";
+    if (assetServerObject[BATCHED_SEND_OPTION].toBool(false)) {
+        nodeList->setBatchedSendEnabled(true);
+        qInfo() << "Batched sends enabled for asset-server connections.";
+    }
+
+    static const QString CONGESTION_CONTROL_OPTION = "congestion_control";
+    static const QString BBR_CONGESTION_CONTROL = "bbr";
+    if (assetServerObject[CONGESTION_CONTROL_OPTION].toString() == BBR_CONGESTION_CONTROL) {
+        nodeList->setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::BBRCC>()));
+        qInfo() << "Using BBR congestion control for asset-server connections.";
+    }
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -133,7 +152,7 @@ void AssetServer::completeSetup() {
 
         qInfo() << "There are" << hashedFiles.size() << "asset files in the asset directory.";
 
-        if (_fileMappings.count() > 0) {
+        if (_fileMappings.size() > 0) {
             cleanupUnmappedFiles();
         }
 
@@ -150,15 +169,13 @@ void AssetServer::cleanupUnmappedFiles() {
 
     auto files = _filesDirectory.entryInfoList(QDir::Files);
 
-    // grab the currently mapped hashes
-    auto mappedHashes = _fileMappings.values();
-
     qInfo() << "Performing unmapped asset cleanup.";
 
     for (const auto& fileInfo : files) {
         if (hashFileRegex.exactMatch(fileInfo.fileName())) {
-            if (!mappedHashes.contains(fileInfo.fileName())) {
+            if (!_fileMappings.isMapped(fileInfo.fileName())) {
                 // remove the unmapped file
+                _mappedAssets.remove(fileInfo.absoluteFilePath());
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
@@ -211,9 +228,8 @@ void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> me
 void AssetServer::handleGetMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket) {
     QString assetPath = message.readString();
 
-    auto it = _fileMappings.find(assetPath);
-    if (it != _fileMappings.end()) {
-        auto assetHash = it->toString();
+    auto assetHash = _fileMappings.getMapping(assetPath);
+    if (!assetHash.isEmpty()) {
         replyPacket.writePrimitive(AssetServerError::NoError);
         replyPacket.write(QByteArray::fromHex(assetHash.toUtf8()));
     } else {
@@ -224,13 +240,13 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, SharedNode
 void AssetServer::handleGetAllMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket) {
     replyPacket.writePrimitive(AssetServerError::NoError);
 
-    auto count = _fileMappings.size();
+    int count = (int) _fileMappings.size();
 
     replyPacket.writePrimitive(count);
 
-    for (auto it = _fileMappings.cbegin(); it != _fileMappings.cend(); ++ it) {
-        replyPacket.writeString(it.key());
-        replyPacket.write(QByteArray::fromHex(it.value().toString().toUtf8()));
+    for (const auto& mapping : _fileMappings.getMappings()) {
+        replyPacket.writeString(mapping.first);
+        replyPacket.write(QByteArray::fromHex(mapping.second.toUtf8()));
     }
 }
 
@@ -331,18 +347,29 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
         return;
     }
 
+    _getRequestsMetric.add();
+
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _mappedAssets);
     _taskPool.start(task);
 }
 
 void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
 
     if (senderNode->getCanWriteToAssetServer()) {
-        qDebug() << "Starting an UploadAssetTask for upload from" << uuidStringWithoutCurlyBraces(senderNode->getUUID());
+        _uploadRequestsMetric.add();
+
+        if (message->isComplete()) {
+            qDebug() << "Starting an UploadAssetTask for upload from" << uuidStringWithoutCurlyBraces(senderNode->getUUID());
+
+            auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _mappedAssets);
+            _taskPool.start(task);
+        } else {
+            qDebug() << "Starting an UploadAssetStream for upload from" << uuidStringWithoutCurlyBraces(senderNode->getUUID());
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory);
-        _taskPool.start(task);
+            auto stream = new UploadAssetStream(message, senderNode, _filesDirectory, _mappedAssets, this);
+            stream->start();
+        }
     } else {
         // this is a node the domain told us is not allowed to rez entities
         // for now this also means it isn't allowed to add assets
@@ -351,7 +378,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
         auto permissionErrorPacket = NLPacket::create(PacketType::AssetUploadReply, sizeof(MessageID) + sizeof(AssetServerError), true);
 
         MessageID messageID;
-        message->readPrimitive(&messageID);
+        message->readHeadPrimitive(&messageID);
 
         // write the message ID and a permission denied error
         permissionErrorPacket->writePrimitive(messageID);
@@ -366,6 +393,8 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
 void AssetServer::sendStatsPacket() {
     QJsonObject serverStats;
 
+    _activeTasksMetric.set(_taskPool.activeThreadCount());
+
     auto stats = DependencyManager::get<NodeList>()->sampleStatsForAllConnections();
 
     for (const auto& stat : stats) {
@@ -386,6 +415,11 @@ void AssetServer::sendStatsPacket() {
         connectionStats["5. Period (us)"] = stat.second.packetSendPeriod;
         connectionStats["6. Up (Mb/s)"] = stat.second.sentBytes * megabitsPerSecPerByte;
         connectionStats["7. Down (Mb/s)"] = stat.second.receivedBytes * megabitsPerSecPerByte;
+        connectionStats["8. Sent Batches"] = stat.second.sentBatches;
+        connectionStats["9. Syscalls Saved"] = stat.second.syscallsSaved;
+        connectionStats["10. Pacing Rate (P/s)"] = stat.second.pacingRate;
+        connectionStats["11. Min RTT (us)"] = stat.second.minRTT;
+        connectionStats["12. Smoothed RTT (us)"] = stat.second.smoothedRTT;
         nodeStats["Connection Stats"] = connectionStats;
 
         using Events = udt::ConnectionStats::Stats::Event;
@@ -433,76 +467,11 @@ void AssetServer::sendStatsPacket() {
 }
 
 static const QString MAP_FILE_NAME = "map.json";
+static const QString MAP_JOURNAL_FILE_NAME = "map.log";
 
 bool AssetServer::loadMappingsFromFile() {
-
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QFile mapFile { mapFilePath };
-    if (mapFile.exists()) {
-        if (mapFile.open(QIODevice::ReadOnly)) {
-            QJsonParseError error;
-
-            auto jsonDocument = QJsonDocument::fromJson(mapFile.readAll(), &error);
-
-            if (error.error == QJsonParseError::NoError) {
-                _fileMappings = jsonDocument.object().toVariantHash();
-
-                // remove any mappings that don't match the expected format
-                auto it = _fileMappings.begin();
-                while (it != _fileMappings.end()) {
-                    bool shouldDrop = false;
-
-                    if (!isValidPath(it.key())) {
-                        qWarning() << "Will not keep mapping for" << it.key() << "since it is not a valid path.";
-                        shouldDrop = true;
-                    }
-
-                    if (!isValidHash(it.value().toString())) {
-                        qWarning() << "Will not keep mapping for" << it.key() << "since it does not have a valid hash.";
-                        shouldDrop = true;
-                    }
-
-                    if (shouldDrop) {
-                        it = _fileMappings.erase(it);
-                    } else {
-                        ++it;
-                    }
-                }
-
-                qInfo() << "Loaded" << _fileMappings.count() << "mappings from map file at" << mapFilePath;
-                return true;
-            }
-        }
-
-        qCritical() << "Failed to read mapping file at" << mapFilePath;
-        return false;
-    } else {
-        qInfo() << "No existing mappings loaded from file since no file was found at" << mapFilePath;
-    }
-
-    return true;
-}
-
-bool AssetServer::writeMappingsToFile() {
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QFile mapFile { mapFilePath };
-    if (mapFile.open(QIODevice::WriteOnly)) {
-        auto jsonObject = QJsonObject::fromVariantHash(_fileMappings);
-        QJsonDocument jsonDocument { jsonObject };
-
-        if (mapFile.write(jsonDocument.toJson()) != -1) {
-            qDebug() << "Wrote JSON mappings to file at" << mapFilePath;
-            return true;
-        } else {
-            qWarning() << "Failed to write JSON mappings to file at" << mapFilePath;
-        }
-    } else {
-        qWarning() << "Failed to open map file at" << mapFilePath;
-    }
-
-    return false;
+    return _fileMappings.load(_resourcesDirectory.absoluteFilePath(MAP_FILE_NAME),
+                              _resourcesDirectory.absoluteFilePath(MAP_JOURNAL_FILE_NAME));
 }
 
 bool AssetServer::setMapping(AssetPath path, AssetHash hash) {
@@ -518,25 +487,14 @@ bool AssetServer::setMapping(AssetPath path, AssetHash hash) {
         return false;
     }
 
-    // remember what the old mapping was in case persistence fails
-    auto oldMapping = _fileMappings.value(path).toString();
-
-    // update the in memory QHash
-    _fileMappings[path] = hash;
+    AssetMappingStore::Change change;
+    change.set[path] = hash;
 
-    // attempt to write to file
-    if (writeMappingsToFile()) {
-        // persistence succeeded, we are good to go
+    // attempt to persist the mapping, it is only set in memory if that succeeds
+    if (_fileMappings.commit(change)) {
         qDebug() << "Set mapping:" << path << "=>" << hash;
         return true;
     } else {
-        // failed to persist this mapping to file - put back the old one in our in-memory representation
-        if (oldMapping.isEmpty()) {
-            _fileMappings.remove(path);
-        } else {
-            _fileMappings[path] = oldMapping;
-        }
-
         qWarning() << "Failed to persist mapping:" << path << "=>" << hash;
 
         return false;
@@ -548,71 +506,51 @@ bool pathIsFolder(const AssetPath& path) {
 }
 
 bool AssetServer::deleteMappings(AssetPathList& paths) {
-    // take a copy of the current mappings in case persistence of these deletes fails
-    auto oldMappings = _fileMappings;
-
-    QSet<QString> hashesToCheckForDeletion;
+    AssetMappingStore::Change change;
 
-    // enumerate the paths to delete and remove them all
+    // enumerate the paths to delete and gather the mappings they remove
     for (auto& path : paths) {
 
         path = path.trimmed();
 
         // figure out if this path will delete a file or folder
         if (pathIsFolder(path)) {
-            // enumerate the in memory file mappings and remove anything that matches
-            auto it = _fileMappings.begin();
-            auto sizeBefore = _fileMappings.size();
+            // the mappings of a folder are next to each other in the sorted mappings
+            auto folder = _fileMappings.getFolder(path);
+            auto sizeBefore = change.removed.size();
 
-            while (it != _fileMappings.end()) {
-                if (it.key().startsWith(path)) {
-                    // add this hash to the list we need to check for asset removal from the server
-                    hashesToCheckForDeletion << it.value().toString();
-
-                    it = _fileMappings.erase(it);
-                } else {
-                    ++it;
-                }
+            for (auto it = folder.first; it != folder.second; ++it) {
+                change.removed << it->first;
             }
 
-            auto sizeNow = _fileMappings.size();
-            if (sizeBefore != sizeNow) {
-                qDebug() << "Deleted" << sizeBefore - sizeNow << "mappings in folder: " << path;
+            auto numDeleted = change.removed.size() - sizeBefore;
+            if (numDeleted > 0) {
+                qDebug() << "Deleted" << numDeleted << "mappings in folder: " << path;
             } else {
                 qDebug() << "Did not find any mappings to delete in folder:" << path;
             }
 
         } else {
-            auto oldMapping = _fileMappings.take(path);
-            if (!oldMapping.isNull()) {
-                // add this hash to the list we need to check for asset removal from server
-                hashesToCheckForDeletion << oldMapping.toString();
+            auto oldMapping = _fileMappings.getMapping(path);
+            if (!oldMapping.isEmpty()) {
+                change.removed << path;
 
-                qDebug() << "Deleted a mapping:" << path << "=>" << oldMapping.toString();
+                qDebug() << "Deleted a mapping:" << path << "=>" << oldMapping;
             } else {
                 qDebug() << "Unable to delete a mapping that was not found:" << path;
             }
         }
     }
 
-    // deleted the old mappings, attempt to persist to file
-    if (writeMappingsToFile()) {
-        // persistence succeeded we are good to go
+    // the hashes no mapping uses once these are deleted, we will delete those asset files
+    QSet<AssetHash> unmappedHashes;
 
-        // grab the current mapped hashes
-        auto mappedHashes = _fileMappings.values();
-
-        // enumerate the mapped hashes and clear the list of hashes to check for anything that's present
-        for (auto& hashVariant : mappedHashes) {
-            auto it = hashesToCheckForDeletion.find(hashVariant.toString());
-            if (it != hashesToCheckForDeletion.end()) {
-                hashesToCheckForDeletion.erase(it);
-            }
-        }
-
-        // we now have a set of hashes that are unmapped - we will delete those asset files
-        for (auto& hash : hashesToCheckForDeletion) {
+    // attempt to persist the deletes, they are only made in memory if that succeeds
+    if (_fileMappings.commit(change, &unmappedHashes)) {
+        // persistence succeeded we are good to go
+        for (auto& hash : unmappedHashes) {
             // remove the unmapped file
+            _mappedAssets.remove(_filesDirectory.absoluteFilePath(hash));
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
@@ -624,10 +562,7 @@ bool AssetServer::deleteMappings(AssetPathList& paths) {
 
         return true;
     } else {
-        qWarning() << "Failed to persist deleted mappings, rolling back";
-
-        // we didn't delete the previous mapping, put it back in our in-memory representation
-        _fileMappings = oldMappings;
+        qWarning() << "Failed to persist deleted mappings";
 
         return false;
     }
@@ -653,34 +588,24 @@ bool AssetServer::renameMapping(AssetPath oldPath, AssetPath newPath) {
             return false;
         }
 
-        // take a copy of the old mappings
-        auto oldMappings = _fileMappings;
+        // the mappings of the folder are moved all together, they are next to each other in the sorted mappings
+        AssetMappingStore::Change change;
+        auto folder = _fileMappings.getFolder(oldPath);
 
-        // iterate the current mappings and adjust any that matches the renamed folder
-        auto it = oldMappings.begin();
+        for (auto it = folder.first; it != folder.second; ++it) {
+            auto newKey = it->first;
+            newKey.replace(0, oldPath.size(), newPath);
 
-        while (it != oldMappings.end()) {
-            if (it.key().startsWith(oldPath)) {
-                auto newKey = it.key();
-                newKey.replace(0, oldPath.size(), newPath);
-
-                // remove the old version from the in memory file mappings
-                _fileMappings.remove(it.key());
-                _fileMappings.insert(newKey, it.value());
-            }
-
-            ++it;
+            change.removed << it->first;
+            change.set[newKey] = it->second;
         }
 
-        if (writeMappingsToFile()) {
+        if (_fileMappings.commit(change)) {
             // persisted the changed mappings, return success
             qDebug() << "Renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return true;
         } else {
-            // couldn't persist the renamed paths, rollback and return failure
-            _fileMappings = oldMappings;
-
             qWarning() << "Failed to persist renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return false;
@@ -693,32 +618,20 @@ bool AssetServer::renameMapping(AssetPath oldPath, AssetPath newPath) {
             return false;
         }
 
-        // take the old hash to remove the old mapping
-        auto oldSourceMapping = _fileMappings.take(oldPath).toString();
-
-        // in case we're overwriting, keep the current destination mapping for potential rollback
-        auto oldDestinationMapping = _fileMappings.value(newPath);
+        auto oldSourceMapping = _fileMappings.getMapping(oldPath);
 
         if (!oldSourceMapping.isEmpty()) {
-            _fileMappings[newPath] = oldSourceMapping;
+            // this overwrites the current destination mapping if there is one
+            AssetMappingStore::Change change;
+            change.removed << oldPath;
+            change.set[newPath] = oldSourceMapping;
 
-            if (writeMappingsToFile()) {
+            if (_fileMappings.commit(change)) {
                 // persisted the renamed mapping, return success
                 qDebug() << "Renamed mapping:" << oldPath << "=>" << newPath;
 
                 return true;
             } else {
-                // we couldn't persist the renamed mapping, rollback and return failure
-                _fileMappings[oldPath] = oldSourceMapping;
-
-                if (!oldDestinationMapping.isNull()) {
-                    // put back the overwritten mapping for the destination path
-                    _fileMappings[newPath] = oldDestinationMapping.toString();
-                } else {
-                    // clear the new mapping
-                    _fileMappings.remove(newPath);
-                }
-
                 qDebug() << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
 
                 return false;
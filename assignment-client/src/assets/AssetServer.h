@@ -15,9 +15,12 @@
 #include <QtCore/QDir>
 #include <QtCore/QThreadPool>
 
+#include <Metrics.h>
 #include <ThreadedAssignment.h>
 
+#include "AssetMappingStore.h"
 #include "AssetUtils.h"
+#include "MappedAssetCache.h"
 #include "ReceivedMessage.h"
 
 class AssetServer : public ThreadedAssignment {
@@ -39,8 +42,6 @@ private slots:
     void sendStatsPacket() override;
 
 private:
-    using Mappings = QVariantHash;
-
     void handleGetMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
     void handleGetAllMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
     void handleSetMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
@@ -49,7 +50,6 @@ private:
 
     // Mapping file operations must be called from main assignment thread only
     bool loadMappingsFromFile();
-    bool writeMappingsToFile();
 
     /// Set the mapping for path to hash
     bool setMapping(AssetPath path, AssetHash hash);
@@ -63,11 +63,17 @@ private:
     // deletes any unmapped files from the local asset directory
     void cleanupUnmappedFiles();
 
-    Mappings _fileMappings;
+    AssetMappingStore _fileMappings;
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
+    // before the task pool, so the tasks are done with it when it goes
+    MappedAssetCache _mappedAssets;
     QThreadPool _taskPool;
+
+    MetricsCounter& _getRequestsMetric;
+    MetricsCounter& _uploadRequestsMetric;
+    MetricsGauge& _activeTasksMetric;
 };
 
 #endif
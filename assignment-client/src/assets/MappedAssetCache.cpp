@@ -0,0 +1,78 @@
+//
+//  MappedAssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappedAssetCache.h"
+
+#include <iterator>
+
+// the files of the assets every visitor of a domain loads fit, a 64-bit process has the address space for them
+static const qint64 MAX_MAPPED_BYTES = 1024LL * 1024LL * 1024LL;
+static const int MAX_MAPPED_FILES = 1024;
+
+MappedAsset::MappedAsset(const QString& filePath) :
+    _file(filePath)
+{
+    if (_file.open(QIODevice::ReadOnly) && _file.size() > 0) {
+        _size = _file.size();
+        _data = _file.map(0, _size);
+    }
+}
+
+MappedAsset::~MappedAsset() {
+    if (_data) {
+        _file.unmap(_data);
+    }
+}
+
+MappedAssetPointer MappedAssetCache::get(const QString& filePath) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto entry = _assets.find(filePath);
+        if (entry != _assets.end()) {
+            _lru.splice(_lru.end(), _lru, entry->position);
+            return entry->asset;
+        }
+    }
+
+    // map outside of the lock, another request can map the same file meanwhile and the first one in is kept
+    auto asset = std::make_shared<MappedAsset>(filePath);
+    if (!asset->isValid()) {
+        return MappedAssetPointer();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto entry = _assets.find(filePath);
+    if (entry != _assets.end()) {
+        return entry->asset;
+    }
+    _lru.push_back(filePath);
+    _assets.insert(filePath, { asset, std::prev(_lru.end()) });
+    _totalSize += asset->getSize();
+
+    // the ones in use stay mapped until they're sent
+    while (_lru.size() > 1 && (_totalSize > MAX_MAPPED_BYTES || _assets.size() > MAX_MAPPED_FILES)) {
+        auto oldest = _assets.find(_lru.front());
+        _totalSize -= oldest->asset->getSize();
+        _assets.erase(oldest);
+        _lru.pop_front();
+    }
+    return asset;
+}
+
+void MappedAssetCache::remove(const QString& filePath) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto entry = _assets.find(filePath);
+    if (entry != _assets.end()) {
+        _totalSize -= entry->asset->getSize();
+        _lru.erase(entry->position);
+        _assets.erase(entry);
+    }
+}
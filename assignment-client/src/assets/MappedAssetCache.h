@@ -0,0 +1,68 @@
+//
+//  MappedAssetCache.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_MappedAssetCache_h
+#define hifi_MappedAssetCache_h
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+// An asset file mapped in memory, kept mapped while it's in use
+class MappedAsset {
+public:
+    MappedAsset(const QString& filePath);
+    ~MappedAsset();
+
+    bool isValid() const { return _data != nullptr; }
+    const char* getData() const { return reinterpret_cast<const char*>(_data); }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    uchar* _data { nullptr };
+    qint64 _size { 0 };
+};
+
+using MappedAssetPointer = std::shared_ptr<MappedAsset>;
+
+// The asset files sent most recently, mapped in memory so a request of a popular asset reads it from the mapping
+// instead of reading it again. The files are named by the hash of their contents, a mapped file never changes.
+// The least recently sent files are unmapped once the mapped files are over the limit, or when they're deleted.
+class MappedAssetCache {
+public:
+    // null if the file can't be mapped, an empty file can't be
+    MappedAssetPointer get(const QString& filePath);
+
+    // before a file is deleted: a file can't be deleted on Windows while mapped
+    void remove(const QString& filePath);
+
+private:
+    using LRU = std::list<QString>;
+    struct Entry {
+        MappedAssetPointer asset;
+        LRU::iterator position;
+    };
+
+    std::mutex _mutex;
+    QHash<QString, Entry> _assets;
+    // least recently used first
+    LRU _lru;
+    qint64 _totalSize { 0 };
+};
+
+#endif // hifi_MappedAssetCache_h
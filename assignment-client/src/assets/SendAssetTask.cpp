@@ -22,11 +22,13 @@
 
 #include "AssetUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             MappedAssetCache& mappedAssets) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _mappedAssets(mappedAssets)
 {
     
 }
@@ -58,11 +60,24 @@ void SendAssetTask::run() {
     if (end <= start) {
         replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
     } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
+        QString filePath = _resourcesDir.absoluteFilePath(QString(hexHash));
+
+        // the packets are written straight from the mapped file, no copy of the range is read first
+        auto mappedAsset = _mappedAssets.get(filePath);
         QFile file { filePath };
 
-        if (file.open(QIODevice::ReadOnly)) {
+        if (mappedAsset) {
+            if (mappedAsset->getSize() < end) {
+                replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
+                qCDebug(networking) << "Bad byte range: " << hexHash << " " << start << ":" << end;
+            } else {
+                auto size = end - start;
+                replyPacketList->writePrimitive(AssetServerError::NoError);
+                replyPacketList->writePrimitive(size);
+                replyPacketList->write(mappedAsset->getData() + start, size);
+                qCDebug(networking) << "Sending asset: " << hexHash;
+            }
+        } else if (file.open(QIODevice::ReadOnly)) {
             if (file.size() < end) {
                 replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " " << start << ":" << end;
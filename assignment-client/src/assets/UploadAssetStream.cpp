@@ -0,0 +1,156 @@
+//
+//  UploadAssetStream.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UploadAssetStream.h"
+
+#include <algorithm>
+
+#include <QtCore/QFile>
+
+#include <NodeList.h>
+#include <UUID.h>
+
+UploadAssetStream::UploadAssetStream(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode,
+                                     const QDir& resourcesDir, MappedAssetCache& mappedAssets, QObject* parent) :
+    QObject(parent),
+    _receivedMessage(message),
+    _senderNode(senderNode),
+    _resourcesDir(resourcesDir),
+    _mappedAssets(mappedAssets),
+    // not named like a hash, the cleanup of the unmapped files leaves it alone
+    _file(resourcesDir.absoluteFilePath("upload-XXXXXX"))
+{
+
+}
+
+void UploadAssetStream::start() {
+    // the head is the only part of a message still arriving that can be read without holding off the packets
+    _receivedMessage->readHeadPrimitive(&_messageID);
+    _receivedMessage->readHeadPrimitive(&_fileSize);
+    _fileEnd = _receivedMessage->getPosition() + (qint64) _fileSize;
+
+    qDebug() << "UploadAssetStream reading a file of " << _fileSize << "bytes from"
+        << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
+
+    if (_fileSize > MAX_UPLOAD_SIZE) {
+        fail(AssetServerError::AssetTooLarge);
+    } else if (!_file.open()) {
+        qWarning() << "Failed to open a temporary file for the upload from"
+            << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "- upload failed.";
+        fail(AssetServerError::FileOperationFailed);
+    }
+
+    connect(_receivedMessage.data(), &ReceivedMessage::progress, this, &UploadAssetStream::readAvailable);
+    connect(_receivedMessage.data(), &ReceivedMessage::completed, this, &UploadAssetStream::finish);
+
+    readAvailable();
+
+    // it may have completed before we were connected to it
+    if (_receivedMessage->isComplete()) {
+        finish();
+    }
+}
+
+void UploadAssetStream::readAvailable() {
+    auto end = std::min(_fileEnd, _receivedMessage->getSize());
+
+    while (_receivedMessage->getPosition() < end) {
+        auto chunk = _receivedMessage->readChunk(end - _receivedMessage->getPosition());
+
+        if (!_hasFailed) {
+            _hasher.addData(chunk);
+
+            if (_file.write(chunk) != chunk.size()) {
+                qWarning() << "Failed to write the upload from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID())
+                    << "to disk - upload failed.";
+                fail(AssetServerError::FileOperationFailed);
+            }
+        }
+    }
+
+    _receivedMessage->releaseReadData();
+}
+
+void UploadAssetStream::finish() {
+    if (_isFinished) {
+        return;
+    }
+    _isFinished = true;
+
+    // what came with the last packet
+    readAvailable();
+
+    if (!_hasFailed) {
+        if (_receivedMessage->failed() || _file.size() != (qint64) _fileSize) {
+            qWarning() << "The upload from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID())
+                << "did not arrive whole - upload failed.";
+            fail(AssetServerError::FileOperationFailed);
+        } else {
+            auto hash = _hasher.result();
+            auto hexHash = hash.toHex();
+
+            qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID())
+                << "is: (" << hexHash << ") ";
+
+            auto filePath = _resourcesDir.absoluteFilePath(QString(hexHash));
+            QFile existingFile { filePath };
+
+            QCryptographicHash existingHasher { QCryptographicHash::Sha256 };
+            if (existingFile.open(QIODevice::ReadOnly) && existingHasher.addData(&existingFile)
+                && existingHasher.result() == hash) {
+                qDebug() << "Not overwriting existing verified file: " << hexHash;
+
+                sendReply(AssetServerError::NoError, hash);
+            } else {
+                if (existingFile.exists()) {
+                    qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
+                    existingFile.close();
+
+                    _mappedAssets.remove(filePath);
+                    existingFile.remove();
+                }
+
+                if (_file.rename(filePath)) {
+                    _file.setAutoRemove(false);
+                    QFile::setPermissions(filePath, QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther);
+
+                    qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
+                    sendReply(AssetServerError::NoError, hash);
+                } else {
+                    qWarning() << "Failed to move the upload of" << hexHash << "into place - upload failed.";
+                    fail(AssetServerError::FileOperationFailed);
+                }
+            }
+        }
+    }
+
+    // the temporary file is removed with us if it wasn't moved into place
+    deleteLater();
+}
+
+void UploadAssetStream::fail(AssetServerError error) {
+    _hasFailed = true;
+    _file.close();
+    sendReply(error);
+}
+
+void UploadAssetStream::sendReply(AssetServerError error, const QByteArray& hash) {
+    auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
+    replyPacket->writePrimitive(_messageID);
+    replyPacket->writePrimitive(error);
+
+    if (error == AssetServerError::NoError) {
+        replyPacket->write(hash);
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->sendPacket(std::move(replyPacket), *_senderNode);
+}
@@ -0,0 +1,63 @@
+//
+//  UploadAssetStream.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_UploadAssetStream_h
+#define hifi_UploadAssetStream_h
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QTemporaryFile>
+
+#include <AssetUtils.h>
+#include <Node.h>
+#include <ReceivedMessage.h>
+
+#include "MappedAssetCache.h"
+
+// An upload of many packets, hashed and written to a temporary file as its packets arrive and moved into place once
+// it's complete, so the asset server never holds more than a few of its packets in memory
+class UploadAssetStream : public QObject {
+    Q_OBJECT
+public:
+    UploadAssetStream(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode, const QDir& resourcesDir,
+                      MappedAssetCache& mappedAssets, QObject* parent = nullptr);
+
+    // Reads what has arrived of the upload and the rest of it as it arrives, deletes itself once it has replied
+    void start();
+
+private:
+    void readAvailable();
+    void finish();
+    void fail(AssetServerError error);
+    void sendReply(AssetServerError error, const QByteArray& hash = QByteArray());
+
+    QSharedPointer<ReceivedMessage> _receivedMessage;
+    SharedNodePointer _senderNode;
+    QDir _resourcesDir;
+    MappedAssetCache& _mappedAssets;
+
+    MessageID _messageID { 0 };
+    uint64_t _fileSize { 0 };
+    qint64 _fileEnd { 0 };
+
+    QCryptographicHash _hasher { QCryptographicHash::Sha256 };
+    QTemporaryFile _file;
+
+    // once the upload has failed the rest of it is dropped as it arrives, the error has been sent already
+    bool _hasFailed { false };
+    bool _isFinished { false };
+};
+
+#endif // hifi_UploadAssetStream_h
@@ -11,7 +11,7 @@
 
 #include "UploadAssetTask.h"
 
-#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
 
 #include <AssetUtils.h>
@@ -20,25 +20,21 @@
 
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir) :
+                                 const QDir& resourcesDir, MappedAssetCache& mappedAssets) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _mappedAssets(mappedAssets)
 {
     
 }
 
 void UploadAssetTask::run() {
-    auto data = _receivedMessage->getMessage();
-    
-    QBuffer buffer { &data };
-    buffer.open(QIODevice::ReadOnly);
-    
     MessageID messageID;
-    buffer.read(reinterpret_cast<char*>(&messageID), sizeof(messageID));
+    _receivedMessage->readPrimitive(&messageID);
     
     uint64_t fileSize;
-    buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+    _receivedMessage->readPrimitive(&fileSize);
     
     qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from"
         << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
@@ -49,15 +45,22 @@ void UploadAssetTask::run() {
     if (fileSize > MAX_UPLOAD_SIZE) {
         replyPacket->writePrimitive(AssetServerError::AssetTooLarge);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
+        // hash the file straight out of the received packets, the message is never flattened
+        auto fileStart = _receivedMessage->getPosition();
+        auto fileEnd = fileStart + std::min((qint64) fileSize, _receivedMessage->getBytesLeftToRead());
+        
+        QCryptographicHash hasher { QCryptographicHash::Sha256 };
+        while (_receivedMessage->getPosition() < fileEnd) {
+            hasher.addData(_receivedMessage->readChunk(fileEnd - _receivedMessage->getPosition()));
+        }
         
-        auto hash = hashData(fileData);
+        auto hash = hasher.result();
         auto hexHash = hash.toHex();
         
         qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID())
             << "is: (" << hexHash << ") ";
         
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
+        QFile file { _resourcesDir.absoluteFilePath(QString(hexHash)) };
 
         bool existingCorrectFile = false;
         
@@ -73,11 +76,29 @@ void UploadAssetTask::run() {
             } else {
                 qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
                 file.close();
+
+                // a new file in its place, the sends still reading the mapping of the old one keep it until they're done
+                _mappedAssets.remove(file.fileName());
+                file.remove();
             }
         }
 
         if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
+            qint64 bytesWritten = 0;
+            
+            if (file.open(QIODevice::WriteOnly)) {
+                _receivedMessage->seek(fileStart);
+                
+                while (_receivedMessage->getPosition() < fileEnd) {
+                    auto chunk = _receivedMessage->readChunk(fileEnd - _receivedMessage->getPosition());
+                    if (file.write(chunk) != chunk.size()) {
+                        break;
+                    }
+                    bytesWritten += chunk.size();
+                }
+            }
+            
+            if (bytesWritten == qint64(fileSize)) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
                 file.close();
 
@@ -19,6 +19,7 @@
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
+#include "MappedAssetCache.h"
 #include "ReceivedMessage.h"
 
 class NLPacketList;
@@ -26,7 +27,8 @@ class Node;
 
 class UploadAssetTask : public QRunnable {
 public:
-    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& resourcesDir);
+    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& resourcesDir,
+                    MappedAssetCache& mappedAssets);
 
     void run() override;
 
@@ -34,6 +36,7 @@ private:
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
+    MappedAssetCache& _mappedAssets;
 };
 
 #endif // hifi_UploadAssetTask_h
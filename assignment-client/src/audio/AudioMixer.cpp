@@ -9,10 +9,12 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <errno.h>
 #include <fcntl.h>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <math.h>
 #include <memory>
 #include <signal.h>
@@ -53,6 +55,7 @@
 #include <SharedUtil.h>
 #include <StDev.h>
 #include <UUID.h>
+#include <shared/Tracing.h>
 
 #include "AudioRingBuffer.h"
 #include "AudioMixerClientData.h"
@@ -67,6 +70,7 @@ const float DEFAULT_NOISE_MUTING_THRESHOLD = 0.003f;
 const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
+const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
 
 InboundAudioStream::Settings AudioMixer::_streamSettings;
 
@@ -82,7 +86,13 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     _minAudibilityThreshold(LOUDNESS_TO_DISTANCE_RATIO / 2.0f),
     _performanceThrottlingRatio(0.0f),
     _attenuationPerDoublingInDistance(DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE),
-    _noiseMutingThreshold(DEFAULT_NOISE_MUTING_THRESHOLD)
+    _noiseMutingThreshold(DEFAULT_NOISE_MUTING_THRESHOLD),
+    _framesMetric(Metrics::counter("hifi_audio_mixer_frames_total", "Frames mixed")),
+    _frameOverrunsMetric(Metrics::counter("hifi_audio_mixer_frame_overruns_total",
+                                          "Frames that were not done by the time the next one was due")),
+    _frameSecondsMetric(Metrics::histogram("hifi_audio_mixer_frame_seconds", "Time taken to mix and send a frame",
+                                           Metrics::secondsBounds())),
+    _listenersMetric(Metrics::gauge("hifi_audio_mixer_listeners", "Listeners mixed for in the last frame"))
 {
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
@@ -100,6 +110,8 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
 
 const float ATTENUATION_BEGINS_AT_DISTANCE = 1.0f;
 
+const int HRTF_DATASET_INDEX = 1;
+
 const int IEEE754_MANT_BITS = 23;
 const int IEEE754_EXPN_BIAS = 127;
 
@@ -158,7 +170,7 @@ static inline float fastexp2(float x) {
 }
 
 float AudioMixer::gainForSource(const PositionalAudioStream& streamToAdd,
-                                const AvatarAudioStream& listeningNodeStream, const glm::vec3& relativePosition, bool isEcho) {
+                                const AvatarAudioStream& listeningNodeStream, const glm::vec3& relativePosition, bool isEcho) const {
     float gain = 1.0f;
 
     float distanceBetween = glm::length(relativePosition);
@@ -215,7 +227,7 @@ float AudioMixer::gainForSource(const PositionalAudioStream& streamToAdd,
 }
 
 float AudioMixer::azimuthForSource(const PositionalAudioStream& streamToAdd, const AvatarAudioStream& listeningNodeStream,
-                                   const glm::vec3& relativePosition) {
+                                   const glm::vec3& relativePosition) const {
     glm::quat inverseOrientation = glm::inverse(listeningNodeStream.getOrientation());
 
     //  Compute sample delay for the two ears to create phase panning
@@ -235,8 +247,9 @@ float AudioMixer::azimuthForSource(const PositionalAudioStream& streamToAdd, con
     }
 }
 
-void AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData& listenerNodeData,
+void AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerSlave& slave, AudioMixerClientData& listenerNodeData,
                                                           const PositionalAudioStream& streamToAdd,
+                                                          const float* streamSamples,
                                                           const QUuid& sourceNodeID,
                                                           const AvatarAudioStream& listeningNodeStream) {
 
@@ -244,7 +257,7 @@ void AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData&
     // to reduce artifacts we calculate the gain and azimuth for every source for this listener
     // even if we are not going to end up mixing in this source
 
-    ++_totalMixes;
+    ++slave.stats.totalMixes;
 
     // this ensures that the tail of any previously mixed audio or the first block of new audio sounds correct
 
@@ -264,8 +277,6 @@ void AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData&
 
     float repeatedFrameFadeFactor = 1.0f;
 
-    static const int HRTF_DATASET_INDEX = 1;
-
     if (!streamToAdd.lastPopSucceeded()) {
         bool forceSilentBlock = true;
 
@@ -301,37 +312,39 @@ void AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData&
                 auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
 
                 // this is not done for stereo streams since they do not go through the HRTF
-                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                hrtf.renderSilent(silentMonoBlock, _mixedSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                static const float silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+                hrtf.renderSilent(silentMonoBlock, slave.mixedSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-                ++_hrtfSilentRenders;;
+                ++slave.stats.hrtfSilentRenders;
             }
 
             return;
         }
     }
 
-    // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd.getLastPopOutput();
+    // the source's frame was already read from its ring buffer and converted to float before mixing started
+    if (!streamSamples) {
+        return;
+    }
 
     if (streamToAdd.isStereo() || isEcho) {
         // this is a stereo source or server echo so we do not pass it through the HRTF
         // simply apply our calculated gain to each sample
         if (streamToAdd.isStereo()) {
             for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-                _mixedSamples[i] += float(streamPopOutput[i] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+                slave.mixedSamples[i] += streamSamples[i] * gain;
             }
 
-            ++_manualStereoMixes;
+            ++slave.stats.manualStereoMixes;
         } else {
             for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i += 2) {
-                auto monoSample = float(streamPopOutput[i / 2] * gain / AudioConstants::MAX_SAMPLE_VALUE);
-                _mixedSamples[i] += monoSample;
-                _mixedSamples[i + 1] += monoSample;
+                auto monoSample = streamSamples[i / 2] * gain;
+                slave.mixedSamples[i] += monoSample;
+                slave.mixedSamples[i + 1] += monoSample;
             }
 
-            ++_manualEchoMixes;
+            ++slave.stats.manualEchoMixes;
         }
 
         return;
@@ -340,19 +353,15 @@ void AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData&
     // get the existing listener-source HRTF object, or create a new one
     auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
 
-    static int16_t streamBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
-
-    streamPopOutput.readSamples(streamBlock, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
     // if the frame we're about to mix is silent, simply call render silent and move on
     if (streamToAdd.getLastPopOutputLoudness() == 0.0f) {
         // silent frame from source
 
         // we still need to call renderSilent via the HRTF for mono source
-        hrtf.renderSilent(streamBlock, _mixedSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+        hrtf.renderSilent(streamSamples, slave.mixedSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-        ++_hrtfSilentRenders;
+        ++slave.stats.hrtfSilentRenders;
 
         return;
     }
@@ -362,27 +371,78 @@ void AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData&
         // the mixer is struggling so we're going to drop off some streams
 
         // we call renderSilent via the HRTF with the actual frame data and a gain of 0.0
-        hrtf.renderSilent(streamBlock, _mixedSamples, HRTF_DATASET_INDEX, azimuth, distance, 0.0f,
+        hrtf.renderSilent(streamSamples, slave.mixedSamples, HRTF_DATASET_INDEX, azimuth, distance, 0.0f,
                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-        ++_hrtfStruggleRenders;
+        ++slave.stats.hrtfStruggleRenders;
 
         return;
     }
 
-    ++_hrtfRenders;
+    ++slave.stats.hrtfRenders;
 
     // mono stream, call the HRTF with our block and calculated azimuth and gain
-    hrtf.render(streamBlock, _mixedSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+    hrtf.render(streamSamples, slave.mixedSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                 AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 }
 
-bool AudioMixer::prepareMixForListeningNode(Node* node) {
+void AudioMixer::addStreamToBedForListeningNodeWithStream(AudioMixerSlave& slave, AudioMixerClientData& listenerNodeData,
+                                                          const PositionalAudioStream& streamToAdd,
+                                                          const float* streamSamples,
+                                                          const QUuid& sourceNodeID,
+                                                          const AvatarAudioStream& listeningNodeStream) {
+    ++slave.stats.totalMixes;
+    ++slave.stats.bedMixes;
+
+    glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
+    float distance = glm::max(glm::length(relativePosition), EPSILON);
+    float gain = gainForSource(streamToAdd, listeningNodeStream, relativePosition, false);
+    float azimuth = azimuthForSource(streamToAdd, listeningNodeStream, relativePosition);
+
+    // fade the HRTF for this source out - once it is silent this is nearly free,
+    // and it fades back in from silence if the source makes it back into the budget
+    static const float silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+    auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
+    hrtf.renderSilent(streamSamples ? streamSamples : silentMonoBlock, slave.mixedSamples, HRTF_DATASET_INDEX,
+                      azimuth, distance, 0.0f, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    if (!streamSamples) {
+        return;
+    }
+
+    if (!streamToAdd.lastPopSucceeded()) {
+        // same repetition rules as a full mix
+        if (!_streamSettings._repetitionWithFade) {
+            return;
+        }
+
+        gain *= calculateRepeatedFrameFadeFactor(streamToAdd.getConsecutiveNotMixedCount() - 1);
+        if (gain <= 0.0f) {
+            return;
+        }
+    }
+
+    // constant power pan from the azimuth instead of the HRTF
+    float pan = sinf(azimuth);
+    float theta = (pan + 1.0f) * PI_OVER_TWO / 2.0f;
+    float leftGain = cosf(theta) * gain;
+    float rightGain = sinf(theta) * gain;
+
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+        slave.mixedSamples[2 * i] += streamSamples[i] * leftGain;
+        slave.mixedSamples[2 * i + 1] += streamSamples[i] * rightGain;
+    }
+}
+
+bool AudioMixer::prepareMixForListeningNode(AudioMixerSlave& slave, Node* node) {
     AvatarAudioStream* nodeAudioStream = static_cast<AudioMixerClientData*>(node->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerNodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
 
     // zero out the client mix for this node
-    memset(_mixedSamples, 0, sizeof(_mixedSamples));
+    memset(slave.mixedSamples, 0, sizeof(slave.mixedSamples));
+
+    auto& candidates = slave.candidates;
+    candidates.clear();
 
     // loop through all other nodes that have sufficient audio to mix
 
@@ -399,20 +459,58 @@ bool AudioMixer::prepareMixForListeningNode(Node* node) {
                 auto otherNodeStream = streamPair.second;
 
                 if (*otherNode != *node || otherNodeStream->shouldLoopbackForNode()) {
-                    addStreamToMixForListeningNodeWithStream(*listenerNodeData, *otherNodeStream, otherNode->getUUID(),
-                                                             *nodeAudioStream);
+                    auto streamSamples = otherNodeClientData->getPreparedSamples(otherNodeStream->getStreamIdentifier());
+                    bool isEcho = (otherNodeStream.get() == nodeAudioStream);
+
+                    if (_hrtfSourceBudget > 0 && !otherNodeStream->isStereo() && !isEcho) {
+                        // this source goes through the HRTF, so it competes for this listener's budget
+                        glm::vec3 relativePosition = otherNodeStream->getPosition() - nodeAudioStream->getPosition();
+                        float loudness = otherNodeStream->getLastPopOutputLoudness()
+                            * gainForSource(*otherNodeStream, *nodeAudioStream, relativePosition, false);
+
+                        candidates.push_back({ otherNodeStream.get(), streamSamples, otherNode->getUUID(), loudness });
+                    } else {
+                        addStreamToMixForListeningNodeWithStream(slave, *listenerNodeData, *otherNodeStream, streamSamples,
+                                                                 otherNode->getUUID(), *nodeAudioStream);
+                    }
                 }
             }
         }
     });
 
+    // only the loudest sources at this listener get the HRTF, the rest go into the panned bed
+    int numCulled = 0;
+    if ((int) candidates.size() > _hrtfSourceBudget) {
+        auto budgetEnd = candidates.begin() + _hrtfSourceBudget;
+        std::nth_element(candidates.begin(), budgetEnd, candidates.end(),
+                         [](const AudioMixerSlave::MixCandidate& a, const AudioMixerSlave::MixCandidate& b) {
+            return a.loudness > b.loudness;
+        });
+        numCulled = (int) (candidates.end() - budgetEnd);
+    }
+
+    int numRendered = (int) candidates.size() - numCulled;
+    for (int i = 0; i < (int) candidates.size(); ++i) {
+        auto& candidate = candidates[i];
+        if (i < numRendered) {
+            addStreamToMixForListeningNodeWithStream(slave, *listenerNodeData, *candidate.stream, candidate.samples,
+                                                     candidate.sourceNodeID, *nodeAudioStream);
+        } else {
+            addStreamToBedForListeningNodeWithStream(slave, *listenerNodeData, *candidate.stream, candidate.samples,
+                                                     candidate.sourceNodeID, *nodeAudioStream);
+        }
+    }
+
+    listenerNodeData->recordCulledSources(numCulled);
+
     // use the per listner AudioLimiter to render the mixed data...
-    listenerNodeData->audioLimiter.render(_mixedSamples, _clampedSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    listenerNodeData->audioLimiter.render(slave.mixedSamples, slave.clampedSamples,
+                                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
     // check for silent audio after the peak limitor has converted the samples
     bool hasAudio = false;
     for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-        if (_clampedSamples[i] != 0) {
+        if (slave.clampedSamples[i] != 0) {
             hasAudio = true;
             break;
         }
@@ -420,6 +518,118 @@ bool AudioMixer::prepareMixForListeningNode(Node* node) {
     return hasAudio;
 }
 
+void AudioMixer::mixForListeningNode(AudioMixerSlave& slave, Node* node, ListenerMix& mix) {
+    mix.hasAudio = prepareMixForListeningNode(slave, node);
+    mix.encodedIndex = -1;
+
+    if (mix.hasAudio) {
+        // the slave's buffers are reused by its next listener, so the frame is copied out for the encode pass
+        mix.decodedBuffer = QByteArray(reinterpret_cast<char*>(slave.clampedSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+        mix.hash = qHash(mix.decodedBuffer);
+    }
+}
+
+std::vector<int> AudioMixer::findUniqueEncodes(const FrameVector<SharedNodePointer>& listeners,
+                                               FrameVector<ListenerMix>& mixes) {
+    std::vector<int> uniqueEncodes;
+
+    // mixes that could share an encoded frame, keyed by encoder and hash of the frame
+    QMultiHash<QPair<const Encoder*, uint>, int> encodedMixes;
+
+    for (int i = 0; i < (int) mixes.size(); ++i) {
+        auto& mix = mixes[i];
+        if (!mix.hasAudio) {
+            continue;
+        }
+
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(listeners[i]->getLinkedData());
+        auto key = qMakePair(nodeData->getEncoder(), mix.hash);
+
+        // the hash only narrows it down, the frames themselves have to match
+        for (auto it = encodedMixes.find(key); it != encodedMixes.end() && it.key() == key; ++it) {
+            if (mixes[it.value()].decodedBuffer == mix.decodedBuffer) {
+                mix.encodedIndex = it.value();
+                break;
+            }
+        }
+
+        if (mix.encodedIndex == -1) {
+            mix.encodedIndex = i;
+            encodedMixes.insert(key, i);
+            uniqueEncodes.push_back(i);
+        } else {
+            ++_sumReusedEncodes;
+        }
+    }
+
+    _sumEncodes += (int) uniqueEncodes.size();
+
+    return uniqueEncodes;
+}
+
+void AudioMixer::mixFrame(const FrameVector<SharedNodePointer>& listeners, FrameVector<ListenerMix>& mixes) {
+    TRACE_SCOPE("AudioMixer::mixFrame");
+    // the mixes are built in parallel, each listener is only touched by the slave that picked it up
+    _slavePool.mix((int) listeners.size(), [&](AudioMixerSlave& slave, int index) {
+        mixForListeningNode(slave, listeners[index].data(), mixes[index]);
+        ++slave.stats.listeners;
+    });
+
+    // encoding is the most expensive step per listener, so each distinct frame is only encoded once
+    // and the encodes get a pass over the slaves of their own
+    auto uniqueEncodes = findUniqueEncodes(listeners, mixes);
+
+    _slavePool.mix((int) uniqueEncodes.size(), [&](AudioMixerSlave& slave, int index) {
+        int listenerIndex = uniqueEncodes[index];
+        auto& mix = mixes[listenerIndex];
+        AudioMixerClientData* nodeData = (AudioMixerClientData*)listeners[listenerIndex]->getLinkedData();
+        nodeData->encode(mix.decodedBuffer, mix.encodedBuffer);
+    });
+
+    _slavePool.finishFrame();
+}
+
+std::unique_ptr<NLPacket> AudioMixer::createMixPacketForListeningNode(Node* node, const QByteArray* encodedBuffer,
+                                                                      int numSilentFrames) {
+    AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+
+    std::unique_ptr<NLPacket> mixPacket;
+
+    if (encodedBuffer) {
+        int mixPacketBytes = sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE
+                                             + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
+        mixPacket = NLPacket::create(PacketType::MixedAudio, mixPacketBytes);
+
+        // pack sequence number
+        quint16 sequence = nodeData->getOutgoingSequenceNumber();
+        mixPacket->writePrimitive(sequence);
+
+        // write the codec
+        QString codecInPacket = nodeData->getCodecName();
+        mixPacket->writeString(codecInPacket);
+
+        // pack mixed audio samples
+        mixPacket->write(encodedBuffer->constData(), encodedBuffer->size());
+    } else {
+        int silentPacketBytes = sizeof(quint16) + sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE;
+        mixPacket = NLPacket::create(PacketType::SilentAudioFrame, silentPacketBytes);
+
+        // pack sequence number
+        quint16 sequence = nodeData->getOutgoingSequenceNumber();
+        mixPacket->writePrimitive(sequence);
+
+        // write the codec
+        QString codecInPacket = nodeData->getCodecName();
+        mixPacket->writeString(codecInPacket);
+
+        // pack number of silent audio samples, for every frame of the run this packet stands in for
+        quint16 numSilentSamples = numSilentFrames * AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+        mixPacket->writePrimitive(numSilentSamples);
+    }
+
+    return mixPacket;
+}
+
 void AudioMixer::sendAudioEnvironmentPacket(SharedNodePointer node) {
     // Send stream properties
     bool hasReverb = false;
@@ -629,9 +839,9 @@ void AudioMixer::removeHRTFsForFinishedInjector(const QUuid& streamID) {
     }
 }
 
-QString AudioMixer::percentageForMixStats(int counter) {
-    if (_totalMixes > 0) {
-        float mixPercentage = (float(counter) / _totalMixes) * 100.0f;
+QString AudioMixer::percentageForMixStats(int counter, int totalMixes) {
+    if (totalMixes > 0) {
+        float mixPercentage = (float(counter) / totalMixes) * 100.0f;
         return QString::number(mixPercentage, 'f', 2);
     } else {
         return QString("0.0");
@@ -647,25 +857,51 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["avg_listeners_per_frame"] = (float) _sumListeners / (float) _numStatFrames;
 
+    // gather the stats from each of the mixing threads
+    AudioMixerSlave::Stats totalStats;
+    QJsonObject threadStats;
+
+    for (int i = 0; i < _slavePool.numThreads(); ++i) {
+        auto& slaveStats = _slavePool.getSlave(i).stats;
+        totalStats.accumulate(slaveStats);
+
+        QJsonObject slaveObject;
+        slaveObject["listeners"] = slaveStats.listeners;
+        slaveObject["avg_mix_usecs_per_frame"] = slaveStats.frames > 0 ? (double) slaveStats.mixUsecs / slaveStats.frames : 0.0;
+        slaveObject["max_mix_usecs_per_frame"] = (double) slaveStats.maxFrameMixUsecs;
+        threadStats[QString::number(i)] = slaveObject;
+
+        slaveStats.reset();
+    }
+
     QJsonObject mixStats;
-    mixStats["%_hrtf_mixes"] = percentageForMixStats(_hrtfRenders);
-    mixStats["%_hrtf_silent_mixes"] = percentageForMixStats(_hrtfSilentRenders);
-    mixStats["%_hrtf_struggle_mixes"] = percentageForMixStats(_hrtfStruggleRenders);
-    mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_manualStereoMixes);
-    mixStats["%_manual_echo_mixes"] = percentageForMixStats(_manualEchoMixes);
+    mixStats["%_hrtf_mixes"] = percentageForMixStats(totalStats.hrtfRenders, totalStats.totalMixes);
+    mixStats["%_hrtf_silent_mixes"] = percentageForMixStats(totalStats.hrtfSilentRenders, totalStats.totalMixes);
+    mixStats["%_hrtf_struggle_mixes"] = percentageForMixStats(totalStats.hrtfStruggleRenders, totalStats.totalMixes);
+    mixStats["%_manual_stereo_mixes"] = percentageForMixStats(totalStats.manualStereoMixes, totalStats.totalMixes);
+    mixStats["%_manual_echo_mixes"] = percentageForMixStats(totalStats.manualEchoMixes, totalStats.totalMixes);
+    mixStats["%_bed_mixes"] = percentageForMixStats(totalStats.bedMixes, totalStats.totalMixes);
 
-    mixStats["total_mixes"] = _totalMixes;
-    mixStats["avg_mixes_per_block"] = _totalMixes / _numStatFrames;
+    mixStats["total_mixes"] = totalStats.totalMixes;
+    mixStats["avg_mixes_per_block"] = totalStats.totalMixes / _numStatFrames;
 
     statsObject["mix_stats"] = mixStats;
 
+    statsObject["mix_threads"] = _slavePool.numThreads();
+    statsObject["frame_arena_high_water_kb"] = (double) FrameArena::getHighWaterMark() / 1024.0;
+    statsObject["mix_thread_stats"] = threadStats;
+
+    QJsonObject encodeStats;
+    encodeStats["total_encodes"] = _sumEncodes;
+    encodeStats["%_reused_encodes"] = percentageForMixStats(_sumReusedEncodes, _sumEncodes + _sumReusedEncodes);
+    statsObject["encode_stats"] = encodeStats;
+
+    statsObject["avg_skipped_silent_frames_per_frame"] = (float) _sumSkippedSilentFrames / (float) _numStatFrames;
+
     _sumListeners = 0;
-    _hrtfRenders = 0;
-    _hrtfSilentRenders = 0;
-    _hrtfStruggleRenders = 0;
-    _manualStereoMixes = 0;
-    _manualEchoMixes = 0;
-    _totalMixes = 0;
+    _sumEncodes = 0;
+    _sumReusedEncodes = 0;
+    _sumSkippedSilentFrames = 0;
     _numStatFrames = 0;
 
     // add stats for each listerner
@@ -683,6 +919,9 @@ void AudioMixer::sendStatsPacket() {
 
             nodeStats["jitter"] = clientData->getAudioStreamStats();
 
+            nodeStats["avg_culled_sources_per_frame"] = clientData->getAverageCulledSources();
+            clientData->resetCulledSources();
+
             listenerStats[uuidString] = nodeStats;
         }
     });
@@ -753,6 +992,8 @@ void AudioMixer::broadcastMixes() {
             timeToSleep = std::chrono::microseconds(0);
         }
 
+        auto frameStart = p_high_resolution_clock::now();
+
         _trailingSleepRatio = (PREVIOUS_FRAMES_RATIO * _trailingSleepRatio)
             + (timeToSleep.count() * CURRENT_FRAME_RATIO / (float) AudioConstants::NETWORK_FRAME_USECS);
 
@@ -793,6 +1034,10 @@ void AudioMixer::broadcastMixes() {
             ++framesSinceCutoffEvent;
         }
 
+        // the listeners and their mixes only last for the frame, so they come from the frame arena of this thread
+        FrameArena::Scope frameScope;
+        FrameVector<SharedNodePointer> listeners;
+
         nodeList->eachNode([&](const SharedNodePointer& node) {
 
             if (node->getLinkedData()) {
@@ -812,66 +1057,53 @@ void AudioMixer::broadcastMixes() {
 
                 if (node->getType() == NodeType::Agent && node->getActiveSocket()
                     && nodeData->getAvatarAudioStream()) {
+                    listeners.push_back(node);
+                }
+            }
+        });
 
-                    bool mixHasAudio = prepareMixForListeningNode(node.data());
-
-                    std::unique_ptr<NLPacket> mixPacket;
-
-                    if (mixHasAudio) {
-                        int mixPacketBytes = sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE 
-                                                             + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
-                        mixPacket = NLPacket::create(PacketType::MixedAudio, mixPacketBytes);
-
-                        // pack sequence number
-                        quint16 sequence = nodeData->getOutgoingSequenceNumber();
-                        mixPacket->writePrimitive(sequence);
-
-                        // write the codec
-                        QString codecInPacket = nodeData->getCodecName();
-                        mixPacket->writeString(codecInPacket);
-
-                        QByteArray decodedBuffer(reinterpret_cast<char*>(_clampedSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                        QByteArray encodedBuffer;
-                        nodeData->encode(decodedBuffer, encodedBuffer);
-
-                        // pack mixed audio samples
-                        mixPacket->write(encodedBuffer.constData(), encodedBuffer.size());
-                    } else {
-                        int silentPacketBytes = sizeof(quint16) + sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE;
-                        mixPacket = NLPacket::create(PacketType::SilentAudioFrame, silentPacketBytes);
+        _listenersMetric.set((double)listeners.size());
 
-                        // pack sequence number
-                        quint16 sequence = nodeData->getOutgoingSequenceNumber();
-                        mixPacket->writePrimitive(sequence);
+        // every stream has been popped for this frame, so the mixes can now be built
+        FrameVector<ListenerMix> mixes(listeners.size());
+        mixFrame(listeners, mixes);
 
-                        // write the codec
-                        QString codecInPacket = nodeData->getCodecName();
-                        mixPacket->writeString(codecInPacket);
+        // sending stays on this thread, in node order
+        for (size_t i = 0; i < listeners.size(); ++i) {
+            auto& node = listeners[i];
+            AudioMixerClientData* nodeData = (AudioMixerClientData*)node->getLinkedData();
 
-                        // pack number of silent audio samples
-                        quint16 numSilentSamples = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
-                        mixPacket->writePrimitive(numSilentSamples);
-                    }
+            // Send audio environment
+            sendAudioEnvironmentPacket(node);
 
-                    // Send audio environment
-                    sendAudioEnvironmentPacket(node);
+            // send mixed audio packet, silent mixes only go out once per run of silent frames
+            auto& mix = mixes[i];
+            if (mix.hasAudio) {
+                nodeData->endSilentRun();
 
-                    // send mixed audio packet
-                    nodeList->sendPacket(std::move(mixPacket), *node);
+                auto& encodedBuffer = mixes[mix.encodedIndex].encodedBuffer;
+                nodeList->sendPacket(createMixPacketForListeningNode(node.data(), &encodedBuffer, 0), *node);
+                nodeData->incrementOutgoingMixedAudioSequenceNumber();
+            } else {
+                int numSilentFrames = nodeData->nextSilentRun(_maxSilentRunFrames);
+                if (numSilentFrames > 0) {
+                    nodeList->sendPacket(createMixPacketForListeningNode(node.data(), nullptr, numSilentFrames), *node);
                     nodeData->incrementOutgoingMixedAudioSequenceNumber();
+                } else {
+                    ++_sumSkippedSilentFrames;
+                }
+            }
 
-                    // send an audio stream stats packet to the client approximately every second
-                    ++currentFrame;
-                    currentFrame %= numFramesPerSecond;
-
-                    if (nodeData->shouldSendStats(currentFrame)) {
-                        nodeData->sendAudioStreamStatsPackets(node);
-                    }
+            // send an audio stream stats packet to the client approximately every second
+            ++currentFrame;
+            currentFrame %= numFramesPerSecond;
 
-                    ++_sumListeners;
-                }
+            if (nodeData->shouldSendStats(currentFrame)) {
+                nodeData->sendAudioStreamStatsPackets(node);
             }
-        });
+
+            ++_sumListeners;
+        }
 
         ++_numStatFrames;
 
@@ -892,11 +1124,38 @@ void AudioMixer::broadcastMixes() {
         auto now = p_high_resolution_clock::now();
         timeToSleep = std::chrono::duration_cast<std::chrono::microseconds>(nextFrameTimestamp - now);
 
+        _framesMetric.add();
+        _frameSecondsMetric.observe(std::chrono::duration<double>(now - frameStart).count());
+        if (timeToSleep.count() < 0) {
+            _frameOverrunsMetric.add();
+        }
+
         std::this_thread::sleep_for(timeToSleep);
     }
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
+    if (settingsObject.contains(AUDIO_THREADING_GROUP_KEY)) {
+        QJsonObject audioThreadingGroupObject = settingsObject[AUDIO_THREADING_GROUP_KEY].toObject();
+
+        int numThreads = 1;
+
+        const QString AUTO_THREADS = "auto_threads";
+        const QString NUM_THREADS = "num_threads";
+        if (audioThreadingGroupObject[AUTO_THREADS].toBool()) {
+            numThreads = QThread::idealThreadCount();
+        } else {
+            bool ok;
+            numThreads = audioThreadingGroupObject[NUM_THREADS].toString().toInt(&ok);
+            if (!ok) {
+                numThreads = 1;
+            }
+        }
+
+        _slavePool.setNumThreads(numThreads);
+        qDebug() << "Mixing with" << _slavePool.numThreads() << "thread(s)";
+    }
+
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
         QJsonObject audioBufferGroupObject = settingsObject[AUDIO_BUFFER_GROUP_KEY].toObject();
 
@@ -991,6 +1250,28 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             }
         }
 
+        const QString HRTF_SOURCE_BUDGET = "hrtf_source_budget";
+        if (audioEnvGroupObject[HRTF_SOURCE_BUDGET].isString()) {
+            bool ok = false;
+            int hrtfSourceBudget = audioEnvGroupObject[HRTF_SOURCE_BUDGET].toString().toInt(&ok);
+            if (ok && hrtfSourceBudget >= 0) {
+                _hrtfSourceBudget = hrtfSourceBudget;
+                qDebug() << "HRTF source budget per listener changed to" << _hrtfSourceBudget;
+            }
+        }
+
+        const QString MAX_SILENT_RUN_FRAMES = "max_silent_run_frames";
+        if (audioEnvGroupObject[MAX_SILENT_RUN_FRAMES].isString()) {
+            bool ok = false;
+            int maxSilentRunFrames = audioEnvGroupObject[MAX_SILENT_RUN_FRAMES].toString().toInt(&ok);
+            if (ok) {
+                // the run goes out as a sample count in a quint16
+                const int MAX_RUN_FRAMES = std::numeric_limits<quint16>::max() / AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+                _maxSilentRunFrames = glm::clamp(maxSilentRunFrames, 1, MAX_RUN_FRAMES);
+                qDebug() << "Silent mixes sent once every" << _maxSilentRunFrames << "frame(s)";
+            }
+        }
+
         const QString FILTER_KEY = "enable_filter";
         if (audioEnvGroupObject[FILTER_KEY].isBool()) {
             _enableFilter = audioEnvGroupObject[FILTER_KEY].toBool();
@@ -15,9 +15,13 @@
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
+#include <FrameArena.h>
+#include <Metrics.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 
+#include "AudioMixerSlavePool.h"
+
 class PositionalAudioStream;
 class AvatarAudioStream;
 class AudioHRTF;
@@ -30,6 +34,7 @@ const int READ_DATAGRAMS_STATS_WINDOW_SECONDS = 30;
 /// Handles assignments of type AudioMixer - mixing streams of audio and re-distributing to various clients.
 class AudioMixer : public ThreadedAssignment {
     Q_OBJECT
+    friend class AudioMixerBenchmark; // runs the frame mix headless, see tools/audio-mixer-benchmark
 public:
     AudioMixer(ReceivedMessage& message);
 
@@ -55,25 +60,54 @@ private:
     void domainSettingsRequestComplete();
     
     /// adds one stream to the mix for a listening node
-    void addStreamToMixForListeningNodeWithStream(AudioMixerClientData& listenerNodeData,
+    void addStreamToMixForListeningNodeWithStream(AudioMixerSlave& slave, AudioMixerClientData& listenerNodeData,
+                                                  const PositionalAudioStream& streamToAdd,
+                                                  const float* streamSamples,
+                                                  const QUuid& sourceNodeID,
+                                                  const AvatarAudioStream& listeningNodeStream);
+
+    /// adds one stream to the cheap panned bed for a listening node, used for sources outside the HRTF budget
+    void addStreamToBedForListeningNodeWithStream(AudioMixerSlave& slave, AudioMixerClientData& listenerNodeData,
                                                   const PositionalAudioStream& streamToAdd,
+                                                  const float* streamSamples,
                                                   const QUuid& sourceNodeID,
                                                   const AvatarAudioStream& listeningNodeStream);
 
     float gainForSource(const PositionalAudioStream& streamToAdd, const AvatarAudioStream& listeningNodeStream,
-                        const glm::vec3& relativePosition, bool isEcho);
+                        const glm::vec3& relativePosition, bool isEcho) const;
     float azimuthForSource(const PositionalAudioStream& streamToAdd, const AvatarAudioStream& listeningNodeStream,
-                           const glm::vec3& relativePosition);
+                           const glm::vec3& relativePosition) const;
+
+    /// prepares a mix for one Node in the slave's buffers, returns false if the mix is silent
+    bool prepareMixForListeningNode(AudioMixerSlave& slave, Node* node);
+
+    /// a listener's frame on its way from the mixing threads, through the encoders, to the socket
+    struct ListenerMix {
+        QByteArray decodedBuffer;
+        QByteArray encodedBuffer;
+        uint hash { 0 };
+        bool hasAudio { false };
+        int encodedIndex { -1 }; // index of the mix whose encoded buffer this listener sends, possibly its own
+    };
+
+    /// mixes for one Node out of the slave's buffers, safe to call from any mixing thread
+    void mixForListeningNode(AudioMixerSlave& slave, Node* node, ListenerMix& mix);
+
+    /// points every mix at the first earlier mix it can share an encoded frame with, returns the mixes to encode
+    std::vector<int> findUniqueEncodes(const FrameVector<SharedNodePointer>& listeners, FrameVector<ListenerMix>& mixes);
 
-    /// prepares and sends a mix to one Node
-    bool prepareMixForListeningNode(Node* node);
+    /// mixes and encodes one frame for every listener, the streams must already have been popped for the frame
+    void mixFrame(const FrameVector<SharedNodePointer>& listeners, FrameVector<ListenerMix>& mixes);
+
+    /// writes the mixed audio packet for one Node, encodedBuffer is null for a run of numSilentFrames silent frames
+    std::unique_ptr<NLPacket> createMixPacketForListeningNode(Node* node, const QByteArray* encodedBuffer, int numSilentFrames);
 
     /// Send Audio Environment packet for a single node
     void sendAudioEnvironmentPacket(SharedNodePointer node);
 
     void perSecondActions();
 
-    QString percentageForMixStats(int counter);
+    QString percentageForMixStats(int counter, int totalMixes);
 
     bool shouldMute(float quietestFrame);
 
@@ -84,19 +118,24 @@ private:
     float _performanceThrottlingRatio;
     float _attenuationPerDoublingInDistance;
     float _noiseMutingThreshold;
+    int _hrtfSourceBudget { 0 }; // max sources HRTF rendered per listener, 0 for no limit
     int _numStatFrames { 0 };
     int _sumListeners { 0 };
-    int _hrtfRenders { 0 };
-    int _hrtfSilentRenders { 0 };
-    int _hrtfStruggleRenders { 0 };
-    int _manualStereoMixes { 0 };
-    int _manualEchoMixes { 0 };
-    int _totalMixes { 0 };
+    int _sumEncodes { 0 };
+    int _sumReusedEncodes { 0 };
+    int _sumSkippedSilentFrames { 0 };
+    int _maxSilentRunFrames { 10 }; // silent frames covered by one silent packet
+
+    // kept for as long as the mixer runs, to alert on
+    MetricsCounter& _framesMetric;
+    MetricsCounter& _frameOverrunsMetric;
+    MetricsHistogram& _frameSecondsMetric;
+    MetricsGauge& _listenersMetric;
 
     QString _codecPreferenceOrder;
 
-    float _mixedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
-    int16_t _clampedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    // each mixing thread has its own scratch buffers and mix stats in its slave
+    AudioMixerSlavePool _slavePool;
 
     QHash<QString, AABox> _audioZones;
     struct ZonesSettings {
@@ -191,6 +191,8 @@ void AudioMixerClientData::checkBuffersBeforeFrameSend() {
             stream->updateLastPopOutputLoudnessAndTrailingLoudness();
         }
 
+        prepareSamplesForStream(*stream);
+
         static const int INJECTOR_MAX_INACTIVE_BLOCKS = 500;
 
         // if we don't have new data for an injected stream in the last INJECTOR_MAX_INACTIVE_BLOCKS then
@@ -203,6 +205,7 @@ void AudioMixerClientData::checkBuffersBeforeFrameSend() {
             emit injectorStreamFinished(it->second->getStreamIdentifier());
 
             // erase the stream to drop our ref to the shared pointer and remove it
+            _preparedBlocks.erase(it->first);
             it = _audioStreams.erase(it);
         } else {
             ++it;
@@ -210,6 +213,35 @@ void AudioMixerClientData::checkBuffersBeforeFrameSend() {
     }
 }
 
+void AudioMixerClientData::prepareSamplesForStream(const PositionalAudioStream& stream) {
+    auto& block = _preparedBlocks[stream.getStreamIdentifier()];
+
+    // when the pop failed the last output is still what gets repeated with fade, so it is prepared either way
+    AudioRingBuffer::ConstIterator popOutput = stream.getLastPopOutput();
+    block.hasOutput = !popOutput.isNull();
+
+    if (block.hasOutput) {
+        int numSamples = stream.isStereo() ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO
+                                           : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+        int16_t streamBlock[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        popOutput.readSamples(streamBlock, numSamples);
+
+        for (int i = 0; i < numSamples; ++i) {
+            block.samples[i] = (float)streamBlock[i] * (1 / 32768.0f);
+        }
+    }
+}
+
+const float* AudioMixerClientData::getPreparedSamples(const QUuid& streamID) const {
+    auto it = _preparedBlocks.find(streamID);
+    if (it != _preparedBlocks.end() && it->second.hasOutput) {
+        return it->second.samples;
+    }
+
+    return nullptr;
+}
+
 bool AudioMixerClientData::shouldSendStats(int frameNumber) {
     return frameNumber == _frameToSendStats;
 }
@@ -298,6 +330,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
         upstreamStats["not_mixed"] = (double) streamStats._consecutiveNotMixedCount;
         upstreamStats["overflows"] = (double) streamStats._overflowCount;
         upstreamStats["silents_dropped"] = (double) streamStats._framesDropped;
+        upstreamStats["time_stretched"] = (double) streamStats._framesTimeStretched;
         upstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
         upstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
         upstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
@@ -327,6 +360,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
             upstreamStats["not_mixed"] = (double) streamStats._consecutiveNotMixedCount;
             upstreamStats["overflows"] = (double) streamStats._overflowCount;
             upstreamStats["silents_dropped"] = (double) streamStats._framesDropped;
+            upstreamStats["time_stretched"] = (double) streamStats._framesTimeStretched;
             upstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
             upstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
             upstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
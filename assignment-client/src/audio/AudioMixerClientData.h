@@ -54,6 +54,12 @@ public:
 
     void checkBuffersBeforeFrameSend();
 
+    // returns the samples popped from the given stream this frame, converted to float (scaled by 1/32768)
+    // they are prepared once in checkBuffersBeforeFrameSend and shared by every listener mixing this stream,
+    // so this is safe to call from any mixing thread until the next checkBuffersBeforeFrameSend
+    // returns nullptr if the stream has no output to mix
+    const float* getPreparedSamples(const QUuid& streamID) const;
+
     void removeDeadInjectedStreams();
 
     QJsonObject getAudioStreamStats();
@@ -63,6 +69,13 @@ public:
     void incrementOutgoingMixedAudioSequenceNumber() { _outgoingMixedAudioSequenceNumber++; }
     quint16 getOutgoingSequenceNumber() const { return _outgoingMixedAudioSequenceNumber; }
 
+    // number of sources left out of this listener's HRTF budget, written by whichever mixing thread mixed it
+    void recordCulledSources(int numCulled) { _culledSourcesSum += numCulled; ++_culledSourcesFrames; }
+    float getAverageCulledSources() const {
+        return _culledSourcesFrames > 0 ? (float) _culledSourcesSum / _culledSourcesFrames : 0.0f;
+    }
+    void resetCulledSources() { _culledSourcesSum = 0; _culledSourcesFrames = 0; }
+
     // uses randomization to have the AudioMixer send a stats packet to this node around every second
     bool shouldSendStats(int frameNumber);
 
@@ -78,6 +91,22 @@ public:
         }
     }
 
+    // stateless codecs hand the same encoder to every client, so listeners with the same encoder
+    // and the same mix produce the same encoded frame
+    const Encoder* getEncoder() const { return _encoder; }
+
+    // while the mix is silent only one packet goes out per run of up to maxRunFrames frames
+    // returns the frames the silent packet due now covers, or 0 if this frame is covered by an earlier one
+    int nextSilentRun(int maxRunFrames) {
+        if (_silentRunFramesLeft > 0) {
+            --_silentRunFramesLeft;
+            return 0;
+        }
+        _silentRunFramesLeft = maxRunFrames - 1;
+        return maxRunFrames;
+    }
+    void endSilentRun() { _silentRunFramesLeft = 0; }
+
     QString getCodecName() { return _selectedCodecName; }
 
 signals:
@@ -91,6 +120,14 @@ private:
     QReadWriteLock _streamsLock;
     AudioStreamMap _audioStreams; // microphone stream from avatar is stored under key of null UUID
 
+    void prepareSamplesForStream(const PositionalAudioStream& stream);
+
+    struct PreparedBlock {
+        float samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        bool hasOutput { false };
+    };
+    std::unordered_map<QUuid, PreparedBlock> _preparedBlocks; // keyed by stream identifier, like _audioStreams
+
     using HRTFMap = std::unordered_map<QUuid, AudioHRTF>;
     using NodeSourcesHRTFMap = std::unordered_map<QUuid, HRTFMap>;
     NodeSourcesHRTFMap _nodeSourcesHRTFMap;
@@ -101,6 +138,11 @@ private:
 
     int _frameToSendStats { 0 };
 
+    int _culledSourcesSum { 0 };
+    int _culledSourcesFrames { 0 };
+
+    int _silentRunFramesLeft { 0 }; // frames still covered by the last silent packet
+
     CodecPluginPointer _codec;
     QString _selectedCodecName;
     Encoder* _encoder{ nullptr }; // for outbound mixed stream
@@ -0,0 +1,142 @@
+//
+//  AudioMixerSlavePool.cpp
+//  assignment-client/src/audio
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerSlavePool.h"
+
+#include <algorithm>
+
+#include <SharedUtil.h>
+
+void AudioMixerSlave::Stats::accumulate(const Stats& other) {
+    hrtfRenders += other.hrtfRenders;
+    hrtfSilentRenders += other.hrtfSilentRenders;
+    hrtfStruggleRenders += other.hrtfStruggleRenders;
+    manualStereoMixes += other.manualStereoMixes;
+    manualEchoMixes += other.manualEchoMixes;
+    totalMixes += other.totalMixes;
+    bedMixes += other.bedMixes;
+
+    listeners += other.listeners;
+    frames = std::max(frames, other.frames);
+    mixUsecs += other.mixUsecs;
+    maxFrameMixUsecs = std::max(maxFrameMixUsecs, other.maxFrameMixUsecs);
+}
+
+AudioMixerSlavePool::AudioMixerSlavePool(int numThreads) {
+    setNumThreads(numThreads);
+}
+
+AudioMixerSlavePool::~AudioMixerSlavePool() {
+    stopThreads();
+}
+
+void AudioMixerSlavePool::setNumThreads(int numThreads) {
+    numThreads = std::max(numThreads, 1);
+
+    if (numThreads == this->numThreads()) {
+        return;
+    }
+
+    stopThreads();
+
+    _slaves.clear();
+    for (int i = 0; i < numThreads; ++i) {
+        _slaves.emplace_back(new AudioMixerSlave);
+    }
+
+    // the first slave is run by the thread calling mix, the rest get a thread of their own
+    for (int i = 1; i < numThreads; ++i) {
+        _threads.emplace_back(&AudioMixerSlavePool::threadMain, this, i, _frame);
+    }
+}
+
+void AudioMixerSlavePool::mix(int count, const MixFunction& function) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _function = function;
+        _count = count;
+        _nextIndex = 0;
+        _pendingThreads = (int) _threads.size();
+        ++_frame;
+    }
+    _frameCondition.notify_all();
+
+    runSlave(*_slaves[0]);
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _doneCondition.wait(lock, [this]{ return _pendingThreads == 0; });
+        _function = nullptr;
+    }
+}
+
+void AudioMixerSlavePool::runSlave(AudioMixerSlave& slave) {
+    auto start = usecTimestampNow();
+
+    // work is handed out one index at a time so a slave that gets cheap listeners picks up more of them
+    int index;
+    while ((index = _nextIndex++) < _count) {
+        _function(slave, index);
+    }
+
+    slave.stats.frameUsecs += usecTimestampNow() - start;
+}
+
+void AudioMixerSlavePool::finishFrame() {
+    for (auto& slave : _slaves) {
+        auto& stats = slave->stats;
+        ++stats.frames;
+        stats.mixUsecs += stats.frameUsecs;
+        stats.maxFrameMixUsecs = std::max(stats.maxFrameMixUsecs, stats.frameUsecs);
+        stats.frameUsecs = 0;
+    }
+}
+
+void AudioMixerSlavePool::threadMain(int slaveIndex, int lastFrame) {
+    auto& slave = *_slaves[slaveIndex];
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _frameCondition.wait(lock, [&]{ return _isStopping || _frame != lastFrame; });
+
+            if (_isStopping) {
+                return;
+            }
+
+            lastFrame = _frame;
+        }
+
+        runSlave(slave);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pendingThreads == 0) {
+                _doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void AudioMixerSlavePool::stopThreads() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _frameCondition.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+    _threads.clear();
+
+    _isStopping = false;
+}
@@ -0,0 +1,110 @@
+//
+//  AudioMixerSlavePool.h
+//  assignment-client/src/audio
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AudioMixerSlavePool_h
+#define hifi_AudioMixerSlavePool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+#include <QtCore/QUuid>
+
+#include <AudioConstants.h>
+
+class PositionalAudioStream;
+
+// State owned by one mixing thread - the scratch buffers a listener's mix is built in and the stats for the mixes it did
+struct AudioMixerSlave {
+    struct Stats {
+        int hrtfRenders { 0 };
+        int hrtfSilentRenders { 0 };
+        int hrtfStruggleRenders { 0 };
+        int manualStereoMixes { 0 };
+        int manualEchoMixes { 0 };
+        int totalMixes { 0 };
+        int bedMixes { 0 };
+
+        int listeners { 0 };
+        int frames { 0 };
+        quint64 mixUsecs { 0 };
+        quint64 maxFrameMixUsecs { 0 };
+        quint64 frameUsecs { 0 }; // time spent on the frame being mixed, over all of its passes
+
+        void accumulate(const Stats& other);
+        void reset() { *this = Stats(); }
+    };
+
+    float mixedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    int16_t clampedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+
+    // sources competing for a listener's HRTF budget, reused from listener to listener
+    struct MixCandidate {
+        const PositionalAudioStream* stream;
+        const float* samples;
+        QUuid sourceNodeID;
+        float loudness; // estimated loudness at the listener
+    };
+    std::vector<MixCandidate> candidates;
+
+    Stats stats;
+};
+
+// Runs the per-listener mix over a fixed set of threads.
+// The thread calling mix() takes part as the first slave, so a pool of one thread mixes exactly like the old serial loop.
+class AudioMixerSlavePool {
+public:
+    // called once per listener index, on whichever slave picked that listener up
+    using MixFunction = std::function<void(AudioMixerSlave& slave, int index)>;
+
+    AudioMixerSlavePool(int numThreads = 1);
+    ~AudioMixerSlavePool();
+
+    void setNumThreads(int numThreads);
+    int numThreads() const { return (int) _slaves.size(); }
+
+    // runs function for every index in [0, count) and blocks until all of them are done
+    // a frame can take more than one pass, call finishFrame once all of them are done
+    void mix(int count, const MixFunction& function);
+    void finishFrame();
+
+    // only safe to call between calls to mix
+    AudioMixerSlave& getSlave(int index) { return *_slaves[index]; }
+
+private:
+    void runSlave(AudioMixerSlave& slave);
+    // lastFrame is the frame that was current when the thread was started, so it only picks up later ones
+    void threadMain(int slaveIndex, int lastFrame);
+    void stopThreads();
+
+    std::vector<std::unique_ptr<AudioMixerSlave>> _slaves;
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _frameCondition;
+    std::condition_variable _doneCondition;
+    int _frame { 0 };
+    int _pendingThreads { 0 };
+    bool _isStopping { false };
+
+    MixFunction _function;
+    int _count { 0 };
+    std::atomic<int> _nextIndex { 0 };
+};
+
+#endif // hifi_AudioMixerSlavePool_h
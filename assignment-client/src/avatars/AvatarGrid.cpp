@@ -0,0 +1,77 @@
+//
+//  AvatarGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarGrid.h"
+
+#include <algorithm>
+
+// each cell coordinate is packed into 21 bits of the key, positions beyond that are held at the edge of the grid
+// and positions that are not a number go in the middle
+const int COORDINATE_BITS = 21;
+const int MAX_COORDINATE = (1 << (COORDINATE_BITS - 1)) - 1;
+
+static int cellCoordinate(float coordinate) {
+    if (coordinate >= MAX_COORDINATE) {
+        return MAX_COORDINATE;
+    } else if (coordinate <= -MAX_COORDINATE) {
+        return -MAX_COORDINATE;
+    } else if (coordinate == coordinate) {
+        return (int) coordinate;
+    } else {
+        return 0;
+    }
+}
+
+static quint64 packCoordinate(int coordinate) {
+    return (quint64) (coordinate + MAX_COORDINATE);
+}
+
+void AvatarGrid::clear() {
+    _cells.clear();
+    _cellIndices.clear();
+}
+
+void AvatarGrid::insert(int avatar, const glm::vec3& position) {
+    glm::vec3 cellPosition = glm::floor(position / _cellSize);
+    glm::ivec3 coordinates(cellCoordinate(cellPosition.x), cellCoordinate(cellPosition.y), cellCoordinate(cellPosition.z));
+
+    quint64 key = (packCoordinate(coordinates.x) << (2 * COORDINATE_BITS))
+        | (packCoordinate(coordinates.y) << COORDINATE_BITS) | packCoordinate(coordinates.z);
+
+    auto it = _cellIndices.find(key);
+    if (it == _cellIndices.end()) {
+        it = _cellIndices.emplace(key, (int) _cells.size()).first;
+
+        Cell cell;
+        cell.minCorner = glm::vec3(coordinates) * _cellSize;
+        _cells.push_back(cell);
+    }
+
+    _cells[it->second].avatars.push_back(avatar);
+}
+
+void AvatarGrid::findCellsByDistance(const glm::vec3& position, std::vector<CellDistance>& cells) const {
+    cells.clear();
+
+    for (int i = 0; i < (int) _cells.size(); ++i) {
+        glm::vec3 minCorner = _cells[i].minCorner;
+        glm::vec3 maxCorner = minCorner + glm::vec3(_cellSize);
+
+        glm::vec3 nearOffset = glm::max(glm::max(minCorner - position, position - maxCorner), glm::vec3(0.0f));
+        glm::vec3 farOffset = glm::max(glm::abs(position - minCorner), glm::abs(position - maxCorner));
+
+        cells.push_back({ i, glm::length(nearOffset), glm::length(farOffset) });
+    }
+
+    std::sort(cells.begin(), cells.end(), [](const CellDistance& a, const CellDistance& b) {
+        return a.nearDistance < b.nearDistance;
+    });
+}
@@ -0,0 +1,56 @@
+//
+//  AvatarGrid.h
+//  assignment-client/src/avatars
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AvatarGrid_h
+#define hifi_AvatarGrid_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <QtCore/QtGlobal>
+
+// A uniform grid of avatar positions, rebuilt every frame, so that a listener can visit the other avatars
+// nearest first and stop once it has what it needs. Only the occupied cells are stored.
+class AvatarGrid {
+public:
+    struct Cell {
+        glm::vec3 minCorner;
+        std::vector<int> avatars; // the indices the avatars were inserted with
+    };
+
+    struct CellDistance {
+        int cell;
+        float nearDistance; // from the position to the nearest point of the cell
+        float farDistance; // from the position to the farthest corner of the cell
+    };
+
+    AvatarGrid(float cellSize) : _cellSize(cellSize) {}
+
+    void clear();
+    void insert(int avatar, const glm::vec3& position);
+
+    int getNumCells() const { return (int) _cells.size(); }
+    const Cell& getCell(int cell) const { return _cells[cell]; }
+
+    // fills cells with every occupied cell, ordered by their nearest distance from position
+    void findCellsByDistance(const glm::vec3& position, std::vector<CellDistance>& cells) const;
+
+private:
+    float _cellSize;
+    std::vector<Cell> _cells;
+    std::unordered_map<quint64, int> _cellIndices; // packed cell coordinates to index in _cells
+};
+
+#endif // hifi_AvatarGrid_h
@@ -9,8 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <cfloat>
-#include <random>
 #include <memory>
 
 #include <QtCore/QCoreApplication>
@@ -19,12 +19,14 @@
 #include <QtCore/QTimer>
 #include <QtCore/QThread>
 
+#include <FrameArena.h>
 #include <LogHandler.h>
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <UUID.h>
 #include <TryLocker.h>
+#include <shared/Tracing.h>
 
 #include "AvatarMixerClientData.h"
 #include "AvatarMixer.h"
@@ -34,18 +36,34 @@ const QString AVATAR_MIXER_LOGGING_NAME = "avatar-mixer";
 const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 60;
 const unsigned int AVATAR_DATA_SEND_INTERVAL_MSECS = (1.0f / (float) AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND) * 1000;
 
+// side of a cell in the grid the avatars are found in, in meters
+const float AVATAR_GRID_CELL_SIZE = 10.0f;
+
+// an avatar's priority for a listener grows with the time since the listener was last sent it,
+// and shrinks with its distance and when it is outside the listener's view
+const float OUT_OF_VIEW_PRIORITY_RATIO = 0.25f;
+const float MIN_PRIORITY_DISTANCE = 1.0f; // meters, avatars closer than this rank as if they were this far
+const float AVATAR_VIEW_RADIUS = 1.0f; // meters, the sphere around an avatar's position tested against the view
+
 AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     ThreadedAssignment(message),
-    _broadcastThread()
+    _broadcastThread(),
+    _framesMetric(Metrics::counter("hifi_avatar_mixer_frames_total", "Frames broadcast")),
+    _frameOverrunsMetric(Metrics::counter("hifi_avatar_mixer_frame_overruns_total",
+                                          "Frames that took longer to broadcast than the interval between them")),
+    _frameSecondsMetric(Metrics::histogram("hifi_avatar_mixer_frame_seconds", "Time taken to broadcast a frame",
+                                           Metrics::secondsBounds())),
+    _avatarGrid(AVATAR_GRID_CELL_SIZE)
 {
     // make sure we hear about node kills so we can tell the other nodes
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &AvatarMixer::nodeKilled);
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::AvatarData, this, "handleAvatarDataPacket");
+    packetReceiver.registerConcurrentListener(PacketType::AvatarData, this, "handleAvatarDataPacket");
     packetReceiver.registerListener(PacketType::AvatarIdentity, this, "handleAvatarIdentityPacket");
     packetReceiver.registerListener(PacketType::KillAvatar, this, "handleKillAvatarPacket");
     packetReceiver.registerListener(PacketType::NodeIgnoreRequest, this, "handleNodeIgnoreRequestPacket");
+    packetReceiver.registerListener(PacketType::AvatarQuery, this, "handleAvatarQueryPacket");
 
     auto nodeList = DependencyManager::get<NodeList>();
     connect(nodeList.data(), &NodeList::packetVersionMismatch, this, &AvatarMixer::handlePacketVersionMismatch);
@@ -64,14 +82,13 @@ AvatarMixer::~AvatarMixer() {
 // assuming 60 htz update rate.
 const float IDENTITY_SEND_PROBABILITY = 1.0f / 187.0f;
 
-// NOTE: some additional optimizations to consider.
-//    1) use the view frustum to cull those avatars that are out of view. Since avatar data doesn't need to be present
-//       if the avatar is not in view or in the keyhole.
 void AvatarMixer::broadcastAvatarData() {
+    TRACE_SCOPE("AvatarMixer::broadcastAvatarData");
+    auto frameStart = p_high_resolution_clock::now();
     int idleTime = AVATAR_DATA_SEND_INTERVAL_MSECS;
 
     if (_lastFrameTimestamp.time_since_epoch().count() > 0) {
-        auto idleDuration = p_high_resolution_clock::now() - _lastFrameTimestamp;
+        auto idleDuration = frameStart - _lastFrameTimestamp;
         idleTime = std::chrono::duration_cast<std::chrono::microseconds>(idleDuration).count();
     }
 
@@ -131,244 +148,262 @@ void AvatarMixer::broadcastAvatarData() {
 
     auto nodeList = DependencyManager::get<NodeList>();
 
-    // setup for distributed random floating point values
-    std::random_device randomDevice;
-    std::mt19937 generator(randomDevice());
-    std::uniform_real_distribution<float> distribution;
+    // everything a listener reads about the other avatars is snapshotted once per frame, up front,
+    // so that the listeners can be handled in parallel without touching each other's data
+    // (the lists only last for the frame, and are only grown here, so they come from the frame arena of this thread)
+    FrameArena::Scope frameScope;
+    FrameVector<AvatarSnapshot> avatars;
+    FrameVector<ListenerBroadcast> listeners;
+    FrameVector<std::unique_ptr<NLPacketList>> avatarPacketLists;
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-            if (!node->getLinkedData()) {
-                return false;
-            }
-            if (node->getType() != NodeType::Agent) {
-                return false;
-            }
-            if (!node->getActiveSocket()) {
-                return false;
-            }
-            return true;
-        },
-        [&](const SharedNodePointer& node) {
-            AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
-            MutexTryLocker lock(nodeData->getMutex());
-            if (!lock.isLocked()) {
-                return;
-            }
-            ++_sumListeners;
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        if (!node->getLinkedData()) {
+            return;
+        }
 
-            AvatarData& avatar = nodeData->getAvatar();
-            glm::vec3 myPosition = avatar.getClientGlobalPosition();
+        AvatarSnapshot snapshot;
+        snapshot.node = node;
+        snapshot.isListener = node->getType() == NodeType::Agent && node->getActiveSocket();
+        avatars.push_back(snapshot);
+    });
+
+    // each avatar is encoded once for the frame, on whichever thread picks it up,
+    // and every listener it goes to is sent the same bytes
+    _slavePool.broadcast((int) avatars.size(), [&](AvatarMixerSlave&, int index) {
+        snapshotAvatar(avatars[index]);
+    });
+
+    _avatarGrid.clear();
+    for (int i = 0; i < (int) avatars.size(); ++i) {
+        if (!avatars[i].isValid) {
+            continue;
+        }
+
+        _avatarGrid.insert(i, avatars[i].position);
+
+        if (avatars[i].isListener) {
+            ListenerBroadcast listener;
+            listener.avatarIndex = i;
+            listeners.push_back(listener);
+            avatarPacketLists.push_back(NLPacketList::create(PacketType::BulkAvatarData));
+        }
+    }
 
-            // reset the internal state for correct random number distribution
-            distribution.reset();
+    quint64 frameTimestamp = usecTimestampNow();
 
-            // reset the max distance for this frame
-            float maxAvatarDistanceThisFrame = 0.0f;
+    _slavePool.broadcast((int) listeners.size(), [&](AvatarMixerSlave& slave, int index) {
+        broadcastToListener(slave, avatars, frameTimestamp, listeners[index], *avatarPacketLists[index]);
+    });
 
-            // reset the number of sent avatars
-            nodeData->resetNumAvatarsSentLastFrame();
+    // sending stays on this thread, in node order
+    for (size_t i = 0; i < listeners.size(); ++i) {
+        auto& listener = listeners[i];
+        if (!listener.wasBroadcast) {
+            continue;
+        }
+        ++_sumListeners;
 
-            // keep a counter of the number of considered avatars
-            int numOtherAvatars = 0;
+        auto& node = avatars[listener.avatarIndex].node;
 
-            // keep track of outbound data rate specifically for avatar data
-            int numAvatarDataBytes = 0;
+        for (int identityIndex : listener.identitySends) {
+            const QByteArray& identityPacketData = avatars[identityIndex].identityPacketData;
 
-            // keep track of the number of other avatars held back in this frame
-            int numAvatarsHeldBack = 0;
+            auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, identityPacketData.size());
+            identityPacket->write(identityPacketData);
+            nodeList->sendPacket(std::move(identityPacket), *node);
 
-            // keep track of the number of other avatar frames skipped
-            int numAvatarsWithSkippedFrames = 0;
+            ++_sumIdentityPackets;
+        }
 
-            // use the data rate specifically for avatar data for FRD adjustment checks
-            float avatarDataRateLastSecond = nodeData->getOutboundAvatarDataKbps();
+        // close the current packet so that we're always sending something
+        avatarPacketLists[i]->closeCurrentPacket(true);
 
-            // Check if it is time to adjust what we send this client based on the observed
-            // bandwidth to this node. We do this once a second, which is also the window for
-            // the bandwidth reported by node->getOutboundBandwidth();
-            if (nodeData->getNumFramesSinceFRDAdjustment() > AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND) {
+        // send the avatar data PacketList
+        nodeList->sendPacketList(std::move(avatarPacketLists[i]), *node);
+    }
 
-                const float FRD_ADJUSTMENT_ACCEPTABLE_RATIO = 0.8f;
-                const float HYSTERISIS_GAP = (1 - FRD_ADJUSTMENT_ACCEPTABLE_RATIO);
-                const float HYSTERISIS_MIDDLE_PERCENTAGE =  (1 - (HYSTERISIS_GAP * 0.5f));
+    _lastFrameTimestamp = p_high_resolution_clock::now();
 
-                // get the current full rate distance so we can work with it
-                float currentFullRateDistance = nodeData->getFullRateDistance();
+    auto frameDuration = _lastFrameTimestamp - frameStart;
+    _framesMetric.add();
+    _frameSecondsMetric.observe(std::chrono::duration<double>(frameDuration).count());
+    if (frameDuration > std::chrono::milliseconds(AVATAR_DATA_SEND_INTERVAL_MSECS)) {
+        _frameOverrunsMetric.add();
+    }
+}
 
-                if (avatarDataRateLastSecond > _maxKbpsPerNode) {
+void AvatarMixer::snapshotAvatar(AvatarSnapshot& snapshot) {
+    const SharedNodePointer& node = snapshot.node;
+    AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
 
-                    // is the FRD greater than the farthest avatar?
-                    // if so, before we calculate anything, set it to that distance
-                    currentFullRateDistance = std::min(currentFullRateDistance, nodeData->getMaxAvatarDistance());
+    MutexTryLocker lock(nodeData->getMutex());
+    if (!lock.isLocked()) {
+        return;
+    }
 
-                    // we're adjusting the full rate distance to target a bandwidth in the middle
-                    // of the hysterisis gap
-                    currentFullRateDistance *= (_maxKbpsPerNode * HYSTERISIS_MIDDLE_PERCENTAGE) / avatarDataRateLastSecond;
+    AvatarData& avatar = nodeData->getAvatar();
 
-                    nodeData->setFullRateDistance(currentFullRateDistance);
-                    nodeData->resetNumFramesSinceFRDAdjustment();
-                } else if (currentFullRateDistance < nodeData->getMaxAvatarDistance()
-                           && avatarDataRateLastSecond < _maxKbpsPerNode * FRD_ADJUSTMENT_ACCEPTABLE_RATIO) {
-                    // we are constrained AND we've recovered to below the acceptable ratio
-                    // lets adjust the full rate distance to target a bandwidth in the middle of the hyterisis gap
-                    currentFullRateDistance *= (_maxKbpsPerNode * HYSTERISIS_MIDDLE_PERCENTAGE) / avatarDataRateLastSecond;
+    snapshot.isValid = true;
+    snapshot.position = avatar.getClientGlobalPosition();
+    snapshot.lastReceivedSequenceNumber = nodeData->getLastReceivedSequenceNumber();
+    snapshot.identityChangeTimestamp = nodeData->getIdentityChangeTimestamp();
+    if (snapshot.identityChangeTimestamp.time_since_epoch().count() > 0) {
+        snapshot.identityPacketData = nodeData->getIdentityPacketData(node->getUUID());
+    }
 
-                    nodeData->setFullRateDistance(currentFullRateDistance);
-                    nodeData->resetNumFramesSinceFRDAdjustment();
-                }
-            } else {
-                nodeData->incrementNumFramesSinceFRDAdjustment();
-            }
+    // the segments lead with the avatar's UUID, so that a listener appends one of them in a single write
+    QByteArray uuidBytes = node->getUUID().toRfc4122();
+    avatar.setJointCompressionBits(_jointRotationBits, _jointTranslationBits);
+    snapshot.avatarSegment = uuidBytes + avatar.toByteArray(false, false);
+    snapshot.fullAvatarSegment = uuidBytes + avatar.toByteArray(false, true);
 
-            // setup a PacketList for the avatarPackets
-            auto avatarPacketList = NLPacketList::create(PacketType::BulkAvatarData);
+    if (snapshot.isListener) {
+        // this version of the joint-states is done, so the next one can notice differences from it
+        avatar.doneEncoding(false);
+    }
+}
 
-            // this is an AGENT we have received head data from
-            // send back a packet with other active node data to this node
-            nodeList->eachMatchingNode(
-                [&](const SharedNodePointer& otherNode)->bool {
-                    // make sure we have data for this avatar, that it isn't the same node,
-                    // and isn't an avatar that the viewing node has ignored
-                    if (!otherNode->getLinkedData()
-                        || otherNode->getUUID() == node->getUUID()
-                        || node->isIgnoringNodeWithID(otherNode->getUUID())) {
-                        return false;
-                    } else {
-                        return true;
-                    }
-                },
-                [&](const SharedNodePointer& otherNode) {
-                    ++numOtherAvatars;
+void AvatarMixer::broadcastToListener(AvatarMixerSlave& slave, const FrameVector<AvatarSnapshot>& avatars, quint64 frameTimestamp,
+                                      ListenerBroadcast& listener, NLPacketList& avatarPacketList) {
+    const AvatarSnapshot& listenerAvatar = avatars[listener.avatarIndex];
+    const SharedNodePointer& node = listenerAvatar.node;
 
-                    AvatarMixerClientData* otherNodeData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
-                    MutexTryLocker lock(otherNodeData->getMutex());
-                    if (!lock.isLocked()) {
-                        return;
-                    }
+    AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+    MutexTryLocker lock(nodeData->getMutex());
+    if (!lock.isLocked()) {
+        return;
+    }
+    listener.wasBroadcast = true;
 
-                    // make sure we send out identity packets to and from new arrivals.
-                    bool forceSend = !otherNodeData->checkAndSetHasReceivedFirstPacketsFrom(node->getUUID());
+    glm::vec3 myPosition = listenerAvatar.position;
 
-                    if (otherNodeData->getIdentityChangeTimestamp().time_since_epoch().count() > 0
-                        && (forceSend
-                            || otherNodeData->getIdentityChangeTimestamp() > _lastFrameTimestamp
-                            || distribution(generator) < IDENTITY_SEND_PROBABILITY)) {
+    // reset the internal state for correct random number distribution
+    auto& distribution = slave.distribution;
+    auto& generator = slave.generator;
+    distribution.reset();
 
-                        QByteArray individualData = otherNodeData->getAvatar().identityByteArray();
+    // reset the number of sent avatars
+    nodeData->resetNumAvatarsSentLastFrame();
 
-                        auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, individualData.size());
+    // keep track of outbound data rate specifically for avatar data
+    int numAvatarDataBytes = 0;
 
-                        individualData.replace(0, NUM_BYTES_RFC4122_UUID, otherNode->getUUID().toRfc4122());
+    // keep track of the number of other avatars held back in this frame
+    int numAvatarsHeldBack = 0;
 
-                        identityPacket->write(individualData);
+    // keep track of the number of other avatar frames skipped
+    int numAvatarsWithSkippedFrames = 0;
 
-                        nodeList->sendPacket(std::move(identityPacket), *node);
+    // until the listener has told us what it is looking at, every avatar counts as in view
+    bool hasViewFrustum = nodeData->hasViewFrustum();
+    const ViewFrustum& viewFrustum = nodeData->getViewFrustum();
 
-                        ++_sumIdentityPackets;
-                    }
+    // rank every other avatar with data this listener hasn't been sent yet
+    auto& priorities = slave.priorities;
+    priorities.clear();
 
-                    AvatarData& otherAvatar = otherNodeData->getAvatar();
-                    //  Decide whether to send this avatar's data based on it's distance from us
+    auto& cells = slave.cells;
+    _avatarGrid.findCellsByDistance(myPosition, cells);
 
-                    //  The full rate distance is the distance at which EVERY update will be sent for this avatar
-                    //  at twice the full rate distance, there will be a 50% chance of sending this avatar's update
-                    glm::vec3 otherPosition = otherAvatar.getClientGlobalPosition();
-                    float distanceToAvatar = glm::length(myPosition - otherPosition);
+    for (auto& cellDistance : cells) {
+        for (int otherIndex : _avatarGrid.getCell(cellDistance.cell).avatars) {
+            const AvatarSnapshot& otherAvatar = avatars[otherIndex];
+            const SharedNodePointer& otherNode = otherAvatar.node;
 
-                    // potentially update the max full rate distance for this frame
-                    maxAvatarDistanceThisFrame = std::max(maxAvatarDistanceThisFrame, distanceToAvatar);
+            // make sure it isn't the same node, and isn't an avatar that the viewing node has ignored
+            if (otherIndex == listener.avatarIndex || node->isIgnoringNodeWithID(otherNode->getUUID())) {
+                continue;
+            }
 
-                    if (distanceToAvatar != 0.0f
-                        && distribution(generator) > (nodeData->getFullRateDistance() / distanceToAvatar)) {
-                        return;
-                    }
+            // make sure we send out identity packets to and from new arrivals.
+            bool forceSend = !nodeData->checkAndSetHasReceivedFirstPacketsFrom(otherNode->getUUID());
 
-                    AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(otherNode->getUUID());
-                    AvatarDataSequenceNumber lastSeqFromSender = otherNodeData->getLastReceivedSequenceNumber();
+            if (otherAvatar.identityChangeTimestamp.time_since_epoch().count() > 0
+                && (forceSend
+                    || otherAvatar.identityChangeTimestamp > _lastFrameTimestamp
+                    || distribution(generator) < IDENTITY_SEND_PROBABILITY)) {
+                listener.identitySends.push_back(otherIndex);
+            }
 
-                    if (lastSeqToReceiver > lastSeqFromSender && lastSeqToReceiver != UINT16_MAX) {
-                        // we got out out of order packets from the sender, track it
-                        otherNodeData->incrementNumOutOfOrderSends();
-                    }
+            AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(otherNode->getUUID());
+            AvatarDataSequenceNumber lastSeqFromSender = otherAvatar.lastReceivedSequenceNumber;
 
-                    // make sure we haven't already sent this data from this sender to this receiver
-                    // or that somehow we haven't sent
-                    if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
-                        ++numAvatarsHeldBack;
-                        return;
-                    } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
-                        // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
-                        ++numAvatarsWithSkippedFrames;
-                    }
+            if (lastSeqToReceiver > lastSeqFromSender && lastSeqToReceiver != UINT16_MAX) {
+                // we got out out of order packets from the sender, track it
+                reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData())->incrementNumOutOfOrderSends();
+            }
 
-                    // we're going to send this avatar
+            // make sure we haven't already sent this data from this sender to this receiver
+            // or that somehow we haven't sent
+            if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
+                ++numAvatarsHeldBack;
+                continue;
+            }
 
-                    // increment the number of avatars sent to this reciever
-                    nodeData->incrementNumAvatarsSentLastFrame();
+            // an avatar this listener has never been sent ranks above all the others
+            quint64 lastBroadcastTime = nodeData->getLastBroadcastTime(otherNode->getUUID());
+            float secondsSinceLastBroadcast = lastBroadcastTime == 0 ? FLT_MAX
+                : (float) (frameTimestamp - lastBroadcastTime) / (float) USECS_PER_SECOND;
 
-                    // set the last sent sequence number for this sender on the receiver
-                    nodeData->setLastBroadcastSequenceNumber(otherNode->getUUID(),
-                                                             otherNodeData->getLastReceivedSequenceNumber());
+            float distanceToAvatar = std::max(glm::length(myPosition - otherAvatar.position), MIN_PRIORITY_DISTANCE);
+            bool isInView = !hasViewFrustum || viewFrustum.sphereIntersectsKeyhole(otherAvatar.position, AVATAR_VIEW_RADIUS);
 
-                    // start a new segment in the PacketList for this avatar
-                    avatarPacketList->startSegment();
+            AvatarPriority candidate;
+            candidate.priority = secondsSinceLastBroadcast * (isInView ? 1.0f : OUT_OF_VIEW_PRIORITY_RATIO) / distanceToAvatar;
+            candidate.avatarIndex = otherIndex;
+            candidate.lastBroadcastSequenceNumber = lastSeqToReceiver;
+            priorities.push_back(candidate);
+        }
+    }
 
-                    numAvatarDataBytes += avatarPacketList->write(otherNode->getUUID().toRfc4122());
-                    numAvatarDataBytes +=
-                        avatarPacketList->write(otherAvatar.toByteArray(false, distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO));
+    std::sort(priorities.begin(), priorities.end(), [](const AvatarPriority& a, const AvatarPriority& b) {
+        return a.priority > b.priority;
+    });
 
-                    avatarPacketList->endSegment();
-            });
+    // this is an AGENT we have received head data from
+    // send back a packet with other active node data to this node, from the top of the ranking
+    // for as long as this listener's share of the bandwidth for the frame lasts - the avatars left out
+    // rank higher next frame, since they have waited longer
+    const int maxFrameBytes = (int) (_maxKbpsPerNode * BYTES_PER_KILOBIT / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
 
-            // close the current packet so that we're always sending something
-            avatarPacketList->closeCurrentPacket(true);
-
-            // send the avatar data PacketList
-            nodeList->sendPacketList(std::move(avatarPacketList), *node);
-
-            // record the bytes sent for other avatar data in the AvatarMixerClientData
-            nodeData->recordSentAvatarData(numAvatarDataBytes);
+    for (auto& candidate : priorities) {
+        if (numAvatarDataBytes >= maxFrameBytes) {
+            break;
+        }
 
-            // record the number of avatars held back this frame
-            nodeData->recordNumOtherAvatarStarves(numAvatarsHeldBack);
-            nodeData->recordNumOtherAvatarSkips(numAvatarsWithSkippedFrames);
+        const AvatarSnapshot& otherAvatar = avatars[candidate.avatarIndex];
+        const SharedNodePointer& otherNode = otherAvatar.node;
 
-            if (numOtherAvatars == 0) {
-                // update the full rate distance to FLOAT_MAX since we didn't have any other avatars to send
-                nodeData->setMaxAvatarDistance(FLT_MAX);
-            } else {
-                nodeData->setMaxAvatarDistance(maxAvatarDistanceThisFrame);
-            }
+        AvatarDataSequenceNumber lastSeqFromSender = otherAvatar.lastReceivedSequenceNumber;
+        if (lastSeqFromSender - candidate.lastBroadcastSequenceNumber > 1) {
+            // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
+            ++numAvatarsWithSkippedFrames;
         }
-    );
-
-    // We're done encoding this version of the otherAvatars.  Update their "lastSent" joint-states so
-    // that we can notice differences, next time around.
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& otherNode)->bool {
-            if (!otherNode->getLinkedData()) {
-                return false;
-            }
-            if (otherNode->getType() != NodeType::Agent) {
-                return false;
-            }
-            if (!otherNode->getActiveSocket()) {
-                return false;
-            }
-            return true;
-        },
-        [&](const SharedNodePointer& otherNode) {
-            AvatarMixerClientData* otherNodeData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
-            MutexTryLocker lock(otherNodeData->getMutex());
-            if (!lock.isLocked()) {
-                return;
-            }
-            AvatarData& otherAvatar = otherNodeData->getAvatar();
-            otherAvatar.doneEncoding(false);
-        });
 
-    _lastFrameTimestamp = p_high_resolution_clock::now();
+        // we're going to send this avatar
+
+        // increment the number of avatars sent to this reciever
+        nodeData->incrementNumAvatarsSentLastFrame();
+
+        // set the last sent sequence number and time for this sender on the receiver
+        nodeData->setLastBroadcastSequenceNumber(otherNode->getUUID(), lastSeqFromSender);
+        nodeData->setLastBroadcastTime(otherNode->getUUID(), frameTimestamp);
+
+        // start a new segment in the PacketList for this avatar
+        avatarPacketList.startSegment();
+
+        numAvatarDataBytes += avatarPacketList.write(distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO
+                                                      ? otherAvatar.fullAvatarSegment : otherAvatar.avatarSegment);
+
+        avatarPacketList.endSegment();
+    }
+
+    // record the bytes sent for other avatar data in the AvatarMixerClientData
+    nodeData->recordSentAvatarData(numAvatarDataBytes);
+
+    // record the number of avatars held back this frame
+    nodeData->recordNumOtherAvatarStarves(numAvatarsHeldBack);
+    nodeData->recordNumOtherAvatarSkips(numAvatarsWithSkippedFrames);
 }
 
 void AvatarMixer::nodeKilled(SharedNodePointer killedNode) {
@@ -440,6 +475,17 @@ void AvatarMixer::handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage>
     senderNode->parseIgnoreRequestMessage(message);
 }
 
+void AvatarMixer::handleAvatarQueryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->getOrCreateLinkedData(senderNode);
+
+    AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
+    if (nodeData != nullptr) {
+        QMutexLocker nodeDataLocker(&nodeData->getMutex());
+        nodeData->readViewFrustumPacket(message->getMessage());
+    }
+}
+
 void AvatarMixer::sendStatsPacket() {
     QJsonObject statsObject;
     statsObject["average_listeners_last_second"] = (float) _sumListeners / (float) _numStatFrames;
@@ -448,6 +494,7 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["trailing_sleep_percentage"] = _trailingSleepRatio * 100;
     statsObject["performance_throttling_ratio"] = _performanceThrottlingRatio;
+    statsObject["frame_arena_high_water_kb"] = (double) FrameArena::getHighWaterMark() / 1024.0;
 
     QJsonObject avatarsObject;
 
@@ -549,4 +596,37 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
 
     _maxKbpsPerNode = nodeBandwidthValue.toDouble(DEFAULT_NODE_SEND_BANDWIDTH) * KILO_PER_MEGA;
     qDebug() << "The maximum send bandwidth per node is" << _maxKbpsPerNode << "kbps.";
+
+    const QString AUTO_THREADS = "auto_threads";
+    const QString NUM_THREADS = "num_threads";
+    QJsonObject avatarMixerGroupObject = domainSettings[AVATAR_MIXER_SETTINGS_KEY].toObject();
+
+    int numThreads = 1;
+    if (avatarMixerGroupObject[AUTO_THREADS].toBool()) {
+        numThreads = QThread::idealThreadCount();
+    } else {
+        bool ok;
+        numThreads = avatarMixerGroupObject[NUM_THREADS].toString().toInt(&ok);
+        if (!ok) {
+            numThreads = 1;
+        }
+    }
+
+    _slavePool.setNumThreads(numThreads);
+    qDebug() << "Broadcasting with" << _slavePool.numThreads() << "thread(s)";
+
+    const QString JOINT_ROTATION_BITS = "joint_rotation_bits";
+    const QString JOINT_TRANSLATION_BITS = "joint_translation_bits";
+
+    bool ok;
+    int jointRotationBits = avatarMixerGroupObject[JOINT_ROTATION_BITS].toString().toInt(&ok);
+    _jointRotationBits = ok ? glm::clamp(jointRotationBits, MIN_JOINT_COMPRESSION_BITS, MAX_JOINT_ROTATION_BITS)
+        : DEFAULT_JOINT_ROTATION_BITS;
+
+    int jointTranslationBits = avatarMixerGroupObject[JOINT_TRANSLATION_BITS].toString().toInt(&ok);
+    _jointTranslationBits = ok ? glm::clamp(jointTranslationBits, MIN_JOINT_COMPRESSION_BITS, MAX_JOINT_TRANSLATION_BITS)
+        : DEFAULT_JOINT_TRANSLATION_BITS;
+
+    qDebug() << "Sending joint rotations at" << _jointRotationBits << "bits and translations at"
+        << _jointTranslationBits << "bits per component";
 }
@@ -15,10 +15,20 @@
 #ifndef hifi_AvatarMixer_h
 #define hifi_AvatarMixer_h
 
+#include <memory>
+#include <vector>
+
+#include <AvatarData.h>
+#include <FrameArena.h>
+#include <Metrics.h>
+#include <NLPacketList.h>
 #include <PortableHighResolutionClock.h>
 
 #include <ThreadedAssignment.h>
 
+#include "AvatarGrid.h"
+#include "AvatarMixerSlavePool.h"
+
 /// Handles assignments of type AvatarMixer - distribution of avatar data to various clients
 class AvatarMixer : public ThreadedAssignment {
     Q_OBJECT
@@ -38,12 +48,42 @@ private slots:
     void handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message);
     void handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAvatarQueryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void domainSettingsRequestComplete();
     void handlePacketVersionMismatch(PacketType type, const HifiSockAddr& senderSockAddr, const QUuid& senderUUID);
 
 
 private:
+    /// what the listeners read about one avatar, snapshotted at the start of a frame
+    struct AvatarSnapshot {
+        SharedNodePointer node;
+        bool isListener { false };
+        bool isValid { false }; // false when the avatar's data was busy, it is skipped for the frame
+        glm::vec3 position;
+        AvatarDataSequenceNumber lastReceivedSequenceNumber { 0 };
+        p_high_resolution_clock::time_point identityChangeTimestamp;
+        QByteArray identityPacketData;
+        QByteArray avatarSegment; // the avatar's UUID followed by its encoded data, as it goes in a BulkAvatarData
+        QByteArray fullAvatarSegment; // the same, for the updates that send every joint
+    };
+
+    /// a listener's frame on its way from the broadcasting threads to the socket, its avatar data is written
+    /// into a packet list of its own
+    struct ListenerBroadcast {
+        int avatarIndex { -1 }; // the listener's own snapshot
+        std::vector<int> identitySends; // the snapshots whose identity goes out to this listener
+        bool wasBroadcast { false };
+    };
+
     void broadcastAvatarData();
+
+    /// reads and encodes one avatar for the frame, safe to call from any broadcasting thread
+    void snapshotAvatar(AvatarSnapshot& snapshot);
+
+    /// fills in the frame for one listener, safe to call from any broadcasting thread
+    void broadcastToListener(AvatarMixerSlave& slave, const FrameVector<AvatarSnapshot>& avatars, quint64 frameTimestamp,
+                             ListenerBroadcast& listener, NLPacketList& avatarPacketList);
+
     void parseDomainServerSettings(const QJsonObject& domainSettings);
 
     QThread _broadcastThread;
@@ -57,9 +97,23 @@ private:
     int _numStatFrames { 0 };
     int _sumIdentityPackets { 0 };
 
+    // kept for as long as the mixer runs, to alert on
+    MetricsCounter& _framesMetric;
+    MetricsCounter& _frameOverrunsMetric;
+    MetricsHistogram& _frameSecondsMetric;
+
     float _maxKbpsPerNode = 0.0f;
 
+    int _jointRotationBits { DEFAULT_JOINT_ROTATION_BITS };
+    int _jointTranslationBits { DEFAULT_JOINT_TRANSLATION_BITS };
+
     QTimer* _broadcastTimer = nullptr;
+
+    // each broadcasting thread has its own random number generator in its slave
+    AvatarMixerSlavePool _slavePool;
+
+    // where the avatars snapshotted for the frame are, only written before the slaves start
+    AvatarGrid _avatarGrid;
 };
 
 #endif // hifi_AvatarMixer_h
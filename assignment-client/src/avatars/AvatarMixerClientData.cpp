@@ -10,6 +10,7 @@
 //
 
 #include <udt/PacketHeaders.h>
+#include <UUID.h>
 
 #include "AvatarMixerClientData.h"
 
@@ -29,6 +30,15 @@ bool AvatarMixerClientData::checkAndSetHasReceivedFirstPacketsFrom(const QUuid&
     return true;
 }
 
+const QByteArray& AvatarMixerClientData::getIdentityPacketData(const QUuid& nodeUUID) {
+    if (_identityPacketData.isEmpty() || _identityPacketDataTimestamp != _identityChangeTimestamp) {
+        _identityPacketData = _avatar->identityByteArray();
+        _identityPacketData.replace(0, NUM_BYTES_RFC4122_UUID, nodeUUID.toRfc4122());
+        _identityPacketDataTimestamp = _identityChangeTimestamp;
+    }
+    return _identityPacketData;
+}
+
 uint16_t AvatarMixerClientData::getLastBroadcastSequenceNumber(const QUuid& nodeUUID) const {
     // return the matching PacketSequenceNumber, or the default if we don't have it
     auto nodeMatch = _lastBroadcastSequenceNumbers.find(nodeUUID);
@@ -39,14 +49,34 @@ uint16_t AvatarMixerClientData::getLastBroadcastSequenceNumber(const QUuid& node
     }
 }
 
+void AvatarMixerClientData::removeLastBroadcastSequenceNumber(const QUuid& nodeUUID) {
+    _lastBroadcastSequenceNumbers.erase(nodeUUID);
+    _lastBroadcastTimes.erase(nodeUUID);
+}
+
+quint64 AvatarMixerClientData::getLastBroadcastTime(const QUuid& nodeUUID) const {
+    auto nodeMatch = _lastBroadcastTimes.find(nodeUUID);
+    if (nodeMatch != _lastBroadcastTimes.end()) {
+        return nodeMatch->second;
+    } else {
+        return 0;
+    }
+}
+
+void AvatarMixerClientData::readViewFrustumPacket(const QByteArray& message) {
+    // a bad frustum is dropped, the last good one stays in use
+    if (_viewFrustum.fromByteArray(message)) {
+        _hasViewFrustum = true;
+    }
+}
+
 void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["display_name"] = _avatar->getDisplayName();
-    jsonObject["full_rate_distance"] = _fullRateDistance;
-    jsonObject["max_av_distance"] = _maxAvatarDistance;
+    jsonObject["has_view_frustum"] = _hasViewFrustum;
     jsonObject["num_avs_sent_last_frame"] = _numAvatarsSentLastFrame;
     jsonObject["avg_other_av_starves_per_second"] = getAvgNumOtherAvatarStarvesPerSecond();
     jsonObject["avg_other_av_skips_per_second"] = getAvgNumOtherAvatarSkipsPerSecond();
-    jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends;
+    jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends.load();
 
     jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
     jsonObject[INBOUND_AVATAR_DATA_STATS_KEY] = _avatar->getAverageBytesReceivedPerSecond() / (float) BYTES_PER_KILOBIT;
@@ -13,7 +13,7 @@
 #define hifi_AvatarMixerClientData_h
 
 #include <algorithm>
-#include <cfloat>
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -27,6 +27,7 @@
 #include <PortableHighResolutionClock.h>
 #include <SimpleMovingAverage.h>
 #include <UUIDHasher.h>
+#include <ViewFrustum.h>
 
 const QString OUTBOUND_AVATAR_DATA_STATS_KEY = "outbound_av_data_kbps";
 const QString INBOUND_AVATAR_DATA_STATS_KEY = "inbound_av_data_kbps";
@@ -44,18 +45,24 @@ public:
     uint16_t getLastBroadcastSequenceNumber(const QUuid& nodeUUID) const;
     void setLastBroadcastSequenceNumber(const QUuid& nodeUUID, uint16_t sequenceNumber)
         { _lastBroadcastSequenceNumbers[nodeUUID] = sequenceNumber; }
-    Q_INVOKABLE void removeLastBroadcastSequenceNumber(const QUuid& nodeUUID) { _lastBroadcastSequenceNumbers.erase(nodeUUID); }
+    Q_INVOKABLE void removeLastBroadcastSequenceNumber(const QUuid& nodeUUID);
+
+    // the usecs timestamp of the frame this node was last sent the given avatar in, 0 if it never was
+    quint64 getLastBroadcastTime(const QUuid& nodeUUID) const;
+    void setLastBroadcastTime(const QUuid& nodeUUID, quint64 broadcastTime) { _lastBroadcastTimes[nodeUUID] = broadcastTime; }
 
     uint16_t getLastReceivedSequenceNumber() const { return _lastReceivedSequenceNumber; }
 
     HRCTime getIdentityChangeTimestamp() const { return _identityChangeTimestamp; }
     void flagIdentityChange() { _identityChangeTimestamp = p_high_resolution_clock::now(); }
 
-    void setFullRateDistance(float fullRateDistance) { _fullRateDistance = fullRateDistance; }
-    float getFullRateDistance() const { return _fullRateDistance; }
+    // the identity packet payload for this avatar, only rebuilt when the identity has changed
+    const QByteArray& getIdentityPacketData(const QUuid& nodeUUID);
 
-    void setMaxAvatarDistance(float maxAvatarDistance) { _maxAvatarDistance = maxAvatarDistance; }
-    float getMaxAvatarDistance() const { return _maxAvatarDistance; }
+    // the view frustum last sent by this node in an AvatarQuery
+    bool hasViewFrustum() const { return _hasViewFrustum; }
+    const ViewFrustum& getViewFrustum() const { return _viewFrustum; }
+    void readViewFrustumPacket(const QByteArray& message);
 
     void resetNumAvatarsSentLastFrame() { _numAvatarsSentLastFrame = 0; }
     void incrementNumAvatarsSentLastFrame() { ++_numAvatarsSentLastFrame; }
@@ -67,12 +74,9 @@ public:
     void recordNumOtherAvatarSkips(int numOtherAvatarSkips) { _otherAvatarSkips.updateAverage((float) numOtherAvatarSkips); }
     float getAvgNumOtherAvatarSkipsPerSecond() const { return _otherAvatarSkips.getAverageSampleValuePerSecond(); }
 
+    // called by every thread broadcasting this avatar
     void incrementNumOutOfOrderSends() { ++_numOutOfOrderSends; }
 
-    int getNumFramesSinceFRDAdjustment() const { return _numFramesSinceAdjustment; }
-    void incrementNumFramesSinceFRDAdjustment() { ++_numFramesSinceAdjustment; }
-    void resetNumFramesSinceFRDAdjustment() { _numFramesSinceAdjustment = 0; }
-
     void recordSentAvatarData(int numBytes) { _avgOtherAvatarDataRate.updateAverage((float) numBytes); }
 
     float getOutboundAvatarDataKbps() const
@@ -84,19 +88,21 @@ private:
 
     uint16_t _lastReceivedSequenceNumber { 0 };
     std::unordered_map<QUuid, uint16_t> _lastBroadcastSequenceNumbers;
+    std::unordered_map<QUuid, quint64> _lastBroadcastTimes;
     std::unordered_set<QUuid> _hasReceivedFirstPacketsFrom;
 
     HRCTime _identityChangeTimestamp;
+    QByteArray _identityPacketData;
+    HRCTime _identityPacketDataTimestamp;
 
-    float _fullRateDistance = FLT_MAX;
-    float _maxAvatarDistance = FLT_MAX;
+    ViewFrustum _viewFrustum;
+    bool _hasViewFrustum { false };
 
     int _numAvatarsSentLastFrame = 0;
-    int _numFramesSinceAdjustment = 0;
 
     SimpleMovingAverage _otherAvatarStarves;
     SimpleMovingAverage _otherAvatarSkips;
-    int _numOutOfOrderSends = 0;
+    std::atomic<int> _numOutOfOrderSends { 0 };
 
     SimpleMovingAverage _avgOtherAvatarDataRate;
 };
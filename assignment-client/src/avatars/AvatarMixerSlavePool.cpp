@@ -0,0 +1,111 @@
+//
+//  AvatarMixerSlavePool.cpp
+//  assignment-client/src/avatars
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarMixerSlavePool.h"
+
+#include <algorithm>
+
+AvatarMixerSlavePool::AvatarMixerSlavePool(int numThreads) {
+    setNumThreads(numThreads);
+}
+
+AvatarMixerSlavePool::~AvatarMixerSlavePool() {
+    stopThreads();
+}
+
+void AvatarMixerSlavePool::setNumThreads(int numThreads) {
+    numThreads = std::max(numThreads, 1);
+
+    if (numThreads == this->numThreads()) {
+        return;
+    }
+
+    stopThreads();
+
+    _slaves.clear();
+    for (int i = 0; i < numThreads; ++i) {
+        _slaves.emplace_back(new AvatarMixerSlave);
+    }
+
+    // the first slave is run by the thread calling broadcast, the rest get a thread of their own
+    for (int i = 1; i < numThreads; ++i) {
+        _threads.emplace_back(&AvatarMixerSlavePool::threadMain, this, i, _frame);
+    }
+}
+
+void AvatarMixerSlavePool::broadcast(int count, const BroadcastFunction& function) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _function = function;
+        _count = count;
+        _nextIndex = 0;
+        _pendingThreads = (int) _threads.size();
+        ++_frame;
+    }
+    _frameCondition.notify_all();
+
+    runSlave(*_slaves[0]);
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _doneCondition.wait(lock, [this]{ return _pendingThreads == 0; });
+        _function = nullptr;
+    }
+}
+
+void AvatarMixerSlavePool::runSlave(AvatarMixerSlave& slave) {
+    // work is handed out one index at a time so a slave that gets cheap listeners picks up more of them
+    int index;
+    while ((index = _nextIndex++) < _count) {
+        _function(slave, index);
+    }
+}
+
+void AvatarMixerSlavePool::threadMain(int slaveIndex, int lastFrame) {
+    auto& slave = *_slaves[slaveIndex];
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _frameCondition.wait(lock, [&]{ return _isStopping || _frame != lastFrame; });
+
+            if (_isStopping) {
+                return;
+            }
+
+            lastFrame = _frame;
+        }
+
+        runSlave(slave);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pendingThreads == 0) {
+                _doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void AvatarMixerSlavePool::stopThreads() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _frameCondition.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+    _threads.clear();
+
+    _isStopping = false;
+}
@@ -0,0 +1,88 @@
+//
+//  AvatarMixerSlavePool.h
+//  assignment-client/src/avatars
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AvatarMixerSlavePool_h
+#define hifi_AvatarMixerSlavePool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "AvatarGrid.h"
+
+// An avatar with new data for a listener, ranked against the others competing for the listener's bandwidth
+struct AvatarPriority {
+    float priority;
+    int avatarIndex;
+    uint16_t lastBroadcastSequenceNumber; // the last of the avatar's sequence numbers this listener was sent
+};
+
+// State owned by one broadcasting thread
+struct AvatarMixerSlave {
+    AvatarMixerSlave() : generator(std::random_device()()) {}
+
+    // the send decisions are random, each thread draws from a generator of its own
+    std::mt19937 generator;
+    std::uniform_real_distribution<float> distribution;
+
+    // the grid cells around a listener, reused from listener to listener
+    std::vector<AvatarGrid::CellDistance> cells;
+
+    // the other avatars ranked for a listener, reused from listener to listener
+    std::vector<AvatarPriority> priorities;
+};
+
+// Runs the per-avatar encoding and the per-listener broadcast of the avatar-mixer over a fixed set of threads.
+// The thread calling broadcast() takes part as the first slave, so a pool of one thread works like the old serial loop.
+class AvatarMixerSlavePool {
+public:
+    // called once per index, on whichever slave picked that index up
+    using BroadcastFunction = std::function<void(AvatarMixerSlave& slave, int index)>;
+
+    AvatarMixerSlavePool(int numThreads = 1);
+    ~AvatarMixerSlavePool();
+
+    void setNumThreads(int numThreads);
+    int numThreads() const { return (int) _slaves.size(); }
+
+    // runs function for every index in [0, count) and blocks until all of them are done
+    void broadcast(int count, const BroadcastFunction& function);
+
+private:
+    void runSlave(AvatarMixerSlave& slave);
+    // lastFrame is the frame that was current when the thread was started, so it only picks up later ones
+    void threadMain(int slaveIndex, int lastFrame);
+    void stopThreads();
+
+    std::vector<std::unique_ptr<AvatarMixerSlave>> _slaves;
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _frameCondition;
+    std::condition_variable _doneCondition;
+    int _frame { 0 };
+    int _pendingThreads { 0 };
+    bool _isStopping { false };
+
+    BroadcastFunction _function;
+    int _count { 0 };
+    std::atomic<int> _nextIndex { 0 };
+};
+
+#endif // hifi_AvatarMixerSlavePool_h
@@ -13,7 +13,7 @@
 #include <QtCore/QJsonObject>
 #include <QBuffer>
 #include <LogHandler.h>
-#include <MessagesClient.h>
+#include <NLPacketList.h>
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 #include "MessagesMixer.h"
@@ -30,27 +30,38 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    for (auto channel = _channelSubscribers.begin(); channel != _channelSubscribers.end();) {
+        channel->remove(killedNode->getUUID());
+        if (channel->isEmpty()) {
+            channel = _channelSubscribers.erase(channel);
+        } else {
+            ++channel;
+        }
     }
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QUuid senderID;
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, message, senderID);
+    // only the channel is read, the message goes out to the subscribers as it came in
+    quint16 channelLength;
+    receivedMessage->readPrimitive(&channelLength);
+    QString channel = QString::fromUtf8(receivedMessage->read(channelLength));
 
+    auto subscribers = _channelSubscribers.find(channel);
+    if (subscribers == _channelSubscribers.end()) {
+        return;
+    }
+
+    QByteArray payload = receivedMessage->getMessage();
     auto nodeList = DependencyManager::get<NodeList>();
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getType() == NodeType::Agent && node->getActiveSocket() &&
-                _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = MessagesClient::encodeMessagesPacket(channel, message, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    for (const QUuid& subscriberID : subscribers.value()) {
+        SharedNodePointer node = nodeList->nodeWithUUID(subscriberID);
+        if (node && node->getType() == NodeType::Agent && node->getActiveSocket()) {
+            auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+            packetList->write(payload);
+            nodeList->sendPacketList(std::move(packetList), *node);
+        }
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -60,8 +71,12 @@ void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> mess
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderNode->getUUID());
+    auto subscribers = _channelSubscribers.find(channel);
+    if (subscribers != _channelSubscribers.end()) {
+        subscribers->remove(senderNode->getUUID());
+        if (subscribers->isEmpty()) {
+            _channelSubscribers.erase(subscribers);
+        }
     }
 }
 
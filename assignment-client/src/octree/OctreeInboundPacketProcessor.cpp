@@ -157,13 +157,10 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                         message->getPosition(), maxSize);
             }
 
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
+            quint64 startProcess = usecTimestampNow();
+            quint64 thisLockWaitTime = 0;
+            int editDataBytesRead =
+                _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode, thisLockWaitTime);
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
@@ -172,8 +169,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             }
 
             editsInPacket++;
-            quint64 thisProcessTime = endProcess - startProcess;
-            quint64 thisLockWaitTime = startProcess - startLock;
+            quint64 thisProcessTime = endProcess - startProcess - thisLockWaitTime;
             processTime += thisProcessTime;
             lockWaitTime += thisLockWaitTime;
 
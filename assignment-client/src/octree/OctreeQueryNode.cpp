@@ -240,11 +240,19 @@ void OctreeQueryNode::updateLastKnownViewFrustum() {
             _lastKnownViewFrustum = _currentViewFrustum;
         }
     }
+    // and what was hidden in it, which wasn't sent
+    _lastKnownOcclusion = _occlusion;
 
     // save that we know the view has been sent.
     setLastTimeBagEmpty();
 }
 
+bool OctreeQueryNode::updateOcclusion(const ViewFrustum& viewFrustum, const std::vector<AABox>& occluders) {
+    bool occludersChanged = !_occlusion || _occlusion->getOccluderBoxes() != occluders;
+    _occlusion = std::make_shared<OcclusionBuffer>(viewFrustum, occluders);
+    return occludersChanged;
+}
+
 
 bool OctreeQueryNode::moveShouldDump() const {
     // if shutting down, return immediately
@@ -15,6 +15,7 @@
 #include <iostream>
 
 #include <NodeData.h>
+#include <OcclusionBuffer.h>
 #include <OctreeConstants.h>
 #include <OctreeElementBag.h>
 #include <OctreePacketData.h>
@@ -64,6 +65,12 @@ public:
     bool updateCurrentViewFrustum();
     void updateLastKnownViewFrustum();
 
+    // what is hidden from the viewer in the view being sent, and in the last view it was sent all of
+    const OcclusionBufferPointer& getOcclusion() const { return _occlusion; }
+    const OcclusionBufferPointer& getLastKnownOcclusion() const { return _lastKnownOcclusion; }
+    // makes the occlusion for a new scene, returns true when the occluders are not the ones of the last scene
+    bool updateOcclusion(const ViewFrustum& viewFrustum, const std::vector<AABox>& occluders);
+
     bool getViewSent() const { return _viewSent; }
     void setViewSent(bool viewSent);
 
@@ -83,6 +90,10 @@ public:
 
     quint64 getLastRootTimestamp() const { return _lastRootTimestamp; }
     void setLastRootTimestamp(quint64 timestamp) { _lastRootTimestamp = timestamp; }
+
+    // how far into the tree's log of changed elements the scenes we have started reach
+    quint64 getLastChangedElementSequence() const { return _lastChangedElementSequence; }
+    void setLastChangedElementSequence(quint64 sequence) { _lastChangedElementSequence = sequence; }
     unsigned int getlastOctreePacketLength() const { return _lastOctreePacketLength; }
     int getDuplicatePacketCount() const { return _duplicatePacketCount; }
 
@@ -121,6 +132,8 @@ private:
     quint64 _lastTimeBagEmpty { 0 };
     bool _viewFrustumChanging { false };
     bool _viewFrustumJustStoppedChanging { true };
+    OcclusionBufferPointer _occlusion;
+    OcclusionBufferPointer _lastKnownOcclusion;
 
     OctreeSendThread* _octreeSendThread { nullptr };
 
@@ -133,6 +146,7 @@ private:
     OCTREE_PACKET_SEQUENCE _sequenceNumber { 0 };
 
     quint64 _lastRootTimestamp { 0 };
+    quint64 _lastChangedElementSequence { 0 };
 
     PacketType _myPacketType { PacketType::Unknown };
     bool _isShuttingDown { false };
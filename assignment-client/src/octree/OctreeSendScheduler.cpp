@@ -0,0 +1,140 @@
+//
+//  OctreeSendScheduler.cpp
+//  assignment-client/src/octree
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+OctreeSendScheduler::OctreeSendScheduler(int numThreads) :
+    _delaySecondsMetric(Metrics::histogram("hifi_octree_send_delay_seconds",
+                                           "How long after it came due each send to a viewer started",
+                                           Metrics::secondsBounds())),
+    _runSecondsMetric(Metrics::histogram("hifi_octree_send_run_seconds", "Time taken by each send to a viewer",
+                                         Metrics::secondsBounds())),
+    _sendThreadsMetric(Metrics::gauge("hifi_octree_send_threads", "Viewers on the send schedule"))
+{
+    numThreads = std::max(numThreads, 1);
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back(&OctreeSendScheduler::threadMain, this);
+    }
+}
+
+OctreeSendScheduler::~OctreeSendScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _taskCondition.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void OctreeSendScheduler::add(OctreeSendThread* sendThread) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_scheduled.insert(sendThread).second) {
+            return;
+        }
+        pushTask(usecTimestampNow(), sendThread);
+    }
+    _taskCondition.notify_one();
+}
+
+void OctreeSendScheduler::remove(OctreeSendThread* sendThread) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _scheduled.erase(sendThread);
+
+    auto it = std::find_if(_tasks.begin(), _tasks.end(), [&](const Task& task) { return task.sendThread == sendThread; });
+    if (it != _tasks.end()) {
+        _tasks.erase(it);
+        std::make_heap(_tasks.begin(), _tasks.end(), isDueLater);
+    }
+
+    _runDoneCondition.wait(lock, [&]{ return _running.count(sendThread) == 0; });
+}
+
+OctreeSendScheduler::Stats OctreeSendScheduler::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats stats = _stats;
+    stats.numSendThreads = (int)_scheduled.size();
+    return stats;
+}
+
+void OctreeSendScheduler::resetStats() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats = Stats();
+}
+
+void OctreeSendScheduler::pushTask(quint64 dueUsecs, OctreeSendThread* sendThread) {
+    _tasks.push_back({ dueUsecs, sendThread });
+    std::push_heap(_tasks.begin(), _tasks.end(), isDueLater);
+}
+
+void OctreeSendScheduler::threadMain() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_isStopping) {
+        if (_tasks.empty()) {
+            _taskCondition.wait(lock);
+            continue;
+        }
+
+        quint64 now = usecTimestampNow();
+        quint64 dueUsecs = _tasks.front().dueUsecs;
+        if (dueUsecs > now) {
+            _taskCondition.wait_for(lock, std::chrono::microseconds(dueUsecs - now));
+            continue;
+        }
+
+        std::pop_heap(_tasks.begin(), _tasks.end(), isDueLater);
+        OctreeSendThread* sendThread = _tasks.back().sendThread;
+        _tasks.pop_back();
+        _running.insert(sendThread);
+
+        quint64 delayUsecs = now - dueUsecs;
+        _stats.numRuns++;
+        _stats.totalDelayUsecs += delayUsecs;
+        _stats.maxDelayUsecs = std::max(_stats.maxDelayUsecs, delayUsecs);
+        _sendThreadsMetric.set((double)_scheduled.size());
+
+        lock.unlock();
+        _delaySecondsMetric.observe((double)delayUsecs / USECS_PER_SECOND);
+        bool keepSending = sendThread->send();
+        if (!keepSending) {
+            // the server destroys a send thread when it finishes, the same as it did for one with a thread of its own,
+            // the signal is queued to the server's thread and we are done with sendThread before remove() returns
+            emit sendThread->finished();
+        }
+        quint64 end = usecTimestampNow();
+        _runSecondsMetric.observe((double)(end - now) / USECS_PER_SECOND);
+        lock.lock();
+
+        _running.erase(sendThread);
+        _stats.totalRunUsecs += end - now;
+
+        if (keepSending && _scheduled.count(sendThread) > 0) {
+            pushTask(now + OCTREE_SEND_INTERVAL_USECS, sendThread);
+            // the new task may come due before the one the other threads are waiting for
+            _taskCondition.notify_one();
+        } else {
+            _scheduled.erase(sendThread);
+        }
+        _runDoneCondition.notify_all();
+    }
+}
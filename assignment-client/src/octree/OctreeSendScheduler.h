@@ -0,0 +1,84 @@
+//
+//  OctreeSendScheduler.h
+//  assignment-client/src/octree
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OctreeSendScheduler_h
+#define hifi_OctreeSendScheduler_h
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include <Metrics.h>
+
+class OctreeSendThread;
+
+// Runs the OctreeSendThreads of an octree server on a fixed set of threads, rather than a thread for each viewer.
+// Every send thread comes due once per send interval and a free thread takes whichever has been due the longest,
+// so a viewer with an expensive scene holds up the others by no more than one of its runs.
+class OctreeSendScheduler {
+public:
+    struct Stats {
+        int numSendThreads { 0 };
+        quint64 numRuns { 0 };
+        quint64 totalDelayUsecs { 0 }; // how long after it came due each run started
+        quint64 maxDelayUsecs { 0 };
+        quint64 totalRunUsecs { 0 };
+    };
+
+    OctreeSendScheduler(int numThreads);
+    ~OctreeSendScheduler();
+
+    int numThreads() const { return (int)_threads.size(); }
+
+    // the send thread runs for the first time as soon as one of our threads is free
+    void add(OctreeSendThread* sendThread);
+
+    // takes the send thread off the schedule, waiting for the end of its run if one of our threads has it
+    void remove(OctreeSendThread* sendThread);
+
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    struct Task {
+        quint64 dueUsecs;
+        OctreeSendThread* sendThread;
+    };
+
+    static bool isDueLater(const Task& a, const Task& b) { return a.dueUsecs > b.dueUsecs; }
+
+    void threadMain();
+    void pushTask(quint64 dueUsecs, OctreeSendThread* sendThread);
+
+    std::vector<std::thread> _threads;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _taskCondition; // a task was pushed, or the threads are stopping
+    std::condition_variable _runDoneCondition;
+    std::vector<Task> _tasks; // a heap with the earliest due task at the front
+    std::unordered_set<OctreeSendThread*> _scheduled; // added and not yet removed or finished
+    std::unordered_set<OctreeSendThread*> _running;
+    bool _isStopping { false };
+    Stats _stats;
+
+    // the delay is how far behind the threads are, updated outside of the lock
+    MetricsHistogram& _delaySecondsMetric;
+    MetricsHistogram& _runSecondsMetric;
+    MetricsGauge& _sendThreadsMetric;
+};
+
+#endif // hifi_OctreeSendScheduler_h
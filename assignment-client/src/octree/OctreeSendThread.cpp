@@ -16,6 +16,7 @@
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
+#include <shared/Tracing.h>
 
 #include "OctreeQueryNode.h"
 #include "OctreeSendThread.h"
@@ -26,6 +27,19 @@
 quint64 startSceneSleepTime = 0;
 quint64 endSceneSleepTime = 0;
 
+// a viewer with more octree packets than this waiting to be processed is sent no more than it processes
+static const int MAX_VIEWER_PENDING_PACKETS = 64;
+
+// the elements that look the largest from the viewer are sent first, nearby detail before the distant one
+static OctreeElementBag::PriorityFunction makeViewerPriority(const glm::vec3& viewerPosition) {
+    return [viewerPosition](const OctreeElement& element) {
+        const AACube& cube = element.getAACube();
+        float distance = glm::distance(cube.calcCenter(), viewerPosition) - 0.5f * SQUARE_ROOT_OF_3 * cube.getScale();
+        const float MIN_DISTANCE = 0.01f;
+        return cube.getScale() / std::max(distance, MIN_DISTANCE);
+    };
+}
+
 OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     _myServer(myServer),
     _node(node),
@@ -66,15 +80,14 @@ void OctreeSendThread::setIsShuttingDown() {
 }
 
 
-bool OctreeSendThread::process() {
+bool OctreeSendThread::send() {
+    TRACE_SCOPE("OctreeSendThread::send");
     if (_isShuttingDown) {
         return false; // exit early if we're shutting down
     }
 
     OctreeServer::didProcess(this);
 
-    quint64  start = usecTimestampNow();
-
     // we'd better have a server at this point, or we're in trouble
     assert(_myServer);
 
@@ -94,7 +107,13 @@ bool OctreeSendThread::process() {
         }
     }
 
-    if (_isShuttingDown) {
+    return !_isShuttingDown;
+}
+
+bool OctreeSendThread::process() {
+    quint64  start = usecTimestampNow();
+
+    if (!send()) {
         return false; // exit early if we're shutting down
     }
 
@@ -299,6 +318,50 @@ int OctreeSendThread::handlePacketSend(SharedNodePointer node, OctreeQueryNode*
     return packetsSent;
 }
 
+bool OctreeSendThread::insertChangedElements(OctreeQueryNode* nodeData) {
+    OctreePointer tree = _myServer->getOctree();
+
+    QVector<OctreeElementPointer> changedElements;
+    quint64 latestSequence;
+    if (!tree->getChangedElementsSince(nodeData->getLastChangedElementSequence(), MAX_CHANGED_ELEMENTS_PER_SCENE,
+                                       changedElements, latestSequence)) {
+        return false;
+    }
+    nodeData->setLastChangedElementSequence(latestSequence);
+
+    ViewFrustum viewFrustum;
+    nodeData->copyCurrentViewFrustum(viewFrustum);
+
+    tree->withReadLock([&] {
+        QVector<OctreeElementPointer> elementsToSend;
+        for (const OctreeElementPointer& element : changedElements) {
+            if (!element->isInView(viewFrustum)) {
+                continue;
+            }
+
+            // encoding an element also sends whatever changed below it, so we only need the topmost of any nesting
+            bool isCovered = false;
+            for (int i = 0; i < elementsToSend.size() && !isCovered; i++) {
+                const OctreeElementPointer& other = elementsToSend[i];
+                if (other == element || isAncestorOf(other->getOctalCode(), element->getOctalCode())) {
+                    isCovered = true;
+                } else if (isAncestorOf(element->getOctalCode(), other->getOctalCode())) {
+                    elementsToSend.remove(i--);
+                }
+            }
+            if (!isCovered) {
+                elementsToSend.push_back(element);
+            }
+        }
+
+        for (const OctreeElementPointer& element : elementsToSend) {
+            nodeData->elementBag.insert(element);
+        }
+    });
+
+    return true;
+}
+
 /// Version of octree element distributor that sends the deepest LOD level at once
 int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged) {
 
@@ -310,7 +373,14 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     }
 
     // calculate max number of packets that can be sent during this interval
-    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
+    // a viewer falling behind on the packets it received gets them only as fast as it works off its backlog
+    int clientMaxPPS = nodeData->getMaxQueryPacketsPerSecond();
+    int pendingPackets = nodeData->getPendingPacketCount();
+    if (pendingPackets > MAX_VIEWER_PENDING_PACKETS) {
+        float processedPPS = nodeData->getProcessedPacketsPerSecond() * MAX_VIEWER_PENDING_PACKETS / pendingPackets;
+        clientMaxPPS = std::min(clientMaxPPS, (int)processedPPS);
+    }
+    int clientMaxPacketsPerInterval = std::max(1, (clientMaxPPS / INTERVALS_PER_SECOND));
     int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
 
     int truePacketsSent = 0;
@@ -338,10 +408,16 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
 
     _packetData.changeSettings(true, targetSize); // FIXME - eventually support only compressed packets
 
+    bool isSceneFromChangedElements = false;
+
     // If the current view frustum has changed OR we have nothing to send, then search against
     // the current view frustum for things to send.
     if (viewFrustumChanged || nodeData->elementBag.isEmpty()) {
 
+        ViewFrustum viewFrustum;
+        nodeData->copyCurrentViewFrustum(viewFrustum);
+        nodeData->elementBag.setPriorityFunction(makeViewerPriority(viewFrustum.getPosition()));
+
         // if our view has changed, we need to reset these things...
         if (viewFrustumChanged) {
             if (nodeData->moveShouldDump() || nodeData->hasLodChanged()) {
@@ -376,19 +452,37 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         nodeData->stats.sceneStarted(isFullScene, viewFrustumChanged,
                                      _myServer->getOctree()->getRoot(), _myServer->getJurisdiction());
 
-        // This is the start of "resending" the scene.
-        bool dontRestartSceneOnMove = false; // this is experimental
-        if (dontRestartSceneOnMove) {
-            if (nodeData->elementBag.isEmpty()) {
+        // This is the start of "resending" the scene. If the viewer has everything in a view it is still looking at
+        // then only the elements edits have changed since can have anything new for it.
+        // the occluders are taken again for each scene, and while they stay the same what they hid stays hidden.
+        // When they change, what only they hid is sent with the rest of the view.
+        std::vector<AABox> occluders;
+        _myServer->getOctree()->withReadLock([&] {
+            _myServer->getOctree()->getOccluders(occluders);
+        });
+        bool occludersChanged = nodeData->updateOcclusion(viewFrustum, occluders);
+
+        bool isCaughtUp = !viewFrustumChanged && !isFullScene && !occludersChanged && nodeData->getViewSent();
+        isSceneFromChangedElements = isCaughtUp && insertChangedElements(nodeData);
+        if (!isSceneFromChangedElements) {
+            // take the sequence before the root goes in the bag, so an edit logged between the two is sent again
+            // rather than missed
+            nodeData->setLastChangedElementSequence(_myServer->getOctree()->getLastChangedElementSequence());
+
+            bool dontRestartSceneOnMove = false; // this is experimental
+            if (dontRestartSceneOnMove) {
+                if (nodeData->elementBag.isEmpty()) {
+                    nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
+                }
+            } else {
                 nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
             }
-        } else {
-            nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
         }
     }
 
     // If we have something in our elementBag, then turn them into packets and send them out...
-    if (!nodeData->elementBag.isEmpty()) {
+    // A scene from the changed elements may have nothing in view, we still send the special packets and complete it
+    if (!nodeData->elementBag.isEmpty() || isSceneFromChangedElements) {
         int bytesWritten = 0;
         quint64 start = usecTimestampNow();
 
@@ -433,10 +527,14 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
                                                  nodeData->getLastTimeBagEmpty(),
                                                  isFullScene, &nodeData->stats, _myServer->getJurisdiction(),
                                                  &nodeData->extraEncodeData);
+                    params.excludedProperties = nodeData->getExcludedProperties();
+                    params.heavyPropertiesDistance = nodeData->getHeavyPropertiesDistance();
                     nodeData->copyCurrentViewFrustum(params.viewFrustum);
                     if (viewFrustumChanged) {
                         nodeData->copyLastKnownViewFrustum(params.lastViewFrustum);
+                        params.lastOcclusion = nodeData->getLastKnownOcclusion();
                     }
+                    params.occlusion = nodeData->getOcclusion();
 
                     // Our trackSend() function is implemented by the server subclass, and will be called back
                     // during the encodeTreeBitstream() as new entities/data elements are sent
@@ -23,7 +23,7 @@ class OctreeServer;
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
-/// Threaded processor for sending octree packets to a single client
+/// Processor for sending octree packets to a single client, run by the server's OctreeSendScheduler
 class OctreeSendThread : public GenericThread {
     Q_OBJECT
 public:
@@ -35,6 +35,9 @@ public:
     
     QUuid getNodeUuid() const { return _nodeUuid; }
 
+    /// Sends this interval's packets to the client, returns false once the client is gone or we are shutting down.
+    bool send();
+
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
     static AtomicUIntStat _totalPackets;
@@ -52,6 +55,9 @@ protected:
 private:
     int handlePacketSend(SharedNodePointer node, OctreeQueryNode* nodeData, int& trueBytesSent, int& truePacketsSent, bool dontSuppressDuplicate = false);
     int packetDistributor(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged);
+
+    // puts the in view elements changed since the viewer's last scene in its bag, returns false if it needs the root
+    bool insertChangedElements(OctreeQueryNode* nodeData);
     
     
     OctreeServer* _myServer { nullptr };
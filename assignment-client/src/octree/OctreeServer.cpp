@@ -30,6 +30,7 @@
 #include <QtCore/QStandardPaths>
 #include <ServerPathUtils.h>
 #include <QtCore/QDir>
+#include <QtCore/QThread>
 
 int OctreeServer::_clientCount = 0;
 const int MOVING_AVERAGE_SAMPLE_COUNTS = 1000000;
@@ -84,6 +85,10 @@ int OctreeServer::_noProcessWait = 0;
 void OctreeServer::resetSendingStats() {
     _averageLoopTime.reset();
 
+    if (_sendScheduler) {
+        _sendScheduler->resetStats();
+    }
+
     _averageEncodeTime.reset();
     _averageShortEncodeTime.reset();
     _averageLongEncodeTime.reset();
@@ -232,7 +237,8 @@ OctreeServer::OctreeServer(ReceivedMessage& message) :
     _octreeInboundPacketProcessor(NULL),
     _persistThread(NULL),
     _started(time(0)),
-    _startedUSecs(usecTimestampNow())
+    _startedUSecs(usecTimestampNow()),
+    _numSendThreads(1)
 {
     _averageLoopTime.updateAverage(0);
     qDebug() << "Octree server starting... [" << this << "]";
@@ -441,6 +447,23 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("      writeDatagram() last second: %1 clients\r\n\r\n")
             .arg(locale.toString((uint)howManyThreadsDidCallWriteDatagram(oneSecondAgo)).rightJustified(COLUMN_WIDTH, ' '));
 
+        if (_sendScheduler) {
+            OctreeSendScheduler::Stats schedulerStats = _sendScheduler->getStats();
+            quint64 runs = std::max(schedulerStats.numRuns, (quint64)1);
+            statsString += QString("                     Send threads: %1 threads\r\n")
+                .arg(locale.toString(_sendScheduler->numThreads()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("                Scheduled clients: %1 clients\r\n")
+                .arg(locale.toString(schedulerStats.numSendThreads).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("                    Client sends: %1 runs\r\n")
+                .arg(locale.toString((qulonglong)schedulerStats.numRuns).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("          Average send start delay: %1 usecs\r\n")
+                .arg(locale.toString((qulonglong)(schedulerStats.totalDelayUsecs / runs)).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("              Max send start delay: %1 usecs\r\n")
+                .arg(locale.toString((qulonglong)schedulerStats.maxDelayUsecs).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("                 Average send time: %1 usecs\r\n\r\n")
+                .arg(locale.toString((qulonglong)(schedulerStats.totalRunUsecs / runs)).rightJustified(COLUMN_WIDTH, ' '));
+        }
+
         float averageLoopTime = getAverageLoopTime();
         statsString += QString().sprintf("           Average packetLoop() time:      %7.2f msecs"
                                          "                 samples: %12d \r\n",
@@ -873,7 +896,9 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
     
     // we want to be notified when the thread finishes
     connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+
+    // the send thread runs on the scheduler's threads rather than one of its own
+    _sendScheduler->add(sendThread.get());
 
     return sendThread;
 }
@@ -881,6 +906,10 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
+        if (_sendScheduler) {
+            _sendScheduler->remove(sendThread);
+        }
+
         // This deletes the unique_ptr, so sendThread is destructed after that line
         _sendThreads.erase(sendThread->getNodeUuid());
     }
@@ -897,6 +926,7 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
+            _sendScheduler->remove(it->second.get());
             _sendThreads.erase(it); // Remove right away and wait on thread to be
             
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
@@ -1107,6 +1137,18 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    // the viewers are sent to from a pool of threads, by default one for each core
+    bool autoSendThreads;
+    if (!readOptionBool(QString("autoSendThreads"), settingsSectionObject, autoSendThreads)) {
+        autoSendThreads = true;
+    }
+    _numSendThreads = QThread::idealThreadCount();
+    if (!autoSendThreads) {
+        readOptionInt(QString("numSendThreads"), settingsSectionObject, _numSendThreads);
+    }
+    _numSendThreads = std::max(_numSendThreads, 1);
+    qDebug() << "numSendThreads=" << _numSendThreads;
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1143,6 +1185,8 @@ void OctreeServer::domainSettingsRequestComplete() {
     packetReceiver.registerListener(PacketType::JurisdictionRequest, this, "handleJurisdictionRequestPacket");
     
     readConfiguration();
+
+    _sendScheduler.reset(new OctreeSendScheduler(_numSendThreads));
     
     beforeRun(); // after payload has been processed
     
@@ -1348,8 +1392,9 @@ void OctreeServer::aboutToFinish() {
         sendThread.setIsShuttingDown();
     }
     
-    // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
-    // which waits on the thread to be done before returning
+    // Stopping the scheduler waits for the send threads it is running to be done, after which
+    // clear can destruct all the unique_ptr to OctreeSendThreads
+    _sendScheduler.reset();
     _sendThreads.clear(); // Cleans up all the send threads.
 
     if (_persistThread) {
@@ -23,6 +23,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendScheduler.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -198,6 +199,8 @@ protected:
     QString _safeServerName;
     
     SendThreads _sendThreads;
+    int _numSendThreads;
+    std::unique_ptr<OctreeSendScheduler> _sendScheduler;
 
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
@@ -27,4 +27,8 @@ const int MAX_FILENAME_LENGTH = 1024;
 const int INTERVALS_PER_SECOND = 90;
 const int OCTREE_SEND_INTERVAL_USECS = (1000 * 1000)/INTERVALS_PER_SECOND;
 
+/// When a viewer that hasn't moved has been sent its view, the next scene starts from just the elements edits have
+/// changed since, so long as there are no more than this many. Otherwise we go back to looking for changes from the root.
+const int MAX_CHANGED_ELEMENTS_PER_SCENE = 64;
+
 #endif // hifi_OctreeServerConsts_h
@@ -35,6 +35,14 @@ macro(SETUP_HIFI_LIBRARY)
     endif()
   endforeach()
 
+  # add compiler flags to NEON source files (always available on 64-bit ARM)
+  file(GLOB_RECURSE NEON_SRCS "src/neon/*.cpp" "src/neon/*.c")
+  foreach(SRC ${NEON_SRCS})
+    if ((APPLE OR UNIX) AND CMAKE_SYSTEM_PROCESSOR MATCHES "^arm")
+      set_source_files_properties(${SRC} PROPERTIES COMPILE_FLAGS -mfpu=neon)
+    endif()
+  endforeach()
+
   setup_memory_debugger()
 
   # create a library and set the property so it can be referenced later
@@ -11,18 +11,22 @@
 
 #include "DomainGatekeeper.h"
 
-#include <openssl/err.h>
-#include <openssl/rsa.h>
-#include <openssl/x509.h>
-
 #include <AccountManager.h>
 #include <Assignment.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 #include "DomainServer.h"
 #include "DomainServerNodeData.h"
 
 using SharedAssignmentPointer = QSharedPointer<Assignment>;
 
+// the connects that can wait on a signature check at once, the ones past it are dropped and come back with the next try
+const int MAX_PENDING_SIGNATURE_CHECKS = 512;
+
+// a key younger than this isn't asked for again, unless a signature failed to check against it
+const quint64 USER_PUBLIC_KEY_REFRESH_USECS = 60 * USECS_PER_SECOND;
+
 DomainGatekeeper::DomainGatekeeper(DomainServer* server) :
     _server(server)
 {
@@ -102,13 +106,23 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
             }
         }
 
+        if (!username.isEmpty() && !usernameSignature.isEmpty()) {
+            // the connect goes on from handleUserSignatureVerified once the signature checks out
+            verifyUserSignature(nodeConnection, username, usernameSignature);
+            return;
+        }
+
         node = processAgentConnectRequest(nodeConnection, username, usernameSignature);
     }
 
+    finishConnectRequest(node, nodeConnection);
+}
+
+void DomainGatekeeper::finishConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection) {
     if (node) {
         // set the sending sock addr and node interest set on this node
         DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(node->getLinkedData());
-        nodeData->setSendingSockAddr(message->getSenderSockAddr());
+        nodeData->setSendingSockAddr(nodeConnection.senderSockAddr);
         nodeData->setNodeInterestSet(nodeConnection.interestList.toSet());
         nodeData->setPlaceName(nodeConnection.placeName);
 
@@ -116,7 +130,7 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         // and broadcast its presence right away
         emit connectedNode(node);
     } else {
-        qDebug() << "Refusing connection from node at" << message->getSenderSockAddr();
+        qDebug() << "Refusing connection from node at" << nodeConnection.senderSockAddr;
     }
 }
 
@@ -252,6 +266,9 @@ void DomainGatekeeper::updateNodePermissions() {
 
         node->setPermissions(userPerms);
 
+        // the other nodes have the permissions of this one in their domain lists
+        _server->recordNodeListChange(node);
+
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
             qDebug() << "node" << node->getUUID() << "no longer has permission to connect.";
             // hang up on this node
@@ -321,45 +338,35 @@ const QString MAXIMUM_USER_CAPACITY = "security.maximum_user_capacity";
 SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnectionData& nodeConnection,
                                                                const QString& username,
                                                                const QByteArray& usernameSignature) {
+    if (!username.isEmpty() && usernameSignature.isEmpty()) {
+        // user is attempting to prove their identity to us, but we don't have enough information
+        sendConnectionTokenPacket(username, nodeConnection.senderSockAddr);
+        // ask for their public key right now to make sure we have it
+        requestUserPublicKey(username);
+        getGroupMemberships(username); // optimistically get started on group memberships
+#ifdef WANT_DEBUG
+        qDebug() << "stalling login because we have no username-signature:" << username;
+#endif
+        return SharedNodePointer();
+    }
 
+    // the connects with a signature go through verifyUserSignature, so this is an anonymous connection attempt
+    return connectAgent(nodeConnection, QString());
+}
+
+SharedNodePointer DomainGatekeeper::connectAgent(const NodeConnectionData& nodeConnection,
+                                                 const QString& verifiedUsername) {
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
-    // start with empty permissions
-    NodePermissions userPerms(NodePermissionsKey(username, 0));
-    userPerms.setAll(false);
+    const QString& username = verifiedUsername;
 
     // check if this user is on our local machine - if this is true set permissions to those for a "localhost" connection
     QHostAddress senderHostAddress = nodeConnection.senderSockAddr.getAddress();
     bool isLocalUser =
         (senderHostAddress == limitedNodeList->getLocalSockAddr().getAddress() || senderHostAddress == QHostAddress::LocalHost);
 
-    QString verifiedUsername; // if this remains empty, consider this an anonymous connection attempt
-    if (!username.isEmpty()) {
-        if (usernameSignature.isEmpty()) {
-            // user is attempting to prove their identity to us, but we don't have enough information
-            sendConnectionTokenPacket(username, nodeConnection.senderSockAddr);
-            // ask for their public key right now to make sure we have it
-            requestUserPublicKey(username);
-            getGroupMemberships(username); // optimistically get started on group memberships
-#ifdef WANT_DEBUG
-            qDebug() << "stalling login because we have no username-signature:" << username;
-#endif
-            return SharedNodePointer();
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
-            // they sent us a username and the signature verifies it
-            getGroupMemberships(username);
-            verifiedUsername = username;
-        } else {
-            // they sent us a username, but it didn't check out
-            requestUserPublicKey(username);
-#ifdef WANT_DEBUG
-            qDebug() << "stalling login because signature verification failed:" << username;
-#endif
-            return SharedNodePointer();
-        }
-    }
-
-    userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, nodeConnection.senderSockAddr.getAddress());
+    NodePermissions userPerms = setPermissionsForUser(isLocalUser, verifiedUsername,
+                                                      nodeConnection.senderSockAddr.getAddress());
 
     if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
         sendConnectionDeniedPacket("You lack the required permissions to connect to this domain.",
@@ -449,72 +456,82 @@ SharedNodePointer DomainGatekeeper::addVerifiedNodeFromConnectRequest(const Node
     return newNode;
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const HifiSockAddr& senderSockAddr) {
+void DomainGatekeeper::verifyUserSignature(const NodeConnectionData& nodeConnection, const QString& username,
+                                           const QByteArray& usernameSignature) {
     // it's possible this user can be allowed to connect, but we need to check their username signature
     auto lowerUsername = username.toLower();
-    QByteArray publicKeyArray = _userPublicKeys.value(lowerUsername);
 
-    const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
+    if (_pendingSignatureChecks.contains(lowerUsername)) {
+        // the client tries again while we check the last signature it sent, the answer to that one will do
+        return;
+    }
 
-    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
-        // if we do have a public key for the user, check for a signature match
+    if (_pendingSignatureChecks.size() >= MAX_PENDING_SIGNATURE_CHECKS) {
+        qDebug() << "Too many username signatures waiting to be checked - delaying connection for" << username;
+        return;
+    }
 
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
+    UserPublicKeyPointer publicKey = _userPublicKeys.value(lowerUsername).key;
+    const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
+    if (!publicKey || connectionToken.isNull()) {
+        if (_userPublicKeys.contains(lowerUsername) && !connectionToken.isNull()) {
+            // we can't let this user in since we couldn't convert their public key to an RSA key we could use
+            qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
+            sendConnectionDeniedPacket("Couldn't convert data to RSA key.", nodeConnection.senderSockAddr,
+                DomainHandler::ConnectionRefusedReason::LoginError);
+        } else {
+            qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
+        }
 
-        QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
-        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
-                                                                QCryptographicHash::Sha256);
+        requestUserPublicKey(username); // no joy.  maybe next time?
+#ifdef WANT_DEBUG
+        qDebug() << "stalling login because signature verification failed:" << username;
+#endif
+        return;
+    }
 
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
+    QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
+    QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
+                                                            QCryptographicHash::Sha256);
 
-            if (decryptResult == 1) {
-                qDebug() << "Username signature matches for" << username;
+    _pendingSignatureChecks.insert(lowerUsername, { nodeConnection, username });
+    _signatureCheckPool.start(new VerifyUserSignatureTask(this, lowerUsername, usernameWithToken,
+                                                          usernameSignature, publicKey));
+}
 
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
-                _connectionTokenHash.remove(username);
+void DomainGatekeeper::handleUserSignatureVerified(QString lowerUsername, bool verified) {
+    auto it = _pendingSignatureChecks.find(lowerUsername);
+    if (it == _pendingSignatureChecks.end()) {
+        return;
+    }
+    PendingSignatureCheck pendingCheck = it.value();
+    _pendingSignatureChecks.erase(it);
 
-                return true;
+    const QString& username = pendingCheck.username;
+    const NodeConnectionData& nodeConnection = pendingCheck.nodeConnection;
 
-            } else {
-                if (!senderSockAddr.isNull()) {
-                    qDebug() << "Error decrypting username signature for " << username << "- denying connection.";
-                    sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
-                        DomainHandler::ConnectionRefusedReason::LoginError);
-                }
+    if (!verified) {
+        qDebug() << "Error decrypting username signature for " << username << "- denying connection.";
+        sendConnectionDeniedPacket("Error decrypting username signature.", nodeConnection.senderSockAddr,
+            DomainHandler::ConnectionRefusedReason::LoginError);
 
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
-            }
+        // they sent us a username, but it didn't check out - their key may have just changed
+        requestUserPublicKey(username, true);
+#ifdef WANT_DEBUG
+        qDebug() << "stalling login because signature verification failed:" << username;
+#endif
+        finishConnectRequest(SharedNodePointer(), nodeConnection);
+        return;
+    }
 
-        } else {
+    qDebug() << "Username signature matches for" << username;
 
-            // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-            if (!senderSockAddr.isNull()) {
-                qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
-                sendConnectionDeniedPacket("Couldn't convert data to RSA key.", senderSockAddr,
-                    DomainHandler::ConnectionRefusedReason::LoginError);
-            }
-        }
-    } else {
-        if (!senderSockAddr.isNull()) {
-            qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
-        }
-    }
+    // they sent us a username and the signature verifies it
+    _connectionTokenHash.remove(lowerUsername);
+    getGroupMemberships(username);
 
-    requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
+    finishConnectRequest(connectAgent(nodeConnection, username), nodeConnection);
 }
 
 bool DomainGatekeeper::isWithinMaxCapacity() {
@@ -550,7 +567,7 @@ void DomainGatekeeper::preloadAllowedUserPublicKeys() {
     }
 }
 
-void DomainGatekeeper::requestUserPublicKey(const QString& username) {
+void DomainGatekeeper::requestUserPublicKey(const QString& username, bool force) {
     // don't request public keys for the standard psuedo-account-names
     if (NodePermissions::standardNames.contains(username, Qt::CaseInsensitive)) {
         return;
@@ -561,9 +578,15 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username) {
         // public-key request for this username is already flight, not rerequesting
         return;
     }
+
+    // even if we have a public key for them right now, request a new one once it is old in case it has just changed
+    auto cachedKey = _userPublicKeys.find(lowerUsername);
+    if (!force && cachedKey != _userPublicKeys.end() && cachedKey->key
+        && usecTimestampNow() - cachedKey->receivedTime < USER_PUBLIC_KEY_REFRESH_USECS) {
+        return;
+    }
     _inFlightPublicKeyRequests += lowerUsername;
 
-    // even if we have a public key for them right now, request a new one in case it has just changed
     JSONCallbackParameters callbackParams;
     callbackParams.jsonCallbackReceiver = this;
     callbackParams.jsonCallbackMethod = "publicKeyJSONCallback";
@@ -600,8 +623,11 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply& requestReply) {
         const QString JSON_DATA_KEY = "data";
         const QString JSON_PUBLIC_KEY_KEY = "public_key";
 
-        _userPublicKeys[username.toLower()] =
+        QByteArray publicKeyData =
             QByteArray::fromBase64(jsonObject[JSON_DATA_KEY].toObject()[JSON_PUBLIC_KEY_KEY].toString().toUtf8());
+
+        // the key is parsed once here, the checks running with the one it replaces keep their own reference to it
+        _userPublicKeys[username.toLower()] = { VerifyUserSignatureTask::createPublicKey(publicKeyData), usecTimestampNow() };
     }
 
     _inFlightPublicKeyRequests.remove(username);
@@ -17,6 +17,7 @@
 #include <unordered_map>
 
 #include <QtCore/QObject>
+#include <QtCore/QThreadPool>
 #include <QtNetwork/QNetworkReply>
 
 #include <DomainHandler.h>
@@ -27,6 +28,7 @@
 
 #include "NodeConnectionData.h"
 #include "PendingAssignedNodeData.h"
+#include "VerifyUserSignatureTask.h"
 
 class DomainServer;
 
@@ -70,29 +72,30 @@ public slots:
 
 private slots:
     void handlePeerPingTimeout();
+    void handleUserSignatureVerified(QString lowerUsername, bool verified);
 private:
     SharedNodePointer processAssignmentConnectRequest(const NodeConnectionData& nodeConnection,
                                                       const PendingAssignedNodeData& pendingAssignment);
     SharedNodePointer processAgentConnectRequest(const NodeConnectionData& nodeConnection,
                                                  const QString& username,
                                                  const QByteArray& usernameSignature);
+    SharedNodePointer connectAgent(const NodeConnectionData& nodeConnection, const QString& verifiedUsername);
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection,
                                                         QUuid nodeID = QUuid());
+    void finishConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection);
     
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const HifiSockAddr& senderSockAddr);
+    void verifyUserSignature(const NodeConnectionData& nodeConnection, const QString& username,
+                             const QByteArray& usernameSignature);
     bool isWithinMaxCapacity();
     
-    bool shouldAllowConnectionFromNode(const QString& username, const QByteArray& usernameSignature,
-                                       const HifiSockAddr& senderSockAddr);
-    
     void sendConnectionTokenPacket(const QString& username, const HifiSockAddr& senderSockAddr);
     static void sendConnectionDeniedPacket(const QString& reason, const HifiSockAddr& senderSockAddr,
             DomainHandler::ConnectionRefusedReason reasonCode = DomainHandler::ConnectionRefusedReason::Unknown);
     
     void pingPunchForConnectingPeer(const SharedNetworkPeer& peer);
     
-    void requestUserPublicKey(const QString& username);
+    // Asks for the key again once it is older than a refresh interval, or right away when forced
+    void requestUserPublicKey(const QString& username, bool force = false);
     
     DomainServer* _server;
     
@@ -101,16 +104,31 @@ private:
     QHash<QUuid, SharedNetworkPeer> _icePeers;
     
     QHash<QString, QUuid> _connectionTokenHash;
-    QHash<QString, QByteArray> _userPublicKeys;
+
+    struct UserPublicKey {
+        UserPublicKeyPointer key;
+        quint64 receivedTime;
+    };
+    QHash<QString, UserPublicKey> _userPublicKeys;
     QSet<QString> _inFlightPublicKeyRequests; // keep track of which we've already asked for
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
 
+    // the connect requests waiting on their signature check, one per user so a key is only used by one check at a time
+    struct PendingSignatureCheck {
+        NodeConnectionData nodeConnection;
+        QString username;
+    };
+    QHash<QString, PendingSignatureCheck> _pendingSignatureChecks;
+
     NodePermissions setPermissionsForUser(bool isLocalUser, QString verifiedUsername, const QHostAddress& senderAddress);
 
     void getGroupMemberships(const QString& username);
     // void getIsGroupMember(const QString& username, const QUuid groupID);
     void getDomainOwnerFriendsList();
+
+    // last, so it waits for the checks still running before the rest of the gatekeeper goes
+    QThreadPool _signatureCheckPool;
 };
 
 
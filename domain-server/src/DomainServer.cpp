@@ -11,8 +11,10 @@
 
 #include "DomainServer.h"
 
+#include <algorithm>
 #include <memory>
 #include <random>
+#include <vector>
 
 #include <QDir>
 #include <QJsonDocument>
@@ -30,6 +32,7 @@
 #include <HifiConfigVariantMap.h>
 #include <HTTPConnection.h>
 #include <LogUtils.h>
+#include <Metrics.h>
 #include <NetworkingConstants.h>
 #include <udt/PacketHeaders.h>
 #include <SettingHandle.h>
@@ -742,18 +745,33 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
+    // the version of the domain list the node has, it only needs what changed since
+    quint64 knownListVersion = 0;
+    packetStream >> knownListVersion;
+
     // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+        || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        recordNodeListChange(sendingNode);
+    }
     
     // update the NodeInterestSet in case there have been any changes
     DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
-    nodeData->setNodeInterestSet(nodeRequestData.interestList.toSet());
+    auto nodeInterestSet = nodeRequestData.interestList.toSet();
+    if (nodeInterestSet != nodeData->getNodeInterestSet()) {
+        // the changes since its list don't have the nodes of the types it just got interested in
+        knownListVersion = 0;
+        nodeData->setNodeInterestSet(nodeInterestSet);
+    }
+
+    nodeData->setKnownListVersion(knownListVersion);
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
 
-    sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    sendDomainListToNode(sendingNode, message->getSenderSockAddr(), knownListVersion);
 }
 
 unsigned int DomainServer::countConnectedUsers() {
@@ -813,6 +831,9 @@ QUrl DomainServer::oauthAuthorizationURL(const QUuid& stateUUID) {
 void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(newNode->getLinkedData());
 
+    // the other nodes get it with the next changes to the domain list
+    recordNodeListChange(newNode);
+
     // reply back to the user with a PacketType::DomainList
     sendDomainListToNode(newNode, nodeData->getSendingSockAddr());
 
@@ -825,8 +846,24 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
-    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr,
+                                        quint64 knownListVersion, bool skipIfUnchanged) {
+    DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(node->getLinkedData());
+
+    // every so often the node gets the whole list again, in case it missed part of one
+    static const quint64 FULL_DOMAIN_LIST_INTERVAL_USECS = 10 * USECS_PER_SECOND;
+    auto now = usecTimestampNow();
+
+    bool isDelta = knownListVersion >= _oldestNodeListVersion && knownListVersion <= _nodeListVersion
+        && now - nodeData->getLastFullListTime() < FULL_DOMAIN_LIST_INTERVAL_USECS;
+    quint64 baseVersion = isDelta ? knownListVersion : 0;
+
+    if (skipIfUnchanged && (!isDelta || baseVersion == _nodeListVersion)) {
+        return;
+    }
+
+    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2
+        + sizeof(quint64) + sizeof(quint64);
     
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
@@ -838,46 +875,97 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getPermissions();
+    extendedHeaderStream << baseVersion << _nodeListVersion;
 
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(node->getLinkedData());
-
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
+    int numEntries = 0;
+
     if (nodeInterestSet.size() > 0) {
 
         // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
         if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([&](const SharedNodePointer& otherNode){
-                if (otherNode->getUUID() != node->getUUID() && nodeInterestSet.contains(otherNode->getType())) {
-                    
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+            auto addNode = [&](const SharedNodePointer& otherNode) {
+                // since we're about to add a node to the packet we start a segment
+                domainListPackets->startSegment();
+
+                domainListStream << (quint8) DomainListEntryType::Node;
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+                // don't send avatar nodes to other avatars, that will come from avatar mixer
+                domainListStream << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+                // pack the secret that these two nodes will use to communicate with each other
+                domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
+                // we've added the node we wanted so end the segment now
+                domainListPackets->endSegment();
+                ++numEntries;
+            };
+
+            if (isDelta) {
+                // only the nodes that changed since the version the node has, once each however often they changed
+                auto firstChange = std::upper_bound(_nodeListChanges.cbegin(), _nodeListChanges.cend(), baseVersion,
+                    [](quint64 version, const NodeListChange& change) { return version < change.version; });
+
+                QSet<QUuid> changedNodeIDs;
+                for (auto it = firstChange; it != _nodeListChanges.cend(); ++it) {
+                    if (it->nodeID == node->getUUID() || !nodeInterestSet.contains(it->nodeType)
+                        || changedNodeIDs.contains(it->nodeID)) {
+                        continue;
+                    }
+                    changedNodeIDs.insert(it->nodeID);
+
+                    auto otherNode = limitedNodeList->nodeWithUUID(it->nodeID);
+                    if (otherNode) {
+                        addNode(otherNode);
+                    } else {
+                        domainListPackets->startSegment();
+                        domainListStream << (quint8) DomainListEntryType::RemovedNode;
+                        domainListStream << it->nodeID;
+                        domainListPackets->endSegment();
+                        ++numEntries;
+                    }
                 }
-            });
+            } else {
+                // if this authenticated node has any interest types, send back those nodes as well
+                limitedNodeList->eachNode([&](const SharedNodePointer& otherNode){
+                    if (otherNode->getUUID() != node->getUUID() && nodeInterestSet.contains(otherNode->getType())) {
+                        addNode(otherNode);
+                    }
+                });
+            }
         }
     }
+
+    if (skipIfUnchanged && numEntries == 0) {
+        return;
+    }
     
     // send an empty list to the node, in case there were no other nodes
     domainListPackets->closeCurrentPacket(true);
 
     // write the PacketList to this node
-    limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
+    if (limitedNodeList->sendPacketList(std::move(domainListPackets), *node) > 0 && !isDelta) {
+        nodeData->setLastFullListTime(now);
+    }
+}
+
+void DomainServer::recordNodeListChange(const SharedNodePointer& node) {
+    // a few minutes of the changes of a busy domain, a node that has been gone longer gets the whole list
+    static const size_t MAX_NODE_LIST_CHANGES = 4096;
+
+    _nodeListChanges.push_back({ ++_nodeListVersion, node->getUUID(), node->getType() });
+
+    if (_nodeListChanges.size() > MAX_NODE_LIST_CHANGES) {
+        _oldestNodeListVersion = _nodeListChanges.front().version;
+        _nodeListChanges.pop_front();
+    }
 }
 
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -902,40 +990,36 @@ QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, con
 }
 
 void DomainServer::broadcastNewNode(const SharedNodePointer& addedNode) {
+    if (!_addedNodesTimer) {
+        // a storm of connecting nodes costs each other node one list, not one packet per connecting node
+        static const int ADDED_NODES_BATCH_MSECS = 100;
 
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-
-    auto addNodePacket = NLPacket::create(PacketType::DomainServerAddedNode);
-
-    // setup the add packet for this new node
-    QDataStream addNodeStream(addNodePacket.get());
-
-    addNodeStream << *addedNode.data();
-
-    int connectionSecretIndex = addNodePacket->pos();
-
-    limitedNodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-            if (node->getLinkedData() && node->getActiveSocket() && node != addedNode) {
-                // is the added Node in this node's interest list?
-                DomainServerNodeData* nodeData = dynamic_cast<DomainServerNodeData*>(node->getLinkedData());
-                return nodeData->getNodeInterestSet().contains(addedNode->getType());
-            } else {
-                return false;
-            }
-        },
-        [&](const SharedNodePointer& node) {
-            addNodePacket->seek(connectionSecretIndex);
+        _addedNodesTimer = new QTimer(this);
+        _addedNodesTimer->setSingleShot(true);
+        _addedNodesTimer->setInterval(ADDED_NODES_BATCH_MSECS);
+        connect(_addedNodesTimer, &QTimer::timeout, this, &DomainServer::sendAddedNodes);
+    }
 
-            QByteArray rfcConnectionSecret = connectionSecretForNodes(node, addedNode).toRfc4122();
+    if (!_addedNodesTimer->isActive()) {
+        _addedNodesTimer->start();
+    }
+}
 
-            // replace the bytes at the end of the packet for the connection secret between these nodes
-            addNodePacket->write(rfcConnectionSecret);
+void DomainServer::sendAddedNodes() {
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
-            // send off this packet to the node
-            limitedNodeList->sendUnreliablePacket(*addNodePacket, *node);
+    // the lists look up the changed nodes, they're sent once we're done going through the nodes
+    std::vector<SharedNodePointer> nodes;
+    limitedNodeList->eachNode([&](const SharedNodePointer& node) {
+        if (node->getLinkedData() && node->getActiveSocket()) {
+            nodes.push_back(node);
         }
-    );
+    });
+
+    for (const auto& node : nodes) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        sendDomainListToNode(node, nodeData->getSendingSockAddr(), nodeData->getKnownListVersion(), true);
+    }
 }
 
 void DomainServer::processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> message) {
@@ -1459,6 +1543,7 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
     const QString URI_ASSIGNMENT = "/assignment";
     const QString URI_NODES = "/nodes";
     const QString URI_SETTINGS = "/settings";
+    const QString URI_METRICS = "/metrics";
 
     const QString UUID_REGEX_STRING = "[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}";
 
@@ -1613,6 +1698,47 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             // send the response
             connection->respond(HTTPConnection::StatusCode200, nodesDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
+            return true;
+        } else if (url.path() == URI_METRICS) {
+            // the metrics of the domain-server and of every node that has sent them with its stats, for Prometheus
+            QList<Metrics::Source> sources;
+
+            int numNodes = 0;
+            nodeList->eachNode([this, &sources, &numNodes](const SharedNodePointer& node){
+                ++numNodes;
+
+                auto nodeData = reinterpret_cast<DomainServerNodeData*>(node->getLinkedData());
+                QJsonObject metrics = nodeData->getStatsJSONObject()["metrics"].toObject();
+                if (metrics.isEmpty()) {
+                    return;
+                }
+
+                QString nodeTypeName = NodeType::getNodeTypeName(node->getType()).toLower().replace(' ', '-');
+
+                Metrics::Source source;
+                source.labels.append(qMakePair(QString("assignment"), nodeTypeName));
+                source.labels.append(qMakePair(QString("node"), uuidStringWithoutCurlyBraces(node->getUUID())));
+
+                SharedAssignmentPointer assignment = _allAssignments.value(nodeData->getAssignmentUUID());
+                if (assignment && !assignment->getPool().isEmpty()) {
+                    source.labels.append(qMakePair(QString("pool"), assignment->getPool()));
+                }
+
+                source.metrics = metrics;
+                sources.append(source);
+            });
+
+            Metrics::gauge("hifi_domain_server_nodes", "Nodes connected to the domain").set(numNodes);
+
+            Metrics::Source domainServerSource;
+            domainServerSource.labels.append(qMakePair(QString("assignment"), QString("domain-server")));
+            domainServerSource.metrics = Metrics::toJson();
+            sources.prepend(domainServerSource);
+
+            const QString PROMETHEUS_TEXT_MIME_TYPE = "text/plain; version=0.0.4";
+            connection->respond(HTTPConnection::StatusCode200, Metrics::toPrometheusText(sources),
+                                qPrintable(PROMETHEUS_TEXT_MIME_TYPE));
+
             return true;
         } else {
             // check if this is for json stats for a node
@@ -2008,6 +2134,9 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
     // if this peer connected via ICE then remove them from our ICE peers hash
     _gatekeeper.removeICEPeer(node->getUUID());
 
+    // the nodes that haven't had the removed node packet get the removal with their next domain list
+    recordNodeListChange(node);
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
 
     if (nodeData) {
@@ -12,6 +12,8 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
@@ -24,6 +26,7 @@
 #include <Assignment.h>
 #include <HTTPSConnection.h>
 #include <LimitedNodeList.h>
+#include <SharedUtil.h>
 
 #include "DomainGatekeeper.h"
 #include "DomainMetadata.h"
@@ -127,10 +130,18 @@ private:
 
     void handleKillNode(SharedNodePointer nodeToKill);
 
-    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr);
+    // Sends the node the nodes it is interested in: only what changed since the version of the list it has when that
+    // version is still known, all of them otherwise. With skipIfUnchanged nothing is sent if nothing changed for it.
+    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr,
+                              quint64 knownListVersion = 0, bool skipIfUnchanged = false);
+
+    // a node was added, removed or changed: the next domain lists have it
+    void recordNodeListChange(const SharedNodePointer& node);
 
     QUuid connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
+    // the nodes that connected within a short time go out together, in one domain list to each node
     void broadcastNewNode(const SharedNodePointer& node);
+    void sendAddedNodes();
 
     void parseAssignmentConfigs(QSet<Assignment::Type>& excludedTypes);
     void addStaticAssignmentToAssignmentHash(Assignment* newAssignment);
@@ -193,6 +204,20 @@ private:
     QTimer* _iceHeartbeatTimer { nullptr };
     QTimer* _metaverseHeartbeatTimer { nullptr };
     QTimer* _metaverseGroupCacheTimer { nullptr };
+    QTimer* _addedNodesTimer { nullptr };
+
+    struct NodeListChange {
+        quint64 version;
+        QUuid nodeID;
+        NodeType_t nodeType;
+    };
+    // the recent changes to the nodes, oldest first, each with the version of the domain list it made
+    std::deque<NodeListChange> _nodeListChanges;
+    // the version of the domain list starts at the time the domain-server started, so a node that still has
+    // the version of a domain-server before this one doesn't get only the changes since it
+    quint64 _nodeListVersion { usecTimestampNow() };
+    // the changes since an older version than this are gone
+    quint64 _oldestNodeListVersion { _nodeListVersion };
 
     QList<QHostAddress> _iceServerAddresses;
     QSet<QHostAddress> _failedIceServerAddresses;
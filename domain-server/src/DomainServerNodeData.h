@@ -62,6 +62,13 @@ public:
 
     bool wasAssigned() const { return _wasAssigned; };
     void setWasAssigned(bool wasAssigned) { _wasAssigned = wasAssigned; }
+
+    // the version of the domain list the node told us it has
+    quint64 getKnownListVersion() const { return _knownListVersion; }
+    void setKnownListVersion(quint64 knownListVersion) { _knownListVersion = knownListVersion; }
+
+    quint64 getLastFullListTime() const { return _lastFullListTime; }
+    void setLastFullListTime(quint64 lastFullListTime) { _lastFullListTime = lastFullListTime; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -85,6 +92,9 @@ private:
     QString _placeName;
 
     bool _wasAssigned { false };
+
+    quint64 _knownListVersion { 0 };
+    quint64 _lastFullListTime { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -0,0 +1,50 @@
+//
+//  VerifyUserSignatureTask.cpp
+//  domain-server/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "VerifyUserSignatureTask.h"
+
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+VerifyUserSignatureTask::VerifyUserSignatureTask(QObject* receiver, const QString& lowerUsername,
+                                                 const QByteArray& usernameWithToken,
+                                                 const QByteArray& usernameSignature,
+                                                 UserPublicKeyPointer publicKey) :
+    QRunnable(),
+    _receiver(receiver),
+    _lowerUsername(lowerUsername),
+    _usernameWithToken(usernameWithToken),
+    _usernameSignature(usernameSignature),
+    _publicKey(publicKey)
+{
+
+}
+
+void VerifyUserSignatureTask::run() {
+    int verifyResult = RSA_verify(NID_sha256,
+                                  reinterpret_cast<const unsigned char*>(_usernameWithToken.constData()),
+                                  _usernameWithToken.size(),
+                                  reinterpret_cast<const unsigned char*>(_usernameSignature.constData()),
+                                  _usernameSignature.size(),
+                                  _publicKey.get());
+
+    QMetaObject::invokeMethod(_receiver, "handleUserSignatureVerified", Qt::QueuedConnection,
+                              Q_ARG(QString, _lowerUsername), Q_ARG(bool, verifyResult == 1));
+}
+
+UserPublicKeyPointer VerifyUserSignatureTask::createPublicKey(const QByteArray& publicKeyData) {
+    const unsigned char* keyData = reinterpret_cast<const unsigned char*>(publicKeyData.constData());
+    RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &keyData, publicKeyData.size());
+    if (!rsaPublicKey) {
+        return UserPublicKeyPointer();
+    }
+    return UserPublicKeyPointer(rsaPublicKey, RSA_free);
+}
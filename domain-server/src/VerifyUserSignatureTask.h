@@ -0,0 +1,47 @@
+//
+//  VerifyUserSignatureTask.h
+//  domain-server/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_VerifyUserSignatureTask_h
+#define hifi_VerifyUserSignatureTask_h
+
+#include <memory>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QString>
+
+struct rsa_st;
+using UserPublicKeyPointer = std::shared_ptr<rsa_st>;
+
+// Checks the signature of the username and connection token a user connects with against their public key, on a
+// worker thread, then calls handleUserSignatureVerified(QString lowerUsername, bool verified) on the receiver
+class VerifyUserSignatureTask : public QRunnable {
+public:
+    VerifyUserSignatureTask(QObject* receiver, const QString& lowerUsername, const QByteArray& usernameWithToken,
+                            const QByteArray& usernameSignature, UserPublicKeyPointer publicKey);
+
+    void run() override;
+
+    // Null if the key data isn't an RSA public key
+    static UserPublicKeyPointer createPublicKey(const QByteArray& publicKeyData);
+
+private:
+    QObject* _receiver;
+    QString _lowerUsername;
+    QByteArray _usernameWithToken;
+    QByteArray _usernameSignature;
+    UserPublicKeyPointer _publicKey;
+};
+
+#endif // hifi_VerifyUserSignatureTask_h
@@ -21,12 +21,18 @@
 #include <LimitedNodeList.h>
 #include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
+#include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 
 const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
 const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
 
+// a public key is fetched again once it is this old, in case the domain has been given a new one
+const quint64 PUBLIC_KEY_REFRESH_USECS = 60 * 60 * USECS_PER_SECOND;
+// a public key no heartbeat has used for this long is dropped, it is kept that long for a domain that comes back
+const quint64 PUBLIC_KEY_TTL_USECS = 10 * 60 * USECS_PER_SECOND;
+
 IceServer::IceServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
     _id(QUuid::createUuid()),
@@ -164,40 +170,46 @@ SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
 }
 
 bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
-    // make sure we're not already waiting for a public key for this domain-server
-    if (!_pendingPublicKeyRequests.contains(domainID)) {
-        // check if we have a public key for this domain ID - if we do not then fire off the request for it
-        auto it = _domainPublicKeys.find(domainID);
-        if (it != _domainPublicKeys.end()) {
-
-            // attempt to verify the signature for this heartbeat
-            const auto rsaPublicKey = it->second.get();
-
-            if (rsaPublicKey) {
-                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
-                int verificationResult = RSA_verify(NID_sha256,
-                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
-                                                    hashedPlaintext.size(),
-                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
-                                                    signature.size(),
-                                                    rsaPublicKey);
-
-                if (verificationResult == 1) {
-                    // this is the only success case - we return true here to indicate that the heartbeat is verified
-                    return true;
-                } else {
-                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
-                }
+    // check if we have a public key for this domain ID - if we do not then fire off the request for it
+    auto it = _domainPublicKeys.find(domainID);
+    if (it != _domainPublicKeys.end() && it->second.key) {
+        DomainPublicKey& publicKey = it->second;
+        quint64 now = usecTimestampNow();
+
+        // an old key is still used while its replacement is requested
+        if (now - publicKey.fetchedUsecs > PUBLIC_KEY_REFRESH_USECS && !_pendingPublicKeyRequests.contains(domainID)) {
+            requestDomainPublicKey(domainID);
+        }
 
-            } else {
-                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
-                qWarning() << "Re-requesting public key from API";
-            }
+        // a heartbeat the same as the last one verified is verified, without checking the signature again
+        if (plaintext == publicKey.verifiedPlaintext && signature == publicKey.verifiedSignature) {
+            publicKey.lastUsedUsecs = now;
+            return true;
         }
 
-        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
-        // ask the metaverse API for the right public key and return false to indicate that this is not verified
+        // attempt to verify the signature for this heartbeat
+        auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
+        int verificationResult = RSA_verify(NID_sha256,
+                                            reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                            hashedPlaintext.size(),
+                                            reinterpret_cast<const unsigned char*>(signature.constData()),
+                                            signature.size(),
+                                            publicKey.key.get());
+
+        if (verificationResult == 1) {
+            // this is the only success case - we return true here to indicate that the heartbeat is verified
+            publicKey.lastUsedUsecs = now;
+            publicKey.verifiedPlaintext = plaintext;
+            publicKey.verifiedSignature = signature;
+            return true;
+        } else {
+            qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
+        }
+    }
+
+    // we could not verify this heartbeat (missing public key, bad actor, or the domain has a new key)
+    // ask the metaverse API for the right public key and return false to indicate that this is not verified
+    if (!_pendingPublicKeyRequests.contains(domainID)) {
         requestDomainPublicKey(domainID);
     }
 
@@ -252,7 +264,12 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
                 RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
 
                 if (rsaPublicKey) {
-                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                    DomainPublicKey& publicKey = _domainPublicKeys[domainID];
+                    publicKey.key = RSAUniquePtr(rsaPublicKey, RSA_free);
+                    publicKey.fetchedUsecs = usecTimestampNow();
+                    publicKey.lastUsedUsecs = publicKey.fetchedUsecs;
+                    publicKey.verifiedPlaintext.clear();
+                    publicKey.verifiedSignature.clear();
                 } else {
                     qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
                     qWarning() << "Public key will be re-requested on next heartbeat.";
@@ -297,9 +314,6 @@ void IceServer::clearInactivePeers() {
         if ((usecTimestampNow() - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
             qDebug() << "Removing peer from memory for inactivity -" << *peer;
 
-            // if we had a public key for this domain, remove it now
-            _domainPublicKeys.erase(peer->getUUID());
-
             // remove the peer object
             peerItem = _activePeers.erase(peerItem);
         } else {
@@ -307,4 +321,15 @@ void IceServer::clearInactivePeers() {
             ++peerItem;
         }
     }
+
+    // the public keys of domains that have stopped heartbeating are kept for a while, in case they come back
+    quint64 now = usecTimestampNow();
+    auto keyItem = _domainPublicKeys.begin();
+    while (keyItem != _domainPublicKeys.end()) {
+        if (now - keyItem->second.lastUsedUsecs > PUBLIC_KEY_TTL_USECS) {
+            keyItem = _domainPublicKeys.erase(keyItem);
+        } else {
+            ++keyItem;
+        }
+    }
 }
@@ -52,7 +52,16 @@ private:
     NetworkPeerHash _activePeers;
 
     using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
+    struct DomainPublicKey {
+        RSAUniquePtr key;
+        quint64 fetchedUsecs { 0 };
+        quint64 lastUsedUsecs { 0 };
+
+        // the last heartbeat verified with the key, a domain sends the same one until its sockets change
+        QByteArray verifiedPlaintext;
+        QByteArray verifiedSignature;
+    };
+    using DomainPublicKeyHash = std::unordered_map<QUuid, DomainPublicKey>;
     DomainPublicKeyHash _domainPublicKeys;
 
     QSet<QUuid> _pendingPublicKeyRequests;
@@ -59,6 +59,18 @@ Item {
                         font.pixelSize: root.fontSize
                         text: "Avatars: " + root.avatarCount
                     }
+                    Text {
+                        color: root.fontColor;
+                        font.pixelSize: root.fontSize
+                        visible: root.expanded
+                        text: "Avatar Animation Full/Half/Quarter/Off: " + root.avatarAnimationLODs
+                    }
+                    Text {
+                        color: root.fontColor;
+                        font.pixelSize: root.fontSize
+                        visible: root.expanded
+                        text: "Avatar Detail Full/No Face/No Attachments/Impostor: " + root.avatarRenderDetails
+                    }
                     Text {
                         color: root.fontColor;
                         font.pixelSize: root.fontSize
@@ -204,6 +216,12 @@ Item {
                         text: "Downloads: " + root.downloads + "/" + root.downloadLimit +
                               ", Pending: " + root.downloadsPending;
                     }
+                    Text {
+                        color: root.fontColor;
+                        font.pixelSize: root.fontSize
+                        visible: root.expanded;
+                        text: "Deferred work: " + root.deferredWork + ", oldest " + root.deferredWorkWait + " ms";
+                    }
                     Text {
                         color: root.fontColor;
                         font.pixelSize: root.fontSize
@@ -246,6 +264,12 @@ Item {
                         text: "Triangles: " + root.triangles +
                             " / Material Switches: " + root.materialSwitches
                     }
+                    Text {
+                        color: root.fontColor;
+                        font.pixelSize: root.fontSize
+                        visible: root.expanded;
+                        text: "Model triangles by LOD: " + root.lodTriangles
+                    }
                     Text {
                         color: root.fontColor;
                         font.pixelSize: root.fontSize
@@ -21,6 +21,7 @@
 #include <QtCore/QAbstractNativeEventFilter>
 #include <QtCore/QCommandLineParser>
 #include <QtCore/QMimeData>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QThreadPool>
 
 #include <QtGui/QScreen>
@@ -37,6 +38,7 @@
 #include <QtWidgets/QDesktopWidget>
 #include <QtWidgets/QMessageBox>
 
+#include <QtMultimedia/QAudioDeviceInfo>
 #include <QtMultimedia/QMediaPlayer>
 
 #include <QProcessEnvironment>
@@ -73,6 +75,7 @@
 #include <LogHandler.h>
 #include <MainWindow.h>
 #include <MessagesClient.h>
+#include <Model.h>
 #include <ModelEntityItem.h>
 #include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
@@ -96,6 +99,7 @@
 #include <ScriptEngines.h>
 #include <ScriptCache.h>
 #include <SoundCache.h>
+#include <StartupInitializer.h>
 #include <steamworks-wrapper/SteamClient.h>
 #include <Tooltip.h>
 #include <udt/PacketHeaders.h>
@@ -103,7 +107,10 @@
 #include <UsersScriptingInterface.h>
 #include <recording/Deck.h>
 #include <recording/Recorder.h>
+#include <shared/FrameScheduler.h>
+#include <shared/FrameTimingRing.h>
 #include <shared/StringHelpers.h>
+#include <shared/Tracing.h>
 #include <QmlWebWindowClass.h>
 #include <Preferences.h>
 #include <display-plugins/CompositorHelper.h>
@@ -198,6 +205,9 @@ static const float MIRROR_FIELD_OF_VIEW = 30.0f;
 
 static const quint64 TOO_LONG_SINCE_LAST_SEND_DOWNSTREAM_AUDIO_STATS = 1 * USECS_PER_SECOND;
 
+// the time each update gives the work that can wait, what doesn't fit runs in the next frames
+static const quint64 DEFERRED_WORK_BUDGET_USECS = 2 * USECS_PER_MSEC;
+
 static const QString INFO_HELP_PATH = "html/interface-welcome.html";
 static const QString INFO_EDIT_ENTITIES_PATH = "html/edit-commands.html";
 
@@ -400,7 +410,8 @@ static const QString STATE_SNAP_TURN = "SnapTurn";
 static const QString STATE_GROUNDED = "Grounded";
 static const QString STATE_NAV_FOCUSED = "NavigationFocused";
 
-bool setupEssentials(int& argc, char** argv) {
+bool setupEssentials(int& argc, char** argv, StartupInitializer& startup) {
+    TRACE_SCOPE("setupEssentials");
     unsigned int listenPort = 0; // bind to an ephemeral port by default
     const char** constArgv = const_cast<const char**>(argv);
     const char* portStr = getCmdOption(argc, constArgv, "--listenPort");
@@ -426,10 +437,22 @@ bool setupEssentials(int& argc, char** argv) {
 
     Setting::init();
 
+    // loading the runtime plugin libraries and looking for the audio devices for the first time take a while, and
+    // neither needs this thread, so they go on while the rest starts up
+    startup.startStep("PluginManager::loadPlugins", [] {
+        PluginManager::getInstance()->loadPlugins();
+    });
+    startup.startStep("QAudioDeviceInfo::availableDevices", [] {
+        QAudioDeviceInfo::availableDevices(QAudio::AudioInput);
+        QAudioDeviceInfo::availableDevices(QAudio::AudioOutput);
+    });
+
     // Set dependencies
     DependencyManager::set<AccountManager>(std::bind(&Application::getUserAgent, qApp));
     DependencyManager::set<ScriptEngines>();
     DependencyManager::set<Preferences>();
+    DependencyManager::set<FrameTimingRing>();
+    DependencyManager::set<FrameScheduler>();
     DependencyManager::set<recording::Deck>();
     DependencyManager::set<recording::Recorder>();
     DependencyManager::set<AddressManager>();
@@ -441,6 +464,7 @@ bool setupEssentials(int& argc, char** argv) {
     DependencyManager::set<Faceshift>();
     DependencyManager::set<DdeFaceTracker>();
     DependencyManager::set<EyeTracker>();
+    startup.waitFor("QAudioDeviceInfo::availableDevices");
     DependencyManager::set<AudioClient>();
     DependencyManager::set<AudioScope>();
     DependencyManager::set<DeferredLightingEffect>();
@@ -505,11 +529,11 @@ Q_GUI_EXPORT void qt_gl_set_global_share_context(QOpenGLContext *context);
 
 Setting::Handle<int> sessionRunTime{ "sessionRunTime", 0 };
 
-Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer) :
+Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, StartupInitializer& startup) :
     QApplication(argc, argv),
     _window(new MainWindow(desktop())),
     _sessionRunTimer(startupTimer),
-    _previousSessionCrashed(setupEssentials(argc, argv)),
+    _previousSessionCrashed(setupEssentials(argc, argv, startup)),
     _undoStackScriptingInterface(&_undoStack),
     _entitySimulation(new PhysicalEntitySimulation()),
     _physicsEngine(new PhysicsEngine(Vectors::ZERO)),
@@ -530,7 +554,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer) :
     _maxOctreePPS(maxOctreePacketsPerSecond.get()),
     _lastFaceTrackerUpdate(0)
 {
-
+    TRACE_SCOPE("Application::Application");
 
     PluginContainer* pluginContainer = dynamic_cast<PluginContainer*>(this); // set the container for any plugins that care
     PluginManager::getInstance()->setContainer(pluginContainer);
@@ -636,7 +660,8 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer) :
         }
     });
 
-    audioThread->start();
+    // capture and playback run on this thread, it must not wait behind the rendering and script threads
+    audioThread->start(QThread::TimeCriticalPriority);
 
     ResourceManager::init();
     // Make sure we don't time out during slow operations at startup
@@ -838,11 +863,12 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer) :
     connect(this, SIGNAL(aboutToQuit()), this, SLOT(aboutToQuit()));
 
     // hook up bandwidth estimator
+    // the recorder counts on the thread of the packet, so there's no event queued for each one
     QSharedPointer<BandwidthRecorder> bandwidthRecorder = DependencyManager::get<BandwidthRecorder>();
     connect(nodeList.data(), &LimitedNodeList::dataSent,
-        bandwidthRecorder.data(), &BandwidthRecorder::updateOutboundData);
+        bandwidthRecorder.data(), &BandwidthRecorder::updateOutboundData, Qt::DirectConnection);
     connect(nodeList.data(), &LimitedNodeList::dataReceived,
-        bandwidthRecorder.data(), &BandwidthRecorder::updateInboundData);
+        bandwidthRecorder.data(), &BandwidthRecorder::updateInboundData, Qt::DirectConnection);
 
     // FIXME -- I'm a little concerned about this.
     connect(getMyAvatar()->getSkeletonModel().get(), &SkeletonModel::skeletonLoaded,
@@ -1474,6 +1500,7 @@ Application::~Application() {
 }
 
 void Application::initializeGL() {
+    TRACE_SCOPE("Application::initializeGL");
     qCDebug(interfaceapp) << "Created Display Window.";
 
     // initialize glut for shape drawing; Qt apparently initializes it on OS X
@@ -1546,6 +1573,7 @@ FrameTimingsScriptingInterface _frameTimingsScriptingInterface;
 extern void setupPreferences();
 
 void Application::initializeUi() {
+    TRACE_SCOPE("Application::initializeUi");
     AddressBarDialog::registerType();
     ErrorDialog::registerType();
     LoginDialog::registerType();
@@ -1686,6 +1714,9 @@ void Application::paintGL() {
 
     _frameCount++;
 
+    auto frameTimings = DependencyManager::get<FrameTimingRing>();
+    frameTimings->mark(_frameCount, FrameTimingRing::RECORD_BEGIN);
+
     auto lastPaintBegin = usecTimestampNow();
     PROFILE_RANGE_EX(__FUNCTION__, 0xff0000ff, (uint64_t)_frameCount);
     PerformanceTimer perfTimer("paintGL");
@@ -1881,6 +1912,7 @@ void Application::paintGL() {
             // right eye.  There are FIXMEs in the relevant plugins
             _myCamera.setProjection(displayPlugin->getCullingProjection(_myCamera.getProjection()));
             renderArgs._context->enableStereo(true);
+            renderArgs._context->enableInstancedStereo(displayPlugin->isInstancedStereo());
             mat4 eyeOffsets[2];
             mat4 eyeProjections[2];
             auto baseProjection = renderArgs.getViewFrustum().getProjection();
@@ -1906,6 +1938,12 @@ void Application::paintGL() {
             renderArgs._context->setStereoProjections(eyeProjections);
             renderArgs._context->setStereoViews(eyeOffsets);
         }
+        // The display sets the frame rate the dynamic resolution keeps the GPU time of the frames in
+        auto resolutionConfig = _renderEngine->getConfiguration()->getConfig<BeginDynamicResolution>();
+        if (resolutionConfig && resolutionConfig->targetFrameRate != displayPlugin->getTargetFrameRate()) {
+            resolutionConfig->setTargetFrameRate(displayPlugin->getTargetFrameRate());
+        }
+
         renderArgs._blitFramebuffer = finalFramebuffer;
         displaySide(&renderArgs, _myCamera);
     }
@@ -1922,6 +1960,7 @@ void Application::paintGL() {
         PROFILE_RANGE(__FUNCTION__ "/pluginOutput");
         PerformanceTimer perfTimer("pluginOutput");
         _frameCounter.increment();
+        frameTimings->mark(_frameCount, FrameTimingRing::RECORD_END);
         displayPlugin->submitFrame(frame);
     }
 
@@ -2906,6 +2945,12 @@ bool Application::shouldPaint(float nsecsElapsed) {
         return false;
     }
 
+    // Wait for the present thread to pick up the last frame rather than record one it would drop,
+    // the update of the next frame then overlaps the execution of the last one
+    if (displayPlugin->isFrameQueueFull()) {
+        return false;
+    }
+
     // Sync up the _renderedFrameIndex
     _renderedFrameIndex = displayPlugin->presentCount();
 
@@ -3166,6 +3211,7 @@ bool Application::exportEntities(const QString& filename, float x, float y, floa
 }
 
 void Application::loadSettings() {
+    TRACE_SCOPE("Application::loadSettings");
 
     sessionRunTime.set(0); // Just clean living. We're about to saveSettings, which will update value.
     DependencyManager::get<AudioClient>()->loadSettings();
@@ -3228,9 +3274,11 @@ QVector<EntityItemID> Application::pasteEntities(float x, float y, float z) {
 }
 
 void Application::initDisplay() {
+    TRACE_SCOPE("Application::initDisplay");
 }
 
 void Application::init() {
+    TRACE_SCOPE("Application::init");
     // Make sure Login state is up to date
     DependencyManager::get<DialogsManager>()->toggleLoginDialog();
 
@@ -3301,6 +3349,9 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    QString hullCachePath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+    hullCachePath = !hullCachePath.isEmpty() ? hullCachePath : "interfaceCache";
+    _shapeManager.setHullCache(std::make_shared<HullCache>(hullCachePath + "/collisionHulls"));
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
 
@@ -3642,6 +3693,11 @@ void Application::update(float deltaTime) {
 
     PROFILE_RANGE_EX(__FUNCTION__, 0xffff0000, (uint64_t)_frameCount + 1);
 
+    // the update is for the frame painted next
+    auto frameTimings = DependencyManager::get<FrameTimingRing>();
+    frameTimings->mark(_frameCount + 1, FrameTimingRing::UPDATE_BEGIN);
+    Finally markUpdateEnd([&] { frameTimings->mark(_frameCount + 1, FrameTimingRing::UPDATE_END); });
+
     bool showWarnings = Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings);
     PerformanceWarning warn(showWarnings, "Application::update()");
 
@@ -3896,10 +3952,16 @@ void Application::update(float deltaTime) {
         // if it's been a while since our last query or the view has significantly changed then send a query, otherwise suppress it
         if (queryIsDue || viewIsDifferentEnough) {
             _lastQueriedTime = now;
-            if (DependencyManager::get<SceneScriptingInterface>()->shouldRenderEntities()) {
-                queryOctree(NodeType::EntityServer, PacketType::EntityQuery, _entityServerJurisdictions);
-            }
             _lastQueriedViewFrustum = _viewFrustum;
+            // the packets are built from the view of the frame the budget gets to them in
+            DependencyManager::get<FrameScheduler>()->post("queryOctree", [this] {
+                PerformanceTimer perfTimer("queryOctree");
+                QMutexLocker viewLocker(&_viewMutex);
+                if (DependencyManager::get<SceneScriptingInterface>()->shouldRenderEntities()) {
+                    queryOctree(NodeType::EntityServer, PacketType::EntityQuery, _entityServerJurisdictions);
+                }
+                queryAvatars();
+            });
         }
     }
 
@@ -3925,6 +3987,13 @@ void Application::update(float deltaTime) {
 
     avatarManager->postUpdate(deltaTime);
 
+    {
+        PROFILE_RANGE_EX("ClusterMatrices", 0xffff0000, (uint64_t)0);
+
+        // the render item updates of the models find the matrices they need already computed, in parallel
+        Model::updatePendingClusterMatrices();
+    }
+
     {
         PROFILE_RANGE_EX("PreRenderLambdas", 0xffff0000, (uint64_t)0);
 
@@ -3936,6 +4005,12 @@ void Application::update(float deltaTime) {
     }
 
     AnimDebugDraw::getInstance().update();
+
+    {
+        PROFILE_RANGE_EX("DeferredWork", 0xffff0000, (uint64_t)0);
+        PerformanceTimer perfTimer("deferredWork");
+        DependencyManager::get<FrameScheduler>()->run(DEFERRED_WORK_BUDGET_USECS);
+    }
 }
 
 
@@ -3990,6 +4065,17 @@ int Application::sendNackPackets() {
     return packetsSent;
 }
 
+// the avatar-mixer ranks the other avatars it sends us by whether they are in this view
+// the caller must hold _viewMutex
+void Application::queryAvatars() {
+    QByteArray viewFrustumData = _viewFrustum.toByteArray();
+
+    auto avatarQueryPacket = NLPacket::create(PacketType::AvatarQuery, viewFrustumData.size());
+    avatarQueryPacket->write(viewFrustumData);
+
+    DependencyManager::get<NodeList>()->broadcastToNodes(std::move(avatarQueryPacket), NodeSet() << NodeType::AvatarMixer);
+}
+
 void Application::queryOctree(NodeType_t serverType, PacketType packetType, NodeToJurisdictionMap& jurisdictions, bool forceResend) {
 
     if (!_settingsLoaded) {
@@ -4012,6 +4098,8 @@ void Application::queryOctree(NodeType_t serverType, PacketType packetType, Node
     auto lodManager = DependencyManager::get<LODManager>();
     _octreeQuery.setOctreeSizeScale(lodManager->getOctreeSizeScale());
     _octreeQuery.setBoundaryLevelAdjust(lodManager->getBoundaryLevelAdjust());
+    _octreeQuery.setHeavyPropertiesDistance(DEFAULT_HEAVY_PROPERTIES_DISTANCE);
+    _octreeQuery.setReceiveStats(_octreeProcessor.getProcessedPPS(), _octreeProcessor.packetsToProcessCount());
 
     // Iterate all of the nodes, and get a count of how many octree servers we have...
     int totalServers = 0;
@@ -4824,6 +4912,7 @@ void Application::registerScriptEngineWithApplicationServices(ScriptEngine* scri
     AvatarManager::registerMetaTypes(scriptEngine);
 
     scriptEngine->registerGlobalObject("Rates", new RatesScriptingInterface(this));
+    scriptEngine->registerGlobalObject("FrameTimings", &_frameTimingsScriptingInterface);
 
     // hook our avatar and avatar hash map object into this script engine
     scriptEngine->registerGlobalObject("MyAvatar", getMyAvatar());
@@ -8,7 +8,12 @@
 
 #include "FrameTimingsScriptingInterface.h"
 
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+
 #include <TextureCache.h>
+#include <shared/FrameTimingRing.h>
+#include <shared/Tracing.h>
 
 void FrameTimingsScriptingInterface::start() {
     _values.clear();
@@ -51,3 +56,49 @@ QVariantList FrameTimingsScriptingInterface::getValues() const {
     }
     return result;
 }
+
+QVariantList FrameTimingsScriptingInterface::getRecentFrames() const {
+    QVariantList result;
+    for (const auto& frame : DependencyManager::get<FrameTimingRing>()->getFrameTimings()) {
+        QVariantMap frameMap;
+        frameMap["frame"] = frame.frameIndex;
+        for (int stage = 0; stage < FrameTimingRing::NUM_STAGES; stage++) {
+            frameMap[FrameTimingRing::getStageName((FrameTimingRing::Stage)stage)] = frame.timestamps[stage];
+        }
+        frameMap["presents"] = frame.numPresents;
+        frameMap["vsyncMisses"] = frame.numVsyncMisses;
+        result << frameMap;
+    }
+    return result;
+}
+
+QString FrameTimingsScriptingInterface::getRecentFramesCSV() const {
+    return DependencyManager::get<FrameTimingRing>()->toCSV();
+}
+
+QString FrameTimingsScriptingInterface::getRecentFramesTrace() const {
+    return QString::fromUtf8(DependencyManager::get<FrameTimingRing>()->toChromeTrace());
+}
+
+bool FrameTimingsScriptingInterface::saveRecentFrames(const QString& filename) const {
+    auto frameTimings = DependencyManager::get<FrameTimingRing>();
+    QByteArray data = filename.endsWith(".json", Qt::CaseInsensitive) ? frameTimings->toChromeTrace() : frameTimings->toCSV().toUtf8();
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "FrameTimings: couldn't write" << filename;
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
+void FrameTimingsScriptingInterface::setTracingEnabled(bool enabled) {
+    Tracing::setEnabled(enabled);
+}
+
+bool FrameTimingsScriptingInterface::saveTrace(const QString& filename) const {
+    return Tracing::saveChromeTrace(filename);
+}
+
+void FrameTimingsScriptingInterface::clearTrace() {
+    Tracing::clear();
+}
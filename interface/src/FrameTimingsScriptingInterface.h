@@ -9,6 +9,7 @@
 #pragma once
 #include <stdint.h>
 #include <QtCore/QObject>
+#include <QtCore/QVariant>
 
 class FrameTimingsScriptingInterface : public QObject {
     Q_OBJECT
@@ -22,6 +23,18 @@ public:
     Q_INVOKABLE void finish();
     Q_INVOKABLE QVariantList getValues() const;
 
+    // The timestamps of the update, record, execute and present of the last frames, and their missed vsyncs, oldest first
+    Q_INVOKABLE QVariantList getRecentFrames() const;
+    Q_INVOKABLE QString getRecentFramesCSV() const;
+    Q_INVOKABLE QString getRecentFramesTrace() const;
+    // A file name ending in .json gets the chrome://tracing trace, any other the CSV
+    Q_INVOKABLE bool saveRecentFrames(const QString& filename) const;
+
+    // The scopes traced in the render jobs and elsewhere, from when tracing is turned on, as a chrome://tracing trace
+    Q_INVOKABLE void setTracingEnabled(bool enabled);
+    Q_INVOKABLE bool saveTrace(const QString& filename) const;
+    Q_INVOKABLE void clearTrace();
+
 
     uint64_t getMax() const { return _max; }
     uint64_t getMin() const { return _min; }
@@ -32,6 +32,7 @@ public:
     void reallocateScope(int frames);
     
     void render(RenderArgs* renderArgs, int width, int height);
+    bool isEnabled() const { return _isEnabled; }
     
 public slots:
     void toggle();
@@ -59,6 +59,17 @@ const float DISPLAYNAME_ALPHA = 1.0f;
 const float DISPLAYNAME_BACKGROUND_ALPHA = 0.4f;
 const glm::vec3 HAND_TO_PALM_OFFSET(0.0f, 0.12f, 0.08f);
 
+// an avatar this many times closer than the distance the LOD manager would stop drawing it at is animated every frame,
+// the rate halves below each step down
+const float FULL_RATE_ANIMATION_VISIBILITY = 8.0f;
+const float HALF_RATE_ANIMATION_VISIBILITY = 4.0f;
+const int FRAMES_PER_RIG_UPDATE[Avatar::NUM_ANIMATION_LODS] = { 1, 2, 4, 1 };
+// the same for the render details, down to the distance the avatar would no longer be drawn at, which is an impostor
+const float VISIBILITY_FOR_RENDER_DETAIL[Avatar::IMPOSTOR_DETAIL] = { 8.0f, 4.0f, 1.0f };
+// an avatar has to be this much closer to get more detail back than it needed to keep it, so it doesn't flicker on an edge
+const float RENDER_DETAIL_HYSTERESIS = 1.1f;
+const glm::vec4 IMPOSTOR_COLOR(0.5f, 0.5f, 0.5f, 1.0f);
+
 namespace render {
     template <> const ItemKey payloadGetKey(const AvatarSharedPointer& avatar) {
         return ItemKey::Builder::opaqueShape();
@@ -257,6 +268,12 @@ void Avatar::updateAvatarEntities() {
 
 
 void Avatar::simulate(float deltaTime) {
+    beginSimulate(deltaTime);
+    simulateRig();
+    endSimulate(deltaTime);
+}
+
+void Avatar::beginSimulate(float deltaTime) {
     PerformanceTimer perfTimer("simulate");
 
     if (!isDead() && !_motionState) {
@@ -287,14 +304,52 @@ void Avatar::simulate(float deltaTime) {
     bool avatarPositionInView = viewFrustum.sphereIntersectsFrustum(getPosition(), boundingRadius);
     bool avatarMeshInView = viewFrustum.boxIntersectsFrustum(_skeletonModel->getRenderableMeshBound());
 
-    if (_shouldAnimate && !_shouldSkipRender && (avatarPositionInView || avatarMeshInView)) {
-        {
-            PerformanceTimer perfTimer("skeleton");
-            _skeletonModel->getRig()->copyJointsFromJointData(_jointData);
-            _skeletonModel->simulate(deltaTime, _hasNewJointRotations || _hasNewJointTranslations);
+    _isSkeletonAnimating = _shouldAnimate && !_shouldSkipRender && _renderDetail != IMPOSTOR_DETAIL &&
+        (avatarPositionInView || avatarMeshInView);
+    _animationLOD = _isSkeletonAnimating ? calculateAnimationLOD(viewFrustum.getPosition()) : NO_ANIMATION;
+
+    // between rig updates the joints hold their last pose while the skeleton keeps following the avatar,
+    // an avatar that comes back into view is updated right away
+    if (_isSkeletonAnimating) {
+        _rigDeltaTime += deltaTime;
+        _framesUntilRigUpdate = std::min(_framesUntilRigUpdate, FRAMES_PER_RIG_UPDATE[_animationLOD]);
+        _isRigUpdating = --_framesUntilRigUpdate <= 0;
+    } else {
+        _rigDeltaTime = 0.0f;
+        _framesUntilRigUpdate = 0;
+        _isRigUpdating = false;
+    }
+
+    // the rig update is left for simulateRig
+    _skeletonModel->setRigUpdateDeferred(true);
+    if (_isRigUpdating) {
+        PerformanceTimer perfTimer("skeleton");
+        _skeletonModel->getRig()->copyJointsFromJointData(_jointData);
+        _skeletonModel->simulate(_rigDeltaTime, _hasNewJointRotations || _hasNewJointTranslations);
+        _hasNewJointRotations = false;
+        _hasNewJointTranslations = false;
+        _framesUntilRigUpdate = FRAMES_PER_RIG_UPDATE[_animationLOD];
+        _rigDeltaTime = 0.0f;
+    } else if (_isSkeletonAnimating) {
+        _skeletonModel->simulate(deltaTime, false);
+    } else {
+        // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+        getHead()->setPosition(getPosition());
+        _skeletonModel->simulate(deltaTime, false);
+    }
+    _skeletonModel->setRigUpdateDeferred(false);
+}
+
+void Avatar::simulateRig() {
+    _skeletonModel->simulateDeferredRig();
+}
+
+void Avatar::endSimulate(float deltaTime) {
+    PerformanceTimer perfTimer("simulate");
+
+    if (_isSkeletonAnimating) {
+        if (_isRigUpdating) {
             locationChanged(); // joints changed, so if there are any children, update them.
-            _hasNewJointRotations = false;
-            _hasNewJointTranslations = false;
         }
         {
             PerformanceTimer perfTimer("head");
@@ -307,10 +362,6 @@ void Avatar::simulate(float deltaTime) {
             head->setScale(getUniformScale());
             head->simulate(deltaTime, false, !_shouldAnimate);
         }
-    } else {
-        // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
-        getHead()->setPosition(getPosition());
-        _skeletonModel->simulate(deltaTime, false);
     }
 
     // update animation for display name fade in/out
@@ -332,11 +383,77 @@ void Avatar::simulate(float deltaTime) {
 
     measureMotionDerivatives(deltaTime);
 
-    simulateAttachments(deltaTime);
+    if (_renderDetail < NO_ATTACHMENT_DETAIL) {
+        simulateAttachments(deltaTime);
+    }
     updatePalms();
     updateAvatarEntities();
 }
 
+float Avatar::calculateVisibleDistance() const {
+    auto lodManager = DependencyManager::get<LODManager>();
+
+    // see calculateRenderAccuracy
+    float visibleDistance = boundaryDistanceForRenderLevel(lodManager->getBoundaryLevelAdjust(),
+        lodManager->getOctreeSizeScale()) / OCTREE_TO_MESH_RATIO;
+    return visibleDistance * 2.0f * getBoundingRadius() / (float)TREE_SCALE;
+}
+
+Avatar::AnimationLOD Avatar::calculateAnimationLOD(const glm::vec3& cameraPosition) const {
+    float visibleDistance = calculateVisibleDistance();
+    float distance = glm::distance(cameraPosition, getPosition());
+    if (distance * FULL_RATE_ANIMATION_VISIBILITY <= visibleDistance) {
+        return FULL_RATE_ANIMATION;
+    } else if (distance * HALF_RATE_ANIMATION_VISIBILITY <= visibleDistance) {
+        return HALF_RATE_ANIMATION;
+    } else {
+        return QUARTER_RATE_ANIMATION;
+    }
+}
+
+void Avatar::updateRenderDetail(const glm::vec3& cameraPosition, bool isWithinBudget) {
+    RenderDetail detail = IMPOSTOR_DETAIL;
+    if (isWithinBudget) {
+        float visibleDistance = calculateVisibleDistance();
+        float distance = glm::distance(cameraPosition, getPosition());
+        for (int i = FULL_DETAIL; i < IMPOSTOR_DETAIL; i++) {
+            float hysteresis = (i < _renderDetail) ? RENDER_DETAIL_HYSTERESIS : 1.0f;
+            if (distance * VISIBILITY_FOR_RENDER_DETAIL[i] * hysteresis <= visibleDistance) {
+                detail = (RenderDetail)i;
+                break;
+            }
+        }
+    }
+    _renderDetail = detail;
+
+    // the models are only reset in the scene when their visibility changes, attachments added since are caught here
+    render::ScenePointer scene = qApp->getMain3DScene();
+    _skeletonModel->setVisibleInScene(_renderDetail != IMPOSTOR_DETAIL, scene);
+    for (auto& attachmentModel : _attachmentModels) {
+        attachmentModel->setVisibleInScene(_renderDetail < NO_ATTACHMENT_DETAIL, scene);
+    }
+}
+
+void Avatar::renderImpostor(gpu::Batch& batch, const glm::vec3& cameraPosition) {
+    PROFILE_RANGE_BATCH(batch, __FUNCTION__);
+    AABox bounds = getBounds();
+    glm::vec3 center = bounds.calcCenter();
+    glm::vec3 dimensions = bounds.getDimensions();
+
+    // turned about the vertical to face the camera, as wide as the avatar's bounds and as tall
+    glm::vec3 toCamera = cameraPosition - center;
+    float yaw = (toCamera.x == 0.0f && toCamera.z == 0.0f) ? 0.0f : glm::atan(toCamera.x, toCamera.z);
+    Transform transform;
+    transform.setTranslation(center);
+    transform.setRotation(glm::quat(glm::vec3(0.0f, yaw, 0.0f)));
+    transform.setScale(glm::vec3(glm::max(dimensions.x, dimensions.z), dimensions.y, 1.0f));
+    batch.setModelTransform(transform);
+
+    auto geometryCache = DependencyManager::get<GeometryCache>();
+    geometryCache->bindSimpleProgram(batch);
+    geometryCache->renderQuad(batch, glm::vec2(-0.5f), glm::vec2(0.5f), IMPOSTOR_COLOR);
+}
+
 bool Avatar::isLookingAtMe(AvatarSharedPointer avatar) const {
     const float HEAD_SPHERE_RADIUS = 0.1f;
     glm::vec3 theirLookAt = dynamic_pointer_cast<Avatar>(avatar)->getHead()->getLookAtPosition();
@@ -539,6 +656,10 @@ void Avatar::render(RenderArgs* renderArgs, const glm::vec3& cameraPosition) {
     {
         fixupModelsInScene();
 
+        if (_renderDetail == IMPOSTOR_DETAIL && renderArgs->_renderMode != RenderArgs::SHADOW_RENDER_MODE) {
+            renderImpostor(batch, cameraPosition);
+        }
+
         if (renderArgs->_renderMode != RenderArgs::SHADOW_RENDER_MODE) {
             // add local lights
             const float BASE_LIGHT_DISTANCE = 2.0f;
@@ -66,6 +66,36 @@ public:
     void init();
     void updateAvatarEntities();
     void simulate(float deltaTime);
+
+    // simulate() in three steps, so that the rigs of many avatars can be evaluated at once in between.
+    // beginSimulate and endSimulate belong to the main thread, simulateRig only touches the avatar's rig and
+    // skeleton model and may run on any thread.
+    void beginSimulate(float deltaTime);
+    void simulateRig();
+    void endSimulate(float deltaTime);
+
+    // how often the rig is updated, picked in beginSimulate from how large the avatar is on screen
+    enum AnimationLOD {
+        FULL_RATE_ANIMATION = 0,
+        HALF_RATE_ANIMATION,
+        QUARTER_RATE_ANIMATION,
+        NO_ANIMATION,
+        NUM_ANIMATION_LODS
+    };
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+
+    // how much of the avatar is drawn, picked before beginSimulate from how large the avatar is on screen
+    enum RenderDetail {
+        FULL_DETAIL = 0,
+        NO_BLENDSHAPE_DETAIL, // the face holds its last blendshapes
+        NO_ATTACHMENT_DETAIL, // and the attachments are neither simulated nor drawn
+        IMPOSTOR_DETAIL, // a flat stand-in facing the camera, the skeleton isn't animated or drawn either
+        NUM_RENDER_DETAILS
+    };
+    RenderDetail getRenderDetail() const { return _renderDetail; }
+    // an avatar outside of the avatar manager's budget is drawn as an impostor whatever its size
+    void updateRenderDetail(const glm::vec3& cameraPosition, bool isWithinBudget);
+
     virtual void simulateAttachments(float deltaTime);
 
     virtual void render(RenderArgs* renderArgs, const glm::vec3& cameraPosition);
@@ -250,6 +280,17 @@ protected:
 private:
     bool _initialized;
     bool _shouldAnimate { true };
+    bool _isSkeletonAnimating { false }; // the skeleton is being animated in the simulate underway
+    bool _isRigUpdating { false }; // and its rig is getting a full update
+    AnimationLOD _animationLOD { FULL_RATE_ANIMATION };
+    int _framesUntilRigUpdate { 0 };
+    float _rigDeltaTime { 0.0f }; // time since the last rig update, including this frame
+
+    AnimationLOD calculateAnimationLOD(const glm::vec3& cameraPosition) const;
+    RenderDetail _renderDetail { FULL_DETAIL };
+    // the distance the LOD manager would stop drawing something the size of this avatar at
+    float calculateVisibleDistance() const;
+    void renderImpostor(gpu::Batch& batch, const glm::vec3& cameraPosition);
     bool _shouldSkipRender { false };
     bool _isLookAtTarget { false };
 
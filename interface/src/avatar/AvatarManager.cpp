@@ -9,7 +9,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include <QScriptEngine>
 
@@ -18,6 +20,7 @@
 #pragma GCC diagnostic ignored "-Wdouble-promotion"
 #endif
 
+#include <glm/gtx/norm.hpp>
 #include <glm/gtx/string_cast.hpp>
 
 #if defined(__GNUC__) && !defined(__clang__)
@@ -25,6 +28,7 @@
 #endif
 
 
+#include <ParallelFor.h>
 #include <PerfStat.h>
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
@@ -120,6 +124,9 @@ void AvatarManager::updateMyAvatar(float deltaTime) {
 }
 
 void AvatarManager::updateOtherAvatars(float deltaTime) {
+    std::fill(std::begin(_animationLODCounts), std::end(_animationLODCounts), 0);
+    std::fill(std::begin(_renderDetailCounts), std::end(_renderDetailCounts), 0);
+
     // lock the hash for read to check the size
     QReadLocker lock(&_hashLock);
 
@@ -135,8 +142,10 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     PerformanceTimer perfTimer("otherAvatars");
     render::PendingChanges pendingChanges;
 
-    // simulate avatars
+    // simulate avatars, their rigs are evaluated in parallel once every avatar has been set up for it
     auto hashCopy = getHashCopy();
+    std::vector<std::shared_ptr<Avatar>> simulatedAvatars;
+    simulatedAvatars.reserve(hashCopy.size());
 
     AvatarHash::iterator avatarIterator = hashCopy.begin();
     while (avatarIterator != hashCopy.end()) {
@@ -150,12 +159,40 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             removeAvatar(avatarIterator.key());
             ++avatarIterator;
         } else {
-            avatar->simulate(deltaTime);
+            simulatedAvatars.push_back(avatar);
             ++avatarIterator;
-
-            avatar->updateRenderItem(pendingChanges);
         }
     }
+
+    // the render details are picked before simulating, the budget goes to the closest avatars
+    ViewFrustum viewFrustum;
+    qApp->copyViewFrustum(viewFrustum);
+    glm::vec3 cameraPosition = viewFrustum.getPosition();
+    if ((int)simulatedAvatars.size() > _avatarRenderBudget) {
+        std::sort(simulatedAvatars.begin(), simulatedAvatars.end(),
+            [&](const std::shared_ptr<Avatar>& a, const std::shared_ptr<Avatar>& b) {
+                return glm::distance2(cameraPosition, a->getPosition()) < glm::distance2(cameraPosition, b->getPosition());
+            });
+    }
+    for (int i = 0; i < (int)simulatedAvatars.size(); ++i) {
+        auto& avatar = simulatedAvatars[i];
+        avatar->updateRenderDetail(cameraPosition, i < _avatarRenderBudget);
+        avatar->beginSimulate(deltaTime);
+    }
+
+    {
+        PerformanceTimer perfTimer("rigs");
+        parallelFor((int)simulatedAvatars.size(), [&](int index) {
+            simulatedAvatars[index]->simulateRig();
+        });
+    }
+
+    for (auto& avatar : simulatedAvatars) {
+        avatar->endSimulate(deltaTime);
+        avatar->updateRenderItem(pendingChanges);
+        ++_animationLODCounts[avatar->getAnimationLOD()];
+        ++_renderDetailCounts[avatar->getRenderDetail()];
+    }
     qApp->getMain3DScene()->enqueuePendingChanges(pendingChanges);
 
     // simulate avatar fades
@@ -12,6 +12,8 @@
 #ifndef hifi_AvatarManager_h
 #define hifi_AvatarManager_h
 
+#include <algorithm>
+
 #include <QtCore/QHash>
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
@@ -52,6 +54,16 @@ public:
 
     bool shouldShowReceiveStats() const { return _shouldShowReceiveStats; }
 
+    // the number of other avatars at the given animation LOD in the last updateOtherAvatars
+    int getAnimationLODCount(Avatar::AnimationLOD lod) const { return _animationLODCounts[lod]; }
+    // and at the given render detail
+    int getRenderDetailCount(Avatar::RenderDetail detail) const { return _renderDetailCounts[detail]; }
+
+    // the most other avatars drawn with their models, the farther ones are drawn as impostors
+    static const int DEFAULT_AVATAR_RENDER_BUDGET = 50;
+    Q_INVOKABLE void setAvatarRenderBudget(int budget) { _avatarRenderBudget = std::max(budget, 0); }
+    Q_INVOKABLE int getAvatarRenderBudget() const { return _avatarRenderBudget; }
+
     class LocalLight {
     public:
         glm::vec3 color;
@@ -101,6 +113,10 @@ private:
 
     bool _shouldShowReceiveStats = false;
 
+    int _animationLODCounts[Avatar::NUM_ANIMATION_LODS] {};
+    int _renderDetailCounts[Avatar::NUM_RENDER_DETAILS] {};
+    int _avatarRenderBudget { DEFAULT_AVATAR_RENDER_BUDGET };
+
     std::list<QPointer<AudioInjector>> _collisionInjectors;
 
     SetOfAvatarMotionStates _motionStatesThatMightUpdate;
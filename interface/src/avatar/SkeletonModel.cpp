@@ -223,7 +223,10 @@ void SkeletonModel::updateAttitude() {
 // but just before head has been simulated.
 void SkeletonModel::simulate(float deltaTime, bool fullUpdate) {
     updateAttitude();
-    setBlendshapeCoefficients(_owningAvatar->getHead()->getBlendshapeCoefficients());
+    // far away the face keeps its blendshapes, so the blender isn't run for it
+    if (_owningAvatar->getRenderDetail() == Avatar::FULL_DETAIL) {
+        setBlendshapeCoefficients(_owningAvatar->getHead()->getBlendshapeCoefficients());
+    }
 
     Model::simulate(deltaTime, fullUpdate);
 
@@ -10,6 +10,9 @@
 //
 
 #include "SoftAttachmentModel.h"
+
+#include <GLMHelpers.h>
+
 #include "InterfaceLogging.h"
 
 SoftAttachmentModel::SoftAttachmentModel(RigPointer rig, QObject* parent, RigPointer rigOverride) :
@@ -37,12 +40,7 @@ int SoftAttachmentModel::getJointIndexOverride(int i) const {
 
 // virtual
 // use the _rigOverride matrices instead of the Model::_rig
-void SoftAttachmentModel::updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation) {
-    if (!_needsUpdateClusterMatrices) {
-        return;
-    }
-    _needsUpdateClusterMatrices = false;
-
+void SoftAttachmentModel::computeClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation) {
     const FBXGeometry& geometry = getFBXGeometry();
 
     glm::mat4 modelToWorld = glm::mat4_cast(modelOrientation);
@@ -61,7 +59,7 @@ void SoftAttachmentModel::updateClusterMatrices(glm::vec3 modelPosition, glm::qu
             } else {
                 jointMatrix = _rig->getJointTransform(cluster.jointIndex);
             }
-            state.clusterMatrices[j] = modelToWorld * jointMatrix * cluster.inverseBindMatrix;
+            multiplyMat4(modelToWorld * jointMatrix, cluster.inverseBindMatrix, state.clusterMatrices[j]);
         }
 
         // Once computed the cluster matrices, update the buffer(s)
@@ -75,10 +73,4 @@ void SoftAttachmentModel::updateClusterMatrices(glm::vec3 modelPosition, glm::qu
             }
         }
     }
-
-    // post the blender if we're not currently waiting for one to finish
-    if (geometry.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
-        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        DependencyManager::get<ModelBlender>()->noteRequiresBlend(getThisPointer());
-    }
 }
@@ -31,9 +31,10 @@ public:
     ~SoftAttachmentModel();
 
     virtual void updateRig(float deltaTime, glm::mat4 parentTransform) override;
-    virtual void updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation) override;
 
 protected:
+    virtual void computeClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation) override;
+
     int getJointIndexOverride(int i) const;
 
     RigPointer _rigOverride;
@@ -20,7 +20,10 @@
 #include <QTranslator>
 
 #include <gl/OpenGLVersionChecker.h>
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
+#include <StartupInitializer.h>
+#include <shared/Tracing.h>
 
 #include <steamworks-wrapper/SteamClient.h>
 
@@ -124,6 +127,13 @@ int main(int argc, const char* argv[]) {
     QElapsedTimer startupTime;
     startupTime.start();
 
+    // a chrome://tracing trace of the steps of the startup is saved to the file given with this
+    const char* TRACE_STARTUP = "--traceStartup";
+    const char* traceStartupFilename = getCmdOption(argc, argv, TRACE_STARTUP);
+    if (traceStartupFilename) {
+        Tracing::setEnabled(true);
+    }
+
     // Debug option to demonstrate that the client's local time does not
     // need to be in sync with any other network node. This forces clock
     // skew for the individual client
@@ -145,7 +155,19 @@ int main(int argc, const char* argv[]) {
     int exitCode;
     {
         QSettings::setDefaultFormat(QSettings::IniFormat);
-        Application app(argc, const_cast<char**>(argv), startupTime);
+        StartupInitializer startup;
+        Application app(argc, const_cast<char**>(argv), startupTime, startup);
+
+        // anything the startup didn't wait for is still done before the first frame
+        startup.waitForAll();
+        for (auto& timing : startup.getTimings()) {
+            qCDebug(interfaceapp, "Startup step %s took %llu msecs.", timing.name,
+                    (unsigned long long)((timing.endNsecs - timing.beginNsecs) / NSECS_PER_MSEC));
+        }
+        if (traceStartupFilename) {
+            Tracing::setEnabled(false);
+            Tracing::saveChromeTrace(traceStartupFilename);
+        }
 
         // If we failed the OpenGLVersion check, log it.
         if (override) {
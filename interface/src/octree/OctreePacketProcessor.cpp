@@ -52,7 +52,7 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
         
         if (piggybackBytes) {
             // construct a new packet from the piggybacked one
-            auto buffer = std::unique_ptr<char[]>(new char[piggybackBytes]);
+            auto buffer = udt::PacketBufferPool::allocate(piggybackBytes);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggybackBytes);
             
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggybackBytes, message->getSenderSockAddr());
@@ -92,13 +92,18 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
     switch(packetType) {
         case PacketType::EntityErase: {
             if (DependencyManager::get<SceneScriptingInterface>()->shouldRenderEntities()) {
+                // the entity data that came before the erase goes in first
+                applyPendingEntityData();
                 qApp->getEntities()->processEraseMessage(*message, sendingNode);
             }
         } break;
 
         case PacketType::EntityData: {
             if (DependencyManager::get<SceneScriptingInterface>()->shouldRenderEntities()) {
-                qApp->getEntities()->processDatagram(*message, sendingNode);
+                _pendingEntityData.emplace_back();
+                if (!qApp->getEntities()->decodeDatagram(*message, sendingNode, _pendingEntityData.back())) {
+                    _pendingEntityData.pop_back();
+                }
             }
         } break;
 
@@ -107,3 +112,13 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
         } break;
     }
 }
+
+void OctreePacketProcessor::postProcess() {
+    applyPendingEntityData();
+}
+
+void OctreePacketProcessor::applyPendingEntityData() {
+    if (!_pendingEntityData.empty()) {
+        qApp->getEntities()->applyDatagrams(_pendingEntityData);
+    }
+}
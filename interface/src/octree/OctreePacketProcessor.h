@@ -12,6 +12,7 @@
 #ifndef hifi_OctreePacketProcessor_h
 #define hifi_OctreePacketProcessor_h
 
+#include <OctreeRenderer.h>
 #include <ReceivedPacketProcessor.h>
 #include <ReceivedMessage.h>
 
@@ -28,7 +29,15 @@ signals:
 protected:
     virtual void processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) override;
 
+    // the entity data of the packets processed together is read into the tree at once
+    virtual void postProcess() override;
+
 private slots:
     void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+
+private:
+    void applyPendingEntityData();
+
+    OctreeRenderer::DecodedDatagrams _pendingEntityData;
 };
 #endif // hifi_OctreePacketProcessor_h
@@ -48,6 +48,7 @@ ApplicationOverlay::ApplicationOverlay()
     auto offscreenUi = DependencyManager::get<OffscreenUi>();
     connect(offscreenUi.data(), &OffscreenUi::textureUpdated, this, [&](GLuint textureId) {
         _uiTexture = textureId;
+        ++_uiTextureCount;
     });
 }
 
@@ -65,6 +66,23 @@ void ApplicationOverlay::renderOverlay(RenderArgs* renderArgs) {
         return; // we can't do anything without our frame buffer.
     }
 
+    // The HUD overlays of the scripts, the audio scope and the mirror are redrawn every frame, otherwise the overlay
+    // is left as it is until the QML UI renders a new texture or the connection to the domain changes
+    bool animated = qApp->getOverlays().hasVisibleHUD() || DependencyManager::get<AudioScope>()->isEnabled() || isRearViewVisible();
+    bool domainDisconnected = isDomainDisconnected();
+    _overlayEmpty = !_uiTexture && !animated && !domainDisconnected;
+    if (_overlayEmpty) {
+        _overlayValid = false;
+        return;
+    }
+    if (_overlayValid && !animated && _renderedUiTextureCount == _uiTextureCount &&
+        _renderedDomainDisconnected == domainDisconnected) {
+        return;
+    }
+    _overlayValid = true;
+    _renderedUiTextureCount = _uiTextureCount;
+    _renderedDomainDisconnected = domainDisconnected;
+
     // Execute the batch into our framebuffer
     doInBatch(renderArgs->_context, [&](gpu::Batch& batch) {
         PROFILE_RANGE_BATCH(batch, "ApplicationOverlayRender");
@@ -153,9 +171,13 @@ void ApplicationOverlay::renderOverlays(RenderArgs* renderArgs) {
 void ApplicationOverlay::renderRearViewToFbo(RenderArgs* renderArgs) {
 }
 
+bool ApplicationOverlay::isRearViewVisible() const {
+    return !qApp->isHMDMode() && Menu::getInstance()->isOptionChecked(MenuOption::MiniMirror) &&
+        !Menu::getInstance()->isOptionChecked(MenuOption::FullscreenMirror);
+}
+
 void ApplicationOverlay::renderRearView(RenderArgs* renderArgs) {
-    if (!qApp->isHMDMode() && Menu::getInstance()->isOptionChecked(MenuOption::MiniMirror) &&
-        !Menu::getInstance()->isOptionChecked(MenuOption::FullscreenMirror)) {
+    if (isRearViewVisible()) {
         gpu::Batch& batch = *renderArgs->_batch;
 
         auto geometryCache = DependencyManager::get<GeometryCache>();
@@ -210,6 +232,11 @@ void ApplicationOverlay::renderStatsAndLogs(RenderArgs* renderArgs) {
     */
 }
 
+bool ApplicationOverlay::isDomainDisconnected() const {
+    auto nodeList = DependencyManager::get<NodeList>();
+    return nodeList && !nodeList->getDomainHandler().isConnected();
+}
+
 void ApplicationOverlay::renderDomainConnectionStatusBorder(RenderArgs* renderArgs) {
     auto geometryCache = DependencyManager::get<GeometryCache>();
     static std::once_flag once;
@@ -223,8 +250,7 @@ void ApplicationOverlay::renderDomainConnectionStatusBorder(RenderArgs* renderAr
         points.push_back(vec2(-B));
         geometryCache->updateVertices(_domainStatusBorder, points, CONNECTION_STATUS_BORDER_COLOR);
     });
-    auto nodeList = DependencyManager::get<NodeList>();
-    if (nodeList && !nodeList->getDomainHandler().isConnected()) {
+    if (isDomainDisconnected()) {
         gpu::Batch& batch = *renderArgs->_batch;
         auto geometryCache = DependencyManager::get<GeometryCache>();
         geometryCache->useSimpleDrawPipeline(batch);
@@ -254,6 +280,7 @@ void ApplicationOverlay::buildFramebufferObject() {
     auto uiSize = qApp->getUiSize();
     if (!_overlayFramebuffer || uiSize != _overlayFramebuffer->getSize()) {
         _overlayFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create());
+        _overlayValid = false;
     }
 
     auto width = uiSize.x;
@@ -271,7 +298,8 @@ void ApplicationOverlay::buildFramebufferObject() {
 }
 
 gpu::TexturePointer ApplicationOverlay::getOverlayTexture() {
-    if (!_overlayFramebuffer) {
+    // nothing to composite
+    if (!_overlayFramebuffer || _overlayEmpty) {
         return gpu::TexturePointer();
     }
     return _overlayFramebuffer->getRenderBuffer(0);
@@ -38,9 +38,18 @@ private:
     void renderOverlays(RenderArgs* renderArgs);
     void buildFramebufferObject();
 
+    bool isRearViewVisible() const;
+    bool isDomainDisconnected() const;
+
     float _alpha{ 1.0f };
     float _trailingAudioLoudness{ 0.0f };
     uint32_t _uiTexture{ 0 };
+    // what the overlay holds, it is only rendered again when it changes
+    uint32_t _uiTextureCount{ 0 };
+    uint32_t _renderedUiTextureCount{ 0 };
+    bool _renderedDomainDisconnected{ false };
+    bool _overlayValid{ false };
+    bool _overlayEmpty{ true };
 
     int _domainStatusBorder;
     int _magnifierBorder;
@@ -146,7 +146,7 @@ void AudioStatsDialog::renderStats() {
     stats = "Output ring buffer: %1ms  - avg msecs of samples in output ring buffer in last 10s";
     _audioMixerStats.push_back(stats.arg(QString::number(outputRingBufferLatency,'f', 2)));
     stats = "Audio output buffer: %1ms  - avg msecs of samples in audio output buffer in last 10s";
-    _audioMixerStats.push_back(stats.arg(QString::number(mixerRingBufferLatency,'f', 2)));
+    _audioMixerStats.push_back(stats.arg(QString::number(audioOutputBufferLatency,'f', 2)));
     stats = "TOTAL: %1ms  - avg msecs of samples in audio output buffer in last 10s";
     _audioMixerStats.push_back(stats.arg(QString::number(totalLatency, 'f', 2)));
 
@@ -227,6 +227,11 @@ void AudioStatsDialog::renderAudioStreamStats(const AudioStreamStats* streamStat
                       QString::number(streamStats->_overflowCount));
     audioStreamStats->push_back(stats);
 
+    stats = "Jitter buffer | network calls for: %1 frames, time_stretched: %2";
+    stats = stats.arg(QString::number(streamStats->_calculatedJitterBufferFrames),
+                      QString::number(streamStats->_framesTimeStretched));
+    audioStreamStats->push_back(stats);
+
 
     stats = "Inter-packet timegaps (overall) | min: %1, max: %2, avg: %3";
     stats = stats.arg(formatUsecTime(streamStats->_timeGapMin),
@@ -24,6 +24,7 @@
 #include <OffscreenUi.h>
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
+#include <shared/FrameScheduler.h>
 
 #include "BandwidthRecorder.h"
 #include "Menu.h"
@@ -116,6 +117,18 @@ void Stats::updateStats(bool force) {
     auto avatarManager = DependencyManager::get<AvatarManager>();
     // we need to take one avatar out so we don't include ourselves
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
+    if (_expanded || force) {
+        STAT_UPDATE(avatarAnimationLODs, QString("%1 / %2 / %3 / %4")
+            .arg(avatarManager->getAnimationLODCount(Avatar::FULL_RATE_ANIMATION))
+            .arg(avatarManager->getAnimationLODCount(Avatar::HALF_RATE_ANIMATION))
+            .arg(avatarManager->getAnimationLODCount(Avatar::QUARTER_RATE_ANIMATION))
+            .arg(avatarManager->getAnimationLODCount(Avatar::NO_ANIMATION)));
+        STAT_UPDATE(avatarRenderDetails, QString("%1 / %2 / %3 / %4")
+            .arg(avatarManager->getRenderDetailCount(Avatar::FULL_DETAIL))
+            .arg(avatarManager->getRenderDetailCount(Avatar::NO_BLENDSHAPE_DETAIL))
+            .arg(avatarManager->getRenderDetailCount(Avatar::NO_ATTACHMENT_DETAIL))
+            .arg(avatarManager->getRenderDetailCount(Avatar::IMPOSTOR_DETAIL)));
+    }
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE(framerate, qApp->getFps());
     if (qApp->getActiveDisplayPlugin()) {
@@ -206,6 +219,10 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(downloadLimit, ResourceCache::getRequestLimit())
         STAT_UPDATE(downloadsPending, ResourceCache::getPendingRequestCount());
 
+        auto frameScheduler = DependencyManager::get<FrameScheduler>();
+        STAT_UPDATE(deferredWork, (int)frameScheduler->getBacklog());
+        STAT_UPDATE(deferredWorkWait, (int)(frameScheduler->getOldestWait() / USECS_PER_MSEC));
+
         // See if the active download urls have changed
         bool shouldUpdateUrls = _downloads != _downloadUrls.size();
         if (!shouldUpdateUrls) {
@@ -380,6 +397,9 @@ void Stats::setRenderDetails(const RenderDetails& details) {
     STAT_UPDATE(triangles, details._trianglesRendered);
     STAT_UPDATE(materialSwitches, details._materialSwitches);
     if (_expanded) {
+        STAT_UPDATE(lodTriangles, QString("%1 / %2 / %3 / %4")
+            .arg(details._lodTrianglesRendered[0]).arg(details._lodTrianglesRendered[1])
+            .arg(details._lodTrianglesRendered[2]).arg(details._lodTrianglesRendered[3]));
         STAT_UPDATE(itemConsidered, details._item._considered);
         STAT_UPDATE(itemOutOfView, details._item._outOfView);
         STAT_UPDATE(itemTooSmall, details._item._tooSmall);
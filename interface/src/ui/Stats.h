@@ -44,6 +44,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, simrate, 0)
     STATS_PROPERTY(int, avatarSimrate, 0)
     STATS_PROPERTY(int, avatarCount, 0)
+    STATS_PROPERTY(QString, avatarAnimationLODs, QString())
+    STATS_PROPERTY(QString, avatarRenderDetails, QString())
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -67,8 +69,12 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, downloads, 0)
     STATS_PROPERTY(int, downloadLimit, 0)
     STATS_PROPERTY(int, downloadsPending, 0)
+    // The main thread work waiting for a later frame, and how long the oldest of it has waited
+    STATS_PROPERTY(int, deferredWork, 0)
+    STATS_PROPERTY(int, deferredWorkWait, 0)
     Q_PROPERTY(QStringList downloadUrls READ downloadUrls NOTIFY downloadUrlsChanged)
     STATS_PROPERTY(int, triangles, 0)
+    STATS_PROPERTY(QString, lodTriangles, QString())
     STATS_PROPERTY(int, quads, 0)
     STATS_PROPERTY(int, materialSwitches, 0)
     STATS_PROPERTY(int, itemConsidered, 0)
@@ -132,6 +138,8 @@ signals:
     void simrateChanged();
     void avatarSimrateChanged();
     void avatarCountChanged();
+    void avatarAnimationLODsChanged();
+    void avatarRenderDetailsChanged();
     void packetInCountChanged();
     void packetOutCountChanged();
     void mbpsInChanged();
@@ -157,6 +165,7 @@ signals:
     void downloadsPendingChanged();
     void downloadUrlsChanged();
     void trianglesChanged();
+    void lodTrianglesChanged();
     void quadsChanged();
     void materialSwitchesChanged();
     void itemConsideredChanged();
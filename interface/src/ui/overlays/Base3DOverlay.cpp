@@ -241,6 +241,7 @@ void Base3DOverlay::locationChanged(bool tellPhysics) {
         pendingChanges.updateItem(itemID);
         scene->enqueuePendingChanges(pendingChanges);
     }
+    qApp->getOverlays().overlayMoved(getOverlayID());
     // Overlays can't currently have children.
     // SpatiallyNestable::locationChanged(tellPhysics); // tell all the children, also
 }
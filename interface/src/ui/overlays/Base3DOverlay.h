@@ -55,6 +55,9 @@ public:
         return findRayIntersection(origin, direction, distance, face, surfaceNormal);
     }
 
+    // False if a ray can hit the overlay outside of its bounds, so picks can't skip it by its bounds
+    virtual bool isPickedWithinBounds() const { return true; }
+
 protected:
     virtual void locationChanged(bool tellPhysics = true) override;
     virtual void parentDeleted() override;
@@ -26,6 +26,7 @@ public:
     LocalModelsOverlay(const LocalModelsOverlay* localModelsOverlay);
 
     virtual void update(float deltatime) override;
+    virtual bool needsUpdate() const override { return true; }
     virtual void render(RenderArgs* args) override;
 
     virtual LocalModelsOverlay* createClone() const override;
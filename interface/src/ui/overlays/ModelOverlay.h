@@ -26,6 +26,7 @@ public:
     ModelOverlay(const ModelOverlay* modelOverlay);
 
     virtual void update(float deltatime) override;
+    virtual bool needsUpdate() const override { return true; }
     virtual void render(RenderArgs* args) override;
     void setProperties(const QVariantMap& properties) override;
     QVariant getProperty(const QString& property) override;
@@ -33,6 +34,8 @@ public:
                                         BoxFace& face, glm::vec3& surfaceNormal) override;
     virtual bool findRayIntersectionExtraInfo(const glm::vec3& origin, const glm::vec3& direction,
         float& distance, BoxFace& face, glm::vec3& surfaceNormal, QString& extraInfo) override;
+    // the model can be picked outside of the overlay's dimensions
+    virtual bool isPickedWithinBounds() const override { return false; }
 
     virtual ModelOverlay* createClone() const override;
 
@@ -36,6 +36,8 @@ public:
     void setOverlayID(unsigned int overlayID) { _overlayID = overlayID; }
 
     virtual void update(float deltatime) {}
+    // Only the overlays that do something in update are updated every frame
+    virtual bool needsUpdate() const { return false; }
     virtual void render(RenderArgs* args) = 0;
 
     virtual AABox getBounds() const = 0;
@@ -0,0 +1,169 @@
+//
+//  OverlayBVH.cpp
+//  interface/src/ui/overlays
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OverlayBVH.h"
+
+#include <algorithm>
+#include <limits>
+
+// the bounds are padded a little, so flat overlays and rays along their faces still get tested against them
+static const float BOUNDS_PADDING = 0.001f;
+
+void OverlayBVH::build(const std::vector<Bounds>& overlays) {
+    clear();
+    _leaves.reserve(overlays.size());
+    for (auto& overlay : overlays) {
+        Leaf leaf;
+        leaf.id = overlay.first;
+        leaf.node = -1;
+        setLeafBounds(leaf, overlay.second);
+        _leafOfOverlay[leaf.id] = (int)_leaves.size();
+        _leaves.push_back(leaf);
+    }
+    if (_leaves.empty()) {
+        return;
+    }
+
+    std::vector<int> leaves(_leaves.size());
+    for (size_t i = 0; i < leaves.size(); i++) {
+        leaves[i] = (int)i;
+    }
+    _nodes.reserve(2 * _leaves.size() - 1);
+    buildNode(leaves, 0, (int)leaves.size(), -1);
+}
+
+void OverlayBVH::clear() {
+    _nodes.clear();
+    _leaves.clear();
+    _leafOfOverlay.clear();
+    _numRefits = 0;
+}
+
+void OverlayBVH::setLeafBounds(Leaf& leaf, const AABox& bounds) {
+    leaf.minimum = bounds.getMinimumPoint() - glm::vec3(BOUNDS_PADDING);
+    leaf.maximum = bounds.getMaximumPoint() + glm::vec3(BOUNDS_PADDING);
+}
+
+int OverlayBVH::buildNode(std::vector<int>& leaves, int begin, int end, int parent) {
+    int index = (int)_nodes.size();
+    _nodes.push_back(Node());
+
+    glm::vec3 minimum(std::numeric_limits<float>::max());
+    glm::vec3 maximum(-std::numeric_limits<float>::max());
+    glm::vec3 minimumCenter = minimum;
+    glm::vec3 maximumCenter = maximum;
+    for (int i = begin; i < end; i++) {
+        const Leaf& leaf = _leaves[leaves[i]];
+        minimum = glm::min(minimum, leaf.minimum);
+        maximum = glm::max(maximum, leaf.maximum);
+        glm::vec3 center = 0.5f * (leaf.minimum + leaf.maximum);
+        minimumCenter = glm::min(minimumCenter, center);
+        maximumCenter = glm::max(maximumCenter, center);
+    }
+
+    int left = -1;
+    int right = -1;
+    int leafIndex = -1;
+    if (end - begin == 1) {
+        leafIndex = leaves[begin];
+        _leaves[leafIndex].node = index;
+    } else {
+        // split at the median of the centers, along the axis they spread the most on
+        glm::vec3 spread = maximumCenter - minimumCenter;
+        int axis = (spread.x > spread.y && spread.x > spread.z) ? 0 : (spread.y > spread.z ? 1 : 2);
+        int middle = (begin + end) / 2;
+        std::nth_element(leaves.begin() + begin, leaves.begin() + middle, leaves.begin() + end, [&](int a, int b) {
+            return (_leaves[a].minimum[axis] + _leaves[a].maximum[axis]) < (_leaves[b].minimum[axis] + _leaves[b].maximum[axis]);
+        });
+        left = buildNode(leaves, begin, middle, index);
+        right = buildNode(leaves, middle, end, index);
+    }
+
+    // the children were pushed after this node, so it's only filled in now
+    Node& node = _nodes[index];
+    node.minimum = minimum;
+    node.maximum = maximum;
+    node.parent = parent;
+    node.left = left;
+    node.right = right;
+    node.leaf = leafIndex;
+    return index;
+}
+
+bool OverlayBVH::refit(OverlayID id, const AABox& bounds) {
+    auto found = _leafOfOverlay.find(id);
+    if (found == _leafOfOverlay.end()) {
+        return false;
+    }
+    Leaf& leaf = _leaves[found->second];
+    setLeafBounds(leaf, bounds);
+    _numRefits++;
+
+    int index = leaf.node;
+    _nodes[index].minimum = leaf.minimum;
+    _nodes[index].maximum = leaf.maximum;
+    for (index = _nodes[index].parent; index != -1; index = _nodes[index].parent) {
+        Node& node = _nodes[index];
+        const Node& left = _nodes[node.left];
+        const Node& right = _nodes[node.right];
+        glm::vec3 minimum = glm::min(left.minimum, right.minimum);
+        glm::vec3 maximum = glm::max(left.maximum, right.maximum);
+        if (minimum == node.minimum && maximum == node.maximum) {
+            break; // nothing changes further up
+        }
+        node.minimum = minimum;
+        node.maximum = maximum;
+    }
+    return true;
+}
+
+// slab test, for a ray starting anywhere, the box included
+static bool rayHitsBox(const glm::vec3& origin, const glm::vec3& inverseDirection,
+                       const glm::vec3& minimum, const glm::vec3& maximum) {
+    glm::vec3 t0 = (minimum - origin) * inverseDirection;
+    glm::vec3 t1 = (maximum - origin) * inverseDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float enter = glm::max(glm::max(tNear.x, tNear.y), tNear.z);
+    float exit = glm::min(glm::min(tFar.x, tFar.y), tFar.z);
+    return exit >= glm::max(enter, 0.0f);
+}
+
+void OverlayBVH::findRayCandidates(const glm::vec3& origin, const glm::vec3& direction,
+                                   std::vector<OverlayID>& candidates) const {
+    if (_nodes.empty()) {
+        return;
+    }
+
+    // a zero component becomes a huge one rather than an infinity, which would make 0 * inf a NaN on the box's edge
+    const float TINY = 1.0e-20f;
+    glm::vec3 inverseDirection;
+    for (int i = 0; i < 3; i++) {
+        float component = (fabsf(direction[i]) < TINY) ? (direction[i] < 0.0f ? -TINY : TINY) : direction[i];
+        inverseDirection[i] = 1.0f / component;
+    }
+
+    std::vector<int> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+        if (!rayHitsBox(origin, inverseDirection, node.minimum, node.maximum)) {
+            continue;
+        }
+        if (node.leaf != -1) {
+            candidates.push_back(_leaves[node.leaf].id);
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
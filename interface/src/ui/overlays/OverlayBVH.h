@@ -0,0 +1,71 @@
+//
+//  OverlayBVH.h
+//  interface/src/ui/overlays
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OverlayBVH_h
+#define hifi_OverlayBVH_h
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+
+// A bounding volume hierarchy over the bounds of the 3D overlays, so a pick only tests the overlays its ray goes near.
+// It is built top down, then kept up to date by refitting the boxes above each overlay that moves. Refitting loosens
+// the hierarchy, so once there have been as many refits as overlays it asks to be built again.
+class OverlayBVH {
+public:
+    using OverlayID = unsigned int;
+    using Bounds = std::pair<OverlayID, AABox>;
+
+    void build(const std::vector<Bounds>& overlays);
+    void clear();
+
+    // False if the overlay isn't in the hierarchy
+    bool refit(OverlayID id, const AABox& bounds);
+    bool contains(OverlayID id) const { return _leafOfOverlay.find(id) != _leafOfOverlay.end(); }
+    bool needsRebuild() const { return _numRefits > _leaves.size(); }
+
+    // Appends the overlays whose bounds the ray goes through
+    void findRayCandidates(const glm::vec3& origin, const glm::vec3& direction, std::vector<OverlayID>& candidates) const;
+
+private:
+    struct Node {
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        int parent;
+        int left;
+        int right;
+        // the index of the overlay's leaf, or -1 for an inner node
+        int leaf;
+    };
+
+    struct Leaf {
+        OverlayID id;
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        int node;
+    };
+
+    int buildNode(std::vector<int>& leaves, int begin, int end, int parent);
+    void setLeafBounds(Leaf& leaf, const AABox& bounds);
+
+    std::vector<Node> _nodes;
+    std::vector<Leaf> _leaves;
+    std::unordered_map<OverlayID, int> _leafOfOverlay;
+    size_t _numRefits { 0 };
+};
+
+#endif // hifi_OverlayBVH_h
@@ -10,6 +10,8 @@
 
 #include "Overlays.h"
 
+#include <algorithm>
+#include <functional>
 #include <limits>
 
 #include <QtScript/QScriptValueIterator>
@@ -52,7 +54,9 @@ void Overlays::cleanupAllOverlays() {
         }
         _overlaysHUD.clear();
         _overlaysWorld.clear();
+        _overlaysToUpdate.clear();
         _panels.clear();
+        _pickIndexDirty = true;
     }
     cleanupOverlaysToDelete();
 }
@@ -65,10 +69,7 @@ void Overlays::update(float deltatime) {
 
     {
         QWriteLocker lock(&_lock);
-        foreach(Overlay::Pointer thisOverlay, _overlaysHUD) {
-            thisOverlay->update(deltatime);
-        }
-        foreach(Overlay::Pointer thisOverlay, _overlaysWorld) {
+        foreach(Overlay::Pointer thisOverlay, _overlaysToUpdate) {
             thisOverlay->update(deltatime);
         }
     }
@@ -100,6 +101,16 @@ void Overlays::cleanupOverlaysToDelete() {
     }
 }
 
+bool Overlays::hasVisibleHUD() {
+    QReadLocker lock(&_lock);
+    foreach(Overlay::Pointer thisOverlay, _overlaysHUD) {
+        if (thisOverlay->getVisible()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Overlays::renderHUD(RenderArgs* renderArgs) {
     PROFILE_RANGE(__FUNCTION__);
     QReadLocker lock(&_lock);
@@ -194,8 +205,12 @@ unsigned int Overlays::addOverlay(Overlay::Pointer overlay) {
     unsigned int thisID = _nextOverlayID;
     overlay->setOverlayID(thisID);
     _nextOverlayID++;
+    if (overlay->needsUpdate()) {
+        _overlaysToUpdate[thisID] = overlay;
+    }
     if (overlay->is3D()) {
         _overlaysWorld[thisID] = overlay;
+        _pickIndexDirty = true;
 
         render::ScenePointer scene = qApp->getMain3DScene();
         render::PendingChanges pendingChanges;
@@ -229,6 +244,7 @@ bool Overlays::editOverlay(unsigned int id, const QVariant& properties) {
     Overlay::Pointer thisOverlay = getOverlay(id);
     if (thisOverlay) {
         thisOverlay->setProperties(properties.toMap());
+        overlayMoved(id);
 
         return true;
     }
@@ -254,6 +270,7 @@ bool Overlays::editOverlays(const QVariant& propertiesById) {
         }
         QVariant properties = map[key];
         thisOverlay->setProperties(properties.toMap());
+        overlayMoved(id);
     }
     return success;
 }
@@ -267,9 +284,11 @@ void Overlays::deleteOverlay(unsigned int id) {
             overlayToDelete = _overlaysHUD.take(id);
         } else if (_overlaysWorld.contains(id)) {
             overlayToDelete = _overlaysWorld.take(id);
+            _pickIndexDirty = true;
         } else {
             return;
         }
+        _overlaysToUpdate.remove(id);
     }
 
     auto attachable = std::dynamic_pointer_cast<PanelAttachable>(overlayToDelete);
@@ -396,16 +415,72 @@ void OverlayPropertyResultFromScriptValue(const QScriptValue& object, OverlayPro
 }
 
 
+void Overlays::overlayMoved(unsigned int id) {
+    std::lock_guard<std::mutex> lock(_movedOverlaysMutex);
+    _movedOverlays.insert(id);
+}
+
+bool Overlays::isPickIndexed(const Overlay::Pointer& overlay) const {
+    // a parent can move its overlays without telling them, so they're tested without their bounds
+    auto overlay3D = std::dynamic_pointer_cast<Base3DOverlay>(overlay);
+    return overlay3D && overlay3D->isPickedWithinBounds() && overlay3D->getParentID().isNull();
+}
+
+void Overlays::updatePickIndex() {
+    QSet<unsigned int> moved;
+    {
+        std::lock_guard<std::mutex> lock(_movedOverlaysMutex);
+        moved.swap(_movedOverlays);
+    }
+
+    bool rebuild = _pickIndexDirty.exchange(false) || _pickIndex.needsRebuild();
+    if (!rebuild) {
+        for (auto id : moved) {
+            auto overlay = _overlaysWorld.value(id);
+            if (!overlay) {
+                continue;
+            }
+            if (isPickIndexed(overlay) != _pickIndex.contains(id)) {
+                rebuild = true; // it was given or lost a parent
+                break;
+            }
+            _pickIndex.refit(id, overlay->getBounds());
+        }
+    }
+
+    if (rebuild) {
+        std::vector<OverlayBVH::Bounds> bounds;
+        bounds.reserve(_overlaysWorld.size());
+        _unindexedOverlays.clear();
+        for (auto i = _overlaysWorld.constBegin(); i != _overlaysWorld.constEnd(); ++i) {
+            if (isPickIndexed(i.value())) {
+                bounds.push_back(OverlayBVH::Bounds(i.key(), i.value()->getBounds()));
+            } else {
+                _unindexedOverlays.push_back(i.key());
+            }
+        }
+        _pickIndex.build(bounds);
+    }
+}
+
 RayToOverlayIntersectionResult Overlays::findRayIntersection(const PickRay& ray) {
     float bestDistance = std::numeric_limits<float>::max();
     bool bestIsFront = false;
     RayToOverlayIntersectionResult result;
-    QMapIterator<unsigned int, Overlay::Pointer> i(_overlaysWorld);
-    i.toBack();
-    while (i.hasPrevious()) {
-        i.previous();
-        unsigned int thisID = i.key();
-        auto thisOverlay = std::dynamic_pointer_cast<Base3DOverlay>(i.value());
+
+    QReadLocker lock(&_lock);
+    std::vector<unsigned int> candidates;
+    {
+        std::lock_guard<std::mutex> pickIndexLock(_pickIndexMutex);
+        updatePickIndex();
+        _pickIndex.findRayCandidates(ray.origin, ray.direction, candidates);
+        candidates.insert(candidates.end(), _unindexedOverlays.begin(), _unindexedOverlays.end());
+    }
+    // the newest overlays first, as drawInFront overlays at the same distance are picked in that order
+    std::sort(candidates.begin(), candidates.end(), std::greater<unsigned int>());
+
+    for (auto thisID : candidates) {
+        auto thisOverlay = std::dynamic_pointer_cast<Base3DOverlay>(_overlaysWorld.value(thisID));
         if (thisOverlay && thisOverlay->getVisible() && !thisOverlay->getIgnoreRayIntersection() && thisOverlay->isLoaded()) {
             float thisDistance;
             BoxFace thisFace;
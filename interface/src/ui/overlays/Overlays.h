@@ -18,11 +18,17 @@
 #ifndef hifi_Overlays_h
 #define hifi_Overlays_h
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include <QReadWriteLock>
 #include <QScriptValue>
+#include <QSet>
 
 #include "Overlay.h"
 
+#include "OverlayBVH.h"
 #include "OverlayPanel.h"
 #include "PanelAttachable.h"
 
@@ -66,6 +72,8 @@ public:
     void init();
     void update(float deltatime);
     void renderHUD(RenderArgs* renderArgs);
+    // False when renderHUD would draw nothing
+    bool hasVisibleHUD();
     void disable();
     void enable();
 
@@ -74,6 +82,9 @@ public:
 
     void cleanupAllOverlays();
 
+    // Called by a 3D overlay when its transform changes, so picks see its new bounds. Can be called with the lock held.
+    void overlayMoved(unsigned int id);
+
 public slots:
     /// adds an overlay with the specific properties
     unsigned int addOverlay(const QString& type, const QVariant& properties);
@@ -150,17 +161,32 @@ signals:
 
 private:
     void cleanupOverlaysToDelete();
+    // Brings the pick index up to date with the 3D overlays, called with the lock held for reading at least
+    void updatePickIndex();
+    bool isPickIndexed(const Overlay::Pointer& overlay) const;
 
     QMap<unsigned int, Overlay::Pointer> _overlaysHUD;
     QMap<unsigned int, Overlay::Pointer> _overlaysWorld;
     QMap<unsigned int, OverlayPanel::Pointer> _panels;
     QList<Overlay::Pointer> _overlaysToDelete;
+    // the overlays that need update called every frame
+    QMap<unsigned int, Overlay::Pointer> _overlaysToUpdate;
     unsigned int _nextOverlayID;
 
     QReadWriteLock _lock;
     QReadWriteLock _deleteLock;
     QScriptEngine* _scriptEngine;
     bool _enabled = true;
+
+    // the bounds of the 3D overlays, for findRayIntersection, and the ones it has to test without them
+    OverlayBVH _pickIndex;
+    std::vector<unsigned int> _unindexedOverlays;
+    std::mutex _pickIndexMutex;
+    // set when 3D overlays are added or deleted, the index is built again at the next pick
+    std::atomic<bool> _pickIndexDirty { true };
+    // the overlays that moved since the last pick, they have a lock of their own since they move with the lock held
+    std::mutex _movedOverlaysMutex;
+    QSet<unsigned int> _movedOverlays;
 };
 
 
@@ -30,6 +30,7 @@ public:
     virtual void render(RenderArgs* args) override;
 
     virtual void update(float deltatime) override;
+    virtual bool needsUpdate() const override { return true; }
 
     virtual const render::ShapeKey getShapeKey() override;
 
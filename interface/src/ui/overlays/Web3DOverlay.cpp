@@ -75,6 +75,7 @@ void Web3DOverlay::render(RenderArgs* args) {
     if (!_webSurface) {
         _webSurface = new OffscreenQmlSurface();
         _webSurface->create(currentContext);
+        _webSurface->setIdleMaxFps(OffscreenQmlSurface::WEB_IDLE_MAX_FPS);
         _webSurface->setBaseUrl(QUrl::fromLocalFile(PathUtils::resourcesPath() + "/qml/controls/"));
         _webSurface->load("WebView.qml");
         _webSurface->resume();
@@ -165,6 +166,7 @@ void Web3DOverlay::setURL(const QString& url) {
     _url = url;
     if (_webSurface) {
         AbstractViewStateInterface::instance()->postLambdaEvent([this, url] {
+            _webSurface->notifyInput();
             _webSurface->getRootItem()->setProperty("url", url);
         });
     }
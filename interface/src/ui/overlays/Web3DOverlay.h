@@ -28,6 +28,7 @@ public:
     virtual const render::ShapeKey getShapeKey() override;
 
     virtual void update(float deltatime) override;
+    virtual bool needsUpdate() const override { return true; }
 
     // setters
     void setURL(const QString& url);
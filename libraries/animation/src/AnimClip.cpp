@@ -50,10 +50,10 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
         _networkAnim.reset();
     }
 
-    if (_anim.size()) {
+    if (_anim && _anim->getNumFrames() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
+        if (_mirrorFlag && !_mirrorAnim) {
             buildMirrorAnim();
         }
 
@@ -67,15 +67,12 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _anim->getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
-        float alpha = glm::fract(_frame);
-
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        const AnimClipFrames& frames = _mirrorFlag ? *_mirrorAnim : *_anim;
+        frames.sample(prevIndex, nextIndex, glm::fract(_frame), _poses, _nextPoses);
     }
 
     return _poses;
@@ -96,7 +93,21 @@ void AnimClip::setCurrentFrameInternal(float frame) {
 
 void AnimClip::copyFromNetworkAnim() {
     assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
+
+    // the frames depend on the skeleton they are retargeted to, so they are shared between clips with equal skeletons
+    _anim = DependencyManager::get<AnimationCache>()->getClipFrames(QUrl(_url), getFramesKey(), [&] {
+        return std::make_shared<AnimClipFrames>(retargetNetworkAnim());
+    });
+
+    // mirrorAnim will be re-built on demand, if needed.
+    _mirrorAnim.reset();
+
+    _poses.resize(_skeleton->getNumJoints());
+}
+
+std::vector<AnimPoseVec> AnimClip::retargetNetworkAnim() const {
+    // _anim[frame][joint]
+    std::vector<AnimPoseVec> anim;
 
     // build a mapping from animation joint indices to skeleton joint indices.
     // by matching joints with the same name.
@@ -115,7 +126,7 @@ void AnimClip::copyFromNetworkAnim() {
     }
 
     const int frameCount = geom.animationFrames.size();
-    _anim.resize(frameCount);
+    anim.resize(frameCount);
 
     for (int frame = 0; frame < frameCount; frame++) {
 
@@ -123,9 +134,9 @@ void AnimClip::copyFromNetworkAnim() {
 
         // init all joints in animation to default pose
         // this will give us a resonable result for bones in the model skeleton but not in the animation.
-        _anim[frame].reserve(skeletonJointCount);
+        anim[frame].reserve(skeletonJointCount);
         for (int skeletonJoint = 0; skeletonJoint < skeletonJointCount; skeletonJoint++) {
-            _anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
+            anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
         }
 
         for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
@@ -165,26 +176,32 @@ void AnimClip::copyFromNetworkAnim() {
 
                 AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
 
-                _anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
+                anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
             }
         }
     }
 
-    // mirrorAnim will be re-built on demand, if needed.
-    _mirrorAnim.clear();
-
-    _poses.resize(skeletonJointCount);
+    return anim;
 }
 
 void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
+    assert(_skeleton && _anim);
+
+    _mirrorAnim = DependencyManager::get<AnimationCache>()->getClipFrames(QUrl(_url), getFramesKey() + "/mirror", [&] {
+        std::vector<AnimPoseVec> mirrorAnim(_anim->getNumFrames(), AnimPoseVec(_anim->getNumJoints()));
+        for (int frame = 0; frame < _anim->getNumFrames(); frame++) {
+            AnimPoseVec& relPoses = mirrorAnim[frame];
+            if (!relPoses.empty()) {
+                _anim->decodeFrame(frame, &relPoses[0]);
+            }
+            _skeleton->mirrorRelativePoses(relPoses);
+        }
+        return std::make_shared<AnimClipFrames>(mirrorAnim);
+    });
+}
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
-    }
+QByteArray AnimClip::getFramesKey() const {
+    return _skeleton->getFingerprint() + (usePreAndPostPoseFromAnim ? "/prePost" : "/bind");
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
@@ -59,17 +59,20 @@ protected:
     virtual void setCurrentFrameInternal(float frame) override;
 
     void copyFromNetworkAnim();
+    std::vector<AnimPoseVec> retargetNetworkAnim() const;
     void buildMirrorAnim();
+    QByteArray getFramesKey() const;
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
 
     AnimationPointer _networkAnim;
     AnimPoseVec _poses;
+    AnimPoseVec _nextPoses; // scratch space for stepping between frames
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // shared through the AnimationCache with every clip playing the same url on the same skeleton
+    AnimClipFrames::Pointer _anim;
+    AnimClipFrames::Pointer _mirrorAnim;
 
     QString _url;
     float _startFrame;
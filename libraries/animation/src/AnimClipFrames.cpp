@@ -0,0 +1,148 @@
+//
+//  AnimClipFrames.cpp
+//
+//  Created by agent on 10/14/26.
+//  Copyright (c) 2026 High Fidelity, Inc. All rights reserved.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipFrames.h"
+
+#include <algorithm>
+#include <assert.h>
+
+#include "AnimUtil.h"
+
+// channels that stay within these of the first frame over the whole clip are stored once
+static const float ROTATION_EPSILON = 1.0e-6f; // in 1 - |dot| of the two rotations
+static const float TRANSLATION_EPSILON = 1.0e-5f;
+static const float SCALE_EPSILON = 1.0e-5f;
+
+static const float MAX_INT16 = 32767.0f;
+static const float MAX_UINT16 = 65535.0f;
+
+AnimClipFrames::AnimClipFrames(const std::vector<AnimPoseVec>& frames) :
+    _numFrames((int)frames.size())
+{
+    if (frames.empty()) {
+        return;
+    }
+
+    _constantPoses = frames[0];
+    const int numJoints = (int)_constantPoses.size();
+
+    for (int joint = 0; joint < numJoints; joint++) {
+        const AnimPose& firstPose = frames[0][joint];
+        bool isRotationAnimated = false;
+        bool isTranslationAnimated = false;
+        bool isScaleAnimated = false;
+        glm::vec3 minTranslation = firstPose.trans;
+        glm::vec3 maxTranslation = firstPose.trans;
+
+        for (int frame = 1; frame < _numFrames; frame++) {
+            assert((int)frames[frame].size() == numJoints);
+            const AnimPose& pose = frames[frame][joint];
+            isRotationAnimated |= 1.0f - fabsf(glm::dot(pose.rot, firstPose.rot)) > ROTATION_EPSILON;
+            isTranslationAnimated |= glm::length(pose.trans - firstPose.trans) > TRANSLATION_EPSILON;
+            isScaleAnimated |= glm::length(pose.scale - firstPose.scale) > SCALE_EPSILON;
+            minTranslation = glm::min(minTranslation, pose.trans);
+            maxTranslation = glm::max(maxTranslation, pose.trans);
+        }
+
+        if (isRotationAnimated) {
+            _rotationJoints.push_back(joint);
+        }
+        if (isTranslationAnimated) {
+            _translationJoints.push_back(joint);
+            _translationRanges.push_back({ minTranslation, (maxTranslation - minTranslation) / MAX_UINT16 });
+        }
+        if (isScaleAnimated) {
+            _scaleJoints.push_back(joint);
+        }
+    }
+
+    _rotations.reserve(_numFrames * _rotationJoints.size() * 4);
+    _translations.reserve(_numFrames * _translationJoints.size() * 3);
+    _scales.reserve(_numFrames * _scaleJoints.size());
+
+    for (int frame = 0; frame < _numFrames; frame++) {
+        const AnimPoseVec& poses = frames[frame];
+
+        for (int joint : _rotationJoints) {
+            glm::quat rot = glm::normalize(poses[joint].rot);
+            if (rot.w < 0.0f) {
+                rot = -rot;
+            }
+            _rotations.push_back((int16_t)glm::round(rot.x * MAX_INT16));
+            _rotations.push_back((int16_t)glm::round(rot.y * MAX_INT16));
+            _rotations.push_back((int16_t)glm::round(rot.z * MAX_INT16));
+            _rotations.push_back((int16_t)glm::round(rot.w * MAX_INT16));
+        }
+
+        for (size_t i = 0; i < _translationJoints.size(); i++) {
+            const QuantizedRange& range = _translationRanges[i];
+            const glm::vec3& trans = poses[_translationJoints[i]].trans;
+            for (int component = 0; component < 3; component++) {
+                float step = range.step[component];
+                float steps = step > 0.0f ? glm::round((trans[component] - range.offset[component]) / step) : 0.0f;
+                _translations.push_back((uint16_t)glm::clamp(steps, 0.0f, MAX_UINT16));
+            }
+        }
+
+        for (int joint : _scaleJoints) {
+            _scales.push_back(poses[joint].scale);
+        }
+    }
+}
+
+void AnimClipFrames::decodeFrame(int frame, AnimPose* poses) const {
+    assert(frame >= 0 && frame < _numFrames);
+    std::copy(_constantPoses.begin(), _constantPoses.end(), poses);
+
+    const int16_t* rotation = _rotations.data() + frame * _rotationJoints.size() * 4;
+    for (int joint : _rotationJoints) {
+        // the components all carry the same scale, normalizing takes it out
+        poses[joint].rot = glm::normalize(glm::quat(rotation[3], rotation[0], rotation[1], rotation[2]));
+        rotation += 4;
+    }
+
+    const uint16_t* translation = _translations.data() + frame * _translationJoints.size() * 3;
+    for (size_t i = 0; i < _translationJoints.size(); i++) {
+        const QuantizedRange& range = _translationRanges[i];
+        poses[_translationJoints[i]].trans = range.offset +
+            range.step * glm::vec3(translation[0], translation[1], translation[2]);
+        translation += 3;
+    }
+
+    const glm::vec3* scale = _scales.data() + frame * _scaleJoints.size();
+    for (int joint : _scaleJoints) {
+        poses[joint].scale = *scale++;
+    }
+}
+
+void AnimClipFrames::sample(int prevFrame, int nextFrame, float alpha, AnimPoseVec& poses, AnimPoseVec& scratch) const {
+    const int numJoints = getNumJoints();
+    poses.resize(numJoints);
+    scratch.resize(numJoints);
+    if (numJoints == 0) {
+        return;
+    }
+
+    decodeFrame(prevFrame, &poses[0]);
+    if (nextFrame != prevFrame) {
+        decodeFrame(nextFrame, &scratch[0]);
+        ::blend(numJoints, &poses[0], &scratch[0], alpha, &poses[0]);
+    }
+}
+
+size_t AnimClipFrames::getMemorySize() const {
+    return sizeof(AnimClipFrames) +
+        _constantPoses.capacity() * sizeof(AnimPose) +
+        (_rotationJoints.capacity() + _translationJoints.capacity() + _scaleJoints.capacity()) * sizeof(int) +
+        _rotations.capacity() * sizeof(int16_t) +
+        _translations.capacity() * sizeof(uint16_t) +
+        _translationRanges.capacity() * sizeof(QuantizedRange) +
+        _scales.capacity() * sizeof(glm::vec3);
+}
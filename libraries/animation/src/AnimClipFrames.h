@@ -0,0 +1,61 @@
+//
+//  AnimClipFrames.h
+//
+//  Created by agent on 10/14/26.
+//  Copyright (c) 2026 High Fidelity, Inc. All rights reserved.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipFrames_h
+#define hifi_AnimClipFrames_h
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include "AnimPose.h"
+
+// The frames of a clip, relative poses [frame][joint], in a compact form that is read only once built.
+// Rotations, translations and scales that never change over the clip are stored once per joint, the ones that do are
+// stored for every frame: rotations and translations quantized to 16 bits a component, scales at full precision.
+class AnimClipFrames {
+public:
+    using Pointer = std::shared_ptr<const AnimClipFrames>;
+
+    explicit AnimClipFrames(const std::vector<AnimPoseVec>& frames);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_constantPoses.size(); }
+
+    // poses must have room for getNumJoints poses
+    void decodeFrame(int frame, AnimPose* poses) const;
+
+    // blends frame prevFrame into nextFrame by alpha, the way AnimClip steps between frames
+    // poses and scratch are resized to getNumJoints
+    void sample(int prevFrame, int nextFrame, float alpha, AnimPoseVec& poses, AnimPoseVec& scratch) const;
+
+    size_t getMemorySize() const;
+
+private:
+    struct QuantizedRange {
+        glm::vec3 offset;
+        glm::vec3 step;
+    };
+
+    int _numFrames { 0 };
+    AnimPoseVec _constantPoses; // the first frame, the channels that are animated are overwritten on decode
+
+    // for each animated channel the joint it belongs to, the per-frame data of frame f starts at f * size()
+    std::vector<int> _rotationJoints;
+    std::vector<int> _translationJoints;
+    std::vector<int> _scaleJoints;
+
+    std::vector<int16_t> _rotations; // x, y, z, w of a quaternion with w >= 0, scaled to the int16_t range
+    std::vector<uint16_t> _translations;
+    std::vector<QuantizedRange> _translationRanges; // one for each of _translationJoints
+    std::vector<glm::vec3> _scales;
+};
+
+#endif // hifi_AnimClipFrames_h
@@ -62,7 +62,8 @@ void AnimInverseKinematics::setTargetVars(
         const QString& jointName,
         const QString& positionVar,
         const QString& rotationVar,
-        const QString& typeVar) {
+        const QString& typeVar,
+        int maxIterations) {
     // if there are dups, last one wins.
     bool found = false;
     for (auto& targetVar: _targetVarVec) {
@@ -71,13 +72,14 @@ void AnimInverseKinematics::setTargetVars(
             targetVar.positionVar = positionVar;
             targetVar.rotationVar = rotationVar;
             targetVar.typeVar = typeVar;
+            targetVar.maxIterations = maxIterations;
             found = true;
             break;
         }
     }
     if (!found) {
         // create a new entry
-        _targetVarVec.push_back(IKTargetVar(jointName, positionVar, rotationVar, typeVar));
+        _targetVarVec.push_back(IKTargetVar(jointName, positionVar, rotationVar, typeVar, maxIterations));
     }
 }
 
@@ -108,6 +110,11 @@ void AnimInverseKinematics::computeTargets(const AnimVariantMap& animVars, std::
                 }
                 target.setPose(rotation, translation);
                 target.setIndex(targetVar.jointIndex);
+                if (targetVar.maxIterations > 0 && targetVar.maxIterations < _maxIterations) {
+                    target.setMaxIterations(targetVar.maxIterations);
+                } else {
+                    target.setMaxIterations(_maxIterations);
+                }
                 targets.push_back(target);
                 if (targetVar.jointIndex > _maxTargetIndex) {
                     _maxTargetIndex = targetVar.jointIndex;
@@ -134,7 +141,7 @@ void AnimInverseKinematics::computeTargets(const AnimVariantMap& animVars, std::
     }
 }
 
-void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<IKTarget>& targets) {
+void AnimInverseKinematics::solve(const std::vector<IKTarget>& targets) {
     // compute absolute poses that correspond to relative target poses
     AnimPoseVec absolutePoses;
     absolutePoses.resize(_relativePoses.size());
@@ -145,17 +152,26 @@ void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<I
         accumulator.clearAndClean();
     }
 
-    float maxError = FLT_MAX;
+    // every target is solved on the first pass, after that only those that are still out of
+    // tolerance and have passes left in their budget
+    std::vector<float> errors(targets.size(), FLT_MAX);
+    bool solving = true;
     int numLoops = 0;
-    const int MAX_IK_LOOPS = 16;
-    const float MAX_ERROR_TOLERANCE = 0.1f; // cm
-    while (maxError > MAX_ERROR_TOLERANCE && numLoops < MAX_IK_LOOPS) {
+    while (solving && numLoops < _maxIterations) {
         ++numLoops;
 
         // solve all targets
         int lowestMovedIndex = (int)_relativePoses.size();
-        for (auto& target: targets) {
-            int lowIndex = solveTargetWithCCD(target, absolutePoses);
+        for (size_t i = 0; i < targets.size(); i++) {
+            if (errors[i] <= _maxError || numLoops > targets[i].getMaxIterations()) {
+                continue;
+            }
+            int lowIndex;
+            if (_solver == Solver::FABRIK && targets[i].getType() != IKTarget::Type::HmdHead) {
+                lowIndex = solveTargetWithFABRIK(targets[i], absolutePoses);
+            } else {
+                lowIndex = solveTargetWithCCD(targets[i], absolutePoses);
+            }
             if (lowIndex < lowestMovedIndex) {
                 lowestMovedIndex = lowIndex;
             }
@@ -177,15 +193,17 @@ void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<I
             }
         }
 
-        // compute maxError
-        maxError = 0.0f;
+        // measure the error of each target, we're done when none of them needs another pass
+        solving = false;
         for (size_t i = 0; i < targets.size(); i++) {
             if (targets[i].getType() == IKTarget::Type::RotationAndPosition || targets[i].getType() == IKTarget::Type::HmdHead ||
                 targets[i].getType() == IKTarget::Type::HipsRelativeRotationAndPosition) {
-                float error = glm::length(absolutePoses[targets[i].getIndex()].trans - targets[i].getTranslation());
-                if (error > maxError) {
-                    maxError = error;
+                errors[i] = glm::length(absolutePoses[targets[i].getIndex()].trans - targets[i].getTranslation());
+                if (errors[i] > _maxError && numLoops < targets[i].getMaxIterations()) {
+                    solving = true;
                 }
+            } else {
+                errors[i] = 0.0f;
             }
         }
     }
@@ -375,6 +393,104 @@ int AnimInverseKinematics::solveTargetWithCCD(const IKTarget& target, AnimPoseVe
     return lowestMovedIndex;
 }
 
+int AnimInverseKinematics::solveTargetWithFABRIK(const IKTarget& target, const AnimPoseVec& absolutePoses) {
+    int lowestMovedIndex = (int)_relativePoses.size();
+    if (target.getType() == IKTarget::Type::RotationOnly) {
+        // the final rotation will be enforced after the iterations
+        return lowestMovedIndex;
+    }
+
+    // collect the chain from the tip up to the same joint the CCD solver would stop at,
+    // the lower-spine is left out so that hand targets can't bend the spine and drive the hips
+    int tipIndex = target.getIndex();
+    _chainIndices.clear();
+    _chainIndices.push_back(tipIndex);
+    int index = _skeleton->getParentIndex(tipIndex);
+    while (index != -1 && index != _hipsIndex && _skeleton->getParentIndex(index) != -1) {
+        RotationConstraint* constraint = getConstraint(index);
+        if (constraint && constraint->isLowerSpine()) {
+            break;
+        }
+        _chainIndices.push_back(index);
+        index = _skeleton->getParentIndex(index);
+    }
+    int numChainJoints = (int)_chainIndices.size();
+    if (numChainJoints < 2) {
+        return lowestMovedIndex;
+    }
+
+    _chainPositions.resize(numChainJoints);
+    _chainLengths.resize(numChainJoints - 1);
+    for (int i = 0; i < numChainJoints; ++i) {
+        _chainPositions[i] = absolutePoses[_chainIndices[i]].trans;
+        if (i > 0) {
+            _chainLengths[i - 1] = glm::length(_chainPositions[i] - _chainPositions[i - 1]);
+        }
+    }
+
+    // move a joint to lie at the given distance from its neighbor, along the line it is on now
+    const float MIN_SEGMENT_LENGTH = 1.0e-4f;
+    auto place = [&](int i, int neighbor, float length) {
+        glm::vec3 line = _chainPositions[i] - _chainPositions[neighbor];
+        float lineLength = glm::length(line);
+        if (lineLength > MIN_SEGMENT_LENGTH) {
+            _chainPositions[i] = _chainPositions[neighbor] + (length / lineLength) * line;
+        }
+    };
+
+    // iterate the forward and backward reaching passes, the base of the chain stays where it is
+    const int MAX_FABRIK_ITERATIONS = 4;
+    const glm::vec3 basePosition = _chainPositions[numChainJoints - 1];
+    const glm::vec3 targetPosition = target.getTranslation();
+    for (int iteration = 0; iteration < MAX_FABRIK_ITERATIONS; ++iteration) {
+        if (glm::length(_chainPositions[0] - targetPosition) <= _maxError) {
+            break;
+        }
+        _chainPositions[0] = targetPosition;
+        for (int i = 1; i < numChainJoints; ++i) {
+            place(i, i - 1, _chainLengths[i - 1]);
+        }
+        _chainPositions[numChainJoints - 1] = basePosition;
+        for (int i = numChainJoints - 2; i >= 0; --i) {
+            place(i, i + 1, _chainLengths[i]);
+        }
+    }
+
+    // convert the new positions into rotations, from the base down, enforcing each joint's constraint as we go
+    int baseParentIndex = _skeleton->getParentIndex(_chainIndices[numChainJoints - 1]);
+    glm::quat parentRotation = absolutePoses[baseParentIndex].rot;
+    glm::quat deltaRotation; // how far the joints above have turned the current one
+    for (int i = numChainJoints - 1; i > 0; --i) {
+        int jointIndex = _chainIndices[i];
+        int childIndex = _chainIndices[i - 1];
+        const AnimPose& jointPose = absolutePoses[jointIndex];
+
+        glm::vec3 currentLine = deltaRotation * (absolutePoses[childIndex].trans - jointPose.trans);
+        glm::vec3 desiredLine = _chainPositions[i - 1] - _chainPositions[i];
+        glm::quat swing;
+        if (glm::length(currentLine) > MIN_SEGMENT_LENGTH && glm::length(desiredLine) > MIN_SEGMENT_LENGTH) {
+            swing = rotationBetween(currentLine, desiredLine);
+        }
+
+        // Q = Qp * q   -->   q' = Qp^ * Q
+        glm::quat newRot = glm::normalize(glm::inverse(parentRotation) * swing * deltaRotation * jointPose.rot);
+        RotationConstraint* constraint = getConstraint(jointIndex);
+        if (constraint) {
+            constraint->apply(newRot);
+        }
+        _accumulators[jointIndex].add(newRot, target.getWeight());
+
+        if (jointIndex < lowestMovedIndex) {
+            lowestMovedIndex = jointIndex;
+        }
+
+        glm::quat newAbsoluteRotation = glm::normalize(parentRotation * newRot);
+        deltaRotation = glm::normalize(newAbsoluteRotation * glm::inverse(jointPose.rot));
+        parentRotation = newAbsoluteRotation;
+    }
+    return lowestMovedIndex;
+}
+
 //virtual
 const AnimPoseVec& AnimInverseKinematics::evaluate(const AnimVariantMap& animVars, float dt, AnimNode::Triggers& triggersOut) {
     // don't call this function, call overlay() instead
@@ -476,8 +592,8 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
             }
 
             {
-                PROFILE_RANGE_EX("ik/ccd", 0xffff00ff, 0);
-                solveWithCyclicCoordinateDescent(targets);
+                PROFILE_RANGE_EX("ik/solve", 0xffff00ff, 0);
+                solve(targets);
             }
 
             {
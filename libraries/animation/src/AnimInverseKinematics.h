@@ -24,6 +24,11 @@ class RotationConstraint;
 
 class AnimInverseKinematics : public AnimNode {
 public:
+    enum class Solver {
+        CyclicCoordinateDescent = 0,
+        FABRIK,
+        NumSolvers
+    };
 
     explicit AnimInverseKinematics(const QString& id);
     virtual ~AnimInverseKinematics() override;
@@ -32,7 +37,18 @@ public:
     void loadPoses(const AnimPoseVec& poses);
     void computeAbsolutePoses(AnimPoseVec& absolutePoses) const;
 
-    void setTargetVars(const QString& jointName, const QString& positionVar, const QString& rotationVar, const QString& typeVar);
+    // maxIterations limits the number of solver passes that include this target, 0 means no limit beyond the node's own
+    void setTargetVars(const QString& jointName, const QString& positionVar, const QString& rotationVar, const QString& typeVar,
+                       int maxIterations = 0);
+
+    Solver getSolver() const { return _solver; }
+    void setSolver(Solver solver) { _solver = solver; }
+
+    // the solver stops once every positional target is within maxError or after maxIterations passes over the targets
+    int getMaxIterations() const { return _maxIterations; }
+    void setMaxIterations(int maxIterations) { _maxIterations = maxIterations; }
+    float getMaxError() const { return _maxError; }
+    void setMaxError(float maxError) { _maxError = maxError; }
 
     virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, float dt, AnimNode::Triggers& triggersOut) override;
     virtual const AnimPoseVec& overlay(const AnimVariantMap& animVars, float dt, Triggers& triggersOut, const AnimPoseVec& underPoses) override;
@@ -41,8 +57,9 @@ public:
 
 protected:
     void computeTargets(const AnimVariantMap& animVars, std::vector<IKTarget>& targets, const AnimPoseVec& underPoses);
-    void solveWithCyclicCoordinateDescent(const std::vector<IKTarget>& targets);
+    void solve(const std::vector<IKTarget>& targets);
     int solveTargetWithCCD(const IKTarget& target, AnimPoseVec& absolutePoses);
+    int solveTargetWithFABRIK(const IKTarget& target, const AnimPoseVec& absolutePoses);
     virtual void setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) override;
 
     // for AnimDebugDraw rendering
@@ -60,12 +77,14 @@ protected:
         IKTargetVar(const QString& jointNameIn,
                 const QString& positionVarIn,
                 const QString& rotationVarIn,
-                const QString& typeVarIn) :
+                const QString& typeVarIn,
+                int maxIterationsIn) :
             positionVar(positionVarIn),
             rotationVar(rotationVarIn),
             typeVar(typeVarIn),
             jointName(jointNameIn),
-            jointIndex(-1)
+            jointIndex(-1),
+            maxIterations(maxIterationsIn)
         {}
 
         QString positionVar;
@@ -73,6 +92,7 @@ protected:
         QString typeVar;
         QString jointName;
         int jointIndex; // cached joint index
+        int maxIterations;
     };
 
     std::map<int, RotationConstraint*> _constraints;
@@ -90,6 +110,15 @@ protected:
     // _maxTargetIndex is tracked to help optimize the recalculation of absolute poses
     // during the the cyclic coordinate descent algorithm
     int _maxTargetIndex { 0 };
+
+    Solver _solver { Solver::CyclicCoordinateDescent };
+    int _maxIterations { 16 };
+    float _maxError { 0.1f };
+
+    // scratch space for solveTargetWithFABRIK, from the tip up to the base of the chain
+    std::vector<int> _chainIndices;
+    std::vector<glm::vec3> _chainPositions;
+    std::vector<float> _chainLengths;
 };
 
 #endif // hifi_AnimInverseKinematics_h
@@ -100,6 +100,26 @@ static AnimManipulator::JointVar::Type stringToAnimManipulatorJointVarType(const
     return AnimManipulator::JointVar::Type::NumTypes;
 }
 
+static const char* solverToString(AnimInverseKinematics::Solver solver) {
+    switch (solver) {
+    case AnimInverseKinematics::Solver::CyclicCoordinateDescent: return "ccd";
+    case AnimInverseKinematics::Solver::FABRIK: return "fabrik";
+    case AnimInverseKinematics::Solver::NumSolvers: return nullptr;
+    };
+    return nullptr;
+}
+
+static AnimInverseKinematics::Solver stringToSolver(const QString& str) {
+    const int NUM_SOLVERS = static_cast<int>(AnimInverseKinematics::Solver::NumSolvers);
+    for (int i = 0; i < NUM_SOLVERS; i++) {
+        AnimInverseKinematics::Solver solver = static_cast<AnimInverseKinematics::Solver>(i);
+        if (str == solverToString(solver)) {
+            return solver;
+        }
+    }
+    return AnimInverseKinematics::Solver::NumSolvers;
+}
+
 static NodeLoaderFunc animNodeTypeToLoaderFunc(AnimNode::Type type) {
     switch (type) {
     case AnimNode::Type::Clip: return loadClipNode;
@@ -173,6 +193,21 @@ static NodeProcessFunc animNodeTypeToProcessFunc(AnimNode::Type type) {
     }                                                                   \
     float NAME = (float)NAME##_VAL.toDouble()
 
+#define READ_OPTIONAL_FLOAT(NAME, JSON_OBJ, DEFAULT)                    \
+    auto NAME##_VAL = JSON_OBJ.value(#NAME);                            \
+    float NAME = DEFAULT;                                               \
+    if (NAME##_VAL.isDouble()) {                                        \
+        NAME = (float)NAME##_VAL.toDouble();                            \
+    }                                                                   \
+    do {} while (0)
+
+#define READ_OPTIONAL_INT(NAME, JSON_OBJ, DEFAULT)                      \
+    auto NAME##_VAL = JSON_OBJ.value(#NAME);                            \
+    int NAME = DEFAULT;                                                 \
+    if (NAME##_VAL.isDouble()) {                                        \
+        NAME = NAME##_VAL.toInt();                                      \
+    }                                                                   \
+    do {} while (0)
 
 static AnimNode::Pointer loadNode(const QJsonObject& jsonObj, const QUrl& jsonUrl) {
     auto idVal = jsonObj.value("id");
@@ -426,6 +461,21 @@ static AnimNode::Pointer loadManipulatorNode(const QJsonObject& jsonObj, const Q
 AnimNode::Pointer loadInverseKinematicsNode(const QJsonObject& jsonObj, const QString& id, const QUrl& jsonUrl) {
     auto node = std::make_shared<AnimInverseKinematics>(id);
 
+    READ_OPTIONAL_STRING(solver, jsonObj);
+    if (!solver.isEmpty()) {
+        AnimInverseKinematics::Solver solverEnum = stringToSolver(solver);
+        if (solverEnum == AnimInverseKinematics::Solver::NumSolvers) {
+            qCCritical(animation) << "AnimNodeLoader, bad solver" << solver << "in inverseKinematics node, id =" << id << ", url =" << jsonUrl.toDisplayString();
+            return nullptr;
+        }
+        node->setSolver(solverEnum);
+    }
+
+    READ_OPTIONAL_INT(maxIterations, jsonObj, node->getMaxIterations());
+    READ_OPTIONAL_FLOAT(maxError, jsonObj, node->getMaxError());
+    node->setMaxIterations(maxIterations);
+    node->setMaxError(maxError);
+
     auto targetsValue = jsonObj.value("targets");
     if (!targetsValue.isArray()) {
         qCCritical(animation) << "AnimNodeLoader, bad array \"targets\" in inverseKinematics node, id =" << id << ", url =" << jsonUrl.toDisplayString();
@@ -444,8 +494,9 @@ AnimNode::Pointer loadInverseKinematicsNode(const QJsonObject& jsonObj, const QS
         READ_STRING(positionVar, targetObj, id, jsonUrl, nullptr);
         READ_STRING(rotationVar, targetObj, id, jsonUrl, nullptr);
         READ_OPTIONAL_STRING(typeVar, targetObj);
+        READ_OPTIONAL_INT(maxIterations, targetObj, 0);
 
-        node->setTargetVars(jointName, positionVar, rotationVar, typeVar);
+        node->setTargetVars(jointName, positionVar, rotationVar, typeVar, maxIterations);
     };
 
     return node;
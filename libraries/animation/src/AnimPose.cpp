@@ -44,6 +44,13 @@ glm::vec3 AnimPose::xformVector(const glm::vec3& rhs) const {
 }
 
 AnimPose AnimPose::operator*(const AnimPose& rhs) const {
+    // with a uniform scale on the left the product is another scale, rotation and translation, and can be
+    // composed directly instead of going through a matrix and decomposing it again
+    const float UNIFORM_SCALE_EPSILON = 0.0001f;
+    float maxScaleError = UNIFORM_SCALE_EPSILON * fabsf(scale.x);
+    if (fabsf(scale.y - scale.x) <= maxScaleError && fabsf(scale.z - scale.x) <= maxScaleError) {
+        return AnimPose(scale.x * rhs.scale, rot * rhs.rot, trans + rot * (scale.x * rhs.trans));
+    }
     return AnimPose(static_cast<glm::mat4>(*this) * static_cast<glm::mat4>(rhs));
 }
 
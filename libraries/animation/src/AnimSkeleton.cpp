@@ -12,6 +12,8 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <QtCore/QCryptographicHash>
+
 #include <GLMHelpers.h>
 
 #include "AnimationLogging.h"
@@ -132,6 +134,19 @@ void AnimSkeleton::mirrorAbsolutePoses(AnimPoseVec& poses) const {
     }
 }
 
+QByteArray AnimSkeleton::getFingerprint() const {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (int i = 0; i < (int)_joints.size(); i++) {
+        hash.addData(_joints[i].name.toUtf8());
+        hash.addData(reinterpret_cast<const char*>(&_joints[i].parentIndex), sizeof(int));
+        hash.addData(reinterpret_cast<const char*>(&_relativeBindPoses[i]), sizeof(AnimPose));
+        hash.addData(reinterpret_cast<const char*>(&_relativeDefaultPoses[i]), sizeof(AnimPose));
+        hash.addData(reinterpret_cast<const char*>(&_relativePreRotationPoses[i]), sizeof(AnimPose));
+        hash.addData(reinterpret_cast<const char*>(&_relativePostRotationPoses[i]), sizeof(AnimPose));
+    }
+    return hash.result();
+}
+
 void AnimSkeleton::buildSkeletonFromJoints(const std::vector<FBXJoint>& joints) {
     _joints = joints;
 
@@ -60,6 +60,10 @@ public:
     void mirrorRelativePoses(AnimPoseVec& poses) const;
     void mirrorAbsolutePoses(AnimPoseVec& poses) const;
 
+    // a hash of the joint names, hierarchy, bind and default poses: skeletons with the same fingerprint play an
+    // animation the same way
+    QByteArray getFingerprint() const;
+
 #ifndef NDEBUG
     void dump() const;
     void dump(const AnimPoseVec& poses) const;
@@ -11,10 +11,7 @@
 #include "AnimUtil.h"
 #include "GLMHelpers.h"
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
-
-void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+static void blendScalar(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -33,6 +30,103 @@ void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, A
     }
 }
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// the poses are blended as a flat array of floats, four at a time
+static const int FLOATS_PER_POSE = 10;
+static_assert(sizeof(AnimPose) == FLOATS_PER_POSE * sizeof(float), "AnimPose must be tightly packed floats");
+
+// Four poses make ten registers of floats, which are lerped as they are. This is right for the scales and translations,
+// the rotations are also loaded one per register and transposed, so each component of the four is blended at once
+// and the results overwrite the lerped rotations. Everything is loaded before anything is stored, so the result may
+// be the same array as a or b.
+static void blendSSE(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    const size_t POSES_PER_BLOCK = 4;
+    const int REGISTERS_PER_BLOCK = FLOATS_PER_POSE * POSES_PER_BLOCK / 4;
+
+    const __m128 alpha4 = _mm_set1_ps(alpha);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    size_t i = 0;
+    for (; i + POSES_PER_BLOCK <= numPoses; i += POSES_PER_BLOCK) {
+        const float* aFloats = reinterpret_cast<const float*>(a + i);
+        const float* bFloats = reinterpret_cast<const float*>(b + i);
+        float* resultFloats = reinterpret_cast<float*>(result + i);
+
+        __m128 aLinear[REGISTERS_PER_BLOCK];
+        __m128 bLinear[REGISTERS_PER_BLOCK];
+        for (int k = 0; k < REGISTERS_PER_BLOCK; k++) {
+            aLinear[k] = _mm_loadu_ps(aFloats + 4 * k);
+            bLinear[k] = _mm_loadu_ps(bFloats + 4 * k);
+        }
+
+        __m128 ax = _mm_loadu_ps(&a[i].rot.x);
+        __m128 ay = _mm_loadu_ps(&a[i + 1].rot.x);
+        __m128 az = _mm_loadu_ps(&a[i + 2].rot.x);
+        __m128 aw = _mm_loadu_ps(&a[i + 3].rot.x);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+
+        __m128 bx = _mm_loadu_ps(&b[i].rot.x);
+        __m128 by = _mm_loadu_ps(&b[i + 1].rot.x);
+        __m128 bz = _mm_loadu_ps(&b[i + 2].rot.x);
+        __m128 bw = _mm_loadu_ps(&b[i + 3].rot.x);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+        // adjust signs if necessary
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        __m128 sign = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), signMask);
+        bx = _mm_xor_ps(bx, sign);
+        by = _mm_xor_ps(by, sign);
+        bz = _mm_xor_ps(bz, sign);
+        bw = _mm_xor_ps(bw, sign);
+
+        __m128 rx = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), alpha4));
+        __m128 ry = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), alpha4));
+        __m128 rz = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), alpha4));
+        __m128 rw = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), alpha4));
+
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                          _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+        if (_mm_movemask_ps(_mm_cmple_ps(lengthSquared, _mm_setzero_ps()))) {
+            // a degenerate rotation, leave it to glm::normalize
+            blendScalar(POSES_PER_BLOCK, a + i, b + i, alpha, result + i);
+            continue;
+        }
+        __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared));
+        rx = _mm_mul_ps(rx, inverseLength);
+        ry = _mm_mul_ps(ry, inverseLength);
+        rz = _mm_mul_ps(rz, inverseLength);
+        rw = _mm_mul_ps(rw, inverseLength);
+        _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+
+        for (int k = 0; k < REGISTERS_PER_BLOCK; k++) {
+            __m128 lerped = _mm_add_ps(aLinear[k], _mm_mul_ps(_mm_sub_ps(bLinear[k], aLinear[k]), alpha4));
+            _mm_storeu_ps(resultFloats + 4 * k, lerped);
+        }
+        _mm_storeu_ps(&result[i].rot.x, rx);
+        _mm_storeu_ps(&result[i + 1].rot.x, ry);
+        _mm_storeu_ps(&result[i + 2].rot.x, rz);
+        _mm_storeu_ps(&result[i + 3].rot.x, rw);
+    }
+
+    blendScalar(numPoses - i, a + i, b + i, alpha, result + i);
+}
+
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    blendSSE(numPoses, a, b, alpha, result);
+}
+
+#else
+
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    blendScalar(numPoses, a, b, alpha, result);
+}
+
+#endif
+
 float accumulateTime(float startFrame, float endFrame, float timeScale, float currentFrame, float dt, bool loopFlag,
                      const QString& id, AnimNode::Triggers& triggersOut) {
 
@@ -35,6 +35,28 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+AnimClipFrames::Pointer AnimationCache::getClipFrames(const QUrl& url, const QByteArray& key,
+                                                      const std::function<AnimClipFrames::Pointer()>& build) {
+    QByteArray fullKey = url.toEncoded() + '\n' + key;
+
+    QMutexLocker lock(&_clipFramesMutex);
+    auto frames = _clipFrames.value(fullKey).lock();
+    if (!frames) {
+        // drop what the clips have let go of before adding more
+        for (auto it = _clipFrames.begin(); it != _clipFrames.end();) {
+            if (it.value().expired()) {
+                it = _clipFrames.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        frames = build();
+        _clipFrames.insert(fullKey, frames);
+    }
+    return frames;
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
     const void* extra) {
     return QSharedPointer<Resource>(new Animation(url), &Resource::deleter);
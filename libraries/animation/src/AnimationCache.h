@@ -12,6 +12,11 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <functional>
+#include <memory>
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
 #include <QtCore/QRunnable>
 #include <QtScript/QScriptEngine>
 #include <QtScript/QScriptValue>
@@ -20,6 +25,8 @@
 #include <FBXReader.h>
 #include <ResourceCache.h>
 
+#include "AnimClipFrames.h"
+
 class Animation;
 
 typedef QSharedPointer<Animation> AnimationPointer;
@@ -33,6 +40,12 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    /// Returns the frames of the animation at url as a clip built them for one skeleton, so they are only built and
+    /// held once for every clip playing it on a skeleton with the same key. build is called, on the calling thread,
+    /// when no clip holds those frames at the moment. Safe to call from any thread.
+    AnimClipFrames::Pointer getClipFrames(const QUrl& url, const QByteArray& key,
+                                          const std::function<AnimClipFrames::Pointer()>& build);
+
 protected:
 
     virtual QSharedPointer<Resource> createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
@@ -41,6 +54,8 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    QMutex _clipFramesMutex;
+    QHash<QByteArray, std::weak_ptr<const AnimClipFrames>> _clipFrames;
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
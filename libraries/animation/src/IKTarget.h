@@ -30,10 +30,12 @@ public:
     const glm::quat& getRotation() const { return _pose.rot; }
     int getIndex() const { return _index; }
     Type getType() const { return _type; }
+    int getMaxIterations() const { return _maxIterations; }
 
     void setPose(const glm::quat& rotation, const glm::vec3& translation);
     void setIndex(int index) { _index = index; }
     void setType(int);
+    void setMaxIterations(int maxIterations) { _maxIterations = maxIterations; }
 
     // HACK: give HmdHead targets more "weight" during IK algorithm
     float getWeight() const { return _type == Type::HmdHead ? HACK_HMD_TARGET_WEIGHT : 1.0f; }
@@ -42,6 +44,7 @@ private:
     AnimPose _pose;
     int _index{-1};
     Type _type{Type::RotationAndPosition};
+    int _maxIterations{0};
 
 };
 
@@ -754,8 +754,15 @@ void AudioClient::handleLocalEchoAndReverb(QByteArray& inputByteArray) {
 void AudioClient::handleAudioInput() {
     const float inputToNetworkInputRatio = calculateDeviceToNetworkInputRatio();
     const int inputSamplesRequired = (int)((float)AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * inputToNetworkInputRatio);
-    const auto inputAudioSamples = std::unique_ptr<int16_t[]>(new int16_t[inputSamplesRequired]);
-    QByteArray inputByteArray = _inputDevice->readAll();
+    if ((int)_inputFrameSamples.size() < inputSamplesRequired) {
+        _inputFrameSamples.resize(inputSamplesRequired);
+    }
+    int16_t* inputAudioSamples = _inputFrameSamples.data();
+
+    // QByteArray keeps its capacity when it shrinks, so after the first few callbacks reading doesn't allocate
+    QByteArray& inputByteArray = _inputDeviceBuffer;
+    inputByteArray.resize((int)_inputDevice->bytesAvailable());
+    inputByteArray.resize((int)std::max(_inputDevice->read(inputByteArray.data(), inputByteArray.size()), (qint64)0));
 
 
     handleLocalEchoAndReverb(inputByteArray);
@@ -772,7 +779,7 @@ void AudioClient::handleAudioInput() {
         ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO
         : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
 
-    static int16_t networkAudioSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    int16_t* networkAudioSamples = _networkInputSamples;
 
     while (_inputRingBuffer.samplesAvailable() >= inputSamplesRequired) {
 
@@ -784,9 +791,9 @@ void AudioClient::handleAudioInput() {
                 _timeSinceLastClip += (float)numNetworkSamples / (float)AudioConstants::SAMPLE_RATE;
             }
 
-            _inputRingBuffer.readSamples(inputAudioSamples.get(), inputSamplesRequired);
+            _inputRingBuffer.readSamples(inputAudioSamples, inputSamplesRequired);
             possibleResampling(_inputToNetworkResampler,
-                inputAudioSamples.get(), networkAudioSamples,
+                inputAudioSamples, networkAudioSamples,
                 inputSamplesRequired, numNetworkSamples,
                 _inputFormat, _desiredInputFormat);
 
@@ -841,7 +848,8 @@ void AudioClient::handleAudioInput() {
         audioTransform.setRotation(_orientationGetter());
         // FIXME find a way to properly handle both playback audio and user audio concurrently
 
-        QByteArray decocedBuffer(reinterpret_cast<char*>(networkAudioSamples), numNetworkBytes);
+        // the frame buffer outlives the packet, no need to copy it
+        QByteArray decocedBuffer = QByteArray::fromRawData(reinterpret_cast<char*>(networkAudioSamples), numNetworkBytes);
         QByteArray encodedBuffer;
         if (_encoder) {
             _encoder->encode(decocedBuffer, encodedBuffer);
@@ -852,6 +860,9 @@ void AudioClient::handleAudioInput() {
         emitAudioPacket(encodedBuffer.constData(), encodedBuffer.size(), _outgoingAvatarAudioSequenceNumber, audioTransform, packetType, _selectedCodecName);
         _stats.sentPacket();
     }
+
+    // what is left waits for the next callback, on top of what the device buffers
+    _stats.updateInputMsecsAvailable(getInputRingBufferMsecsAvailable());
 }
 
 void AudioClient::handleRecordedAudioInput(const QByteArray& audio) {
@@ -870,14 +881,30 @@ void AudioClient::handleRecordedAudioInput(const QByteArray& audio) {
     emitAudioPacket(encodedBuffer.data(), encodedBuffer.size(), _outgoingAvatarAudioSequenceNumber, audioTransform, PacketType::MicrophoneAudioWithEcho, _selectedCodecName);
 }
 
+static bool isSilentFrame(const int16_t* samples, int numSamples) {
+    for (int i = 0; i < numSamples; i++) {
+        if (samples[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void AudioClient::mixLocalAudioInjectors(int16_t* inputBuffer) {
 
     memset(_hrtfBuffer, 0, sizeof(_hrtfBuffer));
     QVector<AudioInjector*> injectorsToRemove;
     static const float INT16_TO_FLOAT_SCALE_FACTOR = 1/32768.0f;
 
+    // below -60dB a local injector is not rendered, the way the audio-mixer drops streams it can't afford
+    static const float MIN_AUDIBLE_LOCAL_INJECTOR_GAIN = 0.001f;
+
     bool injectorsHaveData = false;
-    
+
+    // the listener is the same for every injector of the frame
+    const glm::vec3 listenerPosition = _positionGetter();
+    const glm::quat inverseListenerOrientation = glm::inverse(_orientationGetter());
+
     // lock the injector vector
     Lock lock(_injectorsMutex);
 
@@ -895,19 +922,34 @@ void AudioClient::mixLocalAudioInjectors(int16_t* inputBuffer) {
                 injectorsHaveData = true;
 
                 if (injector->isStereo() ) {
-                    for(int i=0; i<AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
-                        _hrtfBuffer[i] += (float)(_scratchBuffer[i]) * INT16_TO_FLOAT_SCALE_FACTOR;
+                    // the volume of the injector was applied as it was read, so a muted one reads as silence
+                    if (!isSilentFrame(_scratchBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO)) {
+                        for(int i=0; i<AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+                            _hrtfBuffer[i] += (float)(_scratchBuffer[i]) * INT16_TO_FLOAT_SCALE_FACTOR;
+                        }
                     }
                     
                 } else {
 
                     // calculate distance, gain and azimuth for hrtf
-                    glm::vec3 relativePosition = injector->getPosition() - _positionGetter();
+                    glm::vec3 relativePosition = injector->getPosition() - listenerPosition;
                     float distance = glm::max(glm::length(relativePosition), EPSILON);
                     float gain = gainForSource(distance, injector->getVolume()); 
-                    float azimuth = azimuthForSource(relativePosition);         
-                
-                    injector->getLocalHRTF().render(_scratchBuffer, _hrtfBuffer, 1, azimuth, distance, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                    float azimuth = azimuthForSource(relativePosition, inverseListenerOrientation);
+
+                    // silent and inaudible frames still go through the HRTF of the injector, which only renders
+                    // the first of them, so that its tail fades out and it fades back in when it is heard again
+                    auto& hrtf = injector->getLocalHRTF();
+                    if (gain < MIN_AUDIBLE_LOCAL_INJECTOR_GAIN) {
+                        hrtf.renderSilent(_scratchBuffer, _hrtfBuffer, 1, azimuth, distance, 0.0f,
+                                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                    } else if (isSilentFrame(_scratchBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL)) {
+                        hrtf.renderSilent(_scratchBuffer, _hrtfBuffer, 1, azimuth, distance, gain,
+                                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                    } else {
+                        hrtf.render(_scratchBuffer, _hrtfBuffer, 1, azimuth, distance, gain,
+                                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                    }
                 }
             
             } else {
@@ -1294,10 +1336,9 @@ float AudioClient::getAudioOutputMsecsUnplayed() const {
 }
 
 
-float AudioClient::azimuthForSource(const glm::vec3& relativePosition) {
+float AudioClient::azimuthForSource(const glm::vec3& relativePosition, const glm::quat& inverseOrientation) {
     // copied from AudioMixer, more or less
-    glm::quat inverseOrientation = glm::inverse(_orientationGetter());
-    
+
     // compute sample delay for the 2 ears to create phase panning
     glm::vec3 rotatedSourcePosition = inverseOrientation * relativePosition;
     
@@ -1351,6 +1392,7 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
     }
 
     int bytesAudioOutputUnplayed = _audio->_audioOutput->bufferSize() - _audio->_audioOutput->bytesFree();
+    _audio->_stats.updateOutputMsecsUnplayed(_audio->getAudioOutputMsecsUnplayed());
     if (!bytesAudioOutputUnplayed) {
         qCDebug(audioclient) << "empty audio buffer";
     }
@@ -222,7 +222,7 @@ protected:
 private:
     void outputFormatChanged();
     void mixLocalAudioInjectors(int16_t* inputBuffer);
-    float azimuthForSource(const glm::vec3& relativePosition);
+    float azimuthForSource(const glm::vec3& relativePosition, const glm::quat& inverseOrientation);
     float gainForSource(float distance, float volume);
 
     Mutex _injectorsMutex;
@@ -242,6 +242,10 @@ private:
     QAudioOutput* _loopbackAudioOutput;
     QIODevice* _loopbackOutputDevice;
     AudioRingBuffer _inputRingBuffer;
+    // the input of one callback and one frame of it at the device rate, kept so that capture doesn't allocate
+    QByteArray _inputDeviceBuffer;
+    std::vector<int16_t> _inputFrameSamples;
+    int16_t _networkInputSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     MixedProcessedAudioStream _receivedAudioStream;
     bool _isStereoInput;
 
@@ -30,6 +30,8 @@ public:
     void reset();
     
     void updateInputMsecsRead(float msecsRead) { _audioInputMsecsReadStats.update(msecsRead); }
+    void updateInputMsecsAvailable(float msecsAvailable) { _inputRingBufferMsecsAvailableStats.update(msecsAvailable); }
+    void updateOutputMsecsUnplayed(float msecsUnplayed) { _audioOutputMsecsUnplayedStats.update(msecsUnplayed); }
     void sentPacket();
     
     AudioStreamStats getMixerDownstreamStats() const;
@@ -229,15 +229,19 @@ static void FIR_1x4_SSE(float* src, float* dst0, float* dst1, float* dst2, float
 #include "CPUDetect.h"
 
 void FIR_1x4_AVX(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
+void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames);
+void interpolate_AVX2(float* dst, const float* src0, const float* src1, float frac, float gain);
 
 static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
 
-    static auto f = cpuSupportsAVX() ? FIR_1x4_AVX : FIR_1x4_SSE;
+    static auto f = cpuSupportsAVX2() ? FIR_1x4_AVX2 : cpuSupportsAVX() ? FIR_1x4_AVX : FIR_1x4_SSE;
     (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
 }
 
 // 4 channel planar to interleaved
-static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
+static void interleave_4x4_SSE(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
     assert(numFrames % 4 == 0);
 
@@ -333,7 +337,7 @@ static void biquad2_4x4(float* src, float* dst, float coef[5][8], float state[3]
 }
 
 // crossfade 4 inputs into 2 outputs with accumulation (interleaved)
-static void crossfade_4x2(float* src, float* dst, const float* win, int numFrames) {
+static void crossfade_4x2_SSE(float* src, float* dst, const float* win, int numFrames) {
 
     assert(numFrames % 4 == 0);
 
@@ -380,7 +384,7 @@ static void crossfade_4x2(float* src, float* dst, const float* win, int numFrame
 }
 
 // linear interpolation with gain
-static void interpolate(float* dst, const float* src0, const float* src1, float frac, float gain) {
+static void interpolate_SSE(float* dst, const float* src0, const float* src1, float frac, float gain) {
 
     __m128 f0 = _mm_set1_ps(HRTF_GAIN * gain * (1.0f - frac));
     __m128 f1 = _mm_set1_ps(HRTF_GAIN * gain * frac);
@@ -398,6 +402,55 @@ static void interpolate(float* dst, const float* src0, const float* src1, float
     }
 }
 
+static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? interleave_4x4_AVX2 : interleave_4x4_SSE;
+    (*f)(src0, src1, src2, src3, dst, numFrames); // dispatch
+}
+
+static void crossfade_4x2(float* src, float* dst, const float* win, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? crossfade_4x2_AVX2 : crossfade_4x2_SSE;
+    (*f)(src, dst, win, numFrames); // dispatch
+}
+
+static void interpolate(float* dst, const float* src0, const float* src1, float frac, float gain) {
+
+    static auto f = cpuSupportsAVX2() ? interpolate_AVX2 : interpolate_SSE;
+    (*f)(dst, src0, src1, frac, gain); // dispatch
+}
+
+//
+// on ARM architecture, NEON is used when the target has it
+//
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+void FIR_1x4_NEON(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void interleave_4x4_NEON(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
+void biquad2_4x4_NEON(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
+void crossfade_4x2_NEON(float* src, float* dst, const float* win, int numFrames);
+void interpolate_NEON(float* dst, const float* src0, const float* src1, float frac, float gain);
+
+static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+    FIR_1x4_NEON(src, dst0, dst1, dst2, dst3, coef, numFrames);
+}
+
+static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
+    interleave_4x4_NEON(src0, src1, src2, src3, dst, numFrames);
+}
+
+static void biquad2_4x4(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames) {
+    biquad2_4x4_NEON(src, dst, coef, state, numFrames);
+}
+
+static void crossfade_4x2(float* src, float* dst, const float* win, int numFrames) {
+    crossfade_4x2_NEON(src, dst, win, numFrames);
+}
+
+static void interpolate(float* dst, const float* src0, const float* src1, float frac, float gain) {
+    interpolate_NEON(dst, src0, src1, frac, gain);
+}
+
 #else   // portable reference code
 
 // 1 channel input, 4 channel output
@@ -840,6 +893,19 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
 
 void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
 
+    assert(numFrames == HRTF_BLOCK);
+
+    // convert mono input to float
+    float in[HRTF_BLOCK];
+    for (int i = 0; i < HRTF_BLOCK; i++) {
+        in[i] = (float)input[i] * (1/32768.0f);
+    }
+
+    render(in, output, index, azimuth, distance, gain, numFrames);
+}
+
+void AudioHRTF::render(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
+
     assert(index >= 0);
     assert(index < HRTF_TABLES);
     assert(numFrames == HRTF_BLOCK);
@@ -862,10 +928,8 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _distanceState = distance;
     _gainState = gain;
 
-    // convert mono input to float
-    for (int i = 0; i < HRTF_BLOCK; i++) {
-        in[HRTF_TAPS+i] = (float)input[i] * (1/32768.0f);
-    }
+    // copy mono input behind the FIR history
+    memcpy(&in[HRTF_TAPS], input, HRTF_BLOCK * sizeof(float));
 
     // FIR state update
     memcpy(in, _firState, HRTF_TAPS * sizeof(float));
@@ -925,6 +989,21 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
 
 void AudioHRTF::renderSilent(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
 
+    // process the first silent block, to flush internal state
+    if (!_silentState) {
+        render(input, output, index, azimuth, distance, gain, numFrames);
+    }
+
+    // new parameters become old
+    _azimuthState = azimuth;
+    _distanceState = distance;
+    _gainState = gain;
+
+    _silentState = true;
+}
+
+void AudioHRTF::renderSilent(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
+
     // process the first silent block, to flush internal state
     if (!_silentState) {
         render(input, output, index, azimuth, distance, gain, numFrames);
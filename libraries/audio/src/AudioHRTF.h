@@ -39,10 +39,17 @@ public:
     //
     void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
+    //
+    // Same as above, for a mono source already converted to float (scaled by 1/32768)
+    // Lets a source shared by many listeners be converted once instead of once per listener
+    //
+    void render(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
+
     //
     // Fast path when input is known to be silent
     //
     void renderSilent(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
+    void renderSilent(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
 private:
     AudioHRTF(const AudioHRTF&) = delete;
@@ -97,8 +97,17 @@ private:
     void setupInjection();
     int64_t injectNextFrame();
     bool injectLocally();
+
+    // the frame written by the last injectNextFrame, until the AudioInjectorManager has sent it
+    const NLPacket* getPendingFrame() const { return _hasPendingFrame ? _currentPacket.get() : nullptr; }
+    void pendingFrameSent(bool wasSent) {
+        _hasPendingFrame = false;
+        if (wasSent) {
+            _outgoingSequenceNumber++;
+        }
+    }
     
-    QByteArray _audioData;
+    QByteArray _audioData; // shares the samples of its sound, only read through constData()
     AudioInjectorOptions _options;
     AudioInjectorState _state { AudioInjectorState::NotFinished };
     bool _hasSentFirstFrame { false };
@@ -107,6 +116,7 @@ private:
     float _loudness { 0.0f };
     int _currentSendOffset { 0 };
     std::unique_ptr<NLPacket> _currentPacket { nullptr };
+    bool _hasPendingFrame { false };
     AbstractAudioInterface* _localAudioInterface { nullptr };
     AudioInjectorLocalBuffer* _localBuffer { nullptr };
     
@@ -36,9 +36,9 @@ bool AudioInjectorLocalBuffer::seek(qint64 pos) {
     }
 }
 
-void copy(char* to, char* from, int size, qreal factor) {
+void copy(char* to, const char* from, int size, qreal factor) {
     int16_t* toArray = (int16_t*) to;
-    int16_t* fromArray = (int16_t*) from;
+    const int16_t* fromArray = (const int16_t*) from;
     int sampleSize = size / sizeof(int16_t);
     
     for (int i = 0; i < sampleSize; i++) {
@@ -60,7 +60,7 @@ qint64 AudioInjectorLocalBuffer::readData(char* data, qint64 maxSize) {
             bytesRead = bytesToEnd;
         }
         
-        copy(data, _rawAudioArray.data() + _currentOffset, bytesRead, _volume);
+        copy(data, _rawAudioArray.constData() + _currentOffset, bytesRead, _volume);
         
         // now check if we are supposed to loop and if we can copy more from the beginning
         if (_shouldLoop && maxSize != bytesRead) {
@@ -88,7 +88,7 @@ qint64 AudioInjectorLocalBuffer::recursiveReadFromFront(char* data, qint64 maxSi
     }
     
     // copy that amount
-    copy(data, _rawAudioArray.data(), bytesRead, _volume);
+    copy(data, _rawAudioArray.constData(), bytesRead, _volume);
     
     // check if we need to call ourselves again and pull from the front again
     if (bytesRead < maxSize) {
@@ -35,7 +35,7 @@ public:
 private:
     qint64 recursiveReadFromFront(char* data, qint64 maxSize);
 
-    QByteArray _rawAudioArray;
+    const QByteArray _rawAudioArray; // shares the samples of the injector, only read through constData()
     bool _shouldLoop;
     bool _isStopped;
 
@@ -11,8 +11,11 @@
 
 #include "AudioInjectorManager.h"
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
 
+#include <NodeList.h>
 #include <SharedUtil.h>
 
 #include "AudioConstants.h"
@@ -24,15 +27,12 @@ AudioInjectorManager::~AudioInjectorManager() {
     Lock lock(_injectorsMutex);
     
     // make sure any still living injectors are stopped and deleted
-    while (!_injectors.empty()) {
-        // grab the injector at the front
-        auto& timePointerPair = _injectors.top();
-        
-        // ask it to stop and be deleted
-        timePointerPair.second->stopAndDeleteLater();
-        
-        _injectors.pop();
-    }
+    _injectors.clear([](InjectorQPointer& injector) {
+        if (!injector.isNull()) {
+            // ask it to stop and be deleted
+            injector->stopAndDeleteLater();
+        }
+    });
     
     // get rid of the lock now that we've stopped all living injectors
     lock.unlock();
@@ -59,60 +59,40 @@ void AudioInjectorManager::createThread() {
 }
 
 void AudioInjectorManager::run() {
+    std::vector<InjectorQPointer> batch;
+
     while (!_shouldStop) {
-        // wait until the next injector is ready, or until we get a new injector given to us
+        // wait until the next slot with injectors in it starts, or until we get a new injector given to us
         Lock lock(_injectorsMutex);
         
-        if (_injectors.size() > 0) {
-            // when does the next injector need to send a frame?
+        if (!_injectors.empty()) {
+            // when does the next batch of injectors need to send a frame?
             // do we get to wait or should we just go for it now?
-            
-            auto timeInjectorPair = _injectors.top();
-            
-            auto nextTimestamp = timeInjectorPair.first;
-            int64_t difference = int64_t(nextTimestamp - usecTimestampNow());
+            int64_t difference = int64_t(_injectors.nextSlotUsecs() - usecTimestampNow());
             
             if (difference > 0) {
                 _injectorReady.wait_for(lock, std::chrono::microseconds(difference));
             }
-            
-            if (_injectors.size() > 0) {
-                // loop through the injectors in the map and send whatever frames need to go out
-                auto front = _injectors.top();
-
-                // create an InjectorQueue to hold injectors to be queued
-                // this allows us to call processEvents even if a single injector wants to be re-queued immediately
-                std::vector<TimeInjectorPointerPair> heldInjectors;
-                heldInjectors.reserve(_injectors.size());
-
-                while (_injectors.size() > 0 && front.first <= usecTimestampNow()) {
-                    // either way we're popping this injector off - get a copy first
-                    auto injector = front.second;
-                    _injectors.pop();
-                    
+
+            // every injector due in a slot that has started is part of this batch
+            // injectors that want to go again immediately land in the slot that is still open and go out with the
+            // next batch - this allows us to call processEvents even if a single injector wants to be re-queued immediately
+            batch.clear();
+            if (_injectors.popDue(usecTimestampNow(), batch) > 0) {
+                for (auto& injector : batch) {
                     if (!injector.isNull()) {
-                        // this is an injector that's ready to go, have it send a frame now
+                        // this is an injector that's ready to go, have it write its next frame now
                         auto nextCallDelta = injector->injectNextFrame();
 
                         if (nextCallDelta >= 0 && !injector->isFinished()) {
-                            // enqueue the injector with the correct timing in our holding queue
-                            heldInjectors.emplace(heldInjectors.end(), usecTimestampNow() + nextCallDelta, injector);
+                            // re-queue the injector with the correct timing
+                            auto now = usecTimestampNow();
+                            _injectors.insert(now, now + nextCallDelta, injector);
                         }
                     }
-                    
-                    if (_injectors.size() > 0) {
-                        front = _injectors.top();
-                    } else {
-                        // no more injectors to look at, break
-                        break;
-                    }
                 }
 
-                // if there are injectors in the holding queue, push them to our persistent queue now
-                while (!heldInjectors.empty()) {
-                    _injectors.push(heldInjectors.back());
-                    heldInjectors.pop_back();
-                }
+                sendBatch(batch);
             }
 
         } else {
@@ -127,6 +107,49 @@ void AudioInjectorManager::run() {
     }
 }
 
+void AudioInjectorManager::sendBatch(const std::vector<InjectorQPointer>& batch) {
+    // the frames of the whole batch go to the audio mixer in one send pass
+    std::vector<const NLPacket*> frames;
+    frames.reserve(batch.size());
+
+    for (auto& injector : batch) {
+        if (!injector.isNull() && injector->getPendingFrame()) {
+            frames.push_back(injector->getPendingFrame());
+        }
+    }
+
+    if (frames.empty()) {
+        return;
+    }
+
+    // grab our audio mixer from the NodeList, if it exists
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+
+    auto start = usecTimestampNow();
+    if (audioMixer) {
+        nodeList->sendUnreliablePackets(frames, *audioMixer);
+    }
+    auto sendUsecs = usecTimestampNow() - start;
+
+    for (auto& injector : batch) {
+        if (!injector.isNull() && injector->getPendingFrame()) {
+            injector->pendingFrameSent(audioMixer != nullptr);
+        }
+    }
+
+    ++_batchStats.batches;
+    _batchStats.framesSent += frames.size();
+    _batchStats.maxBatchFrames = std::max(_batchStats.maxBatchFrames, (int)frames.size());
+    _batchStats.sendUsecs += sendUsecs;
+    _batchStats.maxBatchSendUsecs = std::max(_batchStats.maxBatchSendUsecs, sendUsecs);
+}
+
+AudioInjectorManager::BatchStats AudioInjectorManager::getBatchStats() {
+    Lock lock(_injectorsMutex);
+    return _batchStats;
+}
+
 static const int MAX_INJECTORS_PER_THREAD = 40; // calculated based on AudioInjector time to send frame, with sufficient padding
 
 bool AudioInjectorManager::wouldExceedLimits() { // Should be called inside of a lock.
@@ -160,7 +183,8 @@ bool AudioInjectorManager::threadInjector(AudioInjector* injector) {
         // handle a restart once the injector has finished
         
         // add the injector to the queue with a send timestamp of now
-        _injectors.emplace(usecTimestampNow(), InjectorQPointer { injector });
+        auto now = usecTimestampNow();
+        _injectors.insert(now, now, InjectorQPointer { injector });
         
         // notify our wait condition so we can inject two frames for this injector immediately
         _injectorReady.notify_one();
@@ -178,7 +202,8 @@ bool AudioInjectorManager::restartFinishedInjector(AudioInjector* injector) {
             return false;
         }
         // add the injector to the queue with a send timestamp of now
-        _injectors.emplace(usecTimestampNow(), InjectorQPointer { injector });
+        auto now = usecTimestampNow();
+        _injectors.insert(now, now, InjectorQPointer { injector });
         
         // notify our wait condition so we can inject two frames for this injector immediately
         _injectorReady.notify_one();
@@ -15,13 +15,14 @@
 #define hifi_AudioInjectorManager_h
 
 #include <condition_variable>
-#include <queue>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QPointer>
 #include <QtCore/QThread>
 
 #include <DependencyManager.h>
+#include <TimingWheel.h>
 
 class AudioInjector;
 
@@ -30,29 +31,33 @@ class AudioInjectorManager : public QObject, public Dependency {
     SINGLETON_DEPENDENCY
 public:
     ~AudioInjectorManager();
+
+    // the injectors due in the same slot of the timing wheel are run and sent as one batch
+    struct BatchStats {
+        quint64 batches { 0 };
+        quint64 framesSent { 0 };
+        int maxBatchFrames { 0 };
+        quint64 sendUsecs { 0 }; // time spent writing the frames of all batches to the socket
+        quint64 maxBatchSendUsecs { 0 };
+    };
+    BatchStats getBatchStats();
+
 private slots:
     void run();
 private:
     
     using InjectorQPointer = QPointer<AudioInjector>;
-    using TimeInjectorPointerPair = std::pair<uint64_t, InjectorQPointer>;
-    
-    struct greaterTime {
-        bool operator() (const TimeInjectorPointerPair& x, const TimeInjectorPointerPair& y) const {
-            return x.first > y.first;
-        }
-    };
-    
-    using InjectorQueue = std::priority_queue<TimeInjectorPointerPair,
-                                              std::deque<TimeInjectorPointerPair>,
-                                              greaterTime>;
+    using InjectorWheel = TimingWheel<InjectorQPointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
+
+    static const quint64 BATCH_SLOT_USECS = 10 * 1000;
     
     bool threadInjector(AudioInjector* injector);
     bool restartFinishedInjector(AudioInjector* injector);
     void notifyInjectorReadyCondition() { _injectorReady.notify_one(); }
     bool wouldExceedLimits();
+    void sendBatch(const std::vector<InjectorQPointer>& batch);
     
     AudioInjectorManager() {};
     AudioInjectorManager(const AudioInjectorManager&) = delete;
@@ -62,9 +67,10 @@ private:
     
     QThread* _thread { nullptr };
     bool _shouldStop { false };
-    InjectorQueue _injectors;
+    InjectorWheel _injectors { BATCH_SLOT_USECS };
     Mutex _injectorsMutex;
     std::condition_variable _injectorReady;
+    BatchStats _batchStats;
     
     friend class AudioInjector;
 };
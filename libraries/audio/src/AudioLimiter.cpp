@@ -10,6 +10,7 @@
 #include <assert.h>
 
 #include "AudioLimiter.h"
+#include "CPUDetect.h"
 
 #ifndef MAX
 #define MAX(a,b) ((a) > (b) ? (a) : (b))
@@ -244,6 +245,144 @@ static inline float dither() {
     return (int32_t)(r0 - r1) * (1/65536.0f);
 }
 
+//
+// Block kernels for the parts of the limiter without a feedback loop.
+// Peak detection runs ahead of the envelope, and gain, dither and conversion run after it.
+//
+
+// peak detect and -log2(x) for a block of input (mono)
+static void peaklog2_mono(float* input, int32_t* output, int numFrames) {
+    for (int n = 0; n < numFrames; n++) {
+        output[n] = peaklog2(&input[n]);
+    }
+}
+
+// peak detect and -log2(x) for a block of input (stereo)
+static void peaklog2_stereo(float* input, int32_t* output, int numFrames) {
+    for (int n = 0; n < numFrames; n++) {
+        output[n] = peaklog2(&input[2*n+0], &input[2*n+1]);
+    }
+}
+
+// apply gain and dither, then store 16-bit output (mono)
+static void applyGain_mono(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+    for (int n = 0; n < numFrames; n++) {
+        float x = input[n] * gain[n];
+        x += dither[n];
+        output[n] = (int16_t)floatToInt(x);
+    }
+}
+
+// apply gain and dither, then store 16-bit output (stereo)
+static void applyGain_stereo(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+    for (int n = 0; n < numFrames; n++) {
+        float x0 = input[2*n+0] * gain[n];
+        float x1 = input[2*n+1] * gain[n];
+        x0 += dither[n];
+        x1 += dither[n];
+        output[2*n+0] = (int16_t)floatToInt(x0);
+        output[2*n+1] = (int16_t)floatToInt(x1);
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+void peaklog2_mono_AVX2(float* input, int32_t* output, const int32_t table[][3], int numFrames);
+void peaklog2_stereo_AVX2(float* input, int32_t* output, const int32_t table[][3], int numFrames);
+void applyGain_mono_AVX2(float* input, float* gain, float* dither, int16_t* output, int numFrames);
+void applyGain_stereo_AVX2(float* input, float* gain, float* dither, int16_t* output, int numFrames);
+
+// the AVX2 kernels process multiples of 8 frames, the remainder is done here
+static void peaklog2Block_mono(float* input, int32_t* output, int numFrames) {
+    static bool avx2 = cpuSupportsAVX2();
+    int n = 0;
+    if (avx2) {
+        n = numFrames & ~7;
+        peaklog2_mono_AVX2(input, output, log2Table, n);
+    }
+    peaklog2_mono(&input[n], &output[n], numFrames - n);
+}
+
+static void peaklog2Block_stereo(float* input, int32_t* output, int numFrames) {
+    static bool avx2 = cpuSupportsAVX2();
+    int n = 0;
+    if (avx2) {
+        n = numFrames & ~7;
+        peaklog2_stereo_AVX2(input, output, log2Table, n);
+    }
+    peaklog2_stereo(&input[2*n], &output[n], numFrames - n);
+}
+
+static void applyGainBlock_mono(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+    static bool avx2 = cpuSupportsAVX2();
+    int n = 0;
+    if (avx2) {
+        n = numFrames & ~7;
+        applyGain_mono_AVX2(input, gain, dither, output, n);
+    }
+    applyGain_mono(&input[n], &gain[n], &dither[n], &output[n], numFrames - n);
+}
+
+static void applyGainBlock_stereo(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+    static bool avx2 = cpuSupportsAVX2();
+    int n = 0;
+    if (avx2) {
+        n = numFrames & ~7;
+        applyGain_stereo_AVX2(input, gain, dither, output, n);
+    }
+    applyGain_stereo(&input[2*n], &gain[n], &dither[n], &output[2*n], numFrames - n);
+}
+
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+// peak detection needs a table lookup per sample, which NEON has no gather for, so only the output stage is vectorized
+void applyGain_mono_NEON(float* input, float* gain, float* dither, int16_t* output, int numFrames);
+void applyGain_stereo_NEON(float* input, float* gain, float* dither, int16_t* output, int numFrames);
+
+static void peaklog2Block_mono(float* input, int32_t* output, int numFrames) {
+    peaklog2_mono(input, output, numFrames);
+}
+
+static void peaklog2Block_stereo(float* input, int32_t* output, int numFrames) {
+    peaklog2_stereo(input, output, numFrames);
+}
+
+// the NEON kernels process multiples of 4 frames, the remainder is done here
+static void applyGainBlock_mono(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+    int n = numFrames & ~3;
+    applyGain_mono_NEON(input, gain, dither, output, n);
+    applyGain_mono(&input[n], &gain[n], &dither[n], &output[n], numFrames - n);
+}
+
+static void applyGainBlock_stereo(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+    int n = numFrames & ~3;
+    applyGain_stereo_NEON(input, gain, dither, output, n);
+    applyGain_stereo(&input[2*n], &gain[n], &dither[n], &output[2*n], numFrames - n);
+}
+
+#else   // portable reference code
+
+static void peaklog2Block_mono(float* input, int32_t* output, int numFrames) {
+    peaklog2_mono(input, output, numFrames);
+}
+
+static void peaklog2Block_stereo(float* input, int32_t* output, int numFrames) {
+    peaklog2_stereo(input, output, numFrames);
+}
+
+static void applyGainBlock_mono(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+    applyGain_mono(input, gain, dither, output, numFrames);
+}
+
+static void applyGainBlock_stereo(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+    applyGain_stereo(input, gain, dither, output, numFrames);
+}
+
+#endif
+
 //
 // Peak-hold lowpass filter
 //
@@ -408,6 +547,10 @@ public:
     int32_t envelope(int32_t attn);
 
     virtual void process(float* input, int16_t* output, int numFrames) = 0;
+
+protected:
+    // frames processed per pass of the block kernels
+    static const int BLOCK_FRAMES = 64;
 };
 
 LimiterImpl::LimiterImpl(int sampleRate) {
@@ -573,36 +716,43 @@ public:
 template<int N>
 void LimiterMono<N>::process(float* input, int16_t* output, int numFrames)
 {
-    for (int n = 0; n < numFrames; n++) {
+    int32_t peak[BLOCK_FRAMES];
+    float gain[BLOCK_FRAMES];
+    float noise[BLOCK_FRAMES];
+    float delayed[BLOCK_FRAMES];
+
+    for (int i = 0; i < numFrames; i += BLOCK_FRAMES) {
+
+        int count = MIN(numFrames - i, BLOCK_FRAMES);
 
         // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[n]);
+        peaklog2Block_mono(&input[i], peak, count);
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+        for (int n = 0; n < count; n++) {
 
-        // apply envelope
-        attn = envelope(attn);
+            // compute limiter attenuation
+            int32_t attn = MAX(_threshold - peak[n], 0);
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+            // apply envelope
+            attn = envelope(attn);
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+            // convert from log2 domain
+            attn = fixexp2(attn);
 
-        // delay audio
-        float x = input[n];
-        _delay.process(x);
+            // lowpass filter
+            attn = _filter.process(attn);
+            gain[n] = attn * _outGain;
 
-        // apply gain
-        x *= gain;
+            // delay audio
+            float x = input[i+n];
+            _delay.process(x);
+            delayed[n] = x;
 
-        // apply dither
-        x += dither();
+            noise[n] = dither();
+        }
 
-        // store 16-bit output
-        output[n] = (int16_t)floatToInt(x);
+        // apply gain and dither, and store 16-bit output
+        applyGainBlock_mono(delayed, gain, noise, &output[i], count);
     }
 }
 
@@ -625,41 +775,45 @@ public:
 template<int N>
 void LimiterStereo<N>::process(float* input, int16_t* output, int numFrames)
 {
-    for (int n = 0; n < numFrames; n++) {
+    int32_t peak[BLOCK_FRAMES];
+    float gain[BLOCK_FRAMES];
+    float noise[BLOCK_FRAMES];
+    float delayed[2*BLOCK_FRAMES];
+
+    for (int i = 0; i < numFrames; i += BLOCK_FRAMES) {
+
+        int count = MIN(numFrames - i, BLOCK_FRAMES);
 
         // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[2*n+0], &input[2*n+1]);
+        peaklog2Block_stereo(&input[2*i], peak, count);
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+        for (int n = 0; n < count; n++) {
 
-        // apply envelope
-        attn = envelope(attn);
+            // compute limiter attenuation
+            int32_t attn = MAX(_threshold - peak[n], 0);
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+            // apply envelope
+            attn = envelope(attn);
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+            // convert from log2 domain
+            attn = fixexp2(attn);
 
-        // delay audio
-        float x0 = input[2*n+0];
-        float x1 = input[2*n+1];
-        _delay.process(x0, x1);
+            // lowpass filter
+            attn = _filter.process(attn);
+            gain[n] = attn * _outGain;
 
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
+            // delay audio
+            float x0 = input[2*(i+n)+0];
+            float x1 = input[2*(i+n)+1];
+            _delay.process(x0, x1);
+            delayed[2*n+0] = x0;
+            delayed[2*n+1] = x1;
 
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
+            noise[n] = dither();
+        }
 
-        // store 16-bit output
-        output[2*n+0] = (int16_t)floatToInt(x0);
-        output[2*n+1] = (int16_t)floatToInt(x1);
+        // apply gain and dither, and store 16-bit output
+        applyGainBlock_stereo(delayed, gain, noise, &output[2*i], count);
     }
 }
 
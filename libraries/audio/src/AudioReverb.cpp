@@ -33,6 +33,26 @@ inline static int MULHI(int a, int b) {
 #define MIN(a,b)    (((a) < (b)) ? (a) : (b))
 #endif
 
+//
+// on x86 architecture, the block versions of the delay elements are vectorized using SSE2
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+#define REVERB_SSE2
+
+// store { prev, y0, y1, y2 } and return y3, to apply the one-sample output delay of each element
+static inline float storeDelayed(float* output, __m128 y, float prev) {
+    __m128 t = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(y), 4));
+    _mm_storeu_ps(output, _mm_move_ss(t, _mm_set_ss(prev)));
+    return _mm_cvtss_f32(_mm_shuffle_ps(y, y, _MM_SHUFFLE(3,3,3,3)));
+}
+
+#endif
+
+// frames per internal block, divides the network frame and the common device buffer sizes
+static const int PROCESS_BLOCK = 16;
+
 static const float PHI = 0.6180339887f; // maximum allpass diffusion
 static const float TWOPI = 6.283185307f;
 
@@ -727,6 +747,33 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // block version, output may alias input
+    void process(const float* input, float* output, int numFrames) {
+        int i = 0;
+#ifdef REVERB_SSE2
+        // 4 frames at a time, when neither the write nor the read wraps
+        // once the input is stored, any delay in [1, N-4] reads the same samples as the scalar version
+        if (_delay <= N - 4) {
+            while (i < numFrames - 3) {
+                int k = (_index - _delay) & (N - 1);
+                if (_index > N - 4 || k > N - 4) {
+                    process(input[i], output[i]);
+                    i++;
+                    continue;
+                }
+                _mm_storeu_ps(&_buffer[_index], _mm_loadu_ps(&input[i]));
+
+                _output = storeDelayed(&output[i], _mm_loadu_ps(&_buffer[k]), _output);
+                _index = (_index + 4) & (N - 1);
+                i += 4;
+            }
+        }
+#endif
+        for (; i < numFrames; i++) {
+            process(input[i], output[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -773,6 +820,36 @@ public:
         _index1 = (_index1 + 1) & (N - 1);
     }
 
+    // block version, output may alias input
+    void process(const float* input, float* output, int numFrames) {
+        int i = 0;
+#ifdef REVERB_SSE2
+        // 4 frames at a time, when neither index wraps
+        // the feedback path is only independent across frames when delay >= 4
+        if (_delay >= 4) {
+            __m128 coef = _mm_set1_ps(_coef);
+            while (i < numFrames - 3) {
+                if (_index0 > N - 4 || _index1 > N - 4) {
+                    process(input[i], output[i]);
+                    i++;
+                    continue;
+                }
+                __m128 x = _mm_loadu_ps(&input[i]);
+                __m128 y = _mm_sub_ps(_mm_loadu_ps(&_buffer[_index1]), _mm_mul_ps(coef, x));   // feedforward path
+                _mm_storeu_ps(&_buffer[_index0], _mm_add_ps(x, _mm_mul_ps(coef, y)));          // feedback path
+
+                _output = storeDelayed(&output[i], y, _output);
+                _index0 = (_index0 + 4) & (N - 1);
+                _index1 = (_index1 + 4) & (N - 1);
+                i += 4;
+            }
+        }
+#endif
+        for (; i < numFrames; i++) {
+            process(input[i], output[i]);
+        }
+    }
+
     void getOutput(float& output) {
         output = _output;
     }
@@ -1065,6 +1142,40 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // block version, outputs may alias input
+    void process(const float* input, float* output0, float* output1, int numFrames) {
+        int i = 0;
+#ifdef REVERB_SSE2
+        // 4 frames at a time, when neither the write nor the reads wrap
+        // once the input is stored, any delay in [1, N-4] reads the same samples as the scalar version
+        if (MIN(_delay0, _delay1) >= 1 && MAX(_delay0, _delay1) <= N - 4) {
+            __m128 gain0 = _mm_set1_ps(_gain0);
+            __m128 gain1 = _mm_set1_ps(_gain1);
+            while (i < numFrames - 3) {
+                int k0 = (_index - _delay0) & (N - 1);
+                int k1 = (_index - _delay1) & (N - 1);
+                if (_index > N - 4 || k0 > N - 4 || k1 > N - 4) {
+                    process(input[i], output0[i], output1[i]);
+                    i++;
+                    continue;
+                }
+                _mm_storeu_ps(&_buffer[_index], _mm_loadu_ps(&input[i]));
+
+                __m128 y0 = _mm_mul_ps(gain0, _mm_loadu_ps(&_buffer[k0]));
+                __m128 y1 = _mm_mul_ps(gain1, _mm_loadu_ps(&_buffer[k1]));
+
+                _output0 = storeDelayed(&output0[i], y0, _output0);
+                _output1 = storeDelayed(&output1[i], y1, _output1);
+                _index = (_index + 4) & (N - 1);
+                i += 4;
+            }
+        }
+#endif
+        for (; i < numFrames; i++) {
+            process(input[i], output0[i], output1[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -1132,6 +1243,44 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // block version, outputs may alias input
+    void process(const float* input, float* output0, float* output1, float* output2, int numFrames) {
+        int i = 0;
+#ifdef REVERB_SSE2
+        // 4 frames at a time, when neither the write nor the reads wrap
+        // once the input is stored, any delay in [1, N-4] reads the same samples as the scalar version
+        if (MIN(_delay1, _delay2) >= 1 && MAX(_delay0, _delay2) <= N - 4) {
+            __m128 gain0 = _mm_set1_ps(_gain0);
+            __m128 gain1 = _mm_set1_ps(_gain1);
+            __m128 gain2 = _mm_set1_ps(_gain2);
+            while (i < numFrames - 3) {
+                int k0 = (_index - _delay0) & (N - 1);
+                int k1 = (_index - _delay1) & (N - 1);
+                int k2 = (_index - _delay2) & (N - 1);
+                if (_index > N - 4 || k0 > N - 4 || k1 > N - 4 || k2 > N - 4) {
+                    process(input[i], output0[i], output1[i], output2[i]);
+                    i++;
+                    continue;
+                }
+                _mm_storeu_ps(&_buffer[_index], _mm_loadu_ps(&input[i]));
+
+                __m128 y0 = _mm_mul_ps(gain0, _mm_loadu_ps(&_buffer[k0]));
+                __m128 y1 = _mm_mul_ps(gain1, _mm_loadu_ps(&_buffer[k1]));
+                __m128 y2 = _mm_mul_ps(gain2, _mm_loadu_ps(&_buffer[k2]));
+
+                _output0 = storeDelayed(&output0[i], y0, _output0);
+                _output1 = storeDelayed(&output1[i], y1, _output1);
+                _output2 = storeDelayed(&output2[i], y2, _output2);
+                _index = (_index + 4) & (N - 1);
+                i += 4;
+            }
+        }
+#endif
+        for (; i < numFrames; i++) {
+            process(input[i], output0[i], output1[i], output2[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -1214,6 +1363,10 @@ public:
     void setParameters(ReverbParameters *p);
     void process(float** inputs, float** outputs, int numFrames);
     void reset();
+
+private:
+    template<int N>
+    void processBlock(const float* inputL, const float* inputR, float* outputL, float* outputR);
 };
 
 static const short primeTable[] = {
@@ -1582,93 +1735,137 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
     _wetDryMix = MIN(MAX(_wetDryMix, 0.0f), 1.0f);
 }
 
-void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
-
-    for (int i = 0; i < numFrames; i++) {
-        float x0, x1, y0, y1, y2, y3;
+//
+// Each element has a one-sample output delay, so the preprocess, early and output stages form a
+// feedforward network that can be run an element at a time over a whole block.
+// The late network has feedback paths as short as a few samples, and is run a frame at a time.
+//
+template<int N>
+void ReverbImpl::processBlock(const float* inputL, const float* inputR, float* outputL, float* outputR) {
 
-        // Preprocess
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        _bw.process(x0, x1, x0, x1);
+    // Preprocess
+    float preL[N], preR[N];
+    for (int i = 0; i < N; i++) {
+        _bw.process(inputL[i], inputR[i], preL[i], preR[i]);
+    }
+    _dl0.process(preL, preL, N);
+    _dl1.process(preR, preR, N);
 
-        float preL, preR;
-        _dl0.process(x0, preL);
-        _dl1.process(x1, preR);
+    float early0L[N], early1L[N], early2L[N], earlyOutL[N];
+    float early0R[N], early1R[N], early2R[N], earlyOutR[N];
+    {
+        float x0[N], x1[N], y0[N], y1[N], y2[N];
 
         // Early Left
-        float early0L, early1L, early2L, earlyOutL;
-        _mt0.process(preL, x0, x1, y0);
-        _ap0.process(x0 + x1, y1);
-        _mt1.process(y1, x0, x1, early0L);
-        _ap1.process(x0 + x1, y2);
-        _ap2.process(y2, x0);
-        _mt2.process(x0, early1L, early2L);
+        _mt0.process(preL, x0, x1, y0, N);
+        for (int i = 0; i < N; i++) {
+            x0[i] += x1[i];
+        }
+        _ap0.process(x0, y1, N);
+        _mt1.process(y1, x0, x1, early0L, N);
+        for (int i = 0; i < N; i++) {
+            x0[i] += x1[i];
+        }
+        _ap1.process(x0, y2, N);
+        _ap2.process(y2, x0, N);
+        _mt2.process(x0, early1L, early2L, N);
 
-        earlyOutL = (y0 + y1 * _earlyMix1L + y2 * _earlyMix2L) * _earlyGain;
+        for (int i = 0; i < N; i++) {
+            earlyOutL[i] = (y0[i] + y1[i] * _earlyMix1L + y2[i] * _earlyMix2L) * _earlyGain;
+        }
 
         // Early Right
-        float early0R, early1R, early2R, earlyOutR;
-        _mt3.process(preR, x0, x1, y0);
-        _ap3.process(x0 + x1, y1);
-        _mt4.process(y1, x0, x1, early0R);
-        _ap4.process(x0 + x1, y2);
-        _ap5.process(y2, x0);
-        _mt5.process(x0, early1R, early2R);
+        _mt3.process(preR, x0, x1, y0, N);
+        for (int i = 0; i < N; i++) {
+            x0[i] += x1[i];
+        }
+        _ap3.process(x0, y1, N);
+        _mt4.process(y1, x0, x1, early0R, N);
+        for (int i = 0; i < N; i++) {
+            x0[i] += x1[i];
+        }
+        _ap4.process(x0, y2, N);
+        _ap5.process(y2, x0, N);
+        _mt5.process(x0, early1R, early2R, N);
+
+        for (int i = 0; i < N; i++) {
+            earlyOutR[i] = (y0[i] + y1[i] * _earlyMix1R + y2[i] * _earlyMix2R) * _earlyGain;
+        }
+    }
 
-        earlyOutR = (y0 + y1 * _earlyMix1R + y2 * _earlyMix2R) * _earlyGain;
+    float lateOut0[N], lateOut1[N], lateOut2[N], lateOut3[N];
+    for (int i = 0; i < N; i++) {
+        float x0, y0, y1, y2, y3;
 
         // LFO update
         int32_t lfoSin, lfoCos;
         _lfo.process(lfoSin, lfoCos);
 
         // Late
-        float lateOut0;
         _ap6.getOutput(x0);
         _ap7.process(x0, lfoSin, x0);
-        _eq0.process(-early0L + x0, x0);
-        _mt6.process(x0, y0, lateOut0);
+        _eq0.process(-early0L[i] + x0, x0);
+        _mt6.process(x0, y0, lateOut0[i]);
 
-        float lateOut1;
         _ap8.getOutput(x0);
         _ap9.process(x0, lfoCos, x0);
-        _eq1.process(-early0R + x0, x0);
-        _mt7.process(x0, y1, lateOut1);
+        _eq1.process(-early0R[i] + x0, x0);
+        _mt7.process(x0, y1, lateOut1[i]);
 
-        float lateOut2;
         _ap10.getOutput(x0);
-        _ap11.process(-early2L + x0, x0);
+        _ap11.process(-early2L[i] + x0, x0);
         _ap12.process(x0, x0);
-        _ap13.process(-early2L - x0, x0);
-        _mt8.process(-early0L + x0, x0, lateOut2);
+        _ap13.process(-early2L[i] - x0, x0);
+        _mt8.process(-early0L[i] + x0, x0, lateOut2[i]);
         _lp0.process(x0, y2);
 
-        float lateOut3;
         _ap14.getOutput(x0);
-        _ap15.process(-early2R + x0, x0);
+        _ap15.process(-early2R[i] + x0, x0);
         _ap16.process(x0, x0);
-        _ap17.process(-early2R - x0, x0);
-        _mt9.process(-early0R + x0, x0, lateOut3);
+        _ap17.process(-early2R[i] - x0, x0);
+        _mt9.process(-early0R[i] + x0, x0, lateOut3[i]);
         _lp1.process(x0, y3);
 
         // Feedback matrix
-        _ap6.process(early1L + y2 - y3, x0);
-        _ap8.process(early1R - y2 - y3, x0);
-        _ap10.process(-early2R + y0 + y1, x0);
-        _ap14.process(-early2L - y0 + y1, x0);
-
-        // Output Left
-        _ap18.process(-earlyOutL + lateOut0 + lateOut3, x0);
-        _ap19.process(x0, y0);
-
-        // Output Right
-        _ap20.process(-earlyOutR + lateOut1 + lateOut2, x1);
-        _ap21.process(x1, y1);
-
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        outputs[0][i] = x0 + (y0 - x0) * _wetDryMix;
-        outputs[1][i] = x1 + (y1 - x1) * _wetDryMix;
+        _ap6.process(early1L[i] + y2 - y3, x0);
+        _ap8.process(early1R[i] - y2 - y3, x0);
+        _ap10.process(-early2R[i] + y0 + y1, x0);
+        _ap14.process(-early2L[i] - y0 + y1, x0);
+    }
+
+    // Output Left
+    float wetL[N];
+    for (int i = 0; i < N; i++) {
+        wetL[i] = -earlyOutL[i] + lateOut0[i] + lateOut3[i];
+    }
+    _ap18.process(wetL, wetL, N);
+    _ap19.process(wetL, wetL, N);
+
+    // Output Right
+    float wetR[N];
+    for (int i = 0; i < N; i++) {
+        wetR[i] = -earlyOutR[i] + lateOut1[i] + lateOut2[i];
+    }
+    _ap20.process(wetR, wetR, N);
+    _ap21.process(wetR, wetR, N);
+
+    for (int i = 0; i < N; i++) {
+        float x0 = inputL[i];
+        float x1 = inputR[i];
+        outputL[i] = x0 + (wetL[i] - x0) * _wetDryMix;
+        outputR[i] = x1 + (wetR[i] - x1) * _wetDryMix;
+    }
+}
+
+void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
+
+    // full blocks use a fixed-size version, any remainder is processed a frame at a time
+    int i = 0;
+    for (; i < numFrames - (PROCESS_BLOCK - 1); i += PROCESS_BLOCK) {
+        processBlock<PROCESS_BLOCK>(&inputs[0][i], &inputs[1][i], &outputs[0][i], &outputs[1][i]);
+    }
+    for (; i < numFrames; i++) {
+        processBlock<1>(&inputs[0][i], &inputs[1][i], &outputs[0][i], &outputs[1][i]);
     }
 }
 
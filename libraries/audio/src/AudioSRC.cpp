@@ -389,7 +389,7 @@ int AudioSRC::multirateFilter2(const float* input0, const float* input1, float*
 }
 
 // convert int16_t to float, deinterleave stereo
-void AudioSRC::convertInput(const int16_t* input, float** outputs, int numFrames) {
+void AudioSRC::convertInput_SSE(const int16_t* input, float** outputs, int numFrames) {
     __m128 scale = _mm_set1_ps(1/32768.0f);
 
     if (_numChannels == 1) {
@@ -468,7 +468,7 @@ static inline __m128 dither4() {
 }
 
 // convert float to int16_t with dither, interleave stereo
-void AudioSRC::convertOutput(float** inputs, int16_t* output, int numFrames) {
+void AudioSRC::convertOutput_SSE(float** inputs, int16_t* output, int numFrames) {
     __m128 scale = _mm_set1_ps(32768.0f);
 
     if (_numChannels == 1) {
@@ -540,7 +540,7 @@ void AudioSRC::convertOutput(float** inputs, int16_t* output, int numFrames) {
 }
 
 // deinterleave stereo
-void AudioSRC::convertInput(const float* input, float** outputs, int numFrames) {
+void AudioSRC::convertInput_SSE(const float* input, float** outputs, int numFrames) {
 
     if (_numChannels == 1) {
 
@@ -566,7 +566,7 @@ void AudioSRC::convertInput(const float* input, float** outputs, int numFrames)
 }
 
 // interleave stereo
-void AudioSRC::convertOutput(float** inputs, float* output, int numFrames) {
+void AudioSRC::convertOutput_SSE(float** inputs, float* output, int numFrames) {
 
     if (_numChannels == 1) {
 
@@ -591,6 +591,69 @@ void AudioSRC::convertOutput(float** inputs, float* output, int numFrames) {
     }
 }
 
+// the conversions are overloaded, so each dispatch names the overload it picks
+using ConvertInputInt16 = void (AudioSRC::*)(const int16_t*, float**, int);
+using ConvertOutputInt16 = void (AudioSRC::*)(float**, int16_t*, int);
+using ConvertInputFloat = void (AudioSRC::*)(const float*, float**, int);
+using ConvertOutputFloat = void (AudioSRC::*)(float**, float*, int);
+
+void AudioSRC::convertInput(const int16_t* input, float** outputs, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? static_cast<ConvertInputInt16>(&AudioSRC::convertInput_AVX2) :
+                                        static_cast<ConvertInputInt16>(&AudioSRC::convertInput_SSE);
+    (this->*f)(input, outputs, numFrames);  // dispatch
+}
+
+void AudioSRC::convertOutput(float** inputs, int16_t* output, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? static_cast<ConvertOutputInt16>(&AudioSRC::convertOutput_AVX2) :
+                                        static_cast<ConvertOutputInt16>(&AudioSRC::convertOutput_SSE);
+    (this->*f)(inputs, output, numFrames);  // dispatch
+}
+
+void AudioSRC::convertInput(const float* input, float** outputs, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? static_cast<ConvertInputFloat>(&AudioSRC::convertInput_AVX2) :
+                                        static_cast<ConvertInputFloat>(&AudioSRC::convertInput_SSE);
+    (this->*f)(input, outputs, numFrames);  // dispatch
+}
+
+void AudioSRC::convertOutput(float** inputs, float* output, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? static_cast<ConvertOutputFloat>(&AudioSRC::convertOutput_AVX2) :
+                                        static_cast<ConvertOutputFloat>(&AudioSRC::convertOutput_SSE);
+    (this->*f)(inputs, output, numFrames);  // dispatch
+}
+
+//
+// on ARM architecture, NEON is used when the target has it
+//
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+int AudioSRC::multirateFilter1(const float* input0, float* output0, int inputFrames) {
+    return multirateFilter1_NEON(input0, output0, inputFrames);
+}
+
+int AudioSRC::multirateFilter2(const float* input0, const float* input1, float* output0, float* output1, int inputFrames) {
+    return multirateFilter2_NEON(input0, input1, output0, output1, inputFrames);
+}
+
+void AudioSRC::convertInput(const int16_t* input, float** outputs, int numFrames) {
+    convertInput_NEON(input, outputs, numFrames);
+}
+
+void AudioSRC::convertOutput(float** inputs, int16_t* output, int numFrames) {
+    convertOutput_NEON(inputs, output, numFrames);
+}
+
+void AudioSRC::convertInput(const float* input, float** outputs, int numFrames) {
+    convertInput_NEON(input, outputs, numFrames);
+}
+
+void AudioSRC::convertOutput(float** inputs, float* output, int numFrames) {
+    convertOutput_NEON(inputs, output, numFrames);
+}
+
 #else
 
 int AudioSRC::multirateFilter1(const float* input0, float* output0, int inputFrames) {
@@ -82,11 +82,29 @@ private:
     int multirateFilter1_AVX2(const float* input0, float* output0, int inputFrames);
     int multirateFilter2_AVX2(const float* input0, const float* input1, float* output0, float* output1, int inputFrames);
 
+    int multirateFilter1_NEON(const float* input0, float* output0, int inputFrames);
+    int multirateFilter2_NEON(const float* input0, const float* input1, float* output0, float* output1, int inputFrames);
+
     void convertInput(const int16_t* input, float** outputs, int numFrames);
     void convertOutput(float** inputs, int16_t* output, int numFrames);
 
     void convertInput(const float* input, float** outputs, int numFrames);
     void convertOutput(float** inputs, float* output, int numFrames);
+
+    void convertInput_SSE(const int16_t* input, float** outputs, int numFrames);
+    void convertOutput_SSE(float** inputs, int16_t* output, int numFrames);
+    void convertInput_SSE(const float* input, float** outputs, int numFrames);
+    void convertOutput_SSE(float** inputs, float* output, int numFrames);
+
+    void convertInput_AVX2(const int16_t* input, float** outputs, int numFrames);
+    void convertOutput_AVX2(float** inputs, int16_t* output, int numFrames);
+    void convertInput_AVX2(const float* input, float** outputs, int numFrames);
+    void convertOutput_AVX2(float** inputs, float* output, int numFrames);
+
+    void convertInput_NEON(const int16_t* input, float** outputs, int numFrames);
+    void convertOutput_NEON(float** inputs, int16_t* output, int numFrames);
+    void convertInput_NEON(const float* input, float** outputs, int numFrames);
+    void convertOutput_NEON(float** inputs, float* output, int numFrames);
 };
 
 #endif // AudioSRC_h
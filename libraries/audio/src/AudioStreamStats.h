@@ -32,6 +32,8 @@ public:
         _consecutiveNotMixedCount(0),
         _overflowCount(0),
         _framesDropped(0),
+        _framesTimeStretched(0),
+        _calculatedJitterBufferFrames(0),
         _packetStreamStats(),
         _packetStreamWindowStats()
     {}
@@ -53,6 +55,9 @@ public:
     quint32 _consecutiveNotMixedCount;
     quint32 _overflowCount;
     quint32 _framesDropped;
+    // the frames time-stretched out of the jitter buffer to bring it down, and the frames the jitter of the network calls for
+    quint32 _framesTimeStretched;
+    quint16 _calculatedJitterBufferFrames;
 
     PacketStreamStats _packetStreamStats;
     PacketStreamStats _packetStreamWindowStats;
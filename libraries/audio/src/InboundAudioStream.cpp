@@ -41,6 +41,10 @@ InboundAudioStream::InboundAudioStream(int numFrameSamples, int numFramesCapacit
     _stdevStatsForDesiredCalcOnTooManyStarves(),
     _calculatedJitterBufferFramesUsingStDev(0),
     _timeGapStatsForDesiredReduction(0, settings._windowSecondsForDesiredReduction),
+    _interArrivalHistogram(),
+    _calculatedJitterBufferFramesUsingHistogram(0),
+    _framesTimeStretched(0),
+    _packetsSinceTimeStretch(0),
     _starveHistoryWindowSeconds(settings._windowSecondsForDesiredCalcOnTooManyStarves),
     _starveHistory(STARVE_HISTORY_CAPACITY),
     _starveThreshold(settings._windowStarveThreshold),
@@ -48,6 +52,8 @@ InboundAudioStream::InboundAudioStream(int numFrameSamples, int numFramesCapacit
     _currentJitterBufferFrames(0),
     _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
     _repetitionWithFade(settings._repetitionWithFade),
+    _silentRunSamples(0),
+    _lastPacketWasSilentRun(false),
     _hasReverb(false)
 {
 }
@@ -58,6 +64,8 @@ void InboundAudioStream::reset() {
     _lastPopOutput = AudioRingBuffer::ConstIterator();
     _isStarved = true;
     _hasStarted = false;
+    _silentRunSamples = 0;
+    _lastPacketWasSilentRun = false;
     resetStats();
     // FIXME: calling cleanupCodec() seems to be the cause of the buzzsaw -- we get an assert
     // after this is called in AudioClient.  Ponder and fix...
@@ -77,6 +85,10 @@ void InboundAudioStream::resetStats() {
     _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
     _stdevStatsForDesiredCalcOnTooManyStarves = StDev();
     _timeGapStatsForDesiredReduction.reset();
+    _interArrivalHistogram.reset();
+    _calculatedJitterBufferFramesUsingHistogram = 0;
+    _framesTimeStretched = 0;
+    _packetsSinceTimeStretch = 0;
     _starveHistory.clear();
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
@@ -110,8 +122,6 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
                                                                                                        message.getSourceID());
     QString codecInPacket = message.readString();
 
-    packetReceivedUpdateTimingStats();
-
     int networkSamples;
     
     // parse the info after the seq number and before the audio data (the stream properties)
@@ -119,6 +129,15 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
     int propertyBytes = parseStreamProperties(message.getType(), message.readWithoutCopy(message.getBytesLeftToRead()), networkSamples);
     message.seek(prePropertyPosition + propertyBytes);
 
+    // the gap after a run of silent frames is as long as the run, and says nothing about network jitter
+    if (_lastPacketWasSilentRun) {
+        _lastPacketReceivedTime = usecTimestampNow();
+    } else {
+        bool skippedPackets = arrivalInfo._status == SequenceNumberStats::Early;
+        packetReceivedUpdateTimingStats(skippedPackets ? arrivalInfo._seqDiffFromExpected : 0);
+    }
+    _lastPacketWasSilentRun = message.getType() == PacketType::SilentAudioFrame && networkSamples > SILENT_RUN_FRAME_SAMPLES;
+
     // handle this packet based on its arrival status.
     switch (arrivalInfo._status) {
         case SequenceNumberStats::Early: {
@@ -126,7 +145,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
             // NOTE: we assume that each dropped packet contains the same number of samples
             // as the packet we just received.
             int packetsDropped = arrivalInfo._seqDiffFromExpected;
-            writeSamplesForDroppedPackets(packetsDropped * networkSamples);
+            writeSamplesForDroppedPackets(packetsDropped * std::min(networkSamples, SILENT_RUN_FRAME_SAMPLES));
 
             // fall through to OnTime case
         }
@@ -134,8 +153,13 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
             // Packet is on time; parse its data to the ringbuffer
             if (message.getType() == PacketType::SilentAudioFrame) {
                 // FIXME - Some codecs need to know about these silent frames... and can produce better output
-                writeDroppableSilentSamples(networkSamples);
+                // a run of silent frames only writes its first frame now, the rest is filled in as the buffer runs dry
+                int samplesToWrite = std::min(networkSamples, SILENT_RUN_FRAME_SAMPLES);
+                writeDroppableSilentSamples(samplesToWrite);
+                _silentRunSamples = networkSamples - samplesToWrite;
             } else {
+                _silentRunSamples = 0;
+
                 // note: PCM and no codec are identical
                 bool selectedPCM = _selectedCodecName == "pcm" || _selectedCodecName == "";
                 bool packetPCM = codecInPacket == "pcm" || codecInPacket == "";
@@ -174,6 +198,12 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
         _currentJitterBufferFrames = 0;
 
         _oldFramesDropped += framesToDrop;
+    } else if (_dynamicJitterBuffers && framesAvailable > _desiredJitterBufferFrames + DESIRED_JITTER_BUFFER_FRAMES_PADDING) {
+        // shrink toward the desired frames a little at a time instead of waiting for the threshold and dropping frames
+        if (++_packetsSinceTimeStretch >= TIME_STRETCH_PACKET_INTERVAL) {
+            timeStretchOldestFrame();
+            _packetsSinceTimeStretch = 0;
+        }
     }
 
     framesAvailableChanged();
@@ -181,6 +211,19 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
     return message.getPosition();
 }
 
+void InboundAudioStream::timeStretchOldestFrame() {
+    // the crossfade starts on the first sample of the oldest frame and ends on the last one of the next,
+    // so the frame played before and the one played after both still line up with it
+    int frameSamples = _ringBuffer.getNumFrameSamples();
+    for (int i = 0; i < frameSamples; ++i) {
+        float weight = (float)i / (float)frameSamples;
+        int16_t& sample = _ringBuffer[frameSamples + i];
+        sample = (int16_t)((1.0f - weight) * _ringBuffer[i] + weight * sample);
+    }
+    _ringBuffer.shiftReadPosition(frameSamples);
+    _framesTimeStretched++;
+}
+
 int InboundAudioStream::parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& numAudioSamples) {
     if (type == PacketType::SilentAudioFrame) {
         quint16 numSilentSamples = 0;
@@ -236,8 +279,20 @@ int InboundAudioStream::writeDroppableSilentSamples(int silentSamples) {
     return ret;
 }
 
+void InboundAudioStream::writeSilentRunSamples(int samplesNeeded) {
+    // the sender skipped these frames since they were silent, so stand in for them instead of starving
+    while (_silentRunSamples > 0 && _ringBuffer.samplesAvailable() < samplesNeeded) {
+        int samples = std::min(_silentRunSamples, SILENT_RUN_FRAME_SAMPLES);
+        _silentRunSamples -= samples;
+        writeDroppableSilentSamples(samples);
+    }
+}
+
 int InboundAudioStream::popSamples(int maxSamples, bool allOrNothing, bool starveIfNoSamplesPopped) {
     int samplesPopped = 0;
+    if (!_isStarved) {
+        writeSilentRunSamples(maxSamples);
+    }
     int samplesAvailable = _ringBuffer.samplesAvailable();
     if (_isStarved) {
         // we're still refilling; don't pop
@@ -267,6 +322,9 @@ int InboundAudioStream::popSamples(int maxSamples, bool allOrNothing, bool starv
 
 int InboundAudioStream::popFrames(int maxFrames, bool allOrNothing, bool starveIfNoFramesPopped) {
     int framesPopped = 0;
+    if (!_isStarved) {
+        writeSilentRunSamples(maxFrames * _ringBuffer.getNumFrameSamples());
+    }
     int framesAvailable = _ringBuffer.framesAvailable();
     if (_isStarved) {
         // we're still refilling; don't pop
@@ -323,7 +381,8 @@ void InboundAudioStream::setToStarved() {
     quint64 now = usecTimestampNow();
     _starveHistory.insert(now);
 
-    if (_dynamicJitterBuffers) {
+    // under Freddy's method the histogram already has the gap that starved us, once the late packet arrives
+    if (_dynamicJitterBuffers && _useStDevForJitterCalc) {
         // dynamic jitter buffers are enabled. check if this starve put us over the window
         // starve threshold
         quint64 windowEnd = now - _starveHistoryWindowSeconds * USECS_PER_SECOND;
@@ -341,17 +400,7 @@ void InboundAudioStream::setToStarved() {
         // this starve put us over the starve threshold. update _desiredJitterBufferFrames to
         // value determined by window A.
         if (starvesInWindow >= _starveThreshold) {
-            int calculatedJitterBufferFrames;
-            if (_useStDevForJitterCalc) {
-                calculatedJitterBufferFrames = _calculatedJitterBufferFramesUsingStDev;
-            } else {
-                // we don't know when the next packet will arrive, so it's possible the gap between the last packet and the
-                // next packet will exceed the max time gap in the window.  If the time since the last packet has already exceeded
-                // the window max gap, then we should use that value to calculate desired frames.
-                int framesSinceLastPacket = ceilf((float)(now - _lastPacketReceivedTime)
-                                                  / (float)AudioConstants::NETWORK_FRAME_USECS);
-                calculatedJitterBufferFrames = std::max(_calculatedJitterBufferFramesUsingMaxGap, framesSinceLastPacket);
-            }
+            int calculatedJitterBufferFrames = _calculatedJitterBufferFramesUsingStDev;
             // make sure _desiredJitterBufferFrames does not become lower here
             if (calculatedJitterBufferFrames >= _desiredJitterBufferFrames) {
                 _desiredJitterBufferFrames = calculatedJitterBufferFrames;
@@ -406,7 +455,7 @@ int InboundAudioStream::clampDesiredJitterBufferFramesValue(int desired) const {
     return glm::clamp(desired, MIN_FRAMES_DESIRED, MAX_FRAMES_DESIRED);
 }
 
-void InboundAudioStream::packetReceivedUpdateTimingStats() {
+void InboundAudioStream::packetReceivedUpdateTimingStats(int packetsLost) {
     
     // update our timegap stats and desired jitter buffer frames if necessary
     // discard the first few packets we receive since they usually have gaps that aren't represensative of normal jitter
@@ -420,6 +469,8 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
         _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
         _stdevStatsForDesiredCalcOnTooManyStarves.addValue(gap);
         _timeGapStatsForDesiredReduction.update(gap);
+        int interArrivalFrames = (int)roundf((float)gap / (float)AudioConstants::NETWORK_FRAME_USECS) - packetsLost;
+        _interArrivalHistogram.addInterArrival(interArrivalFrames);
 
         if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
             _calculatedJitterBufferFramesUsingMaxGap = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
@@ -436,7 +487,19 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
             _stdevStatsForDesiredCalcOnTooManyStarves.reset();
         }
 
-        if (_dynamicJitterBuffers) {
+        // the histogram needs a second or so of packets before its percentiles mean anything
+        const int MIN_ARRIVALS_FOR_HISTOGRAM = 100;
+        if (_interArrivalHistogram.getNumArrivals() >= MIN_ARRIVALS_FOR_HISTOGRAM) {
+            _calculatedJitterBufferFramesUsingHistogram =
+                _interArrivalHistogram.getFramesForPercentile(JITTER_BUFFER_TARGET_PERCENTILE);
+        }
+
+        if (_dynamicJitterBuffers && !_useStDevForJitterCalc) {
+            // the histogram forgets old gaps, so the desired frames come down as well as go up
+            if (_interArrivalHistogram.getNumArrivals() >= MIN_ARRIVALS_FOR_HISTOGRAM) {
+                _desiredJitterBufferFrames = clampDesiredJitterBufferFramesValue(std::max(_calculatedJitterBufferFramesUsingHistogram, 1));
+            }
+        } else if (_dynamicJitterBuffers) {
             // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
             // then reduce _desiredJitterBufferFrames to that number of frames.
             if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
@@ -496,6 +559,8 @@ AudioStreamStats InboundAudioStream::getAudioStreamStats() const {
     streamStats._consecutiveNotMixedCount = _consecutiveNotMixedCount;
     streamStats._overflowCount = _ringBuffer.getOverflowCount();
     streamStats._framesDropped = _silentFramesDropped + _oldFramesDropped;    // TODO: add separate stat for old frames dropped
+    streamStats._framesTimeStretched = _framesTimeStretched;
+    streamStats._calculatedJitterBufferFrames = getCalculatedJitterBufferFrames();
 
     streamStats._packetStreamStats = _incomingSequenceNumberStats.getStats();
     streamStats._packetStreamWindowStats = _incomingSequenceNumberStats.getStatsForHistoryWindow();
@@ -22,6 +22,7 @@
 #include <plugins/CodecPlugin.h>
 
 #include "AudioRingBuffer.h"
+#include "InterArrivalHistogram.h"
 #include "MovingMinMaxAvg.h"
 #include "SequenceNumberStats.h"
 #include "AudioStreamStats.h"
@@ -33,6 +34,12 @@
 // which could lead to a starve soon after.
 const int DESIRED_JITTER_BUFFER_FRAMES_PADDING = 1;
 
+// Under Freddy's method the desired frames are this percentile of the inter-arrival histogram of the stream
+const float JITTER_BUFFER_TARGET_PERCENTILE = 0.95f;
+
+// When the buffer holds more than the desired frames plus padding, one frame in this many packets is time-stretched away
+const int TIME_STRETCH_PACKET_INTERVAL = 4;
+
 // this controls the length of the window for stats used in the stats packet (not the stats used in
 // _desiredJitterBufferFrames calculation)
 const int STATS_FOR_STATS_PACKET_WINDOW_SECONDS = 30;
@@ -139,13 +146,15 @@ public:
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
     int getCalculatedJitterBufferFrames() const { return _useStDevForJitterCalc ?
-        _calculatedJitterBufferFramesUsingStDev : _calculatedJitterBufferFramesUsingMaxGap; };
+        _calculatedJitterBufferFramesUsingStDev : _calculatedJitterBufferFramesUsingHistogram; };
 
     /// returns the desired number of jitter buffer frames using Philip's method
     int getCalculatedJitterBufferFramesUsingStDev() const { return _calculatedJitterBufferFramesUsingStDev; }
 
     /// returns the desired number of jitter buffer frames using Freddy's method
     int getCalculatedJitterBufferFramesUsingMaxGap() const { return _calculatedJitterBufferFramesUsingMaxGap; }
+    /// returns the desired number of jitter buffer frames from the inter-arrival histogram
+    int getCalculatedJitterBufferFramesUsingHistogram() const { return _calculatedJitterBufferFramesUsingHistogram; }
     
     int getWindowSecondsForDesiredReduction() const {
         return _timeGapStatsForDesiredReduction.getWindowIntervals(); }
@@ -191,11 +200,17 @@ public slots:
     void perSecondCallbackForUpdatingStats();
 
 private:
-    void packetReceivedUpdateTimingStats();
+    /// packetsLost are the packets skipped right before this one, their frames aren't part of the gap since the last one
+    void packetReceivedUpdateTimingStats(int packetsLost);
+    /// crossfades the oldest frame into the one after it so both play in the time of one
+    void timeStretchOldestFrame();
     int clampDesiredJitterBufferFramesValue(int desired) const;
 
     int writeSamplesForDroppedPackets(int networkSamples);
 
+    /// fills in the frames of a silent run the sender skipped, until samplesNeeded are available or the run is used up
+    void writeSilentRunSamples(int samplesNeeded);
+
     void popSamplesNoCheck(int samples);
     void framesAvailableChanged();
 
@@ -258,6 +273,10 @@ protected:
     StDev _stdevStatsForDesiredCalcOnTooManyStarves;                        // for Philip's method
     int _calculatedJitterBufferFramesUsingStDev;                     // the most recent desired frames calculated by Philip's method
     MovingMinMaxAvg<quint64> _timeGapStatsForDesiredReduction;
+    InterArrivalHistogram _interArrivalHistogram;                    // takes the place of the max gaps in Freddy's method
+    int _calculatedJitterBufferFramesUsingHistogram;
+    int _framesTimeStretched;
+    int _packetsSinceTimeStretch;
 
     int _starveHistoryWindowSeconds;
     RingBufferHistory<quint64> _starveHistory;
@@ -272,6 +291,11 @@ protected:
     MovingMinMaxAvg<quint64> _timeGapStatsForStatsPacket;
 
     bool _repetitionWithFade;
+
+    // a silent packet with more than one stereo network frame of samples stands in for a run of silent frames
+    static const int SILENT_RUN_FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+    int _silentRunSamples;          // network samples of the current silent run not written yet
+    bool _lastPacketWasSilentRun;
     
     // Reverb properties
     bool _hasReverb;
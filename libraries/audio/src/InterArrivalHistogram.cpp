@@ -0,0 +1,46 @@
+//
+//  InterArrivalHistogram.cpp
+//  libraries/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "InterArrivalHistogram.h"
+
+#include <algorithm>
+
+// the weight of the arrivals halves in about 1000 packets, 10 seconds of audio
+static const float FORGET_FACTOR = 0.9993f;
+
+void InterArrivalHistogram::addInterArrival(int interArrivalFrames) {
+    for (auto& bin : _bins) {
+        bin *= FORGET_FACTOR;
+    }
+    _totalWeight *= FORGET_FACTOR;
+
+    _bins[std::min(std::max(interArrivalFrames, 0), NUM_BINS - 1)] += 1.0f;
+    _totalWeight += 1.0f;
+    ++_numArrivals;
+}
+
+int InterArrivalHistogram::getFramesForPercentile(float percentile) const {
+    float threshold = percentile * _totalWeight;
+    float weight = 0.0f;
+    for (int frames = 0; frames < NUM_BINS; ++frames) {
+        weight += _bins[frames];
+        if (weight >= threshold) {
+            return frames;
+        }
+    }
+    return NUM_BINS - 1;
+}
+
+void InterArrivalHistogram::reset() {
+    _bins.fill(0.0f);
+    _totalWeight = 0.0f;
+    _numArrivals = 0;
+}
@@ -0,0 +1,43 @@
+//
+//  InterArrivalHistogram.h
+//  libraries/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_InterArrivalHistogram_h
+#define hifi_InterArrivalHistogram_h
+
+#include <array>
+
+/// How many frames apart the packets of a stream arrive, as a histogram that forgets old arrivals a little with each new
+/// one. The jitter buffer a stream needs is a percentile of it: the buffer covers that fraction of the gaps.
+class InterArrivalHistogram {
+public:
+    static const int NUM_BINS = 64;
+
+    InterArrivalHistogram() { reset(); }
+
+    /// interArrivalFrames is the gap since the last packet less the frames of the packets lost in between
+    void addInterArrival(int interArrivalFrames);
+
+    /// The fewest frames that cover at least the given fraction of the weight of the histogram
+    int getFramesForPercentile(float percentile) const;
+
+    int getNumArrivals() const { return _numArrivals; }
+
+    void reset();
+
+private:
+    std::array<float, NUM_BINS> _bins;
+    float _totalWeight;
+    int _numArrivals;
+};
+
+#endif // hifi_InterArrivalHistogram_h
@@ -0,0 +1,121 @@
+//
+//  LockFreeAudioRingBuffer.cpp
+//  libraries/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LockFreeAudioRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+LockFreeAudioRingBuffer::LockFreeAudioRingBuffer(int numFrameSamples, int numFramesCapacity) :
+    _numFrameSamples(numFrameSamples),
+    _frameCapacity(numFramesCapacity),
+    _sampleCapacity(numFrameSamples * numFramesCapacity),
+    _bufferLength(numFrameSamples * numFramesCapacity + 1),
+    _buffer(new int16_t[numFrameSamples * numFramesCapacity + 1])
+{
+    memset(_buffer, 0, _bufferLength * sizeof(int16_t));
+}
+
+LockFreeAudioRingBuffer::~LockFreeAudioRingBuffer() {
+    delete[] _buffer;
+}
+
+int LockFreeAudioRingBuffer::shiftedIndex(int index, int numSamples) const {
+    index += numSamples;
+    return (index >= _bufferLength) ? index - _bufferLength : index;
+}
+
+int LockFreeAudioRingBuffer::distance(int readIndex, int writeIndex) const {
+    int sampleDifference = writeIndex - readIndex;
+    return (sampleDifference < 0) ? sampleDifference + _bufferLength : sampleDifference;
+}
+
+void LockFreeAudioRingBuffer::copyIn(int index, const int16_t* source, int numSamples) {
+    int numSamplesToEnd = std::min(numSamples, _bufferLength - index);
+    if (source) {
+        memcpy(_buffer + index, source, numSamplesToEnd * sizeof(int16_t));
+        memcpy(_buffer, source + numSamplesToEnd, (numSamples - numSamplesToEnd) * sizeof(int16_t));
+    } else {
+        memset(_buffer + index, 0, numSamplesToEnd * sizeof(int16_t));
+        memset(_buffer, 0, (numSamples - numSamplesToEnd) * sizeof(int16_t));
+    }
+}
+
+void LockFreeAudioRingBuffer::copyOut(int index, int16_t* destination, int numSamples) const {
+    int numSamplesToEnd = std::min(numSamples, _bufferLength - index);
+    memcpy(destination, _buffer + index, numSamplesToEnd * sizeof(int16_t));
+    memcpy(destination + numSamplesToEnd, _buffer, (numSamples - numSamplesToEnd) * sizeof(int16_t));
+}
+
+int LockFreeAudioRingBuffer::writeSamples(const int16_t* source, int maxSamples) {
+    int writeIndex = _writeIndex.load(std::memory_order_relaxed);
+    // acquire so the reader is done with the samples it has given back before they are overwritten
+    int readIndex = _readIndex.load(std::memory_order_acquire);
+
+    int samplesRoomFor = _sampleCapacity - distance(readIndex, writeIndex);
+    int numWriteSamples = std::min(maxSamples, samplesRoomFor);
+    if (numWriteSamples < maxSamples) {
+        _overflowCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    copyIn(writeIndex, source, numWriteSamples);
+
+    // release so the reader sees the samples before it sees the new index
+    _writeIndex.store(shiftedIndex(writeIndex, numWriteSamples), std::memory_order_release);
+
+    return numWriteSamples;
+}
+
+int LockFreeAudioRingBuffer::writeData(const char* source, int maxSize) {
+    return writeSamples(reinterpret_cast<const int16_t*>(source), maxSize / sizeof(int16_t)) * sizeof(int16_t);
+}
+
+int LockFreeAudioRingBuffer::addSilentSamples(int maxSamples) {
+    return writeSamples(nullptr, maxSamples);
+}
+
+int LockFreeAudioRingBuffer::readSamples(int16_t* destination, int maxSamples) {
+    int readIndex = _readIndex.load(std::memory_order_relaxed);
+    int writeIndex = _writeIndex.load(std::memory_order_acquire);
+
+    int numReadSamples = std::min(maxSamples, distance(readIndex, writeIndex));
+    copyOut(readIndex, destination, numReadSamples);
+
+    _readIndex.store(shiftedIndex(readIndex, numReadSamples), std::memory_order_release);
+
+    return numReadSamples;
+}
+
+int LockFreeAudioRingBuffer::readData(char* destination, int maxSize) {
+    return readSamples(reinterpret_cast<int16_t*>(destination), maxSize / sizeof(int16_t)) * sizeof(int16_t);
+}
+
+void LockFreeAudioRingBuffer::shiftReadPosition(int numSamples) {
+    int readIndex = _readIndex.load(std::memory_order_relaxed);
+    int writeIndex = _writeIndex.load(std::memory_order_acquire);
+
+    numSamples = std::min(numSamples, distance(readIndex, writeIndex));
+    _readIndex.store(shiftedIndex(readIndex, numSamples), std::memory_order_release);
+}
+
+void LockFreeAudioRingBuffer::clear() {
+    _readIndex.store(_writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+AudioRingBuffer::ConstIterator LockFreeAudioRingBuffer::nextOutput() const {
+    return AudioRingBuffer::ConstIterator(_buffer, _bufferLength, _buffer + _readIndex.load(std::memory_order_acquire));
+}
+
+int LockFreeAudioRingBuffer::samplesAvailable() const {
+    int readIndex = _readIndex.load(std::memory_order_acquire);
+    int writeIndex = _writeIndex.load(std::memory_order_acquire);
+    return distance(readIndex, writeIndex);
+}
@@ -0,0 +1,103 @@
+//
+//  LockFreeAudioRingBuffer.h
+//  libraries/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_LockFreeAudioRingBuffer_h
+#define hifi_LockFreeAudioRingBuffer_h
+
+#include <atomic>
+
+#include "AudioRingBuffer.h"
+
+/// A ring buffer of samples shared by exactly one writing thread and one reading thread, without locks.
+/// Unlike AudioRingBuffer, a write never moves the read position - samples that don't fit are dropped instead.
+class LockFreeAudioRingBuffer {
+public:
+    LockFreeAudioRingBuffer(int numFrameSamples, int numFramesCapacity = DEFAULT_RING_BUFFER_FRAME_CAPACITY);
+    ~LockFreeAudioRingBuffer();
+
+    // disallow copying
+    LockFreeAudioRingBuffer(const LockFreeAudioRingBuffer&) = delete;
+    LockFreeAudioRingBuffer(LockFreeAudioRingBuffer&&) = delete;
+    LockFreeAudioRingBuffer& operator=(const LockFreeAudioRingBuffer&) = delete;
+
+    // writer thread
+
+    /// Write up to maxSamples from source (will only write up to the room left in the buffer)
+    /// Returns number of written samples
+    int writeSamples(const int16_t* source, int maxSamples);
+
+    /// Write up to maxSize from source
+    /// Returns number of written bytes
+    int writeData(const char* source, int maxSize);
+
+    /// Write up to maxSamples silent samples (will only write up to the room left in the buffer)
+    /// Returns number of written silent samples
+    int addSilentSamples(int maxSamples);
+
+    // reader thread
+
+    /// Read up to maxSamples into destination (will only read up to samplesAvailable())
+    /// Returns number of read samples
+    int readSamples(int16_t* destination, int maxSamples);
+
+    /// Read up to maxSize into destination
+    /// Returns number of read bytes
+    int readData(char* destination, int maxSize);
+
+    /// Discards up to numSamples from the buffer
+    void shiftReadPosition(int numSamples);
+
+    /// Discards everything written so far
+    void clear();
+
+    /// Iterator at the next sample to read, valid until the reader shifts past it
+    AudioRingBuffer::ConstIterator nextOutput() const;
+
+    // either thread
+
+    int samplesAvailable() const;
+    int framesAvailable() const { return (_numFrameSamples == 0) ? 0 : samplesAvailable() / _numFrameSamples; }
+
+    int getNumFrameSamples() const { return _numFrameSamples; }
+    int getFrameCapacity() const { return _frameCapacity; }
+    int getSampleCapacity() const { return _sampleCapacity; }
+    /// Return times a write did not fit and had samples dropped
+    int getOverflowCount() const { return _overflowCount.load(std::memory_order_relaxed); }
+
+private:
+    static const int CACHE_LINE_SIZE = 64;
+
+    int shiftedIndex(int index, int numSamples) const;
+    int distance(int readIndex, int writeIndex) const;
+
+    // copies between the ring at index and data, in two parts if it wraps
+    void copyIn(int index, const int16_t* source, int numSamples);
+    void copyOut(int index, int16_t* destination, int numSamples) const;
+
+    const int _numFrameSamples;
+    const int _frameCapacity;
+    const int _sampleCapacity;
+    const int _bufferLength; // actual _buffer length (_sampleCapacity + 1)
+    int16_t* const _buffer;
+
+    // each index is only written by one side, and sits on its own cache line so the two sides don't false share
+    char _leadingPadding[CACHE_LINE_SIZE];
+    std::atomic<int> _writeIndex { 0 };
+    char _writePadding[CACHE_LINE_SIZE - sizeof(std::atomic<int>)];
+    std::atomic<int> _readIndex { 0 };
+    char _readPadding[CACHE_LINE_SIZE - sizeof(std::atomic<int>)];
+
+    std::atomic<int> _overflowCount { 0 };
+};
+
+#endif // hifi_LockFreeAudioRingBuffer_h
@@ -78,6 +78,9 @@ void Sound::downloadFinished(const QByteArray& data) {
         qCDebug(audio) << "Unknown sound file type";
     }
 
+    // the unused sounds a SoundCache keeps are budgeted by what they hold once they are decoded
+    setSize(_byteArray.size());
+
     finishedLoading(true);
 
     _isReady = true;
@@ -100,7 +103,7 @@ void Sound::downSample(const QByteArray& rawAudioByteArray) {
     int maxDestinationBytes = maxDestinationFrames * numChannels * sizeof(AudioConstants::AudioSample);
     _byteArray.resize(maxDestinationBytes);
 
-    int numDestinationFrames = resampler.render((int16_t*)rawAudioByteArray.data(), 
+    int numDestinationFrames = resampler.render((const int16_t*)rawAudioByteArray.constData(),
                                                 (int16_t*)_byteArray.data(), 
                                                 numSourceFrames);
 
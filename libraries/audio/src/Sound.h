@@ -29,6 +29,8 @@ public:
     float getDuration() const { return _duration; }
 
  
+    // The samples are decoded and resampled once per sound and shared by everything that plays it, so they must only
+    // be read through constData() - anything that writes to them, or calls data(), gets a copy of its own instead.
     const QByteArray& getByteArray() const { return _byteArray; }
 
 signals:
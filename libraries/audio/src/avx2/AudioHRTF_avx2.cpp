@@ -0,0 +1,182 @@
+//
+//  AudioHRTF_avx2.cpp
+//  libraries/audio/src/avx2
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../AudioHRTF.h"
+
+#ifndef __AVX2__
+#error Must be compiled with /arch:AVX2 or -mavx2 -mfma.
+#endif
+
+// 1 channel input, 4 channel output
+void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        assert(HRTF_TAPS % 4 == 0);
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            __m256 x0 = _mm256_loadu_ps(&ps[k+0]);
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef0[-k-0]), x0, acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef1[-k-0]), x0, acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef2[-k-0]), x0, acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef3[-k-0]), x0, acc3);
+
+            __m256 x1 = _mm256_loadu_ps(&ps[k+1]);
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef0[-k-1]), x1, acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef1[-k-1]), x1, acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef2[-k-1]), x1, acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef3[-k-1]), x1, acc3);
+
+            __m256 x2 = _mm256_loadu_ps(&ps[k+2]);
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef0[-k-2]), x2, acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef1[-k-2]), x2, acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef2[-k-2]), x2, acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef3[-k-2]), x2, acc3);
+
+            __m256 x3 = _mm256_loadu_ps(&ps[k+3]);
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef0[-k-3]), x3, acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef1[-k-3]), x3, acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef2[-k-3]), x3, acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_broadcast_ss(&coef3[-k-3]), x3, acc3);
+        }
+
+        _mm256_storeu_ps(&dst0[i], acc0);
+        _mm256_storeu_ps(&dst1[i], acc1);
+        _mm256_storeu_ps(&dst2[i], acc2);
+        _mm256_storeu_ps(&dst3[i], acc3);
+    }
+
+    _mm256_zeroupper();
+}
+
+// 4 channel planar to interleaved
+void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 x0 = _mm256_loadu_ps(&src0[i]);
+        __m256 x1 = _mm256_loadu_ps(&src1[i]);
+        __m256 x2 = _mm256_loadu_ps(&src2[i]);
+        __m256 x3 = _mm256_loadu_ps(&src3[i]);
+
+        // interleave (4x4 matrix transpose, in each 128-bit lane)
+        __m256 t0 = _mm256_unpacklo_ps(x0, x1);
+        __m256 t1 = _mm256_unpackhi_ps(x0, x1);
+        __m256 t2 = _mm256_unpacklo_ps(x2, x3);
+        __m256 t3 = _mm256_unpackhi_ps(x2, x3);
+
+        x0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1,0,1,0));   // frames 0,4
+        x1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3,2,3,2));   // frames 1,5
+        x2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1,0,1,0));   // frames 2,6
+        x3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3,2,3,2));   // frames 3,7
+
+        // put the frames back in order across lanes
+        _mm256_storeu_ps(&dst[4*i+0], _mm256_permute2f128_ps(x0, x1, 0x20));
+        _mm256_storeu_ps(&dst[4*i+8], _mm256_permute2f128_ps(x2, x3, 0x20));
+        _mm256_storeu_ps(&dst[4*i+16], _mm256_permute2f128_ps(x0, x1, 0x31));
+        _mm256_storeu_ps(&dst[4*i+24], _mm256_permute2f128_ps(x2, x3, 0x31));
+    }
+
+    _mm256_zeroupper();
+}
+
+// crossfade 4 inputs into 2 outputs with accumulation (interleaved)
+void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames) {
+
+    assert(numFrames % 8 == 0);
+
+    const __m256i idx0 = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const __m256i idx1 = _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3);
+    const __m256i idx2 = _mm256_setr_epi32(4, 4, 4, 4, 5, 5, 5, 5);
+    const __m256i idx3 = _mm256_setr_epi32(6, 6, 6, 6, 7, 7, 7, 7);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 w = _mm256_loadu_ps(&win[i]);
+
+        // two frames of { L0, R0, L1, R1 } each
+        __m256 x0 = _mm256_loadu_ps(&src[4*i+0]);
+        __m256 x1 = _mm256_loadu_ps(&src[4*i+8]);
+        __m256 x2 = _mm256_loadu_ps(&src[4*i+16]);
+        __m256 x3 = _mm256_loadu_ps(&src[4*i+24]);
+
+        // new filter output, in the low half of each frame
+        __m256 n0 = _mm256_permute_ps(x0, _MM_SHUFFLE(1,0,3,2));
+        __m256 n1 = _mm256_permute_ps(x1, _MM_SHUFFLE(1,0,3,2));
+        __m256 n2 = _mm256_permute_ps(x2, _MM_SHUFFLE(1,0,3,2));
+        __m256 n3 = _mm256_permute_ps(x3, _MM_SHUFFLE(1,0,3,2));
+
+        // crossfade, valid in the low half of each frame
+        x0 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(w, idx0), _mm256_sub_ps(x0, n0), n0);
+        x1 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(w, idx1), _mm256_sub_ps(x1, n1), n1);
+        x2 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(w, idx2), _mm256_sub_ps(x2, n2), n2);
+        x3 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(w, idx3), _mm256_sub_ps(x3, n3), n3);
+
+        // gather the stereo frames, as frames { 0,2,1,3 } and { 4,6,5,7 }
+        x0 = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(1,0,1,0));
+        x2 = _mm256_shuffle_ps(x2, x3, _MM_SHUFFLE(1,0,1,0));
+
+        // and reorder them
+        x0 = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(x0), _MM_SHUFFLE(3,1,2,0)));
+        x2 = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(x2), _MM_SHUFFLE(3,1,2,0)));
+
+        // accumulate
+        _mm256_storeu_ps(&dst[2*i+0], _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+0]), x0));
+        _mm256_storeu_ps(&dst[2*i+8], _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+8]), x2));
+    }
+
+    _mm256_zeroupper();
+}
+
+// linear interpolation with gain
+void interpolate_AVX2(float* dst, const float* src0, const float* src1, float frac, float gain) {
+
+    __m256 f0 = _mm256_set1_ps(HRTF_GAIN * gain * (1.0f - frac));
+    __m256 f1 = _mm256_set1_ps(HRTF_GAIN * gain * frac);
+
+    assert(HRTF_TAPS % 8 == 0);
+
+    for (int k = 0; k < HRTF_TAPS; k += 8) {
+
+        __m256 x0 = _mm256_loadu_ps(&src0[k]);
+        __m256 x1 = _mm256_loadu_ps(&src1[k]);
+
+        x0 = _mm256_fmadd_ps(f1, x1, _mm256_mul_ps(f0, x0));
+
+        _mm256_storeu_ps(&dst[k], x0);
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -0,0 +1,158 @@
+//
+//  AudioLimiter_avx2.cpp
+//  libraries/audio/src/avx2
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <assert.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#ifndef __AVX2__
+#error Must be compiled with /arch:AVX2 or -mavx2 -mfma.
+#endif
+
+// these must match the reference code in AudioLimiter.cpp
+static const int LOG2_FRACBITS = 26;
+static const int LOG2_HEADROOM = 15;
+static const int LOG2_TABBITS = 4;
+static const int IEEE754_FABS_MASK = 0x7fffffff;
+static const int IEEE754_MANT_BITS = 23;
+static const int IEEE754_EXPN_BIAS = 127;
+
+// signed (a * b) >> 32, for each 32-bit lane
+static inline __m256i mulhi_epi32(__m256i a, __m256i b) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 32);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+// -log2(x) of 8 absolute peaks, as float bits
+static inline __m256i log2_8(__m256i peak, const int32_t table[][3]) {
+
+    // split into e and x - 1.0
+    __m256i e = _mm256_sub_epi32(_mm256_set1_epi32(IEEE754_EXPN_BIAS + LOG2_HEADROOM), _mm256_srli_epi32(peak, IEEE754_MANT_BITS));
+    __m256i x = _mm256_and_si256(_mm256_slli_epi32(peak, 31 - IEEE754_MANT_BITS), _mm256_set1_epi32(0x7fffffff));
+
+    // table index, times 3
+    __m256i k = _mm256_srli_epi32(x, 31 - LOG2_TABBITS);
+    k = _mm256_add_epi32(k, _mm256_add_epi32(k, k));
+
+    // polynomial for log2(1+x) over x=[0,1]
+    __m256i c0 = _mm256_i32gather_epi32((const int*)&table[0][0], k, 4);
+    __m256i c1 = _mm256_i32gather_epi32((const int*)&table[0][1], k, 4);
+    __m256i c2 = _mm256_i32gather_epi32((const int*)&table[0][2], k, 4);
+
+    c1 = _mm256_add_epi32(c1, mulhi_epi32(c0, x));
+    c2 = _mm256_add_epi32(c2, mulhi_epi32(c1, x));
+
+    // reconstruct result in Q26
+    __m256i r = _mm256_sub_epi32(_mm256_slli_epi32(e, LOG2_FRACBITS), _mm256_srai_epi32(c2, 3));
+
+    // saturate
+    __m256i saturate = _mm256_cmpgt_epi32(e, _mm256_set1_epi32(31));
+    return _mm256_blendv_epi8(r, _mm256_set1_epi32(0x7fffffff), saturate);
+}
+
+// peak detect and -log2(x) for a block of input (mono)
+void peaklog2_mono_AVX2(float* input, int32_t* output, const int32_t table[][3], int numFrames) {
+
+    assert(numFrames % 8 == 0);
+
+    const __m256i mask = _mm256_set1_epi32(IEEE754_FABS_MASK);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        // absolute value
+        __m256i peak = _mm256_and_si256(_mm256_loadu_si256((__m256i*)&input[i]), mask);
+
+        _mm256_storeu_si256((__m256i*)&output[i], log2_8(peak, table));
+    }
+
+    _mm256_zeroupper();
+}
+
+// peak detect and -log2(x) for a block of input (stereo)
+void peaklog2_stereo_AVX2(float* input, int32_t* output, const int32_t table[][3], int numFrames) {
+
+    assert(numFrames % 8 == 0);
+
+    const __m256i mask = _mm256_set1_epi32(IEEE754_FABS_MASK);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 x0 = _mm256_loadu_ps(&input[2*i+0]);
+        __m256 x1 = _mm256_loadu_ps(&input[2*i+8]);
+
+        // deinterleave, as frames { 0,1,4,5,2,3,6,7 }
+        __m256i u0 = _mm256_castps_si256(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2,0,2,0)));
+        __m256i u1 = _mm256_castps_si256(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3,1,3,1)));
+
+        // max absolute value
+        __m256i peak = _mm256_max_epi32(_mm256_and_si256(u0, mask), _mm256_and_si256(u1, mask));
+
+        // and reorder
+        peak = _mm256_permute4x64_epi64(peak, _MM_SHUFFLE(3,1,2,0));
+
+        _mm256_storeu_si256((__m256i*)&output[i], log2_8(peak, table));
+    }
+
+    _mm256_zeroupper();
+}
+
+// apply gain and dither, then store 16-bit output (mono)
+void applyGain_mono_AVX2(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        // fused, so the result can differ from the reference code by 1 LSB
+        __m256 x = _mm256_fmadd_ps(_mm256_loadu_ps(&input[i]), _mm256_loadu_ps(&gain[i]), _mm256_loadu_ps(&dither[i]));
+
+        // convert using round-to-nearest, and pack to 16-bit
+        __m256i r = _mm256_cvtps_epi32(x);
+        r = _mm256_permute4x64_epi64(_mm256_packs_epi32(r, r), _MM_SHUFFLE(3,1,2,0));
+
+        _mm_storeu_si128((__m128i*)&output[i], _mm256_castsi256_si128(r));
+    }
+
+    _mm256_zeroupper();
+}
+
+// apply gain and dither, then store 16-bit output (stereo)
+void applyGain_stereo_AVX2(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+
+    assert(numFrames % 8 == 0);
+
+    const __m256i idx0 = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i idx1 = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 g = _mm256_loadu_ps(&gain[i]);
+        __m256 d = _mm256_loadu_ps(&dither[i]);
+
+        // each gain and dither is shared by both channels of a frame
+        // fused, so the result can differ from the reference code by 1 LSB
+        __m256 x0 = _mm256_fmadd_ps(_mm256_loadu_ps(&input[2*i+0]), _mm256_permutevar8x32_ps(g, idx0), _mm256_permutevar8x32_ps(d, idx0));
+        __m256 x1 = _mm256_fmadd_ps(_mm256_loadu_ps(&input[2*i+8]), _mm256_permutevar8x32_ps(g, idx1), _mm256_permutevar8x32_ps(d, idx1));
+
+        // convert using round-to-nearest, and pack to 16-bit
+        __m256i r = _mm256_packs_epi32(_mm256_cvtps_epi32(x0), _mm256_cvtps_epi32(x1));
+        r = _mm256_permute4x64_epi64(r, _MM_SHUFFLE(3,1,2,0));
+
+        _mm256_storeu_si256((__m256i*)&output[2*i], r);
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -198,4 +198,173 @@ int AudioSRC::multirateFilter2_AVX2(const float* input0, const float* input1, fl
     return outputFrames;
 }
 
+// convert int16_t to float, deinterleave stereo
+void AudioSRC::convertInput_AVX2(const int16_t* input, float** outputs, int numFrames) {
+    __m256 scale = _mm256_set1_ps(1/32768.0f);
+
+    int i = 0;
+    if (_numChannels == 1) {
+
+        for (; i < numFrames - 7; i += 8) {
+            __m256i a0 = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)&input[i]));
+
+            __m256 f0 = _mm256_mul_ps(_mm256_cvtepi32_ps(a0), scale);
+
+            _mm256_storeu_ps(&outputs[0][i], f0);
+        }
+
+    } else if (_numChannels == 2) {
+
+        for (; i < numFrames - 7; i += 8) {
+            __m256i a0 = _mm256_loadu_si256((__m256i*)&input[2*i]);
+            __m256i a1 = a0;
+
+            // deinterleave and sign-extend
+            a0 = _mm256_madd_epi16(a0, _mm256_set1_epi32(0x00000001));
+            a1 = _mm256_madd_epi16(a1, _mm256_set1_epi32(0x00010000));
+
+            __m256 f0 = _mm256_mul_ps(_mm256_cvtepi32_ps(a0), scale);
+            __m256 f1 = _mm256_mul_ps(_mm256_cvtepi32_ps(a1), scale);
+
+            _mm256_storeu_ps(&outputs[0][i], f0);
+            _mm256_storeu_ps(&outputs[1][i], f1);
+        }
+    }
+    _mm256_zeroupper();
+
+    // remaining frames
+    if (i < numFrames) {
+        float* tails[2] = { outputs[0] + i, outputs[1] + i };
+        convertInput_SSE(&input[_numChannels*i], tails, numFrames - i);
+    }
+}
+
+// fast TPDF dither in [-1.0f, 1.0f]
+static inline __m256 dither8() {
+    static __m256i rz;
+
+    // update the 16 different maximum-length LCGs
+    rz = _mm256_mullo_epi16(rz, _mm256_set_epi16(31269, 12345, 22221, 9821, 16385, 28629, 5237, 18681,
+                                                 25173, -25511, -5975, -23279, 19445, -27591, 30185, -3495));
+    rz = _mm256_add_epi16(rz, _mm256_set_epi16(7919, 1013, 26371, 3517, 19289, 11093, 30011, 6427,
+                                               13849, -32767, 105, -19675, -7701, -32679, -13225, 28013));
+
+    // promote to 32-bit
+    __m256i r0 = _mm256_unpacklo_epi16(rz, _mm256_setzero_si256());
+    __m256i r1 = _mm256_unpackhi_epi16(rz, _mm256_setzero_si256());
+
+    // return (r0 - r1) * (1/65536.0f);
+    __m256 d0 = _mm256_cvtepi32_ps(_mm256_sub_epi32(r0, r1));
+    return _mm256_mul_ps(d0, _mm256_set1_ps(1/65536.0f));
+}
+
+// convert float to int16_t with dither, interleave stereo
+void AudioSRC::convertOutput_AVX2(float** inputs, int16_t* output, int numFrames) {
+    __m256 scale = _mm256_set1_ps(32768.0f);
+
+    int i = 0;
+    if (_numChannels == 1) {
+
+        for (; i < numFrames - 7; i += 8) {
+            __m256 f0 = _mm256_mul_ps(_mm256_loadu_ps(&inputs[0][i]), scale);
+
+            f0 = _mm256_add_ps(f0, dither8());
+
+            // round and saturate
+            __m256i a0 = _mm256_cvtps_epi32(f0);
+            __m128i b0 = _mm_packs_epi32(_mm256_castsi256_si128(a0), _mm256_extracti128_si256(a0, 1));
+
+            _mm_storeu_si128((__m128i*)&output[i], b0);
+        }
+
+    } else if (_numChannels == 2) {
+
+        for (; i < numFrames - 7; i += 8) {
+            __m256 f0 = _mm256_mul_ps(_mm256_loadu_ps(&inputs[0][i]), scale);
+            __m256 f1 = _mm256_mul_ps(_mm256_loadu_ps(&inputs[1][i]), scale);
+
+            __m256 d0 = dither8();
+            f0 = _mm256_add_ps(f0, d0);
+            f1 = _mm256_add_ps(f1, d0);
+
+            // round and saturate
+            __m256i a0 = _mm256_cvtps_epi32(f0);
+            __m256i a1 = _mm256_cvtps_epi32(f1);
+            __m128i b0 = _mm_packs_epi32(_mm256_castsi256_si128(a0), _mm256_extracti128_si256(a0, 1));
+            __m128i b1 = _mm_packs_epi32(_mm256_castsi256_si128(a1), _mm256_extracti128_si256(a1, 1));
+
+            // interleave
+            _mm_storeu_si128((__m128i*)&output[2*i + 0], _mm_unpacklo_epi16(b0, b1));
+            _mm_storeu_si128((__m128i*)&output[2*i + 8], _mm_unpackhi_epi16(b0, b1));
+        }
+    }
+    _mm256_zeroupper();
+
+    // remaining frames
+    if (i < numFrames) {
+        float* tails[2] = { inputs[0] + i, inputs[1] + i };
+        convertOutput_SSE(tails, &output[_numChannels*i], numFrames - i);
+    }
+}
+
+// deinterleave stereo
+void AudioSRC::convertInput_AVX2(const float* input, float** outputs, int numFrames) {
+
+    if (_numChannels != 2) {
+        convertInput_SSE(input, outputs, numFrames);
+        return;
+    }
+
+    int i = 0;
+    for (; i < numFrames - 7; i += 8) {
+        __m256 f0 = _mm256_loadu_ps(&input[2*i + 0]);
+        __m256 f1 = _mm256_loadu_ps(&input[2*i + 8]);
+
+        // deinterleave, within each lane then across them
+        __m256 x0 = _mm256_shuffle_ps(f0, f1, _MM_SHUFFLE(2,0,2,0));
+        __m256 x1 = _mm256_shuffle_ps(f0, f1, _MM_SHUFFLE(3,1,3,1));
+        x0 = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(x0), _MM_SHUFFLE(3,1,2,0)));
+        x1 = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(x1), _MM_SHUFFLE(3,1,2,0)));
+
+        _mm256_storeu_ps(&outputs[0][i], x0);
+        _mm256_storeu_ps(&outputs[1][i], x1);
+    }
+    _mm256_zeroupper();
+
+    // remaining frames
+    if (i < numFrames) {
+        float* tails[2] = { outputs[0] + i, outputs[1] + i };
+        convertInput_SSE(&input[2*i], tails, numFrames - i);
+    }
+}
+
+// interleave stereo
+void AudioSRC::convertOutput_AVX2(float** inputs, float* output, int numFrames) {
+
+    if (_numChannels != 2) {
+        convertOutput_SSE(inputs, output, numFrames);
+        return;
+    }
+
+    int i = 0;
+    for (; i < numFrames - 7; i += 8) {
+        __m256 f0 = _mm256_loadu_ps(&inputs[0][i]);
+        __m256 f1 = _mm256_loadu_ps(&inputs[1][i]);
+
+        // interleave, within each lane then across them
+        __m256 x0 = _mm256_unpacklo_ps(f0, f1);
+        __m256 x1 = _mm256_unpackhi_ps(f0, f1);
+
+        _mm256_storeu_ps(&output[2*i + 0], _mm256_permute2f128_ps(x0, x1, 0x20));
+        _mm256_storeu_ps(&output[2*i + 8], _mm256_permute2f128_ps(x0, x1, 0x31));
+    }
+    _mm256_zeroupper();
+
+    // remaining frames
+    if (i < numFrames) {
+        float* tails[2] = { inputs[0] + i, inputs[1] + i };
+        convertOutput_SSE(tails, &output[2*i], numFrames - i);
+    }
+}
+
 #endif
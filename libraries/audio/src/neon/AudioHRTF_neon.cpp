@@ -0,0 +1,192 @@
+//
+//  AudioHRTF_neon.cpp
+//  libraries/audio/src/neon
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <assert.h>
+#include <arm_neon.h>
+
+#include "../AudioHRTF.h"
+
+// 1 channel input, 4 channel output
+void FIR_1x4_NEON(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        float32x4_t acc2 = vdupq_n_f32(0.0f);
+        float32x4_t acc3 = vdupq_n_f32(0.0f);
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        assert(HRTF_TAPS % 4 == 0);
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            float32x4_t x0 = vld1q_f32(&ps[k+0]);
+            acc0 = vmlaq_n_f32(acc0, x0, coef0[-k-0]);
+            acc1 = vmlaq_n_f32(acc1, x0, coef1[-k-0]);
+            acc2 = vmlaq_n_f32(acc2, x0, coef2[-k-0]);
+            acc3 = vmlaq_n_f32(acc3, x0, coef3[-k-0]);
+
+            float32x4_t x1 = vld1q_f32(&ps[k+1]);
+            acc0 = vmlaq_n_f32(acc0, x1, coef0[-k-1]);
+            acc1 = vmlaq_n_f32(acc1, x1, coef1[-k-1]);
+            acc2 = vmlaq_n_f32(acc2, x1, coef2[-k-1]);
+            acc3 = vmlaq_n_f32(acc3, x1, coef3[-k-1]);
+
+            float32x4_t x2 = vld1q_f32(&ps[k+2]);
+            acc0 = vmlaq_n_f32(acc0, x2, coef0[-k-2]);
+            acc1 = vmlaq_n_f32(acc1, x2, coef1[-k-2]);
+            acc2 = vmlaq_n_f32(acc2, x2, coef2[-k-2]);
+            acc3 = vmlaq_n_f32(acc3, x2, coef3[-k-2]);
+
+            float32x4_t x3 = vld1q_f32(&ps[k+3]);
+            acc0 = vmlaq_n_f32(acc0, x3, coef0[-k-3]);
+            acc1 = vmlaq_n_f32(acc1, x3, coef1[-k-3]);
+            acc2 = vmlaq_n_f32(acc2, x3, coef2[-k-3]);
+            acc3 = vmlaq_n_f32(acc3, x3, coef3[-k-3]);
+        }
+
+        vst1q_f32(&dst0[i], acc0);
+        vst1q_f32(&dst1[i], acc1);
+        vst1q_f32(&dst2[i], acc2);
+        vst1q_f32(&dst3[i], acc3);
+    }
+}
+
+// 4 channel planar to interleaved
+void interleave_4x4_NEON(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4x4_t x;
+        x.val[0] = vld1q_f32(&src0[i]);
+        x.val[1] = vld1q_f32(&src1[i]);
+        x.val[2] = vld1q_f32(&src2[i]);
+        x.val[3] = vld1q_f32(&src3[i]);
+
+        vst4q_f32(&dst[4*i], x);
+    }
+}
+
+// process 2 cascaded biquads on 4 channels (interleaved)
+// biquads computed in parallel, by adding one sample of delay
+void biquad2_4x4_NEON(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames) {
+
+    // prevent denormals, the same way as the reference code
+    const float32x4_t denormalOffset = vdupq_n_f32(1.0e-20f);
+
+    // restore state
+    float32x4_t y00 = vld1q_f32(&state[0][0]);
+    float32x4_t w10 = vld1q_f32(&state[1][0]);
+    float32x4_t w20 = vld1q_f32(&state[2][0]);
+
+    float32x4_t y01;
+    float32x4_t w11 = vld1q_f32(&state[1][4]);
+    float32x4_t w21 = vld1q_f32(&state[2][4]);
+
+    // first biquad coefs
+    float32x4_t b00 = vld1q_f32(&coef[0][0]);
+    float32x4_t b10 = vld1q_f32(&coef[1][0]);
+    float32x4_t b20 = vld1q_f32(&coef[2][0]);
+    float32x4_t a10 = vld1q_f32(&coef[3][0]);
+    float32x4_t a20 = vld1q_f32(&coef[4][0]);
+
+    // second biquad coefs
+    float32x4_t b01 = vld1q_f32(&coef[0][4]);
+    float32x4_t b11 = vld1q_f32(&coef[1][4]);
+    float32x4_t b21 = vld1q_f32(&coef[2][4]);
+    float32x4_t a11 = vld1q_f32(&coef[3][4]);
+    float32x4_t a21 = vld1q_f32(&coef[4][4]);
+
+    for (int i = 0; i < numFrames; i++) {
+
+        float32x4_t x00 = vaddq_f32(vld1q_f32(&src[4*i]), denormalOffset);
+        float32x4_t x01 = y00;  // first biquad output
+
+        // transposed Direct Form II
+        y00 = vmlaq_f32(w10, x00, b00);
+        y01 = vmlaq_f32(w11, x01, b01);
+
+        w10 = vmlaq_f32(w20, x00, b10);
+        w11 = vmlaq_f32(w21, x01, b11);
+
+        w20 = vmulq_f32(x00, b20);
+        w21 = vmulq_f32(x01, b21);
+
+        w10 = vmlsq_f32(w10, y00, a10);
+        w11 = vmlsq_f32(w11, y01, a11);
+
+        w20 = vmlsq_f32(w20, y00, a20);
+        w21 = vmlsq_f32(w21, y01, a21);
+
+        vst1q_f32(&dst[4*i], y01);  // second biquad output
+    }
+
+    // save state
+    vst1q_f32(&state[0][0], y00);
+    vst1q_f32(&state[1][0], w10);
+    vst1q_f32(&state[2][0], w20);
+
+    vst1q_f32(&state[1][4], w11);
+    vst1q_f32(&state[2][4], w21);
+}
+
+// crossfade 4 inputs into 2 outputs with accumulation (interleaved)
+void crossfade_4x2_NEON(float* src, float* dst, const float* win, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t f0 = vld1q_f32(&win[i]);
+
+        // deinterleave into { L0, R0, L1, R1 }
+        float32x4x4_t x = vld4q_f32(&src[4*i]);
+        float32x4x2_t y = vld2q_f32(&dst[2*i]);
+
+        // crossfade and accumulate
+        y.val[0] = vaddq_f32(y.val[0], vmlaq_f32(x.val[2], f0, vsubq_f32(x.val[0], x.val[2])));
+        y.val[1] = vaddq_f32(y.val[1], vmlaq_f32(x.val[3], f0, vsubq_f32(x.val[1], x.val[3])));
+
+        vst2q_f32(&dst[2*i], y);
+    }
+}
+
+// linear interpolation with gain
+void interpolate_NEON(float* dst, const float* src0, const float* src1, float frac, float gain) {
+
+    float32x4_t f0 = vdupq_n_f32(HRTF_GAIN * gain * (1.0f - frac));
+    float32x4_t f1 = vdupq_n_f32(HRTF_GAIN * gain * frac);
+
+    assert(HRTF_TAPS % 4 == 0);
+
+    for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+        float32x4_t x0 = vld1q_f32(&src0[k]);
+        float32x4_t x1 = vld1q_f32(&src1[k]);
+
+        vst1q_f32(&dst[k], vmlaq_f32(vmulq_f32(f0, x0), f1, x1));
+    }
+}
+
+#endif
@@ -0,0 +1,63 @@
+//
+//  AudioLimiter_neon.cpp
+//  libraries/audio/src/neon
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <assert.h>
+#include <stdint.h>
+#include <arm_neon.h>
+
+// convert float to int using round-to-nearest, the same way as the reference code
+static inline int32x4_t floatToInt(float32x4_t x) {
+    uint32x4_t negative = vcltq_f32(x, vdupq_n_f32(0.0f));
+    x = vaddq_f32(x, vbslq_f32(negative, vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f)));
+    return vcvtq_s32_f32(x);
+}
+
+// apply gain and dither, then store 16-bit output (mono)
+void applyGain_mono_NEON(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t x = vmulq_f32(vld1q_f32(&input[i]), vld1q_f32(&gain[i]));
+        x = vaddq_f32(x, vld1q_f32(&dither[i]));
+
+        vst1_s16(&output[i], vmovn_s32(floatToInt(x)));
+    }
+}
+
+// apply gain and dither, then store 16-bit output (stereo)
+void applyGain_stereo_NEON(float* input, float* gain, float* dither, int16_t* output, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t g = vld1q_f32(&gain[i]);
+        float32x4_t d = vld1q_f32(&dither[i]);
+
+        // deinterleave into { L, R }
+        float32x4x2_t x = vld2q_f32(&input[2*i]);
+
+        x.val[0] = vaddq_f32(vmulq_f32(x.val[0], g), d);
+        x.val[1] = vaddq_f32(vmulq_f32(x.val[1], g), d);
+
+        int16x4x2_t y;
+        y.val[0] = vmovn_s32(floatToInt(x.val[0]));
+        y.val[1] = vmovn_s32(floatToInt(x.val[1]));
+
+        vst2_s16(&output[2*i], y);
+    }
+}
+
+#endif
@@ -0,0 +1,342 @@
+//
+//  AudioSRC_neon.cpp
+//  libraries/audio/src/neon
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <assert.h>
+#include <string.h>
+#include <arm_neon.h>
+
+#include "../AudioSRC.h"
+
+// high/low part of int64_t
+#define LO32(a)   ((uint32_t)(a))
+#define HI32(a)   ((int32_t)((a) >> 32))
+
+// horizontal sum, stored to a single float
+static inline void storeSum(float* dst, float32x4_t acc) {
+    float32x2_t t = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    t = vpadd_f32(t, t);
+    vst1_lane_f32(dst, t, 0);
+}
+
+int AudioSRC::multirateFilter1_NEON(const float* input0, float* output0, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 4 == 0);  // SIMD4
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            float32x4_t acc0 = vdupq_n_f32(0.0f);
+
+            for (int j = 0; j < _numTaps; j += 4) {
+
+                //float coef = c0[j];
+                float32x4_t coef0 = vld1q_f32(&c0[j]);
+
+                //acc += input[i + j] * coef;
+                acc0 = vmlaq_f32(acc0, vld1q_f32(&input0[i + j]), coef0);
+            }
+
+            storeSum(&output0[outputFrames], acc0);
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            float frac = (f & SRC_FRACMASK) * QFRAC_TO_FLOAT;
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            float32x4_t acc0 = vdupq_n_f32(0.0f);
+
+            for (int j = 0; j < _numTaps; j += 4) {
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                float32x4_t coef0 = vld1q_f32(&c0[j]);
+                float32x4_t coef1 = vld1q_f32(&c1[j]);
+                coef0 = vmlaq_n_f32(coef0, vsubq_f32(coef1, coef0), frac);
+
+                //acc += input[i + j] * coef;
+                acc0 = vmlaq_f32(acc0, vld1q_f32(&input0[i + j]), coef0);
+            }
+
+            storeSum(&output0[outputFrames], acc0);
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+
+    return outputFrames;
+}
+
+int AudioSRC::multirateFilter2_NEON(const float* input0, const float* input1, float* output0, float* output1, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 4 == 0);  // SIMD4
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            float32x4_t acc0 = vdupq_n_f32(0.0f);
+            float32x4_t acc1 = vdupq_n_f32(0.0f);
+
+            for (int j = 0; j < _numTaps; j += 4) {
+
+                //float coef = c0[j];
+                float32x4_t coef0 = vld1q_f32(&c0[j]);
+
+                //acc += input[i + j] * coef;
+                acc0 = vmlaq_f32(acc0, vld1q_f32(&input0[i + j]), coef0);
+                acc1 = vmlaq_f32(acc1, vld1q_f32(&input1[i + j]), coef0);
+            }
+
+            storeSum(&output0[outputFrames], acc0);
+            storeSum(&output1[outputFrames], acc1);
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            float frac = (f & SRC_FRACMASK) * QFRAC_TO_FLOAT;
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            float32x4_t acc0 = vdupq_n_f32(0.0f);
+            float32x4_t acc1 = vdupq_n_f32(0.0f);
+
+            for (int j = 0; j < _numTaps; j += 4) {
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                float32x4_t coef0 = vld1q_f32(&c0[j]);
+                float32x4_t coef1 = vld1q_f32(&c1[j]);
+                coef0 = vmlaq_n_f32(coef0, vsubq_f32(coef1, coef0), frac);
+
+                //acc += input[i + j] * coef;
+                acc0 = vmlaq_f32(acc0, vld1q_f32(&input0[i + j]), coef0);
+                acc1 = vmlaq_f32(acc1, vld1q_f32(&input1[i + j]), coef0);
+            }
+
+            storeSum(&output0[outputFrames], acc0);
+            storeSum(&output1[outputFrames], acc1);
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+
+    return outputFrames;
+}
+
+// convert int16_t to float, deinterleave stereo
+void AudioSRC::convertInput_NEON(const int16_t* input, float** outputs, int numFrames) {
+    const float scale = 1/32768.0f;
+
+    int i = 0;
+    if (_numChannels == 1) {
+
+        for (; i < numFrames - 3; i += 4) {
+            int32x4_t a0 = vmovl_s16(vld1_s16(&input[i]));
+
+            vst1q_f32(&outputs[0][i], vmulq_n_f32(vcvtq_f32_s32(a0), scale));
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = (float)input[i] * scale;
+        }
+
+    } else if (_numChannels == 2) {
+
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleave
+            int16x4x2_t a = vld2_s16(&input[2*i]);
+
+            vst1q_f32(&outputs[0][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(a.val[0])), scale));
+            vst1q_f32(&outputs[1][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(a.val[1])), scale));
+        }
+        for (; i < numFrames; i++) {
+            outputs[0][i] = (float)input[2*i + 0] * scale;
+            outputs[1][i] = (float)input[2*i + 1] * scale;
+        }
+    }
+}
+
+// fast TPDF dither in [-1.0f, 1.0f]
+static inline float32x4_t dither4() {
+    static const uint16_t mul[8] = { 62041, 30185, 37945, 19445, 42257, 59561, 40025, 25173 };
+    static const uint16_t add[8] = { 28013, 52311, 32857, 57835, 45861, 105, 32769, 13849 };
+    static uint16x8_t rz = vdupq_n_u16(0);
+
+    // update the 8 different maximum-length LCGs
+    rz = vaddq_u16(vmulq_u16(rz, vld1q_u16(mul)), vld1q_u16(add));
+
+    // promote to 32-bit
+    int32x4_t r0 = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(rz)));
+    int32x4_t r1 = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(rz)));
+
+    // return (r0 - r1) * (1/65536.0f);
+    return vmulq_n_f32(vcvtq_f32_s32(vsubq_s32(r0, r1)), 1/65536.0f);
+}
+
+// round-to-nearest, the same way as the reference code, then saturate to int16_t
+static inline int16x4_t floatToInt16(float32x4_t x) {
+    uint32x4_t negative = vcltq_f32(x, vdupq_n_f32(0.0f));
+    x = vaddq_f32(x, vbslq_f32(negative, vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f)));
+    return vqmovn_s32(vcvtq_s32_f32(x));
+}
+
+// convert float to int16_t with dither, interleave stereo
+void AudioSRC::convertOutput_NEON(float** inputs, int16_t* output, int numFrames) {
+    const float scale = 32768.0f;
+
+    int i = 0;
+    if (_numChannels == 1) {
+
+        for (; i < numFrames - 3; i += 4) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_f32(&inputs[0][i]), scale);
+
+            f0 = vaddq_f32(f0, dither4());
+
+            vst1_s16(&output[i], floatToInt16(f0));
+        }
+
+    } else if (_numChannels == 2) {
+
+        for (; i < numFrames - 3; i += 4) {
+            float32x4_t f0 = vmulq_n_f32(vld1q_f32(&inputs[0][i]), scale);
+            float32x4_t f1 = vmulq_n_f32(vld1q_f32(&inputs[1][i]), scale);
+
+            float32x4_t d0 = dither4();
+
+            // interleave
+            int16x4x2_t a;
+            a.val[0] = floatToInt16(vaddq_f32(f0, d0));
+            a.val[1] = floatToInt16(vaddq_f32(f1, d0));
+
+            vst2_s16(&output[2*i], a);
+        }
+    }
+
+    // the remaining frames, one vector with the unused lanes dropped
+    if (i < numFrames) {
+        float tail[2][4] = {};
+        for (int k = 0; k < numFrames - i; k++) {
+            tail[0][k] = inputs[0][i + k] * scale;
+            tail[1][k] = (_numChannels == 2) ? inputs[1][i + k] * scale : 0.0f;
+        }
+
+        float32x4_t d0 = dither4();
+        int16_t a0[4], a1[4];
+        vst1_s16(a0, floatToInt16(vaddq_f32(vld1q_f32(tail[0]), d0)));
+        vst1_s16(a1, floatToInt16(vaddq_f32(vld1q_f32(tail[1]), d0)));
+
+        for (int k = 0; k < numFrames - i; k++) {
+            if (_numChannels == 2) {
+                output[2*(i + k) + 0] = a0[k];
+                output[2*(i + k) + 1] = a1[k];
+            } else {
+                output[i + k] = a0[k];
+            }
+        }
+    }
+}
+
+// deinterleave stereo
+void AudioSRC::convertInput_NEON(const float* input, float** outputs, int numFrames) {
+
+    if (_numChannels == 1) {
+
+        memcpy(outputs[0], input, numFrames * sizeof(float));
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // deinterleave
+            float32x4x2_t x = vld2q_f32(&input[2*i]);
+
+            vst1q_f32(&outputs[0][i], x.val[0]);
+            vst1q_f32(&outputs[1][i], x.val[1]);
+        }
+        for (; i < numFrames; i++) {
+            // deinterleave
+            outputs[0][i] = input[2*i + 0];
+            outputs[1][i] = input[2*i + 1];
+        }
+    }
+}
+
+// interleave stereo
+void AudioSRC::convertOutput_NEON(float** inputs, float* output, int numFrames) {
+
+    if (_numChannels == 1) {
+
+        memcpy(output, inputs[0], numFrames * sizeof(float));
+
+    } else if (_numChannels == 2) {
+
+        int i = 0;
+        for (; i < numFrames - 3; i += 4) {
+            // interleave
+            float32x4x2_t x;
+            x.val[0] = vld1q_f32(&inputs[0][i]);
+            x.val[1] = vld1q_f32(&inputs[1][i]);
+
+            vst2q_f32(&output[2*i], x);
+        }
+        for (; i < numFrames; i++) {
+            // interleave
+            output[2*i + 0] = inputs[0][i];
+            output[2*i + 1] = inputs[1][i];
+        }
+    }
+}
+
+#endif
@@ -25,6 +25,7 @@
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
 
+#include <BitStream.h>
 #include <QVariantGLM.h>
 #include <Transform.h>
 #include <NetworkAccessManager.h>
@@ -89,9 +90,16 @@ namespace AvatarDataPacket {
     struct JointData {
         uint8_t numJoints;
         uint8_t rotationValidityBits[ceil(numJoints / 8)];     // one bit per joint, if true then a compressed rotation follows.
-        SixByteQuat rotation[numValidRotations];  // encodeded and compressed by packOrientationQuatToSixBytes()
+        uint8_t rotationBits;                              // bits per quaternion component in the rotations
+        uint8_t rotations[ceil(numValidRotations * (3 * rotationBits + 2) / 8)];  // bit-packed by packOrientationQuatToBits()
         uint8_t translationValidityBits[ceil(numJoints / 8)];  // one bit per joint, if true then a compressed translation follows.
-        SixByteTrans translation[numValidTranslations];  // encodeded and compressed by packFloatVec3ToSignedTwoByteFixed()
+        uint8_t translationBits;                           // bits per component in the translations
+        float maxTranslationDimension;                     // the translations are scaled to -max..max
+        uint8_t translations[ceil(numValidTranslations * 3 * translationBits / 8)];  // bit-packed by packFloatVec3ToBits()
+        SixByteQuat leftHandControllerRotation;            // the faux joints, packed as before
+        SixByteTrans leftHandControllerTranslation;
+        SixByteQuat rightHandControllerRotation;
+        SixByteTrans rightHandControllerTranslation;
     };
     */
 }
@@ -308,18 +316,23 @@ QByteArray AvatarData::toByteArray(bool cullSmallChanges, bool sendAll) {
         *destinationBuffer++ = validity;
     }
 
+    // the rotations are bit-packed back to back, at the precision given ahead of them
+    *destinationBuffer++ = (uint8_t)_jointRotationBits;
+    BitWriter rotationWriter(destinationBuffer);
+
     validityBit = 0;
     validity = *validityPosition++;
     for (int i = 0; i < _jointData.size(); i ++) {
         const JointData& data = _jointData[i];
         if (validity & (1 << validityBit)) {
-            destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+            packOrientationQuatToBits(rotationWriter, data.rotation, _jointRotationBits);
         }
         if (++validityBit == BITS_IN_BYTE) {
             validityBit = 0;
             validity = *validityPosition++;
         }
     }
+    destinationBuffer += rotationWriter.flush();
 
 
     // joint translation data
@@ -332,7 +345,7 @@ QByteArray AvatarData::toByteArray(bool cullSmallChanges, bool sendAll) {
     unsigned char* beforeTranslations = destinationBuffer;
     #endif
 
-    float maxTranslationDimension = 0.0;
+    float maxTranslationDimension = 0.0f;
     for (int i=0; i < _jointData.size(); i++) {
         const JointData& data = _jointData[i];
         if (sendAll || _lastSentJointData[i].translation != data.translation) {
@@ -360,19 +373,25 @@ QByteArray AvatarData::toByteArray(bool cullSmallChanges, bool sendAll) {
         *destinationBuffer++ = validity;
     }
 
+    // the translations are bit-packed back to back, scaled to the largest of them
+    *destinationBuffer++ = (uint8_t)_jointTranslationBits;
+    memcpy(destinationBuffer, &maxTranslationDimension, sizeof(maxTranslationDimension));
+    destinationBuffer += sizeof(maxTranslationDimension);
+    BitWriter translationWriter(destinationBuffer);
+
     validityBit = 0;
     validity = *validityPosition++;
     for (int i = 0; i < _jointData.size(); i ++) {
         const JointData& data = _jointData[i];
         if (validity & (1 << validityBit)) {
-            destinationBuffer +=
-                packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+            packFloatVec3ToBits(translationWriter, data.translation, maxTranslationDimension, _jointTranslationBits);
         }
         if (++validityBit == BITS_IN_BYTE) {
             validityBit = 0;
             validity = *validityPosition++;
         }
     }
+    destinationBuffer += translationWriter.flush();
 
     // faux joints
     Transform controllerLeftHandTransform = Transform(getControllerLeftHandMatrix());
@@ -400,6 +419,11 @@ QByteArray AvatarData::toByteArray(bool cullSmallChanges, bool sendAll) {
     return avatarDataByteArray.left(destinationBuffer - startPosition);
 }
 
+void AvatarData::setJointCompressionBits(int rotationBits, int translationBits) {
+    _jointRotationBits = glm::clamp(rotationBits, MIN_JOINT_COMPRESSION_BITS, MAX_JOINT_ROTATION_BITS);
+    _jointTranslationBits = glm::clamp(translationBits, MIN_JOINT_COMPRESSION_BITS, MAX_JOINT_TRANSLATION_BITS);
+}
+
 void AvatarData::doneEncoding(bool cullSmallChanges) {
     // The server has finished sending this version of the joint-data to other nodes.  Update _lastSentJointData.
     QReadLocker readLock(&_jointDataLock);
@@ -621,20 +645,32 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         }
     }
 
-    // each joint rotation is stored in 6 bytes.
+    // the joint rotations are bit-packed, each takes three components of rotationBits plus two bits
+    PACKET_READ_CHECK(JointRotationBits, sizeof(uint8_t));
+    int rotationBits = *sourceBuffer++;
+    if (rotationBits < MIN_JOINT_COMPRESSION_BITS || rotationBits > MAX_JOINT_ROTATION_BITS) {
+        if (shouldLogError(now)) {
+            qCWarning(avatars) << "Discard AvatarData packet: joint rotation bits" << rotationBits << "out of range, uuid "
+                << getSessionUUID();
+        }
+        return buffer.size();
+    }
+
     QWriteLocker writeLock(&_jointDataLock);
     _jointData.resize(numJoints);
 
-    const int COMPRESSED_QUATERNION_SIZE = 6;
-    PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
+    const int jointRotationsSize = (numValidJointRotations * (3 * rotationBits + 2) + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+    PACKET_READ_CHECK(JointRotations, jointRotationsSize);
+    BitReader rotationReader(sourceBuffer, jointRotationsSize);
     for (int i = 0; i < numJoints; i++) {
         JointData& data = _jointData[i];
         if (validRotations[i]) {
-            sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+            data.rotation = unpackOrientationQuatFromBits(rotationReader, rotationBits);
             _hasNewJointRotations = true;
             data.rotationSet = true;
         }
     }
+    sourceBuffer += jointRotationsSize;
 
     PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
 
@@ -658,18 +694,32 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         }
     } // 1 + bytesOfValidity bytes
 
-    // each joint translation component is stored in 6 bytes.
-    const int COMPRESSED_TRANSLATION_SIZE = 6;
-    PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
+    // the joint translations are bit-packed, three components of translationBits each scaled to the largest one
+    PACKET_READ_CHECK(JointTranslationBits, sizeof(uint8_t) + sizeof(float));
+    int translationBits = *sourceBuffer++;
+    float maxTranslationDimension;
+    memcpy(&maxTranslationDimension, sourceBuffer, sizeof(maxTranslationDimension));
+    sourceBuffer += sizeof(maxTranslationDimension);
+    if (translationBits < MIN_JOINT_COMPRESSION_BITS || translationBits > MAX_JOINT_TRANSLATION_BITS
+        || isNaN(maxTranslationDimension)) {
+        if (shouldLogError(now)) {
+            qCWarning(avatars) << "Discard AvatarData packet: bad joint translation scale, uuid " << getSessionUUID();
+        }
+        return buffer.size();
+    }
 
+    const int jointTranslationsSize = (numValidJointTranslations * 3 * translationBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+    PACKET_READ_CHECK(JointTranslation, jointTranslationsSize);
+    BitReader translationReader(sourceBuffer, jointTranslationsSize);
     for (int i = 0; i < numJoints; i++) {
         JointData& data = _jointData[i];
         if (validTranslations[i]) {
-            sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+            data.translation = unpackFloatVec3FromBits(translationReader, maxTranslationDimension, translationBits);
             _hasNewJointTranslations = true;
             data.translationSet = true;
         }
     }
+    sourceBuffer += jointTranslationsSize;
 
     #ifdef WANT_DEBUG
     if (numValidJointRotations > 15) {
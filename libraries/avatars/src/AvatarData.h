@@ -121,6 +121,14 @@ const float AVATAR_SEND_FULL_UPDATE_RATIO = 0.02f;
 const float AVATAR_MIN_ROTATION_DOT = 0.9999999f;
 const float AVATAR_MIN_TRANSLATION = 0.0001f;
 
+// the precision joint rotations and translations are sent at, in bits for each component
+// translations are scaled to the largest one sent in the packet, so their bits cover -largest..largest
+const int DEFAULT_JOINT_ROTATION_BITS = 12;
+const int DEFAULT_JOINT_TRANSLATION_BITS = 12;
+const int MIN_JOINT_COMPRESSION_BITS = 6;
+const int MAX_JOINT_ROTATION_BITS = 15;
+const int MAX_JOINT_TRANSLATION_BITS = 16;
+
 
 // Where one's own Avatar begins in the world (will be overwritten if avatar data file is found).
 // This is the start location in the Sandbox (xyz: 6270, 211, 6000).
@@ -198,6 +206,9 @@ public:
     virtual QByteArray toByteArray(bool cullSmallChanges, bool sendAll);
     virtual void doneEncoding(bool cullSmallChanges);
 
+    // the precision toByteArray packs the joints at, clamped to what the format can carry
+    void setJointCompressionBits(int rotationBits, int translationBits);
+
     /// \return true if an error should be logged
     bool shouldLogError(const quint64& now);
 
@@ -372,6 +383,7 @@ public slots:
     virtual glm::vec3 getAbsoluteJointTranslationInObjectFrame(int index) const override;
     virtual bool setAbsoluteJointRotationInObjectFrame(int index, const glm::quat& rotation) override { return false; }
     virtual bool setAbsoluteJointTranslationInObjectFrame(int index, const glm::vec3& translation) override { return false; }
+    virtual bool hasAnimatedJoints() const override { return true; }
 
     float getTargetScale() { return _targetScale; }
 
@@ -386,6 +398,8 @@ protected:
 
     QVector<JointData> _jointData; ///< the state of the skeleton joints
     QVector<JointData> _lastSentJointData; ///< the state of the skeleton joints last time we transmitted
+    int _jointRotationBits { DEFAULT_JOINT_ROTATION_BITS };
+    int _jointTranslationBits { DEFAULT_JOINT_TRANSLATION_BITS };
     mutable QReadWriteLock _jointDataLock;
 
     // key state
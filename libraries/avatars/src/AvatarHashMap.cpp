@@ -10,10 +10,12 @@
 //
 
 #include <QtCore/QDataStream>
+#include <QtCore/QPointer>
 
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
+#include <shared/FrameScheduler.h>
 
 #include "AvatarLogging.h"
 #include "AvatarHashMap.h"
@@ -125,10 +127,28 @@ void AvatarHashMap::processAvatarDataPacket(QSharedPointer<ReceivedMessage> mess
     }
 }
 
+static QString getIdentityWorkKey(const QUuid& sessionUUID) {
+    return "avatarIdentity/" + sessionUUID.toString();
+}
+
 void AvatarHashMap::processAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     AvatarData::Identity identity;
     AvatarData::parseAvatarIdentityPacket(message->getMessage(), identity);
 
+    // the identities of a crowd arriving at once are spread over the next frames, only the newest of an avatar is kept
+    if (DependencyManager::isSet<FrameScheduler>()) {
+        QPointer<AvatarHashMap> self(this);
+        DependencyManager::get<FrameScheduler>()->post(getIdentityWorkKey(identity.uuid), [self, identity, sendingNode] {
+            if (self) {
+                self->processAvatarIdentity(identity, sendingNode);
+            }
+        });
+    } else {
+        processAvatarIdentity(identity, sendingNode);
+    }
+}
+
+void AvatarHashMap::processAvatarIdentity(const AvatarData::Identity& identity, const SharedNodePointer& sendingNode) {
     // make sure this isn't for an ignored avatar
     auto nodeList = DependencyManager::get<NodeList>();
     if (!nodeList->isIgnoringNode(identity.uuid)) {
@@ -141,6 +161,10 @@ void AvatarHashMap::processAvatarIdentityPacket(QSharedPointer<ReceivedMessage>
 void AvatarHashMap::processKillAvatar(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     // read the node id
     QUuid sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    // an identity still waiting would bring the avatar back
+    if (DependencyManager::isSet<FrameScheduler>()) {
+        DependencyManager::get<FrameScheduler>()->cancel(getIdentityWorkKey(sessionUUID));
+    }
     removeAvatar(sessionUUID);
 }
 
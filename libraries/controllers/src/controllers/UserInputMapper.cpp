@@ -8,6 +8,7 @@
 
 #include "UserInputMapper.h"
 
+#include <algorithm>
 #include <set>
 
 #include <QtCore/QThread>
@@ -452,10 +453,14 @@ void UserInputMapper::runMappings() {
         debugRoutes = true;
     }
 
+    if (_routesChanged) {
+        compileRoutes();
+    }
+
     if (debugRoutes) {
         qCDebug(controllers) << "Beginning mapping frame";
     }
-    for (auto endpointEntry : this->_endpointsByInput) {
+    for (const auto& endpointEntry : this->_endpointsByInput) {
         endpointEntry.second->reset();
     }
 
@@ -463,12 +468,12 @@ void UserInputMapper::runMappings() {
         qCDebug(controllers) << "Processing device routes";
     }
     // Now process the current values for each level of the stack
-    applyRoutes(_deviceRoutes);
+    applyRoutes(_compiledDeviceRoutes, _deferredRoutes);
 
     if (debugRoutes) {
         qCDebug(controllers) << "Processing standard routes";
     }
-    applyRoutes(_standardRoutes);
+    applyRoutes(_compiledStandardRoutes, _deferredRoutes);
 
     if (debugRoutes) {
         qCDebug(controllers) << "Done with mappings";
@@ -476,50 +481,67 @@ void UserInputMapper::runMappings() {
     debugRoutes = false;
 }
 
+void UserInputMapper::compileRoutes() {
+    auto compile = [](const Route::List& routes, CompiledRouteList& compiled) {
+        compiled.clear();
+        compiled.reserve(routes.size());
+        for (const auto& route : routes) {
+            // a route without a destination never does anything
+            if (!route || !route->destination) {
+                continue;
+            }
+            compiled.push_back({ route.get(), route->source.get(), route->destination.get(), route->conditional.get(),
+                route->source->getInput().device == STANDARD_DEVICE });
+        }
+    };
+    compile(_deviceRoutes, _compiledDeviceRoutes);
+    compile(_standardRoutes, _compiledStandardRoutes);
+    _deferredRoutes.reserve(std::max(_compiledDeviceRoutes.size(), _compiledStandardRoutes.size()));
+    _routesChanged = false;
+}
+
 // Encapsulate the logic that routes should not be read before they are written
-void UserInputMapper::applyRoutes(const Route::List& routes) {
-    Route::List deferredRoutes;
+void UserInputMapper::applyRoutes(const CompiledRouteList& routes, std::vector<const CompiledRoute*>& deferredRoutes) {
+    deferredRoutes.clear();
 
     for (const auto& route : routes) {
-        if (!route) {
-            continue;
-        }
-
         // Try all the deferred routes
-        deferredRoutes.remove_if([](Route::Pointer route) {
-            return UserInputMapper::applyRoute(route);
-        });
+        if (!deferredRoutes.empty()) {
+            deferredRoutes.erase(std::remove_if(deferredRoutes.begin(), deferredRoutes.end(), [](const CompiledRoute* route) {
+                return UserInputMapper::applyRoute(*route);
+            }), deferredRoutes.end());
+        }
 
         if (!applyRoute(route)) {
-            deferredRoutes.push_back(route);
+            deferredRoutes.push_back(&route);
         }
     }
 
     bool force = true;
     for (const auto& route : deferredRoutes) {
-        UserInputMapper::applyRoute(route, force);
+        UserInputMapper::applyRoute(*route, force);
     }
+    deferredRoutes.clear();
 }
 
-
-bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
+bool UserInputMapper::applyRoute(const CompiledRoute& compiledRoute, bool force) {
+    const auto route = compiledRoute.route;
     if (debugRoutes && route->debug) {
         qCDebug(controllers) << "Applying route " << route->json;
     }
 
     // If the source hasn't been written yet, defer processing of this route
-    auto source = route->source;
-    auto sourceInput = source->getInput();
-    if (sourceInput.device == STANDARD_DEVICE && !force && source->writeable()) {
+    auto source = compiledRoute.source;
+    if (compiledRoute.fromStandard && !force && source->writeable()) {
         if (debugRoutes && route->debug) {
             qCDebug(controllers) << "Source not yet written, deferring";
         }
         return false;
     }
 
-    if (route->conditional) {
+    if (compiledRoute.conditional) {
         // FIXME for endpoint conditionals we need to check if they've been written
-        if (!route->conditional->satisfied()) {
+        if (!compiledRoute.conditional->satisfied()) {
             if (debugRoutes && route->debug) {
                 qCDebug(controllers) << "Conditional failed";
             }
@@ -540,16 +562,8 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
         return true;
     }
 
-    auto destination = route->destination;
-    // THis could happen if the route destination failed to create
-    // FIXME: Maybe do not create the route if the destination failed and avoid this case ?
-    if (!destination) {
-        if (debugRoutes && route->debug) {
-            qCDebug(controllers) << "Bad Destination";
-        }
-        return true;
-    }
-
+    // the routes whose destination failed to create are left out when compiling
+    auto destination = compiledRoute.destination;
     if (!destination->writeable()) {
         if (debugRoutes && route->debug) {
             qCDebug(controllers) << "Destination unwritable";
@@ -559,7 +573,7 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
 
     // Fetch the value, may have been overriden by previous loopback routes
     if (source->isPose()) {
-        Pose value = getPose(source, route->peek);
+        Pose value = getPose(route->source, route->peek);
         static const Pose IDENTITY_POSE { vec3(), quat() };
         if (debugRoutes && route->debug) {
             if (!value.valid) {
@@ -571,10 +585,10 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
             }
         }
         // no filters yet for pose
-        destination->apply(value, source);
+        destination->apply(value, route->source);
     } else {
         // Fetch the value, may have been overriden by previous loopback routes
-        float value = getValue(source, route->peek);
+        float value = getValue(route->source, route->peek);
 
         if (debugRoutes && route->debug) {
             qCDebug(controllers) << "Value was " << value;
@@ -588,7 +602,7 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
             qCDebug(controllers) << "Filtered value was " << value;
         }
 
-        destination->apply(value, source);
+        destination->apply(value, route->source);
     }
     return true;
 }
@@ -1163,6 +1177,7 @@ void UserInputMapper::enableMapping(const Mapping::Pointer& mapping) {
         return (value->source->getInput().device == STANDARD_DEVICE);
     });
     _deviceRoutes.insert(_deviceRoutes.begin(), deviceRoutes.begin(), deviceRoutes.end());
+    _routesChanged = true;
 
     if (!debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
@@ -1179,6 +1194,7 @@ void UserInputMapper::disableMapping(const Mapping::Pointer& mapping) {
     _standardRoutes.remove_if([&](const Route::Pointer& value) {
         return routeSet.count(value) != 0;
     });
+    _routesChanged = true;
 
     if (debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
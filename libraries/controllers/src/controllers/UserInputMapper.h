@@ -16,6 +16,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtQml/QJSValue>
 #include <QtScript/QScriptValue>
@@ -149,10 +150,22 @@ namespace controller {
         friend class RouteBuilderProxy;
         friend class MappingBuilderProxy;
 
+        // A route of the enabled mappings flattened for runMappings, with the pointers it follows every frame resolved
+        struct CompiledRoute {
+            Route* route;
+            Endpoint* source;
+            Endpoint* destination;
+            Conditional* conditional;
+            bool fromStandard;
+        };
+        using CompiledRouteList = std::vector<CompiledRoute>;
+
         void runMappings();
+        // Called on the first update after a mapping is enabled or disabled
+        void compileRoutes();
 
-        static void applyRoutes(const RouteList& route);
-        static bool applyRoute(const RoutePointer& route, bool force = false);
+        static void applyRoutes(const CompiledRouteList& routes, std::vector<const CompiledRoute*>& deferredRoutes);
+        static bool applyRoute(const CompiledRoute& route, bool force = false);
         void enableMapping(const MappingPointer& mapping);
         void disableMapping(const MappingPointer& mapping);
         EndpointPointer endpointFor(const QJSValue& endpoint);
@@ -184,6 +197,10 @@ namespace controller {
 
         RouteList _deviceRoutes;
         RouteList _standardRoutes;
+        CompiledRouteList _compiledDeviceRoutes;
+        CompiledRouteList _compiledStandardRoutes;
+        std::vector<const CompiledRoute*> _deferredRoutes;
+        bool _routesChanged { true };
 
         QSet<QString> _loadedRouteJsonFiles;
 
@@ -38,6 +38,7 @@
 #include <GeometryCache.h>
 
 #include <FramebufferCache.h>
+#include <shared/FrameTimingRing.h>
 #include <shared/NsightHelpers.h>
 #include <ui-plugins/PluginContainer.h>
 #include <ui/Menu.h>
@@ -480,6 +481,15 @@ void OpenGLDisplayPlugin::submitFrame(const gpu::FramePointer& newFrame) {
     });
 }
 
+bool OpenGLDisplayPlugin::isFrameQueueFull() const {
+    bool full = false;
+    withNonPresentThreadLock([&] {
+        // a locked texture holds the queue back, it mustn't hold the main thread too
+        full = !_lockCurrentTexture && (_newFrameQueue.size() >= MAX_QUEUED_FRAMES);
+    });
+    return full;
+}
+
 void OpenGLDisplayPlugin::updateFrameData() {
     if (_lockCurrentTexture) {
         return;
@@ -501,6 +511,10 @@ void OpenGLDisplayPlugin::updateFrameData() {
 }
 
 void OpenGLDisplayPlugin::compositeOverlay() {
+    // the application sends no overlay when there is nothing in it
+    if (!_currentFrame->overlay) {
+        return;
+    }
     render([&](gpu::Batch& batch){
         batch.enableStereo(false);
         batch.setFramebuffer(_compositeFramebuffer);
@@ -599,6 +613,7 @@ void OpenGLDisplayPlugin::internalPresent() {
 
 void OpenGLDisplayPlugin::present() {
     PROFILE_RANGE_EX(__FUNCTION__, 0xffffff00, (uint64_t)presentCount())
+    auto frameTimings = DependencyManager::get<FrameTimingRing>();
     updateFrameData();
     incrementPresentCount();
 
@@ -609,16 +624,23 @@ void OpenGLDisplayPlugin::present() {
 
     if (_currentFrame) {
         {
+            bool newFrame = false;
             withPresentThreadLock([&] {
                 _renderRate.increment();
-                if (_currentFrame != _lastFrame) {
+                newFrame = (_currentFrame != _lastFrame);
+                if (newFrame) {
                     _newFrameRate.increment();
                 }
                 _lastFrame = _currentFrame;
             });
-            // Execute the frame rendering commands
-            PROFILE_RANGE_EX("execute", 0xff00ff00, (uint64_t)presentCount())
-            _gpuContext->executeFrame(_currentFrame);
+            _reprojectingFrame = !newFrame && canReprojectFrame();
+            if (!_reprojectingFrame) {
+                // Execute the frame rendering commands
+                PROFILE_RANGE_EX("execute", 0xff00ff00, (uint64_t)presentCount())
+                frameTimings->mark(_currentFrame->frameIndex, FrameTimingRing::EXECUTE_BEGIN);
+                _gpuContext->executeFrame(_currentFrame);
+                frameTimings->mark(_currentFrame->frameIndex, FrameTimingRing::EXECUTE_END);
+            }
         }
 
         // Write all layers to a local framebuffer
@@ -630,8 +652,21 @@ void OpenGLDisplayPlugin::present() {
         // Take the composite framebuffer and send it to the output device
         {
             PROFILE_RANGE_EX("internalPresent", 0xff00ffff, (uint64_t)presentCount())
+            frameTimings->mark(_currentFrame->frameIndex, FrameTimingRing::PRESENT_BEGIN);
             internalPresent();
+            frameTimings->mark(_currentFrame->frameIndex, FrameTimingRing::PRESENT_END);
+        }
+
+        // a present coming more than half a frame late missed the vsync it was meant for
+        auto now = usecTimestampNow();
+        float targetFrameRate = getTargetFrameRate();
+        if (_lastPresentTime != 0 && targetFrameRate > 0.0f) {
+            float presentInterval = (float)(now - _lastPresentTime);
+            if (presentInterval > 1.5f * (float)USECS_PER_SECOND / targetFrameRate) {
+                frameTimings->markVsyncMiss(_currentFrame->frameIndex);
+            }
         }
+        _lastPresentTime = now;
     }
 }
 
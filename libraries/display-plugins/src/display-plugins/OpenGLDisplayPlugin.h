@@ -45,6 +45,7 @@ public:
     bool isDisplayVisible() const override { return true; }
 
     void submitFrame(const gpu::FramePointer& newFrame) override;
+    bool isFrameQueueFull() const override;
 
     glm::uvec2 getRecommendedRenderSize() const override {
         return getSurfacePixels();
@@ -99,6 +100,9 @@ protected:
 
     virtual void updateFrameData();
 
+    // When no new frame is ready in time the last one is executed again, unless the plugin can warp its image instead
+    virtual bool canReprojectFrame() const { return false; }
+
     void withMainThreadContext(std::function<void()> f) const;
 
     void present();
@@ -110,13 +114,18 @@ protected:
     bool _vsyncEnabled { true };
     QThread* _presentThread{ nullptr };
     std::queue<gpu::FramePointer> _newFrameQueue;
+    // the present thread keeps only the newest frame of the queue, so the ones waiting past this are recorded for nothing
+    static const size_t MAX_QUEUED_FRAMES = 1;
     RateCounter<> _droppedFrameRate;
     RateCounter<> _newFrameRate;
     RateCounter<> _presentRate;
     RateCounter<> _renderRate;
+    quint64 _lastPresentTime { 0 };
 
     gpu::FramePointer _currentFrame;
     gpu::FramePointer _lastFrame;
+    // the current frame wasn't executed again for this present, its image is the one left from the last
+    bool _reprojectingFrame { false };
     gpu::FramebufferPointer _compositeFramebuffer;
     gpu::PipelinePointer _overlayPipeline;
     gpu::PipelinePointer _simplePipeline;
@@ -34,10 +34,12 @@
 #include "../CompositorHelper.h"
 
 static const QString MONO_PREVIEW = "Mono Preview";
+static const QString REPROJECTION = "Reproject Late Frames";
 static const QString DISABLE_PREVIEW = "Disable Preview";
 static const QString FRAMERATE = DisplayPlugin::MENU_PATH() + ">Framerate";
 static const QString DEVELOPER_MENU_PATH = "Developer>" + DisplayPlugin::MENU_PATH();
 static const bool DEFAULT_MONO_VIEW = true;
+static const bool DEFAULT_REPROJECTION = true;
 #if !defined(Q_OS_MAC)
 static const bool DEFAULT_DISABLE_PREVIEW = false;
 #endif
@@ -47,6 +49,44 @@ static const size_t NUMBER_OF_HANDS = 2;
 //#define LIVE_SHADER_RELOAD 1
 extern glm::vec3 getPoint(float yaw, float pitch);
 
+static const char* REPROJECTION_FRAG = R"SCRIBE(
+
+uniform sampler2D colorMap;
+
+struct ReprojectionData {
+    mat4 projections[2];
+    mat4 inverseProjections[2];
+    mat4 reprojection;
+};
+
+layout(std140) uniform reprojectionBuffer {
+    ReprojectionData reprojectionData;
+};
+
+in vec2 varTexCoord0;
+
+out vec4 outFragColor;
+
+void main(void) {
+    // the left eye is the left half of the scene, the right eye the right half
+    int eye = (varTexCoord0.x < 0.5) ? 0 : 1;
+    vec2 eyeTexCoord = vec2(varTexCoord0.x * 2.0 - float(eye), varTexCoord0.y);
+
+    // the direction through the fragment for the present pose, seen from the rendered pose
+    vec4 eyePos = reprojectionData.inverseProjections[eye] * vec4(eyeTexCoord * 2.0 - 1.0, 0.0, 1.0);
+    vec3 ray = mat3(reprojectionData.reprojection) * (eyePos.xyz / eyePos.w);
+
+    vec4 clipPos = reprojectionData.projections[eye] * vec4(ray, 1.0);
+    vec2 renderedTexCoord = (clipPos.xy / clipPos.w) * 0.5 + 0.5;
+    if (clipPos.w <= 0.0 || any(lessThan(renderedTexCoord, vec2(0.0))) || any(greaterThan(renderedTexCoord, vec2(1.0)))) {
+        outFragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+    outFragColor = texture(colorMap, vec2((renderedTexCoord.x + float(eye)) * 0.5, renderedTexCoord.y));
+}
+
+)SCRIBE";
+
 static QString readFile(const QString& filename) {
     QFile file(filename);
     file.open(QFile::Text | QFile::ReadOnly);
@@ -63,6 +103,11 @@ QRect HmdDisplayPlugin::getRecommendedOverlayRect() const {
     return CompositorHelper::VIRTUAL_SCREEN_RECOMMENDED_OVERLAY_RECT;
 }
 
+bool HmdDisplayPlugin::isInstancedStereo() const {
+    // only the backends of the recent enough GL versions can
+    return _gpuContext && _gpuContext->supportsInstancedStereo();
+}
+
 bool HmdDisplayPlugin::beginFrameRender(uint32_t frameIndex) {
     if (!_vsyncEnabled && !_disablePreviewItemAdded) {
         _container->addMenuItem(PluginType::DISPLAY_PLUGIN, MENU_PATH(), DISABLE_PREVIEW,
@@ -88,6 +133,12 @@ bool HmdDisplayPlugin::internalActivate() {
         _monoPreview = clicked;
         _container->setBoolSetting("monoPreview", _monoPreview);
     }, true, _monoPreview);
+    _reprojection = _container->getBoolSetting("hmdReprojection", DEFAULT_REPROJECTION);
+    _container->addMenuItem(PluginType::DISPLAY_PLUGIN, MENU_PATH(), REPROJECTION,
+        [this](bool clicked) {
+        _reprojection = clicked;
+        _container->setBoolSetting("hmdReprojection", _reprojection);
+    }, true, _reprojection);
 #if defined(Q_OS_MAC)
     _disablePreview = true;
 #else
@@ -111,6 +162,7 @@ void HmdDisplayPlugin::internalDeactivate() {
 void HmdDisplayPlugin::customizeContext() {
     Parent::customizeContext();
     _overlayRenderer.build();
+    _reprojectionRenderer.build();
 }
 
 void HmdDisplayPlugin::uncustomizeContext() {
@@ -125,6 +177,7 @@ void HmdDisplayPlugin::uncustomizeContext() {
     });
     internalPresent();
     _overlayRenderer = OverlayRenderer();
+    _reprojectionRenderer = ReprojectionRenderer();
     Parent::uncustomizeContext();
 }
 
@@ -457,6 +510,53 @@ void HmdDisplayPlugin::OverlayRenderer::render(HmdDisplayPlugin& plugin) {
     });
 }
 
+void HmdDisplayPlugin::ReprojectionRenderer::build() {
+    auto vs = gpu::StandardShaderLib::getDrawUnitQuadTexcoordVS();
+    auto ps = gpu::Shader::createPixel(std::string(REPROJECTION_FRAG));
+    gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+    gpu::Shader::makeProgram(*program);
+    uniformsLocation = program->getBuffers().findLocation("reprojectionBuffer");
+
+    gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+    state->setDepthTest(gpu::State::DepthTest(false));
+    state->setScissorEnable(true);
+    pipeline = gpu::Pipeline::create(program, state);
+
+    uniformBuffer = std::make_shared<gpu::Buffer>(sizeof(Uniforms), nullptr);
+}
+
+void HmdDisplayPlugin::ReprojectionRenderer::render(HmdDisplayPlugin& plugin) {
+    for_each_eye([&](Eye eye) {
+        uniforms.projections[eye] = plugin._eyeProjections[eye];
+        uniforms.inverseProjections[eye] = plugin._eyeInverseProjections[eye];
+    });
+    // only the rotation is corrected, the scene has no depth left to move the eyes with
+    uniforms.reprojection = mat4(glm::inverse(mat3(plugin._renderedPose)) * mat3(plugin._currentPresentFrameInfo.presentPose));
+    uniformBuffer->setSubData(0, uniforms);
+
+    plugin.render([&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+        batch.setFramebuffer(plugin._compositeFramebuffer);
+        batch.setViewportTransform(ivec4(uvec2(), plugin._compositeFramebuffer->getSize()));
+        batch.setStateScissorRect(ivec4(uvec2(), plugin._compositeFramebuffer->getSize()));
+        batch.resetViewTransform();
+        batch.setProjectionTransform(mat4());
+        batch.setPipeline(pipeline);
+        batch.setUniformBuffer(uniformsLocation, uniformBuffer);
+        batch.setResourceTexture(0, plugin._currentFrame->framebuffer->getRenderBuffer(0));
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+    });
+}
+
+void HmdDisplayPlugin::compositeScene() {
+    if (!_reprojectingFrame) {
+        _renderedPose = _currentPresentFrameInfo.presentPose;
+        Parent::compositeScene();
+        return;
+    }
+    _reprojectionRenderer.render(*this);
+}
+
 void HmdDisplayPlugin::compositePointer() {
     auto& cursorManager = Cursor::Manager::instance();
     const auto& cursorData = _cursorsData[cursorManager.getCursor()->getIcon()];
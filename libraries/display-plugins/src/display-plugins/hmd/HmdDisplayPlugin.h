@@ -31,6 +31,7 @@ public:
     glm::uvec2 getRecommendedUiSize() const override final;
     glm::uvec2 getRecommendedRenderSize() const override final { return _renderTargetSize; }
     bool isDisplayVisible() const override { return isHmdMounted(); }
+    bool isInstancedStereo() const override;
 
     QRect getRecommendedOverlayRect() const override final;
 
@@ -57,6 +58,8 @@ protected:
     void customizeContext() override;
     void uncustomizeContext() override;
     void updateFrameData() override;
+    bool canReprojectFrame() const override { return _reprojection; }
+    void compositeScene() override;
     void compositeExtra() override;
 
     struct HandLaserInfo {
@@ -100,6 +103,8 @@ protected:
     FrameInfo _currentRenderFrameInfo;
 
     bool _disablePreview{ true };
+    // The frames that aren't ready in time are replaced by the last one, turned to the newest head pose
+    bool _reprojection { true };
 private:
     ivec4 getViewportForSourceSize(const uvec2& size) const;
 
@@ -108,6 +113,25 @@ private:
     bool _clearPreviewFlag { false };
     gpu::TexturePointer _previewTexture;
 
+    // Rotates the image of each eye of the scene from the pose it was rendered with to the pose it is presented with,
+    // the parts the scene doesn't cover anymore are black
+    struct ReprojectionRenderer {
+        gpu::PipelinePointer pipeline;
+        gpu::BufferPointer uniformBuffer;
+        int32_t uniformsLocation { -1 };
+
+        struct Uniforms {
+            mat4 projections[2];
+            mat4 inverseProjections[2];
+            mat4 reprojection;
+        } uniforms;
+
+        void build();
+        void render(HmdDisplayPlugin& plugin);
+    } _reprojectionRenderer;
+    // the pose the image of the current frame was rendered with
+    mat4 _renderedPose;
+
     struct OverlayRenderer {
         gpu::Stream::FormatPointer format;
         gpu::BufferPointer vertices;
@@ -0,0 +1,69 @@
+//
+//  EntityScriptShards.cpp
+//  libraries/entities-renderer/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptShards.h"
+
+#include <algorithm>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+#include <AbstractScriptingServicesInterface.h>
+#include <ScriptEngine.h>
+
+static void entitiesScriptEngineDeleter(ScriptEngine* engine) {
+    class WaitRunnable : public QRunnable {
+        public:
+            WaitRunnable(ScriptEngine* engine) : _engine(engine) {}
+            virtual void run() override {
+                _engine->waitTillDoneRunning();
+                _engine->deleteLater();
+            }
+
+        private:
+            ScriptEngine* _engine;
+    };
+
+    // Wait for the scripting thread from the thread pool to avoid hanging the main thread
+    QThreadPool::globalInstance()->start(new WaitRunnable(engine));
+}
+
+EntityScriptShards::EntityScriptShards(const QString& name, int numEngines,
+                                       AbstractScriptingServicesInterface* scriptingServices) {
+    numEngines = std::max(numEngines, 1);
+    _engines.reserve(numEngines);
+    for (int i = 0; i < numEngines; i++) {
+        QString engineName = (numEngines == 1) ? name : QString("%1.%2").arg(name).arg(i + 1);
+        auto engine = QSharedPointer<ScriptEngine>(new ScriptEngine(NO_SCRIPT, engineName), entitiesScriptEngineDeleter);
+        scriptingServices->registerScriptEngineWithApplicationServices(engine.data());
+        engine->runInThread();
+        _engines.push_back(engine);
+    }
+}
+
+const QSharedPointer<ScriptEngine>& EntityScriptShards::getEngine(const EntityItemID& entityID) const {
+    return _engines[qHash(entityID) % (uint)_engines.size()];
+}
+
+void EntityScriptShards::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const QStringList& params) {
+    getEngine(entityID)->callEntityScriptMethod(entityID, methodName, params);
+}
+
+void EntityScriptShards::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const PointerEvent& event) {
+    getEngine(entityID)->callEntityScriptMethod(entityID, methodName, event);
+}
+
+void EntityScriptShards::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const EntityItemID& otherID, const Collision& collision) {
+    getEngine(entityID)->callEntityScriptMethod(entityID, methodName, otherID, collision);
+}
@@ -0,0 +1,48 @@
+//
+//  EntityScriptShards.h
+//  libraries/entities-renderer/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_EntityScriptShards_h
+#define hifi_EntityScriptShards_h
+
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
+#include <EntitiesScriptEngineProvider.h>
+
+class AbstractScriptingServicesInterface;
+class Collision;
+class PointerEvent;
+class ScriptEngine;
+
+// The engines the entity scripts run in, each on a thread of its own. The script of an entity always runs in the same
+// engine, picked by its ID, and everything an entity script is sent goes to that engine: the events and the calls of
+// the other scripts, which cross to its thread like any call from another thread.
+// The set of engines doesn't change once made, so it can be read from any thread.
+class EntityScriptShards : public EntitiesScriptEngineProvider {
+public:
+    EntityScriptShards(const QString& name, int numEngines, AbstractScriptingServicesInterface* scriptingServices);
+
+    const QSharedPointer<ScriptEngine>& getEngine(const EntityItemID& entityID) const;
+    const QVector<QSharedPointer<ScriptEngine>>& getEngines() const { return _engines; }
+
+    virtual void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                        const QStringList& params = QStringList()) override;
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const PointerEvent& event);
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const EntityItemID& otherID, const Collision& collision);
+
+private:
+    QVector<QSharedPointer<ScriptEngine>> _engines;
+};
+
+#endif // hifi_EntityScriptShards_h
@@ -12,8 +12,9 @@
 #include <glm/gtx/quaternion.hpp>
 
 #include <QEventLoop>
+#include <QPointer>
 #include <QScriptSyntaxCheckResult>
-#include <QThreadPool>
+#include <QThread>
 
 #include <ColorUtils.h>
 #include <AbstractScriptingServicesInterface.h>
@@ -23,9 +24,12 @@
 #include <PerfStat.h>
 #include <SceneScriptingInterface.h>
 #include <ScriptEngine.h>
+#include <SettingHandle.h>
 #include <procedural/ProceduralSkybox.h>
+#include <shared/FrameScheduler.h>
 
 #include "EntityTreeRenderer.h"
+#include "EntityScriptShards.h"
 
 #include "RenderableEntityItem.h"
 
@@ -47,7 +51,7 @@ EntityTreeRenderer::EntityTreeRenderer(bool wantScripts, AbstractViewStateInterf
                                             AbstractScriptingServicesInterface* scriptingServices) :
     OctreeRenderer(),
     _wantScripts(wantScripts),
-    _entitiesScriptEngine(NULL),
+    _entitiesScripts(NULL),
     _lastPointerEventValid(false),
     _viewState(viewState),
     _scriptingServices(scriptingServices),
@@ -76,49 +80,35 @@ EntityTreeRenderer::EntityTreeRenderer(bool wantScripts, AbstractViewStateInterf
 }
 
 EntityTreeRenderer::~EntityTreeRenderer() {
-    // NOTE: We don't need to delete _entitiesScriptEngine because
-    //       it is registered with ScriptEngines, which will call deleteLater for us.
+    // NOTE: We don't need to delete the engines of _entitiesScripts because
+    //       they are registered with ScriptEngines, which will call deleteLater for us.
 }
 
 int EntityTreeRenderer::_entitiesScriptEngineCount = 0;
 
-void entitiesScriptEngineDeleter(ScriptEngine* engine) {
-    class WaitRunnable : public QRunnable {
-        public:
-            WaitRunnable(ScriptEngine* engine) : _engine(engine) {}
-            virtual void run() override {
-                _engine->waitTillDoneRunning();
-                _engine->deleteLater();
-            }
-
-        private:
-            ScriptEngine* _engine;
-    };
-
-    // Wait for the scripting thread from the thread pool to avoid hanging the main thread
-    QThreadPool::globalInstance()->start(new WaitRunnable(engine));
-}
+// The entity scripts of a scene share one engine by default, more share the scripts between them and their threads
+static Setting::Handle<int> entityScriptThreads("entityScriptThreads", 1);
 
 void EntityTreeRenderer::resetEntitiesScriptEngine() {
-    // Keep a ref to oldEngine until newEngine is ready so EntityScriptingInterface has something to use
-    auto oldEngine = _entitiesScriptEngine;
+    // Keep a ref to the old engines until the new ones are ready so EntityScriptingInterface has something to use
+    auto oldScripts = _entitiesScripts;
 
-    auto newEngine = new ScriptEngine(NO_SCRIPT, QString("Entities %1").arg(++_entitiesScriptEngineCount));
-    _entitiesScriptEngine = QSharedPointer<ScriptEngine>(newEngine, entitiesScriptEngineDeleter);
-
-    _scriptingServices->registerScriptEngineWithApplicationServices(_entitiesScriptEngine.data());
-    _entitiesScriptEngine->runInThread();
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(_entitiesScriptEngine.data());
+    int numEngines = glm::clamp(entityScriptThreads.get(), 1, std::max(QThread::idealThreadCount(), 1));
+    _entitiesScripts = QSharedPointer<EntityScriptShards>::create(QString("Entities %1").arg(++_entitiesScriptEngineCount),
+                                                                  numEngines, _scriptingServices);
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(_entitiesScripts.data());
 }
 
 void EntityTreeRenderer::clear() {
     leaveAllEntities();
 
     // unload and stop the engine
-    if (_entitiesScriptEngine) {
+    if (_entitiesScripts) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
+        for (auto& engine : _entitiesScripts->getEngines()) {
+            engine->unloadAllEntityScripts();
+            engine->stop();
+        }
     }
 
     // reset the engine
@@ -143,10 +133,13 @@ void EntityTreeRenderer::clear() {
 }
 
 void EntityTreeRenderer::reloadEntityScripts() {
-    _entitiesScriptEngine->unloadAllEntityScripts();
+    for (auto& engine : _entitiesScripts->getEngines()) {
+        engine->unloadAllEntityScripts();
+    }
     foreach(auto entity, _entitiesInScene) {
         if (!entity->getScript().isEmpty()) {
-            ScriptEngine::loadEntityScript(_entitiesScriptEngine, entity->getEntityItemID(), entity->getScript(), true);
+            ScriptEngine::loadEntityScript(_entitiesScripts->getEngine(entity->getEntityItemID()), entity->getEntityItemID(),
+                                          entity->getScript(), true);
         }
     }
 }
@@ -161,6 +154,7 @@ void EntityTreeRenderer::init() {
     }
 
     forceRecheckEntities(); // setup our state to force checking our inside/outsideness of entities
+    entityTree->setTrackChangedEntities(true);
 
     connect(entityTree.get(), &EntityTree::deletingEntity, this, &EntityTreeRenderer::deletingEntity, Qt::QueuedConnection);
     connect(entityTree.get(), &EntityTree::addingEntity, this, &EntityTreeRenderer::addingEntity, Qt::QueuedConnection);
@@ -169,8 +163,10 @@ void EntityTreeRenderer::init() {
 }
 
 void EntityTreeRenderer::shutdown() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    if (_entitiesScripts) {
+        for (auto& engine : _entitiesScripts->getEngines()) {
+            engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+        }
     }
     _shuttingDown = true;
 
@@ -204,7 +200,7 @@ void EntityTreeRenderer::update() {
         // and we want to simulate this message here as well as in mouse move
         if (_lastPointerEventValid && !_currentClickingOnEntityID.isInvalidID()) {
             emit holdingClickOnEntity(_currentClickingOnEntityID, _lastPointerEvent);
-            _entitiesScriptEngine->callEntityScriptMethod(_currentClickingOnEntityID, "holdingClickOnEntity", _lastPointerEvent);
+            _entitiesScripts->callEntityScriptMethod(_currentClickingOnEntityID, "holdingClickOnEntity", _lastPointerEvent);
         }
 
     }
@@ -277,14 +273,15 @@ bool EntityTreeRenderer::checkEnterLeaveEntities() {
     if (_tree && !_shuttingDown) {
         glm::vec3 avatarPosition = _viewState->getAvatarPosition();
 
-        // we want to check our enter/leave state if we've moved a significant amount, or
-        // if some amount of time has elapsed since we last checked. We check the time
-        // elapsed because zones or entities might have been created "around us" while we've
-        // been stationary
+        // we want to check our enter/leave state if we've moved a significant amount, or if
+        // entities have been created, moved or deleted "around us" while we've been stationary
+        QSet<EntityItemID> changedEntities;
+        std::static_pointer_cast<EntityTree>(_tree)->takeChangedEntities(changedEntities);
+
         auto movedEnough = glm::distance(avatarPosition, _avatarPosition) > ZONE_CHECK_DISTANCE;
         auto enoughTimeElapsed = (now - _lastZoneCheck) > ZONE_CHECK_INTERVAL;
         
-        if (movedEnough || enoughTimeElapsed) {
+        if (movedEnough || enoughTimeElapsed || changesAffectAvatar(changedEntities)) {
             _avatarPosition = avatarPosition;
             _lastZoneCheck = now;
             QVector<EntityItemID> entitiesContainingAvatar;
@@ -298,8 +295,8 @@ bool EntityTreeRenderer::checkEnterLeaveEntities() {
             foreach(const EntityItemID& entityID, _currentEntitiesInside) {
                 if (!entitiesContainingAvatar.contains(entityID)) {
                     emit leaveEntity(entityID);
-                    if (_entitiesScriptEngine) {
-                        _entitiesScriptEngine->callEntityScriptMethod(entityID, "leaveEntity");
+                    if (_entitiesScripts) {
+                        _entitiesScripts->callEntityScriptMethod(entityID, "leaveEntity");
                     }
                 }
             }
@@ -308,8 +305,8 @@ bool EntityTreeRenderer::checkEnterLeaveEntities() {
             foreach(const EntityItemID& entityID, entitiesContainingAvatar) {
                 if (!_currentEntitiesInside.contains(entityID)) {
                     emit enterEntity(entityID);
-                    if (_entitiesScriptEngine) {
-                        _entitiesScriptEngine->callEntityScriptMethod(entityID, "enterEntity");
+                    if (_entitiesScripts) {
+                        _entitiesScripts->callEntityScriptMethod(entityID, "enterEntity");
                     }
                 }
             }
@@ -319,14 +316,44 @@ bool EntityTreeRenderer::checkEnterLeaveEntities() {
     return didUpdate;
 }
 
+bool EntityTreeRenderer::changesAffectAvatar(const QSet<EntityItemID>& changedEntities) {
+    if (changedEntities.isEmpty()) {
+        return false;
+    }
+
+    bool affected = false;
+    auto tree = std::static_pointer_cast<EntityTree>(_tree);
+    tree->withReadLock([&] {
+        for (auto& entityID : changedEntities) {
+            // an entity we were in, or a zone we were lit by, may have moved away, changed, or be gone
+            if (_currentEntitiesInside.contains(entityID) || _layeredZones.contains(entityID)) {
+                affected = true;
+                return;
+            }
+
+            // otherwise, only a zone or a scripted entity that now holds us matters
+            auto entity = tree->findEntityByEntityItemID(entityID);
+            if (entity && (entity->getType() == EntityTypes::Zone || !entity->getScript().isEmpty())) {
+                bool success;
+                AABox bounds = entity->getAABox(success);
+                if (!success || bounds.contains(_avatarPosition)) {
+                    affected = true;
+                    return;
+                }
+            }
+        }
+    });
+    return affected;
+}
+
 void EntityTreeRenderer::leaveAllEntities() {
     if (_tree && !_shuttingDown) {
 
         // for all of our previous containing entities, if they are no longer containing then send them a leave event
         foreach(const EntityItemID& entityID, _currentEntitiesInside) {
             emit leaveEntity(entityID);
-            if (_entitiesScriptEngine) {
-                _entitiesScriptEngine->callEntityScriptMethod(entityID, "leaveEntity");
+            if (_entitiesScripts) {
+                _entitiesScripts->callEntityScriptMethod(entityID, "leaveEntity");
             }
         }
         _currentEntitiesInside.clear();
@@ -714,14 +741,14 @@ void EntityTreeRenderer::mousePressEvent(QMouseEvent* event) {
 
         emit mousePressOnEntity(rayPickResult.entityID, pointerEvent);
 
-        if (_entitiesScriptEngine) {
-            _entitiesScriptEngine->callEntityScriptMethod(rayPickResult.entityID, "mousePressOnEntity", pointerEvent);
+        if (_entitiesScripts) {
+            _entitiesScripts->callEntityScriptMethod(rayPickResult.entityID, "mousePressOnEntity", pointerEvent);
         }
 
         _currentClickingOnEntityID = rayPickResult.entityID;
         emit clickDownOnEntity(_currentClickingOnEntityID, pointerEvent);
-        if (_entitiesScriptEngine) {
-            _entitiesScriptEngine->callEntityScriptMethod(_currentClickingOnEntityID, "clickDownOnEntity", pointerEvent);
+        if (_entitiesScripts) {
+            _entitiesScripts->callEntityScriptMethod(_currentClickingOnEntityID, "clickDownOnEntity", pointerEvent);
         }
 
         _lastPointerEvent = pointerEvent;
@@ -753,8 +780,8 @@ void EntityTreeRenderer::mouseReleaseEvent(QMouseEvent* event) {
                                   toPointerButton(*event), toPointerButtons(*event));
 
         emit mouseReleaseOnEntity(rayPickResult.entityID, pointerEvent);
-        if (_entitiesScriptEngine) {
-            _entitiesScriptEngine->callEntityScriptMethod(rayPickResult.entityID, "mouseReleaseOnEntity", pointerEvent);
+        if (_entitiesScripts) {
+            _entitiesScripts->callEntityScriptMethod(rayPickResult.entityID, "mouseReleaseOnEntity", pointerEvent);
         }
 
         _lastPointerEvent = pointerEvent;
@@ -773,8 +800,8 @@ void EntityTreeRenderer::mouseReleaseEvent(QMouseEvent* event) {
                                   toPointerButton(*event), toPointerButtons(*event));
 
         emit clickReleaseOnEntity(_currentClickingOnEntityID, pointerEvent);
-        if (_entitiesScriptEngine) {
-            _entitiesScriptEngine->callEntityScriptMethod(rayPickResult.entityID, "clickReleaseOnEntity", pointerEvent);
+        if (_entitiesScripts) {
+            _entitiesScripts->callEntityScriptMethod(rayPickResult.entityID, "clickReleaseOnEntity", pointerEvent);
         }
     }
 
@@ -804,9 +831,9 @@ void EntityTreeRenderer::mouseMoveEvent(QMouseEvent* event) {
 
         emit mouseMoveOnEntity(rayPickResult.entityID, pointerEvent);
 
-        if (_entitiesScriptEngine) {
-            _entitiesScriptEngine->callEntityScriptMethod(rayPickResult.entityID, "mouseMoveEvent", pointerEvent);
-            _entitiesScriptEngine->callEntityScriptMethod(rayPickResult.entityID, "mouseMoveOnEntity", pointerEvent);
+        if (_entitiesScripts) {
+            _entitiesScripts->callEntityScriptMethod(rayPickResult.entityID, "mouseMoveEvent", pointerEvent);
+            _entitiesScripts->callEntityScriptMethod(rayPickResult.entityID, "mouseMoveOnEntity", pointerEvent);
         }
 
         // handle the hover logic...
@@ -823,24 +850,24 @@ void EntityTreeRenderer::mouseMoveEvent(QMouseEvent* event) {
                                       toPointerButton(*event), toPointerButtons(*event));
 
             emit hoverLeaveEntity(_currentHoverOverEntityID, pointerEvent);
-            if (_entitiesScriptEngine) {
-                _entitiesScriptEngine->callEntityScriptMethod(_currentHoverOverEntityID, "hoverLeaveEntity", pointerEvent);
+            if (_entitiesScripts) {
+                _entitiesScripts->callEntityScriptMethod(_currentHoverOverEntityID, "hoverLeaveEntity", pointerEvent);
             }
         }
 
         // If the new hover entity does not match the previous hover entity then we are entering the new one
         // this is true if the _currentHoverOverEntityID is known or unknown
         if (rayPickResult.entityID != _currentHoverOverEntityID) {
-            if (_entitiesScriptEngine) {
-                _entitiesScriptEngine->callEntityScriptMethod(rayPickResult.entityID, "hoverEnterEntity", pointerEvent);
+            if (_entitiesScripts) {
+                _entitiesScripts->callEntityScriptMethod(rayPickResult.entityID, "hoverEnterEntity", pointerEvent);
             }
         }
 
         // and finally, no matter what, if we're intersecting an entity then we're definitely hovering over it, and
         // we should send our hover over event
         emit hoverOverEntity(rayPickResult.entityID, pointerEvent);
-        if (_entitiesScriptEngine) {
-            _entitiesScriptEngine->callEntityScriptMethod(rayPickResult.entityID, "hoverOverEntity", pointerEvent);
+        if (_entitiesScripts) {
+            _entitiesScripts->callEntityScriptMethod(rayPickResult.entityID, "hoverOverEntity", pointerEvent);
         }
 
         // remember what we're hovering over
@@ -863,8 +890,8 @@ void EntityTreeRenderer::mouseMoveEvent(QMouseEvent* event) {
                                   toPointerButton(*event), toPointerButtons(*event));
 
             emit hoverLeaveEntity(_currentHoverOverEntityID, pointerEvent);
-            if (_entitiesScriptEngine) {
-                _entitiesScriptEngine->callEntityScriptMethod(_currentHoverOverEntityID, "hoverLeaveEntity", pointerEvent);
+            if (_entitiesScripts) {
+                _entitiesScripts->callEntityScriptMethod(_currentHoverOverEntityID, "hoverLeaveEntity", pointerEvent);
             }
             _currentHoverOverEntityID = UNKNOWN_ENTITY_ID; // makes it the unknown ID
         }
@@ -882,19 +909,17 @@ void EntityTreeRenderer::mouseMoveEvent(QMouseEvent* event) {
                                   toPointerButton(*event), toPointerButtons(*event));
 
         emit holdingClickOnEntity(_currentClickingOnEntityID, pointerEvent);
-        if (_entitiesScriptEngine) {
-            _entitiesScriptEngine->callEntityScriptMethod(_currentClickingOnEntityID, "holdingClickOnEntity", pointerEvent);
+        if (_entitiesScripts) {
+            _entitiesScripts->callEntityScriptMethod(_currentClickingOnEntityID, "holdingClickOnEntity", pointerEvent);
         }
     }
 }
 
 void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
-    if (_tree && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID);
+    if (_tree && !_shuttingDown && _entitiesScripts) {
+        _entitiesScripts->getEngine(entityID)->unloadEntityScript(entityID);
     }
 
-    forceRecheckEntities(); // reset our state to force checking our inside/outsideness of entities
-
     // here's where we remove the entity payload from the scene
     if (_entitiesInScene.contains(entityID)) {
         auto entity = _entitiesInScene.take(entityID);
@@ -906,7 +931,6 @@ void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
 }
 
 void EntityTreeRenderer::addingEntity(const EntityItemID& entityID) {
-    forceRecheckEntities(); // reset our state to force checking our inside/outsideness of entities
     checkAndCallPreload(entityID);
     auto entity = std::static_pointer_cast<EntityTree>(_tree)->findEntityByID(entityID);
     if (entity) {
@@ -927,7 +951,7 @@ void EntityTreeRenderer::addEntityToScene(EntityItemPointer entity) {
 
 void EntityTreeRenderer::entitySciptChanging(const EntityItemID& entityID, const bool reload) {
     if (_tree && !_shuttingDown) {
-        _entitiesScriptEngine->unloadEntityScript(entityID);
+        _entitiesScripts->getEngine(entityID)->unloadEntityScript(entityID);
         checkAndCallPreload(entityID, reload);
     }
 }
@@ -935,10 +959,10 @@ void EntityTreeRenderer::entitySciptChanging(const EntityItemID& entityID, const
 void EntityTreeRenderer::checkAndCallPreload(const EntityItemID& entityID, const bool reload) {
     if (_tree && !_shuttingDown) {
         EntityItemPointer entity = getTree()->findEntityByEntityItemID(entityID);
-        if (entity && entity->shouldPreloadScript() && _entitiesScriptEngine) {
+        if (entity && entity->shouldPreloadScript() && _entitiesScripts) {
             QString scriptUrl = entity->getScript();
             scriptUrl = ResourceManager::normalizeURL(scriptUrl);
-            ScriptEngine::loadEntityScript(_entitiesScriptEngine, entityID, scriptUrl, reload);
+            ScriptEngine::loadEntityScript(_entitiesScripts->getEngine(entityID), entityID, scriptUrl, reload);
             entity->scriptHasPreloaded();
         }
     }
@@ -1044,31 +1068,50 @@ void EntityTreeRenderer::entityCollisionWithEntity(const EntityItemID& idA, cons
     // And now the entity scripts
     if (isCollisionOwner(myNodeID, entityTree, idA, collision)) {
         emit collisionWithEntity(idA, idB, collision);
-        if (_entitiesScriptEngine) {
-            _entitiesScriptEngine->callEntityScriptMethod(idA, "collisionWithEntity", idB, collision);
+        if (_entitiesScripts) {
+            _entitiesScripts->callEntityScriptMethod(idA, "collisionWithEntity", idB, collision);
         }
     }
 
     if (isCollisionOwner(myNodeID, entityTree, idA, collision)) {
         emit collisionWithEntity(idB, idA, collision);
-        if (_entitiesScriptEngine) {
-            _entitiesScriptEngine->callEntityScriptMethod(idB, "collisionWithEntity", idA, collision);
+        if (_entitiesScripts) {
+            _entitiesScripts->callEntityScriptMethod(idB, "collisionWithEntity", idA, collision);
         }
     }
 }
 
 void EntityTreeRenderer::updateEntityRenderStatus(bool shouldRenderEntities) {
+    // a large scene is added or removed a batch per frame, so the switch doesn't stall the frame it happens in
+    if (!DependencyManager::isSet<FrameScheduler>()) {
+        while (updateEntityRenderStatusBatch()) {
+        }
+        return;
+    }
+    QPointer<EntityTreeRenderer> self(this);
+    DependencyManager::get<FrameScheduler>()->post("updateEntityRenderStatus", [self] {
+        if (self && self->updateEntityRenderStatusBatch()) {
+            self->updateEntityRenderStatus(false);
+        }
+    });
+}
+
+bool EntityTreeRenderer::updateEntityRenderStatusBatch() {
+    const int ENTITY_RENDER_STATUS_BATCH_SIZE = 64;
+    // the status is read again for every batch, switching back midway picks up where the last switch got to
     if (DependencyManager::get<SceneScriptingInterface>()->shouldRenderEntities()) {
-        for (auto entityID : _entityIDsLastInScene) {
-            addingEntity(entityID);
+        for (int i = 0; i < ENTITY_RENDER_STATUS_BATCH_SIZE && !_entityIDsLastInScene.isEmpty(); ++i) {
+            addingEntity(_entityIDsLastInScene.takeFirst());
         }
-        _entityIDsLastInScene.clear();
+        return !_entityIDsLastInScene.isEmpty();
     } else {
-        _entityIDsLastInScene = _entitiesInScene.keys();
-        for (auto entityID : _entityIDsLastInScene) {
+        for (int i = 0; i < ENTITY_RENDER_STATUS_BATCH_SIZE && !_entitiesInScene.isEmpty(); ++i) {
+            auto entityID = _entitiesInScene.begin().key();
+            _entityIDsLastInScene.push_back(entityID);
             // FIXME - is this really right? do we want to do the deletingEntity() code or just remove from the scene.
             deletingEntity(entityID);
         }
+        return !_entitiesInScene.isEmpty();
     }
 }
 
@@ -28,6 +28,7 @@ class AbstractScriptingServicesInterface;
 class AbstractViewStateInterface;
 class Model;
 class ScriptEngine;
+class EntityScriptShards;
 class ZoneEntityItem;
 class EntityItem;
 
@@ -156,14 +157,18 @@ private:
 
     QScriptValueList createEntityArgs(const EntityItemID& entityID);
     bool checkEnterLeaveEntities();
+    // whether any of the entities that changed can have moved in or out from around the avatar
+    bool changesAffectAvatar(const QSet<EntityItemID>& changedEntities);
     void leaveAllEntities();
     void forceRecheckEntities();
+    // true while entities are left to add to or remove from the scene
+    bool updateEntityRenderStatusBatch();
 
     glm::vec3 _avatarPosition { 0.0f };
     QVector<EntityItemID> _currentEntitiesInside;
 
     bool _wantScripts;
-    QSharedPointer<ScriptEngine> _entitiesScriptEngine;
+    QSharedPointer<EntityScriptShards> _entitiesScripts;
 
     bool isCollisionOwner(const QUuid& myNodeID, EntityTreePointer entityTree,
                           const EntityItemID& id, const Collision& collision);
@@ -214,6 +219,7 @@ private:
         void update(std::shared_ptr<ZoneEntityItem> zone);
 
         bool contains(const LayeredZones& other);
+        bool contains(const QUuid& id) const { return _map.find(id) != _map.end(); }
 
         std::shared_ptr<ZoneEntityItem> getZone() { return empty() ? nullptr : begin()->zone; }
 
@@ -235,7 +241,9 @@ private:
     bool _pendingSkyboxTexture { false };
 
     quint64 _lastZoneCheck { 0 };
-    const quint64 ZONE_CHECK_INTERVAL = USECS_PER_MSEC * 100; // ~10hz
+    // the changed entities are what bring a recheck while the avatar stays put, the interval only catches what they
+    // can't tell, like a collision hull that finished loading
+    const quint64 ZONE_CHECK_INTERVAL = USECS_PER_SECOND;
     const float ZONE_CHECK_DISTANCE = 0.001f;
 
     QHash<EntityItemID, EntityItemPointer> _entitiesInScene;
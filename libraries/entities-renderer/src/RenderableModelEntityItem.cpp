@@ -376,6 +376,12 @@ void RenderableModelEntityItem::render(RenderArgs* args) {
             }
 
             if (_model) {
+                if (!_model->isLoaded()) {
+                    // the download moves up or down the queue with the size of the model on screen
+                    EntityTreeRenderer* renderer = static_cast<EntityTreeRenderer*>(args->_renderer);
+                    _model->setLoadingPriority(renderer->getEntityLoadingPriority(*this));
+                }
+
                 if (hasRenderAnimation()) {
                     if (!jointsMapped()) {
                         QStringList modelJointNames = _model->getJointNames();
@@ -440,6 +446,14 @@ void RenderableModelEntityItem::render(RenderArgs* args) {
                 }
             }
 
+            // a model with nothing of its own but its transform is drawn together with the other copies of its URL
+            bool canShareRenderItems = !hasAnimation() && getTextures().isEmpty();
+            _jointDataLock.withReadLock([&] {
+                canShareRenderItems = canShareRenderItems && !_absoluteJointRotationsInObjectFrameSet.contains(true) &&
+                    !_absoluteJointTranslationsInObjectFrameSet.contains(true);
+            });
+            _model->setCanShareRenderItems(canShareRenderItems);
+
             if (_model->needsFixupInScene()) {
                 render::PendingChanges pendingChanges;
 
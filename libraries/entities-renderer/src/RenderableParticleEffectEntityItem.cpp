@@ -22,6 +22,7 @@
 #include "untextured_particle_frag.h"
 #include "textured_particle_vert.h"
 #include "textured_particle_frag.h"
+#include "simulated_particle_vert.h"
 
 
 class ParticlePayloadData {
@@ -41,6 +42,16 @@ public:
         float lifespan;
         glm::vec3 spare;
     };
+    // The layout of the particleEmitterBuffer of simulated_particle.slv
+    struct EmitterUniforms {
+        glm::vec4 orientation;
+        glm::vec4 dimensions; // + emit radius start
+        glm::vec4 acceleration; // + emit speed
+        glm::vec4 accelerationSpread; // + speed spread
+        glm::vec4 angles; // polar start, polar finish, azimuth start, azimuth finish
+        glm::vec4 timing; // time between emits, time since the newest emit
+        glm::ivec4 emits; // index of the newest particle, number of particles alive at most
+    };
     
     struct ParticlePrimitive {
         ParticlePrimitive(glm::vec3 xyzIn, glm::vec2 uvIn) : xyz(xyzIn), uv(uvIn) {}
@@ -62,6 +73,8 @@ public:
     ParticlePayloadData() {
         ParticleUniforms uniforms;
         _uniformBuffer = std::make_shared<Buffer>(sizeof(ParticleUniforms), (const gpu::Byte*) &uniforms);
+        EmitterUniforms emitter;
+        _emitterBuffer = std::make_shared<Buffer>(sizeof(EmitterUniforms), (const gpu::Byte*) &emitter);
         
         _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC3F_XYZ,
                                     offsetof(ParticlePrimitive, xyz), gpu::Stream::PER_INSTANCE);
@@ -84,6 +97,11 @@ public:
     const ParticleUniforms& getParticleUniforms() const { return _uniformBuffer.get<ParticleUniforms>(); }
     ParticleUniforms& editParticleUniforms() { return _uniformBuffer.edit<ParticleUniforms>(); }
 
+    // Simulated particles are emitted by the vertex shader instead of read from the particle buffer
+    bool isSimulated() const { return _isSimulated; }
+    void setSimulated(bool isSimulated, gpu::uint32 numParticles) { _isSimulated = isSimulated; _numSimulatedParticles = numParticles; }
+    EmitterUniforms& editEmitterUniforms() { return _emitterBuffer.edit<EmitterUniforms>(); }
+
     void setTexture(TexturePointer texture) { _texture = texture; }
     const TexturePointer& getTexture() const { return _texture; }
 
@@ -102,6 +120,14 @@ public:
 
         batch.setModelTransform(_modelTransform);
         batch.setUniformBuffer(0, _uniformBuffer);
+
+        if (_isSimulated) {
+            batch.setUniformBuffer(1, _emitterBuffer);
+            batch.setInputFormat(_simulatedFormat);
+            batch.drawInstanced(_numSimulatedParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+            return;
+        }
+
         batch.setInputFormat(_vertexFormat);
         batch.setInputBuffer(0, _particleBuffer, 0, sizeof(ParticlePrimitive));
 
@@ -118,6 +144,11 @@ protected:
     BufferView _uniformBuffer;
     TexturePointer _texture;
     bool _visibleFlag = true;
+
+    FormatPointer _simulatedFormat { std::make_shared<Format>() };
+    BufferView _emitterBuffer;
+    bool _isSimulated { false };
+    gpu::uint32 _numSimulatedParticles { 0 };
 };
 
 namespace render {
@@ -155,7 +186,7 @@ EntityItemPointer RenderableParticleEffectEntityItem::factory(const EntityItemID
 RenderableParticleEffectEntityItem::RenderableParticleEffectEntityItem(const EntityItemID& entityItemID) :
     ParticleEffectEntityItem(entityItemID) {
     // lazy creation of particle system pipeline
-    if (!_untexturedPipeline || !_texturedPipeline) {
+    if (!_untexturedPipeline || !_texturedPipeline || !_simulatedPipeline) {
         createPipelines();
     }
 }
@@ -184,7 +215,21 @@ void RenderableParticleEffectEntityItem::removeFromScene(EntityItemPointer self,
 };
 
 void RenderableParticleEffectEntityItem::update(const quint64& now) {
-    ParticleEffectEntityItem::update(now);
+    if (isSimulatedOnGPU()) {
+        // we check for 'now' in the past in case users set their clock backward
+        if (now < _lastSimulated) {
+            _lastSimulated = now;
+        } else {
+            float deltaTime = (float)(now - _lastSimulated) / (float)USECS_PER_SECOND;
+            _lastSimulated = now;
+            stepSimulatedEmitter(deltaTime);
+        }
+        _particles.clear();
+        EntityItem::update(now);
+    } else {
+        _newestSimulatedParticle = -1;
+        ParticleEffectEntityItem::update(now);
+    }
 
     if (_texturesChangedFlag) {
         if (_textures.isEmpty()) {
@@ -200,6 +245,36 @@ void RenderableParticleEffectEntityItem::update(const quint64& now) {
     updateRenderItem();
 }
 
+int RenderableParticleEffectEntityItem::getNumSimulatedParticles() const {
+    // enough slots for a particle to die before the emits come back around to its slot, unless there are too many
+    float numAlive = glm::ceil(_lifespan * _emitRate) + 1.0f;
+    return glm::max((int)glm::min(numAlive, (float)_maxParticles), 1);
+}
+
+void RenderableParticleEffectEntityItem::stepSimulatedEmitter(float deltaTime) {
+    if (getIsEmitting() && _emitRate > 0.0f && _lifespan > 0.0f && _polarStart <= _polarFinish) {
+        // like stepSimulation, the first particle is emitted right away and the next ones once every period
+        if (_newestSimulatedParticle < 0) {
+            _newestSimulatedParticle = 0;
+            _timeSinceSimulatedEmit = 0.0f;
+        }
+        float timeSinceEmit = _timeSinceSimulatedEmit + deltaTime;
+        int numEmits = (int)(timeSinceEmit * _emitRate);
+        _newestSimulatedParticle += numEmits;
+        _timeSinceSimulatedEmit = glm::max(timeSinceEmit - (float)numEmits / _emitRate, 0.0f);
+
+        // keep the index from overflowing, moving it back by a multiple of the slots keeps each particle in its slot
+        const int MAX_PARTICLE_INDEX = 1 << 30;
+        if (_newestSimulatedParticle > MAX_PARTICLE_INDEX) {
+            int numSlots = getNumSimulatedParticles();
+            _newestSimulatedParticle -= (MAX_PARTICLE_INDEX / numSlots) * numSlots;
+        }
+    } else if (_newestSimulatedParticle >= 0) {
+        // the particles still alive keep aging, there is no need to count past the point they all died
+        _timeSinceSimulatedEmit = glm::min(_timeSinceSimulatedEmit + deltaTime, _lifespan);
+    }
+}
+
 void RenderableParticleEffectEntityItem::updateRenderItem() {
     // this 2 tests are synonyms for this class, but we would like to get rid of the _scene pointer ultimately
     if (!_scene || !render::Item::isValidID(_renderItemId)) { 
@@ -218,6 +293,7 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
     using ParticleUniforms = ParticlePayloadData::ParticleUniforms;
     using ParticlePrimitive = ParticlePayloadData::ParticlePrimitive;
     using ParticlePrimitives = ParticlePayloadData::ParticlePrimitives;
+    using EmitterUniforms = ParticlePayloadData::EmitterUniforms;
 
     // Fill in Uniforms structure
     ParticleUniforms particleUniforms;
@@ -231,11 +307,25 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
     particleUniforms.color.spread = glm::vec4(getColorSpreadRGB(), getAlphaSpread());
     particleUniforms.lifespan = getLifespan();
     
-    // Build particle primitives
+    // Fill in the emitter of the simulated particles, or build the particle primitives
+    bool isSimulated = isSimulatedOnGPU();
+    gpu::uint32 numSimulatedParticles = 0;
+    EmitterUniforms emitterUniforms;
     auto particlePrimitives = std::make_shared<ParticlePrimitives>();
-    particlePrimitives->reserve(_particles.size()); // Reserve space
-    for (auto& particle : _particles) {
-        particlePrimitives->emplace_back(particle.position, glm::vec2(particle.lifetime, particle.seed));
+    if (isSimulated) {
+        numSimulatedParticles = (gpu::uint32)getNumSimulatedParticles();
+        emitterUniforms.orientation = glm::vec4(_emitOrientation.x, _emitOrientation.y, _emitOrientation.z, _emitOrientation.w);
+        emitterUniforms.dimensions = glm::vec4(_emitDimensions, _emitRadiusStart);
+        emitterUniforms.acceleration = glm::vec4(_emitAcceleration, _emitSpeed);
+        emitterUniforms.accelerationSpread = glm::vec4(_accelerationSpread, _speedSpread);
+        emitterUniforms.angles = glm::vec4(_polarStart, _polarFinish, _azimuthStart, _azimuthFinish);
+        emitterUniforms.timing = glm::vec4(_emitRate > 0.0f ? 1.0f / _emitRate : 0.0f, _timeSinceSimulatedEmit, 0.0f, 0.0f);
+        emitterUniforms.emits = glm::ivec4(_newestSimulatedParticle, numSimulatedParticles, 0, 0);
+    } else {
+        particlePrimitives->reserve(_particles.size()); // Reserve space
+        for (auto& particle : _particles) {
+            particlePrimitives->emplace_back(particle.position, glm::vec2(particle.lifetime, particle.seed));
+        }
     }
 
     bool successb, successp, successr;
@@ -260,20 +350,31 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
         // Update particle uniforms
         memcpy(&payload.editParticleUniforms(), &particleUniforms, sizeof(ParticleUniforms));
         
-        // Update particle buffer
-        auto particleBuffer = payload.getParticleBuffer();
-        size_t numBytes = sizeof(ParticlePrimitive) * particlePrimitives->size();
-        particleBuffer->resize(numBytes);
-        if (numBytes == 0) {
-            return;
+        payload.setSimulated(isSimulated, numSimulatedParticles);
+        if (isSimulated) {
+            // Update the emitter, the particles come from it alone
+            memcpy(&payload.editEmitterUniforms(), &emitterUniforms, sizeof(EmitterUniforms));
+        } else {
+            // Update particle buffer
+            auto particleBuffer = payload.getParticleBuffer();
+            size_t numBytes = sizeof(ParticlePrimitive) * particlePrimitives->size();
+            particleBuffer->resize(numBytes);
+            if (numBytes == 0) {
+                return;
+            }
+            particleBuffer->setData(numBytes, (const gpu::Byte*)particlePrimitives->data());
         }
-        particleBuffer->setData(numBytes, (const gpu::Byte*)particlePrimitives->data());
 
         // Update transform and bounds
         payload.setModelTransform(transform);
         payload.setBound(bounds);
 
-        if (_texture && _texture->isLoaded()) {
+        if (isSimulated) {
+            // an untextured particle is a square of its color
+            bool isTextured = _texture && _texture->isLoaded();
+            payload.setTexture(isTextured ? _texture->getGPUTexture() : DependencyManager::get<TextureCache>()->getWhiteTexture());
+            payload.setPipeline(_simulatedPipeline);
+        } else if (_texture && _texture->isLoaded()) {
             payload.setTexture(_texture->getGPUTexture());
             payload.setPipeline(_texturedPipeline);
         } else {
@@ -312,6 +413,24 @@ void RenderableParticleEffectEntityItem::createPipelines() {
         auto program = gpu::Shader::createProgram(vertShader, fragShader);
         _texturedPipeline = gpu::Pipeline::create(program, state);
     }
+    if (!_simulatedPipeline) {
+        auto state = std::make_shared<gpu::State>();
+        state->setCullMode(gpu::State::CULL_BACK);
+        state->setDepthTest(true, false, gpu::LESS_EQUAL);
+        state->setBlendFunction(true, gpu::State::SRC_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::ONE,
+                                gpu::State::FACTOR_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::ONE);
+
+        auto vertShader = gpu::Shader::createVertex(std::string(simulated_particle_vert));
+        auto fragShader = gpu::Shader::createPixel(std::string(textured_particle_frag));
+
+        auto program = gpu::Shader::createProgram(vertShader, fragShader);
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("particleBuffer"), 0));
+        slotBindings.insert(gpu::Shader::Binding(std::string("particleEmitterBuffer"), 1));
+        slotBindings.insert(gpu::Shader::Binding(std::string("colorMap"), 0));
+        gpu::Shader::makeProgram(*program, slotBindings);
+        _simulatedPipeline = gpu::Pipeline::create(program, state);
+    }
 }
 
 void RenderableParticleEffectEntityItem::notifyBoundChanged() {
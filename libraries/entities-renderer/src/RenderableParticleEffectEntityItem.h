@@ -35,6 +35,14 @@ protected:
     void notifyBoundChanged();
 
     void createPipelines();
+
+    // The emitters that don't trail are simulated on the GPU from their properties alone, as each particle only
+    // depends on when it was emitted. The CPU only keeps count of the emits.
+    bool isSimulatedOnGPU() const { return !getEmitterShouldTrail(); }
+    int getNumSimulatedParticles() const;
+    void stepSimulatedEmitter(float deltaTime);
+    int _newestSimulatedParticle { -1 };
+    float _timeSinceSimulatedEmit { 0.0f };
     
     render::ScenePointer _scene;
     render::ItemID _renderItemId{ render::Item::INVALID_ITEM_ID };
@@ -42,6 +50,7 @@ protected:
     NetworkTexturePointer _texture;
     gpu::PipelinePointer _untexturedPipeline;
     gpu::PipelinePointer _texturedPipeline;
+    gpu::PipelinePointer _simulatedPipeline;
 };
 
 
@@ -12,6 +12,8 @@
 #include <math.h>
 #include <QObject>
 #include <QByteArray>
+#include <QThread>
+#include <QThreadPool>
 #include <QtConcurrent/QtConcurrentRun>
 #include <glm/gtx/transform.hpp>
 
@@ -61,7 +63,7 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
   _voxelData -- compressed QByteArray representation of which voxels have which values
   _volData -- datastructure from the PolyVox library which holds which voxels have which values
-  _mesh -- renderable representation of the voxels
+  _chunks -- renderable representation of the voxels, as a mesh and collision hulls for each block of 16^3 voxels
   _shape -- used for bullet collisions
 
   Each one depends on the one before it, except that _voxelData is set from _volData if a script edits the voxels.
@@ -74,7 +76,7 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
   In RenderablePolyVoxEntityItem::render, these flags are checked and changes are propagated along the chain.
   decompressVolumeData() is called to decompress _voxelData into _volData.  getMesh() is called to invoke the
-  polyVox surface extractor to create _mesh (as well as set Simulation _dirtyFlags).  Because Simulation::DIRTY_SHAPE
+  polyVox surface extractor on the chunks with changed voxels (as well as set Simulation _dirtyFlags once they are all done).  Because Simulation::DIRTY_SHAPE
   is set, isReadyToComputeShape() gets called and _shape is created either from _volData or _shape, depending on
   the surface style.
 
@@ -112,7 +114,6 @@ EntityItemPointer RenderablePolyVoxEntityItem::factory(const EntityItemID& entit
 
 RenderablePolyVoxEntityItem::RenderablePolyVoxEntityItem(const EntityItemID& entityItemID) :
     PolyVoxEntityItem(entityItemID),
-    _mesh(new model::Mesh()),
     _meshDirty(true),
     _xTexture(nullptr),
     _yTexture(nullptr),
@@ -179,6 +180,7 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
         } else {
             _volDataDirty = true;
             _voxelSurfaceStyle = voxelSurfaceStyle;
+            markAllChunksDirty();
         }
     });
 
@@ -551,11 +553,7 @@ void RenderablePolyVoxEntityItem::setZTextureURL(QString zTextureURL) {
     }
 }
 
-void RenderablePolyVoxEntityItem::render(RenderArgs* args) {
-    PerformanceTimer perfTimer("RenderablePolyVoxEntityItem::render");
-    assert(getType() == EntityTypes::PolyVox);
-    Q_ASSERT(args->_batch);
-
+void RenderablePolyVoxEntityItem::processDirtyFlags() {
     bool voxelDataDirty;
     bool volDataDirty;
     withWriteLock([&] {
@@ -572,13 +570,36 @@ void RenderablePolyVoxEntityItem::render(RenderArgs* args) {
     } else if (volDataDirty) {
         getMesh();
     }
+}
+
+void RenderablePolyVoxEntityItem::render(RenderArgs* args) {
+    size_t numChunks;
+    withReadLock([&] {
+        numChunks = _chunks.size();
+    });
+    for (size_t i = 0; i < numChunks; i++) {
+        renderChunk(args, (int)i);
+    }
+}
+
+void RenderablePolyVoxEntityItem::renderChunk(RenderArgs* args, int chunk) {
+    PerformanceTimer perfTimer("RenderablePolyVoxEntityItem::render");
+    assert(getType() == EntityTypes::PolyVox);
+    Q_ASSERT(args->_batch);
+
+    processDirtyFlags();
 
     model::MeshPointer mesh;
     glm::vec3 voxelVolumeSize;
     withReadLock([&] {
-        mesh = _mesh;
+        if (chunk < (int)_chunks.size()) {
+            mesh = _chunks[chunk].mesh;
+        }
         voxelVolumeSize = _voxelVolumeSize;
     });
+    if (!mesh || mesh->getNumIndices() == 0) {
+        return;
+    }
 
     if (!_pipeline) {
         gpu::ShaderPointer vertexShader = gpu::Shader::createVertex(std::string(polyvox_vert));
@@ -645,29 +666,49 @@ void RenderablePolyVoxEntityItem::render(RenderArgs* args) {
     batch.drawIndexed(gpu::TRIANGLES, (gpu::uint32)mesh->getNumIndices(), 0);
 }
 
+AABox RenderablePolyVoxEntityItem::getChunkBound(int chunk) const {
+    glm::vec3 lowCorner;
+    glm::vec3 highCorner;
+    bool isValid = false;
+    withReadLock([&] {
+        if (chunk < (int)_chunks.size()) {
+            // cubic faces sit half a voxel off the voxels
+            lowCorner = glm::vec3(_chunks[chunk].lowCorner) - Vectors::HALF;
+            highCorner = glm::vec3(_chunks[chunk].highCorner) + Vectors::HALF;
+            isValid = true;
+        }
+    });
+    if (!isValid) {
+        return AABox();
+    }
+
+    glm::mat4 vtwMatrix = voxelToWorldMatrix();
+    AABox bound;
+    for (int i = 0; i < 8; i++) {
+        glm::vec3 corner((i & 1) ? highCorner.x : lowCorner.x,
+                         (i & 2) ? highCorner.y : lowCorner.y,
+                         (i & 4) ? highCorner.z : lowCorner.z);
+        bound += glm::vec3(vtwMatrix * glm::vec4(corner, 1.0f));
+    }
+    return bound;
+}
+
 bool RenderablePolyVoxEntityItem::addToScene(EntityItemPointer self,
                                              std::shared_ptr<render::Scene> scene,
                                              render::PendingChanges& pendingChanges) {
-    _myItem = scene->allocateID();
-
-    auto renderItem = std::make_shared<PolyVoxPayload>(getThisPointer());
-    auto renderData = PolyVoxPayload::Pointer(renderItem);
-    auto renderPayload = std::make_shared<PolyVoxPayload::Payload>(renderData);
-
-    render::Item::Status::Getters statusGetters;
-    makeEntityItemStatusGetters(getThisPointer(), statusGetters);
-    renderPayload->addStatusGetters(statusGetters);
-
-    pendingChanges.resetItem(_myItem, renderPayload);
-
+    _scene = scene;
+    resetChunkRenderItems(pendingChanges);
     return true;
 }
 
 void RenderablePolyVoxEntityItem::removeFromScene(EntityItemPointer self,
                                                   std::shared_ptr<render::Scene> scene,
                                                   render::PendingChanges& pendingChanges) {
-    pendingChanges.removeItem(_myItem);
-    render::Item::clearID(_myItem);
+    for (auto item : _chunkRenderItems) {
+        pendingChanges.removeItem(item);
+    }
+    _chunkRenderItems.clear();
+    _scene = nullptr;
 }
 
 namespace render {
@@ -678,19 +719,15 @@ namespace render {
     template <> const Item::Bound payloadGetBound(const PolyVoxPayload::Pointer& payload) {
         if (payload && payload->_owner) {
             auto polyVoxEntity = std::dynamic_pointer_cast<RenderablePolyVoxEntityItem>(payload->_owner);
-            bool success;
-            auto result = polyVoxEntity->getAABox(success);
-            if (!success) {
-                return render::Item::Bound();
-            }
-            return result;
+            return polyVoxEntity->getChunkBound(payload->_chunk);
         }
         return render::Item::Bound();
     }
 
     template <> void payloadRender(const PolyVoxPayload::Pointer& payload, RenderArgs* args) {
         if (args && payload && payload->_owner) {
-            payload->_owner->render(args);
+            auto polyVoxEntity = std::dynamic_pointer_cast<RenderablePolyVoxEntityItem>(payload->_owner);
+            polyVoxEntity->renderChunk(args, payload->_chunk);
         }
     }
 }
@@ -763,7 +800,103 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(glm::vec3 voxelVolumeSize)
 
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+
+        resetChunks();
     });
+
+    if (_scene) {
+        render::PendingChanges pendingChanges;
+        resetChunkRenderItems(pendingChanges);
+        _scene->enqueuePendingChanges(pendingChanges);
+    }
+}
+
+void RenderablePolyVoxEntityItem::resetChunks() {
+    // lay the chunks out over _volData.  This assumes that the caller has write-locked the entity.
+    _chunksVersion++;
+    _chunks.clear();
+
+    // the surface is made between the voxels, so there are one less cells than voxels along each axis
+    glm::ivec3 numCells(_volData->getWidth() - 1, _volData->getHeight() - 1, _volData->getDepth() - 1);
+    numCells = glm::max(numCells, glm::ivec3(1));
+    _numChunks = (numCells + (CHUNK_SIZE - 1)) / CHUNK_SIZE;
+    for (int z = 0; z < _numChunks.z; z++) {
+        for (int y = 0; y < _numChunks.y; y++) {
+            for (int x = 0; x < _numChunks.x; x++) {
+                Chunk chunk;
+                glm::ivec3 index(x, y, z);
+                chunk.lowCorner = index * CHUNK_SIZE;
+                chunk.highCorner = glm::min(chunk.lowCorner + CHUNK_SIZE, numCells);
+                chunk.ownedHighCorner = chunk.lowCorner + CHUNK_SIZE;
+                for (int axis = 0; axis < 3; axis++) {
+                    if (index[axis] == _numChunks[axis] - 1) {
+                        // the voxels of the high side belong to the last chunk, there isn't one after it
+                        chunk.ownedHighCorner[axis] = numCells[axis] + 1;
+                    }
+                }
+                _chunks.push_back(chunk);
+            }
+        }
+    }
+}
+
+void RenderablePolyVoxEntityItem::markChunksDirty(int x, int y, int z) {
+    // x, y, z are in _volData coords.  This assumes that the caller has write-locked the entity.
+    // A voxel changes the mesh of the chunks whose regions are within a voxel of it, the normals of the marching
+    // cubes are the gradient of the voxels around the corners of a cell.
+    glm::ivec3 voxel(x, y, z);
+    glm::ivec3 first;
+    glm::ivec3 last;
+    for (int axis = 0; axis < 3; axis++) {
+        first[axis] = glm::max((voxel[axis] - 2) / CHUNK_SIZE, 0);
+        last[axis] = glm::min((voxel[axis] + 1) / CHUNK_SIZE, _numChunks[axis] - 1);
+    }
+    for (int chunkZ = first.z; chunkZ <= last.z; chunkZ++) {
+        for (int chunkY = first.y; chunkY <= last.y; chunkY++) {
+            for (int chunkX = first.x; chunkX <= last.x; chunkX++) {
+                _chunks[(chunkZ * _numChunks.y + chunkY) * _numChunks.x + chunkX].isDirty = true;
+            }
+        }
+    }
+}
+
+void RenderablePolyVoxEntityItem::markAllChunksDirty() {
+    for (auto& chunk : _chunks) {
+        chunk.isDirty = true;
+    }
+}
+
+void RenderablePolyVoxEntityItem::setVolDataVoxel(int x, int y, int z, uint8_t toValue) {
+    // x, y, z are in _volData coords.  This assumes that the caller has write-locked the entity.
+    if (_volData->getVoxelAt(x, y, z) != toValue) {
+        _volData->setVoxelAt(x, y, z, toValue);
+        markChunksDirty(x, y, z);
+    }
+}
+
+void RenderablePolyVoxEntityItem::resetChunkRenderItems(render::PendingChanges& pendingChanges) {
+    // give each chunk its own render item
+    for (auto item : _chunkRenderItems) {
+        pendingChanges.removeItem(item);
+    }
+    _chunkRenderItems.clear();
+
+    size_t numChunks;
+    withReadLock([&] {
+        numChunks = _chunks.size();
+    });
+    for (size_t i = 0; i < numChunks; i++) {
+        auto item = _scene->allocateID();
+        auto renderData = std::make_shared<PolyVoxPayload>(getThisPointer(), (int)i);
+        auto renderPayload = std::make_shared<PolyVoxPayload::Payload>(renderData);
+
+        render::Item::Status::Getters statusGetters;
+        makeEntityItemStatusGetters(getThisPointer(), statusGetters);
+        renderPayload->addStatusGetters(statusGetters);
+
+        pendingChanges.resetItem(item, renderPayload);
+        _chunkRenderItems.push_back(item);
+    }
 }
 
 
@@ -831,6 +964,10 @@ bool RenderablePolyVoxEntityItem::setVoxelInternal(int x, int y, int z, uint8_t
         _neighborsNeedUpdate = true;
     }
 
+    if (result) {
+        int edge = isEdged(_voxelSurfaceStyle) ? 1 : 0;
+        markChunksDirty(x + edge, y + edge, z + edge);
+    }
     _volDataDirty |= result;
 
     return result;
@@ -1046,7 +1183,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                 for (int y = 0; y < _volData->getHeight(); y++) {
                     for (int z = 0; z < _volData->getDepth(); z++) {
                         uint8_t neighborValue = polyVoxXPNeighbor->getVoxel(0, y, z);
-                        _volData->setVoxelAt(_volData->getWidth() - 1, y, z, neighborValue);
+                        setVolDataVoxel(_volData->getWidth() - 1, y, z, neighborValue);
                     }
                 }
             });
@@ -1060,7 +1197,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                 for (int x = 0; x < _volData->getWidth(); x++) {
                     for (int z = 0; z < _volData->getDepth(); z++) {
                         uint8_t neighborValue = polyVoxYPNeighbor->getVoxel(x, 0, z);
-                        _volData->setVoxelAt(x, _volData->getWidth() - 1, z, neighborValue);
+                        setVolDataVoxel(x, _volData->getWidth() - 1, z, neighborValue);
                     }
                 }
             });
@@ -1074,7 +1211,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                 for (int x = 0; x < _volData->getWidth(); x++) {
                     for (int y = 0; y < _volData->getHeight(); y++) {
                         uint8_t neighborValue = polyVoxZPNeighbor->getVoxel(x, y, 0);
-                        _volData->setVoxelAt(x, y, _volData->getDepth() - 1, neighborValue);
+                        setVolDataVoxel(x, y, _volData->getDepth() - 1, neighborValue);
                     }
                 }
             });
@@ -1082,8 +1219,18 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
     }
 }
 
+// the chunks of all polyvoxes are extracted on a pool of their own, so a large edit doesn't hold up the global one
+static QThreadPool* getChunkThreadPool() {
+    static QThreadPool* pool = nullptr;
+    if (!pool) {
+        pool = new QThreadPool();
+        pool->setMaxThreadCount(std::max(QThread::idealThreadCount() / 2, 1));
+    }
+    return pool;
+}
+
 void RenderablePolyVoxEntityItem::getMesh() {
-    // use _volData to make a renderable mesh
+    // use _volData to make renderable meshes of the chunks whose voxels changed
     PolyVoxSurfaceStyle voxelSurfaceStyle;
     withReadLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
@@ -1094,83 +1241,197 @@ void RenderablePolyVoxEntityItem::getMesh() {
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
+    // a chunk edited while it is being extracted stays dirty, and is extracted again once it is done
+    std::vector<int> chunksToExtract;
+    int chunksVersion;
+    withWriteLock([&] {
+        chunksVersion = _chunksVersion;
+        for (size_t i = 0; i < _chunks.size(); i++) {
+            auto& chunk = _chunks[i];
+            if (chunk.isDirty && !chunk.isExtracting) {
+                chunk.isDirty = false;
+                chunk.isExtracting = true;
+                chunksToExtract.push_back((int)i);
+            }
+        }
+    });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
-        model::MeshPointer mesh(new model::Mesh());
+    for (int chunk : chunksToExtract) {
+        QtConcurrent::run(getChunkThreadPool(), [entity, chunk, chunksVersion, voxelSurfaceStyle] {
+            entity->extractChunk(chunk, chunksVersion, voxelSurfaceStyle);
+        });
+    }
+}
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+void RenderablePolyVoxEntityItem::extractChunk(int chunk, int chunksVersion, PolyVoxSurfaceStyle voxelSurfaceStyle) {
+    // this is run off the main thread, it makes the mesh and the collision hulls of one chunk
+    bool isMarchingCubes = voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
+        voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES;
 
-        entity->withReadLock([&] {
-            PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+    // A mesh object to hold the result of surface extraction
+    PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+    ShapeInfo::PointCollection pointCollection;
+    glm::ivec3 lowCorner;
+    bool isCurrent = false;
+
+    withReadLock([&] {
+        if (chunksVersion != _chunksVersion) {
+            return;
+        }
+        isCurrent = true;
+
+        const Chunk& currentChunk = _chunks[chunk];
+        lowCorner = currentChunk.lowCorner;
+        PolyVox::Region region(PolyVox::Vector3DInt32(lowCorner.x, lowCorner.y, lowCorner.z),
+                               PolyVox::Vector3DInt32(currentChunk.highCorner.x, currentChunk.highCorner.y,
+                                                      currentChunk.highCorner.z));
+        if (isMarchingCubes) {
+            PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (_volData, region, &polyVoxMesh);
+            surfaceExtractor.execute();
+            return;
+        }
+
+        PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+            (_volData, region, &polyVoxMesh);
+        surfaceExtractor.execute();
+
+        // a box for each voxel of the chunk that is on the surface
+        int edge = isEdged(voxelSurfaceStyle) ? 1 : 0;
+        glm::ivec3 low = glm::max(currentChunk.lowCorner - edge, glm::ivec3(0));
+        glm::ivec3 high = glm::min(currentChunk.ownedHighCorner - edge, glm::ivec3(_voxelVolumeSize));
+        for (int z = low.z; z < high.z; z++) {
+            for (int y = low.y; y < high.y; y++) {
+                for (int x = low.x; x < high.x; x++) {
+                    if (getVoxelInternal(x, y, z) == 0) {
+                        continue;
+                    }
+                    if ((x > 0 && getVoxelInternal(x - 1, y, z) > 0) &&
+                        (y > 0 && getVoxelInternal(x, y - 1, z) > 0) &&
+                        (z > 0 && getVoxelInternal(x, y, z - 1) > 0) &&
+                        (x < _voxelVolumeSize.x - 1 && getVoxelInternal(x + 1, y, z) > 0) &&
+                        (y < _voxelVolumeSize.y - 1 && getVoxelInternal(x, y + 1, z) > 0) &&
+                        (z < _voxelVolumeSize.z - 1 && getVoxelInternal(x, y, z + 1) > 0)) {
+                        // this voxel has neighbors in every cardinal direction, so there's no need
+                        // to include it in the collision hull.
+                        continue;
+                    }
+
+                    float offL = -0.5f + edge;
+                    float offH = 0.5f + edge;
+
+                    QVector<glm::vec3> pointsInPart;
+                    pointsInPart << glm::vec3(x + offL, y + offL, z + offL);
+                    pointsInPart << glm::vec3(x + offL, y + offL, z + offH);
+                    pointsInPart << glm::vec3(x + offL, y + offH, z + offL);
+                    pointsInPart << glm::vec3(x + offL, y + offH, z + offH);
+                    pointsInPart << glm::vec3(x + offH, y + offL, z + offL);
+                    pointsInPart << glm::vec3(x + offH, y + offL, z + offH);
+                    pointsInPart << glm::vec3(x + offH, y + offH, z + offL);
+                    pointsInPart << glm::vec3(x + offH, y + offH, z + offH);
+
+                    // add next convex hull
+                    pointCollection << pointsInPart;
                 }
             }
-        });
-
-        // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
-        auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
-                                                         (gpu::Byte*)vecIndices.data());
-        auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
-        auto indexBufferView = new gpu::BufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::RAW));
-        mesh->setIndexBuffer(*indexBufferView);
-
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getVertices();
-        auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
-                                                          (gpu::Byte*)vecVertices.data());
-        auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
-        gpu::Resource::Size vertexBufferSize = 0;
-        if (vertexBufferPtr->getSize() > sizeof(float) * 3) {
-            vertexBufferSize = vertexBufferPtr->getSize() - sizeof(float) * 3;
         }
-        auto vertexBufferView = new gpu::BufferView(vertexBufferPtr, 0, vertexBufferSize,
-                                                    sizeof(PolyVox::PositionMaterialNormal),
-                                                    gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW));
-        mesh->setVertexBuffer(*vertexBufferView);
-        mesh->addAttribute(gpu::Stream::NORMAL,
-                           gpu::BufferView(vertexBufferPtr,
-                                           sizeof(float) * 3,
-                                           vertexBufferPtr->getSize() - sizeof(float) * 3,
-                                           sizeof(PolyVox::PositionMaterialNormal),
-                                           gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW)));
-        entity->setMesh(mesh);
     });
+
+    if (!isCurrent) {
+        return;
+    }
+
+    // convert PolyVox mesh to a Sam mesh, the extractors place the vertices relative to the low corner of the region
+    model::MeshPointer mesh(new model::Mesh());
+
+    const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
+    auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
+                                                     (gpu::Byte*)vecIndices.data());
+    auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
+    auto indexBufferView = new gpu::BufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::RAW));
+    mesh->setIndexBuffer(*indexBufferView);
+
+    std::vector<PolyVox::PositionMaterialNormal> vecVertices = polyVoxMesh.getVertices();
+    PolyVox::Vector3DFloat offset((float)lowCorner.x, (float)lowCorner.y, (float)lowCorner.z);
+    for (auto& vertex : vecVertices) {
+        vertex.setPosition(vertex.getPosition() + offset);
+    }
+    auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
+                                                      (gpu::Byte*)vecVertices.data());
+    auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
+    gpu::Resource::Size vertexBufferSize = 0;
+    if (vertexBufferPtr->getSize() > sizeof(float) * 3) {
+        vertexBufferSize = vertexBufferPtr->getSize() - sizeof(float) * 3;
+    }
+    auto vertexBufferView = new gpu::BufferView(vertexBufferPtr, 0, vertexBufferSize,
+                                                sizeof(PolyVox::PositionMaterialNormal),
+                                                gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW));
+    mesh->setVertexBuffer(*vertexBufferView);
+    mesh->addAttribute(gpu::Stream::NORMAL,
+                       gpu::BufferView(vertexBufferPtr,
+                                       sizeof(float) * 3,
+                                       vertexBufferPtr->getSize() - sizeof(float) * 3,
+                                       sizeof(PolyVox::PositionMaterialNormal),
+                                       gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW)));
+
+    if (isMarchingCubes) {
+        // pull each triangle in the mesh into a polyhedron which can be collided with
+        for (size_t i = 0; i + 2 < vecIndices.size(); i += 3) {
+            const glm::vec3 p0 = glm::vec3(vecVertices[vecIndices[i]].getPosition().getX(),
+                                           vecVertices[vecIndices[i]].getPosition().getY(),
+                                           vecVertices[vecIndices[i]].getPosition().getZ());
+            const glm::vec3 p1 = glm::vec3(vecVertices[vecIndices[i + 1]].getPosition().getX(),
+                                           vecVertices[vecIndices[i + 1]].getPosition().getY(),
+                                           vecVertices[vecIndices[i + 1]].getPosition().getZ());
+            const glm::vec3 p2 = glm::vec3(vecVertices[vecIndices[i + 2]].getPosition().getX(),
+                                           vecVertices[vecIndices[i + 2]].getPosition().getY(),
+                                           vecVertices[vecIndices[i + 2]].getPosition().getZ());
+
+            glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
+            glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+            glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
+
+            QVector<glm::vec3> pointsInPart;
+            pointsInPart << p0;
+            pointsInPart << p1;
+            pointsInPart << p2;
+            pointsInPart << p3;
+            // add next convex hull
+            pointCollection << pointsInPart;
+        }
+    }
+
+    setChunkMesh(chunk, chunksVersion, mesh, pointCollection);
 }
 
-void RenderablePolyVoxEntityItem::setMesh(model::MeshPointer mesh) {
-    // this catches the payload from getMesh
-    bool neighborsNeedUpdate;
+void RenderablePolyVoxEntityItem::setChunkMesh(int chunk, int chunksVersion, model::MeshPointer mesh,
+                                               ShapeInfo::PointCollection pointCollection) {
+    // this catches the payload from extractChunk.  The collision shape is remade once no chunk is left to extract.
+    bool neighborsNeedUpdate = false;
     withWriteLock([&] {
-        _dirtyFlags |= Simulation::DIRTY_SHAPE | Simulation::DIRTY_MASS;
-        _mesh = mesh;
-        _meshDirty = true;
-        _meshInitialized = true;
-        neighborsNeedUpdate = _neighborsNeedUpdate;
-        _neighborsNeedUpdate = false;
+        if (chunksVersion != _chunksVersion) {
+            return;
+        }
+        auto& currentChunk = _chunks[chunk];
+        currentChunk.mesh = mesh;
+        currentChunk.points = pointCollection;
+        currentChunk.isExtracting = false;
+
+        bool isDone = true;
+        for (const auto& otherChunk : _chunks) {
+            if (otherChunk.isDirty) {
+                // edited while it was extracted, have the next render start it again
+                _volDataDirty = true;
+            }
+            isDone = isDone && !otherChunk.isDirty && !otherChunk.isExtracting;
+        }
+        if (isDone) {
+            _dirtyFlags |= Simulation::DIRTY_SHAPE | Simulation::DIRTY_MASS;
+            _meshDirty = true;
+            _meshInitialized = true;
+            neighborsNeedUpdate = _neighborsNeedUpdate;
+            _neighborsNeedUpdate = false;
+        }
     });
     if (neighborsNeedUpdate) {
         bonkNeighbors();
@@ -1178,132 +1439,38 @@ void RenderablePolyVoxEntityItem::setMesh(model::MeshPointer mesh) {
 }
 
 void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
-    // this creates a collision-shape for the physics engine.  The shape comes from
-    // _volData for cubic extractors and from _mesh for marching-cube extractors
+    // this creates a collision-shape for the physics engine from the collision hulls of the chunks.  They came
+    // from _volData for cubic extractors and from the meshes for marching-cube extractors
     if (!_meshInitialized) {
         return;
     }
 
     EntityItemPointer entity = getThisPointer();
 
-    PolyVoxSurfaceStyle voxelSurfaceStyle;
-    glm::vec3 voxelVolumeSize;
-    model::MeshPointer mesh;
-
+    std::vector<ShapeInfo::PointCollection> chunkPoints;
     withReadLock([&] {
-        voxelSurfaceStyle = _voxelSurfaceStyle;
-        voxelVolumeSize = _voxelVolumeSize;
-        mesh = _mesh;
+        for (const auto& chunk : _chunks) {
+            chunkPoints.push_back(chunk.points);
+        }
     });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
+    QtConcurrent::run([entity, chunkPoints] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
         QVector<QVector<glm::vec3>> pointCollection;
         AABox box;
-        glm::mat4 vtoM = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->voxelToLocalMatrix();
-
-        if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
-            voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
-            // pull each triangle in the mesh into a polyhedron which can be collided with
-            unsigned int i = 0;
-
-            const gpu::BufferView& vertexBufferView = mesh->getVertexBuffer();
-            const gpu::BufferView& indexBufferView = mesh->getIndexBuffer();
-
-            gpu::BufferView::Iterator<const uint32_t> it = indexBufferView.cbegin<uint32_t>();
-            while (it != indexBufferView.cend<uint32_t>()) {
-                uint32_t p0Index = *(it++);
-                uint32_t p1Index = *(it++);
-                uint32_t p2Index = *(it++);
-
-                const glm::vec3& p0 = vertexBufferView.get<const glm::vec3>(p0Index);
-                const glm::vec3& p1 = vertexBufferView.get<const glm::vec3>(p1Index);
-                const glm::vec3& p2 = vertexBufferView.get<const glm::vec3>(p2Index);
-
-                glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
-                glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-                glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
-
-                glm::vec3 p0Model = glm::vec3(vtoM * glm::vec4(p0, 1.0f));
-                glm::vec3 p1Model = glm::vec3(vtoM * glm::vec4(p1, 1.0f));
-                glm::vec3 p2Model = glm::vec3(vtoM * glm::vec4(p2, 1.0f));
-                glm::vec3 p3Model = glm::vec3(vtoM * glm::vec4(p3, 1.0f));
-
-                box += p0Model;
-                box += p1Model;
-                box += p2Model;
-                box += p3Model;
+        glm::mat4 vtoM = polyVoxEntity->voxelToLocalMatrix();
 
+        for (const auto& points : chunkPoints) {
+            for (const auto& hull : points) {
                 QVector<glm::vec3> pointsInPart;
-                pointsInPart << p0Model;
-                pointsInPart << p1Model;
-                pointsInPart << p2Model;
-                pointsInPart << p3Model;
+                for (const auto& point : hull) {
+                    glm::vec3 pointModel = glm::vec3(vtoM * glm::vec4(point, 1.0f));
+                    box += pointModel;
+                    pointsInPart << pointModel;
+                }
                 // add next convex hull
-                QVector<glm::vec3> newMeshPoints;
-                pointCollection << newMeshPoints;
-                // add points to the new convex hull
-                pointCollection[i++] << pointsInPart;
+                pointCollection << pointsInPart;
             }
-        } else {
-            unsigned int i = 0;
-            polyVoxEntity->forEachVoxelValue(voxelVolumeSize.x, voxelVolumeSize.y, voxelVolumeSize.z,
-                                             [&](int x, int y, int z, uint8_t value) {
-                if (value > 0) {
-                    if ((x > 0 && polyVoxEntity->getVoxelInternal(x - 1, y, z) > 0) &&
-                        (y > 0 && polyVoxEntity->getVoxelInternal(x, y - 1, z) > 0) &&
-                        (z > 0 && polyVoxEntity->getVoxelInternal(x, y, z - 1) > 0) &&
-                        (x < voxelVolumeSize.x - 1 && polyVoxEntity->getVoxelInternal(x + 1, y, z) > 0) &&
-                        (y < voxelVolumeSize.y - 1 && polyVoxEntity->getVoxelInternal(x, y + 1, z) > 0) &&
-                        (z < voxelVolumeSize.z - 1 && polyVoxEntity->getVoxelInternal(x, y, z + 1) > 0)) {
-                        // this voxel has neighbors in every cardinal direction, so there's no need
-                        // to include it in the collision hull.
-                        return;
-                    }
-
-                    QVector<glm::vec3> pointsInPart;
-
-                    float offL = -0.5f;
-                    float offH = 0.5f;
-                    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
-                        offL += 1.0f;
-                        offH += 1.0f;
-                    }
-
-                    glm::vec3 p000 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offL, 1.0f));
-                    glm::vec3 p001 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offH, 1.0f));
-                    glm::vec3 p010 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offL, 1.0f));
-                    glm::vec3 p011 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offH, 1.0f));
-                    glm::vec3 p100 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offL, 1.0f));
-                    glm::vec3 p101 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offH, 1.0f));
-                    glm::vec3 p110 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offL, 1.0f));
-                    glm::vec3 p111 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offH, 1.0f));
-
-                    box += p000;
-                    box += p001;
-                    box += p010;
-                    box += p011;
-                    box += p100;
-                    box += p101;
-                    box += p110;
-                    box += p111;
-
-                    pointsInPart << p000;
-                    pointsInPart << p001;
-                    pointsInPart << p010;
-                    pointsInPart << p011;
-                    pointsInPart << p100;
-                    pointsInPart << p101;
-                    pointsInPart << p110;
-                    pointsInPart << p111;
-
-                    // add next convex hull
-                    QVector<glm::vec3> newMeshPoints;
-                    pointCollection << newMeshPoints;
-                    // add points to the new convex hull
-                    pointCollection[i++] << pointsInPart;
-                }
-            });
         }
         polyVoxEntity->setCollisionPoints(pointCollection, box);
     });
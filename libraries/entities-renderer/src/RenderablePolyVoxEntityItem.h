@@ -24,13 +24,15 @@
 #include "RenderableEntityItem.h"
 #include "gpu/Context.h"
 
+// The render item of one chunk of a polyvox
 class PolyVoxPayload {
 public:
-    PolyVoxPayload(EntityItemPointer owner) : _owner(owner), _bounds(AABox()) { }
+    PolyVoxPayload(EntityItemPointer owner, int chunk) : _owner(owner), _chunk(chunk), _bounds(AABox()) { }
     typedef render::Payload<PolyVoxPayload> Payload;
     typedef Payload::DataPointer Pointer;
 
     EntityItemPointer _owner;
+    int _chunk;
     AABox _bounds;
 };
 
@@ -62,6 +64,8 @@ public:
     virtual bool setVoxel(int x, int y, int z, uint8_t toValue) override;
 
     void render(RenderArgs* args) override;
+    void renderChunk(RenderArgs* args, int chunk);
+    AABox getChunkBound(int chunk) const;
     virtual bool supportsDetailedRayIntersection() const override { return true; }
     virtual bool findDetailedRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
                         bool& keepSearching, OctreeElementPointer& element, float& distance, 
@@ -122,7 +126,8 @@ public:
     void forEachVoxelValue(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize,
                            std::function<void(int, int, int, uint8_t)> thunk);
 
-    void setMesh(model::MeshPointer mesh);
+    void extractChunk(int chunk, int chunksVersion, PolyVoxSurfaceStyle voxelSurfaceStyle);
+    void setChunkMesh(int chunk, int chunksVersion, model::MeshPointer mesh, ShapeInfo::PointCollection points);
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
     PolyVox::SimpleVolume<uint8_t>* getVolData() { return _volData; }
 
@@ -138,7 +143,33 @@ private:
     // The PolyVoxEntityItem class has _voxelData which contains dimensions and compressed voxel data.  The dimensions
     // may not match _voxelVolumeSize.
 
-    model::MeshPointer _mesh;
+    static const int CHUNK_SIZE = 16; // voxels along each side of a chunk
+
+    // A block of _volData that is meshed and given collision hulls on its own, so an edit only redoes the chunks it
+    // touches. Corners are in _volData coordinates, the high corner is the low corner of the next chunk, as the
+    // extractors make the surface between the voxels of a region.
+    class Chunk {
+    public:
+        glm::ivec3 lowCorner;
+        glm::ivec3 highCorner; // inclusive
+        glm::ivec3 ownedHighCorner; // exclusive, the voxels whose cubic collision hulls go in this chunk
+        model::MeshPointer mesh;
+        ShapeInfo::PointCollection points; // collision hulls, in voxel coordinates
+        bool isDirty { true };
+        bool isExtracting { false };
+    };
+    std::vector<Chunk> _chunks;
+    glm::ivec3 _numChunks;
+    int _chunksVersion { 0 }; // bumped when _chunks is laid out again, so late extractions are dropped
+    void resetChunks();
+    void markChunksDirty(int x, int y, int z);
+    void markAllChunksDirty();
+    void setVolDataVoxel(int x, int y, int z, uint8_t toValue);
+
+    render::ScenePointer _scene;
+    std::vector<render::ItemID> _chunkRenderItems;
+    void resetChunkRenderItems(render::PendingChanges& pendingChanges);
+
     bool _meshDirty { true }; // does collision-shape need to be recomputed?
     bool _meshInitialized { false };
 
@@ -147,7 +178,6 @@ private:
     NetworkTexturePointer _zTexture;
 
     const int MATERIAL_GPU_SLOT = 3;
-    render::ItemID _myItem{ render::Item::INVALID_ITEM_ID };
     static gpu::PipelinePointer _pipeline;
 
     ShapeInfo _shapeInfo;
@@ -161,6 +191,8 @@ private:
     bool updateOnCount(int x, int y, int z, uint8_t toValue);
     PolyVox::RaycastResult doRayCast(glm::vec4 originInVoxel, glm::vec4 farInVoxel, glm::vec4& result) const;
 
+    void processDirtyFlags();
+
     // these are run off the main thread
     void decompressVolumeData();
     void compressVolumeDataAndSendEditPacket();
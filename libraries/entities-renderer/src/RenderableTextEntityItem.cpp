@@ -73,8 +73,13 @@ void RenderableTextEntityItem::render(RenderArgs* args) {
     float leftMargin = 0.1f * _lineHeight, topMargin = 0.1f * _lineHeight;
     glm::vec2 bounds = glm::vec2(dimensions.x - 2.0f * leftMargin,
                                  dimensions.y - 2.0f * topMargin);
-    _textRenderer->draw(batch, leftMargin / scale, -topMargin / scale, _text, textColor, bounds / scale);
-    
+    if (transparent || getFaceCamera() || args->_renderMode != RenderArgs::DEFAULT_RENDER_MODE) {
+        // fading or camera facing text would lay its glyphs out again every frame, draw it right away
+        _textRenderer->draw(batch, leftMargin / scale, -topMargin / scale, _text, textColor, bounds / scale);
+    } else {
+        // drawn with all the other text of the font once the opaque items are
+        _textRenderer->queue(transformToTopLeft, leftMargin / scale, -topMargin / scale, _text, textColor, bounds / scale);
+    }
 }
 
 
@@ -66,6 +66,7 @@ bool RenderableWebEntityItem::buildWebSurface(EntityTreeRenderer* renderer) {
     QSurface * currentSurface = currentContext->surface();
     _webSurface = new OffscreenQmlSurface();
     _webSurface->create(currentContext);
+    _webSurface->setIdleMaxFps(OffscreenQmlSurface::WEB_IDLE_MAX_FPS);
     _webSurface->setBaseUrl(QUrl::fromLocalFile(PathUtils::resourcesPath() + "/qml/controls/"));
     _webSurface->load("WebView.qml");
     _webSurface->resume();
@@ -97,7 +98,8 @@ bool RenderableWebEntityItem::buildWebSurface(EntityTreeRenderer* renderer) {
             QList<QTouchEvent::TouchPoint> touchPoints;
             touchPoints.push_back(point);
             QTouchEvent* touchEvent = new QTouchEvent(QEvent::TouchEnd, nullptr, Qt::NoModifier, Qt::TouchPointReleased, touchPoints);
-            QCoreApplication::postEvent(_webSurface->getWindow(), touchEvent);
+            _webSurface->notifyInput();
+        QCoreApplication::postEvent(_webSurface->getWindow(), touchEvent);
         }
     });
     return true;
@@ -182,6 +184,7 @@ void RenderableWebEntityItem::setSourceUrl(const QString& value) {
         _sourceUrl = value;
         if (_webSurface) {
             AbstractViewStateInterface::instance()->postLambdaEvent([this] {
+                _webSurface->notifyInput();
                 _webSurface->getRootItem()->setProperty("url", _sourceUrl);
             });
         }
@@ -260,6 +263,7 @@ void RenderableWebEntityItem::handlePointerEvent(const PointerEvent& event) {
 
         _lastTouchEvent = *touchEvent;
 
+        _webSurface->notifyInput();
         QCoreApplication::postEvent(_webSurface->getWindow(), touchEvent);
     }
 }
@@ -0,0 +1,106 @@
+//
+//  AddEntitiesOperator.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AddEntitiesOperator.h"
+
+#include "EntityItem.h"
+#include "EntityTree.h"
+#include "EntityTreeElement.h"
+
+AddEntitiesOperator::AddEntitiesOperator(EntityTreePointer tree, const QVector<EntityItemPointer>& newEntities) :
+    _tree(tree)
+{
+    _rootEntities.reserve(newEntities.size());
+    foreach (const EntityItemPointer& entity, newEntities) {
+        // caller must have verified existence of each entity
+        assert(entity);
+
+        bool success;
+        auto queryCube = entity->getQueryAACube(success);
+        if (!success) {
+            entity->markAncestorMissing(true);
+        }
+        _rootEntities.push_back({ entity, queryCube.clamp((float)(-HALF_TREE_SCALE), (float)HALF_TREE_SCALE) });
+    }
+
+    // deep enough for most trees without growing, the levels are reused from one branch to the next
+    const int EXPECTED_MAX_DEPTH = 32;
+    _levels.reserve(EXPECTED_MAX_DEPTH);
+}
+
+bool AddEntitiesOperator::preRecursion(const OctreeElementPointer& element) {
+    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+
+    // grown before we point into our parent's level
+    if (_depth == (int)_levels.size()) {
+        _levels.emplace_back();
+    }
+
+    // our new entities are the ones our parent handed to the child that we are
+    NewEntities* newEntities = &_rootEntities;
+    if (_depth > 0) {
+        Level& parentLevel = _levels[_depth - 1];
+        newEntities = nullptr;
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            if (parentLevel.element->getChildAtIndex(i) == element) {
+                newEntities = &parentLevel.childEntities[i];
+                break;
+            }
+        }
+    }
+
+    Level& level = _levels[_depth++];
+    level.element = element;
+    level.hasNewEntities = newEntities && !newEntities->empty();
+    bool keepSearching = false;
+
+    if (level.hasNewEntities) {
+        for (const NewEntity& newEntity : *newEntities) {
+            int childIndex = OctreeElement::CHILD_UNKNOWN;
+            if (!entityTreeElement->bestFitBounds(newEntity.box)) {
+                childIndex = element->getMyChildContaining(newEntity.box);
+            }
+
+            if (childIndex == OctreeElement::CHILD_UNKNOWN) {
+                entityTreeElement->addEntityItem(newEntity.entity);
+                _tree->setContainingElement(newEntity.entity->getEntityItemID(), entityTreeElement);
+                _tree->trackChangedElement(entityTreeElement);
+            } else {
+                level.childEntities[childIndex].push_back(newEntity);
+                keepSearching = true;
+            }
+        }
+        newEntities->clear();
+    }
+
+    return keepSearching; // only recurse into branches that have new entities left for them
+}
+
+bool AddEntitiesOperator::postRecursion(const OctreeElementPointer& element) {
+    Level& level = _levels[--_depth];
+    if (level.hasNewEntities) {
+        // we added entities in this element or below it
+        element->markWithChangedTime();
+    }
+    level.element.reset();
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        level.childEntities[i].clear();
+    }
+    return true; // keep going, our siblings may still have new entities
+}
+
+OctreeElementPointer AddEntitiesOperator::possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) {
+    // we're called for the element on top of our levels, make the child if we have new entities for it
+    if (_depth > 0 && !_levels[_depth - 1].childEntities[childIndex].empty()) {
+        return element->addChildAtIndex(childIndex);
+    }
+    return NULL;
+}
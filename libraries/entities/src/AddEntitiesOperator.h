@@ -0,0 +1,58 @@
+//
+//  AddEntitiesOperator.h
+//  libraries/entities/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AddEntitiesOperator_h
+#define hifi_AddEntitiesOperator_h
+
+#include <vector>
+
+#include <AABox.h>
+#include <Octree.h>
+
+#include "EntityTypes.h"
+
+class EntityTree;
+typedef std::shared_ptr<EntityTree> EntityTreePointer;
+
+// Adds many entities to the tree in one recursion. Each element keeps the entities that best fit it and hands the
+// rest down to the child that contains them, so every entity is looked at once per level, and only the branches
+// with new entities are visited or created.
+class AddEntitiesOperator : public RecurseOctreeOperator {
+public:
+    AddEntitiesOperator(EntityTreePointer tree, const QVector<EntityItemPointer>& newEntities);
+
+    virtual bool preRecursion(const OctreeElementPointer& element) override;
+    virtual bool postRecursion(const OctreeElementPointer& element) override;
+    virtual OctreeElementPointer possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) override;
+
+private:
+    struct NewEntity {
+        EntityItemPointer entity;
+        AABox box;
+    };
+    using NewEntities = std::vector<NewEntity>;
+
+    // an element on the current path down the tree, with the new entities for each of its children
+    struct Level {
+        OctreeElementPointer element;
+        NewEntities childEntities[NUMBER_OF_CHILDREN];
+        bool hasNewEntities { false };
+    };
+
+    EntityTreePointer _tree;
+    NewEntities _rootEntities;
+    std::vector<Level> _levels;
+    int _depth { 0 }; // how many of the levels are on the current path
+};
+
+#endif // hifi_AddEntitiesOperator_h
@@ -34,7 +34,7 @@ AddEntityOperator::AddEntityOperator(EntityTreePointer tree, EntityItemPointer n
     _newEntityBox = queryCube.clamp((float)(-HALF_TREE_SCALE), (float)HALF_TREE_SCALE);
 }
 
-bool AddEntityOperator::preRecursion(OctreeElementPointer element) {
+bool AddEntityOperator::preRecursion(const OctreeElementPointer& element) {
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
 
     // In Pre-recursion, we're generally deciding whether or not we want to recurse this
@@ -53,6 +53,7 @@ bool AddEntityOperator::preRecursion(OctreeElementPointer element) {
 
             entityTreeElement->addEntityItem(_newEntity);
             _tree->setContainingElement(_newEntity->getEntityItemID(), entityTreeElement);
+            _tree->trackChangedElement(entityTreeElement);
 
             _foundNew = true;
             keepSearching = false;
@@ -64,7 +65,7 @@ bool AddEntityOperator::preRecursion(OctreeElementPointer element) {
     return keepSearching; // if we haven't yet found it, keep looking
 }
 
-bool AddEntityOperator::postRecursion(OctreeElementPointer element) {
+bool AddEntityOperator::postRecursion(const OctreeElementPointer& element) {
     // Post-recursion is the unwinding process. For this operation, while we
     // unwind we want to mark the path as being dirty if we changed it below.
     // We might have two paths, one for the old entity and one for the new entity.
@@ -78,7 +79,7 @@ bool AddEntityOperator::postRecursion(OctreeElementPointer element) {
     return keepSearching; // if we haven't yet found it, keep looking
 }
 
-OctreeElementPointer AddEntityOperator::possiblyCreateChildAt(OctreeElementPointer element, int childIndex) {
+OctreeElementPointer AddEntityOperator::possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) {
     // If we're getting called, it's because there was no child element at this index while recursing.
     // We only care if this happens while still searching for the new entity location.
     // Check to see if 
@@ -79,6 +79,69 @@ void AnimationPropertyGroup::copyFromScriptValue(const QScriptValue& object, boo
 
 }
 
+void AnimationPropertyGroup::copyToJSON(const EntityPropertyFlags& desiredProperties, JSONWriter& writer, bool skipDefaults, EntityItemProperties& defaultEntityProperties) const {
+    writer.beginGroup("animation");
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_ANIMATION_URL, Animation, animation, URL, url);
+
+    if (_animationLoop) {
+        COPY_GROUP_PROPERTY_TO_JSON_GETTER(PROP_ANIMATION_FPS, Animation, animation, FPS, fps, _animationLoop->getFPS);
+        COPY_GROUP_PROPERTY_TO_JSON_GETTER(PROP_ANIMATION_FRAME_INDEX, Animation, animation, CurrentFrame, currentFrame, _animationLoop->getFPS);
+        COPY_GROUP_PROPERTY_TO_JSON_GETTER(PROP_ANIMATION_PLAYING, Animation, animation, Running, running, _animationLoop->getRunning);
+        COPY_GROUP_PROPERTY_TO_JSON_GETTER(PROP_ANIMATION_LOOP, Animation, animation, Loop, loop, _animationLoop->getLoop);
+        COPY_GROUP_PROPERTY_TO_JSON_GETTER(PROP_ANIMATION_FIRST_FRAME, Animation, animation, FirstFrame, firstFrame, _animationLoop->getFirstFrame);
+        COPY_GROUP_PROPERTY_TO_JSON_GETTER(PROP_ANIMATION_LAST_FRAME, Animation, animation, LastFrame, lastFrame, _animationLoop->getLastFrame);
+        COPY_GROUP_PROPERTY_TO_JSON_GETTER(PROP_ANIMATION_HOLD, Animation, animation, Hold, hold, _animationLoop->getHold);
+    } else {
+        COPY_GROUP_PROPERTY_TO_JSON(PROP_ANIMATION_FPS, Animation, animation, FPS, fps);
+        COPY_GROUP_PROPERTY_TO_JSON(PROP_ANIMATION_FRAME_INDEX, Animation, animation, CurrentFrame, currentFrame);
+        COPY_GROUP_PROPERTY_TO_JSON(PROP_ANIMATION_PLAYING, Animation, animation, Running, running);
+        COPY_GROUP_PROPERTY_TO_JSON(PROP_ANIMATION_LOOP, Animation, animation, Loop, loop);
+        COPY_GROUP_PROPERTY_TO_JSON(PROP_ANIMATION_FIRST_FRAME, Animation, animation, FirstFrame, firstFrame);
+        COPY_GROUP_PROPERTY_TO_JSON(PROP_ANIMATION_LAST_FRAME, Animation, animation, LastFrame, lastFrame);
+        COPY_GROUP_PROPERTY_TO_JSON(PROP_ANIMATION_HOLD, Animation, animation, Hold, hold);
+    }
+    writer.endGroup();
+}
+
+void AnimationPropertyGroup::copyFromJSON(const QJsonObject& object, bool& _defaultSettings) {
+
+    COPY_GROUP_PROPERTY_FROM_JSON(animation, url, QString, setURL);
+
+    // legacy property support
+    COPY_PROPERTY_FROM_JSON_GETTER(animationURL, QString, setURL, getURL);
+    COPY_PROPERTY_FROM_JSON_NOCHECK(animationSettings, QString, setFromOldAnimationSettings);
+
+    if (_animationLoop) {
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, fps, float, _animationLoop->setFPS);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, currentFrame, float, _animationLoop->setCurrentFrame);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, running, bool, _animationLoop->setRunning);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, loop, bool, _animationLoop->setLoop);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, firstFrame, float, _animationLoop->setFirstFrame);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, lastFrame, float, _animationLoop->setLastFrame);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, hold, bool, _animationLoop->setHold);
+
+        // legacy property support
+        COPY_PROPERTY_FROM_JSON_GETTER(animationFPS, float, _animationLoop->setFPS, _animationLoop->getFPS);
+        COPY_PROPERTY_FROM_JSON_GETTER(animationIsPlaying, bool, _animationLoop->setRunning, _animationLoop->getRunning);
+        COPY_PROPERTY_FROM_JSON_GETTER(animationFrameIndex, float, _animationLoop->setCurrentFrame, _animationLoop->getCurrentFrame);
+
+    } else {
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, fps, float, setFPS);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, currentFrame, float, setCurrentFrame);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, running, bool, setRunning);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, loop, bool, setLoop);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, firstFrame, float, setFirstFrame);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, lastFrame, float, setLastFrame);
+        COPY_GROUP_PROPERTY_FROM_JSON(animation, hold, bool, setHold);
+
+        // legacy property support
+        COPY_PROPERTY_FROM_JSON_GETTER(animationFPS, float, setFPS, getFPS);
+        COPY_PROPERTY_FROM_JSON_GETTER(animationIsPlaying, bool, setRunning, getRunning);
+        COPY_PROPERTY_FROM_JSON_GETTER(animationFrameIndex, float, setCurrentFrame, getCurrentFrame);
+    }
+
+}
+
 void AnimationPropertyGroup::setFromOldAnimationSettings(const QString& value) {
     // the animations setting is a JSON string that may contain various animation settings.
     // if it includes fps, currentFrame, or running, those values will be parsed out and
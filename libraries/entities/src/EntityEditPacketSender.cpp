@@ -106,10 +106,72 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
             qCDebug(entities) << "    id:" << entityItemID;
             qCDebug(entities) << "    properties:" << properties;
         #endif
-        queueOctreeEditMessage(type, bufferOut);
+        if (type == PacketType::EntityEdit) {
+            queuePendingEdit(entityItemID, bufferOut);
+        } else {
+            queueOctreeEditMessage(type, bufferOut);
+        }
     }
 }
 
+void EntityEditPacketSender::queuePendingEdit(const EntityItemID& entityItemID, QByteArray& message) {
+    QMutexLocker locker(&_pendingEditsLock);
+
+    auto it = _pendingEdits.find(entityItemID);
+    if (it == _pendingEdits.end()) {
+        _pendingEdits[entityItemID] = message;
+        return;
+    }
+
+    // most entities are edited once between flushes, so the properties are only decoded back out of the
+    // messages when there are two to merge. Decoding the newer edit on top of the pending one sets just the
+    // properties it carries, so the merged edit has everything either one changed with the newer values.
+    QByteArray& pending = it->second;
+    EntityItemProperties mergedProperties;
+    EntityItemID decodedID;
+    int pendingBytes = 0;
+    int newBytes = 0;
+    QByteArray mergedMessage(NLPacket::maxPayloadSize(PacketType::EntityEdit), 0);
+    if (EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(pending.constData()),
+                                                     pending.size(), pendingBytes, decodedID, mergedProperties) &&
+        EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(message.constData()),
+                                                     message.size(), newBytes, decodedID, mergedProperties) &&
+        EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, entityItemID, mergedProperties,
+                                                     mergedMessage)) {
+        pending = mergedMessage;
+        _collapsedEditCount++;
+    } else {
+        // the two together don't fit in one message, so the pending one goes out as it is
+        queueOctreeEditMessage(PacketType::EntityEdit, pending);
+        pending = message;
+    }
+}
+
+void EntityEditPacketSender::flushPendingEdits() {
+    QMutexLocker locker(&_pendingEditsLock);
+
+    quint64 now = usecTimestampNow();
+    if (_pendingEdits.empty() || now - _lastEditFlush < _editFlushInterval) {
+        return;
+    }
+    _lastEditFlush = now;
+
+    for (auto& pending : _pendingEdits) {
+        queueOctreeEditMessage(PacketType::EntityEdit, pending.second);
+    }
+    _pendingEdits.clear();
+}
+
+void EntityEditPacketSender::releaseQueuedMessages() {
+    flushPendingEdits();
+    OctreeEditPacketSender::releaseQueuedMessages();
+}
+
+bool EntityEditPacketSender::process() {
+    flushPendingEdits();
+    return OctreeEditPacketSender::process();
+}
+
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
     if (!_shouldSend) {
         return; // bail early
@@ -119,6 +181,14 @@ void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityI
     assert(_myAvatar);
     _myAvatar->clearAvatarEntity(entityItemID);
 
+    // there's no point sending edits of an entity that's going away
+    {
+        QMutexLocker locker(&_pendingEditsLock);
+        if (_pendingEdits.erase(entityItemID) > 0) {
+            _collapsedEditCount++;
+        }
+    }
+
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
 
     if (EntityItemProperties::encodeEraseEntityMessage(entityItemID, bufferOut)) {
@@ -12,7 +12,13 @@
 #ifndef hifi_EntityEditPacketSender_h
 #define hifi_EntityEditPacketSender_h
 
+#include <atomic>
+#include <unordered_map>
+
+#include <QtCore/QMutex>
+
 #include <OctreeEditPacketSender.h>
+#include <UUIDHasher.h>
 
 #include "EntityItem.h"
 #include "AvatarData.h"
@@ -41,6 +47,18 @@ public:
 
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
 
+    /// Edits of an entity queued between two flushes are merged into one, later properties overwriting earlier ones.
+    /// releaseQueuedMessages() and process() flush once this long has passed since the last flush, so with the default
+    /// of 0 only the edits made between two releases are merged.
+    void setEditFlushInterval(quint64 usecs) { _editFlushInterval = usecs; }
+    quint64 getEditFlushInterval() const { return _editFlushInterval; }
+
+    /// the number of edits that were merged into a later edit of the same entity rather than sent
+    quint64 getCollapsedEditCount() const { return _collapsedEditCount; }
+
+    virtual void releaseQueuedMessages() override;
+    virtual bool process() override;
+
     // My server type is the model server
     virtual char getMyNodeType() const override { return NodeType::EntityServer; }
     virtual void adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) override;
@@ -49,7 +67,16 @@ public slots:
     void processEntityEditNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
 
 private:
+    void queuePendingEdit(const EntityItemID& entityItemID, QByteArray& message);
+    void flushPendingEdits();
+
     AvatarData* _myAvatar { nullptr };
     QScriptEngine _scriptEngine;
+
+    QMutex _pendingEditsLock;
+    std::unordered_map<QUuid, QByteArray> _pendingEdits; // the merged edit message of each entity since the last flush
+    quint64 _editFlushInterval { 0 };
+    quint64 _lastEditFlush { 0 };
+    std::atomic<quint64> _collapsedEditCount { 0 };
 };
 #endif // hifi_EntityEditPacketSender_h
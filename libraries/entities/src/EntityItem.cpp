@@ -101,6 +101,24 @@ EntityItem::~EntityItem() {
     assert(!_physicsInfo);
 }
 
+EntityPropertyFlags EntityItem::filterPropertiesToSend(EntityPropertyFlags properties,
+                                                      const EncodeBitstreamParams& params) const {
+    if (!params.excludedProperties.isEmpty()) {
+        properties -= EntityPropertyFlags(params.excludedProperties);
+    }
+    if (params.heavyPropertiesDistance > NO_HEAVY_PROPERTIES_DISTANCE) {
+        float distance = glm::distance(getPosition(), params.viewFrustum.getPosition()) - 0.5f * glm::length(getDimensions());
+        if (distance > params.heavyPropertiesDistance) {
+            properties -= PROP_SCRIPT;
+            properties -= PROP_SCRIPT_TIMESTAMP;
+            properties -= PROP_USER_DATA;
+            properties -= PROP_TEXTURES;
+            properties -= PROP_COLLISION_SOUND_URL;
+        }
+    }
+    return properties;
+}
+
 EntityPropertyFlags EntityItem::getEntityProperties(EncodeBitstreamParams& params) const {
     EntityPropertyFlags requestedProperties;
 
@@ -176,7 +194,8 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
 
     EntityPropertyFlags propertyFlags(PROP_LAST_ITEM);
-    EntityPropertyFlags requestedProperties = getEntityProperties(params);
+    EntityPropertyFlags allProperties = getEntityProperties(params);
+    EntityPropertyFlags requestedProperties = filterPropertiesToSend(allProperties, params);
     EntityPropertyFlags propertiesDidntFit = requestedProperties;
 
     // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
@@ -185,7 +204,19 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
     }
 
+    // A complete encoding doesn't depend on who it is for, so if another viewer has been sent this entity since
+    // it last changed we can copy those bytes rather than encode every property again.
+    bool isEncodingAllProperties = requestedProperties == allProperties;
+    if (isEncodingAllProperties) {
+        QByteArray cachedEncoding = getCachedEncoding();
+        if (!cachedEncoding.isEmpty() && packetData->appendRawData(cachedEncoding)) {
+            params.trackSend(getID(), getLastEdited());
+            return appendState;
+        }
+    }
+
     LevelDetails entityLevel = packetData->startLevel();
+    int startOfEntity = packetData->getUncompressedByteOffset();
 
     quint64 lastEdited = getLastEdited();
 
@@ -310,6 +341,11 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         }
 
         packetData->endLevel(entityLevel);
+
+        if (isEncodingAllProperties && appendState == OctreeElement::COMPLETED) {
+            int endOfEntity = packetData->getUncompressedByteOffset();
+            cacheEncoding(QByteArray((const char*)packetData->getUncompressedData(startOfEntity), endOfEntity - startOfEntity));
+        }
     } else {
         packetData->discardLevel(entityLevel);
         appendState = OctreeElement::NONE; // if we got here, then we didn't include the item
@@ -329,6 +365,26 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     return appendState;
 }
 
+QByteArray EntityItem::getCachedEncoding() const {
+    QMutexLocker locker(&_cachedEncodingMutex);
+    if (_cachedEncodingChangedOnServer == _changedOnServer && _cachedEncodingLastEdited == _lastEdited &&
+        _cachedEncodingLastUpdated == _lastUpdated && _cachedEncodingLastSimulated == _lastSimulated &&
+        _cachedEncodingQueryAACube == getQueryAACube()) {
+        return _cachedEncoding;
+    }
+    return QByteArray();
+}
+
+void EntityItem::cacheEncoding(const QByteArray& encoding) const {
+    QMutexLocker locker(&_cachedEncodingMutex);
+    _cachedEncoding = encoding;
+    _cachedEncodingChangedOnServer = _changedOnServer;
+    _cachedEncodingLastEdited = _lastEdited;
+    _cachedEncodingLastUpdated = _lastUpdated;
+    _cachedEncodingLastSimulated = _lastSimulated;
+    _cachedEncodingQueryAACube = getQueryAACube();
+}
+
 // TODO: My goal is to get rid of this concept completely. The old code (and some of the current code) used this
 // result to calculate if a packet being sent to it was potentially bad or corrupt. I've adjusted this to now
 // only consider the minimum header bytes as being required. But it would be preferable to completely eliminate
@@ -17,6 +17,7 @@
 
 #include <glm/glm.hpp>
 
+#include <QtCore/QMutex>
 #include <QtGui/QWindow>
 
 #include <AnimationCache.h> // for Animation, AnimationCache, and AnimationPointer classes
@@ -119,6 +120,13 @@ public:
     // TODO: eventually only include properties changed since the params.lastViewFrustumSent time
     virtual EntityPropertyFlags getEntityProperties(EncodeBitstreamParams& params) const;
 
+    // the properties to send to the viewer of the params: without the ones it excluded, and without the heavy ones
+    // while it is far away
+    EntityPropertyFlags getEntityPropertiesToSend(EncodeBitstreamParams& params) const {
+        return filterPropertiesToSend(getEntityProperties(params), params);
+    }
+    EntityPropertyFlags filterPropertiesToSend(EntityPropertyFlags properties, const EncodeBitstreamParams& params) const;
+
     virtual OctreeElement::AppendState appendEntityData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                                 EntityTreeElementExtraEncodeData* entityTreeElementExtraEncodeData) const;
 
@@ -456,6 +464,10 @@ protected:
     virtual void locationChanged(bool tellPhysics = true) override;
     virtual void dimensionsChanged() override;
 
+    // the last complete encoding from appendEntityData, empty once the entity has changed since
+    QByteArray getCachedEncoding() const;
+    void cacheEncoding(const QByteArray& encoding) const;
+
     EntityTypes::EntityType _type;
     quint64 _lastSimulated; // last time this entity called simulate(), this includes velocity, angular velocity,
                             // and physics changes
@@ -473,6 +485,15 @@ protected:
     mutable AACube _minAACube;
     mutable bool _recalcAABox = true;
     mutable bool _recalcMinAACube = true;
+
+    // several octree send threads can encode this entity at once, each under the tree's read lock
+    mutable QMutex _cachedEncodingMutex;
+    mutable QByteArray _cachedEncoding;
+    mutable quint64 _cachedEncodingChangedOnServer { 0 };
+    mutable quint64 _cachedEncodingLastEdited { 0 };
+    mutable quint64 _cachedEncodingLastUpdated { 0 };
+    mutable quint64 _cachedEncodingLastSimulated { 0 };
+    mutable AACube _cachedEncodingQueryAACube;
     mutable bool _recalcMaxAACube = true;
 
     float _localRenderAlpha;
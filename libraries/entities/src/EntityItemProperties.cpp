@@ -751,6 +751,344 @@ void EntityItemProperties::copyFromScriptValue(const QScriptValue& object, bool
     _lastEdited = usecTimestampNow();
 }
 
+void EntityItemProperties::copyToJSON(JSONWriter& writer, bool skipDefaults) const {
+    EntityItemProperties defaultEntityProperties;
+
+    writer.beginObject();
+    if (_created == UNKNOWN_CREATED_TIME) {
+        // No entity properties can have been set so return without setting any default, zero property values.
+        writer.endObject();
+        return;
+    }
+
+    if (_idSet) {
+        COPY_PROPERTY_TO_JSON_GETTER_ALWAYS(id, _id.toString());
+    }
+
+    COPY_PROPERTY_TO_JSON_GETTER_ALWAYS(type, EntityTypes::getEntityTypeName(_type));
+    auto created = QDateTime::fromMSecsSinceEpoch(getCreated() / 1000.0f, Qt::UTC); // usec per msec
+    created.setTimeSpec(Qt::OffsetFromUTC);
+    COPY_PROPERTY_TO_JSON_GETTER_ALWAYS(created, created.toString(Qt::ISODate));
+
+    COPY_PROPERTY_TO_JSON(PROP_POSITION, position);
+    COPY_PROPERTY_TO_JSON(PROP_DIMENSIONS, dimensions);
+    COPY_PROPERTY_TO_JSON(PROP_ROTATION, rotation);
+    COPY_PROPERTY_TO_JSON(PROP_VELOCITY, velocity);
+    COPY_PROPERTY_TO_JSON(PROP_GRAVITY, gravity);
+    COPY_PROPERTY_TO_JSON(PROP_ACCELERATION, acceleration);
+    COPY_PROPERTY_TO_JSON(PROP_DAMPING, damping);
+    COPY_PROPERTY_TO_JSON(PROP_RESTITUTION, restitution);
+    COPY_PROPERTY_TO_JSON(PROP_FRICTION, friction);
+    COPY_PROPERTY_TO_JSON(PROP_DENSITY, density);
+    COPY_PROPERTY_TO_JSON(PROP_LIFETIME, lifetime);
+    COPY_PROPERTY_TO_JSON(PROP_SCRIPT, script);
+    COPY_PROPERTY_TO_JSON(PROP_SCRIPT_TIMESTAMP, scriptTimestamp);
+    COPY_PROPERTY_TO_JSON(PROP_REGISTRATION_POINT, registrationPoint);
+    COPY_PROPERTY_TO_JSON(PROP_ANGULAR_VELOCITY, angularVelocity);
+    COPY_PROPERTY_TO_JSON(PROP_ANGULAR_DAMPING, angularDamping);
+    COPY_PROPERTY_TO_JSON(PROP_VISIBLE, visible);
+    COPY_PROPERTY_TO_JSON(PROP_COLLISIONLESS, collisionless);
+    COPY_PROXY_PROPERTY_TO_JSON_GETTER(PROP_COLLISIONLESS, collisionless, ignoreForCollisions, getCollisionless()); // legacy support
+    COPY_PROPERTY_TO_JSON(PROP_COLLISION_MASK, collisionMask);
+    COPY_PROXY_PROPERTY_TO_JSON_GETTER(PROP_COLLISION_MASK, collisionMask, collidesWith, getCollisionMaskAsString());
+    COPY_PROPERTY_TO_JSON(PROP_DYNAMIC, dynamic);
+    COPY_PROXY_PROPERTY_TO_JSON_GETTER(PROP_DYNAMIC, dynamic, collisionsWillMove, getDynamic()); // legacy support
+    COPY_PROPERTY_TO_JSON(PROP_HREF, href);
+    COPY_PROPERTY_TO_JSON(PROP_DESCRIPTION, description);
+    COPY_PROPERTY_TO_JSON(PROP_FACE_CAMERA, faceCamera);
+    COPY_PROPERTY_TO_JSON(PROP_ACTION_DATA, actionData);
+    COPY_PROPERTY_TO_JSON(PROP_LOCKED, locked);
+    COPY_PROPERTY_TO_JSON(PROP_USER_DATA, userData);
+    COPY_PROPERTY_TO_JSON(PROP_MARKETPLACE_ID, marketplaceID);
+    COPY_PROPERTY_TO_JSON(PROP_NAME, name);
+    COPY_PROPERTY_TO_JSON(PROP_COLLISION_SOUND_URL, collisionSoundURL);
+
+    // Boxes, Spheres, Light, Line, Model(??), Particle, PolyLine
+    COPY_PROPERTY_TO_JSON(PROP_COLOR, color);
+
+    // Particles only
+    if (_type == EntityTypes::ParticleEffect) {
+        COPY_PROPERTY_TO_JSON(PROP_EMITTING_PARTICLES, isEmitting);
+        COPY_PROPERTY_TO_JSON(PROP_MAX_PARTICLES, maxParticles);
+        COPY_PROPERTY_TO_JSON(PROP_LIFESPAN, lifespan);
+        COPY_PROPERTY_TO_JSON(PROP_EMIT_RATE, emitRate);
+        COPY_PROPERTY_TO_JSON(PROP_EMIT_SPEED, emitSpeed);
+        COPY_PROPERTY_TO_JSON(PROP_SPEED_SPREAD, speedSpread);
+        COPY_PROPERTY_TO_JSON(PROP_EMIT_ORIENTATION, emitOrientation);
+        COPY_PROPERTY_TO_JSON(PROP_EMIT_DIMENSIONS, emitDimensions);
+        COPY_PROPERTY_TO_JSON(PROP_EMIT_RADIUS_START, emitRadiusStart);
+        COPY_PROPERTY_TO_JSON(PROP_POLAR_START, polarStart);
+        COPY_PROPERTY_TO_JSON(PROP_POLAR_FINISH, polarFinish);
+        COPY_PROPERTY_TO_JSON(PROP_AZIMUTH_START, azimuthStart);
+        COPY_PROPERTY_TO_JSON(PROP_AZIMUTH_FINISH, azimuthFinish);
+        COPY_PROPERTY_TO_JSON(PROP_EMIT_ACCELERATION, emitAcceleration);
+        COPY_PROPERTY_TO_JSON(PROP_ACCELERATION_SPREAD, accelerationSpread);
+        COPY_PROPERTY_TO_JSON(PROP_PARTICLE_RADIUS, particleRadius);
+        COPY_PROPERTY_TO_JSON(PROP_RADIUS_SPREAD, radiusSpread);
+        COPY_PROPERTY_TO_JSON(PROP_RADIUS_START, radiusStart);
+        COPY_PROPERTY_TO_JSON(PROP_RADIUS_FINISH, radiusFinish);
+        COPY_PROPERTY_TO_JSON(PROP_COLOR_SPREAD, colorSpread);
+        COPY_PROPERTY_TO_JSON(PROP_COLOR_START, colorStart);
+        COPY_PROPERTY_TO_JSON(PROP_COLOR_FINISH, colorFinish);
+        COPY_PROPERTY_TO_JSON(PROP_ALPHA, alpha);
+        COPY_PROPERTY_TO_JSON(PROP_ALPHA_SPREAD, alphaSpread);
+        COPY_PROPERTY_TO_JSON(PROP_ALPHA_START, alphaStart);
+        COPY_PROPERTY_TO_JSON(PROP_ALPHA_FINISH, alphaFinish);
+        COPY_PROPERTY_TO_JSON(PROP_EMITTER_SHOULD_TRAIL, emitterShouldTrail);
+    }
+
+    // Models only
+    if (_type == EntityTypes::Model) {
+        COPY_PROPERTY_TO_JSON(PROP_MODEL_URL, modelURL);
+        _animation.copyToJSON(_desiredProperties, writer, skipDefaults, defaultEntityProperties);
+        COPY_PROPERTY_TO_JSON(PROP_JOINT_ROTATIONS_SET, jointRotationsSet);
+        COPY_PROPERTY_TO_JSON(PROP_JOINT_ROTATIONS, jointRotations);
+        COPY_PROPERTY_TO_JSON(PROP_JOINT_TRANSLATIONS_SET, jointTranslationsSet);
+        COPY_PROPERTY_TO_JSON(PROP_JOINT_TRANSLATIONS, jointTranslations);
+    }
+
+    if (_type == EntityTypes::Model || _type == EntityTypes::Zone || _type == EntityTypes::ParticleEffect) {
+        COPY_PROPERTY_TO_JSON_GETTER(PROP_SHAPE_TYPE, shapeType, getShapeTypeAsString());
+    }
+    if (_type == EntityTypes::Box) {
+        COPY_PROPERTY_TO_JSON_GETTER(PROP_SHAPE_TYPE, shapeType, QString("Box"));
+    }
+    if (_type == EntityTypes::Sphere) {
+        COPY_PROPERTY_TO_JSON_GETTER(PROP_SHAPE_TYPE, shapeType, QString("Sphere"));
+    }
+    if (_type == EntityTypes::Box || _type == EntityTypes::Sphere || _type == EntityTypes::Shape) {
+        COPY_PROPERTY_TO_JSON(PROP_SHAPE, shape);
+    }
+
+    // FIXME - it seems like ParticleEffect should also support this
+    if (_type == EntityTypes::Model || _type == EntityTypes::Zone) {
+        COPY_PROPERTY_TO_JSON(PROP_COMPOUND_SHAPE_URL, compoundShapeURL);
+    }
+
+    // Models & Particles
+    if (_type == EntityTypes::Model || _type == EntityTypes::ParticleEffect) {
+        COPY_PROPERTY_TO_JSON(PROP_TEXTURES, textures);
+    }
+
+    // Lights only
+    if (_type == EntityTypes::Light) {
+        COPY_PROPERTY_TO_JSON(PROP_IS_SPOTLIGHT, isSpotlight);
+        COPY_PROPERTY_TO_JSON(PROP_INTENSITY, intensity);
+        COPY_PROPERTY_TO_JSON(PROP_FALLOFF_RADIUS, falloffRadius);
+        COPY_PROPERTY_TO_JSON(PROP_EXPONENT, exponent);
+        COPY_PROPERTY_TO_JSON(PROP_CUTOFF, cutoff);
+    }
+
+    // Text only
+    if (_type == EntityTypes::Text) {
+        COPY_PROPERTY_TO_JSON(PROP_TEXT, text);
+        COPY_PROPERTY_TO_JSON(PROP_LINE_HEIGHT, lineHeight);
+        COPY_PROPERTY_TO_JSON_GETTER(PROP_TEXT_COLOR, textColor, getTextColor());
+        COPY_PROPERTY_TO_JSON_GETTER(PROP_BACKGROUND_COLOR, backgroundColor, getBackgroundColor());
+    }
+
+    // Zones only
+    if (_type == EntityTypes::Zone) {
+        _keyLight.copyToJSON(_desiredProperties, writer, skipDefaults, defaultEntityProperties);
+
+        COPY_PROPERTY_TO_JSON_GETTER(PROP_BACKGROUND_MODE, backgroundMode, getBackgroundModeAsString());
+
+        _stage.copyToJSON(_desiredProperties, writer, skipDefaults, defaultEntityProperties);
+        _skybox.copyToJSON(_desiredProperties, writer, skipDefaults, defaultEntityProperties);
+
+        COPY_PROPERTY_TO_JSON(PROP_FLYING_ALLOWED, flyingAllowed);
+        COPY_PROPERTY_TO_JSON(PROP_GHOSTING_ALLOWED, ghostingAllowed);
+    }
+
+    // Web only
+    if (_type == EntityTypes::Web) {
+        COPY_PROPERTY_TO_JSON(PROP_SOURCE_URL, sourceUrl);
+        COPY_PROPERTY_TO_JSON(PROP_DPI, dpi);
+    }
+
+    // PolyVoxel only
+    if (_type == EntityTypes::PolyVox) {
+        COPY_PROPERTY_TO_JSON(PROP_VOXEL_VOLUME_SIZE, voxelVolumeSize);
+        COPY_PROPERTY_TO_JSON(PROP_VOXEL_DATA, voxelData);
+        COPY_PROPERTY_TO_JSON(PROP_VOXEL_SURFACE_STYLE, voxelSurfaceStyle);
+        COPY_PROPERTY_TO_JSON(PROP_X_TEXTURE_URL, xTextureURL);
+        COPY_PROPERTY_TO_JSON(PROP_Y_TEXTURE_URL, yTextureURL);
+        COPY_PROPERTY_TO_JSON(PROP_Z_TEXTURE_URL, zTextureURL);
+
+        COPY_PROPERTY_TO_JSON(PROP_X_N_NEIGHBOR_ID, xNNeighborID);
+        COPY_PROPERTY_TO_JSON(PROP_Y_N_NEIGHBOR_ID, yNNeighborID);
+        COPY_PROPERTY_TO_JSON(PROP_Z_N_NEIGHBOR_ID, zNNeighborID);
+
+        COPY_PROPERTY_TO_JSON(PROP_X_P_NEIGHBOR_ID, xPNeighborID);
+        COPY_PROPERTY_TO_JSON(PROP_Y_P_NEIGHBOR_ID, yPNeighborID);
+        COPY_PROPERTY_TO_JSON(PROP_Z_P_NEIGHBOR_ID, zPNeighborID);
+    }
+
+    // Lines & PolyLines
+    if (_type == EntityTypes::Line || _type == EntityTypes::PolyLine) {
+        COPY_PROPERTY_TO_JSON(PROP_LINE_WIDTH, lineWidth);
+        COPY_PROPERTY_TO_JSON(PROP_LINE_POINTS, linePoints);
+        COPY_PROPERTY_TO_JSON(PROP_NORMALS, normals);
+        COPY_PROPERTY_TO_JSON(PROP_STROKE_WIDTHS, strokeWidths);
+        COPY_PROPERTY_TO_JSON(PROP_TEXTURES, textures);
+    }
+
+    COPY_PROPERTY_TO_JSON(PROP_PARENT_ID, parentID);
+    COPY_PROPERTY_TO_JSON(PROP_PARENT_JOINT_INDEX, parentJointIndex);
+    COPY_PROPERTY_TO_JSON(PROP_QUERY_AA_CUBE, queryAACube);
+
+    COPY_PROPERTY_TO_JSON(PROP_LOCAL_POSITION, localPosition);
+    COPY_PROPERTY_TO_JSON(PROP_LOCAL_ROTATION, localRotation);
+    COPY_PROPERTY_TO_JSON(PROP_LOCAL_VELOCITY, localVelocity);
+    COPY_PROPERTY_TO_JSON(PROP_LOCAL_ANGULAR_VELOCITY, localAngularVelocity);
+
+    writer.writeMember("clientOnly", getClientOnly());
+    writer.key("owningAvatarID");
+    writeJSONValue(writer, getOwningAvatarID());
+
+    writer.endObject();
+}
+
+
+void EntityItemProperties::copyFromJSON(const QJsonObject& object) {
+    QJsonValue typeValue = object.value(QLatin1String("type"));
+    if (!typeValue.isUndefined()) {
+        setType(typeValue.toVariant().toString());
+    }
+
+    COPY_PROPERTY_FROM_JSON(position, glmVec3, setPosition);
+    COPY_PROPERTY_FROM_JSON(dimensions, glmVec3, setDimensions);
+    COPY_PROPERTY_FROM_JSON(rotation, glmQuat, setRotation);
+    COPY_PROPERTY_FROM_JSON(density, float, setDensity);
+    COPY_PROPERTY_FROM_JSON(velocity, glmVec3, setVelocity);
+    COPY_PROPERTY_FROM_JSON(gravity, glmVec3, setGravity);
+    COPY_PROPERTY_FROM_JSON(acceleration, glmVec3, setAcceleration);
+    COPY_PROPERTY_FROM_JSON(damping, float, setDamping);
+    COPY_PROPERTY_FROM_JSON(restitution, float, setRestitution);
+    COPY_PROPERTY_FROM_JSON(friction, float, setFriction);
+    COPY_PROPERTY_FROM_JSON(lifetime, float, setLifetime);
+    COPY_PROPERTY_FROM_JSON(script, QString, setScript);
+    COPY_PROPERTY_FROM_JSON(scriptTimestamp, quint64, setScriptTimestamp);
+    COPY_PROPERTY_FROM_JSON(registrationPoint, glmVec3, setRegistrationPoint);
+    COPY_PROPERTY_FROM_JSON(angularVelocity, glmVec3, setAngularVelocity);
+    COPY_PROPERTY_FROM_JSON(angularDamping, float, setAngularDamping);
+    COPY_PROPERTY_FROM_JSON(visible, bool, setVisible);
+    COPY_PROPERTY_FROM_JSON(color, xColor, setColor);
+    COPY_PROPERTY_FROM_JSON(colorSpread, xColor, setColorSpread);
+    COPY_PROPERTY_FROM_JSON(colorStart, xColor, setColorStart);
+    COPY_PROPERTY_FROM_JSON(colorFinish, xColor, setColorFinish);
+    COPY_PROPERTY_FROM_JSON(alpha, float, setAlpha);
+    COPY_PROPERTY_FROM_JSON(alphaSpread, float, setAlphaSpread);
+    COPY_PROPERTY_FROM_JSON(alphaStart, float, setAlphaStart);
+    COPY_PROPERTY_FROM_JSON(alphaFinish, float, setAlphaFinish);
+    COPY_PROPERTY_FROM_JSON(emitterShouldTrail , bool, setEmitterShouldTrail);
+    COPY_PROPERTY_FROM_JSON(modelURL, QString, setModelURL);
+    COPY_PROPERTY_FROM_JSON(compoundShapeURL, QString, setCompoundShapeURL);
+    COPY_PROPERTY_FROM_JSON(localRenderAlpha, float, setLocalRenderAlpha);
+    COPY_PROPERTY_FROM_JSON(collisionless, bool, setCollisionless);
+    COPY_PROPERTY_FROM_JSON_GETTER(ignoreForCollisions, bool, setCollisionless, getCollisionless); // legacy support
+    COPY_PROPERTY_FROM_JSON(collisionMask, uint8_t, setCollisionMask);
+    COPY_PROPERTY_FROM_JSON_ENUM(collidesWith, CollisionMask);
+    COPY_PROPERTY_FROM_JSON_GETTER(collisionsWillMove, bool, setDynamic, getDynamic); // legacy support
+    COPY_PROPERTY_FROM_JSON(dynamic, bool, setDynamic);
+    COPY_PROPERTY_FROM_JSON(isSpotlight, bool, setIsSpotlight);
+    COPY_PROPERTY_FROM_JSON(intensity, float, setIntensity);
+    COPY_PROPERTY_FROM_JSON(falloffRadius, float, setFalloffRadius);
+    COPY_PROPERTY_FROM_JSON(exponent, float, setExponent);
+    COPY_PROPERTY_FROM_JSON(cutoff, float, setCutoff);
+    COPY_PROPERTY_FROM_JSON(locked, bool, setLocked);
+    COPY_PROPERTY_FROM_JSON(textures, QString, setTextures);
+    COPY_PROPERTY_FROM_JSON(userData, QString, setUserData);
+    COPY_PROPERTY_FROM_JSON(text, QString, setText);
+    COPY_PROPERTY_FROM_JSON(lineHeight, float, setLineHeight);
+    COPY_PROPERTY_FROM_JSON(textColor, xColor, setTextColor);
+    COPY_PROPERTY_FROM_JSON(backgroundColor, xColor, setBackgroundColor);
+    COPY_PROPERTY_FROM_JSON_ENUM(shapeType, ShapeType);
+    COPY_PROPERTY_FROM_JSON(maxParticles, quint32, setMaxParticles);
+    COPY_PROPERTY_FROM_JSON(lifespan, float, setLifespan);
+    COPY_PROPERTY_FROM_JSON(isEmitting, bool, setIsEmitting);
+    COPY_PROPERTY_FROM_JSON(emitRate, float, setEmitRate);
+    COPY_PROPERTY_FROM_JSON(emitSpeed, float, setEmitSpeed);
+    COPY_PROPERTY_FROM_JSON(speedSpread, float, setSpeedSpread);
+    COPY_PROPERTY_FROM_JSON(emitOrientation, glmQuat, setEmitOrientation);
+    COPY_PROPERTY_FROM_JSON(emitDimensions, glmVec3, setEmitDimensions);
+    COPY_PROPERTY_FROM_JSON(emitRadiusStart, float, setEmitRadiusStart);
+    COPY_PROPERTY_FROM_JSON(polarStart, float, setPolarStart);
+    COPY_PROPERTY_FROM_JSON(polarFinish, float, setPolarFinish);
+    COPY_PROPERTY_FROM_JSON(azimuthStart, float, setAzimuthStart);
+    COPY_PROPERTY_FROM_JSON(azimuthFinish, float, setAzimuthFinish);
+    COPY_PROPERTY_FROM_JSON(emitAcceleration, glmVec3, setEmitAcceleration);
+    COPY_PROPERTY_FROM_JSON(accelerationSpread, glmVec3, setAccelerationSpread);
+    COPY_PROPERTY_FROM_JSON(particleRadius, float, setParticleRadius);
+    COPY_PROPERTY_FROM_JSON(radiusSpread, float, setRadiusSpread);
+    COPY_PROPERTY_FROM_JSON(radiusStart, float, setRadiusStart);
+    COPY_PROPERTY_FROM_JSON(radiusFinish, float, setRadiusFinish);
+    COPY_PROPERTY_FROM_JSON(marketplaceID, QString, setMarketplaceID);
+    COPY_PROPERTY_FROM_JSON(name, QString, setName);
+    COPY_PROPERTY_FROM_JSON(collisionSoundURL, QString, setCollisionSoundURL);
+
+    COPY_PROPERTY_FROM_JSON_ENUM(backgroundMode, BackgroundMode);
+    COPY_PROPERTY_FROM_JSON(sourceUrl, QString, setSourceUrl);
+    COPY_PROPERTY_FROM_JSON(voxelVolumeSize, glmVec3, setVoxelVolumeSize);
+    COPY_PROPERTY_FROM_JSON(voxelData, QByteArray, setVoxelData);
+    COPY_PROPERTY_FROM_JSON(voxelSurfaceStyle, uint16_t, setVoxelSurfaceStyle);
+    COPY_PROPERTY_FROM_JSON(lineWidth, float, setLineWidth);
+    COPY_PROPERTY_FROM_JSON(linePoints, qVectorVec3, setLinePoints);
+    COPY_PROPERTY_FROM_JSON(href, QString, setHref);
+    COPY_PROPERTY_FROM_JSON(description, QString, setDescription);
+    COPY_PROPERTY_FROM_JSON(faceCamera, bool, setFaceCamera);
+    COPY_PROPERTY_FROM_JSON(actionData, QByteArray, setActionData);
+    COPY_PROPERTY_FROM_JSON(normals, qVectorVec3, setNormals);
+    COPY_PROPERTY_FROM_JSON(strokeWidths,qVectorFloat, setStrokeWidths);
+
+    COPY_PROPERTY_FROM_JSON_GETTER(created, QDateTime, setCreated, [this]() {
+            auto result = QDateTime::fromMSecsSinceEpoch(_created / 1000, Qt::UTC); // usec per msec
+            return result;
+        });
+
+    _animation.copyFromJSON(object, _defaultSettings);
+    _keyLight.copyFromJSON(object, _defaultSettings);
+    _skybox.copyFromJSON(object, _defaultSettings);
+    _stage.copyFromJSON(object, _defaultSettings);
+
+    COPY_PROPERTY_FROM_JSON(xTextureURL, QString, setXTextureURL);
+    COPY_PROPERTY_FROM_JSON(yTextureURL, QString, setYTextureURL);
+    COPY_PROPERTY_FROM_JSON(zTextureURL, QString, setZTextureURL);
+
+    COPY_PROPERTY_FROM_JSON(xNNeighborID, EntityItemID, setXNNeighborID);
+    COPY_PROPERTY_FROM_JSON(yNNeighborID, EntityItemID, setYNNeighborID);
+    COPY_PROPERTY_FROM_JSON(zNNeighborID, EntityItemID, setZNNeighborID);
+
+    COPY_PROPERTY_FROM_JSON(xPNeighborID, EntityItemID, setXPNeighborID);
+    COPY_PROPERTY_FROM_JSON(yPNeighborID, EntityItemID, setYPNeighborID);
+    COPY_PROPERTY_FROM_JSON(zPNeighborID, EntityItemID, setZPNeighborID);
+
+    COPY_PROPERTY_FROM_JSON(parentID, QUuid, setParentID);
+    COPY_PROPERTY_FROM_JSON(parentJointIndex, quint16, setParentJointIndex);
+    COPY_PROPERTY_FROM_JSON(queryAACube, AACube, setQueryAACube);
+
+    COPY_PROPERTY_FROM_JSON(localPosition, glmVec3, setLocalPosition);
+    COPY_PROPERTY_FROM_JSON(localRotation, glmQuat, setLocalRotation);
+    COPY_PROPERTY_FROM_JSON(localVelocity, glmVec3, setLocalVelocity);
+    COPY_PROPERTY_FROM_JSON(localAngularVelocity, glmVec3, setLocalAngularVelocity);
+
+    COPY_PROPERTY_FROM_JSON(jointRotationsSet, qVectorBool, setJointRotationsSet);
+    COPY_PROPERTY_FROM_JSON(jointRotations, qVectorQuat, setJointRotations);
+    COPY_PROPERTY_FROM_JSON(jointTranslationsSet, qVectorBool, setJointTranslationsSet);
+    COPY_PROPERTY_FROM_JSON(jointTranslations, qVectorVec3, setJointTranslations);
+    COPY_PROPERTY_FROM_JSON(shape, QString, setShape);
+
+    COPY_PROPERTY_FROM_JSON(flyingAllowed, bool, setFlyingAllowed);
+    COPY_PROPERTY_FROM_JSON(ghostingAllowed, bool, setGhostingAllowed);
+
+    COPY_PROPERTY_FROM_JSON(clientOnly, bool, setClientOnly);
+    COPY_PROPERTY_FROM_JSON(owningAvatarID, QUuid, setOwningAvatarID);
+
+    COPY_PROPERTY_FROM_JSON(dpi, uint16_t, setDPI);
+
+    _lastEdited = usecTimestampNow();
+}
+
 QScriptValue EntityItemPropertiesToScriptValue(QScriptEngine* engine, const EntityItemProperties& properties) {
     return properties.copyToScriptValue(engine, false);
 }
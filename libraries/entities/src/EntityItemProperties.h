@@ -75,6 +75,12 @@ public:
     virtual QScriptValue copyToScriptValue(QScriptEngine* engine, bool skipDefaults) const;
     virtual void copyFromScriptValue(const QScriptValue& object, bool honorReadOnly);
 
+    // The same properties as the script value of a save or an export, but written as JSON and read back from it without
+    // a script engine. The values scripts can only get, like the age or the bounding box, are left out. copyFromJSON
+    // sets the read only properties too, as EntityItemPropertiesFromScriptValueIgnoreReadOnly.
+    void copyToJSON(JSONWriter& writer, bool skipDefaults) const;
+    void copyFromJSON(const QJsonObject& object);
+
     static QScriptValue entityPropertyFlagsToScriptValue(QScriptEngine* engine, const EntityPropertyFlags& flags);
     static void entityPropertyFlagsFromScriptValue(const QScriptValue& object, EntityPropertyFlags& flags);
 
@@ -14,8 +14,11 @@
 #define hifi_EntityItemPropertiesMacros_h
 
 #include <QDateTime>
+#include <QJsonArray>
+#include <QJsonObject>
 
 #include "EntityItemID.h"
+#include <JSONWriter.h>
 #include <RegisteredMetaTypes.h>
 
 #define APPEND_ENTITY_PROPERTY(P,V) \
@@ -367,6 +370,327 @@ inline xColor xColor_convertFromScriptValue(const QScriptValue& v, bool& isValid
         }                                                         \
     }
 
+// The JSON of the properties, as the script values of them turn out once converted to JSON, for saves and exports
+// that go straight to JSON without a script engine
+inline void writeJSONValue(JSONWriter& w, float v) { w.write(v); }
+inline void writeJSONValue(JSONWriter& w, int v) { w.write(v); }
+inline void writeJSONValue(JSONWriter& w, bool v) { w.write(v); }
+inline void writeJSONValue(JSONWriter& w, quint16 v) { w.write((int)v); }
+inline void writeJSONValue(JSONWriter& w, quint32 v) { w.write((qint64)v); }
+inline void writeJSONValue(JSONWriter& w, quint64 v) { w.write(v); }
+inline void writeJSONValue(JSONWriter& w, const QString& v) { w.write(v); }
+inline void writeJSONValue(JSONWriter& w, const QByteArray& v) { w.write(QString(v.toBase64())); }
+inline void writeJSONValue(JSONWriter& w, const QUuid& v) { w.write(v.toString()); }
+inline void writeJSONValue(JSONWriter& w, const EntityItemID& v) { w.write(QUuid(v).toString()); }
+
+inline void writeJSONValue(JSONWriter& w, const glm::vec3& v) {
+    w.beginObject();
+    w.writeMember("x", v.x);
+    w.writeMember("y", v.y);
+    w.writeMember("z", v.z);
+    w.endObject();
+}
+
+inline void writeJSONValue(JSONWriter& w, const glm::quat& v) {
+    w.beginObject();
+    w.writeMember("x", v.x);
+    w.writeMember("y", v.y);
+    w.writeMember("z", v.z);
+    w.writeMember("w", v.w);
+    w.endObject();
+}
+
+inline void writeJSONValue(JSONWriter& w, const xColor& v) {
+    w.beginObject();
+    w.writeMember("red", (int)v.red);
+    w.writeMember("green", (int)v.green);
+    w.writeMember("blue", (int)v.blue);
+    w.endObject();
+}
+
+inline void writeJSONValue(JSONWriter& w, const AACube& v) {
+    const glm::vec3& corner = v.getCorner();
+    w.beginObject();
+    w.writeMember("x", corner.x);
+    w.writeMember("y", corner.y);
+    w.writeMember("z", corner.z);
+    w.writeMember("scale", v.getScale());
+    w.endObject();
+}
+
+template <typename T> inline void writeJSONValue(JSONWriter& w, const QVector<T>& v) {
+    w.beginArray();
+    for (const auto& element : v) {
+        writeJSONValue(w, element);
+    }
+    w.endArray();
+}
+
+#define COPY_GROUP_PROPERTY_TO_JSON(X,G,g,P,p) \
+    if ((desiredProperties.isEmpty() || desiredProperties.getHasProperty(X)) && \
+        (!skipDefaults || defaultEntityProperties.get##G().get##P() != get##P())) { \
+        writer.key(#p); \
+        writeJSONValue(writer, get##P()); \
+    }
+
+#define COPY_GROUP_PROPERTY_TO_JSON_GETTER(X,G,g,P,p,M) \
+    if ((desiredProperties.isEmpty() || desiredProperties.getHasProperty(X)) && \
+        (!skipDefaults || defaultEntityProperties.get##G().get##P() != get##P())) { \
+        writer.key(#p); \
+        writeJSONValue(writer, M()); \
+    }
+
+#define COPY_PROPERTY_TO_JSON(p,P) \
+    if ((_desiredProperties.isEmpty() || _desiredProperties.getHasProperty(p)) && \
+        (!skipDefaults || defaultEntityProperties._##P != _##P)) { \
+        writer.key(#P); \
+        writeJSONValue(writer, _##P); \
+    }
+
+#define COPY_PROPERTY_TO_JSON_GETTER(p, P, G) \
+    if ((_desiredProperties.isEmpty() || _desiredProperties.getHasProperty(p)) && \
+        (!skipDefaults || defaultEntityProperties._##P != _##P)) { \
+        writer.key(#P); \
+        writeJSONValue(writer, G); \
+    }
+
+#define COPY_PROXY_PROPERTY_TO_JSON_GETTER(p, P, X, G) \
+    if ((_desiredProperties.isEmpty() || _desiredProperties.getHasProperty(p)) && \
+        (!skipDefaults || defaultEntityProperties._##P != _##P)) { \
+        writer.key(#X); \
+        writeJSONValue(writer, G); \
+    }
+
+#define COPY_PROPERTY_TO_JSON_GETTER_ALWAYS(P, G) \
+    if (!skipDefaults || defaultEntityProperties._##P != _##P) { \
+        writer.key(#P); \
+        writeJSONValue(writer, G); \
+    }
+
+// and back, as the script values of the JSON would have converted
+inline float jsonToFloat(const QJsonValue& v, bool& isValid) {
+    if (v.isDouble()) {
+        isValid = true;
+        return (float)v.toDouble();
+    }
+    return v.toVariant().toFloat(&isValid);
+}
+
+inline float float_convertFromJSONValue(const QJsonValue& v, bool& isValid) { return jsonToFloat(v, isValid); }
+inline quint64 quint64_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    if (v.isDouble()) {
+        isValid = v.toDouble() >= 0.0;
+        return isValid ? (quint64)v.toDouble() : 0;
+    }
+    return v.toVariant().toULongLong(&isValid);
+}
+inline quint32 quint32_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    if (v.isDouble()) {
+        double value = v.toDouble();
+        isValid = value >= 0.0 && value <= (double)UINT32_MAX && value == (quint32)value;
+        return isValid ? (quint32)value : 0;
+    }
+    return v.toString().toUInt(&isValid);
+}
+inline int int_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    if (v.isDouble()) {
+        isValid = true;
+        return (int)v.toDouble();
+    }
+    return v.toVariant().toInt(&isValid);
+}
+inline quint16 quint16_convertFromJSONValue(const QJsonValue& v, bool& isValid) { return int_convertFromJSONValue(v, isValid); }
+inline uint16_t uint16_t_convertFromJSONValue(const QJsonValue& v, bool& isValid) { return int_convertFromJSONValue(v, isValid); }
+inline bool bool_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    return v.isBool() ? v.toBool() : v.toVariant().toBool();
+}
+inline uint8_t uint8_t_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    return (uint8_t)(0xff & int_convertFromJSONValue(v, isValid));
+}
+inline QString QString_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    return (v.isString() ? v.toString() : v.toVariant().toString()).trimmed();
+}
+inline QUuid QUuid_convertFromJSONValue(const QJsonValue& v, bool& isValid) { isValid = true; return QUuid(v.toString()); }
+inline EntityItemID EntityItemID_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    return QUuid(v.toString());
+}
+inline QDateTime QDateTime_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    return QDateTime::fromString(QString_convertFromJSONValue(v, isValid), Qt::ISODate);
+}
+inline QByteArray QByteArray_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    return QByteArray::fromBase64(QString_convertFromJSONValue(v, isValid).toUtf8());
+}
+
+// a missing or unreadable component is 0, as in vec3FromScriptValue
+inline float jsonComponent(const QJsonObject& object, const char* name) {
+    bool isValid;
+    return jsonToFloat(object.value(QLatin1String(name)), isValid);
+}
+
+inline glmVec3 glmVec3_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    QJsonObject object = v.toObject();
+    isValid = object.contains(QLatin1String("x")) && object.contains(QLatin1String("y")) &&
+        object.contains(QLatin1String("z"));
+    if (!isValid) {
+        return glm::vec3(0);
+    }
+    glm::vec3 newValue(jsonComponent(object, "x"), jsonComponent(object, "y"), jsonComponent(object, "z"));
+    isValid = !glm::isnan(newValue.x) && !glm::isnan(newValue.y) && !glm::isnan(newValue.z);
+    return isValid ? newValue : glm::vec3(0);
+}
+
+inline glmQuat glmQuat_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    QJsonObject object = v.toObject();
+    isValid = object.contains(QLatin1String("x")) && object.contains(QLatin1String("y")) &&
+        object.contains(QLatin1String("z")) && object.contains(QLatin1String("w"));
+    if (!isValid) {
+        return glm::quat();
+    }
+    glm::quat newValue(jsonComponent(object, "w"), jsonComponent(object, "x"), jsonComponent(object, "y"),
+        jsonComponent(object, "z"));
+    isValid = !glm::isnan(newValue.x) && !glm::isnan(newValue.y) && !glm::isnan(newValue.z) && !glm::isnan(newValue.w);
+    return isValid ? newValue : glm::quat();
+}
+
+inline xColor xColor_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    xColor newValue { 255, 255, 255 };
+    QJsonObject object = v.toObject();
+    isValid = object.contains(QLatin1String("red")) && object.contains(QLatin1String("green")) &&
+        object.contains(QLatin1String("blue"));
+    if (isValid) {
+        bool componentIsValid;
+        newValue.red = int_convertFromJSONValue(object.value(QLatin1String("red")), componentIsValid);
+        newValue.green = int_convertFromJSONValue(object.value(QLatin1String("green")), componentIsValid);
+        newValue.blue = int_convertFromJSONValue(object.value(QLatin1String("blue")), componentIsValid);
+    }
+    return newValue;
+}
+
+inline AACube AACube_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    QJsonObject object = v.toObject();
+    glm::vec3 corner(jsonComponent(object, "x"), jsonComponent(object, "y"), jsonComponent(object, "z"));
+    return AACube(corner, jsonComponent(object, "scale"));
+}
+
+inline qVectorFloat qVectorFloat_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    qVectorFloat newVector;
+    QJsonArray array = v.toArray();
+    newVector.reserve(array.size());
+    for (const auto& element : array) {
+        // only the numbers, as qVectorFloatFromScriptValue
+        if (element.isDouble()) {
+            newVector << (float)element.toDouble();
+        }
+    }
+    return newVector;
+}
+
+inline qVectorVec3 qVectorVec3_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    qVectorVec3 newVector;
+    QJsonArray array = v.toArray();
+    newVector.reserve(array.size());
+    for (const auto& element : array) {
+        QJsonObject object = element.toObject();
+        newVector << glm::vec3(jsonComponent(object, "x"), jsonComponent(object, "y"), jsonComponent(object, "z"));
+    }
+    return newVector;
+}
+
+inline qVectorQuat qVectorQuat_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    qVectorQuat newVector;
+    QJsonArray array = v.toArray();
+    newVector.reserve(array.size());
+    for (const auto& element : array) {
+        QJsonObject object = element.toObject();
+        newVector << glm::quat(jsonComponent(object, "w"), jsonComponent(object, "x"), jsonComponent(object, "y"),
+            jsonComponent(object, "z"));
+    }
+    return newVector;
+}
+
+inline qVectorBool qVectorBool_convertFromJSONValue(const QJsonValue& v, bool& isValid) {
+    isValid = true;
+    qVectorBool newVector;
+    QJsonArray array = v.toArray();
+    newVector.reserve(array.size());
+    for (const auto& element : array) {
+        bool elementIsValid;
+        newVector << bool_convertFromJSONValue(element, elementIsValid);
+    }
+    return newVector;
+}
+
+#define COPY_PROPERTY_FROM_JSON(P, T, S)                             \
+    {                                                                \
+        QJsonValue V = object.value(QLatin1String(#P));              \
+        if (!V.isUndefined()) {                                      \
+            bool isValid = false;                                    \
+            T newValue = T##_convertFromJSONValue(V, isValid);       \
+            if (isValid && (_defaultSettings || newValue != _##P)) { \
+                S(newValue);                                         \
+            }                                                        \
+        }                                                            \
+    }
+
+#define COPY_PROPERTY_FROM_JSON_GETTER(P, T, S, G)                   \
+    {                                                                \
+        QJsonValue V = object.value(QLatin1String(#P));              \
+        if (!V.isUndefined()) {                                      \
+            bool isValid = false;                                    \
+            T newValue = T##_convertFromJSONValue(V, isValid);       \
+            if (isValid && (_defaultSettings || newValue != G())) {  \
+                S(newValue);                                         \
+            }                                                        \
+        }                                                            \
+    }
+
+#define COPY_PROPERTY_FROM_JSON_NOCHECK(P, T, S)                     \
+    {                                                                \
+        QJsonValue V = object.value(QLatin1String(#P));              \
+        if (!V.isUndefined()) {                                      \
+            bool isValid = false;                                    \
+            T newValue = T##_convertFromJSONValue(V, isValid);       \
+            if (isValid && (_defaultSettings)) {                     \
+                S(newValue);                                         \
+            }                                                        \
+        }                                                            \
+    }
+
+#define COPY_GROUP_PROPERTY_FROM_JSON(G, P, T, S)                            \
+    {                                                                        \
+        QJsonValue G = object.value(QLatin1String(#G));                      \
+        if (G.isObject()) {                                                  \
+            QJsonValue V = G.toObject().value(QLatin1String(#P));            \
+            if (!V.isUndefined()) {                                          \
+                bool isValid = false;                                        \
+                T newValue = T##_convertFromJSONValue(V, isValid);           \
+                if (isValid && (_defaultSettings || newValue != _##P)) {     \
+                    S(newValue);                                             \
+                }                                                            \
+            }                                                                \
+        }                                                                    \
+    }
+
+#define COPY_PROPERTY_FROM_JSON_ENUM(P, S)                                 \
+    {                                                                      \
+        QJsonValue V = object.value(QLatin1String(#P));                    \
+        if (!V.isUndefined()) {                                            \
+            QString newValue = V.isString() ? V.toString() : V.toVariant().toString(); \
+            if (_defaultSettings || newValue != get##S##AsString()) {      \
+                set##S##FromString(newValue);                              \
+            }                                                              \
+        }                                                                  \
+    }
+
 #define DEFINE_PROPERTY_GROUP(N, n, T)           \
     public:                                      \
         const T& get##N() const { return _##n; } \
@@ -114,55 +114,59 @@ EntityItemProperties convertLocationToScriptSemantics(const EntityItemProperties
 }
 
 
-EntityItemProperties convertLocationFromScriptSemantics(const EntityItemProperties& scriptSideProperties) {
-    // convert position and rotation properties from world-space to local, unless localPosition and localRotation
-    // are set.  If they are set, they overwrite position and rotation.
-    EntityItemProperties entitySideProperties = scriptSideProperties;
+// converts position and rotation properties from world-space to local, unless localPosition and localRotation
+// are set.  If they are set, they overwrite position and rotation.  This changes the properties where they are,
+// for the edit path, which would otherwise copy them twice.
+void convertLocationFromScriptSemanticsInPlace(EntityItemProperties& properties) {
     bool success;
 
     // TODO -- handle velocity and angularVelocity
 
-    if (scriptSideProperties.localPositionChanged()) {
-        entitySideProperties.setPosition(scriptSideProperties.getLocalPosition());
-    } else if (scriptSideProperties.positionChanged()) {
-        glm::vec3 localPosition = SpatiallyNestable::worldToLocal(entitySideProperties.getPosition(),
-                                                                  entitySideProperties.getParentID(),
-                                                                  entitySideProperties.getParentJointIndex(),
+    if (properties.localPositionChanged()) {
+        properties.setPosition(properties.getLocalPosition());
+    } else if (properties.positionChanged()) {
+        glm::vec3 localPosition = SpatiallyNestable::worldToLocal(properties.getPosition(),
+                                                                  properties.getParentID(),
+                                                                  properties.getParentJointIndex(),
                                                                   success);
-        entitySideProperties.setPosition(localPosition);
+        properties.setPosition(localPosition);
     }
 
-    if (scriptSideProperties.localRotationChanged()) {
-        entitySideProperties.setRotation(scriptSideProperties.getLocalRotation());
-    } else if (scriptSideProperties.rotationChanged()) {
-        glm::quat localRotation = SpatiallyNestable::worldToLocal(entitySideProperties.getRotation(),
-                                                                  entitySideProperties.getParentID(),
-                                                                  entitySideProperties.getParentJointIndex(),
+    if (properties.localRotationChanged()) {
+        properties.setRotation(properties.getLocalRotation());
+    } else if (properties.rotationChanged()) {
+        glm::quat localRotation = SpatiallyNestable::worldToLocal(properties.getRotation(),
+                                                                  properties.getParentID(),
+                                                                  properties.getParentJointIndex(),
                                                                   success);
-        entitySideProperties.setRotation(localRotation);
+        properties.setRotation(localRotation);
     }
 
-    if (scriptSideProperties.localVelocityChanged()) {
-        entitySideProperties.setVelocity(scriptSideProperties.getLocalVelocity());
-    } else if (scriptSideProperties.velocityChanged()) {
-        glm::vec3 localVelocity = SpatiallyNestable::worldToLocalVelocity(entitySideProperties.getVelocity(),
-                                                                          entitySideProperties.getParentID(),
-                                                                          entitySideProperties.getParentJointIndex(),
+    if (properties.localVelocityChanged()) {
+        properties.setVelocity(properties.getLocalVelocity());
+    } else if (properties.velocityChanged()) {
+        glm::vec3 localVelocity = SpatiallyNestable::worldToLocalVelocity(properties.getVelocity(),
+                                                                          properties.getParentID(),
+                                                                          properties.getParentJointIndex(),
                                                                           success);
-        entitySideProperties.setVelocity(localVelocity);
+        properties.setVelocity(localVelocity);
     }
 
-    if (scriptSideProperties.localAngularVelocityChanged()) {
-        entitySideProperties.setAngularVelocity(scriptSideProperties.getLocalAngularVelocity());
-    } else if (scriptSideProperties.angularVelocityChanged()) {
+    if (properties.localAngularVelocityChanged()) {
+        properties.setAngularVelocity(properties.getLocalAngularVelocity());
+    } else if (properties.angularVelocityChanged()) {
         glm::vec3 localAngularVelocity =
-            SpatiallyNestable::worldToLocalAngularVelocity(entitySideProperties.getAngularVelocity(),
-                                                           entitySideProperties.getParentID(),
-                                                           entitySideProperties.getParentJointIndex(),
+            SpatiallyNestable::worldToLocalAngularVelocity(properties.getAngularVelocity(),
+                                                           properties.getParentID(),
+                                                           properties.getParentJointIndex(),
                                                            success);
-        entitySideProperties.setAngularVelocity(localAngularVelocity);
+        properties.setAngularVelocity(localAngularVelocity);
     }
+}
 
+EntityItemProperties convertLocationFromScriptSemantics(const EntityItemProperties& scriptSideProperties) {
+    EntityItemProperties entitySideProperties = scriptSideProperties;
+    convertLocationFromScriptSemanticsInPlace(entitySideProperties);
     return entitySideProperties;
 }
 
@@ -264,44 +268,70 @@ EntityItemProperties EntityScriptingInterface::getEntityProperties(QUuid identit
         _entityTree->withReadLock([&] {
             EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(identity));
             if (entity) {
-                if (desiredProperties.getHasProperty(PROP_POSITION) ||
-                    desiredProperties.getHasProperty(PROP_ROTATION) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_ROTATION)) {
-                    // if we are explicitly getting position or rotation, we need parent information to make sense of them.
-                    desiredProperties.setHasProperty(PROP_PARENT_ID);
-                    desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
-                }
+                results = getEntityPropertiesInTree(entity, desiredProperties);
+            }
+        });
+    }
 
-                if (desiredProperties.isEmpty()) {
-                    // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
-                    // don't end up in json saves, etc.  We still want them here, though.
-                    EncodeBitstreamParams params; // unknown
-                    desiredProperties = entity->getEntityProperties(params);
-                    desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
-                    desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
-                 }
-
-                results = entity->getProperties(desiredProperties);
-
-                // TODO: improve sitting points and naturalDimensions in the future,
-                //       for now we've included the old sitting points model behavior for entity types that are models
-                //        we've also added this hack for setting natural dimensions of models
-                if (entity->getType() == EntityTypes::Model) {
-                    const FBXGeometry* geometry = _entityTree->getGeometryForEntity(entity);
-                    if (geometry) {
-                        results.setSittingPoints(geometry->sittingPoints);
-                        Extents meshExtents = geometry->getUnscaledMeshExtents();
-                        results.setNaturalDimensions(meshExtents.maximum - meshExtents.minimum);
-                        results.calculateNaturalPosition(meshExtents.minimum, meshExtents.maximum);
-                    }
-                }
+    return convertLocationToScriptSemantics(results);
+}
 
+QVector<EntityItemProperties> EntityScriptingInterface::getEntitiesProperties(const QVector<QUuid>& entityIDs,
+                                                                              EntityPropertyFlags desiredProperties) {
+    QVector<EntityItemProperties> results(entityIDs.size());
+    if (_entityTree) {
+        _entityTree->withReadLock([&] {
+            for (int i = 0; i < entityIDs.size(); i++) {
+                EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityIDs[i]));
+                if (entity) {
+                    results[i] = getEntityPropertiesInTree(entity, desiredProperties);
+                }
             }
         });
     }
 
-    return convertLocationToScriptSemantics(results);
+    for (auto& properties : results) {
+        properties = convertLocationToScriptSemantics(properties);
+    }
+    return results;
+}
+
+EntityItemProperties EntityScriptingInterface::getEntityPropertiesInTree(const EntityItemPointer& entity,
+                                                                         EntityPropertyFlags desiredProperties) {
+    if (desiredProperties.getHasProperty(PROP_POSITION) ||
+        desiredProperties.getHasProperty(PROP_ROTATION) ||
+        desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
+        desiredProperties.getHasProperty(PROP_LOCAL_ROTATION)) {
+        // if we are explicitly getting position or rotation, we need parent information to make sense of them.
+        desiredProperties.setHasProperty(PROP_PARENT_ID);
+        desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
+    }
+
+    if (desiredProperties.isEmpty()) {
+        // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
+        // don't end up in json saves, etc.  We still want them here, though.
+        EncodeBitstreamParams params; // unknown
+        desiredProperties = entity->getEntityProperties(params);
+        desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
+        desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
+    }
+
+    EntityItemProperties results = entity->getProperties(desiredProperties);
+
+    // TODO: improve sitting points and naturalDimensions in the future,
+    //       for now we've included the old sitting points model behavior for entity types that are models
+    //        we've also added this hack for setting natural dimensions of models
+    if (entity->getType() == EntityTypes::Model) {
+        const FBXGeometry* geometry = _entityTree->getGeometryForEntity(entity);
+        if (geometry) {
+            results.setSittingPoints(geometry->sittingPoints);
+            Extents meshExtents = geometry->getUnscaledMeshExtents();
+            results.setNaturalDimensions(meshExtents.maximum - meshExtents.minimum);
+            results.calculateNaturalPosition(meshExtents.minimum, meshExtents.maximum);
+        }
+    }
+
+    return results;
 }
 
 QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties& scriptSideProperties) {
@@ -336,117 +366,163 @@ QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties&
 
     bool updatedEntity = false;
     _entityTree->withWriteLock([&] {
-        EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (!entity) {
-            return;
+        updatedEntity = editEntityInTree(entityID, scriptSideProperties, properties);
+    });
+    if (!updatedEntity) {
+        return QUuid();
+    }
+    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
+    return id;
+}
+
+QVector<QUuid> EntityScriptingInterface::editEntities(const QScriptValue& edits) {
+    // [ { id, properties } ]
+    quint32 length = edits.property("length").toUInt32();
+    QVector<QUuid> results(length);
+    if (!_entityTree) {
+        for (quint32 i = 0; i < length; i++) {
+            QScriptValue edit = edits.property(i);
+            results[i] = editEntity(edit.property("id").toVariant().toUuid(),
+                qscriptvalue_cast<EntityItemProperties>(edit.property("properties")));
         }
+        return results;
+    }
 
-        auto nodeList = DependencyManager::get<NodeList>();
-        if (entity->getClientOnly() && entity->getOwningAvatarID() != nodeList->getSessionUUID()) {
-            // don't edit other avatar's avatarEntities
-            return;
+    QVector<EntityItemProperties> editedProperties(length);
+    _entityTree->withWriteLock([&] {
+        for (quint32 i = 0; i < length; i++) {
+            QScriptValue edit = edits.property(i);
+            QUuid id = edit.property("id").toVariant().toUuid();
+            EntityItemProperties scriptSideProperties = qscriptvalue_cast<EntityItemProperties>(edit.property("properties"));
+            _activityTracking.editedEntityCount++;
+            editedProperties[i] = scriptSideProperties;
+            if (editEntityInTree(EntityItemID(id), scriptSideProperties, editedProperties[i])) {
+                results[i] = id;
+            }
         }
+    });
+    // the edits of the same server go out in the same packets, see OctreeEditPacketSender
+    for (quint32 i = 0; i < length; i++) {
+        if (!results[i].isNull()) {
+            queueEntityMessage(PacketType::EntityEdit, EntityItemID(results[i]), editedProperties[i]);
+        }
+    }
+    return results;
+}
+
+bool EntityScriptingInterface::editEntityInTree(const EntityItemID& entityID, const EntityItemProperties& scriptSideProperties,
+                                                EntityItemProperties& properties) {
+    auto dimensions = properties.getDimensions();
+    float volume = dimensions.x * dimensions.y * dimensions.z;
+    auto density = properties.getDensity();
+    auto newVelocity = properties.getVelocity().length();
+    float oldVelocity = { 0.0f };
+
+    EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
+    if (!entity) {
+        return false;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (entity->getClientOnly() && entity->getOwningAvatarID() != nodeList->getSessionUUID()) {
+        // don't edit other avatar's avatarEntities
+        return false;
+    }
 
-        if (scriptSideProperties.parentRelatedPropertyChanged()) {
-            // All of parentID, parentJointIndex, position, rotation are needed to make sense of any of them.
-            // If any of these changed, pull any missing properties from the entity.
+    if (scriptSideProperties.parentRelatedPropertyChanged()) {
+        // All of parentID, parentJointIndex, position, rotation are needed to make sense of any of them.
+        // If any of these changed, pull any missing properties from the entity.
 
-            //existing entity, retrieve old velocity for check down below
-            oldVelocity = entity->getVelocity().length();
+        //existing entity, retrieve old velocity for check down below
+        oldVelocity = entity->getVelocity().length();
 
-            if (!scriptSideProperties.parentIDChanged()) {
-                properties.setParentID(entity->getParentID());
-            }
-            if (!scriptSideProperties.parentJointIndexChanged()) {
-                properties.setParentJointIndex(entity->getParentJointIndex());
-            }
-            if (!scriptSideProperties.localPositionChanged() && !scriptSideProperties.positionChanged()) {
-                properties.setPosition(entity->getPosition());
-            }
-            if (!scriptSideProperties.localRotationChanged() && !scriptSideProperties.rotationChanged()) {
-                properties.setRotation(entity->getOrientation());
-            }
+        if (!scriptSideProperties.parentIDChanged()) {
+            properties.setParentID(entity->getParentID());
+        }
+        if (!scriptSideProperties.parentJointIndexChanged()) {
+            properties.setParentJointIndex(entity->getParentJointIndex());
         }
-        properties = convertLocationFromScriptSemantics(properties);
-        properties.setClientOnly(entity->getClientOnly());
-        properties.setOwningAvatarID(entity->getOwningAvatarID());
+        if (!scriptSideProperties.localPositionChanged() && !scriptSideProperties.positionChanged()) {
+            properties.setPosition(entity->getPosition());
+        }
+        if (!scriptSideProperties.localRotationChanged() && !scriptSideProperties.rotationChanged()) {
+            properties.setRotation(entity->getOrientation());
+        }
+    }
+    convertLocationFromScriptSemanticsInPlace(properties);
+    properties.setClientOnly(entity->getClientOnly());
+    properties.setOwningAvatarID(entity->getOwningAvatarID());
 
-        float cost = calculateCost(density * volume, oldVelocity, newVelocity);
-        cost *= costMultiplier;
+    float cost = calculateCost(density * volume, oldVelocity, newVelocity);
+    cost *= costMultiplier;
 
-        if (cost > _currentAvatarEnergy) {
-            updatedEntity = false;
-        } else {
-            //debit the avatar energy and continue
-            updatedEntity = _entityTree->updateEntity(entityID, properties);
-            if (updatedEntity) {
-                emit debitEnergySource(cost);
-            }
+    bool updatedEntity = false;
+    if (cost > _currentAvatarEnergy) {
+        updatedEntity = false;
+    } else {
+        //debit the avatar energy and continue
+        updatedEntity = _entityTree->updateEntity(entityID, properties);
+        if (updatedEntity) {
+            emit debitEnergySource(cost);
         }
-    });
+    }
 
     if (!updatedEntity) {
-        return QUuid();
+        return false;
     }
 
-    _entityTree->withReadLock([&] {
-        EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (entity) {
-            // make sure the properties has a type, so that the encode can know which properties to include
-            properties.setType(entity->getType());
-            bool hasTerseUpdateChanges = properties.hasTerseUpdateChanges();
-            bool hasPhysicsChanges = properties.hasMiscPhysicsChanges() || hasTerseUpdateChanges;
-            if (_bidOnSimulationOwnership && hasPhysicsChanges) {
-                auto nodeList = DependencyManager::get<NodeList>();
-                const QUuid myNodeID = nodeList->getSessionUUID();
+    // make sure the properties has a type, so that the encode can know which properties to include
+    properties.setType(entity->getType());
+    bool hasTerseUpdateChanges = properties.hasTerseUpdateChanges();
+    bool hasPhysicsChanges = properties.hasMiscPhysicsChanges() || hasTerseUpdateChanges;
+    if (_bidOnSimulationOwnership && hasPhysicsChanges) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        const QUuid myNodeID = nodeList->getSessionUUID();
 
-                if (entity->getSimulatorID() == myNodeID) {
-                    // we think we already own the simulation, so make sure to send ALL TerseUpdate properties
-                    if (hasTerseUpdateChanges) {
-                        entity->getAllTerseUpdateProperties(properties);
-                    }
-                    // TODO: if we knew that ONLY TerseUpdate properties have changed in properties AND the object
-                    // is dynamic AND it is active in the physics simulation then we could chose to NOT queue an update
-                    // and instead let the physics simulation decide when to send a terse update.  This would remove
-                    // the "slide-no-rotate" glitch (and typical double-update) that we see during the "poke rolling
-                    // balls" test.  However, even if we solve this problem we still need to provide a "slerp the visible
-                    // proxy toward the true physical position" feature to hide the final glitches in the remote watcher's
-                    // simulation.
-
-                    if (entity->getSimulationPriority() < SCRIPT_POKE_SIMULATION_PRIORITY) {
-                        // we re-assert our simulation ownership at a higher priority
-                        properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
-                    }
-                } else {
-                    // we make a bid for simulation ownership
-                    properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
-                    entity->pokeSimulationOwnership();
-                }
+        if (entity->getSimulatorID() == myNodeID) {
+            // we think we already own the simulation, so make sure to send ALL TerseUpdate properties
+            if (hasTerseUpdateChanges) {
+                entity->getAllTerseUpdateProperties(properties);
             }
-            if (properties.parentRelatedPropertyChanged() && entity->computePuffedQueryAACube()) {
-                properties.setQueryAACube(entity->getQueryAACube());
+            // TODO: if we knew that ONLY TerseUpdate properties have changed in properties AND the object
+            // is dynamic AND it is active in the physics simulation then we could chose to NOT queue an update
+            // and instead let the physics simulation decide when to send a terse update.  This would remove
+            // the "slide-no-rotate" glitch (and typical double-update) that we see during the "poke rolling
+            // balls" test.  However, even if we solve this problem we still need to provide a "slerp the visible
+            // proxy toward the true physical position" feature to hide the final glitches in the remote watcher's
+            // simulation.
+
+            if (entity->getSimulationPriority() < SCRIPT_POKE_SIMULATION_PRIORITY) {
+                // we re-assert our simulation ownership at a higher priority
+                properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
+            }
+        } else {
+            // we make a bid for simulation ownership
+            properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
+            entity->pokeSimulationOwnership();
+        }
+    }
+    if (properties.parentRelatedPropertyChanged() && entity->computePuffedQueryAACube()) {
+        properties.setQueryAACube(entity->getQueryAACube());
+    }
+    entity->setLastBroadcast(usecTimestampNow());
+    properties.setLastEdited(entity->getLastEdited());
+
+    // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
+    // if they've changed.
+    entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+        if (descendant->getNestableType() == NestableType::Entity) {
+            if (descendant->computePuffedQueryAACube()) {
+                EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
+                EntityItemProperties newQueryCubeProperties;
+                newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
+                newQueryCubeProperties.setLastEdited(properties.getLastEdited());
+                queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
+                entityDescendant->setLastBroadcast(usecTimestampNow());
             }
-            entity->setLastBroadcast(usecTimestampNow());
-            properties.setLastEdited(entity->getLastEdited());
-
-            // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
-            // if they've changed.
-            entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
-                if (descendant->getNestableType() == NestableType::Entity) {
-                    if (descendant->computePuffedQueryAACube()) {
-                        EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
-                        EntityItemProperties newQueryCubeProperties;
-                        newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
-                        newQueryCubeProperties.setLastEdited(properties.getLastEdited());
-                        queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
-                        entityDescendant->setLastBroadcast(usecTimestampNow());
-                    }
-                }
-            });
         }
     });
-    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-    return id;
+    return true;
 }
 
 void EntityScriptingInterface::deleteEntity(QUuid id) {
@@ -566,6 +642,80 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesInBox(const glm::vec3& corn
     return result;
 }
 
+QVector<QVector<QUuid>> EntityScriptingInterface::findEntitiesInSpheres(const QVector<glm::vec3>& centers,
+                                                                        const QVector<float>& radii) const {
+    QVector<QVector<QUuid>> result;
+    if (_entityTree) {
+        int numSpheres = std::min(centers.size(), radii.size());
+        QVector<QVector<EntityItemPointer>> entities;
+        _entityTree->withReadLock([&] {
+            _entityTree->findEntities(centers.mid(0, numSpheres), radii.mid(0, numSpheres), entities);
+        });
+
+        result.resize(entities.size());
+        for (int i = 0; i < entities.size(); i++) {
+            foreach (EntityItemPointer entity, entities[i]) {
+                result[i] << entity->getEntityItemID();
+            }
+        }
+    }
+    return result;
+}
+
+QVector<QVector<QUuid>> EntityScriptingInterface::findEntitiesInBoxes(const QVector<glm::vec3>& corners,
+                                                                      const QVector<glm::vec3>& dimensions) const {
+    QVector<QVector<QUuid>> result;
+    if (_entityTree) {
+        QVector<AABox> boxes;
+        int numBoxes = std::min(corners.size(), dimensions.size());
+        for (int i = 0; i < numBoxes; i++) {
+            boxes << AABox(corners[i], dimensions[i]);
+        }
+
+        QVector<QVector<EntityItemPointer>> entities;
+        _entityTree->withReadLock([&] {
+            _entityTree->findEntities(boxes, entities);
+        });
+
+        result.resize(entities.size());
+        for (int i = 0; i < entities.size(); i++) {
+            foreach (EntityItemPointer entity, entities[i]) {
+                result[i] << entity->getEntityItemID();
+            }
+        }
+    }
+    return result;
+}
+
+QVector<RayToEntityIntersectionResult> EntityScriptingInterface::findRayIntersections(const QVector<PickRay>& rays,
+                bool precisionPicking, const QScriptValue& entityIdsToInclude, const QScriptValue& entityIdsToDiscard) {
+    QVector<RayToEntityIntersectionResult> results(rays.size());
+    if (_entityTree) {
+        QVector<EntityItemID> entitiesToInclude = qVectorEntityItemIDFromScriptValue(entityIdsToInclude);
+        QVector<EntityItemID> entitiesToDiscard = qVectorEntityItemIDFromScriptValue(entityIdsToDiscard);
+
+        bool accurate;
+        QVector<EntityTree::RayIntersection> intersections = _entityTree->findRayIntersections(rays, entitiesToInclude,
+            entitiesToDiscard, Octree::Lock, &accurate, precisionPicking);
+
+        for (int i = 0; i < rays.size(); i++) {
+            const EntityTree::RayIntersection& intersection = intersections[i];
+            RayToEntityIntersectionResult& result = results[i];
+            result.accurate = accurate;
+            result.intersects = intersection.intersects;
+            result.distance = intersection.distance;
+            result.face = intersection.face;
+            result.surfaceNormal = intersection.surfaceNormal;
+            if (result.intersects && intersection.entity) {
+                result.entityID = intersection.entity->getEntityItemID();
+                result.properties = intersection.entity->getProperties();
+                result.intersection = rays[i].origin + (rays[i].direction * result.distance);
+            }
+        }
+    }
+    return results;
+}
+
 RayToEntityIntersectionResult EntityScriptingInterface::findRayIntersection(const PickRay& ray, bool precisionPicking, 
                 const QScriptValue& entityIdsToInclude, const QScriptValue& entityIdsToDiscard) {
 
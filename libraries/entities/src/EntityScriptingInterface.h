@@ -51,6 +51,10 @@ public:
 };
 
 Q_DECLARE_METATYPE(RayToEntityIntersectionResult)
+Q_DECLARE_METATYPE(QVector<RayToEntityIntersectionResult>)
+Q_DECLARE_METATYPE(QVector<PickRay>)
+Q_DECLARE_METATYPE(QVector<QVector<QUuid>>)
+Q_DECLARE_METATYPE(QVector<EntityItemProperties>)
 
 QScriptValue RayToEntityIntersectionResultToScriptValue(QScriptEngine* engine, const RayToEntityIntersectionResult& results);
 void RayToEntityIntersectionResultFromScriptValue(const QScriptValue& object, RayToEntityIntersectionResult& results);
@@ -106,10 +110,19 @@ public slots:
     Q_INVOKABLE EntityItemProperties getEntityProperties(QUuid entityID);
     Q_INVOKABLE EntityItemProperties getEntityProperties(QUuid identity, EntityPropertyFlags desiredProperties);
 
+    /// gets the properties of many entities under one lock of the tree, only the desired ones if any are named,
+    /// in the order of the IDs, with empty properties for the entities that aren't known
+    Q_INVOKABLE QVector<EntityItemProperties> getEntitiesProperties(const QVector<QUuid>& entityIDs,
+                                                                    EntityPropertyFlags desiredProperties = EntityPropertyFlags());
+
     /// edits a model updating only the included properties, will return the identified EntityItemID in case of
     /// successful edit, if the input entityID is for an unknown model this function will have no effect
     Q_INVOKABLE QUuid editEntity(QUuid entityID, const EntityItemProperties& properties);
 
+    /// edits many entities under one lock of the tree, from [ { id, properties } ], returns the IDs of the edited
+    /// entities in the order of the edits, a null ID for each edit that had no effect
+    Q_INVOKABLE QVector<QUuid> editEntities(const QScriptValue& edits);
+
     /// deletes a model
     Q_INVOKABLE void deleteEntity(QUuid entityID);
 
@@ -131,6 +144,16 @@ public slots:
     /// this function will not find any models in script engine contexts which don't have access to models
     Q_INVOKABLE QVector<QUuid> findEntitiesInBox(const glm::vec3& corner, const glm::vec3& dimensions) const;
 
+    /// finds models within each of the spheres, the same as findEntities for each but much faster for many spheres,
+    /// the results are in the order of the spheres
+    Q_INVOKABLE QVector<QVector<QUuid>> findEntitiesInSpheres(const QVector<glm::vec3>& centers,
+                                                             const QVector<float>& radii) const;
+
+    /// finds models within each of the boxes, the same as findEntitiesInBox for each but much faster for many boxes,
+    /// the results are in the order of the boxes
+    Q_INVOKABLE QVector<QVector<QUuid>> findEntitiesInBoxes(const QVector<glm::vec3>& corners,
+                                                           const QVector<glm::vec3>& dimensions) const;
+
     /// If the scripting context has visible entities, this will determine a ray intersection, the results
     /// may be inaccurate if the engine is unable to access the visible entities, in which case result.accurate
     /// will be false.
@@ -138,6 +161,10 @@ public slots:
 
     /// If the scripting context has visible entities, this will determine a ray intersection, and will block in
     /// order to return an accurate result
+    /// determines the intersection of each of the rays, the same as findRayIntersection for each but much faster for
+    /// many rays, the results are in the order of the rays
+    Q_INVOKABLE QVector<RayToEntityIntersectionResult> findRayIntersections(const QVector<PickRay>& rays, bool precisionPicking = false, const QScriptValue& entityIdsToInclude = QScriptValue(), const QScriptValue& entityIdsToDiscard = QScriptValue());
+
     Q_INVOKABLE RayToEntityIntersectionResult findRayIntersectionBlocking(const PickRay& ray, bool precisionPicking = false, const QScriptValue& entityIdsToInclude = QScriptValue(), const QScriptValue& entityIdsToDiscard = QScriptValue());
 
     Q_INVOKABLE void setLightsArePickable(bool value);
@@ -238,6 +265,11 @@ private:
     bool setPoints(QUuid entityID, std::function<bool(LineEntityItem&)> actor);
     void queueEntityMessage(PacketType packetType, EntityItemID entityID, const EntityItemProperties& properties);
 
+    // with the tree locked
+    EntityItemProperties getEntityPropertiesInTree(const EntityItemPointer& entity, EntityPropertyFlags desiredProperties);
+    bool editEntityInTree(const EntityItemID& entityID, const EntityItemProperties& scriptSideProperties,
+                          EntityItemProperties& properties);
+
     EntityItemPointer checkForTreeEntityAndTypeMatch(const QUuid& entityID,
                                                      EntityTypes::EntityType entityType = EntityTypes::Unknown);
 
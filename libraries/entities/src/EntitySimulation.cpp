@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <AACube.h>
 
 #include "EntitySimulation.h"
@@ -18,6 +20,7 @@
 void EntitySimulation::setEntityTree(EntityTreePointer tree) {
     if (_entityTree && _entityTree != tree) {
         _mortalEntities.clear();
+        _expiryQueue.clear();
         _nextExpiry = quint64(-1);
         _entitiesToUpdate.clear();
         _entitiesToSort.clear();
@@ -91,31 +94,51 @@ void EntitySimulation::changeEntityInternal(EntityItemPointer entity) {
     }
 }
 
+// protected
+void EntitySimulation::addMortalEntity(EntityItemPointer entity) {
+    _mortalEntities.insert(entity);
+
+    const size_t MIN_EXPIRY_QUEUE_SIZE_TO_REBUILD = 64;
+    if (_expiryQueue.size() > MIN_EXPIRY_QUEUE_SIZE_TO_REBUILD &&
+        _expiryQueue.size() > 2 * (size_t)_mortalEntities.size()) {
+        // most of the queue has been left behind by removed entities and changed lifetimes
+        _expiryQueue.clear();
+        for (auto& mortal : _mortalEntities) {
+            _expiryQueue.push_back({ mortal->getExpiry(), mortal });
+        }
+        std::make_heap(_expiryQueue.begin(), _expiryQueue.end(), expiresLater);
+    } else {
+        _expiryQueue.push_back({ entity->getExpiry(), entity });
+        std::push_heap(_expiryQueue.begin(), _expiryQueue.end(), expiresLater);
+    }
+    _nextExpiry = _expiryQueue.front().expiry;
+}
+
 // protected
 void EntitySimulation::expireMortalEntities(const quint64& now) {
     if (now > _nextExpiry) {
-        // only search for expired entities if we expect to find one
-        _nextExpiry = quint64(-1);
+        // only the entries that have come due are looked at, rather than every mortal entity
         QMutexLocker lock(&_mutex);
-        SetOfEntities::iterator itemItr = _mortalEntities.begin();
-        while (itemItr != _mortalEntities.end()) {
-            EntityItemPointer entity = *itemItr;
+        while (!_expiryQueue.empty() && _expiryQueue.front().expiry < now) {
+            std::pop_heap(_expiryQueue.begin(), _expiryQueue.end(), expiresLater);
+            EntityItemPointer entity = _expiryQueue.back().entity.lock();
+            _expiryQueue.pop_back();
+
+            if (!entity || !_mortalEntities.contains(entity)) {
+                continue;
+            }
             quint64 expiry = entity->getExpiry();
             if (expiry < now) {
-                itemItr = _mortalEntities.erase(itemItr);
+                _mortalEntities.remove(entity);
                 entity->die();
                 prepareEntityForDelete(entity);
             } else {
-                if (expiry < _nextExpiry) {
-                    // remember the smallest _nextExpiry so we know when to start the next search
-                    _nextExpiry = expiry;
-                }
-                ++itemItr;
+                // it will expire later than when it was queued
+                _expiryQueue.push_back({ expiry, entity });
+                std::push_heap(_expiryQueue.begin(), _expiryQueue.end(), expiresLater);
             }
         }
-        if (_mortalEntities.size() < 1) {
-            _nextExpiry = -1;
-        }
+        _nextExpiry = _expiryQueue.empty() ? quint64(-1) : _expiryQueue.front().expiry;
     }
 }
 
@@ -156,6 +179,7 @@ void EntitySimulation::sortEntitiesThatMoved() {
             prepareEntityForDelete(entity);
         } else {
             moveOperator.addEntityToMoveList(entity, newCube);
+            _entityTree->noteChangedEntity(entity->getEntityItemID());
             ++itemItr;
         }
     }
@@ -172,11 +196,7 @@ void EntitySimulation::addEntity(EntityItemPointer entity) {
     assert(entity);
     entity->deserializeActions();
     if (entity->isMortal()) {
-        _mortalEntities.insert(entity);
-        quint64 expiry = entity->getExpiry();
-        if (expiry < _nextExpiry) {
-            _nextExpiry = expiry;
-        }
+        addMortalEntity(entity);
     }
     if (entity->needsToCallUpdate()) {
         _entitiesToUpdate.insert(entity);
@@ -220,11 +240,7 @@ void EntitySimulation::changeEntity(EntityItemPointer entity) {
     if (!wasRemoved) {
         if (dirtyFlags & Simulation::DIRTY_LIFETIME) {
             if (entity->isMortal()) {
-                _mortalEntities.insert(entity);
-                quint64 expiry = entity->getExpiry();
-                if (expiry < _nextExpiry) {
-                    _nextExpiry = expiry;
-                }
+                addMortalEntity(entity);
             } else {
                 _mortalEntities.remove(entity);
             }
@@ -242,6 +258,7 @@ void EntitySimulation::changeEntity(EntityItemPointer entity) {
 void EntitySimulation::clearEntities() {
     QMutexLocker lock(&_mutex);
     _mortalEntities.clear();
+    _expiryQueue.clear();
     _nextExpiry = quint64(-1);
     _entitiesToUpdate.clear();
     _entitiesToSort.clear();
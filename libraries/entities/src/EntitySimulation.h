@@ -12,6 +12,8 @@
 #ifndef hifi_EntitySimulation_h
 #define hifi_EntitySimulation_h
 
+#include <vector>
+
 #include <QtCore/QObject>
 #include <QSet>
 #include <QVector>
@@ -95,6 +97,7 @@ protected:
     virtual void changeEntityInternal(EntityItemPointer entity);
     virtual void clearEntitiesInternal() = 0;
 
+    void addMortalEntity(EntityItemPointer entity);
     void expireMortalEntities(const quint64& now);
     void callUpdateOnEntitiesThatNeedIt(const quint64& now);
     virtual void sortEntitiesThatMoved();
@@ -121,6 +124,15 @@ private:
     SetOfEntities _mortalEntities; // entities that have an expiry
     quint64 _nextExpiry;
 
+    // when each mortal entity expires, a heap with the soonest at the front. An entry is left behind when its entity
+    // is removed or its lifetime changes, and is skipped when it comes due.
+    struct Expiry {
+        quint64 expiry;
+        EntityItemWeakPointer entity;
+    };
+    static bool expiresLater(const Expiry& a, const Expiry& b) { return a.expiry > b.expiry; }
+    std::vector<Expiry> _expiryQueue;
+
 
     SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
 
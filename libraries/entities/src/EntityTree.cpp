@@ -9,23 +9,52 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
+#include <ParallelFor.h>
 #include <PerfStat.h>
 #include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QtScript/QScriptEngine>
 
 #include "EntityTree.h"
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
 
+#include "AddEntitiesOperator.h"
 #include "AddEntityOperator.h"
 #include "MovingEntitiesOperator.h"
 #include "UpdateEntityOperator.h"
 #include "QVariantGLM.h"
 #include "EntitiesLogging.h"
+#include "RecurseOctreeToJSONOperator.h"
 #include "RecurseOctreeToMapOperator.h"
 #include "LogHandler.h"
+#include "ShapeEntityItem.h"
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
+
+// The binary entities file is a header and then a record for each entity, in the native byte order the way the
+// octree wire format is. A record is its encoding, created time, size, and then the entity as an EntityAdd edit
+// message, or as binary JSON of its properties if it doesn't fit in one.
+static const char BINARY_ENTITIES_MAGIC[4] = { 'H', 'F', 'E', 'B' };
+static const quint32 BINARY_ENTITIES_FORMAT_VERSION = 1;
+enum BinaryEntityEncoding : quint8 { EditMessageEncoding = 0, BinaryJSONEncoding };
+
+struct BinaryEntitiesHeader {
+    char magic[4];
+    quint32 formatVersion;
+    quint32 packetVersion; // of EntityAdd, a file from another version falls back to the JSON save
+    quint32 numEntities;
+};
+
+struct BinaryEntityRecordHeader {
+    quint8 encoding;
+    quint64 created; // edit messages don't carry it
+    quint32 size;
+};
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
 
 
@@ -64,6 +93,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
             element->cleanupEntities();
         }
         _entityToElementMap.clear();
+        _entityMap.clear();
     }
     Octree::eraseAllOctreeElements(createNewRoot);
 
@@ -85,6 +115,13 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
 
 /// Adds a new entity item to the tree
 void EntityTree::postAddEntity(EntityItemPointer entity) {
+    trackAddedEntity(entity);
+
+    // find and hook up any entities with this entity as a (previously) missing parent
+    fixupMissingParents();
+}
+
+void EntityTree::trackAddedEntity(EntityItemPointer entity) {
     assert(entity);
     // check to see if we need to simulate this entity..
     if (_simulation) {
@@ -97,10 +134,8 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    noteChangedEntity(entity->getEntityItemID());
     emit addingEntity(entity->getEntityItemID());
-
-    // find and hook up any entities with this entity as a (previously) missing parent
-    fixupMissingParents();
 }
 
 bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
@@ -278,6 +313,7 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
         }
 
         _isDirty = true;
+        noteChangedEntity(entity->getEntityItemID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -311,6 +347,60 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
 }
 
 EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties) {
+    EntityItemPointer result = constructNewEntity(entityID, properties);
+    if (result) {
+        // Recurse the tree and store the entity in the correct tree element
+        AddEntityOperator theOperator(getThisPointer(), result);
+        recurseTreeWithOperator(&theOperator);
+        if (result->getAncestorMissing()) {
+            // we added the entity, but didn't know about all its ancestors, so it went into the wrong place.
+            // add it to a list of entities needing to be fixed once their parents are known.
+            QWriteLocker locker(&_missingParentLock);
+            _missingParent.append(result);
+        }
+
+        postAddEntity(result);
+    }
+    return result;
+}
+
+QVector<EntityItemPointer> EntityTree::addEntities(const QVector<EntityItemID>& entityIDs,
+                                                   const QVector<EntityItemProperties>& properties) {
+    assert(entityIDs.size() == properties.size());
+
+    QVector<EntityItemPointer> results;
+    QSet<EntityItemID> constructedIDs;
+    results.reserve(entityIDs.size());
+    for (int i = 0; i < entityIDs.size(); i++) {
+        // the containing element map doesn't know about the ones we haven't added yet
+        if (constructedIDs.contains(entityIDs[i])) {
+            qCDebug(entities) << "UNEXPECTED!!! ----- addEntities() given the same entity twice. entityID=" << entityIDs[i];
+            continue;
+        }
+        EntityItemPointer entity = constructNewEntity(entityIDs[i], properties[i]);
+        if (entity) {
+            constructedIDs.insert(entityIDs[i]);
+            results << entity;
+        }
+    }
+
+    // one pass down the tree for all of them, rather than a pass from the root for each
+    AddEntitiesOperator theOperator(getThisPointer(), results);
+    recurseTreeWithOperator(&theOperator);
+
+    foreach (const EntityItemPointer& entity, results) {
+        if (entity->getAncestorMissing()) {
+            QWriteLocker locker(&_missingParentLock);
+            _missingParent.append(entity);
+        }
+        trackAddedEntity(entity);
+    }
+    fixupMissingParents();
+
+    return results;
+}
+
+EntityItemPointer EntityTree::constructNewEntity(const EntityItemID& entityID, const EntityItemProperties& properties) {
     EntityItemPointer result = NULL;
     EntityItemProperties props = properties;
 
@@ -344,21 +434,8 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
     EntityTypes::EntityType type = props.getType();
     result = EntityTypes::constructEntityItem(type, entityID, props);
 
-    if (result) {
-        if (recordCreationTime) {
-            result->recordCreationTime();
-        }
-        // Recurse the tree and store the entity in the correct tree element
-        AddEntityOperator theOperator(getThisPointer(), result);
-        recurseTreeWithOperator(&theOperator);
-        if (result->getAncestorMissing()) {
-            // we added the entity, but didn't know about all its ancestors, so it went into the wrong place.
-            // add it to a list of entities needing to be fixed once their parents are known.
-            QWriteLocker locker(&_missingParentLock);
-            _missingParent.append(result);
-        }
-
-        postAddEntity(result);
+    if (result && recordCreationTime) {
+        result->recordCreationTime();
     }
     return result;
 }
@@ -411,6 +488,7 @@ void EntityTree::deleteEntity(const EntityItemID& entityID, bool force, bool ign
         return;
     }
 
+    noteChangedEntity(entityID);
     emit deletingEntity(entityID);
 
     // NOTE: callers must lock the tree before using this method
@@ -450,6 +528,7 @@ void EntityTree::deleteEntities(QSet<EntityItemID> entityIDs, bool force, bool i
 
         // tell our delete operator about this entityID
         theOperator.addEntityIDToDeleteList(entityID);
+        noteChangedEntity(entityID);
         emit deletingEntity(entityID);
     }
 
@@ -482,6 +561,9 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
             // set up the deleted entities ID
             QWriteLocker locker(&_recentlyDeletedEntitiesLock);
             _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            if (_isJournalingDeletes) {
+                _unjournaledDeletedEntityItemIDs.insert(theEntity->getEntityItemID());
+            }
         } else {
             // on the client side, we also remember that we deleted this entity, we don't care about the time
             trackDeletedEntity(theEntity->getEntityItemID());
@@ -504,7 +586,7 @@ public:
 };
 
 
-bool EntityTree::findNearPointOperation(OctreeElementPointer element, void* extraData) {
+bool EntityTree::findNearPointOperation(const OctreeElementPointer& element, void* extraData) {
     FindNearPointArgs* args = static_cast<FindNearPointArgs*>(extraData);
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
 
@@ -555,7 +637,7 @@ public:
 };
 
 
-bool findRayIntersectionOp(OctreeElementPointer element, void* extraData) {
+bool findRayIntersectionOp(const OctreeElementPointer& element, void* extraData) {
     RayArgs* args = static_cast<RayArgs*>(extraData);
     bool keepSearching = true;
     EntityTreeElementPointer entityTreeElementPointer = std::dynamic_pointer_cast<EntityTreeElement>(element);
@@ -586,6 +668,44 @@ bool EntityTree::findRayIntersection(const glm::vec3& origin, const glm::vec3& d
     return args.found;
 }
 
+QVector<EntityTree::RayIntersection> EntityTree::findRayIntersections(const QVector<PickRay>& rays,
+                                    const QVector<EntityItemID>& entityIdsToInclude,
+                                    const QVector<EntityItemID>& entityIdsToDiscard,
+                                    Octree::lockType lockType, bool* accurateResult, bool precisionPicking) {
+    QVector<RayIntersection> intersections(rays.size());
+
+    auto findRayIntersection = [&](int i) {
+        RayIntersection& intersection = intersections[i];
+        OctreeElementPointer element;
+        void* intersectedObject = nullptr;
+        RayArgs args = { rays[i].origin, rays[i].direction, element, intersection.distance, intersection.face,
+                         intersection.surfaceNormal, entityIdsToInclude, entityIdsToDiscard,
+                         &intersectedObject, false, precisionPicking };
+        recurseTreeWithOperation(findRayIntersectionOp, &args);
+        intersection.intersects = args.found;
+        if (intersectedObject) {
+            intersection.entity = static_cast<EntityItem*>(intersectedObject)->getThisPointer();
+        }
+    };
+
+    // the threads helping us don't lock, a read lock they waited on behind a writer would wait on us
+    bool requireLock = lockType == Octree::Lock;
+    bool lockResult = withReadLock([&]{
+        if (precisionPicking) {
+            for (int i = 0; i < rays.size(); i++) {
+                findRayIntersection(i);
+            }
+        } else {
+            parallelFor(rays.size(), findRayIntersection);
+        }
+    }, requireLock);
+
+    if (accurateResult) {
+        *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
+    }
+
+    return intersections;
+}
 
 EntityItemPointer EntityTree::findClosestEntity(glm::vec3 position, float targetRadius) {
     FindNearPointArgs args = { position, targetRadius, false, NULL, FLT_MAX };
@@ -604,7 +724,7 @@ public:
 };
 
 
-bool EntityTree::findInSphereOperation(OctreeElementPointer element, void* extraData) {
+bool EntityTree::findInSphereOperation(const OctreeElementPointer& element, void* extraData) {
     FindAllNearPointArgs* args = static_cast<FindAllNearPointArgs*>(extraData);
     glm::vec3 penetration;
     bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
@@ -640,7 +760,7 @@ public:
     QVector<EntityItemPointer> _foundEntities;
 };
 
-bool EntityTree::findInCubeOperation(OctreeElementPointer element, void* extraData) {
+bool EntityTree::findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
     FindEntitiesInCubeArgs* args = static_cast<FindEntitiesInCubeArgs*>(extraData);
     if (element->getAACube().touches(args->_cube)) {
         EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
@@ -669,7 +789,7 @@ public:
     QVector<EntityItemPointer> _foundEntities;
 };
 
-bool EntityTree::findInBoxOperation(OctreeElementPointer element, void* extraData) {
+bool EntityTree::findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
     FindEntitiesInBoxArgs* args = static_cast<FindEntitiesInBoxArgs*>(extraData);
     if (element->getAACube().touches(args->_box)) {
         EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
@@ -688,18 +808,38 @@ void EntityTree::findEntities(const AABox& box, QVector<EntityItemPointer>& foun
     foundEntities.swap(args._foundEntities);
 }
 
+void EntityTree::findEntities(const QVector<glm::vec3>& centers, const QVector<float>& radii,
+                              QVector<QVector<EntityItemPointer>>& foundEntities) {
+    assert(centers.size() == radii.size());
+    foundEntities = QVector<QVector<EntityItemPointer>>(centers.size());
+    parallelFor(centers.size(), [&](int i) {
+        findEntities(centers[i], radii[i], foundEntities[i]);
+    });
+}
+
+void EntityTree::findEntities(const QVector<AACube>& cubes, QVector<QVector<EntityItemPointer>>& foundEntities) {
+    foundEntities = QVector<QVector<EntityItemPointer>>(cubes.size());
+    parallelFor(cubes.size(), [&](int i) {
+        findEntities(cubes[i], foundEntities[i]);
+    });
+}
+
+void EntityTree::findEntities(const QVector<AABox>& boxes, QVector<QVector<EntityItemPointer>>& foundEntities) {
+    foundEntities = QVector<QVector<EntityItemPointer>>(boxes.size());
+    parallelFor(boxes.size(), [&](int i) {
+        findEntities(boxes[i], foundEntities[i]);
+    });
+}
+
 EntityItemPointer EntityTree::findEntityByID(const QUuid& id) {
     EntityItemID entityID(id);
     return findEntityByEntityItemID(entityID);
 }
 
 EntityItemPointer EntityTree::findEntityByEntityItemID(const EntityItemID& entityID) /*const*/ {
-    EntityItemPointer foundEntity = NULL;
-    EntityTreeElementPointer containingElement = getContainingElement(entityID);
-    if (containingElement) {
-        foundEntity = containingElement->getEntityWithEntityItemID(entityID);
-    }
-    return foundEntity;
+    QReadLocker locker(&_entityToElementLock);
+    const EntityItemPointer* foundEntity = _entityMap.find(entityID);
+    return foundEntity ? *foundEntity : EntityItemPointer();
 }
 
 void EntityTree::fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties) {
@@ -866,7 +1006,7 @@ void EntityTree::fixupTerseEditLogging(EntityItemProperties& properties, QList<Q
 }
 
 int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
-                                     const SharedNodePointer& senderNode) {
+                                     const SharedNodePointer& senderNode, quint64& lockWaitUsecs) {
 
     if (!getIsServer()) {
         qCDebug(entities) << "UNEXPECTED!!! processEditPacketData() should only be called on a server tree.";
@@ -878,7 +1018,11 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     switch (message.getType()) {
         case PacketType::EntityErase: {
             QByteArray dataByteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-            processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            quint64 startLock = usecTimestampNow();
+            withWriteLock([&] {
+                lockWaitUsecs += usecTimestampNow() - startLock;
+                processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            });
             break;
         }
 
@@ -914,78 +1058,84 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                 }
             }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                EntityItemPointer existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (existingEntity && message.getType() == PacketType::EntityEdit) {
-                    // if the EntityItem exists, then update it
-                    startLogging = usecTimestampNow();
-                    if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
-                        qCDebug(entities) << "   properties:" << properties;
-                    }
-                    if (wantTerseEditLogging()) {
-                        QList<QString> changedProperties = properties.listChangedProperties();
-                        fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
-                    }
-                    endLogging = usecTimestampNow();
-
-                    startUpdate = usecTimestampNow();
-                    updateEntity(entityItemID, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (message.getType() == PacketType::EntityAdd) {
-                    if (senderNode->getCanRez() || senderNode->getCanRezTmp()) {
-                        // this is a new entity... assign a new entityID
-                        properties.setCreated(properties.getLastEdited());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
+            // the decode above doesn't touch the tree, so only the lookup and the change itself hold the write lock
+            quint64 startLock = usecTimestampNow();
+            withWriteLock([&] {
+                lockWaitUsecs += usecTimestampNow() - startLock;
+
+                // If we got a valid edit packet, then it could be a new entity or it could be an update to
+                // an existing entity... handle appropriately
+                if (validEditPacket) {
+                    // search for the entity by EntityItemID
+                    startLookup = usecTimestampNow();
+                    EntityItemPointer existingEntity = findEntityByEntityItemID(entityItemID);
+                    endLookup = usecTimestampNow();
+                    if (existingEntity && message.getType() == PacketType::EntityEdit) {
+                        // if the EntityItem exists, then update it
+                        startLogging = usecTimestampNow();
+                        if (wantEditLogging()) {
+                            qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                            qCDebug(entities) << "   properties:" << properties;
+                        }
+                        if (wantTerseEditLogging()) {
+                            QList<QString> changedProperties = properties.listChangedProperties();
+                            fixupTerseEditLogging(properties, changedProperties);
+                            qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                                existingEntity->getDebugName() << changedProperties;
+                        }
+                        endLogging = usecTimestampNow();
+
+                        startUpdate = usecTimestampNow();
+                        updateEntity(entityItemID, properties, senderNode);
+                        existingEntity->markAsChangedOnServer();
+                        endUpdate = usecTimestampNow();
+                        _totalUpdates++;
+                    } else if (message.getType() == PacketType::EntityAdd) {
+                        if (senderNode->getCanRez() || senderNode->getCanRezTmp()) {
+                            // this is a new entity... assign a new entityID
+                            properties.setCreated(properties.getLastEdited());
+                            startCreate = usecTimestampNow();
+                            EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                            endCreate = usecTimestampNow();
+                            _totalCreates++;
+                            if (newEntity) {
+                                newEntity->markAsChangedOnServer();
+                                notifyNewlyCreatedEntity(*newEntity, senderNode);
+
+                                startLogging = usecTimestampNow();
+                                if (wantEditLogging()) {
+                                    qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                                    << newEntity->getEntityItemID();
+                                    qCDebug(entities) << "   properties:" << properties;
+                                }
+                                if (wantTerseEditLogging()) {
+                                    QList<QString> changedProperties = properties.listChangedProperties();
+                                    fixupTerseEditLogging(properties, changedProperties);
+                                    qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
+                                }
+                                endLogging = usecTimestampNow();
 
+                            }
+                        } else {
+                            qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
+                                              << "] attempted to add an entity.";
                         }
                     } else {
-                        qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
-                                          << "] attempted to add an entity.";
+                        static QString repeatedMessage =
+                            LogHandler::getInstance().addRepeatedMessageRegex("^Edit failed.*");
+                        qCDebug(entities) << "Edit failed. [" << message.getType() <<"] " <<
+                                "entity id:" << entityItemID << 
+                                "existingEntity pointer:" << existingEntity.get();
                     }
-                } else {
-                    static QString repeatedMessage =
-                        LogHandler::getInstance().addRepeatedMessageRegex("^Edit failed.*");
-                    qCDebug(entities) << "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get();
                 }
-            }
 
 
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
+                _totalDecodeTime += endDecode - startDecode;
+                _totalLookupTime += endLookup - startLookup;
+                _totalUpdateTime += endUpdate - startUpdate;
+                _totalCreateTime += endCreate - startCreate;
+                _totalLoggingTime += endLogging - startLogging;
+            });
 
             break;
         }
@@ -1032,10 +1182,108 @@ void EntityTree::releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncod
     extraEncodeData->clear();
 }
 
+// an occluder is opaque, fills its bounds, and is large on at least two of its sides, like a wall or a floor
+static const float MIN_OCCLUDER_SIDE = 4.0f; // meters
+static const float OCCLUDER_AXIS_ALIGNMENT_TOLERANCE = 0.001f;
+static const quint64 OCCLUDERS_MAX_AGE_USECS = USECS_PER_SECOND;
+
+static bool getOccluderBox(const EntityItemPointer& entity, AABox& box) {
+    if (entity->getType() != EntityTypes::Box && entity->getType() != EntityTypes::Shape) {
+        return false;
+    }
+    auto shapeEntity = std::static_pointer_cast<ShapeEntityItem>(entity);
+    if (shapeEntity->getShape() != entity::Shape::Cube || shapeEntity->getAlpha() < 1.0f || !entity->getVisible()) {
+        return false;
+    }
+
+    // anything that moves, or moves with a parent, could leave what it hid in the view without it being sent
+    if (entity->getDynamic() || entity->isMoving() || !entity->getParentID().isNull()) {
+        return false;
+    }
+
+    glm::vec3 dimensions = entity->getDimensions();
+    int largeSides = (dimensions.x >= MIN_OCCLUDER_SIDE) + (dimensions.y >= MIN_OCCLUDER_SIDE) +
+        (dimensions.z >= MIN_OCCLUDER_SIDE);
+    if (largeSides < 2) {
+        return false;
+    }
+
+    // the bounds of a turned box are larger than the box, so only a box lined up with the axes is used
+    glm::mat3 rotation = glm::mat3_cast(entity->getRotation());
+    for (int column = 0; column < 3; column++) {
+        for (int row = 0; row < 3; row++) {
+            float size = fabsf(rotation[column][row]);
+            if (size > OCCLUDER_AXIS_ALIGNMENT_TOLERANCE && size < 1.0f - OCCLUDER_AXIS_ALIGNMENT_TOLERANCE) {
+                return false;
+            }
+        }
+    }
+
+    bool success;
+    box = entity->getAABox(success);
+    return success;
+}
+
+void EntityTree::getOccluders(std::vector<AABox>& occluders) const {
+    // this looks at every entity, so what it finds is kept for a while and shared by all the viewers
+    std::lock_guard<std::mutex> lock(_occludersMutex);
+    quint64 now = usecTimestampNow();
+    if (now - _occludersGatheredAt > OCCLUDERS_MAX_AGE_USECS) {
+        _occluders.clear();
+        {
+            QReadLocker locker(&_entityToElementLock);
+            _entityMap.forEach([&](const QUuid& entityID, const EntityItemPointer& entity) {
+                AABox box;
+                if (getOccluderBox(entity, box)) {
+                    _occluders.push_back(box);
+                }
+            });
+        }
+
+        // in an order that doesn't depend on the map, so the same occluders compare equal from one time to the next
+        std::sort(_occluders.begin(), _occluders.end(), [](const AABox& first, const AABox& second) {
+            const glm::vec3& firstCorner = first.getCorner();
+            const glm::vec3& secondCorner = second.getCorner();
+            if (firstCorner.x != secondCorner.x) {
+                return firstCorner.x < secondCorner.x;
+            }
+            if (firstCorner.y != secondCorner.y) {
+                return firstCorner.y < secondCorner.y;
+            }
+            if (firstCorner.z != secondCorner.z) {
+                return firstCorner.z < secondCorner.z;
+            }
+            return glm::length(first.getScale()) < glm::length(second.getScale());
+        });
+        _occludersGatheredAt = now;
+    }
+    occluders = _occluders;
+}
+
 void EntityTree::entityChanged(EntityItemPointer entity) {
     if (_simulation) {
         _simulation->changeEntity(entity);
     }
+    noteChangedEntity(entity->getEntityItemID());
+}
+
+void EntityTree::setTrackChangedEntities(bool track) {
+    std::lock_guard<std::mutex> lock(_changedEntitiesMutex);
+    _trackChangedEntities = track;
+    _changedEntities.clear();
+}
+
+void EntityTree::noteChangedEntity(const EntityItemID& entityID) {
+    if (_trackChangedEntities) {
+        std::lock_guard<std::mutex> lock(_changedEntitiesMutex);
+        _changedEntities.insert(entityID);
+    }
+}
+
+void EntityTree::takeChangedEntities(QSet<EntityItemID>& changed) {
+    std::lock_guard<std::mutex> lock(_changedEntitiesMutex);
+    changed.swap(_changedEntities);
+    _changedEntities.clear();
 }
 
 void EntityTree::fixupMissingParents() {
@@ -1283,12 +1531,20 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
 }
 
 void EntityTree::setContainingElement(const EntityItemID& entityItemID, EntityTreeElementPointer element) {
+    // every caller has just added the entity to element, or taken it out of the one it was in
+    EntityItemPointer entity = element ? element->getEntityWithEntityItemID(entityItemID) : EntityItemPointer();
+
     QWriteLocker locker(&_entityToElementLock);
     if (element) {
         _entityToElementMap[entityItemID] = element;
     } else {
         _entityToElementMap.remove(entityItemID);
     }
+    if (entity) {
+        _entityMap.insert(entityItemID, entity);
+    } else {
+        _entityMap.remove(entityItemID);
+    }
 }
 
 void EntityTree::debugDumpMap() {
@@ -1304,15 +1560,15 @@ void EntityTree::debugDumpMap() {
 
 class ContentsDimensionOperator : public RecurseOctreeOperator {
 public:
-    virtual bool preRecursion(OctreeElementPointer element) override;
-    virtual bool postRecursion(OctreeElementPointer element) override { return true; }
+    virtual bool preRecursion(const OctreeElementPointer& element) override;
+    virtual bool postRecursion(const OctreeElementPointer& element) override { return true; }
     glm::vec3 getDimensions() const { return _contentExtents.size(); }
     float getLargestDimension() const { return _contentExtents.largestDimension(); }
 private:
     Extents _contentExtents;
 };
 
-bool ContentsDimensionOperator::preRecursion(OctreeElementPointer element) {
+bool ContentsDimensionOperator::preRecursion(const OctreeElementPointer& element) {
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
     entityTreeElement->expandExtentsToContents(_contentExtents);
     return true;
@@ -1332,11 +1588,11 @@ float EntityTree::getContentsLargestDimension() {
 
 class DebugOperator : public RecurseOctreeOperator {
 public:
-    virtual bool preRecursion(OctreeElementPointer element) override;
-    virtual bool postRecursion(OctreeElementPointer element) override { return true; }
+    virtual bool preRecursion(const OctreeElementPointer& element) override;
+    virtual bool postRecursion(const OctreeElementPointer& element) override { return true; }
 };
 
-bool DebugOperator::preRecursion(OctreeElementPointer element) {
+bool DebugOperator::preRecursion(const OctreeElementPointer& element) {
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
     qCDebug(entities) << "EntityTreeElement [" << entityTreeElement.get() << "]";
     entityTreeElement->debugDump();
@@ -1350,11 +1606,11 @@ void EntityTree::dumpTree() {
 
 class PruneOperator : public RecurseOctreeOperator {
 public:
-    virtual bool preRecursion(OctreeElementPointer element) override { return true; }
-    virtual bool postRecursion(OctreeElementPointer element) override;
+    virtual bool preRecursion(const OctreeElementPointer& element) override { return true; }
+    virtual bool postRecursion(const OctreeElementPointer& element) override;
 };
 
-bool PruneOperator::postRecursion(OctreeElementPointer element) {
+bool PruneOperator::postRecursion(const OctreeElementPointer& element) {
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
     entityTreeElement->pruneChildren();
     return true;
@@ -1384,7 +1640,7 @@ QVector<EntityItemID> EntityTree::sendEntities(EntityEditPacketSender* packetSen
     return map.values().toVector();
 }
 
-bool EntityTree::sendEntitiesOperation(OctreeElementPointer element, void* extraData) {
+bool EntityTree::sendEntitiesOperation(const OctreeElementPointer& element, void* extraData) {
     SendEntitiesOperationArgs* args = static_cast<SendEntitiesOperationArgs*>(extraData);
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
     std::function<const EntityItemID(EntityItemPointer&)> getMapped = [&](EntityItemPointer& item) -> const EntityItemID {
@@ -1457,7 +1713,10 @@ bool EntityTree::readFromMap(QVariantMap& map) {
         return false;
     }
 
-    bool success = true;
+    QVector<EntityItemID> entityItemIDs;
+    QVector<EntityItemProperties> entityProperties;
+    entityItemIDs.reserve(entitiesQList.size());
+    entityProperties.reserve(entitiesQList.size());
     foreach (QVariant entityVariant, entitiesQList) {
         // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
         QVariantMap entityMap = entityVariant.toMap();
@@ -1472,11 +1731,334 @@ bool EntityTree::readFromMap(QVariantMap& map) {
             entityItemID = EntityItemID(QUuid::createUuid());
         }
 
-        EntityItemPointer entity = addEntity(entityItemID, properties);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+        entityItemIDs << entityItemID;
+        entityProperties << properties;
+    }
+
+    return addEntitiesFromLoad(entityItemIDs, entityProperties);
+}
+
+bool EntityTree::writeToJSON(QByteArray& jsonData, OctreeElementPointer element, bool skipDefaultValues,
+                             bool skipThoseWithBadParents) {
+    // the properties go straight to JSON, there are no script values or QVariantMaps of the whole tree on the way
+    JSONWriter writer(jsonData);
+    writer.beginObject();
+    writer.writeMember("Version", (int)expectedVersion());
+    writer.key("Entities");
+    writer.beginArray();
+    RecurseOctreeToJSONOperator theOperator(writer, element, skipDefaultValues, skipThoseWithBadParents);
+    recurseTreeWithOperator(&theOperator);
+    writer.endArray();
+    writer.endObject();
+    return true;
+}
+
+bool EntityTree::readFromJSON(const QByteArray& jsonData) {
+    // as readFromMap, but the properties are read from the JSON objects of the entities
+    QJsonArray entitiesArray = QJsonDocument::fromJson(jsonData).object().value(QLatin1String("Entities")).toArray();
+    if (entitiesArray.isEmpty()) {
+        // Empty map or invalidly formed file.
+        return false;
+    }
+
+    QVector<EntityItemID> entityItemIDs;
+    QVector<EntityItemProperties> entityProperties;
+    entityItemIDs.reserve(entitiesArray.size());
+    entityProperties.reserve(entitiesArray.size());
+    for (const auto& entityValue : entitiesArray) {
+        QJsonObject entityObject = entityValue.toObject();
+        EntityItemProperties properties;
+        properties.copyFromJSON(entityObject);
+
+        QJsonValue idValue = entityObject.value(QLatin1String("id"));
+        if (!idValue.isUndefined()) {
+            entityItemIDs << EntityItemID(QUuid(idValue.toString()));
+        } else {
+            entityItemIDs << EntityItemID(QUuid::createUuid());
+        }
+        entityProperties << properties;
+    }
+
+    return addEntitiesFromLoad(entityItemIDs, entityProperties);
+}
+
+bool EntityTree::addEntitiesFromLoad(const QVector<EntityItemID>& entityItemIDs,
+                                     const QVector<EntityItemProperties>& entityProperties) {
+    QVector<EntityItemPointer> addedEntities = addEntities(entityItemIDs, entityProperties);
+    if (addedEntities.size() == entityItemIDs.size()) {
+        return true;
+    }
+
+    // say which ones didn't make it
+    QSet<EntityItemID> addedIDs;
+    foreach (const EntityItemPointer& entity, addedEntities) {
+        addedIDs.insert(entity->getEntityItemID());
+    }
+    for (int i = 0; i < entityItemIDs.size(); i++) {
+        if (!addedIDs.contains(entityItemIDs[i])) {
+            qCDebug(entities) << "adding Entity failed:" << entityItemIDs[i] << entityProperties[i].getType();
+        }
+    }
+    return false;
+}
+
+bool EntityTree::writeChangesToMap(QVariantMap& changes, quint64 sinceTime) {
+    QScriptEngine scriptEngine;
+    QVariantList entitiesQList;
+    {
+        QReadLocker locker(&_entityToElementLock);
+        for (auto it = _entityToElementMap.constBegin(); it != _entityToElementMap.constEnd(); ++it) {
+            EntityItemPointer entity = it.value()->getEntityWithEntityItemID(it.key());
+            // the same entities a full save would skip
+            if (!entity || entity->getLastChangedOnServer() <= sinceTime || !entity->isParentIDValid()) {
+                continue;
+            }
+            entitiesQList << EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, entity->getProperties()).toVariant();
+        }
+    }
+
+    QVariantList deletedQList;
+    {
+        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+        foreach (const QUuid& entityID, _unjournaledDeletedEntityItemIDs) {
+            deletedQList << entityID.toString();
+        }
+        _unjournaledDeletedEntityItemIDs.clear();
+        _isJournalingDeletes = true;
+    }
+
+    changes["Entities"] = entitiesQList;
+    changes["Deleted"] = deletedQList;
+    return true;
+}
+
+void EntityTree::mergeChangesIntoMap(QVariantMap& entityDescription, const QVariantList& changesList) const {
+    // index the saved entities by ID, keeping their order so parents still tend to come before their children
+    QVector<QVariant> entities;
+    QHash<QUuid, int> entityIndices;
+    foreach (const QVariant& entityVariant, entityDescription["Entities"].toList()) {
+        QUuid entityID(entityVariant.toMap()["id"].toString());
+        if (!entityID.isNull()) {
+            entityIndices[entityID] = entities.size();
+        }
+        entities << entityVariant;
+    }
+
+    foreach (const QVariant& changesVariant, changesList) {
+        QVariantMap changes = changesVariant.toMap();
+
+        // deletes first, an entity that was deleted and then added again since the last journaling is in both
+        foreach (const QVariant& deletedVariant, changes["Deleted"].toList()) {
+            auto found = entityIndices.find(QUuid(deletedVariant.toString()));
+            if (found != entityIndices.end()) {
+                entities[found.value()] = QVariant();
+                entityIndices.erase(found);
+            }
+        }
+
+        foreach (const QVariant& entityVariant, changes["Entities"].toList()) {
+            QUuid entityID(entityVariant.toMap()["id"].toString());
+            auto found = entityIndices.find(entityID);
+            if (found != entityIndices.end()) {
+                entities[found.value()] = entityVariant;
+            } else {
+                entityIndices[entityID] = entities.size();
+                entities << entityVariant;
+            }
+        }
+    }
+
+    QVariantList entitiesQList;
+    foreach (const QVariant& entityVariant, entities) {
+        if (entityVariant.isValid()) {
+            entitiesQList << entityVariant;
+        }
+    }
+    entityDescription["Entities"] = entitiesQList;
+}
+
+// interleaves the bits of a position in the tree so sorting by it visits the octree depth first, octal code order
+static quint64 mortonCodeForPosition(const glm::vec3& position) {
+    const int BITS_PER_AXIS = 21;
+    const float AXIS_SCALE = (float)((1 << BITS_PER_AXIS) - 1);
+
+    glm::vec3 unit = glm::clamp(position / (float)TREE_SCALE + glm::vec3(0.5f), glm::vec3(0.0f), glm::vec3(1.0f));
+    quint64 axes[3] = { (quint64)(unit.x * AXIS_SCALE), (quint64)(unit.y * AXIS_SCALE), (quint64)(unit.z * AXIS_SCALE) };
+
+    quint64 code = 0;
+    for (int bit = BITS_PER_AXIS - 1; bit >= 0; bit--) {
+        for (int axis = 0; axis < 3; axis++) {
+            code = (code << 1) | ((axes[axis] >> bit) & 1);
+        }
+    }
+    return code;
+}
+
+bool EntityTree::writeToBinaryFile(const char* fileName) {
+    std::vector<std::pair<quint64, EntityItemPointer>> sortedEntities;
+    {
+        QReadLocker locker(&_entityToElementLock);
+        sortedEntities.reserve(_entityToElementMap.size());
+        for (auto it = _entityToElementMap.constBegin(); it != _entityToElementMap.constEnd(); ++it) {
+            EntityItemPointer entity = it.value()->getEntityWithEntityItemID(it.key());
+            // the same entities a full save would skip
+            if (!entity || !entity->isParentIDValid()) {
+                continue;
+            }
+            bool success;
+            AACube queryCube = entity->getQueryAACube(success);
+            sortedEntities.push_back({ mortonCodeForPosition(success ? queryCube.calcCenter() : glm::vec3(0.0f)), entity });
+        }
+    }
+
+    // presorted so neighbours in the tree are neighbours in the file
+    std::sort(sortedEntities.begin(), sortedEntities.end(),
+        [](const std::pair<quint64, EntityItemPointer>& a, const std::pair<quint64, EntityItemPointer>& b) {
+            return a.first < b.first;
+        });
+
+    BinaryEntitiesHeader header;
+    memcpy(header.magic, BINARY_ENTITIES_MAGIC, sizeof(header.magic));
+    header.formatVersion = BINARY_ENTITIES_FORMAT_VERSION;
+    header.packetVersion = versionForPacketType(PacketType::EntityAdd);
+    header.numEntities = (quint32)sortedEntities.size();
+
+    QByteArray fileData;
+    fileData.append(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    QScriptEngine scriptEngine;
+    QByteArray buffer;
+    for (auto& sortedEntity : sortedEntities) {
+        EntityItemPointer entity = sortedEntity.second;
+        EntityItemProperties properties = entity->getProperties();
+        properties.markAllChanged();
+
+        BinaryEntityRecordHeader recordHeader;
+        recordHeader.created = entity->getCreated();
+
+        buffer.resize(MAX_OCTREE_UNCOMRESSED_PACKET_SIZE);
+        if (EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, entity->getEntityItemID(), properties, buffer)) {
+            recordHeader.encoding = EditMessageEncoding;
+        } else {
+            recordHeader.encoding = BinaryJSONEncoding;
+            QVariant entityVariant = EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, properties).toVariant();
+            buffer = QJsonDocument::fromVariant(entityVariant).toBinaryData();
+        }
+        recordHeader.size = (quint32)buffer.size();
+
+        fileData.append(reinterpret_cast<const char*>(&recordHeader), sizeof(recordHeader));
+        fileData.append(buffer);
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(fileData) != fileData.size()) {
+        qCDebug(entities) << "ERROR writing binary entities file" << fileName;
+        return false;
+    }
+    return true;
+}
+
+bool EntityTree::readFromBinaryFile(const char* fileName, const QVariantList& changesList) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    qint64 fileSize = file.size();
+    const unsigned char* fileData = (fileSize > 0) ? file.map(0, fileSize) : nullptr;
+    if (!fileData || fileSize < (qint64)sizeof(BinaryEntitiesHeader)) {
+        qCDebug(entities) << "ERROR reading binary entities file" << fileName;
+        return false;
+    }
+
+    BinaryEntitiesHeader header;
+    memcpy(&header, fileData, sizeof(header));
+    if (memcmp(header.magic, BINARY_ENTITIES_MAGIC, sizeof(header.magic)) != 0
+            || header.formatVersion != BINARY_ENTITIES_FORMAT_VERSION
+            || header.packetVersion != versionForPacketType(PacketType::EntityAdd)) {
+        qCDebug(entities) << "Binary entities file" << fileName << "is from another version, not reading it";
+        return false;
+    }
+
+    // check all the records are there before we add any entity
+    std::vector<qint64> recordOffsets;
+    recordOffsets.reserve(header.numEntities);
+    qint64 offset = sizeof(header);
+    for (quint32 i = 0; i < header.numEntities; i++) {
+        BinaryEntityRecordHeader recordHeader;
+        if (offset + (qint64)sizeof(recordHeader) > fileSize) {
+            break;
+        }
+        memcpy(&recordHeader, fileData + offset, sizeof(recordHeader));
+        if (offset + (qint64)sizeof(recordHeader) + recordHeader.size > fileSize) {
+            break;
+        }
+        recordOffsets.push_back(offset);
+        offset += sizeof(recordHeader) + recordHeader.size;
+    }
+    if (recordOffsets.size() != header.numEntities) {
+        qCDebug(entities) << "ERROR binary entities file" << fileName << "is truncated";
+        return false;
+    }
+
+    // anything the changes mention is added from them instead
+    QVariantMap changedDescription;
+    mergeChangesIntoMap(changedDescription, changesList);
+    QSet<QUuid> changedIDs;
+    foreach (const QVariant& changesVariant, changesList) {
+        QVariantMap changes = changesVariant.toMap();
+        foreach (const QVariant& deletedVariant, changes["Deleted"].toList()) {
+            changedIDs.insert(QUuid(deletedVariant.toString()));
+        }
+        foreach (const QVariant& entityVariant, changes["Entities"].toList()) {
+            changedIDs.insert(QUuid(entityVariant.toMap()["id"].toString()));
+        }
+    }
+    QVariantList entitiesQList = changedDescription["Entities"].toList();
+
+    bool success = true;
+    QVector<EntityItemID> entityItemIDs;
+    QVector<EntityItemProperties> entityProperties;
+    entityItemIDs.reserve((int)recordOffsets.size());
+    entityProperties.reserve((int)recordOffsets.size());
+    for (qint64 recordOffset : recordOffsets) {
+        BinaryEntityRecordHeader recordHeader;
+        memcpy(&recordHeader, fileData + recordOffset, sizeof(recordHeader));
+        const unsigned char* recordData = fileData + recordOffset + sizeof(recordHeader);
+
+        if (recordHeader.encoding == BinaryJSONEncoding) {
+            QByteArray jsonData = QByteArray::fromRawData(reinterpret_cast<const char*>(recordData), recordHeader.size);
+            QVariant entityVariant = QJsonDocument::fromBinaryData(jsonData).toVariant();
+            if (!changedIDs.contains(QUuid(entityVariant.toMap()["id"].toString()))) {
+                entitiesQList << entityVariant;
+            }
+            continue;
+        }
+
+        EntityItemID entityItemID;
+        EntityItemProperties properties;
+        int processedBytes = 0;
+        if (!EntityItemProperties::decodeEntityEditPacket(recordData, recordHeader.size, processedBytes,
+                                                          entityItemID, properties)) {
+            qCDebug(entities) << "ERROR decoding entity from binary entities file" << fileName;
             success = false;
+            continue;
+        }
+        if (changedIDs.contains(entityItemID)) {
+            continue;
         }
+        properties.setCreated(recordHeader.created);
+
+        entityItemIDs << entityItemID;
+        entityProperties << properties;
+    }
+    file.unmap(const_cast<unsigned char*>(fileData));
+
+    success = addEntitiesFromLoad(entityItemIDs, entityProperties) && success;
+
+    if (!entitiesQList.isEmpty()) {
+        changedDescription["Entities"] = entitiesQList;
+        success = readFromMap(changedDescription) && success;
     }
     return success;
 }
@@ -12,10 +12,15 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+#include <mutex>
+
 #include <QSet>
 #include <QVector>
 
+#include <FlatUUIDHash.h>
 #include <Octree.h>
+#include <RegisteredMetaTypes.h>
 #include <SpatialParentFinder.h>
 
 class EntityTree;
@@ -86,7 +91,7 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const override;
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
-                                      const SharedNodePointer& senderNode) override;
+                                      const SharedNodePointer& senderNode, quint64& lockWaitUsecs) override;
 
     virtual bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         OctreeElementPointer& node, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
@@ -97,6 +102,24 @@ public:
         bool* accurateResult = NULL,
         bool precisionPicking = false);
 
+    struct RayIntersection {
+        bool intersects { false };
+        float distance { FLT_MAX };
+        BoxFace face { UNKNOWN_FACE };
+        glm::vec3 surfaceNormal;
+        EntityItemPointer entity;
+    };
+
+    /// finds the intersection of each ray, the rays are spread over the threads of the global thread pool
+    /// unless precisionPicking, which may touch render models, is asked for
+    /// \param accurateResult[out] set false if a TryLock didn't get the lock, in which case nothing was found
+    QVector<RayIntersection> findRayIntersections(const QVector<PickRay>& rays,
+        const QVector<EntityItemID>& entityIdsToInclude = QVector<EntityItemID>(),
+        const QVector<EntityItemID>& entityIdsToDiscard = QVector<EntityItemID>(),
+        Octree::lockType lockType = Octree::TryLock,
+        bool* accurateResult = NULL,
+        bool precisionPicking = false);
+
     virtual bool rootElementHasData() const override { return true; }
 
     // the root at least needs to store the number of entities in the packet/buffer
@@ -104,6 +127,7 @@ public:
     virtual bool suppressEmptySubtrees() const override { return false; }
     virtual void releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncodeData) const override;
     virtual bool mustIncludeAllChildData() const override { return false; }
+    virtual void getOccluders(std::vector<AABox>& occluders) const override;
 
     virtual bool versionHasSVOfileBreaks(PacketVersion thisVersion) const override
                     { return thisVersion >= VERSION_ENTITIES_HAS_FILE_BREAKS; }
@@ -115,6 +139,10 @@ public:
 
     EntityItemPointer addEntity(const EntityItemID& entityID, const EntityItemProperties& properties);
 
+    // adds many entities in a single pass over the tree, returns the ones that were added
+    QVector<EntityItemPointer> addEntities(const QVector<EntityItemID>& entityIDs,
+                                           const QVector<EntityItemProperties>& properties);
+
     // use this method if you only know the entityID
     bool updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
 
@@ -153,6 +181,13 @@ public:
     /// \remark Side effect: any initial contents in entities will be lost
     void findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities);
 
+    /// the batched forms of findEntities, each query's entities are at the same index in foundEntities
+    /// the queries are spread over the threads of the global thread pool, the caller holds the read lock for them all
+    void findEntities(const QVector<glm::vec3>& centers, const QVector<float>& radii,
+                      QVector<QVector<EntityItemPointer>>& foundEntities);
+    void findEntities(const QVector<AACube>& cubes, QVector<QVector<EntityItemPointer>>& foundEntities);
+    void findEntities(const QVector<AABox>& boxes, QVector<QVector<EntityItemPointer>>& foundEntities);
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -194,6 +229,12 @@ public:
 
     void entityChanged(EntityItemPointer entity);
 
+    // The entities added, edited, moved or deleted since the last take, for an observer that only wants to look at
+    // what changed. Nothing is kept until someone asks for it.
+    void setTrackChangedEntities(bool track);
+    void noteChangedEntity(const EntityItemID& entityID);
+    void takeChangedEntities(QSet<EntityItemID>& changed);
+
     void emitEntityScriptChanging(const EntityItemID& entityItemID, const bool reload);
 
     void setSimulation(EntitySimulationPointer simulation);
@@ -208,6 +249,13 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
+    virtual bool writeToJSON(QByteArray& jsonData, OctreeElementPointer element, bool skipDefaultValues,
+                             bool skipThoseWithBadParents) override;
+    virtual bool readFromJSON(const QByteArray& jsonData) override;
+    virtual bool writeChangesToMap(QVariantMap& changes, quint64 sinceTime) override;
+    virtual void mergeChangesIntoMap(QVariantMap& entityDescription, const QVariantList& changesList) const override;
+    virtual bool writeToBinaryFile(const char* fileName) override;
+    virtual bool readFromBinaryFile(const char* fileName, const QVariantList& changesList) override;
 
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
@@ -272,19 +320,26 @@ protected:
     bool updateEntityWithElement(EntityItemPointer entity, const EntityItemProperties& properties,
                                  EntityTreeElementPointer containingElement,
                                  const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
-    static bool findNearPointOperation(OctreeElementPointer element, void* extraData);
-    static bool findInSphereOperation(OctreeElementPointer element, void* extraData);
-    static bool findInCubeOperation(OctreeElementPointer element, void* extraData);
-    static bool findInBoxOperation(OctreeElementPointer element, void* extraData);
-    static bool sendEntitiesOperation(OctreeElementPointer element, void* extraData);
+    static bool findNearPointOperation(const OctreeElementPointer& element, void* extraData);
+    static bool findInSphereOperation(const OctreeElementPointer& element, void* extraData);
+    static bool findInCubeOperation(const OctreeElementPointer& element, void* extraData);
+    static bool findInBoxOperation(const OctreeElementPointer& element, void* extraData);
+    static bool sendEntitiesOperation(const OctreeElementPointer& element, void* extraData);
 
     void notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode);
 
+    // an entity of the type and with the properties asked for that isn't in the tree yet, or null if it can't be added
+    EntityItemPointer constructNewEntity(const EntityItemID& entityID, const EntityItemProperties& properties);
+    void trackAddedEntity(EntityItemPointer entity); // postAddEntity, without the missing parent fixup
+    bool addEntitiesFromLoad(const QVector<EntityItemID>& entityItemIDs, const QVector<EntityItemProperties>& entityProperties);
+
     QReadWriteLock _newlyCreatedHooksLock;
     QVector<NewlyCreatedEntityHook*> _newlyCreatedHooks;
 
     mutable QReadWriteLock _recentlyDeletedEntitiesLock; /// lock of server side recent deletes
     QMultiMap<quint64, QUuid> _recentlyDeletedEntityItemIDs; /// server side recent deletes
+    bool _isJournalingDeletes { false }; /// set by the first writeChangesToMap
+    QSet<QUuid> _unjournaledDeletedEntityItemIDs; /// server side deletes since the last writeChangesToMap
 
     mutable QReadWriteLock _deletedEntitiesLock; /// lock of client side recent deletes
     QSet<QUuid> _deletedEntityItemIDs; /// client side recent deletes
@@ -303,6 +358,13 @@ protected:
 
     mutable QReadWriteLock _entityToElementLock;
     QHash<EntityItemID, EntityTreeElementPointer> _entityToElementMap;
+    // the same entities by ID, kept with the element map, for the lookups by ID that don't need the element
+    FlatUUIDHash<EntityItemPointer> _entityMap;
+
+    // the boxes the server hides what is behind from its viewers with, gathered again once they are out of date
+    mutable std::mutex _occludersMutex;
+    mutable std::vector<AABox> _occluders;
+    mutable quint64 _occludersGatheredAt { 0 };
 
     EntitySimulationPointer _simulation;
 
@@ -332,6 +394,10 @@ protected:
     QVector<EntityItemWeakPointer> _missingParent; // entites with a parentID but no (yet) known parent instance
     mutable QReadWriteLock _missingParentLock;
 
+    std::atomic<bool> _trackChangedEntities { false };
+    std::mutex _changedEntitiesMutex;
+    QSet<EntityItemID> _changedEntities;
+
     // we maintain a list of avatarIDs to notice when an entity is a child of one.
     QSet<QUuid> _avatarIDs; // IDs of avatars connected to entity server
     QHash<QUuid, QSet<EntityItemID>> _childrenOfAvatars;  // which entities are children of which avatars
@@ -71,7 +71,7 @@ void EntityTreeElement::initializeExtraEncodeData(EncodeBitstreamParams& params)
         EntityTreeElementExtraEncodeData* entityTreeElementExtraEncodeData = new EntityTreeElementExtraEncodeData();
         entityTreeElementExtraEncodeData->elementCompleted = (_entityItems.size() == 0);
         for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-            EntityTreeElementPointer child = getChildAtIndex(i);
+            EntityTreeElement* child = getRawChildAtIndex(i);
             if (!child) {
                 entityTreeElementExtraEncodeData->childCompleted[i] = true; // if no child exists, it is completed
             } else {
@@ -83,7 +83,7 @@ void EntityTreeElement::initializeExtraEncodeData(EncodeBitstreamParams& params)
             }
         }
         forEachEntity([&](EntityItemPointer entity) {
-            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
+            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityPropertiesToSend(params));
         });
 
         // TODO: some of these inserts might be redundant!!!
@@ -112,7 +112,7 @@ bool EntityTreeElement::shouldIncludeChildData(int childIndex, EncodeBitstreamPa
 }
 
 bool EntityTreeElement::shouldRecurseChildTree(int childIndex, EncodeBitstreamParams& params) const {
-    EntityTreeElementPointer childElement = getChildAtIndex(childIndex);
+    EntityTreeElement* childElement = getRawChildAtIndex(childIndex);
     if (childElement->alreadyFullyEncoded(params)) {
         return false;
     }
@@ -181,15 +181,15 @@ void EntityTreeElement::elementEncodeComplete(EncodeBitstreamParams& params) con
 
     bool someChildTreeNotComplete = false;
     for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        EntityTreeElementPointer childElement = getChildAtIndex(i);
+        EntityTreeElement* childElement = getRawChildAtIndex(i);
         if (childElement) {
 
             // why would this ever fail???
             // If we've encoding this element before... but we're coming back a second time in an attempt to
             // encoud our parent... this might happen.
-            if (extraEncodeData->contains(childElement.get())) {
+            if (extraEncodeData->contains(childElement)) {
                 EntityTreeElementExtraEncodeData* childExtraEncodeData
-                    = static_cast<EntityTreeElementExtraEncodeData*>((*extraEncodeData)[childElement.get()]);
+                    = static_cast<EntityTreeElementExtraEncodeData*>((*extraEncodeData)[childElement]);
 
                 if (wantDebug) {
                     qCDebug(entities) << "checking child: " << childElement->_cube;
@@ -249,7 +249,7 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
         entityTreeElementExtraEncodeData->elementCompleted = !hasContent();
 
         for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-            EntityTreeElementPointer child = getChildAtIndex(i);
+            EntityTreeElement* child = getRawChildAtIndex(i);
             if (!child) {
                 entityTreeElementExtraEncodeData->childCompleted[i] = true; // if no child exists, it is completed
             } else {
@@ -262,7 +262,7 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
             }
         }
         forEachEntity([&](EntityItemPointer entity) {
-            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
+            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityPropertiesToSend(params));
         });
     }
 
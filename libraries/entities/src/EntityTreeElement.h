@@ -90,6 +90,11 @@ public:
         return std::static_pointer_cast<EntityTreeElement>(OctreeElement::getChildAtIndex(index));
     }
 
+    // for traversals that only look at the child while we hold it, saves the refcount traffic of the version above
+    EntityTreeElement* getRawChildAtIndex(int index) const {
+        return static_cast<EntityTreeElement*>(OctreeElement::getChildAtIndex(index).get());
+    }
+
     // methods you can and should override to implement your tree functionality
 
     /// Adds a child to the current element. Override this if there is additional child initialization your class needs.
@@ -10,6 +10,10 @@
 //
 
 #include "EntityTreeHeadlessViewer.h"
+
+#include <QtScript/QScriptValue>
+
+#include "EntityItemProperties.h"
 #include "SimpleEntitySimulation.h"
 
 EntityTreeHeadlessViewer::EntityTreeHeadlessViewer()
@@ -30,6 +34,41 @@ void EntityTreeHeadlessViewer::init() {
     }
 }
 
+void EntityTreeHeadlessViewer::setWantedProperties(const QStringList& propertyNames) {
+    if (propertyNames.isEmpty()) {
+        setExcludedProperties(QByteArray());
+        return;
+    }
+
+    EntityPropertyFlags wantedProperties;
+    for (const QString& propertyName : propertyNames) {
+        EntityItemProperties::entityPropertyFlagsFromScriptValue(QScriptValue(propertyName), wantedProperties);
+    }
+
+    // what the tree and its simulation need for where an entity is and how it moves
+    wantedProperties += PROP_POSITION;
+    wantedProperties += PROP_ROTATION;
+    wantedProperties += PROP_DIMENSIONS;
+    wantedProperties += PROP_QUERY_AA_CUBE;
+    wantedProperties += PROP_PARENT_ID;
+    wantedProperties += PROP_PARENT_JOINT_INDEX;
+    wantedProperties += PROP_VELOCITY;
+    wantedProperties += PROP_ANGULAR_VELOCITY;
+    wantedProperties += PROP_GRAVITY;
+    wantedProperties += PROP_ACCELERATION;
+    wantedProperties += PROP_DAMPING;
+    wantedProperties += PROP_ANGULAR_DAMPING;
+    wantedProperties += PROP_LIFETIME;
+
+    EntityPropertyFlags excludedProperties;
+    for (int property = PROP_CUSTOM_PROPERTIES_INCLUDED + 1; property < PROP_AFTER_LAST_ITEM; property++) {
+        if (!wantedProperties.getHasProperty((EntityPropertyList)property)) {
+            excludedProperties += (EntityPropertyList)property;
+        }
+    }
+    setExcludedProperties(excludedProperties.encode());
+}
+
 void EntityTreeHeadlessViewer::update() {
     if (_tree) {
         EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
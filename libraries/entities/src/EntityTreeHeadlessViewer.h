@@ -42,6 +42,12 @@ public:
 
     virtual void init() override;
 
+public slots:
+    // Asks the entity servers for only these properties of the entities, by their script names, along with the ones
+    // the tree needs to place and move them. It is meant to be called before the viewer starts to query, entities
+    // already received keep what they have. With no names at all every property is asked for again.
+    void setWantedProperties(const QStringList& propertyNames);
+
 protected:
     virtual OctreePointer createTree() override {
         EntityTreePointer newTree = EntityTreePointer(new EntityTree(true));
@@ -49,6 +49,31 @@ void KeyLightPropertyGroup::copyFromScriptValue(const QScriptValue& object, bool
     COPY_PROPERTY_FROM_QSCRIPTVALUE_GETTER(keyLightDirection, glmVec3, setDirection, getDirection);
 }
 
+void KeyLightPropertyGroup::copyToJSON(const EntityPropertyFlags& desiredProperties, JSONWriter& writer, bool skipDefaults, EntityItemProperties& defaultEntityProperties) const {
+    writer.beginGroup("keyLight");
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_KEYLIGHT_COLOR, KeyLight, keyLight, Color, color);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_KEYLIGHT_INTENSITY, KeyLight, keyLight, Intensity, intensity);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_KEYLIGHT_AMBIENT_INTENSITY, KeyLight, keyLight, AmbientIntensity, ambientIntensity);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_KEYLIGHT_DIRECTION, KeyLight, keyLight, Direction, direction);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_KEYLIGHT_AMBIENT_URL, KeyLight, keyLight, AmbientURL, ambientURL);
+    writer.endGroup();
+}
+
+void KeyLightPropertyGroup::copyFromJSON(const QJsonObject& object, bool& _defaultSettings) {
+
+    COPY_GROUP_PROPERTY_FROM_JSON(keyLight, color, xColor, setColor);
+    COPY_GROUP_PROPERTY_FROM_JSON(keyLight, intensity, float, setIntensity);
+    COPY_GROUP_PROPERTY_FROM_JSON(keyLight, ambientIntensity, float, setAmbientIntensity);
+    COPY_GROUP_PROPERTY_FROM_JSON(keyLight, direction, glmVec3, setDirection);
+    COPY_GROUP_PROPERTY_FROM_JSON(keyLight, ambientURL, QString, setAmbientURL);
+    
+    // legacy property support
+    COPY_PROPERTY_FROM_JSON_GETTER(keyLightColor, xColor, setColor, getColor);
+    COPY_PROPERTY_FROM_JSON_GETTER(keyLightIntensity, float, setIntensity, getIntensity);
+    COPY_PROPERTY_FROM_JSON_GETTER(keyLightAmbientIntensity, float, setAmbientIntensity, getAmbientIntensity);
+    COPY_PROPERTY_FROM_JSON_GETTER(keyLightDirection, glmVec3, setDirection, getDirection);
+}
+
 
 void KeyLightPropertyGroup::debugDump() const {
     qDebug() << "   KeyLightPropertyGroup: ---------------------------------------------";
@@ -18,6 +18,8 @@
 #include "EntityPropertyFlags.h"
 
 class EntityItemProperties;
+class JSONWriter;
+class QJsonObject;
 class EncodeBitstreamParams;
 class OctreePacketData;
 class EntityTreeElementExtraEncodeData;
@@ -56,6 +58,8 @@ public:
     // EntityItemProperty related helpers
     virtual void copyToScriptValue(const EntityPropertyFlags& desiredProperties, QScriptValue& properties, QScriptEngine* engine, bool skipDefaults, EntityItemProperties& defaultEntityProperties) const = 0;
     virtual void copyFromScriptValue(const QScriptValue& object, bool& _defaultSettings) = 0;
+    virtual void copyToJSON(const EntityPropertyFlags& desiredProperties, JSONWriter& writer, bool skipDefaults, EntityItemProperties& defaultEntityProperties) const = 0;
+    virtual void copyFromJSON(const QJsonObject& object, bool& _defaultSettings) = 0;
     virtual void debugDump() const { }
     virtual void listChangedProperties(QList<QString>& out) { }
 
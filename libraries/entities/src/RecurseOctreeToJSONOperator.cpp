@@ -0,0 +1,53 @@
+//
+//  RecurseOctreeToJSONOperator.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RecurseOctreeToJSONOperator.h"
+
+#include <JSONWriter.h>
+
+#include "EntityItemProperties.h"
+
+RecurseOctreeToJSONOperator::RecurseOctreeToJSONOperator(JSONWriter& writer,
+                                                         OctreeElementPointer top,
+                                                         bool skipDefaultValues,
+                                                         bool skipThoseWithBadParents) :
+        RecurseOctreeOperator(),
+        _writer(writer),
+        _top(top),
+        _skipDefaultValues(skipDefaultValues),
+        _skipThoseWithBadParents(skipThoseWithBadParents)
+{
+    // if some element "top" was given, only save information for that element and its children.
+    _withinTop = !_top;
+}
+
+bool RecurseOctreeToJSONOperator::preRecursion(const OctreeElementPointer& element) {
+    if (element == _top) {
+        _withinTop = true;
+    }
+    return true;
+}
+
+bool RecurseOctreeToJSONOperator::postRecursion(const OctreeElementPointer& element) {
+    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+
+    entityTreeElement->forEachEntity([&](EntityItemPointer entityItem) {
+        if (_skipThoseWithBadParents && !entityItem->isParentIDValid()) {
+            return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
+        }
+        entityItem->getProperties().copyToJSON(_writer, _skipDefaultValues);
+    });
+
+    if (element == _top) {
+        _withinTop = false;
+    }
+    return true;
+}
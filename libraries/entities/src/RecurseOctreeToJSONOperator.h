@@ -0,0 +1,34 @@
+//
+//  RecurseOctreeToJSONOperator.h
+//  libraries/entities/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RecurseOctreeToJSONOperator_h
+#define hifi_RecurseOctreeToJSONOperator_h
+
+#include "EntityTree.h"
+
+class JSONWriter;
+
+// As RecurseOctreeToMapOperator, but writes the properties of the entities straight to an open JSON array
+class RecurseOctreeToJSONOperator : public RecurseOctreeOperator {
+public:
+    RecurseOctreeToJSONOperator(JSONWriter& writer, OctreeElementPointer top, bool skipDefaultValues,
+                                bool skipThoseWithBadParents);
+    bool preRecursion(const OctreeElementPointer& element) override;
+    bool postRecursion(const OctreeElementPointer& element) override;
+ private:
+    JSONWriter& _writer;
+    OctreeElementPointer _top;
+    bool _withinTop;
+    bool _skipDefaultValues;
+    bool _skipThoseWithBadParents;
+};
+
+#endif // hifi_RecurseOctreeToJSONOperator_h
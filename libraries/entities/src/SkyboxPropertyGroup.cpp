@@ -27,6 +27,18 @@ void SkyboxPropertyGroup::copyFromScriptValue(const QScriptValue& object, bool&
     COPY_GROUP_PROPERTY_FROM_QSCRIPTVALUE(skybox, url, QString, setURL);
 }
 
+void SkyboxPropertyGroup::copyToJSON(const EntityPropertyFlags& desiredProperties, JSONWriter& writer, bool skipDefaults, EntityItemProperties& defaultEntityProperties) const {
+    writer.beginGroup("skybox");
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_SKYBOX_COLOR, Skybox, skybox, Color, color);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_SKYBOX_URL, Skybox, skybox, URL, url);
+    writer.endGroup();
+}
+
+void SkyboxPropertyGroup::copyFromJSON(const QJsonObject& object, bool& _defaultSettings) {
+    COPY_GROUP_PROPERTY_FROM_JSON(skybox, color, xColor, setColor);
+    COPY_GROUP_PROPERTY_FROM_JSON(skybox, url, QString, setURL);
+}
+
 void SkyboxPropertyGroup::debugDump() const {
     qDebug() << "   SkyboxPropertyGroup: ---------------------------------------------";
     qDebug() << "       Color:" << getColor() << " has changed:" << colorChanged();
@@ -55,6 +55,37 @@ void StagePropertyGroup::copyFromScriptValue(const QScriptValue& object, bool& _
     COPY_GROUP_PROPERTY_FROM_QSCRIPTVALUE(stage, automaticHourDay, bool, setAutomaticHourDay);
 }
 
+void StagePropertyGroup::copyToJSON(const EntityPropertyFlags& desiredProperties, JSONWriter& writer, bool skipDefaults, EntityItemProperties& defaultEntityProperties) const {
+    writer.beginGroup("stage");
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_STAGE_SUN_MODEL_ENABLED, Stage, stage, SunModelEnabled, sunModelEnabled);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_STAGE_LATITUDE, Stage, stage, Latitude, latitude);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_STAGE_LONGITUDE, Stage, stage, Longitude, longitude);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_STAGE_ALTITUDE, Stage, stage, Altitude, altitude);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_STAGE_DAY, Stage, stage, Day, day);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_STAGE_HOUR, Stage, stage, Hour, hour);
+    COPY_GROUP_PROPERTY_TO_JSON(PROP_STAGE_AUTOMATIC_HOURDAY, Stage, stage, AutomaticHourDay, automaticHourDay);
+    writer.endGroup();
+}
+
+void StagePropertyGroup::copyFromJSON(const QJsonObject& object, bool& _defaultSettings) {
+
+    // Backward compatibility support for the old way of doing stage properties
+    COPY_PROPERTY_FROM_JSON_GETTER(stageSunModelEnabled, bool, setSunModelEnabled, getSunModelEnabled);
+    COPY_PROPERTY_FROM_JSON_GETTER(stageLatitude, float, setLatitude, getLatitude);
+    COPY_PROPERTY_FROM_JSON_GETTER(stageLongitude, float, setLongitude, getLongitude);
+    COPY_PROPERTY_FROM_JSON_GETTER(stageAltitude, float, setAltitude, getAltitude);
+    COPY_PROPERTY_FROM_JSON_GETTER(stageDay, uint16_t, setDay, getDay);
+    COPY_PROPERTY_FROM_JSON_GETTER(stageHour, float, setHour, getHour);
+
+    COPY_GROUP_PROPERTY_FROM_JSON(stage, sunModelEnabled, bool, setSunModelEnabled);
+    COPY_GROUP_PROPERTY_FROM_JSON(stage, latitude, float, setLatitude);
+    COPY_GROUP_PROPERTY_FROM_JSON(stage, longitude, float, setLongitude);
+    COPY_GROUP_PROPERTY_FROM_JSON(stage, altitude, float, setAltitude);
+    COPY_GROUP_PROPERTY_FROM_JSON(stage, day, uint16_t, setDay);
+    COPY_GROUP_PROPERTY_FROM_JSON(stage, hour, float, setHour);
+    COPY_GROUP_PROPERTY_FROM_JSON(stage, automaticHourDay, bool, setAutomaticHourDay);
+}
+
 void StagePropertyGroup::debugDump() const {
     qDebug() << "   StagePropertyGroup: ---------------------------------------------";
     qDebug() << "     _sunModelEnabled:" << _sunModelEnabled;
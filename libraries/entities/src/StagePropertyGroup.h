@@ -34,6 +34,9 @@ public:
                                    QScriptEngine* engine, bool skipDefaults,
                                    EntityItemProperties& defaultEntityProperties) const override;
     virtual void copyFromScriptValue(const QScriptValue& object, bool& _defaultSettings) override;
+    virtual void copyToJSON(const EntityPropertyFlags& desiredProperties, JSONWriter& writer, bool skipDefaults,
+                            EntityItemProperties& defaultEntityProperties) const override;
+    virtual void copyFromJSON(const QJsonObject& object, bool& _defaultSettings) override;
     virtual void debugDump() const override;
     virtual void listChangedProperties(QList<QString>& out) override;
 
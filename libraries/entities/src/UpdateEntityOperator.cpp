@@ -112,7 +112,7 @@ bool UpdateEntityOperator::subTreeContainsNewEntity(OctreeElementPointer element
 }
 
 
-bool UpdateEntityOperator::preRecursion(OctreeElementPointer element) {
+bool UpdateEntityOperator::preRecursion(const OctreeElementPointer& element) {
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
 
     // In Pre-recursion, we're generally deciding whether or not we want to recurse this
@@ -223,6 +223,7 @@ bool UpdateEntityOperator::preRecursion(OctreeElementPointer element) {
                 entityTreeElement->addEntityItem(_existingEntity);
                 _tree->setContainingElement(_entityItemID, entityTreeElement);
             }
+            _tree->trackChangedElement(entityTreeElement);
             _foundNew = true; // we found the new element
             _removeOld = false; // and it has already been removed from the old
         } else {
@@ -238,7 +239,7 @@ bool UpdateEntityOperator::preRecursion(OctreeElementPointer element) {
     return keepSearching; // if we haven't yet found it, keep looking
 }
 
-bool UpdateEntityOperator::postRecursion(OctreeElementPointer element) {
+bool UpdateEntityOperator::postRecursion(const OctreeElementPointer& element) {
     // Post-recursion is the unwinding process. For this operation, while we
     // unwind we want to mark the path as being dirty if we changed it below.
     // We might have two paths, one for the old entity and one for the new entity.
@@ -270,7 +271,7 @@ bool UpdateEntityOperator::postRecursion(OctreeElementPointer element) {
     return keepSearching; // if we haven't yet found it, keep looking
 }
 
-OctreeElementPointer UpdateEntityOperator::possiblyCreateChildAt(OctreeElementPointer element, int childIndex) {
+OctreeElementPointer UpdateEntityOperator::possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) {
     // If we're getting called, it's because there was no child element at this index while recursing.
     // We only care if this happens while still searching for the new entity location.
     // Check to see if
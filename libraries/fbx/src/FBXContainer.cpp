@@ -0,0 +1,492 @@
+//
+//  FBXContainer.cpp
+//  libraries/fbx/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXContainer.h"
+
+#include <memory>
+#include <string.h>
+
+#include <QtCore/QDataStream>
+
+#include <ParallelFor.h>
+
+static const char CONTAINER_MAGIC[4] = { 'H', 'F', 'M', 'D' };
+static const quint32 CONTAINER_VERSION = 1;
+
+// The container is only ever read back on the machine that wrote it, so the arrays of plain values are written
+// as they are in memory, and only the Qt types go through the stream operators.
+namespace {
+
+template <typename T>
+void writeValue(QDataStream& stream, const T& value) {
+    stream.writeRawData(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void readValue(QDataStream& stream, T& value) {
+    if (stream.readRawData(reinterpret_cast<char*>(&value), sizeof(T)) != sizeof(T)) {
+        stream.setStatus(QDataStream::ReadPastEnd);
+    }
+}
+
+// guards the sizes read back, so corrupt data can't ask for an allocation larger than what is left to read
+bool checkSize(QDataStream& stream, quint32 count, qint64 elementSize) {
+    if (stream.status() != QDataStream::Ok || (qint64)count * elementSize > stream.device()->bytesAvailable()) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+void writeArray(QDataStream& stream, const QVector<T>& array) {
+    stream << (quint32)array.size();
+    stream.writeRawData(reinterpret_cast<const char*>(array.constData()), array.size() * (int)sizeof(T));
+}
+
+template <typename T>
+void readArray(QDataStream& stream, QVector<T>& array) {
+    quint32 size = 0;
+    stream >> size;
+    if (!checkSize(stream, size, sizeof(T))) {
+        return;
+    }
+    array.resize(size);
+    stream.readRawData(reinterpret_cast<char*>(array.data()), size * (int)sizeof(T));
+}
+
+void writeExtents(QDataStream& stream, const Extents& extents) {
+    writeValue(stream, extents.minimum);
+    writeValue(stream, extents.maximum);
+}
+
+void readExtents(QDataStream& stream, Extents& extents) {
+    readValue(stream, extents.minimum);
+    readValue(stream, extents.maximum);
+}
+
+void writeTexture(QDataStream& stream, const FBXTexture& texture) {
+    stream << texture.name << texture.filename << texture.content;
+    stream << (quint8)texture.transform.isIdentity();
+    if (!texture.transform.isIdentity()) {
+        writeValue(stream, texture.transform.getTranslation());
+        writeValue(stream, texture.transform.getRotation());
+        writeValue(stream, texture.transform.getScale());
+    }
+    stream << (qint32)texture.texcoordSet << texture.texcoordSetName << (quint8)texture.isBumpmap;
+}
+
+void readTexture(QDataStream& stream, FBXTexture& texture) {
+    quint8 isIdentity;
+    stream >> texture.name >> texture.filename >> texture.content >> isIdentity;
+    texture.transform.setIdentity();
+    if (!isIdentity) {
+        Transform::Vec3 translation;
+        Transform::Quat rotation;
+        Transform::Vec3 scale;
+        readValue(stream, translation);
+        readValue(stream, rotation);
+        readValue(stream, scale);
+        texture.transform.setTranslation(translation);
+        texture.transform.setRotation(rotation);
+        texture.transform.setScale(scale);
+    }
+    qint32 texcoordSet;
+    quint8 isBumpmap;
+    stream >> texcoordSet >> texture.texcoordSetName >> isBumpmap;
+    texture.texcoordSet = texcoordSet;
+    texture.isBumpmap = isBumpmap != 0;
+}
+
+// the same fields, in the same order, for the writes and the reads
+#define MATERIAL_VALUES(X) \
+    X(diffuseColor) X(diffuseFactor) X(specularColor) X(specularFactor) X(emissiveColor) X(emissiveFactor) \
+    X(shininess) X(opacity) X(metallic) X(roughness) X(emissiveIntensity) X(ambientFactor) X(lightmapParams) \
+    X(isPBSMaterial) X(useNormalMap) X(useAlbedoMap) X(useOpacityMap) X(useRoughnessMap) X(useSpecularMap) \
+    X(useMetallicMap) X(useEmissiveMap) X(useOcclusionMap)
+
+#define MATERIAL_TEXTURES(X) \
+    X(normalTexture) X(albedoTexture) X(opacityTexture) X(glossTexture) X(roughnessTexture) X(specularTexture) \
+    X(metallicTexture) X(emissiveTexture) X(occlusionTexture) X(scatteringTexture) X(lightmapTexture)
+
+void writeMaterial(QDataStream& stream, const FBXMaterial& material) {
+#define WRITE_VALUE(field) writeValue(stream, material.field);
+#define WRITE_TEXTURE(field) writeTexture(stream, material.field);
+    MATERIAL_VALUES(WRITE_VALUE)
+    MATERIAL_TEXTURES(WRITE_TEXTURE)
+#undef WRITE_VALUE
+#undef WRITE_TEXTURE
+    stream << material.materialID << material.name << material.shadingModel;
+
+    // the reader only sets the values of the model material, its maps are added as the textures are loaded
+    const auto& modelMaterial = material._material;
+    stream << (quint8)(modelMaterial ? 1 : 0);
+    if (modelMaterial) {
+        writeValue(stream, modelMaterial->getEmissive(false));
+        writeValue(stream, modelMaterial->getAlbedo(false));
+        writeValue(stream, modelMaterial->getFresnel(false));
+        writeValue(stream, modelMaterial->getMetallic());
+        writeValue(stream, modelMaterial->getRoughness());
+        writeValue(stream, modelMaterial->getScattering());
+        writeValue(stream, modelMaterial->getOpacity());
+        stream << (quint8)modelMaterial->isUnlit();
+    }
+}
+
+void readMaterial(QDataStream& stream, FBXMaterial& material) {
+#define READ_VALUE(field) readValue(stream, material.field);
+#define READ_TEXTURE(field) readTexture(stream, material.field);
+    MATERIAL_VALUES(READ_VALUE)
+    MATERIAL_TEXTURES(READ_TEXTURE)
+#undef READ_VALUE
+#undef READ_TEXTURE
+    stream >> material.materialID >> material.name >> material.shadingModel;
+
+    quint8 hasModelMaterial;
+    stream >> hasModelMaterial;
+    if (hasModelMaterial) {
+        model::Material::Color emissive, albedo, fresnel;
+        float metallic, roughness, scattering, opacity;
+        quint8 isUnlit;
+        readValue(stream, emissive);
+        readValue(stream, albedo);
+        readValue(stream, fresnel);
+        readValue(stream, metallic);
+        readValue(stream, roughness);
+        readValue(stream, scattering);
+        readValue(stream, opacity);
+        stream >> isUnlit;
+
+        material._material = std::make_shared<model::Material>();
+        material._material->setEmissive(emissive, false);
+        material._material->setAlbedo(albedo, false);
+        material._material->setFresnel(fresnel, false);
+        material._material->setMetallic(metallic);
+        material._material->setRoughness(roughness);
+        material._material->setScattering(scattering);
+        material._material->setOpacity(opacity);
+        material._material->setUnlit(isUnlit != 0);
+    }
+}
+
+#undef MATERIAL_VALUES
+#undef MATERIAL_TEXTURES
+
+void writeJoint(QDataStream& stream, const FBXJoint& joint) {
+    writeArray(stream, joint.shapeInfo.points);
+    writeArray(stream, joint.freeLineage);
+    writeValue(stream, joint.isFree);
+    writeValue(stream, joint.parentIndex);
+    writeValue(stream, joint.distanceToParent);
+    writeValue(stream, joint.translation);
+    writeValue(stream, joint.preTransform);
+    writeValue(stream, joint.preRotation);
+    writeValue(stream, joint.rotation);
+    writeValue(stream, joint.postRotation);
+    writeValue(stream, joint.postTransform);
+    writeValue(stream, joint.transform);
+    writeValue(stream, joint.rotationMin);
+    writeValue(stream, joint.rotationMax);
+    writeValue(stream, joint.inverseDefaultRotation);
+    writeValue(stream, joint.inverseBindRotation);
+    writeValue(stream, joint.bindTransform);
+    stream << joint.name;
+    writeValue(stream, joint.isSkeletonJoint);
+    writeValue(stream, joint.bindTransformFoundInCluster);
+}
+
+void readJoint(QDataStream& stream, FBXJoint& joint) {
+    readArray(stream, joint.shapeInfo.points);
+    readArray(stream, joint.freeLineage);
+    readValue(stream, joint.isFree);
+    readValue(stream, joint.parentIndex);
+    readValue(stream, joint.distanceToParent);
+    readValue(stream, joint.translation);
+    readValue(stream, joint.preTransform);
+    readValue(stream, joint.preRotation);
+    readValue(stream, joint.rotation);
+    readValue(stream, joint.postRotation);
+    readValue(stream, joint.postTransform);
+    readValue(stream, joint.transform);
+    readValue(stream, joint.rotationMin);
+    readValue(stream, joint.rotationMax);
+    readValue(stream, joint.inverseDefaultRotation);
+    readValue(stream, joint.inverseBindRotation);
+    readValue(stream, joint.bindTransform);
+    stream >> joint.name;
+    readValue(stream, joint.isSkeletonJoint);
+    readValue(stream, joint.bindTransformFoundInCluster);
+}
+
+void writeMesh(QDataStream& stream, const FBXMesh& mesh) {
+    stream << (quint32)mesh.parts.size();
+    for (const auto& part : mesh.parts) {
+        writeArray(stream, part.quadIndices);
+        writeArray(stream, part.quadTrianglesIndices);
+        writeArray(stream, part.triangleIndices);
+        stream << part.materialID;
+    }
+
+    writeArray(stream, mesh.vertices);
+    writeArray(stream, mesh.normals);
+    writeArray(stream, mesh.tangents);
+    writeArray(stream, mesh.colors);
+    writeArray(stream, mesh.texCoords);
+    writeArray(stream, mesh.texCoords1);
+    writeArray(stream, mesh.clusterIndices);
+    writeArray(stream, mesh.clusterWeights);
+    writeArray(stream, mesh.clusters);
+
+    writeExtents(stream, mesh.meshExtents);
+    writeValue(stream, mesh.modelTransform);
+    writeValue(stream, mesh.isEye);
+
+    stream << (quint32)mesh.blendshapes.size();
+    for (const auto& blendshape : mesh.blendshapes) {
+        writeArray(stream, blendshape.indices);
+        writeArray(stream, blendshape.vertices);
+        writeArray(stream, blendshape.normals);
+    }
+
+    stream << (quint32)mesh.meshIndex;
+}
+
+void readMesh(QDataStream& stream, FBXMesh& mesh) {
+    quint32 numParts = 0;
+    stream >> numParts;
+    if (!checkSize(stream, numParts, 1)) {
+        return;
+    }
+    mesh.parts.resize(numParts);
+    for (auto& part : mesh.parts) {
+        readArray(stream, part.quadIndices);
+        readArray(stream, part.quadTrianglesIndices);
+        readArray(stream, part.triangleIndices);
+        stream >> part.materialID;
+    }
+
+    readArray(stream, mesh.vertices);
+    readArray(stream, mesh.normals);
+    readArray(stream, mesh.tangents);
+    readArray(stream, mesh.colors);
+    readArray(stream, mesh.texCoords);
+    readArray(stream, mesh.texCoords1);
+    readArray(stream, mesh.clusterIndices);
+    readArray(stream, mesh.clusterWeights);
+    readArray(stream, mesh.clusters);
+
+    readExtents(stream, mesh.meshExtents);
+    readValue(stream, mesh.modelTransform);
+    readValue(stream, mesh.isEye);
+
+    quint32 numBlendshapes = 0;
+    stream >> numBlendshapes;
+    if (!checkSize(stream, numBlendshapes, 1)) {
+        return;
+    }
+    mesh.blendshapes.resize(numBlendshapes);
+    for (auto& blendshape : mesh.blendshapes) {
+        readArray(stream, blendshape.indices);
+        readArray(stream, blendshape.vertices);
+        readArray(stream, blendshape.normals);
+    }
+
+    quint32 meshIndex;
+    stream >> meshIndex;
+    mesh.meshIndex = meshIndex;
+}
+
+}
+
+QByteArray FBXContainer::serialize(const FBXGeometry& geometry) {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    stream.writeRawData(CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC));
+    stream << CONTAINER_VERSION;
+
+    stream << geometry.author << geometry.applicationName;
+
+    stream << (quint32)geometry.joints.size();
+    for (const auto& joint : geometry.joints) {
+        writeJoint(stream, joint);
+    }
+    stream << geometry.jointIndices << (quint8)geometry.hasSkeletonJoints;
+
+    stream << (quint32)geometry.materials.size();
+    for (auto it = geometry.materials.constBegin(); it != geometry.materials.constEnd(); ++it) {
+        stream << it.key();
+        writeMaterial(stream, it.value());
+    }
+
+    stream << (quint32)geometry.meshes.size();
+    for (const auto& mesh : geometry.meshes) {
+        writeMesh(stream, mesh);
+    }
+
+    writeValue(stream, geometry.offset);
+    const int jointIndices[] = {
+        geometry.leftEyeJointIndex, geometry.rightEyeJointIndex, geometry.neckJointIndex, geometry.rootJointIndex,
+        geometry.leanJointIndex, geometry.headJointIndex, geometry.leftHandJointIndex, geometry.rightHandJointIndex,
+        geometry.leftToeJointIndex, geometry.rightToeJointIndex
+    };
+    writeValue(stream, jointIndices);
+    writeValue(stream, geometry.leftEyeSize);
+    writeValue(stream, geometry.rightEyeSize);
+    writeArray(stream, geometry.humanIKJointIndices);
+    writeValue(stream, geometry.palmDirection);
+
+    stream << (quint32)geometry.sittingPoints.size();
+    for (const auto& sittingPoint : geometry.sittingPoints) {
+        stream << sittingPoint.name;
+        writeValue(stream, sittingPoint.position);
+        writeValue(stream, sittingPoint.rotation);
+    }
+
+    writeValue(stream, geometry.neckPivot);
+    writeExtents(stream, geometry.bindExtents);
+    writeExtents(stream, geometry.meshExtents);
+
+    stream << (quint32)geometry.animationFrames.size();
+    for (const auto& frame : geometry.animationFrames) {
+        writeArray(stream, frame.rotations);
+        writeArray(stream, frame.translations);
+    }
+
+    stream << geometry.meshIndicesToModelNames << geometry.blendshapeChannelNames;
+
+    return data;
+}
+
+FBXGeometry* FBXContainer::unserialize(const QByteArray& data, const QString& url) {
+    QDataStream stream(data);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    char magic[sizeof(CONTAINER_MAGIC)];
+    quint32 version = 0;
+    if (stream.readRawData(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, CONTAINER_MAGIC, sizeof(magic)) != 0) {
+        return nullptr;
+    }
+    stream >> version;
+    if (version != CONTAINER_VERSION) {
+        return nullptr;
+    }
+
+    std::unique_ptr<FBXGeometry> geometry(new FBXGeometry());
+    stream >> geometry->author >> geometry->applicationName;
+
+    quint32 numJoints = 0;
+    stream >> numJoints;
+    if (!checkSize(stream, numJoints, 1)) {
+        return nullptr;
+    }
+    geometry->joints.resize(numJoints);
+    for (auto& joint : geometry->joints) {
+        readJoint(stream, joint);
+    }
+    quint8 hasSkeletonJoints;
+    stream >> geometry->jointIndices >> hasSkeletonJoints;
+    geometry->hasSkeletonJoints = hasSkeletonJoints != 0;
+
+    quint32 numMaterials = 0;
+    stream >> numMaterials;
+    if (!checkSize(stream, numMaterials, 1)) {
+        return nullptr;
+    }
+    for (quint32 i = 0; i < numMaterials && stream.status() == QDataStream::Ok; ++i) {
+        QString materialID;
+        stream >> materialID;
+        readMaterial(stream, geometry->materials[materialID]);
+    }
+
+    quint32 numMeshes = 0;
+    stream >> numMeshes;
+    if (!checkSize(stream, numMeshes, 1)) {
+        return nullptr;
+    }
+    geometry->meshes.resize(numMeshes);
+    for (auto& mesh : geometry->meshes) {
+        readMesh(stream, mesh);
+    }
+
+    readValue(stream, geometry->offset);
+    int jointIndices[10];
+    readValue(stream, jointIndices);
+    geometry->leftEyeJointIndex = jointIndices[0];
+    geometry->rightEyeJointIndex = jointIndices[1];
+    geometry->neckJointIndex = jointIndices[2];
+    geometry->rootJointIndex = jointIndices[3];
+    geometry->leanJointIndex = jointIndices[4];
+    geometry->headJointIndex = jointIndices[5];
+    geometry->leftHandJointIndex = jointIndices[6];
+    geometry->rightHandJointIndex = jointIndices[7];
+    geometry->leftToeJointIndex = jointIndices[8];
+    geometry->rightToeJointIndex = jointIndices[9];
+    readValue(stream, geometry->leftEyeSize);
+    readValue(stream, geometry->rightEyeSize);
+    readArray(stream, geometry->humanIKJointIndices);
+    readValue(stream, geometry->palmDirection);
+
+    quint32 numSittingPoints = 0;
+    stream >> numSittingPoints;
+    if (!checkSize(stream, numSittingPoints, 1)) {
+        return nullptr;
+    }
+    geometry->sittingPoints.resize(numSittingPoints);
+    for (auto& sittingPoint : geometry->sittingPoints) {
+        stream >> sittingPoint.name;
+        readValue(stream, sittingPoint.position);
+        readValue(stream, sittingPoint.rotation);
+    }
+
+    readValue(stream, geometry->neckPivot);
+    readExtents(stream, geometry->bindExtents);
+    readExtents(stream, geometry->meshExtents);
+
+    quint32 numFrames = 0;
+    stream >> numFrames;
+    if (!checkSize(stream, numFrames, 1)) {
+        return nullptr;
+    }
+    geometry->animationFrames.resize(numFrames);
+    for (auto& frame : geometry->animationFrames) {
+        readArray(stream, frame.rotations);
+        readArray(stream, frame.translations);
+    }
+
+    stream >> geometry->meshIndicesToModelNames >> geometry->blendshapeChannelNames;
+
+    if (stream.status() != QDataStream::Ok) {
+        return nullptr;
+    }
+
+    // the joint and cluster indices are used as is, so they have to be in range
+    for (const auto& joint : geometry->joints) {
+        if (joint.parentIndex < -1 || joint.parentIndex >= (int)numJoints) {
+            return nullptr;
+        }
+    }
+    for (const auto& mesh : geometry->meshes) {
+        for (const auto& cluster : mesh.clusters) {
+            if (cluster.jointIndex < 0 || cluster.jointIndex >= (int)numJoints) {
+                return nullptr;
+            }
+        }
+    }
+
+    FBXMesh* meshes = geometry->meshes.data();
+    parallelFor(geometry->meshes.size(), [meshes, &url](int i) {
+        FBXReader::buildModelMesh(meshes[i], url);
+    });
+
+    return geometry.release();
+}
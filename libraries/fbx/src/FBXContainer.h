@@ -0,0 +1,35 @@
+//
+//  FBXContainer.h
+//  libraries/fbx/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_FBXContainer_h
+#define hifi_FBXContainer_h
+
+#include <QtCore/QByteArray>
+
+#include "FBXReader.h"
+
+// the extension of the models that are processed on the client, and of the ones baked ahead of time by the oven
+static const QString FBX_CONTAINER_EXTENSION = ".hfmd";
+
+// Lays out a geometry as it comes out of the FBX or OBJ reader: the joints, the vertex attribute and index arrays of
+// every mesh part, the cluster tables and the materials, so a model can be loaded again without parsing it.
+// The model meshes are not held, they are rebuilt from the arrays as the geometry is read back.
+class FBXContainer {
+public:
+    static QByteArray serialize(const FBXGeometry& geometry);
+
+    // returns nullptr for data that was not written by serialize, or by another version of it
+    static FBXGeometry* unserialize(const QByteArray& data, const QString& url);
+};
+
+#endif // hifi_FBXContainer_h
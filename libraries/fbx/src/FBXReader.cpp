@@ -28,6 +28,7 @@
 #include <GLMHelpers.h>
 #include <NumericalConstants.h>
 #include <OctalCode.h>
+#include <ParallelFor.h>
 #include <gpu/Format.h>
 #include <LogHandler.h>
 
@@ -475,6 +476,13 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
 
     std::map<QString, FBXLight> lights;
 
+    struct PendingMesh {
+        QString id;
+        FBXNode object;
+        unsigned int meshIndex;
+    };
+    QVector<PendingMesh> pendingMeshes;
+
     QVariantHash joints = mapping.value("joint").toHash();
     QString jointEyeLeftName = processID(getString(joints.value("jointEyeLeft", "jointEyeLeft")));
     QString jointEyeRightName = processID(getString(joints.value("jointEyeRight", "jointEyeRight")));
@@ -580,7 +588,9 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex));
+                        // the meshes are extracted together once all of the objects have been read
+                        PendingMesh pending = { getID(object.properties), object, meshIndex++ };
+                        pendingMeshes.append(pending);
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
@@ -1188,6 +1198,18 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
         }
     }
 
+    // extract the meshes in parallel, and add them in the order they were read in
+    {
+        std::vector<ExtractedMesh> extractedMeshes(pendingMeshes.size());
+        parallelFor(pendingMeshes.size(), [&](int i) {
+            unsigned int index = pendingMeshes.at(i).meshIndex;
+            extractedMeshes[i] = extractMesh(pendingMeshes.at(i).object, index);
+        });
+        for (int i = 0; i < pendingMeshes.size(); ++i) {
+            meshes.insert(pendingMeshes.at(i).id, extractedMeshes.at(i));
+        }
+    }
+
     // assign the blendshapes to their corresponding meshes
     foreach (const ExtractedBlendshape& extracted, blendshapes) {
         QString blendshapeChannelID = _connectionParentMap.value(extracted.id);
@@ -1372,21 +1394,47 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
     // see if any materials have texture children
     bool materialsHaveTextures = checkMaterialsHaveTextures(_fbxMaterials, _textureFilenames, _connectionChildMap);
 
+    // The meshes are finished in parallel, apart from the steps that update the joints and the geometry,
+    // which are run in the order of the meshes so that the results are the same as they would be one mesh at a time.
+    struct MeshJointPoint {
+        int jointIndex;
+        glm::vec3 point;
+    };
+    struct MeshState {
+        QString meshID;
+        ExtractedMesh* extracted;
+        QString modelID;
+        glm::mat4 modelTransform;
+        QVector<QString> clusterIDs;
+        int maxJointIndex;
+        std::vector<MeshJointPoint> shapePoints; // in the order they're added to shapeVertices
+    };
+    std::vector<MeshState> meshStates;
+    meshStates.reserve(meshes.size());
     for (QMap<QString, ExtractedMesh>::iterator it = meshes.begin(); it != meshes.end(); it++) {
-        ExtractedMesh& extracted = it.value();
+        MeshState state;
+        state.meshID = it.key();
+        state.extracted = &it.value();
+        state.maxJointIndex = 0;
+        meshStates.push_back(state);
+    }
+
+    // the extents, materials and tangents of each mesh only depend on the mesh
+    parallelFor((int)meshStates.size(), [&](int meshStateIndex) {
+        MeshState& state = meshStates[meshStateIndex];
+        ExtractedMesh& extracted = *state.extracted;
 
         extracted.mesh.meshExtents.reset();
 
         // accumulate local transforms
-        QString modelID = models.contains(it.key()) ? it.key() : _connectionParentMap.value(it.key());
+        QString modelID = models.contains(state.meshID) ? state.meshID : _connectionParentMap.value(state.meshID);
         glm::mat4 modelTransform = getGlobalTransform(_connectionParentMap, models, modelID, geometry.applicationName == "mixamo.com");
+        state.modelID = modelID;
+        state.modelTransform = modelTransform;
 
         // compute the mesh extents from the transformed vertices
         foreach (const glm::vec3& vertex, extracted.mesh.vertices) {
             glm::vec3 transformedVertex = glm::vec3(modelTransform * glm::vec4(vertex, 1.0f));
-            geometry.meshExtents.minimum = glm::min(geometry.meshExtents.minimum, transformedVertex);
-            geometry.meshExtents.maximum = glm::max(geometry.meshExtents.maximum, transformedVertex);
-
             extracted.mesh.meshExtents.minimum = glm::min(extracted.mesh.meshExtents.minimum, transformedVertex);
             extracted.mesh.meshExtents.maximum = glm::max(extracted.mesh.meshExtents.maximum, transformedVertex);
             extracted.mesh.modelTransform = modelTransform;
@@ -1451,17 +1499,26 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
                 }
             }
         }
+    });
+
+    // the clusters override the bind transforms of their joints, which every mesh's skinning reads
+    for (auto& state : meshStates) {
+        ExtractedMesh& extracted = *state.extracted;
+        const glm::mat4& modelTransform = state.modelTransform;
+
+        if (!extracted.mesh.vertices.isEmpty()) {
+            geometry.meshExtents.addExtents(extracted.mesh.meshExtents);
+        }
 
         // find the clusters with which the mesh is associated
-        QVector<QString> clusterIDs;
-        foreach (const QString& childID, _connectionChildMap.values(it.key())) {
+        foreach (const QString& childID, _connectionChildMap.values(state.meshID)) {
             foreach (const QString& clusterID, _connectionChildMap.values(childID)) {
                 if (!clusters.contains(clusterID)) {
                     continue;
                 }
                 FBXCluster fbxCluster;
                 const Cluster& cluster = clusters[clusterID];
-                clusterIDs.append(clusterID);
+                state.clusterIDs.append(clusterID);
 
                 // see http://stackoverflow.com/questions/13566608/loading-skinning-information-from-fbx for a discussion
                 // of skinning information in FBX
@@ -1489,13 +1546,22 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
         // if we don't have a skinned joint, parent to the model itself
         if (extracted.mesh.clusters.isEmpty()) {
             FBXCluster cluster;
-            cluster.jointIndex = modelIDs.indexOf(modelID);
+            cluster.jointIndex = modelIDs.indexOf(state.modelID);
             if (cluster.jointIndex == -1) {
-                qCDebug(modelformat) << "Model not in model list: " << modelID;
+                qCDebug(modelformat) << "Model not in model list: " << state.modelID;
                 cluster.jointIndex = 0;
             }
             extracted.mesh.clusters.append(cluster);
         }
+    }
+
+    // the skinning and model mesh of each mesh only read the joints from here on
+    const QVector<FBXJoint>& bindJoints = geometry.joints;
+    parallelFor((int)meshStates.size(), [&](int meshStateIndex) {
+        MeshState& state = meshStates[meshStateIndex];
+        ExtractedMesh& extracted = *state.extracted;
+        const glm::mat4& modelTransform = state.modelTransform;
+        const QVector<QString>& clusterIDs = state.clusterIDs;
 
         // whether we're skinned depends on how many clusters are attached
         const FBXCluster& firstFBXCluster = extracted.mesh.clusters.at(0);
@@ -1508,17 +1574,17 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
             float maxWeight = 0.0f;
             for (int i = 0; i < clusterIDs.size(); i++) {
                 QString clusterID = clusterIDs.at(i);
-                const Cluster& cluster = clusters[clusterID];
+                const Cluster& cluster = *clusters.constFind(clusterID);
                 const FBXCluster& fbxCluster = extracted.mesh.clusters.at(i);
                 int jointIndex = fbxCluster.jointIndex;
-                FBXJoint& joint = geometry.joints[jointIndex];
+                const FBXJoint& joint = bindJoints.at(jointIndex);
                 glm::mat4 transformJointToMesh = inverseModelTransform * joint.bindTransform;
                 glm::vec3 boneEnd = extractTranslation(transformJointToMesh);
                 glm::vec3 boneBegin = boneEnd;
                 glm::vec3 boneDirection;
                 float boneLength = 0.0f;
                 if (joint.parentIndex != -1) {
-                    boneBegin = extractTranslation(inverseModelTransform * geometry.joints[joint.parentIndex].bindTransform);
+                    boneBegin = extractTranslation(inverseModelTransform * bindJoints.at(joint.parentIndex).bindTransform);
                     boneDirection = boneEnd - boneBegin;
                     boneLength = glm::length(boneDirection);
                     if (boneLength > EPSILON) {
@@ -1528,7 +1594,6 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
 
                 float clusterScale = extractUniformScale(fbxCluster.inverseBindMatrix);
                 glm::mat4 meshToJoint = glm::inverse(joint.bindTransform) * modelTransform;
-                ShapeVertices& points = shapeVertices.at(jointIndex);
 
                 float totalWeight = 0.0f;
                 for (int j = 0; j < cluster.indices.size(); j++) {
@@ -1543,7 +1608,8 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
                         if (weight > EXPANSION_WEIGHT_THRESHOLD) {
                             // transform to joint-frame and save for later
                             const glm::mat4 vertexTransform = meshToJoint * glm::translate(extracted.mesh.vertices.at(it.value()));
-                            points.push_back(extractTranslation(vertexTransform) * clusterScale);
+                            MeshJointPoint shapePoint = { jointIndex, extractTranslation(vertexTransform) * clusterScale };
+                            state.shapePoints.push_back(shapePoint);
                         }
 
                         // look for an unused slot in the weights vector
@@ -1585,24 +1651,34 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
         } else {
             // this is a single-mesh joint
             int jointIndex = maxJointIndex;
-            FBXJoint& joint = geometry.joints[jointIndex];
+            const FBXJoint& joint = bindJoints.at(jointIndex);
 
             // transform cluster vertices to joint-frame and save for later
             float clusterScale = extractUniformScale(firstFBXCluster.inverseBindMatrix);
             glm::mat4 meshToJoint = glm::inverse(joint.bindTransform) * modelTransform;
-            ShapeVertices& points = shapeVertices.at(jointIndex);
+            state.shapePoints.reserve(extracted.mesh.vertices.size());
             foreach (const glm::vec3& vertex, extracted.mesh.vertices) {
                 const glm::mat4 vertexTransform = meshToJoint * glm::translate(vertex);
-                points.push_back(extractTranslation(vertexTransform) * clusterScale);
+                MeshJointPoint shapePoint = { jointIndex, extractTranslation(vertexTransform) * clusterScale };
+                state.shapePoints.push_back(shapePoint);
             }
 
         }
+        state.maxJointIndex = maxJointIndex;
         extracted.mesh.isEye = (maxJointIndex == geometry.leftEyeJointIndex || maxJointIndex == geometry.rightEyeJointIndex);
 
         buildModelMesh(extracted.mesh, url);
+    });
+
+    for (auto& state : meshStates) {
+        ExtractedMesh& extracted = *state.extracted;
+
+        for (const auto& shapePoint : state.shapePoints) {
+            shapeVertices.at(shapePoint.jointIndex).push_back(shapePoint.point);
+        }
 
         if (extracted.mesh.isEye) {
-            if (maxJointIndex == geometry.leftEyeJointIndex) {
+            if (state.maxJointIndex == geometry.leftEyeJointIndex) {
                 geometry.leftEyeSize = extracted.mesh.meshExtents.largestDimension() * offsetScale;
             } else {
                 geometry.rightEyeSize = extracted.mesh.meshExtents.largestDimension() * offsetScale;
@@ -1611,7 +1687,7 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
 
         geometry.meshes.append(extracted.mesh);
         int meshIndex = geometry.meshes.size() - 1;
-        meshIDsToMeshIndices.insert(it.key(), meshIndex);
+        meshIDsToMeshIndices.insert(state.meshID, meshIndex);
     }
 
     const float INV_SQRT_3 = 0.57735026918f;
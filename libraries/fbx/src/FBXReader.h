@@ -23,9 +23,11 @@
 
 #include <Extents.h>
 #include <Transform.h>
+#include <TriangleBVH.h>
 
 #include <model/Geometry.h>
 #include <model/Material.h>
+#include <model/MeshLOD.h>
 
 class QIODevice;
 class FBXNode;
@@ -213,6 +215,8 @@ public:
     unsigned int meshIndex; // the order the meshes appeared in the object file
 
     model::MeshPointer _mesh;
+    model::MeshLODs _lods; // simplified down from _mesh as the model is loaded, coarsest last
+    TriangleBVH _pickBVH; // the triangles of the parts, after modelTransform, built as the model is loaded
 };
 
 class ExtractedMesh {
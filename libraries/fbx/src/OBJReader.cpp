@@ -14,9 +14,11 @@
 
 #include "OBJReader.h"
 
-#include <ctype.h>  // .obj files are not locale-specific. The C/ASCII charset applies.
+#include <limits>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
 
-#include <QtCore/QBuffer>
 #include <QtCore/QIODevice>
 #include <QtCore/QEventLoop>
 #include <QtNetwork/QNetworkAccessManager>
@@ -43,11 +45,134 @@ T& checked_at(QVector<T>& vector, int i) {
 }
 }
 
-OBJTokenizer::OBJTokenizer(QIODevice* device) : _device(device), _pushedBackToken(-1) {
+// .obj files are not locale-specific. The C/ASCII charset applies.
+static inline bool isSpace(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\f' || ch == '\v';
+}
+
+static inline bool isDigit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+// Parses the whole of [begin, end) as an integer
+static bool parseInt(const char* begin, const char* end, int& result) {
+    const char* p = begin;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    if (p == end) {
+        return false;
+    }
+    int64_t value = 0;
+    for (; p < end; ++p) {
+        if (!isDigit(*p)) {
+            return false;
+        }
+        value = std::min<int64_t>(value * 10 + (*p - '0'), std::numeric_limits<int>::max());
+    }
+    result = (int)(negative ? -value : value);
+    return true;
+}
+
+// Parses the whole of [begin, end) as a decimal float, in the C locale like the rest of the format
+static bool parseFloat(const char* begin, const char* end, float& result) {
+    static const double POWERS_OF_TEN[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    static const int MAX_EXACT_POWER = 22;
+    static const int MAX_MANTISSA_DIGITS = 19; // what fits in 64 bits
+
+    const char* p = begin;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int numDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    for (; p < end && isDigit(*p); ++p) {
+        hasDigits = true;
+        if (numDigits < MAX_MANTISSA_DIGITS) {
+            mantissa = mantissa * 10 + (*p - '0');
+            numDigits += (mantissa != 0) ? 1 : 0;
+        } else {
+            ++exponent;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && isDigit(*p); ++p) {
+            hasDigits = true;
+            if (numDigits < MAX_MANTISSA_DIGITS) {
+                mantissa = mantissa * 10 + (*p - '0');
+                numDigits += (mantissa != 0) ? 1 : 0;
+                --exponent;
+            }
+        }
+    }
+    if (!hasDigits) {
+        return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = (*p == '-');
+            ++p;
+        }
+        if (p == end) {
+            return false;
+        }
+        const int MAX_EXPONENT = 1000;
+        int value = 0;
+        for (; p < end && isDigit(*p); ++p) {
+            value = std::min(value * 10 + (*p - '0'), MAX_EXPONENT);
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    if (p != end) {
+        return false;
+    }
+
+    double value = (double)mantissa;
+    if (exponent < 0) {
+        value /= (-exponent <= MAX_EXACT_POWER) ? POWERS_OF_TEN[-exponent] : pow(10.0, -exponent);
+    } else if (exponent > 0) {
+        value *= (exponent <= MAX_EXACT_POWER) ? POWERS_OF_TEN[exponent] : pow(10.0, exponent);
+    }
+    result = (float)(negative ? -value : value);
+    return true;
+}
+
+OBJTokenizer::OBJTokenizer(const QByteArray& data) :
+    _position(data.constData()),
+    _end(data.constData() + data.size()),
+    _pushedBackToken(-1) {
 }
 
 const QByteArray OBJTokenizer::getLineAsDatum() {
-    return _device->readLine().trimmed();
+    const char* lineEnd = (const char*)memchr(_position, '\n', _end - _position);
+    if (!lineEnd) {
+        lineEnd = _end;
+    }
+    QByteArray line(_position, (int)(lineEnd - _position));
+    _position = (lineEnd < _end) ? lineEnd + 1 : _end;
+    return line.trimmed();
+}
+
+void OBJTokenizer::skipLine() {
+    const char* lineEnd = (const char*)memchr(_position, '\n', _end - _position);
+    _position = lineEnd ? lineEnd + 1 : _end;
+}
+
+bool OBJTokenizer::isDatum(const char* keyword) const {
+    size_t length = strlen(keyword);
+    return (size_t)(_datumEnd - _datumBegin) == length && memcmp(_datumBegin, keyword, length) == 0;
 }
 
 int OBJTokenizer::nextToken() {
@@ -57,43 +182,65 @@ int OBJTokenizer::nextToken() {
         return token;
     }
 
-    char ch;
-    while (_device->getChar(&ch)) {
-        if (QChar(ch).isSpace()) {
+    while (_position < _end) {
+        char ch = *_position++;
+        if (isSpace(ch)) {
             continue; // skip whitespace
         }
         switch (ch) {
             case '#': {
-                _comment = _device->readLine(); // stash comment for a future call to getComment
+                // stash comment for a future call to getComment
+                _commentBegin = _position;
+                skipLine();
+                _commentEnd = _position;
                 return COMMENT_TOKEN;
             }
 
-            case '\"':
-                _datum = "";
-                while (_device->getChar(&ch)) {
-                    if (ch == '\"') { // end on closing quote
-                        break;
+            case '\"': {
+                // a quoted datum can be read in place unless it has escapes in it
+                const char* begin = _position;
+                bool escaped = false;
+                while (_position < _end && *_position != '\"') {
+                    if (*_position == '\\') {
+                        escaped = true;
+                        ++_position;
+                    }
+                    if (_position < _end) {
+                        ++_position;
                     }
-                    if (ch == '\\') { // handle escaped quotes
-                        if (_device->getChar(&ch) && ch != '\"') {
-                            _datum.append('\\');
+                }
+                const char* end = std::min(_position, _end);
+                if (_position < _end) {
+                    ++_position; // the closing quote
+                }
+                if (!escaped) {
+                    _datumBegin = begin;
+                    _datumEnd = end;
+                    return DATUM_TOKEN;
+                }
+
+                _quotedDatum.clear();
+                for (const char* p = begin; p < end; ++p) {
+                    if (*p == '\\' && p + 1 < end) { // handle escaped quotes
+                        ++p;
+                        if (*p != '\"') {
+                            _quotedDatum.append('\\');
                         }
                     }
-                    _datum.append(ch);
+                    _quotedDatum.append(*p);
                 }
+                _datumBegin = _quotedDatum.constData();
+                _datumEnd = _datumBegin + _quotedDatum.size();
                 return DATUM_TOKEN;
+            }
 
             default:
-                _datum = "";
-                _datum.append(ch);
-                while (_device->getChar(&ch)) {
-                    if (QChar(ch).isSpace() || ch == '\"') {
-                        ungetChar(ch); // read until we encounter a special character, then replace it
-                        break;
-                    }
-                    _datum.append(ch);
+                // read until we encounter a special character
+                _datumBegin = _position - 1;
+                while (_position < _end && !isSpace(*_position) && *_position != '\"') {
+                    ++_position;
                 }
-
+                _datumEnd = _position;
                 return DATUM_TOKEN;
         }
     }
@@ -104,11 +251,17 @@ bool OBJTokenizer::isNextTokenFloat() {
     if (nextToken() != OBJTokenizer::DATUM_TOKEN) {
         return false;
     }
-    QByteArray token = getDatum();
     pushBackToken(OBJTokenizer::DATUM_TOKEN);
-    bool ok;
-    token.toFloat(&ok);
-    return ok;
+    float value;
+    return parseFloat(_datumBegin, _datumEnd, value);
+}
+
+float OBJTokenizer::getFloat() {
+    float value = 0.0f;
+    if (nextToken() == OBJTokenizer::DATUM_TOKEN) {
+        parseFloat(_datumBegin, _datumEnd, value);
+    }
+    return value;
 }
 
 glm::vec3 OBJTokenizer::getVec3() {
@@ -123,12 +276,14 @@ glm::vec3 OBJTokenizer::getVec3() {
     return v;
 }
 glm::vec2 OBJTokenizer::getVec2() {
-    auto v = glm::vec2(getFloat(), 1.0f - getFloat());  // OBJ has an odd sense of u, v. Also N.B.: getFloat() has side-effect
+    auto u = getFloat(); // N.B.: getFloat() has side-effect
+    auto v = getFloat();
+    auto uv = glm::vec2(u, 1.0f - v);  // OBJ has an odd sense of u, v.
     while (isNextTokenFloat()) {
         // there can be a w, but we don't handle that
         nextToken();
     }
-    return v;
+    return uv;
 }
 
 
@@ -136,59 +291,96 @@ void setMeshPartDefaults(FBXMeshPart& meshPart, QString materialID) {
     meshPart.materialID = materialID;
 }
 
-// OBJFace
-bool OBJFace::add(const QByteArray& vertexIndex, const QByteArray& textureIndex, const QByteArray& normalIndex, const QVector<glm::vec3>& vertices) {
-    bool ok;
-    int index = vertexIndex.toInt(&ok);
-    if (!ok) {
+// Turns a face index into an index of the data read so far, they count from 1, or back from the last one when negative.
+// An index that can't be right is made one that checked_at rejects, since -1 stands for no index at all.
+static int resolveIndex(int index, int count) {
+    int resolved = (index > 0) ? index - 1 : count + index;
+    return (index == 0 || resolved < 0) ? std::numeric_limits<int>::max() : resolved;
+}
+
+bool OBJReader::parseFaceCorner(const char* begin, const char* end, OBJFaceCorner& corner) const {
+    // faces can be:
+    //   vertex-index
+    //   vertex-index/texture-index
+    //   vertex-index/texture-index/surface-normal-index
+    //   vertex-index//surface-normal-index
+    const char* indexEnds[3] = { end, end, end };
+    const char* indexBegins[3] = { begin, end, end };
+    int numIndices = 1;
+    for (const char* p = begin; p < end && numIndices < 3; ++p) {
+        if (*p == '/') {
+            indexEnds[numIndices - 1] = p;
+            indexBegins[numIndices] = p + 1;
+            ++numIndices;
+        }
+    }
+
+    int index;
+    if (!parseInt(indexBegins[0], indexEnds[0], index)) {
         return false;
     }
-    vertexIndices.append(index - 1);
-    if (!textureIndex.isEmpty()) {
-        index = textureIndex.toInt(&ok);
-        if (!ok) {
+    corner.vertexIndex = resolveIndex(index, vertices.count());
+    corner.textureUVIndex = -1;
+    corner.normalIndex = -1;
+    if (indexBegins[1] < indexEnds[1]) {
+        if (!parseInt(indexBegins[1], indexEnds[1], index)) {
             return false;
         }
-        if (index < 0) { // Count backwards from the last one added.
-            index = vertices.count() + 1 + index;
-        }
-        textureUVIndices.append(index - 1);
+        corner.textureUVIndex = resolveIndex(index, textureUVs.count());
     }
-    if (!normalIndex.isEmpty()) {
-        index = normalIndex.toInt(&ok);
-        if (!ok) {
+    if (indexBegins[2] < indexEnds[2]) {
+        if (!parseInt(indexBegins[2], indexEnds[2], index)) {
             return false;
         }
-        normalIndices.append(index - 1);
+        corner.normalIndex = resolveIndex(index, normals.count());
     }
     return true;
 }
-QVector<OBJFace> OBJFace::triangulate() {
-    QVector<OBJFace> newFaces;
-    const int nVerticesInATriangle = 3;
-    if (vertexIndices.count() == nVerticesInATriangle) {
-        newFaces.append(*this);
-    } else {
-        for (int i = 1; i < vertexIndices.count() - 1; i++) {
-            OBJFace newFace;
-            newFace.addFrom(this, 0);
-            newFace.addFrom(this, i);
-            newFace.addFrom(this, i + 1);
-            newFace.groupName = groupName;
-            newFace.materialName = materialName;
-            newFaces.append(newFace);
+
+void OBJReader::reserveForContent(const QByteArray& model) {
+    int numVertices = 0;
+    int numTextureUVs = 0;
+    int numNormals = 0;
+    size_t numCorners = 0;
+
+    const char* position = model.constData();
+    const char* end = position + model.size();
+    while (position < end) {
+        const char* lineEnd = (const char*)memchr(position, '\n', end - position);
+        if (!lineEnd) {
+            lineEnd = end;
         }
+        while (position < lineEnd && isSpace(*position)) {
+            ++position;
+        }
+        if (lineEnd - position >= 2 && isSpace(position[1])) {
+            if (position[0] == 'v') {
+                ++numVertices;
+            } else if (position[0] == 'f') {
+                int numFaceCorners = 0;
+                for (const char* p = position + 1; p < lineEnd; ++p) {
+                    if (!isSpace(*p) && isSpace(p[-1])) {
+                        ++numFaceCorners;
+                    }
+                }
+                if (numFaceCorners >= 3) {
+                    numCorners += 3 * (numFaceCorners - 2);
+                }
+            }
+        } else if (lineEnd - position >= 3 && position[0] == 'v' && isSpace(position[2])) {
+            if (position[1] == 't') {
+                ++numTextureUVs;
+            } else if (position[1] == 'n') {
+                ++numNormals;
+            }
+        }
+        position = lineEnd + 1;
     }
-    return newFaces;
-}
-void OBJFace::addFrom(const OBJFace* face, int index) { // add using data from f at index i
-    vertexIndices.append(face->vertexIndices[index]);
-    if (face->textureUVIndices.count() > 0) { // Any at all. Runtime error if not consistent.
-        textureUVIndices.append(face->textureUVIndices[index]);
-    }
-    if (face->normalIndices.count() > 0) {
-        normalIndices.append(face->normalIndices[index]);
-    }
+
+    vertices.reserve(numVertices);
+    textureUVs.reserve(numTextureUVs);
+    normals.reserve(numNormals);
+    faceCorners.reserve(numCorners);
 }
 
 static bool replyOK(QNetworkReply* netReply, QUrl url) { // This will be reworked when we make things asynchronous
@@ -212,7 +404,8 @@ bool OBJReader::isValidTexture(const QByteArray &filename) {
 }
 
 void OBJReader::parseMaterialLibrary(QIODevice* device) {
-    OBJTokenizer tokenizer(device);
+    QByteArray data = device->readAll();
+    OBJTokenizer tokenizer(data);
     QString matName = SMART_DEFAULT_MATERIAL_NAME;
     OBJMaterial& currentMaterial = materials[matName];
     while (true) {
@@ -231,8 +424,7 @@ void OBJReader::parseMaterialLibrary(QIODevice* device) {
                 #endif
                 return;
         }
-        QByteArray token = tokenizer.getDatum();
-        if (token == "newmtl") {
+        if (tokenizer.isDatum("newmtl")) {
             if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
                 return;
             }
@@ -243,19 +435,20 @@ void OBJReader::parseMaterialLibrary(QIODevice* device) {
             qCDebug(modelformat) << "OBJ Reader Starting new material definition " << matName;
             #endif
             currentMaterial.diffuseTextureFilename = "";
-        } else if (token == "Ns") {
+        } else if (tokenizer.isDatum("Ns")) {
             currentMaterial.shininess = tokenizer.getFloat();
-        } else if ((token == "d") || (token == "Tr")) {
+        } else if (tokenizer.isDatum("d") || tokenizer.isDatum("Tr")) {
             currentMaterial.opacity = tokenizer.getFloat();
-        } else if (token == "Ka") {
+        } else if (tokenizer.isDatum("Ka")) {
             #ifdef WANT_DEBUG
             qCDebug(modelformat) << "OBJ Reader Ignoring material Ka " << tokenizer.getVec3();
             #endif
-        } else if (token == "Kd") {
+        } else if (tokenizer.isDatum("Kd")) {
             currentMaterial.diffuseColor = tokenizer.getVec3();
-        } else if (token == "Ks") {
+        } else if (tokenizer.isDatum("Ks")) {
             currentMaterial.specularColor = tokenizer.getVec3();
-        } else if ((token == "map_Kd") || (token == "map_Ks")) {
+        } else if (tokenizer.isDatum("map_Kd") || tokenizer.isDatum("map_Ks")) {
+            bool isDiffuse = tokenizer.isDatum("map_Kd");
             QByteArray filename = QUrl(tokenizer.getLineAsDatum()).fileName().toUtf8();
             if (filename.endsWith(".tga")) {
                 #ifdef WANT_DEBUG
@@ -263,7 +456,7 @@ void OBJReader::parseMaterialLibrary(QIODevice* device) {
                 #endif
                 break;
             }
-            if (token == "map_Kd") {
+            if (isDiffuse) {
                 currentMaterial.diffuseTextureFilename = filename;
             } else {
                 currentMaterial.specularTextureFilename = filename;
@@ -300,11 +493,13 @@ QNetworkReply* OBJReader::request(QUrl& url, bool isTest) {
 
 
 bool OBJReader::parseOBJGroup(OBJTokenizer& tokenizer, const QVariantHash& mapping, FBXGeometry& geometry, float& scaleGuess) {
-    FaceGroup faces;
+    OBJFaceGroup faces;
+    faces.firstCorner = faceCorners.size();
     FBXMesh& mesh = geometry.meshes[0];
     mesh.parts.append(FBXMeshPart());
     FBXMeshPart& meshPart = mesh.parts.last();
     bool sawG = false;
+    bool sawF = false;
     bool result = true;
     int originalFaceCountForDebugging = 0;
     QString currentGroup;
@@ -330,10 +525,8 @@ bool OBJReader::parseOBJGroup(OBJTokenizer& tokenizer, const QVariantHash& mappi
             result = false;
             break;
         }
-        QByteArray token = tokenizer.getDatum();
-        //qCDebug(modelformat) << token;
         // we don't support separate objects in the same file, so treat "o" the same as "g".
-        if (token == "g" || token == "o") {
+        if (tokenizer.isDatum("g") || tokenizer.isDatum("o")) {
             if (sawG) {
                 // we've encountered the beginning of the next group.
                 tokenizer.pushBackToken(OBJTokenizer::DATUM_TOKEN);
@@ -345,14 +538,14 @@ bool OBJReader::parseOBJGroup(OBJTokenizer& tokenizer, const QVariantHash& mappi
             }
             QByteArray groupName = tokenizer.getDatum();
             currentGroup = groupName;
-        } else if (token == "mtllib" && !_url.isEmpty()) {
+        } else if (tokenizer.isDatum("mtllib") && !_url.isEmpty()) {
             if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
                 break;
             }
             QByteArray libraryName = tokenizer.getDatum();
             librariesSeen[libraryName] = true;
             // We'll read it later only if we actually need it.
-        } else if (token == "usemtl") {
+        } else if (tokenizer.isDatum("usemtl")) {
             if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
                 break;
             }
@@ -363,51 +556,54 @@ bool OBJReader::parseOBJGroup(OBJTokenizer& tokenizer, const QVariantHash& mappi
                 qCDebug(modelformat) << "OBJ Reader new current material:" << currentMaterialName;
                 #endif
             }
-        } else if (token == "v") {
+        } else if (tokenizer.isDatum("v")) {
             vertices.append(tokenizer.getVec3());
-        } else if (token == "vn") {
+        } else if (tokenizer.isDatum("vn")) {
             normals.append(tokenizer.getVec3());
-        } else if (token == "vt") {
+        } else if (tokenizer.isDatum("vt")) {
             textureUVs.append(tokenizer.getVec2());
-        } else if (token == "f") {
-            OBJFace face;
+        } else if (tokenizer.isDatum("f")) {
+            _face.clear();
             while (true) {
                 if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
-                    if (face.vertexIndices.count() == 0) {
+                    if (_face.empty()) {
                         // nonsense, bail out.
                         goto done;
                     }
                     break;
                 }
-                // faces can be:
-                //   vertex-index
-                //   vertex-index/texture-index
-                //   vertex-index/texture-index/surface-normal-index
-                QByteArray token = tokenizer.getDatum();
-                if (!isdigit(token[0])) { // Tokenizer treats line endings as whitespace. Non-digit indicates done;
+                // Tokenizer treats line endings as whitespace. Anything but an index indicates done;
+                const char* begin = tokenizer.getDatumBegin();
+                if (!isDigit(*begin) && *begin != '-') {
                     tokenizer.pushBackToken(OBJTokenizer::DATUM_TOKEN);
                     break;
                 }
-                QList<QByteArray> parts = token.split('/');
-                assert(parts.count() >= 1);
-                assert(parts.count() <= 3);
-                const QByteArray noData {};
-                face.add(parts[0], (parts.count() > 1) ? parts[1] : noData, (parts.count() > 2) ? parts[2] : noData, vertices);
-                face.groupName = currentGroup;
-                face.materialName = currentMaterialName;
+                OBJFaceCorner corner;
+                if (parseFaceCorner(begin, tokenizer.getDatumEnd(), corner)) {
+                    _face.push_back(corner);
+                }
+            }
+            if (!sawF) {
+                sawF = true;
+                faces.groupName = currentGroup;
+                faces.materialName = currentMaterialName;
             }
             originalFaceCountForDebugging++;
-            foreach(OBJFace face, face.triangulate()) {
-                faces.append(face);
+            // fan the face out into triangles
+            for (size_t i = 1; i + 1 < _face.size(); i++) {
+                faceCorners.push_back(_face[0]);
+                faceCorners.push_back(_face[i]);
+                faceCorners.push_back(_face[i + 1]);
             }
         } else {
             // something we don't (yet) care about
-            // qCDebug(modelformat) << "OBJ parser is skipping a line with" << token;
+            // qCDebug(modelformat) << "OBJ parser is skipping a line with" << tokenizer.getDatum();
             tokenizer.skipLine();
         }
     }
 done:
-    if (faces.count() == 0) { // empty mesh
+    faces.numCorners = faceCorners.size() - faces.firstCorner;
+    if (faces.numCorners == 0) { // empty mesh
         mesh.parts.pop_back();
     } else {
         faceGroups.append(faces); // We're done with this group. Add the faces.
@@ -418,12 +614,9 @@ done:
 
 FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping, const QUrl& url) {
     PROFILE_RANGE_EX(__FUNCTION__, 0xffff0000, nullptr);
-    QBuffer buffer { &model };
-    buffer.open(QIODevice::ReadOnly);
-
     FBXGeometry* geometryPtr = new FBXGeometry();
     FBXGeometry& geometry = *geometryPtr;
-    OBJTokenizer tokenizer { &buffer };
+    OBJTokenizer tokenizer { model };
     float scaleGuess = 1.0f;
 
     bool needsMaterialLibrary = false;
@@ -433,6 +626,8 @@ FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping,
     geometry.meshes.append(FBXMesh());
 
     try {
+        reserveForContent(model);
+
         // call parseOBJGroup as long as it's returning true.  Each successful call will
         // add a new meshPart to the geometry's single mesh.
         while (parseOBJGroup(tokenizer, mapping, geometry, scaleGuess)) {}
@@ -460,44 +655,54 @@ FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping,
                                               0, 0, 0, 1);
         mesh.clusters.append(cluster);
 
+        // every corner of every triangle gets its own vertex, written straight into the arrays of the mesh
+        const int numCorners = (int)faceCorners.size();
+        mesh.vertices.resize(numCorners);
+        mesh.normals.resize(numCorners);
+        mesh.texCoords.resize(numCorners);
+        glm::vec3* meshVertices = mesh.vertices.data();
+        glm::vec3* meshNormals = mesh.normals.data();
+        glm::vec2* meshTexCoords = mesh.texCoords.data();
+
         for (int i = 0, meshPartCount = 0; i < mesh.parts.count(); i++, meshPartCount++) {
             FBXMeshPart& meshPart = mesh.parts[i];
-            FaceGroup faceGroup = faceGroups[meshPartCount];
+            const OBJFaceGroup& faceGroup = faceGroups[meshPartCount];
             bool specifiesUV = false;
-            foreach(OBJFace face, faceGroup) {
-                glm::vec3 v0 = checked_at(vertices, face.vertexIndices[0]);
-                glm::vec3 v1 = checked_at(vertices, face.vertexIndices[1]);
-                glm::vec3 v2 = checked_at(vertices, face.vertexIndices[2]);
-                meshPart.triangleIndices.append(mesh.vertices.count()); // not face.vertexIndices into vertices
-                mesh.vertices << v0;
-                meshPart.triangleIndices.append(mesh.vertices.count());
-                mesh.vertices << v1;
-                meshPart.triangleIndices.append(mesh.vertices.count());
-                mesh.vertices << v2;
-
-                glm::vec3 n0, n1, n2;
-                if (face.normalIndices.count()) {
-                    n0 = checked_at(normals, face.normalIndices[0]);
-                    n1 = checked_at(normals, face.normalIndices[1]);
-                    n2 = checked_at(normals, face.normalIndices[2]);
+            meshPart.triangleIndices.resize((int)faceGroup.numCorners);
+            int* triangleIndices = meshPart.triangleIndices.data();
+            for (size_t first = 0; first < faceGroup.numCorners; first += 3) {
+                const OBJFaceCorner* face = &faceCorners[faceGroup.firstCorner + first];
+                const int index = (int)(faceGroup.firstCorner + first); // not face.vertexIndex into vertices
+                triangleIndices[first] = index;
+                triangleIndices[first + 1] = index + 1;
+                triangleIndices[first + 2] = index + 2;
+
+                glm::vec3 v0 = checked_at(vertices, face[0].vertexIndex);
+                glm::vec3 v1 = checked_at(vertices, face[1].vertexIndex);
+                glm::vec3 v2 = checked_at(vertices, face[2].vertexIndex);
+                meshVertices[index] = v0;
+                meshVertices[index + 1] = v1;
+                meshVertices[index + 2] = v2;
+
+                if (face[0].normalIndex != -1) {
+                    meshNormals[index] = checked_at(normals, face[0].normalIndex);
+                    meshNormals[index + 1] = checked_at(normals, face[1].normalIndex);
+                    meshNormals[index + 2] = checked_at(normals, face[2].normalIndex);
                 } else { // generate normals from triangle plane if not provided
-                    n0 = n1 = n2 = glm::cross(v1 - v0, v2 - v0);
+                    meshNormals[index] = meshNormals[index + 1] = meshNormals[index + 2] = glm::cross(v1 - v0, v2 - v0);
                 }
-                mesh.normals << n0 << n1 << n2;
-                if (face.textureUVIndices.count()) {
+                if (face[0].textureUVIndex != -1) {
                     specifiesUV = true;
-                    mesh.texCoords <<
-                    checked_at(textureUVs, face.textureUVIndices[0]) <<
-                    checked_at(textureUVs, face.textureUVIndices[1]) <<
-                    checked_at(textureUVs, face.textureUVIndices[2]);
+                    meshTexCoords[index] = checked_at(textureUVs, face[0].textureUVIndex);
+                    meshTexCoords[index + 1] = checked_at(textureUVs, face[1].textureUVIndex);
+                    meshTexCoords[index + 2] = checked_at(textureUVs, face[2].textureUVIndex);
                 } else {
                     glm::vec2 corner(0.0f, 1.0f);
-                    mesh.texCoords << corner << corner << corner;
+                    meshTexCoords[index] = meshTexCoords[index + 1] = meshTexCoords[index + 2] = corner;
                 }
             }
             // All the faces in the same group will have the same name and material.
-            OBJFace leadFace = faceGroup[0];
-            QString groupMaterialName = leadFace.materialName;
+            QString groupMaterialName = faceGroup.materialName;
             if (groupMaterialName.isEmpty() && specifiesUV) {
                 #ifdef WANT_DEBUG
                 qCDebug(modelformat) << "OBJ Reader WARNING: " << url
@@ -1,10 +1,14 @@
 
+#include <vector>
+
 #include <QtNetwork/QNetworkReply>
 #include "FBXReader.h"
 
+// Reads the tokens of an .obj or .mtl file in place, out of the data handed to it (which has to outlive the tokenizer).
+// Only the names the reader keeps are copied out, keywords and numbers are compared and parsed where they are.
 class OBJTokenizer {
 public:
-    OBJTokenizer(QIODevice* device);
+    OBJTokenizer(const QByteArray& data);
     enum SpecialToken {
         NO_TOKEN = -1,
         NO_PUSHBACKED_TOKEN = -1,
@@ -12,38 +16,45 @@ public:
         COMMENT_TOKEN = 0x101
     };
     int nextToken();
-    const QByteArray& getDatum() const { return _datum; }
+    const QByteArray getDatum() const { return QByteArray(_datumBegin, (int)(_datumEnd - _datumBegin)); }
+    bool isDatum(const char* keyword) const;
+    const char* getDatumBegin() const { return _datumBegin; }
+    const char* getDatumEnd() const { return _datumEnd; }
     bool isNextTokenFloat();
     const QByteArray getLineAsDatum(); // some "filenames" have spaces in them
-    void skipLine() { _device->readLine(); }
+    void skipLine();
     void pushBackToken(int token) { _pushedBackToken = token; }
-    void ungetChar(char ch) { _device->ungetChar(ch); }
-    const QString getComment() const { return _comment; }
+    const QString getComment() const { return QString::fromUtf8(_commentBegin, (int)(_commentEnd - _commentBegin)); }
     glm::vec3 getVec3();
     glm::vec2 getVec2();
-    float getFloat() { return std::stof((nextToken() != OBJTokenizer::DATUM_TOKEN) ? nullptr : getDatum().data()); }
-    
+    float getFloat();
+
 private:
-    QIODevice* _device;
-    QByteArray _datum;
+    const char* _position;
+    const char* _end;
+    const char* _datumBegin { nullptr };
+    const char* _datumEnd { nullptr };
+    const char* _commentBegin { nullptr };
+    const char* _commentEnd { nullptr };
+    QByteArray _quotedDatum; // a quoted datum with escapes in it can't be read in place
     int _pushedBackToken;
-    QString _comment;
 };
 
-class OBJFace { // A single face, with three or more planar vertices. But see triangulate().
+// One corner of a triangle, indexing the vertices, texture coordinates and normals read so far, or -1 for none
+class OBJFaceCorner {
 public:
-    QVector<int> vertexIndices;
-    QVector<int> textureUVIndices;
-    QVector<int> normalIndices;
+    int vertexIndex;
+    int textureUVIndex;
+    int normalIndex;
+};
+
+// The triangles of a group, a range of OBJReader::faceCorners. Every face of the group gets the material of its first.
+class OBJFaceGroup {
+public:
+    size_t firstCorner { 0 };
+    size_t numCorners { 0 };
     QString groupName; // We don't make use of hierarchical structure, but it can be preserved for debugging and future use.
     QString materialName;
-    // Add one more set of vertex data. Answers true if successful
-    bool add(const QByteArray& vertexIndex, const QByteArray& textureIndex, const QByteArray& normalIndex, const QVector<glm::vec3>& vertices);
-    // Return a set of one or more OBJFaces from this one, in which each is just a triangle.
-    // Even though FBXMeshPart can handle quads, it would be messy to try to keep track of mixed-size faces, so we treat everything as triangles.
-    QVector<OBJFace> triangulate();
-private:
-    void addFrom(const OBJFace* face, int index);
 };
 
 // Materials and references to material names can come in any order, and different mesh parts can refer to the same material.
@@ -64,11 +75,13 @@ public:
 class OBJReader: public QObject { // QObject so we can make network requests.
     Q_OBJECT
 public:
-    typedef QVector<OBJFace> FaceGroup;
     QVector<glm::vec3> vertices;  // all that we ever encounter while reading
     QVector<glm::vec2> textureUVs;
     QVector<glm::vec3> normals;
-    QVector<FaceGroup> faceGroups;
+    // The faces are triangulated as they are read. Even though FBXMeshPart can handle quads, it would be messy to keep
+    // track of mixed-size faces, so we treat everything as triangles.
+    std::vector<OBJFaceCorner> faceCorners;
+    QVector<OBJFaceGroup> faceGroups;
     QString currentMaterialName;
     QHash<QString, OBJMaterial> materials;
 
@@ -79,6 +92,10 @@ private:
     QUrl _url;
 
     QHash<QByteArray, bool> librariesSeen;
+    std::vector<OBJFaceCorner> _face; // the corners of the face being read, before it's triangulated
+    // counts the vertex data and the triangle corners in a first pass, so they can be read without growing
+    void reserveForContent(const QByteArray& model);
+    bool parseFaceCorner(const char* begin, const char* end, OBJFaceCorner& corner) const;
     bool parseOBJGroup(OBJTokenizer& tokenizer, const QVariantHash& mapping, FBXGeometry& geometry, float& scaleGuess);
     void parseMaterialLibrary(QIODevice* device);
     bool isValidTexture(const QByteArray &filename); // true if the file exists. TODO?: check content-type header and that it is a supported format.
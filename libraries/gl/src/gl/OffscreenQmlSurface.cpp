@@ -8,6 +8,8 @@
 #include "OffscreenQmlSurface.h"
 #include "OglplusHelpers.h"
 
+#include <algorithm>
+
 #include <QtWidgets/QWidget>
 #include <QtQml/QtQml>
 #include <QtQml/QQmlEngine>
@@ -72,6 +74,8 @@ public:
 // achieve.
 // This has the effect of capping the framerate at 200
 static const int MIN_TIMER_MS = 5;
+// how long a surface with an idle rate keeps rendering at its max rate after its last input
+static const uint64_t IDLE_TIMEOUT_USECS = 3 * USECS_PER_SECOND;
 
 class QMyQuickRenderControl : public QQuickRenderControl {
 protected:
@@ -608,13 +612,21 @@ QObject* OffscreenQmlSurface::finishQmlLoad(std::function<void(QQmlContext*, QOb
     return _rootItem;
 }
 
+void OffscreenQmlSurface::notifyInput() {
+    _lastInputTime = usecTimestampNow();
+}
+
 void OffscreenQmlSurface::updateQuick() {
     // If we're 
     //   a) not set up
     //   b) already rendering a frame
     //   c) rendering too fast
     // then skip this 
-    if (!_renderer || _renderer->_rendering || !_renderer->allowNewFrame(_maxFps)) {
+    uint8_t maxFps = _maxFps;
+    if (_idleMaxFps > 0 && (usecTimestampNow() - _lastInputTime) > IDLE_TIMEOUT_USECS) {
+        maxFps = std::min(_maxFps, _idleMaxFps);
+    }
+    if (!_renderer || _renderer->_rendering || !_renderer->allowNewFrame(maxFps)) {
         return;
     }
 
@@ -675,6 +687,7 @@ bool OffscreenQmlSurface::eventFilter(QObject* originalDestination, QEvent* even
     if (!filterEnabled(originalDestination, event)) {
         return false;
     }
+    notifyInput();
 #ifdef DEBUG
     // Don't intercept our own events, or we enter an infinite recursion
     QObject* recurseTest = originalDestination;
@@ -752,6 +765,7 @@ void OffscreenQmlSurface::pause() {
 
 void OffscreenQmlSurface::resume() {
     _paused = false;
+    notifyInput();
     requestRender();
 }
 
@@ -49,6 +49,12 @@ public:
     Q_INVOKABLE QVariant returnFromUiThread(std::function<QVariant()> function);
 
     void setMaxFps(uint8_t maxFps) { _maxFps = maxFps; }
+    // Once no input reached the surface for a few seconds it renders at most idleMaxFps, 0 keeps it at the max
+    void setIdleMaxFps(uint8_t idleMaxFps) { _idleMaxFps = idleMaxFps; }
+    // The rate of the web surfaces that nobody is interacting with
+    static const uint8_t WEB_IDLE_MAX_FPS = 10;
+    // For the input sent straight to the window of the surface rather than through its event filter
+    void notifyInput();
     // Optional values for event handling
     void setProxyWindow(QWindow* window);
     void setMouseTranslator(MouseTranslator mouseTranslator) {
@@ -104,6 +110,8 @@ private:
     bool _paused{ true };
     bool _focusText { false };
     uint8_t _maxFps{ 60 };
+    uint8_t _idleMaxFps{ 0 };
+    uint64_t _lastInputTime{ 0 };
     MouseTranslator _mouseTranslator{ [](const QPointF& p) { return p.toPoint();  } };
     QWindow* _proxyWindow { nullptr };
 };
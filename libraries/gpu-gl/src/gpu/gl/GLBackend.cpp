@@ -80,6 +80,7 @@ GLBackend::CommandCall GLBackend::_commandCalls[Batch::NUM_COMMANDS] =
     (&::gpu::gl::GLBackend::do_drawIndexedInstanced),
     (&::gpu::gl::GLBackend::do_multiDrawIndirect),
     (&::gpu::gl::GLBackend::do_multiDrawIndexedIndirect),
+    (&::gpu::gl::GLBackend::do_captureVertices),
 
     (&::gpu::gl::GLBackend::do_setInputFormat),
     (&::gpu::gl::GLBackend::do_setInputBuffer),
@@ -98,6 +99,7 @@ GLBackend::CommandCall GLBackend::_commandCalls[Batch::NUM_COMMANDS] =
 
     (&::gpu::gl::GLBackend::do_setUniformBuffer),
     (&::gpu::gl::GLBackend::do_setResourceTexture),
+    (&::gpu::gl::GLBackend::do_setResourceTextureTable),
 
     (&::gpu::gl::GLBackend::do_setFramebuffer),
     (&::gpu::gl::GLBackend::do_clearFramebuffer),
@@ -262,8 +264,35 @@ void GLBackend::renderPassDraw(const Batch& batch) {
             case Batch::COMMAND_setProjectionTransform:
                 break;
 
+            case Batch::COMMAND_drawIndexed: {
+                size_t numDraws = 1;
+                size_t lastCommandIndex = _commandIndex;
+                if (supportsIndexedDrawRuns() && batch._currentNamedCall.empty()) {
+                    lastCommandIndex = findIndexedDrawRun(batch, numDraws);
+                }
+
+                // updates for draw calls
+                ++_currentDraw;
+                updateInput();
+                updateTransform(batch);
+                updatePipeline();
+
+                if (numDraws > 1) {
+                    do_drawIndexedRun(batch, lastCommandIndex, numDraws);
+
+                    // skip over the rest of the run
+                    _currentDraw += (int)numDraws - 1;
+                    command += lastCommandIndex - _commandIndex;
+                    offset += lastCommandIndex - _commandIndex;
+                    _commandIndex = lastCommandIndex;
+                } else {
+                    CommandCall call = _commandCalls[(*command)];
+                    (this->*(call))(batch, *offset);
+                }
+                break;
+            }
+
             case Batch::COMMAND_draw:
-            case Batch::COMMAND_drawIndexed:
             case Batch::COMMAND_drawInstanced:
             case Batch::COMMAND_drawIndexedInstanced:
             case Batch::COMMAND_multiDrawIndirect:
@@ -278,6 +307,16 @@ void GLBackend::renderPassDraw(const Batch& batch) {
                 (this->*(call))(batch, *offset);
                 break;
             }
+
+            case Batch::COMMAND_captureVertices: {
+                // not a draw call, it doesn't have a transform or draw call info of its own
+                updateInput();
+                updatePipeline();
+
+                CommandCall call = _commandCalls[(*command)];
+                (this->*(call))(batch, *offset);
+                break;
+            }
             default: {
                 CommandCall call = _commandCalls[(*command)];
                 (this->*(call))(batch, *offset);
@@ -290,6 +329,27 @@ void GLBackend::renderPassDraw(const Batch& batch) {
     }
 }
 
+size_t GLBackend::findIndexedDrawRun(const Batch& batch, size_t& numDraws) const {
+    const auto& commands = batch.getCommands();
+    const auto& offsets = batch.getCommandOffsets();
+    // the primitive type is the last param of a drawIndexed
+    uint32 primitiveType = batch._params[offsets[_commandIndex] + 2]._uint;
+
+    size_t lastCommandIndex = _commandIndex;
+    numDraws = 1;
+    for (size_t i = _commandIndex + 1; i < commands.size(); ++i) {
+        if (commands[i] == Batch::COMMAND_setModelTransform) {
+            continue;
+        }
+        if (commands[i] != Batch::COMMAND_drawIndexed || batch._params[offsets[i] + 2]._uint != primitiveType) {
+            break;
+        }
+        lastCommandIndex = i;
+        ++numDraws;
+    }
+    return lastCommandIndex;
+}
+
 void GLBackend::render(const Batch& batch) {
     _transform._skybox = _stereo._skybox = batch.isSkyboxEnabled();
     // Allow the batch to override the rendering stereo settings
@@ -298,6 +358,8 @@ void GLBackend::render(const Batch& batch) {
     if (!batch.isStereoEnabled()) {
         _stereo._enable = false;
     }
+    updateProgramVersion();
+    _stats._CSNumCompactedCommands += (int)batch.getNumCompactedCommands();
     
     {
         PROFILE_RANGE("Transfer");
@@ -308,6 +370,7 @@ void GLBackend::render(const Batch& batch) {
         PROFILE_RANGE(_stereo._enable ? "Render Stereo" : "Render");
         renderPassDraw(batch);
     }
+    enableStereoClip(false);
 
     // Restore the saved stereo state for the next batch
     _stereo._enable = savedStereo;
@@ -328,14 +391,56 @@ void GLBackend::setupStereoSide(int side) {
     ivec4 vp = _transform._viewport;
     vp.z /= 2;
     glViewport(vp.x + side * vp.z, vp.y, vp.z, vp.w);
+    enableStereoClip(false);
 
     _transform.bindCurrentCamera(side);
 }
 
+void GLBackend::setupInstancedStereo() {
+    // the vertex shader puts each eye in its half of the viewport
+    const ivec4& vp = _transform._viewport;
+    glViewport(vp.x, vp.y, vp.z, vp.w);
+    enableStereoClip(true);
+
+    _transform.bindCurrentStereoCameras();
+}
+
+void GLBackend::enableStereoClip(bool enable) {
+    if (_stereoClipEnabled != enable) {
+        if (enable) {
+            glEnable(GL_CLIP_DISTANCE0);
+        } else {
+            glDisable(GL_CLIP_DISTANCE0);
+        }
+        _stereoClipEnabled = enable;
+    }
+}
+
 void GLBackend::do_resetStages(const Batch& batch, size_t paramOffset) {
     resetStages();
 }
 
+void GLBackend::do_captureVertices(const Batch& batch, size_t paramOffset) {
+    BufferPointer buffer = batch._buffers.get(batch._params[paramOffset + 0]._uint);
+    GLint startVertex = batch._params[paramOffset + 1]._uint;
+    GLsizei numVertices = batch._params[paramOffset + 2]._uint;
+    if (!buffer || numVertices == 0) {
+        return;
+    }
+
+    // only the vertex stage runs, its outputs go to the buffer and nothing is rasterized
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, getBufferID(*buffer));
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, startVertex, numVertices);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    _stats._DSNumAPIDrawcalls++;
+    (void) CHECK_GL_ERROR();
+}
+
 void GLBackend::do_runLambda(const Batch& batch, size_t paramOffset) {
     std::function<void()> f = batch._lambdas.get(batch._params[paramOffset]._uint);
     f();
@@ -382,13 +487,13 @@ void GLBackend::do_popProfileRange(const Batch& batch, size_t paramOffset) {
 // code, we need to be able to record and batch these calls. THe long 
 // term strategy is to get rid of any GL calls in favor of the HIFI GPU API
 
-// As long as we don;t use several versions of shaders we can avoid this more complex code path
-// #define GET_UNIFORM_LOCATION(shaderUniformLoc) _pipeline._programShader->getUniformLocation(shaderUniformLoc, isStereo());
-#define GET_UNIFORM_LOCATION(shaderUniformLoc) shaderUniformLoc
+// The locations are the ones of the default version of the program, the stereo version may have its own
+#define GET_UNIFORM_LOCATION(shaderUniformLoc) (_pipeline._programShader ? \
+    _pipeline._programShader->getUniformLocation(shaderUniformLoc, isInstancedStereo() ? GLShader::Stereo : GLShader::Mono) : shaderUniformLoc)
 void GLBackend::do_glActiveBindTexture(const Batch& batch, size_t paramOffset) {
     glActiveTexture(batch._params[paramOffset + 2]._uint);
     glBindTexture(
-        GET_UNIFORM_LOCATION(batch._params[paramOffset + 1]._uint),
+        batch._params[paramOffset + 1]._uint,
         batch._params[paramOffset + 0]._uint);
 
     (void)CHECK_GL_ERROR();
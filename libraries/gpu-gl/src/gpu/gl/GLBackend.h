@@ -75,6 +75,10 @@ public:
     static const int MAX_NUM_RESOURCE_TEXTURES = 16;
     size_t getMaxNumResourceTextures() const { return MAX_NUM_RESOURCE_TEXTURES; }
 
+    // With bindless textures the material textures are sampled through the handles of the slots of a TextureTable,
+    // the shaders are compiled with GPU_TEXTURE_TABLE_BINDLESS (see TextureTable.slh)
+    virtual bool supportsBindlessTextures() const { return false; }
+
     // Draw Stage
     virtual void do_draw(const Batch& batch, size_t paramOffset) = 0;
     virtual void do_drawIndexed(const Batch& batch, size_t paramOffset) = 0;
@@ -82,6 +86,7 @@ public:
     virtual void do_drawIndexedInstanced(const Batch& batch, size_t paramOffset) = 0;
     virtual void do_multiDrawIndirect(const Batch& batch, size_t paramOffset) = 0;
     virtual void do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOffset) = 0;
+    virtual void do_captureVertices(const Batch& batch, size_t paramOffset) final;
 
     // Input Stage
     virtual void do_setInputFormat(const Batch& batch, size_t paramOffset) final;
@@ -102,6 +107,7 @@ public:
 
     // Resource Stage
     virtual void do_setResourceTexture(const Batch& batch, size_t paramOffset) final;
+    virtual void do_setResourceTextureTable(const Batch& batch, size_t paramOffset) final;
 
     // Pipeline Stage
     virtual void do_setPipeline(const Batch& batch, size_t paramOffset) final;
@@ -200,8 +206,22 @@ protected:
 
     void renderPassTransfer(const Batch& batch);
     void renderPassDraw(const Batch& batch);
+
+    // Consecutive drawIndexed commands with nothing but model transforms between them share all their state,
+    // a backend that supports it draws such a run with a single call
+    virtual bool supportsIndexedDrawRuns() const { return false; }
+    // Returns the command index of the last draw of the run starting at the current command
+    size_t findIndexedDrawRun(const Batch& batch, size_t& numDraws) const;
+    virtual void do_drawIndexedRun(const Batch& batch, size_t lastCommandIndex, size_t numDraws) {}
     void setupStereoSide(int side);
 
+    // The stereo draws of a program that has a stereo version are drawn in a single call, every instance twice,
+    // once for each eye (see GPU_TRANSFORM_IS_STEREO in Transform.slh)
+    bool isInstancedStereo() const { return _pipeline._instancedStereo; }
+    void setupInstancedStereo();
+    void enableStereoClip(bool enable);
+    bool _stereoClipEnabled { false };
+
     virtual void initInput() final;
     virtual void killInput() final;
     virtual void syncInputStateCache() final;
@@ -235,6 +255,9 @@ protected:
 
         GLuint _defaultVAO { 0 };
 
+        // the per instance attributes advance every two instances when both eyes are drawn at once
+        GLuint _divisorScale { 1 };
+
         InputStageState() :
             _buffers(_invalidBuffers.size()),
             _bufferOffsets(_invalidBuffers.size(), 0),
@@ -269,6 +292,9 @@ protected:
         GLuint _objectBuffer { 0 };
         GLuint _cameraBuffer { 0 };
         GLuint _drawCallInfoBuffer { 0 };
+        GLuint _drawRunBuffer { 0 }; // the indirect commands of the current indexed draw run
+        // the buffer holding the draw call infos of the current batch, a backend may stream them elsewhere
+        mutable GLuint _currentDrawCallInfoBuffer { 0 };
         GLuint _objectBufferTexture { 0 };
         size_t _cameraUboSize { 0 };
         bool _viewIsCamera{ false };
@@ -292,6 +318,8 @@ protected:
         void preUpdate(size_t commandIndex, const StereoState& stereo);
         void update(size_t commandIndex, const StereoState& stereo) const;
         void bindCurrentCamera(int stereoSide) const;
+        // the cameras of both eyes side by side, as the stereo version of the shaders reads them
+        void bindCurrentStereoCameras() const;
     } _transform;
 
     virtual void transferTransformState(const Batch& batch) const = 0;
@@ -306,6 +334,7 @@ protected:
     
     // update resource cache and do the gl unbind call with the current gpu::Texture cached at slot s
     void releaseResourceTexture(uint32_t slot);
+    void bindResourceTexture(uint32_t slot, const TexturePointer& resourceTexture);
 
     void resetResourceStage();
 
@@ -325,12 +354,18 @@ protected:
     void syncPipelineStateCache();
     void resetPipelineStage();
 
+    bool canDrawInstancedStereo(const GLShader* program) const;
+    // Switches the program of the current pipeline to the version for the stereo state of the batch
+    void updateProgramVersion();
+
     struct PipelineStageState {
         PipelinePointer _pipeline;
 
         GLuint _program { 0 };
         GLint _cameraCorrectionLocation { -1 };
         GLShader* _programShader { nullptr };
+        // the program is the stereo version, its draws go in a single call for both eyes
+        bool _instancedStereo { false };
         bool _invalidProgram { false };
 
         BufferView _cameraCorrectionBuffer { gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(CameraCorrection), nullptr )) };
@@ -163,6 +163,12 @@ void GLBackend::do_setIndirectBuffer(const Batch& batch, size_t paramOffset) {
 #endif
 
 void GLBackend::updateInput() {
+    GLuint divisorScale = isInstancedStereo() ? 2 : 1;
+    if (_input._divisorScale != divisorScale) {
+        _input._divisorScale = divisorScale;
+        _input._invalidFormat = true;
+    }
+
 #if defined(SUPPORT_VERTEX_ATTRIB_FORMAT)
     if (_input._invalidFormat) {
 
@@ -187,7 +193,7 @@ void GLBackend::updateInput() {
                     glVertexAttribFormat(slot + locNum, count, type, isNormalized, offset + locNum * perLocationSize);
                     glVertexAttribBinding(slot + locNum, attrib._channel);
                 }
-                glVertexBindingDivisor(attrib._channel, attrib._frequency);
+                glVertexBindingDivisor(attrib._channel, attrib._frequency * _input._divisorScale);
             }
             (void)CHECK_GL_ERROR();
         }
@@ -306,7 +312,7 @@ void GLBackend::updateInput() {
                             for (size_t locNum = 0; locNum < locationCount; ++locNum) {
                                 glVertexAttribPointer(slot + (GLuint)locNum, count, type, isNormalized, stride,
                                     reinterpret_cast<GLvoid*>(pointer + perLocationStride * (GLuint)locNum));
-                                glVertexAttribDivisor(slot + (GLuint)locNum, attrib._frequency);
+                                glVertexAttribDivisor(slot + (GLuint)locNum, attrib._frequency * _input._divisorScale);
                             }
 
                             // TODO: Support properly the IAttrib version
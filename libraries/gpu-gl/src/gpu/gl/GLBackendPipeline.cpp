@@ -16,6 +16,8 @@
 #include "GLBuffer.h"
 #include "GLTexture.h"
 
+#include <gpu/TextureTable.h>
+
 using namespace gpu;
 using namespace gpu::gl;
 
@@ -36,6 +38,7 @@ void GLBackend::do_setPipeline(const Batch& batch, size_t paramOffset) {
         _pipeline._program = 0;
         _pipeline._cameraCorrectionLocation = -1;
         _pipeline._programShader = nullptr;
+        _pipeline._instancedStereo = false;
         _pipeline._invalidProgram = true;
 
         _pipeline._state = nullptr;
@@ -48,11 +51,13 @@ void GLBackend::do_setPipeline(const Batch& batch, size_t paramOffset) {
 
         // check the program cache
         // pick the program version 
-        GLuint glprogram = pipelineObject->_program->getProgram();
+        bool instancedStereo = canDrawInstancedStereo(pipelineObject->_program);
+        GLuint glprogram = pipelineObject->_program->getProgram(instancedStereo ? GLShader::Stereo : GLShader::Mono);
 
         if (_pipeline._program != glprogram) {
             _pipeline._program = glprogram;
             _pipeline._programShader = pipelineObject->_program;
+            _pipeline._instancedStereo = instancedStereo;
             _pipeline._invalidProgram = true;
             _pipeline._cameraCorrectionLocation = pipelineObject->_cameraCorrection;
         }
@@ -79,6 +84,23 @@ void GLBackend::do_setPipeline(const Batch& batch, size_t paramOffset) {
     }
 }
 
+bool GLBackend::canDrawInstancedStereo(const GLShader* program) const {
+    return _stereo._enable && _stereo._instanced && supportsInstancedStereo() && program && program->hasVersion(GLShader::Stereo);
+}
+
+void GLBackend::updateProgramVersion() {
+    if (!_pipeline._programShader) {
+        return;
+    }
+    // the pipeline may stay across batches that don't have the same stereo state
+    bool instancedStereo = canDrawInstancedStereo(_pipeline._programShader);
+    if (instancedStereo != _pipeline._instancedStereo) {
+        _pipeline._program = _pipeline._programShader->getProgram(instancedStereo ? GLShader::Stereo : GLShader::Mono);
+        _pipeline._instancedStereo = instancedStereo;
+        _pipeline._invalidProgram = true;
+    }
+}
+
 void GLBackend::updatePipeline() {
     if (_pipeline._invalidProgram) {
         // doing it here is aproblem for calls to glUniform.... so will do it on assing...
@@ -119,6 +141,7 @@ void GLBackend::resetPipelineStage() {
     _pipeline._invalidProgram = false;
     _pipeline._program = 0;
     _pipeline._programShader = nullptr;
+    _pipeline._instancedStereo = false;
     _pipeline._pipeline.reset();
     glUseProgram(0);
 }
@@ -194,6 +217,26 @@ void GLBackend::do_setResourceTexture(const Batch& batch, size_t paramOffset) {
     GLuint slot = batch._params[paramOffset + 1]._uint;
     TexturePointer resourceTexture = batch._textures.get(batch._params[paramOffset + 0]._uint);
 
+    bindResourceTexture(slot, resourceTexture);
+}
+
+void GLBackend::do_setResourceTextureTable(const Batch& batch, size_t paramOffset) {
+    const auto& textureTable = batch._textureTables.get(batch._params[paramOffset + 0]._uint);
+    GLuint slot = batch._params[paramOffset + 1]._uint;
+    if (!textureTable) {
+        return;
+    }
+
+    // the handles of the slots of the table are passed along with the next draw (see GL45Backend::updateTextureTable)
+    const auto& textures = textureTable->getTextures();
+    for (GLuint i = 0; i < TextureTable::COUNT && (slot + i) < MAX_NUM_RESOURCE_TEXTURES; ++i) {
+        if (textures[i]) {
+            bindResourceTexture(slot + i, textures[i]);
+        }
+    }
+}
+
+void GLBackend::bindResourceTexture(uint32_t slot, const TexturePointer& resourceTexture) {
     if (!resourceTexture) {
         releaseResourceTexture(slot);
         return;
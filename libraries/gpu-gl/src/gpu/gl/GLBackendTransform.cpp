@@ -55,6 +55,7 @@ void GLBackend::killTransform() {
     glDeleteBuffers(1, &_transform._objectBuffer);
     glDeleteBuffers(1, &_transform._cameraBuffer);
     glDeleteBuffers(1, &_transform._drawCallInfoBuffer);
+    glDeleteBuffers(1, &_transform._drawRunBuffer);
     glDeleteTextures(1, &_transform._objectBufferTexture);
 }
 
@@ -135,6 +136,12 @@ void GLBackend::TransformStageState::bindCurrentCamera(int eye) const {
     }
 }
 
+void GLBackend::TransformStageState::bindCurrentStereoCameras() const {
+    if (_currentCameraOffset != INVALID_OFFSET) {
+        glBindBufferRange(GL_UNIFORM_BUFFER, TRANSFORM_CAMERA_SLOT, _cameraBuffer, _currentCameraOffset, 2 * sizeof(CameraBufferElement));
+    }
+}
+
 void GLBackend::updateTransform(const Batch& batch) {
     _transform.update(_commandIndex, _stereo);
 
@@ -145,10 +152,10 @@ void GLBackend::updateTransform(const Batch& batch) {
         glVertexAttribI2i(gpu::Stream::DRAW_CALL_INFO, drawCallInfo.index, drawCallInfo.unused);
     } else {
         glEnableVertexAttribArray(gpu::Stream::DRAW_CALL_INFO); // Make sure attrib array is enabled
-        glBindBuffer(GL_ARRAY_BUFFER, _transform._drawCallInfoBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, _transform._currentDrawCallInfoBuffer);
         glVertexAttribIPointer(gpu::Stream::DRAW_CALL_INFO, 2, GL_UNSIGNED_SHORT, 0,
                                _transform._drawCallInfoOffsets[batch._currentNamedCall]);
-        glVertexAttribDivisor(gpu::Stream::DRAW_CALL_INFO, 1);
+        glVertexAttribDivisor(gpu::Stream::DRAW_CALL_INFO, _input._divisorScale);
     }
     
     (void)CHECK_GL_ERROR();
@@ -0,0 +1,173 @@
+//
+//  GLProgramCache.cpp
+//  libraries/gpu-gl/src/gpu/gl
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GLProgramCache.h"
+
+#include <mutex>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <GPUIdent.h>
+
+using namespace gpu;
+using namespace gpu::gl;
+
+static const QString PROGRAM_CACHE_DIRECTORY = "programCache";
+static const QString PROGRAM_BINARY_EXTENSION = ".glbin";
+
+// Bump to drop every binary cached by an older layout of the files or of the keys
+static const quint32 PROGRAM_CACHE_VERSION = 1;
+
+struct ProgramBinaryHeader {
+    quint32 version;
+    quint32 format;
+};
+
+bool GLProgramCache::isEnabled() {
+    static bool enabled = false;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        enabled = (numFormats > 0) && !getDirectory().isEmpty();
+        qCDebug(gpugllogging) << "GLProgramCache" << (enabled ? "at" : "disabled") << getDirectory();
+    });
+    return enabled;
+}
+
+const QString& GLProgramCache::getDirectory() {
+    static QString directory;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        QString dataPath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+        directory = QDir(!dataPath.isEmpty() ? dataPath : "interfaceCache").absoluteFilePath(PROGRAM_CACHE_DIRECTORY);
+        if (!QDir().mkpath(directory)) {
+            directory.clear();
+        }
+    });
+    return directory;
+}
+
+const QByteArray& GLProgramCache::getDriverIdentity() {
+    static QByteArray identity;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        auto gpuIdent = GPUIdent::getInstance();
+        identity = QByteArray::number(PROGRAM_CACHE_VERSION);
+        identity += '\n';
+        identity += (const char*)glGetString(GL_VENDOR);
+        identity += '\n';
+        identity += (const char*)glGetString(GL_RENDERER);
+        identity += '\n';
+        identity += (const char*)glGetString(GL_VERSION);
+        identity += '\n';
+        identity += gpuIdent->getName().toUtf8();
+        identity += '\n';
+        identity += gpuIdent->getDriver().toUtf8();
+    });
+    return identity;
+}
+
+QString GLProgramCache::getPath(const QByteArray& key) {
+    return getDirectory() + "/" + key + PROGRAM_BINARY_EXTENSION;
+}
+
+QByteArray GLProgramCache::evalKey(const ShaderSources& shaderSources, const std::vector<std::string>& feedbackVaryings) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(getDriverIdentity());
+
+    // the separators keep the boundaries of the strings in the hash
+    for (const auto& shaderSource : shaderSources) {
+        hash.addData(shaderSource.first.c_str(), (int)shaderSource.first.size());
+        hash.addData("\0", 1);
+        hash.addData(shaderSource.second.c_str(), (int)shaderSource.second.size());
+        hash.addData("\0", 1);
+    }
+    for (const auto& varying : feedbackVaryings) {
+        hash.addData(varying.c_str(), (int)varying.size());
+        hash.addData("\0", 1);
+    }
+    return hash.result().toHex();
+}
+
+GLuint GLProgramCache::loadProgram(const QByteArray& key) {
+    QString path = getPath(key);
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    QByteArray data = file.readAll();
+    file.close();
+
+    ProgramBinaryHeader header;
+    if (data.size() <= (int)sizeof(ProgramBinaryHeader)) {
+        QFile::remove(path);
+        return 0;
+    }
+    memcpy(&header, data.constData(), sizeof(ProgramBinaryHeader));
+    if (header.version != PROGRAM_CACHE_VERSION) {
+        QFile::remove(path);
+        return 0;
+    }
+
+    GLuint glprogram = glCreateProgram();
+    if (!glprogram) {
+        return 0;
+    }
+    glProgramBinary(glprogram, (GLenum)header.format, data.constData() + sizeof(ProgramBinaryHeader),
+        (GLsizei)(data.size() - sizeof(ProgramBinaryHeader)));
+    // a format the driver doesn't know anymore is an error, not just a failed link
+    glGetError();
+
+    GLint linked = 0;
+    glGetProgramiv(glprogram, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        qCDebug(gpugllogging) << "GLProgramCache::loadProgram - the driver refused the binary" << key << ", compiling the program again";
+        glDeleteProgram(glprogram);
+        QFile::remove(path);
+        return 0;
+    }
+    return glprogram;
+}
+
+void GLProgramCache::saveProgram(const QByteArray& key, GLuint glprogram) {
+    GLint length = 0;
+    glGetProgramiv(glprogram, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    QByteArray data((int)sizeof(ProgramBinaryHeader) + length, 0);
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(glprogram, length, &written, &format, data.data() + sizeof(ProgramBinaryHeader));
+    if (written <= 0) {
+        return;
+    }
+    data.resize((int)sizeof(ProgramBinaryHeader) + written);
+
+    ProgramBinaryHeader header;
+    header.version = PROGRAM_CACHE_VERSION;
+    header.format = (quint32)format;
+    memcpy(data.data(), &header, sizeof(ProgramBinaryHeader));
+
+    // written aside and then moved in place, a binary is never read half written
+    QSaveFile file(getPath(key));
+    if (file.open(QIODevice::WriteOnly) && file.write(data) == data.size()) {
+        file.commit();
+    } else {
+        file.cancelWriting();
+    }
+}
@@ -0,0 +1,55 @@
+//
+//  GLProgramCache.h
+//  libraries/gpu-gl/src/gpu/gl
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_gpu_gl_GLProgramCache_h
+#define hifi_gpu_gl_GLProgramCache_h
+
+#include <string>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "GLShared.h"
+
+namespace gpu { namespace gl {
+
+// Keeps the binaries of the linked programs on disk, so the next runs don't compile and link them again.
+// The key of a program is a hash of the defines and sources of its shaders, of its feedback varyings and of the identity
+// of the GPU and its driver: a new driver misses on all the binaries of the previous one, and a binary the driver
+// refuses anyway is thrown away.
+class GLProgramCache {
+public:
+    // the defines and the source of each shader of a program
+    using ShaderSources = std::vector<std::pair<std::string, std::string>>;
+
+    // False when the driver has no binary format or there is nowhere to write the binaries
+    static bool isEnabled();
+
+    static QByteArray evalKey(const ShaderSources& shaderSources, const std::vector<std::string>& feedbackVaryings);
+
+    // A program linked from the binary cached for the key, or 0 if there is none
+    static GLuint loadProgram(const QByteArray& key);
+
+    // Caches the binary of a program linked with the retrievable hint
+    static void saveProgram(const QByteArray& key, GLuint glprogram);
+
+protected:
+    static const QString& getDirectory();
+    static const QByteArray& getDriverIdentity();
+    static QString getPath(const QByteArray& key);
+};
+
+} }
+
+#endif // hifi_gpu_gl_GLProgramCache_h
@@ -7,6 +7,7 @@
 //
 #include "GLShader.h"
 #include "GLBackend.h"
+#include "GLProgramCache.h"
 
 using namespace gpu;
 using namespace gpu::gl;
@@ -15,7 +16,12 @@ GLShader::GLShader(const std::weak_ptr<GLBackend>& backend) : _backend(backend)
 }
 
 GLShader::~GLShader() {
-    for (auto& so : _shaderObjects) {
+    for (size_t version = 0; version < _shaderObjects.size(); version++) {
+        auto& so = _shaderObjects[version];
+        // a version identical to the default one shares its objects
+        if (version != Mono && so.glshader == _shaderObjects[Mono].glshader && so.glprogram == _shaderObjects[Mono].glprogram) {
+            continue;
+        }
         auto backend = _backend.lock();
         if (backend) {
             if (so.glshader != 0) {
@@ -54,9 +60,40 @@ static const std::array<std::string, NUM_SHADER_DOMAINS> DOMAIN_DEFINES { {
 
 // Versions specific of the shader
 static const std::array<std::string, GLShader::NumVersions> VERSION_DEFINES { {
-    ""
+    "",
+    "#define GPU_TRANSFORM_IS_STEREO"
 } };
 
+// The stereo version of a vertex shader only draws both eyes right if it puts its clip positions in the half of the
+// viewport of their eye (transformStereoClipPos in Transform.slh), the geometry shaders are left mono.
+// The shaders that don't use the camera are the same in both versions.
+static bool needsStereoVersion(const Shader& shader, const std::string& shaderSource, bool& sameAsMono) {
+    sameAsMono = false;
+    switch (shader.getType()) {
+        case Shader::VERTEX:
+            return shaderSource.find("gl_ClipDistance") != std::string::npos;
+        case Shader::PIXEL:
+            sameAsMono = shaderSource.find("transformCameraBuffer") == std::string::npos;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// The material textures are sampled through the handles of the TextureTable (see TextureTable.slh)
+static const std::string BINDLESS_DEFINES {
+    "#extension GL_ARB_bindless_texture : require\n"
+    "#define GPU_TEXTURE_TABLE_BINDLESS"
+};
+
+static std::string getShaderDefines(const GLBackend& backend, const Shader& shader, int version) {
+    std::string defines = glslVersion + "\n" + DOMAIN_DEFINES[shader.getType()] + "\n" + VERSION_DEFINES[version];
+    if (backend.supportsBindlessTextures()) {
+        defines += "\n" + BINDLESS_DEFINES;
+    }
+    return defines;
+}
+
 GLShader* compileBackendShader(GLBackend& backend, const Shader& shader) {
     // Any GLSLprogram ? normally yes...
     const std::string& shaderSource = shader.getSource().getCode();
@@ -66,10 +103,26 @@ GLShader* compileBackendShader(GLBackend& backend, const Shader& shader) {
     for (int version = 0; version < GLShader::NumVersions; version++) {
         auto& shaderObject = shaderObjects[version];
 
-        std::string shaderDefines = glslVersion + "\n" + DOMAIN_DEFINES[shader.getType()] + "\n" + VERSION_DEFINES[version];
+        if (version == GLShader::Stereo) {
+            bool sameAsMono = false;
+            if (!backend.supportsInstancedStereo() || !needsStereoVersion(shader, shaderSource, sameAsMono)) {
+                continue;
+            }
+            if (sameAsMono) {
+                shaderObject = shaderObjects[GLShader::Mono];
+                continue;
+            }
+        }
+
+        std::string shaderDefines = getShaderDefines(backend, shader, version);
 
         bool result = compileShader(shaderDomain, shaderSource, shaderDefines, shaderObject.glshader, shaderObject.glprogram);
         if (!result) {
+            if (version != GLShader::Mono) {
+                // the program is drawn once per eye with the default version instead
+                shaderObject = GLShader::ShaderObject();
+                continue;
+            }
             return nullptr;
         }
     }
@@ -91,25 +144,71 @@ GLShader* compileBackendProgram(GLBackend& backend, const Shader& program) {
     for (int version = 0; version < GLShader::NumVersions; version++) {
         auto& programObject = programObjects[version];
 
+        if (version == GLShader::Stereo) {
+            if (!backend.supportsInstancedStereo()) {
+                continue;
+            }
+            bool hasStereoVersions = true;
+            for (auto subShader : program.getShaders()) {
+                bool sameAsMono = false;
+                hasStereoVersions = hasStereoVersions && needsStereoVersion(*subShader, subShader->getSource().getCode(), sameAsMono);
+            }
+            if (!hasStereoVersions) {
+                continue;
+            }
+        }
+
+        // A program cached by a previous run doesn't need its shaders
+        QByteArray cacheKey;
+        if (GLProgramCache::isEnabled()) {
+            GLProgramCache::ShaderSources shaderSources;
+            for (auto subShader : program.getShaders()) {
+                shaderSources.emplace_back(getShaderDefines(backend, *subShader, version), subShader->getSource().getCode());
+            }
+            cacheKey = GLProgramCache::evalKey(shaderSources, program.getTransformFeedbackVaryings());
+
+            GLuint glprogram = GLProgramCache::loadProgram(cacheKey);
+            if (glprogram != 0) {
+                programObject.glprogram = glprogram;
+                makeProgramBindings(programObject);
+                continue;
+            }
+        }
+
         // Let's go through every shaders and make sure they are ready to go
         std::vector< GLuint > shaderGLObjects;
+        bool hasVersion = true;
         for (auto subShader : program.getShaders()) {
             auto object = GLShader::sync(backend, *subShader);
             if (object) {
-                shaderGLObjects.push_back(object->_shaderObjects[version].glshader);
+                GLuint glshader = object->_shaderObjects[version].glshader;
+                hasVersion = hasVersion && (glshader != 0);
+                shaderGLObjects.push_back(glshader);
             } else {
                 qCDebug(gpugllogging) << "GLShader::compileBackendProgram - One of the shaders of the program is not compiled?";
                 return nullptr;
             }
         }
 
-        GLuint glprogram = compileProgram(shaderGLObjects);
+        // A version other than the default one is only made when all the shaders of the program have it
+        if (version != GLShader::Mono && !hasVersion) {
+            continue;
+        }
+
+        GLuint glprogram = compileProgram(shaderGLObjects, program.getTransformFeedbackVaryings());
         if (glprogram == 0) {
+            if (version != GLShader::Mono) {
+                continue;
+            }
             return nullptr;
         }
 
         programObject.glprogram = glprogram;
 
+        if (!cacheKey.isEmpty()) {
+            GLProgramCache::saveProgram(cacheKey, glprogram);
+        }
+
         makeProgramBindings(programObject);
     }
 
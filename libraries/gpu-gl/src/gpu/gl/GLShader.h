@@ -19,6 +19,9 @@ public:
 
     enum Version {
         Mono = 0,
+        // Draws both eyes at once, see GPU_TRANSFORM_IS_STEREO in Transform.slh,
+        // only made when the backend supports instanced stereo and the program can be drawn that way
+        Stereo,
         NumVersions
     };
 
@@ -38,10 +41,18 @@ public:
         return _shaderObjects[version].glprogram;
     }
 
-    GLint getUniformLocation(GLint srcLoc, Version version = Mono) {
-        // THIS will be used in the future PR as we grow the number of versions
-        // return _uniformMappings[version][srcLoc];
-        return srcLoc;
+    bool hasVersion(Version version) const {
+        return _shaderObjects[version].glprogram != 0;
+    }
+
+    GLint getUniformLocation(GLint srcLoc, Version version = Mono) const {
+        // the mapping of a version is from the locations of the default version to its own
+        if (version == Mono || (size_t)(version - 1) >= _uniformMappings.size()) {
+            return srcLoc;
+        }
+        const auto& mapping = _uniformMappings[version - 1];
+        auto found = mapping.find(srcLoc);
+        return (found != mapping.end()) ? found->second : -1;
     }
 
     const std::weak_ptr<GLBackend> _backend;
@@ -788,7 +788,7 @@ bool compileShader(GLenum shaderDomain, const std::string& shaderSource, const s
     return true;
 }
 
-GLuint compileProgram(const std::vector<GLuint>& glshaders) {
+GLuint compileProgram(const std::vector<GLuint>& glshaders, const std::vector<std::string>& feedbackVaryings) {
     // A brand new program:
     GLuint glprogram = glCreateProgram();
     if (!glprogram) {
@@ -796,12 +796,23 @@ GLuint compileProgram(const std::vector<GLuint>& glshaders) {
         return 0;
     }
 
-    // glProgramParameteri(glprogram, GL_PROGRAM_, GL_TRUE);
+    // so the binary can be kept in the GLProgramCache
+    glProgramParameteri(glprogram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     // Create the program from the sub shaders
     for (auto so : glshaders) {
         glAttachShader(glprogram, so);
     }
 
+    // The varyings to feed back have to be known before linking, they are interleaved in a single buffer
+    if (!feedbackVaryings.empty()) {
+        std::vector<const GLchar*> names;
+        names.reserve(feedbackVaryings.size());
+        for (const auto& varying : feedbackVaryings) {
+            names.push_back(varying.c_str());
+        }
+        glTransformFeedbackVaryings(glprogram, (GLsizei)names.size(), names.data(), GL_INTERLEAVED_ATTRIBS);
+    }
+
     // Link!
     glLinkProgram(glprogram);
 
@@ -930,6 +941,11 @@ void makeProgramBindings(ShaderObject& shaderObject) {
         shaderObject.transformCameraSlot = gpu::TRANSFORM_CAMERA_SLOT;
     }
 
+    loc = glGetUniformBlockIndex(glprogram, "gpu_resourceTextureTable");
+    if (loc >= 0) {
+        glUniformBlockBinding(glprogram, loc, gpu::RESOURCE_TEXTURE_TABLE_SLOT);
+    }
+
     (void)CHECK_GL_ERROR();
 }
 
@@ -38,7 +38,7 @@ int makeUniformBlockSlots(GLuint glprogram, const Shader::BindingSet& slotBindin
 int makeInputSlots(GLuint glprogram, const Shader::BindingSet& slotBindings, Shader::SlotSet& inputs);
 int makeOutputSlots(GLuint glprogram, const Shader::BindingSet& slotBindings, Shader::SlotSet& outputs);
 bool compileShader(GLenum shaderDomain, const std::string& shaderSource, const std::string& defines, GLuint &shaderObject, GLuint &programObject);
-GLuint compileProgram(const std::vector<GLuint>& glshaders);
+GLuint compileProgram(const std::vector<GLuint>& glshaders, const std::vector<std::string>& feedbackVaryings = std::vector<std::string>());
 void makeProgramBindings(ShaderObject& shaderObject);
 
 enum GLSyncState {
@@ -17,6 +17,8 @@ using namespace gpu;
 using namespace gpu::gl;
 
 std::shared_ptr<GLTextureTransferHelper> GLTexture::_textureTransferHelper;
+std::unordered_map<const Texture*, std::weak_ptr<Texture>> GLTexture::_streamableTextures;
+uint32 GLTexture::_residencyFrame { 0 };
 static std::map<uint16, size_t> _textureCountByMips;
 static uint16 _currentMaxMipCount { 0 };
 
@@ -94,7 +96,28 @@ const std::vector<GLenum>& GLTexture::getFaceTargets(GLenum target) {
     return faceTargets;
 }
 
-float GLTexture::getMemoryPressure() {
+bool GLTexture::isStreamable(const Texture& texture, bool transferrable) {
+    // Mips generated on the gpu are never in sysmem, and cube maps are small enough to always be resident
+    if (!transferrable || texture.getType() != Texture::TEX_2D || texture.isAutogenerateMips() || texture.maxMip() == 0) {
+        return false;
+    }
+    for (uint16 level = texture.minMip(); level <= texture.maxMip(); ++level) {
+        if (!texture.isStoredMipFaceAvailable(level)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint16 GLTexture::evalStreamingStartMip(const Texture& texture) {
+    uint16 mip = texture.minMip();
+    while (mip < texture.maxMip() && std::max(texture.evalMipWidth(mip), texture.evalMipHeight(mip)) > STREAMING_START_DIMENSION) {
+        ++mip;
+    }
+    return mip;
+}
+
+Size GLTexture::getAllowedMemory() {
     // Check for an explicit memory limit
     auto availableTextureMemory = Texture::getAllowedGPUMemoryUsage();
 
@@ -112,10 +135,13 @@ float GLTexture::getMemoryPressure() {
         // FIXME overly conservative?
         availableTextureMemory = (totalGpuMemory >> 2) * 3;
     }
+    return availableTextureMemory;
+}
 
+float GLTexture::getMemoryPressure() {
     // Return the consumed texture memory divided by the available texture memory.
     auto consumedGpuMemory = Context::getTextureGPUMemoryUsage();
-    return (float)consumedGpuMemory / (float)availableTextureMemory;
+    return (float)consumedGpuMemory / (float)getAllowedMemory();
 }
 
 GLTexture::DownsampleSource::DownsampleSource(const std::weak_ptr<GLBackend>& backend, GLTexture* oldTexture) :
@@ -136,16 +162,22 @@ GLTexture::DownsampleSource::~DownsampleSource() {
     }
 }
 
-GLTexture::GLTexture(const std::weak_ptr<GLBackend>& backend, const gpu::Texture& texture, GLuint id, GLTexture* originalTexture, bool transferrable) :
+GLTexture::GLTexture(const std::weak_ptr<GLBackend>& backend, const gpu::Texture& texture, GLuint id, GLTexture* originalTexture, bool transferrable, uint16 minMip) :
     GLObject(backend, texture, id),
     _storageStamp(texture.getStamp()),
     _target(getGLTextureType(texture)),
     _maxMip(texture.maxMip()),
-    _minMip(texture.minMip()),
+    _minMip(minMip),
     _virtualSize(texture.evalTotalSize()),
     _transferrable(transferrable),
+    _streamable(isStreamable(texture, transferrable)),
+    _requestedMinMip(originalTexture ? originalTexture->_requestedMinMip : texture.maxMip()),
+    _lastRequestFrame(originalTexture ? originalTexture->_lastRequestFrame : _residencyFrame),
     _downsampleSource(backend, originalTexture)
 {
+    if (_streamable && _minMip > texture.minMip()) {
+        Backend::incrementTextureGPUStreamingCount();
+    }
     if (_transferrable) {
         uint16 mipCount = usedMipLevels();
         _currentMaxMipCount = std::max(_currentMaxMipCount, mipCount);
@@ -160,9 +192,10 @@ GLTexture::GLTexture(const std::weak_ptr<GLBackend>& backend, const gpu::Texture
 }
 
 
-// Create the texture and allocate storage
+// Create the texture and allocate storage, streamable textures start out with their smaller mips only
 GLTexture::GLTexture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, GLuint id, bool transferrable) :
-    GLTexture(backend, texture, id, nullptr, transferrable)
+    GLTexture(backend, texture, id, nullptr, transferrable,
+        isStreamable(texture, transferrable) ? evalStreamingStartMip(texture) : texture.minMip())
 {
     // FIXME, do during allocation
     //Backend::updateTextureGPUMemoryUsage(0, _size);
@@ -171,14 +204,26 @@ GLTexture::GLTexture(const std::weak_ptr<GLBackend>& backend, const Texture& tex
 
 // Create the texture and copy from the original higher resolution version
 GLTexture::GLTexture(const std::weak_ptr<GLBackend>& backend, const gpu::Texture& texture, GLuint id, GLTexture* originalTexture) :
-    GLTexture(backend, texture, id, originalTexture, originalTexture->_transferrable)
+    GLTexture(backend, texture, id, originalTexture, originalTexture->_transferrable, texture.minMip())
 {
     Q_ASSERT(_minMip >= originalTexture->_minMip);
     // Set the GPU object last because that implicitly destroys the originalTexture object
     Backend::setGPUObject(texture, this);
 }
 
+// Create the texture with more or fewer mips than the original, the shared mips are copied from it
+GLTexture::GLTexture(const std::weak_ptr<GLBackend>& backend, const gpu::Texture& texture, GLuint id, GLTexture* originalTexture, uint16 minMip) :
+    GLTexture(backend, texture, id, originalTexture, originalTexture->_transferrable, minMip)
+{
+    // Set the GPU object last because that implicitly destroys the originalTexture object
+    Backend::setGPUObject(texture, this);
+}
+
 GLTexture::~GLTexture() {
+    if (_streamable && _minMip > _gpuObject.minMip()) {
+        Backend::decrementTextureGPUStreamingCount();
+    }
+
     if (_transferrable) {
         uint16 mipCount = usedMipLevels();
         Q_ASSERT(_textureCountByMips.count(mipCount));
@@ -213,6 +258,55 @@ void GLTexture::createTexture() {
 void GLTexture::setSize(GLuint size) const {
     Backend::updateTextureGPUMemoryUsage(_size, size);
     const_cast<GLuint&>(_size) = size;
+    _gpuObject.notifyGPUResidentSize(size);
+}
+
+uint16 GLTexture::evalCopiedMinMip() const {
+    if (!_downsampleSource._texture) {
+        return _maxMip + 1;
+    }
+    return std::max(_minMip, _downsampleSource._minMip);
+}
+
+GLuint GLTexture::evalTransferSize() const {
+    GLuint size = 0;
+    uint16 copiedMinMip = evalCopiedMinMip();
+    for (uint16 level = _minMip; level < copiedMinMip; ++level) {
+        size += _gpuObject.evalMipSize(level);
+    }
+    return size * _gpuObject.getNumSlices();
+}
+
+void GLTexture::transferMipRows(uint16_t mipLevel, uint8_t face, const MipRowsUpload& upload) const {
+    auto mip = _gpuObject.accessStoredMipFace(mipLevel, face);
+    auto dimensions = _gpuObject.evalMipDimensions(mipLevel);
+
+    // Mips from a QImage have their rows padded out to 32 bits, others are tightly packed
+    GLuint rowPitch = (GLuint)mip->getSize() / dimensions.y;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, (rowPitch % 4 == 0) ? 4 : 1);
+
+    GLsizei bandRows = std::max<GLsizei>(1, MAX_TRANSFER_BAND_SIZE / std::max<GLuint>(rowPitch, 1));
+    const Byte* pixels = mip->readData();
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _textureTransferHelper->getStagingBuffer());
+    for (GLsizei y = 0; y < (GLsizei)dimensions.y; y += bandRows) {
+        GLsizei numRows = std::min<GLsizei>(bandRows, dimensions.y - y);
+        GLsizeiptr bandSize = (GLsizeiptr)numRows * rowPitch;
+        // Orphan the previous band, the driver holds on to it until its upload is done
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, bandSize, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, bandSize, pixels + (size_t)y * rowPitch);
+        upload(y, numRows, nullptr);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    (void)CHECK_GL_ERROR();
+}
+
+GLuint GLTexture::evalResidentSize() const {
+    GLuint size = 0;
+    for (uint16 level = _minMip; level <= _maxMip; ++level) {
+        size += _gpuObject.evalMipSize(level);
+    }
+    return size * _gpuObject.getNumSlices();
 }
 
 bool GLTexture::isInvalid() const {
@@ -262,6 +356,11 @@ void GLTexture::postTransfer() {
 
     _downsampleSource.reset();
 
+    // A streamable texture keeps its sysmem to stream the mips back in after they are evicted
+    if (_streamable) {
+        return;
+    }
+
     // At this point the mip pixels have been loaded, we can notify the gpu texture to abandon it's memory
     switch (_gpuObject.getType()) {
         case Texture::TEX_2D:
@@ -8,6 +8,9 @@
 #ifndef hifi_gpu_gl_GLTexture_h
 #define hifi_gpu_gl_GLTexture_h
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "GLShared.h"
 #include "GLTextureTransfer.h"
 #include "GLBackend.h"
@@ -43,6 +46,9 @@ public:
         if (!object || object->isInvalid()) {
             // This automatically any previous texture
             object = new GLTextureType(backend.shared_from_this(), texture, needTransfer);
+            if (object->_streamable) {
+                _streamableTextures[&texture] = texturePointer;
+            }
             if (!object->_transferrable) {
                 object->createTexture();
                 object->_contentStamp = texture.getDataStamp();
@@ -72,7 +78,8 @@ public:
         }
 
         // Do we need to reduce texture memory usage?
-        if (object->isOverMaxMemory() && texturePointer->incremementMinMip()) {
+        // Streamable textures give up their mips in updateResidency instead, where they can be streamed back in
+        if (!object->_streamable && object->isOverMaxMemory() && texturePointer->incremementMinMip()) {
             // WARNING, this code path will essentially `delete this`, 
             // so no dereferencing of this instance should be done past this point
             object = new GLTextureType(backend.shared_from_this(), texture, object);
@@ -83,6 +90,84 @@ public:
         return object;
     }
 
+    // Once a frame, streams mips of the streamable textures in towards the mips the renderer requested,
+    // or when over the memory budget, evicts the mips that were not requested, from the textures that went unused longest
+    template <typename GLTextureType>
+    static void updateResidency(GLBackend& backend) {
+        struct Candidate {
+            TexturePointer texture;
+            GLTextureType* object;
+            uint16 minMip;
+            uint32 priority;
+        };
+        std::vector<Candidate> promotions;
+        std::vector<Candidate> evictions;
+
+        ++_residencyFrame;
+        for (auto it = _streamableTextures.begin(); it != _streamableTextures.end();) {
+            TexturePointer texture = it->second.lock();
+            if (!texture) {
+                it = _streamableTextures.erase(it);
+                continue;
+            }
+            ++it;
+
+            GLTextureType* object = Backend::getGPUObject<GLTextureType>(*texture);
+            if (!object || !object->_streamable) {
+                continue;
+            }
+            if (GLSyncState::Transferred == object->getSyncState()) {
+                object->postTransfer();
+            }
+            if (!object->isReady()) {
+                continue;
+            }
+
+            uint16 requested = texture->takeRequestedMinMip();
+            if (requested != Texture::NO_MIP_REQUESTED) {
+                object->_requestedMinMip = requested;
+                object->_lastRequestFrame = _residencyFrame;
+            }
+
+            uint16 wantedMip = std::min(std::max(object->_requestedMinMip, texture->minMip()), object->_maxMip);
+            uint32 unusedFrames = _residencyFrame - object->_lastRequestFrame;
+            if (unusedFrames > MAX_UNUSED_FRAMES) {
+                wantedMip = std::max(wantedMip, evalStreamingStartMip(*texture));
+            }
+
+            if (wantedMip < object->_minMip) {
+                promotions.push_back({ texture, object, (uint16)(object->_minMip - 1), (uint32)(object->_minMip - wantedMip) });
+            } else if (wantedMip > object->_minMip) {
+                evictions.push_back({ texture, object, (uint16)(object->_minMip + 1), unusedFrames });
+            }
+        }
+
+        auto byPriority = [](const Candidate& a, const Candidate& b) { return a.priority > b.priority; };
+        Size allowedMemory = getAllowedMemory();
+        Size consumedMemory = Context::getTextureGPUMemoryUsage();
+        if (consumedMemory >= allowedMemory) {
+            std::sort(evictions.begin(), evictions.end(), byPriority);
+            size_t numEvictions = std::min(evictions.size(), (size_t)MAX_RESIDENCY_CHANGES_PER_FRAME);
+            for (size_t i = 0; i < numEvictions; ++i) {
+                // WARNING, replacing the gpu object deletes the previous one
+                new GLTextureType(backend.shared_from_this(), *evictions[i].texture, evictions[i].object, evictions[i].minMip);
+                _textureTransferHelper->transferTexture(evictions[i].texture);
+            }
+        } else {
+            std::sort(promotions.begin(), promotions.end(), byPriority);
+            size_t numPromotions = std::min(promotions.size(), (size_t)MAX_RESIDENCY_CHANGES_PER_FRAME);
+            for (size_t i = 0; i < numPromotions; ++i) {
+                const auto& promotion = promotions[i];
+                consumedMemory += promotion.texture->evalMipSize(promotion.minMip);
+                if (consumedMemory > allowedMemory) {
+                    break;
+                }
+                new GLTextureType(backend.shared_from_this(), *promotion.texture, promotion.object, promotion.minMip);
+                _textureTransferHelper->transferTexture(promotion.texture);
+            }
+        }
+    }
+
     template <typename GLTextureType> 
     static GLuint getId(GLBackend& backend, const TexturePointer& texture, bool shouldSync) {
         if (!texture) {
@@ -130,7 +215,11 @@ public:
     const GLuint _virtualSize; // theoretical size as expected
     Stamp _contentStamp { 0 };
     const bool _transferrable;
+    // Has every mip in sysmem, so the mips can be left out of gpu memory and streamed in later
+    const bool _streamable;
     Size _transferCount { 0 };
+    uint16 _requestedMinMip;
+    uint32 _lastRequestFrame;
 
     struct DownsampleSource {
         using Pointer = std::shared_ptr<DownsampleSource>;
@@ -171,6 +260,11 @@ protected:
     static const std::vector<GLenum>& getFaceTargets(GLenum textureType);
 
     static GLenum getGLTextureType(const Texture& texture);
+    static bool isStreamable(const Texture& texture, bool transferrable);
+    // The mip a streamable texture starts out from, and returns to once it goes unused
+    static uint16 evalStreamingStartMip(const Texture& texture);
+    // Return the texture memory the textures are allowed to consume
+    static Size getAllowedMemory();
     // Return a floating point value indicating how much of the allowed 
     // texture memory we are currently consuming.  A value of 0 indicates 
     // no texture memory usage, while a value of 1 indicates all available / allowed memory
@@ -178,14 +272,34 @@ protected:
     static float getMemoryPressure();
 
 
+    static const uint16 STREAMING_START_DIMENSION { 128 };
+    static const uint32 MAX_UNUSED_FRAMES { 300 };
+    static const size_t MAX_RESIDENCY_CHANGES_PER_FRAME { 8 };
+    static const GLuint MAX_TRANSFER_BAND_SIZE { 1024 * 1024 };
+
+    static std::unordered_map<const Texture*, std::weak_ptr<Texture>> _streamableTextures;
+    static uint32 _residencyFrame;
+
     const GLuint _size { 0 }; // true size as reported by the gl api
     std::atomic<GLSyncState> _syncState { GLSyncState::Idle };
 
     GLTexture(const std::weak_ptr<gl::GLBackend>& backend, const Texture& texture, GLuint id, bool transferrable);
     GLTexture(const std::weak_ptr<gl::GLBackend>& backend, const Texture& texture, GLuint id, GLTexture* originalTexture);
+    // Create the texture with the mips from minMip, copying the ones it shares with the original
+    GLTexture(const std::weak_ptr<gl::GLBackend>& backend, const Texture& texture, GLuint id, GLTexture* originalTexture, uint16 minMip);
 
     void setSyncState(GLSyncState syncState) { _syncState = syncState; }
     uint16 usedMipLevels() const { return (_maxMip - _minMip) + 1; }
+    GLuint evalResidentSize() const;
+    // The mips from this one down are copied from the texture this one replaces, the others come from sysmem
+    uint16 evalCopiedMinMip() const;
+    // The bytes the transfer uploads from sysmem
+    GLuint evalTransferSize() const;
+
+    using MipRowsUpload = std::function<void(GLint yOffset, GLsizei numRows, const GLvoid* pixels)>;
+    // Uploads a stored mip face through the transfer helper's pixel unpack buffer, a band of rows at a time,
+    // upload is called for each band with the unpack buffer bound
+    void transferMipRows(uint16_t mipLevel, uint8_t face, const MipRowsUpload& upload) const;
 
     void createTexture();
     
@@ -201,7 +315,7 @@ protected:
 
 private:
 
-    GLTexture(const std::weak_ptr<GLBackend>& backend, const gpu::Texture& gpuTexture, GLuint id, GLTexture* originalTexture, bool transferrable);
+    GLTexture(const std::weak_ptr<GLBackend>& backend, const gpu::Texture& gpuTexture, GLuint id, GLTexture* originalTexture, bool transferrable, uint16 minMip);
 
     friend class GLTextureTransferHelper;
     friend class GLBackend;
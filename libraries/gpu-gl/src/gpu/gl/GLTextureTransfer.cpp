@@ -37,27 +37,46 @@ GLTextureTransferHelper::~GLTextureTransferHelper() {
 void GLTextureTransferHelper::transferTexture(const gpu::TexturePointer& texturePointer) {
     GLTexture* object = Backend::getGPUObject<GLTexture>(*texturePointer);
     Backend::incrementTextureGPUTransferCount();
-#ifdef THREADED_TEXTURE_TRANSFER
     GLsync fence { 0 };
-    //fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-    //glFlush();
-
     TextureTransferPackage package { texturePointer, fence };
     object->setSyncState(GLSyncState::Pending);
+#ifdef THREADED_TEXTURE_TRANSFER
     queueItem(package);
 #else
-    object->withPreservedTexture([&] {
-        do_transfer(*object);
-    });
-    object->_contentStamp = texturePointer->getDataStamp();
-    object->setSyncState(GLSyncState::Transferred);
+    _pendingTransfers.push_back(package);
+#endif
+}
+
+void GLTextureTransferHelper::beginFrame() {
+    ++_frame;
+#ifndef THREADED_TEXTURE_TRANSFER
+    processTransfers();
 #endif
 }
 
+GLuint GLTextureTransferHelper::getStagingBuffer() {
+    if (!_stagingBuffer) {
+        glGenBuffers(1, &_stagingBuffer);
+    }
+    return _stagingBuffer;
+}
+
 void GLTextureTransferHelper::setup() {
 }
 
 void GLTextureTransferHelper::shutdown() {
+#ifdef THREADED_TEXTURE_TRANSFER
+    _context.makeCurrent();
+    for (auto& transfer : _fencedTransfers) {
+        glDeleteSync(transfer.fence);
+    }
+    _fencedTransfers.clear();
+    if (_stagingBuffer) {
+        glDeleteBuffers(1, &_stagingBuffer);
+        _stagingBuffer = 0;
+    }
+    _context.doneCurrent();
+#endif
 }
 
 void GLTextureTransferHelper::do_transfer(GLTexture& texture) {
@@ -67,51 +86,110 @@ void GLTextureTransferHelper::do_transfer(GLTexture& texture) {
     Backend::decrementTextureGPUTransferCount();
 }
 
+bool GLTextureTransferHelper::process() {
+#ifdef THREADED_TEXTURE_TRANSFER
+    // Sleep until there are textures queued, unless transfers are still waiting for budget or fences,
+    // those are checked again after a short wait
+    bool isBusy = !_pendingTransfers.empty() || !_fencedTransfers.empty();
+    lock();
+    bool hasItems = !_items.empty();
+    unlock();
+    if (!hasItems) {
+        static const uint32_t BUSY_WAIT_MSECS = 1;
+        _hasItemsMutex.lock();
+        _hasItems.wait(&_hasItemsMutex, isBusy ? BUSY_WAIT_MSECS : getMaxWait());
+        _hasItemsMutex.unlock();
+    }
+
+    Queue items;
+    lock();
+    items.swap(_items);
+    unlock();
+    processQueueItems(items);
+#endif
+    return isStillRunning();
+}
+
 bool GLTextureTransferHelper::processQueueItems(const Queue& messages) {
+    for (auto package : messages) {
+        _pendingTransfers.push_back(package);
+    }
+    if (_pendingTransfers.empty() && _fencedTransfers.empty()) {
+        return true;
+    }
+
 #ifdef THREADED_TEXTURE_TRANSFER
     _context.makeCurrent();
 #endif
-    for (auto package : messages) {
-        TexturePointer texturePointer = package.texture.lock();
+    processFences();
+    processTransfers();
+#ifdef THREADED_TEXTURE_TRANSFER
+    _context.doneCurrent();
+#endif
+    return true;
+}
+
+void GLTextureTransferHelper::processTransfers() {
+    uint32_t frame = _frame.load();
+    if (frame != _budgetFrame) {
+        _budgetFrame = frame;
+        _transferredThisFrame = 0;
+    }
+
+    const Size budget = Texture::getAllowedGPUTransferPerFrame();
+    while (!_pendingTransfers.empty()) {
+        TexturePointer texturePointer = _pendingTransfers.front().texture.lock();
+        GLTexture* object = texturePointer ? Backend::getGPUObject<GLTexture>(*texturePointer) : nullptr;
         // Texture no longer exists, move on to the next
-        if (!texturePointer) {
+        if (!object) {
+            _pendingTransfers.pop_front();
+            Backend::decrementTextureGPUTransferCount();
             continue;
         }
 
-        if (package.fence) {
-            auto result = glClientWaitSync(package.fence, 0, 0);
-            while (GL_TIMEOUT_EXPIRED == result || GL_WAIT_FAILED == result) {
-                // Minimum sleep
-                QThread::usleep(1);
-                result = glClientWaitSync(package.fence, 0, 0);
-            }
-            assert(GL_CONDITION_SATISFIED == result || GL_ALREADY_SIGNALED == result);
-            glDeleteSync(package.fence);
-            package.fence = 0;
+        // A texture larger than the whole budget goes on its own, first thing in a frame
+        Size size = object->evalTransferSize();
+        if (_transferredThisFrame > 0 && _transferredThisFrame + size > budget) {
+            break;
         }
+        _pendingTransfers.pop_front();
+        _transferredThisFrame += size;
 
-        GLTexture* object = Backend::getGPUObject<GLTexture>(*texturePointer);
-
+#ifdef THREADED_TEXTURE_TRANSFER
         do_transfer(*object);
         glBindTexture(object->_target, 0);
 
-        {
-            auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-            assert(fence);
-            auto result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
-            while (GL_TIMEOUT_EXPIRED == result || GL_WAIT_FAILED == result) {
-                // Minimum sleep
-                QThread::usleep(1);
-                result = glClientWaitSync(fence, 0, 0);
-            }
-            glDeleteSync(fence);
-        }
-
+        auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        assert(fence);
+        glFlush();
+        _fencedTransfers.push_back({ texturePointer, object, texturePointer->getDataStamp(), fence });
+#else
+        object->withPreservedTexture([&] {
+            do_transfer(*object);
+        });
+        // The render thread did the transfer, the commands it issues next see it without a fence
         object->_contentStamp = texturePointer->getDataStamp();
         object->setSyncState(GLSyncState::Transferred);
-    }
-#ifdef THREADED_TEXTURE_TRANSFER
-    _context.doneCurrent();
 #endif
-    return true;
+    }
+}
+
+void GLTextureTransferHelper::processFences() {
+    for (auto it = _fencedTransfers.begin(); it != _fencedTransfers.end();) {
+        auto result = glClientWaitSync(it->fence, 0, 0);
+        if (GL_TIMEOUT_EXPIRED == result) {
+            ++it;
+            continue;
+        }
+        glDeleteSync(it->fence);
+
+        // The gpu object may have been replaced while its transfer was in flight
+        TexturePointer texturePointer = it->texture.lock();
+        GLTexture* object = texturePointer ? Backend::getGPUObject<GLTexture>(*texturePointer) : nullptr;
+        if (object && object == it->object) {
+            object->_contentStamp = it->dataStamp;
+            object->setSyncState(GLSyncState::Transferred);
+        }
+        it = _fencedTransfers.erase(it);
+    }
 }
@@ -8,6 +8,9 @@
 #ifndef hifi_gpu_gl_GLTextureTransfer_h
 #define hifi_gpu_gl_GLTextureTransfer_h
 
+#include <atomic>
+#include <list>
+
 #include <QtGlobal>
 #include <QtCore/QSharedPointer>
 
@@ -28,6 +31,10 @@ struct TextureTransferPackage {
     GLsync fence;
 };
 
+// Transfers the textures queued to it a frame's upload budget at a time, on its own thread and shared context
+// where there is one, or on the render thread once a frame otherwise.
+// Mips are uploaded in bands of rows through a pixel unpack buffer, and on the transfer thread
+// the textures are handed back as their fences signal rather than waiting for each one in turn.
 class GLTextureTransferHelper : public GenericQueueThread<TextureTransferPackage> {
 public:
     using Pointer = std::shared_ptr<GLTextureTransferHelper>;
@@ -36,14 +43,39 @@ public:
     void transferTexture(const gpu::TexturePointer& texturePointer);
     void postTransfer(const gpu::TexturePointer& texturePointer);
 
+    // Called by the backend once a frame on the render thread, starts the next frame's upload budget
+    void beginFrame();
+
+    // The buffer mip bands are staged in, only valid on the context doing the transfers
+    GLuint getStagingBuffer();
+
 protected:
     void setup() override;
     void shutdown() override;
+    bool process() override;
     bool processQueueItems(const Queue& messages) override;
     void do_transfer(GLTexture& texturePointer);
 
 private:
+    struct FencedTransfer {
+        std::weak_ptr<Texture> texture;
+        const GLTexture* object;
+        Stamp dataStamp;
+        GLsync fence;
+    };
+
+    void processTransfers();
+    void processFences();
+
     ::gl::OffscreenContext _context;
+
+    std::list<TextureTransferPackage> _pendingTransfers; // waiting for upload budget
+    std::list<FencedTransfer> _fencedTransfers; // uploaded, waiting for the gpu to complete them
+    GLuint _stagingBuffer { 0 };
+
+    std::atomic<uint32_t> _frame { 0 };
+    uint32_t _budgetFrame { 0 };
+    Size _transferredThisFrame { 0 };
 };
 
 } }
@@ -44,6 +44,7 @@ public:
     public:
         GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture& buffer, bool transferrable);
         GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture& buffer, GL41Texture* original);
+        GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture& buffer, GL41Texture* original, uint16 minMip);
 
     protected:
         void transferMip(uint16_t mipLevel, uint8_t face = 0) const;
@@ -57,6 +58,8 @@ public:
 
 
 protected:
+    void recycle() const override;
+
     GLuint getFramebufferID(const FramebufferPointer& framebuffer) override;
     GLFramebuffer* syncGPUObject(const Framebuffer& framebuffer) override;
 
@@ -38,10 +38,20 @@ GLTexture* GL41Backend::syncGPUObject(const TexturePointer& texture, bool transf
     return GL41Texture::sync<GL41Texture>(*this, texture, transfer);
 }
 
+void GL41Backend::recycle() const {
+    Parent::recycle();
+    // Recycling happens once a frame, which is when the streamed texture mips are updated
+    // and the next frame of texture transfers can start
+    GL41Texture::updateResidency<GL41Texture>(const_cast<GL41Backend&>(*this));
+    GL41Texture::_textureTransferHelper->beginFrame();
+}
+
 GL41Texture::GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, bool transferrable) : GLTexture(backend, texture, allocate(), transferrable) {}
 
 GL41Texture::GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, GL41Texture* original) : GLTexture(backend, texture, allocate(), original) {}
 
+GL41Texture::GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, GL41Texture* original, uint16 minMip) : GLTexture(backend, texture, allocate(), original, minMip) {}
+
 void GL41Backend::GL41Texture::withPreservedTexture(std::function<void()> f) const  {
     GLint boundTex = -1;
     switch (_target) {
@@ -95,7 +105,7 @@ void GL41Backend::GL41Texture::allocateStorage() const {
 }
 
 void GL41Backend::GL41Texture::updateSize() const {
-    setSize(_virtualSize);
+    setSize(evalResidentSize());
     if (!_id) {
         return;
     }
@@ -136,7 +146,11 @@ void GL41Backend::GL41Texture::transferMip(uint16_t mipLevel, uint8_t face) cons
     //GLenum target = getFaceTargets()[face];
     GLenum target = _target == GL_TEXTURE_2D ? GL_TEXTURE_2D : CUBE_FACE_LAYOUT[face];
     auto size = _gpuObject.evalMipDimensions(mipLevel);
-    glTexSubImage2D(target, mipLevel, 0, 0, size.x, size.y, texelFormat.format, texelFormat.type, mip->readData());
+    // the gl texture starts from our min mip
+    GLint level = mipLevel - _minMip;
+    transferMipRows(mipLevel, face, [&](GLint yOffset, GLsizei numRows, const GLvoid* pixels) {
+        glTexSubImage2D(target, level, 0, yOffset, size.x, numRows, texelFormat.format, texelFormat.type, pixels);
+    });
     (void)CHECK_GL_ERROR();
 }
 
@@ -153,17 +167,18 @@ void GL41Backend::GL41Texture::transfer() const {
     glBindTexture(_target, _id);
     (void)CHECK_GL_ERROR();
 
+    // The mips the previous gl texture of a downsampled or streamed texture has are copied from it,
+    // the ones it doesn't are transferred from sysmem
+    uint16 copiedMinMip = evalCopiedMinMip();
     if (_downsampleSource._texture) {
         GLuint fbo { 0 };
         glGenFramebuffers(1, &fbo);
         (void)CHECK_GL_ERROR();
         glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
         (void)CHECK_GL_ERROR();
-        // Find the distance between the old min mip and the new one
-        uint16 mipOffset = _minMip - _downsampleSource._minMip;
-        for (uint16 i = _minMip; i <= _maxMip; ++i) {
+        for (uint16 i = copiedMinMip; i <= _maxMip; ++i) {
             uint16 targetMip = i - _minMip;
-            uint16 sourceMip = targetMip + mipOffset;
+            uint16 sourceMip = i - _downsampleSource._minMip;
             Vec3u dimensions = _gpuObject.evalMipDimensions(i);
             for (GLenum target : getFaceTargets(_target)) {
                 glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, _downsampleSource._texture, sourceMip);
@@ -174,12 +189,14 @@ void GL41Backend::GL41Texture::transfer() const {
         }
         glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
         glDeleteFramebuffers(1, &fbo);
-    } else {
+    }
+
+    if (copiedMinMip > _minMip) {
         // GO through the process of allocating the correct storage and/or update the content
         switch (_gpuObject.getType()) {
         case Texture::TEX_2D: 
             {
-                for (uint16_t i = _minMip; i <= _maxMip; ++i) {
+                for (uint16_t i = _minMip; i < copiedMinMip; ++i) {
                     if (_gpuObject.isStoredMipFaceAvailable(i)) {
                         transferMip(i);
                     }
@@ -190,7 +207,7 @@ void GL41Backend::GL41Texture::transfer() const {
         case Texture::TEX_CUBE:
             // transfer pixels from each faces
             for (uint8_t f = 0; f < CUBE_NUM_FACES; f++) {
-                for (uint16_t i = 0; i < Sampler::MAX_MIP_LEVEL; ++i) {
+                for (uint16_t i = _minMip; i < copiedMinMip; ++i) {
                     if (_gpuObject.isStoredMipFaceAvailable(i, f)) {
                         transferMip(i, f);
                     }
@@ -19,16 +19,23 @@ using namespace gpu;
 using namespace gpu::gl45;
 
 void GL45Backend::do_draw(const Batch& batch, size_t paramOffset) {
+    updateTextureTable();
+
     Primitive primitiveType = (Primitive)batch._params[paramOffset + 2]._uint;
     GLenum mode = gl::PRIMITIVE_TO_GL[primitiveType];
     uint32 numVertices = batch._params[paramOffset + 1]._uint;
     uint32 startVertex = batch._params[paramOffset + 0]._uint;
 
     if (isStereo()) {
-        setupStereoSide(0);
-        glDrawArrays(mode, startVertex, numVertices);
-        setupStereoSide(1);
-        glDrawArrays(mode, startVertex, numVertices);
+        if (isInstancedStereo()) {
+            setupInstancedStereo();
+            glDrawArraysInstanced(mode, startVertex, numVertices, 2);
+        } else {
+            setupStereoSide(0);
+            glDrawArrays(mode, startVertex, numVertices);
+            setupStereoSide(1);
+            glDrawArrays(mode, startVertex, numVertices);
+        }
 
         _stats._DSNumTriangles += 2 * numVertices / 3;
         _stats._DSNumDrawcalls += 2;
@@ -44,6 +51,8 @@ void GL45Backend::do_draw(const Batch& batch, size_t paramOffset) {
 }
 
 void GL45Backend::do_drawIndexed(const Batch& batch, size_t paramOffset) {
+    updateTextureTable();
+
     Primitive primitiveType = (Primitive)batch._params[paramOffset + 2]._uint;
     GLenum mode = gl::PRIMITIVE_TO_GL[primitiveType];
     uint32 numIndices = batch._params[paramOffset + 1]._uint;
@@ -55,10 +64,15 @@ void GL45Backend::do_drawIndexed(const Batch& batch, size_t paramOffset) {
     GLvoid* indexBufferByteOffset = reinterpret_cast<GLvoid*>(startIndex * typeByteSize + _input._indexBufferOffset);
 
     if (isStereo()) {
-        setupStereoSide(0);
-        glDrawElements(mode, numIndices, glType, indexBufferByteOffset);
-        setupStereoSide(1);
-        glDrawElements(mode, numIndices, glType, indexBufferByteOffset);
+        if (isInstancedStereo()) {
+            setupInstancedStereo();
+            glDrawElementsInstanced(mode, numIndices, glType, indexBufferByteOffset, 2);
+        } else {
+            setupStereoSide(0);
+            glDrawElements(mode, numIndices, glType, indexBufferByteOffset);
+            setupStereoSide(1);
+            glDrawElements(mode, numIndices, glType, indexBufferByteOffset);
+        }
 
         _stats._DSNumTriangles += 2 * numIndices / 3;
         _stats._DSNumDrawcalls += 2;
@@ -73,6 +87,8 @@ void GL45Backend::do_drawIndexed(const Batch& batch, size_t paramOffset) {
 }
 
 void GL45Backend::do_drawInstanced(const Batch& batch, size_t paramOffset) {
+    updateTextureTable();
+
     GLint numInstances = batch._params[paramOffset + 4]._uint;
     Primitive primitiveType = (Primitive)batch._params[paramOffset + 3]._uint;
     GLenum mode = gl::PRIMITIVE_TO_GL[primitiveType];
@@ -83,10 +99,15 @@ void GL45Backend::do_drawInstanced(const Batch& batch, size_t paramOffset) {
     if (isStereo()) {
         GLint trueNumInstances = 2 * numInstances;
 
-        setupStereoSide(0);
-        glDrawArraysInstanced(mode, startVertex, numVertices, numInstances);
-        setupStereoSide(1);
-        glDrawArraysInstanced(mode, startVertex, numVertices, numInstances);
+        if (isInstancedStereo()) {
+            setupInstancedStereo();
+            glDrawArraysInstanced(mode, startVertex, numVertices, trueNumInstances);
+        } else {
+            setupStereoSide(0);
+            glDrawArraysInstanced(mode, startVertex, numVertices, numInstances);
+            setupStereoSide(1);
+            glDrawArraysInstanced(mode, startVertex, numVertices, numInstances);
+        }
 
         _stats._DSNumTriangles += (trueNumInstances * numVertices) / 3;
         _stats._DSNumDrawcalls += trueNumInstances;
@@ -101,6 +122,8 @@ void GL45Backend::do_drawInstanced(const Batch& batch, size_t paramOffset) {
 }
 
 void GL45Backend::do_drawIndexedInstanced(const Batch& batch, size_t paramOffset) {
+    updateTextureTable();
+
     GLint numInstances = batch._params[paramOffset + 4]._uint;
     GLenum mode = gl::PRIMITIVE_TO_GL[(Primitive)batch._params[paramOffset + 3]._uint];
     uint32 numIndices = batch._params[paramOffset + 2]._uint;
@@ -112,10 +135,16 @@ void GL45Backend::do_drawIndexedInstanced(const Batch& batch, size_t paramOffset
  
     if (isStereo()) {
         GLint trueNumInstances = 2 * numInstances;
-        setupStereoSide(0);
-        glDrawElementsInstancedBaseVertexBaseInstance(mode, numIndices, glType, indexBufferByteOffset, numInstances, 0, startInstance);
-        setupStereoSide(1);
-        glDrawElementsInstancedBaseVertexBaseInstance(mode, numIndices, glType, indexBufferByteOffset, numInstances, 0, startInstance);
+        if (isInstancedStereo()) {
+            // the base instance is added after the divisor, the instances of both eyes fetch the same attributes
+            setupInstancedStereo();
+            glDrawElementsInstancedBaseVertexBaseInstance(mode, numIndices, glType, indexBufferByteOffset, trueNumInstances, 0, startInstance);
+        } else {
+            setupStereoSide(0);
+            glDrawElementsInstancedBaseVertexBaseInstance(mode, numIndices, glType, indexBufferByteOffset, numInstances, 0, startInstance);
+            setupStereoSide(1);
+            glDrawElementsInstancedBaseVertexBaseInstance(mode, numIndices, glType, indexBufferByteOffset, numInstances, 0, startInstance);
+        }
         _stats._DSNumTriangles += (trueNumInstances * numIndices) / 3;
         _stats._DSNumDrawcalls += trueNumInstances;
     } else {
@@ -130,6 +159,8 @@ void GL45Backend::do_drawIndexedInstanced(const Batch& batch, size_t paramOffset
 }
 
 void GL45Backend::do_multiDrawIndirect(const Batch& batch, size_t paramOffset) {
+    updateTextureTable();
+
     uint commandCount = batch._params[paramOffset + 0]._uint;
     GLenum mode = gl::PRIMITIVE_TO_GL[(Primitive)batch._params[paramOffset + 1]._uint];
     glMultiDrawArraysIndirect(mode, reinterpret_cast<GLvoid*>(_input._indirectBufferOffset), commandCount, (GLsizei)_input._indirectBufferStride);
@@ -139,6 +170,8 @@ void GL45Backend::do_multiDrawIndirect(const Batch& batch, size_t paramOffset) {
 }
 
 void GL45Backend::do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOffset) {
+    updateTextureTable();
+
     uint commandCount = batch._params[paramOffset + 0]._uint;
     GLenum mode = gl::PRIMITIVE_TO_GL[(Primitive)batch._params[paramOffset + 1]._uint];
     GLenum indexType = gl::ELEMENT_TYPE_TO_GL[_input._indexBufferType];
@@ -147,3 +180,74 @@ void GL45Backend::do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOf
     _stats._DSNumAPIDrawcalls++;
     (void)CHECK_GL_ERROR();
 }
+
+void GL45Backend::do_drawIndexedRun(const Batch& batch, size_t lastCommandIndex, size_t numDraws) {
+    updateTextureTable();
+
+    const auto& commands = batch.getCommands();
+    const auto& offsets = batch.getCommandOffsets();
+    GLenum mode = gl::PRIMITIVE_TO_GL[(Primitive)batch._params[offsets[_commandIndex] + 2]._uint];
+    GLenum glType = gl::ELEMENT_TYPE_TO_GL[_input._indexBufferType];
+    auto typeByteSize = TYPE_SIZE[_input._indexBufferType];
+    uint32 indexBufferFirstIndex = (uint32)(_input._indexBufferOffset / typeByteSize);
+
+    // One command per draw, its base instance points the per instance draw call info at the draw's own transform
+    _drawRunCommands.clear();
+    _drawRunCommands.reserve(numDraws);
+    uint32 numIndices = 0;
+    for (size_t i = _commandIndex; i <= lastCommandIndex; ++i) {
+        if (commands[i] != Batch::COMMAND_drawIndexed) {
+            continue;
+        }
+        Batch::DrawIndexedIndirectCommand drawCommand;
+        drawCommand._count = batch._params[offsets[i] + 1]._uint;
+        drawCommand._instanceCount = isInstancedStereo() ? 2 : 1;
+        drawCommand._firstIndex = indexBufferFirstIndex + batch._params[offsets[i] + 0]._uint;
+        drawCommand._baseInstance = (uint)(_currentDraw + _drawRunCommands.size());
+        _drawRunCommands.push_back(drawCommand);
+        numIndices += drawCommand._count;
+    }
+
+    GLsizeiptr commandsSize = _drawRunCommands.size() * sizeof(Batch::DrawIndexedIndirectCommand);
+    GLintptr commandsOffset = _streamRing.allocate(commandsSize, sizeof(uint));
+    if (commandsOffset >= 0) {
+        memcpy(_streamRing.getPointer(commandsOffset), _drawRunCommands.data(), commandsSize);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _streamRing.getBuffer());
+    } else {
+        glNamedBufferData(_transform._drawRunBuffer, commandsSize, _drawRunCommands.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _transform._drawRunBuffer);
+        commandsOffset = 0;
+    }
+    const GLvoid* commands = reinterpret_cast<const GLvoid*>(commandsOffset);
+
+    glEnableVertexAttribArray(gpu::Stream::DRAW_CALL_INFO);
+    glBindBuffer(GL_ARRAY_BUFFER, _transform._currentDrawCallInfoBuffer);
+    glVertexAttribIPointer(gpu::Stream::DRAW_CALL_INFO, 2, GL_UNSIGNED_SHORT, 0, _transform._drawCallInfoOffsets[std::string()]);
+    glVertexAttribDivisor(gpu::Stream::DRAW_CALL_INFO, _input._divisorScale);
+
+    GLsizei drawCount = (GLsizei)_drawRunCommands.size();
+    if (isStereo()) {
+        if (isInstancedStereo()) {
+            setupInstancedStereo();
+            glMultiDrawElementsIndirect(mode, glType, commands, drawCount, 0);
+        } else {
+            setupStereoSide(0);
+            glMultiDrawElementsIndirect(mode, glType, commands, drawCount, 0);
+            setupStereoSide(1);
+            glMultiDrawElementsIndirect(mode, glType, commands, drawCount, 0);
+        }
+
+        _stats._DSNumTriangles += 2 * numIndices / 3;
+        _stats._DSNumDrawcalls += 2 * drawCount;
+    } else {
+        glMultiDrawElementsIndirect(mode, glType, commands, drawCount, 0);
+        _stats._DSNumTriangles += numIndices / 3;
+        _stats._DSNumDrawcalls += drawCount;
+    }
+    _stats._DSNumAPIDrawcalls++;
+
+    // Put back the indirect buffer set by the batch
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _input._indirectBuffer ? getBufferID(*_input._indirectBuffer) : 0);
+
+    (void)CHECK_GL_ERROR();
+}
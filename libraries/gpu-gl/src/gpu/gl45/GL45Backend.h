@@ -11,6 +11,10 @@
 #ifndef hifi_gpu_45_GL45Backend_h
 #define hifi_gpu_45_GL45Backend_h
 
+#include <deque>
+
+#include <gpu/TextureTable.h>
+
 #include "../gl/GLBackend.h"
 #include "../gl/GLTexture.h"
 
@@ -26,6 +30,45 @@ class GL45Backend : public GLBackend {
 public:
     explicit GL45Backend(bool syncCache) : Parent(syncCache) {}
     GL45Backend() : Parent() {}
+    ~GL45Backend();
+
+    bool supportsBindlessTextures() const override;
+
+    // A persistently mapped, coherent buffer the per batch transform data is written into directly.
+    // Space is handed out in ring order and reused once the fence covering its last use has signaled.
+    class StreamRing {
+    public:
+        ~StreamRing();
+
+        void init(GLsizeiptr size);
+        bool isValid() const { return _mappedData != nullptr; }
+        GLuint getBuffer() const { return _buffer; }
+
+        // Returns the offset of size bytes aligned to alignment, waiting on the GPU if they are still in use,
+        // or -1 if they don't fit beside what was allocated since the last fence
+        GLintptr allocate(GLsizeiptr size, GLsizeiptr alignment);
+        void* getPointer(GLintptr offset) const { return _mappedData + offset; }
+
+        // Fences what was allocated so far, once the commands reading it have been issued
+        void fence();
+
+    private:
+        struct Segment {
+            GLsync fence;
+            GLintptr begin;
+            GLintptr end;
+        };
+
+        // end is before begin for a segment that wraps around the end of the ring
+        bool overlaps(GLintptr begin, GLintptr end, GLintptr offset, GLsizeiptr size) const;
+
+        GLuint _buffer { 0 };
+        uint8_t* _mappedData { nullptr };
+        GLsizeiptr _size { 0 };
+        GLintptr _head { 0 };
+        GLintptr _openBegin { 0 }; // where the allocations since the last fence begin
+        std::deque<Segment> _segments; // fenced and maybe still in use, oldest first
+    };
 
     class GL45Texture : public GLTexture {
         using Parent = GLTexture;
@@ -33,8 +76,15 @@ public:
     public:
         GL45Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, bool transferrable);
         GL45Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, GLTexture* original);
+        GL45Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, GLTexture* original, uint16 minMip);
+
+        // The bindless handle of the texture, made resident the first time it is asked for once the texture is ready,
+        // or 0 until then. The sampler of the texture is frozen as it is when the handle is made.
+        GLuint64 getHandle() const;
 
     protected:
+        mutable GLuint64 _handle { 0 };
+
         void transferMip(uint16_t mipLevel, uint8_t face = 0) const;
         void allocateStorage() const override;
         void updateSize() const override;
@@ -46,6 +96,8 @@ public:
 
 
 protected:
+    void recycle() const override;
+
     GLuint getFramebufferID(const FramebufferPointer& framebuffer) override;
     GLFramebuffer* syncGPUObject(const Framebuffer& framebuffer) override;
 
@@ -66,6 +118,26 @@ protected:
     void do_multiDrawIndirect(const Batch& batch, size_t paramOffset) override;
     void do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOffset) override;
 
+    bool supportsIndexedDrawRuns() const override { return true; }
+    bool supportsInstancedStereo() const override { return true; }
+    void do_drawIndexedRun(const Batch& batch, size_t lastCommandIndex, size_t numDraws) override;
+    std::vector<Batch::DrawIndexedIndirectCommand> _drawRunCommands;
+
+    // Before each draw, passes the handles of the textures of the slots of a TextureTable to the shaders
+    // when they changed since the previous draw
+    void updateTextureTable();
+    GLuint64 getFallbackTextureHandle();
+    using TextureTableHandles = std::array<GLuint64, TextureTable::COUNT>;
+    TextureTableHandles _textureTableHandles;
+    bool _textureTableValid { false };
+    GLuint _textureTableBuffer { 0 };
+    // a texture for the slots with no texture ready, a handle the shaders can always sample
+    GLuint _fallbackTexture { 0 };
+    GLuint64 _fallbackTextureHandle { 0 };
+
+    mutable StreamRing _streamRing;
+    GLsizeiptr _streamAlignment { 0 }; // for binding ranges of the ring as uniform, storage or texture buffers
+
     // Input Stage
     void updateInput() override;
 
@@ -0,0 +1,96 @@
+//
+//  GL45BackendStream.cpp
+//  libraries/gpu-gl/src/gpu/gl45
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "GL45Backend.h"
+
+using namespace gpu;
+using namespace gpu::gl45;
+
+static const GLuint64 FENCE_WAIT_TIMEOUT_NSECS = 1000000000;
+
+GL45Backend::StreamRing::~StreamRing() {
+    for (auto& segment : _segments) {
+        glDeleteSync(segment.fence);
+    }
+    if (_buffer) {
+        if (_mappedData) {
+            glUnmapNamedBuffer(_buffer);
+        }
+        glDeleteBuffers(1, &_buffer);
+    }
+}
+
+void GL45Backend::StreamRing::init(GLsizeiptr size) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glCreateBuffers(1, &_buffer);
+    glNamedBufferStorage(_buffer, size, nullptr, flags);
+    _mappedData = reinterpret_cast<uint8_t*>(glMapNamedBufferRange(_buffer, 0, size, flags));
+    _size = _mappedData ? size : 0;
+    (void)CHECK_GL_ERROR();
+}
+
+bool GL45Backend::StreamRing::overlaps(GLintptr begin, GLintptr end, GLintptr offset, GLsizeiptr size) const {
+    if (begin <= end) {
+        return offset < end && offset + size > begin;
+    }
+    return offset + size > begin || offset < end;
+}
+
+GLintptr GL45Backend::StreamRing::allocate(GLsizeiptr size, GLsizeiptr alignment) {
+    if (!isValid() || size <= 0 || size > _size) {
+        return -1;
+    }
+
+    GLintptr offset = ((_head + alignment - 1) / alignment) * alignment;
+    if (offset + size > _size) {
+        offset = 0;
+    }
+
+    // What was allocated since the last fence is still being written, it can't be waited on
+    if (_openBegin != _head && overlaps(_openBegin, _head, offset, size)) {
+        return -1;
+    }
+
+    // Segments come free in the order they were fenced, wait for the oldest until none of them is in the way
+    while (!_segments.empty()) {
+        bool inUse = false;
+        for (const auto& segment : _segments) {
+            if (overlaps(segment.begin, segment.end, offset, size)) {
+                inUse = true;
+                break;
+            }
+        }
+        if (!inUse) {
+            break;
+        }
+
+        auto& oldest = _segments.front();
+        GLenum result;
+        do {
+            result = glClientWaitSync(oldest.fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_TIMEOUT_NSECS);
+        } while (result == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(oldest.fence);
+        _segments.pop_front();
+    }
+
+    if (_openBegin == _head) {
+        _openBegin = offset;
+    }
+    _head = offset + size;
+    return offset;
+}
+
+void GL45Backend::StreamRing::fence() {
+    if (_openBegin == _head) {
+        return;
+    }
+    _segments.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), _openBegin, _head });
+    _openBegin = _head;
+}
@@ -10,6 +10,7 @@
 //
 #include "GL45Backend.h"
 
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -38,12 +39,32 @@ GLTexture* GL45Backend::syncGPUObject(const TexturePointer& texture, bool transf
     return GL45Texture::sync<GL45Texture>(*this, texture, transfer);
 }
 
+void GL45Backend::recycle() const {
+    Parent::recycle();
+    // Recycling happens once a frame, which is when the streamed texture mips are updated
+    // and the next frame of texture transfers can start
+    GL45Texture::updateResidency<GL45Texture>(const_cast<GL45Backend&>(*this));
+    GL45Texture::_textureTransferHelper->beginFrame();
+}
+
 GL45Backend::GL45Texture::GL45Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, bool transferrable)
     : GLTexture(backend, texture, allocate(texture), transferrable) {}
 
 GL45Backend::GL45Texture::GL45Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, GLTexture* original)
     : GLTexture(backend, texture, allocate(texture), original) {}
 
+GL45Backend::GL45Texture::GL45Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture, GLTexture* original, uint16 minMip)
+    : GLTexture(backend, texture, allocate(texture), original, minMip) {}
+
+GLuint64 GL45Backend::GL45Texture::getHandle() const {
+    if (!_handle && isReady()) {
+        _handle = glGetTextureHandleARB(_id);
+        glMakeTextureHandleResidentARB(_handle);
+        (void)CHECK_GL_ERROR();
+    }
+    return _handle;
+}
+
 void GL45Backend::GL45Texture::withPreservedTexture(std::function<void()> f) const {
     f();
 }
@@ -67,7 +88,7 @@ void GL45Backend::GL45Texture::allocateStorage() const {
 }
 
 void GL45Backend::GL45Texture::updateSize() const {
-    setSize(_virtualSize);
+    setSize(evalResidentSize());
     if (!_id) {
         return;
     }
@@ -82,13 +103,19 @@ void GL45Backend::GL45Texture::transferMip(uint16_t mipLevel, uint8_t face) cons
     auto mip = _gpuObject.accessStoredMipFace(mipLevel, face);
     GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(_gpuObject.getTexelFormat(), mip->getFormat());
     auto size = _gpuObject.evalMipDimensions(mipLevel);
+    // the gl texture starts from our min mip
+    GLint level = mipLevel - _minMip;
     if (GL_TEXTURE_2D == _target) {
-        glTextureSubImage2D(_id, mipLevel, 0, 0, size.x, size.y, texelFormat.format, texelFormat.type, mip->readData());
+        transferMipRows(mipLevel, face, [&](GLint yOffset, GLsizei numRows, const GLvoid* pixels) {
+            glTextureSubImage2D(_id, level, 0, yOffset, size.x, numRows, texelFormat.format, texelFormat.type, pixels);
+        });
     } else if (GL_TEXTURE_CUBE_MAP == _target) {
         // DSA ARB does not work on AMD, so use EXT
-        // glTextureSubImage3D(_id, mipLevel, 0, 0, face, size.x, size.y, 1, texelFormat.format, texelFormat.type, mip->readData());
+        // glTextureSubImage3D(_id, level, 0, 0, face, size.x, size.y, 1, texelFormat.format, texelFormat.type, mip->readData());
         auto target = CUBE_FACE_LAYOUT[face];
-        glTextureSubImage2DEXT(_id, target, mipLevel, 0, 0, size.x, size.y, texelFormat.format, texelFormat.type, mip->readData());
+        transferMipRows(mipLevel, face, [&](GLint yOffset, GLsizei numRows, const GLvoid* pixels) {
+            glTextureSubImage2DEXT(_id, target, level, 0, yOffset, size.x, numRows, texelFormat.format, texelFormat.type, pixels);
+        });
     } else {
         Q_ASSERT(false);
     }
@@ -105,15 +132,16 @@ void GL45Backend::GL45Texture::transfer() const {
         return;
     }
 
+    // The mips the previous gl texture of a downsampled or streamed texture has are copied from it,
+    // the ones it doesn't are transferred from sysmem
+    uint16 copiedMinMip = evalCopiedMinMip();
     if (_downsampleSource._texture) {
         GLuint fbo { 0 };
         glCreateFramebuffers(1, &fbo);
         glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
-        // Find the distance between the old min mip and the new one
-        uint16 mipOffset = _minMip - _downsampleSource._minMip;
-        for (uint16 i = _minMip; i <= _maxMip; ++i) {
+        for (uint16 i = copiedMinMip; i <= _maxMip; ++i) {
             uint16 targetMip = i - _minMip;
-            uint16 sourceMip = targetMip + mipOffset;
+            uint16 sourceMip = i - _downsampleSource._minMip;
             Vec3u dimensions = _gpuObject.evalMipDimensions(i);
             for (GLenum target : getFaceTargets(_target)) {
                 glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, _downsampleSource._texture, sourceMip);
@@ -124,12 +152,14 @@ void GL45Backend::GL45Texture::transfer() const {
         }
         glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
         glDeleteFramebuffers(1, &fbo);
-    } else {
+    }
+
+    if (copiedMinMip > _minMip) {
         // GO through the process of allocating the correct storage and/or update the content
         switch (_gpuObject.getType()) {
         case Texture::TEX_2D: 
             {
-                for (uint16_t i = _minMip; i <= _maxMip; ++i) {
+                for (uint16_t i = _minMip; i < copiedMinMip; ++i) {
                     if (_gpuObject.isStoredMipFaceAvailable(i)) {
                         transferMip(i);
                     }
@@ -140,7 +170,7 @@ void GL45Backend::GL45Texture::transfer() const {
         case Texture::TEX_CUBE:
             // transfer pixels from each faces
             for (uint8_t f = 0; f < CUBE_NUM_FACES; f++) {
-                for (uint16_t i = 0; i < Sampler::MAX_MIP_LEVEL; ++i) {
+                for (uint16_t i = _minMip; i < copiedMinMip; ++i) {
                     if (_gpuObject.isStoredMipFaceAvailable(i, f)) {
                         transferMip(i, f);
                     }
@@ -160,6 +190,10 @@ void GL45Backend::GL45Texture::transfer() const {
 }
 
 void GL45Backend::GL45Texture::syncSampler() const {
+    // the parameters of a texture with a handle can't change anymore
+    if (_handle) {
+        return;
+    }
     const Sampler& sampler = _gpuObject.getSampler();
 
     const auto& fm = FILTER_MODES[sampler.getFilter()];
@@ -183,3 +217,87 @@ void GL45Backend::GL45Texture::syncSampler() const {
     glTextureParameterf(_id, GL_TEXTURE_MAX_ANISOTROPY_EXT, sampler.getMaxAnisotropy());
 }
 
+
+GL45Backend::~GL45Backend() {
+    // deleting the fallback texture deletes its handle too
+    if (_fallbackTexture) {
+        glDeleteTextures(1, &_fallbackTexture);
+    }
+    if (_textureTableBuffer) {
+        glDeleteBuffers(1, &_textureTableBuffer);
+    }
+}
+
+bool GL45Backend::supportsBindlessTextures() const {
+    static bool supported = false;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        supported = (GLEW_ARB_bindless_texture != GL_FALSE);
+        qCDebug(gpugl45logging) << "GL45Backend bindless textures" << (supported ? "enabled" : "not supported");
+    });
+    return supported;
+}
+
+GLuint64 GL45Backend::getFallbackTextureHandle() {
+    if (!_fallbackTextureHandle) {
+        static const uint32_t WHITE = 0xFFFFFFFF;
+        glCreateTextures(GL_TEXTURE_2D, 1, &_fallbackTexture);
+        glTextureStorage2D(_fallbackTexture, 1, GL_RGBA8, 1, 1);
+        glTextureSubImage2D(_fallbackTexture, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, &WHITE);
+        _fallbackTextureHandle = glGetTextureHandleARB(_fallbackTexture);
+        glMakeTextureHandleResidentARB(_fallbackTextureHandle);
+        (void)CHECK_GL_ERROR();
+    }
+    return _fallbackTextureHandle;
+}
+
+void GL45Backend::updateTextureTable() {
+    if (!supportsBindlessTextures()) {
+        return;
+    }
+
+    // The textures still transferring are sampled as the fallback until they are ready
+    TextureTableHandles handles;
+    for (size_t i = 0; i < TextureTable::COUNT; ++i) {
+        GLuint64 handle = 0;
+        const auto& texture = _resource._textures[i];
+        if (texture) {
+            auto* object = Backend::getGPUObject<GL45Texture>(*texture);
+            if (object) {
+                handle = object->getHandle();
+            }
+        }
+        handles[i] = handle ? handle : getFallbackTextureHandle();
+    }
+
+    // a uniform buffer set on the slot of the table since the last upload took its binding
+    const uint32_t slot = RESOURCE_TEXTURE_TABLE_SLOT;
+    if (_textureTableValid && !_uniform._buffers[slot] && handles == _textureTableHandles) {
+        return;
+    }
+    _textureTableHandles = handles;
+    _textureTableValid = true;
+
+    // std140 lays the samplers of the block out 16 bytes apart
+    static const GLsizeiptr HANDLE_STRIDE = 16;
+    const GLsizeiptr size = TextureTable::COUNT * HANDLE_STRIDE;
+    uint8_t data[size];
+    memset(data, 0, size);
+    for (size_t i = 0; i < TextureTable::COUNT; ++i) {
+        memcpy(data + i * HANDLE_STRIDE, &handles[i], sizeof(GLuint64));
+    }
+
+    GLintptr offset = _streamRing.allocate(size, std::max<GLsizeiptr>(_streamAlignment, _uboAlignment));
+    if (offset >= 0) {
+        memcpy(_streamRing.getPointer(offset), data, size);
+        glBindBufferRange(GL_UNIFORM_BUFFER, slot, _streamRing.getBuffer(), offset, size);
+    } else {
+        if (!_textureTableBuffer) {
+            glCreateBuffers(1, &_textureTableBuffer);
+        }
+        glNamedBufferData(_textureTableBuffer, size, data, GL_STREAM_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, slot, _textureTableBuffer);
+    }
+    _uniform._buffers[slot].reset();
+    (void)CHECK_GL_ERROR();
+}
@@ -13,17 +13,29 @@
 using namespace gpu;
 using namespace gpu::gl45;
 
+// Room for the transform objects and draw call infos of a few frames in flight
+static const GLsizeiptr STREAM_RING_SIZE = 16 * 1024 * 1024;
+
 void GL45Backend::initTransform() {
-    GLuint transformBuffers[3];
-    glCreateBuffers(3, transformBuffers);
+    GLuint transformBuffers[4];
+    glCreateBuffers(4, transformBuffers);
     _transform._objectBuffer = transformBuffers[0];
     _transform._cameraBuffer = transformBuffers[1];
     _transform._drawCallInfoBuffer = transformBuffers[2];
+    _transform._drawRunBuffer = transformBuffers[3];
     glCreateTextures(GL_TEXTURE_BUFFER, 1, &_transform._objectBufferTexture);
-    size_t cameraSize = sizeof(TransformStageState::CameraBufferElement);
+    // Room for the cameras of both eyes side by side in every slot, for the instanced stereo draws
+    size_t cameraSize = 2 * sizeof(TransformStageState::CameraBufferElement);
     while (_transform._cameraUboSize < cameraSize) {
         _transform._cameraUboSize += _uboAlignment;
     }
+
+    GLint textureBufferAlignment = 0;
+    GLint storageBufferAlignment = 0;
+    glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &textureBufferAlignment);
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageBufferAlignment);
+    _streamAlignment = std::max<GLsizeiptr>(16, std::max(textureBufferAlignment, storageBufferAlignment));
+    _streamRing.init(STREAM_RING_SIZE);
 }
 
 void GL45Backend::transferTransformState(const Batch& batch) const {
@@ -31,18 +43,47 @@ void GL45Backend::transferTransformState(const Batch& batch) const {
     static std::vector<uint8_t> bufferData;
     if (!_transform._cameras.empty()) {
         bufferData.resize(_transform._cameraUboSize * _transform._cameras.size());
+        const size_t cameraSize = sizeof(TransformStageState::CameraBufferElement);
         for (size_t i = 0; i < _transform._cameras.size(); ++i) {
-            memcpy(bufferData.data() + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
+            const auto& camera = _transform._cameras[i];
+            uint8_t* slot = bufferData.data() + (_transform._cameraUboSize * i);
+            memcpy(slot, &camera, cameraSize);
+            // the left eye is followed by the right eye in its slot too, where bindCurrentStereoCameras reads them
+            bool isLeftEye = (camera._stereoInfo.x > 0.0f) && (camera._stereoInfo.y == 0.0f);
+            if (isLeftEye && (i + 1 < _transform._cameras.size())) {
+                memcpy(slot + cameraSize, &_transform._cameras[i + 1], cameraSize);
+            }
         }
         glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
     }
 
-    if (!batch._objects.empty()) {
-        glNamedBufferData(_transform._objectBuffer, batch._objects.size() * sizeof(Batch::TransformObject), batch._objects.data(), GL_STREAM_DRAW);
+    // Whatever the previous batches wrote into the ring is fenced behind their commands
+    _streamRing.fence();
+
+    // The objects and draw call infos are written straight into the ring when there is room for them,
+    // or uploaded into their own buffers as before when there isn't
+    GLsizeiptr objectsSize = batch._objects.size() * sizeof(Batch::TransformObject);
+    GLintptr objectsOffset = -1;
+    if (objectsSize > 0) {
+        objectsOffset = _streamRing.allocate(objectsSize, _streamAlignment);
+        if (objectsOffset >= 0) {
+            memcpy(_streamRing.getPointer(objectsOffset), batch._objects.data(), objectsSize);
+        } else {
+            glNamedBufferData(_transform._objectBuffer, objectsSize, batch._objects.data(), GL_STREAM_DRAW);
+        }
     }
 
-    if (!batch._namedData.empty()) {
-        bufferData.clear();
+    // The draw call infos of the batch itself go first, the indexed draw runs fetch them per instance
+    const auto& drawCallInfos = batch.getDrawCallInfoBuffer();
+    _transform._drawCallInfoOffsets.clear();
+    _transform._currentDrawCallInfoBuffer = _transform._drawCallInfoBuffer;
+    if (!batch._namedData.empty() || !drawCallInfos.empty()) {
+        bufferData.resize(drawCallInfos.size() * sizeof(Batch::DrawCallInfo));
+        if (!drawCallInfos.empty()) {
+            memcpy(bufferData.data(), drawCallInfos.data(), bufferData.size());
+        }
+        _transform._drawCallInfoOffsets[std::string()] = 0;
+
         for (auto& data : batch._namedData) {
             auto currentSize = bufferData.size();
             auto bytesToCopy = data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
@@ -50,15 +91,33 @@ void GL45Backend::transferTransformState(const Batch& batch) const {
             memcpy(bufferData.data() + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
             _transform._drawCallInfoOffsets[data.first] = (GLvoid*)currentSize;
         }
-        glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+
+        GLintptr drawCallInfosOffset = bufferData.empty() ? -1 : _streamRing.allocate(bufferData.size(), sizeof(Batch::DrawCallInfo));
+        if (drawCallInfosOffset >= 0) {
+            memcpy(_streamRing.getPointer(drawCallInfosOffset), bufferData.data(), bufferData.size());
+            _transform._currentDrawCallInfoBuffer = _streamRing.getBuffer();
+            for (auto& offset : _transform._drawCallInfoOffsets) {
+                offset.second = (GLvoid*)(drawCallInfosOffset + reinterpret_cast<GLintptr>(offset.second));
+            }
+        } else {
+            glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        }
     }
 
 #ifdef GPU_SSBO_DRAW_CALL_INFO
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TRANSFORM_OBJECT_SLOT, _transform._objectBuffer);
+    if (objectsOffset >= 0) {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, TRANSFORM_OBJECT_SLOT, _streamRing.getBuffer(), objectsOffset, objectsSize);
+    } else {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TRANSFORM_OBJECT_SLOT, _transform._objectBuffer);
+    }
 #else
     glActiveTexture(GL_TEXTURE0 + TRANSFORM_OBJECT_SLOT);
     glBindTexture(GL_TEXTURE_BUFFER, _transform._objectBufferTexture);
-    glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    if (objectsOffset >= 0) {
+        glTextureBufferRange(_transform._objectBufferTexture, GL_RGBA32F, _streamRing.getBuffer(), objectsOffset, objectsSize);
+    } else {
+        glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    }
 #endif
 
     CHECK_GL_ERROR();
@@ -0,0 +1,197 @@
+//
+//  ImageKernels_avx2.cpp
+//  libraries/gpu/src/avx2
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <algorithm>
+#include <stdint.h>
+#include <immintrin.h>
+
+#ifndef __AVX2__
+#error Must be compiled with /arch:AVX2 or -mavx2 -mfma.
+#endif
+
+static const float SOBEL_STRENGTH = 2.0f;
+static const float NORMAL_Z = 255.0f / SOBEL_STRENGTH;
+
+static inline int horizontalSum(__m256i x) {
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+int countAlphas_AVX2(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents) {
+    const __m256i opaque = _mm256_set1_epi32(255);
+    const __m256i transparent = _mm256_setzero_si256();
+
+    // the comparisons are -1 for a match, so the counts go down
+    __m256i opaques = _mm256_setzero_si256();
+    __m256i transparents = _mm256_setzero_si256();
+
+    int i = 0;
+    for (; i + 8 <= numPixels; i += 8) {
+        __m256i alpha = _mm256_srli_epi32(_mm256_loadu_si256((const __m256i*)&pixels[i]), 24);
+        opaques = _mm256_add_epi32(opaques, _mm256_cmpeq_epi32(alpha, opaque));
+        transparents = _mm256_add_epi32(transparents, _mm256_cmpeq_epi32(alpha, transparent));
+    }
+
+    int blockOpaques = -horizontalSum(opaques);
+    int blockTransparents = -horizontalSum(transparents);
+    numOpaques += blockOpaques;
+    numTranslucents += i - blockOpaques - blockTransparents;
+    return i;
+}
+
+// weighs the channels of 32 bit lanes that hold them in their low byte
+static inline __m256i gray_AVX2(__m256i r, __m256i g, __m256i b) {
+    __m256i sum = _mm256_add_epi32(_mm256_mullo_epi16(r, _mm256_set1_epi32(11)), _mm256_slli_epi32(g, 4));
+    sum = _mm256_add_epi32(sum, _mm256_mullo_epi16(b, _mm256_set1_epi32(5)));
+    return _mm256_srli_epi32(sum, 5);
+}
+
+// stores the low byte of each 32 bit lane
+static inline void storeGray_AVX2(uint8_t* dst, __m256i gray) {
+    __m256i packed = _mm256_packs_epi32(gray, gray);
+    packed = _mm256_packus_epi16(packed, packed);
+    packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4));
+    _mm_storel_epi64((__m128i*)dst, _mm256_castsi256_si128(packed));
+}
+
+int grayFromRGB888_AVX2(const uint8_t* src, uint8_t* dst, int numPixels, bool invert) {
+    const __m256i mask = _mm256_set1_epi32(invert ? 0xff : 0x00);
+
+    // each 128 bit lane holds 4 pixels in its first 12 bytes
+    const __m256i redShuffle = _mm256_setr_epi8(
+        0, -1, -1, -1, 3, -1, -1, -1, 6, -1, -1, -1, 9, -1, -1, -1,
+        0, -1, -1, -1, 3, -1, -1, -1, 6, -1, -1, -1, 9, -1, -1, -1);
+    const __m256i greenShuffle = _mm256_setr_epi8(
+        1, -1, -1, -1, 4, -1, -1, -1, 7, -1, -1, -1, 10, -1, -1, -1,
+        1, -1, -1, -1, 4, -1, -1, -1, 7, -1, -1, -1, 10, -1, -1, -1);
+    const __m256i blueShuffle = _mm256_setr_epi8(
+        2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1,
+        2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1);
+
+    // the load of the second lane reads 4 bytes past the 8 pixels, so it stops short of the end of the row
+    int i = 0;
+    for (; i + 10 <= numPixels; i += 8) {
+        const uint8_t* pixels = &src[3 * i];
+        __m256i rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)pixels)),
+            _mm_loadu_si128((const __m128i*)(pixels + 12)), 1);
+        __m256i r = _mm256_xor_si256(_mm256_shuffle_epi8(rgb, redShuffle), mask);
+        __m256i g = _mm256_xor_si256(_mm256_shuffle_epi8(rgb, greenShuffle), mask);
+        __m256i b = _mm256_xor_si256(_mm256_shuffle_epi8(rgb, blueShuffle), mask);
+        storeGray_AVX2(&dst[i], gray_AVX2(r, g, b));
+    }
+    return i;
+}
+
+int grayFromARGB32_AVX2(const uint32_t* src, uint8_t* dst, int numPixels, bool invert) {
+    const __m256i mask = _mm256_set1_epi32(invert ? 0xffffffff : 0x00);
+    const __m256i channel = _mm256_set1_epi32(0xff);
+
+    int i = 0;
+    for (; i + 8 <= numPixels; i += 8) {
+        __m256i pixel = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&src[i]), mask);
+        __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), channel);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), channel);
+        __m256i b = _mm256_and_si256(pixel, channel);
+        storeGray_AVX2(&dst[i], gray_AVX2(r, g, b));
+    }
+    return i;
+}
+
+static inline __m256 loadHeights_AVX2(const uint8_t* heights) {
+    return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)heights)));
+}
+
+static inline __m256i mapNormalComponent_AVX2(__m256 component) {
+    // (component + 1) * 127.5 + 0.5
+    __m256 mapped = _mm256_mul_ps(_mm256_add_ps(component, _mm256_set1_ps(1.0f)), _mm256_set1_ps(127.5f));
+    return _mm256_cvttps_epi32(_mm256_add_ps(mapped, _mm256_set1_ps(0.5f)));
+}
+
+int normalsFromHeights_AVX2(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width) {
+    const __m256 strength = _mm256_set1_ps(SOBEL_STRENGTH);
+    const __m256 normalZ = _mm256_set1_ps(NORMAL_Z);
+
+    // the first pixel is clamped, the others read up to the pixel after them
+    int x = 1;
+    for (; x + 8 < width; x += 8) {
+        __m256 abovePrev = loadHeights_AVX2(&above[x - 1]);
+        __m256 aboveNext = loadHeights_AVX2(&above[x + 1]);
+        __m256 belowPrev = loadHeights_AVX2(&below[x - 1]);
+        __m256 belowNext = loadHeights_AVX2(&below[x + 1]);
+
+        __m256 right = _mm256_add_ps(_mm256_add_ps(aboveNext, _mm256_mul_ps(strength, loadHeights_AVX2(&row[x + 1]))), belowNext);
+        __m256 left = _mm256_add_ps(_mm256_add_ps(abovePrev, _mm256_mul_ps(strength, loadHeights_AVX2(&row[x - 1]))), belowPrev);
+        __m256 bottom = _mm256_add_ps(_mm256_add_ps(belowPrev, _mm256_mul_ps(strength, loadHeights_AVX2(&below[x]))), belowNext);
+        __m256 top = _mm256_add_ps(_mm256_add_ps(abovePrev, _mm256_mul_ps(strength, loadHeights_AVX2(&above[x]))), aboveNext);
+        __m256 dX = _mm256_sub_ps(right, left);
+        __m256 dY = _mm256_sub_ps(bottom, top);
+
+        __m256 lengthSquared = _mm256_fmadd_ps(dX, dX, _mm256_fmadd_ps(dY, dY, _mm256_mul_ps(normalZ, normalZ)));
+        __m256 invLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquared));
+
+        int32_t components[3][8];
+        _mm256_storeu_si256((__m256i*)components[0], mapNormalComponent_AVX2(_mm256_mul_ps(dX, invLength)));
+        _mm256_storeu_si256((__m256i*)components[1], mapNormalComponent_AVX2(_mm256_mul_ps(dY, invLength)));
+        _mm256_storeu_si256((__m256i*)components[2], mapNormalComponent_AVX2(_mm256_mul_ps(normalZ, invLength)));
+        for (int j = 0; j < 8; ++j) {
+            dst[3 * (x + j)] = (uint8_t)components[0][j];
+            dst[3 * (x + j) + 1] = (uint8_t)components[1][j];
+            dst[3 * (x + j) + 2] = (uint8_t)components[2][j];
+        }
+    }
+    return x;
+}
+
+int downsampleRow_AVX2(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize) {
+    // only the destination texels whose source texels are all inside the row
+    const int numTexels = std::min(dstWidth, srcWidth / 2);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi16(2);
+
+    // the sums of each 128 bit lane end up in its low 8 bytes
+    const __m256i lowHalves = _mm256_setr_epi32(0, 1, 4, 5, 0, 1, 4, 5);
+
+    int x = 0;
+    if (texelSize == 4) {
+        // 8 source texels in, 4 out
+        for (; x + 4 <= numTexels; x += 4) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)&row0[8 * x]);
+            __m256i b = _mm256_loadu_si256((const __m256i*)&row1[8 * x]);
+            __m256i low = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+            __m256i high = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+            low = _mm256_add_epi16(low, _mm256_srli_si256(low, 8));
+            high = _mm256_add_epi16(high, _mm256_srli_si256(high, 8));
+            __m256i sum = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(low, high), round), 2);
+            sum = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(sum, sum), lowHalves);
+            _mm_storeu_si128((__m128i*)&dst[4 * x], _mm256_castsi256_si128(sum));
+        }
+    } else if (texelSize == 1) {
+        // 32 source texels in, 16 out
+        const __m256i ones = _mm256_set1_epi16(1);
+        for (; x + 16 <= numTexels; x += 16) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)&row0[2 * x]);
+            __m256i b = _mm256_loadu_si256((const __m256i*)&row1[2 * x]);
+            __m256i low = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+            __m256i high = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+            __m256i sum = _mm256_packs_epi32(_mm256_madd_epi16(low, ones), _mm256_madd_epi16(high, ones));
+            sum = _mm256_srli_epi16(_mm256_add_epi16(sum, round), 2);
+            sum = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(sum, sum), lowHalves);
+            _mm_storeu_si128((__m128i*)&dst[x], _mm256_castsi256_si128(sum));
+        }
+    }
+    return x;
+}
+
+#endif
@@ -14,6 +14,8 @@
 
 #include <QDebug>
 
+#include "TextureTable.h"
+
 #if defined(NSIGHT_FOUND)
 #include "nvToolsExt.h"
 
@@ -59,6 +61,7 @@ Batch::Batch(const Batch& batch_) {
 
     _buffers._items.swap(batch._buffers._items);
     _textures._items.swap(batch._textures._items);
+    _textureTables._items.swap(batch._textureTables._items);
     _streamFormats._items.swap(batch._streamFormats._items);
     _transforms._items.swap(batch._transforms._items);
     _pipelines._items.swap(batch._pipelines._items);
@@ -71,6 +74,14 @@ Batch::Batch(const Batch& batch_) {
     _namedData.swap(batch._namedData);
     _enableStereo = batch._enableStereo;
     _enableSkybox = batch._enableSkybox;
+
+    _recordedPipeline = batch._recordedPipeline;
+    _recordedInputFormat = batch._recordedInputFormat;
+    _recordedIndexBuffer = batch._recordedIndexBuffer;
+    _recordedInputBuffers = batch._recordedInputBuffers;
+    _recordedUniformBuffers = batch._recordedUniformBuffers;
+    _recordedTextures = batch._recordedTextures;
+    _numCompactedCommands = batch._numCompactedCommands;
 }
 
 Batch::~Batch() {
@@ -96,12 +107,59 @@ void Batch::clear() {
     _data.clear();
     _buffers.clear();
     _textures.clear();
+    _textureTables.clear();
     _streamFormats.clear();
     _transforms.clear();
     _pipelines.clear();
     _framebuffers.clear();
     _objects.clear();
     _drawCallInfos.clear();
+
+    invalidateRecordedState();
+    _numCompactedCommands = 0;
+}
+
+bool Batch::isRedundant(RecordedBinding& recorded, const RecordedBinding& binding) {
+    if (recorded == binding) {
+        ++_numCompactedCommands;
+        return true;
+    }
+    recorded = binding;
+    return false;
+}
+
+bool Batch::isRedundant(RecordedBindings& recorded, uint32 slot, const RecordedBinding& binding) {
+    if (slot >= recorded.size()) {
+        return false;
+    }
+    return isRedundant(recorded[slot], binding);
+}
+
+void Batch::invalidateRecordedState() {
+    _recordedPipeline = RecordedBinding();
+    _recordedInputFormat = RecordedBinding();
+    _recordedIndexBuffer = RecordedBinding();
+    _recordedInputBuffers.fill(RecordedBinding());
+    _recordedUniformBuffers.fill(RecordedBinding());
+    _recordedTextures.fill(RecordedBinding());
+}
+
+bool Batch::mergeWithPreviousDraw(Command command, Primitive primitiveType, uint32 count, uint32 start) {
+    // The strips and fans don't join, and a new model transform or a named call needs a draw call info of its own
+    if ((primitiveType != POINTS && primitiveType != LINES && primitiveType != TRIANGLES) ||
+        _invalidModel || !_currentNamedCall.empty() || _commands.empty() || _commands.back() != command) {
+        return false;
+    }
+
+    // draw and drawIndexed share the layout of their params: start, count, primitive
+    size_t offset = _commandOffsets.back();
+    Param& previousCount = _params[offset + 1];
+    if (_params[offset + 2]._uint != (uint32)primitiveType || _params[offset]._uint + previousCount._uint != start) {
+        return false;
+    }
+    previousCount._uint += count;
+    ++_numCompactedCommands;
+    return true;
 }
 
 size_t Batch::cacheData(size_t size, const void* data) {
@@ -114,6 +172,9 @@ size_t Batch::cacheData(size_t size, const void* data) {
 }
 
 void Batch::draw(Primitive primitiveType, uint32 numVertices, uint32 startVertex) {
+    if (mergeWithPreviousDraw(COMMAND_draw, primitiveType, numVertices, startVertex)) {
+        return;
+    }
     ADD_COMMAND(draw);
 
     _params.emplace_back(startVertex);
@@ -124,6 +185,9 @@ void Batch::draw(Primitive primitiveType, uint32 numVertices, uint32 startVertex
 }
 
 void Batch::drawIndexed(Primitive primitiveType, uint32 numIndices, uint32 startIndex) {
+    if (mergeWithPreviousDraw(COMMAND_drawIndexed, primitiveType, numIndices, startIndex)) {
+        return;
+    }
     ADD_COMMAND(drawIndexed);
 
     _params.emplace_back(startIndex);
@@ -174,13 +238,37 @@ void Batch::multiDrawIndexedIndirect(uint32 nbCommands, Primitive primitiveType)
     captureDrawCallInfo();
 }
 
+void Batch::captureVertices(const BufferPointer& buffer, uint32 numVertices, uint32 startVertex) {
+    ADD_COMMAND(captureVertices);
+
+    _params.emplace_back(_buffers.cache(buffer));
+    _params.emplace_back(startVertex);
+    _params.emplace_back(numVertices);
+}
+
 void Batch::setInputFormat(const Stream::FormatPointer& format) {
+    RecordedBinding binding;
+    binding._object = format.get();
+    binding._valid = true;
+    if (isRedundant(_recordedInputFormat, binding)) {
+        return;
+    }
+
     ADD_COMMAND(setInputFormat);
 
     _params.emplace_back(_streamFormats.cache(format));
 }
 
 void Batch::setInputBuffer(Slot channel, const BufferPointer& buffer, Offset offset, Offset stride) {
+    RecordedBinding binding;
+    binding._object = buffer.get();
+    binding._offset = offset;
+    binding._size = stride;
+    binding._valid = true;
+    if (isRedundant(_recordedInputBuffers, channel, binding)) {
+        return;
+    }
+
     ADD_COMMAND(setInputBuffer);
 
     _params.emplace_back(stride);
@@ -205,6 +293,15 @@ void Batch::setInputStream(Slot startChannel, const BufferStream& stream) {
 }
 
 void Batch::setIndexBuffer(Type type, const BufferPointer& buffer, Offset offset) {
+    RecordedBinding binding;
+    binding._object = buffer.get();
+    binding._offset = offset;
+    binding._size = type;
+    binding._valid = true;
+    if (isRedundant(_recordedIndexBuffer, binding)) {
+        return;
+    }
+
     ADD_COMMAND(setIndexBuffer);
 
     _params.emplace_back(offset);
@@ -259,6 +356,13 @@ void Batch::setDepthRangeTransform(float nearDepth, float farDepth) {
 }
 
 void Batch::setPipeline(const PipelinePointer& pipeline) {
+    RecordedBinding binding;
+    binding._object = pipeline.get();
+    binding._valid = true;
+    if (isRedundant(_recordedPipeline, binding)) {
+        return;
+    }
+
     ADD_COMMAND(setPipeline);
 
     _params.emplace_back(_pipelines.cache(pipeline));
@@ -280,6 +384,15 @@ void Batch::setStateScissorRect(const Vec4i& rect) {
 }
 
 void Batch::setUniformBuffer(uint32 slot, const BufferPointer& buffer, Offset offset, Offset size) {
+    RecordedBinding binding;
+    binding._object = buffer.get();
+    binding._offset = offset;
+    binding._size = size;
+    binding._valid = true;
+    if (isRedundant(_recordedUniformBuffers, slot, binding)) {
+        return;
+    }
+
     ADD_COMMAND(setUniformBuffer);
 
     _params.emplace_back(size);
@@ -294,6 +407,13 @@ void Batch::setUniformBuffer(uint32 slot, const BufferView& view) {
 
 
 void Batch::setResourceTexture(uint32 slot, const TexturePointer& texture) {
+    RecordedBinding binding;
+    binding._object = texture.get();
+    binding._valid = true;
+    if (isRedundant(_recordedTextures, slot, binding)) {
+        return;
+    }
+
     ADD_COMMAND(setResourceTexture);
 
     _params.emplace_back(_textures.cache(texture));
@@ -304,6 +424,34 @@ void Batch::setResourceTexture(uint32 slot, const TextureView& view) {
     setResourceTexture(slot, view._texture);
 }
 
+void Batch::setResourceTextureTable(const TextureTablePointer& table, uint32 slot) {
+    const auto& textures = table->getTextures();
+    bool redundant = (slot + TextureTable::COUNT <= NUM_RECORDED_SLOTS);
+    for (size_t i = 0; redundant && i < TextureTable::COUNT; ++i) {
+        const auto& recorded = _recordedTextures[slot + i];
+        redundant = !textures[i] || (recorded._valid && recorded._object == textures[i].get());
+    }
+    if (redundant) {
+        ++_numCompactedCommands;
+        return;
+    }
+
+    ADD_COMMAND(setResourceTextureTable);
+
+    _params.emplace_back(_textureTables.cache(table));
+    _params.emplace_back(slot);
+
+    // the slots of the table hold its textures now
+    for (size_t i = 0; i < TextureTable::COUNT; ++i) {
+        if (textures[i] && slot + i < NUM_RECORDED_SLOTS) {
+            auto& binding = _recordedTextures[slot + i];
+            binding = RecordedBinding();
+            binding._object = textures[i].get();
+            binding._valid = true;
+        }
+    }
+}
+
 void Batch::setFramebuffer(const FramebufferPointer& framebuffer) {
     ADD_COMMAND(setFramebuffer);
 
@@ -382,11 +530,13 @@ void Batch::getQuery(const QueryPointer& query) {
 
 void Batch::resetStages() {
     ADD_COMMAND(resetStages);
+    invalidateRecordedState();
 }
 
 void Batch::runLambda(std::function<void()> f) {
     ADD_COMMAND(runLambda);
     _params.emplace_back(_lambdas.cache(f));
+    invalidateRecordedState();
 }
 
 void Batch::startNamedCall(const std::string& name) {
@@ -516,6 +666,12 @@ void Batch::_glActiveBindTexture(uint32 unit, uint32 target, uint32 texture) {
     _params.emplace_back(texture);
     _params.emplace_back(target);
     _params.emplace_back(unit);
+
+    // the unit now holds a texture the batch doesn't know of
+    uint32 slot = unit - GL_TEXTURE0;
+    if (slot < _recordedTextures.size()) {
+        _recordedTextures[slot] = RecordedBinding();
+    }
 }
 
 void Batch::_glUniform1i(int32 location, int32 v0) {
@@ -11,6 +11,7 @@
 #ifndef hifi_gpu_Batch_h
 #define hifi_gpu_Batch_h
 
+#include <array>
 #include <vector>
 #include <mutex>
 #include <functional>
@@ -37,6 +38,8 @@ enum ReservedSlot {
     TRANSFORM_OBJECT_SLOT = 31,
 #endif
     TRANSFORM_CAMERA_SLOT = 7,
+    // the uniform buffer of the handles of a TextureTable, with bindless textures
+    RESOURCE_TEXTURE_TABLE_SLOT = 11,
 };
 
 // The named batch data provides a mechanism for accumulating data into buffers over the course 
@@ -116,6 +119,10 @@ public:
     void enableSkybox(bool enable = true);
     bool isSkyboxEnabled() const;
 
+    // The commands dropped or merged into the previous one while recording, since they wouldn't change anything:
+    // a state set again to what it already is, or a draw continuing the range of the draw just before it
+    size_t getNumCompactedCommands() const { return _numCompactedCommands; }
+
     // Drawcalls
     void draw(Primitive primitiveType, uint32 numVertices, uint32 startVertex = 0);
     void drawIndexed(Primitive primitiveType, uint32 numIndices, uint32 startIndex = 0);
@@ -124,6 +131,11 @@ public:
     void multiDrawIndirect(uint32 numCommands, Primitive primitiveType);
     void multiDrawIndexedIndirect(uint32 numCommands, Primitive primitiveType);
 
+    // Runs the vertex stage of the current pipeline over numVertices points and writes the varyings its program feeds
+    // back (see Shader::setTransformFeedbackVaryings) into buffer, interleaved, without rasterizing anything.
+    // It isn't a draw call: it happens once in stereo too and takes no model transform.
+    void captureVertices(const BufferPointer& buffer, uint32 numVertices, uint32 startVertex = 0);
+
     void setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function);
     BufferPointer getNamedBuffer(const std::string& instanceName, uint8_t index = 0);
 
@@ -192,6 +204,9 @@ public:
     void setResourceTexture(uint32 slot, const TexturePointer& view);
     void setResourceTexture(uint32 slot, const TextureView& view); // not a command, just a shortcut from a TextureView
 
+    // Set the textures of the table on the TextureTable::COUNT slots starting at slot
+    void setResourceTextureTable(const TextureTablePointer& table, uint32 slot = 0);
+
     // Ouput Stage
     void setFramebuffer(const FramebufferPointer& framebuffer);
  
@@ -276,6 +291,7 @@ public:
         COMMAND_drawIndexedInstanced,
         COMMAND_multiDrawIndirect,
         COMMAND_multiDrawIndexedIndirect,
+        COMMAND_captureVertices,
 
         COMMAND_setInputFormat,
         COMMAND_setInputBuffer,
@@ -294,6 +310,7 @@ public:
 
         COMMAND_setUniformBuffer,
         COMMAND_setResourceTexture,
+        COMMAND_setResourceTextureTable,
 
         COMMAND_setFramebuffer,
         COMMAND_clearFramebuffer,
@@ -408,6 +425,7 @@ public:
 
     typedef Cache<BufferPointer>::Vector BufferCaches;
     typedef Cache<TexturePointer>::Vector TextureCaches;
+    typedef Cache<TextureTablePointer>::Vector TextureTableCaches;
     typedef Cache<Stream::FormatPointer>::Vector StreamFormatCaches;
     typedef Cache<Transform>::Vector TransformCaches;
     typedef Cache<PipelinePointer>::Vector PipelineCaches;
@@ -462,6 +480,7 @@ public:
 
     BufferCaches _buffers;
     TextureCaches _textures;
+    TextureTableCaches _textureTables;
     StreamFormatCaches _streamFormats;
     TransformCaches _transforms;
     PipelineCaches _pipelines;
@@ -477,6 +496,39 @@ public:
     bool _enableSkybox{ false };
 
 protected:
+    // The last binding recorded for a slot of a stage, the object is only compared, never dereferenced
+    // (the caches of the batch hold on to it anyway)
+    struct RecordedBinding {
+        const void* _object { nullptr };
+        Offset _offset { 0 };
+        Offset _size { 0 };
+        bool _valid { false };
+
+        bool operator==(const RecordedBinding& binding) const {
+            return _valid && binding._valid && (_object == binding._object) && (_offset == binding._offset) && (_size == binding._size);
+        }
+    };
+    static const size_t NUM_RECORDED_SLOTS = 16;
+    using RecordedBindings = std::array<RecordedBinding, NUM_RECORDED_SLOTS>;
+
+    // The state a command would set again is not recorded, false when the command must be recorded
+    bool isRedundant(RecordedBinding& recorded, const RecordedBinding& binding);
+    bool isRedundant(RecordedBindings& recorded, uint32 slot, const RecordedBinding& binding);
+
+    // The state of the backend is unknown after a lambda or a reset
+    void invalidateRecordedState();
+
+    // Extends the previous draw when it is of the same kind, with the same list primitive, and ends where this one starts
+    bool mergeWithPreviousDraw(Command command, Primitive primitiveType, uint32 count, uint32 start);
+
+    RecordedBinding _recordedPipeline;
+    RecordedBinding _recordedInputFormat;
+    RecordedBinding _recordedIndexBuffer;
+    RecordedBindings _recordedInputBuffers;
+    RecordedBindings _recordedUniformBuffers;
+    RecordedBindings _recordedTextures;
+    size_t _numCompactedCommands { 0 };
+
     friend class Context;
     friend class Frame;
 
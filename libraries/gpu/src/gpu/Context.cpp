@@ -43,6 +43,17 @@ void Context::appendFrameBatch(Batch& batch) {
     _currentFrame->batches.push_back(batch);
 }
 
+void Context::appendFrameBatches(std::vector<Batch>& batches) {
+    if (!_frameActive) {
+        qWarning() << "Batches executed outside of frame boundaries";
+        return;
+    }
+    _currentFrame->batches.reserve(_currentFrame->batches.size() + batches.size());
+    for (auto& batch : batches) {
+        _currentFrame->batches.push_back(batch);
+    }
+}
+
 FramePointer Context::endFrame() {
     assert(_frameActive);
     auto result = _currentFrame;
@@ -94,6 +105,18 @@ bool Context::isStereo() {
     return _stereo._enable;
 }
 
+void Context::enableInstancedStereo(bool enable) {
+    _stereo._instanced = enable;
+}
+
+bool Context::isInstancedStereo() const {
+    return _stereo._enable && _stereo._instanced && supportsInstancedStereo();
+}
+
+bool Context::supportsInstancedStereo() const {
+    return _backend && _backend->supportsInstancedStereo();
+}
+
 void Context::setStereoProjections(const mat4 eyeProjections[2]) {
     for (int i = 0; i < 2; ++i) {
         _stereo._eyeProjections[i] = eyeProjections[i];
@@ -168,6 +191,7 @@ std::atomic<uint32_t> Context::_textureGPUCount{ 0 };
 std::atomic<Texture::Size> Context::_textureGPUMemoryUsage{ 0 };
 std::atomic<Texture::Size> Context::_textureGPUVirtualMemoryUsage{ 0 };
 std::atomic<uint32_t> Context::_textureGPUTransferCount{ 0 };
+std::atomic<uint32_t> Context::_textureGPUStreamingCount{ 0 };
 
 void Context::incrementBufferGPUCount() {
     _bufferGPUCount++;
@@ -221,6 +245,13 @@ void Context::decrementTextureGPUTransferCount() {
     _textureGPUTransferCount--;
 }
 
+void Context::incrementTextureGPUStreamingCount() {
+    _textureGPUStreamingCount++;
+}
+void Context::decrementTextureGPUStreamingCount() {
+    _textureGPUStreamingCount--;
+}
+
 uint32_t Context::getBufferGPUCount() {
     return _bufferGPUCount.load();
 }
@@ -245,6 +276,10 @@ uint32_t Context::getTextureGPUTransferCount() {
     return _textureGPUTransferCount.load();
 }
 
+uint32_t Context::getTextureGPUStreamingCount() {
+    return _textureGPUStreamingCount.load();
+}
+
 void Backend::incrementBufferGPUCount() { Context::incrementBufferGPUCount(); }
 void Backend::decrementBufferGPUCount() { Context::decrementBufferGPUCount(); }
 void Backend::updateBufferGPUMemoryUsage(Resource::Size prevObjectSize, Resource::Size newObjectSize) { Context::updateBufferGPUMemoryUsage(prevObjectSize, newObjectSize); }
@@ -254,3 +289,5 @@ void Backend::updateTextureGPUMemoryUsage(Resource::Size prevObjectSize, Resourc
 void Backend::updateTextureGPUVirtualMemoryUsage(Resource::Size prevObjectSize, Resource::Size newObjectSize) { Context::updateTextureGPUVirtualMemoryUsage(prevObjectSize, newObjectSize); }
 void Backend::incrementTextureGPUTransferCount() { Context::incrementTextureGPUTransferCount(); }
 void Backend::decrementTextureGPUTransferCount() { Context::decrementTextureGPUTransferCount(); }
+void Backend::incrementTextureGPUStreamingCount() { Context::incrementTextureGPUStreamingCount(); }
+void Backend::decrementTextureGPUStreamingCount() { Context::decrementTextureGPUStreamingCount(); }
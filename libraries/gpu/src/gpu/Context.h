@@ -15,6 +15,7 @@
 #include <mutex>
 
 #include <GLMHelpers.h>
+#include <ParallelFor.h>
 
 #include "Forward.h"
 #include "Batch.h"
@@ -42,6 +43,8 @@ public:
     int _DSNumTriangles = 0;
 
     int _PSNumSetPipelines = 0;
+
+    int _CSNumCompactedCommands = 0;
  
     ContextStats() {}
     ContextStats(const ContextStats& stats) = default;
@@ -58,6 +61,9 @@ public:
     virtual void recycle() const = 0;
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) = 0;
 
+    // Can the backend draw both eyes of a stereo batch in one instanced draw call
+    virtual bool supportsInstancedStereo() const { return false; }
+
     // UBO class... layout MUST match the layout in Transform.slh
     class TransformCamera {
     public:
@@ -98,6 +104,8 @@ public:
     static void updateTextureGPUVirtualMemoryUsage(Resource::Size prevObjectSize, Resource::Size newObjectSize);
     static void incrementTextureGPUTransferCount();
     static void decrementTextureGPUTransferCount();
+    static void incrementTextureGPUStreamingCount();
+    static void decrementTextureGPUStreamingCount();
 
 protected:
     virtual bool isStereo() {
@@ -143,6 +151,8 @@ public:
 
     void beginFrame(const glm::mat4& renderPose = glm::mat4());
     void appendFrameBatch(Batch& batch);
+    // Appends the batches in order, for batches recorded together
+    void appendFrameBatches(std::vector<Batch>& batches);
     FramePointer endFrame();
 
     // MUST only be called on the rendering thread
@@ -184,6 +194,10 @@ public:
 
     void enableStereo(bool enable = true);
     bool isStereo();
+    // Ask for the stereo batches to be drawn in a single pass, an instance per eye, if the backend supports it
+    void enableInstancedStereo(bool enable = true);
+    bool isInstancedStereo() const;
+    bool supportsInstancedStereo() const;
     void setStereoProjections(const mat4 eyeProjections[2]);
     void setStereoViews(const mat4 eyeViews[2]);
     void getStereoProjections(mat4* eyeProjections) const;
@@ -204,6 +218,7 @@ public:
     static Size getTextureGPUMemoryUsage();
     static Size getTextureGPUVirtualMemoryUsage();
     static uint32_t getTextureGPUTransferCount();
+    static uint32_t getTextureGPUStreamingCount();
 
 protected:
     Context(const Context& context);
@@ -236,6 +251,8 @@ protected:
     static void updateTextureGPUVirtualMemoryUsage(Size prevObjectSize, Size newObjectSize);
     static void incrementTextureGPUTransferCount();
     static void decrementTextureGPUTransferCount();
+    static void incrementTextureGPUStreamingCount();
+    static void decrementTextureGPUStreamingCount();
 
     // Buffer and Texture Counters
     static std::atomic<uint32_t> _bufferGPUCount;
@@ -245,6 +262,7 @@ protected:
     static std::atomic<Size> _textureGPUMemoryUsage;
     static std::atomic<Size> _textureGPUVirtualMemoryUsage;
     static std::atomic<uint32_t> _textureGPUTransferCount;
+    static std::atomic<uint32_t> _textureGPUStreamingCount;
 
 
     friend class Backend;
@@ -258,6 +276,20 @@ void doInBatch(std::shared_ptr<gpu::Context> context, F f) {
     context->appendFrameBatch(batch);
 }
 
+// Records numBatches batches in parallel, f(batchIndex, batch) runs on the thread pool and the calling thread,
+// then appends them to the frame in index order as if they had been recorded one after the other.
+// Each batch has its own commands, named calls and transforms, but f must not touch anything
+// shared between the batches that isn't thread safe, such as render item payloads or PerformanceTimers.
+template<typename F>
+void doInBatches(std::shared_ptr<gpu::Context> context, int numBatches, F f) {
+    // the batches are created and destroyed on the calling thread, they update static preallocation sizes when they do
+    std::vector<gpu::Batch> batches(numBatches);
+    parallelFor(numBatches, [&](int i) {
+        f(i, batches[i]);
+    });
+    context->appendFrameBatches(batches);
+}
+
 };
 
 
@@ -90,10 +90,14 @@ namespace gpu {
     using Textures = std::vector<TexturePointer>;
     class TextureView;
     using TextureViews = std::vector<TextureView>;
+    class TextureTable;
+    using TextureTablePointer = std::shared_ptr<TextureTable>;
 
     struct StereoState {
         bool _enable{ false };
         bool _skybox{ false };
+        // draw both eyes with a single instanced draw call when the backend supports it
+        bool _instanced{ false };
         // 0 for left eye, 1 for right eye
         uint8 _pass{ 0 };
         Mat4 _eyeViews[2];
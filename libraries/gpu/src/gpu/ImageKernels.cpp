@@ -0,0 +1,367 @@
+//
+//  ImageKernels.cpp
+//  libraries/gpu/src/gpu
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ImageKernels.h"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+// The SIMD kernels do as much of a row as they can in whole vectors and return how far they got,
+// the rest of the row is done by the reference code.
+
+//
+// portable reference code
+//
+
+static const uint32_t OPAQUE_ALPHA = 255;
+static const uint32_t TRANSPARENT_ALPHA = 0;
+
+static inline uint8_t qGray8(uint32_t r, uint32_t g, uint32_t b) {
+    return (uint8_t)((r * 11 + g * 16 + b * 5) >> 5);
+}
+
+static void countAlphas_ref(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents) {
+    for (int i = 0; i < numPixels; ++i) {
+        uint32_t alpha = pixels[i] >> 24;
+        if (alpha == OPAQUE_ALPHA) {
+            numOpaques++;
+        } else if (alpha != TRANSPARENT_ALPHA) {
+            numTranslucents++;
+        }
+    }
+}
+
+static void grayFromRGB888_ref(const uint8_t* src, uint8_t* dst, int numPixels, bool invert) {
+    const uint32_t mask = invert ? 0xff : 0x00;
+    for (int i = 0; i < numPixels; ++i) {
+        dst[i] = qGray8(src[3 * i] ^ mask, src[3 * i + 1] ^ mask, src[3 * i + 2] ^ mask);
+    }
+}
+
+static void grayFromARGB32_ref(const uint32_t* src, uint8_t* dst, int numPixels, bool invert) {
+    const uint32_t mask = invert ? 0xffffffff : 0x00;
+    for (int i = 0; i < numPixels; ++i) {
+        uint32_t pixel = src[i] ^ mask;
+        dst[i] = qGray8((pixel >> 16) & 0xff, (pixel >> 8) & 0xff, pixel & 0xff);
+    }
+}
+
+// the sobel filter weighs the middle row or column twice, and the normal leans less the stronger the filter is
+static const float SOBEL_STRENGTH = 2.0f;
+static const float NORMAL_Z = 255.0f / SOBEL_STRENGTH;
+
+static inline uint8_t mapNormalComponent(float component) {
+    return (uint8_t)((component + 1.0f) * 127.5f + 0.5f);
+}
+
+static void normalsFromHeights_ref(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst,
+        int begin, int end, int width) {
+    for (int x = begin; x < end; ++x) {
+        const int prev = std::max(x - 1, 0);
+        const int next = std::min(x + 1, width - 1);
+
+        const float dX = ((float)above[next] + SOBEL_STRENGTH * (float)row[next] + (float)below[next]) -
+            ((float)above[prev] + SOBEL_STRENGTH * (float)row[prev] + (float)below[prev]);
+        const float dY = ((float)below[prev] + SOBEL_STRENGTH * (float)below[x] + (float)below[next]) -
+            ((float)above[prev] + SOBEL_STRENGTH * (float)above[x] + (float)above[next]);
+
+        const float invLength = 1.0f / sqrtf(dX * dX + dY * dY + NORMAL_Z * NORMAL_Z);
+        dst[3 * x] = mapNormalComponent(dX * invLength);
+        dst[3 * x + 1] = mapNormalComponent(dY * invLength);
+        dst[3 * x + 2] = mapNormalComponent(NORMAL_Z * invLength);
+    }
+}
+
+static void downsampleRow_ref(const uint8_t* row0, const uint8_t* row1, uint8_t* dst,
+        int begin, int dstWidth, int srcWidth, int texelSize) {
+    for (int x = begin; x < dstWidth; ++x) {
+        const int offset0 = std::min(2 * x, srcWidth - 1) * texelSize;
+        const int offset1 = std::min(2 * x + 1, srcWidth - 1) * texelSize;
+        for (int c = 0; c < texelSize; ++c) {
+            uint32_t sum = row0[offset0 + c] + row0[offset1 + c] + row1[offset0 + c] + row1[offset1 + c];
+            dst[x * texelSize + c] = (uint8_t)((sum + 2) / 4);
+        }
+    }
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static int countAlphas_SSE(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents) {
+    const __m128i opaque = _mm_set1_epi32(OPAQUE_ALPHA);
+    const __m128i transparent = _mm_set1_epi32(TRANSPARENT_ALPHA);
+
+    // the comparisons are -1 for a match, so the counts go down
+    __m128i opaques = _mm_setzero_si128();
+    __m128i transparents = _mm_setzero_si128();
+
+    int i = 0;
+    for (; i + 4 <= numPixels; i += 4) {
+        __m128i alpha = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)&pixels[i]), 24);
+        opaques = _mm_add_epi32(opaques, _mm_cmpeq_epi32(alpha, opaque));
+        transparents = _mm_add_epi32(transparents, _mm_cmpeq_epi32(alpha, transparent));
+    }
+
+    int32_t counts[2][4];
+    _mm_storeu_si128((__m128i*)counts[0], opaques);
+    _mm_storeu_si128((__m128i*)counts[1], transparents);
+    int blockOpaques = -(counts[0][0] + counts[0][1] + counts[0][2] + counts[0][3]);
+    int blockTransparents = -(counts[1][0] + counts[1][1] + counts[1][2] + counts[1][3]);
+    numOpaques += blockOpaques;
+    numTranslucents += i - blockOpaques - blockTransparents;
+    return i;
+}
+
+// there is no SSE2 shuffle for 3 byte pixels
+static int grayFromRGB888_SSE(const uint8_t* src, uint8_t* dst, int numPixels, bool invert) {
+    return 0;
+}
+
+static int grayFromARGB32_SSE(const uint32_t* src, uint8_t* dst, int numPixels, bool invert) {
+    const __m128i mask = _mm_set1_epi32(invert ? 0xffffffff : 0x00);
+    const __m128i channel = _mm_set1_epi32(0xff);
+    const __m128i redWeight = _mm_set1_epi32(11);
+    const __m128i greenWeight = _mm_set1_epi32(16);
+    const __m128i blueWeight = _mm_set1_epi32(5);
+
+    int i = 0;
+    for (; i + 8 <= numPixels; i += 8) {
+        __m128i gray[2];
+        for (int j = 0; j < 2; ++j) {
+            __m128i pixel = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&src[i + 4 * j]), mask);
+            __m128i r = _mm_and_si128(_mm_srli_epi32(pixel, 16), channel);
+            __m128i g = _mm_and_si128(_mm_srli_epi32(pixel, 8), channel);
+            __m128i b = _mm_and_si128(pixel, channel);
+
+            // the channels and their products fit in the low 16 bits of each lane
+            __m128i sum = _mm_add_epi32(_mm_mullo_epi16(r, redWeight), _mm_mullo_epi16(g, greenWeight));
+            sum = _mm_add_epi32(sum, _mm_mullo_epi16(b, blueWeight));
+            gray[j] = _mm_srli_epi32(sum, 5);
+        }
+        __m128i packed = _mm_packs_epi32(gray[0], gray[1]);
+        _mm_storel_epi64((__m128i*)&dst[i], _mm_packus_epi16(packed, packed));
+    }
+    return i;
+}
+
+static inline __m128 loadHeights_SSE(const uint8_t* heights) {
+    int32_t bytes;
+    memcpy(&bytes, heights, sizeof(bytes));
+    __m128i zero = _mm_setzero_si128();
+    __m128i words = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero);
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero));
+}
+
+static int normalsFromHeights_SSE(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width) {
+    const __m128 strength = _mm_set1_ps(SOBEL_STRENGTH);
+    const __m128 normalZ = _mm_set1_ps(NORMAL_Z);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(127.5f);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    // the first pixel is clamped, the others read up to the pixel after them
+    int x = 1;
+    for (; x + 4 < width; x += 4) {
+        __m128 abovePrev = loadHeights_SSE(&above[x - 1]);
+        __m128 aboveNext = loadHeights_SSE(&above[x + 1]);
+        __m128 belowPrev = loadHeights_SSE(&below[x - 1]);
+        __m128 belowNext = loadHeights_SSE(&below[x + 1]);
+
+        __m128 right = _mm_add_ps(_mm_add_ps(aboveNext, _mm_mul_ps(strength, loadHeights_SSE(&row[x + 1]))), belowNext);
+        __m128 left = _mm_add_ps(_mm_add_ps(abovePrev, _mm_mul_ps(strength, loadHeights_SSE(&row[x - 1]))), belowPrev);
+        __m128 bottom = _mm_add_ps(_mm_add_ps(belowPrev, _mm_mul_ps(strength, loadHeights_SSE(&below[x]))), belowNext);
+        __m128 top = _mm_add_ps(_mm_add_ps(abovePrev, _mm_mul_ps(strength, loadHeights_SSE(&above[x]))), aboveNext);
+        __m128 dX = _mm_sub_ps(right, left);
+        __m128 dY = _mm_sub_ps(bottom, top);
+
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dX, dX), _mm_mul_ps(dY, dY)), _mm_mul_ps(normalZ, normalZ));
+        __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSquared));
+
+        int32_t components[3][4];
+        _mm_storeu_si128((__m128i*)components[0],
+            _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(dX, invLength), one), scale), half)));
+        _mm_storeu_si128((__m128i*)components[1],
+            _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(dY, invLength), one), scale), half)));
+        _mm_storeu_si128((__m128i*)components[2],
+            _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(normalZ, invLength), one), scale), half)));
+        for (int j = 0; j < 4; ++j) {
+            dst[3 * (x + j)] = (uint8_t)components[0][j];
+            dst[3 * (x + j) + 1] = (uint8_t)components[1][j];
+            dst[3 * (x + j) + 2] = (uint8_t)components[2][j];
+        }
+    }
+    return x;
+}
+
+// the number of destination texels whose source texels are all inside the row
+static inline int numWholeTexels(int dstWidth, int srcWidth) {
+    return std::min(dstWidth, srcWidth / 2);
+}
+
+static int downsampleRow_SSE(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize) {
+    const int numTexels = numWholeTexels(dstWidth, srcWidth);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(2);
+
+    int x = 0;
+    if (texelSize == 4) {
+        // 4 source texels in, 2 out
+        for (; x + 2 <= numTexels; x += 2) {
+            __m128i a = _mm_loadu_si128((const __m128i*)&row0[8 * x]);
+            __m128i b = _mm_loadu_si128((const __m128i*)&row1[8 * x]);
+            __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+            __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+            low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+            high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+            __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(low, high), round), 2);
+            _mm_storel_epi64((__m128i*)&dst[4 * x], _mm_packus_epi16(sum, sum));
+        }
+    } else if (texelSize == 1) {
+        // 16 source texels in, 8 out
+        const __m128i ones = _mm_set1_epi16(1);
+        for (; x + 8 <= numTexels; x += 8) {
+            __m128i a = _mm_loadu_si128((const __m128i*)&row0[2 * x]);
+            __m128i b = _mm_loadu_si128((const __m128i*)&row1[2 * x]);
+            __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+            __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+            __m128i sum = _mm_packs_epi32(_mm_madd_epi16(low, ones), _mm_madd_epi16(high, ones));
+            sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+            _mm_storel_epi64((__m128i*)&dst[x], _mm_packus_epi16(sum, sum));
+        }
+    }
+    return x;
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+int countAlphas_AVX2(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents);
+int grayFromRGB888_AVX2(const uint8_t* src, uint8_t* dst, int numPixels, bool invert);
+int grayFromARGB32_AVX2(const uint32_t* src, uint8_t* dst, int numPixels, bool invert);
+int normalsFromHeights_AVX2(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width);
+int downsampleRow_AVX2(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize);
+
+static int countAlphas_SIMD(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents) {
+    static auto f = cpuSupportsAVX2() ? countAlphas_AVX2 : countAlphas_SSE;
+    return (*f)(pixels, numPixels, numOpaques, numTranslucents); // dispatch
+}
+
+static int grayFromRGB888_SIMD(const uint8_t* src, uint8_t* dst, int numPixels, bool invert) {
+    static auto f = cpuSupportsAVX2() ? grayFromRGB888_AVX2 : grayFromRGB888_SSE;
+    return (*f)(src, dst, numPixels, invert); // dispatch
+}
+
+static int grayFromARGB32_SIMD(const uint32_t* src, uint8_t* dst, int numPixels, bool invert) {
+    static auto f = cpuSupportsAVX2() ? grayFromARGB32_AVX2 : grayFromARGB32_SSE;
+    return (*f)(src, dst, numPixels, invert); // dispatch
+}
+
+static int normalsFromHeights_SIMD(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width) {
+    static auto f = cpuSupportsAVX2() ? normalsFromHeights_AVX2 : normalsFromHeights_SSE;
+    return (*f)(above, row, below, dst, width); // dispatch
+}
+
+static int downsampleRow_SIMD(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize) {
+    static auto f = cpuSupportsAVX2() ? downsampleRow_AVX2 : downsampleRow_SSE;
+    return (*f)(row0, row1, dst, dstWidth, srcWidth, texelSize); // dispatch
+}
+
+//
+// on ARM architecture, NEON is used when the target has it
+//
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+int countAlphas_NEON(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents);
+int grayFromRGB888_NEON(const uint8_t* src, uint8_t* dst, int numPixels, bool invert);
+int grayFromARGB32_NEON(const uint32_t* src, uint8_t* dst, int numPixels, bool invert);
+int normalsFromHeights_NEON(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width);
+int downsampleRow_NEON(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize);
+
+static int countAlphas_SIMD(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents) {
+    return countAlphas_NEON(pixels, numPixels, numOpaques, numTranslucents);
+}
+
+static int grayFromRGB888_SIMD(const uint8_t* src, uint8_t* dst, int numPixels, bool invert) {
+    return grayFromRGB888_NEON(src, dst, numPixels, invert);
+}
+
+static int grayFromARGB32_SIMD(const uint32_t* src, uint8_t* dst, int numPixels, bool invert) {
+    return grayFromARGB32_NEON(src, dst, numPixels, invert);
+}
+
+static int normalsFromHeights_SIMD(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width) {
+    return normalsFromHeights_NEON(above, row, below, dst, width);
+}
+
+static int downsampleRow_SIMD(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize) {
+    return downsampleRow_NEON(row0, row1, dst, dstWidth, srcWidth, texelSize);
+}
+
+#else   // the reference code does the whole row
+
+static int countAlphas_SIMD(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents) {
+    return 0;
+}
+
+static int grayFromRGB888_SIMD(const uint8_t* src, uint8_t* dst, int numPixels, bool invert) {
+    return 0;
+}
+
+static int grayFromARGB32_SIMD(const uint32_t* src, uint8_t* dst, int numPixels, bool invert) {
+    return 0;
+}
+
+static int normalsFromHeights_SIMD(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width) {
+    return 0;
+}
+
+static int downsampleRow_SIMD(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize) {
+    return 0;
+}
+
+#endif
+
+void gpu::countAlphas(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents) {
+    int i = countAlphas_SIMD(pixels, numPixels, numOpaques, numTranslucents);
+    countAlphas_ref(pixels + i, numPixels - i, numOpaques, numTranslucents);
+}
+
+void gpu::grayFromRGB888(const uint8_t* src, uint8_t* dst, int numPixels, bool invert) {
+    int i = grayFromRGB888_SIMD(src, dst, numPixels, invert);
+    grayFromRGB888_ref(src + 3 * i, dst + i, numPixels - i, invert);
+}
+
+void gpu::grayFromARGB32(const uint32_t* src, uint8_t* dst, int numPixels, bool invert) {
+    int i = grayFromARGB32_SIMD(src, dst, numPixels, invert);
+    grayFromARGB32_ref(src + i, dst + i, numPixels - i, invert);
+}
+
+void gpu::normalsFromHeights(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width) {
+    if (width <= 0) {
+        return;
+    }
+    normalsFromHeights_ref(above, row, below, dst, 0, 1, width);
+    int x = std::max(normalsFromHeights_SIMD(above, row, below, dst, width), 1);
+    normalsFromHeights_ref(above, row, below, dst, x, width, width);
+}
+
+void gpu::downsampleRow(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize) {
+    int x = downsampleRow_SIMD(row0, row1, dst, dstWidth, srcWidth, texelSize);
+    downsampleRow_ref(row0, row1, dst, x, dstWidth, srcWidth, texelSize);
+}
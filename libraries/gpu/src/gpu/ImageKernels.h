@@ -0,0 +1,43 @@
+//
+//  ImageKernels.h
+//  libraries/gpu/src/gpu
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_gpu_ImageKernels_h
+#define hifi_gpu_ImageKernels_h
+
+#include <stdint.h>
+
+// Kernels for the texture loaders that work on one scanline of 8 bit channels at a time.
+// Each picks an SSE2, AVX2 or NEON version for the cpu it runs on, and they all give the same result as the
+// reference code, except for the normals, where the vector square roots and multiply-adds can round a component
+// differently by one.
+namespace gpu {
+
+// adds up the pixels of a row of 32 bit ARGB pixels that are opaque, and the ones that are neither opaque nor transparent
+void countAlphas(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents);
+
+// writes the qGray() luminance of each pixel of a row of 24 bit RGB pixels (in R, G, B byte order)
+// or of 32 bit ARGB pixels, with the color inverted first when invert is set. Alpha is ignored.
+void grayFromRGB888(const uint8_t* src, uint8_t* dst, int numPixels, bool invert);
+void grayFromARGB32(const uint32_t* src, uint8_t* dst, int numPixels, bool invert);
+
+// writes a row of 24 bit RGB normals from the sobel filter of a row of heights and the rows above and below it,
+// the row is clamped at its first and last pixels
+void normalsFromHeights(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width);
+
+// writes a row of a mip from two rows of the level above it, each destination texel is the rounded mean of the 2x2
+// source texels under it. The last source texel of an odd width is averaged with itself.
+void downsampleRow(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize);
+
+}
+
+#endif
@@ -148,6 +148,11 @@ public:
     // or automatically by calling "makeShader()", this is the preferred way
     void defineSlots(const SlotSet& uniforms, const SlotSet& buffers, const SlotSet& textures, const SlotSet& samplers, const SlotSet& inputs, const SlotSet& outputs);
 
+    // The outputs of the vertex stage a program writes to a buffer with Batch::captureVertices, in the order they are
+    // interleaved there. They have to be set before the program is made.
+    void setTransformFeedbackVaryings(const std::vector<std::string>& varyings) { _transformFeedbackVaryings = varyings; }
+    const std::vector<std::string>& getTransformFeedbackVaryings() const { return _transformFeedbackVaryings; }
+
     // makeProgram(...) make a program shader ready to be used in a Batch.
     // It compiles the sub shaders, link them and defines the Slots and their bindings.
     // If the shader passed is not a program, nothing happens. 
@@ -187,6 +192,8 @@ protected:
     SlotSet _inputs;
     SlotSet _outputs;
 
+    std::vector<std::string> _transformFeedbackVaryings;
+
     // The type of the shader, the master key
     Type _type;
 
@@ -14,6 +14,7 @@
 #include <glm/gtc/constants.hpp>
 
 #include <NumericalConstants.h>
+#include <ParallelFor.h>
 
 #include "GPULogging.h"
 #include "Context.h"
@@ -27,6 +28,7 @@ int TexturePointerMetaTypeId = qRegisterMetaType<TexturePointer>();
 std::atomic<uint32_t> Texture::_textureCPUCount{ 0 };
 std::atomic<Texture::Size> Texture::_textureCPUMemoryUsage{ 0 };
 std::atomic<Texture::Size> Texture::_allowedCPUMemoryUsage { 0 };
+std::atomic<Texture::Size> Texture::_allowedGPUTransferPerFrame { MB_TO_BYTES(8) };
 
 void Texture::updateTextureCPUMemoryUsage(Size prevObjectSize, Size newObjectSize) {
     if (prevObjectSize == newObjectSize) {
@@ -63,6 +65,10 @@ uint32_t Texture::getTextureGPUTransferCount() {
     return Context::getTextureGPUTransferCount();
 }
 
+uint32_t Texture::getTextureGPUStreamingCount() {
+    return Context::getTextureGPUStreamingCount();
+}
+
 Texture::Size Texture::getAllowedGPUMemoryUsage() {
     return _allowedCPUMemoryUsage;
 }
@@ -72,6 +78,14 @@ void Texture::setAllowedGPUMemoryUsage(Size size) {
     _allowedCPUMemoryUsage = size;
 }
 
+Texture::Size Texture::getAllowedGPUTransferPerFrame() {
+    return _allowedGPUTransferPerFrame;
+}
+
+void Texture::setAllowedGPUTransferPerFrame(Size size) {
+    _allowedGPUTransferPerFrame = size;
+}
+
 uint8 Texture::NUM_FACES_PER_TYPE[NUM_TYPES] = { 1, 1, 1, 6 };
 
 Texture::Pixels::Pixels(const Element& format, Size size, const Byte* bytes) :
@@ -684,20 +698,6 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
 
     // allocate memory for calculations
     output.resize(sqOrder);
-    std::vector<float> resultR(sqOrder);
-    std::vector<float> resultG(sqOrder);
-    std::vector<float> resultB(sqOrder);
-
-    // initialize values
-    float fWt = 0.0f;
-    for(uint i=0; i < sqOrder; i++) {
-        output[i] = glm::vec3(0.0f);
-        resultR[i] = 0.0f;
-        resultG[i] = 0;
-        resultB[i] = 0;
-    }
-    std::vector<float> shBuff(sqOrder);
-    std::vector<float> shBuffB(sqOrder);
 
     // We trade accuracy for speed by breaking the image into 32x32 parts
     // and approximating the distance for all the pixels in each part to be
@@ -709,22 +709,36 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
     int stride = width / numDivisionsPerSide;
     int halfStride = stride / 2;
 
-    // for each face of cube texture
-    for(int face=0; face < gpu::Texture::NUM_CUBE_FACES; face++) {
+    // step between two texels for range [0, 1]
+    float invWidth = 1.0f / float(width);
+    // initial negative bound for range [-1, 1]
+    float negativeBound = -1.0f + invWidth;
+    // step between two texels for range [-1, 1]
+    float invWidthBy2 = 2.0f / float(width);
+
+    // the faces are projected in parallel, each into sums of its own, which are added up in face order after
+    struct FaceSums {
+        std::vector<float> resultR;
+        std::vector<float> resultG;
+        std::vector<float> resultB;
+        float fWt { 0.0f };
+    };
+    std::vector<FaceSums> faceSums(gpu::Texture::NUM_CUBE_FACES);
+
+    parallelFor(gpu::Texture::NUM_CUBE_FACES, [&](int face) {
+        FaceSums& sums = faceSums[face];
+        sums.resultR.assign(sqOrder, 0.0f);
+        sums.resultG.assign(sqOrder, 0.0f);
+        sums.resultB.assign(sqOrder, 0.0f);
+        std::vector<float> shBuff(sqOrder);
+        std::vector<float> shBuffB(sqOrder);
 
         auto numComponents = cubeTexture.accessStoredMipFace(0,face)->getFormat().getScalarCount();
         auto data = cubeTexture.accessStoredMipFace(0,face)->readData();
         if (data == nullptr) {
-            continue;
+            return;
         }
 
-        // step between two texels for range [0, 1]
-        float invWidth = 1.0f / float(width);
-        // initial negative bound for range [-1, 1]
-        float negativeBound = -1.0f + invWidth;
-        // step between two texels for range [-1, 1]
-        float invWidthBy2 = 2.0f / float(width);
-
         for(int y=halfStride; y < width-halfStride; y += stride) {
             // texture coordinate V in range [-1 to 1]
             const float fV = negativeBound + float(y) * invWidthBy2;
@@ -776,8 +790,6 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                     dir.z = - 1.0f;
                     break;
                 }
-                default:
-                    return false;
                 }
 
                 // normalize direction
@@ -786,23 +798,22 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                 // scale factor depending on distance from center of the face
                 const float fDiffSolid = 4.0f / ((1.0f + fU*fU + fV*fV) *
                                             sqrtf(1.0f + fU*fU + fV*fV));
-                fWt += fDiffSolid;
+                sums.fWt += fDiffSolid;
 
                 // calculate coefficients of spherical harmonics for current direction
                 sphericalHarmonicsEvaluateDirection(shBuff.data(), order, dir);
 
-                // index of texel in texture
-
                 // get color from texture and map to range [0, 1]
+                // the part is walked a row at a time, so that its texels are read in the order they are stored
                 float red { 0.0f };
                 float green { 0.0f };
                 float blue { 0.0f };
-                for (int i = 0; i < stride; ++i) {
-                    for (int j = 0; j < stride; ++j) {
-                        int k = (int)(x + i - halfStride + (y + j - halfStride) * width) * numComponents;
-                        red += ColorUtils::sRGB8ToLinearFloat(data[k]);
-                        green += ColorUtils::sRGB8ToLinearFloat(data[k + 1]);
-                        blue += ColorUtils::sRGB8ToLinearFloat(data[k + 2]);
+                for (int j = 0; j < stride; ++j) {
+                    const uint8_t* texel = data + (x - halfStride + (y + j - halfStride) * width) * numComponents;
+                    for (int i = 0; i < stride; ++i, texel += numComponents) {
+                        red += ColorUtils::sRGB8ToLinearFloat(texel[0]);
+                        green += ColorUtils::sRGB8ToLinearFloat(texel[1]);
+                        blue += ColorUtils::sRGB8ToLinearFloat(texel[2]);
                     }
                 }
                 glm::vec3 clr(red, green, blue);
@@ -810,15 +821,26 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                 // scale color and add to previously accumulated coefficients
                 // red
                 sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), clr.r * fDiffSolid);
-                sphericalHarmonicsAdd(resultR.data(), order, resultR.data(), shBuffB.data());
+                sphericalHarmonicsAdd(sums.resultR.data(), order, sums.resultR.data(), shBuffB.data());
                 // green
                 sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), clr.g * fDiffSolid);
-                sphericalHarmonicsAdd(resultG.data(), order, resultG.data(), shBuffB.data());
+                sphericalHarmonicsAdd(sums.resultG.data(), order, sums.resultG.data(), shBuffB.data());
                 // blue
                 sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), clr.b * fDiffSolid);
-                sphericalHarmonicsAdd(resultB.data(), order, resultB.data(), shBuffB.data());
+                sphericalHarmonicsAdd(sums.resultB.data(), order, sums.resultB.data(), shBuffB.data());
             }
         }
+    });
+
+    std::vector<float> resultR(sqOrder, 0.0f);
+    std::vector<float> resultG(sqOrder, 0.0f);
+    std::vector<float> resultB(sqOrder, 0.0f);
+    float fWt = 0.0f;
+    for (auto& sums : faceSums) {
+        sphericalHarmonicsAdd(resultR.data(), order, resultR.data(), sums.resultR.data());
+        sphericalHarmonicsAdd(resultG.data(), order, resultG.data(), sums.resultG.data());
+        sphericalHarmonicsAdd(resultB.data(), order, resultB.data(), sums.resultB.data());
+        fWt += sums.fWt;
     }
 
     // final scale for coefficients
@@ -888,6 +910,22 @@ bool Texture::incremementMinMip(uint16 count) {
     return setMinMip(_minMip + count);
 }
 
+void Texture::requestMinMip(uint16 mip) const {
+    uint16 requested = _requestedMinMip.load();
+    while (mip < requested && !_requestedMinMip.compare_exchange_weak(requested, mip)) {
+    }
+}
+
+void Texture::requestMinMipForScreenSize(float screenSize) const {
+    float largestDimension = (float)std::max(_width, _height);
+    if (screenSize >= largestDimension) {
+        requestMinMip(0);
+        return;
+    }
+    float mip = floorf(log2f(largestDimension / std::max(screenSize, 1.0f)));
+    requestMinMip((uint16)std::min(mip, (float)_maxMip));
+}
+
 Vec3u Texture::evalMipDimensions(uint16 level) const { 
     auto dimensions = getDimensions();
     dimensions >>= level; 
@@ -12,6 +12,7 @@
 #define hifi_gpu_Texture_h
 
 #include <algorithm> //min max and more
+#include <atomic>
 #include <bitset>
 
 #include <QMetaType>
@@ -143,6 +144,7 @@ class Texture : public Resource {
     static std::atomic<uint32_t> _textureCPUCount;
     static std::atomic<Size> _textureCPUMemoryUsage;
     static std::atomic<Size> _allowedCPUMemoryUsage;
+    static std::atomic<Size> _allowedGPUTransferPerFrame;
     static void updateTextureCPUMemoryUsage(Size prevObjectSize, Size newObjectSize);
 public:
     static uint32_t getTextureCPUCount();
@@ -151,8 +153,12 @@ public:
     static Size getTextureGPUMemoryUsage();
     static Size getTextureGPUVirtualMemoryUsage();
     static uint32_t getTextureGPUTransferCount();
+    static uint32_t getTextureGPUStreamingCount();
     static Size getAllowedGPUMemoryUsage();
     static void setAllowedGPUMemoryUsage(Size size);
+    // The bytes of texture mips the backend uploads in a frame, a texture larger than that still goes in one frame
+    static Size getAllowedGPUTransferPerFrame();
+    static void setAllowedGPUTransferPerFrame(Size size);
 
     class Usage {
     public:
@@ -436,6 +442,8 @@ public:
 
     // For Cube Texture, it's possible to generate the irradiance spherical harmonics and make them availalbe with the texture
     bool generateIrradiance();
+    // or assign harmonics that were generated before, as when the texture is read back from a TextureContainer
+    void assignIrradiance(const SphericalHarmonics& irradiance) { _irradiance = std::make_shared<SphericalHarmonics>(irradiance); }
     const SHPointer& getIrradiance(uint16 slice = 0) const { return _irradiance; }
     bool isIrradianceValid() const { return _isIrradianceValid; }
 
@@ -444,8 +452,21 @@ public:
     const Sampler& getSampler() const { return _sampler; }
     Stamp getSamplerStamp() const { return _samplerStamp; }
 
+    // The renderer requests the finest mip it needs of the texture each frame it draws with it,
+    // the backend streams the mips in and out of gpu memory towards the requests
+    static const uint16 NO_MIP_REQUESTED { (uint16)-1 };
+    void requestMinMip(uint16 mip) const;
+    // Request the mip that has about one texel per pixel when the texture spans screenSize pixels
+    void requestMinMipForScreenSize(float screenSize) const;
+
     // Only callable by the Backend
     void notifyMipFaceGPULoaded(uint16 level, uint8 face = 0) const { return _storage->notifyMipFaceGPULoaded(level, face); }
+    // Returns the finest mip requested since the last call, or NO_MIP_REQUESTED
+    uint16 takeRequestedMinMip() const { return _requestedMinMip.exchange(NO_MIP_REQUESTED); }
+    void notifyGPUResidentSize(Size size) const { _gpuResidentSize = size; }
+
+    // The bytes of the texture mips the backend has in gpu memory
+    Size getGPUResidentSize() const { return _gpuResidentSize.load(); }
 
     const GPUObjectPointer gpuObject {};
 
@@ -475,6 +496,8 @@ protected:
     Usage _usage;
 
     SHPointer _irradiance;
+    mutable std::atomic<uint16> _requestedMinMip { NO_MIP_REQUESTED };
+    mutable std::atomic<Size> _gpuResidentSize { 0 };
     bool _autoGenerateMips = false;
     bool _isIrradianceValid = false;
     bool _defined = false;
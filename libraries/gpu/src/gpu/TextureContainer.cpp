@@ -0,0 +1,239 @@
+//
+//  TextureContainer.cpp
+//  libraries/gpu/src/gpu
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureContainer.h"
+
+#include <memory>
+#include <string.h>
+
+#include <QtCore/QDataStream>
+
+#include "GPULogging.h"
+#include "ImageKernels.h"
+
+using namespace gpu;
+
+static const char CONTAINER_MAGIC[4] = { 'H', 'F', 'T', 'X' };
+static const quint32 CONTAINER_VERSION = 1;
+
+struct MipFace {
+    Element format;
+    std::vector<Byte> bytes;
+};
+
+static void writeElement(QDataStream& stream, const Element& element) {
+    stream << (quint8)element.getDimension() << (quint8)element.getType() << (quint8)element.getSemantic();
+}
+
+static Element readElement(QDataStream& stream) {
+    quint8 dimension, type, semantic;
+    stream >> dimension >> type >> semantic;
+    if (dimension >= NUM_DIMENSIONS || type >= NUM_TYPES || semantic >= NUM_SEMANTICS) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return Element();
+    }
+    return Element((Dimension)dimension, (Type)type, (Semantic)semantic);
+}
+
+// Halves a mip of 8 bit channels, the last row or column of an odd size is averaged with itself
+static MipFace downsampleMip(const Byte* bytes, uint32 pitch, uint16 width, uint16 height,
+        uint16 mipWidth, uint16 mipHeight, const Element& format) {
+    const uint32 texelSize = format.getSize();
+    MipFace mip;
+    mip.format = format;
+    mip.bytes.resize(mipWidth * mipHeight * texelSize);
+
+    for (uint16 y = 0; y < mipHeight; ++y) {
+        const Byte* row0 = bytes + std::min(2 * y, height - 1) * pitch;
+        const Byte* row1 = bytes + std::min(2 * y + 1, height - 1) * pitch;
+        downsampleRow(row0, row1, mip.bytes.data() + y * mipWidth * texelSize, mipWidth, width, texelSize);
+    }
+    return mip;
+}
+
+QByteArray TextureContainer::serialize(const Texture& texture) {
+    if (!texture.isDefined() || (texture.getType() != Texture::TEX_2D && texture.getType() != Texture::TEX_CUBE)) {
+        return QByteArray();
+    }
+
+    const uint8 numFaces = texture.getNumFaces();
+    const uint16 numMips = texture.isAutogenerateMips() ? texture.evalNumMips() : texture.maxMip() + 1;
+
+    // mips[level * numFaces + face]
+    std::vector<MipFace> mips;
+    mips.reserve(numMips * numFaces);
+    for (uint16 level = 0; level < numMips; ++level) {
+        for (uint8 face = 0; face < numFaces; ++face) {
+            if (texture.isStoredMipFaceAvailable(level, face)) {
+                auto pixels = texture.accessStoredMipFace(level, face);
+                MipFace mip;
+                mip.format = pixels->getFormat();
+                mip.bytes.assign(pixels->readData(), pixels->readData() + pixels->getSize());
+                mips.push_back(std::move(mip));
+                continue;
+            }
+
+            if (level == 0 || !texture.isAutogenerateMips()) {
+                return QByteArray();
+            }
+
+            const MipFace& parent = mips[(level - 1) * numFaces + face];
+            const Element& format = parent.format;
+            if (format.isCompressed() || (format.getType() != NUINT8 && format.getType() != UINT8)) {
+                return QByteArray();
+            }
+
+            // a mip straight from a QImage can have its rows padded out to 32 bits
+            uint16 parentWidth = texture.evalMipWidth(level - 1);
+            uint16 parentHeight = texture.evalMipHeight(level - 1);
+            uint32 pitch = (uint32)parent.bytes.size() / parentHeight;
+            if (pitch < parentWidth * format.getSize()) {
+                return QByteArray();
+            }
+            mips.push_back(downsampleMip(parent.bytes.data(), pitch, parentWidth, parentHeight,
+                texture.evalMipWidth(level), texture.evalMipHeight(level), format));
+        }
+    }
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    stream.writeRawData(CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC));
+    stream << CONTAINER_VERSION;
+
+    stream << (quint8)texture.getType() << texture.getWidth() << texture.getHeight();
+    writeElement(stream, texture.getTexelFormat());
+    stream << (quint32)texture.getUsage()._flags.to_ulong();
+
+    const Sampler& sampler = texture.getSampler();
+    const glm::vec4& borderColor = sampler.getBorderColor();
+    stream << borderColor.x << borderColor.y << borderColor.z << borderColor.w << sampler.getMaxAnisotropy();
+    stream << (quint8)sampler.getFilter() << (quint8)sampler.getComparisonFunction();
+    stream << (quint8)sampler.getWrapModeU() << (quint8)sampler.getWrapModeV() << (quint8)sampler.getWrapModeW();
+    stream << sampler.getMipOffset() << sampler.getMinMip() << sampler.getMaxMip();
+
+    const auto& irradiance = texture.getIrradiance();
+    stream << (quint8)(irradiance ? 1 : 0);
+    if (irradiance) {
+        const glm::vec3* coefficients[SphericalHarmonics::NUM_COEFFICIENTS] = {
+            &irradiance->L00, &irradiance->L1m1, &irradiance->L10, &irradiance->L11,
+            &irradiance->L2m2, &irradiance->L2m1, &irradiance->L20, &irradiance->L21, &irradiance->L22
+        };
+        for (auto coefficient : coefficients) {
+            stream << coefficient->x << coefficient->y << coefficient->z;
+        }
+    }
+
+    stream << numMips;
+    for (const auto& mip : mips) {
+        writeElement(stream, mip.format);
+        stream << (quint32)mip.bytes.size();
+        stream.writeRawData((const char*)mip.bytes.data(), (int)mip.bytes.size());
+    }
+
+    return data;
+}
+
+Texture* TextureContainer::unserialize(const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    char magic[sizeof(CONTAINER_MAGIC)];
+    quint32 version = 0;
+    if (stream.readRawData(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, CONTAINER_MAGIC, sizeof(magic)) != 0) {
+        return nullptr;
+    }
+    stream >> version;
+    if (version != CONTAINER_VERSION) {
+        return nullptr;
+    }
+
+    quint8 type;
+    quint16 width, height;
+    stream >> type >> width >> height;
+    Element texelFormat = readElement(stream);
+    quint32 usageFlags;
+    stream >> usageFlags;
+
+    Sampler::Desc samplerDesc;
+    stream >> samplerDesc._borderColor.x >> samplerDesc._borderColor.y >> samplerDesc._borderColor.z >> samplerDesc._borderColor.w;
+    stream >> samplerDesc._maxAnisotropy;
+    stream >> samplerDesc._filter >> samplerDesc._comparisonFunc;
+    stream >> samplerDesc._wrapModeU >> samplerDesc._wrapModeV >> samplerDesc._wrapModeW;
+    stream >> samplerDesc._mipOffset >> samplerDesc._minMip >> samplerDesc._maxMip;
+
+    quint8 hasIrradiance;
+    stream >> hasIrradiance;
+    SphericalHarmonics irradiance;
+    if (hasIrradiance) {
+        glm::vec3* coefficients[SphericalHarmonics::NUM_COEFFICIENTS] = {
+            &irradiance.L00, &irradiance.L1m1, &irradiance.L10, &irradiance.L11,
+            &irradiance.L2m2, &irradiance.L2m1, &irradiance.L20, &irradiance.L21, &irradiance.L22
+        };
+        for (auto coefficient : coefficients) {
+            stream >> coefficient->x >> coefficient->y >> coefficient->z;
+        }
+    }
+
+    quint16 numMips;
+    stream >> numMips;
+    if (stream.status() != QDataStream::Ok || width == 0 || height == 0) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Texture> texture;
+    if (type == Texture::TEX_2D) {
+        texture.reset(Texture::create2D(texelFormat, width, height, Sampler(samplerDesc)));
+    } else if (type == Texture::TEX_CUBE) {
+        texture.reset(Texture::createCube(texelFormat, width, Sampler(samplerDesc)));
+    } else {
+        return nullptr;
+    }
+    texture->setUsage(Texture::Usage(Texture::Usage::Flags(usageFlags)));
+
+    if (numMips == 0 || numMips > texture->evalNumMips()) {
+        return nullptr;
+    }
+
+    const uint8 numFaces = texture->getNumFaces();
+    std::vector<Byte> bytes;
+    for (uint16 level = 0; level < numMips; ++level) {
+        for (uint8 face = 0; face < numFaces; ++face) {
+            Element format = readElement(stream);
+            quint32 size = 0;
+            stream >> size;
+            if (stream.status() != QDataStream::Ok || size > (quint32)(data.size() - stream.device()->pos())) {
+                return nullptr;
+            }
+            bytes.resize(size);
+            if (stream.readRawData((char*)bytes.data(), (int)size) != (int)size) {
+                return nullptr;
+            }
+
+            bool assigned = (type == Texture::TEX_CUBE) ?
+                texture->assignStoredMipFace(level, format, size, bytes.data(), face) :
+                texture->assignStoredMip(level, format, size, bytes.data());
+            if (!assigned) {
+                qCWarning(gpulogging) << "TextureContainer: mip" << level << "does not match its texture";
+                return nullptr;
+            }
+        }
+    }
+
+    if (hasIrradiance) {
+        texture->assignIrradiance(irradiance);
+    }
+
+    return texture.release();
+}
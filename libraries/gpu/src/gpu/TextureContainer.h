@@ -0,0 +1,42 @@
+//
+//  TextureContainer.h
+//  libraries/gpu/src/gpu
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_gpu_TextureContainer_h
+#define hifi_gpu_TextureContainer_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "Texture.h"
+
+namespace gpu {
+
+// the extension of the textures that are processed on the client, and of the ones baked ahead of time by the oven
+static const QString TEXTURE_CONTAINER_EXTENSION = ".hftx";
+
+// Lays out a processed texture with every one of its mips, in the formats they are uploaded in, so a texture
+// can be read back without decoding its image or generating its mips again.
+// Mips the texture leaves to the gpu to generate are box filtered on the cpu as it is written,
+// they can only be for the uncompressed 8 bits per channel formats the texture loaders produce.
+class TextureContainer {
+public:
+    // returns an empty array for a texture the container cannot hold
+    static QByteArray serialize(const Texture& texture);
+
+    // returns nullptr for data that was not written by serialize, or by another version of it
+    static Texture* unserialize(const QByteArray& data);
+};
+
+}
+
+#endif
@@ -0,0 +1,34 @@
+//
+//  TextureTable.cpp
+//  libraries/gpu/src/gpu
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureTable.h"
+
+#include "Texture.h"
+
+using namespace gpu;
+
+TextureTable::TextureTable() {
+}
+
+TextureTable::TextureTable(const Textures& textures) {
+    for (size_t i = 0; i < COUNT && i < textures.size(); ++i) {
+        _textures[i] = textures[i];
+    }
+}
+
+TextureTable::TextureTable(const Array& textures) : _textures(textures) {
+}
+
+void TextureTable::setTexture(size_t index, const TexturePointer& texture) {
+    if (index < COUNT) {
+        _textures[index] = texture;
+    }
+}
@@ -0,0 +1,45 @@
+//
+//  TextureTable.h
+//  libraries/gpu/src/gpu
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_gpu_TextureTable_h
+#define hifi_gpu_TextureTable_h
+
+#include <array>
+
+#include "Forward.h"
+
+namespace gpu {
+
+// A set of textures set on consecutive resource slots with a single Batch::setResourceTextureTable,
+// the slots of the null textures of the table are left as they are.
+// Each texture is bound to its slot, and a backend with bindless textures also passes the handles of the textures
+// of the slots of the table to the shaders as a uniform buffer (see TextureTable.slh).
+class TextureTable {
+public:
+    static const size_t COUNT = 8;
+    using Array = std::array<TexturePointer, COUNT>;
+
+    TextureTable();
+    TextureTable(const Textures& textures);
+    TextureTable(const Array& textures);
+
+    void setTexture(size_t index, const TexturePointer& texture);
+    const Array& getTextures() const { return _textures; }
+
+private:
+    Array _textures;
+};
+
+}
+
+#endif // hifi_gpu_TextureTable_h
@@ -0,0 +1,173 @@
+//
+//  ImageKernels_neon.cpp
+//  libraries/gpu/src/neon
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+#include <arm_neon.h>
+
+static const float SOBEL_STRENGTH = 2.0f;
+static const float NORMAL_Z = 255.0f / SOBEL_STRENGTH;
+
+static inline int horizontalSum(uint32x4_t x) {
+    uint64x2_t sum = vpaddlq_u32(x);
+    return (int)(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+}
+
+// the 32 bit ARGB pixels are in B, G, R, A byte order, so vld4 puts alpha in val[3]
+int countAlphas_NEON(const uint32_t* pixels, int numPixels, int& numOpaques, int& numTranslucents) {
+    uint32x4_t opaques = vdupq_n_u32(0);
+    uint32x4_t transparents = vdupq_n_u32(0);
+
+    int i = 0;
+    for (; i + 16 <= numPixels; i += 16) {
+        uint8x16_t alpha = vld4q_u8((const uint8_t*)&pixels[i]).val[3];
+        uint8x16_t opaque = vshrq_n_u8(vceqq_u8(alpha, vdupq_n_u8(255)), 7);
+        uint8x16_t transparent = vshrq_n_u8(vceqq_u8(alpha, vdupq_n_u8(0)), 7);
+        opaques = vpadalq_u16(opaques, vpaddlq_u8(opaque));
+        transparents = vpadalq_u16(transparents, vpaddlq_u8(transparent));
+    }
+
+    int blockOpaques = horizontalSum(opaques);
+    int blockTransparents = horizontalSum(transparents);
+    numOpaques += blockOpaques;
+    numTranslucents += i - blockOpaques - blockTransparents;
+    return i;
+}
+
+static inline uint8x8_t gray_NEON(uint8x8_t r, uint8x8_t g, uint8x8_t b) {
+    uint16x8_t sum = vmull_u8(r, vdup_n_u8(11));
+    sum = vmlal_u8(sum, g, vdup_n_u8(16));
+    sum = vmlal_u8(sum, b, vdup_n_u8(5));
+    return vshrn_n_u16(sum, 5);
+}
+
+int grayFromRGB888_NEON(const uint8_t* src, uint8_t* dst, int numPixels, bool invert) {
+    const uint8x8_t mask = vdup_n_u8(invert ? 0xff : 0x00);
+
+    int i = 0;
+    for (; i + 8 <= numPixels; i += 8) {
+        uint8x8x3_t rgb = vld3_u8(&src[3 * i]);
+        vst1_u8(&dst[i], gray_NEON(veor_u8(rgb.val[0], mask), veor_u8(rgb.val[1], mask), veor_u8(rgb.val[2], mask)));
+    }
+    return i;
+}
+
+int grayFromARGB32_NEON(const uint32_t* src, uint8_t* dst, int numPixels, bool invert) {
+    const uint8x8_t mask = vdup_n_u8(invert ? 0xff : 0x00);
+
+    int i = 0;
+    for (; i + 8 <= numPixels; i += 8) {
+        uint8x8x4_t bgra = vld4_u8((const uint8_t*)&src[i]);
+        vst1_u8(&dst[i], gray_NEON(veor_u8(bgra.val[2], mask), veor_u8(bgra.val[1], mask), veor_u8(bgra.val[0], mask)));
+    }
+    return i;
+}
+
+static inline float32x4_t loadHeights_NEON(const uint8_t* heights) {
+    uint32_t bytes;
+    memcpy(&bytes, heights, sizeof(bytes));
+    uint16x8_t words = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(bytes)));
+    return vcvtq_f32_u32(vmovl_u16(vget_low_u16(words)));
+}
+
+static inline float32x4_t invSqrt_NEON(float32x4_t x) {
+#if defined(__aarch64__)
+    return vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(x));
+#else
+    // refine the estimate twice, which brings it to within rounding of the reference
+    float32x4_t y = vrsqrteq_f32(x);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+    return y;
+#endif
+}
+
+static inline uint32x4_t mapNormalComponent_NEON(float32x4_t component) {
+    // (component + 1) * 127.5 + 0.5
+    float32x4_t mapped = vmulq_f32(vaddq_f32(component, vdupq_n_f32(1.0f)), vdupq_n_f32(127.5f));
+    return vcvtq_u32_f32(vaddq_f32(mapped, vdupq_n_f32(0.5f)));
+}
+
+int normalsFromHeights_NEON(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int width) {
+    const float32x4_t strength = vdupq_n_f32(SOBEL_STRENGTH);
+    const float32x4_t normalZ = vdupq_n_f32(NORMAL_Z);
+
+    // the first pixel is clamped, the others read up to the pixel after them
+    int x = 1;
+    for (; x + 4 < width; x += 4) {
+        float32x4_t abovePrev = loadHeights_NEON(&above[x - 1]);
+        float32x4_t aboveNext = loadHeights_NEON(&above[x + 1]);
+        float32x4_t belowPrev = loadHeights_NEON(&below[x - 1]);
+        float32x4_t belowNext = loadHeights_NEON(&below[x + 1]);
+
+        float32x4_t right = vaddq_f32(vaddq_f32(aboveNext, vmulq_f32(strength, loadHeights_NEON(&row[x + 1]))), belowNext);
+        float32x4_t left = vaddq_f32(vaddq_f32(abovePrev, vmulq_f32(strength, loadHeights_NEON(&row[x - 1]))), belowPrev);
+        float32x4_t bottom = vaddq_f32(vaddq_f32(belowPrev, vmulq_f32(strength, loadHeights_NEON(&below[x]))), belowNext);
+        float32x4_t top = vaddq_f32(vaddq_f32(abovePrev, vmulq_f32(strength, loadHeights_NEON(&above[x]))), aboveNext);
+        float32x4_t dX = vsubq_f32(right, left);
+        float32x4_t dY = vsubq_f32(bottom, top);
+
+        float32x4_t lengthSquared = vaddq_f32(vaddq_f32(vmulq_f32(dX, dX), vmulq_f32(dY, dY)), vmulq_f32(normalZ, normalZ));
+        float32x4_t invLength = invSqrt_NEON(lengthSquared);
+
+        uint8x8x3_t normals;
+        normals.val[0] = vmovn_u16(vcombine_u16(vmovn_u32(mapNormalComponent_NEON(vmulq_f32(dX, invLength))), vdup_n_u16(0)));
+        normals.val[1] = vmovn_u16(vcombine_u16(vmovn_u32(mapNormalComponent_NEON(vmulq_f32(dY, invLength))), vdup_n_u16(0)));
+        normals.val[2] = vmovn_u16(vcombine_u16(vmovn_u32(mapNormalComponent_NEON(vmulq_f32(normalZ, invLength))), vdup_n_u16(0)));
+
+        // vst3 would write 8 pixels, so the 4 are interleaved through the stack
+        uint8_t interleaved[24];
+        vst3_u8(interleaved, normals);
+        memcpy(&dst[3 * x], interleaved, 12);
+    }
+    return x;
+}
+
+int downsampleRow_NEON(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int dstWidth, int srcWidth, int texelSize) {
+    // only the destination texels whose source texels are all inside the row
+    const int numTexels = std::min(dstWidth, srcWidth / 2);
+
+    // vld2 splits the even texels from the odd ones, and vrshrn rounds the sum of the four as it halves it twice
+    int x = 0;
+    if (texelSize == 4) {
+        // 8 source texels in, 4 out
+        for (; x + 4 <= numTexels; x += 4) {
+            uint32x4x2_t a = vld2q_u32((const uint32_t*)&row0[8 * x]);
+            uint32x4x2_t b = vld2q_u32((const uint32_t*)&row1[8 * x]);
+            uint8x16_t aEven = vreinterpretq_u8_u32(a.val[0]);
+            uint8x16_t aOdd = vreinterpretq_u8_u32(a.val[1]);
+            uint8x16_t bEven = vreinterpretq_u8_u32(b.val[0]);
+            uint8x16_t bOdd = vreinterpretq_u8_u32(b.val[1]);
+            uint16x8_t low = vaddq_u16(vaddl_u8(vget_low_u8(aEven), vget_low_u8(aOdd)),
+                vaddl_u8(vget_low_u8(bEven), vget_low_u8(bOdd)));
+            uint16x8_t high = vaddq_u16(vaddl_u8(vget_high_u8(aEven), vget_high_u8(aOdd)),
+                vaddl_u8(vget_high_u8(bEven), vget_high_u8(bOdd)));
+            vst1q_u8(&dst[4 * x], vcombine_u8(vrshrn_n_u16(low, 2), vrshrn_n_u16(high, 2)));
+        }
+    } else if (texelSize == 1) {
+        // 32 source texels in, 16 out
+        for (; x + 16 <= numTexels; x += 16) {
+            uint8x16x2_t a = vld2q_u8(&row0[2 * x]);
+            uint8x16x2_t b = vld2q_u8(&row1[2 * x]);
+            uint16x8_t low = vaddq_u16(vaddl_u8(vget_low_u8(a.val[0]), vget_low_u8(a.val[1])),
+                vaddl_u8(vget_low_u8(b.val[0]), vget_low_u8(b.val[1])));
+            uint16x8_t high = vaddq_u16(vaddl_u8(vget_high_u8(a.val[0]), vget_high_u8(a.val[1])),
+                vaddl_u8(vget_high_u8(b.val[0]), vget_high_u8(b.val[1])));
+            vst1q_u8(&dst[x], vcombine_u8(vrshrn_n_u16(low, 2), vrshrn_n_u16(high, 2)));
+        }
+    }
+    return x;
+}
+
+#endif
@@ -12,12 +12,24 @@
 #include "ModelCache.h"
 #include <Finally.h>
 #include <FSTReader.h>
+#include <ParallelFor.h>
+#include "FBXContainer.h"
 #include "FBXReader.h"
 #include "OBJReader.h"
 
+#include <mutex>
+#include <string.h>
+
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QThreadPool>
 
 #include "ModelNetworkingLogging.h"
@@ -105,6 +117,7 @@ void GeometryMappingResource::onGeometryMappingLoaded(bool success) {
         _fbxGeometry = _geometryResource->_fbxGeometry;
         _meshParts = _geometryResource->_meshParts;
         _meshes = _geometryResource->_meshes;
+        _meshLODs = _geometryResource->_meshLODs;
         _materials = _geometryResource->_materials;
 
         // Avoid holding onto extra references
@@ -126,12 +139,100 @@ public:
     virtual void run() override;
 
 private:
+    // Models are kept on disk once they are read, keyed by url and mapping.
+    // An entry is only used while it was made from the same content as was downloaded this time.
+    static QString processedModelPath(const QUrl& url, const QVariantHash& mapping);
+    static FBXGeometry* readProcessedModel(const QString& path, const QByteArray& contentHash, const QUrl& url);
+    static void writeProcessedModel(const QString& path, const QByteArray& contentHash, const FBXGeometry& geometry);
+
     QWeakPointer<Resource> _resource;
     QUrl _url;
     QVariantHash _mapping;
     QByteArray _data;
 };
 
+QString GeometryReader::processedModelPath(const QUrl& url, const QVariantHash& mapping) {
+    static const QString PROCESSED_MODELS_DIRECTORY = "processedModels";
+
+    static QString directory;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        QString dataPath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+        directory = QDir(!dataPath.isEmpty() ? dataPath : "interfaceCache").absoluteFilePath(PROCESSED_MODELS_DIRECTORY);
+        QDir().mkpath(directory);
+    });
+
+    // the mapping changes the scale and the special joints, the json of it has its keys in order
+    QByteArray key = url.toEncoded() + '#' + QJsonDocument(QJsonObject::fromVariantHash(mapping)).toJson(QJsonDocument::Compact);
+    return directory + "/" + QCryptographicHash::hash(key, QCryptographicHash::Md5).toHex() + FBX_CONTAINER_EXTENSION;
+}
+
+FBXGeometry* GeometryReader::readProcessedModel(const QString& path, const QByteArray& contentHash, const QUrl& url) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() <= contentHash.size()) {
+        return nullptr;
+    }
+
+    // the container is read straight out of the mapped file, the content hash comes first
+    const qint64 size = file.size();
+    uchar* mapped = file.map(0, size);
+    if (!mapped) {
+        return nullptr;
+    }
+    Finally unmap([&] {
+        file.unmap(mapped);
+    });
+
+    if (memcmp(mapped, contentHash.constData(), contentHash.size()) != 0) {
+        return nullptr;
+    }
+    QByteArray container = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped) + contentHash.size(),
+        (int)(size - contentHash.size()));
+    return FBXContainer::unserialize(container, url.path());
+}
+
+void GeometryReader::writeProcessedModel(const QString& path, const QByteArray& contentHash, const FBXGeometry& geometry) {
+    QByteArray container = FBXContainer::serialize(geometry);
+
+    // another reader may be writing the same model, QSaveFile only replaces the entry once it is complete
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    file.write(contentHash);
+    file.write(container);
+    if (!file.commit()) {
+        qCDebug(modelnetworking) << "Could not write processed model for" << path;
+    }
+}
+
+// The triangles Model picks against, quads split the same way
+static void buildPickBVH(FBXMesh& mesh) {
+    const int INDICES_PER_TRIANGLE = 3;
+    const int INDICES_PER_QUAD = 4;
+
+    auto vertex = [&mesh](int index) {
+        return glm::vec3(mesh.modelTransform * glm::vec4(mesh.vertices.at(index), 1.0f));
+    };
+
+    std::vector<Triangle> triangles;
+    for (const FBXMeshPart& part : mesh.parts) {
+        for (int i = 0; i + INDICES_PER_QUAD <= part.quadIndices.size(); i += INDICES_PER_QUAD) {
+            glm::vec3 v0 = vertex(part.quadIndices[i]);
+            glm::vec3 v1 = vertex(part.quadIndices[i + 1]);
+            glm::vec3 v2 = vertex(part.quadIndices[i + 2]);
+            glm::vec3 v3 = vertex(part.quadIndices[i + 3]);
+            triangles.push_back({ v0, v1, v3 });
+            triangles.push_back({ v1, v2, v3 });
+        }
+        for (int i = 0; i + INDICES_PER_TRIANGLE <= part.triangleIndices.size(); i += INDICES_PER_TRIANGLE) {
+            triangles.push_back({ vertex(part.triangleIndices[i]), vertex(part.triangleIndices[i + 1]),
+                                  vertex(part.triangleIndices[i + 2]) });
+        }
+    }
+    mesh._pickBVH.build(triangles);
+}
+
 void GeometryReader::run() {
     auto originalPriority = QThread::currentThread()->priority();
     if (originalPriority == QThread::InheritPriority) {
@@ -154,20 +255,47 @@ void GeometryReader::run() {
 
         QString urlname = _url.path().toLower();
         if (!urlname.isEmpty() && !_url.path().isEmpty() &&
-            (_url.path().toLower().endsWith(".fbx") || _url.path().toLower().endsWith(".obj"))) {
+            (_url.path().toLower().endsWith(".fbx") || _url.path().toLower().endsWith(".obj") ||
+             _url.path().toLower().endsWith(FBX_CONTAINER_EXTENSION))) {
             FBXGeometry::Pointer fbxGeometry;
 
-            if (_url.path().toLower().endsWith(".fbx")) {
-                fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
-                if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
-                    throw QString("empty geometry, possibly due to an unsupported FBX version");
+            if (_url.path().toLower().endsWith(FBX_CONTAINER_EXTENSION)) {
+                // a model baked by the oven, with the mapping it was baked with already applied
+                fbxGeometry.reset(FBXContainer::unserialize(_data, _url.path()));
+                if (!fbxGeometry) {
+                    throw QString("baked model was written by another version of the oven");
                 }
-            } else if (_url.path().toLower().endsWith(".obj")) {
-                fbxGeometry.reset(OBJReader().readOBJ(_data, _mapping, _url));
             } else {
-                throw QString("unsupported format");
+                QString processedPath = processedModelPath(_url, _mapping);
+                QByteArray contentHash = QCryptographicHash::hash(_data, QCryptographicHash::Md5);
+                fbxGeometry.reset(readProcessedModel(processedPath, contentHash, _url));
+
+                if (!fbxGeometry) {
+                    if (_url.path().toLower().endsWith(".fbx")) {
+                        fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
+                        if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
+                            throw QString("empty geometry, possibly due to an unsupported FBX version");
+                        }
+                    } else if (_url.path().toLower().endsWith(".obj")) {
+                        fbxGeometry.reset(OBJReader().readOBJ(_data, _mapping, _url));
+                    } else {
+                        throw QString("unsupported format");
+                    }
+                    writeProcessedModel(processedPath, contentHash, *fbxGeometry);
+                }
             }
 
+            // The LODs and the pick BVHs are quick to build next to parsing the model, so they aren't kept with
+            // the processed model
+            auto& meshes = fbxGeometry->meshes;
+            parallelFor(meshes.size(), [&meshes](int i) {
+                FBXMesh& mesh = meshes[i];
+                if (mesh._mesh) {
+                    mesh._lods = model::buildMeshLODs(*mesh._mesh);
+                }
+                buildPickBVH(mesh);
+            });
+
             // Ensure the resource has not been deleted
             auto resource = _resource.toStrongRef();
             if (!resource) {
@@ -222,11 +350,13 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
     }
 
     std::shared_ptr<GeometryMeshes> meshes = std::make_shared<GeometryMeshes>();
+    std::shared_ptr<GeometryMeshLODs> meshLODs = std::make_shared<GeometryMeshLODs>();
     std::shared_ptr<GeometryMeshParts> parts = std::make_shared<GeometryMeshParts>();
     int meshID = 0;
     for (const FBXMesh& mesh : _fbxGeometry->meshes) {
         // Copy mesh pointers
         meshes->emplace_back(mesh._mesh);
+        meshLODs->push_back(mesh._lods);
         int partID = 0;
         for (const FBXMeshPart& part : mesh.parts) {
             // Construct local parts
@@ -236,6 +366,7 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
         meshID++;
     }
     _meshes = meshes;
+    _meshLODs = meshLODs;
     _meshParts = parts;
 
     finishedLoading(true);
@@ -290,6 +421,7 @@ const QVariantMap Geometry::getTextures() const {
 Geometry::Geometry(const Geometry& geometry) {
     _fbxGeometry = geometry._fbxGeometry;
     _meshes = geometry._meshes;
+    _meshLODs = geometry._meshLODs;
     _meshParts = geometry._meshParts;
 
     _materials.reserve(geometry._materials.size());
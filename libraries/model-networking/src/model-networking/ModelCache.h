@@ -39,6 +39,7 @@ public:
 
     // Immutable over lifetime
     using GeometryMeshes = std::vector<std::shared_ptr<const model::Mesh>>;
+    using GeometryMeshLODs = std::vector<model::MeshLODs>;
     using GeometryMeshParts = std::vector<std::shared_ptr<const MeshPart>>;
 
     // Mutable, but must retain structure of vector
@@ -46,6 +47,8 @@ public:
 
     const FBXGeometry& getFBXGeometry() const { return *_fbxGeometry; }
     const GeometryMeshes& getMeshes() const { return *_meshes; }
+    // The simplified levels of each mesh, by mesh index
+    const GeometryMeshLODs& getMeshLODs() const { return *_meshLODs; }
     const std::shared_ptr<const NetworkMaterial> getShapeMaterial(int shapeID) const;
 
     const QVariantMap getTextures() const;
@@ -60,6 +63,7 @@ protected:
     // Shared across all geometries, constant throughout lifetime
     std::shared_ptr<const FBXGeometry> _fbxGeometry;
     std::shared_ptr<const GeometryMeshes> _meshes;
+    std::shared_ptr<const GeometryMeshLODs> _meshLODs;
     std::shared_ptr<const GeometryMeshParts> _meshParts;
 
     // Copied to each geometry, mutable throughout lifetime via setTextures
@@ -110,6 +114,11 @@ public:
     void setResource(GeometryResource::Pointer resource);
 
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
+    void setLoadPriority(const QPointer<QObject>& owner, float priority) {
+        if (_resource) {
+            _resource->setLoadPriority(owner, priority);
+        }
+    }
 
 private:
     void startWatching();
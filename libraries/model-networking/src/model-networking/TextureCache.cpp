@@ -13,8 +13,13 @@
 
 #include <mutex>
 
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
 #include <QNetworkReply>
 #include <QPainter>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QRunnable>
 #include <QThreadPool>
 #include <QImageReader>
@@ -23,6 +28,7 @@
 #include <glm/gtc/random.hpp>
 
 #include <gpu/Batch.h>
+#include <gpu/TextureContainer.h>
 
 #include <shared/NsightHelpers.h>
 
@@ -171,10 +177,7 @@ NetworkTexturePointer TextureCache::getTexture(const QUrl& url, Type type, const
 }
 
 
-NetworkTexture::TextureLoaderFunc getTextureLoaderForType(NetworkTexture::Type type,
-                                                          const QVariantMap& options = QVariantMap()) {
-    using Type = NetworkTexture;
-
+NetworkTexture::TextureLoaderFunc NetworkTexture::getTextureLoaderForType(Type type, const QVariantMap& options) {
     switch (type) {
         case Type::ALBEDO_TEXTURE: {
             return model::TextureUsage::createAlbedoTextureFromImage;
@@ -229,10 +232,31 @@ NetworkTexture::TextureLoaderFunc getTextureLoaderForType(NetworkTexture::Type t
     }
 }
 
+QByteArray NetworkTexture::serializeBaked(const gpu::Texture& texture, int originalWidth, int originalHeight) {
+    QByteArray container = gpu::TextureContainer::serialize(texture);
+    if (container.isEmpty()) {
+        return QByteArray();
+    }
+    qint32 size[2] = { originalWidth, originalHeight };
+    return QByteArray((const char*)size, sizeof(size)) + container;
+}
+
+gpu::Texture* NetworkTexture::unserializeBaked(const QByteArray& data, int& originalWidth, int& originalHeight) {
+    qint32 size[2];
+    if (data.size() <= (int)sizeof(size)) {
+        return nullptr;
+    }
+    memcpy(size, data.constData(), sizeof(size));
+    originalWidth = size[0];
+    originalHeight = size[1];
+    return gpu::TextureContainer::unserialize(QByteArray::fromRawData(data.constData() + sizeof(size),
+        data.size() - (int)sizeof(size)));
+}
+
 /// Returns a texture version of an image file
 gpu::TexturePointer TextureCache::getImageTexture(const QString& path, Type type, QVariantMap options) {
     QImage image = QImage(path);
-    auto loader = getTextureLoaderForType(type, options);
+    auto loader = NetworkTexture::getTextureLoaderForType(type, options);
     return gpu::TexturePointer(loader(image, QUrl::fromLocalFile(path).fileName().toStdString()));
 }
 
@@ -287,6 +311,16 @@ public:
 private:
     static void listSupportedImageFormats();
 
+    // Textures are processed once and kept on disk with their mips, keyed by url and type.
+    // An entry is only used while it was made from the same content as was downloaded this time.
+    static QString processedTexturePath(const QUrl& url, NetworkTexture::Type type);
+    static gpu::Texture* readProcessedTexture(const QString& path, const QByteArray& contentHash,
+        int& originalWidth, int& originalHeight);
+    static void writeProcessedTexture(const QString& path, const QByteArray& contentHash,
+        const gpu::Texture& texture, int originalWidth, int originalHeight);
+
+    void setImage(const gpu::TexturePointer& texture, int originalWidth, int originalHeight);
+
     QWeakPointer<Resource> _resource;
     QUrl _url;
     QByteArray _content;
@@ -317,6 +351,73 @@ void ImageReader::listSupportedImageFormats() {
     });
 }
 
+QString ImageReader::processedTexturePath(const QUrl& url, NetworkTexture::Type type) {
+    static const QString PROCESSED_TEXTURES_DIRECTORY = "processedTextures";
+
+    static QString directory;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        QString dataPath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+        directory = QDir(!dataPath.isEmpty() ? dataPath : "interfaceCache").absoluteFilePath(PROCESSED_TEXTURES_DIRECTORY);
+        QDir().mkpath(directory);
+    });
+
+    QByteArray key = url.toEncoded() + '#' + QByteArray::number((int)type);
+    return directory + "/" + QCryptographicHash::hash(key, QCryptographicHash::Md5).toHex() + gpu::TEXTURE_CONTAINER_EXTENSION;
+}
+
+gpu::Texture* ImageReader::readProcessedTexture(const QString& path, const QByteArray& contentHash,
+        int& originalWidth, int& originalHeight) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    // the content hash and original size come first, then the TextureContainer
+    const int HEADER_SIZE = contentHash.size() + 2 * sizeof(qint32);
+    QByteArray header = file.read(HEADER_SIZE);
+    if (header.size() != HEADER_SIZE || !header.startsWith(contentHash)) {
+        return nullptr;
+    }
+    memcpy(&originalWidth, header.constData() + contentHash.size(), sizeof(qint32));
+    memcpy(&originalHeight, header.constData() + contentHash.size() + sizeof(qint32), sizeof(qint32));
+
+    return gpu::TextureContainer::unserialize(file.readAll());
+}
+
+void ImageReader::writeProcessedTexture(const QString& path, const QByteArray& contentHash,
+        const gpu::Texture& texture, int originalWidth, int originalHeight) {
+    QByteArray container = gpu::TextureContainer::serialize(texture);
+    if (container.isEmpty()) {
+        return;
+    }
+
+    // another reader may be writing the same texture, QSaveFile only replaces the entry once it is complete
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    qint32 size[2] = { originalWidth, originalHeight };
+    file.write(contentHash);
+    file.write((const char*)size, sizeof(size));
+    file.write(container);
+    if (!file.commit()) {
+        qCDebug(modelnetworking) << "Could not write processed texture for" << path;
+    }
+}
+
+void ImageReader::setImage(const gpu::TexturePointer& texture, int originalWidth, int originalHeight) {
+    // Ensure the resource has not been deleted
+    auto resource = _resource.toStrongRef();
+    if (!resource) {
+        qCWarning(modelnetworking) << "Abandoning load of" << _url << "; could not get strong ref";
+    } else {
+        QMetaObject::invokeMethod(resource.data(), "setImage",
+            Q_ARG(gpu::TexturePointer, texture),
+            Q_ARG(int, originalWidth), Q_ARG(int, originalHeight));
+    }
+}
+
 void ImageReader::run() {
     PROFILE_RANGE_EX(__FUNCTION__, 0xffff0000, nullptr);
     auto originalPriority = QThread::currentThread()->priority();
@@ -328,11 +429,46 @@ void ImageReader::run() {
         QThread::currentThread()->setPriority(originalPriority);
     });
 
-    if (!_resource.data()) {
-        qCWarning(modelnetworking) << "Abandoning load of" << _url << "; could not get strong ref";
+    NetworkTexture::Type type;
+    {
+        auto resource = _resource.toStrongRef();
+        if (!resource) {
+            qCWarning(modelnetworking) << "Abandoning load of" << _url << "; could not get strong ref";
+            return;
+        }
+        type = resource.staticCast<NetworkTexture>()->getTextureType();
+    }
+
+    // a texture baked by the oven has been through its loader already
+    if (_url.path().toLower().endsWith(gpu::TEXTURE_CONTAINER_EXTENSION)) {
+        int originalWidth = 0;
+        int originalHeight = 0;
+        gpu::TexturePointer texture(NetworkTexture::unserializeBaked(_content, originalWidth, originalHeight));
+        if (!texture) {
+            qCDebug(modelnetworking) << "Baked texture was written by another version of the oven:" << _url;
+            return;
+        }
+        setImage(texture, originalWidth, originalHeight);
         return;
     }
 
+    // A custom loader is not known by the type, so only the textures of the standard loaders are kept
+    QString processedPath;
+    QByteArray contentHash;
+    if (type != NetworkTexture::CUSTOM_TEXTURE) {
+        PROFILE_RANGE_EX(__FUNCTION__"::readProcessedTexture", 0xff00ff00, nullptr);
+        processedPath = processedTexturePath(_url, type);
+        contentHash = QCryptographicHash::hash(_content, QCryptographicHash::Md5);
+
+        int originalWidth = 0;
+        int originalHeight = 0;
+        gpu::TexturePointer texture(readProcessedTexture(processedPath, contentHash, originalWidth, originalHeight));
+        if (texture) {
+            setImage(texture, originalWidth, originalHeight);
+            return;
+        }
+    }
+
     listSupportedImageFormats();
 
     // Help the QImage loader by extracting the image file format from the url filename ext.
@@ -370,15 +506,12 @@ void ImageReader::run() {
         texture.reset(resource.dynamicCast<NetworkTexture>()->getTextureLoader()(image, url));
     }
 
-    // Ensure the resource has not been deleted
-    auto resource = _resource.toStrongRef();
-    if (!resource) {
-        qCWarning(modelnetworking) << "Abandoning load of" << _url << "; could not get strong ref";
-    } else {
-        QMetaObject::invokeMethod(resource.data(), "setImage",
-            Q_ARG(gpu::TexturePointer, texture),
-            Q_ARG(int, originalWidth), Q_ARG(int, originalHeight));
+    if (texture && !processedPath.isEmpty()) {
+        PROFILE_RANGE_EX(__FUNCTION__"::writeProcessedTexture", 0xff00ff00, nullptr);
+        writeProcessedTexture(processedPath, contentHash, *texture, originalWidth, originalHeight);
     }
+
+    setImage(texture, originalWidth, originalHeight);
 }
 
 void NetworkTexture::setImage(gpu::TexturePointer texture, int originalWidth,
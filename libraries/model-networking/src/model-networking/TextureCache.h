@@ -68,8 +68,18 @@ public:
     int getWidth() const { return _width; }
     int getHeight() const { return _height; }
     
+    Type getTextureType() const { return _type; }
     TextureLoaderFunc getTextureLoader() const;
 
+    /// Returns the loader that processes the images of a type of texture, for any type but a custom one
+    static TextureLoaderFunc getTextureLoaderForType(Type type, const QVariantMap& options = QVariantMap());
+
+    /// A texture baked by the oven is the original size of its image, then the gpu::TextureContainer of it.
+    /// Returns an empty array for a texture the container cannot hold.
+    static QByteArray serializeBaked(const gpu::Texture& texture, int originalWidth, int originalHeight);
+    /// Returns nullptr for data that is not a baked texture of this version
+    static gpu::Texture* unserializeBaked(const QByteArray& data, int& originalWidth, int& originalHeight);
+
 signals:
     void networkTextureCreated(const QWeakPointer<NetworkTexture>& self);
 
@@ -0,0 +1,386 @@
+//
+//  MeshLOD.cpp
+//  libraries/model/src/model
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshLOD.h"
+
+#include <algorithm>
+#include <iterator>
+#include <queue>
+#include <unordered_map>
+
+using namespace model;
+
+static const size_t MIN_LOD_TRIANGLES = 256;
+static const int NUM_LOD_LEVELS = 3;
+
+// a level has to have at most this fraction of the triangles of the one before it to be worth drawing instead
+static const float MAX_LOD_REDUCTION = 0.75f;
+
+// a collapse may not turn any of the triangles around it by more than ~78 degrees, or fold them over
+static const float MIN_NORMAL_DOT = 0.2f;
+
+static const uint32_t NO_PART = (uint32_t)-1;
+
+namespace {
+
+// The sum of the squared distances to a set of planes, as the upper half of a symmetric 4x4 matrix
+class Quadric {
+public:
+    Quadric() {}
+    Quadric(const glm::dvec3& n, double d, double weight) :
+        _a2(weight * n.x * n.x), _ab(weight * n.x * n.y), _ac(weight * n.x * n.z), _ad(weight * n.x * d),
+        _b2(weight * n.y * n.y), _bc(weight * n.y * n.z), _bd(weight * n.y * d),
+        _c2(weight * n.z * n.z), _cd(weight * n.z * d),
+        _d2(weight * d * d) {}
+
+    Quadric& operator+=(const Quadric& other) {
+        _a2 += other._a2; _ab += other._ab; _ac += other._ac; _ad += other._ad;
+        _b2 += other._b2; _bc += other._bc; _bd += other._bd;
+        _c2 += other._c2; _cd += other._cd;
+        _d2 += other._d2;
+        return *this;
+    }
+
+    double evaluate(const glm::vec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        return _a2 * x * x + 2.0 * _ab * x * y + 2.0 * _ac * x * z + 2.0 * _ad * x +
+            _b2 * y * y + 2.0 * _bc * y * z + 2.0 * _bd * y +
+            _c2 * z * z + 2.0 * _cd * z +
+            _d2;
+    }
+
+private:
+    double _a2 { 0.0 }, _ab { 0.0 }, _ac { 0.0 }, _ad { 0.0 };
+    double _b2 { 0.0 }, _bc { 0.0 }, _bd { 0.0 };
+    double _c2 { 0.0 }, _cd { 0.0 };
+    double _d2 { 0.0 };
+};
+
+// Moving one vertex onto another, valid as long as neither has changed since the cost was taken
+class Collapse {
+public:
+    float cost;
+    uint32_t from;
+    uint32_t to;
+    uint32_t fromVersion;
+    uint32_t toVersion;
+
+    // the queue pops its largest element, and the cheapest collapse should come first
+    bool operator<(const Collapse& other) const { return cost > other.cost; }
+};
+
+class Simplifier {
+public:
+    Simplifier(std::vector<glm::vec3>&& positions, std::vector<uint32_t>&& triangles,
+        const std::vector<uint32_t>& triangleParts);
+
+    size_t getNumTriangles() const { return _numTriangles; }
+    const std::vector<uint32_t>& getTriangles() const { return _triangles; }
+    bool isRemoved(size_t triangle) const { return _removed[triangle] != 0; }
+
+    // collapses the cheapest edges until there are at most targetTriangles left, or nothing more can go
+    void simplify(size_t targetTriangles);
+
+private:
+    void queueCollapses(uint32_t vertex);
+    void queueCollapse(uint32_t from, uint32_t to);
+    bool canCollapse(uint32_t from, uint32_t to) const;
+    void collapse(uint32_t from, uint32_t to);
+    void gatherNeighbors(uint32_t vertex, std::vector<uint32_t>& neighbors) const;
+
+    std::vector<glm::vec3> _positions;
+    std::vector<uint32_t> _triangles;
+    std::vector<uint8_t> _removed;
+    size_t _numTriangles { 0 };
+
+    std::vector<Quadric> _quadrics;
+    std::vector<uint8_t> _locked;
+    std::vector<uint32_t> _versions;
+    std::vector<std::vector<uint32_t>> _vertexTriangles;
+
+    std::priority_queue<Collapse> _collapses;
+};
+
+Simplifier::Simplifier(std::vector<glm::vec3>&& positions, std::vector<uint32_t>&& triangles,
+        const std::vector<uint32_t>& triangleParts) :
+    _positions(std::move(positions)),
+    _triangles(std::move(triangles))
+{
+    const size_t numVertices = _positions.size();
+    _numTriangles = _triangles.size() / 3;
+    _removed.resize(_numTriangles, 0);
+    _quadrics.resize(numVertices);
+    _locked.resize(numVertices, 0);
+    _versions.resize(numVertices, 0);
+    _vertexTriangles.resize(numVertices);
+
+    // an edge used by a single triangle is an open border, which is also where the normals or texture coordinates
+    // are split, and an edge used by more is not manifold, neither can be moved without tearing the surface
+    std::unordered_map<uint64_t, int> edgeCounts;
+    edgeCounts.reserve(_triangles.size());
+    std::vector<uint32_t> vertexParts(numVertices, NO_PART);
+    for (size_t t = 0; t < _numTriangles; ++t) {
+        const uint32_t* corners = &_triangles[3 * t];
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = corners[k];
+            uint32_t w = corners[(k + 1) % 3];
+            uint64_t key = ((uint64_t)std::min(v, w) << 32) | std::max(v, w);
+            ++edgeCounts[key];
+
+            // the vertices shared between parts hold the borders between their materials
+            if (vertexParts[v] == NO_PART) {
+                vertexParts[v] = triangleParts[t];
+            } else if (vertexParts[v] != triangleParts[t]) {
+                _locked[v] = 1;
+            }
+            _vertexTriangles[v].push_back((uint32_t)t);
+        }
+
+        // weigh each plane by the area of its triangle, so the many small triangles of a detail don't outweigh a face
+        const glm::dvec3 p0(_positions[corners[0]]);
+        glm::dvec3 normal = glm::cross(glm::dvec3(_positions[corners[1]]) - p0, glm::dvec3(_positions[corners[2]]) - p0);
+        double length = glm::length(normal);
+        if (length > 0.0) {
+            normal /= length;
+            Quadric quadric(normal, -glm::dot(normal, p0), 0.5 * length);
+            for (int k = 0; k < 3; ++k) {
+                _quadrics[corners[k]] += quadric;
+            }
+        }
+    }
+    for (const auto& edge : edgeCounts) {
+        if (edge.second != 2) {
+            _locked[(uint32_t)(edge.first >> 32)] = 1;
+            _locked[(uint32_t)(edge.first & 0xffffffff)] = 1;
+        }
+    }
+
+    for (uint32_t v = 0; v < (uint32_t)numVertices; ++v) {
+        queueCollapses(v);
+    }
+}
+
+void Simplifier::gatherNeighbors(uint32_t vertex, std::vector<uint32_t>& neighbors) const {
+    neighbors.clear();
+    for (uint32_t t : _vertexTriangles[vertex]) {
+        if (_removed[t]) {
+            continue;
+        }
+        for (int k = 0; k < 3; ++k) {
+            uint32_t w = _triangles[3 * t + k];
+            if (w != vertex) {
+                neighbors.push_back(w);
+            }
+        }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+}
+
+void Simplifier::queueCollapses(uint32_t vertex) {
+    std::vector<uint32_t> neighbors;
+    gatherNeighbors(vertex, neighbors);
+    for (uint32_t w : neighbors) {
+        queueCollapse(vertex, w);
+        queueCollapse(w, vertex);
+    }
+}
+
+void Simplifier::queueCollapse(uint32_t from, uint32_t to) {
+    if (_locked[from]) {
+        return;
+    }
+    Quadric quadric = _quadrics[from];
+    quadric += _quadrics[to];
+    _collapses.push({ (float)quadric.evaluate(_positions[to]), from, to, _versions[from], _versions[to] });
+}
+
+bool Simplifier::canCollapse(uint32_t from, uint32_t to) const {
+    // the vertices may only share the neighbors across the triangles of their edge, or the surface would pinch
+    std::vector<uint32_t> fromNeighbors;
+    std::vector<uint32_t> toNeighbors;
+    gatherNeighbors(from, fromNeighbors);
+    gatherNeighbors(to, toNeighbors);
+    std::vector<uint32_t> shared;
+    std::set_intersection(fromNeighbors.begin(), fromNeighbors.end(), toNeighbors.begin(), toNeighbors.end(),
+        std::back_inserter(shared));
+
+    size_t numEdgeTriangles = 0;
+    const glm::vec3& target = _positions[to];
+    for (uint32_t t : _vertexTriangles[from]) {
+        if (_removed[t]) {
+            continue;
+        }
+        const uint32_t* corners = &_triangles[3 * t];
+        if (corners[0] == to || corners[1] == to || corners[2] == to) {
+            ++numEdgeTriangles;
+            continue;
+        }
+
+        // the triangles that stay must keep facing the way they did
+        glm::vec3 p[3];
+        glm::vec3 q[3];
+        for (int k = 0; k < 3; ++k) {
+            p[k] = _positions[corners[k]];
+            q[k] = (corners[k] == from) ? target : p[k];
+        }
+        glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+        glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+        float beforeLength = glm::length(before);
+        float afterLength = glm::length(after);
+        if (afterLength == 0.0f) {
+            return false;
+        }
+        if (beforeLength > 0.0f && glm::dot(before, after) < MIN_NORMAL_DOT * beforeLength * afterLength) {
+            return false;
+        }
+    }
+    return numEdgeTriangles > 0 && shared.size() == numEdgeTriangles;
+}
+
+void Simplifier::collapse(uint32_t from, uint32_t to) {
+    for (uint32_t t : _vertexTriangles[from]) {
+        if (_removed[t]) {
+            continue;
+        }
+        uint32_t* corners = &_triangles[3 * t];
+        if (corners[0] == to || corners[1] == to || corners[2] == to) {
+            _removed[t] = 1;
+            --_numTriangles;
+        } else {
+            for (int k = 0; k < 3; ++k) {
+                if (corners[k] == from) {
+                    corners[k] = to;
+                }
+            }
+            _vertexTriangles[to].push_back(t);
+        }
+    }
+    _vertexTriangles[from].clear();
+
+    auto& toTriangles = _vertexTriangles[to];
+    toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(), [this](uint32_t t) {
+        return _removed[t] != 0;
+    }), toTriangles.end());
+
+    _quadrics[to] += _quadrics[from];
+    _locked[from] = 1;
+    ++_versions[from];
+    ++_versions[to];
+
+    // the cost of every edge around the vertex moved along with its quadric
+    queueCollapses(to);
+}
+
+void Simplifier::simplify(size_t targetTriangles) {
+    while (_numTriangles > targetTriangles && !_collapses.empty()) {
+        Collapse next = _collapses.top();
+        _collapses.pop();
+        if (next.fromVersion != _versions[next.from] || next.toVersion != _versions[next.to]) {
+            continue;
+        }
+        if (canCollapse(next.from, next.to)) {
+            collapse(next.from, next.to);
+        }
+    }
+}
+
+}
+
+MeshLODs model::buildMeshLODs(const Mesh& mesh) {
+    MeshLODs lods;
+
+    const size_t numVertices = mesh.getNumVertices();
+    const size_t numParts = mesh.getNumParts();
+    if (numVertices == 0 || numParts == 0 || mesh.getNumIndices() / 3 < MIN_LOD_TRIANGLES) {
+        return lods;
+    }
+
+    const BufferView& indexBuffer = mesh.getIndexBuffer();
+    const BufferView& partBuffer = mesh.getPartBuffer();
+
+    std::vector<glm::vec3> positions(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        positions[i] = mesh.getPos3((Index)i);
+    }
+
+    // the triangles are kept in the order of their parts, partTriangles[p] is where part p starts
+    std::vector<uint32_t> triangles;
+    std::vector<uint32_t> triangleParts;
+    std::vector<size_t> partTriangles(numParts + 1, 0);
+    triangles.reserve(mesh.getNumIndices());
+    triangleParts.reserve(mesh.getNumIndices() / 3);
+    for (size_t p = 0; p < numParts; ++p) {
+        partTriangles[p] = triangleParts.size();
+        const Mesh::Part& part = partBuffer.get<Mesh::Part>((Index)p);
+        if (part._topology != Mesh::TRIANGLES) {
+            return lods;
+        }
+        for (Index i = part._startIndex; i + 3 <= part._startIndex + part._numIndices; i += 3) {
+            uint32_t corners[3];
+            for (int k = 0; k < 3; ++k) {
+                corners[k] = indexBuffer.get<uint32_t>(i + k) + part._baseVertex;
+                if (corners[k] >= numVertices) {
+                    return lods;
+                }
+            }
+            if (corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0]) {
+                continue;
+            }
+            triangles.insert(triangles.end(), corners, corners + 3);
+            triangleParts.push_back((uint32_t)p);
+        }
+    }
+    partTriangles[numParts] = triangleParts.size();
+
+    const size_t numTriangles = triangleParts.size();
+    if (numTriangles < MIN_LOD_TRIANGLES) {
+        return lods;
+    }
+
+    Simplifier simplifier(std::move(positions), std::move(triangles), triangleParts);
+
+    // each level carries on from the one before, so they stay consistent with each other
+    size_t previousTriangles = numTriangles;
+    for (int level = 1; level <= NUM_LOD_LEVELS; ++level) {
+        simplifier.simplify(numTriangles >> level);
+        if (simplifier.getNumTriangles() > previousTriangles * MAX_LOD_REDUCTION) {
+            break;
+        }
+        previousTriangles = simplifier.getNumTriangles();
+
+        MeshLOD lod;
+        std::vector<uint32_t> indices;
+        indices.reserve(3 * previousTriangles);
+        lod._parts.reserve(numParts);
+        const std::vector<uint32_t>& simplified = simplifier.getTriangles();
+        for (size_t p = 0; p < numParts; ++p) {
+            const Mesh::Part& part = partBuffer.get<Mesh::Part>((Index)p);
+            Mesh::Part lodPart((Index)indices.size(), 0, part._baseVertex, Mesh::TRIANGLES);
+            for (size_t t = partTriangles[p]; t < partTriangles[p + 1]; ++t) {
+                if (!simplifier.isRemoved(t)) {
+                    for (int k = 0; k < 3; ++k) {
+                        indices.push_back(simplified[3 * t + k] - part._baseVertex);
+                    }
+                }
+            }
+            lodPart._numIndices = (Index)indices.size() - lodPart._startIndex;
+            lod._parts.push_back(lodPart);
+        }
+
+        auto buffer = std::make_shared<gpu::Buffer>(indices.size() * sizeof(uint32_t), (const gpu::Byte*)indices.data());
+        lod._indexBuffer = BufferView(buffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
+        lod._numTriangles = previousTriangles;
+        lods.push_back(std::move(lod));
+    }
+
+    return lods;
+}
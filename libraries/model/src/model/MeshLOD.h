@@ -0,0 +1,40 @@
+//
+//  MeshLOD.h
+//  libraries/model/src/model
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_model_MeshLOD_h
+#define hifi_model_MeshLOD_h
+
+#include <vector>
+
+#include "Geometry.h"
+
+namespace model {
+
+// A simplified set of the triangles of a mesh, indexing into the vertices of the full mesh
+class MeshLOD {
+public:
+    BufferView _indexBuffer;
+    std::vector<Mesh::Part> _parts; // one for each part of the mesh, ranges of the LOD index buffer
+    size_t _numTriangles { 0 };
+};
+using MeshLODs = std::vector<MeshLOD>;
+
+// Simplifies the triangles of a mesh to a half, a quarter and an eighth of them with quadric edge collapses onto existing
+// vertices, so every level shares the vertex buffer (and so the skinning and the blendshapes) of the mesh.
+// The open borders of the surface, where the attribute seams are, and the borders between parts are kept as they are.
+// Returns no levels for a mesh too small to need them, and stops at the first level that no longer removes enough.
+MeshLODs buildMeshLODs(const Mesh& mesh);
+
+};
+
+#endif // hifi_model_MeshLOD_h
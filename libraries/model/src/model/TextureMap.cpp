@@ -14,6 +14,8 @@
 #include <QPainter>
 #include <QDebug>
 
+#include <gpu/ImageKernels.h>
+
 #include "ModelLogging.h"
 
 using namespace model;
@@ -56,28 +58,22 @@ const QImage TextureUsage::process2DImageColor(const QImage& srcImage, bool& val
     QImage image = srcImage;
     validAlpha = false;
     alphaAsMask = true;
-    const uint8 OPAQUE_ALPHA = 255;
-    const uint8 TRANSPARENT_ALPHA = 0;
     if (image.hasAlphaChannel()) {
         if (image.format() != QImage::Format_ARGB32) {
             image = image.convertToFormat(QImage::Format_ARGB32);
         }
 
-        // Figure out if we can use a mask for alpha or not
+        // Figure out if we can use a mask for alpha or not, a row at a time
         int numOpaques = 0;
         int numTranslucents = 0;
         const int NUM_PIXELS = image.width() * image.height();
         const int MAX_TRANSLUCENT_PIXELS_FOR_ALPHAMASK = (int)(0.05f * (float)(NUM_PIXELS));
-        const QRgb* data = reinterpret_cast<const QRgb*>(image.constBits());
-        for (int i = 0; i < NUM_PIXELS; ++i) {
-            auto alpha = qAlpha(data[i]);
-            if (alpha == OPAQUE_ALPHA) {
-                numOpaques++;
-            } else if (alpha != TRANSPARENT_ALPHA) {
-                if (++numTranslucents > MAX_TRANSLUCENT_PIXELS_FOR_ALPHAMASK) {
-                    alphaAsMask = false;
-                    break;
-                }
+        for (int y = 0; y < image.height(); ++y) {
+            const QRgb* data = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            gpu::countAlphas(data, image.width(), numOpaques, numTranslucents);
+            if (numTranslucents > MAX_TRANSLUCENT_PIXELS_FOR_ALPHAMASK) {
+                alphaAsMask = false;
+                break;
             }
         }
         validAlpha = (numOpaques != NUM_PIXELS);
@@ -241,73 +237,48 @@ gpu::Texture* TextureUsage::createNormalTextureFromNormalImage(const QImage& src
     return theTexture;
 }
 
-int clampPixelCoordinate(int coordinate, int maxCoordinate) {
-    return coordinate - ((int)(coordinate < 0) * coordinate) + ((int)(coordinate > maxCoordinate) * (maxCoordinate - coordinate));
-}
+// The luminance of an image in the weights of qGray(), which QImage uses for Format_Grayscale8,
+// inverted first for a gloss image
+static QImage convertToGrayscale(const QImage& srcImage, bool invert) {
+    QImage image = srcImage;
+    if (!invert && image.format() == QImage::Format_Grayscale8) {
+        return image;
+    }
 
-const int RGBA_MAX = 255;
+    if (!image.hasAlphaChannel()) {
+        if (image.format() != QImage::Format_RGB888) {
+            image = image.convertToFormat(QImage::Format_RGB888);
+        }
+    } else {
+        if (image.format() != QImage::Format_ARGB32) {
+            image = image.convertToFormat(QImage::Format_ARGB32);
+        }
+    }
 
-// transform -1 - 1 to 0 - 255 (from sobel value to rgb)
-double mapComponent(double sobelValue) {
-    const double factor = RGBA_MAX / 2.0;
-    return (sobelValue + 1.0) * factor;
+    QImage result(image.width(), image.height(), QImage::Format_Grayscale8);
+    for (int y = 0; y < image.height(); ++y) {
+        if (image.format() == QImage::Format_RGB888) {
+            gpu::grayFromRGB888(image.constScanLine(y), result.scanLine(y), image.width(), invert);
+        } else {
+            const QRgb* data = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            gpu::grayFromARGB32(data, result.scanLine(y), image.width(), invert);
+        }
+    }
+    return result;
 }
 
 gpu::Texture* TextureUsage::createNormalTextureFromBumpImage(const QImage& srcImage, const std::string& srcImageName) {
-    QImage image = srcImage;
-    
-    if (image.format() != QImage::Format_RGB888) {
-        image = image.convertToFormat(QImage::Format_RGB888);
-    }
+    QImage heights = convertToGrayscale(srcImage, false);
 
     // PR 5540 by AlessandroSigna integrated here as a specialized TextureLoader for bumpmaps
     // The conversion is done using the Sobel Filter to calculate the derivatives from the grayscale image
-    const double pStrength = 2.0;
-    int width = image.width();
-    int height = image.height();
-    QImage result(width, height, QImage::Format_RGB888);
-    
-    for (int i = 0; i < width; i++) {
-        const int iNextClamped = clampPixelCoordinate(i + 1, width - 1);
-        const int iPrevClamped = clampPixelCoordinate(i - 1, width - 1);
-    
-        for (int j = 0; j < height; j++) {
-            const int jNextClamped = clampPixelCoordinate(j + 1, height - 1);
-            const int jPrevClamped = clampPixelCoordinate(j - 1, height - 1);
-    
-            // surrounding pixels
-            const QRgb topLeft = image.pixel(iPrevClamped, jPrevClamped);
-            const QRgb top = image.pixel(iPrevClamped, j);
-            const QRgb topRight = image.pixel(iPrevClamped, jNextClamped);
-            const QRgb right = image.pixel(i, jNextClamped);
-            const QRgb bottomRight = image.pixel(iNextClamped, jNextClamped);
-            const QRgb bottom = image.pixel(iNextClamped, j);
-            const QRgb bottomLeft = image.pixel(iNextClamped, jPrevClamped);
-            const QRgb left = image.pixel(i, jPrevClamped);
-    
-            // take their gray intensities
-            // since it's a grayscale image, the value of each component RGB is the same
-            const double tl = qRed(topLeft);
-            const double t = qRed(top);
-            const double tr = qRed(topRight);
-            const double r = qRed(right);
-            const double br = qRed(bottomRight);
-            const double b = qRed(bottom);
-            const double bl = qRed(bottomLeft);
-            const double l = qRed(left);
-    
-            // apply the sobel filter
-            const double dX = (tr + pStrength * r + br) - (tl + pStrength * l + bl);
-            const double dY = (bl + pStrength * b + br) - (tl + pStrength * t + tr);
-            const double dZ = RGBA_MAX / pStrength;
-    
-            glm::vec3 v(dX, dY, dZ);
-            glm::normalize(v);
-    
-            // convert to rgb from the value obtained computing the filter
-            QRgb qRgbValue = qRgb(mapComponent(v.x), mapComponent(v.y), mapComponent(v.z));
-            result.setPixel(i, j, qRgbValue);
-        }
+    int width = heights.width();
+    int height = heights.height();
+    QImage image(width, height, QImage::Format_RGB888);
+    for (int y = 0; y < height; ++y) {
+        const uint8* above = heights.constScanLine(std::max(y - 1, 0));
+        const uint8* below = heights.constScanLine(std::min(y + 1, height - 1));
+        gpu::normalsFromHeights(above, heights.constScanLine(y), below, image.scanLine(y), width);
     }
 
     gpu::Texture* theTexture = nullptr;
@@ -325,18 +296,7 @@ gpu::Texture* TextureUsage::createNormalTextureFromBumpImage(const QImage& srcIm
 }
 
 gpu::Texture* TextureUsage::createRoughnessTextureFromImage(const QImage& srcImage, const std::string& srcImageName) {
-    QImage image = srcImage;
-    if (!image.hasAlphaChannel()) {
-        if (image.format() != QImage::Format_RGB888) {
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-    } else {
-        if (image.format() != QImage::Format_ARGB32) {
-            image = image.convertToFormat(QImage::Format_ARGB32);
-        }
-    }
-
-    image = image.convertToFormat(QImage::Format_Grayscale8);
+    QImage image = convertToGrayscale(srcImage, false);
 
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
@@ -358,21 +318,8 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromImage(const QImage& srcIma
 }
 
 gpu::Texture* TextureUsage::createRoughnessTextureFromGlossImage(const QImage& srcImage, const std::string& srcImageName) {
-    QImage image = srcImage;
-    if (!image.hasAlphaChannel()) {
-        if (image.format() != QImage::Format_RGB888) {
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-    } else {
-        if (image.format() != QImage::Format_ARGB32) {
-            image = image.convertToFormat(QImage::Format_ARGB32);
-        }
-    }
-
     // Gloss turned into Rough
-    image.invertPixels(QImage::InvertRgba);
-    
-    image = image.convertToFormat(QImage::Format_Grayscale8);
+    QImage image = convertToGrayscale(srcImage, true);
     
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
@@ -395,18 +342,7 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromGlossImage(const QImage& s
 }
 
 gpu::Texture* TextureUsage::createMetallicTextureFromImage(const QImage& srcImage, const std::string& srcImageName) {
-    QImage image = srcImage;
-    if (!image.hasAlphaChannel()) {
-        if (image.format() != QImage::Format_RGB888) {
-            image = image.convertToFormat(QImage::Format_RGB888);
-        }
-    } else {
-        if (image.format() != QImage::Format_ARGB32) {
-            image = image.convertToFormat(QImage::Format_ARGB32);
-        }
-    }
-
-    image = image.convertToFormat(QImage::Format_Grayscale8);
+    QImage image = convertToGrayscale(srcImage, false);
 
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
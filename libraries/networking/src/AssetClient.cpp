@@ -22,6 +22,7 @@
 #include "AssetRequest.h"
 #include "AssetUpload.h"
 #include "AssetUtils.h"
+#include "ContentCache.h"
 #include "MappingRequest.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
@@ -96,6 +97,11 @@ void AssetClient::clearCache() {
     } else {
         qCWarning(asset_client) << "No disk cache to clear.";
     }
+
+    if (auto contentCache = DependencyManager::get<ContentCache>()) {
+        qDebug() << "AssetClient::clearCache(): Clearing content cache.";
+        contentCache->clear();
+    }
 }
 
 void AssetClient::handleAssetMappingOperationReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -14,6 +14,7 @@
 #include <algorithm>
 
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include "AssetClient.h"
 #include "NetworkLogging.h"
@@ -27,9 +28,7 @@ AssetRequest::AssetRequest(const QString& hash) :
 
 AssetRequest::~AssetRequest() {
     auto assetClient = DependencyManager::get<AssetClient>();
-    if (_assetRequestID) {
-        assetClient->cancelGetAssetRequest(_assetRequestID);
-    }
+    cancelRangeRequests();
     if (_assetInfoRequestID) {
         assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
     }
@@ -56,7 +55,7 @@ void AssetRequest::start() {
     }
     
     // Try to load from cache
-    _data = loadFromCache(getUrl());
+    _data = loadFromCache(_hash);
     if (!_data.isNull()) {
         _info.hash = _hash;
         _info.size = _data.size();
@@ -99,65 +98,155 @@ void AssetRequest::start() {
         }
         
         _state = WaitingForData;
-        _data.resize(info.size);
-        
+
         qCDebug(asset_client) << "Got size of " << _hash << " : " << info.size << " bytes";
-        
-        int start = 0, end = _info.size;
-        
-        auto assetClient = DependencyManager::get<AssetClient>();
-        auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
-        _assetRequestID = assetClient->getAsset(_hash, start, end,
-                [this, that, start, end](bool responseReceived, AssetServerError serverError, const QByteArray& data) {
-            if (!that) {
-                // If the request is dead, return
-                return;
-            }
-            _assetRequestID = AssetClient::INVALID_MESSAGE_ID;
-
-            if (!responseReceived) {
-                _error = NetworkError;
-            } else if (serverError != AssetServerError::NoError) {
-                switch (serverError) {
-                    case AssetServerError::AssetNotFound:
-                        _error = NotFound;
-                        break;
-                    case AssetServerError::InvalidByteRange:
-                        _error = InvalidByteRange;
-                        break;
-                    default:
-                        _error = UnknownError;
-                        break;
-                }
-            } else {
-                Q_ASSERT(data.size() == (end - start));
-                
-                // we need to check the hash of the received data to make sure it matches what we expect
-                if (hashData(data).toHex() == _hash) {
-                    memcpy(_data.data() + start, data.constData(), data.size());
-                    _totalReceived += data.size();
-                    emit progress(_totalReceived, _info.size);
-                    
-                    saveToCache(getUrl(), data);
-                } else {
-                    // hash doesn't match - we have an error
-                    _error = HashVerificationFailed;
-                }
-                
-            }
-            
-            if (_error != NoError) {
-                qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
-            }
-            
-            _state = Finished;
-            emit finished(this);
-        }, [this, that](qint64 totalReceived, qint64 total) {
-            if (!that) {
-                // If the request is dead, return
-                return;
-            }
-            emit progress(totalReceived, total);
-        });
+
+        for (DataOffset start = 0; start < _info.size || start == 0; start += RANGE_SIZE) {
+            _ranges.push_back({ start, std::min(start + RANGE_SIZE, (DataOffset) _info.size) });
+        }
+
+        // the ranges of a single range asset are the asset, there is nothing to put together
+        if (_ranges.size() > 1) {
+            _data.resize(_info.size);
+        }
+
+        requestNextRanges();
     });
 }
+
+void AssetRequest::requestNextRanges() {
+    while (_nextRange < _ranges.size() && (size_t) _numPendingRequests < MAX_RANGES_IN_FLIGHT) {
+        requestRange(_nextRange++);
+    }
+}
+
+void AssetRequest::requestRange(size_t index) {
+    auto& range = _ranges[index];
+    ++_numPendingRequests;
+
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    auto requestID = assetClient->getAsset(_hash, range.start, range.end,
+            [this, that, index](bool responseReceived, AssetServerError serverError, const QByteArray& data) {
+        if (!that) {
+            // If the request is dead, return
+            return;
+        }
+        handleRangeReply(index, responseReceived, serverError, data);
+    }, [this, that, index](qint64 totalReceived, qint64 total) {
+        if (!that) {
+            // If the request is dead, return
+            return;
+        }
+        handleRangeProgress(index, totalReceived);
+    });
+
+    // without an asset server the reply has been handled already
+    if (requestID != AssetClient::INVALID_MESSAGE_ID) {
+        range.requestID = requestID;
+    }
+}
+
+void AssetRequest::handleRangeReply(size_t index, bool responseReceived, AssetServerError serverError,
+                                    const QByteArray& data) {
+    if (_state != WaitingForData) {
+        return;
+    }
+
+    auto& range = _ranges[index];
+    range.requestID = AssetClient::INVALID_MESSAGE_ID;
+    --_numPendingRequests;
+
+    _totalInFlight -= range.received;
+    range.received = 0;
+
+    if (!responseReceived) {
+        if (range.numRetries < MAX_RANGE_RETRIES) {
+            ++range.numRetries;
+            qCDebug(asset_client) << "Retrying range" << range.start << "to" << range.end << "of" << _hash;
+
+            // give the connection a moment, the ranges that arrived are kept
+            static const int RANGE_RETRY_DELAY_MSECS = 500;
+            ++_numPendingRequests;
+            QTimer::singleShot(RANGE_RETRY_DELAY_MSECS * range.numRetries, this, [this, index] {
+                if (_state == WaitingForData) {
+                    --_numPendingRequests;
+                    requestRange(index);
+                }
+            });
+            return;
+        }
+        _error = NetworkError;
+    } else if (serverError != AssetServerError::NoError) {
+        switch (serverError) {
+            case AssetServerError::AssetNotFound:
+                _error = NotFound;
+                break;
+            case AssetServerError::InvalidByteRange:
+                _error = InvalidByteRange;
+                break;
+            default:
+                _error = UnknownError;
+                break;
+        }
+    } else if (data.size() != (qint64) (range.end - range.start)) {
+        _error = InvalidByteRange;
+    } else {
+        if (_ranges.size() == 1) {
+            _data = data;
+        } else {
+            memcpy(_data.data() + range.start, data.constData(), data.size());
+        }
+        _totalReceived += data.size();
+        emit progress(_totalReceived + _totalInFlight, _info.size);
+    }
+
+    if (_error != NoError) {
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+        finish();
+        return;
+    }
+
+    requestNextRanges();
+
+    if (_numPendingRequests == 0) {
+        // we need to check the hash of the received data to make sure it matches what we expect
+        if (hashData(_data).toHex() == _hash) {
+            saveToCache(_hash, _data);
+        } else {
+            // hash doesn't match - we have an error
+            _error = HashVerificationFailed;
+            qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+        }
+        finish();
+    }
+}
+
+void AssetRequest::handleRangeProgress(size_t index, qint64 received) {
+    auto& range = _ranges[index];
+
+    // the reply starts with a header of its own, it doesn't count
+    received = std::min(received, (qint64) (range.end - range.start));
+    _totalInFlight += received - range.received;
+    range.received = received;
+
+    emit progress(_totalReceived + _totalInFlight, _info.size);
+}
+
+void AssetRequest::finish() {
+    cancelRangeRequests();
+    _numPendingRequests = 0;
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::cancelRangeRequests() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    for (auto& range : _ranges) {
+        if (range.requestID != AssetClient::INVALID_MESSAGE_ID) {
+            assetClient->cancelGetAssetRequest(range.requestID);
+            range.requestID = AssetClient::INVALID_MESSAGE_ID;
+        }
+    }
+}
@@ -16,13 +16,21 @@
 #include <QObject>
 #include <QString>
 
+#include <vector>
+
 #include "AssetClient.h"
 
 #include "AssetUtils.h"
 
+// Gets an asset from the asset server. An asset larger than a range is got as several ranges at once, a range that
+// fails to arrive is asked for again without losing the ones that did.
 class AssetRequest : public QObject {
    Q_OBJECT
 public:
+    static const DataOffset RANGE_SIZE = 1024 * 1024;
+    static const size_t MAX_RANGES_IN_FLIGHT = 4;
+    static const int MAX_RANGE_RETRIES = 3;
+
     enum State {
         NotStarted = 0,
         WaitingForInfo,
@@ -55,14 +63,33 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    struct Range {
+        DataOffset start;
+        DataOffset end;
+        MessageID requestID { AssetClient::INVALID_MESSAGE_ID };
+        // what has arrived of the request in flight
+        qint64 received { 0 };
+        int numRetries { 0 };
+    };
+
+    void requestNextRanges();
+    void requestRange(size_t index);
+    void handleRangeReply(size_t index, bool responseReceived, AssetServerError serverError, const QByteArray& data);
+    void handleRangeProgress(size_t index, qint64 received);
+    void finish();
+    void cancelRangeRequests();
+
     State _state = NotStarted;
     Error _error = NoError;
     AssetInfo _info;
+    // the bytes of the ranges that have arrived, and of the ones still arriving
     uint64_t _totalReceived { 0 };
+    qint64 _totalInFlight { 0 };
     QString _hash;
     QByteArray _data;
+    std::vector<Range> _ranges;
+    size_t _nextRange { 0 };
     int _numPendingRequests { 0 };
-    MessageID _assetRequestID { AssetClient::INVALID_MESSAGE_ID };
     MessageID _assetInfoRequestID { AssetClient::INVALID_MESSAGE_ID };
 };
 
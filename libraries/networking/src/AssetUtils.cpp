@@ -11,12 +11,9 @@
 
 #include "AssetUtils.h"
 
-#include <memory>
-
 #include <QtCore/QCryptographicHash>
-#include <QtNetwork/QAbstractNetworkCache>
 
-#include "NetworkAccessManager.h"
+#include "ContentCache.h"
 #include "NetworkLogging.h"
 
 #include "ResourceManager.h"
@@ -29,43 +26,30 @@ QByteArray hashData(const QByteArray& data) {
     return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
 }
 
-QByteArray loadFromCache(const QUrl& url) {
-    if (auto cache = NetworkAccessManager::getInstance().cache()) {
-
-        // caller is responsible for the deletion of the ioDevice, hence the unique_ptr
-        if (auto ioDevice = std::unique_ptr<QIODevice>(cache->data(url))) {
-            qCDebug(asset_client) << url.toDisplayString() << "loaded from disk cache.";
-            return ioDevice->readAll();
+QByteArray loadFromCache(const AssetHash& hash) {
+    if (auto cache = DependencyManager::get<ContentCache>()) {
+        QByteArray data = cache->load(hash);
+        if (!data.isNull()) {
+            qCDebug(asset_client) << hash << "loaded from content cache.";
         } else {
-            qCDebug(asset_client) << url.toDisplayString() << "not in disk cache";
+            qCDebug(asset_client) << hash << "not in content cache";
         }
-
+        return data;
     } else {
-        qCWarning(asset_client) << "No disk cache to load assets from.";
+        qCWarning(asset_client) << "No content cache to load assets from.";
     }
     return QByteArray();
 }
 
-bool saveToCache(const QUrl& url, const QByteArray& file) {
-    if (auto cache = NetworkAccessManager::getInstance().cache()) {
-        if (!cache->metaData(url).isValid()) {
-            QNetworkCacheMetaData metaData;
-            metaData.setUrl(url);
-            metaData.setSaveToDisk(true);
-            metaData.setLastModified(QDateTime::currentDateTime());
-            metaData.setExpirationDate(QDateTime()); // Never expires
-
-            // ioDevice is managed by the cache and should either be passed back to insert or remove!
-            if (auto ioDevice = cache->prepare(metaData)) {
-                ioDevice->write(file);
-                cache->insert(ioDevice);
-                qCDebug(asset_client) << url.toDisplayString() << "saved to disk cache";
-                return true;
-            }
-            qCWarning(asset_client) << "Could not save" << url.toDisplayString() << "to disk cache.";
+bool saveToCache(const AssetHash& hash, const QByteArray& file) {
+    if (auto cache = DependencyManager::get<ContentCache>()) {
+        if (cache->save(hash, file)) {
+            qCDebug(asset_client) << hash << "saved to content cache";
+            return true;
         }
+        qCWarning(asset_client) << "Could not save" << hash << "to content cache.";
     } else {
-        qCWarning(asset_client) << "No disk cache to save assets to.";
+        qCWarning(asset_client) << "No content cache to save assets to.";
     }
     return false;
 }
@@ -56,8 +56,8 @@ QUrl getATPUrl(const QString& hash);
 
 QByteArray hashData(const QByteArray& data);
 
-QByteArray loadFromCache(const QUrl& url);
-bool saveToCache(const QUrl& url, const QByteArray& file);
+QByteArray loadFromCache(const AssetHash& hash);
+bool saveToCache(const AssetHash& hash, const QByteArray& file);
 
 bool isValidPath(const AssetPath& path);
 bool isValidHash(const QString& hashString);
@@ -11,105 +11,128 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <math.h>
+
 #include <QDateTime>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
 #include "BandwidthRecorder.h"
 
 
-BandwidthRecorder::Channel::Channel() {
-}
+// the rates are worked out again when read at least this long after the last time
+static const quint64 RATE_UPDATE_INTERVAL_USECS = 100 * USECS_PER_MSEC;
+// and follow the rate over the time since then smoothly, about as much as the last second of it
+static const float RATE_TIME_CONSTANT_SECONDS = 1.0f;
 
-float BandwidthRecorder::Channel::getAverageInputPacketsPerSecond() {
-    float averageTimeBetweenPackets = _input.getEventDeltaAverage();
-    if (averageTimeBetweenPackets > 0.0f) {
-        return (1.0f / averageTimeBetweenPackets);
-    }
-    return 0.0f;
+BandwidthRecorder::Channel::Direction::Direction() :
+    _lastUsecs(usecTimestampNow())
+{
 }
 
-float BandwidthRecorder::Channel::getAverageOutputPacketsPerSecond() {
-    float averageTimeBetweenPackets = _output.getEventDeltaAverage();
-    if (averageTimeBetweenPackets > 0.0f) {
-        return (1.0f / averageTimeBetweenPackets);
+void BandwidthRecorder::Channel::Direction::updateRates() {
+    quint64 now = usecTimestampNow();
+    if (now < _lastUsecs + RATE_UPDATE_INTERVAL_USECS) {
+        return;
     }
-    return 0.0f;
-}
 
-float BandwidthRecorder::Channel::getAverageInputKilobitsPerSecond() {
-    return (_input.getAverageSampleValuePerSecond() * (8.0f / 1000));
-}
+    uint64_t packets = _packets.get();
+    uint64_t bytes = _bytes.get();
+    float seconds = (float)(now - _lastUsecs) / USECS_PER_SECOND;
+    float weight = 1.0f - expf(-seconds / RATE_TIME_CONSTANT_SECONDS);
+    _packetsPerSecond += ((float)(packets - _lastPackets) / seconds - _packetsPerSecond) * weight;
+    _bytesPerSecond += ((float)(bytes - _lastBytes) / seconds - _bytesPerSecond) * weight;
 
-float BandwidthRecorder::Channel::getAverageOutputKilobitsPerSecond() {
-    return (_output.getAverageSampleValuePerSecond() * (8.0f / 1000));
+    _lastUsecs = now;
+    _lastPackets = packets;
+    _lastBytes = bytes;
 }
 
-
-void BandwidthRecorder::Channel::updateInputAverage(const float sample) {
-    _input.updateAverage(sample);
+float BandwidthRecorder::Channel::Direction::getPacketsPerSecond() {
+    QMutexLocker lock(&_rateMutex);
+    updateRates();
+    return _packetsPerSecond;
 }
 
-void BandwidthRecorder::Channel::updateOutputAverage(const float sample) {
-    _output.updateAverage(sample);
+float BandwidthRecorder::Channel::Direction::getKilobitsPerSecond() {
+    QMutexLocker lock(&_rateMutex);
+    updateRates();
+    return _bytesPerSecond * (8.0f / 1000);
 }
 
 BandwidthRecorder::BandwidthRecorder() {
     for (uint i=0; i<CHANNEL_COUNT; i++) {
-        _channels[ i ] = NULL;
+        _channels[ i ] = nullptr;
     }
 }
 
 BandwidthRecorder::~BandwidthRecorder() {
     for (uint i=0; i<CHANNEL_COUNT; i++) {
-        delete _channels[ i ];
+        delete _channels[ i ].load();
     }
 }
 
-void BandwidthRecorder::updateInboundData(const quint8 channelType, const int sample) {
-    if (! _channels[channelType]) {
-        _channels[channelType] = new Channel();
+BandwidthRecorder::Channel& BandwidthRecorder::getChannel(const quint8 channelType) {
+    Channel* channel = _channels[channelType].load(std::memory_order_acquire);
+    if (!channel) {
+        // two threads can make the channel at once, the one that loses throws its own away
+        Channel* newChannel = new Channel();
+        if (_channels[channelType].compare_exchange_strong(channel, newChannel, std::memory_order_acq_rel)) {
+            channel = newChannel;
+        } else {
+            delete newChannel;
+        }
     }
-    _channels[channelType]->updateInputAverage(sample);
+    return *channel;
+}
+
+void BandwidthRecorder::updateInboundData(const quint8 channelType, const int sample) {
+    getChannel(channelType).recordInput(sample);
 }
 
 void BandwidthRecorder::updateOutboundData(const quint8 channelType, const int sample) {
-    if (! _channels[channelType]) {
-        _channels[channelType] = new Channel();
-    }
-    _channels[channelType]->updateOutputAverage(sample);
+    getChannel(channelType).recordOutput(sample);
 }
 
 float BandwidthRecorder::getAverageInputPacketsPerSecond(const quint8 channelType) {
-    if (! _channels[channelType]) {
+    Channel* channel = _channels[channelType].load(std::memory_order_acquire);
+    if (! channel) {
         return 0.0f;
     }
-    return _channels[channelType]->getAverageInputPacketsPerSecond();
+    return channel->getAverageInputPacketsPerSecond();
 }
 
 float BandwidthRecorder::getAverageOutputPacketsPerSecond(const quint8 channelType) {
-    if (! _channels[channelType]) {
+    Channel* channel = _channels[channelType].load(std::memory_order_acquire);
+    if (! channel) {
         return 0.0f;
     }
-    return _channels[channelType]->getAverageOutputPacketsPerSecond();
+    return channel->getAverageOutputPacketsPerSecond();
 }
 
 float BandwidthRecorder::getAverageInputKilobitsPerSecond(const quint8 channelType) {
-    if (! _channels[channelType]) {
+    Channel* channel = _channels[channelType].load(std::memory_order_acquire);
+    if (! channel) {
         return 0.0f;
     }
-    return _channels[channelType]->getAverageInputKilobitsPerSecond();
+    return channel->getAverageInputKilobitsPerSecond();
 }
 
 float BandwidthRecorder::getAverageOutputKilobitsPerSecond(const quint8 channelType) {
-    if (! _channels[channelType]) {
+    Channel* channel = _channels[channelType].load(std::memory_order_acquire);
+    if (! channel) {
         return 0.0f;
     }
-    return _channels[channelType]->getAverageOutputKilobitsPerSecond();
+    return channel->getAverageOutputKilobitsPerSecond();
 }
 
 float BandwidthRecorder::getTotalAverageInputPacketsPerSecond() {
     float result = 0.0f;
     for (uint i=0; i<CHANNEL_COUNT; i++) {
-        if (_channels[i]) {
-            result += _channels[i]->getAverageInputPacketsPerSecond();
+        Channel* channel = _channels[i].load(std::memory_order_acquire);
+        if (channel) {
+            result += channel->getAverageInputPacketsPerSecond();
         }
     }
     return result;
@@ -118,8 +141,9 @@ float BandwidthRecorder::getTotalAverageInputPacketsPerSecond() {
 float BandwidthRecorder::getTotalAverageOutputPacketsPerSecond() {
     float result = 0.0f;
     for (uint i=0; i<CHANNEL_COUNT; i++) {
-        if (_channels[i]) {
-            result += _channels[i]->getAverageOutputPacketsPerSecond();
+        Channel* channel = _channels[i].load(std::memory_order_acquire);
+        if (channel) {
+            result += channel->getAverageOutputPacketsPerSecond();
         }
     }
     return result;
@@ -128,8 +152,9 @@ float BandwidthRecorder::getTotalAverageOutputPacketsPerSecond() {
 float BandwidthRecorder::getTotalAverageInputKilobitsPerSecond(){
     float result = 0.0f;
     for (uint i=0; i<CHANNEL_COUNT; i++) {
-        if (_channels[i]) {
-            result += _channels[i]->getAverageInputKilobitsPerSecond();
+        Channel* channel = _channels[i].load(std::memory_order_acquire);
+        if (channel) {
+            result += channel->getAverageInputKilobitsPerSecond();
         }
     }
     return result;
@@ -138,8 +163,9 @@ float BandwidthRecorder::getTotalAverageInputKilobitsPerSecond(){
 float BandwidthRecorder::getTotalAverageOutputKilobitsPerSecond(){
     float result = 0.0f;
     for (uint i=0; i<CHANNEL_COUNT; i++) {
-        if (_channels[i]) {
-            result += _channels[i]->getAverageOutputKilobitsPerSecond();
+        Channel* channel = _channels[i].load(std::memory_order_acquire);
+        if (channel) {
+            result += channel->getAverageOutputKilobitsPerSecond();
         }
     }
     return result;
@@ -14,10 +14,13 @@
 #ifndef hifi_BandwidthRecorder_h
 #define hifi_BandwidthRecorder_h
 
+#include <atomic>
+
 #include <QObject>
-#include <QElapsedTimer>
+#include <QMutex>
+
 #include "DependencyManager.h"
-#include "SimpleMovingAverage.h"
+#include "ShardedCounter.h"
 
 
 class BandwidthRecorder : public QObject, public Dependency {
@@ -29,20 +32,49 @@ public:
     ~BandwidthRecorder();
 
     // keep track of data rate in two directions as well as units and style to use during display
+    // The packets are counted on whichever threads send and receive them without a lock, and the rates are worked out
+    // from the counts when they are read, so the reads never hold the network threads up.
     class Channel {
     public:
-        Channel();
-        float getAverageInputPacketsPerSecond();
-        float getAverageOutputPacketsPerSecond();
-        float getAverageInputKilobitsPerSecond();
-        float getAverageOutputKilobitsPerSecond();
+        Channel() {}
+        float getAverageInputPacketsPerSecond() { return _input.getPacketsPerSecond(); }
+        float getAverageOutputPacketsPerSecond() { return _output.getPacketsPerSecond(); }
+        float getAverageInputKilobitsPerSecond() { return _input.getKilobitsPerSecond(); }
+        float getAverageOutputKilobitsPerSecond() { return _output.getKilobitsPerSecond(); }
 
-        void updateInputAverage(const float sample);
-        void updateOutputAverage(const float sample);
+        void recordInput(int bytes) { _input.record(bytes); }
+        void recordOutput(int bytes) { _output.record(bytes); }
 
     private:
-        SimpleMovingAverage _input = SimpleMovingAverage();
-        SimpleMovingAverage _output = SimpleMovingAverage();
+        class Direction {
+        public:
+            Direction();
+
+            void record(int bytes) {
+                _packets.add(1);
+                _bytes.add(bytes);
+            }
+
+            float getPacketsPerSecond();
+            float getKilobitsPerSecond();
+
+        private:
+            void updateRates();
+
+            ShardedCounter _packets;
+            ShardedCounter _bytes;
+
+            // the readers only
+            QMutex _rateMutex;
+            quint64 _lastUsecs;
+            uint64_t _lastPackets { 0 };
+            uint64_t _lastBytes { 0 };
+            float _packetsPerSecond { 0.0f };
+            float _bytesPerSecond { 0.0f };
+        };
+
+        Direction _input;
+        Direction _output;
     };
 
     float getAverageInputPacketsPerSecond(const quint8 channelType);
@@ -62,12 +94,15 @@ public:
 
 
 private:
-    // one for each possible Node type
+    Channel& getChannel(const quint8 channelType);
+
+    // one for each possible Node type, made by the first thread to record anything in it
     static const unsigned int CHANNEL_COUNT = 256;
-    Channel* _channels[CHANNEL_COUNT];
+    std::atomic<Channel*> _channels[CHANNEL_COUNT];
 
 
 public slots:
+    // can be called from any thread, connect to them directly
     void updateInboundData(const quint8 channelType, const int bytes);
     void updateOutboundData(const quint8 channelType, const int bytes);
 };
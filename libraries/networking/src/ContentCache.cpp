@@ -0,0 +1,247 @@
+//
+//  ContentCache.cpp
+//  libraries/networking/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContentCache.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#ifdef Q_OS_WIN
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include "NetworkLogging.h"
+
+const qint64 ContentCache::MAXIMUM_CONTENT_CACHE_SIZE = 10LL * 1024 * 1024 * 1024; // 10GB
+
+static const QString CONTENT_DIRECTORY = "content";
+static const QString INDEX_DIRECTORY = "urls";
+
+// evicting takes the cache down to this fraction of its budget, so that a full cache isn't rescanned on every save
+static const float EVICTION_TARGET = 0.9f;
+
+// the modification time of a content file is when it was last read, which is what the eviction goes by
+static void touchFile(const QString& path) {
+#ifdef Q_OS_WIN
+    _wutime(reinterpret_cast<const wchar_t*>(path.utf16()), nullptr);
+#else
+    utime(QFile::encodeName(path).constData(), nullptr);
+#endif
+}
+
+QString ContentCache::getDefaultDirectory() {
+    // the generic location, rather than the one for the application, so interface and the assignment-clients share it
+    QString path = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (path.isEmpty()) {
+        path = QDir::tempPath();
+    }
+    return path + "/" + QCoreApplication::organizationName() + "/ContentCache";
+}
+
+ContentCache::ContentCache(const QString& directory, qint64 maximumSize) :
+    _directory(directory),
+    _maximumSize(maximumSize)
+{
+    qCDebug(networking) << "Content cache setup at" << _directory << "(size:" << _maximumSize / (1024 * 1024) << "MB)";
+}
+
+QString ContentCache::getContentPath(const AssetHash& hash) const {
+    // fan the files out over 256 directories, so that none of them gets too large to list
+    return _directory + "/" + CONTENT_DIRECTORY + "/" + hash.left(2) + "/" + hash;
+}
+
+QString ContentCache::getIndexPath(const QUrl& url) const {
+    return _directory + "/" + INDEX_DIRECTORY + "/" + hashData(url.toEncoded()).toHex();
+}
+
+QByteArray ContentCache::load(const AssetHash& hash) {
+    if (!isValidHash(hash)) {
+        return QByteArray();
+    }
+
+    QString path = getContentPath(hash.toLower());
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    // map the file rather than reading it, so it's only copied once, out of the page cache
+    const qint64 size = file.size();
+    QByteArray data;
+    if (size > 0) {
+        uchar* mapped = file.map(0, size);
+        if (!mapped) {
+            return QByteArray();
+        }
+        data = QByteArray(reinterpret_cast<const char*>(mapped), (int)size);
+        file.unmap(mapped);
+    } else {
+        data = QByteArray("");
+    }
+    file.close();
+
+    if (hashData(data).toHex() != hash.toLower()) {
+        qCWarning(networking) << "Content cache file" << path << "failed verification, removing it";
+        if (QFile::remove(path)) {
+            QMutexLocker locker(&_sizeLock);
+            if (_size >= 0) {
+                _size -= size;
+            }
+        }
+        return QByteArray();
+    }
+
+    touchFile(path);
+    return data;
+}
+
+bool ContentCache::save(const AssetHash& hash, const QByteArray& data) {
+    if (!isValidHash(hash)) {
+        return false;
+    }
+
+    QString path = getContentPath(hash.toLower());
+    if (QFile::exists(path)) {
+        // another request, or another process, got here first
+        touchFile(path);
+        return true;
+    }
+
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        qCWarning(networking) << "Could not create content cache directory for" << path;
+        return false;
+    }
+
+    // the save file is written to the side and renamed into place, so nobody reads a partial file
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        // on some platforms the rename fails if another process has just saved the same content
+        if (QFile::exists(path)) {
+            return true;
+        }
+        qCWarning(networking) << "Could not save" << path << "to the content cache";
+        return false;
+    }
+
+    QMutexLocker locker(&_sizeLock);
+    if (_size >= 0) {
+        _size += data.size();
+    }
+    if (_size < 0 || _size > _maximumSize) {
+        evict();
+    }
+    return true;
+}
+
+QByteArray ContentCache::loadForUrl(const QUrl& url) {
+    QString path = getIndexPath(url);
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    // the index holds the hash of the content and when it expires (in msecs since the epoch), one to a line
+    QList<QByteArray> lines = file.readAll().split('\n');
+    file.close();
+
+    if (lines.size() < 2 || QDateTime::currentMSecsSinceEpoch() >= lines[1].toLongLong()) {
+        QFile::remove(path);
+        return QByteArray();
+    }
+
+    QByteArray data = load(QString::fromLatin1(lines[0]));
+    if (data.isNull()) {
+        // the content has been evicted out from under the index
+        QFile::remove(path);
+    }
+    return data;
+}
+
+bool ContentCache::saveForUrl(const QUrl& url, const QByteArray& data, const QDateTime& expiration) {
+    if (!expiration.isValid() || expiration <= QDateTime::currentDateTimeUtc()) {
+        return false;
+    }
+
+    AssetHash hash = hashData(data).toHex();
+    if (!save(hash, data)) {
+        return false;
+    }
+
+    QString path = getIndexPath(url);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return false;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(hash.toLatin1() + '\n' + QByteArray::number(expiration.toMSecsSinceEpoch()) + '\n');
+    return file.commit();
+}
+
+void ContentCache::clear() {
+    QMutexLocker locker(&_sizeLock);
+    QDir(_directory + "/" + INDEX_DIRECTORY).removeRecursively();
+    QDir(_directory + "/" + CONTENT_DIRECTORY).removeRecursively();
+    _size = 0;
+}
+
+void ContentCache::evict() {
+    struct ContentFile {
+        QString path;
+        qint64 size;
+        qint64 lastRead;
+    };
+
+    // the other processes sharing the cache have been saving to it too, so the directory is rescanned
+    std::vector<ContentFile> files;
+    qint64 size = 0;
+    QDirIterator it(_directory + "/" + CONTENT_DIRECTORY, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        QFileInfo info = it.fileInfo();
+        files.push_back({ info.absoluteFilePath(), info.size(), info.lastModified().toMSecsSinceEpoch() });
+        size += info.size();
+    }
+
+    if (size > _maximumSize) {
+        std::sort(files.begin(), files.end(), [](const ContentFile& a, const ContentFile& b) {
+            return a.lastRead < b.lastRead;
+        });
+
+        const qint64 targetSize = (qint64)(_maximumSize * EVICTION_TARGET);
+        int numEvicted = 0;
+        for (const auto& file : files) {
+            if (size <= targetSize) {
+                break;
+            }
+            // a file that's open in another process can fail to remove on windows, it'll go next time
+            if (QFile::remove(file.path)) {
+                size -= file.size;
+                ++numEvicted;
+            }
+        }
+        qCDebug(networking) << "Evicted" << numEvicted << "files from the content cache";
+    }
+
+    _size = size;
+}
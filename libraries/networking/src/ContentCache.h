@@ -0,0 +1,68 @@
+//
+//  ContentCache.h
+//  libraries/networking/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ContentCache_h
+#define hifi_ContentCache_h
+
+#include <QtCore/QDateTime>
+#include <QtCore/QMutex>
+#include <QtCore/QUrl>
+
+#include <DependencyManager.h>
+
+#include "AssetUtils.h"
+
+// A store of downloaded content on disk, keyed by the SHA-256 of the content, that every interface and
+// assignment-client on the host shares. ATP content is looked up by its hash, other content by its url through an
+// index that remembers the hash (and how long the content is fresh for).
+//
+// Every process writes its files atomically and re-verifies the hash of whatever it reads, so a process never trusts a
+// file another one is part way through writing, or one that was corrupted on disk. Once over its size budget the
+// process that went over evicts the content that's been read least recently.
+class ContentCache : public Dependency {
+    SINGLETON_DEPENDENCY
+
+public:
+    static QString getDefaultDirectory();
+
+    ContentCache(const QString& directory = getDefaultDirectory(), qint64 maximumSize = MAXIMUM_CONTENT_CACHE_SIZE);
+
+    const QString& getDirectory() const { return _directory; }
+    qint64 getMaximumSize() const { return _maximumSize; }
+
+    // returns the content with the given hash, or a null array when it isn't in the cache or fails verification
+    QByteArray load(const AssetHash& hash);
+    bool save(const AssetHash& hash, const QByteArray& data);
+
+    // returns the content last saved for a url, as long as it's still fresh
+    QByteArray loadForUrl(const QUrl& url);
+    bool saveForUrl(const QUrl& url, const QByteArray& data, const QDateTime& expiration);
+
+    void clear();
+
+    static const qint64 MAXIMUM_CONTENT_CACHE_SIZE;
+
+private:
+    QString getContentPath(const AssetHash& hash) const;
+    QString getIndexPath(const QUrl& url) const;
+
+    void evict();
+
+    const QString _directory;
+    const qint64 _maximumSize;
+
+    QMutex _sizeLock;
+    qint64 _size { -1 }; // the size of the content on disk, or -1 until the directory is first scanned
+};
+
+#endif // hifi_ContentCache_h
@@ -12,11 +12,14 @@
 #include "HTTPResourceRequest.h"
 
 #include <QFile>
+#include <QLocale>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QRegExp>
 
 #include <SharedUtil.h>
 
+#include "ContentCache.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 
@@ -28,6 +31,35 @@ HTTPResourceRequest::~HTTPResourceRequest() {
     }
 }
 
+// How long the reply can be used for without revalidating it, by the headers Qt's own cache goes by.
+// Returns an invalid time when it can't be reused at all.
+static QDateTime getExpiration(QNetworkReply* reply) {
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+
+    QString cacheControl = QString::fromLatin1(reply->rawHeader("Cache-Control")).toLower();
+    if (cacheControl.contains("no-store") || cacheControl.contains("no-cache")) {
+        return QDateTime();
+    }
+    QRegExp maxAgeRegex { "max-age=(\\d+)" };
+    if (maxAgeRegex.indexIn(cacheControl) != -1) {
+        return now.addSecs(maxAgeRegex.cap(1).toLongLong());
+    }
+
+    if (reply->hasRawHeader("Expires")) {
+        QDateTime expires = QLocale::c().toDateTime(QString::fromLatin1(reply->rawHeader("Expires")),
+            "ddd, dd MMM yyyy hh:mm:ss 'GMT'");
+        expires.setTimeSpec(Qt::UTC);
+        return expires;
+    }
+
+    // without either, content is fresh for a tenth of the time since it last changed
+    QDateTime lastModified = reply->header(QNetworkRequest::LastModifiedHeader).toDateTime();
+    if (lastModified.isValid()) {
+        return now.addSecs(lastModified.secsTo(now) / 10);
+    }
+    return QDateTime();
+}
+
 void HTTPResourceRequest::setupTimer() {
     Q_ASSERT(!_sendTimer);
     static const int TIMEOUT_MS = 10000;
@@ -76,6 +108,12 @@ void HTTPResourceRequest::onRequestFinished() {
             _data = _reply->readAll();
             _loadedFromCache = _reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
             _result = Success;
+
+            if (_cacheEnabled) {
+                if (auto cache = DependencyManager::get<ContentCache>()) {
+                    cache->saveForUrl(_url, _data, getExpiration(_reply));
+                }
+            }
             break;
         case QNetworkReply::TimeoutError:
             _result = Timeout;
@@ -107,6 +107,10 @@ LimitedNodeList::LimitedNodeList(unsigned short socketListenPort, unsigned short
     // set our isPacketVerified method as the verify operator for the udt::Socket
     using std::placeholders::_1;
     _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
+    _nodeSocket.setReceiveFinishedOperator([this] {
+        _lastPacketSourceID = QUuid();
+        _lastPacketSource.reset();
+    });
 
     _packetStatTimer.start();
 
@@ -238,17 +242,18 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
     } else {
         QUuid sourceID = NLPacket::sourceIDInHeader(packet);
 
-        // figure out which node this is from
-        SharedNodePointer matchingNode = nodeWithUUID(sourceID);
+        // figure out which node this is from, the packets read off the socket together are often from the same one
+        if (sourceID != _lastPacketSourceID || !_lastPacketSource) {
+            _lastPacketSource = nodeWithUUID(sourceID);
+            _lastPacketSourceID = sourceID;
+        }
+        SharedNodePointer matchingNode = _lastPacketSource;
 
         if (matchingNode) {
             if (!NON_VERIFIED_PACKETS.contains(headerType)) {
 
-                QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
-                QByteArray expectedHash = NLPacket::hashForPacketAndSecret(packet, matchingNode->getConnectionSecret());
-
-                // check if the md5 hash in the header matches the hash we would expect
-                if (packetHeaderHash != expectedHash) {
+                // check if the hash in the header matches the hash we would expect
+                if (!NLPacket::verificationHashMatches(packet, matchingNode->getConnectionSecret())) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
 
                     if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
@@ -325,6 +330,41 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const HifiS
     return _nodeSocket.writePacket(packet, sockAddr);
 }
 
+qint64 LimitedNodeList::sendUnreliablePackets(const std::vector<const NLPacket*>& packets, const Node& destinationNode) {
+    auto activeSocket = destinationNode.getActiveSocket();
+    if (!activeSocket || packets.empty()) {
+        return 0;
+    }
+
+    std::vector<const udt::Packet*> datagrams;
+    datagrams.reserve(packets.size());
+
+    for (auto packet : packets) {
+        Q_ASSERT(!packet->isPartOfMessage());
+        Q_ASSERT_X(!packet->isReliable(), "LimitedNodeList::sendUnreliablePackets",
+                   "Trying to send a reliable packet unreliably.");
+
+        emit dataSent(destinationNode.getType(), packet->getDataSize());
+        destinationNode.recordBytesSent(packet->getDataSize());
+
+        collectPacketStats(*packet);
+        fillPacketHeader(*packet, destinationNode.getConnectionSecret());
+
+        datagrams.push_back(packet);
+    }
+
+    std::vector<qint64> bytesWritten;
+    _nodeSocket.writePackets(datagrams, *activeSocket, bytesWritten);
+
+    qint64 totalBytesWritten = 0;
+    for (auto bytes : bytesWritten) {
+        if (bytes > 0) {
+            totalBytesWritten += bytes;
+        }
+    }
+    return totalBytesWritten;
+}
+
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode) {
     Q_ASSERT(!packet->isPartOfMessage());
     auto activeSocket = destinationNode.getActiveSocket();
@@ -396,6 +436,7 @@ qint64 LimitedNodeList::sendPacketList(NLPacketList& packetList, const HifiSockA
 qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList, const HifiSockAddr& sockAddr) {
     // close the last packet in the list
     packetList->closeCurrentPacket();
+    packetList->compressPayload();
 
     for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
         NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
@@ -411,6 +452,7 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
     if (activeSocket) {
         // close the last packet in the list
         packetList->closeCurrentPacket();
+        packetList->compressPayload();
 
         for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
             NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
@@ -489,11 +531,30 @@ void LimitedNodeList::eraseAllNodes() {
         }
     }
 
+    publishNodeSnapshot();
+
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         handleNodeKill(killedNode);
     }
 }
 
+void LimitedNodeList::publishNodeSnapshot() {
+    std::lock_guard<std::mutex> publishLock(_nodeSnapshotMutex);
+
+    auto snapshot = std::make_shared<NodeSnapshot>();
+
+    {
+        QReadLocker readLocker(&_nodeMutex);
+        snapshot->reserve(_nodeHash.size());
+
+        for (auto it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
+            snapshot->push_back(it->second);
+        }
+    }
+
+    std::atomic_store(&_nodeSnapshot, std::shared_ptr<const NodeSnapshot>(std::move(snapshot)));
+}
+
 void LimitedNodeList::reset() {
     eraseAllNodes();
 
@@ -515,6 +576,8 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID) {
             _nodeHash.unsafe_erase(it);
         }
 
+        publishNodeSnapshot();
+
         handleNodeKill(matchingNode);
         return true;
     }
@@ -594,6 +657,8 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         _nodeHash.insert(UUIDNodePair(newNode->getUUID(), newNodePointer));
         readLocker.unlock();
 
+        publishNodeSnapshot();
+
         qCDebug(networking) << "Added" << *newNode;
 
         emit nodeAdded(newNodePointer);
@@ -715,6 +780,10 @@ void LimitedNodeList::removeSilentNodes() {
         node->getMutex().unlock();
     });
 
+    if (!killedNodes.isEmpty()) {
+        publishNodeSnapshot();
+    }
+
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         handleNodeKill(killedNode);
     }
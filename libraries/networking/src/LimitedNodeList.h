@@ -16,8 +16,10 @@
 #include <stdint.h>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <unistd.h> // not on windows, not needed for mac or windows
@@ -65,6 +67,7 @@ const QString USERNAME_UUID_REPLACEMENT_STATS_KEY = "$username";
 using namespace tbb;
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
+typedef std::vector<SharedNodePointer> NodeSnapshot;
 
 typedef quint8 PingType_t;
 namespace PingType {
@@ -121,6 +124,10 @@ public:
     qint64 sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr,
                                 const QUuid& connectionSecret = QUuid());
 
+    // sends a batch of unreliable packets to one node, in as few system calls as the platform allows
+    // returns the number of bytes written for the whole batch
+    qint64 sendUnreliablePackets(const std::vector<const NLPacket*>& packets, const Node& destinationNode);
+
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode);
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr,
                       const QUuid& connectionSecret = QUuid());
@@ -169,32 +176,36 @@ public:
 
     SharedNodePointer findNodeWithAddr(const HifiSockAddr& addr);
     
+    // Returns the last published immutable list of nodes. It is replaced (never modified) whenever a node is added or
+    // removed, so it can be iterated without holding the _nodeMutex. Nodes killed after it was taken are still in it.
+    std::shared_ptr<const NodeSnapshot> getNodeSnapshot() const { return std::atomic_load(&_nodeSnapshot); }
+
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const auto& node : *snapshot) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const auto& node : *snapshot) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const auto& node : *snapshot) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -202,11 +213,11 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const auto& node : *snapshot) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
@@ -223,6 +234,9 @@ public:
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
+    void setBatchedSendEnabled(bool isBatchedSendEnabled) { _nodeSocket.setBatchedSendEnabled(isBatchedSendEnabled); }
+    void setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory> ccFactory)
+        { _nodeSocket.setCongestionControlFactory(std::move(ccFactory)); }
 
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
@@ -293,7 +307,17 @@ protected:
     QUuid _sessionUUID;
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex;
+
+    // must be called after every change to the _nodeHash, without holding the _nodeMutex
+    void publishNodeSnapshot();
+
+    std::shared_ptr<const NodeSnapshot> _nodeSnapshot { std::make_shared<const NodeSnapshot>() };
+    std::mutex _nodeSnapshotMutex; // serializes publishers, readers never take it
     udt::Socket _nodeSocket;
+    // the node the last verified packet came from, until the socket has read everything waiting on it, so that a run
+    // of packets from one node takes one node lookup
+    QUuid _lastPacketSourceID;
+    SharedNodePointer _lastPacketSource;
     QUdpSocket* _dtlsSocket;
     HifiSockAddr _localSockAddr;
     HifiSockAddr _publicSockAddr;
@@ -11,10 +11,12 @@
 
 #include "NLPacket.h"
 
+#include <SipHash.h>
+
 int NLPacket::localHeaderSize(PacketType type) {
     bool nonSourced = NON_SOURCED_PACKETS.contains(type);
     bool nonVerified = NON_VERIFIED_PACKETS.contains(type);
-    qint64 optionalSize = (nonSourced ? 0 : NUM_BYTES_RFC4122_UUID) + ((nonSourced || nonVerified) ? 0 : NUM_BYTES_MD5_HASH);
+    qint64 optionalSize = (nonSourced ? 0 : NUM_BYTES_RFC4122_UUID) + ((nonSourced || nonVerified) ? 0 : NUM_BYTES_VERIFICATION_HASH);
     return sizeof(PacketType) + sizeof(PacketVersion) + optionalSize;
 }
 int NLPacket::totalHeaderSize(PacketType type, bool isPartOfMessage) {
@@ -32,7 +34,7 @@ std::unique_ptr<NLPacket> NLPacket::create(PacketType type, qint64 size, bool is
     return packet;
 }
 
-std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                        const HifiSockAddr& senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
@@ -87,7 +89,7 @@ NLPacket::NLPacket(const NLPacket& other) : Packet(other) {
     _sourceID = other._sourceID;
 }
 
-NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr) :
+NLPacket::NLPacket(udt::PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr) :
     Packet(std::move(data), size, senderSockAddr)
 {    
     // sanity check before we decrease the payloadSize with the payloadCapacity
@@ -144,23 +146,35 @@ QUuid NLPacket::sourceIDInHeader(const udt::Packet& packet) {
     return QUuid::fromRfc4122(QByteArray::fromRawData(packet.getData() + offset, NUM_BYTES_RFC4122_UUID));
 }
 
-QByteArray NLPacket::verificationHashInHeader(const udt::Packet& packet) {
-    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_RFC4122_UUID;
-    return QByteArray(packet.getData() + offset, NUM_BYTES_MD5_HASH);
+static int verificationHashOffset(const udt::Packet& packet) {
+    return udt::Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
+        + NUM_BYTES_RFC4122_UUID;
 }
 
-QByteArray NLPacket::hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret) {
-    QCryptographicHash hash(QCryptographicHash::Md5);
-    
-    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
-        + NUM_BYTES_RFC4122_UUID + NUM_BYTES_MD5_HASH;
-    
-    // add the packet payload and the connection UUID
-    hash.addData(packet.getData() + offset, packet.getDataSize() - offset);
-    hash.addData(connectionSecret.toRfc4122());
-    
-    // return the hash
-    return hash.result();
+void NLPacket::hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret, uint8_t* hash) {
+    // the key is the secret in its RFC 4122 byte order, taken from the fields rather than a QByteArray of it
+    uint8_t key[SipHash::KEY_SIZE];
+    key[0] = (uint8_t)(connectionSecret.data1 >> 24);
+    key[1] = (uint8_t)(connectionSecret.data1 >> 16);
+    key[2] = (uint8_t)(connectionSecret.data1 >> 8);
+    key[3] = (uint8_t)connectionSecret.data1;
+    key[4] = (uint8_t)(connectionSecret.data2 >> 8);
+    key[5] = (uint8_t)connectionSecret.data2;
+    key[6] = (uint8_t)(connectionSecret.data3 >> 8);
+    key[7] = (uint8_t)connectionSecret.data3;
+    memcpy(key + 8, connectionSecret.data4, 8);
+
+    int offset = verificationHashOffset(packet) + NUM_BYTES_VERIFICATION_HASH;
+
+    SipHash sipHash(key, SipHash::Output128);
+    sipHash.addData(packet.getData() + offset, packet.getDataSize() - offset);
+    sipHash.result128(hash);
+}
+
+bool NLPacket::verificationHashMatches(const udt::Packet& packet, const QUuid& connectionSecret) {
+    uint8_t expectedHash[NUM_BYTES_VERIFICATION_HASH];
+    hashForPacketAndSecret(packet, connectionSecret, expectedHash);
+    return memcmp(packet.getData() + verificationHashOffset(packet), expectedHash, NUM_BYTES_VERIFICATION_HASH) == 0;
 }
 
 void NLPacket::writeTypeAndVersion() {
@@ -215,9 +229,6 @@ void NLPacket::writeSourceID(const QUuid& sourceID) const {
 void NLPacket::writeVerificationHashGivenSecret(const QUuid& connectionSecret) const {
     Q_ASSERT(!NON_SOURCED_PACKETS.contains(_type) && !NON_VERIFIED_PACKETS.contains(_type));
     
-    auto offset = Packet::totalHeaderSize(isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
-                + NUM_BYTES_RFC4122_UUID;
-    QByteArray verificationHash = hashForPacketAndSecret(*this, connectionSecret);
-    
-    memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
+    hashForPacketAndSecret(*this, connectionSecret,
+                           reinterpret_cast<uint8_t*>(_packet.get() + verificationHashOffset(*this)));
 }
@@ -19,6 +19,16 @@ std::unique_ptr<NLPacketList> NLPacketList::create(PacketType packetType, QByteA
     auto nlPacketList = std::unique_ptr<NLPacketList>(new NLPacketList(packetType, extendedHeader,
                                                                        isReliable, isOrdered));
     nlPacketList->open(WriteOnly);
+
+    if (isOrdered && packetVersionSupportsCompression(packetType, versionForPacketType(packetType))) {
+        Q_ASSERT_X(extendedHeader.isEmpty(), "NLPacketList::create",
+                   "Compressed payloads do not support an extended header in every packet");
+
+        // start out uncompressed, compressPayload decides once everything is written
+        nlPacketList->_hasPayloadCodec = true;
+        nlPacketList->writePrimitive(PayloadCodec::None);
+    }
+
     return nlPacketList;
 }
 
@@ -44,3 +54,35 @@ NLPacketList::NLPacketList(PacketList&& other) : PacketList(std::move(other)) {
 std::unique_ptr<udt::Packet> NLPacketList::createPacket() {
     return NLPacket::create(getType(), -1, isReliable(), isOrdered());
 }
+
+void NLPacketList::compressPayload() {
+    if (!_hasPayloadCodec) {
+        return;
+    }
+
+    closeCurrentPacket();
+
+    auto message = getMessage();
+
+    // below this the savings don't make up for the time spent compressing
+    static const int MIN_COMPRESSION_SIZE = 1024;
+
+    if (message.size() - 1 < MIN_COMPRESSION_SIZE || message[0] != static_cast<char>(PayloadCodec::None)) {
+        return;
+    }
+
+    static const int COMPRESSION_LEVEL = 1; // favour speed, these are sent from busy servers
+    auto compressed = qCompress(reinterpret_cast<const uchar*>(message.constData() + 1), message.size() - 1,
+                                COMPRESSION_LEVEL);
+
+    if (compressed.size() >= message.size() - 1) {
+        // not worth it, send it as it is
+        return;
+    }
+
+    clearPackets();
+
+    writePrimitive(PayloadCodec::Zlib);
+    write(compressed);
+    closeCurrentPacket();
+}
@@ -16,6 +16,12 @@
 
 #include "NLPacket.h"
 
+// Leads the payload of ordered lists whose packet version supports compression
+enum class PayloadCodec : uint8_t {
+    None,
+    Zlib
+};
+
 class NLPacketList : public udt::PacketList {
 public:
     static std::unique_ptr<NLPacketList> create(PacketType packetType, QByteArray extendedHeader = QByteArray(),
@@ -23,6 +29,10 @@ public:
     
     PacketVersion getVersion() const { return _packetVersion; }
     const QUuid& getSourceID() const { return _sourceID; }
+
+    // Swaps what was written for its compressed form, if this list leads with a PayloadCodec and the payload is
+    // large enough and compresses well - LimitedNodeList calls this once everything has been written
+    void compressPayload();
     
 private:
     NLPacketList(PacketType packetType, QByteArray extendedHeader = QByteArray(), bool isReliable = false,
@@ -36,6 +46,8 @@ private:
 
     PacketVersion _packetVersion;
     QUuid _sourceID;
+
+    bool _hasPayloadCodec { false };
 };
 
 Q_DECLARE_METATYPE(QSharedPointer<NLPacketList>)
@@ -18,6 +18,7 @@
 #include <QtCore/QTimer>
 #include <QtCore/QUuid>
 
+#include "BandwidthRecorder.h"
 #include "HifiSockAddr.h"
 
 const QString ICE_SERVER_HOSTNAME = "localhost";
@@ -100,6 +101,9 @@ protected:
     QTimer* _pingTimer = NULL;
 
     int _connectionAttempts;
+
+    // counted on the threads that send and receive the packets of the peer, without a lock
+    mutable BandwidthRecorder::Channel _bandwidth;
 };
 
 QDebug operator<<(QDebug debug, const NetworkPeer &peer);
@@ -113,4 +113,10 @@ namespace std {
 
 QDebug operator<<(QDebug debug, const Node& node);
 
+// Each entry of a domain list starts with its type: a node the receiver is interested in, or the ID of one that is gone
+enum class DomainListEntryType : quint8 {
+    Node = 0,
+    RemovedNode
+};
+
 #endif // hifi_Node_h
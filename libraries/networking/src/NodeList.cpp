@@ -11,6 +11,8 @@
 
 #include "NodeList.h"
 
+#include <algorithm>
+
 #include <QtCore/QDataStream>
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
@@ -217,6 +219,7 @@ void NodeList::reset() {
     LimitedNodeList::reset();
 
     _numNoReplyDomainCheckIns = 0;
+    _domainListVersion = 0;
 
     // lock and clear our set of ignored IDs
     _ignoredSetLock.lockForWrite();
@@ -332,6 +335,11 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType << _publicSockAddr << _localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // the domain-server only sends us what changed since the list we have
+            packetStream << _domainListVersion;
+        }
+
         if (!_domainHandler.isConnected()) {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
@@ -559,9 +567,27 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     packetStream >> newPermissions;
     setPermissions(newPermissions);
 
+    // the list holds the changes from the version of the list in base to its own version, 0 for the whole list
+    quint64 baseVersion, listVersion;
+    packetStream >> baseVersion >> listVersion;
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        quint8 entryType;
+        packetStream >> entryType;
+
+        if (entryType == (quint8) DomainListEntryType::RemovedNode) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeWithUUID(nodeUUID);
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
+    }
+
+    // if we missed the list before this one, we keep asking for the changes from the last one we have
+    if (baseVersion <= _domainListVersion) {
+        _domainListVersion = std::max(_domainListVersion, listVersion);
     }
 }
 
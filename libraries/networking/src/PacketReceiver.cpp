@@ -12,20 +12,98 @@
 
 #include "PacketReceiver.h"
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 #include <QMutexLocker>
+#include <QReadLocker>
+#include <QThread>
+#include <QWriteLocker>
 
 #include "DependencyManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 #include "SharedUtil.h"
 
+// Runs the invocations for concurrent listeners, in the order they were queued
+class PacketReceiver::DispatchWorker {
+public:
+    DispatchWorker() : _thread(&DispatchWorker::run, this) {}
+
+    ~DispatchWorker() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isStopped = true;
+        }
+        _condition.notify_one();
+        _thread.join();
+    }
+
+    void queueTask(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _condition.notify_one();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true) {
+            _condition.wait(lock, [this] { return _isStopped || !_tasks.empty(); });
+
+            if (_tasks.empty()) {
+                // we've been stopped and have nothing left to deliver
+                return;
+            }
+
+            auto task = std::move(_tasks.front());
+            _tasks.pop_front();
+
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _tasks;
+    bool _isStopped { false };
+
+    // declared last so that everything it uses has been constructed when it starts
+    std::thread _thread;
+};
+
 PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
     qRegisterMetaType<QSharedPointer<NLPacket>>();
     qRegisterMetaType<QSharedPointer<NLPacketList>>();
     qRegisterMetaType<QSharedPointer<ReceivedMessage>>();
 }
 
+PacketReceiver::~PacketReceiver() {
+    // defined here so that DispatchWorker is complete, this joins each of the worker threads
+}
+
 bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot) {
+    return registerListenerForTypes(std::move(types), listener, slot, false);
+}
+
+bool PacketReceiver::registerConcurrentListenerForTypes(PacketTypeList types, QObject* listener, const char* slot) {
+    return registerListenerForTypes(std::move(types), listener, slot, true);
+}
+
+bool PacketReceiver::registerConcurrentListener(PacketType type, QObject* listener, const char* slot) {
+    return registerListenerForTypes({ type }, listener, slot, true);
+}
+
+bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot,
+                                              bool isConcurrent) {
     Q_ASSERT_X(!types.empty(), "PacketReceiver::registerListenerForTypes", "No types to register");
     Q_ASSERT_X(listener, "PacketReceiver::registerListenerForTypes", "No object to register");
     Q_ASSERT_X(slot, "PacketReceiver::registerListenerForTypes", "No slot to register");
@@ -54,13 +132,13 @@ bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* lis
     }
     
     // Register non sourced types
-    std::for_each(std::begin(types), middle, [this, &listener, &nonSourcedMethod](PacketType type) {
-        registerVerifiedListener(type, listener, nonSourcedMethod);
+    std::for_each(std::begin(types), middle, [this, &listener, &nonSourcedMethod, isConcurrent](PacketType type) {
+        registerVerifiedListener(type, listener, nonSourcedMethod, false, isConcurrent);
     });
     
     // Register sourced types
-    std::for_each(middle, std::end(types), [this, &listener, &sourcedMethod](PacketType type) {
-        registerVerifiedListener(type, listener, sourcedMethod);
+    std::for_each(middle, std::end(types), [this, &listener, &sourcedMethod, isConcurrent](PacketType type) {
+        registerVerifiedListener(type, listener, sourcedMethod, false, isConcurrent);
     });
     
     return true;
@@ -165,22 +243,39 @@ QMetaMethod PacketReceiver::matchingMethodForListener(PacketType type, QObject*
     }
 }
 
-void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object, const QMetaMethod& slot, bool deliverPending) {
+void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object, const QMetaMethod& slot,
+                                              bool deliverPending, bool isConcurrent) {
     Q_ASSERT_X(object, "PacketReceiver::registerVerifiedListener", "No object to register");
     QMutexLocker locker(&_packetListenerLock);
 
+    if (isConcurrent && _dispatchWorkers.empty()) {
+        // this is the first concurrent listener, spin up the dispatch workers
+        int numDispatchWorkers = _numDispatchWorkers > 0 ? _numDispatchWorkers : std::max(QThread::idealThreadCount() - 1, 1);
+
+        qCDebug(networking) << "Starting" << numDispatchWorkers << "packet dispatch workers";
+
+        for (int i = 0; i < numDispatchWorkers; ++i) {
+            _dispatchWorkers.emplace_back(new DispatchWorker);
+        }
+    }
+
     if (_messageListenerMap.contains(type)) {
         qCWarning(networking) << "Registering a packet listener for packet type" << type
             << "that will remove a previously registered listener";
     }
     
     // add the mapping
-    _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending };
+    std::shared_ptr<ConcurrentGuard> guard;
+    if (isConcurrent) {
+        guard = std::make_shared<ConcurrentGuard>();
+    }
+    _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending, isConcurrent, guard };
 }
 
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
-    
+
+    std::vector<std::shared_ptr<ConcurrentGuard>> concurrentGuards;
     {
         QMutexLocker packetListenerLocker(&_packetListenerLock);
         
@@ -189,12 +284,22 @@ void PacketReceiver::unregisterListener(QObject* listener) {
         
         while (it != _messageListenerMap.end()) {
             if (it.value().object == listener) {
+                if (it.value().guard) {
+                    concurrentGuards.push_back(it.value().guard);
+                }
                 it = _messageListenerMap.erase(it);
             } else {
                 ++it;
             }
         }
     }
+
+    // nothing new is queued for the listener now, wait for the invocations running on the dispatch workers and keep
+    // the ones still queued from starting, so that the listener can be destroyed as soon as we return
+    for (auto& guard : concurrentGuards) {
+        QWriteLocker guardLocker(&guard->lock);
+        guard->isRegistered = false;
+    }
     
     QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
     _directlyConnectedObjects.remove(listener);
@@ -206,15 +311,14 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
         return;
     }
     
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
-    
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
-    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
 
     _inPacketCount += 1;
     _inByteCount += nlPacket->size();
 
+    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
+
     handleVerifiedMessage(receivedMessage, true);
 }
 
@@ -230,14 +334,14 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
 
     if (it == _pendingMessages.end()) {
         // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+        message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
         if (!message->isComplete()) {
             _pendingMessages[key] = message;
         }
         handleVerifiedMessage(message, true);
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
@@ -257,7 +361,7 @@ void PacketReceiver::handleMessageFailure(HifiSockAddr from, udt::Packet::Messag
 }
 
 void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> receivedMessage, bool justReceived) {
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    auto nodeList = DependencyManager::getRaw<LimitedNodeList>();
     
     SharedNodePointer matchingNode;
     
@@ -281,7 +385,28 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
     
         if (listener.object) {
             
-            bool success = false;
+            PacketType packetType = receivedMessage->getType();
+
+            if (matchingNode) {
+                matchingNode->recordBytesReceived(receivedMessage->getSize());
+            }
+
+            if (listener.isConcurrent) {
+                // hand this message off to the dispatch worker for its sender, it will invoke the listener directly
+                dispatchWorkerForMessage(*receivedMessage).queueTask([listener, receivedMessage, matchingNode, packetType] {
+                    QReadLocker guardLocker(&listener.guard->lock);
+                    if (!listener.guard->isRegistered) {
+                        return;
+                    }
+
+                    if (!invokeListener(listener, Qt::DirectConnection, receivedMessage, matchingNode)) {
+                        qCDebug(networking).nospace() << "Error delivering packet " << packetType << " to concurrent listener "
+                            << listener.object << "::" << qPrintable(listener.method.methodSignature());
+                    }
+                });
+
+                return;
+            }
 
             Qt::ConnectionType connectionType;
             // check if this is a directly connected listener
@@ -291,54 +416,18 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
                 connectionType = _directlyConnectedObjects.contains(listener.object) ? Qt::DirectConnection : Qt::AutoConnection;
             }
             
-            PacketType packetType = receivedMessage->getType();
-            
-            if (matchingNode) {
-                matchingNode->recordBytesReceived(receivedMessage->getSize());
-
-                QMetaMethod metaMethod = listener.method;
-                
-                static const QByteArray QSHAREDPOINTER_NODE_NORMALIZED = QMetaObject::normalizedType("QSharedPointer<Node>");
-                static const QByteArray SHARED_NODE_NORMALIZED = QMetaObject::normalizedType("SharedNodePointer");
-                
-                // one final check on the QPointer before we go to invoke
-                if (listener.object) {
-                    if (metaMethod.parameterTypes().contains(SHARED_NODE_NORMALIZED)) {
-                        success = metaMethod.invoke(listener.object,
-                                                    connectionType,
-                                                    Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
-                                                    Q_ARG(SharedNodePointer, matchingNode));
-                        
-                    } else if (metaMethod.parameterTypes().contains(QSHAREDPOINTER_NODE_NORMALIZED)) {
-                        success = metaMethod.invoke(listener.object,
-                                                    connectionType,
-                                                    Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
-                                                    Q_ARG(QSharedPointer<Node>, matchingNode));
-                        
-                    } else {
-                        success = metaMethod.invoke(listener.object,
-                                                    connectionType,
-                                                    Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage));
-                    }
-                } else {
-                    listenerIsDead = true;
+            // one final check on the QPointer before we go to invoke
+            if (listener.object) {
+                // unsourced messages have always been delivered with an automatic connection
+                bool success = invokeListener(listener, matchingNode ? connectionType : Qt::AutoConnection,
+                                              receivedMessage, matchingNode);
+
+                if (!success) {
+                    qCDebug(networking).nospace() << "Error delivering packet " << packetType << " to listener "
+                        << listener.object << "::" << qPrintable(listener.method.methodSignature());
                 }
             } else {
-                // qDebug() << "Got verified unsourced packet list: " << QString(nlPacketList->getMessage());
-                
-                // one final check on the QPointer before we invoke
-                if (listener.object) {
-                    success = listener.method.invoke(listener.object,
-                                                     Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage));
-                } else {
-                    listenerIsDead = true;
-                }
-                
-            }
-            
-            if (!success) {
-                qCDebug(networking).nospace() << "Error delivering packet " << packetType << " to listener "
-                    << listener.object << "::" << qPrintable(listener.method.methodSignature());
+                listenerIsDead = true;
             }
             
         } else {
@@ -360,6 +449,52 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
         qCWarning(networking) << "No listener found for packet type" << receivedMessage->getType();
         
         // insert a dummy listener so we don't print this again
-        _messageListenerMap.insert(receivedMessage->getType(), { nullptr, QMetaMethod(), false });
+        _messageListenerMap.insert(receivedMessage->getType(), { nullptr, QMetaMethod(), false, false });
+    }
+}
+
+bool PacketReceiver::invokeListener(const Listener& listener, Qt::ConnectionType connectionType,
+                                    QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer matchingNode) {
+    if (!listener.object) {
+        return false;
+    }
+
+    if (matchingNode) {
+        QMetaMethod metaMethod = listener.method;
+
+        static const QByteArray QSHAREDPOINTER_NODE_NORMALIZED = QMetaObject::normalizedType("QSharedPointer<Node>");
+        static const QByteArray SHARED_NODE_NORMALIZED = QMetaObject::normalizedType("SharedNodePointer");
+
+        if (metaMethod.parameterTypes().contains(SHARED_NODE_NORMALIZED)) {
+            return metaMethod.invoke(listener.object,
+                                     connectionType,
+                                     Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
+                                     Q_ARG(SharedNodePointer, matchingNode));
+
+        } else if (metaMethod.parameterTypes().contains(QSHAREDPOINTER_NODE_NORMALIZED)) {
+            return metaMethod.invoke(listener.object,
+                                     connectionType,
+                                     Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
+                                     Q_ARG(QSharedPointer<Node>, matchingNode));
+
+        } else {
+            return metaMethod.invoke(listener.object,
+                                     connectionType,
+                                     Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage));
+        }
+    } else {
+        // qDebug() << "Got verified unsourced packet list: " << QString(nlPacketList->getMessage());
+        return listener.method.invoke(listener.object,
+                                      connectionType,
+                                      Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage));
     }
 }
+
+PacketReceiver::DispatchWorker& PacketReceiver::dispatchWorkerForMessage(ReceivedMessage& receivedMessage) {
+    // pick the worker from the sender so that messages from one sender are always handled in order
+    size_t senderHash = receivedMessage.getSourceID().isNull()
+        ? std::hash<HifiSockAddr>()(receivedMessage.getSenderSockAddr())
+        : qHash(receivedMessage.getSourceID());
+
+    return *_dispatchWorkers[senderHash % _dispatchWorkers.size()];
+}
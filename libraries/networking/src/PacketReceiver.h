@@ -13,6 +13,7 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
@@ -21,6 +22,7 @@
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QSet>
 
 #include "NLPacket.h"
@@ -29,6 +31,7 @@
 #include "udt/PacketHeaders.h"
 
 class EntityEditPacketSender;
+class Node;
 class OctreePacketProcessor;
 
 namespace std {
@@ -47,6 +50,7 @@ public:
     
     PacketReceiver(QObject* parent = 0);
     PacketReceiver(const PacketReceiver&) = delete;
+    ~PacketReceiver();
 
     PacketReceiver& operator=(const PacketReceiver&) = delete;
     
@@ -62,6 +66,19 @@ public:
     // for the message is received.
     bool registerListener(PacketType type, QObject* listener, const char* slot, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
+
+    // Concurrent listeners are invoked directly on one of the PacketReceiver's dispatch workers instead of
+    // on the listener's thread. Messages from the same sender are always handled by the same worker, and so in
+    // the order they were received. The slot must be safe to call concurrently for messages from different senders.
+    // The listener has to be unregistered before it is destroyed, and not from inside one of its concurrent slots.
+    bool registerConcurrentListener(PacketType type, QObject* listener, const char* slot);
+    bool registerConcurrentListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
+
+    // Sets the number of dispatch workers that will be started for the first concurrent listener
+    // (defaults to one less than the ideal thread count)
+    void setNumDispatchWorkers(int numDispatchWorkers) { _numDispatchWorkers = numDispatchWorkers; }
+
+    // once this returns no slot of the listener is running on a dispatch worker, and none will be invoked again
     void unregisterListener(QObject* listener);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
@@ -69,13 +86,29 @@ public:
     void handleMessageFailure(HifiSockAddr from, udt::Packet::MessageNumber messageNumber);
     
 private:
+    // held for reading by a dispatch worker while it invokes a concurrent listener, and for writing while the
+    // listener is unregistered, so that the listener isn't invoked once unregisterListener has returned
+    struct ConcurrentGuard {
+        QReadWriteLock lock;
+        bool isRegistered { true };
+    };
+
     struct Listener {
         QPointer<QObject> object;
         QMetaMethod method;
         bool deliverPending;
+        bool isConcurrent;
+        std::shared_ptr<ConcurrentGuard> guard; // the concurrent listeners only
     };
 
+    class DispatchWorker;
+
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
+    static bool invokeListener(const Listener& listener, Qt::ConnectionType connectionType,
+                               QSharedPointer<ReceivedMessage> receivedMessage, QSharedPointer<Node> matchingNode);
+    DispatchWorker& dispatchWorkerForMessage(ReceivedMessage& receivedMessage);
+
+    bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot, bool isConcurrent);
 
     // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
     // should be changed to have a true event loop and be able to handle our QMetaMethod::invoke
@@ -83,7 +116,8 @@ private:
     void registerDirectListener(PacketType type, QObject* listener, const char* slot);
 
     QMetaMethod matchingMethodForListener(PacketType type, QObject* object, const char* slot) const;
-    void registerVerifiedListener(PacketType type, QObject* listener, const QMetaMethod& slot, bool deliverPending = false);
+    void registerVerifiedListener(PacketType type, QObject* listener, const QMetaMethod& slot,
+                                  bool deliverPending = false, bool isConcurrent = false);
 
     QMutex _packetListenerLock;
     QHash<PacketType, Listener> _messageListenerMap;
@@ -94,6 +128,9 @@ private:
     QSet<QObject*> _directlyConnectedObjects;
 
     std::unordered_map<std::pair<HifiSockAddr, udt::Packet::MessageNumber>, QSharedPointer<ReceivedMessage>> _pendingMessages;
+
+    int _numDispatchWorkers { -1 };
+    std::vector<std::unique_ptr<DispatchWorker>> _dispatchWorkers;
     
     friend class EntityEditPacketSender;
     friend class OctreePacketProcessor;
@@ -12,8 +12,12 @@
 
 #include "ReceivedMessage.h"
 
+#include <algorithm>
+
 #include "QSharedPointer"
 
+#include "NetworkLogging.h"
+
 int receivedMessageMetaTypeId = qRegisterMetaType<ReceivedMessage*>("ReceivedMessage*");
 int sharedPtrReceivedMessageMetaTypeId = qRegisterMetaType<QSharedPointer<ReceivedMessage>>("QSharedPointer<ReceivedMessage>");
 
@@ -21,7 +25,9 @@ static const int HEAD_DATA_SIZE = 512;
 
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
     : _data(packetList.getMessage()),
+      _isFlattened(true),
       _headData(_data.mid(0, HEAD_DATA_SIZE)),
+      _size(_data.size()),
       _numPackets(packetList.getNumPackets()),
       _sourceID(packetList.getSourceID()),
       _packetType(packetList.getType()),
@@ -29,11 +35,14 @@ ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
       _senderSockAddr(packetList.getSenderSockAddr()),
       _isComplete(true)
 {
+    decodePayload();
 }
 
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
     : _data(packet.readAll()),
+      _isFlattened(true),
       _headData(_data.mid(0, HEAD_DATA_SIZE)),
+      _size(_data.size()),
       _numPackets(1),
       _sourceID(packet.getSourceID()),
       _packetType(packet.getType()),
@@ -41,6 +50,41 @@ ReceivedMessage::ReceivedMessage(NLPacket& packet)
       _senderSockAddr(packet.getSenderSockAddr()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
+    if (_isComplete) {
+        decodePayload();
+    }
+}
+
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet)
+    : _headData(packet->getPayload(), std::min(packet->getPayloadSize(), (qint64) HEAD_DATA_SIZE)),
+      _numPackets(1),
+      _sourceID(packet->getSourceID()),
+      _packetType(packet->getType()),
+      _packetVersion(packet->getVersion()),
+      _senderSockAddr(packet->getSenderSockAddr()),
+      _isComplete(packet->getPacketPosition() == NLPacket::ONLY)
+{
+    appendChunk(std::move(packet));
+
+    if (_isComplete) {
+        decodePayload();
+    }
+}
+
+QByteArray ReceivedMessage::getMessage() const {
+    std::lock_guard<std::mutex> lock(_chunksMutex);
+    if (!flatten()) {
+        return QByteArray();
+    }
+    return _data;
+}
+
+const char* ReceivedMessage::getRawMessage() const {
+    std::lock_guard<std::mutex> lock(_chunksMutex);
+    if (!flatten()) {
+        return nullptr;
+    }
+    return _data.constData();
 }
 
 void ReceivedMessage::setFailed() {
@@ -58,7 +102,12 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
+    {
+        std::lock_guard<std::mutex> lock(_chunksMutex);
+        flatten();
+        _data.append(packet.getPayload(), packet.getPayloadSize());
+        _size += packet.getPayloadSize();
+    }
 
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress();
@@ -66,17 +115,163 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
 
     if (packet.getPacketPosition() == NLPacket::PacketPosition::LAST) {
         _isComplete = true;
+        decodePayload();
+        emit completed();
+    }
+}
+
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
+    Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket",
+               "We should not be appending to a complete message");
+
+    // Limit progress signal to every X packets
+    const int EMIT_PROGRESS_EVERY_X_PACKETS = 100;
+
+    ++_numPackets;
+
+    bool isLast = packet->getPacketPosition() == NLPacket::PacketPosition::LAST;
+
+    appendChunk(std::move(packet));
+
+    if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
+        emit progress();
+    }
+
+    if (isLast) {
+        _isComplete = true;
+        decodePayload();
         emit completed();
     }
 }
 
+void ReceivedMessage::appendChunk(std::unique_ptr<NLPacket> packet) {
+    auto payloadSize = packet->getPayloadSize();
+
+    std::lock_guard<std::mutex> lock(_chunksMutex);
+    if (_isFlattened) {
+        // someone already needed this message in one piece, keep it that way
+        _data.append(packet->getPayload(), payloadSize);
+    } else {
+        _chunks.push_back({ std::move(packet), _size.load() });
+    }
+
+    _size += payloadSize;
+}
+
+std::vector<ReceivedMessage::Chunk>::const_iterator ReceivedMessage::chunkForPosition(qint64 position) const {
+    // find the last chunk starting at or before the position
+    auto it = std::upper_bound(_chunks.cbegin(), _chunks.cend(), position, [](qint64 position, const Chunk& chunk) {
+        return position < chunk.offset;
+    });
+
+    return it == _chunks.cbegin() ? it : it - 1;
+}
+
+bool ReceivedMessage::copyData(qint64 position, char* data, qint64 size) const {
+    std::lock_guard<std::mutex> lock(_chunksMutex);
+    if (_isFlattened) {
+        memcpy(data, _data.constData() + position, size);
+        return true;
+    }
+
+    auto first = chunkForPosition(position);
+    if (size > 0 && first != _chunks.cend() && !first->packet) {
+        // the chunks are released in order, so if any of the range was it is the start of it
+        qCWarning(networking) << "Cannot read data of a" << _packetType << "message that was already released";
+        return false;
+    }
+
+    for (auto it = first; size > 0 && it != _chunks.cend(); ++it) {
+        auto offsetInChunk = position - it->offset;
+        auto bytesToCopy = std::min(size, it->packet->getPayloadSize() - offsetInChunk);
+
+        memcpy(data, it->packet->getPayload() + offsetInChunk, bytesToCopy);
+
+        data += bytesToCopy;
+        position += bytesToCopy;
+        size -= bytesToCopy;
+    }
+    return true;
+}
+
+const char* ReceivedMessage::contiguousData(qint64 position, qint64 size) const {
+    std::lock_guard<std::mutex> lock(_chunksMutex);
+    if (!_isFlattened && !_chunks.empty()) {
+        auto it = chunkForPosition(position);
+        auto offsetInChunk = position - it->offset;
+
+        if (it->packet && offsetInChunk + size <= it->packet->getPayloadSize()) {
+            return it->packet->getPayload() + offsetInChunk;
+        }
+    }
+
+    if (!flatten()) {
+        qCWarning(networking) << "Cannot read data of a" << _packetType << "message that was already released";
+        return nullptr;
+    }
+    return _data.constData() + position;
+}
+
+bool ReceivedMessage::flatten() const {
+    if (_isFlattened) {
+        return true;
+    }
+
+    if (_numReleasedChunks > 0) {
+        return false;
+    }
+
+    _data.reserve(_size);
+    for (const auto& chunk : _chunks) {
+        _data.append(chunk.packet->getPayload(), chunk.packet->getPayloadSize());
+    }
+
+    _chunks.clear();
+    _isFlattened = true;
+    return true;
+}
+
+void ReceivedMessage::decodePayload() {
+    if (!packetVersionSupportsCompression(_packetType, _packetVersion) || _size == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_chunksMutex);
+    if (!flatten()) {
+        qCDebug(networking) << "Could not decode the payload of a" << _packetType
+            << "message that was already released - dropping it";
+        _failed = true;
+        return;
+    }
+
+    auto codec = static_cast<PayloadCodec>(_data[0]);
+
+    if (codec == PayloadCodec::Zlib) {
+        _data = qUncompress(reinterpret_cast<const uchar*>(_data.constData() + 1), _data.size() - 1);
+
+        if (_data.isEmpty()) {
+            qCDebug(networking) << "Could not decompress the payload of a" << _packetType << "message - dropping it";
+            _failed = true;
+        }
+    } else {
+        _data.remove(0, sizeof(PayloadCodec));
+    }
+
+    _size = _data.size();
+    _headData = _data.left(HEAD_DATA_SIZE);
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
+    if (!copyData(_position, data, size)) {
+        return -1;
+    }
     return size;
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
+    if (!copyData(_position, data, size)) {
+        return -1;
+    }
     _position += size;
     return size;
 }
@@ -88,12 +283,21 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    // match QByteArray::mid, which these used to be, and clamp to what is left
+    if (size < 0 || size > getBytesLeftToRead()) {
+        size = std::max(getBytesLeftToRead(), (qint64) 0);
+    }
+
+    QByteArray data { (int) size, Qt::Uninitialized };
+    if (!copyData(_position, data.data(), size)) {
+        return QByteArray();
+    }
+    return data;
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
-    _position += size;
+    auto data = peek(size);
+    _position += data.size();
     return data;
 }
 
@@ -111,17 +315,65 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
-    auto string = QString::fromUtf8(_data.constData() + _position, size);
+    auto stringData = contiguousData(_position, size);
+    if (!stringData) {
+        return QString();
+    }
+    auto string = QString::fromUtf8(stringData, size);
     _position += size;
     return string;
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
-    QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
+    auto rawData = contiguousData(_position, size);
+    if (!rawData) {
+        return QByteArray();
+    }
+    QByteArray data { QByteArray::fromRawData(rawData, size) };
     _position += size;
     return data;
 }
 
+QByteArray ReceivedMessage::readChunk(qint64 maxSize) {
+    auto size = std::min(maxSize, getBytesLeftToRead());
+
+    if (size > 0) {
+        std::lock_guard<std::mutex> lock(_chunksMutex);
+        if (!_isFlattened && !_chunks.empty()) {
+            auto it = chunkForPosition(_position);
+            if (!it->packet) {
+                qCWarning(networking) << "Cannot read data of a" << _packetType << "message that was already released";
+                return QByteArray();
+            }
+            auto offsetInChunk = _position - it->offset;
+            size = std::min(size, it->packet->getPayloadSize() - offsetInChunk);
+
+            // the packet itself doesn't move when the list of chunks grows
+            QByteArray data { QByteArray::fromRawData(it->packet->getPayload() + offsetInChunk, size) };
+            _position += size;
+            return data;
+        }
+    }
+
+    return readWithoutCopy(size);
+}
+
+void ReceivedMessage::releaseReadData() {
+    std::lock_guard<std::mutex> lock(_chunksMutex);
+    if (_isFlattened) {
+        return;
+    }
+
+    while (_numReleasedChunks < _chunks.size()) {
+        auto& chunk = _chunks[_numReleasedChunks];
+        if (chunk.offset + chunk.packet->getPayloadSize() > _position) {
+            break;
+        }
+        chunk.packet.reset();
+        ++_numReleasedChunks;
+    }
+}
+
 void ReceivedMessage::onComplete() {
     _isComplete = true;
     emit completed();
@@ -16,6 +16,9 @@
 #include <QObject>
 
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "NLPacketList.h"
 
@@ -25,8 +28,13 @@ public:
     ReceivedMessage(const NLPacketList& packetList);
     ReceivedMessage(NLPacket& packet);
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    // takes ownership of the packet so its payload can be read in place, without a copy
+    ReceivedMessage(std::unique_ptr<NLPacket> packet);
+
+    // the message is held as the list of received packet payloads, these flatten it into one buffer on first use,
+    // and return nothing once releaseReadData has dropped some of it
+    QByteArray getMessage() const;
+    const char* getRawMessage() const;
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
@@ -34,6 +42,7 @@ public:
     void setFailed();
 
     void appendPacket(NLPacket& packet);
+    void appendPacket(std::unique_ptr<NLPacket> packet);
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
@@ -46,12 +55,13 @@ public:
     // Get the number of packets that were used to send this message
     qint64 getNumPackets() const { return _numPackets; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size - _position; }
 
     void seek(qint64 position) { _position = position; }
 
+    // these return -1 without moving the position if the data was released
     qint64 peek(char* data, qint64 size);
     qint64 read(char* data, qint64 size);
 
@@ -72,6 +82,15 @@ public:
     // exceed that of the ReceivedMessage.
     QByteArray readWithoutCopy(qint64 size);
 
+    // Returns up to maxSize bytes from the current position, stopping at the end of the packet payload they are in.
+    // Like readWithoutCopy the data is not copied, but unlike it this never needs to flatten the message.
+    QByteArray readChunk(qint64 maxSize);
+
+    // Drops the packets the position is past, for a message read a chunk at a time while it is still arriving, so it
+    // doesn't have to be held in memory all at once. The data released can't be read again, and the message can't be
+    // flattened anymore: reads that need it fail, and only readChunk and readHead can be counted on after this.
+    void releaseReadData();
+
     template<typename T> qint64 peekPrimitive(T* data);
     template<typename T> qint64 readPrimitive(T* data);
 
@@ -85,9 +104,39 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
+    struct Chunk {
+        std::unique_ptr<NLPacket> packet; // null once released
+        qint64 offset; // position of the start of this payload in the message
+    };
+
+    void appendChunk(std::unique_ptr<NLPacket> packet);
+    std::vector<Chunk>::const_iterator chunkForPosition(qint64 position) const;
+
+    // copies size bytes at position into data, across as many chunks as needed, false if some of them were released
+    bool copyData(qint64 position, char* data, qint64 size) const;
+
+    // returns a pointer to size contiguous bytes at position, flattening the message only if they span chunks,
+    // or null if they can't be had because some of the message was released
+    const char* contiguousData(qint64 position, qint64 size) const;
+
+    // _chunksMutex has to be held, false if the message can't be flattened because some of it was released
+    bool flatten() const;
+
+    // strips the PayloadCodec byte from messages whose version has one, decompressing the rest if needed
+    void decodePayload();
+
+    // once flattened the message lives in _data and _chunks is empty
+    mutable std::vector<Chunk> _chunks;
+    // the packets are appended on the thread receiving them while a message still arriving can be read on another,
+    // so the chunks, _data and _isFlattened are only touched with this held
+    mutable std::mutex _chunksMutex;
+    size_t _numReleasedChunks { 0 };
+    mutable QByteArray _data;
+    mutable bool _isFlattened { false };
     QByteArray _headData;
 
+    std::atomic<qint64> _size { 0 };
+
     std::atomic<qint64> _position { 0 };
     std::atomic<qint64> _numPackets { 0 };
 
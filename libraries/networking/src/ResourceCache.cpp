@@ -9,12 +9,15 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <cfloat>
+#include <climits>
 #include <cmath>
 
 #include <QThread>
 #include <QTimer>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <assert.h>
 
@@ -28,23 +31,106 @@
                            (((x) > (max)) ? (max) :\
                                             (x)))
 
+// requests to a host are held back once it has this many, except for the local ones, which have no host
+const int DEFAULT_ATP_REQUEST_LIMIT = 8;
+const int DEFAULT_HTTP_REQUEST_LIMIT_PER_HOST = 6;
+
+// an active request is only paused for a higher priority one once it has had time to get somewhere,
+// and not when most of it has arrived
+const quint64 MIN_USECS_BEFORE_PAUSE = 3 * USECS_PER_SECOND;
+
+static QString getRequestHost(const QUrl& activeUrl) {
+    auto url = ResourceManager::normalizeURL(activeUrl);
+    auto scheme = url.scheme();
+    if (scheme == URL_SCHEME_ATP) {
+        return URL_SCHEME_ATP;
+    } else if (scheme == URL_SCHEME_HTTP || scheme == URL_SCHEME_HTTPS) {
+        return QString("%1://%2:%3").arg(scheme, url.host().toLower(), QString::number(url.port(-1)));
+    }
+    return QString();
+}
+
+int ResourceCacheSharedItems::getHostLimit(const QString& host) const {
+    if (host.isEmpty()) {
+        return INT_MAX;
+    } else if (host == URL_SCHEME_ATP) {
+        return ResourceCache::getATPRequestLimit();
+    }
+    return ResourceCache::getHTTPRequestLimitPerHost();
+}
+
 void ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    if (!strongResource) {
+        return;
+    }
+    auto host = getRequestHost(strongResource->_activeUrl);
+
     Lock lock(_mutex);
-    _loadingRequests.append(resource);
+    _loadingRequests.append({ resource, host, usecTimestampNow(), false });
+    _activeRequestsPerHost[host]++;
 }
 
 void ResourceCacheSharedItems::appendPendingRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    if (!strongResource) {
+        return;
+    }
+    auto host = getRequestHost(strongResource->_activeUrl);
+    float priority = strongResource->getLoadPriority();
+
     Lock lock(_mutex);
-    _pendingRequests.append(resource);
+    if (strongResource->_pendingSequence == 0) {
+        _numPendingRequests++;
+    }
+    strongResource->_pendingSequence = ++_lastSequence;
+    strongResource->_pendingPriority = priority;
+
+    auto& heap = _pendingRequests[host];
+    heap.push_back({ priority, strongResource->_pendingSequence, resource });
+    std::push_heap(heap.begin(), heap.end());
+}
+
+void ResourceCacheSharedItems::updatePendingRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    if (!strongResource) {
+        return;
+    }
+    auto host = getRequestHost(strongResource->_activeUrl);
+    float priority = strongResource->getLoadPriority();
+
+    // the entry it was queued with becomes stale
+    Lock lock(_mutex);
+    if (strongResource->_pendingSequence == 0) {
+        return;
+    }
+    strongResource->_pendingSequence = ++_lastSequence;
+    strongResource->_pendingPriority = priority;
+
+    auto& heap = _pendingRequests[host];
+    heap.push_back({ priority, strongResource->_pendingSequence, resource });
+    std::push_heap(heap.begin(), heap.end());
+}
+
+void ResourceCacheSharedItems::removePendingRequest(Resource* resource) {
+    // its entries are dropped as they come up
+    Lock lock(_mutex);
+    if (resource->_pendingSequence != 0) {
+        resource->_pendingSequence = 0;
+        _numPendingRequests--;
+    }
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _pendingRequests) {
-        if (resource) {
-            result.append(resource);
+    for (auto& heap : _pendingRequests) {
+        for (auto& request : heap) {
+            auto resource = request.resource.lock();
+            if (resource && resource->_pendingSequence == request.sequence) {
+                result.append(resource);
+            }
         }
     }
 
@@ -53,14 +139,15 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return _numPendingRequests;
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _loadingRequests) {
+    foreach(const ActiveRequest& request, _loadingRequests) {
+        auto resource = request.resource.lock();
         if (resource) {
             result.append(resource);
         }
@@ -76,9 +163,10 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        auto request = _loadingRequests.at(i).resource;
         // Clear our resource and any freed resources
         if (!request || request.data() == resource.data()) {
+            _activeRequestsPerHost[_loadingRequests.at(i).host]--;
             _loadingRequests.removeAt(i);
             continue;
         }
@@ -86,38 +174,129 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
-QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
+bool ResourceCacheSharedItems::hasHostCapacity(const QSharedPointer<Resource>& resource) const {
+    auto host = getRequestHost(resource->_activeUrl);
+
     Lock lock(_mutex);
+    return _activeRequestsPerHost.value(host) < getHostLimit(host);
+}
 
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
-        if (!resource) {
-            _pendingRequests.removeAt(i);
+QSharedPointer<Resource> ResourceCacheSharedItems::peekPendingRequest(PendingHeap& heap, float& priority) {
+    while (!heap.empty()) {
+        auto resource = heap.front().resource.lock();
+        if (!resource || resource->_pendingSequence != heap.front().sequence) {
+            // freed, started, or queued again at another priority
+            std::pop_heap(heap.begin(), heap.end());
+            heap.pop_back();
+            continue;
+        }
+
+        // the load priorities keep changing, a request that went down is moved to where it belongs now,
+        // one that went up is queued again by updatePendingRequest
+        priority = resource->getLoadPriority();
+        if (priority < heap.front().priority) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back().priority = priority;
+            resource->_pendingPriority = priority;
+            std::push_heap(heap.begin(), heap.end());
+            continue;
+        }
+        return resource;
+    }
+    return QSharedPointer<Resource>();
+}
+
+QSharedPointer<Resource> ResourceCacheSharedItems::peekHighestPendingRequest(bool onlyHostsWithCapacity,
+        QString& host, float& priority) {
+    QSharedPointer<Resource> highestResource;
+    float highestPriority = -FLT_MAX;
+
+    for (auto it = _pendingRequests.begin(); it != _pendingRequests.end();) {
+        if (onlyHostsWithCapacity && _activeRequestsPerHost.value(it.key()) >= getHostLimit(it.key())) {
+            ++it;
             continue;
         }
 
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        if (priority >= highestPriority) {
-            highestPriority = priority;
-            highestIndex = i;
+        float hostPriority;
+        auto resource = peekPendingRequest(it.value(), hostPriority);
+        if (!resource) {
+            it = _pendingRequests.erase(it);
+            continue;
+        }
+        if (!highestResource || hostPriority > highestPriority) {
             highestResource = resource;
+            highestPriority = hostPriority;
+            host = it.key();
         }
-        i++;
+        ++it;
     }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+    priority = highestPriority;
+    return highestResource;
+}
+
+QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
+    QString host;
+    float priority;
+    Lock lock(_mutex);
+
+    auto highestResource = peekHighestPendingRequest(true, host, priority);
+    if (highestResource) {
+        auto& heap = _pendingRequests[host];
+        std::pop_heap(heap.begin(), heap.end());
+        heap.pop_back();
+        highestResource->_pendingSequence = 0;
+        _numPendingRequests--;
     }
 
     return highestResource;
 }
 
+QSharedPointer<Resource> ResourceCacheSharedItems::takeStaleRequest(bool isAtRequestLimit) {
+    QString host;
+    float priority;
+    Lock lock(_mutex);
+
+    auto pendingResource = peekHighestPendingRequest(false, host, priority);
+    if (!pendingResource) {
+        return QSharedPointer<Resource>();
+    }
+
+    // the pending request is held back either by its host, in which case only another request to it can make way,
+    // or by the limit on all requests
+    bool isHostAtLimit = _activeRequestsPerHost.value(host) >= getHostLimit(host);
+    if (!isHostAtLimit && !isAtRequestLimit) {
+        return QSharedPointer<Resource>();
+    }
+
+    quint64 now = usecTimestampNow();
+    int staleIndex = -1;
+    QSharedPointer<Resource> staleResource;
+    float stalePriority = priority;
+    for (int i = 0; i < _loadingRequests.size(); ++i) {
+        const auto& request = _loadingRequests.at(i);
+        if (request.isPausing || (isHostAtLimit && request.host != host) ||
+                now - request.startUsecs < MIN_USECS_BEFORE_PAUSE) {
+            continue;
+        }
+        auto resource = request.resource.lock();
+        if (!resource || (resource->_bytesTotal > 0 && 2 * resource->_bytesReceived >= resource->_bytesTotal)) {
+            continue;
+        }
+        float activePriority = resource->getLoadPriority();
+        if (activePriority < stalePriority) {
+            staleIndex = i;
+            staleResource = resource;
+            stalePriority = activePriority;
+        }
+    }
+
+    if (staleResource) {
+        _loadingRequests[staleIndex].isPausing = true;
+    }
+    return staleResource;
+}
+
 ScriptableResource::ScriptableResource(const QUrl& url) :
     QObject(nullptr),
     _url(url) { }
@@ -297,10 +476,37 @@ QVariantList ResourceCache::getResourceList() {
         QMetaObject::invokeMethod(this, "getResourceList", Qt::BlockingQueuedConnection,
             Q_RETURN_ARG(QVariantList, list));
     } else {
-        auto resources = _resources.uniqueKeys();
+        QHash<QUrl, QWeakPointer<Resource>> resources;
+        {
+            QReadLocker locker(&_resourcesLock);
+            resources = _resources;
+        }
         list.reserve(resources.size());
-        for (auto& resource : resources) {
-            list << resource;
+        for (auto it = resources.constBegin(); it != resources.constEnd(); ++it) {
+            QVariantMap entry;
+            entry["url"] = it.key();
+
+            auto resource = it.value().lock();
+            if (resource) {
+                QString state;
+                if (resource->isLoaded()) {
+                    state = "loaded";
+                } else if (resource->isFailed()) {
+                    state = "failed";
+                } else if (resource->_request) {
+                    state = "loading";
+                } else if (resource->_pendingSequence != 0) {
+                    state = resource->_isPaused ? "paused" : "pending";
+                } else {
+                    state = "waiting";
+                }
+                entry["state"] = state;
+                entry["host"] = getRequestHost(resource->_activeUrl);
+                entry["priority"] = resource->getLoadPriority();
+                entry["bytesReceived"] = resource->getBytesReceived();
+                entry["bytesTotal"] = resource->getBytesTotal();
+            }
+            list << entry;
         }
     }
 
@@ -316,6 +522,18 @@ void ResourceCache::setRequestLimit(int limit) {
     }
 }
 
+void ResourceCache::setATPRequestLimit(int limit) {
+    _atpRequestLimit = limit;
+    while (attemptHighestPriorityRequest()) {
+    }
+}
+
+void ResourceCache::setHTTPRequestLimitPerHost(int limit) {
+    _httpRequestLimitPerHost = limit;
+    while (attemptHighestPriorityRequest()) {
+    }
+}
+
 QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl& fallback, void* extra) {
     QSharedPointer<Resource> resource;
     {
@@ -465,7 +683,7 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     Q_ASSERT(!resource.isNull());
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
 
-    if (_requestsActive >= _requestLimit) {
+    if (_requestsActive >= _requestLimit || !sharedItems->hasHostCapacity(resource)) {
         // wait until a slot becomes available
         sharedItems->appendPendingRequest(resource);
         return false;
@@ -473,6 +691,7 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     
     ++_requestsActive;
     sharedItems->appendActiveRequest(resource);
+    resource->_isPaused = false;
     resource->makeRequest();
     return true;
 }
@@ -491,8 +710,25 @@ bool ResourceCache::attemptHighestPriorityRequest() {
     return (resource && attemptRequest(resource));
 }
 
+void ResourceCache::updatePendingRequest(QSharedPointer<Resource> resource) {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->updatePendingRequest(resource);
+    pauseStaleRequest();
+}
+
+void ResourceCache::pauseStaleRequest() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto resource = sharedItems->takeStaleRequest(_requestsActive >= _requestLimit);
+    if (resource) {
+        // the request belongs to the thread of its resource
+        QMetaObject::invokeMethod(resource.data(), "pause", Qt::QueuedConnection);
+    }
+}
+
 const int DEFAULT_REQUEST_LIMIT = 10;
 int ResourceCache::_requestLimit = DEFAULT_REQUEST_LIMIT;
+int ResourceCache::_atpRequestLimit = DEFAULT_ATP_REQUEST_LIMIT;
+int ResourceCache::_httpRequestLimitPerHost = DEFAULT_HTTP_REQUEST_LIMIT_PER_HOST;
 int ResourceCache::_requestsActive = 0;
 
 Resource::Resource(const QUrl& url) :
@@ -510,6 +746,12 @@ Resource::~Resource() {
         _request = nullptr;
         ResourceCache::requestCompleted(_self);
     }
+    if (_pendingSequence != 0) {
+        auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+        if (sharedItems) {
+            sharedItems->removePendingRequest(this);
+        }
+    }
 }
 
 void Resource::ensureLoading() {
@@ -521,6 +763,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!(_failedToLoad || _loaded)) {
         _loadPriorities.insert(owner, priority);
+        updatePendingPriority();
     }
 }
 
@@ -532,6 +775,7 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    updatePendingPriority();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
@@ -540,6 +784,18 @@ void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     }
 }
 
+void Resource::updatePendingPriority() {
+    // a queued request is only queued again when its priority goes up by enough to matter,
+    // the queue catches up with the ones that go down as they come up
+    const float MIN_PRIORITY_INCREASE = 0.05f;
+    if (_pendingSequence != 0) {
+        float priority = getLoadPriority();
+        if (priority > _pendingPriority + MIN_PRIORITY_INCREASE * fabsf(_pendingPriority)) {
+            ResourceCache::updatePendingRequest(_self);
+        }
+    }
+}
+
 float Resource::getLoadPriority() {
     float highestPriority = -FLT_MAX;
     for (QHash<QPointer<QObject>, float>::iterator it = _loadPriorities.begin(); it != _loadPriorities.end(); ) {
@@ -622,6 +878,24 @@ void Resource::attemptRequest() {
     ResourceCache::attemptRequest(_self);
 }
 
+void Resource::pause() {
+    // it may have finished while this was queued
+    if (!_request || _loaded || _failedToLoad) {
+        return;
+    }
+
+    qCDebug(networking).noquote() << "Pausing request for" << _url.toDisplayString() << "in favor of a higher priority one";
+    _request->disconnect(this);
+    _request->deleteLater();
+    _request = nullptr;
+    _bytesReceived = _bytesTotal = 0;
+    _isPaused = true;
+
+    // the slot goes to the highest priority pending request, and this one waits for another
+    ResourceCache::requestCompleted(_self);
+    ResourceCache::attemptRequest(_self);
+}
+
 void Resource::finishedLoading(bool success) {
     if (success) {
         qCDebug(networking).noquote() << "Finished loading:" << _url.toDisplayString();
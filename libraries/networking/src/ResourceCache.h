@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -67,19 +68,60 @@ class ResourceCacheSharedItems : public Dependency  {
 
 public:
     void appendPendingRequest(QWeakPointer<Resource> newRequest);
+    /// Moves a queued request to its new priority, does nothing if it is no longer queued
+    void updatePendingRequest(QWeakPointer<Resource> request);
     void appendActiveRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
+    void removePendingRequest(Resource* request);
     QList<QSharedPointer<Resource>> getPendingRequests();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests();
+
+    /// Takes the highest priority pending request whose host is below its limit
     QSharedPointer<Resource> getHighestPendingRequest();
 
+    /// Checks whether another request to the host of the resource is within the limit for that host
+    bool hasHostCapacity(const QSharedPointer<Resource>& resource) const;
+
+    /// Picks an active request that has been passed over by a higher priority pending one it holds a slot from,
+    /// and marks it as pausing
+    /// \param isAtRequestLimit whether the total number of requests is at its limit
+    QSharedPointer<Resource> takeStaleRequest(bool isAtRequestLimit);
+
 private:
     ResourceCacheSharedItems() = default;
 
+    // An entry is only valid while its sequence is the one its resource was last queued with,
+    // the ones left behind by a change of priority are dropped as they reach the top of their heap
+    struct PendingRequest {
+        float priority;
+        uint64_t sequence;
+        QWeakPointer<Resource> resource;
+
+        // the most recent of equal priorities comes first, as it did with a linear scan
+        bool operator<(const PendingRequest& other) const {
+            return priority < other.priority || (priority == other.priority && sequence < other.sequence);
+        }
+    };
+    using PendingHeap = std::vector<PendingRequest>;
+
+    struct ActiveRequest {
+        QWeakPointer<Resource> resource;
+        QString host;
+        quint64 startUsecs;
+        bool isPausing;
+    };
+
+    int getHostLimit(const QString& host) const;
+    QSharedPointer<Resource> peekPendingRequest(PendingHeap& heap, float& priority);
+    QSharedPointer<Resource> peekHighestPendingRequest(bool onlyHostsWithCapacity, QString& host, float& priority);
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    QHash<QString, PendingHeap> _pendingRequests; // a max heap of the pending requests of each host
+    QList<ActiveRequest> _loadingRequests;
+    QHash<QString, int> _activeRequestsPerHost;
+    uint64_t _lastSequence { 0 };
+    uint32_t _numPendingRequests { 0 };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -156,11 +198,20 @@ public:
     size_t getNumCachedResources() const { return _numUnusedResources; }
     size_t getSizeCachedResources() const { return _unusedResourcesSize; }
 
+    /// Lists the url, request state, host, load priority and progress of each resource
     Q_INVOKABLE QVariantList getResourceList();
 
     static void setRequestLimit(int limit);
     static int getRequestLimit() { return _requestLimit; }
 
+    /// Limits the requests to the asset server, which all ATP requests go to
+    static void setATPRequestLimit(int limit);
+    static int getATPRequestLimit() { return _atpRequestLimit; }
+
+    /// Limits the requests to each HTTP host
+    static void setHTTPRequestLimitPerHost(int limit);
+    static int getHTTPRequestLimitPerHost() { return _httpRequestLimitPerHost; }
+
     static int getRequestsActive() { return _requestsActive; }
     
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
@@ -218,6 +269,10 @@ protected:
     static void requestCompleted(QWeakPointer<Resource> resource);
     static bool attemptHighestPriorityRequest();
 
+    /// Moves a pending resource to its new load priority, pausing a stale request if it now deserves its slot
+    static void updatePendingRequest(QSharedPointer<Resource> resource);
+    static void pauseStaleRequest();
+
 private:
     friend class Resource;
 
@@ -227,6 +282,8 @@ private:
     void removeResource(const QUrl& url, qint64 size = 0);
 
     static int _requestLimit;
+    static int _atpRequestLimit;
+    static int _httpRequestLimitPerHost;
     static int _requestsActive;
 
     // Resources
@@ -332,6 +389,9 @@ signals:
 protected slots:
     void attemptRequest();
 
+    /// Stops the download in favor of a higher priority one and queues the resource to start over
+    void pause();
+
 protected:
     virtual void init();
 
@@ -366,6 +426,7 @@ private slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
     
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
@@ -385,6 +446,13 @@ private:
     qint64 _bytes{ 0 };
     int _attempts{ 0 };
     bool _isInScript{ false };
+
+    void updatePendingPriority();
+
+    // guarded by the mutex of ResourceCacheSharedItems
+    uint64_t _pendingSequence{ 0 }; // nonzero while queued
+    float _pendingPriority{ 0.0f }; // the priority it was last queued with
+    bool _isPaused{ false };
 };
 
 uint qHash(const QPointer<QObject>& value, uint seed = 0);
@@ -19,6 +19,8 @@
 
 
 #include "AssetResourceRequest.h"
+#include "AssetUtils.h"
+#include "ContentCache.h"
 #include "FileResourceRequest.h"
 #include "HTTPResourceRequest.h"
 #include "NetworkAccessManager.h"
@@ -78,6 +80,8 @@ QUrl ResourceManager::normalizeURL(const QUrl& originalUrl) {
 void ResourceManager::init() {
     _thread.setObjectName("Resource Manager Thread");
 
+    DependencyManager::set<ContentCache>();
+
     auto assetClient = DependencyManager::set<AssetClient>();
     assetClient->moveToThread(&_thread);
     QObject::connect(&_thread, &QThread::started, assetClient.data(), &AssetClient::init);
@@ -90,6 +94,29 @@ void ResourceManager::cleanup() {
     DependencyManager::destroy<AssetClient>();
     _thread.quit();
     _thread.wait();
+
+    DependencyManager::destroy<ContentCache>();
+}
+
+QByteArray ResourceManager::loadFromContentCache(const QUrl& url) {
+    auto cache = DependencyManager::get<ContentCache>();
+    if (!cache) {
+        return QByteArray();
+    }
+
+    auto normalizedURL = normalizeURL(url);
+    auto scheme = normalizedURL.scheme();
+
+    if (scheme == URL_SCHEME_HTTP || scheme == URL_SCHEME_HTTPS || scheme == URL_SCHEME_FTP) {
+        return cache->loadForUrl(normalizedURL);
+    } else if (scheme == URL_SCHEME_ATP) {
+        // only a url of a hash names its content, the content for a path can be remapped on the asset-server
+        auto hash = normalizedURL.path().split(".", QString::SkipEmptyParts).value(0);
+        if (isValidHash(hash)) {
+            return cache->load(hash);
+        }
+    }
+    return QByteArray();
 }
 
 ResourceRequest* ResourceManager::createResourceRequest(QObject* parent, const QUrl& url) {
@@ -32,6 +32,10 @@ public:
 
     static ResourceRequest* createResourceRequest(QObject* parent, const QUrl& url);
 
+    /// Returns the content for the url from the content cache shared with other processes on this host,
+    /// or a null array if it has to be requested
+    static QByteArray loadFromContentCache(const QUrl& url);
+
     static void init();
     static void cleanup();
 
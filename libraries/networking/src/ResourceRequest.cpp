@@ -13,6 +13,8 @@
 
 #include <QtCore/QThread>
 
+#include "ResourceManager.h"
+
 ResourceRequest::ResourceRequest(const QUrl& url) : _url(url) { }
 
 void ResourceRequest::send() {
@@ -24,5 +26,18 @@ void ResourceRequest::send() {
     Q_ASSERT(_state == NotStarted);
 
     _state = InProgress;
+
+    // anything already in the content cache is never requested
+    if (_cacheEnabled) {
+        _data = ResourceManager::loadFromContentCache(_url);
+        if (!_data.isNull()) {
+            _loadedFromCache = true;
+            _result = Success;
+            _state = Finished;
+            emit finished();
+            return;
+        }
+    }
+
     doSend();
 }
@@ -21,6 +21,28 @@ float PacketStreamStats::getLostRate() const {
     return (_expectedReceived == 0) ? 0.0f : (float)_lost / (float)_expectedReceived;
 }
 
+void PublishedPacketStreamStats::store(const PacketStreamStats& stats) {
+    _received.store(stats._received, std::memory_order_relaxed);
+    _unreasonable.store(stats._unreasonable, std::memory_order_relaxed);
+    _early.store(stats._early, std::memory_order_relaxed);
+    _late.store(stats._late, std::memory_order_relaxed);
+    _lost.store(stats._lost, std::memory_order_relaxed);
+    _recovered.store(stats._recovered, std::memory_order_relaxed);
+    _expectedReceived.store(stats._expectedReceived, std::memory_order_relaxed);
+}
+
+PacketStreamStats PublishedPacketStreamStats::load() const {
+    PacketStreamStats stats;
+    stats._received = _received.load(std::memory_order_relaxed);
+    stats._unreasonable = _unreasonable.load(std::memory_order_relaxed);
+    stats._early = _early.load(std::memory_order_relaxed);
+    stats._late = _late.load(std::memory_order_relaxed);
+    stats._lost = _lost.load(std::memory_order_relaxed);
+    stats._recovered = _recovered.load(std::memory_order_relaxed);
+    stats._expectedReceived = _expectedReceived.load(std::memory_order_relaxed);
+    return stats;
+}
+
 SequenceNumberStats::SequenceNumberStats(int statsHistoryLength, bool canDetectOutOfSync)
     : _lastReceivedSequence(0),
     _missingSet(),
@@ -35,6 +57,7 @@ SequenceNumberStats::SequenceNumberStats(int statsHistoryLength, bool canDetectO
 void SequenceNumberStats::reset() {
     _missingSet.clear();
     _stats = PacketStreamStats();
+    _publishedStats.store(_stats);
     _lastSenderUUID = QUuid();
     _statsHistory.clear();
     _lastUnreasonableSequence = 0;
@@ -44,6 +67,12 @@ void SequenceNumberStats::reset() {
 static const int UINT16_RANGE = std::numeric_limits<uint16_t>::max() + 1;
 
 SequenceNumberStats::ArrivalInfo SequenceNumberStats::sequenceNumberReceived(quint16 incoming, QUuid senderUUID, const bool wantExtraDebugging) {
+    ArrivalInfo arrivalInfo = countSequenceNumber(incoming, senderUUID, wantExtraDebugging);
+    _publishedStats.store(_stats);
+    return arrivalInfo;
+}
+
+SequenceNumberStats::ArrivalInfo SequenceNumberStats::countSequenceNumber(quint16 incoming, QUuid senderUUID, const bool wantExtraDebugging) {
 
     SequenceNumberStats::ArrivalInfo arrivalInfo;
 
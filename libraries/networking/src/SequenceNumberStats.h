@@ -12,6 +12,8 @@
 #ifndef hifi_SequenceNumberStats_h
 #define hifi_SequenceNumberStats_h
 
+#include <atomic>
+
 #include "SharedUtil.h"
 #include "RingBufferHistory.h"
 #include <quuid.h>
@@ -54,6 +56,30 @@ public:
     quint32 _expectedReceived;
 };
 
+// The counts of a PacketStreamStats as the thread counting the packets last left them, for other threads to read
+// without a lock while it goes on. Each count is whole, but a read can get some counts from before a packet and
+// some from after it.
+class PublishedPacketStreamStats {
+public:
+    PublishedPacketStreamStats() { store(PacketStreamStats()); }
+    PublishedPacketStreamStats(const PublishedPacketStreamStats& other) { store(other.load()); }
+    PublishedPacketStreamStats& operator=(const PublishedPacketStreamStats& other) {
+        store(other.load());
+        return *this;
+    }
+
+    void store(const PacketStreamStats& stats);
+    PacketStreamStats load() const;
+
+    std::atomic<quint32> _received;
+    std::atomic<quint32> _unreasonable;
+    std::atomic<quint32> _early;
+    std::atomic<quint32> _late;
+    std::atomic<quint32> _lost;
+    std::atomic<quint32> _recovered;
+    std::atomic<quint32> _expectedReceived;
+};
+
 class SequenceNumberStats {
 public:
     enum ArrivalStatus {
@@ -77,21 +103,25 @@ public:
     void pruneMissingSet(const bool wantExtraDebugging = false);
     void pushStatsToHistory() { _statsHistory.insert(_stats); }
 
-    quint32 getReceived() const { return _stats._received; }
-    quint32 getExpectedReceived() const { return _stats._expectedReceived; }
-    quint32 getUnreasonable() const { return _stats._unreasonable; }
-    quint32 getOutOfOrder() const { return _stats._early + _stats._late; }
-    quint32 getEarly() const { return _stats._early; }
-    quint32 getLate() const { return _stats._late; }
-    quint32 getLost() const { return _stats._lost; }
-    quint32 getRecovered() const { return _stats._recovered; }
-
+    // the counts can be read from any thread
+    quint32 getReceived() const { return _publishedStats._received.load(std::memory_order_relaxed); }
+    quint32 getExpectedReceived() const { return _publishedStats._expectedReceived.load(std::memory_order_relaxed); }
+    quint32 getUnreasonable() const { return _publishedStats._unreasonable.load(std::memory_order_relaxed); }
+    quint32 getOutOfOrder() const { return getEarly() + getLate(); }
+    quint32 getEarly() const { return _publishedStats._early.load(std::memory_order_relaxed); }
+    quint32 getLate() const { return _publishedStats._late.load(std::memory_order_relaxed); }
+    quint32 getLost() const { return _publishedStats._lost.load(std::memory_order_relaxed); }
+    quint32 getRecovered() const { return _publishedStats._recovered.load(std::memory_order_relaxed); }
+    PacketStreamStats getPublishedStats() const { return _publishedStats.load(); }
+
+    // the rest only from the thread the sequence numbers are received on
     const PacketStreamStats& getStats() const { return _stats; }
     PacketStreamStats getStatsForHistoryWindow() const;
     PacketStreamStats getStatsForLastHistoryInterval() const;
     const QSet<quint16>& getMissingSet() const { return _missingSet; }
 
 private:
+    ArrivalInfo countSequenceNumber(quint16 incoming, QUuid senderUUID, const bool wantExtraDebugging);
     void receivedUnreasonable(quint16 incoming);
 
 private:
@@ -99,6 +129,7 @@ private:
     QSet<quint16> _missingSet;
 
     PacketStreamStats _stats;
+    PublishedPacketStreamStats _publishedStats;
 
     QUuid _lastSenderUUID;
 
@@ -11,13 +11,20 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
 #include <LogHandler.h>
+#include <Metrics.h>
+#include <shared/Tracing.h>
 
+#include "udt/PacketBufferPool.h"
 #include "ThreadedAssignment.h"
 
+// the file the scopes traced while the assignment runs are saved to, tracing is off without it
+static const QString TRACE_FILE_ENVIRONMENT_VARIABLE = "HIFI_TRACE_FILE";
+
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
     _isFinished(false),
@@ -61,6 +68,12 @@ void ThreadedAssignment::setFinished(bool isFinished) {
             _domainServerTimer.stop();
             _statsTimer.stop();
 
+            QString traceFilename = QProcessEnvironment::systemEnvironment().value(TRACE_FILE_ENVIRONMENT_VARIABLE);
+            if (!traceFilename.isEmpty() && Tracing::isEnabled()) {
+                Tracing::setEnabled(false);
+                Tracing::saveChromeTrace(traceFilename);
+            }
+
             // call our virtual aboutToFinish method - this gives the ThreadedAssignment subclass a chance to cleanup
             aboutToFinish();
 
@@ -73,6 +86,11 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
     // change the logging target name while the assignment is running
     LogHandler::getInstance().setTargetName(targetName);
 
+    // the trace goes to the file once the assignment finishes
+    if (QProcessEnvironment::systemEnvironment().contains(TRACE_FILE_ENVIRONMENT_VARIABLE)) {
+        Tracing::setEnabled(true);
+    }
+
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->setOwnerType(nodeType);
 
@@ -97,6 +115,10 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject &statsObje
 
     statsObject["packets_per_second"] = packetsPerSecond;
     statsObject["bytes_per_second"] = bytesPerSecond;
+    statsObject["packet_buffer_pool"] = udt::PacketBufferPool::getStatsJson();
+
+    // the domain-server puts these out for Prometheus, labelled with this assignment
+    statsObject["metrics"] = Metrics::toJson();
 
     nodeList->sendStatsToDomainServer(statsObject);
 }
@@ -11,6 +11,8 @@
 
 #include "CongestionControl.h"
 
+#include <algorithm>
+#include <array>
 #include <random>
 
 #include "Packet.h"
@@ -40,6 +42,10 @@ void CongestionControl::setPacketSendPeriod(double newSendPeriod) {
     }
 }
 
+int CongestionControl::getPacingRate() const {
+    return _packetSendPeriod > 0.0 ? (int)(USECS_PER_SECOND / _packetSendPeriod) : 0;
+}
+
 DefaultCC::DefaultCC() :
     _lastDecreaseMaxSeq(SequenceNumber {SequenceNumber::MAX })
 {
@@ -225,3 +231,205 @@ void DefaultCC::stopSlowStart() {
 void DefaultCC::setInitialSendSequenceNumber(udt::SequenceNumber seqNum) {
     _lastACK = _lastDecreaseMaxSeq = seqNum - 1;
 }
+
+// gains and windows follow the values used by BBR
+static const double STARTUP_GAIN = 2.885; // 2 / ln(2), the smallest gain that doubles the delivery rate each round
+static const double DRAIN_GAIN = 1.0 / STARTUP_GAIN;
+static const double PROBE_BW_CWND_GAIN = 2.0;
+static const std::array<double, 8> PROBE_BW_PACING_GAINS {{ 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 }};
+
+static const int BANDWIDTH_FILTER_ROUNDS = 10;
+static const auto MIN_RTT_FILTER_WINDOW = seconds(10);
+static const auto PROBE_RTT_DURATION = milliseconds(200);
+
+// the pipe is considered full once the bandwidth estimate grows by less than 25% for three rounds in a row
+static const double FULL_PIPE_GROWTH = 1.25;
+static const int FULL_PIPE_ROUNDS = 3;
+
+static const double MIN_CONGESTION_WINDOW_SIZE = 4.0;
+
+BBRCC::BBRCC() :
+    _pacingGain(STARTUP_GAIN),
+    _cwndGain(STARTUP_GAIN)
+{
+    _mss = udt::MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+    _congestionWindowSize = 16.0;
+    setPacketSendPeriod(1.0);
+}
+
+void BBRCC::onACK(SequenceNumber ackNum) {
+    auto now = p_high_resolution_clock::now();
+
+    int ackedPackets = std::max(0, seqoff(_lastACK, ackNum));
+    _lastACK = ackNum;
+
+    // a round ends once everything that was outstanding at its start has been ACKed
+    bool isNewRound = ackNum > _roundEndSeq;
+    if (isNewRound) {
+        ++_round;
+        _roundEndSeq = _sendCurrSeqNum;
+    }
+
+    updateBottleneckBandwidth();
+
+    if (isNewRound) {
+        checkFullPipe();
+    }
+
+    updateMinRTT(now);
+    updateMode(ackNum, now);
+
+    if (_bottleneckBandwidth == 0) {
+        // no delivery rate from the receiver yet, grow the window like a slow start
+        _congestionWindowSize += ackedPackets;
+        return;
+    }
+
+    setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * _bottleneckBandwidth));
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = MIN_CONGESTION_WINDOW_SIZE;
+        return;
+    }
+
+    double targetWindowSize = _cwndGain * bandwidthDelayProduct();
+
+    if (_isPipeFull) {
+        _congestionWindowSize = std::min(_congestionWindowSize + ackedPackets, targetWindowSize);
+    } else if (_congestionWindowSize < targetWindowSize) {
+        _congestionWindowSize += ackedPackets;
+    }
+
+    _congestionWindowSize = std::max(_congestionWindowSize, MIN_CONGESTION_WINDOW_SIZE);
+}
+
+void BBRCC::onTimeout() {
+    // nothing has been ACKed in a while - only keep the minimum in flight until ACKs flow again,
+    // the next ACKs grow the window back towards the model
+    _congestionWindowSize = MIN_CONGESTION_WINDOW_SIZE;
+}
+
+void BBRCC::setInitialSendSequenceNumber(SequenceNumber seqNum) {
+    _lastACK = _roundEndSeq = seqNum - 1;
+}
+
+void BBRCC::updateBottleneckBandwidth() {
+    if (_receiveRate <= 0) {
+        return;
+    }
+
+    // record this delivery rate sample and drop the ones that have fallen out of the window
+    _rateSamples.push_back({ _round, _receiveRate });
+
+    auto firstValid = std::find_if(_rateSamples.begin(), _rateSamples.end(), [this](const RateSample& sample) {
+        return sample.round > _round - BANDWIDTH_FILTER_ROUNDS;
+    });
+    _rateSamples.erase(_rateSamples.begin(), firstValid);
+
+    _bottleneckBandwidth = 0;
+    for (auto& sample : _rateSamples) {
+        _bottleneckBandwidth = std::max(_bottleneckBandwidth, sample.rate);
+    }
+}
+
+void BBRCC::updateMinRTT(time_point now) {
+    int rttSample = _rttSample > 0 ? _rttSample : _rtt;
+    if (rttSample <= 0) {
+        return;
+    }
+
+    bool isExpired = _minRTT == 0 || now > _minRTTTimestamp + MIN_RTT_FILTER_WINDOW;
+
+    if (isExpired && _mode != Mode::ProbeRTT && _minRTT > 0) {
+        // our min RTT has gone stale, drain the pipe so we can see what the RTT really is
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _cwndGain = 1.0;
+        _isProbeRTTDoneTimeSet = false;
+    }
+
+    if (rttSample < _minRTT || isExpired) {
+        _minRTT = rttSample;
+        _minRTTTimestamp = now;
+    }
+}
+
+void BBRCC::checkFullPipe() {
+    if (_isPipeFull || _bottleneckBandwidth == 0) {
+        return;
+    }
+
+    if (_bottleneckBandwidth >= _fullPipeBandwidth * FULL_PIPE_GROWTH) {
+        // still growing, start counting again
+        _fullPipeBandwidth = _bottleneckBandwidth;
+        _fullPipeRounds = 0;
+    } else if (++_fullPipeRounds >= FULL_PIPE_ROUNDS) {
+        _isPipeFull = true;
+    }
+}
+
+void BBRCC::updateMode(SequenceNumber ackNum, time_point now) {
+    int packetsInFlight = std::max(0, seqoff(ackNum, _sendCurrSeqNum) + 1);
+
+    switch (_mode) {
+        case Mode::Startup:
+            if (_isPipeFull) {
+                // drain the queue that was built up during startup
+                _mode = Mode::Drain;
+                _pacingGain = DRAIN_GAIN;
+                _cwndGain = STARTUP_GAIN;
+            }
+            break;
+        case Mode::Drain:
+            if (packetsInFlight <= bandwidthDelayProduct()) {
+                enterProbeBW(now);
+            }
+            break;
+        case Mode::ProbeBW:
+            // move to the next gain about once per round trip
+            if (now - _cycleStart > microseconds(_minRTT)) {
+                _cycleIndex = (_cycleIndex + 1) % PROBE_BW_PACING_GAINS.size();
+                _cycleStart = now;
+                _pacingGain = PROBE_BW_PACING_GAINS[_cycleIndex];
+            }
+            break;
+        case Mode::ProbeRTT:
+            if (!_isProbeRTTDoneTimeSet) {
+                if (packetsInFlight <= MIN_CONGESTION_WINDOW_SIZE) {
+                    _probeRTTDoneTime = now + PROBE_RTT_DURATION;
+                    _isProbeRTTDoneTimeSet = true;
+                }
+            } else if (now > _probeRTTDoneTime) {
+                _minRTTTimestamp = now;
+
+                if (_isPipeFull) {
+                    enterProbeBW(now);
+                } else {
+                    _mode = Mode::Startup;
+                    _pacingGain = STARTUP_GAIN;
+                    _cwndGain = STARTUP_GAIN;
+                }
+            }
+            break;
+    }
+}
+
+void BBRCC::enterProbeBW(time_point now) {
+    _mode = Mode::ProbeBW;
+    _cwndGain = PROBE_BW_CWND_GAIN;
+
+    // start at a random phase of the cycle (other than the drain phase) so connections don't probe in lockstep
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    std::uniform_int_distribution<> distribution(2, (int) PROBE_BW_PACING_GAINS.size() - 1);
+
+    _cycleIndex = distribution(generator);
+    _cycleStart = now;
+    _pacingGain = PROBE_BW_PACING_GAINS[_cycleIndex];
+}
+
+double BBRCC::bandwidthDelayProduct() const {
+    int rtt = _minRTT > 0 ? _minRTT : _rtt + synInterval();
+    return (double)_bottleneckBandwidth * rtt / USECS_PER_SECOND;
+}
@@ -43,6 +43,10 @@ public:
     virtual void onACK(SequenceNumber ackNum) {}
     virtual void onLoss(SequenceNumber rangeStart, SequenceNumber rangeEnd) {}
     virtual void onTimeout() {}
+
+    // estimates reported in the connection stats
+    int getPacingRate() const; // packets per second, derived from the current send period
+    virtual int getMinRTTEstimate() const { return _rtt; } // microseconds, CCs that don't track it use the smoothed RTT
 protected:
     void setAckInterval(int ackInterval) { _ackInterval = ackInterval; }
     void setRTO(int rto) { _userDefinedRTO = true; _rto = rto; }
@@ -54,6 +58,7 @@ protected:
     void setSendCurrentSequenceNumber(SequenceNumber seqNum) { _sendCurrSeqNum = seqNum; }
     void setReceiveRate(int rate) { _receiveRate = rate; }
     void setRTT(int rtt) { _rtt = rtt; }
+    void setRTTSample(int rttSample) { _rttSample = rttSample; }
     void setPacketSendPeriod(double newSendPeriod); // call this internally to ensure send period doesn't go past max bandwidth
     
     double _packetSendPeriod { 1.0 }; // Packet sending period, in microseconds
@@ -67,6 +72,7 @@ protected:
     SequenceNumber _sendCurrSeqNum; // current maximum seq num sent out
     int _receiveRate { 0 }; // packet arrive rate at receiver side, packets per second
     int _rtt { 0 }; // current estimated RTT, microsecond
+    int _rttSample { 0 }; // last RTT sample reported by an ACK, before smoothing, microsecond
     
 private:
     CongestionControl(const CongestionControl& other) = delete;
@@ -125,6 +131,66 @@ private:
     int _decreaseCount { 0 }; // number of decreases in a congestion epoch
     bool _delayedDecrease { false };
 };
+
+// Delay/bandwidth probing congestion control modelled after BBR.
+// Rather than backing off on loss it paces at the highest delivery rate reported by the receiver recently,
+// keeps roughly one bandwidth-delay product in flight and periodically probes for more bandwidth and a lower RTT.
+class BBRCC: public CongestionControl {
+public:
+    BBRCC();
+
+public:
+    virtual void onACK(SequenceNumber ackNum) override;
+    virtual void onLoss(SequenceNumber rangeStart, SequenceNumber rangeEnd) override {}
+    virtual void onTimeout() override;
+
+    virtual int getMinRTTEstimate() const override { return _minRTT; }
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override;
+
+private:
+    enum class Mode { Startup, Drain, ProbeBW, ProbeRTT };
+
+    using time_point = p_high_resolution_clock::time_point;
+
+    struct RateSample {
+        int round;
+        int rate;
+    };
+
+    void updateBottleneckBandwidth();
+    void updateMinRTT(time_point now);
+    void checkFullPipe();
+    void updateMode(SequenceNumber ackNum, time_point now);
+    void enterProbeBW(time_point now);
+
+    double bandwidthDelayProduct() const; // in packets
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _cwndGain;
+
+    std::vector<RateSample> _rateSamples; // recent delivery rate samples, used as a windowed max filter
+    int _bottleneckBandwidth { 0 }; // packets per second
+
+    int _minRTT { 0 }; // microseconds
+    time_point _minRTTTimestamp;
+
+    int _round { 0 }; // number of round trips so far
+    SequenceNumber _roundEndSeq; // a new round starts once this sequence number is ACKed
+    SequenceNumber _lastACK;
+
+    bool _isPipeFull { false };
+    int _fullPipeBandwidth { 0 };
+    int _fullPipeRounds { 0 };
+
+    int _cycleIndex { 0 };
+    time_point _cycleStart;
+
+    time_point _probeRTTDoneTime;
+    bool _isProbeRTTDoneTimeSet { false };
+};
     
 }
 
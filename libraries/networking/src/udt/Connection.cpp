@@ -101,6 +101,7 @@ SendQueue& Connection::getSendQueue() {
         QObject::connect(_sendQueue.get(), &SendQueue::packetSent, this, &Connection::packetSent);
         QObject::connect(_sendQueue.get(), &SendQueue::packetSent, this, &Connection::recordSentPackets);
         QObject::connect(_sendQueue.get(), &SendQueue::packetRetransmitted, this, &Connection::recordRetransmission);
+        QObject::connect(_sendQueue.get(), &SendQueue::batchSent, this, &Connection::recordSentBatch);
         QObject::connect(_sendQueue.get(), &SendQueue::queueInactive, this, &Connection::queueInactive);
         QObject::connect(_sendQueue.get(), &SendQueue::timeout, this, &Connection::queueTimeout);
         QObject::connect(_sendQueue.get(), &SendQueue::shortCircuitLoss, this, &Connection::queueShortCircuitLoss);
@@ -254,6 +255,10 @@ void Connection::recordRetransmission() {
     _stats.record(ConnectionStats::Stats::Retransmission);
 }
 
+void Connection::recordSentBatch(int numDatagrams, int numSyscalls) {
+    _stats.recordSentBatch(numDatagrams, numSyscalls);
+}
+
 void Connection::sendACK(bool wasCausedBySyncTimeout) {
     static p_high_resolution_clock::time_point lastACKSendTime;
     auto currentTime = p_high_resolution_clock::now();
@@ -323,7 +328,8 @@ void Connection::sendACK(bool wasCausedBySyncTimeout) {
                "Connection::sendACK", "Adding an invalid ACK to _sentACKs");
     
     // write this ACK to the map of sent ACKs
-    _sentACKs.push_back({ _currentACKSubSequenceNumber, { nextACKNumber, p_high_resolution_clock::now() }});
+    // (stamped with the time just before it was handed to the socket)
+    _sentACKs.push_back({ _currentACKSubSequenceNumber, { nextACKNumber, lastACKSendTime }});
     
     // reset the number of data packets received since last ACK
     _packetsSinceACK = 0;
@@ -426,7 +432,8 @@ SequenceNumber Connection::nextACK() const {
     }
 }
 
-bool Connection::processReceivedSequenceNumber(SequenceNumber sequenceNumber, int packetSize, int payloadSize) {
+bool Connection::processReceivedSequenceNumber(SequenceNumber sequenceNumber, int packetSize, int payloadSize,
+                                               p_high_resolution_clock::time_point receiveTime) {
     
     if (!_hasReceivedHandshake) {
         // Refuse to process any packets until we've received the handshake
@@ -448,18 +455,18 @@ bool Connection::processReceivedSequenceNumber(SequenceNumber sequenceNumber, in
     
     // check if this is a packet pair we should estimate bandwidth from, or just a regular packet
     if (((uint32_t) sequenceNumber & 0xF) == 0) {
-        _receiveWindow.onProbePair1Arrival();
+        _receiveWindow.onProbePair1Arrival(receiveTime);
     } else if (((uint32_t) sequenceNumber & 0xF) == 1) {
         // only use this packet for bandwidth estimation if we didn't just receive a control packet in its place
         if (!_receivedControlProbeTail) {
-            _receiveWindow.onProbePair2Arrival();
+            _receiveWindow.onProbePair2Arrival(receiveTime);
         } else {
             // reset our control probe tail marker so the next probe that comes with data can be used
             _receivedControlProbeTail = false;
         }
         
     }
-    _receiveWindow.onPacketArrival();
+    _receiveWindow.onPacketArrival(receiveTime);
     
     // If this is not the next sequence number, report loss
     if (sequenceNumber > _lastReceivedSequenceNumber + 1) {
@@ -645,6 +652,7 @@ void Connection::processACK(std::unique_ptr<ControlPacket> controlPacket) {
     
     // set the RTT for congestion control
     _congestionControl->setRTT(_rtt);
+    _congestionControl->setRTTSample(rtt);
     
     if (controlPacket->bytesLeftToRead() > 0) {
         int32_t receiveRate, bandwidth;
@@ -716,9 +724,10 @@ void Connection::processACK2(std::unique_ptr<ControlPacket> controlPacket) {
         if (it->first == subSequenceNumber){
             // update the RTT using the ACK window
             
-            // calculate the RTT (time now - time ACK sent)
-            auto now = p_high_resolution_clock::now();
-            int rtt = duration_cast<microseconds>(now - it->second.second).count();
+            // calculate the RTT (time ACK2 received - time ACK sent)
+            // the receive time comes from the kernel when available, so time spent queued behind other work
+            // on this thread doesn't inflate the RTT
+            int rtt = std::max((int) duration_cast<microseconds>(controlPacket->getReceiveTime() - it->second.second).count(), 0);
             
             updateRTT(rtt);
             // write this RTT to stats
@@ -726,6 +735,7 @@ void Connection::processACK2(std::unique_ptr<ControlPacket> controlPacket) {
             
             // set the RTT for congestion control
             _congestionControl->setRTT(_rtt);
+            _congestionControl->setRTTSample(rtt);
             
             // update the last ACKed ACK
             if (it->second.first > _lastReceivedAcknowledgedACK) {
@@ -826,7 +836,7 @@ void Connection::processProbeTail(std::unique_ptr<ControlPacket> controlPacket)
         qCDebug(networking) << "Processing second packet of probe from control packet instead of data packet";
 #endif
         
-        _receiveWindow.onProbePair2Arrival();
+        _receiveWindow.onProbePair2Arrival(controlPacket->getReceiveTime());
         
         // mark that we processed a control packet for the second in the pair and we should not mark
         // the next data packet received
@@ -892,6 +902,7 @@ void Connection::updateRTT(int rtt) {
     static const int RTT_ESTIMATION_VARIANCE_ALPHA_NUMERATOR = 4;
    
     _rtt = (_rtt * (RTT_ESTIMATION_ALPHA_NUMERATOR - 1) + rtt) / RTT_ESTIMATION_ALPHA_NUMERATOR;
+    _stats.recordSmoothedRTT(_rtt);
     
     _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA_NUMERATOR - 1)
                     + abs(rtt - _rtt)) / RTT_ESTIMATION_VARIANCE_ALPHA_NUMERATOR;
@@ -918,6 +929,8 @@ void Connection::updateCongestionControlAndSendQueue(std::function<void ()> cong
     // record connection stats
     _stats.recordPacketSendPeriod(_congestionControl->_packetSendPeriod);
     _stats.recordCongestionWindowSize(_congestionControl->_congestionWindowSize);
+    _stats.recordPacingRate(_congestionControl->getPacingRate());
+    _stats.recordMinRTT(_congestionControl->getMinRTTEstimate());
 }
 
 void PendingReceivedMessage::enqueuePacket(std::unique_ptr<Packet> packet) {
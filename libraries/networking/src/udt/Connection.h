@@ -65,7 +65,8 @@ public:
     void sync(); // rate control method, fired by Socket for all connections on SYN interval
 
     // return indicates if this packet should be processed
-    bool processReceivedSequenceNumber(SequenceNumber sequenceNumber, int packetSize, int payloadSize);
+    bool processReceivedSequenceNumber(SequenceNumber sequenceNumber, int packetSize, int payloadSize,
+                                       p_high_resolution_clock::time_point receiveTime = p_high_resolution_clock::now());
     void processControl(std::unique_ptr<ControlPacket> controlPacket);
 
     void queueReceivedMessagePacket(std::unique_ptr<Packet> packet);
@@ -85,6 +86,7 @@ signals:
 private slots:
     void recordSentPackets(int payload, int total);
     void recordRetransmission();
+    void recordSentBatch(int numDatagrams, int numSyscalls);
     void queueInactive();
     void queueTimeout();
     void queueShortCircuitLoss(quint32 sequenceNumber);
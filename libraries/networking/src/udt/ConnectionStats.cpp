@@ -80,6 +80,14 @@ void ConnectionStats::recordUnreliableReceivedPackets(int payload, int total) {
     _total.receivedUnreliableBytes += total;
 }
 
+void ConnectionStats::recordSentBatch(int numDatagrams, int numSyscalls) {
+    ++_currentSample.sentBatches;
+    ++_total.sentBatches;
+
+    _currentSample.syscallsSaved += numDatagrams - numSyscalls;
+    _total.syscallsSaved += numDatagrams - numSyscalls;
+}
+
 static const double EWMA_CURRENT_SAMPLE_WEIGHT = 0.125;
 static const double EWMA_PREVIOUS_SAMPLES_WEIGHT = 1.0 - EWMA_CURRENT_SAMPLE_WEIGHT;
 
@@ -103,6 +111,11 @@ void ConnectionStats::recordRTT(int sample) {
     _total.rtt = (int)((_total.rtt * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
 }
 
+void ConnectionStats::recordSmoothedRTT(int sample) {
+    _currentSample.smoothedRTT = sample;
+    _total.smoothedRTT = (int)((_total.smoothedRTT * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
+}
+
 void ConnectionStats::recordCongestionWindowSize(int sample) {
     _currentSample.congestionWindowSize = sample;
     _total.congestionWindowSize = (int)((_total.congestionWindowSize * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
@@ -112,3 +125,13 @@ void ConnectionStats::recordPacketSendPeriod(int sample) {
     _currentSample.packetSendPeriod = sample;
     _total.packetSendPeriod = (int)((_total.packetSendPeriod * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
 }
+
+void ConnectionStats::recordPacingRate(int sample) {
+    _currentSample.pacingRate = sample;
+    _total.pacingRate = (int)((_total.pacingRate * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
+}
+
+void ConnectionStats::recordMinRTT(int sample) {
+    _currentSample.minRTT = sample;
+    _total.minRTT = (int)((_total.minRTT * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
+}
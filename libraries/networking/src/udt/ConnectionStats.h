@@ -61,14 +61,21 @@ public:
         int receivedUnreliableUtilBytes { 0 };
         int sentUnreliableBytes { 0 };
         int receivedUnreliableBytes { 0 };
+
+        // batched sends
+        int sentBatches { 0 };
+        int syscallsSaved { 0 };
        
         // the following stats are trailing averages in the result, not totals
         int sendRate { 0 };
         int receiveRate { 0 };
         int estimatedBandwith { 0 };
-        int rtt { 0 };
+        int rtt { 0 }; // raw RTT samples
+        int smoothedRTT { 0 }; // the connection's filtered RTT estimate
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
+        int pacingRate { 0 };
+        int minRTT { 0 };
         
         // TODO: Remove once Win build supports brace initialization: `Events events {{ 0 }};`
         Stats() { events.fill(0); }
@@ -86,13 +93,18 @@ public:
     
     void recordUnreliableSentPackets(int payload, int total);
     void recordUnreliableReceivedPackets(int payload, int total);
+
+    void recordSentBatch(int numDatagrams, int numSyscalls);
     
     void recordSendRate(int sample);
     void recordReceiveRate(int sample);
     void recordEstimatedBandwidth(int sample);
     void recordRTT(int sample);
+    void recordSmoothedRTT(int sample);
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
+    void recordPacingRate(int sample);
+    void recordMinRTT(int sample);
     
 private:
     Stats _currentSample;
@@ -12,7 +12,7 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <map>
 
 #include "SequenceNumber.h"
 
@@ -30,7 +30,7 @@ public:
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere, merging with any ranges it touches
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -44,7 +44,9 @@ public:
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    // disjoint, non-adjacent ranges keyed by their first sequence number, mapped to their last
+    // a balanced tree keeps lookups logarithmic when a burst of losses leaves thousands of ranges outstanding
+    std::map<SequenceNumber, SequenceNumber> _lossList;
     int _length { 0 };
 };
     
@@ -0,0 +1,199 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QThreadStorage>
+
+#include "Constants.h"
+
+using namespace udt;
+
+static const int NUM_SIZE_CLASSES = 3;
+static const std::array<qint64, NUM_SIZE_CLASSES> SIZE_CLASSES {{ 128, 512, MAX_PACKET_SIZE }};
+
+// number of free buffers a thread keeps per size class before it hands some of them to the global list
+static const size_t MAX_THREAD_FREE_BUFFERS = 256;
+// number of buffers moved between a thread and the global list at once
+static const size_t BUFFER_TRANSFER_COUNT = 128;
+// number of free buffers the global list keeps per size class before it starts deleting them
+static const size_t MAX_GLOBAL_FREE_BUFFERS = 4096;
+
+using FreeList = std::vector<char*>;
+using FreeLists = std::array<FreeList, NUM_SIZE_CLASSES>;
+
+namespace {
+
+struct GlobalFreeLists {
+    std::mutex mutex;
+    FreeLists lists;
+
+    std::atomic<quint64> hits { 0 };
+    std::atomic<quint64> misses { 0 };
+    std::atomic<quint64> unpooled { 0 };
+};
+
+GlobalFreeLists& globalFreeLists() {
+    // intentionally leaked so that it outlives the thread storage of threads torn down during shutdown
+    static GlobalFreeLists* lists = new GlobalFreeLists;
+    return *lists;
+}
+
+struct ThreadFreeLists {
+    FreeLists lists;
+
+    ~ThreadFreeLists() {
+        // this thread is going away, give what it had cached back to the global lists
+        auto& global = globalFreeLists();
+        std::lock_guard<std::mutex> lock(global.mutex);
+
+        for (int sizeClass = 0; sizeClass < NUM_SIZE_CLASSES; ++sizeClass) {
+            for (auto buffer : lists[sizeClass]) {
+                if (global.lists[sizeClass].size() < MAX_GLOBAL_FREE_BUFFERS) {
+                    global.lists[sizeClass].push_back(buffer);
+                } else {
+                    delete[] buffer;
+                }
+            }
+        }
+    }
+};
+
+QThreadStorage<ThreadFreeLists*>& threadFreeLists() {
+    // leaked like the global lists, buffers held by queued messages can be released after static destruction
+    static QThreadStorage<ThreadFreeLists*>* storage = new QThreadStorage<ThreadFreeLists*>;
+    return *storage;
+}
+
+FreeLists& localFreeLists() {
+    auto& storage = threadFreeLists();
+    if (!storage.hasLocalData()) {
+        storage.setLocalData(new ThreadFreeLists);
+    }
+
+    return storage.localData()->lists;
+}
+
+// the free lists of this thread if it has them. Releasing doesn't make them: the thread may be tearing down, with
+// its lists already given back, and making them again then would leak them.
+FreeLists* existingLocalFreeLists() {
+    auto& storage = threadFreeLists();
+    return storage.hasLocalData() ? &storage.localData()->lists : nullptr;
+}
+
+void releaseToGlobalList(char* buffer, int sizeClass) {
+    auto& global = globalFreeLists();
+    std::lock_guard<std::mutex> lock(global.mutex);
+    auto& globalList = global.lists[sizeClass];
+
+    if (globalList.size() < MAX_GLOBAL_FREE_BUFFERS) {
+        globalList.push_back(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+}
+
+void PacketBufferDeleter::operator()(char* buffer) const {
+    if (_sizeClass == UNPOOLED) {
+        delete[] buffer;
+    } else {
+        PacketBufferPool::release(buffer, _sizeClass);
+    }
+}
+
+PacketBuffer PacketBufferPool::allocate(qint64 size) {
+    auto& global = globalFreeLists();
+
+    int sizeClass = 0;
+    while (sizeClass < NUM_SIZE_CLASSES && SIZE_CLASSES[sizeClass] < size) {
+        ++sizeClass;
+    }
+
+    if (sizeClass == NUM_SIZE_CLASSES) {
+        // bigger than anything we pool, fall back to a plain allocation
+        ++global.unpooled;
+        return PacketBuffer(new char[size]);
+    }
+
+    auto& localList = localFreeLists()[sizeClass];
+
+    if (localList.empty()) {
+        // refill from the global list
+        std::lock_guard<std::mutex> lock(global.mutex);
+        auto& globalList = global.lists[sizeClass];
+
+        auto numToTransfer = std::min(globalList.size(), BUFFER_TRANSFER_COUNT);
+        localList.insert(localList.end(), globalList.end() - numToTransfer, globalList.end());
+        globalList.resize(globalList.size() - numToTransfer);
+    }
+
+    if (localList.empty()) {
+        ++global.misses;
+        return PacketBuffer(new char[SIZE_CLASSES[sizeClass]], PacketBufferDeleter(sizeClass));
+    }
+
+    ++global.hits;
+
+    auto buffer = localList.back();
+    localList.pop_back();
+
+    return PacketBuffer(buffer, PacketBufferDeleter(sizeClass));
+}
+
+void PacketBufferPool::release(char* buffer, int sizeClass) {
+    auto localLists = existingLocalFreeLists();
+    if (!localLists) {
+        // a thread that never allocated, or one whose lists are gone
+        releaseToGlobalList(buffer, sizeClass);
+        return;
+    }
+
+    auto& localList = (*localLists)[sizeClass];
+
+    if (localList.size() >= MAX_THREAD_FREE_BUFFERS) {
+        // this thread has more than it needs, move a chunk over to the global list for the threads that allocate
+        auto& global = globalFreeLists();
+        std::lock_guard<std::mutex> lock(global.mutex);
+        auto& globalList = global.lists[sizeClass];
+
+        auto begin = localList.end() - BUFFER_TRANSFER_COUNT;
+        for (auto it = begin; it != localList.end(); ++it) {
+            if (globalList.size() < MAX_GLOBAL_FREE_BUFFERS) {
+                globalList.push_back(*it);
+            } else {
+                delete[] *it;
+            }
+        }
+
+        localList.erase(begin, localList.end());
+    }
+
+    localList.push_back(buffer);
+}
+
+QJsonObject PacketBufferPool::getStatsJson() {
+    auto& global = globalFreeLists();
+
+    QJsonObject stats;
+    stats["hits"] = (double) global.hits.load();
+    stats["misses"] = (double) global.misses.load();
+    stats["unpooled"] = (double) global.unpooled.load();
+
+    return stats;
+}
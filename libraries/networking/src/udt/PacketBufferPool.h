@@ -0,0 +1,61 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <memory>
+
+#include <QtCore/QJsonObject>
+
+namespace udt {
+
+// Deleter for packet buffers - pooled buffers go back to the free list for their size class, others are deleted
+class PacketBufferDeleter {
+public:
+    static const int UNPOOLED = -1;
+
+    PacketBufferDeleter(int sizeClass = UNPOOLED) : _sizeClass(sizeClass) {}
+
+    void operator()(char* buffer) const;
+
+    int getSizeClass() const { return _sizeClass; }
+
+private:
+    int _sizeClass;
+};
+
+using PacketBuffer = std::unique_ptr<char[], PacketBufferDeleter>;
+
+// Size-class pool of packet buffers shared by all packets.
+// Each thread keeps its own free lists and trades buffers in bulk with a global overflow list, since packets
+// are regularly created on one thread (mixers, send threads) and released on another (the networking thread).
+class PacketBufferPool {
+public:
+    // Returns a buffer of at least size bytes, the contents are not initialized
+    static PacketBuffer allocate(qint64 size);
+
+    // Takes ownership of a buffer that was not allocated by the pool
+    static PacketBuffer adopt(std::unique_ptr<char[]> buffer) { return PacketBuffer(buffer.release()); }
+
+    static QJsonObject getStatsJson();
+
+private:
+    friend class PacketBufferDeleter;
+
+    static void release(char* buffer, int sizeClass);
+};
+
+}
+
+#endif // hifi_PacketBufferPool_h
@@ -43,7 +43,9 @@ const QSet<PacketType> NON_SOURCED_PACKETS = QSet<PacketType>()
 PacketVersion versionForPacketType(PacketType packetType) {
     switch (packetType) {
         case PacketType::DomainList:
-            return static_cast<PacketVersion>(DomainListVersion::PermissionsGrid);
+            return static_cast<PacketVersion>(DomainListVersion::DeltaUpdates);
+        case PacketType::DomainListRequest:
+            return static_cast<PacketVersion>(DomainListRequestVersion::HasListVersion);
         case PacketType::EntityAdd:
         case PacketType::EntityEdit:
         case PacketType::EntityData:
@@ -52,7 +54,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AvatarData:
         case PacketType::BulkAvatarData:
         case PacketType::KillAvatar:
-            return static_cast<PacketVersion>(AvatarMixerPacketVersion::HandControllerJoints);
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::BitPackedJoints);
         case PacketType::ICEServerHeartbeat:
             return 18; // ICE Server Heartbeat signing
         case PacketType::AssetGetInfo:
@@ -62,6 +64,8 @@ PacketVersion versionForPacketType(PacketType packetType) {
             return 18;
         case PacketType::NodeIgnoreRequest:
             return 18; // Introduction of node ignore request (which replaced an unused packet tpye)
+        case PacketType::AssetMappingOperationReply:
+            return static_cast<PacketVersion>(AssetMappingOperationReplyVersion::CompressedPayload);
 
         case PacketType::DomainConnectionDenied:
             return static_cast<PacketVersion>(DomainConnectionDeniedVersion::IncludesReasonCode);
@@ -77,13 +81,24 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::InjectAudio:
         case PacketType::MicrophoneAudioNoEcho:
         case PacketType::MicrophoneAudioWithEcho:
-            return static_cast<PacketVersion>(AudioVersion::CodecNameInAudioPackets);
+            return static_cast<PacketVersion>(AudioVersion::SilentFrameRuns);
+        case PacketType::AudioStreamStats:
+            return static_cast<PacketVersion>(AudioStreamStatsVersion::TimeStretchedFrames);
 
         default:
             return 17;
     }
 }
 
+bool packetVersionSupportsCompression(PacketType packetType, PacketVersion version) {
+    switch (packetType) {
+        case PacketType::AssetMappingOperationReply:
+            return version >= static_cast<PacketVersion>(AssetMappingOperationReplyVersion::CompressedPayload);
+        default:
+            return false;
+    }
+}
+
 uint qHash(const PacketType& key, uint seed) {
     // seems odd that Qt couldn't figure out this cast itself, but this fixes a compile error after switch
     // to strongly typed enum for PacketType
@@ -119,6 +134,7 @@ static void ensureProtocolVersionsSignature() {
             uint8_t packetTypeVersion = static_cast<uint8_t>(versionForPacketType(static_cast<PacketType>(packetType)));
             stream << packetTypeVersion;
         }
+        stream << PACKET_VERIFICATION_VERSION;
         QCryptographicHash hash(QCryptographicHash::Md5);
         hash.addData(buffer);
         protocolVersionSignature = hash.result();
@@ -99,7 +99,8 @@ public:
         SelectedAudioFormat,
         MoreEntityShapes,
         NodeKickRequest,
-        LAST_PACKET_TYPE = NodeKickRequest
+        AvatarQuery,
+        LAST_PACKET_TYPE = AvatarQuery
     };
 };
 
@@ -107,12 +108,18 @@ using PacketType = PacketTypeEnum::Value;
 
 const int NUM_BYTES_MD5_HASH = 16;
 
+// The hash of a verified packet is a SipHash-2-4-128 since version 1, it was an MD5 before. The version is part of
+// the protocol signature, so a node and a domain that don't hash the same way can't connect.
+const uint8_t PACKET_VERIFICATION_VERSION = 1;
+const int NUM_BYTES_VERIFICATION_HASH = 16;
+
 typedef char PacketVersion;
 
 extern const QSet<PacketType> NON_VERIFIED_PACKETS;
 extern const QSet<PacketType> NON_SOURCED_PACKETS;
 
 PacketVersion versionForPacketType(PacketType packetType);
+bool packetVersionSupportsCompression(PacketType packetType, PacketVersion version); /// ordered lists of this type and version lead with a PayloadCodec
 QByteArray protocolVersionsSignature(); /// returns a unqiue signature for all the current protocols
 QString protocolVersionsSignatureBase64();
 
@@ -195,7 +202,8 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     AvatarEntities,
     AbsoluteSixByteRotations,
     SensorToWorldMat,
-    HandControllerJoints
+    HandControllerJoints,
+    BitPackedJoints
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -216,12 +224,29 @@ enum class DomainServerAddedNodeVersion : PacketVersion {
 
 enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
-    PermissionsGrid
+    PermissionsGrid,
+    DeltaUpdates
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreListVersion = 17,
+    HasListVersion
 };
 
 enum class AudioVersion : PacketVersion {
     HasCompressedAudio = 17,
-    CodecNameInAudioPackets
+    CodecNameInAudioPackets,
+    SilentFrameRuns
+};
+
+enum class AudioStreamStatsVersion : PacketVersion {
+    PreJitterHistogram = 17,
+    TimeStretchedFrames
+};
+
+enum class AssetMappingOperationReplyVersion : PacketVersion {
+    Uncompressed = 17,
+    CompressedPayload
 };
 
 #endif // hifi_PacketHeaders_h
@@ -121,6 +121,12 @@ void PacketList::closeCurrentPacket(bool shouldSendEmpty) {
     }
 }
 
+void PacketList::clearPackets() {
+    _packets.clear();
+    _currentPacket.reset();
+    _segmentStartIndex = -1;
+}
+
 QByteArray PacketList::getMessage() const {
     size_t sizeBytes = 0;
 
@@ -68,6 +68,9 @@ protected:
     
     void preparePackets(MessageNumber messageNumber);
 
+    // throws away everything written so far, so that the list can be written again from scratch
+    void clearPackets();
+
     virtual qint64 writeData(const char* data, qint64 maxSize) override;
     // Not implemented, added an assert so that it doesn't get used by accident
     virtual qint64 readData(char* data, qint64 maxSize) override { Q_ASSERT(false); return 0; }
@@ -11,6 +11,7 @@
 
 #include "PacketTimeWindow.h"
 
+#include <algorithm>
 #include <numeric>
 #include <cmath>
 
@@ -92,33 +93,31 @@ int32_t PacketTimeWindow::getEstimatedBandwidth() const {
     return meanOfMedianFilteredValues(_probeIntervals, _numProbeIntervals);
 }
 
-void PacketTimeWindow::onPacketArrival() {
-    
-    // take the current time
-    auto now = p_high_resolution_clock::now();
+void PacketTimeWindow::onPacketArrival(p_high_resolution_clock::time_point arrivalTime) {
     
     if (_packetIntervals.size() > 0) {
         // record the interval between this packet and the last one
-        _packetIntervals[_currentPacketInterval++] = duration_cast<microseconds>(now - _lastPacketTime).count();
+        // (never negative, in case this arrival time came from a different clock source than the last)
+        _packetIntervals[_currentPacketInterval++] =
+            std::max(duration_cast<microseconds>(arrivalTime - _lastPacketTime).count(), (microseconds::rep) 0);
         
         // reset the currentPacketInterval index when it wraps
         _currentPacketInterval %= _numPacketIntervals;
     }
     
     // remember this as the last packet arrival time
-    _lastPacketTime = now;
+    _lastPacketTime = arrivalTime;
 }
 
-void PacketTimeWindow::onProbePair1Arrival() {
-    // take the current time as the first probe time
-    _firstProbeTime = p_high_resolution_clock::now();
+void PacketTimeWindow::onProbePair1Arrival(p_high_resolution_clock::time_point arrivalTime) {
+    // take the arrival time as the first probe time
+    _firstProbeTime = arrivalTime;
 }
 
-void PacketTimeWindow::onProbePair2Arrival() {
+void PacketTimeWindow::onProbePair2Arrival(p_high_resolution_clock::time_point arrivalTime) {
     // store the interval between the two probes
-    auto now = p_high_resolution_clock::now();
-    
-    _probeIntervals[_currentProbeInterval++] = duration_cast<microseconds>(now - _firstProbeTime).count();
+    _probeIntervals[_currentProbeInterval++] =
+        std::max(duration_cast<microseconds>(arrivalTime - _firstProbeTime).count(), (microseconds::rep) 0);
     
     // reset the currentProbeInterval index when it wraps
     _currentProbeInterval %= _numProbeIntervals;
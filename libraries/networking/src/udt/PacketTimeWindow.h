@@ -24,9 +24,10 @@ class PacketTimeWindow {
 public:
     PacketTimeWindow(int numPacketIntervals = 16, int numProbeIntervals = 16);
     
-    void onPacketArrival();
-    void onProbePair1Arrival();
-    void onProbePair2Arrival();
+    // arrival times default to now, pass the packet's receive time when the socket has one
+    void onPacketArrival(p_high_resolution_clock::time_point arrivalTime = p_high_resolution_clock::now());
+    void onProbePair1Arrival(p_high_resolution_clock::time_point arrivalTime = p_high_resolution_clock::now());
+    void onProbePair2Arrival(p_high_resolution_clock::time_point arrivalTime = p_high_resolution_clock::now());
     
     int32_t getPacketReceiveSpeed() const;
     int32_t getEstimatedBandwidth() const;
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <random>
 #include <thread>
+#include <vector>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
@@ -97,6 +98,8 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest) :
     _currentSequenceNumber = _initialSequenceNumber - 1;
     _atomicCurrentSequenceNumber = uint32_t(_currentSequenceNumber);
     _lastACKSequenceNumber = uint32_t(_currentSequenceNumber) - 1;
+
+    _isBatchedSendEnabled = _socket->isBatchedSendEnabled();
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
@@ -238,11 +241,15 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     // write the sequence number and send the packet
     newPacket->writeSequenceNumber(sequenceNumber);
 
+    auto bytesWritten = sendPacket(*newPacket);
+
+    return addToSentList(std::move(newPacket), sequenceNumber, bytesWritten);
+}
+
+bool SendQueue::addToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber, qint64 bytesWritten) {
     // Save packet/payload size before we move it
     auto packetSize = newPacket->getDataSize();
     auto payloadSize = newPacket->getPayloadSize();
-    
-    auto bytesWritten = sendPacket(*newPacket);
 
     {
         // Insert the packet we have just sent in the sent list
@@ -310,7 +317,25 @@ void SendQueue::run() {
         // (this is according to the current flow window size) then we send out a new packet
         auto newPacketCount = 0;
         if (!attemptedToSendPacket) {
-            newPacketCount = maybeSendNewPacket();
+            if (_isBatchedSendEnabled) {
+                // gather every packet that is due now or within the next pacing window
+                static const int BATCH_PACING_WINDOW_USECS = 1000;
+                static const int MAX_PACKETS_PER_BATCH = 64;
+
+                int maxPackets = MAX_PACKETS_PER_BATCH;
+                int packetSendPeriod = _packetSendPeriod;
+
+                if (packetSendPeriod > 0) {
+                    auto usecsBehind = duration_cast<microseconds>(p_high_resolution_clock::now() - nextPacketTimestamp);
+                    int64_t usecsDue = usecsBehind.count() + BATCH_PACING_WINDOW_USECS;
+                    maxPackets = (int) std::max(std::min(usecsDue / packetSendPeriod + 1, (int64_t) MAX_PACKETS_PER_BATCH),
+                                                (int64_t) 1);
+                }
+
+                newPacketCount = maybeSendNewPacketBatch(maxPackets);
+            } else {
+                newPacketCount = maybeSendNewPacket();
+            }
             attemptedToSendPacket = (newPacketCount > 0);
         }
         
@@ -326,7 +351,9 @@ void SendQueue::run() {
         }
 
         // push the next packet timestamp forwards by the current packet send period
-        auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
+        // (once per packet when sending in batches)
+        auto nextPacketDelta = (_isBatchedSendEnabled ? std::max(newPacketCount, 1) : (newPacketCount == 2 ? 2 : 1))
+            * _packetSendPeriod;
         nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
 
         // sleep as long as we need for next packet send, if we can
@@ -428,6 +455,67 @@ int SendQueue::maybeSendNewPacket() {
     return 0;
 }
 
+int SendQueue::maybeSendNewPacketBatch(int maxPackets) {
+    std::vector<std::unique_ptr<Packet>> newPackets;
+    std::vector<SequenceNumber> sequenceNumbers;
+    std::vector<const BasePacket*> datagrams;
+
+    static auto pairTailPacket = ControlPacket::create(ControlPacket::ProbeTail);
+
+    while ((int) newPackets.size() < maxPackets && !isFlowWindowFull()) {
+        std::unique_ptr<Packet> packet = _packets.takePacket();
+        if (!packet) {
+            break;
+        }
+
+        SequenceNumber nextNumber = getNextSequenceNumber();
+        packet->writeSequenceNumber(nextNumber);
+
+        datagrams.push_back(packet.get());
+        sequenceNumbers.push_back(nextNumber);
+        newPackets.push_back(std::move(packet));
+
+        if (((uint32_t) nextNumber & 0xF) == 0) {
+            // this is the first packet in a probe pair, the tail has to follow it in the same batch
+            std::unique_ptr<Packet> secondPacket = _packets.takePacket();
+
+            if (secondPacket) {
+                SequenceNumber secondNumber = getNextSequenceNumber();
+                secondPacket->writeSequenceNumber(secondNumber);
+
+                datagrams.push_back(secondPacket.get());
+                sequenceNumbers.push_back(secondNumber);
+                newPackets.push_back(std::move(secondPacket));
+            } else {
+                // no second packet for the pair, send a ProbeTail so the receiver can still estimate bandwidth
+                datagrams.push_back(pairTailPacket.get());
+            }
+        }
+    }
+
+    if (newPackets.empty()) {
+        // No packets were sent
+        return 0;
+    }
+
+    std::vector<qint64> bytesWritten;
+    auto numSyscalls = _socket->writeDatagrams(datagrams, _destination, bytesWritten);
+
+    // walk the datagrams to match up the write results with the packets (ProbeTails are not tracked)
+    size_t packetIndex = 0;
+    for (size_t i = 0; i < datagrams.size(); ++i) {
+        if (packetIndex < newPackets.size() && datagrams[i] == newPackets[packetIndex].get()) {
+            addToSentList(std::move(newPackets[packetIndex]), sequenceNumbers[packetIndex], bytesWritten[i]);
+            ++packetIndex;
+        }
+    }
+
+    emit batchSent((int) datagrams.size(), numSyscalls);
+
+    // return the number of attempted packet sends
+    return (int) sequenceNumbers.size();
+}
+
 bool SendQueue::maybeResendPacket() {
     
     // the following while makes sure that we find a packet to re-send, if there is one
@@ -76,6 +76,7 @@ public slots:
 signals:
     void packetSent(int dataSize, int payloadSize);
     void packetRetransmitted();
+    void batchSent(int numDatagrams, int numSyscalls);
     
     void queueInactive();
 
@@ -94,8 +95,10 @@ private:
     
     int sendPacket(const Packet& packet);
     bool sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber);
+    bool addToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber, qint64 bytesWritten);
     
     int maybeSendNewPacket(); // Figures out what packet to send next
+    int maybeSendNewPacketBatch(int maxPackets); // Sends up to maxPackets new packets with one Socket::writeDatagrams
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
     bool isInactive(bool attemptedToSendPacket);
@@ -126,6 +129,8 @@ private:
     std::atomic<int64_t> _lastReceiverResponse { 0 }; // Timestamp for the last time we got new data from the receiver (ACK/NAK)
     
     std::atomic<int> _flowWindowSize { 0 }; // Flow control window size (number of packets that can be on wire) - set from CC
+
+    bool _isBatchedSendEnabled { false }; // Gather the packets due within a pacing window into a single write
     
     mutable std::mutex _naksLock; // Protects the naks list.
     LossList _naks; // Sequence numbers of packets to resend
@@ -11,10 +11,26 @@
 
 #include "Socket.h"
 
-#ifdef Q_OS_ANDROID
+#if defined(Q_OS_ANDROID) || defined(UDT_BATCHED_RECEIVE) || defined(UDT_BATCHED_SEND) || defined(UDT_KERNEL_TIMESTAMPS)
 #include <sys/socket.h>
 #endif
 
+#ifdef UDT_KERNEL_TIMESTAMPS
+#include <linux/sockios.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#endif
+
+#ifdef UDT_BATCHED_SEND
+#include <arpa/inet.h>
+#endif
+
+#if defined(UDT_BATCHED_RECEIVE) || defined(UDT_BATCHED_SEND)
+#include <array>
+#include <cerrno>
+#include <cstring>
+#endif
+
 #include <QtCore/QThread>
 
 #include <LogHandler.h>
@@ -29,6 +45,42 @@
 
 using namespace udt;
 
+#ifdef UDT_BATCHED_RECEIVE
+struct Socket::ReceiveBatch {
+    std::array<mmsghdr, RECEIVE_BATCH_SIZE> headers;
+    std::array<iovec, RECEIVE_BATCH_SIZE> vectors;
+    std::array<sockaddr_storage, RECEIVE_BATCH_SIZE> addresses;
+#ifdef UDT_KERNEL_TIMESTAMPS
+    std::array<std::array<char, CMSG_SPACE(sizeof(timespec))>, RECEIVE_BATCH_SIZE> controls;
+#endif
+
+    // each slot keeps its buffer until a datagram is read into it and handed off to a packet
+    std::array<PacketBuffer, RECEIVE_BATCH_SIZE> buffers;
+};
+#endif
+
+#ifdef UDT_KERNEL_TIMESTAMPS
+// converts a kernel (CLOCK_REALTIME) receive timestamp to our clock, using how long ago it was taken
+static p_high_resolution_clock::time_point fromKernelTimestamp(const timespec& timestamp,
+                                                               p_high_resolution_clock::time_point fallback) {
+    using namespace std::chrono;
+
+    timespec realtimeNow;
+    clock_gettime(CLOCK_REALTIME, &realtimeNow);
+
+    auto age = nanoseconds((realtimeNow.tv_sec - timestamp.tv_sec) * 1000000000LL
+                           + (realtimeNow.tv_nsec - timestamp.tv_nsec));
+
+    // don't trust a timestamp from the future or from too long ago - the wall clock was likely stepped
+    static const auto MAX_TIMESTAMP_AGE = seconds(1);
+    if (age.count() < 0 || age > MAX_TIMESTAMP_AGE) {
+        return fallback;
+    }
+
+    return p_high_resolution_clock::now() - duration_cast<p_high_resolution_clock::duration>(age);
+}
+#endif
+
 Socket::Socket(QObject* parent) :
     QObject(parent),
     _synTimer(new QTimer(this))
@@ -47,6 +99,10 @@ Socket::Socket(QObject* parent) :
     connect(&_udpSocket, &QAbstractSocket::stateChanged, this, &Socket::handleStateChanged);
 }
 
+Socket::~Socket() {
+    // defined here so that the batched receive state is complete when it is destroyed
+}
+
 void Socket::bind(const QHostAddress& address, quint16 port) {
     _udpSocket.bind(address, port);
     setSystemBufferSizes();
@@ -55,6 +111,15 @@ void Socket::bind(const QHostAddress& address, quint16 port) {
     auto sd = _udpSocket.socketDescriptor();
     int val = IP_PMTUDISC_DONT;
     setsockopt(sd, IPPROTO_IP, IP_MTU_DISCOVER, &val, sizeof(val));
+
+#ifdef UDT_KERNEL_TIMESTAMPS
+    int enableTimestamps = 1;
+    _hasKernelTimestamps = setsockopt(sd, SOL_SOCKET, SO_TIMESTAMPNS, &enableTimestamps, sizeof(enableTimestamps)) == 0;
+
+    if (!_hasKernelTimestamps) {
+        qCDebug(networking) << "Kernel receive timestamps are not available, packet timing will be taken in userspace";
+    }
+#endif
 #elif defined(Q_OS_WINDOWS)
     auto sd = _udpSocket.socketDescriptor();
     int val = 0; // false
@@ -196,6 +261,91 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+int Socket::writeDatagrams(const std::vector<const BasePacket*>& datagrams, const HifiSockAddr& sockAddr,
+                           std::vector<qint64>& bytesWritten) {
+    int numDatagrams = (int) datagrams.size();
+    bytesWritten.assign(numDatagrams, -1);
+
+#ifdef UDT_BATCHED_SEND
+    if (numDatagrams > 1 && sockAddr.getAddress().protocol() == QAbstractSocket::IPv4Protocol) {
+        sockaddr_in destination;
+        memset(&destination, 0, sizeof(destination));
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(sockAddr.getPort());
+        destination.sin_addr.s_addr = htonl(sockAddr.getAddress().toIPv4Address());
+
+        std::vector<iovec> vectors(numDatagrams);
+        std::vector<mmsghdr> headers(numDatagrams);
+
+        for (int i = 0; i < numDatagrams; ++i) {
+            vectors[i].iov_base = const_cast<char*>(datagrams[i]->getData());
+            vectors[i].iov_len = datagrams[i]->getDataSize();
+
+            memset(&headers[i], 0, sizeof(mmsghdr));
+
+            auto& messageHeader = headers[i].msg_hdr;
+            messageHeader.msg_name = &destination;
+            messageHeader.msg_namelen = sizeof(destination);
+            messageHeader.msg_iov = &vectors[i];
+            messageHeader.msg_iovlen = 1;
+        }
+
+        auto socketDescriptor = static_cast<int>(_udpSocket.socketDescriptor());
+
+        int numSent = 0;
+        int numSyscalls = 0;
+
+        while (numSent < numDatagrams) {
+            int result = sendmmsg(socketDescriptor, headers.data() + numSent, numDatagrams - numSent, 0);
+            ++numSyscalls;
+
+            if (result <= 0) {
+                // the rest of the batch did not make it on the wire, leave their results as errors
+                // so that they will be handled as short-circuit losses
+                static const QString WRITE_ERROR_REGEX = "Socket::writeDatagrams failed to send .*";
+                static QString repeatedMessage
+                    = LogHandler::getInstance().addRepeatedMessageRegex(WRITE_ERROR_REGEX);
+
+                qCDebug(networking) << "Socket::writeDatagrams failed to send" << (numDatagrams - numSent)
+                    << "datagrams -" << strerror(errno);
+                break;
+            }
+
+            for (int i = numSent; i < numSent + result; ++i) {
+                bytesWritten[i] = headers[i].msg_len;
+            }
+
+            numSent += result;
+        }
+
+        return numSyscalls;
+    }
+#endif
+
+    for (int i = 0; i < numDatagrams; ++i) {
+        bytesWritten[i] = writeDatagram(datagrams[i]->getData(), datagrams[i]->getDataSize(), sockAddr);
+    }
+
+    return numDatagrams;
+}
+
+int Socket::writePackets(const std::vector<const Packet*>& packets, const HifiSockAddr& sockAddr,
+                         std::vector<qint64>& bytesWritten) {
+    std::vector<const BasePacket*> datagrams;
+    datagrams.reserve(packets.size());
+
+    auto& sequenceNumber = _unreliableSequenceNumbers[sockAddr];
+    for (auto packet : packets) {
+        Q_ASSERT_X(!packet->isReliable(), "Socket::writePackets", "Cannot send a reliable packet unreliably");
+
+        // write the correct sequence number to the Packet here
+        packet->writeSequenceNumber(++sequenceNumber);
+        datagrams.push_back(packet);
+    }
+
+    return writeDatagrams(datagrams, sockAddr, bytesWritten);
+}
+
 Connection& Socket::findOrCreateConnection(const HifiSockAddr& sockAddr) {
     auto it = _connectionsHash.find(sockAddr);
 
@@ -259,67 +409,180 @@ void Socket::readPendingDatagrams() {
         HifiSockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::allocate(packetSizeWithHeader);
 
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
                                                 senderSockAddr.getAddressPointer(), senderSockAddr.getPortPointer());
 
+        auto receiveTime = p_high_resolution_clock::now();
+
         if (sizeRead <= 0) {
             // we either didn't pull anything for this packet or there was an error reading (this seems to trigger
             // on windows even if there's not a packet available)
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+#ifdef UDT_KERNEL_TIMESTAMPS
+        receiveTime = lastKernelReceiveTime(receiveTime);
+#endif
+
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+
+#ifdef UDT_BATCHED_RECEIVE
+        // the first datagram always goes through the QUdpSocket so that it re-arms its read notification,
+        // anything else already queued on the socket is drained in batches
+        readPendingDatagramBatches();
+#endif
+    }
+
+    if (_receiveFinishedOperator) {
+        _receiveFinishedOperator();
+    }
+}
+
+#ifdef UDT_BATCHED_RECEIVE
+void Socket::readPendingDatagramBatches() {
+    if (!_receiveBatch) {
+        _receiveBatch.reset(new ReceiveBatch);
+    }
+
+    auto& batch = *_receiveBatch;
+    auto socketDescriptor = static_cast<int>(_udpSocket.socketDescriptor());
+
+    int numReceived = 0;
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                it->second(std::move(basePacket));
+    do {
+        for (int i = 0; i < RECEIVE_BATCH_SIZE; ++i) {
+            if (!batch.buffers[i]) {
+                // this slot's buffer was handed off with a packet during the last batch, replace it
+                batch.buffers[i] = PacketBufferPool::allocate(MAX_PACKET_SIZE);
             }
 
-            continue;
+            batch.vectors[i].iov_base = batch.buffers[i].get();
+            batch.vectors[i].iov_len = MAX_PACKET_SIZE;
+
+            memset(&batch.headers[i], 0, sizeof(mmsghdr));
+
+            auto& messageHeader = batch.headers[i].msg_hdr;
+            messageHeader.msg_name = &batch.addresses[i];
+            messageHeader.msg_namelen = sizeof(sockaddr_storage);
+            messageHeader.msg_iov = &batch.vectors[i];
+            messageHeader.msg_iovlen = 1;
+
+#ifdef UDT_KERNEL_TIMESTAMPS
+            if (_hasKernelTimestamps) {
+                messageHeader.msg_control = batch.controls[i].data();
+                messageHeader.msg_controllen = batch.controls[i].size();
+            }
+#endif
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        numReceived = recvmmsg(socketDescriptor, batch.headers.data(), RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        auto batchReceiveTime = p_high_resolution_clock::now();
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        for (int i = 0; i < numReceived; ++i) {
+            qint64 sizeRead = batch.headers[i].msg_len;
 
-            // move this control packet to the matching connection
-            auto& connection = findOrCreateConnection(senderSockAddr);
-            connection.processControl(move(controlPacket));
+            if (sizeRead <= 0 || (batch.headers[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+                // nothing usable in this slot (a truncated datagram is larger than any packet we would send)
+                // so its buffer stays where it is for the next batch
+                continue;
+            }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
-                    auto& connection = findOrCreateConnection(senderSockAddr);
-
-                    if (!connection.processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                  packet->getDataSize(),
-                                                                  packet->getPayloadSize())) {
-                        // the connection indicated that we should not continue processing this packet
-                        continue;
-                    }
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&batch.addresses[i]));
+
+            auto receiveTime = batchReceiveTime;
+
+#ifdef UDT_KERNEL_TIMESTAMPS
+            auto& messageHeader = batch.headers[i].msg_hdr;
+            for (auto control = CMSG_FIRSTHDR(&messageHeader); control; control = CMSG_NXTHDR(&messageHeader, control)) {
+                if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS) {
+                    timespec timestamp;
+                    memcpy(&timestamp, CMSG_DATA(control), sizeof(timestamp));
+                    receiveTime = fromKernelTimestamp(timestamp, batchReceiveTime);
                 }
+            }
+#endif
 
-                if (packet->isPartOfMessage()) {
-                    auto& connection = findOrCreateConnection(senderSockAddr);
-                    connection.queueReceivedMessagePacket(std::move(packet));
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            processDatagram(std::move(batch.buffers[i]), sizeRead, senderSockAddr, receiveTime);
+        }
+
+        // a full batch means there may be more datagrams waiting on the socket
+    } while (numReceived == RECEIVE_BATCH_SIZE);
+}
+#endif
+
+#ifdef UDT_KERNEL_TIMESTAMPS
+p_high_resolution_clock::time_point Socket::lastKernelReceiveTime(p_high_resolution_clock::time_point fallback) {
+    if (!_hasKernelTimestamps) {
+        return fallback;
+    }
+
+    // the QUdpSocket doesn't hand us its control messages, ask for the timestamp of the datagram it just read
+    timespec timestamp;
+    if (ioctl(static_cast<int>(_udpSocket.socketDescriptor()), SIOCGSTAMPNS, &timestamp) != 0) {
+        return fallback;
+    }
+
+    return fromKernelTimestamp(timestamp, fallback);
+}
+#endif
+
+void Socket::processDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader,
+                             const HifiSockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection
+        auto& connection = findOrCreateConnection(senderSockAddr);
+        connection.processControl(move(controlPacket));
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+                auto& connection = findOrCreateConnection(senderSockAddr);
+
+                if (!connection.processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                              packet->getDataSize(),
+                                                              packet->getPayloadSize(),
+                                                              packet->getReceiveTime())) {
+                    // the connection indicated that we should not continue processing this packet
+                    return;
                 }
             }
+
+            if (packet->isPartOfMessage()) {
+                auto& connection = findOrCreateConnection(senderSockAddr);
+                connection.queueReceivedMessagePacket(std::move(packet));
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
+            }
         }
     }
 }
@@ -14,6 +14,7 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
 #include <functional>
 #include <unordered_map>
 
@@ -27,6 +28,15 @@
 
 //#define UDT_CONNECTION_DEBUG
 
+#if defined(Q_OS_LINUX)
+// drain the socket with recvmmsg instead of one readDatagram call per datagram
+#define UDT_BATCHED_RECEIVE
+// submit batches of datagrams to the same destination with sendmmsg
+#define UDT_BATCHED_SEND
+// give received packets the time the kernel received them at, rather than when we got around to reading them
+#define UDT_KERNEL_TIMESTAMPS
+#endif
+
 class UDTTest;
 
 namespace udt {
@@ -37,6 +47,7 @@ class PacketList;
 class SequenceNumber;
 
 using PacketFilterOperator = std::function<bool(const Packet&)>;
+using ReceiveFinishedOperator = std::function<void()>;
 
 using BasePacketHandler = std::function<void(std::unique_ptr<BasePacket>)>;
 using PacketHandler = std::function<void(std::unique_ptr<Packet>)>;
@@ -49,6 +60,7 @@ public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
     
     Socket(QObject* object = 0);
+    ~Socket();
     
     quint16 localPort() const { return _udpSocket.localPort(); }
     
@@ -59,11 +71,22 @@ public:
     qint64 writePacketList(std::unique_ptr<PacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr);
+
+    // Writes all datagrams to the same destination, in as few system calls as the platform allows
+    // bytesWritten is filled with the result for each datagram, the number of system calls used is returned
+    int writeDatagrams(const std::vector<const BasePacket*>& datagrams, const HifiSockAddr& sockAddr,
+                       std::vector<qint64>& bytesWritten);
+
+    // Unreliable version of writePacket for a batch of packets to the same destination, sent with writeDatagrams
+    int writePackets(const std::vector<const Packet*>& packets, const HifiSockAddr& sockAddr,
+                     std::vector<qint64>& bytesWritten);
     
     void bind(const QHostAddress& address, quint16 port = 0);
     void rebind();
     
     void setPacketFilterOperator(PacketFilterOperator filterOperator) { _packetFilterOperator = filterOperator; }
+    // called once the datagrams waiting on the socket have all been read, for a filter that keeps state across them
+    void setReceiveFinishedOperator(ReceiveFinishedOperator finishedOperator) { _receiveFinishedOperator = finishedOperator; }
     void setPacketHandler(PacketHandler handler) { _packetHandler = handler; }
     void setMessageHandler(MessageHandler handler) { _messageHandler = handler; }
     void setMessageFailureHandler(MessageFailureHandler handler) { _messageFailureHandler = handler; }
@@ -74,6 +97,10 @@ public:
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
+    // SendQueues created after this is set gather the packets due in a pacing window into one writeDatagrams call
+    void setBatchedSendEnabled(bool isBatchedSendEnabled) { _isBatchedSendEnabled = isBatchedSendEnabled; }
+    bool isBatchedSendEnabled() const { return _isBatchedSendEnabled; }
+
     void messageReceived(std::unique_ptr<Packet> packet);
     void messageFailed(Connection* connection, Packet::MessageNumber messageNumber);
     
@@ -93,6 +120,12 @@ private slots:
 private:
     void setSystemBufferSizes();
     Connection& findOrCreateConnection(const HifiSockAddr& sockAddr);
+
+    void processDatagram(PacketBuffer buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
+#ifdef UDT_BATCHED_RECEIVE
+    void readPendingDatagramBatches();
+#endif
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const HifiSockAddr& destination);
@@ -105,6 +138,7 @@ private:
     
     QUdpSocket _udpSocket { this };
     PacketFilterOperator _packetFilterOperator;
+    ReceiveFinishedOperator _receiveFinishedOperator;
     PacketHandler _packetHandler;
     MessageHandler _messageHandler;
     MessageFailureHandler _messageFailureHandler;
@@ -117,8 +151,23 @@ private:
     QTimer* _synTimer { nullptr };
 
     int _maxBandwidth { -1 };
+
+    std::atomic<bool> _isBatchedSendEnabled { false };
     
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<DefaultCC>() };
+
+#ifdef UDT_BATCHED_RECEIVE
+    static const int RECEIVE_BATCH_SIZE = 64;
+
+    struct ReceiveBatch;
+    std::unique_ptr<ReceiveBatch> _receiveBatch;
+#endif
+
+#ifdef UDT_KERNEL_TIMESTAMPS
+    p_high_resolution_clock::time_point lastKernelReceiveTime(p_high_resolution_clock::time_point fallback);
+
+    bool _hasKernelTimestamps { false };
+#endif
     
     friend UDTTest;
 };
@@ -17,14 +17,14 @@ DirtyOctreeElementOperator::DirtyOctreeElementOperator(OctreeElementPointer elem
     _point = _element->getAACube().calcCenter();
 }
 
-bool DirtyOctreeElementOperator::preRecursion(OctreeElementPointer element) {
+bool DirtyOctreeElementOperator::preRecursion(const OctreeElementPointer& element) {
     if (element == _element) {
         return false;
     }
     return element->getAACube().contains(_point);
 }
 
-bool DirtyOctreeElementOperator::postRecursion(OctreeElementPointer element) {
+bool DirtyOctreeElementOperator::postRecursion(const OctreeElementPointer& element) {
     element->markWithChangedTime();
     return true;
 }
@@ -20,8 +20,8 @@ public:
 
     ~DirtyOctreeElementOperator() {}
 
-    virtual bool preRecursion(OctreeElementPointer element) override;
-    virtual bool postRecursion(OctreeElementPointer element) override;
+    virtual bool preRecursion(const OctreeElementPointer& element) override;
+    virtual bool postRecursion(const OctreeElementPointer& element) override;
 private:
     glm::vec3 _point;
     OctreeElementPointer _element;
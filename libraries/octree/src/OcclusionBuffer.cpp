@@ -0,0 +1,86 @@
+//
+//  OcclusionBuffer.cpp
+//  libraries/octree/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+// the most occluders a buffer keeps, each cube tested is compared with all of them
+const int MAX_OCCLUDERS = 32;
+
+static float farthestDistance(const glm::vec3& point, const AABox& box) {
+    glm::vec3 farthest = glm::max(glm::abs(point - box.getMinimum()), glm::abs(point - box.getMaximum()));
+    return glm::length(farthest);
+}
+
+static float nearestDistance(const glm::vec3& point, const AACube& cube) {
+    glm::vec3 nearest = glm::clamp(point, cube.getMinimumPoint(), cube.getMaximumPoint());
+    return glm::distance(point, nearest);
+}
+
+OcclusionBuffer::OcclusionBuffer(const ViewFrustum& viewFrustum, const std::vector<AABox>& occluders) :
+    _viewFrustum(viewFrustum),
+    _occluderBoxes(occluders)
+{
+    const glm::vec3& position = viewFrustum.getPosition();
+    for (const AABox& box : occluders) {
+        if (!viewFrustum.boxIntersectsFrustum(box)) {
+            continue;
+        }
+        // the outline is only good when all of the box is in front of the viewer, and there is none when the
+        // viewer is inside of it
+        CubeProjectedPolygon outline = viewFrustum.getProjectedPolygon(box);
+        if (outline.getVertexCount() == 0 || !outline.getAllInView()) {
+            continue;
+        }
+        Occluder occluder;
+        occluder.outline = outline;
+        occluder.farthestDistance = farthestDistance(position, box);
+        _occluders.push_back(occluder);
+    }
+
+    if ((int)_occluders.size() > MAX_OCCLUDERS) {
+        std::partial_sort(_occluders.begin(), _occluders.begin() + MAX_OCCLUDERS, _occluders.end(),
+            [](const Occluder& first, const Occluder& second) {
+                return first.outline.getBoundingBox().area() > second.outline.getBoundingBox().area();
+            });
+        _occluders.erase(_occluders.begin() + MAX_OCCLUDERS, _occluders.end());
+    }
+}
+
+bool OcclusionBuffer::isOccluded(const AACube& cube) const {
+    if (_occluders.empty()) {
+        return false;
+    }
+
+    // the cube is only projected once an occluder is known to be in front of all of it
+    float distance = nearestDistance(_viewFrustum.getPosition(), cube);
+    CubeProjectedPolygon outline;
+    bool isProjected = false;
+    for (const Occluder& occluder : _occluders) {
+        if (distance < occluder.farthestDistance) {
+            continue;
+        }
+        if (!isProjected) {
+            outline = _viewFrustum.getProjectedPolygon(cube);
+            if (outline.getVertexCount() == 0 || !outline.getAllInView()) {
+                return false;
+            }
+            isProjected = true;
+        }
+        if (occluder.outline.occludes(outline)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,56 @@
+//
+//  OcclusionBuffer.h
+//  libraries/octree/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OcclusionBuffer_h
+#define hifi_OcclusionBuffer_h
+
+#include <memory>
+#include <vector>
+
+#include <AABox.h>
+#include <AACube.h>
+#include <CubeProjectedPolygon.h>
+#include <ViewFrustum.h>
+
+// A coarse picture of what a viewer can't see, made from the outlines on its screen of the solid boxes in front of it
+// that cover the most of it. A cube is occluded when its outline is inside the outline of one of those boxes and all
+// of it is farther from the viewer than all of the box, so that every line of sight to it goes through the box first.
+//
+// The boxes come from Octree::getOccluders, and have to be solid and opaque for what is behind them to be left out.
+// A buffer is made for one view and does not change, so a scene can hold on to the one it was sent with.
+class OcclusionBuffer {
+public:
+    OcclusionBuffer(const ViewFrustum& viewFrustum, const std::vector<AABox>& occluders);
+
+    // the boxes the buffer was made from, to tell when the occluders of a tree have changed
+    const std::vector<AABox>& getOccluderBoxes() const { return _occluderBoxes; }
+
+    bool isEmpty() const { return _occluders.empty(); }
+    int getOccluderCount() const { return (int)_occluders.size(); }
+
+    bool isOccluded(const AACube& cube) const;
+
+private:
+    struct Occluder {
+        CubeProjectedPolygon outline;
+        float farthestDistance;
+    };
+
+    ViewFrustum _viewFrustum;
+    std::vector<AABox> _occluderBoxes;
+    std::vector<Occluder> _occluders;
+};
+
+using OcclusionBufferPointer = std::shared_ptr<const OcclusionBuffer>;
+
+#endif // hifi_OcclusionBuffer_h
@@ -31,6 +31,7 @@
 #include <QJsonDocument>
 #include <QFileInfo>
 #include <QString>
+#include <QThread>
 
 #include <GeometryUtil.h>
 #include <Gzip.h>
@@ -117,7 +118,7 @@ void Octree::recurseTreeWithPostOperation(RecurseOctreeOperation operation, void
 }
 
 // Recurses voxel element with an operation function
-void Octree::recurseElementWithOperation(OctreeElementPointer element, RecurseOctreeOperation operation, void* extraData,
+void Octree::recurseElementWithOperation(const OctreeElementPointer& element, RecurseOctreeOperation operation, void* extraData,
                         int recursionCount) {
     if (recursionCount > DANGEROUSLY_DEEP_RECURSION) {
         static QString repeatedMessage
@@ -130,7 +131,7 @@ void Octree::recurseElementWithOperation(OctreeElementPointer element, RecurseOc
 
     if (operation(element, extraData)) {
         for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-            OctreeElementPointer child = element->getChildAtIndex(i);
+            const OctreeElementPointer& child = element->getChildAtIndex(i);
             if (child) {
                 recurseElementWithOperation(child, operation, extraData, recursionCount+1);
             }
@@ -139,7 +140,7 @@ void Octree::recurseElementWithOperation(OctreeElementPointer element, RecurseOc
 }
 
 // Recurses voxel element with an operation function
-void Octree::recurseElementWithPostOperation(OctreeElementPointer element, RecurseOctreeOperation operation,
+void Octree::recurseElementWithPostOperation(const OctreeElementPointer& element, RecurseOctreeOperation operation,
                                              void* extraData, int recursionCount) {
     if (recursionCount > DANGEROUSLY_DEEP_RECURSION) {
         static QString repeatedMessage
@@ -151,7 +152,7 @@ void Octree::recurseElementWithPostOperation(OctreeElementPointer element, Recur
     }
 
     for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        OctreeElementPointer child = element->getChildAtIndex(i);
+        const OctreeElementPointer& child = element->getChildAtIndex(i);
         if (child) {
             recurseElementWithPostOperation(child, operation, extraData, recursionCount+1);
         }
@@ -168,7 +169,7 @@ void Octree::recurseTreeWithOperationDistanceSorted(RecurseOctreeOperation opera
 }
 
 // Recurses voxel element with an operation function
-void Octree::recurseElementWithOperationDistanceSorted(OctreeElementPointer element, RecurseOctreeOperation operation,
+void Octree::recurseElementWithOperationDistanceSorted(const OctreeElementPointer& element, RecurseOctreeOperation operation,
                                                        const glm::vec3& point, void* extraData, int recursionCount) {
 
     if (recursionCount > DANGEROUSLY_DEEP_RECURSION) {
@@ -211,7 +212,7 @@ void Octree::recurseTreeWithOperator(RecurseOctreeOperator* operatorObject) {
     recurseElementWithOperator(_rootElement, operatorObject);
 }
 
-bool Octree::recurseElementWithOperator(OctreeElementPointer element,
+bool Octree::recurseElementWithOperator(const OctreeElementPointer& element,
                                         RecurseOctreeOperator* operatorObject, int recursionCount) {
     if (recursionCount > DANGEROUSLY_DEEP_RECURSION) {
         static QString repeatedMessage
@@ -224,14 +225,17 @@ bool Octree::recurseElementWithOperator(OctreeElementPointer element,
 
     if (operatorObject->preRecursion(element)) {
         for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-            OctreeElementPointer child = element->getChildAtIndex(i);
+            // the child is passed down by reference to its slot in element, which holds it until our postRecursion
+            if (element->getChildAtIndex(i)) {
+                if (!recurseElementWithOperator(element->getChildAtIndex(i), operatorObject, recursionCount + 1)) {
+                    break; // stop recursing if operator returns false...
+                }
+                continue;
+            }
 
             // If there is no child at that location, the Operator may want to create a child at that location.
             // So give the operator a chance to do so....
-            if (!child) {
-                child = operatorObject->possiblyCreateChildAt(element, i);
-            }
-
+            OctreeElementPointer child = operatorObject->possiblyCreateChildAt(element, i);
             if (child) {
                 if (!recurseElementWithOperator(child, operatorObject, recursionCount + 1)) {
                     break; // stop recursing if operator returns false...
@@ -243,6 +247,50 @@ bool Octree::recurseElementWithOperator(OctreeElementPointer element,
     return operatorObject->postRecursion(element);
 }
 
+void Octree::trackChangedElement(const OctreeElementPointer& element) {
+    if (!_isServer || !element) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_changedElementsMutex);
+
+    // a run of edits to the same element, like a script moving one entity, only needs logging once
+    if (!_changedElements.empty() && _changedElements.back().lock() == element) {
+        return;
+    }
+
+    _changedElements.push_back(element);
+    _lastChangedElementSequence++;
+    if ((int)_changedElements.size() > MAX_TRACKED_CHANGED_ELEMENTS) {
+        _changedElements.pop_front();
+    }
+}
+
+quint64 Octree::getLastChangedElementSequence() const {
+    std::lock_guard<std::mutex> lock(_changedElementsMutex);
+    return _lastChangedElementSequence;
+}
+
+bool Octree::getChangedElementsSince(quint64 sinceSequence, int maxElements,
+                                     QVector<OctreeElementPointer>& changedElements, quint64& latestSequence) const {
+    std::lock_guard<std::mutex> lock(_changedElementsMutex);
+    latestSequence = _lastChangedElementSequence;
+
+    // if the sequence is from before a reset of the count this wraps around to a huge number and we return false
+    quint64 numChanged = _lastChangedElementSequence - sinceSequence;
+    if (numChanged > (quint64)_changedElements.size() || numChanged > (quint64)maxElements) {
+        return false;
+    }
+
+    for (size_t i = _changedElements.size() - (size_t)numChanged; i < _changedElements.size(); i++) {
+        OctreeElementPointer element = _changedElements[i].lock();
+        if (element) {
+            changedElements.push_back(element);
+        }
+    }
+    return true;
+}
+
 
 OctreeElementPointer Octree::nodeForOctalCode(OctreeElementPointer ancestorElement, const unsigned char* needleCode,
                                               OctreeElementPointer* parentOfFoundElement) const {
@@ -702,7 +750,7 @@ public:
     void* penetratedObject; /// the type is defined by the type of Octree, the caller is assumed to know the type
 };
 
-bool findSpherePenetrationOp(OctreeElementPointer element, void* extraData) {
+bool findSpherePenetrationOp(const OctreeElementPointer& element, void* extraData) {
     SphereArgs* args = static_cast<SphereArgs*>(extraData);
 
     // coarse check against bounds
@@ -764,7 +812,7 @@ public:
     CubeList* cubes;
 };
 
-bool findCapsulePenetrationOp(OctreeElementPointer element, void* extraData) {
+bool findCapsulePenetrationOp(const OctreeElementPointer& element, void* extraData) {
     CapsuleArgs* args = static_cast<CapsuleArgs*>(extraData);
 
     // coarse check against bounds
@@ -797,7 +845,7 @@ uint qHash(const glm::vec3& point) {
         (((quint64)(point.z * RESOLUTION_PER_METER)) % MAX_SCALED_COMPONENT << 2 * BITS_PER_COMPONENT));
 }
 
-bool findContentInCubeOp(OctreeElementPointer element, void* extraData) {
+bool findContentInCubeOp(const OctreeElementPointer& element, void* extraData) {
     ContentArgs* args = static_cast<ContentArgs*>(extraData);
 
     // coarse check against bounds
@@ -850,7 +898,7 @@ public:
 };
 
 // Find the smallest colored voxel enclosing a point (if there is one)
-bool getElementEnclosingOperation(OctreeElementPointer element, void* extraData) {
+bool getElementEnclosingOperation(const OctreeElementPointer& element, void* extraData) {
     GetElementEnclosingArgs* args = static_cast<GetElementEnclosingArgs*>(extraData);
     if (element->getAACube().contains(args->point)) {
         if (element->hasContent() && element->isLeaf()) {
@@ -903,6 +951,14 @@ int Octree::encodeTreeBitstream(OctreeElementPointer element,
         params.stopReason = EncodeBitstreamParams::OUT_OF_VIEW;
         return bytesWritten;
     }
+    // and the same for one hidden behind an occluder, the children of an element are checked as it is encoded
+    if (!params.recurseEverything && params.occlusion && params.occlusion->isOccluded(element->getAACube())) {
+        if (params.stats) {
+            params.stats->skippedOccluded(element);
+        }
+        params.stopReason = EncodeBitstreamParams::OCCLUDED;
+        return bytesWritten;
+    }
 
     // write the octal code
     bool roomForOctalCode = false; // assume the worst
@@ -972,7 +1028,7 @@ int Octree::encodeTreeBitstream(OctreeElementPointer element,
     return bytesWritten;
 }
 
-int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
+int Octree::encodeTreeBitstreamRecursion(const OctreeElementPointer& element,
                                          OctreePacketData* packetData, OctreeElementBag& bag,
                                          EncodeBitstreamParams& params, int& currentEncodeLevel,
                                          const ViewFrustum::intersection& parentLocationThisView) const {
@@ -1059,6 +1115,10 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
             } else {
                 wasInView = location == ViewFrustum::INSIDE;
             }
+            // what was hidden from the last view wasn't sent for it
+            if (wasInView && params.lastOcclusion && params.lastOcclusion->isOccluded(element->getAACube())) {
+                wasInView = false;
+            }
 
             // If we were in view, double check that we didn't switch LOD visibility... namely, the was in view doesn't
             // tell us if it was so small we wouldn't have rendered it. Which may be the case. And we may have moved closer
@@ -1135,13 +1195,12 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
     int inViewNotLeafCount = 0;
     int inViewWithColorCount = 0;
 
-    OctreeElementPointer sortedChildren[NUMBER_OF_CHILDREN] = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
     float distancesToChildren[NUMBER_OF_CHILDREN] = { 0, 0, 0, 0, 0, 0, 0, 0 };
     int indexOfChildren[NUMBER_OF_CHILDREN] = { 0, 0, 0, 0, 0, 0, 0, 0 };
     int currentCount = 0;
 
     for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        OctreeElementPointer childElement = element->getChildAtIndex(i);
+        const OctreeElementPointer& childElement = element->getChildAtIndex(i);
 
         // if the caller wants to include childExistsBits, then include them even if not in view, if however,
         // we're in a portion of the tree that's not our responsibility, then we assume the child nodes exist
@@ -1157,7 +1216,6 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
             }
         }
 
-        sortedChildren[i] = childElement;
         indexOfChildren[i] = i;
         distancesToChildren[i] = 0.0f;
         currentCount++;
@@ -1169,24 +1227,50 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
         }
     }
 
+    // when this element straddles the view, its children are tested against the view all at once
+    ViewFrustum::intersection childLocations[NUMBER_OF_CHILDREN];
+    if (!params.recurseEverything && nodeLocationThisView == ViewFrustum::INTERSECT) {
+        float cornerX[NUMBER_OF_CHILDREN], cornerY[NUMBER_OF_CHILDREN], cornerZ[NUMBER_OF_CHILDREN];
+        float scale[NUMBER_OF_CHILDREN];
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            // a missing child stands in with the cube of this element, its result is never read
+            const OctreeElementPointer& childElement = element->getChildAtIndex(i);
+            const AACube& cube = childElement ? childElement->getAACube() : element->getAACube();
+            cornerX[i] = cube.getCorner().x;
+            cornerY[i] = cube.getCorner().y;
+            cornerZ[i] = cube.getCorner().z;
+            scale[i] = cube.getScale();
+        }
+        params.viewFrustum.calculateCubesKeyholeIntersection(NUMBER_OF_CHILDREN, cornerX, cornerY, cornerZ, scale,
+            childLocations);
+    }
+
     // for each child element in Distance sorted order..., check to see if they exist, are colored, and in view, and if so
     // add them to our distance ordered array of children
     for (int i = 0; i < currentCount; i++) {
-        OctreeElementPointer childElement = sortedChildren[i];
         int originalIndex = indexOfChildren[i];
+        const OctreeElementPointer& childElement = element->getChildAtIndex(originalIndex);
 
         bool childIsInView  = (childElement &&
                 (params.recurseEverything ||
                  (nodeLocationThisView == ViewFrustum::INSIDE) || // parent was fully in view, we can assume ALL children are
                   (nodeLocationThisView == ViewFrustum::INTERSECT &&
-                        childElement->isInView(params.viewFrustum)) // the parent intersects and the child is in view
+                        childLocations[originalIndex] != ViewFrustum::OUTSIDE) // the parent intersects, the child is in view
                 ));
 
+        // a child in view can still be hidden behind an occluder, then it and everything under it is left out
+        bool childIsOccluded = childIsInView && !params.recurseEverything && params.occlusion &&
+            params.occlusion->isOccluded(childElement->getAACube());
+
         if (!childIsInView) {
             // must check childElement here, because it could be we got here because there was no childElement
             if (params.stats && childElement) {
                 params.stats->skippedOutOfView(childElement);
             }
+        } else if (childIsOccluded) {
+            if (params.stats) {
+                params.stats->skippedOccluded(childElement);
+            }
         } else {
             // Before we consider this further, let's see if it's in our LOD scope...
             float boundaryDistance = params.recurseEverything ? 1 :
@@ -1209,8 +1293,6 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
                     inViewNotLeafCount++;
                 }
 
-                bool childIsOccluded = false; // assume it's not occluded
-
                 bool shouldRender = params.recurseEverything ||
                         childElement->calculateShouldRender(params.viewFrustum,
                                 params.octreeElementSizeScale, params.boundaryLevelAdjust);
@@ -1221,14 +1303,10 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
                     if (!shouldRender && childElement->isLeaf()) {
                         params.stats->skippedDistance(childElement);
                     }
-                    // don't need to check childElement here, because we can't get here with no childElement
-                    if (childIsOccluded) {
-                        params.stats->skippedOccluded(childElement);
-                    }
                 }
 
                 // track children with actual color, only if the child wasn't previously in view!
-                if (shouldRender && !childIsOccluded) {
+                if (shouldRender) {
                     bool childWasInView = false;
 
                     if (childElement && params.deltaView) {
@@ -1240,6 +1318,10 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
                         } else {
                             childWasInView = location == ViewFrustum::INSIDE;
                         }
+                        if (childWasInView && params.lastOcclusion &&
+                                params.lastOcclusion->isOccluded(childElement->getAACube())) {
+                            childWasInView = false;
+                        }
                     }
 
                     // If our child wasn't in view (or we're ignoring wasInView) then we add it to our sending items.
@@ -1296,7 +1378,7 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
     // This section of the code, is writing the "N x [child data]" portion of this bitstream
     for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
         if (oneAtBit(childrenDataBits, i)) {
-            OctreeElementPointer childElement = element->getChildAtIndex(i);
+            const OctreeElementPointer& childElement = element->getChildAtIndex(i);
 
             // the childrenDataBits were set up by the in view/LOD logic, it may contain children that we've already
             // processed and sent the data bits for. Let our tree subclass determine if it really wants to send the
@@ -1437,8 +1519,8 @@ int Octree::encodeTreeBitstreamRecursion(OctreeElementPointer element,
         // for each child element in Distance sorted order..., check to see if they exist, are colored, and in view, and if so
         // add them to our distance ordered array of children
         for (int indexByDistance = 0; indexByDistance < currentCount; indexByDistance++) {
-            OctreeElementPointer childElement = sortedChildren[indexByDistance];
             int originalIndex = indexOfChildren[indexByDistance];
+            const OctreeElementPointer& childElement = element->getChildAtIndex(originalIndex);
 
             if (oneAtBit(childrenExistInPacketBits, originalIndex)) {
 
@@ -1657,16 +1739,52 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
         qCritical() << "Cannot open gzipped json file for reading: " << qFileName;
         return false;
     }
-    QByteArray compressedJsonData = file.readAll();
-    QByteArray jsonData;
+    GzipDevice jsonDevice(&file);
+    if (!jsonDevice.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot read gzipped json file: " << qFileName;
+        return false;
+    }
+
+    QDataStream jsonStream(&jsonDevice);
+    if (!readJSONFromStream(-1, jsonStream) || jsonDevice.hasError()) {
+        qCritical() << "json File not in gzip format: " << qFileName << jsonDevice.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool Octree::readMapFromFile(const char* fileName, QVariantMap& entityDescription) {
+    QString qFileName = findMostRecentFileExtension(fileName, PERSIST_EXTENSIONS);
 
-    if (!gunzip(compressedJsonData, jsonData)) {
-        qCritical() << "json File not in gzip format: " << qFileName;
+    QFile file(qFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
         return false;
     }
+    QByteArray jsonData;
 
-    QDataStream jsonStream(jsonData);
-    return readJSONFromStream(-1, jsonStream);
+    if (qFileName.endsWith(".json.gz")) {
+        GzipDevice jsonDevice(&file);
+        if (jsonDevice.open(QIODevice::ReadOnly)) {
+            jsonData = jsonDevice.readAll();
+        }
+        if (!jsonDevice.isOpen() || jsonDevice.hasError()) {
+            qCritical() << "json File not in gzip format: " << qFileName;
+            return false;
+        }
+    } else {
+        jsonData = file.readAll();
+        if (!jsonData.isEmpty() && jsonData[0] == (char) PacketType::EntityData) {
+            // binary SVO, which only reads straight into the tree
+            return false;
+        }
+    }
+
+    QJsonDocument asDocument = QJsonDocument::fromJson(jsonData);
+    if (!asDocument.isObject()) {
+        return false;
+    }
+    entityDescription = asDocument.toVariant().toMap();
+    return true;
 }
 
 bool Octree::readFromURL(const QString& urlString) {
@@ -1860,14 +1978,18 @@ bool Octree::readJSONFromStream(unsigned long streamLength, QDataStream& inputSt
         jsonBuffer += QByteArray(rawData, got);
     }
 
-    QJsonDocument asDocument = QJsonDocument::fromJson(jsonBuffer);
-    QVariant asVariant = asDocument.toVariant();
-    QVariantMap asMap = asVariant.toMap();
-    bool success = readFromMap(asMap);
+    bool success = readFromJSON(jsonBuffer);
     delete[] rawData;
     return success;
 }
 
+bool Octree::readFromJSON(const QByteArray& jsonData) {
+    QJsonDocument asDocument = QJsonDocument::fromJson(jsonData);
+    QVariant asVariant = asDocument.toVariant();
+    QVariantMap asMap = asVariant.toMap();
+    return readFromMap(asMap);
+}
+
 bool Octree::writeToFile(const char* fileName, OctreeElementPointer element, QString persistAsFileType) {
     // make the sure file extension makes sense
     QString qFileName = fileNameWithoutExtension(QString(fileName), PERSIST_EXTENSIONS) + "." + persistAsFileType;
@@ -1887,52 +2009,61 @@ bool Octree::writeToFile(const char* fileName, OctreeElementPointer element, QSt
     return success;
 }
 
-bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element, bool doGzip) {
+bool Octree::writeToJSON(QByteArray& jsonData, OctreeElementPointer element, bool skipDefaultValues,
+                         bool skipThoseWithBadParents) {
     QVariantMap entityDescription;
 
-    qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
-
-    OctreeElementPointer top;
-    if (element) {
-        top = element;
-    } else {
-        top = _rootElement;
-    }
-
     // include the "bitstream" version
     PacketType expectedType = expectedDataPacketType();
     PacketVersion expectedVersion = versionForPacketType(expectedType);
     entityDescription["Version"] = (int) expectedVersion;
 
     // store the entity data
-    bool entityDescriptionSuccess = writeToMap(entityDescription, top, true, true);
-    if (!entityDescriptionSuccess) {
-        qCritical("Failed to convert Entities to QVariantMap while saving to json.");
+    if (!writeToMap(entityDescription, element, skipDefaultValues, skipThoseWithBadParents)) {
         return false;
     }
 
     // convert the QVariantMap to JSON
-    QByteArray jsonData = QJsonDocument::fromVariant(entityDescription).toJson();
-    QByteArray jsonDataForFile;
+    jsonData = QJsonDocument::fromVariant(entityDescription).toJson();
+    return true;
+}
 
-    if (doGzip) {
-        if (!gzip(jsonData, jsonDataForFile, -1)) {
-            qCritical("unable to gzip data while saving to json.");
-            return false;
-        }
+bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element, bool doGzip) {
+    qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
+
+    OctreeElementPointer top;
+    if (element) {
+        top = element;
     } else {
-        jsonDataForFile = jsonData;
+        top = _rootElement;
+    }
+
+    QByteArray jsonData;
+    if (!writeToJSON(jsonData, top, true, true)) {
+        qCritical("Failed to convert Entities to JSON while saving to json.");
+        return false;
     }
 
     QFile persistFile(fileName);
-    bool success = false;
-    if (persistFile.open(QIODevice::WriteOnly)) {
-        success = persistFile.write(jsonDataForFile) != -1;
-    } else {
+    if (!persistFile.open(QIODevice::WriteOnly)) {
         qCritical("Could not write to JSON description of entities.");
+        return false;
     }
 
-    return success;
+    if (!doGzip) {
+        return persistFile.write(jsonData) != -1;
+    }
+
+    // compress straight into the file, on as many threads as there are cores, so that the compressed copy is never
+    // all in memory next to the JSON
+    GzipDevice gzipDevice(&persistFile, -1, QThread::idealThreadCount());
+    bool success = gzipDevice.open(QIODevice::WriteOnly) && gzipDevice.write(jsonData) != -1;
+    gzipDevice.close();
+    if (!success || gzipDevice.hasError()) {
+        qCritical("unable to gzip data while saving to json.");
+        return false;
+    }
+    return true;
 }
 
 bool Octree::writeToSVOFile(const char* fileName, OctreeElementPointer element) {
@@ -2030,7 +2161,7 @@ unsigned long Octree::getOctreeElementsCount() {
     return nodeCount;
 }
 
-bool Octree::countOctreeElementsOperation(OctreeElementPointer element, void* extraData) {
+bool Octree::countOctreeElementsOperation(const OctreeElementPointer& element, void* extraData) {
     (*(unsigned long*)extraData)++;
     return true; // keep going
 }
@@ -12,7 +12,9 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <set>
 
 #include <QHash>
@@ -23,6 +25,7 @@
 #include <ViewFrustum.h>
 
 #include "JurisdictionMap.h"
+#include "OcclusionBuffer.h"
 #include "OctreeElement.h"
 #include "OctreeElementBag.h"
 #include "OctreePacketData.h"
@@ -40,13 +43,13 @@ extern QVector<QString> PERSIST_EXTENSIONS;
 /// derive from this class to use the Octree::recurseTreeWithOperator() method
 class RecurseOctreeOperator {
 public:
-    virtual bool preRecursion(OctreeElementPointer element) = 0;
-    virtual bool postRecursion(OctreeElementPointer element) = 0;
-    virtual OctreeElementPointer possiblyCreateChildAt(OctreeElementPointer element, int childIndex) { return NULL; }
+    virtual bool preRecursion(const OctreeElementPointer& element) = 0;
+    virtual bool postRecursion(const OctreeElementPointer& element) = 0;
+    virtual OctreeElementPointer possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) { return NULL; }
 };
 
 // Callback function, for recuseTreeWithOperation
-typedef bool (*RecurseOctreeOperation)(OctreeElementPointer element, void* extraData);
+typedef bool (*RecurseOctreeOperation)(const OctreeElementPointer& element, void* extraData);
 typedef enum {GRADIENT, RANDOM, NATURAL} creationMode;
 typedef QHash<uint, AACube> CubeList;
 
@@ -59,6 +62,7 @@ const int DONT_CHOP              = 0;
 const int NO_BOUNDARY_ADJUST     = 0;
 const int LOW_RES_MOVING_ADJUST  = 1;
 const quint64 IGNORE_LAST_SENT  = 0;
+const int MAX_TRACKED_CHANGED_ELEMENTS = 1000;
 
 #define IGNORE_SCENE_STATS       NULL
 #define IGNORE_COVERAGE_MAP      NULL
@@ -82,6 +86,15 @@ public:
     JurisdictionMap* jurisdictionMap;
     OctreeElementExtraEncodeData* extraEncodeData;
 
+    // the properties of the data the viewer asked to do without, as encoded by the tree's own property flags
+    QByteArray excludedProperties;
+    // data further than this from the viewer goes without its heavy properties, until the viewer gets closer
+    float heavyPropertiesDistance { NO_HEAVY_PROPERTIES_DISTANCE };
+    // what the viewer can't see in this view, and couldn't in the last one, elements wholly behind occluders are
+    // left out like those outside of the view
+    OcclusionBufferPointer occlusion;
+    OcclusionBufferPointer lastOcclusion;
+
     // output hints from the encode process
     typedef enum {
         UNKNOWN,
@@ -216,8 +229,10 @@ public:
                     return thisVersion == versionForPacketType(expectedDataPacketType()); }
     virtual PacketVersion expectedVersion() const { return versionForPacketType(expectedDataPacketType()); }
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
+    // called without the tree's lock, implementations take the write lock only for the part of the edit that needs it
+    // and add the time spent waiting for it to lockWaitUsecs
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
-                                      const SharedNodePointer& sourceNode) { return 0; }
+                                      const SharedNodePointer& sourceNode, quint64& lockWaitUsecs) { return 0; }
                     
     virtual bool recurseChildrenWithData() const { return true; }
     virtual bool rootElementHasData() const { return false; }
@@ -225,6 +240,10 @@ public:
     virtual bool suppressEmptySubtrees() const { return true; }
     virtual void releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncodeData) const { }
     virtual bool mustIncludeAllChildData() const { return true; }
+
+    /// the bounds of the solid, opaque and still data of the tree that is big enough to hide what is behind it from a
+    /// viewer, for the server to build an OcclusionBuffer from. The tree must be read locked.
+    virtual void getOccluders(std::vector<AABox>& occluders) const { }
     
     /// some versions of the SVO file will include breaks with buffer lengths between each buffer chunk in the SVO
     /// file. If the Octree subclass expects this for this particular version of the file, it should override this
@@ -305,6 +324,11 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
 
+    // The JSON of a save or an export, with the "bitstream" version. The default goes through writeToMap and a
+    // QJsonDocument, a tree can write its elements straight to JSON instead.
+    virtual bool writeToJSON(QByteArray& jsonData, OctreeElementPointer element, bool skipDefaultValues,
+                             bool skipThoseWithBadParents);
+
     // Octree importers
     bool readFromFile(const char* filename);
     bool readFromURL(const QString& url); // will support file urls as well...
@@ -312,24 +336,39 @@ public:
     bool readSVOFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromGzippedFile(QString qFileName);
+    bool readMapFromFile(const char* filename, QVariantMap& entityDescription); // JSON files only, does not touch the tree
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    // As readFromMap, from the JSON of a save or an export
+    virtual bool readFromJSON(const QByteArray& jsonData);
+
+    // Journaling, for trees that can describe what changed since a point in time, lets a persist append only the
+    // changes rather than rewrite every element. writeChangesToMap gives what changed after sinceTime, and deletes
+    // since the previous call, it returns false for a tree that can't journal. mergeChangesIntoMap folds a list of
+    // those changes, oldest first, into a map read from a full save.
+    virtual bool writeChangesToMap(QVariantMap& changes, quint64 sinceTime) { return false; }
+    virtual void mergeChangesIntoMap(QVariantMap& entityDescription, const QVariantList& changesList) const { }
+
+    // A compact binary save of the whole tree that a tree may offer, for a persist to load much faster than JSON.
+    // readFromBinaryFile applies a list of changes from writeChangesToMap over what it reads.
+    virtual bool writeToBinaryFile(const char* fileName) { return false; }
+    virtual bool readFromBinaryFile(const char* fileName, const QVariantList& changesList) { return false; }
 
     unsigned long getOctreeElementsCount();
 
     bool getShouldReaverage() const { return _shouldReaverage; }
 
-    void recurseElementWithOperation(OctreeElementPointer element, RecurseOctreeOperation operation,
+    void recurseElementWithOperation(const OctreeElementPointer& element, RecurseOctreeOperation operation,
                 void* extraData, int recursionCount = 0);
 
     /// Traverse child nodes of node applying operation in post-fix order
     ///
-    void recurseElementWithPostOperation(OctreeElementPointer element, RecurseOctreeOperation operation,
+    void recurseElementWithPostOperation(const OctreeElementPointer& element, RecurseOctreeOperation operation,
                 void* extraData, int recursionCount = 0);
 
-    void recurseElementWithOperationDistanceSorted(OctreeElementPointer element, RecurseOctreeOperation operation,
+    void recurseElementWithOperationDistanceSorted(const OctreeElementPointer& element, RecurseOctreeOperation operation,
                 const glm::vec3& point, void* extraData, int recursionCount = 0);
 
-    bool recurseElementWithOperator(OctreeElementPointer element, RecurseOctreeOperator* operatorObject, int recursionCount = 0);
+    bool recurseElementWithOperator(const OctreeElementPointer& element, RecurseOctreeOperator* operatorObject, int recursionCount = 0);
 
     bool getIsViewing() const { return _isViewing; } /// This tree is receiving inbound viewer datagrams.
     void setIsViewing(bool isViewing) { _isViewing = isViewing; }
@@ -340,6 +379,17 @@ public:
     bool getIsClient() const { return !_isServer; } /// Is this a client based tree. Allows guards for certain operations
     void setIsClient(bool isClient) { _isServer = !isClient; }
 
+    /// Server only, edits log the element each changed entity ended up in, so a viewer that has been sent its view can
+    /// send just those elements instead of walking the whole tree for changes. The log keeps the most recent
+    /// MAX_TRACKED_CHANGED_ELEMENTS, and a sequence number counts every element ever logged.
+    void trackChangedElement(const OctreeElementPointer& element);
+    quint64 getLastChangedElementSequence() const;
+
+    /// Appends the elements logged after sinceSequence that still exist to changedElements, and sets latestSequence.
+    /// Returns false if more than maxElements were logged since, or the log no longer reaches back to sinceSequence.
+    bool getChangedElementsSince(quint64 sinceSequence, int maxElements,
+                                 QVector<OctreeElementPointer>& changedElements, quint64& latestSequence) const;
+
     virtual void dumpTree() { }
     virtual void pruneTree() { }
 
@@ -361,12 +411,12 @@ public slots:
 protected:
     void deleteOctalCodeFromTreeRecursion(OctreeElementPointer element, void* extraData);
 
-    int encodeTreeBitstreamRecursion(OctreeElementPointer element,
+    int encodeTreeBitstreamRecursion(const OctreeElementPointer& element,
                                      OctreePacketData* packetData, OctreeElementBag& bag,
                                      EncodeBitstreamParams& params, int& currentEncodeLevel,
                                      const ViewFrustum::intersection& parentLocationThisView) const;
 
-    static bool countOctreeElementsOperation(OctreeElementPointer element, void* extraData);
+    static bool countOctreeElementsOperation(const OctreeElementPointer& element, void* extraData);
 
     OctreeElementPointer nodeForOctalCode(OctreeElementPointer ancestorElement, const unsigned char* needleCode, OctreeElementPointer* parentOfFoundElement) const;
     OctreeElementPointer createMissingElement(OctreeElementPointer lastParentElement, const unsigned char* codeToReach, int recursionCount = 0);
@@ -381,6 +431,11 @@ protected:
 
     bool _isViewing;
     bool _isServer;
+
+    // operators can run without the tree lock (see EntityTree::fixupMissingParents) so the log has a lock of its own
+    mutable std::mutex _changedElementsMutex;
+    std::deque<OctreeElementWeakPointer> _changedElements;
+    quint64 _lastChangedElementSequence { 0 };
 };
 
 #endif // hifi_Octree_h
@@ -47,4 +47,8 @@ const float SMALLEST_REASONABLE_OCTREE_ELEMENT_SCALE = SCALE_AT_UNREASONABLY_DEE
 
 const int DEFAULT_MAX_OCTREE_PPS = 600; // the default maximum PPS we think any octree based server should send to a client
 
+// the distance past which a viewer can ask for the data without its heavy properties (scripts, user data, textures)
+const float NO_HEAVY_PROPERTIES_DISTANCE = 0.0f; // always sends them
+const float DEFAULT_HEAVY_PROPERTIES_DISTANCE = 50.0f; // meters
+
 #endif // hifi_OctreeConstants_h
@@ -66,28 +66,10 @@ void OctreeElement::init(unsigned char * octalCode) {
         delete[] octalCode;
     }
 
-    // set up the _children union
+    // all nodes start with no children
     _childBitmask = 0;
-    _childrenExternal = false;
-
-
     _childrenCount[0]++;
 
-    // default pointers to child nodes to NULL
-#ifdef SIMPLE_CHILD_ARRAY
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        _simpleChildArray[i] = NULL;
-    }
-#endif
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-    _childrenSingle.reset();
-#endif
-
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-        _externalChildren[i].reset();
-    }
-
     _isDirty = true;
     _shouldRender = false;
     _sourceUUIDKey = 0;
@@ -248,56 +230,13 @@ AtomicUIntStat OctreeElement::_setChildAtIndexCalls { 0 };
 AtomicUIntStat OctreeElement::_externalChildrenCount { 0 };
 AtomicUIntStat OctreeElement::_childrenCount[NUMBER_OF_CHILDREN + 1];
 
-OctreeElementPointer OctreeElement::getChildAtIndex(int childIndex) const {
-#ifdef SIMPLE_CHILD_ARRAY
-    return _simpleChildArray[childIndex];
-#endif // SIMPLE_CHILD_ARRAY
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-    int childCount = getChildCount();
-
-    switch (childCount) {
-        case 0: {
-            return NULL;
-        } break;
-
-        case 1: {
-            // if our single child is the one being requested, return it, otherwise
-            // return null
-            int firstIndex = getNthBit(_childBitmask, 1);
-            if (firstIndex == childIndex) {
-                return _childrenSingle;
-            } else {
-                return NULL;
-            }
-        } break;
-
-        default : {
-            return _externalChildren[childIndex];
-        } break;
-    }
-#endif // def SIMPLE_EXTERNAL_CHILDREN
-}
-
 void OctreeElement::deleteAllChildren() {
-    // first delete all the OctreeElement objects...
     for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        OctreeElementPointer childAt = getChildAtIndex(i);
-        if (childAt) {
-            childAt.reset();
-        }
-    }
-
-    if (_childrenExternal) {
-        // if the children_t union represents _children.external we need to delete it here
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
+        _children[i].reset();
     }
 }
 
 void OctreeElement::setChildAtIndex(int childIndex, OctreeElementPointer child) {
-#ifdef SIMPLE_CHILD_ARRAY
     int previousChildCount = getChildCount();
     if (child) {
         setAtBit(_childBitmask, childIndex);
@@ -307,71 +246,13 @@ void OctreeElement::setChildAtIndex(int childIndex, OctreeElementPointer child)
     int newChildCount = getChildCount();
 
     // store the child in our child array
-    _simpleChildArray[childIndex] = child;
+    _children[childIndex] = std::move(child);
 
     // track our population data
     if (previousChildCount != newChildCount) {
         _childrenCount[previousChildCount]--;
         _childrenCount[newChildCount]++;
     }
-#endif
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-
-    int firstIndex = getNthBit(_childBitmask, 1);
-    int secondIndex = getNthBit(_childBitmask, 2);
-
-    int previousChildCount = getChildCount();
-    if (child) {
-        setAtBit(_childBitmask, childIndex);
-    } else {
-        clearAtBit(_childBitmask, childIndex);
-    }
-    int newChildCount = getChildCount();
-
-    // track our population data
-    if (previousChildCount != newChildCount) {
-        _childrenCount[previousChildCount]--;
-        _childrenCount[newChildCount]++;
-    }
-
-    if ((previousChildCount == 0 || previousChildCount == 1) && newChildCount == 0) {
-        _childrenSingle.reset();
-    } else if (previousChildCount == 0 && newChildCount == 1) {
-        _childrenSingle = child;
-    } else if (previousChildCount == 1 && newChildCount == 2) {
-        OctreeElementPointer previousChild = _childrenSingle;
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
-        _externalChildren[firstIndex] = previousChild;
-        _externalChildren[childIndex] = child;
-
-        _childrenExternal = true;
-
-        _externalChildrenMemoryUsage += NUMBER_OF_CHILDREN * sizeof(OctreeElementPointer);
-
-    } else if (previousChildCount == 2 && newChildCount == 1) {
-        assert(!child); // we are removing a child, so this must be true!
-        OctreeElementPointer previousFirstChild = _externalChildren[firstIndex];
-        OctreeElementPointer previousSecondChild = _externalChildren[secondIndex];
-
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
-        _childrenExternal = false;
-
-        _externalChildrenMemoryUsage -= NUMBER_OF_CHILDREN * sizeof(OctreeElementPointer);
-        if (childIndex == firstIndex) {
-            _childrenSingle = previousSecondChild;
-        } else {
-            _childrenSingle = previousFirstChild;
-        }
-    } else {
-        _externalChildren[childIndex] = child;
-    }
-
-#endif // def SIMPLE_EXTERNAL_CHILDREN
 }
 
 
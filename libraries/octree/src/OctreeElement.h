@@ -12,9 +12,6 @@
 #ifndef hifi_OctreeElement_h
 #define hifi_OctreeElement_h
 
-//#define SIMPLE_CHILD_ARRAY
-#define SIMPLE_EXTERNAL_CHILDREN
-
 #include <atomic>
 
 #include <QReadWriteLock>
@@ -119,7 +116,7 @@ public:
 
     // Base class methods you don't need to implement
     const unsigned char* getOctalCode() const { return (_octcodePointer) ? _octalCode.pointer : &_octalCode.buffer[0]; }
-    OctreeElementPointer getChildAtIndex(int childIndex) const;
+    const OctreeElementPointer& getChildAtIndex(int childIndex) const { return _children[childIndex]; }
     void deleteChildAtIndex(int childIndex);
     OctreeElementPointer removeChildAtIndex(int childIndex);
     bool isParentOf(OctreeElementPointer possibleChild) const;
@@ -236,17 +233,8 @@ protected:
 
     quint64 _lastChanged; /// Client and server, timestamp this node was last changed, 8 bytes
 
-    /// Client and server, pointers to child nodes, various encodings
-#ifdef SIMPLE_CHILD_ARRAY
-    OctreeElementPointer _simpleChildArray[8]; /// Only used when SIMPLE_CHILD_ARRAY is enabled
-#endif
-
-#ifdef SIMPLE_EXTERNAL_CHILDREN
-    // union children_t {
-    OctreeElementPointer _childrenSingle;
-    OctreeElementPointer _externalChildren[NUMBER_OF_CHILDREN];
-    // } _children;
-#endif
+    /// Client and server, pointers to child nodes indexed by octant, null where _childBitmask has no bit set, 128 bytes
+    OctreeElementPointer _children[NUMBER_OF_CHILDREN];
 
     uint16_t _sourceUUIDKey; /// Client only, stores node id of voxel server that sent his voxel, 2 bytes
 
@@ -263,8 +251,7 @@ protected:
          _isDirty : 1, /// Client only, has this voxel changed since being rendered, 1 bit
          _shouldRender : 1, /// Client only, should this voxel render at this time, 1 bit
          _octcodePointer : 1, /// Client and Server only, is this voxel's octal code a pointer or buffer, 1 bit
-         _unknownBufferIndex : 1,
-         _childrenExternal : 1; /// Client only, is this voxel's VBO buffer the unknown buffer index, 1 bit
+         _unknownBufferIndex : 1; /// Client only, is this voxel's VBO buffer the unknown buffer index, 1 bit
 
     static AtomicUIntStat _voxelNodeCount;
     static AtomicUIntStat _voxelNodeLeafCount;
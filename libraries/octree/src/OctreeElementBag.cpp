@@ -10,31 +10,52 @@
 //
 
 #include "OctreeElementBag.h"
+
+#include <algorithm>
+
 #include <OctalCode.h>
 
 void OctreeElementBag::deleteAll() {
-    _bagElements = Bag();
+    _heap = std::vector<Entry>();
+    _keys = std::unordered_set<OctreeElement*>();
 }
 
 /// does the bag contain elements?
 /// if all of the contained elements are expired, they will not report as empty, and
 /// a single last item will be returned by extract as a null pointer
 bool OctreeElementBag::isEmpty() {
-    return _bagElements.empty();
+    return _heap.empty();
 }
 
 void OctreeElementBag::insert(OctreeElementPointer element) {
-    _bagElements[element.get()] = element;
+    if (!_keys.insert(element.get()).second) {
+        return;
+    }
+    float priority = _priorityFunction ? _priorityFunction(*element) : 0.0f;
+    _heap.push_back({ priority, element.get(), element });
+    std::push_heap(_heap.begin(), _heap.end());
 }
 
 OctreeElementPointer OctreeElementBag::extract() {
     OctreeElementPointer result;
 
     // Find the first element still alive
-    Bag::iterator it = _bagElements.begin();
-    while (it != _bagElements.end() && !result) {
-        result = it->second.lock();
-        it = _bagElements.erase(it);
+    while (!_heap.empty() && !result) {
+        std::pop_heap(_heap.begin(), _heap.end());
+        result = _heap.back().element.lock();
+        _keys.erase(_heap.back().key);
+        _heap.pop_back();
     }
     return result;
 }
+
+void OctreeElementBag::setPriorityFunction(PriorityFunction priorityFunction) {
+    _priorityFunction = priorityFunction;
+    for (auto& entry : _heap) {
+        auto element = entry.element.lock();
+        if (element) {
+            entry.priority = _priorityFunction ? _priorityFunction(*element) : 0.0f;
+        }
+    }
+    std::make_heap(_heap.begin(), _heap.end());
+}
@@ -7,7 +7,8 @@
 //
 //  This class is used by the Octree:encodeTreeBitstream() functions to store elements and element data that need to be sent.
 //  It's a generic bag style storage mechanism. But It has the property that you can't put the same element into the bag
-//  more than once (in other words, it de-dupes automatically).
+//  more than once (in other words, it de-dupes automatically). With a priority function, the elements of highest
+//  priority come out first.
 //
 //  Distributed under the Apache License, Version 2.0.
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
@@ -16,28 +17,45 @@
 #ifndef hifi_OctreeElementBag_h
 #define hifi_OctreeElementBag_h
 
-#include <unordered_map>
+#include <functional>
+#include <unordered_set>
+#include <vector>
 
 #include "OctreeElement.h"
 
 class OctreeElementBag {
-    using Bag = std::unordered_map<OctreeElement*, OctreeElementWeakPointer>;
-    
 public:
+    using PriorityFunction = std::function<float(const OctreeElement& element)>;
+
     void insert(OctreeElementPointer element); // put a element into the bag
 
-    OctreeElementPointer extract(); /// pull a element out of the bag (could come in any order) and if all of the
-                                    /// elements have expired, a single null pointer will be returned
+    OctreeElementPointer extract(); /// pull the element of highest priority out of the bag (any of them without a
+                                    /// priority function) and if all of the elements have expired, a single null
+                                    /// pointer will be returned
+
+    /// sets how the elements are ordered, the elements already in the bag are ordered again
+    void setPriorityFunction(PriorityFunction priorityFunction);
 
     bool isEmpty(); /// does the bag contain elements, 
                     /// if all of the contained elements are expired, they will not report as empty, and
                     /// a single last item will be returned by extract as a null pointer
     
     void deleteAll();
-    size_t size() const { return _bagElements.size(); }
+    size_t size() const { return _heap.size(); }
 
 private:
-    Bag _bagElements;
+    struct Entry {
+        float priority;
+        OctreeElement* key;
+        OctreeElementWeakPointer element;
+
+        bool operator<(const Entry& other) const { return priority < other.priority; }
+    };
+
+    // a max heap of the elements by priority, and the elements in it to keep them from going in twice
+    std::vector<Entry> _heap;
+    std::unordered_set<OctreeElement*> _keys;
+    PriorityFunction _priorityFunction;
 };
 
 using OctreeElementExtraEncodeData = QMap<const OctreeElement*, void*>;
@@ -22,6 +22,15 @@ void OctreeHeadlessViewer::init() {
     OctreeRenderer::init();
 }
 
+void OctreeHeadlessViewer::setRegion(const glm::vec3& center, float radius) {
+    // the frustum can't be empty, so it is left as a sliver in front of the keyhole
+    const float REGION_FAR_CLIP = 2.0f * DEFAULT_NEAR_CLIP;
+    _viewFrustum.setProjection(glm::perspective(glm::radians(DEFAULT_FIELD_OF_VIEW_DEGREES), DEFAULT_ASPECT_RATIO,
+        DEFAULT_NEAR_CLIP, REGION_FAR_CLIP));
+    _viewFrustum.setPosition(center);
+    _viewFrustum.setCenterRadius(radius);
+}
+
 void OctreeHeadlessViewer::queryOctree() {
     char serverType = getMyNodeType();
     PacketType packetType = getMyQueryMessageType();
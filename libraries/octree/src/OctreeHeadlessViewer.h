@@ -49,6 +49,10 @@ public slots:
     void setCenterRadius(float radius) { _viewFrustum.setCenterRadius(radius); }
     void setKeyholeRadius(float radius) { _viewFrustum.setCenterRadius(radius); } // TODO: remove this legacy support
 
+    // limits what is queried to a sphere, for a viewer that only cares about what is around it rather than what it
+    // could see, by shrinking the view down to the keyhole around the position
+    void setRegion(const glm::vec3& center, float radius);
+
     // setters for LOD and PPS
     void setVoxelSizeScale(float sizeScale) { _voxelSizeScale = sizeScale; }
     void setBoundaryLevelAdjust(int boundaryLevelAdjust) { _boundaryLevelAdjust = boundaryLevelAdjust; }
@@ -65,6 +69,12 @@ public slots:
 
     unsigned getOctreeElementsCount() const { return _tree->getOctreeElementsCount(); }
 
+protected:
+    // the properties, as encoded by the tree's own property flags, the servers are asked to leave out
+    void setExcludedProperties(const QByteArray& excludedProperties) {
+        _octreeQuery.setExcludedProperties(excludedProperties);
+    }
+
 private:
     JurisdictionListener* _jurisdictionListener = nullptr;
     OctreeQuery _octreeQuery;
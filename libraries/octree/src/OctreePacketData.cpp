@@ -9,8 +9,11 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QtCore/QtEndian>
+
 #include <GLMHelpers.h>
 #include <PerfStat.h>
+#include <UUID.h>
 
 #include "OctreeLogging.h"
 #include "OctreePacketData.h"
@@ -80,6 +83,17 @@ bool OctreePacketData::append(const unsigned char* data, int length) {
     return success;
 }
 
+unsigned char* OctreePacketData::appendInPlace(int length) {
+    if (length > _bytesAvailable) {
+        return nullptr;
+    }
+    unsigned char* destination = &_uncompressed[_bytesInUse];
+    _bytesInUse += length;
+    _bytesAvailable -= length;
+    _dirty = true;
+    return destination;
+}
+
 bool OctreePacketData::append(unsigned char byte) {
     bool success = false;
     if (_bytesAvailable > 0) {
@@ -399,19 +413,18 @@ bool OctreePacketData::appendValue(const QVector<glm::vec3>& value) {
 }
 
 bool OctreePacketData::appendValue(const QVector<glm::quat>& value) {
+    const int PACKED_QUAT_SIZE = sizeof(uint16_t) * 4;
     uint16_t qVecSize = value.size();
     bool success = appendValue(qVecSize);
 
     if (success) {
-        QByteArray dataByteArray(udt::MAX_PACKET_SIZE, 0);
-        unsigned char* start = reinterpret_cast<unsigned char*>(dataByteArray.data());
-        unsigned char* destinationBuffer = start;
-        for (int index = 0; index < value.size(); index++) {
-            destinationBuffer += packOrientationQuatToBytes(destinationBuffer, value[index]);
-        }
-        int quatsSize = destinationBuffer - start;
-        success = append(start, quatsSize);
+        int quatsSize = qVecSize * PACKED_QUAT_SIZE;
+        unsigned char* destinationBuffer = appendInPlace(quatsSize);
+        success = destinationBuffer != nullptr;
         if (success) {
+            for (int index = 0; index < value.size(); index++) {
+                destinationBuffer += packOrientationQuatToBytes(destinationBuffer, value[index]);
+            }
             _bytesOfValues += quatsSize;
             _totalBytesOfValues += quatsSize;
         }
@@ -438,22 +451,20 @@ bool OctreePacketData::appendValue(const QVector<bool>& value) {
     bool success = appendValue(qVecSize);
 
     if (success) {
-        QByteArray dataByteArray(udt::MAX_PACKET_SIZE, 0);
-        unsigned char* start = reinterpret_cast<unsigned char*>(dataByteArray.data());
-        unsigned char* destinationBuffer = start;
-        int bit = 0;
-        for (int index = 0; index < value.size(); index++) {
-            if (value[index]) {
-                (*destinationBuffer) |= (1 << bit);
-            }
-            if (++bit == BITS_IN_BYTE) {
-                destinationBuffer++;
-                bit = 0;
-            }
-        }
-        int boolsSize = destinationBuffer - start;
-        success = append(start, boolsSize);
+        // only whole bytes of bits are written, the same as always
+        int boolsSize = qVecSize / BITS_IN_BYTE;
+        unsigned char* destinationBuffer = appendInPlace(boolsSize);
+        success = destinationBuffer != nullptr;
         if (success) {
+            for (int byte = 0; byte < boolsSize; byte++) {
+                unsigned char bits = 0;
+                for (int bit = 0; bit < BITS_IN_BYTE; bit++) {
+                    if (value[byte * BITS_IN_BYTE + bit]) {
+                        bits |= (1 << bit);
+                    }
+                }
+                destinationBuffer[byte] = bits;
+            }
             _bytesOfValues += boolsSize;
             _totalBytesOfValues += boolsSize;
         }
@@ -494,14 +505,20 @@ bool OctreePacketData::appendValue(const QString& string) {
 }
 
 bool OctreePacketData::appendValue(const QUuid& uuid) {
-    QByteArray bytes = uuid.toRfc4122();
     if (uuid.isNull()) {
         return appendValue((uint16_t)0); // zero length for null uuid
     } else {
-        uint16_t length = bytes.size();
+        // the same bytes as toRfc4122(), without a QByteArray for them
+        unsigned char bytes[NUM_BYTES_RFC4122_UUID];
+        qToBigEndian(uuid.data1, bytes);
+        qToBigEndian(uuid.data2, bytes + sizeof(uuid.data1));
+        qToBigEndian(uuid.data3, bytes + sizeof(uuid.data1) + sizeof(uuid.data2));
+        memcpy(bytes + sizeof(uuid.data1) + sizeof(uuid.data2) + sizeof(uuid.data3), uuid.data4, sizeof(uuid.data4));
+
+        uint16_t length = NUM_BYTES_RFC4122_UUID;
         bool success = appendValue(length);
         if (success) {
-            success = appendRawData((const unsigned char*)bytes.constData(), bytes.size());
+            success = appendRawData(bytes, length);
         }
         return success;
     }
@@ -653,8 +670,7 @@ int OctreePacketData::unpackDataFromBytes(const unsigned char* dataBytes, QStrin
     uint16_t length;
     memcpy(&length, dataBytes, sizeof(length));
     dataBytes += sizeof(length);
-    QString value((const char*)dataBytes);
-    result = value;
+    result = QString((const char*)dataBytes);
     return sizeof(length) + length;
 }
 
@@ -665,8 +681,7 @@ int OctreePacketData::unpackDataFromBytes(const unsigned char* dataBytes, QUuid&
     if (length == 0) {
         result = QUuid();
     } else {
-        QByteArray ba((const char*)dataBytes, length);
-        result = QUuid::fromRfc4122(ba);
+        result = QUuid::fromRfc4122(QByteArray::fromRawData((const char*)dataBytes, length));
     }
     return sizeof(length) + length;
 }
@@ -735,8 +750,7 @@ int OctreePacketData::unpackDataFromBytes(const unsigned char* dataBytes, QByteA
     uint16_t length;
     memcpy(&length, dataBytes, sizeof(length));
     dataBytes += sizeof(length);
-    QByteArray value((const char*)dataBytes, length);
-    result = value;
+    result = QByteArray((const char*)dataBytes, length);
     return sizeof(length) + length;
 }
 
@@ -275,6 +275,10 @@ private:
     /// append a single byte, might fail if byte would cause packet to be too large
     bool append(unsigned char byte);
 
+    /// makes room for length bytes at the end of the stream and returns where to write them, so values can be packed
+    /// straight into the stream. Returns nullptr without changing the stream if they would not fit.
+    unsigned char* appendInPlace(int length);
+
     unsigned int _targetSize;
     bool _enableCompression;
     
@@ -16,15 +16,20 @@
 #include <fstream>
 #include <time.h>
 
+#include <QBuffer>
+#include <QDataStream>
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QThread>
 
+#include <Gzip.h>
 #include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <PathUtils.h>
@@ -33,6 +38,7 @@
 #include "OctreePersistThread.h"
 
 const int OctreePersistThread::DEFAULT_PERSIST_INTERVAL = 1000 * 30; // every 30 seconds
+const int OctreePersistThread::DEFAULT_SNAPSHOT_INTERVAL = 1000 * 60 * 10; // every 10 minutes
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory, int persistInterval,
                                          bool wantBackup, const QJsonObject& settings, bool debugTimestampNow,
@@ -54,6 +60,8 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+    _journalFilename = _filename + ".journal";
+    _binaryFilename = _filename + ".bin";
 }
 
 QString OctreePersistThread::getPersistFileMimeType() const {
@@ -66,6 +74,14 @@ QString OctreePersistThread::getPersistFileMimeType() const {
 }
 
 void OctreePersistThread::parseSettings(const QJsonObject& settings) {
+    QJsonValue snapshotIntervalVal = settings["snapshotInterval"];
+    if (snapshotIntervalVal.isString()) {
+        _snapshotInterval = snapshotIntervalVal.toString().toInt();
+    } else if (snapshotIntervalVal.isDouble()) {
+        _snapshotInterval = snapshotIntervalVal.toInt();
+    }
+    qCDebug(octree) << "snapshotInterval=" << _snapshotInterval;
+
     if (settings["backups"].isArray()) {
         const QJsonArray& backupRules = settings["backups"].toArray();
         qCDebug(octree) << "BACKUP RULES:";
@@ -155,16 +171,55 @@ bool OctreePersistThread::process() {
                 // that file as our persist file.
                 restoreFromMostRecentBackup();
 
+                // the journal and binary copy followed the save we are no longer loading
+                remove(qPrintable(_journalFilename));
+                remove(qPrintable(_binaryFilename));
+
                 lockFile.close();
                 qCDebug(octree) << "Loading Octree... lock file closed:" << lockFileName;
                 remove(qPrintable(lockFileName));
                 qCDebug(octree) << "Loading Octree... lock file removed:" << lockFileName;
             }
 
-            persistantFileRead = _tree->readFromFile(qPrintable(_filename.toLocal8Bit()));
+            QVariantList journal = readJournal();
+            QVariantMap entityDescription;
+
+            // the binary copy is only good if nothing has replaced the snapshot since they were saved together
+            QFileInfo binaryFileInfo(_binaryFilename);
+            bool useBinaryFile = binaryFileInfo.exists() &&
+                binaryFileInfo.lastModified() >= QFileInfo(_filename).lastModified();
+
+            if (useBinaryFile && _tree->readFromBinaryFile(qPrintable(_binaryFilename.toLocal8Bit()), journal)) {
+                qCDebug(octree) << "Loaded binary copy" << _binaryFilename << "with" << journal.size() << "journal entries";
+                persistantFileRead = true;
+            } else if (!journal.isEmpty() && _tree->readMapFromFile(qPrintable(_filename.toLocal8Bit()), entityDescription)) {
+                qCDebug(octree) << "Replaying" << journal.size() << "journal entries from" << _journalFilename;
+                _tree->mergeChangesIntoMap(entityDescription, journal);
+                persistantFileRead = _tree->readFromMap(entityDescription);
+            } else {
+                if (!journal.isEmpty()) {
+                    qCDebug(octree) << "WARNING: can't replay journal" << _journalFilename << "over" << _filename;
+                }
+                persistantFileRead = _tree->readFromFile(qPrintable(_filename.toLocal8Bit()));
+            }
             _tree->pruneTree();
+
+            // an svo snapshot can't have a journal merged into it when loaded
+            _isJournaling = _persistAsFileType != "svo" && _snapshotInterval > 0;
+            if (_isJournaling) {
+                // this also starts the tree tracking what it deletes, what it returns is already in the tree we loaded
+                _lastJournalTime = usecTimestampNow();
+                QVariantMap changes;
+                _isJournaling = _tree->writeChangesToMap(changes, _lastJournalTime);
+            }
         });
 
+        // the next snapshot is due a snapshot interval after the one we loaded was saved
+        QFileInfo persistFileInfo(_filename);
+        if (persistFileInfo.exists()) {
+            _lastSnapshotTime = persistFileInfo.lastModified().toMSecsSinceEpoch() * USECS_PER_MSEC;
+        }
+
         quint64 loadDone = usecTimestampNow();
         _loadTimeUSecs = loadDone - loadStarted;
 
@@ -244,6 +299,26 @@ void OctreePersistThread::aboutToFinish() {
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+
+    // with a journal the snapshot alone is out of date, so give the snapshot and journal merged
+    QVariantList journal = readJournal();
+    QVariantMap entityDescription;
+    if (!journal.isEmpty() && _tree->readMapFromFile(qPrintable(_filename.toLocal8Bit()), entityDescription)) {
+        _tree->mergeChangesIntoMap(entityDescription, journal);
+        QByteArray jsonData = QJsonDocument::fromVariant(entityDescription).toJson();
+        if (_persistAsFileType == "json.gz") {
+            QBuffer buffer(&fileContents);
+            buffer.open(QIODevice::WriteOnly);
+            GzipDevice gzipDevice(&buffer, -1, QThread::idealThreadCount());
+            if (gzipDevice.open(QIODevice::WriteOnly)) {
+                gzipDevice.write(jsonData);
+            }
+        } else {
+            fileContents = jsonData;
+        }
+        return fileContents;
+    }
+
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -251,36 +326,114 @@ QByteArray OctreePersistThread::getPersistFileContents() const {
     return fileContents;
 }
 
-void OctreePersistThread::persist() {
-    if (_tree->isDirty() && _initialLoadComplete) {
+QVariantList OctreePersistThread::readJournal() const {
+    QVariantList journal;
 
-        _tree->withWriteLock([&] {
-            qCDebug(octree) << "pruning Octree before saving...";
-            _tree->pruneTree();
-            qCDebug(octree) << "DONE pruning Octree before saving...";
-        });
+    QFile journalFile(_journalFilename);
+    if (!journalFile.open(QIODevice::ReadOnly)) {
+        return journal;
+    }
 
-        qCDebug(octree) << "persist operation calling backup...";
-        backup(); // handle backup if requested        
-        qCDebug(octree) << "persist operation DONE with backup...";
+    QDataStream journalStream(&journalFile);
+    while (!journalStream.atEnd()) {
+        QByteArray entry;
+        journalStream >> entry;
 
+        QJsonDocument entryDocument = QJsonDocument::fromBinaryData(entry);
+        if (journalStream.status() != QDataStream::Ok || entryDocument.isNull()) {
+            // the last append didn't complete, everything before it is good
+            qCDebug(octree) << "WARNING: ignoring incomplete entry at the end of journal" << _journalFilename;
+            break;
+        }
+        journal << entryDocument.toVariant();
+    }
+    return journal;
+}
+
+bool OctreePersistThread::appendToJournal() {
+    QVariantMap changes;
+    _tree->withReadLock([&] {
+        quint64 journalTime = usecTimestampNow();
+        if (_tree->writeChangesToMap(changes, _lastJournalTime)) {
+            _lastJournalTime = journalTime;
+        }
+    });
 
-        // create our "lock" file to indicate we're saving.
-        QString lockFileName = _filename + ".lock";
-        std::ofstream lockFile(qPrintable(lockFileName), std::ios::out|std::ios::binary);
-        if(lockFile.is_open()) {
-            qCDebug(octree) << "saving Octree lock file created at:" << lockFileName;
+    QFile journalFile(_journalFilename);
+    if (!journalFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCDebug(octree) << "ERROR opening journal" << _journalFilename;
+        return false;
+    }
 
-            _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
-            time(&_lastPersistTime);
-            _tree->clearDirtyBit(); // tree is clean after saving
-            qCDebug(octree) << "DONE saving Octree to file...";
+    QDataStream journalStream(&journalFile);
+    journalStream << QJsonDocument::fromVariant(changes).toBinaryData();
+    journalFile.flush();
+    bool success = journalStream.status() == QDataStream::Ok;
+    if (success) {
+        _tree->clearDirtyBit(); // the tree is clean once its changes are journaled
+        qCDebug(octree) << "journaled" << changes["Entities"].toList().size() << "changed and"
+            << changes["Deleted"].toList().size() << "deleted entities to" << _journalFilename;
+    } else {
+        qCDebug(octree) << "ERROR appending to journal" << _journalFilename;
+    }
+    return success;
+}
+
+void OctreePersistThread::persist() {
+    if (_tree->isDirty() && _initialLoadComplete) {
+        quint64 now = usecTimestampNow();
 
-            lockFile.close();
-            qCDebug(octree) << "saving Octree lock file closed:" << lockFileName;
-            remove(qPrintable(lockFileName));
-            qCDebug(octree) << "saving Octree lock file removed:" << lockFileName;
+        // a snapshot is due after the snapshot interval, or once the journal has caught up with the snapshot in size
+        if (_isJournaling && now - _lastSnapshotTime < (quint64)_snapshotInterval * USECS_PER_MSEC
+                && QFileInfo(_journalFilename).size() < QFileInfo(_filename).size()) {
+            if (appendToJournal()) {
+                return;
+            }
         }
+
+        persistSnapshot(now);
+    }
+}
+
+void OctreePersistThread::persistSnapshot(quint64 now) {
+    _tree->withWriteLock([&] {
+        qCDebug(octree) << "pruning Octree before saving...";
+        _tree->pruneTree();
+        qCDebug(octree) << "DONE pruning Octree before saving...";
+    });
+
+    qCDebug(octree) << "persist operation calling backup...";
+    backup(); // handle backup if requested        
+    qCDebug(octree) << "persist operation DONE with backup...";
+
+
+    // create our "lock" file to indicate we're saving.
+    QString lockFileName = _filename + ".lock";
+    std::ofstream lockFile(qPrintable(lockFileName), std::ios::out|std::ios::binary);
+    if(lockFile.is_open()) {
+        qCDebug(octree) << "saving Octree lock file created at:" << lockFileName;
+
+        // anything that changes from here on is journaled next time, if it also makes this snapshot that's harmless
+        _lastJournalTime = usecTimestampNow();
+        _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
+        _tree->withReadLock([&] {
+            // written after the JSON so its being newer says they match
+            if (!_tree->writeToBinaryFile(qPrintable(_binaryFilename.toLocal8Bit()))) {
+                remove(qPrintable(_binaryFilename));
+            }
+        });
+        time(&_lastPersistTime);
+        _lastSnapshotTime = now;
+        _tree->clearDirtyBit(); // tree is clean after saving
+        qCDebug(octree) << "DONE saving Octree to file...";
+
+        // the snapshot has everything in the journal, remove it while the lock file still covers us
+        remove(qPrintable(_journalFilename));
+
+        lockFile.close();
+        qCDebug(octree) << "saving Octree lock file closed:" << lockFileName;
+        remove(qPrintable(lockFileName));
+        qCDebug(octree) << "saving Octree lock file removed:" << lockFileName;
     }
 }
 
@@ -32,6 +32,7 @@ public:
     };
 
     static const int DEFAULT_PERSIST_INTERVAL;
+    static const int DEFAULT_SNAPSHOT_INTERVAL;
 
     OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory,
                         int persistInterval = DEFAULT_PERSIST_INTERVAL, bool wantBackup = false,
@@ -54,6 +55,9 @@ protected:
     virtual bool process() override;
 
     void persist();
+    void persistSnapshot(quint64 now);
+    bool appendToJournal();
+    QVariantList readJournal() const;
     void backup();
     void rollOldBackupVersions(const BackupRule& rule);
     void restoreFromMostRecentBackup();
@@ -79,6 +83,15 @@ private:
     quint64 _lastTimeDebug;
 
     QString _persistAsFileType;
+
+    // between full saves (snapshots) changed entities are appended to a journal next to the persist file,
+    // loading folds the journal back into the snapshot
+    QString _journalFilename;
+    QString _binaryFilename; // a binary copy of each snapshot, for the tree to load faster than the JSON
+    int _snapshotInterval { DEFAULT_SNAPSHOT_INTERVAL };
+    bool _isJournaling { false };
+    quint64 _lastSnapshotTime { 0 };
+    quint64 _lastJournalTime { 0 }; // changes after this aren't in the snapshot or journal yet
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <GLMHelpers.h>
 #include <udt/PacketHeaders.h>
 
@@ -66,6 +68,22 @@ int OctreeQuery::getBroadcastData(unsigned char* destinationBuffer) {
 
     memcpy(destinationBuffer, &_cameraCenterRadius, sizeof(_cameraCenterRadius));
     destinationBuffer += sizeof(_cameraCenterRadius);
+
+    // receive stats
+    memcpy(destinationBuffer, &_processedPPS, sizeof(_processedPPS));
+    destinationBuffer += sizeof(_processedPPS);
+    memcpy(destinationBuffer, &_pendingPacketCount, sizeof(_pendingPacketCount));
+    destinationBuffer += sizeof(_pendingPacketCount);
+
+    // property filters
+    memcpy(destinationBuffer, &_heavyPropertiesDistance, sizeof(_heavyPropertiesDistance));
+    destinationBuffer += sizeof(_heavyPropertiesDistance);
+    QByteArray excludedProperties = getExcludedProperties();
+    uint16_t excludedPropertiesSize = (uint16_t)excludedProperties.size();
+    memcpy(destinationBuffer, &excludedPropertiesSize, sizeof(excludedPropertiesSize));
+    destinationBuffer += sizeof(excludedPropertiesSize);
+    memcpy(destinationBuffer, excludedProperties.constData(), excludedPropertiesSize);
+    destinationBuffer += excludedPropertiesSize;
     
     return destinationBuffer - bufferStart;
 }
@@ -112,10 +130,39 @@ int OctreeQuery::parseData(ReceivedMessage& message) {
     if (bytesLeft >= (int)sizeof(_cameraCenterRadius)) {
         memcpy(&_cameraCenterRadius, sourceBuffer, sizeof(_cameraCenterRadius));
         sourceBuffer += sizeof(_cameraCenterRadius);
+        bytesLeft -= sizeof(_cameraCenterRadius);
+    }
+    if (bytesLeft >= (int)(sizeof(_processedPPS) + sizeof(_pendingPacketCount))) {
+        memcpy(&_processedPPS, sourceBuffer, sizeof(_processedPPS));
+        sourceBuffer += sizeof(_processedPPS);
+        memcpy(&_pendingPacketCount, sourceBuffer, sizeof(_pendingPacketCount));
+        sourceBuffer += sizeof(_pendingPacketCount);
+        bytesLeft -= sizeof(_processedPPS) + sizeof(_pendingPacketCount);
+    }
+    uint16_t excludedPropertiesSize = 0;
+    if (bytesLeft >= (int)(sizeof(_heavyPropertiesDistance) + sizeof(excludedPropertiesSize))) {
+        memcpy(&_heavyPropertiesDistance, sourceBuffer, sizeof(_heavyPropertiesDistance));
+        sourceBuffer += sizeof(_heavyPropertiesDistance);
+        memcpy(&excludedPropertiesSize, sourceBuffer, sizeof(excludedPropertiesSize));
+        sourceBuffer += sizeof(excludedPropertiesSize);
+        bytesLeft -= sizeof(_heavyPropertiesDistance) + sizeof(excludedPropertiesSize);
+        excludedPropertiesSize = (uint16_t)std::min((int)excludedPropertiesSize, (int)bytesLeft);
+        setExcludedProperties(QByteArray(reinterpret_cast<const char*>(sourceBuffer), excludedPropertiesSize));
+        sourceBuffer += excludedPropertiesSize;
     }
     return sourceBuffer - startPosition;
 }
 
+QByteArray OctreeQuery::getExcludedProperties() const {
+    std::lock_guard<std::mutex> lock(_excludedPropertiesMutex);
+    return _excludedProperties;
+}
+
+void OctreeQuery::setExcludedProperties(const QByteArray& excludedProperties) {
+    std::lock_guard<std::mutex> lock(_excludedPropertiesMutex);
+    _excludedProperties = excludedProperties;
+}
+
 glm::vec3 OctreeQuery::calculateCameraDirection() const {
     glm::vec3 direction = glm::vec3(_cameraOrientation * glm::vec4(IDENTITY_FRONT, 0.0f));
     return direction;
@@ -28,11 +28,17 @@ typedef unsigned long long quint64;
 #endif
 
 
+#include <mutex>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include <QtCore/QByteArray>
+
 #include <NodeData.h>
 
+#include "OctreeConstants.h"
+
 // First bitset
 const int WANT_LOW_RES_MOVING_BIT = 0;
 const int WANT_COLOR_AT_BIT = 1;
@@ -77,6 +83,22 @@ public:
     float getOctreeSizeScale() const { return _octreeElementSizeScale; }
     int getBoundaryLevelAdjust() const { return _boundaryLevelAdjust; }
 
+    // how well the viewer keeps up with the octree packets it receives, so the servers can slow down for it
+    float getProcessedPacketsPerSecond() const { return _processedPPS; }
+    int getPendingPacketCount() const { return _pendingPacketCount; }
+    void setReceiveStats(float processedPPS, int pendingPacketCount) {
+        _processedPPS = processedPPS;
+        _pendingPacketCount = pendingPacketCount;
+    }
+
+    // the properties the viewer never wants, encoded as the property flags of the tree it queries (empty for none)
+    QByteArray getExcludedProperties() const;
+    void setExcludedProperties(const QByteArray& excludedProperties);
+
+    // the distance past which the viewer wants the data without its heavy properties
+    float getHeavyPropertiesDistance() const { return _heavyPropertiesDistance; }
+    void setHeavyPropertiesDistance(float distance) { _heavyPropertiesDistance = distance; }
+
 public slots:
     void setMaxQueryPacketsPerSecond(int maxQueryPPS) { _maxQueryPPS = maxQueryPPS; }
     void setOctreeSizeScale(float octreeSizeScale) { _octreeElementSizeScale = octreeSizeScale; }
@@ -98,6 +120,15 @@ protected:
     float _octreeElementSizeScale = DEFAULT_OCTREE_SIZE_SCALE; /// used for LOD calculations
     int _boundaryLevelAdjust = 0; /// used for LOD calculations
 
+    // as the viewer last reported them, a viewer that doesn't report them is never behind
+    float _processedPPS { 0.0f };
+    int _pendingPacketCount { 0 };
+
+    // set by the queries received while the server reads them
+    mutable std::mutex _excludedPropertiesMutex;
+    QByteArray _excludedProperties;
+    float _heavyPropertiesDistance { NO_HEAVY_PROPERTIES_DISTANCE };
+
 private:
     // privatize the copy constructor and assignment operator so they cannot be called
     OctreeQuery(const OctreeQuery&);
@@ -41,164 +41,155 @@ void OctreeRenderer::setTree(OctreePointer newTree) {
 }
 
 void OctreeRenderer::processDatagram(ReceivedMessage& message, SharedNodePointer sourceNode) {
+    DecodedDatagrams datagrams(1);
+    if (decodeDatagram(message, sourceNode, datagrams.back())) {
+        applyDatagrams(datagrams);
+    }
+}
+
+bool OctreeRenderer::decodeDatagram(ReceivedMessage& message, SharedNodePointer sourceNode, DecodedDatagram& decoded) {
     bool extraDebugging = false;
 
     if (extraDebugging) {
-        qCDebug(octree) << "OctreeRenderer::processDatagram()";
+        qCDebug(octree) << "OctreeRenderer::decodeDatagram()";
     }
 
     if (!_tree) {
-        qCDebug(octree) << "OctreeRenderer::processDatagram() called before init, calling init()...";
+        qCDebug(octree) << "OctreeRenderer::decodeDatagram() called before init, calling init()...";
         this->init();
     }
 
-    bool showTimingDetails = false; // Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings);
-    PerformanceWarning warn(showTimingDetails, "OctreeRenderer::processDatagram()", showTimingDetails);
-    
-    if (message.getType() == getExpectedPacketType()) {
-        PerformanceWarning warn(showTimingDetails, "OctreeRenderer::processDatagram expected PacketType", showTimingDetails);
-        // if we are getting inbound packets, then our tree is also viewing, and we should remember that fact.
-        _tree->setIsViewing(true);
-        
-        OCTREE_PACKET_FLAGS flags;
-        message.readPrimitive(&flags);
-        
-        OCTREE_PACKET_SEQUENCE sequence;
-        message.readPrimitive(&sequence);
-
-        OCTREE_PACKET_SENT_TIME sentAt;
-        message.readPrimitive(&sentAt);
-
-        bool packetIsColored = oneAtBit(flags, PACKET_IS_COLOR_BIT);
-        bool packetIsCompressed = oneAtBit(flags, PACKET_IS_COMPRESSED_BIT);
-        
+    if (message.getType() != getExpectedPacketType()) {
+        return false;
+    }
+
+    // if we are getting inbound packets, then our tree is also viewing, and we should remember that fact.
+    _tree->setIsViewing(true);
+
+    OCTREE_PACKET_FLAGS flags;
+    message.readPrimitive(&flags);
+
+    OCTREE_PACKET_SEQUENCE sequence;
+    message.readPrimitive(&sequence);
+
+    OCTREE_PACKET_SENT_TIME sentAt;
+    message.readPrimitive(&sentAt);
+
+    bool packetIsColored = oneAtBit(flags, PACKET_IS_COLOR_BIT);
+    bool packetIsCompressed = oneAtBit(flags, PACKET_IS_COMPRESSED_BIT);
+
+    if (extraDebugging) {
         OCTREE_PACKET_SENT_TIME arrivedAt = usecTimestampNow();
         qint64 clockSkew = sourceNode ? sourceNode->getClockSkewUsec() : 0;
         qint64 flightTime = arrivedAt - sentAt + clockSkew;
 
-        OCTREE_PACKET_INTERNAL_SECTION_SIZE sectionLength = 0;
+        qCDebug(octree) << "OctreeRenderer::decodeDatagram() ... "
+                           "Got Packet Section color:" << packetIsColored <<
+                           "compressed:" << packetIsCompressed <<
+                           "sequence: " <<  sequence <<
+                           "flight: " << flightTime << " usec" <<
+                           "size:" << message.getSize() <<
+                           "data:" << message.getBytesLeftToRead();
+    }
 
-        if (extraDebugging) {
-            qCDebug(octree) << "OctreeRenderer::processDatagram() ... "
-                               "Got Packet Section color:" << packetIsColored <<
-                               "compressed:" << packetIsCompressed <<
-                               "sequence: " <<  sequence << 
-                               "flight: " << flightTime << " usec" <<
-                               "size:" << message.getSize() <<
-                               "data:" << message.getBytesLeftToRead();
-        }
-        
-        _packetsInLastWindow++;
-        
-        int elementsPerPacket = 0;
-        int entitiesPerPacket = 0;
-        
-        quint64 totalWaitingForLock = 0;
-        quint64 totalUncompress = 0;
-        quint64 totalReadBitsteam = 0;
-
-        const QUuid& sourceUUID = message.getSourceID();
-        
-        int subsection = 1;
-        
-        bool error = false;
-        
-        while (message.getBytesLeftToRead() > 0 && !error) {
-            if (packetIsCompressed) {
-                if (message.getBytesLeftToRead() > (qint64) sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE)) {
-                    message.readPrimitive(&sectionLength);
-                } else {
-                    sectionLength = 0;
-                    error = true;
-                }
+    decoded.sourceUUID = message.getSourceID();
+    decoded.sourceNode = sourceNode;
+    decoded.version = message.getVersion();
+    decoded.sections.clear();
+
+    quint64 startUncompress = usecTimestampNow();
+
+    OCTREE_PACKET_INTERNAL_SECTION_SIZE sectionLength = 0;
+    while (message.getBytesLeftToRead() > 0) {
+        if (packetIsCompressed) {
+            if (message.getBytesLeftToRead() > (qint64) sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE)) {
+                message.readPrimitive(&sectionLength);
             } else {
-                sectionLength = message.getBytesLeftToRead();
+                break;
+            }
+        } else {
+            sectionLength = message.getBytesLeftToRead();
+        }
+
+        if (sectionLength) {
+            const uchar* sectionData = reinterpret_cast<const uchar*>(message.getRawMessage() + message.getPosition());
+            QByteArray section = packetIsCompressed ? qUncompress(sectionData, sectionLength) :
+                                                      QByteArray(reinterpret_cast<const char*>(sectionData), sectionLength);
+
+            // a section that doesn't fit in a packet is dropped, the same as OctreePacketData would
+            if (section.size() <= MAX_OCTREE_UNCOMRESSED_PACKET_SIZE) {
+                decoded.sections.push_back(section);
             }
-            
-            if (sectionLength) {
-                // ask the VoxelTree to read the bitstream into the tree
+
+            // seek forwards in packet
+            message.seek(message.getPosition() + sectionLength);
+        }
+    }
+
+    _uncompressPerPacket.updateAverage(usecTimestampNow() - startUncompress);
+    return true;
+}
+
+void OctreeRenderer::applyDatagrams(DecodedDatagrams& datagrams) {
+    if (datagrams.empty()) {
+        return;
+    }
+
+    bool showTimingDetails = false; // Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings);
+    PerformanceWarning warn(showTimingDetails, "OctreeRenderer::applyDatagrams()", showTimingDetails);
+
+    quint64 startLock = usecTimestampNow();
+    _tree->withWriteLock([&] {
+        _waitLockPerPacket.updateAverage(usecTimestampNow() - startLock);
+
+        for (auto& datagram : datagrams) {
+            int elementsPerPacket = 0;
+            int entitiesPerPacket = 0;
+
+            quint64 startReadBitsteam = usecTimestampNow();
+            for (auto& section : datagram.sections) {
+                // ask the tree to read the bitstream into the tree
                 ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
-                                                sourceUUID, sourceNode, false, message.getVersion());
-                quint64 startUncompress, startLock = usecTimestampNow();
-                quint64 startReadBitsteam, endReadBitsteam;
-                // FIXME STUTTER - there may be an opportunity to bump this lock outside of the
-                // loop to reduce the amount of locking/unlocking we're doing
-                _tree->withWriteLock([&] {
-                    startUncompress = usecTimestampNow();
-
-                    OctreePacketData packetData(packetIsCompressed);
-                    packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
-                        sectionLength);
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeRenderer::processDatagram() ... "
-                            "Got Packet Section color:" << packetIsColored <<
-                            "compressed:" << packetIsCompressed <<
-                            "sequence: " << sequence <<
-                            "flight: " << flightTime << " usec" <<
-                            "size:" << message.getSize() <<
-                            "data:" << message.getBytesLeftToRead() <<
-                            "subsection:" << subsection <<
-                            "sectionLength:" << sectionLength <<
-                            "uncompressed:" << packetData.getUncompressedSize();
-                    }
-
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeRenderer::processDatagram() ******* START _tree->readBitstreamToTree()...";
-                    }
-                    startReadBitsteam = usecTimestampNow();
-                    _tree->readBitstreamToTree(packetData.getUncompressedData(), packetData.getUncompressedSize(), args);
-                    endReadBitsteam = usecTimestampNow();
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeRenderer::processDatagram() ******* END _tree->readBitstreamToTree()...";
-                    }
-                });
-                
-                // seek forwards in packet
-                message.seek(message.getPosition() + sectionLength);
+                                               datagram.sourceUUID, datagram.sourceNode, false, datagram.version);
+                _tree->readBitstreamToTree(reinterpret_cast<const unsigned char*>(section.constData()), section.size(), args);
 
                 elementsPerPacket += args.elementsPerPacket;
                 entitiesPerPacket += args.entitiesPerPacket;
+            }
+            _readBitstreamPerPacket.updateAverage(usecTimestampNow() - startReadBitsteam);
 
-                _elementsInLastWindow += args.elementsPerPacket;
-                _entitiesInLastWindow += args.entitiesPerPacket;
-
-                totalWaitingForLock += (startUncompress - startLock);
-                totalUncompress += (startReadBitsteam - startUncompress);
-                totalReadBitsteam += (endReadBitsteam - startReadBitsteam);
+            _packetsInLastWindow++;
+            _elementsInLastWindow += elementsPerPacket;
+            _entitiesInLastWindow += entitiesPerPacket;
 
-            }
-            subsection++;
-        }
-        _elementsPerPacket.updateAverage(elementsPerPacket);
-        _entitiesPerPacket.updateAverage(entitiesPerPacket);
-
-        _waitLockPerPacket.updateAverage(totalWaitingForLock);
-        _uncompressPerPacket.updateAverage(totalUncompress);
-        _readBitstreamPerPacket.updateAverage(totalReadBitsteam);
-        
-        quint64 now = usecTimestampNow();
-        if (_lastWindowAt == 0) {
-            _lastWindowAt = now;
-        }
-        quint64 sinceLastWindow = now - _lastWindowAt;
-        
-        if (sinceLastWindow > USECS_PER_SECOND) {
-            float packetsPerSecondInWindow = (float)_packetsInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
-            float elementsPerSecondInWindow = (float)_elementsInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
-            float entitiesPerSecondInWindow = (float)_entitiesInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
-            _packetsPerSecond.updateAverage(packetsPerSecondInWindow);
-            _elementsPerSecond.updateAverage(elementsPerSecondInWindow);
-            _entitiesPerSecond.updateAverage(entitiesPerSecondInWindow);
-
-            _lastWindowAt = now;
-            _packetsInLastWindow = 0;
-            _elementsInLastWindow = 0;
-            _entitiesInLastWindow = 0;
+            _elementsPerPacket.updateAverage(elementsPerPacket);
+            _entitiesPerPacket.updateAverage(entitiesPerPacket);
         }
+    });
+    datagrams.clear();
+
+    quint64 now = usecTimestampNow();
+    if (_lastWindowAt == 0) {
+        _lastWindowAt = now;
+    }
+    quint64 sinceLastWindow = now - _lastWindowAt;
+
+    if (sinceLastWindow > USECS_PER_SECOND) {
+        float packetsPerSecondInWindow = (float)_packetsInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
+        float elementsPerSecondInWindow = (float)_elementsInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
+        float entitiesPerSecondInWindow = (float)_entitiesInLastWindow / (float)(sinceLastWindow / USECS_PER_SECOND);
+        _packetsPerSecond.updateAverage(packetsPerSecondInWindow);
+        _elementsPerSecond.updateAverage(elementsPerSecondInWindow);
+        _entitiesPerSecond.updateAverage(entitiesPerSecondInWindow);
+
+        _lastWindowAt = now;
+        _packetsInLastWindow = 0;
+        _elementsInLastWindow = 0;
+        _entitiesInLastWindow = 0;
     }
 }
 
-bool OctreeRenderer::renderOperation(OctreeElementPointer element, void* extraData) {
+bool OctreeRenderer::renderOperation(const OctreeElementPointer& element, void* extraData) {
     RenderArgs* args = static_cast<RenderArgs*>(extraData);
     if (element->isInView(args->getViewFrustum())) {
         if (element->hasContent()) {
@@ -15,6 +15,8 @@
 #include <glm/glm.hpp>
 #include <stdint.h>
 
+#include <vector>
+
 #include <QObject>
 
 #include <udt/PacketHeaders.h>
@@ -42,9 +44,23 @@ public:
 
     virtual void setTree(OctreePointer newTree);
 
+    /// An incoming packet with its sections uncompressed, ready to be read into the tree
+    struct DecodedDatagram {
+        QUuid sourceUUID;
+        SharedNodePointer sourceNode;
+        PacketVersion version;
+        std::vector<QByteArray> sections;
+    };
+    using DecodedDatagrams = std::vector<DecodedDatagram>;
+
     /// process incoming data
     virtual void processDatagram(ReceivedMessage& message, SharedNodePointer sourceNode);
 
+    /// The two halves of processDatagram: decoding doesn't touch the tree, so it runs without the tree lock, and
+    /// the decoded packets are then read into the tree together, under a single write lock. False if not our packet type.
+    bool decodeDatagram(ReceivedMessage& message, SharedNodePointer sourceNode, DecodedDatagram& decoded);
+    void applyDatagrams(DecodedDatagrams& datagrams);
+
     /// initialize and GPU/rendering related resources
     virtual void init();
 
@@ -54,7 +70,7 @@ public:
     const ViewFrustum& getViewFrustum() const { return _viewFrustum; }
     void setViewFrustum(const ViewFrustum& viewFrustum) { _viewFrustum = viewFrustum; }
 
-    static bool renderOperation(OctreeElementPointer element, void* extraData);
+    static bool renderOperation(const OctreeElementPointer& element, void* extraData);
 
     /// clears the tree
     virtual void clear();
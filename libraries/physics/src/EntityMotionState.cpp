@@ -227,15 +227,11 @@ void EntityMotionState::setWorldTransform(const btTransform& worldTrans) {
 
     assert(entityTreeIsLocked());
     measureBodyAcceleration();
-    bool positionSuccess;
-    _entity->setPosition(bulletToGLM(worldTrans.getOrigin()) + ObjectMotionState::getWorldOffset(), positionSuccess, false);
-    if (!positionSuccess) {
-        qDebug() << "EntityMotionState::setWorldTransform setPosition failed" << _entity->getID();
-    }
-    bool orientationSuccess;
-    _entity->setOrientation(bulletToGLM(worldTrans.getRotation()), orientationSuccess, false);
-    if (!orientationSuccess) {
-        qDebug() << "EntityMotionState::setWorldTransform setOrientation failed" << _entity->getID();
+    bool success;
+    _entity->setPositionAndOrientation(bulletToGLM(worldTrans.getOrigin()) + ObjectMotionState::getWorldOffset(),
+                                       bulletToGLM(worldTrans.getRotation()), success, false);
+    if (!success) {
+        qDebug() << "EntityMotionState::setWorldTransform setPositionAndOrientation failed" << _entity->getID();
     }
     _entity->setVelocity(getBodyLinearVelocity());
     _entity->setAngularVelocity(getBodyAngularVelocity());
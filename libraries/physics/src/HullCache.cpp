@@ -0,0 +1,123 @@
+//
+//  HullCache.cpp
+//  libraries/physics/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HullCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+#include "PhysicsLogging.h"
+
+static const quint32 HULL_CACHE_VERSION = 1;
+
+// sanity limits for what is read back, well past anything ShapeFactory builds
+static const quint32 MAX_CACHED_HULLS = 1 << 16;
+static const quint32 MAX_CACHED_HULL_POINTS = 1 << 16;
+
+HullCache::HullCache(const QString& directory) : _directory(directory) {
+    if (!QDir().mkpath(_directory)) {
+        qCWarning(physics) << "HullCache could not create" << _directory;
+    }
+}
+
+bool HullCache::load(const ShapeInfo& info, std::vector<Hull>& hulls) const {
+    QFile file(getPath(info));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 version;
+    QByteArray digest;
+    quint32 numHulls;
+    stream >> version >> digest >> numHulls;
+    if (stream.status() != QDataStream::Ok || version != HULL_CACHE_VERSION || numHulls > MAX_CACHED_HULLS ||
+        digest != computePointsDigest(info)) {
+        return false;
+    }
+
+    hulls.resize(numHulls);
+    for (auto& hull : hulls) {
+        quint32 numPoints;
+        stream >> hull.margin >> numPoints;
+        if (numPoints > MAX_CACHED_HULL_POINTS) {
+            return false;
+        }
+        hull.points.resize(numPoints);
+        for (auto& point : hull.points) {
+            float x, y, z;
+            stream >> x >> y >> z;
+            point.setValue(x, y, z);
+        }
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+void HullCache::save(const ShapeInfo& info, const std::vector<Hull>& hulls) const {
+    // written to the side and moved into place, so a reader never sees half an entry
+    QSaveFile file(getPath(info));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << HULL_CACHE_VERSION << computePointsDigest(info) << (quint32)hulls.size();
+    for (auto& hull : hulls) {
+        stream << hull.margin << (quint32)hull.points.size();
+        for (auto& point : hull.points) {
+            stream << (float)point.getX() << (float)point.getY() << (float)point.getZ();
+        }
+    }
+
+    if (!file.commit()) {
+        qCWarning(physics) << "HullCache could not write" << file.fileName();
+    }
+}
+
+HullCache::Hull HullCache::hullFromShape(const btConvexHullShape* shape) {
+    Hull hull;
+    hull.margin = shape->getMargin();
+    const btVector3* points = shape->getUnscaledPoints();
+    hull.points.assign(points, points + shape->getNumPoints());
+    return hull;
+}
+
+btConvexHullShape* HullCache::shapeFromHull(const Hull& hull) {
+    btConvexHullShape* shape = new btConvexHullShape();
+    shape->setMargin(hull.margin);
+    for (auto& point : hull.points) {
+        shape->addPoint(point, false);
+    }
+    shape->recalcLocalAabb();
+    return shape;
+}
+
+QString HullCache::getPath(const ShapeInfo& info) const {
+    const DoubleHashKey& key = info.getHash();
+    return QString("%1/%2-%3.hulls").arg(_directory).arg(key.getHash(), 8, 16, QChar('0'))
+        .arg(key.getHash2(), 8, 16, QChar('0'));
+}
+
+QByteArray HullCache::computePointsDigest(const ShapeInfo& info) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (auto& points : info.getPointCollection()) {
+        quint32 numPoints = points.size();
+        hash.addData(reinterpret_cast<const char*>(&numPoints), sizeof(numPoints));
+        hash.addData(reinterpret_cast<const char*>(points.constData()), points.size() * sizeof(glm::vec3));
+    }
+    return hash.result();
+}
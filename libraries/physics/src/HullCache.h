@@ -0,0 +1,55 @@
+//
+//  HullCache.h
+//  libraries/physics/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_HullCache_h
+#define hifi_HullCache_h
+
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <ShapeInfo.h>
+
+// Keeps the finished convex hulls of compound shapes on disk, so a model's collision hulls are not rebuilt and
+// reduced every time they are loaded. An entry is kept by the ShapeInfo's hash and checked against a digest of
+// the points it was built from, so a model that has changed at the same url is rebuilt rather than loaded stale.
+// Entries are separate files, so different shapes can be loaded and saved from different threads.
+class HullCache {
+public:
+    struct Hull {
+        float margin { 0.0f };
+        std::vector<btVector3> points;
+    };
+
+    HullCache(const QString& directory);
+
+    const QString& getDirectory() const { return _directory; }
+
+    // returns false if there is no entry for the shape, or it was built from other points
+    bool load(const ShapeInfo& info, std::vector<Hull>& hulls) const;
+    void save(const ShapeInfo& info, const std::vector<Hull>& hulls) const;
+
+    static Hull hullFromShape(const btConvexHullShape* shape);
+    static btConvexHullShape* shapeFromHull(const Hull& hull);
+
+private:
+    QString getPath(const ShapeInfo& info) const;
+    static QByteArray computePointsDigest(const ShapeInfo& info);
+
+    QString _directory;
+};
+
+#endif // hifi_HullCache_h
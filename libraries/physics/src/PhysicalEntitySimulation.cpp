@@ -217,16 +217,18 @@ void PhysicalEntitySimulation::getObjectsToAddToPhysics(VectorOfMotionStates& re
         } else if (entity->isReadyToComputeShape()) {
             ShapeInfo shapeInfo;
             entity->computeShapeInfo(shapeInfo);
-            int numPoints = shapeInfo.getLargestSubshapePointCount();
-            if (shapeInfo.getType() == SHAPE_TYPE_COMPOUND) {
-                if (numPoints > MAX_HULL_POINTS) {
-                    qWarning() << "convex hull with" << numPoints
-                        << "points for entity" << entity->getName()
-                        << "at" << entity->getPosition() << " will be reduced";
-                }
-            }
-            btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+            // expensive shapes are built off this thread, the entity stays on the list and is added once it's ready
+            btCollisionShape* shape =
+                const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShapeWhenReady(shapeInfo));
             if (shape) {
+                int numPoints = shapeInfo.getLargestSubshapePointCount();
+                if (shapeInfo.getType() == SHAPE_TYPE_COMPOUND) {
+                    if (numPoints > MAX_HULL_POINTS) {
+                        qWarning() << "convex hull with" << numPoints
+                            << "points for entity" << entity->getName()
+                            << "at" << entity->getPosition() << " was reduced";
+                    }
+                }
                 EntityMotionState* motionState = new EntityMotionState(shape, entity);
                 entity->setPhysicsInfo(static_cast<void*>(motionState));
                 _physicalObjects.insert(motionState);
@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <PhysicsCollisionGroups.h>
 
 #include "CharacterController.h"
@@ -234,6 +236,12 @@ void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
 }
 
 void PhysicsEngine::stepSimulation() {
+    float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
+    _clock.reset();
+    stepSimulation(dt);
+}
+
+void PhysicsEngine::stepSimulation(float dt) {
     CProfileManager::Reset();
     BT_PROFILE("stepSimulation");
     // NOTE: the grand order of operations is:
@@ -243,8 +251,6 @@ void PhysicsEngine::stepSimulation() {
     // (4) send outgoing packets
 
     const float MAX_TIMESTEP = (float)PHYSICS_ENGINE_MAX_NUM_SUBSTEPS * PHYSICS_ENGINE_FIXED_SUBSTEP;
-    float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
-    _clock.reset();
     float timeStep = btMin(dt, MAX_TIMESTEP);
 
     if (_myAvatarController) {
@@ -403,13 +409,18 @@ const VectorOfMotionStates& PhysicsEngine::getOutgoingChanges() {
     _activeStaticBodies.clear();
     _dynamicsWorld->synchronizeMotionStates();
     _hasOutgoingChanges = false;
-    return _dynamicsWorld->getChangedMotionStates();
+    const VectorOfMotionStates& changedMotionStates = _dynamicsWorld->getChangedMotionStates();
+    _numSyncedMotionStates = (int)changedMotionStates.size();
+    _maxSyncedMotionStates = std::max(_maxSyncedMotionStates, _numSyncedMotionStates);
+    return changedMotionStates;
 }
 
 void PhysicsEngine::dumpStatsIfNecessary() {
     if (_dumpNextStats) {
         _dumpNextStats = false;
         CProfileManager::dumpAll();
+        qCDebug(physics) << "synced motion states last step:" << _numSyncedMotionStates << "max:" << _maxSyncedMotionStates;
+        _maxSyncedMotionStates = 0;
     }
 }
 
@@ -13,6 +13,8 @@
 #define hifi_PhysicsEngine_h
 
 #include <stdint.h>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 
 #include <QUuid>
@@ -40,7 +42,17 @@ public:
     void* _b; // ObjectMotionState pointer
 };
 
-typedef std::map<ContactKey, ContactInfo> ContactMap;
+class ContactKeyHash {
+public:
+    size_t operator()(const ContactKey& key) const {
+        std::hash<void*> pointerHash;
+        size_t hash = pointerHash(key._a);
+        return hash ^ (pointerHash(key._b) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+    }
+};
+
+// looked up for every manifold on every substep, so a hash rather than a tree
+typedef std::unordered_map<ContactKey, ContactInfo, ContactKeyHash> ContactMap;
 typedef std::vector<Collision> CollisionEvents;
 
 class PhysicsEngine {
@@ -59,6 +71,8 @@ public:
     void reinsertObject(ObjectMotionState* object);
 
     void stepSimulation();
+    // steps by dt seconds instead of the time since the last step, so a run can be repeated exactly
+    void stepSimulation(float dt);
     void updateContactMap();
 
     bool hasOutgoingChanges() const { return _hasOutgoingChanges; }
@@ -69,6 +83,12 @@ public:
     /// \return reference to list of Collision events.  The list is only valid until beginning of next simulation loop.
     const CollisionEvents& getCollisionEvents();
 
+    /// \return the number of motion states synchronized by the last getOutgoingChanges()
+    int getNumSyncedMotionStates() const { return _numSyncedMotionStates; }
+
+    /// \return the number of object pairs currently tracked as touching
+    int getNumContacts() const { return (int)_contactMap.size(); }
+
     /// \brief prints timings for last frame if stats have been requested.
     void dumpStatsIfNecessary();
 
@@ -117,6 +137,9 @@ private:
     uint32_t _numContactFrames = 0;
     uint32_t _numSubsteps;
 
+    int _numSyncedMotionStates = 0;
+    int _maxSyncedMotionStates = 0; // the most synchronized since stats were last dumped
+
     bool _dumpNextStats = false;
     bool _hasOutgoingChanges = false;
 };
@@ -15,6 +15,7 @@
 
 #include "ShapeFactory.h"
 #include "BulletUtil.h"
+#include "HullCache.h"
 
 // These are the same normalized directions used by the btShapeHull class.
 // 12 points for the face centers of a duodecohedron plus another 30 points
@@ -247,7 +248,7 @@ void deleteStaticMeshArray(btTriangleIndexVertexArray* dataArray) {
     delete dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info, const HullCache* hullCache) {
     btCollisionShape* shape = NULL;
     int type = info.getType();
     switch(type) {
@@ -271,14 +272,31 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         case SHAPE_TYPE_SIMPLE_HULL: {
             const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
             uint32_t numSubShapes = info.getNumSubShapes();
+
+            // only the hulls of a model are worth keeping, the same model is loaded again and again
+            bool useHullCache = hullCache && type == SHAPE_TYPE_COMPOUND && !info.getUrl().isEmpty();
+            std::vector<HullCache::Hull> cachedHulls;
+            bool isCached = useHullCache && hullCache->load(info, cachedHulls) && cachedHulls.size() == numSubShapes;
+            std::vector<btConvexHullShape*> hulls;
+            hulls.reserve(numSubShapes);
+            for (uint32_t i = 0; i < numSubShapes; ++i) {
+                hulls.push_back(isCached ? HullCache::shapeFromHull(cachedHulls[i]) : createConvexHull(pointCollection[i]));
+            }
+            if (useHullCache && !isCached) {
+                cachedHulls.clear();
+                for (auto hull : hulls) {
+                    cachedHulls.push_back(HullCache::hullFromShape(hull));
+                }
+                hullCache->save(info, cachedHulls);
+            }
+
             if (numSubShapes == 1) {
-                shape = createConvexHull(pointCollection[0]);
+                shape = hulls[0];
             } else {
                 auto compound = new btCompoundShape();
                 btTransform trans;
                 trans.setIdentity();
-                foreach (const ShapeInfo::PointList& hullPoints, pointCollection) {
-                    btConvexHullShape* hull = createConvexHull(hullPoints);
+                for (auto hull : hulls) {
                     compound->addChildShape(trans, hull);
                 }
                 shape = compound;
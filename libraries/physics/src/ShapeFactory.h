@@ -17,10 +17,13 @@
 
 #include <ShapeInfo.h>
 
+class HullCache;
+
 // translates between ShapeInfo and btShape
 
 namespace ShapeFactory {
-    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
+    // the hulls of compound shapes for a model url are loaded from and saved to hullCache, when there is one
+    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info, const HullCache* hullCache = nullptr);
     void deleteShape(const btCollisionShape* shape);
 
     //btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info);
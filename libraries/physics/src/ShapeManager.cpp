@@ -10,12 +10,33 @@
 //
 
 #include <QDebug>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
 
 #include <glm/gtx/norm.hpp>
 
 #include "ShapeFactory.h"
 #include "ShapeManager.h"
 
+class ShapeBuilder : public QRunnable {
+public:
+    ShapeBuilder(const ShapeManager::ShapeBuildPointer& build) : _build(build) {}
+
+    void run() override {
+        const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(_build->info, _build->hullCache.get());
+        std::lock_guard<std::mutex> lock(_build->mutex);
+        if (_build->isAbandoned) {
+            ShapeFactory::deleteShape(shape);
+        } else {
+            _build->shape = shape;
+        }
+        _build->isDone = true;
+    }
+
+private:
+    ShapeManager::ShapeBuildPointer _build;
+};
+
 ShapeManager::ShapeManager() {
 }
 
@@ -26,6 +47,18 @@ ShapeManager::~ShapeManager() {
         ShapeFactory::deleteShape(shapeRef->shape);
     }
     _shapeMap.clear();
+
+    int numBuilds = _pendingBuilds.size();
+    for (int i = 0; i < numBuilds; ++i) {
+        ShapeBuild& build = **_pendingBuilds.getAtIndex(i);
+        std::lock_guard<std::mutex> lock(build.mutex);
+        if (build.isDone) {
+            ShapeFactory::deleteShape(build.shape);
+        } else {
+            build.isAbandoned = true;
+        }
+    }
+    _pendingBuilds.clear();
 }
 
 const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
@@ -45,7 +78,57 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         shapeRef->refCount++;
         return shapeRef->shape;
     }
-    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    return addShape(key, ShapeFactory::createShapeFromInfo(info, _hullCache.get()));
+}
+
+const btCollisionShape* ShapeManager::getShapeWhenReady(const ShapeInfo& info) {
+    switch (info.getType()) {
+        case SHAPE_TYPE_COMPOUND:
+        case SHAPE_TYPE_SIMPLE_HULL:
+        case SHAPE_TYPE_SIMPLE_COMPOUND:
+        case SHAPE_TYPE_STATIC_MESH:
+            break;
+        default:
+            // the primitive shapes are cheap to build
+            return getShape(info);
+    }
+
+    DoubleHashKey key = info.getHash();
+    if (_shapeMap.find(key)) {
+        return getShape(info);
+    }
+
+    ShapeBuildPointer* pendingBuild = _pendingBuilds.find(key);
+    if (!pendingBuild) {
+        // getShape() turns tiny shapes down without building them
+        const float MIN_SHAPE_DIAGONAL_SQUARED = 3.0e-4f; // 1 cm cube
+        if (4.0f * glm::length2(info.getHalfExtents()) < MIN_SHAPE_DIAGONAL_SQUARED) {
+            return nullptr;
+        }
+
+        ShapeBuildPointer build = std::make_shared<ShapeBuild>();
+        build->info = info;
+        build->hullCache = _hullCache;
+        _pendingBuilds.insert(key, build);
+        QThreadPool::globalInstance()->start(new ShapeBuilder(build));
+        return nullptr;
+    }
+
+    const btCollisionShape* shape;
+    {
+        ShapeBuild& build = **pendingBuild;
+        std::lock_guard<std::mutex> lock(build.mutex);
+        if (!build.isDone) {
+            return nullptr;
+        }
+        shape = build.shape;
+    }
+    _pendingBuilds.remove(key);
+    return addShape(key, shape);
+}
+
+// private helper method
+const btCollisionShape* ShapeManager::addShape(const DoubleHashKey& key, const btCollisionShape* shape) {
     if (shape) {
         ShapeReference newRef;
         newRef.refCount = 1;
@@ -93,6 +176,25 @@ bool ShapeManager::releaseShape(const btCollisionShape* shape) {
 }
 
 void ShapeManager::collectGarbage() {
+    // a finished build nobody came back for is only a shape of no references, free it on the next collection
+    btAlignedObjectArray<DoubleHashKey> unclaimedBuilds;
+    int numBuilds = _pendingBuilds.size();
+    for (int i = 0; i < numBuilds; ++i) {
+        ShapeBuild& build = **_pendingBuilds.getAtIndex(i);
+        std::lock_guard<std::mutex> lock(build.mutex);
+        if (build.isDone) {
+            unclaimedBuilds.push_back(build.info.getHash());
+        }
+    }
+    for (int i = 0; i < unclaimedBuilds.size(); ++i) {
+        const DoubleHashKey& key = unclaimedBuilds[i];
+        const btCollisionShape* shape = (*_pendingBuilds.find(key))->shape;
+        _pendingBuilds.remove(key);
+        if (addShape(key, shape)) {
+            _shapeMap.find(key)->refCount = 0;
+        }
+    }
+
     int numShapes = _pendingGarbage.size();
     for (int i = 0; i < numShapes; ++i) {
         DoubleHashKey& key = _pendingGarbage[i];
@@ -103,6 +205,12 @@ void ShapeManager::collectGarbage() {
         }
     }
     _pendingGarbage.clear();
+
+    for (int i = 0; i < unclaimedBuilds.size(); ++i) {
+        if (_shapeMap.find(unclaimedBuilds[i])) {
+            _pendingGarbage.push_back(unclaimedBuilds[i]);
+        }
+    }
 }
 
 int ShapeManager::getNumReferences(const ShapeInfo& info) const {
@@ -12,12 +12,16 @@
 #ifndef hifi_ShapeManager_h
 #define hifi_ShapeManager_h
 
+#include <memory>
+#include <mutex>
+
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btHashMap.h>
 
 #include <ShapeInfo.h>
 
 #include "DoubleHashKey.h"
+#include "HullCache.h"
 
 class ShapeManager {
 public:
@@ -28,20 +32,41 @@ public:
     /// \return pointer to shape
     const btCollisionShape* getShape(const ShapeInfo& info);
 
+    /// like getShape(), but hulls, compounds and meshes that aren't already managed are built on a worker thread
+    /// \return pointer to shape, or nullptr while it is still being built (ask again later for the same info)
+    const btCollisionShape* getShapeWhenReady(const ShapeInfo& info);
+
     /// \return true if shape was found and released
     bool releaseShape(const btCollisionShape* shape);
 
     /// delete shapes that have zero references
     void collectGarbage();
 
+    /// the hulls of model compound shapes are kept in hullCache across runs, pass nullptr to stop using one
+    void setHullCache(std::shared_ptr<HullCache> hullCache) { _hullCache = hullCache; }
+
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
+    int getNumPendingShapes() const { return _pendingBuilds.size(); }
     int getNumReferences(const ShapeInfo& info) const;
     int getNumReferences(const btCollisionShape* shape) const;
     bool hasShape(const btCollisionShape* shape) const;
 
+    // the state shared between the ShapeManager and the worker building a shape
+    class ShapeBuild {
+    public:
+        ShapeInfo info;
+        std::shared_ptr<HullCache> hullCache;
+        std::mutex mutex;
+        const btCollisionShape* shape { nullptr };
+        bool isDone { false };
+        bool isAbandoned { false }; // the ShapeManager is gone, the worker deletes what it builds
+    };
+    using ShapeBuildPointer = std::shared_ptr<ShapeBuild>;
+
 private:
     bool releaseShapeByKey(const DoubleHashKey& key);
+    const btCollisionShape* addShape(const DoubleHashKey& key, const btCollisionShape* shape);
 
     class ShapeReference {
     public:
@@ -53,6 +78,8 @@ private:
 
     btHashMap<DoubleHashKey, ShapeReference> _shapeMap;
     btAlignedObjectArray<DoubleHashKey> _pendingGarbage;
+    btHashMap<DoubleHashKey, ShapeBuildPointer> _pendingBuilds;
+    std::shared_ptr<HullCache> _hullCache;
 };
 
 #endif // hifi_ShapeManager_h
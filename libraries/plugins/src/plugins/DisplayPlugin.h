@@ -133,6 +133,8 @@ public:
     virtual int getHmdScreen() const { return -1; }
     /// By default, all HMDs are stereo
     virtual bool isStereo() const { return isHmd(); }
+    /// Whether both eyes of the stereo frames should be drawn in a single pass
+    virtual bool isInstancedStereo() const { return false; }
     virtual bool isThrottled() const { return false; }
     virtual float getTargetFrameRate() const { return 0.0f; }
 
@@ -149,6 +151,9 @@ public:
     virtual void setContext(const gpu::ContextPointer& context) final { _gpuContext = context; }
     virtual void submitFrame(const gpu::FramePointer& newFrame) = 0;
 
+    // True while the frames submitted already are waiting for the present thread, a new one would only replace them
+    virtual bool isFrameQueueFull() const { return false; }
+
     // Does the rendering surface have current focus?
     virtual bool hasFocus() const = 0;
 
@@ -115,6 +115,10 @@ const LoaderList& getLoadedPlugins() {
 PluginManager::PluginManager() {
 }
 
+void PluginManager::loadPlugins() {
+    getLoadedPlugins();
+}
+
 extern CodecPluginList getCodecPlugins();
 
 const CodecPluginList& PluginManager::getCodecPlugins() {
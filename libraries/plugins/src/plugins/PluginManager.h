@@ -20,6 +20,10 @@ public:
     const InputPluginList& getInputPlugins();
     const CodecPluginList& getCodecPlugins();
 
+    // Loads the runtime plugin libraries without making any plugins, which can be done on any thread ahead of
+    // the first of the calls above
+    void loadPlugins();
+
     DisplayPluginList getPreferredDisplayPlugins();
     void setPreferredDisplayPlugins(const QStringList& displays);
 
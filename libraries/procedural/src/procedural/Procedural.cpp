@@ -8,6 +8,9 @@
 
 #include "Procedural.h"
 
+#include <unordered_map>
+
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QJsonArray>
@@ -33,6 +36,9 @@ static const std::string PROCEDURAL_BLOCK = "//PROCEDURAL_BLOCK";
 static const std::string PROCEDURAL_COMMON_BLOCK = "//PROCEDURAL_COMMON_BLOCK";
 static const std::string PROCEDURAL_VERSION = "//PROCEDURAL_VERSION";
 
+// the new programs are compiled no closer together than a frame
+static const quint64 MIN_USECS_BETWEEN_PROGRAM_COMPILES = USECS_PER_SECOND / 90;
+
 static const std::string STANDARD_UNIFORM_NAMES[Procedural::NUM_STANDARD_UNIFORMS] = {
     "iDate",
     "iGlobalTime",
@@ -218,6 +224,11 @@ bool Procedural::ready() {
         }
     }
 
+    // the fallback is drawn until the program is there
+    if (!setupProgram()) {
+        return false;
+    }
+
     if (!_hasStartedFade) {
         _hasStartedFade = true;
         _isFading = true;
@@ -226,10 +237,7 @@ bool Procedural::ready() {
     return true;
 }
 
-void Procedural::prepare(gpu::Batch& batch, const glm::vec3& position, const glm::vec3& size, const glm::quat& orientation) {
-    _entityDimensions = size;
-    _entityPosition = position;
-    _entityOrientation = glm::mat3_cast(orientation);
+bool Procedural::setupProgram() {
     if (_shaderUrl.isLocalFile()) {
         auto lastModified = (quint64)QFileInfo(_shaderPath).lastModified().toMSecsSinceEpoch();
         if (lastModified > _shaderModified) {
@@ -243,65 +251,108 @@ void Procedural::prepare(gpu::Batch& batch, const glm::vec3& position, const glm
         _shaderSource = _networkShader->_source;
     }
 
-    if (!_opaquePipeline || !_transparentPipeline || _shaderDirty) {
-        if (!_vertexShader) {
-            _vertexShader = gpu::Shader::createVertex(_vertexSource);
-        }
+    if (_opaquePipeline && _transparentPipeline && !_shaderDirty) {
+        return true;
+    }
 
-        // Build the fragment shader
-        std::string fragmentShaderSource = _fragmentSource;
-        size_t replaceIndex = fragmentShaderSource.find(PROCEDURAL_COMMON_BLOCK);
-        if (replaceIndex != std::string::npos) {
-            fragmentShaderSource.replace(replaceIndex, PROCEDURAL_COMMON_BLOCK.size(), ProceduralCommon_frag);
-        }
+    // Build the fragment shader
+    std::string fragmentShaderSource = _fragmentSource;
+    size_t replaceIndex = fragmentShaderSource.find(PROCEDURAL_COMMON_BLOCK);
+    if (replaceIndex != std::string::npos) {
+        fragmentShaderSource.replace(replaceIndex, PROCEDURAL_COMMON_BLOCK.size(), ProceduralCommon_frag);
+    }
 
-        replaceIndex = fragmentShaderSource.find(PROCEDURAL_VERSION);
-        if (replaceIndex != std::string::npos) {
-            if (_version == 1) {
-                fragmentShaderSource.replace(replaceIndex, PROCEDURAL_VERSION.size(), "#define PROCEDURAL_V1 1");
-            } else if (_version == 2) {
-                fragmentShaderSource.replace(replaceIndex, PROCEDURAL_VERSION.size(), "#define PROCEDURAL_V2 1");
-            }
-        }
-        replaceIndex = fragmentShaderSource.find(PROCEDURAL_BLOCK);
-        if (replaceIndex != std::string::npos) {
-            fragmentShaderSource.replace(replaceIndex, PROCEDURAL_BLOCK.size(), _shaderSource.toLocal8Bit().data());
+    replaceIndex = fragmentShaderSource.find(PROCEDURAL_VERSION);
+    if (replaceIndex != std::string::npos) {
+        if (_version == 1) {
+            fragmentShaderSource.replace(replaceIndex, PROCEDURAL_VERSION.size(), "#define PROCEDURAL_V1 1");
+        } else if (_version == 2) {
+            fragmentShaderSource.replace(replaceIndex, PROCEDURAL_VERSION.size(), "#define PROCEDURAL_V2 1");
         }
+    }
+    replaceIndex = fragmentShaderSource.find(PROCEDURAL_BLOCK);
+    if (replaceIndex != std::string::npos) {
+        fragmentShaderSource.replace(replaceIndex, PROCEDURAL_BLOCK.size(), _shaderSource.toLocal8Bit().data());
+    }
 
-        // Leave this here for debugging
-        // qDebug() << "FragmentShader:\n" << fragmentShaderSource.c_str();
+    // Leave this here for debugging
+    // qDebug() << "FragmentShader:\n" << fragmentShaderSource.c_str();
+
+    // The procedurals of the same sources share one program, the channel bindings are the same for all of them.
+    // The cache only holds on to the programs that are in use.
+    static std::unordered_map<std::string, std::weak_ptr<gpu::Shader>> programs;
+    static quint64 lastCompileTime { 0 };
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(_vertexSource.data(), (int)_vertexSource.size());
+    hash.addData("\0", 1);
+    hash.addData(fragmentShaderSource.data(), (int)fragmentShaderSource.size());
+    std::string key = hash.result().toStdString();
+
+    gpu::ShaderPointer shader = programs[key].lock();
+    if (!shader) {
+        // A program is compiled on the render thread, so the new ones take turns, one to a frame, and the others
+        // keep drawing their fallback until it is theirs
+        quint64 now = usecTimestampNow();
+        if (now - lastCompileTime < MIN_USECS_BETWEEN_PROGRAM_COMPILES) {
+            return false;
+        }
+        lastCompileTime = now;
 
-        _fragmentShader = gpu::Shader::createPixel(fragmentShaderSource);
-        _shader = gpu::Shader::createProgram(_vertexShader, _fragmentShader);
+        auto vertexShader = gpu::Shader::createVertex(_vertexSource);
+        auto fragmentShader = gpu::Shader::createPixel(fragmentShaderSource);
+        shader = gpu::Shader::createProgram(vertexShader, fragmentShader);
 
         gpu::Shader::BindingSet slotBindings;
         slotBindings.insert(gpu::Shader::Binding(std::string("iChannel0"), 0));
         slotBindings.insert(gpu::Shader::Binding(std::string("iChannel1"), 1));
         slotBindings.insert(gpu::Shader::Binding(std::string("iChannel2"), 2));
         slotBindings.insert(gpu::Shader::Binding(std::string("iChannel3"), 3));
-        gpu::Shader::makeProgram(*_shader, slotBindings);
-
-        _opaquePipeline = gpu::Pipeline::create(_shader, _opaqueState);
-        _transparentPipeline = gpu::Pipeline::create(_shader, _transparentState);
-        for (size_t i = 0; i < NUM_STANDARD_UNIFORMS; ++i) {
-            const std::string& name = STANDARD_UNIFORM_NAMES[i];
-            _standardUniformSlots[i] = _shader->getUniforms().findLocation(name);
+        gpu::Shader::makeProgram(*shader, slotBindings);
+
+        // the programs that went out of use go with the next one that is made
+        for (auto it = programs.begin(); it != programs.end();) {
+            if (it->second.expired()) {
+                it = programs.erase(it);
+            } else {
+                ++it;
+            }
         }
-        _start = usecTimestampNow();
-        _frameCount = 0;
+        programs[key] = shader;
+    }
+
+    _shader = shader;
+    _opaquePipeline = gpu::Pipeline::create(_shader, _opaqueState);
+    _transparentPipeline = gpu::Pipeline::create(_shader, _transparentState);
+    for (size_t i = 0; i < NUM_STANDARD_UNIFORMS; ++i) {
+        const std::string& name = STANDARD_UNIFORM_NAMES[i];
+        _standardUniformSlots[i] = _shader->getUniforms().findLocation(name);
     }
+    _start = usecTimestampNow();
+    _frameCount = 0;
+
+    // the uniforms are found again in the new program
+    _shaderDirty = false;
+    _uniformsDirty = true;
+    return true;
+}
+
+void Procedural::prepare(gpu::Batch& batch, const glm::vec3& position, const glm::vec3& size, const glm::quat& orientation) {
+    _entityDimensions = size;
+    _entityPosition = position;
+    _entityOrientation = glm::mat3_cast(orientation);
 
     batch.setPipeline(isFading() ? _transparentPipeline : _opaquePipeline);
 
-    if (_shaderDirty || _uniformsDirty) {
+    if (_uniformsDirty) {
         setupUniforms();
     }
 
-    if (_shaderDirty || _uniformsDirty || _channelsDirty) {
-        setupChannels(_shaderDirty || _uniformsDirty);
+    if (_uniformsDirty || _channelsDirty) {
+        setupChannels(_uniformsDirty);
     }
 
-    _shaderDirty = _uniformsDirty = _channelsDirty = false;
+    _uniformsDirty = _channelsDirty = false;
 
     for (auto lambda : _uniforms) {
         lambda(batch);
@@ -94,8 +94,6 @@ protected:
     NetworkTexturePointer _channels[MAX_PROCEDURAL_TEXTURE_CHANNELS];
     gpu::PipelinePointer _opaquePipeline;
     gpu::PipelinePointer _transparentPipeline;
-    gpu::ShaderPointer _vertexShader;
-    gpu::ShaderPointer _fragmentShader;
     gpu::ShaderPointer _shader;
 
     // Entity metadata
@@ -111,6 +109,9 @@ private:
     bool parseUniforms(const QJsonObject& uniforms);
     bool parseTextures(const QJsonArray& channels);
 
+    // Points the pipelines at the program of the current sources, returns false while a new program waits its turn
+    // to be compiled
+    bool setupProgram();
     void setupUniforms();
     void setupChannels(bool shouldCreate);
 
@@ -13,10 +13,13 @@
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
 
+#include <vector>
+
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QBuffer>
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
 
 using namespace recording;
 
@@ -89,8 +92,65 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
     return true;
 }
 
+template <typename T>
+bool writeValue(QIODevice& output, const T& value) {
+    return output.write((const char*)&value, sizeof(T)) == sizeof(T);
+}
+
+// A chunk is the frames of a stretch of the clip, stored by column:
+//     uint32 frame count, uint16 track count
+//     the type and time of each frame, uncompressed, which is what the clip seeks with
+//     the type and compressed size of each track
+//     each track compressed on its own: the uint32 data size of each of its frames, then their data
+// The frames of one type look alike from one to the next, they compress far better together than one by one.
+bool writeChunk(QIODevice& output, const std::vector<FrameConstPointer>& frames) {
+    std::vector<FrameType> trackTypes;
+    QHash<FrameType, int> trackIndices;
+    std::vector<QByteArray> trackSizes;
+    std::vector<QByteArray> trackData;
+    for (const auto& frame : frames) {
+        auto trackIndex = trackIndices.find(frame->type);
+        if (trackIndex == trackIndices.end()) {
+            trackIndex = trackIndices.insert(frame->type, (int)trackTypes.size());
+            trackTypes.push_back(frame->type);
+            trackSizes.push_back(QByteArray());
+            trackData.push_back(QByteArray());
+        }
+        uint32_t dataSize = frame->data.size();
+        trackSizes[trackIndex.value()].append((const char*)&dataSize, sizeof(dataSize));
+        trackData[trackIndex.value()].append(frame->data);
+    }
+
+    if (!writeValue(output, (uint32_t)frames.size()) || !writeValue(output, (uint16_t)trackTypes.size())) {
+        return false;
+    }
+    for (const auto& frame : frames) {
+        if (!writeValue(output, frame->type) || !writeValue(output, frame->timeOffset)) {
+            return false;
+        }
+    }
+
+    std::vector<QByteArray> tracks;
+    tracks.reserve(trackTypes.size());
+    for (size_t i = 0; i < trackTypes.size(); ++i) {
+        tracks.push_back(qCompress(trackSizes[i] + trackData[i]));
+        if (!writeValue(output, trackTypes[i]) || !writeValue(output, (uint32_t)tracks.back().size())) {
+            return false;
+        }
+    }
+    for (const auto& track : tracks) {
+        if (output.write(track) != track.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::CHUNKED_FRAME_TYPE_MAP = QStringLiteral("chunkedFrameTypes");
+const Frame::Time Clip::MAX_CHUNK_TIME = 2000;
+const uint32_t Clip::MAX_CHUNK_FRAMES = 512;
 
 bool Clip::write(QIODevice& output) {
     auto frameTypes = Frame::getFrameTypes();
@@ -100,9 +160,7 @@ bool Clip::write(QIODevice& output) {
     }
 
     QJsonObject rootObject;
-    rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
-    // Always mark new files as compressed
-    rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    rootObject.insert(CHUNKED_FRAME_TYPE_MAP, frameTypeObj);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
     // Never compress the header frame
     if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
@@ -111,10 +169,20 @@ bool Clip::write(QIODevice& output) {
 
     seek(0);
 
+    std::vector<FrameConstPointer> chunkFrames;
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
-            return false;
+        if (frame->type == Frame::TYPE_INVALID) {
+            qWarning() << "Attempting to write invalid frame";
+            continue;
+        }
+        if (!chunkFrames.empty() && (chunkFrames.size() >= MAX_CHUNK_FRAMES ||
+                frame->timeOffset - chunkFrames.front()->timeOffset >= MAX_CHUNK_TIME)) {
+            if (!writeChunk(output, chunkFrames)) {
+                return false;
+            }
+            chunkFrames.clear();
         }
+        chunkFrames.push_back(frame);
     }
-    return true;
+    return chunkFrames.empty() || writeChunk(output, chunkFrames);
 }
@@ -56,6 +56,10 @@ public:
     
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
+    // The frame type map of a chunked clip, under its own key so older readers turn the file down
+    static const QString CHUNKED_FRAME_TYPE_MAP;
+    static const Frame::Time MAX_CHUNK_TIME;
+    static const uint32_t MAX_CHUNK_FRAMES;
 
 protected:
     friend class WrapperClip;
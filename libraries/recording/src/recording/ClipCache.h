@@ -21,6 +21,7 @@ public:
     using Pointer = std::shared_ptr<NetworkClip>;
 
     NetworkClip(const QUrl& url) : _url(url) {}
+    virtual ~NetworkClip() { waitForPrefetch(); }
     virtual void init(const QByteArray& clipData);
     virtual QString getName() const override { return _url.toString(); }
 
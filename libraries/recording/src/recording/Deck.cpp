@@ -8,6 +8,8 @@
 
 #include "Deck.h"
  
+#include <map>
+
 #include <QtCore/QThread>
 
 #include <NumericalConstants.h>
@@ -31,17 +33,28 @@ void Deck::queueClip(ClipPointer clip, float timeOffset) {
         return;
     }
 
-    // FIXME disabling multiple clips for now
-    _clips.clear();
+    _tracks.clear();
+    addClip(clip, timeOffset);
+}
+
+Deck::TrackID Deck::addClip(ClipPointer clip, float timeOffset) {
+    Locker lock(_mutex);
+
+    if (!clip) {
+        qCWarning(recordingLog) << "Clip invalid, ignoring";
+        return INVALID_TRACK;
+    }
 
     // if the time offset is not zero, wrap in an OffsetClip
     if (timeOffset != 0.0f) {
         clip = std::make_shared<OffsetClip>(clip, timeOffset);
     }
 
-    _clips.push_back(clip);
+    TrackID id = _nextTrackID++;
+    _tracks.push_back({ id, clip });
 
     _length = std::max(_length, clip->duration());
+    return id;
 }
 
 void Deck::play() { 
@@ -65,10 +78,10 @@ void Deck::pause() {
 Clip::Pointer Deck::getNextClip() {
     Clip::Pointer result;
     auto soonestFramePosition = Frame::INVALID_TIME;
-    for (const auto& clip : _clips) {
-        auto nextFramePosition = clip->positionFrameTime();
+    for (const auto& track : _tracks) {
+        auto nextFramePosition = track.clip->positionFrameTime();
         if (nextFramePosition < soonestFramePosition) {
-            result = clip;
+            result = track.clip;
             soonestFramePosition = nextFramePosition;
         }
     }
@@ -83,8 +96,8 @@ void Deck::seek(float position) {
     _startEpoch = Frame::epochForFrameTime(_position);
 
     // reset the clips to the appropriate spot
-    for (auto& clip : _clips) {
-        clip->seekFrameTime(_position);
+    for (auto& track : _tracks) {
+        track.clip->seekFrameTime(_position);
     }
 
     if (!_pause) {
@@ -117,12 +130,14 @@ void Deck::processFrames() {
 
     auto startingPosition = Frame::frameTimeFromEpoch(_startEpoch);
     auto triggerPosition = startingPosition + MIN_FRAME_WAIT_INTERVAL;
-    Clip::Pointer nextClip;
     // FIXME add code to start dropping frames if we fall behind.
     // Alternatively, add code to cache frames here and then process only the last frame of a given type
     // ... the latter will work for Avatar, but not well for audio I suspect.
     bool overLimit = false;
-    for (nextClip = getNextClip(); nextClip; nextClip = getNextClip()) {
+    // every clip is advanced to the trigger position before any frame is handled, so that each handler is called
+    // once per tick with the frames of all the clips, in the order of each clip
+    std::map<FrameType, Frame::TrackFrames> dueFrames;
+    for (auto& track : _tracks) {
         auto currentPosition = Frame::frameTimeFromEpoch(_startEpoch);
         if ((currentPosition - startingPosition) >= MAX_FRAME_PROCESSING_TIME) {
             qCWarning(recordingLog) << "Exceeded maximum frame processing time, breaking early";
@@ -135,15 +150,21 @@ void Deck::processFrames() {
             break;
         }
 
-        // If the clip is too far in the future, just break out of the handling loop
-        Frame::Time framePosition = nextClip->positionFrameTime();
-        if (framePosition > triggerPosition) {
-            break;
+        // Take the frames of the clip up to the trigger position, the rest are in the future
+        while (track.clip->positionFrameTime() <= triggerPosition) {
+            auto frame = track.clip->nextFrame();
+            if (!frame) {
+                break;
+            }
+            dueFrames[frame->type].push_back({ track.id, frame });
         }
-        // Handle the frame and advance the clip
-        Frame::handleFrame(nextClip->nextFrame());
     }
 
+    for (const auto& frames : dueFrames) {
+        Frame::handleFrames(frames.first, frames.second);
+    }
+
+    Clip::Pointer nextClip = getNextClip();
     if (!nextClip) {
         qCDebug(recordingLog) << "No more frames available";
         // No more frames available, so handle the end of playback
@@ -182,26 +203,29 @@ void Deck::processFrames() {
 
 void Deck::removeClip(const ClipConstPointer& clip) {
     Locker lock(_mutex);
-    std::remove_if(_clips.begin(), _clips.end(), [&](const Clip::ConstPointer& testClip)->bool {
-        return (clip == testClip);
+    _tracks.remove_if([&](const Track& track)->bool {
+        return (clip == track.clip);
     });
 }
 
 void Deck::removeClip(const QString& clipName) {
     Locker lock(_mutex);
-    std::remove_if(_clips.begin(), _clips.end(), [&](const Clip::ConstPointer& clip)->bool {
-        return (clip->getName() == clipName);
+    _tracks.remove_if([&](const Track& track)->bool {
+        return (track.clip->getName() == clipName);
     });
 }
 
 void Deck::removeAllClips() {
     Locker lock(_mutex);
-    _clips.clear();
+    _tracks.clear();
 }
 
 Deck::ClipList Deck::getClips(const QString& clipName) const {
     Locker lock(_mutex);
-    ClipList result = _clips;
+    ClipList result;
+    for (const auto& track : _tracks) {
+        result.push_back(track.clip);
+    }
     return result;
 }
 
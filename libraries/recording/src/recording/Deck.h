@@ -31,11 +31,16 @@ class Deck : public QObject, public ::Dependency {
 public:
     using ClipList = std::list<ClipPointer>;
     using Pointer = std::shared_ptr<Deck>;
+    using TrackID = uint32_t;
+    static const TrackID INVALID_TRACK = (TrackID)-1;
 
     Deck(QObject* parent = nullptr);
 
-    // Place a clip on the deck for recording or playback
+    // Place a clip on the deck for recording or playback, in place of the ones on it
     void queueClip(ClipPointer clip, float timeOffset = 0.0f);
+    // Place a clip on the deck to play along with the ones on it. Each tick advances all the clips and hands the frames
+    // that came due to the handlers of their type in one batch, the track tells the batch handlers which clip a frame is from.
+    TrackID addClip(ClipPointer clip, float timeOffset = 0.0f);
     void removeClip(const ClipConstPointer& clip);
     void removeClip(const QString& clipName);
     void removeAllClips();
@@ -65,12 +70,19 @@ private:
     using Mutex = std::recursive_mutex;
     using Locker = std::unique_lock<Mutex>;
 
+    struct Track {
+        TrackID id;
+        ClipPointer clip;
+    };
+    using TrackList = std::list<Track>;
+
     ClipPointer getNextClip();
     void processFrames();
 
     mutable Mutex _mutex;
     QTimer _timer;
-    ClipList _clips;
+    TrackList _tracks;
+    TrackID _nextTrackID { 0 };
     quint64 _startEpoch { 0 };
     Frame::Time _position { 0 };
     bool _pause { true };
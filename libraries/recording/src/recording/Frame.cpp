@@ -71,6 +71,7 @@ private:
 
 static Registry<FrameType, QString> frameTypes;
 static QMap<FrameType, Frame::Handler> handlerMap;
+static QMap<FrameType, Frame::BatchHandler> batchHandlerMap;
 using Mutex = std::mutex;
 using Locker = std::unique_lock<Mutex>;
 static Mutex mutex;
@@ -162,3 +163,46 @@ void Frame::handleFrame(const Frame::ConstPointer& frame) {
     }
     handler(frame);
 }
+
+Frame::BatchHandler Frame::registerBatchHandler(FrameType type, BatchHandler handler) {
+    Locker lock(mutex);
+    BatchHandler result;
+    if (batchHandlerMap.contains(type)) {
+        result = batchHandlerMap[type];
+    }
+    batchHandlerMap[type] = handler;
+    return result;
+}
+
+void Frame::clearBatchHandler(FrameType type) {
+    Locker lock(mutex);
+    batchHandlerMap.remove(type);
+}
+
+void Frame::handleFrames(FrameType type, const TrackFrames& frames) {
+    if (frames.empty()) {
+        return;
+    }
+    BatchHandler batchHandler;
+    Handler handler;
+    {
+        Locker lock(mutex);
+        auto batchIterator = batchHandlerMap.find(type);
+        if (batchIterator != batchHandlerMap.end()) {
+            batchHandler = *batchIterator;
+        } else {
+            auto iterator = handlerMap.find(type);
+            if (iterator == handlerMap.end()) {
+                return;
+            }
+            handler = *iterator;
+        }
+    }
+    if (batchHandler) {
+        batchHandler(frames);
+        return;
+    }
+    for (const auto& frame : frames) {
+        handler(frame.second);
+    }
+}
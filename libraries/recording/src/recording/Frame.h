@@ -13,6 +13,8 @@
 #include "Forward.h"
 
 #include <functional>
+#include <utility>
+#include <vector>
 
 #ifdef Q_OS_WIN
 #include <stdint.h>
@@ -58,6 +60,9 @@ public:
     using Pointer = std::shared_ptr<Frame>;
     using ConstPointer = std::shared_ptr<const Frame>;
     using Handler = std::function<void(Frame::ConstPointer frame)>;
+    // The frames of one type that came due on a tick of a deck, each with the deck track it was played from
+    using TrackFrames = std::vector<std::pair<uint32_t, ConstPointer>>;
+    using BatchHandler = std::function<void(const TrackFrames& frames)>;
 
     QByteArray data;
 
@@ -73,6 +78,12 @@ public:
     static QMap<QString, FrameType> getFrameTypes();
     static QMap<FrameType, QString> getFrameTypeNames();
     static void handleFrame(const ConstPointer& frame);
+
+    // A batch handler of a type takes the place of its frame handler for the frames a deck plays
+    static BatchHandler registerBatchHandler(FrameType type, BatchHandler handler);
+    static void clearBatchHandler(FrameType type);
+    // Without a batch handler, the frames go to the frame handler one by one
+    static void handleFrames(FrameType type, const TrackFrames& frames);
 };
 
 }
@@ -59,6 +59,7 @@ bool FileClip::write(const QString& fileName, Clip::Pointer clip) {
 
 FileClip::~FileClip() {
     Locker lock(_mutex);
+    waitForPrefetch();
     _file.unmap(_data);
     if (_file.isOpen()) {
         _file.close();
@@ -9,10 +9,13 @@
 #include "PointerClip.h"
 
 #include <algorithm>
+#include <condition_variable>
 
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
 
 #include <Finally.h>
 
@@ -25,11 +28,11 @@ using namespace recording;
 
 using FrameTranslationMap = QMap<FrameType, FrameType>;
 
-FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
+FrameTranslationMap parseTranslationMap(const QJsonDocument& doc, const QString& key) {
     FrameTranslationMap results;
     auto headerObj = doc.object();
-    if (headerObj.contains(Clip::FRAME_TYPE_MAP)) {
-        auto frameTypeObj = headerObj[Clip::FRAME_TYPE_MAP].toObject();
+    if (headerObj.contains(key)) {
+        auto frameTypeObj = headerObj[key].toObject();
         auto currentFrameTypes = Frame::getFrameTypes();
         for (auto frameTypeName : frameTypeObj.keys()) {
             qDebug() << frameTypeName;
@@ -45,37 +48,146 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
+bool parseFrameHeader(uchar* const start, uchar*& current, uchar* const end, PointerFrameHeader& header) {
+    if (end - current < PointerClip::MINIMUM_FRAME_SIZE) {
+        return false;
+    }
+    memcpy(&(header.type), current, sizeof(FrameType));
+    current += sizeof(FrameType);
+    memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
+    current += sizeof(Frame::Time);
+    memcpy(&(header.size), current, sizeof(FrameSize));
+    current += sizeof(FrameSize);
+    header.fileOffset = current - start;
+    if (end - current < header.size) {
+        current = end;
+        return false;
+    }
+    current += header.size;
+    return true;
+}
+
+PointerFrameHeaderList parseFrameHeaders(uchar* const start, uchar* current, const size_t& size) {
     PointerFrameHeaderList results;
-    auto current = start;
-    auto end = current + size;
+    auto end = start + size;
     // Read all the frame headers
     // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
-        PointerFrameHeader header;
-        memcpy(&(header.type), current, sizeof(FrameType));
-        current += sizeof(FrameType);
-        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
-        current += sizeof(Frame::Time);
-        memcpy(&(header.size), current, sizeof(FrameSize));
-        current += sizeof(FrameSize);
-        header.fileOffset = current - start;
-        if (end - current < header.size) {
-            current = end;
-            break;
-        }
-        current += header.size;
+    PointerFrameHeader header;
+    while (parseFrameHeader(start, current, end, header)) {
         results.push_back(header);
     }
     qDebug() << "Parsed source data into " << results.size() << " frames";
-//    int i = 0;
-//    for (const auto& frameHeader : results) {
-//        qDebug() << "Frame " << i++ << " time " << frameHeader.timeOffset << " Type " << frameHeader.type;
-//    }
     return results;
 }
 
+template <typename T>
+bool readValue(const uchar*& current, const uchar* end, T& value) {
+    if (end - current < (ptrdiff_t)sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, current, sizeof(T));
+    current += sizeof(T);
+    return true;
+}
+
+namespace recording {
+
+struct DecodedClipChunk {
+    struct Track {
+        QByteArray data;
+        // where each frame starts in the data, and where the last one ends
+        std::vector<uint32_t> offsets;
+    };
+    std::vector<Track> tracks;
+
+    QByteArray getFrameData(uint16_t track, uint32_t trackFrame) const {
+        if (track >= tracks.size() || trackFrame + 1 >= tracks[track].offsets.size()) {
+            return QByteArray();
+        }
+        const auto& offsets = tracks[track].offsets;
+        return tracks[track].data.mid(offsets[trackFrame], offsets[trackFrame + 1] - offsets[trackFrame]);
+    }
+};
+
+struct ClipChunkPrefetch {
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+    uint32_t chunk { 0 };
+    bool finished { false };
+    DecodedClipChunkPointer result;
+};
+
+}
+
+DecodedClipChunkPointer decodeChunk(const uchar* data, const PointerClipChunk& chunk) {
+    auto result = std::make_shared<DecodedClipChunk>();
+    result->tracks.resize(chunk.tracks.size());
+    for (size_t i = 0; i < chunk.tracks.size(); ++i) {
+        const auto& track = chunk.tracks[i];
+        auto& decoded = result->tracks[i];
+        QByteArray column = qUncompress(data + track.fileOffset, track.size);
+        size_t sizesLength = sizeof(uint32_t) * track.frameCount;
+        if ((size_t)column.size() < sizesLength) {
+            qCWarning(recordingLog) << "Corrupt track in clip chunk";
+            continue;
+        }
+        decoded.offsets.reserve(track.frameCount + 1);
+        uint32_t offset = 0;
+        decoded.offsets.push_back(offset);
+        for (uint32_t frame = 0; frame < track.frameCount; ++frame) {
+            uint32_t frameSize;
+            memcpy(&frameSize, column.constData() + sizeof(uint32_t) * frame, sizeof(uint32_t));
+            offset += frameSize;
+            decoded.offsets.push_back(offset);
+        }
+        if (column.size() - sizesLength < offset) {
+            qCWarning(recordingLog) << "Corrupt track in clip chunk";
+            decoded.offsets.clear();
+            continue;
+        }
+        decoded.data = column.mid((int)sizesLength);
+    }
+    return result;
+}
+
+// Decodes chunks ahead of playback off the threads that play, one reader thread for all the clips
+class PrefetchChunkTask : public QRunnable {
+public:
+    PrefetchChunkTask(const std::shared_ptr<ClipChunkPrefetch>& prefetch, const uchar* data, const PointerClipChunk& chunk)
+        : _prefetch(prefetch), _data(data), _chunk(chunk) {}
+
+    void run() override {
+        auto result = decodeChunk(_data, _chunk);
+        std::unique_lock<std::mutex> lock(_prefetch->mutex);
+        _prefetch->result = result;
+        _prefetch->finished = true;
+        _prefetch->finishedCondition.notify_all();
+    }
+
+private:
+    const std::shared_ptr<ClipChunkPrefetch> _prefetch;
+    const uchar* const _data;
+    const PointerClipChunk _chunk;
+};
+
+static QThreadPool* getReaderPool() {
+    static QThreadPool* pool = [] {
+        auto result = new QThreadPool();
+        result->setMaxThreadCount(1);
+        return result;
+    }();
+    return pool;
+}
+
+PointerClip::~PointerClip() {
+    waitForPrefetch();
+}
+
 void PointerClip::reset() {
+    waitForPrefetch();
+    _prefetch.reset();
+    _currentChunk.reset();
+    _chunks.clear();
     _frames.clear();
     _data = nullptr;
     _size = 0;
@@ -88,28 +200,33 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
-    // Verify that at least one frame exists and that the first frame is a header
-    if (0 == parsedFrameHeaders.size()) {
+    // Grab the file header, the first frame
+    auto current = data;
+    PointerFrameHeader fileHeaderFrameHeader;
+    if (!parseFrameHeader(data, current, data + size, fileHeaderFrameHeader)) {
         qWarning() << "No frames found, invalid file";
         reset();
         return;
     }
-
-    // Grab the file header
+    if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
+        qWarning() << "Missing header frame, invalid file";
+        reset();
+        return;
+    }
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
-        if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
-            qWarning() << "Missing header frame, invalid file";
-            reset();
-            return;
-        }
-
         QByteArray fileHeaderData((char*)_data + fileHeaderFrameHeader.fileOffset, fileHeaderFrameHeader.size);
         _header = QJsonDocument::fromBinaryData(fileHeaderData);
     }
 
+    if (_header.object().contains(CHUNKED_FRAME_TYPE_MAP)) {
+        if (!initChunks(current - data)) {
+            reset();
+        }
+        return;
+    }
+
+    auto parsedFrameHeaders = parseFrameHeaders(data, current, size);
+
     // Check for compression
     {
         _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
@@ -117,7 +234,7 @@ void PointerClip::init(uchar* data, size_t size) {
 
     // Find the type enum translation map and fix up the frame headers
     {
-        FrameTranslationMap translationMap = parseTranslationMap(_header);
+        FrameTranslationMap translationMap = parseTranslationMap(_header, FRAME_TYPE_MAP);
         if (translationMap.empty()) {
             qWarning() << "Header missing frame type map, invalid file";
             reset();
@@ -137,6 +254,116 @@ void PointerClip::init(uchar* data, size_t size) {
 
 }
 
+// The frame table of each chunk is read up front, so seeking never touches the compressed tracks
+bool PointerClip::initChunks(size_t offset) {
+    FrameTranslationMap translationMap = parseTranslationMap(_header, CHUNKED_FRAME_TYPE_MAP);
+    if (translationMap.empty()) {
+        qWarning() << "Header missing frame type map, invalid file";
+        return false;
+    }
+
+    const uchar* current = _data + offset;
+    const uchar* end = _data + _size;
+    std::vector<FrameType> trackTypes;
+    std::vector<uint32_t> trackFrameCounts;
+    while (current < end) {
+        uint32_t frameCount;
+        uint16_t trackCount;
+        if (!readValue(current, end, frameCount) || !readValue(current, end, trackCount)) {
+            qWarning() << "Truncated chunk, invalid file";
+            return false;
+        }
+
+        const uchar* frameTable = current;
+        if ((size_t)(end - current) < (size_t)frameCount * (sizeof(FrameType) + sizeof(Frame::Time))) {
+            qWarning() << "Truncated chunk, invalid file";
+            return false;
+        }
+        current += (size_t)frameCount * (sizeof(FrameType) + sizeof(Frame::Time));
+
+        PointerClipChunk chunk;
+        chunk.tracks.resize(trackCount);
+        trackTypes.resize(trackCount);
+        trackFrameCounts.assign(trackCount, 0);
+        for (uint16_t i = 0; i < trackCount; ++i) {
+            if (!readValue(current, end, trackTypes[i]) || !readValue(current, end, chunk.tracks[i].size)) {
+                qWarning() << "Truncated chunk, invalid file";
+                return false;
+            }
+        }
+        for (auto& track : chunk.tracks) {
+            if ((size_t)(end - current) < track.size) {
+                qWarning() << "Truncated chunk, invalid file";
+                return false;
+            }
+            track.fileOffset = current - _data;
+            current += track.size;
+        }
+
+        uint32_t chunkIndex = (uint32_t)_chunks.size();
+        for (uint32_t i = 0; i < frameCount; ++i) {
+            PointerFrameHeader header;
+            readValue(frameTable, end, header.type);
+            readValue(frameTable, end, header.timeOffset);
+            auto track = std::find(trackTypes.begin(), trackTypes.end(), header.type);
+            if (track == trackTypes.end()) {
+                qWarning() << "Frame without a track in chunk, invalid file";
+                return false;
+            }
+            header.chunk = chunkIndex;
+            header.track = (uint16_t)(track - trackTypes.begin());
+            header.trackFrame = trackFrameCounts[header.track]++;
+            header.size = 0;
+            header.fileOffset = 0;
+            if (!translationMap.contains(header.type)) {
+                continue;
+            }
+            header.type = translationMap[header.type];
+            _frames.push_back(header);
+        }
+        for (size_t i = 0; i < chunk.tracks.size(); ++i) {
+            chunk.tracks[i].frameCount = trackFrameCounts[i];
+        }
+        _chunks.push_back(chunk);
+    }
+    qDebug() << "Parsed source data into " << _frames.size() << " frames in " << _chunks.size() << " chunks";
+    return true;
+}
+
+void PointerClip::waitForPrefetch() const {
+    if (!_prefetch) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_prefetch->mutex);
+    _prefetch->finishedCondition.wait(lock, [&] { return _prefetch->finished; });
+}
+
+DecodedClipChunkPointer PointerClip::getChunk(uint32_t chunk) const {
+    if (!_currentChunk || _currentChunkIndex != chunk) {
+        DecodedClipChunkPointer decoded;
+        if (_prefetch) {
+            waitForPrefetch();
+            if (_prefetch->chunk == chunk) {
+                decoded = _prefetch->result;
+            }
+            _prefetch.reset();
+        }
+        // after a seek, the chunk wasn't read ahead
+        if (!decoded) {
+            decoded = decodeChunk(_data, _chunks[chunk]);
+        }
+        _currentChunk = decoded;
+        _currentChunkIndex = chunk;
+
+        if (chunk + 1 < _chunks.size()) {
+            _prefetch = std::make_shared<ClipChunkPrefetch>();
+            _prefetch->chunk = chunk + 1;
+            getReaderPool()->start(new PrefetchChunkTask(_prefetch, _data, _chunks[chunk + 1]));
+        }
+    }
+    return _currentChunk;
+}
+
 // Internal only function, needs no locking
 FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
     FramePointer result;
@@ -145,7 +372,9 @@ FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
         const auto& header = _frames[frameIndex];
         result->type = header.type;
         result->timeOffset = header.timeOffset;
-        if (header.size) {
+        if (!_chunks.empty()) {
+            result->data = getChunk(header.chunk)->getFrameData(header.track, header.trackFrame);
+        } else if (header.size) {
             result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
             if (_compressed) {
                 result->data = qUncompress(result->data);
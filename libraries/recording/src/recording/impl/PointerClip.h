@@ -13,6 +13,7 @@
 #include "ArrayClip.h"
 
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QJsonDocument>
 
@@ -25,16 +26,36 @@ struct PointerFrameHeader : public FrameHeader {
     Frame::Time timeOffset;
     uint16_t size;
     quint64 fileOffset;
+    // in a chunked clip, where in its chunk the frame data is instead of the file offset
+    uint32_t chunk { 0 };
+    uint16_t track { 0 };
+    uint32_t trackFrame { 0 };
 };
 
 using PointerFrameHeaderList = std::list<PointerFrameHeader>;
 
+// The compressed column of the frames of one type in a chunk
+struct PointerClipTrack {
+    quint64 fileOffset;
+    uint32_t size;
+    uint32_t frameCount;
+};
+
+struct PointerClipChunk {
+    std::vector<PointerClipTrack> tracks;
+};
+
+struct DecodedClipChunk;
+using DecodedClipChunkPointer = std::shared_ptr<const DecodedClipChunk>;
+struct ClipChunkPrefetch;
+
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
     using Pointer = std::shared_ptr<PointerClip>;
 
     PointerClip() {};
     PointerClip(uchar* data, size_t size) { init(data, size); }
+    virtual ~PointerClip();
 
     void init(uchar* data, size_t size);
     virtual void addFrame(FrameConstPointer) override;
@@ -47,10 +68,23 @@ public:
 protected:
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
+    // Has to be called before the data goes away, the reader thread may still be decoding a chunk of it
+    void waitForPrefetch() const;
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+
+private:
+    bool initChunks(size_t offset);
+    DecodedClipChunkPointer getChunk(uint32_t chunk) const;
+
+    std::vector<PointerClipChunk> _chunks;
+    // the chunk the last frame was read from, and the one after it which the reader thread decodes ahead of playback
+    mutable DecodedClipChunkPointer _currentChunk;
+    mutable uint32_t _currentChunkIndex { 0 };
+    mutable std::shared_ptr<ClipChunkPrefetch> _prefetch;
 };
 
 }
@@ -33,6 +33,8 @@
 #include "ssao_debugOcclusion_frag.h"
 #include "ssao_makeHorizontalBlur_frag.h"
 #include "ssao_makeVerticalBlur_frag.h"
+#include "ssao_accumulate_frag.h"
+#include "ssao_upsample_frag.h"
 
 
 AmbientOcclusionFramebuffer::AmbientOcclusionFramebuffer() {
@@ -58,11 +60,24 @@ void AmbientOcclusionFramebuffer::updateLinearDepth(const gpu::TexturePointer& l
     }
 }
 
+void AmbientOcclusionFramebuffer::updateFullFrameSize(const glm::ivec2& fullFrameSize) {
+    if (_fullFrameSize != fullFrameSize) {
+        _fullFrameSize = fullFrameSize;
+        _occlusionUpsampledFramebuffer.reset();
+        _occlusionUpsampledTexture.reset();
+    }
+}
+
 void AmbientOcclusionFramebuffer::clear() {
     _occlusionFramebuffer.reset();
     _occlusionTexture.reset();
     _occlusionBlurredFramebuffer.reset();
     _occlusionBlurredTexture.reset();
+    for (int i = 0; i < 2; i++) {
+        _occlusionHistoryFramebuffers[i].reset();
+        _occlusionHistoryTextures[i].reset();
+    }
+    _isHistoryValid = false;
 }
 
 gpu::TexturePointer AmbientOcclusionFramebuffer::getLinearDepthTexture() {
@@ -83,6 +98,21 @@ void AmbientOcclusionFramebuffer::allocate() {
     _occlusionBlurredFramebuffer->setRenderBuffer(0, _occlusionBlurredTexture);
 }
 
+void AmbientOcclusionFramebuffer::allocateHistory() {
+    for (int i = 0; i < 2; i++) {
+        _occlusionHistoryTextures[i] = gpu::TexturePointer(gpu::Texture::create2D(gpu::Element::COLOR_RGBA_32, _frameSize.x, _frameSize.y, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_LINEAR_MIP_POINT)));
+        _occlusionHistoryFramebuffers[i] = gpu::FramebufferPointer(gpu::Framebuffer::create());
+        _occlusionHistoryFramebuffers[i]->setRenderBuffer(0, _occlusionHistoryTextures[i]);
+    }
+    _isHistoryValid = false;
+}
+
+void AmbientOcclusionFramebuffer::allocateUpsampled() {
+    _occlusionUpsampledTexture = gpu::TexturePointer(gpu::Texture::create2D(gpu::Element::COLOR_RGBA_32, _fullFrameSize.x, _fullFrameSize.y, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_LINEAR_MIP_POINT)));
+    _occlusionUpsampledFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create());
+    _occlusionUpsampledFramebuffer->setRenderBuffer(0, _occlusionUpsampledTexture);
+}
+
 gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionFramebuffer() {
     if (!_occlusionFramebuffer) {
         allocate();
@@ -111,6 +141,41 @@ gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionBlurredTexture() {
     return _occlusionBlurredTexture;
 }
 
+gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionHistoryFramebuffer(int index) {
+    if (!_occlusionHistoryFramebuffers[index]) {
+        allocateHistory();
+    }
+    return _occlusionHistoryFramebuffers[index];
+}
+
+gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionHistoryTexture(int index) {
+    if (!_occlusionHistoryTextures[index]) {
+        allocateHistory();
+    }
+    return _occlusionHistoryTextures[index];
+}
+
+gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionUpsampledFramebuffer() {
+    if (!_occlusionUpsampledFramebuffer) {
+        allocateUpsampled();
+    }
+    return _occlusionUpsampledFramebuffer;
+}
+
+gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionUpsampledTexture() {
+    if (!_occlusionUpsampledTexture) {
+        allocateUpsampled();
+    }
+    return _occlusionUpsampledTexture;
+}
+
+gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionResultTexture() {
+    if (!_occlusionResultTexture) {
+        return getOcclusionTexture();
+    }
+    return _occlusionResultTexture;
+}
+
 
 class GaussianDistribution {
 public:
@@ -172,6 +237,8 @@ const int AmbientOcclusionEffect_ParamsSlot = 1;
 const int AmbientOcclusionEffect_CameraCorrectionSlot = 2;
 const int AmbientOcclusionEffect_LinearDepthMapSlot = 0;
 const int AmbientOcclusionEffect_OcclusionMapSlot = 0;
+const int AmbientOcclusionEffect_OcclusionHistoryMapSlot = 1;
+const int AmbientOcclusionEffect_FullLinearDepthMapSlot = 1;
 
 AmbientOcclusionEffect::AmbientOcclusionEffect() {
 }
@@ -258,6 +325,17 @@ void AmbientOcclusionEffect::configure(const Config& config) {
     if (shouldUpdateGaussian) {
         updateGaussianDistribution();
     }
+
+    if (config.temporalEnabled != _isTemporalEnabled) {
+        _isTemporalEnabled = config.temporalEnabled;
+        // the taps only turn from frame to frame when they are accumulated
+        _parametersBuffer->ditheringInfo.y = 0.0f;
+    }
+    _temporalBlend = config.temporalBlend;
+    _isUpsampleEnabled = config.upsampleEnabled;
+
+    // the history was left behind by the frames the effect was off or set differently
+    _framebuffer->_isHistoryValid = false;
 }
 
 const gpu::PipelinePointer& AmbientOcclusionEffect::getOcclusionPipeline() {
@@ -333,6 +411,54 @@ const gpu::PipelinePointer& AmbientOcclusionEffect::getVBlurPipeline() {
     return _vBlurPipeline;
 }
 
+const gpu::PipelinePointer& AmbientOcclusionEffect::getAccumulatePipeline() {
+    if (!_accumulatePipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawViewportQuadTransformTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(ssao_accumulate_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("deferredFrameTransformBuffer"), AmbientOcclusionEffect_FrameTransformSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("cameraCorrectionBuffer"), AmbientOcclusionEffect_CameraCorrectionSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("ambientOcclusionParamsBuffer"), AmbientOcclusionEffect_ParamsSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("occlusionMap"), AmbientOcclusionEffect_OcclusionMapSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("occlusionHistoryMap"), AmbientOcclusionEffect_OcclusionHistoryMapSlot));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+
+        state->setColorWriteMask(true, true, true, false);
+
+        // Good to go add the brand new pipeline
+        _accumulatePipeline = gpu::Pipeline::create(program, state);
+    }
+    return _accumulatePipeline;
+}
+
+const gpu::PipelinePointer& AmbientOcclusionEffect::getUpsamplePipeline() {
+    if (!_upsamplePipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawViewportQuadTransformTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(ssao_upsample_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("deferredFrameTransformBuffer"), AmbientOcclusionEffect_FrameTransformSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("cameraCorrectionBuffer"), AmbientOcclusionEffect_CameraCorrectionSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("ambientOcclusionParamsBuffer"), AmbientOcclusionEffect_ParamsSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("occlusionMap"), AmbientOcclusionEffect_OcclusionMapSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("linearDepthMap"), AmbientOcclusionEffect_FullLinearDepthMapSlot));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+
+        state->setColorWriteMask(true, true, true, false);
+
+        // Good to go add the brand new pipeline
+        _upsamplePipeline = gpu::Pipeline::create(program, state);
+    }
+    return _upsamplePipeline;
+}
+
 void AmbientOcclusionEffect::updateGaussianDistribution() {
     auto coefs = _parametersBuffer->_gaussianCoefs;
     GaussianDistribution::evalSampling(coefs, Parameters::GAUSSIAN_COEFS_LENGTH, _parametersBuffer->getBlurRadius(), _parametersBuffer->getBlurDeviation());
@@ -361,6 +487,8 @@ void AmbientOcclusionEffect::run(const render::SceneContextPointer& sceneContext
     }
 
     _framebuffer->updateLinearDepth(linearDepthTexture);
+    auto fullLinearDepthTexture = linearDepthFramebuffer->getLinearDepthTexture();
+    _framebuffer->updateFullFrameSize(glm::ivec2(fullLinearDepthTexture->getDimensions()));
   
     
     auto occlusionFBO = _framebuffer->getOcclusionFramebuffer();
@@ -380,6 +508,39 @@ void AmbientOcclusionEffect::run(const render::SceneContextPointer& sceneContext
     auto occlusionPipeline = getOcclusionPipeline();
     auto firstHBlurPipeline = getHBlurPipeline();
     auto lastVBlurPipeline = getVBlurPipeline();
+
+    // Accumulate the occlusion of the frame into the one of the previous frames, reprojected, so fewer taps turning
+    // every frame converge to as many
+    bool isAccumulated = _isTemporalEnabled;
+    gpu::FramebufferPointer historyFBO;
+    gpu::TexturePointer previousHistoryTexture;
+    auto resultTexture = occlusionFBO->getRenderBuffer(0);
+    if (isAccumulated) {
+        const float GOLDEN_ANGLE = 2.39996323f;
+        const float TWO_PI = 6.28318531f;
+        _frameIndex = (_frameIndex + 1) % 1024;
+        _parametersBuffer->ditheringInfo.y = fmodf(_frameIndex * GOLDEN_ANGLE, TWO_PI);
+        // without a history the frame starts it alone
+        _parametersBuffer->blurInfo.w = _framebuffer->_isHistoryValid ? _temporalBlend : 1.0f;
+
+        previousHistoryTexture = _framebuffer->getOcclusionHistoryTexture(_framebuffer->_historyIndex);
+        _framebuffer->_historyIndex = 1 - _framebuffer->_historyIndex;
+        historyFBO = _framebuffer->getOcclusionHistoryFramebuffer(_framebuffer->_historyIndex);
+        resultTexture = historyFBO->getRenderBuffer(0);
+        _framebuffer->_isHistoryValid = true;
+    }
+
+    // Bring the lower resolution back to the full frame, weighting the nearest texels by how close their depth is
+    bool isUpsampled = _isUpsampleEnabled && (_parametersBuffer->getResolutionLevel() > 0);
+    gpu::FramebufferPointer upsampledFBO;
+    gpu::TexturePointer lowResolutionTexture = resultTexture;
+    if (isUpsampled) {
+        upsampledFBO = _framebuffer->getOcclusionUpsampledFramebuffer();
+        resultTexture = upsampledFBO->getRenderBuffer(0);
+    }
+    _framebuffer->_occlusionResultTexture = resultTexture;
+    auto accumulatePipeline = (isAccumulated ? getAccumulatePipeline() : gpu::PipelinePointer());
+    auto upsamplePipeline = (isUpsampled ? getUpsamplePipeline() : gpu::PipelinePointer());
     
     gpu::doInBatch(args->_context, [=](gpu::Batch& batch) {
         batch.enableStereo(false);
@@ -423,7 +584,26 @@ void AmbientOcclusionEffect::run(const render::SceneContextPointer& sceneContext
             batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, occlusionBlurredFBO->getRenderBuffer(0));
             batch.draw(gpu::TRIANGLE_STRIP, 4);
         }
-        
+
+        if (isAccumulated) {
+            batch.setFramebuffer(historyFBO);
+            batch.setPipeline(accumulatePipeline);
+            batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, occlusionFBO->getRenderBuffer(0));
+            batch.setResourceTexture(AmbientOcclusionEffect_OcclusionHistoryMapSlot, previousHistoryTexture);
+            batch.draw(gpu::TRIANGLE_STRIP, 4);
+            batch.setResourceTexture(AmbientOcclusionEffect_OcclusionHistoryMapSlot, nullptr);
+        }
+
+        if (isUpsampled) {
+            batch.setViewportTransform(sourceViewport);
+            batch.setModelTransform(Transform());
+            batch.setFramebuffer(upsampledFBO);
+            batch.setPipeline(upsamplePipeline);
+            batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, lowResolutionTexture);
+            batch.setResourceTexture(AmbientOcclusionEffect_FullLinearDepthMapSlot, fullLinearDepthTexture);
+            batch.draw(gpu::TRIANGLE_STRIP, 4);
+            batch.setResourceTexture(AmbientOcclusionEffect_FullLinearDepthMapSlot, nullptr);
+        }
         
         batch.setResourceTexture(AmbientOcclusionEffect_LinearDepthMapSlot, nullptr);
         batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, nullptr);
@@ -29,15 +29,30 @@ public:
     
     gpu::FramebufferPointer getOcclusionBlurredFramebuffer();
     gpu::TexturePointer getOcclusionBlurredTexture();
+
+    // The occlusion accumulated over the frames, one is written from the other of the previous frame
+    gpu::FramebufferPointer getOcclusionHistoryFramebuffer(int index);
+    gpu::TexturePointer getOcclusionHistoryTexture(int index);
+
+    // The occlusion brought back to the full frame size from a lower resolution level
+    gpu::FramebufferPointer getOcclusionUpsampledFramebuffer();
+    gpu::TexturePointer getOcclusionUpsampledTexture();
+
+    // The texture the lighting reads the occlusion of the frame from, the last one written by the effect
+    gpu::TexturePointer getOcclusionResultTexture();
     
     // Update the source framebuffer size which will drive the allocation of all the other resources.
     void updateLinearDepth(const gpu::TexturePointer& linearDepthBuffer);
+    // Update the size of the full frame the occlusion is upsampled to
+    void updateFullFrameSize(const glm::ivec2& fullFrameSize);
     gpu::TexturePointer getLinearDepthTexture();
     const glm::ivec2& getSourceFrameSize() const { return _frameSize; }
         
 protected:
     void clear();
     void allocate();
+    void allocateHistory();
+    void allocateUpsampled();
     
     gpu::TexturePointer _linearDepthTexture;
     
@@ -46,9 +61,21 @@ protected:
     
     gpu::FramebufferPointer _occlusionBlurredFramebuffer;
     gpu::TexturePointer _occlusionBlurredTexture;
-    
+
+    gpu::FramebufferPointer _occlusionHistoryFramebuffers[2];
+    gpu::TexturePointer _occlusionHistoryTextures[2];
+    int _historyIndex { 0 };
+    bool _isHistoryValid { false };
+
+    gpu::FramebufferPointer _occlusionUpsampledFramebuffer;
+    gpu::TexturePointer _occlusionUpsampledTexture;
+
+    gpu::TexturePointer _occlusionResultTexture;
     
     glm::ivec2 _frameSize;
+    glm::ivec2 _fullFrameSize;
+
+    friend class AmbientOcclusionEffect;
 };
 
 using AmbientOcclusionFramebufferPointer = std::shared_ptr<AmbientOcclusionFramebuffer>;
@@ -68,6 +95,9 @@ class AmbientOcclusionEffectConfig : public render::GPUJobConfig::Persistent {
     Q_PROPERTY(int numSamples MEMBER numSamples WRITE setNumSamples)
     Q_PROPERTY(int resolutionLevel MEMBER resolutionLevel WRITE setResolutionLevel)
     Q_PROPERTY(int blurRadius MEMBER blurRadius WRITE setBlurRadius)
+    Q_PROPERTY(bool temporalEnabled MEMBER temporalEnabled NOTIFY dirty)
+    Q_PROPERTY(float temporalBlend MEMBER temporalBlend WRITE setTemporalBlend)
+    Q_PROPERTY(bool upsampleEnabled MEMBER upsampleEnabled NOTIFY dirty)
 
 public:
     AmbientOcclusionEffectConfig() : render::GPUJobConfig::Persistent("Ambient Occlusion", false) {}
@@ -84,6 +114,7 @@ public:
     void setNumSamples(int samples) { numSamples = std::max(1.0f, (float)samples); emit dirty(); }
     void setResolutionLevel(int level) { resolutionLevel = std::max(0, std::min(level, MAX_RESOLUTION_LEVEL)); emit dirty(); }
     void setBlurRadius(int radius) { blurRadius = std::max(0, std::min(MAX_BLUR_RADIUS, radius)); emit dirty(); }
+    void setTemporalBlend(float blend) { temporalBlend = std::max(0.01f, std::min(blend, 1.0f)); emit dirty(); }
 
     float radius{ 0.5f };
     float perspectiveScale{ 1.0f };
@@ -98,6 +129,9 @@ public:
     bool ditheringEnabled{ true }; // randomize the distribution of taps per pixel, should always be true
     bool borderingEnabled{ true }; // avoid evaluating information from non existing pixels out of the frame, should always be true
     bool fetchMipsEnabled{ true }; // fetch taps in sub mips to otpimize cache, should always be true
+    bool temporalEnabled{ false }; // rotate the taps every frame and accumulate the occlusion reprojected from the previous frames
+    float temporalBlend{ 0.1f }; // the part of the occlusion of the frame in the accumulated one
+    bool upsampleEnabled{ false }; // bring a lower resolution level back to the full frame respecting the depth edges
 
 signals:
     void dirty();
@@ -147,7 +181,7 @@ public:
         glm::vec4 ditheringInfo { 0.0f, 0.0f, 0.01f, 1.0f };
         // Sampling info
         glm::vec4 sampleInfo { 11.0f, 1.0f/11.0f, 7.0f, 1.0f };
-        // Blurring info
+        // Blurring info is { edge sharpness, blur radius, blur deviation, temporal blend }
         glm::vec4 blurInfo { 1.0f, 3.0f, 2.0f, 0.0f };
          // gaussian distribution coefficients first is the sampling radius (max is 6)
         const static int GAUSSIAN_COEFS_LENGTH = 8;
@@ -162,6 +196,7 @@ public:
         float getFalloffBias() const { return (float)ditheringInfo.z; }
         float getEdgeSharpness() const { return (float)blurInfo.x; }
         float getBlurDeviation() const { return blurInfo.z; }
+        float getTemporalBlend() const { return blurInfo.w; }
         
         float getNumSpiralTurns() const { return sampleInfo.z; }
         int getNumSamples() const { return (int)sampleInfo.x; }
@@ -181,10 +216,19 @@ private:
     const gpu::PipelinePointer& getOcclusionPipeline();
     const gpu::PipelinePointer& getHBlurPipeline(); // first
     const gpu::PipelinePointer& getVBlurPipeline(); // second
+    const gpu::PipelinePointer& getAccumulatePipeline();
+    const gpu::PipelinePointer& getUpsamplePipeline();
 
     gpu::PipelinePointer _occlusionPipeline;
     gpu::PipelinePointer _hBlurPipeline;
     gpu::PipelinePointer _vBlurPipeline;
+    gpu::PipelinePointer _accumulatePipeline;
+    gpu::PipelinePointer _upsamplePipeline;
+
+    bool _isTemporalEnabled { false };
+    float _temporalBlend { 0.1f };
+    bool _isUpsampleEnabled { false };
+    int _frameIndex { 0 };
 
     AmbientOcclusionFramebufferPointer _framebuffer;
     
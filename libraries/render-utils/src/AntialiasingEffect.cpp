@@ -146,8 +146,9 @@ void Antialiasing::run(const render::SceneContextPointer& sceneContext, const re
         glm::vec4 color(0.0f, 0.0f, 0.0f, 1.0f);
         glm::vec2 bottomLeft(-1.0f, -1.0f);
         glm::vec2 topRight(1.0f, 1.0f);
-        glm::vec2 texCoordTopLeft(0.0f, 0.0f);
-        glm::vec2 texCoordBottomRight(1.0f, 1.0f);
+        // the viewport may only be a corner of the framebuffer
+        glm::vec2 texCoordTopLeft(args->_viewport.x / fbWidth, args->_viewport.y / fbHeight);
+        glm::vec2 texCoordBottomRight((args->_viewport.x + args->_viewport.z) / fbWidth, (args->_viewport.y + args->_viewport.w) / fbHeight);
         DependencyManager::get<GeometryCache>()->renderQuad(batch, bottomLeft, topRight, texCoordTopLeft, texCoordBottomRight, color);
 
 
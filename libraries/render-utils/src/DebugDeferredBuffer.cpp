@@ -411,7 +411,7 @@ void DebugDeferredBuffer::run(const SceneContextPointer& sceneContext, const Ren
 			batch.setResourceTexture(Lighting, deferredFramebuffer->getLightingTexture());
 		}
 		if (!lightStage.lights.empty()) {
-			batch.setResourceTexture(Shadow, lightStage.lights[0]->shadow.framebuffer->getDepthStencilBuffer());
+			batch.setResourceTexture(Shadow, lightStage.lights[0]->shadow.getCascade(0).map);
 		}
 
 		if (linearDepthTarget) {
@@ -31,6 +31,10 @@ void DeferredFrameTransform::update(RenderArgs* args) {
 
     //_parametersBuffer.edit<Parameters>()._ditheringInfo.y += 0.25f;
 
+    frameTransformBuffer.previousView = frameTransformBuffer.view;
+    frameTransformBuffer.previousProjection[0] = frameTransformBuffer.projection[0];
+    frameTransformBuffer.previousProjection[1] = frameTransformBuffer.projection[1];
+
     Transform cameraTransform;
     args->getViewFrustum().evalViewTransform(cameraTransform);
     cameraTransform.getMatrix(frameTransformBuffer.invView);
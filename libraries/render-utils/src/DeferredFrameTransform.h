@@ -51,6 +51,9 @@ protected:
         glm::mat4 invView;
         // View matrix from world space to eye space (mono)
         glm::mat4 view;
+        // The view and the side projections of the previous frame, to reproject into it
+        glm::mat4 previousView;
+        glm::mat4 previousProjection[2];
 
         FrameTransform() {}
     };
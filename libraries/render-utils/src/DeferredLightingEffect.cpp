@@ -37,6 +37,7 @@
 
 #include "point_light_frag.h"
 #include "spot_light_frag.h"
+#include "clustered_light_frag.h"
 
 using namespace render;
 
@@ -64,6 +65,8 @@ enum DeferredShader_MapSlot {
     DEFERRED_BUFFER_DIFFUSED_CURVATURE_UNIT,
     SCATTERING_LUT_UNIT,
     SCATTERING_SPECULAR_UNIT,
+    SHADOW_MAP_1_UNIT,
+    SHADOW_MAP_2_UNIT,
 };
 enum DeferredShader_BufferSlot {
     DEFERRED_FRAME_TRANSFORM_BUFFER_SLOT = 0,
@@ -71,6 +74,9 @@ enum DeferredShader_BufferSlot {
     SCATTERING_PARAMETERS_BUFFER_SLOT,
     LIGHTING_MODEL_BUFFER_SLOT = render::ShapePipeline::Slot::LIGHTING_MODEL,
     LIGHT_GPU_SLOT = render::ShapePipeline::Slot::LIGHT,
+    CLUSTER_GRID_BUFFER_SLOT,
+    CLUSTER_CONTENT_BUFFER_SLOT,
+    CLUSTER_LIGHT_BUFFER_SLOT,
 };
 
 static void loadLightProgram(const char* vertSource, const char* fragSource, bool lightVolume, gpu::PipelinePointer& program, LightLocationsPtr& locations);
@@ -86,6 +92,7 @@ void DeferredLightingEffect::init() {
 
     _pointLightLocations = std::make_shared<LightLocations>();
     _spotLightLocations = std::make_shared<LightLocations>();
+    _clusteredLightLocations = std::make_shared<LightLocations>();
 
     loadLightProgram(deferred_light_vert, directional_light_frag, false, _directionalLight, _directionalLightLocations);
     loadLightProgram(deferred_light_vert, directional_ambient_light_frag, false, _directionalAmbientSphereLight, _directionalAmbientSphereLightLocations);
@@ -97,6 +104,7 @@ void DeferredLightingEffect::init() {
 
     loadLightProgram(deferred_light_limited_vert, point_light_frag, true, _pointLight, _pointLightLocations);
     loadLightProgram(deferred_light_spot_vert, spot_light_frag, true, _spotLight, _spotLightLocations);
+    loadLightProgram(deferred_light_vert, clustered_light_frag, false, _clusteredLight, _clusteredLightLocations);
 
     // Allocate a global light representing the Global Directional light casting shadow (the sun) and the ambient light
     _globalLights.push_back(0);
@@ -174,6 +182,8 @@ static void loadLightProgram(const char* vertSource, const char* fragSource, boo
     slotBindings.insert(gpu::Shader::Binding(std::string("depthMap"), DEFERRED_BUFFER_DEPTH_UNIT));
     slotBindings.insert(gpu::Shader::Binding(std::string("obscuranceMap"), DEFERRED_BUFFER_OBSCURANCE_UNIT));
     slotBindings.insert(gpu::Shader::Binding(std::string("shadowMap"), SHADOW_MAP_UNIT));
+    slotBindings.insert(gpu::Shader::Binding(std::string("shadowMap1"), SHADOW_MAP_1_UNIT));
+    slotBindings.insert(gpu::Shader::Binding(std::string("shadowMap2"), SHADOW_MAP_2_UNIT));
     slotBindings.insert(gpu::Shader::Binding(std::string("skyboxMap"), SKYBOX_MAP_UNIT));
 
     slotBindings.insert(gpu::Shader::Binding(std::string("curvatureMap"), DEFERRED_BUFFER_CURVATURE_UNIT));
@@ -187,6 +197,9 @@ static void loadLightProgram(const char* vertSource, const char* fragSource, boo
     slotBindings.insert(gpu::Shader::Binding(std::string("lightingModelBuffer"), LIGHTING_MODEL_BUFFER_SLOT));
     slotBindings.insert(gpu::Shader::Binding(std::string("subsurfaceScatteringParametersBuffer"), SCATTERING_PARAMETERS_BUFFER_SLOT));
     slotBindings.insert(gpu::Shader::Binding(std::string("lightBuffer"), LIGHT_GPU_SLOT));
+    slotBindings.insert(gpu::Shader::Binding(std::string("clusterGridBuffer"), CLUSTER_GRID_BUFFER_SLOT));
+    slotBindings.insert(gpu::Shader::Binding(std::string("clusterContentBuffer"), CLUSTER_CONTENT_BUFFER_SLOT));
+    slotBindings.insert(gpu::Shader::Binding(std::string("clusterLightBuffer"), CLUSTER_LIGHT_BUFFER_SLOT));
     
 
     gpu::Shader::makeProgram(*program, slotBindings);
@@ -434,7 +447,7 @@ void RenderDeferredSetup::run(const render::SceneContextPointer& sceneContext, c
         
         // FIXME: Different render modes should have different tasks
         if (args->_renderMode == RenderArgs::DEFAULT_RENDER_MODE && deferredLightingEffect->isAmbientOcclusionEnabled()) {
-            batch.setResourceTexture(DEFERRED_BUFFER_OBSCURANCE_UNIT, ambientOcclusionFramebuffer->getOcclusionTexture());
+            batch.setResourceTexture(DEFERRED_BUFFER_OBSCURANCE_UNIT, ambientOcclusionFramebuffer->getOcclusionResultTexture());
         } else {
             // need to assign the white texture if ao is off
             batch.setResourceTexture(DEFERRED_BUFFER_OBSCURANCE_UNIT, textureCache->getWhiteTexture());
@@ -462,8 +475,10 @@ void RenderDeferredSetup::run(const render::SceneContextPointer& sceneContext, c
         assert(deferredLightingEffect->getLightStage().lights.size() > 0);
         const auto& globalShadow = deferredLightingEffect->getLightStage().lights[0]->shadow;
 
-        // Bind the shadow buffer
-        batch.setResourceTexture(SHADOW_MAP_UNIT, globalShadow.map);
+        // Bind the shadow buffers
+        batch.setResourceTexture(SHADOW_MAP_UNIT, globalShadow.getCascade(0).map);
+        batch.setResourceTexture(SHADOW_MAP_1_UNIT, globalShadow.getCascade(1).map);
+        batch.setResourceTexture(SHADOW_MAP_2_UNIT, globalShadow.getCascade(2).map);
 
         auto& program = deferredLightingEffect->_shadowMapEnabled ? deferredLightingEffect->_directionalLightShadow : deferredLightingEffect->_directionalLight;
         LightLocationsPtr locations = deferredLightingEffect->_shadowMapEnabled ? deferredLightingEffect->_directionalLightShadowLocations : deferredLightingEffect->_directionalLightLocations;
@@ -511,6 +526,8 @@ void RenderDeferredSetup::run(const render::SceneContextPointer& sceneContext, c
             batch.setResourceTexture(SKYBOX_MAP_UNIT, nullptr);
         }
         batch.setResourceTexture(SHADOW_MAP_UNIT, nullptr);
+        batch.setResourceTexture(SHADOW_MAP_1_UNIT, nullptr);
+        batch.setResourceTexture(SHADOW_MAP_2_UNIT, nullptr);
     });
     
 }
@@ -566,6 +583,34 @@ void RenderDeferredLocals::run(const render::SceneContextPointer& sceneContext,
         batch.setProjectionTransform(monoProjMat);
         batch.setViewTransform(monoViewTransform, true);
 
+        // Light every fragment in one full screen pass with the lights of its froxel
+        if (lightingModel->isClusteredLightsEnabled()) {
+            auto& clusters = deferredLightingEffect->_lightClusters;
+            std::vector<model::LightPointer> lights;
+            lights.reserve(deferredLightingEffect->_pointLights.size() + deferredLightingEffect->_spotLights.size());
+            if (points) {
+                for (auto lightID : deferredLightingEffect->_pointLights) {
+                    lights.push_back(deferredLightingEffect->_allocatedLights[lightID]);
+                }
+            }
+            if (spots) {
+                for (auto lightID : deferredLightingEffect->_spotLights) {
+                    lights.push_back(deferredLightingEffect->_allocatedLights[lightID]);
+                }
+            }
+            clusters.update(viewFrustum, lights);
+
+            if (clusters.getNumLights() > 0) {
+                batch.setPipeline(deferredLightingEffect->_clusteredLight);
+                batch._glUniform4fv(deferredLightingEffect->_clusteredLightLocations->texcoordFrameTransform, 1, reinterpret_cast< const float* >(&textureFrameTransform));
+                batch.setUniformBuffer(CLUSTER_GRID_BUFFER_SLOT, clusters.getGridBuffer());
+                batch.setUniformBuffer(CLUSTER_CONTENT_BUFFER_SLOT, clusters.getContentBuffer());
+                batch.setUniformBuffer(CLUSTER_LIGHT_BUFFER_SLOT, clusters.getLightBuffer());
+                batch.draw(gpu::TRIANGLE_STRIP, 4);
+            }
+            return;
+        }
+
         // Splat Point lights
         if (points && !deferredLightingEffect->_pointLights.empty()) {
             // POint light pipeline
@@ -667,6 +712,9 @@ void RenderDeferredCleanup::run(const render::SceneContextPointer& sceneContext,
         batch.setResourceTexture(SCATTERING_SPECULAR_UNIT, nullptr);
         
         batch.setUniformBuffer(SCATTERING_PARAMETERS_BUFFER_SLOT, nullptr);
+        batch.setUniformBuffer(CLUSTER_GRID_BUFFER_SLOT, nullptr);
+        batch.setUniformBuffer(CLUSTER_CONTENT_BUFFER_SLOT, nullptr);
+        batch.setUniformBuffer(CLUSTER_LIGHT_BUFFER_SLOT, nullptr);
    //     batch.setUniformBuffer(LIGHTING_MODEL_BUFFER_SLOT, nullptr);
         batch.setUniformBuffer(DEFERRED_FRAME_TRANSFORM_BUFFER_SLOT, nullptr);
     });
@@ -28,6 +28,7 @@
 #include "LightingModel.h"
 
 #include "LightStage.h"
+#include "LightClusters.h"
 #include "SurfaceGeometryPass.h"
 #include "SubsurfaceScattering.h"
 #include "AmbientOcclusionEffect.h"
@@ -83,6 +84,7 @@ private:
 
     gpu::PipelinePointer _pointLight;
     gpu::PipelinePointer _spotLight;
+    gpu::PipelinePointer _clusteredLight;
 
     LightLocationsPtr _directionalSkyboxLightLocations;
     LightLocationsPtr _directionalAmbientSphereLightLocations;
@@ -94,6 +96,9 @@ private:
 
     LightLocationsPtr _pointLightLocations;
     LightLocationsPtr _spotLightLocations;
+    LightLocationsPtr _clusteredLightLocations;
+
+    LightClusters _lightClusters;
 
     using Lights = std::vector<model::LightPointer>;
 
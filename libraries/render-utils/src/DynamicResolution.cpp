@@ -0,0 +1,108 @@
+//
+//  DynamicResolution.cpp
+//  libraries/render-utils/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <RenderArgs.h>
+#include <gpu/Context.h>
+
+const float DEFAULT_TARGET_FRAME_RATE = 60.0f;
+
+// the part of the way to the scale the GPU time asks for that is made every frame, the timer averages a few frames too
+const float SCALE_ADJUST_RATE = 0.1f;
+
+// the sizes of the viewport are multiples of this, so it doesn't change for every small move of the scale
+// and the two halves of a stereo frame stay the same
+const int VIEWPORT_ALIGNMENT = 8;
+
+static int evalScaledSize(int size, float scale) {
+    if (scale >= 1.0f) {
+        return size;
+    }
+    int scaledSize = (int)roundf(size * scale / VIEWPORT_ALIGNMENT) * VIEWPORT_ALIGNMENT;
+    return std::max(VIEWPORT_ALIGNMENT, std::min(scaledSize, size));
+}
+
+void BeginDynamicResolution::configure(const Config& config) {
+    _autoAdjust = config.autoAdjust;
+    _scale = config.scale;
+    _minScale = std::min(config.minScale, config.maxScale);
+    _maxScale = config.maxScale;
+    _targetFrameRate = config.targetFrameRate;
+    _targetGPUTime = config.targetGPUTime;
+    _gpuBudget = config.gpuBudget;
+}
+
+float BeginDynamicResolution::evalTargetGPUTime() const {
+    if (_targetGPUTime > 0.0f) {
+        return _targetGPUTime;
+    }
+    float frameRate = (_targetFrameRate > 0.0f ? _targetFrameRate : DEFAULT_TARGET_FRAME_RATE);
+    return _gpuBudget * 1000.0f / frameRate;
+}
+
+void BeginDynamicResolution::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, DynamicResolutionPointer& resolution) {
+    assert(renderContext->args);
+    RenderArgs* args = renderContext->args;
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+
+    resolution = _resolution;
+    _resolution->fullViewport = args->_viewport;
+    _resolution->viewport = args->_viewport;
+    _resolution->scale = 1.0f;
+
+    // Only the main view follows the time of the frames, the mirror keeps its full resolution
+    _resolution->_isTimed = (args->_renderMode == RenderArgs::DEFAULT_RENDER_MODE);
+    if (!_resolution->_isTimed) {
+        return;
+    }
+
+    if (_autoAdjust) {
+        double gpuTime = _resolution->_gpuTimer->getGPUAverage();
+        if (gpuTime > 0.0) {
+            // the time to fill the frame goes with its number of pixels, the square of the scale
+            float desiredScale = _currentScale * sqrtf(evalTargetGPUTime() / (float)gpuTime);
+            _currentScale += (desiredScale - _currentScale) * SCALE_ADJUST_RATE;
+        }
+        _currentScale = std::max(_minScale, std::min(_currentScale, _maxScale));
+    } else {
+        _currentScale = _scale;
+    }
+
+    const auto& fullViewport = _resolution->fullViewport;
+    glm::ivec4 viewport(fullViewport.x, fullViewport.y,
+        evalScaledSize(fullViewport.z, _currentScale), evalScaledSize(fullViewport.w, _currentScale));
+    _resolution->viewport = viewport;
+    _resolution->scale = (float)viewport.z / (float)std::max(fullViewport.z, 1);
+    args->_viewport = viewport;
+
+    gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+        _resolution->_gpuTimer->begin(batch);
+    });
+
+    config->setCurrentScale(_currentScale);
+    config->setGPUBatchRunTime(_resolution->_gpuTimer->getGPUAverage(), _resolution->_gpuTimer->getBatchAverage());
+}
+
+void EndDynamicResolution::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const DynamicResolutionPointer& resolution) {
+    assert(renderContext->args);
+    RenderArgs* args = renderContext->args;
+
+    if (resolution->_isTimed) {
+        gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+            resolution->_gpuTimer->end(batch);
+        });
+    }
+    args->_viewport = resolution->fullViewport;
+}
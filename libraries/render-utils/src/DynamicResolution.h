@@ -0,0 +1,114 @@
+//
+//  DynamicResolution.h
+//  libraries/render-utils/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_render_utils_DynamicResolution_h
+#define hifi_render_utils_DynamicResolution_h
+
+#include <gpu/Query.h>
+#include <render/Task.h>
+
+// The viewport a frame is rendered in, a corner of the full one scaled down to keep the GPU time of the frame
+// in budget when it is bound by the pixels to fill. The Blit brings it back up to the full viewport
+class DynamicResolution {
+public:
+    glm::ivec4 fullViewport;
+    glm::ivec4 viewport;
+    float scale { 1.0f };
+
+    DynamicResolution() : _gpuTimer(std::make_shared<gpu::RangeTimer>()) {}
+
+protected:
+    gpu::RangeTimerPointer _gpuTimer;
+    bool _isTimed { false };
+
+    friend class BeginDynamicResolution;
+    friend class EndDynamicResolution;
+};
+using DynamicResolutionPointer = std::shared_ptr<DynamicResolution>;
+
+class DynamicResolutionConfig : public render::GPUJobConfig {
+    Q_OBJECT
+    Q_PROPERTY(bool autoAdjust MEMBER autoAdjust NOTIFY dirty)
+    Q_PROPERTY(float scale MEMBER scale WRITE setScale)
+    Q_PROPERTY(float minScale MEMBER minScale WRITE setMinScale)
+    Q_PROPERTY(float maxScale MEMBER maxScale WRITE setMaxScale)
+    Q_PROPERTY(float targetFrameRate MEMBER targetFrameRate WRITE setTargetFrameRate)
+    Q_PROPERTY(float targetGPUTime MEMBER targetGPUTime WRITE setTargetGPUTime)
+    Q_PROPERTY(float gpuBudget MEMBER gpuBudget WRITE setGPUBudget)
+    Q_PROPERTY(float currentScale READ getCurrentScale)
+
+public:
+    DynamicResolutionConfig() : render::GPUJobConfig(true) {}
+
+    const float MIN_SCALE = 0.25f;
+
+    void setScale(float newScale) { scale = std::max(MIN_SCALE, std::min(newScale, 1.0f)); emit dirty(); }
+    void setMinScale(float newScale) { minScale = std::max(MIN_SCALE, std::min(newScale, 1.0f)); emit dirty(); }
+    void setMaxScale(float newScale) { maxScale = std::max(MIN_SCALE, std::min(newScale, 1.0f)); emit dirty(); }
+    void setTargetFrameRate(float rate) { targetFrameRate = std::max(0.0f, rate); emit dirty(); }
+    void setTargetGPUTime(float time) { targetGPUTime = std::max(0.0f, time); emit dirty(); }
+    void setGPUBudget(float budget) { gpuBudget = std::max(0.1f, std::min(budget, 1.0f)); emit dirty(); }
+
+    void setCurrentScale(float newScale) { _currentScale = newScale; }
+    float getCurrentScale() const { return _currentScale; }
+
+    bool autoAdjust { false }; // follow the GPU time of the frames, otherwise render at the scale
+    float scale { 1.0f };
+    float minScale { 0.5f };
+    float maxScale { 1.0f };
+    float targetFrameRate { 0.0f }; // the rate of the display, set every frame by the application from the display plugin
+    float targetGPUTime { 0.0f }; // in ms, overrides the time of a frame at the target frame rate when not 0
+    float gpuBudget { 0.9f }; // the part of the time of a frame the GPU time aims at
+
+signals:
+    void dirty();
+
+protected:
+    float _currentScale { 1.0f };
+};
+
+// Scales the viewport of the frame down, it should run before the first GPU job
+class BeginDynamicResolution {
+public:
+    using Config = DynamicResolutionConfig;
+    using JobModel = render::Job::ModelO<BeginDynamicResolution, DynamicResolutionPointer, Config>;
+
+    BeginDynamicResolution() : _resolution(std::make_shared<DynamicResolution>()) {}
+
+    void configure(const Config& config);
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, DynamicResolutionPointer& resolution);
+
+protected:
+    float evalTargetGPUTime() const;
+
+    DynamicResolutionPointer _resolution;
+    float _currentScale { 1.0f };
+
+    bool _autoAdjust { false };
+    float _scale { 1.0f };
+    float _minScale { 0.5f };
+    float _maxScale { 1.0f };
+    float _targetFrameRate { 0.0f };
+    float _targetGPUTime { 0.0f };
+    float _gpuBudget { 0.9f };
+};
+
+// Gives the full viewport back, it should run after the Blit
+class EndDynamicResolution {
+public:
+    using JobModel = render::Job::ModelI<EndDynamicResolution, DynamicResolutionPointer>;
+
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const DynamicResolutionPointer& resolution);
+};
+
+#endif // hifi_render_utils_DynamicResolution_h
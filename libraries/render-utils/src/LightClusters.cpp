@@ -0,0 +1,162 @@
+//
+//  LightClusters.cpp
+//  libraries/render-utils/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LightClusters.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <Transform.h>
+#include <ViewFrustum.h>
+
+const float LightClusters::FAR_DEPTH = 200.0f;
+
+static_assert(sizeof(model::Light::Schema) >= 7 * sizeof(glm::vec4), "the light schema starts with the seven vec4 of a cluster light");
+
+// the froxel of a depth, the slices are as thick relative to their distance from the eye
+static int evalSlice(float depth, float nearDepth, float slicesPerLog) {
+    if (depth <= nearDepth) {
+        return 0;
+    }
+    int slice = (int)(logf(depth / nearDepth) * slicesPerLog);
+    return std::min(slice, LightClusters::GRID_DEPTH - 1);
+}
+
+static int evalTile(float ndc, int numTiles) {
+    int tile = (int)floorf((ndc * 0.5f + 0.5f) * numTiles);
+    return std::max(0, std::min(tile, numTiles - 1));
+}
+
+LightClusters::LightClusters() {
+    Grid grid;
+    _gridBuffer = gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(Grid), (const gpu::Byte*) &grid));
+    Content content;
+    _contentBuffer = gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(Content), (const gpu::Byte*) &content));
+    Lights lights;
+    _lightBuffer = gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(Lights), (const gpu::Byte*) &lights));
+
+    _clusterCounts.resize(NUM_CLUSTERS);
+}
+
+void LightClusters::update(const ViewFrustum& viewFrustum, const std::vector<model::LightPointer>& lights) {
+    glm::mat4 projection;
+    viewFrustum.evalProjectionMatrix(projection);
+    Transform cameraTransform;
+    viewFrustum.evalViewTransform(cameraTransform);
+    glm::mat4 view;
+    cameraTransform.getInverseMatrix(view);
+
+    const float nearDepth = viewFrustum.getNearClip();
+    const float farDepth = std::max(std::min(viewFrustum.getFarClip(), FAR_DEPTH), nearDepth * 2.0f);
+    const float slicesPerLog = GRID_DEPTH / logf(farDepth / nearDepth);
+
+    // Find the froxels each light touches, from the box around its sphere
+    _lightRanges.clear();
+    Lights& lightData = _lightBuffer.edit<Lights>();
+    int numLights = 0;
+    for (const auto& light : lights) {
+        if (numLights >= MAX_LIGHTS) {
+            break;
+        }
+        if (!light || !light->isRanged()) {
+            continue;
+        }
+
+        const float radius = light->getMaximumRadius();
+        const glm::vec3 center = glm::vec3(view * glm::vec4(light->getPosition(), 1.0f));
+        const float nearestDepth = -center.z - radius;
+        const float farthestDepth = -center.z + radius;
+        if (farthestDepth < nearDepth) {
+            continue; // behind the eye
+        }
+
+        glm::ivec3 first(0, 0, evalSlice(nearestDepth, nearDepth, slicesPerLog));
+        glm::ivec3 last(GRID_WIDTH - 1, GRID_HEIGHT - 1, evalSlice(farthestDepth, nearDepth, slicesPerLog));
+        if (nearestDepth > nearDepth) {
+            // the box is all in front of the eye, so its corners project to a rectangle holding the sphere.
+            // The tiles are clamped rather than the light dropped, the fragments off the sides of the mono frustum
+            // (as in stereo) fall in the tiles of the edges too.
+            glm::vec2 ndcMin(1.0f);
+            glm::vec2 ndcMax(-1.0f);
+            for (int i = 0; i < 8; i++) {
+                glm::vec4 corner(center.x + ((i & 1) ? radius : -radius),
+                                 center.y + ((i & 2) ? radius : -radius),
+                                 center.z + ((i & 4) ? radius : -radius), 1.0f);
+                glm::vec4 clip = projection * corner;
+                glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+            first.x = evalTile(ndcMin.x, GRID_WIDTH);
+            first.y = evalTile(ndcMin.y, GRID_HEIGHT);
+            last.x = evalTile(ndcMax.x, GRID_WIDTH);
+            last.y = evalTile(ndcMax.y, GRID_HEIGHT);
+        }
+        _lightRanges.push_back(first);
+        _lightRanges.push_back(last);
+
+        memcpy(lightData.lights[numLights].data, &light->getSchemaBuffer().get<model::Light::Schema>(), LIGHT_SIZE);
+        ++numLights;
+    }
+    _numLights = numLights;
+
+    // Count the lights of each froxel, then lay their lists out one after the other
+    std::fill(_clusterCounts.begin(), _clusterCounts.end(), 0);
+    for (int i = 0; i < numLights; i++) {
+        const glm::ivec3& first = _lightRanges[2 * i];
+        const glm::ivec3& last = _lightRanges[2 * i + 1];
+        for (int z = first.z; z <= last.z; z++) {
+            for (int y = first.y; y <= last.y; y++) {
+                for (int x = first.x; x <= last.x; x++) {
+                    _clusterCounts[(z * GRID_HEIGHT + y) * GRID_WIDTH + x]++;
+                }
+            }
+        }
+    }
+
+    Grid& grid = _gridBuffer.edit<Grid>();
+    grid.dims = glm::vec4(GRID_WIDTH, GRID_HEIGHT, GRID_DEPTH, numLights);
+    grid.depth = glm::vec4(nearDepth, slicesPerLog, 0.0f, 0.0f);
+
+    // when the lists don't all fit, the froxels past the end are left with the lights that do
+    std::vector<uint16_t> offsets(NUM_CLUSTERS);
+    int numIndices = 0;
+    for (int c = 0; c < NUM_CLUSTERS; c++) {
+        int count = std::min((int)_clusterCounts[c], MAX_LIGHT_INDICES - numIndices);
+        offsets[c] = (uint16_t)numIndices;
+        _clusterCounts[c] = (uint16_t)count;
+        numIndices += count;
+        grid.clusters[c / 4][c % 4] = (uint32_t)offsets[c] | ((uint32_t)count << 16);
+    }
+
+    Content& content = _contentBuffer.edit<Content>();
+    std::vector<uint16_t> filled(NUM_CLUSTERS, 0);
+    auto setIndex = [&content](int index, int light) {
+        glm::uint& word = content.indices[index / 16][(index / 4) % 4];
+        int shift = (index % 4) * 8;
+        word = (word & ~(0xFFu << shift)) | ((glm::uint)light << shift);
+    };
+    for (int i = 0; i < numLights; i++) {
+        const glm::ivec3& first = _lightRanges[2 * i];
+        const glm::ivec3& last = _lightRanges[2 * i + 1];
+        for (int z = first.z; z <= last.z; z++) {
+            for (int y = first.y; y <= last.y; y++) {
+                for (int x = first.x; x <= last.x; x++) {
+                    int c = (z * GRID_HEIGHT + y) * GRID_WIDTH + x;
+                    if (filled[c] < _clusterCounts[c]) {
+                        setIndex(offsets[c] + filled[c], i);
+                        filled[c]++;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+//
+//  LightClusters.h
+//  libraries/render-utils/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_render_utils_LightClusters_h
+#define hifi_render_utils_LightClusters_h
+
+#include <vector>
+
+#include <gpu/Resource.h>
+#include <model/Light.h>
+
+class ViewFrustum;
+
+// LightClusters sorts the point and spot lights of a frame into a grid of froxels, the tiles of the screen cut into
+// slices of depth growing exponentially away from the eye, so a single full screen pass can light every fragment
+// with only the lights of the froxel it falls in (see LightClusterGrid.slh for the other end).
+// The grid, the lists of lights of each froxel and the lights themselves are uniform buffers, sized to fit the 16KB
+// that every GL implementation gives a uniform block.
+class LightClusters {
+public:
+    using UniformBufferView = gpu::BufferView;
+
+    static const int GRID_WIDTH = 16;
+    static const int GRID_HEIGHT = 8;
+    static const int GRID_DEPTH = 16;
+    static const int NUM_CLUSTERS = GRID_WIDTH * GRID_HEIGHT * GRID_DEPTH;
+
+    // the lights past these are not drawn, the indices of the lights in the froxels are one byte each
+    static const int MAX_LIGHTS = 128;
+    static const int MAX_LIGHT_INDICES = 8192;
+
+    LightClusters();
+
+    // Fills the buffers for the mono view of the frustum with the ranged lights among lights
+    void update(const ViewFrustum& viewFrustum, const std::vector<model::LightPointer>& lights);
+
+    int getNumLights() const { return _numLights; }
+
+    const UniformBufferView& getGridBuffer() const { return _gridBuffer; }
+    const UniformBufferView& getContentBuffer() const { return _contentBuffer; }
+    const UniformBufferView& getLightBuffer() const { return _lightBuffer; }
+
+protected:
+    // the slices of depth end there, anything further is in the last one
+    static const float FAR_DEPTH;
+
+    // The layout of the clusterGridBuffer of LightClusterGrid.slh
+    class Grid {
+    public:
+        // { width, height, depth, number of lights }
+        glm::vec4 dims;
+        // { near depth, number of slices over log(far / near) }
+        glm::vec4 depth;
+        // the offset of the first light of a cluster in the content is in the low 16 bits, the number of them in the high
+        glm::uvec4 clusters[NUM_CLUSTERS / 4];
+
+        Grid() {}
+    };
+
+    // The light indices of all the clusters one after another, four to a uint
+    class Content {
+    public:
+        glm::uvec4 indices[MAX_LIGHT_INDICES / 16];
+
+        Content() {}
+    };
+
+    // The part of model::Light::Schema before the ambient sphere, which only the global light has
+    static const size_t LIGHT_SIZE = 7 * sizeof(glm::vec4);
+    struct LightData {
+        uint8_t data[LIGHT_SIZE];
+    };
+    class Lights {
+    public:
+        LightData lights[MAX_LIGHTS];
+
+        Lights() {}
+    };
+
+    UniformBufferView _gridBuffer;
+    UniformBufferView _contentBuffer;
+    UniformBufferView _lightBuffer;
+    int _numLights { 0 };
+
+    // scratch space, the first and the last froxel of each light one after the other
+    std::vector<glm::ivec3> _lightRanges;
+    std::vector<uint16_t> _clusterCounts;
+};
+
+#endif // hifi_render_utils_LightClusters_h
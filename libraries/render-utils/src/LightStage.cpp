@@ -13,9 +13,27 @@
 
 #include "LightStage.h"
 
-LightStage::Shadow::Shadow(model::LightPointer light) : _light{ light}, _frustum{ std::make_shared<ViewFrustum>() } {
+// The far depth of each cascade, as a part of the range the cascades cover
+static const float CASCADE_FAR_RATIOS[LightStage::Shadow::NUM_CASCADES] = { 0.12f, 0.4f, 1.0f };
+// How far towards the light past the view frustum the casters are still drawn in the map
+static const float CASTER_DEPTH = 20.0f;
+// How many steps the cached cascades move in across their width
+static const float CACHED_CASCADE_STEPS = 8.0f;
+
+LightStage::Shadow::Cascade::Cascade() : _frustum{ std::make_shared<ViewFrustum>() } {
     framebuffer = gpu::FramebufferPointer(gpu::Framebuffer::createShadowmap(MAP_SIZE));
     map = framebuffer->getDepthStencilBuffer();
+}
+
+const glm::mat4& LightStage::Shadow::Cascade::getView() const {
+    return _frustum->getView();
+}
+
+const glm::mat4& LightStage::Shadow::Cascade::getProjection() const {
+    return _frustum->getProjection();
+}
+
+LightStage::Shadow::Shadow(model::LightPointer light) : _light{ light}, _cascades(NUM_CASCADES) {
     Schema schema;
     _schemaBuffer = std::make_shared<gpu::Buffer>(sizeof(Schema), (const gpu::Byte*) &schema);
 }
@@ -35,56 +53,58 @@ void LightStage::Shadow::setKeylightFrustum(const ViewFrustum& viewFrustum, floa
         auto up = glm::normalize(glm::cross(side, direction));
         orientation = glm::quat_cast(glm::mat3(side, up, -direction));
     }
-    _frustum->setOrientation(orientation);
-
-    // Position the keylight frustum
-    _frustum->setPosition(viewFrustum.getPosition() - (nearDepth + farDepth)*direction);
-
-    const Transform view{ _frustum->getView()};
-    const Transform viewInverse{ view.getInverseMatrix() };
-
-    auto nearCorners = viewFrustum.getCorners(nearDepth);
-    auto farCorners = viewFrustum.getCorners(farDepth);
-
-    vec3 min{ viewInverse.transform(nearCorners.bottomLeft) };
-    vec3 max{ min };
-    // Expand keylight frustum  to fit view frustum
-    auto fitFrustum = [&min, &max, &viewInverse](const vec3& viewCorner) {
-        const auto corner = viewInverse.transform(viewCorner);
-
-        min.x = glm::min(min.x, corner.x);
-        min.y = glm::min(min.y, corner.y);
-        min.z = glm::min(min.z, corner.z);
-
-        max.x = glm::max(max.x, corner.x);
-        max.y = glm::max(max.y, corner.y);
-        max.z = glm::max(max.z, corner.z);
-    };
-    fitFrustum(nearCorners.bottomRight);
-    fitFrustum(nearCorners.topLeft);
-    fitFrustum(nearCorners.topRight);
-    fitFrustum(farCorners.bottomLeft);
-    fitFrustum(farCorners.bottomRight);
-    fitFrustum(farCorners.topLeft);
-    fitFrustum(farCorners.topRight);
-
-    glm::mat4 ortho = glm::ortho<float>(min.x, max.x, min.y, max.y, -max.z, -min.z);
-    _frustum->setProjection(ortho);
-
-    // Calculate the frustum's internal state
-    _frustum->calculate();
-
-    // Update the buffer
-    _schemaBuffer.edit<Schema>().projection = ortho;
-    _schemaBuffer.edit<Schema>().viewInverse = viewInverse.getMatrix();
-}
-
-const glm::mat4& LightStage::Shadow::getView() const {
-    return _frustum->getView();
-}
-
-const glm::mat4& LightStage::Shadow::getProjection() const {
-    return _frustum->getProjection();
+    const glm::quat lightInverse = glm::inverse(orientation);
+
+    auto& schema = _schemaBuffer.edit<Schema>();
+    float cascadeNear = nearDepth;
+    for (int i = 0; i < NUM_CASCADES; i++) {
+        auto& cascade = _cascades[i];
+        float cascadeFar = nearDepth + (farDepth - nearDepth) * CASCADE_FAR_RATIOS[i];
+
+        // Fit the cascade to the sphere around its part of the view frustum, so its size does not change as the view turns
+        auto nearCorners = viewFrustum.getCorners(cascadeNear);
+        auto farCorners = viewFrustum.getCorners(cascadeFar);
+        const vec3 corners[] = {
+            nearCorners.bottomLeft, nearCorners.bottomRight, nearCorners.topLeft, nearCorners.topRight,
+            farCorners.bottomLeft, farCorners.bottomRight, farCorners.topLeft, farCorners.topRight
+        };
+        vec3 center(0.0f);
+        for (const auto& corner : corners) {
+            center += corner;
+        }
+        center /= 8.0f;
+        float radius = 0.0f;
+        for (const auto& corner : corners) {
+            radius = glm::max(radius, glm::distance(center, corner));
+        }
+
+        // Snap the center (in the space of the light) to steps of a texel, so the casters don't crawl across the texels
+        // as the view moves. The cached cascades take coarse steps instead and grow by one to still hold the sphere.
+        float step = 2.0f * radius / MAP_SIZE;
+        if (i > 0) {
+            step = 2.0f * radius / CACHED_CASCADE_STEPS;
+            radius += step;
+        }
+        radius = glm::ceil(radius / step) * step;
+        vec3 lightCenter = lightInverse * center;
+        lightCenter = glm::floor(lightCenter / step + 0.5f) * step;
+
+        cascade._frustum->setOrientation(orientation);
+        cascade._frustum->setPosition(orientation * (lightCenter + vec3(0.0f, 0.0f, radius + CASTER_DEPTH)));
+
+        glm::mat4 ortho = glm::ortho<float>(-radius, radius, -radius, radius, 0.0f, 2.0f * radius + CASTER_DEPTH);
+        cascade._frustum->setProjection(ortho);
+
+        // Calculate the frustum's internal state
+        cascade._frustum->calculate();
+
+        // Update the buffer
+        const Transform view{ cascade._frustum->getView() };
+        schema.projection[i] = ortho;
+        schema.viewInverse[i] = view.getInverseMatrix();
+
+        cascadeNear = cascadeFar;
+    }
 }
 
 const LightStage::LightPointer LightStage::addLight(model::LightPointer light) {
@@ -25,31 +25,47 @@ public:
     public:
         using UniformBufferView = gpu::BufferView;
         static const int MAP_SIZE = 1024;
+        static const int NUM_CASCADES = 3;
+
+        // One of the maps the view frustum is split into along its depth, each covering a range further from the eye
+        class Cascade {
+        public:
+            Cascade();
+
+            const std::shared_ptr<ViewFrustum>& getFrustum() const { return _frustum; }
+
+            const glm::mat4& getView() const;
+            const glm::mat4& getProjection() const;
+
+            gpu::FramebufferPointer framebuffer;
+            gpu::TexturePointer map;
+        protected:
+            std::shared_ptr<ViewFrustum> _frustum;
+
+            friend class Shadow;
+        };
 
         Shadow(model::LightPointer light);
 
+        // Fits the cascades to [nearDepth, farDepth] of the view frustum. The cascades past the first one are moved in
+        // coarse steps, so they keep the same frustum (and can keep their map) while the view moves a little.
         void setKeylightFrustum(const ViewFrustum& viewFrustum, float nearDepth, float farDepth);
 
-        const std::shared_ptr<ViewFrustum> getFrustum() const { return _frustum; }
-
-        const glm::mat4& getView() const;
-        const glm::mat4& getProjection() const;
+        const Cascade& getCascade(int index) const { return _cascades[index]; }
 
         const UniformBufferView& getBuffer() const { return _schemaBuffer; }
 
-        gpu::FramebufferPointer framebuffer;
-        gpu::TexturePointer map;
     protected:
         model::LightPointer _light;
-        std::shared_ptr<ViewFrustum> _frustum;
+        std::vector<Cascade> _cascades;
 
         class Schema {
         public:
-            glm::mat4 projection;
-            glm::mat4 viewInverse;
+            glm::mat4 projection[NUM_CASCADES];
+            glm::mat4 viewInverse[NUM_CASCADES];
 
             glm::float32 bias = 0.005f;
-            glm::float32 scale = 1 / MAP_SIZE;
+            glm::float32 scale = 1.0f / MAP_SIZE;
         };
         UniformBufferView _schemaBuffer = nullptr;
         
@@ -132,6 +132,14 @@ void LightingModel::setShowLightContour(bool enable) {
 bool LightingModel::isShowLightContourEnabled() const {
     return (bool)_parametersBuffer.get<Parameters>().showLightContour;
 }
+void LightingModel::setClusteredLights(bool enable) {
+    if (enable != isClusteredLightsEnabled()) {
+        _parametersBuffer.edit<Parameters>().enableClusteredLights = (float)enable;
+    }
+}
+bool LightingModel::isClusteredLightsEnabled() const {
+    return (bool)_parametersBuffer.get<Parameters>().enableClusteredLights;
+}
 
 MakeLightingModel::MakeLightingModel() {
     _lightingModel = std::make_shared<LightingModel>();
@@ -156,6 +164,7 @@ void MakeLightingModel::configure(const Config& config) {
     _lightingModel->setSpotLight(config.enableSpotLight);
 
     _lightingModel->setShowLightContour(config.showLightContour);
+    _lightingModel->setClusteredLights(config.enableClusteredLights);
 }
 
 void MakeLightingModel::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, LightingModelPointer& lightingModel) {
@@ -62,6 +62,10 @@ public:
     void setShowLightContour(bool enable);
     bool isShowLightContourEnabled() const;
 
+    // Draw the point and spot lights in one full screen pass over froxels rather than one volume each
+    void setClusteredLights(bool enable);
+    bool isClusteredLightsEnabled() const;
+
     UniformBufferView getParametersBuffer() const { return _parametersBuffer; }
 
 protected:
@@ -90,7 +94,8 @@ protected:
         float showLightContour{ 0.0f }; // false by default
         float enableObscurance{ 1.0f };
 
-        glm::vec2 spares{ 0.0f };
+        float enableClusteredLights{ 0.0f }; // false by default, only read on the cpu
+        float spare{ 0.0f };
 
         Parameters() {}
     };
@@ -123,6 +128,7 @@ class MakeLightingModelConfig : public render::Job::Config {
     Q_PROPERTY(bool enableSpotLight MEMBER enableSpotLight NOTIFY dirty)
 
     Q_PROPERTY(bool showLightContour MEMBER showLightContour NOTIFY dirty)
+    Q_PROPERTY(bool enableClusteredLights MEMBER enableClusteredLights NOTIFY dirty)
 
 public:
     MakeLightingModelConfig() : render::Job::Config() {} // Make Lighting Model is always on
@@ -144,6 +150,7 @@ public:
     bool enableSpotLight{ true };
 
     bool showLightContour{ false }; // false by default
+    bool enableClusteredLights{ false };
 
 signals:
     void dirty();
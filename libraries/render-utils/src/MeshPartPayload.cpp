@@ -11,12 +11,18 @@
 
 #include "MeshPartPayload.h"
 
+#include <mutex>
+
 #include <PerfStat.h>
+#include <gpu/TextureTable.h>
 
 #include "DeferredLightingEffect.h"
 #include "Model.h"
 #include "EntityItem.h"
 
+#include "skin_model_feedback_vert.h"
+#include "model_shadow_frag.h"
+
 using namespace render;
 
 namespace render {
@@ -177,86 +183,89 @@ void MeshPartPayload::bindMaterial(gpu::Batch& batch, const ShapePipeline::Locat
         numUnlit++;
     }
 
+    // Every texture of the material is set with a single table, kept as long as the same textures are picked
+    gpu::TextureTable::Array textures;
+
     // Albedo
     if (materialKey.isAlbedoMap()) {
         auto albedoMap = textureMaps[model::MaterialKey::ALBEDO_MAP];
         if (albedoMap && albedoMap->isDefined()) {
-            batch.setResourceTexture(ShapePipeline::Slot::ALBEDO, albedoMap->getTextureView());
+            textures[ShapePipeline::Slot::MAP::ALBEDO] = albedoMap->getTextureView()._texture;
         } else {
-            batch.setResourceTexture(ShapePipeline::Slot::ALBEDO, textureCache->getGrayTexture());
+            textures[ShapePipeline::Slot::MAP::ALBEDO] = textureCache->getGrayTexture();
         }
     } else {
-        batch.setResourceTexture(ShapePipeline::Slot::ALBEDO, textureCache->getWhiteTexture());
+        textures[ShapePipeline::Slot::MAP::ALBEDO] = textureCache->getWhiteTexture();
     }
 
     // Roughness map
     if (materialKey.isRoughnessMap()) {
         auto roughnessMap = textureMaps[model::MaterialKey::ROUGHNESS_MAP];
         if (roughnessMap && roughnessMap->isDefined()) {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::ROUGHNESS, roughnessMap->getTextureView());
+            textures[ShapePipeline::Slot::MAP::ROUGHNESS] = roughnessMap->getTextureView()._texture;
 
             // texcoord are assumed to be the same has albedo
         } else {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::ROUGHNESS, textureCache->getWhiteTexture());
+            textures[ShapePipeline::Slot::MAP::ROUGHNESS] = textureCache->getWhiteTexture();
         }
     } else {
-        batch.setResourceTexture(ShapePipeline::Slot::MAP::ROUGHNESS, textureCache->getWhiteTexture());
+        textures[ShapePipeline::Slot::MAP::ROUGHNESS] = textureCache->getWhiteTexture();
     }
 
     // Normal map
     if (materialKey.isNormalMap()) {
         auto normalMap = textureMaps[model::MaterialKey::NORMAL_MAP];
         if (normalMap && normalMap->isDefined()) {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::NORMAL, normalMap->getTextureView());
+            textures[ShapePipeline::Slot::MAP::NORMAL] = normalMap->getTextureView()._texture;
 
             // texcoord are assumed to be the same has albedo
         } else {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::NORMAL, textureCache->getBlueTexture());
+            textures[ShapePipeline::Slot::MAP::NORMAL] = textureCache->getBlueTexture();
         }
     } else {
-        batch.setResourceTexture(ShapePipeline::Slot::MAP::NORMAL, nullptr);
+        textures[ShapePipeline::Slot::MAP::NORMAL] = nullptr;
     }
 
     // Metallic map
     if (materialKey.isMetallicMap()) {
         auto specularMap = textureMaps[model::MaterialKey::METALLIC_MAP];
         if (specularMap && specularMap->isDefined()) {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::METALLIC, specularMap->getTextureView());
+            textures[ShapePipeline::Slot::MAP::METALLIC] = specularMap->getTextureView()._texture;
 
             // texcoord are assumed to be the same has albedo
         } else {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::METALLIC, textureCache->getBlackTexture());
+            textures[ShapePipeline::Slot::MAP::METALLIC] = textureCache->getBlackTexture();
         }
     } else {
-        batch.setResourceTexture(ShapePipeline::Slot::MAP::METALLIC, nullptr);
+        textures[ShapePipeline::Slot::MAP::METALLIC] = nullptr;
     }
 
     // Occlusion map
     if (materialKey.isOcclusionMap()) {
         auto specularMap = textureMaps[model::MaterialKey::OCCLUSION_MAP];
         if (specularMap && specularMap->isDefined()) {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::OCCLUSION, specularMap->getTextureView());
+            textures[ShapePipeline::Slot::MAP::OCCLUSION] = specularMap->getTextureView()._texture;
 
             // texcoord are assumed to be the same has albedo
         } else {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::OCCLUSION, textureCache->getWhiteTexture());
+            textures[ShapePipeline::Slot::MAP::OCCLUSION] = textureCache->getWhiteTexture();
         }
     } else {
-        batch.setResourceTexture(ShapePipeline::Slot::MAP::OCCLUSION, nullptr);
+        textures[ShapePipeline::Slot::MAP::OCCLUSION] = nullptr;
     }
 
     // Scattering map
     if (materialKey.isScatteringMap()) {
         auto scatteringMap = textureMaps[model::MaterialKey::SCATTERING_MAP];
         if (scatteringMap && scatteringMap->isDefined()) {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::SCATTERING, scatteringMap->getTextureView());
+            textures[ShapePipeline::Slot::MAP::SCATTERING] = scatteringMap->getTextureView()._texture;
 
             // texcoord are assumed to be the same has albedo
         } else {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::SCATTERING, textureCache->getWhiteTexture());
+            textures[ShapePipeline::Slot::MAP::SCATTERING] = textureCache->getWhiteTexture();
         }
     } else {
-        batch.setResourceTexture(ShapePipeline::Slot::MAP::SCATTERING, nullptr);
+        textures[ShapePipeline::Slot::MAP::SCATTERING] = nullptr;
     }
 
     // Emissive / Lightmap
@@ -264,21 +273,26 @@ void MeshPartPayload::bindMaterial(gpu::Batch& batch, const ShapePipeline::Locat
         auto lightmapMap = textureMaps[model::MaterialKey::LIGHTMAP_MAP];
 
         if (lightmapMap && lightmapMap->isDefined()) {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP, lightmapMap->getTextureView());
+            textures[ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP] = lightmapMap->getTextureView()._texture;
         } else {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP, textureCache->getGrayTexture());
+            textures[ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP] = textureCache->getGrayTexture();
         }
     } else if (materialKey.isEmissiveMap()) {
         auto emissiveMap = textureMaps[model::MaterialKey::EMISSIVE_MAP];
 
         if (emissiveMap && emissiveMap->isDefined()) {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP, emissiveMap->getTextureView());
+            textures[ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP] = emissiveMap->getTextureView()._texture;
         } else {
-            batch.setResourceTexture(ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP, textureCache->getBlackTexture());
+            textures[ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP] = textureCache->getBlackTexture();
         }
     } else {
-        batch.setResourceTexture(ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP, nullptr);
+        textures[ShapePipeline::Slot::MAP::EMISSIVE_LIGHTMAP] = nullptr;
+    }
+
+    if (!_textureTable || _textureTable->getTextures() != textures) {
+        _textureTable = std::make_shared<gpu::TextureTable>(textures);
     }
+    batch.setResourceTextureTable(_textureTable);
 }
 
 void MeshPartPayload::bindTransform(gpu::Batch& batch, const ShapePipeline::LocationsPointer locations, bool canCauterize) const {
@@ -286,6 +300,31 @@ void MeshPartPayload::bindTransform(gpu::Batch& batch, const ShapePipeline::Loca
 }
 
 
+float MeshPartPayload::evalScreenSize(RenderArgs* args, const AABox& worldBound) {
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
+    float distance = std::max(glm::distance(viewFrustum.getPosition(), worldBound.calcCenter()), viewFrustum.getNearClip());
+    float pixelsPerMeter = (float)args->_viewport.w /
+        (2.0f * tanf(0.5f * glm::radians(viewFrustum.getFieldOfView())) * distance);
+    return worldBound.getLargestDimension() * pixelsPerMeter;
+}
+
+void MeshPartPayload::requestTextureMips(RenderArgs* args, float screenSize) const {
+    if (!_drawMaterial || args->_renderMode == RenderArgs::SHADOW_RENDER_MODE) {
+        return;
+    }
+
+    // Assume the textures span the largest dimension of the part once
+
+    for (const auto& textureMap : _drawMaterial->getTextureMaps()) {
+        if (textureMap.second && textureMap.second->isDefined()) {
+            auto texture = textureMap.second->getTextureView()._texture;
+            if (texture) {
+                texture->requestMinMipForScreenSize(screenSize);
+            }
+        }
+    }
+}
+
 void MeshPartPayload::render(RenderArgs* args) const {
     PerformanceTimer perfTimer("MeshPartPayload::render");
 
@@ -296,6 +335,7 @@ void MeshPartPayload::render(RenderArgs* args) const {
 
     // Bind the model transform and the skinCLusterMatrices if needed
     bindTransform(batch, locations);
+    requestTextureMips(args);
 
     //Bind the index buffer and vertex buffer and Blend shapes if needed
     bindMesh(batch);
@@ -371,6 +411,13 @@ void ModelMeshPartPayload::initCache() {
         const FBXMesh& mesh = geometry.meshes.at(_meshIndex);
 
         _isBlendShaped = !mesh.blendshapes.isEmpty();
+        _hasClusterBuffer = mesh.clusters.size() > 1;
+
+        _lods = _model->getGeometry()->getMeshLODs().at(_meshIndex);
+        if (_lods.size() >= RenderDetails::MAX_MESH_LODS) {
+            _lods.resize(RenderDetails::MAX_MESH_LODS - 1);
+        }
+        _lodLevel = std::min(_lodLevel, (int)_lods.size());
     }
 
     auto networkMaterial = _model->getGeometry()->getShapeMaterial(_shapeID);
@@ -465,7 +512,7 @@ ShapeKey ModelMeshPartPayload::getShapeKey() const {
     bool hasLightmap = drawMaterialKey.isLightmapMap();
     bool isUnlit = drawMaterialKey.isUnlit();
 
-    bool isSkinned = _isSkinned;
+    bool isSkinned = _isSkinned && !canUseSkinnedVertexCache();
     bool wireframe = _model->isWireframe();
 
     if (wireframe) {
@@ -498,26 +545,110 @@ ShapeKey ModelMeshPartPayload::getShapeKey() const {
 }
 
 void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) const {
-    if (!_isBlendShaped) {
+    if (canUseSkinnedVertexCache()) {
+        const Model::MeshState& state = _model->_meshStates.at(_meshIndex);
         batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
 
-        batch.setInputFormat((_drawMesh->getVertexFormat()));
+        batch.setInputFormat(state.skinnedVertexFormat);
 
-        batch.setInputStream(0, _drawMesh->getVertexStream());
+        batch.setInputStream(0, state.skinnedVertexStream);
     } else {
         batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
 
-        batch.setInputFormat((_drawMesh->getVertexFormat()));
+        bindSourceVertices(batch);
+    }
+
+    float fadeRatio = _isFading ? Interpolate::calculateFadeRatio(_fadeStartTime) : 1.0f;
+    if (!_hasColorAttrib || fadeRatio < 1.0f) {
+        batch._glColor4f(1.0f, 1.0f, 1.0f, fadeRatio);
+    }
+}
+
+void ModelMeshPartPayload::bindSourceVertices(gpu::Batch& batch) const {
+    batch.setInputFormat((_drawMesh->getVertexFormat()));
 
+    if (!_isBlendShaped) {
+        batch.setInputStream(0, _drawMesh->getVertexStream());
+    } else {
         batch.setInputBuffer(0, _model->_blendedVertexBuffers[_meshIndex], 0, sizeof(glm::vec3));
         batch.setInputBuffer(1, _model->_blendedVertexBuffers[_meshIndex], _drawMesh->getNumVertices() * sizeof(glm::vec3), sizeof(glm::vec3));
         batch.setInputStream(2, _drawMesh->getVertexStream().makeRangedStream(2));
     }
+}
 
-    float fadeRatio = _isFading ? Interpolate::calculateFadeRatio(_fadeStartTime) : 1.0f;
-    if (!_hasColorAttrib || fadeRatio < 1.0f) {
-        batch._glColor4f(1.0f, 1.0f, 1.0f, fadeRatio);
+bool ModelMeshPartPayload::canUseSkinnedVertexCache() const {
+    return _isSkinned && _hasClusterBuffer && !_model->getCauterizeBones();
+}
+
+// position, normal and tangent, as they are interleaved by skin_model_feedback.slv
+static const gpu::Offset SKINNED_VERTEX_SIZE = 3 * sizeof(glm::vec3);
+
+static const gpu::PipelinePointer& getSkinningPipeline() {
+    static gpu::PipelinePointer skinningPipeline;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        auto vs = gpu::Shader::createVertex(std::string(skin_model_feedback_vert));
+        auto ps = gpu::Shader::createPixel(std::string(model_shadow_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+        program->setTransformFeedbackVaryings({ "_skinnedPosition", "_skinnedNormal", "_skinnedTangent" });
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("skinClusterBuffer"), ShapePipeline::Slot::BUFFER::SKINNING));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        skinningPipeline = gpu::Pipeline::create(program, std::make_shared<gpu::State>());
+    });
+    return skinningPipeline;
+}
+
+void ModelMeshPartPayload::updateSkinnedVertices(RenderArgs* args) const {
+    Model::MeshState& state = _model->_meshStates[_meshIndex];
+    if (!state.skinnedVerticesNeedUpdate) {
+        return;
+    }
+
+    const uint32_t numVertices = (uint32_t)_drawMesh->getNumVertices();
+    if (!state.skinnedVertexBuffer) {
+        state.skinnedVertexBuffer = std::make_shared<gpu::Buffer>();
+        state.skinnedVertexBuffer->resize(numVertices * SKINNED_VERTEX_SIZE);
+
+        // the skinned attributes come from the captured buffer, the others still from the buffers of the mesh
+        state.skinnedVertexFormat = std::make_shared<gpu::Stream::Format>();
+        state.skinnedVertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0);
+        state.skinnedVertexFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), sizeof(glm::vec3));
+        state.skinnedVertexFormat->setAttribute(gpu::Stream::TANGENT, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 2 * sizeof(glm::vec3));
+        state.skinnedVertexStream.clear();
+        state.skinnedVertexStream.addBuffer(state.skinnedVertexBuffer, 0, SKINNED_VERTEX_SIZE);
+
+        const auto& meshStream = _drawMesh->getVertexStream();
+        gpu::Stream::Slot channel = 1;
+        for (const auto& entry : _drawMesh->getVertexFormat()->getAttributes()) {
+            const gpu::Stream::Attribute& attribute = entry.second;
+            switch (attribute._slot) {
+                case gpu::Stream::POSITION:
+                case gpu::Stream::NORMAL:
+                case gpu::Stream::TANGENT:
+                case gpu::Stream::SKIN_CLUSTER_INDEX:
+                case gpu::Stream::SKIN_CLUSTER_WEIGHT:
+                    continue;
+                default:
+                    break;
+            }
+            state.skinnedVertexFormat->setAttribute(attribute._slot, channel, attribute._element, attribute._offset,
+                (gpu::Stream::Frequency)attribute._frequency);
+            state.skinnedVertexStream.addBuffer(meshStream.getBuffers()[attribute._channel],
+                meshStream.getOffsets()[attribute._channel], meshStream.getStrides()[attribute._channel]);
+            ++channel;
+        }
     }
+
+    gpu::Batch& batch = *(args->_batch);
+    batch.setPipeline(getSkinningPipeline());
+    bindSourceVertices(batch);
+    batch.captureVertices(state.skinnedVertexBuffer, numVertices);
+    batch.setPipeline(args->_pipeline->pipeline);
+
+    state.skinnedVerticesNeedUpdate = false;
 }
 
 void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const ShapePipeline::LocationsPointer locations, bool canCauterize) const {
@@ -598,9 +729,20 @@ void ModelMeshPartPayload::render(RenderArgs* args) const {
     bool canCauterize = args->_renderMode != RenderArgs::SHADOW_RENDER_MODE;
     _model->updateClusterMatrices(_transform.getTranslation(), _transform.getRotation());
     bindTransform(batch, locations, canCauterize);
+    if (canUseSkinnedVertexCache()) {
+        updateSkinnedVertices(args);
+    }
+    requestTextureMips(args);
+    int lodLevel = updateLODLevel(args);
+
+    if (canDrawInstanced()) {
+        drawInstanced(args, lodLevel);
+        return;
+    }
 
     //Bind the index buffer and vertex buffer and Blend shapes if needed
     bindMesh(batch);
+    bindLODIndexBuffer(batch, lodLevel);
 
     // apply material properties
     bindMaterial(batch, locations);
@@ -610,14 +752,83 @@ void ModelMeshPartPayload::render(RenderArgs* args) const {
     }
 
     // Draw!
+    const model::Mesh::Part& drawPart = getLODPart(lodLevel);
     {
         PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
+        batch.drawIndexed(gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
     }
 
     if (args) {
         const int INDICES_PER_TRIANGLE = 3;
-        args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+        args->_details._trianglesRendered += drawPart._numIndices / INDICES_PER_TRIANGLE;
+        args->_details._lodTrianglesRendered[lodLevel] += drawPart._numIndices / INDICES_PER_TRIANGLE;
     }
 }
 
+// A part is drawn at a LOD while it spans fewer pixels than the threshold of the level above
+static const float LOD_SCREEN_SIZES[RenderDetails::MAX_MESH_LODS - 1] = { 256.0f, 128.0f, 64.0f };
+// and only moves to another level once it is this far past the threshold, so it doesn't flicker between two of them
+static const float LOD_HYSTERESIS = 0.1f;
+
+int ModelMeshPartPayload::updateLODLevel(RenderArgs* args) const {
+    // The shadows are drawn with the level the part was last seen at
+    if (_lods.empty() || args->_renderMode == RenderArgs::SHADOW_RENDER_MODE) {
+        return _lodLevel;
+    }
+
+    _lodLevel = evalLODLevel(evalScreenSize(args), _lodLevel);
+    return _lodLevel;
+}
+
+int ModelMeshPartPayload::evalLODLevel(float screenSize, int lodLevel) const {
+    const int numLevels = (int)_lods.size();
+    while (lodLevel > 0 && screenSize > LOD_SCREEN_SIZES[lodLevel - 1] * (1.0f + LOD_HYSTERESIS)) {
+        --lodLevel;
+    }
+    while (lodLevel < numLevels && screenSize < LOD_SCREEN_SIZES[lodLevel] * (1.0f - LOD_HYSTERESIS)) {
+        ++lodLevel;
+    }
+    return lodLevel;
+}
+
+void ModelMeshPartPayload::bindLODIndexBuffer(gpu::Batch& batch, int lodLevel) const {
+    if (lodLevel > 0) {
+        batch.setIndexBuffer(gpu::UINT32, _lods[lodLevel - 1]._indexBuffer._buffer, 0);
+    }
+}
+
+bool ModelMeshPartPayload::canDrawInstanced() const {
+    return !_isSkinned && !_isBlendShaped && !_isFading && !getShapeKey().isTranslucent();
+}
+
+void ModelMeshPartPayload::drawInstanced(RenderArgs* args, int lodLevel) const {
+    gpu::Batch& batch = *(args->_batch);
+    auto pipeline = args->_pipeline;
+    const model::Mesh::Part drawPart = getLODPart(lodLevel);
+
+    // Every copy of this mesh part drawn at the same LOD with the same material and pipeline shares one named call,
+    // the batch captures the model transform of each copy and draws them all at once when it is flushed
+    std::string instanceName = "model_part_" + std::to_string(std::hash<const void*>()(_drawMesh.get())) +
+        "_" + std::to_string(_drawPart._startIndex) + "_" + std::to_string(_drawPart._numIndices) +
+        "_lod" + std::to_string(lodLevel) +
+        "_" + std::to_string(std::hash<const void*>()(_drawMaterial.get())) +
+        "_" + std::to_string(std::hash<render::ShapePipelinePointer>()(pipeline));
+
+    // The call is set up by the first copy and the batch is flushed before the scene can remove it
+    batch.setupNamedCalls(instanceName, [this, pipeline, lodLevel, drawPart](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        batch.setPipeline(pipeline->pipeline);
+        if (pipeline->batchSetter) {
+            pipeline->batchSetter(*pipeline, batch);
+        }
+
+        bindMesh(batch);
+        bindLODIndexBuffer(batch, lodLevel);
+        bindMaterial(batch, pipeline->locations);
+        batch.drawIndexedInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
+    });
+
+    args->_details._materialSwitches++;
+    const int INDICES_PER_TRIANGLE = 3;
+    args->_details._trianglesRendered += drawPart._numIndices / INDICES_PER_TRIANGLE;
+    args->_details._lodTrianglesRendered[lodLevel] += drawPart._numIndices / INDICES_PER_TRIANGLE;
+}
@@ -20,6 +20,7 @@
 #include <render/ShapePipeline.h>
 
 #include <model/Geometry.h>
+#include <model/MeshLOD.h>
 
 class Model;
 
@@ -49,6 +50,12 @@ public:
     virtual void bindMesh(gpu::Batch& batch) const;
     virtual void bindMaterial(gpu::Batch& batch, const render::ShapePipeline::LocationsPointer locations) const;
     virtual void bindTransform(gpu::Batch& batch, const render::ShapePipeline::LocationsPointer locations, bool canCauterize = true) const;
+    // The size in pixels the largest dimension of the part spans on screen
+    float evalScreenSize(RenderArgs* args) const { return evalScreenSize(args, _worldBound); }
+    static float evalScreenSize(RenderArgs* args, const AABox& worldBound);
+    // Request the material texture mips for how large the part is on screen, so the backend can stream them in
+    void requestTextureMips(RenderArgs* args) const { requestTextureMips(args, evalScreenSize(args)); }
+    void requestTextureMips(RenderArgs* args, float screenSize) const;
 
     // Payload resource cached values
     std::shared_ptr<const model::Mesh> _drawMesh;
@@ -56,6 +63,8 @@ public:
     model::Mesh::Part _drawPart;
 
     std::shared_ptr<const model::Material> _drawMaterial;
+    // the textures of the material bindMaterial picked last, a batch may still be holding the previous table
+    mutable gpu::TextureTablePointer _textureTable;
     
     model::Box _localBound;
     Transform _drawTransform;
@@ -104,6 +113,22 @@ public:
     void bindMesh(gpu::Batch& batch) const override;
     void bindTransform(gpu::Batch& batch, const render::ShapePipeline::LocationsPointer locations, bool canCauterize) const override;
 
+    // Opaque parts that are neither skinned, blended nor fading can be drawn with every other copy of the same part
+    bool canDrawInstanced() const;
+    void drawInstanced(RenderArgs* args, int lodLevel) const;
+
+    // Pick the LOD to draw for how large the part is on screen, 0 is the full mesh and the others index _lods from 1
+    int updateLODLevel(RenderArgs* args) const;
+    // The level for a screen size, moving from the level given
+    int evalLODLevel(float screenSize, int lodLevel) const;
+    const model::Mesh::Part& getLODPart(int lodLevel) const { return lodLevel > 0 ? _lods[lodLevel - 1]._parts[_partIndex] : _drawPart; }
+    void bindLODIndexBuffer(gpu::Batch& batch, int lodLevel) const;
+
+    // Skinned parts are drawn from the vertices of their mesh skinned once a frame into Model::MeshState,
+    // rather than skinned again by every pass, unless the bones of the model are cauterized for some of them
+    bool canUseSkinnedVertexCache() const;
+    void updateSkinnedVertices(RenderArgs* args) const;
+
     void initCache();
 
     Model* _model;
@@ -113,8 +138,14 @@ public:
 
     bool _isSkinned{ false };
     bool _isBlendShaped{ false };
+    bool _hasClusterBuffer{ false };
+
+    model::MeshLODs _lods;
 
 private:
+    void bindSourceVertices(gpu::Batch& batch) const;
+
+    mutable int _lodLevel { 0 };
     quint64 _fadeStartTime { 0 };
     bool _hasStartedFade { false };
     mutable bool _hasFinishedFade { false };
@@ -13,10 +13,13 @@
 #include <QRunnable>
 #include <QThreadPool>
 
+#include <mutex>
+
 #include <glm/gtx/transform.hpp>
 #include <glm/gtx/norm.hpp>
 
 #include <GeometryUtil.h>
+#include <ParallelFor.h>
 #include <PathUtils.h>
 #include <PerfStat.h>
 #include <ViewFrustum.h>
@@ -25,6 +28,7 @@
 #include "AbstractViewStateInterface.h"
 #include "MeshPartPayload.h"
 #include "Model.h"
+#include "ModelInstanceSet.h"
 
 #include "RenderUtilsLogging.h"
 
@@ -33,6 +37,7 @@ using namespace std;
 int nakedModelPointerTypeId = qRegisterMetaType<ModelPointer>();
 int weakGeometryResourceBridgePointerTypeId = qRegisterMetaType<Geometry::WeakPointer >();
 int vec3VectorTypeId = qRegisterMetaType<QVector<glm::vec3> >();
+int intVectorTypeId = qRegisterMetaType<QVector<int> >();
 float Model::FAKE_DIMENSION_PLACEHOLDER = -1.0f;
 #define HTTP_INVALID_COM "http://invalid.com"
 
@@ -178,6 +183,10 @@ size_t Model::getRenderInfoTextureSize() {
 }
 
 
+// the models whose render items were updated this frame, for updatePendingClusterMatrices
+static std::mutex pendingClusterMatricesLock;
+static std::vector<std::weak_ptr<Model>> pendingClusterMatrices;
+
 void Model::updateRenderItems() {
     if (!_addedToScene) {
         return;
@@ -190,6 +199,15 @@ void Model::updateRenderItems() {
     }
     _needsUpdateClusterMatrices = true;
     _renderItemsNeedUpdate = false;
+    if (_instanceSet) {
+        // the set brings the matrices of its copies up to date as it updates its render items
+        _instanceSet->instanceChanged();
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(pendingClusterMatricesLock);
+        pendingClusterMatrices.push_back(shared_from_this());
+    }
 
     // queue up this work for later processing, at the end of update and just before rendering.
     // the application will ensure only the last lambda is actually invoked.
@@ -351,10 +369,17 @@ bool Model::findRayIntersectionAgainstSubMeshes(const glm::vec3& origin, const g
 
         const FBXGeometry& geometry = getFBXGeometry();
 
+        // the triangles are picked in the frame of the meshes, the same transform as calculateScaledOffsetPoint
+        glm::mat4 meshToWorldMatrix = modelToWorldMatrix * glm::scale(_scale) * glm::translate(_offset) * geometry.offset;
+        glm::mat4 worldToMeshMatrix = glm::inverse(meshToWorldMatrix);
+        glm::vec3 meshFrameOrigin = glm::vec3(worldToMeshMatrix * glm::vec4(origin, 1.0f));
+        glm::vec3 meshFrameDirection = glm::vec3(worldToMeshMatrix * glm::vec4(direction, 0.0f));
+        bool mirrored = glm::determinant(glm::mat3(meshToWorldMatrix)) < 0.0f;
+
         // If we hit the models box, then consider the submeshes...
         _mutex.lock();
-        if (!_calculatedMeshBoxesValid || (pickAgainstTriangles && !_calculatedMeshTrianglesValid)) {
-            recalculateMeshBoxes(pickAgainstTriangles);
+        if (!_calculatedMeshBoxesValid) {
+            recalculateMeshBoxes();
         }
 
         for (const auto& subMeshBox : _calculatedMeshBoxes) {
@@ -363,18 +388,17 @@ bool Model::findRayIntersectionAgainstSubMeshes(const glm::vec3& origin, const g
                 if (distanceToSubMesh < bestDistance) {
                     if (pickAgainstTriangles) {
                         // check our triangles here....
-                        const QVector<Triangle>& meshTriangles = _calculatedMeshTriangles[subMeshIndex];
-                        for(const auto& triangle : meshTriangles) {
-                            float thisTriangleDistance;
-                            if (findRayTriangleIntersection(origin, direction, triangle, thisTriangleDistance)) {
-                                if (thisTriangleDistance < bestDistance) {
-                                    bestDistance = thisTriangleDistance;
-                                    intersectedSomething = true;
-                                    face = subMeshFace;
-                                    surfaceNormal = triangle.getNormal();
-                                    extraInfo = geometry.getModelNameOfMesh(subMeshIndex);
-                                }
-                            }
+                        float thisTriangleDistance = bestDistance;
+                        Triangle triangle;
+                        if (geometry.meshes.at(subMeshIndex)._pickBVH.findRayIntersection(meshFrameOrigin,
+                                meshFrameDirection, thisTriangleDistance, triangle, mirrored)) {
+                            bestDistance = thisTriangleDistance;
+                            intersectedSomething = true;
+                            face = subMeshFace;
+                            Triangle worldTriangle = { calculateScaledOffsetPoint(triangle.v0),
+                                calculateScaledOffsetPoint(triangle.v1), calculateScaledOffsetPoint(triangle.v2) };
+                            surfaceNormal = worldTriangle.getNormal();
+                            extraInfo = geometry.getModelNameOfMesh(subMeshIndex);
                         }
                     } else {
                         // this is the non-triangle picking case...
@@ -597,6 +621,10 @@ void Model::setVisibleInScene(bool newValue, std::shared_ptr<render::Scene> scen
     if (_isVisible != newValue) {
         _isVisible = newValue;
 
+        if (_instanceSet) {
+            _instanceSet->instanceChanged();
+        }
+
         render::PendingChanges pendingChanges;
         foreach (auto item, _modelMeshRenderItems.keys()) {
             pendingChanges.resetItem(item, _modelMeshRenderItems[item]);
@@ -616,6 +644,16 @@ bool Model::addToScene(std::shared_ptr<render::Scene> scene,
         createRenderItemSet();
     }
 
+    if (!_collisionGeometry && !_instanceSet && canShareRenderItems()) {
+        _instanceSet = ModelInstanceSet::join(getThisPointer(), scene, pendingChanges);
+        _addedToScene = true;
+        _needsFixupInScene = false;
+        _renderInfoVertexCount = 0;
+        _renderInfoDrawCalls = 0;
+        _renderInfoHasTransparent = false;
+        return true;
+    }
+
     bool somethingAdded = false;
     if (_collisionGeometry) {
         if (_collisionRenderItems.empty()) {
@@ -665,6 +703,11 @@ bool Model::addToScene(std::shared_ptr<render::Scene> scene,
 }
 
 void Model::removeFromScene(std::shared_ptr<render::Scene> scene, render::PendingChanges& pendingChanges) {
+    if (_instanceSet) {
+        _instanceSet->leave(this, pendingChanges);
+        _instanceSet.reset();
+    }
+
     foreach (auto item, _modelMeshRenderItems.keys()) {
         pendingChanges.removeItem(item);
     }
@@ -869,6 +912,13 @@ void Model::setURL(const QUrl& url) {
     onInvalidate();
 }
 
+void Model::setLoadingPriority(float priority) {
+    _loadingPriority = priority;
+    if (!isLoaded()) {
+        _renderWatcher.setLoadPriority(this, _loadingPriority);
+    }
+}
+
 void Model::loadURLFinished(bool success) {
     if (!success) {
         _visualGeometryRequestFailed = true;
@@ -954,31 +1004,52 @@ Blender::Blender(ModelPointer model, int blendNumber, const Geometry::WeakPointe
 
 void Blender::run() {
     PROFILE_RANGE(__FUNCTION__);
+    // only the vertices moved by one of the active blendshapes are blended and posted back, by mesh in the order of
+    // their indices: the model keeps the others at their rest positions
+    QVector<int> meshIndexCounts, indices;
     QVector<glm::vec3> vertices, normals;
     if (_model) {
-        int offset = 0;
+        std::vector<int> blendedSlots;
         foreach (const FBXMesh& mesh, _meshes) {
             if (mesh.blendshapes.isEmpty()) {
                 continue;
             }
-            vertices += mesh.vertices;
-            normals += mesh.normals;
-            glm::vec3* meshVertices = vertices.data() + offset;
-            glm::vec3* meshNormals = normals.data() + offset;
-            offset += mesh.vertices.size();
+            const float EPSILON = 0.0001f;
+            int numBlendshapes = qMin(_blendshapeCoefficients.size(), mesh.blendshapes.size());
+            blendedSlots.assign(mesh.vertices.size(), -1);
+            for (int i = 0; i < numBlendshapes; i++) {
+                if (_blendshapeCoefficients.at(i) < EPSILON) {
+                    continue;
+                }
+                foreach (int index, mesh.blendshapes.at(i).indices) {
+                    blendedSlots[index] = 0;
+                }
+            }
+            int first = indices.size();
+            for (int index = 0; index < (int)blendedSlots.size(); index++) {
+                if (blendedSlots[index] == 0) {
+                    blendedSlots[index] = indices.size() - first;
+                    indices.push_back(index);
+                    vertices.push_back(mesh.vertices.at(index));
+                    normals.push_back(mesh.normals.at(index));
+                }
+            }
+            meshIndexCounts.push_back(indices.size() - first);
+
+            glm::vec3* meshVertices = vertices.data() + first;
+            glm::vec3* meshNormals = normals.data() + first;
             const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-            for (int i = 0, n = qMin(_blendshapeCoefficients.size(), mesh.blendshapes.size()); i < n; i++) {
+            for (int i = 0; i < numBlendshapes; i++) {
                 float vertexCoefficient = _blendshapeCoefficients.at(i);
-                const float EPSILON = 0.0001f;
                 if (vertexCoefficient < EPSILON) {
                     continue;
                 }
                 float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
                 const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
                 for (int j = 0; j < blendshape.indices.size(); j++) {
-                    int index = blendshape.indices.at(j);
-                    meshVertices[index] += blendshape.vertices.at(j) * vertexCoefficient;
-                    meshNormals[index] += blendshape.normals.at(j) * normalCoefficient;
+                    int slot = blendedSlots[blendshape.indices.at(j)];
+                    meshVertices[slot] += blendshape.vertices.at(j) * vertexCoefficient;
+                    meshNormals[slot] += blendshape.normals.at(j) * normalCoefficient;
                 }
             }
         }
@@ -986,7 +1057,8 @@ void Blender::run() {
     // post the result to the geometry cache, which will dispatch to the model if still alive
     QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
         Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber),
-        Q_ARG(const Geometry::WeakPointer&, _geometry), Q_ARG(const QVector<glm::vec3>&, vertices),
+        Q_ARG(const Geometry::WeakPointer&, _geometry), Q_ARG(const QVector<int>&, meshIndexCounts),
+        Q_ARG(const QVector<int>&, indices), Q_ARG(const QVector<glm::vec3>&, vertices),
         Q_ARG(const QVector<glm::vec3>&, normals));
 }
 
@@ -1094,7 +1166,19 @@ void Model::simulate(float deltaTime, bool fullUpdate) {
         if (_snapModelToRegistrationPoint && !_snappedToRegistrationPoint) {
             snapToRegistrationPoint();
         }
-        simulateInternal(deltaTime);
+        if (_isRigUpdateDeferred) {
+            _hasDeferredRigUpdate = true;
+            _deferredRigDeltaTime = deltaTime;
+        } else {
+            simulateInternal(deltaTime);
+        }
+    }
+}
+
+void Model::simulateDeferredRig() {
+    if (_hasDeferredRigUpdate) {
+        _hasDeferredRigUpdate = false;
+        simulateInternal(_deferredRigDeltaTime);
     }
 }
 
@@ -1118,34 +1202,92 @@ void Model::updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrient
         return;
     }
     _needsUpdateClusterMatrices = false;
+    computeClusterMatrices(modelPosition, modelOrientation);
+    finishClusterMatricesUpdate();
+}
+
+void Model::updatePendingClusterMatrices() {
+    PerformanceTimer perfTimer("Model::updatePendingClusterMatrices");
+
+    std::vector<std::weak_ptr<Model>> pending;
+    {
+        std::unique_lock<std::mutex> lock(pendingClusterMatricesLock);
+        pending.swap(pendingClusterMatrices);
+    }
+
+    // a model is only taken once, however many times it was queued
+    std::vector<ModelPointer> models;
+    models.reserve(pending.size());
+    for (auto& weakModel : pending) {
+        auto model = weakModel.lock();
+        if (model && model->_needsUpdateClusterMatrices && model->isLoaded()) {
+            model->_needsUpdateClusterMatrices = false;
+            models.push_back(model);
+        }
+    }
+
+    parallelFor((int)models.size(), [&](int i) {
+        const ModelPointer& model = models[i];
+        model->computeClusterMatrices(model->_translation, model->_rotation);
+    });
+
+    for (auto& model : models) {
+        model->finishClusterMatricesUpdate();
+    }
+}
+
+void Model::finishClusterMatricesUpdate() {
+    for (auto& state : _meshStates) {
+        state.skinnedVerticesNeedUpdate = true;
+    }
+
+    // post the blender if we're not currently waiting for one to finish
+    const FBXGeometry& geometry = getFBXGeometry();
+    if (geometry.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
+        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
+        DependencyManager::get<ModelBlender>()->noteRequiresBlend(getThisPointer());
+    }
+}
+
+void Model::computeClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation) {
     const FBXGeometry& geometry = getFBXGeometry();
     glm::mat4 zeroScale(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f),
         glm::vec4(0.0f, 0.0f, 0.0f, 0.0f),
         glm::vec4(0.0f, 0.0f, 0.0f, 0.0f),
         glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-    auto cauterizeMatrix = _rig->getJointTransform(geometry.neckJointIndex) * zeroScale;
-
     glm::mat4 modelToWorld = glm::mat4_cast(modelOrientation);
+    auto cauterizeMatrix = modelToWorld * _rig->getJointTransform(geometry.neckJointIndex) * zeroScale;
+
+    // build the matrix of each joint once, the clusters of different meshes often share joints
+    int numJoints = _rig->getJointStateCount();
+    _jointMatrices.resize(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        _jointMatrices[i] = modelToWorld * _rig->getJointTransform(i);
+    }
+
     for (int i = 0; i < _meshStates.size(); i++) {
         MeshState& state = _meshStates[i];
         const FBXMesh& mesh = geometry.meshes.at(i);
 
         for (int j = 0; j < mesh.clusters.size(); j++) {
             const FBXCluster& cluster = mesh.clusters.at(j);
-            auto jointMatrix = _rig->getJointTransform(cluster.jointIndex);
-            state.clusterMatrices[j] = modelToWorld * jointMatrix * cluster.inverseBindMatrix;
+            bool isJointValid = cluster.jointIndex >= 0 && cluster.jointIndex < numJoints;
+            const glm::mat4& jointMatrix = isJointValid ? _jointMatrices[cluster.jointIndex] : modelToWorld;
+            multiplyMat4(jointMatrix, cluster.inverseBindMatrix, state.clusterMatrices[j]);
 
             // as an optimization, don't build cautrizedClusterMatrices if the boneSet is empty.
             if (!_cauterizeBoneSet.empty()) {
                 if (_cauterizeBoneSet.find(cluster.jointIndex) != _cauterizeBoneSet.end()) {
-                    jointMatrix = cauterizeMatrix;
+                    multiplyMat4(cauterizeMatrix, cluster.inverseBindMatrix, state.cauterizedClusterMatrices[j]);
+                } else {
+                    state.cauterizedClusterMatrices[j] = state.clusterMatrices[j];
                 }
-                state.cauterizedClusterMatrices[j] = modelToWorld * jointMatrix * cluster.inverseBindMatrix;
             }
         }
 
         // Once computed the cluster matrices, update the buffer(s)
         if (mesh.clusters.size() > 1) {
+
             if (!state.clusterBuffer) {
                 state.clusterBuffer = std::make_shared<gpu::Buffer>(state.clusterMatrices.size() * sizeof(glm::mat4),
                                                                     (const gpu::Byte*) state.clusterMatrices.constData());
@@ -1166,12 +1308,6 @@ void Model::updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrient
             }
         }
     }
-
-    // post the blender if we're not currently waiting for one to finish
-    if (geometry.hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
-        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        DependencyManager::get<ModelBlender>()->noteRequiresBlend(getThisPointer());
-    }
 }
 
 void Model::inverseKinematics(int endIndex, glm::vec3 targetPosition, const glm::quat& targetRotation, float priority) {
@@ -1205,32 +1341,101 @@ bool Model::maybeStartBlender() {
     return false;
 }
 
-void Model::setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) {
+void Model::setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry, const QVector<int>& meshIndexCounts,
+        const QVector<int>& indices, const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) {
     auto geometryRef = geometry.lock();
     if (!geometryRef || _renderGeometry != geometryRef || _blendedVertexBuffers.empty() || blendNumber < _appliedBlendNumber) {
         return;
     }
     _appliedBlendNumber = blendNumber;
     const FBXGeometry& fbxGeometry = getFBXGeometry();
-    int index = 0;
-    for (int i = 0; i < fbxGeometry.meshes.size(); i++) {
+    int blendedMesh = 0;
+    int offset = 0;
+    for (int i = 0; i < fbxGeometry.meshes.size() && i < _meshStates.size(); i++) {
         const FBXMesh& mesh = fbxGeometry.meshes.at(i);
         if (mesh.blendshapes.isEmpty()) {
             continue;
         }
-
+        if (blendedMesh >= meshIndexCounts.size()) {
+            break;
+        }
+        int count = meshIndexCounts.at(blendedMesh++);
+        const int* newIndices = indices.constData() + offset;
+        const glm::vec3* newVertices = vertices.constData() + offset;
+        const glm::vec3* newNormals = normals.constData() + offset;
+        offset += count;
+
+        // the vertices blended the last time and not this time go back to their rest positions, the runs of
+        // vertices written are joined over the short gaps of vertices at rest so the buffer takes few, larger writes
+        MeshState& state = _meshStates[i];
+        const QVector<int>& oldIndices = state.blendedIndices;
         gpu::BufferPointer& buffer = _blendedVertexBuffers[i];
-        buffer->setSubData(0, mesh.vertices.size() * sizeof(glm::vec3), (gpu::Byte*) vertices.constData() + index*sizeof(glm::vec3));
-        buffer->setSubData(mesh.vertices.size() * sizeof(glm::vec3),
-            mesh.normals.size() * sizeof(glm::vec3), (gpu::Byte*) normals.constData() + index*sizeof(glm::vec3));
+        gpu::Size normalsOffset = mesh.vertices.size() * sizeof(glm::vec3);
+        std::vector<glm::vec3> runVertices, runNormals;
+        int runStart = 0;
+        auto flushRun = [&] {
+            if (!runVertices.empty()) {
+                buffer->setSubData(runStart * sizeof(glm::vec3), runVertices.size() * sizeof(glm::vec3),
+                    (const gpu::Byte*)runVertices.data());
+                buffer->setSubData(normalsOffset + runStart * sizeof(glm::vec3), runNormals.size() * sizeof(glm::vec3),
+                    (const gpu::Byte*)runNormals.data());
+                runVertices.clear();
+                runNormals.clear();
+            }
+        };
+        const int MAX_RUN_GAP = 16;
+        int j = 0, k = 0;
+        while (j < count || k < oldIndices.size()) {
+            int index;
+            glm::vec3 vertex, normal;
+            if (k == oldIndices.size() || (j < count && newIndices[j] <= oldIndices.at(k))) {
+                index = newIndices[j];
+                vertex = newVertices[j];
+                normal = newNormals[j];
+                if (k < oldIndices.size() && oldIndices.at(k) == index) {
+                    k++;
+                }
+                j++;
+            } else {
+                index = oldIndices.at(k++);
+                vertex = mesh.vertices.at(index);
+                normal = mesh.normals.at(index);
+            }
+            int runEnd = runStart + (int)runVertices.size();
+            if (!runVertices.empty() && index - runEnd > MAX_RUN_GAP) {
+                flushRun();
+            }
+            if (runVertices.empty()) {
+                runStart = index;
+            } else {
+                for (int gap = runEnd; gap < index; gap++) {
+                    runVertices.push_back(mesh.vertices.at(gap));
+                    runNormals.push_back(mesh.normals.at(gap));
+                }
+            }
+            runVertices.push_back(vertex);
+            runNormals.push_back(normal);
+        }
+        flushRun();
 
-        index += mesh.vertices.size();
+        if (count != 0 || !oldIndices.isEmpty()) {
+            state.skinnedVerticesNeedUpdate = true;
+        }
+        state.blendedIndices = QVector<int>(count);
+        std::copy(newIndices, newIndices + count, state.blendedIndices.begin());
     }
 }
 
 void Model::deleteGeometry() {
     _deleteGeometryCounter++;
+    if (_instanceSet) {
+        // the parts of the set may be the parts of this model
+        render::PendingChanges pendingChanges;
+        _instanceSet->leave(this, pendingChanges);
+        _instanceSet.reset();
+        AbstractViewStateInterface::instance()->getMain3DScene()->enqueuePendingChanges(pendingChanges);
+        _addedToScene = false;
+    }
     _blendedVertexBuffers.clear();
     _meshStates.clear();
     _rig->destroyAnimGraph();
@@ -1344,6 +1549,29 @@ bool Model::isRenderable() const {
     return !_meshStates.isEmpty() || (isLoaded() && _renderGeometry->getMeshes().empty());
 }
 
+void Model::setCanShareRenderItems(bool canShareRenderItems) {
+    if (_canShareRenderItems != canShareRenderItems) {
+        _canShareRenderItems = canShareRenderItems;
+        if (_addedToScene && (bool)_instanceSet != canShareRenderItems) {
+            _needsFixupInScene = true;
+        }
+    }
+}
+
+bool Model::canShareRenderItems() const {
+    if (!_canShareRenderItems || !isLoaded() || _collisionGeometry || _isWireframe || _cauterizeBones ||
+            _modelMeshRenderItemsSet.isEmpty()) {
+        return false;
+    }
+    // a part that is drawn on its own can't be drawn for the other copies
+    foreach (auto renderItem, _modelMeshRenderItemsSet) {
+        if (!renderItem->canDrawInstanced() || renderItem->_hasClusterBuffer) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool Model::initWhenReady(render::ScenePointer scene) {
     // NOTE: this only called by SkeletonModel
     if (_addedToScene || !isRenderable()) {
@@ -1400,6 +1628,7 @@ public:
         std::shared_ptr<GeometryMeshes> meshes = std::make_shared<GeometryMeshes>();
         meshes->push_back(mesh);
         _meshes = meshes;
+        _meshLODs = std::make_shared<GeometryMeshLODs>(meshes->size());
         _meshParts = std::shared_ptr<const GeometryMeshParts>();
     }
 };
@@ -1434,10 +1663,11 @@ void ModelBlender::noteRequiresBlend(ModelPointer model) {
     }
 }
 
-void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber,
-        const Geometry::WeakPointer& geometry, const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) {
+void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry,
+        const QVector<int>& meshIndexCounts, const QVector<int>& indices, const QVector<glm::vec3>& vertices,
+        const QVector<glm::vec3>& normals) {
     if (model) {
-        model->setBlendedVertices(blendNumber, geometry, vertices, normals);
+        model->setBlendedVertices(blendNumber, geometry, meshIndexCounts, indices, vertices, normals);
     }
     _pendingBlenders--;
     {
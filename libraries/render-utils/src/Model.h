@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
+#include <vector>
 
 #include <AABox.h>
 #include <DependencyManager.h>
@@ -33,6 +34,7 @@
 #include "Rig.h"
 
 class AbstractViewStateInterface;
+class ModelInstanceSet;
 class QScriptEngine;
 
 #include "RenderArgs.h"
@@ -105,15 +107,21 @@ public:
 
     bool maybeStartBlender();
 
-    /// Sets blended vertices computed in a separate thread.
-    void setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
+    /// Sets blended vertices computed in a separate thread: the indices of the vertices the blendshapes moved, mesh
+    /// after mesh of the meshes with blendshapes, with their positions and normals.
+    void setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry, const QVector<int>& meshIndexCounts,
+        const QVector<int>& indices, const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
 
     bool isLoaded() const { return (bool)_renderGeometry; }
 
     void setIsWireframe(bool isWireframe) { _isWireframe = isWireframe; }
     bool isWireframe() const { return _isWireframe; }
 
+    /// Lets a static model be drawn by the render items of the other copies of its URL rather than by its own, see
+    /// ModelInstanceSet. The owner says whether nothing but the transform tells the model apart from its copies.
+    void setCanShareRenderItems(bool canShareRenderItems);
+    bool canShareRenderItems() const;
+
     void init();
     void reset();
 
@@ -123,8 +131,18 @@ public:
     bool getSnapModelToRegistrationPoint() { return _snapModelToRegistrationPoint; }
 
     virtual void simulate(float deltaTime, bool fullUpdate = true);
+
+    /// While deferred, simulate() leaves the rig update it would have done for simulateDeferredRig(),
+    /// which touches only this model and its rig so it can run on another thread.
+    void setRigUpdateDeferred(bool deferred) { _isRigUpdateDeferred = deferred; }
+    void simulateDeferredRig();
+
     virtual void updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation);
 
+    /// Updates the cluster matrices of every model whose render items were updated since the last call, all at once
+    /// and in parallel, rather than one at a time as their render items are. Call it before the post update lambdas.
+    static void updatePendingClusterMatrices();
+
     /// Returns a reference to the shared geometry.
     const Geometry::Pointer& getGeometry() const { return _renderGeometry; }
     /// Returns a reference to the shared collision geometry.
@@ -230,7 +248,8 @@ public:
     bool updateGeometry();
     void setCollisionMesh(model::MeshPointer mesh);
 
-    void setLoadingPriority(float priority) { _loadingPriority = priority; }
+    /// Sets the priority of the download of the geometry, it can keep changing while the geometry loads
+    void setLoadingPriority(float priority);
 
     size_t getRenderInfoVertexCount() const { return _renderInfoVertexCount; }
     int getRenderInfoTextureCount() const { return _renderInfoTextureCount; }
@@ -304,14 +323,28 @@ protected:
         gpu::BufferPointer clusterBuffer;
         gpu::BufferPointer cauterizedClusterBuffer;
 
+        // The skinned positions, normals and tangents of the mesh, captured once when the cluster matrices (or the
+        // blended vertices) change and then drawn by every pass of every part like a static mesh
+        gpu::BufferPointer skinnedVertexBuffer;
+        gpu::Stream::FormatPointer skinnedVertexFormat;
+        gpu::BufferStream skinnedVertexStream;
+        bool skinnedVerticesNeedUpdate { true };
+
+        // the sorted indices of the vertices of the blended vertex buffer that are away from their rest positions
+        QVector<int> blendedIndices;
     };
 
     QVector<MeshState> _meshStates;
+    std::vector<glm::mat4> _jointMatrices; // scratch space for updateClusterMatrices, joint to world rotation
     std::unordered_set<int> _cauterizeBoneSet;
     bool _cauterizeBones;
 
     virtual void initJointStates();
 
+    // computes the cluster matrices and fills the cluster buffers of this model only, so models can do it in parallel
+    virtual void computeClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrientation);
+    void finishClusterMatricesUpdate();
+
     void setScaleInternal(const glm::vec3& scale);
     void scaleToFit();
     void snapToRegistrationPoint();
@@ -394,9 +427,13 @@ protected:
     bool _needsFixupInScene { true }; // needs to be removed/re-added to scene
     bool _needsReload { true };
     bool _needsUpdateClusterMatrices { true };
+    bool _isRigUpdateDeferred { false };
+    bool _hasDeferredRigUpdate { false };
+    float _deferredRigDeltaTime { 0.0f };
     mutable bool _needsUpdateTextures { true };
 
     friend class ModelMeshPartPayload;
+    friend class ModelInstanceSet;
     RigPointer _rig;
 
     uint32_t _deleteGeometryCounter { 0 };
@@ -406,6 +443,10 @@ protected:
 
     bool _renderItemsNeedUpdate { false };
 
+    // the set of copies the model is drawn with, when it has no render items of its own
+    std::shared_ptr<ModelInstanceSet> _instanceSet;
+    bool _canShareRenderItems { false };
+
     size_t _renderInfoVertexCount { 0 };
     int _renderInfoTextureCount { 0 };
     size_t _renderInfoTextureSize { 0 };
@@ -433,7 +474,8 @@ public:
 
 public slots:
     void setBlendedVertices(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
+        const QVector<int>& meshIndexCounts, const QVector<int>& indices, const QVector<glm::vec3>& vertices,
+        const QVector<glm::vec3>& normals);
 
 private:
     using Mutex = std::mutex;
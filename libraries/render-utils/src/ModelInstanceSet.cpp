@@ -0,0 +1,220 @@
+//
+//  ModelInstanceSet.cpp
+//  libraries/render-utils/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelInstanceSet.h"
+
+#include <algorithm>
+
+#include <QtCore/QHash>
+
+#include <PerfStat.h>
+#include <ViewFrustum.h>
+
+#include "AbstractViewStateInterface.h"
+#include "Model.h"
+
+// the sets of the URLs that have copies in the scene
+static QHash<QUrl, std::weak_ptr<ModelInstanceSet>> instanceSets;
+
+namespace render {
+template <> const ItemKey payloadGetKey(const ModelInstancePartPayload::Pointer& payload) {
+    if (payload) {
+        return payload->getKey();
+    }
+    return ItemKey::Builder::opaqueShape(); // for lack of a better idea
+}
+
+template <> const Item::Bound payloadGetBound(const ModelInstancePartPayload::Pointer& payload) {
+    if (payload) {
+        return payload->getBound();
+    }
+    return Item::Bound();
+}
+
+template <> const ShapeKey shapeGetShapeKey(const ModelInstancePartPayload::Pointer& payload) {
+    if (payload) {
+        return payload->getShapeKey();
+    }
+    return ShapeKey::Builder::invalid();
+}
+
+template <> void payloadRender(const ModelInstancePartPayload::Pointer& payload, RenderArgs* args) {
+    return payload->render(args);
+}
+}
+
+render::ItemKey ModelInstancePartPayload::getKey() const {
+    // the parts of a set are opaque and not deformed, that's what lets the copies share them
+    render::ItemKey::Builder builder;
+    builder.withTypeShape();
+    if (_instances.empty()) {
+        builder.withInvisible();
+    }
+    return builder.build();
+}
+
+void ModelInstancePartPayload::render(RenderArgs* args) const {
+    PerformanceTimer perfTimer("ModelInstancePartPayload::render");
+
+    if (!_prototype->isLoaded() || !_prototype->getGeometry()->areTexturesLoaded() || !_part->getShapeKey().isValid()) {
+        return;
+    }
+
+    gpu::Batch& batch = *(args->_batch);
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
+    bool isShadowPass = args->_renderMode == RenderArgs::SHADOW_RENDER_MODE;
+    float largestScreenSize = 0.0f;
+    for (const auto& instance : _instances) {
+        if (!viewFrustum.boxIntersectsFrustum(instance.bound)) {
+            continue;
+        }
+        // the shadows are drawn with the level the copy was last seen at
+        if (!isShadowPass && !_part->_lods.empty()) {
+            float screenSize = MeshPartPayload::evalScreenSize(args, instance.bound);
+            largestScreenSize = std::max(largestScreenSize, screenSize);
+            instance.lodLevel = _part->evalLODLevel(screenSize, instance.lodLevel);
+        }
+        batch.setModelTransform(instance.transform);
+        _part->drawInstanced(args, instance.lodLevel);
+    }
+    if (largestScreenSize > 0.0f) {
+        _part->requestTextureMips(args, largestScreenSize);
+    }
+}
+
+ModelInstanceSet::Pointer ModelInstanceSet::join(const ModelPointer& model, const render::ScenePointer& scene,
+                                                 render::PendingChanges& pendingChanges) {
+    Pointer set = instanceSets.value(model->getURL()).lock();
+    if (!set) {
+        set = Pointer(new ModelInstanceSet(model));
+        set->_url = model->getURL();
+        set->addRenderItems(scene, pendingChanges);
+        instanceSets.insert(set->_url, set);
+    }
+    set->_instances.push_back(model.get());
+    set->instanceChanged();
+    return set;
+}
+
+void ModelInstanceSet::leave(Model* model, render::PendingChanges& pendingChanges) {
+    auto instance = std::find(_instances.begin(), _instances.end(), model);
+    if (instance == _instances.end()) {
+        return;
+    }
+    _instances.erase(instance);
+    if (!_instances.empty() && model != _prototype.get()) {
+        instanceChanged();
+        return;
+    }
+
+    for (const auto& renderItem : _renderItems) {
+        pendingChanges.removeItem(renderItem.first);
+    }
+    _renderItems.clear();
+    if (!_instances.empty()) {
+        // the parts of the first copy may not be there for much longer, the copies carry on with the parts of another
+        _prototype = _instances.front()->getThisPointer();
+        addRenderItems(AbstractViewStateInterface::instance()->getMain3DScene(), pendingChanges);
+        instanceChanged();
+        return;
+    }
+
+    // the parts of the first copy can go with it now, a model that joins later starts a set of its own
+    _prototype.reset();
+    if (instanceSets.value(_url).lock().get() == this) {
+        instanceSets.remove(_url);
+    }
+}
+
+ModelInstanceSet::~ModelInstanceSet() {
+    if (instanceSets.value(_url).expired()) {
+        instanceSets.remove(_url);
+    }
+}
+
+void ModelInstanceSet::addRenderItems(const render::ScenePointer& scene, render::PendingChanges& pendingChanges) {
+    for (const auto& part : _prototype->_modelMeshRenderItemsSet) {
+        auto item = scene->allocateID();
+        auto renderPayload = std::make_shared<ModelInstancePartPayload::Payload>(
+            std::make_shared<ModelInstancePartPayload>(_prototype, part));
+        pendingChanges.resetItem(item, renderPayload);
+        _renderItems.push_back({ item, part });
+    }
+}
+
+void ModelInstanceSet::instanceChanged() {
+    // however many copies changed, the render items are updated once, at the end of update and just before rendering
+    std::weak_ptr<ModelInstanceSet> weakSelf = shared_from_this();
+    AbstractViewStateInterface::instance()->pushPostUpdateLambda(this, [weakSelf]() {
+        auto self = weakSelf.lock();
+        if (self) {
+            self->updateRenderItems();
+        }
+    });
+}
+
+void ModelInstanceSet::updateRenderItems() {
+    if (_renderItems.empty()) {
+        return;
+    }
+
+    for (Model* model : _instances) {
+        if (model->isVisible() && model->isLoaded()) {
+            model->updateClusterMatrices(model->_translation, model->_rotation);
+        }
+    }
+
+    render::PendingChanges pendingChanges;
+    for (const auto& renderItem : _renderItems) {
+        const auto& part = renderItem.second;
+
+        std::vector<ModelInstancePartPayload::Instance> instances;
+        instances.reserve(_instances.size());
+        AABox bound;
+        for (Model* model : _instances) {
+            if (!model->isVisible() || !model->isLoaded() || part->_meshIndex >= model->_meshStates.size() ||
+                model->_meshStates.at(part->_meshIndex).clusterMatrices.isEmpty()) {
+                continue;
+            }
+            // as ModelMeshPartPayload::bindTransform, the cluster matrix has the rotation and scale of the model
+            // but not its translation
+            const glm::mat4& clusterMatrix = model->_meshStates.at(part->_meshIndex).clusterMatrices[0];
+            ModelInstancePartPayload::Instance instance;
+            instance.model = model;
+            instance.transform = Transform(clusterMatrix);
+            instance.transform.preTranslate(model->_translation);
+            instance.bound = part->_localBound;
+            instance.bound.transform(clusterMatrix);
+            instance.bound.translate(model->_translation);
+            bound += instance.bound;
+            instances.push_back(instance);
+        }
+
+        pendingChanges.updateItem<ModelInstancePartPayload>(renderItem.first,
+                [instances, bound](ModelInstancePartPayload& data) {
+            // the copies keep their levels, they stay in the order they joined in
+            std::vector<ModelInstancePartPayload::Instance> newInstances = instances;
+            size_t next = 0;
+            for (auto& instance : newInstances) {
+                for (size_t i = next; i < data._instances.size(); i++) {
+                    if (data._instances[i].model == instance.model) {
+                        instance.lodLevel = data._instances[i].lodLevel;
+                        next = i + 1;
+                        break;
+                    }
+                }
+            }
+            data._instances.swap(newInstances);
+            data._bound = bound;
+        });
+    }
+    AbstractViewStateInterface::instance()->getMain3DScene()->enqueuePendingChanges(pendingChanges);
+}
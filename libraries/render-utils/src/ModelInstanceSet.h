@@ -0,0 +1,103 @@
+//
+//  ModelInstanceSet.h
+//  libraries/render-utils/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ModelInstanceSet_h
+#define hifi_ModelInstanceSet_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QUrl>
+
+#include <AABox.h>
+#include <Transform.h>
+#include <render/Scene.h>
+
+#include "MeshPartPayload.h"
+
+class Model;
+using ModelPointer = std::shared_ptr<Model>;
+class ModelInstanceSet;
+
+// A mesh part of the models of a set, drawn for every copy in view with the instanced call of the part
+class ModelInstancePartPayload {
+public:
+    using Payload = render::Payload<ModelInstancePartPayload>;
+    using Pointer = Payload::DataPointer;
+
+    struct Instance {
+        const Model* model; // only to keep the level of a copy across updates
+        Transform transform;
+        AABox bound;
+        mutable int lodLevel { 0 };
+    };
+
+    ModelInstancePartPayload(const ModelPointer& prototype, const std::shared_ptr<ModelMeshPartPayload>& part) :
+        _prototype(prototype), _part(part) {}
+
+    render::ItemKey getKey() const;
+    render::Item::Bound getBound() const { return _bound; }
+    render::ShapeKey getShapeKey() const { return _part->getShapeKey(); }
+    void render(RenderArgs* args) const;
+
+    // the model of the part, kept for as long as the scene holds the render item
+    ModelPointer _prototype;
+    std::shared_ptr<ModelMeshPartPayload> _part;
+
+    // the copies as of the last update of the set, and the bound of them all
+    std::vector<Instance> _instances;
+    AABox _bound;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const ModelInstancePartPayload::Pointer& payload);
+    template <> const Item::Bound payloadGetBound(const ModelInstancePartPayload::Pointer& payload);
+    template <> const ShapeKey shapeGetShapeKey(const ModelInstancePartPayload::Pointer& payload);
+    template <> void payloadRender(const ModelInstancePartPayload::Pointer& payload, RenderArgs* args);
+}
+
+// The copies of a static model of the same URL, drawn by one render item for each mesh part of the model rather than by
+// render items of their own. The parts and materials of the first copy are drawn for all of them, each copy only adds
+// its transform, so the parts of copies in view go out in one instanced draw.
+//
+// The models of the set still simulate for themselves, for their picking and their shapes. Only the main thread uses
+// the sets.
+class ModelInstanceSet : public std::enable_shared_from_this<ModelInstanceSet> {
+public:
+    using Pointer = std::shared_ptr<ModelInstanceSet>;
+
+    // The set of the URL of the model, with the model in it. The first model of a URL creates the render items.
+    static Pointer join(const ModelPointer& model, const render::ScenePointer& scene, render::PendingChanges& pendingChanges);
+
+    // The render items go once the last model is gone
+    void leave(Model* model, render::PendingChanges& pendingChanges);
+
+    // The transforms and the visibility of the copies are taken in once before the next frame
+    void instanceChanged();
+
+    ~ModelInstanceSet();
+
+private:
+    ModelInstanceSet(const ModelPointer& prototype) : _prototype(prototype) {}
+
+    void addRenderItems(const render::ScenePointer& scene, render::PendingChanges& pendingChanges);
+    void updateRenderItems();
+
+    QUrl _url;
+    // the first copy, whose parts are drawn for all of them
+    ModelPointer _prototype;
+    std::vector<Model*> _instances;
+    std::vector<std::pair<render::ItemID, std::shared_ptr<ModelMeshPartPayload>>> _renderItems;
+};
+
+#endif // hifi_ModelInstanceSet_h
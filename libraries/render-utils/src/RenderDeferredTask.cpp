@@ -33,6 +33,7 @@
 #include "FramebufferCache.h"
 #include "HitEffect.h"
 #include "TextureCache.h"
+#include "TextRenderer3D.h"
 
 #include "AmbientOcclusionEffect.h"
 #include "AntialiasingEffect.h"
@@ -54,6 +55,7 @@ RenderDeferredTask::RenderDeferredTask(CullFunctor cullFunctor) {
     // Prepare the ShapePipelines
     ShapePlumberPointer shapePlumber = std::make_shared<ShapePlumber>();
     initDeferredPipelines(*shapePlumber);
+    addJob<PrecompileShapePipelines>("PrecompileShapePipelines", shapePlumber);
 
     // CPU jobs:
     // Fetch and cull the items from the scene
@@ -97,7 +99,10 @@ RenderDeferredTask::RenderDeferredTask(CullFunctor cullFunctor) {
     const auto lightingModel = addJob<MakeLightingModel>("LightingModel");
 
 
-    // GPU jobs: Start preparing the primary, deferred and lighting buffer
+    // GPU jobs: Scale the viewport down to the resolution the GPU time allows
+    const auto dynamicResolution = addJob<BeginDynamicResolution>("DynamicResolution");
+
+    // Start preparing the primary, deferred and lighting buffer
     const auto primaryFramebuffer = addJob<PreparePrimaryFramebuffer>("PreparePrimaryBuffer");
 
    // const auto fullFrameRangeTimer = addJob<BeginGPURangeTimer>("BeginRangeTimer");
@@ -111,6 +116,7 @@ RenderDeferredTask::RenderDeferredTask(CullFunctor cullFunctor) {
     // Render opaque objects in DeferredBuffer
     const auto opaqueInputs = DrawStateSortDeferred::Inputs(opaques, lightingModel).hasVarying();
     addJob<DrawStateSortDeferred>("DrawOpaqueDeferred", opaqueInputs, shapePlumber);
+    addJob<DrawQueuedText>("DrawQueuedText");
 
     // Once opaque is all rendered create stencil background
     addJob<DrawStencilDeferred>("DrawOpaqueStencil", deferredFramebuffer);
@@ -206,7 +212,9 @@ RenderDeferredTask::RenderDeferredTask(CullFunctor cullFunctor) {
     addJob<EndGPURangeTimer>("ToneAndPostRangeTimer", toneAndPostRangeTimer);
 
     // Blit!
-    addJob<Blit>("Blit", primaryFramebuffer);
+    const auto blitInputs = Blit::Inputs(primaryFramebuffer, dynamicResolution).hasVarying();
+    addJob<Blit>("Blit", blitInputs);
+    addJob<EndDynamicResolution>("EndDynamicResolution", dynamicResolution);
 
  //   addJob<EndGPURangeTimer>("RangeTimer", fullFrameRangeTimer);
 
@@ -227,9 +235,7 @@ void RenderDeferredTask::run(const SceneContextPointer& sceneContext, const Rend
 
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
 
-    for (auto job : _jobs) {
-        job.run(sceneContext, renderContext);
-    }
+    runJobs(sceneContext, renderContext);
 }
 
 void BeginGPURangeTimer::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, gpu::RangeTimerPointer& timer) {
@@ -325,6 +331,31 @@ void DrawStateSortDeferred::run(const SceneContextPointer& sceneContext, const R
     config->setNumDrawn((int)inItems.size());
 }
 
+void DrawQueuedText::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+
+    RenderArgs* args = renderContext->args;
+
+    gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+        args->_batch = &batch;
+
+        batch.setViewportTransform(args->_viewport);
+        batch.setStateScissorRect(args->_viewport);
+
+        glm::mat4 projMat;
+        Transform viewMat;
+        args->getViewFrustum().evalProjectionMatrix(projMat);
+        args->getViewFrustum().evalViewTransform(viewMat);
+
+        batch.setProjectionTransform(projMat);
+        batch.setViewTransform(viewMat);
+
+        TextRenderer3D::drawQueued(batch);
+        args->_batch = nullptr;
+    });
+}
+
 DrawOverlay3D::DrawOverlay3D(bool opaque) :
     _shapePlumber(std::make_shared<ShapePlumber>()),
     _opaquePass(opaque) {
@@ -461,7 +492,7 @@ void DrawBackgroundDeferred::run(const SceneContextPointer& sceneContext, const
    // std::static_pointer_cast<Config>(renderContext->jobConfig)->gpuTime = _gpuTimer.getAverage();
 }
 
-void Blit::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const gpu::FramebufferPointer& srcFramebuffer) {
+void Blit::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const Inputs& inputs) {
     assert(renderContext->args);
     assert(renderContext->args->_context);
 
@@ -472,12 +503,17 @@ void Blit::run(const SceneContextPointer& sceneContext, const RenderContextPoint
         return;
     }
 
-    // Determine size from viewport
-    int width = renderArgs->_viewport.z;
-    int height = renderArgs->_viewport.w;
+    // Determine the sizes from the viewports, the frame may have been rendered in a corner of the full one
+    const auto& resolution = inputs.get1();
+    glm::ivec4 srcViewport = resolution ? resolution->viewport : renderArgs->_viewport;
+    glm::ivec4 dstViewport = resolution ? resolution->fullViewport : renderArgs->_viewport;
+    int srcWidth = srcViewport.z;
+    int srcHeight = srcViewport.w;
+    int width = dstViewport.z;
+    int height = dstViewport.w;
 
     // Blit primary to blit FBO
-    auto primaryFbo = srcFramebuffer;
+    auto primaryFbo = inputs.get0();
 
     gpu::doInBatch(renderArgs->_context, [&](gpu::Batch& batch) {
         batch.setFramebuffer(blitFbo);
@@ -485,33 +521,33 @@ void Blit::run(const SceneContextPointer& sceneContext, const RenderContextPoint
         if (renderArgs->_renderMode == RenderArgs::MIRROR_RENDER_MODE) {
             if (renderArgs->_context->isStereo()) {
                 gpu::Vec4i srcRectLeft;
-                srcRectLeft.z = width / 2;
-                srcRectLeft.w = height;
+                srcRectLeft.z = srcWidth / 2;
+                srcRectLeft.w = srcHeight;
 
                 gpu::Vec4i srcRectRight;
-                srcRectRight.x = width / 2;
-                srcRectRight.z = width;
-                srcRectRight.w = height;
+                srcRectRight.x = srcWidth / 2;
+                srcRectRight.z = srcWidth;
+                srcRectRight.w = srcHeight;
 
                 gpu::Vec4i destRectLeft;
-                destRectLeft.x = srcRectLeft.z;
-                destRectLeft.z = srcRectLeft.x;
-                destRectLeft.y = srcRectLeft.y;
-                destRectLeft.w = srcRectLeft.w;
+                destRectLeft.x = width / 2;
+                destRectLeft.z = 0;
+                destRectLeft.y = 0;
+                destRectLeft.w = height;
 
                 gpu::Vec4i destRectRight;
-                destRectRight.x = srcRectRight.z;
-                destRectRight.z = srcRectRight.x;
-                destRectRight.y = srcRectRight.y;
-                destRectRight.w = srcRectRight.w;
+                destRectRight.x = width;
+                destRectRight.z = width / 2;
+                destRectRight.y = 0;
+                destRectRight.w = height;
 
                 // Blit left to right and right to left in stereo
                 batch.blit(primaryFbo, srcRectRight, blitFbo, destRectLeft);
                 batch.blit(primaryFbo, srcRectLeft, blitFbo, destRectRight);
             } else {
                 gpu::Vec4i srcRect;
-                srcRect.z = width;
-                srcRect.w = height;
+                srcRect.z = srcWidth;
+                srcRect.w = srcHeight;
 
                 gpu::Vec4i destRect;
                 destRect.x = width;
@@ -522,11 +558,15 @@ void Blit::run(const SceneContextPointer& sceneContext, const RenderContextPoint
                 batch.blit(primaryFbo, srcRect, blitFbo, destRect);
             }
         } else {
-            gpu::Vec4i rect;
-            rect.z = width;
-            rect.w = height;
+            gpu::Vec4i srcRect;
+            srcRect.z = srcWidth;
+            srcRect.w = srcHeight;
+
+            gpu::Vec4i destRect;
+            destRect.z = width;
+            destRect.w = height;
 
-            batch.blit(primaryFbo, rect, blitFbo, rect);
+            batch.blit(primaryFbo, srcRect, blitFbo, destRect);
         }
     });
 }
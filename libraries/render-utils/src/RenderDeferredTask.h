@@ -15,6 +15,7 @@
 #include <gpu/Pipeline.h>
 #include <render/CullTask.h>
 #include "LightingModel.h"
+#include "DynamicResolution.h"
 
 
 class BeginGPURangeTimer {
@@ -120,6 +121,14 @@ protected:
     bool _stateSort;
 };
 
+// Draws the strings queued to the text renderers by the opaque items, one call for each font
+class DrawQueuedText {
+public:
+    using JobModel = render::Job::Model<DrawQueuedText>;
+
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext);
+};
+
 class DeferredFramebuffer;
 class DrawStencilDeferred {
 public:
@@ -185,11 +194,13 @@ protected:
     bool _opaquePass{ true };
 };
 
+// Blits the viewport of the source to the full viewport of the blit framebuffer, scaling it up when rendered smaller
 class Blit {
 public:
-    using JobModel = render::Job::ModelI<Blit, gpu::FramebufferPointer>;
+    using Inputs = render::VaryingSet2<gpu::FramebufferPointer, DynamicResolutionPointer>;
+    using JobModel = render::Job::ModelI<Blit, Inputs>;
 
-    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const gpu::FramebufferPointer& srcFramebuffer);
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const Inputs& inputs);
 };
 
 using RenderDeferredTaskConfig = render::GPUTaskConfig;
@@ -11,6 +11,8 @@
 
 #include "RenderShadowTask.h"
 
+#include <cstring>
+
 #include <gpu/Context.h>
 
 #include <ViewFrustum.h>
@@ -31,6 +33,36 @@
 
 using namespace render;
 
+void RenderShadowCascadeSetup::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext) {
+    const auto& lightStage = DependencyManager::get<DeferredLightingEffect>()->getLightStage();
+    const auto& cascade = lightStage.lights[0]->shadow.getCascade(_cascadeIndex);
+
+    // RenderShadowTask pushed a frustum for the first cascade to replace
+    RenderArgs* args = renderContext->args;
+    args->popViewFrustum();
+    args->pushViewFrustum(*(cascade.getFrustum()));
+}
+
+// A sum of a hash of each caster, in any order the sort left them in
+static uint64_t evalCastersSignature(const render::ShapeBounds& inShapes) {
+    uint64_t signature = 0;
+    for (const auto& items : inShapes) {
+        for (const auto& item : items.second) {
+            const glm::vec3& corner = item.bound.getCorner();
+            const glm::vec3& scale = item.bound.getScale();
+            const float values[] = { corner.x, corner.y, corner.z, scale.x, scale.y, scale.z };
+            uint64_t hash = 14695981039346656037ULL ^ (uint64_t)item.id;
+            for (float value : values) {
+                uint32_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                hash = (hash ^ bits) * 1099511628211ULL;
+            }
+            signature += hash;
+        }
+    }
+    return signature;
+}
+
 void RenderShadowMap::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
                           const render::ShapeBounds& inShapes) {
     assert(renderContext->args);
@@ -38,8 +70,20 @@ void RenderShadowMap::run(const render::SceneContextPointer& sceneContext, const
 
     const auto& lightStage = DependencyManager::get<DeferredLightingEffect>()->getLightStage();
     const auto globalLight = lightStage.lights[0];
-    const auto& shadow = globalLight->shadow;
-    const auto& fbo = shadow.framebuffer;
+    const auto& cascade = globalLight->shadow.getCascade(_cascadeIndex);
+    const auto& fbo = cascade.framebuffer;
+
+    if (_isCached) {
+        uint64_t casters = evalCastersSignature(inShapes);
+        if (_isDrawn && casters == _drawnCasters &&
+            cascade.getView() == _drawnView && cascade.getProjection() == _drawnProjection) {
+            return;
+        }
+        _isDrawn = true;
+        _drawnCasters = casters;
+        _drawnView = cascade.getView();
+        _drawnProjection = cascade.getProjection();
+    }
 
     RenderArgs* args = renderContext->args;
     gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
@@ -54,8 +98,8 @@ void RenderShadowMap::run(const render::SceneContextPointer& sceneContext, const
             gpu::Framebuffer::BUFFER_COLOR0 | gpu::Framebuffer::BUFFER_DEPTH,
             vec4(vec3(1.0, 1.0, 1.0), 0.0), 1.0, 0, true);
 
-        batch.setProjectionTransform(shadow.getProjection());
-        batch.setViewTransform(shadow.getView(), false);
+        batch.setProjectionTransform(cascade.getProjection());
+        batch.setViewTransform(cascade.getView(), false);
 
         auto shadowPipeline = _shapePlumber->pickPipeline(args, ShapeKey());
         auto shadowSkinnedPipeline = _shapePlumber->pickPipeline(args, ShapeKey::Builder().withSkinned());
@@ -110,18 +154,24 @@ RenderShadowTask::RenderShadowTask(CullFunctor cullFunctor) {
             skinProgram, state);
     }
 
-    // CPU jobs:
-    // Fetch and cull the items from the scene
+    // Each cascade culls and draws its own casters, the ones past the first are cached
     auto shadowFilter = ItemFilter::Builder::visibleWorldItems().withTypeShape().withOpaque().withoutLayered();
-    const auto shadowSelection = addJob<FetchSpatialTree>("FetchShadowSelection", shadowFilter);
-    const auto culledShadowSelection = addJob<CullSpatialSelection>("CullShadowSelection", shadowSelection, cullFunctor, RenderDetails::SHADOW, shadowFilter);
+    for (int i = 0; i < LightStage::Shadow::NUM_CASCADES; i++) {
+        const std::string suffix = i > 0 ? std::to_string(i) : std::string();
+
+        // CPU jobs:
+        // Fetch and cull the items from the scene
+        addJob<RenderShadowCascadeSetup>("RenderShadowCascadeSetup" + suffix, i);
+        const auto shadowSelection = addJob<FetchSpatialTree>("FetchShadowSelection" + suffix, shadowFilter);
+        const auto culledShadowSelection = addJob<CullSpatialSelection>("CullShadowSelection" + suffix, shadowSelection, cullFunctor, RenderDetails::SHADOW, shadowFilter);
 
-    // Sort
-    const auto sortedPipelines = addJob<PipelineSortShapes>("PipelineSortShadowSort", culledShadowSelection);
-    const auto sortedShapes = addJob<DepthSortShapes>("DepthSortShadowMap", sortedPipelines);
+        // Sort
+        const auto sortedPipelines = addJob<PipelineSortShapes>("PipelineSortShadowSort" + suffix, culledShadowSelection);
+        const auto sortedShapes = addJob<DepthSortShapes>("DepthSortShadowMap" + suffix, sortedPipelines);
 
-    // GPU jobs: Render to shadow map
-    addJob<RenderShadowMap>("RenderShadowMap", sortedShapes, shapePlumber);
+        // GPU jobs: Render to shadow map
+        addJob<RenderShadowMap>("RenderShadowMap" + suffix, sortedShapes, shapePlumber, i, i > 0);
+    }
 }
 
 void RenderShadowTask::configure(const Config& configuration) {
@@ -152,18 +202,16 @@ void RenderShadowTask::run(const SceneContextPointer& sceneContext, const render
 
     auto nearClip = args->getViewFrustum().getNearClip();
     float nearDepth = -args->_boomOffset.z;
-    const int SHADOW_FAR_DEPTH = 20;
+    const int SHADOW_FAR_DEPTH = 100;
     globalLight->shadow.setKeylightFrustum(args->getViewFrustum(), nearDepth, nearClip + SHADOW_FAR_DEPTH);
 
-    // Set the keylight render args
-    args->pushViewFrustum(*(globalLight->shadow.getFrustum()));
+    // Set the keylight render args, each cascade points the culling at its own frustum
+    args->pushViewFrustum(*(globalLight->shadow.getCascade(0).getFrustum()));
     args->_renderMode = RenderArgs::SHADOW_RENDER_MODE;
 
     // TODO: Allow runtime manipulation of culling ShouldRenderFunctor
 
-    for (auto job : _jobs) {
-        job.run(sceneContext, renderContext);
-    }
+    runJobs(sceneContext, renderContext);
 
     // Reset the render args
     args->popViewFrustum();
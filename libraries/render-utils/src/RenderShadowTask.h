@@ -19,16 +19,38 @@
 
 class ViewFrustum;
 
+// Points the culling of the jobs after it at the frustum of a cascade of the keylight shadow
+class RenderShadowCascadeSetup {
+public:
+    using JobModel = render::Job::Model<RenderShadowCascadeSetup>;
+
+    RenderShadowCascadeSetup(int cascadeIndex) : _cascadeIndex{ cascadeIndex } {}
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext);
+
+protected:
+    int _cascadeIndex;
+};
+
 class RenderShadowMap {
 public:
     using JobModel = render::Job::ModelI<RenderShadowMap, render::ShapeBounds>;
 
-    RenderShadowMap(render::ShapePlumberPointer shapePlumber) : _shapePlumber{ shapePlumber } {}
+    // The map of a cached cascade is only drawn again when its frustum or the bounds of its casters change
+    RenderShadowMap(render::ShapePlumberPointer shapePlumber, int cascadeIndex, bool isCached) :
+        _shapePlumber{ shapePlumber }, _cascadeIndex{ cascadeIndex }, _isCached{ isCached } {}
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
              const render::ShapeBounds& inShapes);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
+    int _cascadeIndex;
+    bool _isCached;
+
+    // what the map was last drawn with
+    bool _isDrawn { false };
+    glm::mat4 _drawnView;
+    glm::mat4 _drawnProjection;
+    uint64_t _drawnCasters { 0 };
 };
 
 class RenderShadowTaskConfig : public render::Task::Config::Persistent {
@@ -78,3 +78,20 @@ void TextRenderer3D::draw(gpu::Batch& batch, float x, float y, const QString& st
     }
 }
 
+
+void TextRenderer3D::queue(const Transform& transform, float x, float y, const QString& str, const glm::vec4& color,
+                           const glm::vec2& bounds) {
+    if (_font) {
+        _font->queueString(this, transform, x, y, str, color, bounds);
+    }
+}
+
+void TextRenderer3D::drawQueued(gpu::Batch& batch) {
+    Font::drawQueuedStrings(batch);
+}
+
+TextRenderer3D::~TextRenderer3D() {
+    if (_font) {
+        _font->releaseString(this);
+    }
+}
@@ -20,6 +20,7 @@ namespace gpu {
 class Batch;
 }
 class Font;
+class Transform;
 
 #include "text/EffectType.h"
 #include "text/FontFamilies.h"
@@ -39,6 +40,17 @@ public:
     void draw(gpu::Batch& batch, float x, float y, const QString& str, const glm::vec4& color = glm::vec4(1.0f),
               const glm::vec2& bounds = glm::vec2(-1.0f), bool layered = false);
 
+    // Queue the string to be drawn, placed by the model transform, at once with every string queued to the same font.
+    // The glyphs of this renderer are laid out again only when the string, the bounds, the transform or the color change.
+    // The queued strings are drawn without the effect of the renderer
+    void queue(const Transform& transform, float x, float y, const QString& str, const glm::vec4& color = glm::vec4(1.0f),
+               const glm::vec2& bounds = glm::vec2(-1.0f));
+
+    // Draw the strings of all the renderers queued since the last call
+    static void drawQueued(gpu::Batch& batch);
+
+    ~TextRenderer3D();
+
 private:
     TextRenderer3D(const char* family, float pointSize, int weight = -1, bool italic = false,
                    EffectType effect = NO_EFFECT, int effectThickness = 1);
@@ -3,6 +3,8 @@
 #include <QFile>
 #include <QImage>
 
+#include <algorithm>
+
 #include <ColorUtils.h>
 
 #include <StreamHelpers.h>
@@ -10,6 +12,8 @@
 #include "sdf_text3D_vert.h"
 #include "sdf_text3D_frag.h"
 #include "sdf_text3D_overlay_frag.h"
+#include "sdf_text3D_queued_vert.h"
+#include "sdf_text3D_queued_frag.h"
 
 #include "../RenderUtilsLogging.h"
 #include "FontFamilies.h"
@@ -47,6 +51,14 @@ struct QuadBuilder {
 
 
 
+// The vertex of the glyphs of the queued strings, already in world space
+struct QueuedVertex {
+    glm::vec3 pos;
+    glm::vec2 tex;
+    glm::vec3 normal;
+    glm::vec4 color;
+};
+
 static QHash<QString, Font::Pointer> LOADED_FONTS;
 
 Font::Pointer Font::load(QIODevice& fontFile) {
@@ -245,6 +257,13 @@ void Font::setupGPU() {
             layeredState->setCullMode(gpu::State::CULL_BACK);
             layeredState->setDepthTest(true, true, gpu::LESS_EQUAL);
             _layeredPipeline = gpu::Pipeline::create(programOverlay, layeredState);
+
+            auto queueVertexShader = gpu::Shader::createVertex(std::string(sdf_text3D_queued_vert));
+            auto queuePixelShader = gpu::Shader::createPixel(std::string(sdf_text3D_queued_frag));
+            gpu::ShaderPointer queueProgram = gpu::Shader::createProgram(queueVertexShader, queuePixelShader);
+            gpu::Shader::makeProgram(*queueProgram, slotBindings);
+            _queueFontLoc = queueProgram->getTextures().findLocation("Font");
+            _queuePipeline = gpu::Pipeline::create(queueProgram, state);
         }
 
         // Sanity checks
@@ -258,18 +277,23 @@ void Font::setupGPU() {
         _format = std::make_shared<gpu::Stream::Format>();
         _format->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ), 0);
         _format->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), OFFSET);
+
+        _queueFormat = std::make_shared<gpu::Stream::Format>();
+        _queueFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ),
+            offsetof(QueuedVertex, pos));
+        _queueFormat->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV),
+            offsetof(QueuedVertex, tex));
+        _queueFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ),
+            offsetof(QueuedVertex, normal));
+        _queueFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element(gpu::VEC4, gpu::FLOAT, gpu::RGBA),
+            offsetof(QueuedVertex, color));
+        _queueVerticesBuffer = std::make_shared<gpu::Buffer>();
+        _queueIndicesBuffer = std::make_shared<gpu::Buffer>();
     }
 }
 
-void Font::rebuildVertices(float x, float y, const QString& str, const glm::vec2& bounds) {
-    _verticesBuffer = std::make_shared<gpu::Buffer>();
-    _numVertices = 0;
-    _indicesBuffer = std::make_shared<gpu::Buffer>();
-    _numIndices = 0;
-
-    _lastStringRendered = str;
-    _lastBounds = bounds;
-
+void Font::layoutGlyphs(float x, float y, const QString& str, const glm::vec2& bounds,
+                        const std::function<void(const Glyph& glyph, const glm::vec2& offset)>& addGlyph) const {
     // Top left of text
     glm::vec2 advance = glm::vec2(x, y);
     foreach(const QString& token, tokenizeForWrapping(str)) {
@@ -301,40 +325,8 @@ void Font::rebuildVertices(float x, float y, const QString& str, const glm::vec2
         // Draw the token
         if (!isNewLine) {
             for (auto c : token) {
-                auto glyph = _glyphs[c];
-                quint16 verticesOffset = _numVertices;
-
-                QuadBuilder qd(glyph, advance - glm::vec2(0.0f, _ascent));
-                _verticesBuffer->append(sizeof(QuadBuilder), (const gpu::Byte*)&qd);
-                _numVertices += 4;
-                
-                // Sam's recommended triangle slices
-                // Triangle tri1 = { v0, v1, v3 };
-                // Triangle tri2 = { v1, v2, v3 };
-                // NOTE: Random guy on the internet's recommended triangle slices
-                // Triangle tri1 = { v0, v1, v2 };
-                // Triangle tri2 = { v2, v3, v0 };
-
-                // The problem here being that the 4 vertices are { ll, lr, ul, ur }, a Z pattern
-                // Additionally, you want to ensure that the shared side vertices are used sequentially
-                // to improve cache locality
-                //
-                //  2 -- 3
-                //  |    |
-                //  |    |
-                //  0 -- 1
-                //
-                //  { 0, 1, 2 } -> { 2, 1, 3 }
-                quint16 indices[NUMBER_OF_INDICES_PER_QUAD];
-                indices[0] = verticesOffset + 0;
-                indices[1] = verticesOffset + 1;
-                indices[2] = verticesOffset + 2;
-                indices[3] = verticesOffset + 2;
-                indices[4] = verticesOffset + 1;
-                indices[5] = verticesOffset + 3;
-                _indicesBuffer->append(sizeof(indices), (const gpu::Byte*)indices);
-                _numIndices += NUMBER_OF_INDICES_PER_QUAD;
-                
+                const Glyph& glyph = _glyphs[c];
+                addGlyph(glyph, advance - glm::vec2(0.0f, _ascent));
 
                 // Advance by glyph size
                 advance.x += glyph.d;
@@ -346,6 +338,51 @@ void Font::rebuildVertices(float x, float y, const QString& str, const glm::vec2
     }
 }
 
+void Font::rebuildVertices(float x, float y, const QString& str, const glm::vec2& bounds) {
+    _verticesBuffer = std::make_shared<gpu::Buffer>();
+    _numVertices = 0;
+    _indicesBuffer = std::make_shared<gpu::Buffer>();
+    _numIndices = 0;
+
+    _lastStringRendered = str;
+    _lastBounds = bounds;
+
+    layoutGlyphs(x, y, str, bounds, [&](const Glyph& glyph, const glm::vec2& offset) {
+        quint16 verticesOffset = _numVertices;
+
+        QuadBuilder qd(glyph, offset);
+        _verticesBuffer->append(sizeof(QuadBuilder), (const gpu::Byte*)&qd);
+        _numVertices += 4;
+
+        // Sam's recommended triangle slices
+        // Triangle tri1 = { v0, v1, v3 };
+        // Triangle tri2 = { v1, v2, v3 };
+        // NOTE: Random guy on the internet's recommended triangle slices
+        // Triangle tri1 = { v0, v1, v2 };
+        // Triangle tri2 = { v2, v3, v0 };
+
+        // The problem here being that the 4 vertices are { ll, lr, ul, ur }, a Z pattern
+        // Additionally, you want to ensure that the shared side vertices are used sequentially
+        // to improve cache locality
+        //
+        //  2 -- 3
+        //  |    |
+        //  |    |
+        //  0 -- 1
+        //
+        //  { 0, 1, 2 } -> { 2, 1, 3 }
+        quint16 indices[NUMBER_OF_INDICES_PER_QUAD];
+        indices[0] = verticesOffset + 0;
+        indices[1] = verticesOffset + 1;
+        indices[2] = verticesOffset + 2;
+        indices[3] = verticesOffset + 2;
+        indices[4] = verticesOffset + 1;
+        indices[5] = verticesOffset + 3;
+        _indicesBuffer->append(sizeof(indices), (const gpu::Byte*)indices);
+        _numIndices += NUMBER_OF_INDICES_PER_QUAD;
+    });
+}
+
 void Font::drawString(gpu::Batch& batch, float x, float y, const QString& str, const glm::vec4* color,
                       EffectType effectType, const glm::vec2& bounds, bool layered) {
     if (str == "") {
@@ -371,3 +408,130 @@ void Font::drawString(gpu::Batch& batch, float x, float y, const QString& str, c
     batch.setIndexBuffer(gpu::UINT16, _indicesBuffer, 0);
     batch.drawIndexed(gpu::TRIANGLES, _numIndices, 0);
 }
+
+void Font::queueString(const void* owner, const Transform& transform, float x, float y, const QString& str,
+                       const glm::vec4& color, const glm::vec2& bounds) {
+    if (str == "") {
+        return;
+    }
+
+    glm::mat4 matrix;
+    transform.getMatrix(matrix);
+
+    auto& queued = _queuedStrings[owner];
+    if (queued.version == 0 || str != queued.str || glm::vec2(x, y) != queued.position || bounds != queued.bounds ||
+            matrix != queued.transform || color != queued.color) {
+        // versions are unique over all the strings, so an owner of the same address is never mistaken for an older one
+        static uint64_t lastVersion = 0;
+        queued.version = ++lastVersion;
+        queued.str = str;
+        queued.position = glm::vec2(x, y);
+        queued.bounds = bounds;
+        queued.transform = matrix;
+        queued.color = color;
+
+        // need the gamma corrected color here
+        glm::vec4 lrgba = ColorUtils::sRGBToLinearVec4(color);
+        glm::vec3 normal = glm::normalize(glm::vec3(matrix[2]));
+
+        queued.vertices.clear();
+        queued.numQuads = 0;
+        layoutGlyphs(x, y, str, bounds, [&](const Glyph& glyph, const glm::vec2& offset) {
+            QuadBuilder qd(glyph, offset);
+            QueuedVertex vertices[VERTICES_PER_QUAD];
+            for (int i = 0; i < VERTICES_PER_QUAD; i++) {
+                vertices[i].pos = glm::vec3(matrix * glm::vec4(qd.vertices[i].pos, 0.0f, 1.0f));
+                vertices[i].tex = qd.vertices[i].tex;
+                vertices[i].normal = normal;
+                vertices[i].color = lrgba;
+            }
+            const uint8_t* bytes = (const uint8_t*)vertices;
+            queued.vertices.insert(queued.vertices.end(), bytes, bytes + sizeof(vertices));
+            queued.numQuads++;
+        });
+    }
+
+    if (!queued.isQueued) {
+        queued.isQueued = true;
+        _queue.push_back(owner);
+    }
+}
+
+void Font::releaseString(const void* owner) {
+    auto it = _queuedStrings.find(owner);
+    if (it != _queuedStrings.end()) {
+        if (it->second.isQueued) {
+            _queue.erase(std::find(_queue.begin(), _queue.end(), owner));
+        }
+        _queuedStrings.erase(it);
+    }
+}
+
+void Font::drawQueue(gpu::Batch& batch) {
+    if (_queue.empty()) {
+        return;
+    }
+
+    setupGPU();
+
+    // Only put the glyphs together again when the queued strings differ from the ones of the buffers
+    bool isChanged = (_queue.size() != _drawnQueue.size());
+    for (size_t i = 0; !isChanged && i < _queue.size(); i++) {
+        isChanged = (_queue[i] != _drawnQueue[i].first || _queuedStrings[_queue[i]].version != _drawnQueue[i].second);
+    }
+
+    if (isChanged) {
+        _drawnQueue.clear();
+        std::vector<uint8_t> vertices;
+        std::vector<uint32_t> indices;
+        uint32_t numQuads = 0;
+        for (auto owner : _queue) {
+            const auto& queued = _queuedStrings[owner];
+            _drawnQueue.emplace_back(owner, queued.version);
+            vertices.insert(vertices.end(), queued.vertices.begin(), queued.vertices.end());
+            for (uint32_t i = 0; i < queued.numQuads; i++) {
+                // same slices as rebuildVertices, { 0, 1, 2 } -> { 2, 1, 3 }
+                uint32_t verticesOffset = (numQuads + i) * VERTICES_PER_QUAD;
+                indices.push_back(verticesOffset + 0);
+                indices.push_back(verticesOffset + 1);
+                indices.push_back(verticesOffset + 2);
+                indices.push_back(verticesOffset + 2);
+                indices.push_back(verticesOffset + 1);
+                indices.push_back(verticesOffset + 3);
+            }
+            numQuads += queued.numQuads;
+        }
+        _queueVerticesBuffer->setData(vertices.size(), (const gpu::Byte*)vertices.data());
+        _queueIndicesBuffer->setData(indices.size() * sizeof(uint32_t), (const gpu::Byte*)indices.data());
+        _numQueueIndices = (unsigned int)indices.size();
+    }
+
+    for (auto owner : _queue) {
+        _queuedStrings[owner].isQueued = false;
+    }
+    _queue.clear();
+
+    if (_numQueueIndices == 0) {
+        return;
+    }
+
+    batch.setPipeline(_queuePipeline);
+    batch.setResourceTexture(_queueFontLoc, _texture);
+    batch.setModelTransform(Transform());
+
+    batch.setInputFormat(_queueFormat);
+    batch.setInputBuffer(0, _queueVerticesBuffer, 0, sizeof(QueuedVertex));
+    batch.setIndexBuffer(gpu::UINT32, _queueIndicesBuffer, 0);
+    batch.drawIndexed(gpu::TRIANGLES, _numQueueIndices, 0);
+}
+
+void Font::drawQueuedStrings(gpu::Batch& batch) {
+    // the same font can be loaded under several families
+    std::vector<Font*> drawnFonts;
+    for (const auto& font : LOADED_FONTS) {
+        if (font && std::find(drawnFonts.begin(), drawnFonts.end(), font.get()) == drawnFonts.end()) {
+            drawnFonts.push_back(font.get());
+            font->drawQueue(batch);
+        }
+    }
+}
@@ -10,10 +10,15 @@
 #ifndef hifi_Font_h
 #define hifi_Font_h
 
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 #include "Glyph.h"
 #include "EffectType.h"
 #include <gpu/Batch.h>
 #include <gpu/Pipeline.h>
+#include <Transform.h>
 
 class Font {
 public:
@@ -31,6 +36,16 @@ public:
         const glm::vec4* color, EffectType effectType,
         const glm::vec2& bound, bool layered = false);
 
+    // Queue the string of owner, placed by the model transform, to be drawn at once with all the strings of this font
+    // by drawQueuedStrings. The glyphs of owner are only laid out again when its string, bounds, transform or color change
+    void queueString(const void* owner, const Transform& transform, float x, float y, const QString& str,
+        const glm::vec4& color, const glm::vec2& bound);
+    // Forget the glyphs kept for owner
+    void releaseString(const void* owner);
+
+    // Draw the strings queued to every loaded font since the last call, in one call per font
+    static void drawQueuedStrings(gpu::Batch& batch);
+
     static Pointer load(QIODevice& fontFile);
     static Pointer load(const QString& family);
 
@@ -40,7 +55,10 @@ private:
     glm::vec2 computeTokenExtent(const QString& str) const;
 
     const Glyph& getGlyph(const QChar& c) const;
+    void layoutGlyphs(float x, float y, const QString& str, const glm::vec2& bounds,
+        const std::function<void(const Glyph& glyph, const glm::vec2& offset)>& addGlyph) const;
     void rebuildVertices(float x, float y, const QString& str, const glm::vec2& bounds);
+    void drawQueue(gpu::Batch& batch);
 
     void setupGPU();
 
@@ -79,6 +97,32 @@ private:
     // last string render characteristics
     QString _lastStringRendered;
     glm::vec2 _lastBounds;
+
+    // the glyphs of a queued string in world space, one quad of 4 vertices each
+    class QueuedString {
+    public:
+        QString str;
+        glm::vec2 position;
+        glm::vec2 bounds;
+        glm::mat4 transform;
+        glm::vec4 color;
+
+        std::vector<uint8_t> vertices;
+        uint32_t numQuads { 0 };
+        uint64_t version { 0 };
+        bool isQueued { false };
+    };
+    std::unordered_map<const void*, QueuedString> _queuedStrings;
+    std::vector<const void*> _queue;
+
+    // the queue the buffers hold, the owners and the versions of their strings
+    std::vector<std::pair<const void*, uint64_t>> _drawnQueue;
+    gpu::PipelinePointer _queuePipeline;
+    gpu::Stream::FormatPointer _queueFormat;
+    gpu::BufferPointer _queueVerticesBuffer;
+    gpu::BufferPointer _queueIndicesBuffer;
+    unsigned int _numQueueIndices = 0;
+    int _queueFontLoc = -1;
 };
 
 #endif
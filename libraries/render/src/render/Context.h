@@ -25,11 +25,13 @@ public:
 using SceneContextPointer = std::shared_ptr<SceneContext>;
 
 class JobConfig;
+class JobProfiler;
 
 class RenderContext {
 public:
     RenderArgs* args;
     std::shared_ptr<JobConfig> jobConfig{ nullptr };
+    std::shared_ptr<JobProfiler> jobProfiler{ nullptr }; // set while the engine profiler is capturing
 };
 using RenderContextPointer = std::shared_ptr<RenderContext>;
 
@@ -14,7 +14,9 @@
 #include <algorithm>
 #include <assert.h>
 
+#include <FrameArena.h>
 #include <OctreeUtils.h>
+#include <ParallelFor.h>
 #include <PerfStat.h>
 #include <ViewFrustum.h>
 #include <gpu/Context.h>
@@ -133,167 +135,119 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
         args->pushViewFrustum(_frozenFrutstum); // replace the true view frustum by the frozen one
     }
 
-    // Culling Frustum / solidAngle test helper class
-    struct Test {
-        CullFunctor _functor;
-        RenderArgs* _args;
-        RenderDetails::Item& _renderDetails;
-        glm::vec3 _eyePos;
-        float _squareTanAlpha;
-
-        Test(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails) :
-            _functor(functor),
-            _args(pargs),
-            _renderDetails(renderDetails)
-        {
-            // FIXME: Keep this code here even though we don't use it yet
-            /*_eyePos = _args->getViewFrustum().getPosition();
-            float a = glm::degrees(Octree::getAccuracyAngle(_args->_sizeScale, _args->_boundaryLevelAdjust));
-            auto angle = std::min(glm::radians(45.0f), a); // no worse than 45 degrees
-            angle = std::max(glm::radians(1.0f / 60.0f), a); // no better than 1 minute of degree
-            auto tanAlpha = tan(angle);
-            _squareTanAlpha = (float)(tanAlpha * tanAlpha);
-            */
-        }
-
-        bool frustumTest(const AABox& bound) {
-            if (!_args->getViewFrustum().boxIntersectsFrustum(bound)) {
-                _renderDetails._outOfView++;
-                return false;
-            }
-            return true;
-        }
-
-        bool solidAngleTest(const AABox& bound) {
-            // FIXME: Keep this code here even though we don't use it yet
-            //auto eyeToPoint = bound.calcCenter() - _eyePos;
-            //auto boundSize = bound.getDimensions();
-            //float test = (glm::dot(boundSize, boundSize) / glm::dot(eyeToPoint, eyeToPoint)) - squareTanAlpha;
-            //if (test < 0.0f) {
-            if (!_functor(_args, bound)) {
-                _renderDetails._tooSmall++;
-                return false;
-            }
-            return true;
-        }
+    // The four lists of the selection are cut into chunks, which are filtered and culled on the worker threads into
+    // outputs of their own. The outputs are put together in chunk order, so the result is the same as a serial cull.
+    // The chunks only last for the cull, so they are reserved in full from the frame arena of this thread up front,
+    // which leaves the workers nothing to allocate.
+    FrameArena::Scope frameScope;
+    const size_t ITEMS_PER_CHUNK = 1024;
+    enum ChunkTests { FILTER_ONLY = 0, FRUSTUM_TEST = 1, SOLID_ANGLE_TEST = 2 };
+    struct Chunk {
+        const ItemIDs* ids;
+        size_t begin;
+        size_t end;
+        int tests;
+        FrameVector<ItemBound> outItems;
+        int outOfView { 0 };
+        int tooSmall { 0 };
     };
-    Test test(_cullFunctor, args, details);
-
-    // Now we have a selection of items to render
-    outItems.clear();
-    outItems.reserve(inSelection.numItems());
-
-    // Now get the bound, and
-    // filter individually against the _filter
-    // visibility cull if partially selected ( octree cell contianing it was partial)
-    // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-
-    if (_skipCulling) {
-        // inside & fit items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("insideFitItems");
-            for (auto id : inSelection.insideItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
-        }
-
-        // inside & subcell items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("insideSmallItems");
-            for (auto id : inSelection.insideSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
-        }
-
-        // partial & fit items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
-        }
 
-        // partial & subcell items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
+    // inside & fit items: easy, just filter
+    // inside & subcell items: filter & distance cull
+    // partial & fit items: filter & frustum cull
+    // partial & subcell items: filter & frustum cull & solid angle cull
+    const std::pair<const ItemIDs*, int> lists[] = {
+        { &inSelection.insideItems, FILTER_ONLY },
+        { &inSelection.insideSubcellItems, SOLID_ANGLE_TEST },
+        { &inSelection.partialItems, FRUSTUM_TEST },
+        { &inSelection.partialSubcellItems, FRUSTUM_TEST | SOLID_ANGLE_TEST }
+    };
+    size_t numChunks = 0;
+    for (auto& list : lists) {
+        numChunks += (list.first->size() + ITEMS_PER_CHUNK - 1) / ITEMS_PER_CHUNK;
+    }
+    FrameVector<Chunk> chunks;
+    chunks.reserve(numChunks);
+    for (auto& list : lists) {
+        for (size_t begin = 0; begin < list.first->size(); begin += ITEMS_PER_CHUNK) {
+            chunks.emplace_back();
+            Chunk& chunk = chunks.back();
+            chunk.ids = list.first;
+            chunk.begin = begin;
+            chunk.end = std::min(begin + ITEMS_PER_CHUNK, list.first->size());
+            // culling can be disabled from the config, leaving only the filter
+            chunk.tests = _skipCulling ? FILTER_ONLY : list.second;
+            chunk.outItems.reserve(chunk.end - chunk.begin);
         }
+    }
 
-    } else {
-
-        // inside & fit items: easy, just filter
-        {
-            PerformanceTimer perfTimer("insideFitItems");
-            for (auto id : inSelection.insideItems) {
+    const ViewFrustum& frustum = args->getViewFrustum();
+    {
+        PerformanceTimer perfTimer("cullChunks");
+        parallelFor((int)chunks.size(), [&](int index) {
+            Chunk& chunk = chunks[index];
+            auto& chunkItems = chunk.outItems;
+            for (size_t i = chunk.begin; i < chunk.end; i++) {
+                auto id = (*chunk.ids)[i];
                 auto& item = scene->getItem(id);
                 if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
+                    chunkItems.emplace_back(id, item.getBound());
                 }
             }
-        }
 
-        // inside & subcell items: filter & distance cull
-        {
-            PerformanceTimer perfTimer("insideSmallItems");
-            for (auto id : inSelection.insideSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.solidAngleTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
+            // the items that pass the filter are tested against the frustum in batches, laid out as arrays of the
+            // parts of their corners and scales, and the ones in view are packed down in place
+            if (chunk.tests & FRUSTUM_TEST) {
+                const size_t BATCH_SIZE = 64;
+                float cornerX[BATCH_SIZE], cornerY[BATCH_SIZE], cornerZ[BATCH_SIZE];
+                float scaleX[BATCH_SIZE], scaleY[BATCH_SIZE], scaleZ[BATCH_SIZE];
+                ViewFrustum::intersection locations[BATCH_SIZE];
+                size_t numInView = 0;
+                for (size_t begin = 0; begin < chunkItems.size(); begin += BATCH_SIZE) {
+                    size_t batchSize = std::min(BATCH_SIZE, chunkItems.size() - begin);
+                    for (size_t i = 0; i < batchSize; i++) {
+                        const AABox& bound = chunkItems[begin + i].bound;
+                        cornerX[i] = bound.getCorner().x;
+                        cornerY[i] = bound.getCorner().y;
+                        cornerZ[i] = bound.getCorner().z;
+                        scaleX[i] = bound.getScale().x;
+                        scaleY[i] = bound.getScale().y;
+                        scaleZ[i] = bound.getScale().z;
                     }
-                }
-            }
-        }
-
-        // partial & fit items: filter & frustum cull
-        {
-            PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
+                    frustum.calculateBoxesFrustumIntersection((int)batchSize, cornerX, cornerY, cornerZ,
+                        scaleX, scaleY, scaleZ, locations);
+                    for (size_t i = 0; i < batchSize; i++) {
+                        if (locations[i] == ViewFrustum::OUTSIDE) {
+                            chunk.outOfView++;
+                        } else {
+                            chunkItems[numInView++] = chunkItems[begin + i];
+                        }
                     }
                 }
+                chunkItems.erase(chunkItems.begin() + numInView, chunkItems.end());
             }
-        }
 
-        // partial & subcell items:: filter & frutum cull & solidangle cull
-        {
-            PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                        }
+            if (chunk.tests & SOLID_ANGLE_TEST) {
+                size_t numLargeEnough = 0;
+                for (size_t i = 0; i < chunkItems.size(); i++) {
+                    if (_cullFunctor(args, chunkItems[i].bound)) {
+                        chunkItems[numLargeEnough++] = chunkItems[i];
+                    } else {
+                        chunk.tooSmall++;
                     }
                 }
+                chunkItems.erase(chunkItems.begin() + numLargeEnough, chunkItems.end());
             }
-        }
+        });
+    }
+
+    // Now we have a selection of items to render
+    outItems.clear();
+    outItems.reserve(inSelection.numItems());
+    for (auto& chunk : chunks) {
+        outItems.insert(outItems.end(), chunk.outItems.begin(), chunk.outItems.end());
+        details._outOfView += chunk.outOfView;
+        details._tooSmall += chunk.tooSmall;
     }
 
     details._rendered += (int)outItems.size();
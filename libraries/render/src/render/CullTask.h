@@ -24,6 +24,7 @@ namespace render {
 
     class FetchNonspatialItems {
     public:
+        typedef void is_concurrent_tag;
         using JobModel = Job::ModelO<FetchNonspatialItems, ItemBounds>;
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, ItemBounds& outItems);
     };
@@ -54,6 +55,7 @@ namespace render {
         ViewFrustum _frozenFrutstum;
         float _lodAngle;
     public:
+        typedef void is_concurrent_tag;
         using Config = FetchSpatialTreeConfig;
         using JobModel = Job::ModelO<FetchSpatialTree, ItemSpatialTree::ItemSelection, Config>;
 
@@ -143,6 +145,7 @@ namespace render {
     template <int NUM_FILTERS>
     class MultiFilterItem {
     public:
+        typedef void is_concurrent_tag;
         using ItemFilterArray = std::array<ItemFilter, NUM_FILTERS>;
         using ItemBoundsArray = VaryingArray<ItemBounds, NUM_FILTERS>;
         using Config = MultiFilterItemConfig;
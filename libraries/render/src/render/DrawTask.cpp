@@ -133,3 +133,22 @@ void DrawLight::run(const SceneContextPointer& sceneContext, const RenderContext
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
     config->setNumDrawn((int)inLights.size());
 }
+
+void PrecompileShapePipelines::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    if (!_isGathered) {
+        _pipelines = _shapePlumber->getPipelines();
+        _isGathered = true;
+    }
+    if (_numPrecompiled >= _pipelines.size()) {
+        return;
+    }
+
+    RenderArgs* args = renderContext->args;
+    gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+        size_t last = std::min(_numPrecompiled + NUM_PIPELINES_PER_FRAME, _pipelines.size());
+        for (; _numPrecompiled < last; ++_numPrecompiled) {
+            batch.setPipeline(_pipelines[_numPrecompiled]);
+        }
+        batch.setPipeline(nullptr);
+    });
+}
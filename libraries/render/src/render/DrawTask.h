@@ -50,6 +50,26 @@ protected:
     int _maxDrawn; // initialized by Config
 };
 
+// Has the programs of the pipelines of a ShapePlumber compiled a few every frame from the start, rather than all of them
+// on the frame their shapes first show up. The backend compiles (or loads from its cache) the program of a pipeline
+// the first time a batch sets it.
+class PrecompileShapePipelines {
+public:
+    using JobModel = Job::Model<PrecompileShapePipelines>;
+
+    PrecompileShapePipelines(const ShapePlumberPointer& shapePlumber) : _shapePlumber(shapePlumber) {}
+
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext);
+
+protected:
+    static const size_t NUM_PIPELINES_PER_FRAME = 4;
+
+    ShapePlumberPointer _shapePlumber;
+    std::vector<gpu::PipelinePointer> _pipelines;
+    size_t _numPrecompiled { 0 };
+    bool _isGathered { false };
+};
+
 }
 
 #endif // hifi_render_DrawTask_h
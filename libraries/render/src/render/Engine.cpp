@@ -17,6 +17,7 @@
 
 #include <gpu/Context.h>
 
+#include "EngineProfiler.h"
 #include "EngineStats.h"
 
 using namespace render;
@@ -24,6 +25,7 @@ using namespace render;
 Engine::Engine() :
     _sceneContext(std::make_shared<SceneContext>()),
     _renderContext(std::make_shared<RenderContext>()) {
+    addJob<EngineProfiler>("Profiler");
     addJob<EngineStats>("Stats");
 }
 
@@ -53,9 +55,6 @@ void Engine::load() {
 }
 
 void Engine::run() {
-    for (auto job : _jobs) {
-        job.run(_sceneContext, _renderContext);
-    }
-
+    runJobs(_sceneContext, _renderContext);
 }
 
@@ -0,0 +1,131 @@
+//
+//  EngineProfiler.cpp
+//  render/src/render
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EngineProfiler.h"
+
+#include <algorithm>
+#include <map>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+
+#include <NumericalConstants.h>
+
+using namespace render;
+
+QVariantList EngineProfilerConfig::getJobTimes() const {
+    struct JobTimes {
+        int depth { 0 };
+        double cpuTotal { 0.0 };
+        double cpuMax { 0.0 };
+        int numCPUSamples { 0 };
+        double gpuTotal { 0.0 };
+        double gpuMax { 0.0 };
+        int numGPUSamples { 0 };
+    };
+
+    // keep the jobs in the order they run
+    std::vector<std::string> names;
+    std::map<std::string, JobTimes> times;
+
+    for (const auto& frame : profiler->getFrames()) {
+        for (const auto& sample : frame.jobs) {
+            auto it = times.find(sample.name);
+            if (it == times.end()) {
+                names.push_back(sample.name);
+                it = times.insert({ sample.name, JobTimes() }).first;
+                it->second.depth = sample.depth;
+            }
+            auto& jobTimes = it->second;
+
+            double cpuMsecs = (double)sample.cpuUsecs / USECS_PER_MSEC;
+            jobTimes.cpuTotal += cpuMsecs;
+            jobTimes.cpuMax = std::max(jobTimes.cpuMax, cpuMsecs);
+            jobTimes.numCPUSamples++;
+
+            if (sample.gpuMsecs >= 0.0) {
+                jobTimes.gpuTotal += sample.gpuMsecs;
+                jobTimes.gpuMax = std::max(jobTimes.gpuMax, sample.gpuMsecs);
+                jobTimes.numGPUSamples++;
+            }
+        }
+    }
+
+    QVariantList result;
+    for (const auto& name : names) {
+        const auto& jobTimes = times[name];
+        QVariantMap job;
+        job["name"] = QString::fromStdString(name);
+        job["depth"] = jobTimes.depth;
+        job["cpuAverage"] = jobTimes.cpuTotal / jobTimes.numCPUSamples;
+        job["cpuMax"] = jobTimes.cpuMax;
+        job["gpuAverage"] = jobTimes.numGPUSamples > 0 ? jobTimes.gpuTotal / jobTimes.numGPUSamples : 0.0;
+        job["gpuMax"] = jobTimes.gpuMax;
+        result.push_back(job);
+    }
+    return result;
+}
+
+QString EngineProfilerConfig::toChromeTrace() const {
+    auto frames = profiler->getFrames();
+    quint64 traceStartUsecs = frames.empty() ? 0 : frames.front().startUsecs;
+
+    // every job is a complete event on the render thread, the backend only reports how long the GPU took
+    // and not when, so the GPU time rides along in the event's args
+    QJsonArray events;
+    for (const auto& frame : frames) {
+        for (const auto& sample : frame.jobs) {
+            QJsonObject args;
+            args["frame"] = (double)frame.number;
+            if (sample.gpuMsecs >= 0.0) {
+                args["gpuMs"] = sample.gpuMsecs;
+            }
+
+            QJsonObject event;
+            event["name"] = QString::fromStdString(sample.name);
+            event["cat"] = "render";
+            event["ph"] = "X";
+            event["ts"] = (double)(sample.startUsecs - traceStartUsecs);
+            event["dur"] = (double)sample.cpuUsecs;
+            event["pid"] = 1;
+            event["tid"] = 1;
+            event["args"] = args;
+            events.push_back(event);
+        }
+    }
+
+    QJsonObject trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ms";
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
+bool EngineProfilerConfig::exportChromeTrace(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Could not open" << path << "to export the render profile";
+        return false;
+    }
+    file.write(toChromeTrace().toUtf8());
+    return true;
+}
+
+void EngineProfiler::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+
+    // the jobs find the profiler in the render context, it stays there for every job that runs after this one
+    if (config->capture) {
+        config->profiler->beginFrame(renderContext->args);
+        renderContext->jobProfiler = config->profiler;
+    } else {
+        renderContext->jobProfiler.reset();
+    }
+}
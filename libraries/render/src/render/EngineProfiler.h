@@ -0,0 +1,58 @@
+//
+//  EngineProfiler.h
+//  render/src/render
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_render_EngineProfiler_h
+#define hifi_render_EngineProfiler_h
+
+#include <QtCore/QVariantList>
+
+#include "Engine.h"
+#include "JobProfiler.h"
+
+namespace render {
+
+    // Set capture from a script, Render.getConfig("Profiler").capture = true, to time every job of the engine
+    // on the CPU and the GPU over the last JobProfiler::NUM_FRAMES frames
+    class EngineProfilerConfig : public Job::Config {
+        Q_OBJECT
+        Q_PROPERTY(bool capture MEMBER capture NOTIFY dirty)
+
+    public:
+        EngineProfilerConfig() : Job::Config() {}
+
+        bool capture { false };
+        JobProfilerPointer profiler { std::make_shared<JobProfiler>() };
+
+        // The average and maximum times of each job over the captured frames, in ms,
+        // as a list of { name, depth, cpuAverage, cpuMax, gpuAverage, gpuMax }
+        Q_INVOKABLE QVariantList getJobTimes() const;
+
+        // The captured frames in the trace event format that chrome://tracing loads
+        Q_INVOKABLE QString toChromeTrace() const;
+        Q_INVOKABLE bool exportChromeTrace(const QString& path) const;
+
+    signals:
+        void dirty();
+    };
+
+    class EngineProfiler {
+    public:
+        using Config = EngineProfilerConfig;
+        using JobModel = Job::Model<EngineProfiler, Config>;
+
+        void configure(const Config& configuration) {}
+        void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext);
+    };
+}
+
+#endif // hifi_render_EngineProfiler_h
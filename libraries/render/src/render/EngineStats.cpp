@@ -34,6 +34,8 @@ void EngineStats::run(const SceneContextPointer& sceneContext, const RenderConte
     config->textureGPUMemoryUsage = gpu::Texture::getTextureGPUMemoryUsage();
     config->textureGPUVirtualMemoryUsage = gpu::Texture::getTextureGPUVirtualMemoryUsage();
     config->textureGPUTransferCount = gpu::Texture::getTextureGPUTransferCount();
+    config->textureGPUStreamingCount = gpu::Texture::getTextureGPUStreamingCount();
+    config->textureGPUMeanResidentSize = config->textureGPUCount ? config->textureGPUMemoryUsage / config->textureGPUCount : 0;
 
     gpu::ContextStats gpuStats(_gpuStats);
     renderContext->args->_context->getStats(_gpuStats);
@@ -50,6 +52,7 @@ void EngineStats::run(const SceneContextPointer& sceneContext, const RenderConte
     config->frameTextureMemoryUsage = _gpuStats._RSAmountTextureMemoryBounded - gpuStats._RSAmountTextureMemoryBounded;
 
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines - gpuStats._PSNumSetPipelines;
+    config->frameCompactedCommandCount = _gpuStats._CSNumCompactedCommands - gpuStats._CSNumCompactedCommands;
 
     config->emitDirty();
 }
@@ -35,6 +35,8 @@ namespace render {
         Q_PROPERTY(qint64 textureGPUMemoryUsage MEMBER textureGPUMemoryUsage NOTIFY dirty)
         Q_PROPERTY(qint64 textureGPUVirtualMemoryUsage MEMBER textureGPUVirtualMemoryUsage NOTIFY dirty)
         Q_PROPERTY(quint32 textureGPUTransferCount MEMBER textureGPUTransferCount NOTIFY dirty)
+        Q_PROPERTY(quint32 textureGPUStreamingCount MEMBER textureGPUStreamingCount NOTIFY dirty)
+        Q_PROPERTY(qint64 textureGPUMeanResidentSize MEMBER textureGPUMeanResidentSize NOTIFY dirty)
 
         Q_PROPERTY(quint32 frameAPIDrawcallCount MEMBER frameAPIDrawcallCount NOTIFY dirty)
         Q_PROPERTY(quint32 frameDrawcallCount MEMBER frameDrawcallCount NOTIFY dirty)
@@ -48,6 +50,7 @@ namespace render {
         Q_PROPERTY(quint32 frameTextureMemoryUsage MEMBER frameTextureMemoryUsage NOTIFY dirty)
 
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY dirty)
+        Q_PROPERTY(quint32 frameCompactedCommandCount MEMBER frameCompactedCommandCount NOTIFY dirty)
 
 
     public:
@@ -64,6 +67,8 @@ namespace render {
         qint64 textureGPUMemoryUsage{ 0 };
         qint64 textureGPUVirtualMemoryUsage{ 0 };
         quint32 textureGPUTransferCount{ 0 };
+        quint32 textureGPUStreamingCount{ 0 }; // textures with mips left to stream in
+        qint64 textureGPUMeanResidentSize{ 0 };
 
         quint32 frameAPIDrawcallCount{ 0 };
         quint32 frameDrawcallCount{ 0 };
@@ -77,6 +82,7 @@ namespace render {
         qint64 frameTextureMemoryUsage{ 0 };
 
         quint32 frameSetPipelineCount{ 0 };
+        quint32 frameCompactedCommandCount{ 0 }; // commands the batches dropped at record time
 
 
 
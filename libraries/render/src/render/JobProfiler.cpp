@@ -0,0 +1,130 @@
+//
+//  JobProfiler.cpp
+//  render/src/render
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JobProfiler.h"
+
+#include <RenderArgs.h>
+#include <SharedUtil.h>
+
+#include <gpu/Context.h>
+
+using namespace render;
+
+// How many frames the queries of a frame get to come back before they are asked for
+static const quint64 NUM_QUERY_LATENCY_FRAMES = 3;
+
+void JobProfiler::beginFrame(RenderArgs* args) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    ++_frameNumber;
+    auto& frame = _frames[_frameNumber % NUM_FRAMES];
+    frame.number = _frameNumber;
+    frame.startUsecs = usecTimestampNow();
+    frame.jobs.clear();
+    _depth = 0;
+
+    if (_frameNumber > NUM_QUERY_LATENCY_FRAMES && args && args->_context) {
+        int slot = (int)((_frameNumber - NUM_QUERY_LATENCY_FRAMES) % NUM_FRAMES);
+        const auto& slotQueries = _queries[slot];
+        const auto& pastFrame = _frames[slot];
+        gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+            for (size_t i = 0; i < pastFrame.jobs.size() && i < slotQueries.queries.size(); ++i) {
+                batch.getQuery(slotQueries.queries[i]);
+            }
+        });
+    }
+}
+
+gpu::QueryPointer JobProfiler::getQuery(int slot, int sampleIndex) {
+    auto& slotQueries = _queries[slot];
+    while ((int)slotQueries.queries.size() <= sampleIndex) {
+        int index = (int)slotQueries.queries.size();
+        slotQueries.queries.push_back(std::make_shared<gpu::Query>([this, slot, index](const gpu::Query& query) {
+            setGPUTime(slot, index, query.getGPUElapsedTime());
+        }));
+        slotQueries.issuedFrameNumbers.push_back(0);
+    }
+    return slotQueries.queries[sampleIndex];
+}
+
+void JobProfiler::setGPUTime(int slot, int sampleIndex, double gpuMsecs) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // the slot may have been reused by a newer frame since the query was issued
+    auto& frame = _frames[slot];
+    if (sampleIndex < (int)frame.jobs.size() && _queries[slot].issuedFrameNumbers[sampleIndex] == frame.number) {
+        frame.jobs[sampleIndex].gpuMsecs = gpuMsecs;
+    }
+}
+
+JobProfiler::JobToken JobProfiler::beginJob(const std::string& name, quint64 startUsecs, RenderArgs* args) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    int slot = (int)(_frameNumber % NUM_FRAMES);
+    auto& frame = _frames[slot];
+
+    JobToken token;
+    token.frameNumber = _frameNumber;
+    token.sampleIndex = (int)frame.jobs.size();
+
+    JobSample sample;
+    sample.name = name;
+    sample.depth = _depth++;
+    sample.startUsecs = startUsecs;
+    frame.jobs.push_back(sample);
+
+    if (args && args->_context) {
+        auto query = getQuery(slot, token.sampleIndex);
+        _queries[slot].issuedFrameNumbers[token.sampleIndex] = _frameNumber;
+        gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+            batch.beginQuery(query);
+        });
+    }
+    return token;
+}
+
+void JobProfiler::endJob(const JobToken& token, quint64 endUsecs, RenderArgs* args) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    int slot = (int)(token.frameNumber % NUM_FRAMES);
+    auto& frame = _frames[slot];
+    if (frame.number != token.frameNumber || token.sampleIndex < 0 || token.sampleIndex >= (int)frame.jobs.size()) {
+        return;
+    }
+    auto& sample = frame.jobs[token.sampleIndex];
+    sample.cpuUsecs = endUsecs - sample.startUsecs;
+    if (token.frameNumber == _frameNumber) {
+        _depth = sample.depth;
+    }
+
+    // a begun query is always ended, it is asked for later with the rest of its frame
+    if (args && args->_context) {
+        auto query = getQuery(slot, token.sampleIndex);
+        gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+            batch.endQuery(query);
+        });
+    }
+}
+
+std::vector<JobProfiler::Frame> JobProfiler::getFrames() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<Frame> frames;
+    if (_frameNumber == 0) {
+        return frames;
+    }
+    // the current frame is still being recorded
+    quint64 first = _frameNumber > (quint64)NUM_FRAMES ? _frameNumber - NUM_FRAMES + 1 : 1;
+    for (quint64 number = first; number < _frameNumber; ++number) {
+        frames.push_back(_frames[number % NUM_FRAMES]);
+    }
+    return frames;
+}
@@ -0,0 +1,86 @@
+//
+//  JobProfiler.h
+//  render/src/render
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_render_JobProfiler_h
+#define hifi_render_JobProfiler_h
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include <gpu/Query.h>
+
+class RenderArgs;
+
+namespace render {
+
+// Records the CPU wall time and the GPU time of every job the engine runs, over a ring of recent frames.
+// Each job is bracketed with a pair of timer queries, which come back from the backend a few frames later.
+class JobProfiler {
+public:
+    static const int NUM_FRAMES { 64 };
+
+    struct JobSample {
+        std::string name;
+        int depth { 0 }; // how many tasks the job runs in
+        quint64 startUsecs { 0 };
+        quint64 cpuUsecs { 0 };
+        double gpuMsecs { -1.0 }; // until the query comes back
+    };
+
+    struct Frame {
+        quint64 number { 0 };
+        quint64 startUsecs { 0 };
+        std::vector<JobSample> jobs;
+    };
+
+    // Where beginJob put the sample, a job that began before a new frame did still ends in its own frame
+    struct JobToken {
+        quint64 frameNumber { 0 };
+        int sampleIndex { -1 };
+    };
+
+    // Starts recording a new frame, and asks the backend for the queries of a frame old enough to be done
+    void beginFrame(RenderArgs* args);
+
+    JobToken beginJob(const std::string& name, quint64 startUsecs, RenderArgs* args);
+    void endJob(const JobToken& token, quint64 endUsecs, RenderArgs* args);
+
+    // The frames in the ring that are complete, oldest first
+    std::vector<Frame> getFrames() const;
+
+private:
+    // The query of every job of a frame slot, and the frame it was last issued in
+    struct SlotQueries {
+        std::vector<gpu::QueryPointer> queries;
+        std::vector<quint64> issuedFrameNumbers;
+    };
+
+    gpu::QueryPointer getQuery(int slot, int sampleIndex);
+    void setGPUTime(int slot, int sampleIndex, double gpuMsecs);
+
+    mutable std::mutex _mutex; // the queries come back on the thread that executes the frames
+    std::array<Frame, NUM_FRAMES> _frames;
+    std::array<SlotQueries, NUM_FRAMES> _queries;
+    quint64 _frameNumber { 0 };
+    int _depth { 0 };
+};
+using JobProfilerPointer = std::shared_ptr<JobProfiler>;
+
+}
+
+#endif // hifi_render_JobProfiler_h
@@ -10,6 +10,7 @@
 //
 #include "Scene.h"
 
+#include <algorithm>
 #include <numeric>
 #include "gpu/Batch.h"
 
@@ -48,6 +49,15 @@ Scene::Scene(glm::vec3 origin, float size) :
     _items.push_back(Item()); // add the itemID #0 to nothing
 }
 
+Scene::~Scene() {
+    auto node = _changeStack.exchange(nullptr);
+    while (node) {
+        auto next = node->_next;
+        delete node;
+        node = next;
+    }
+}
+
 ItemID Scene::allocateID() {
     // Just increment and return the proevious value initialized at 0
     return _IDAllocator.fetch_add(1);
@@ -59,26 +69,27 @@ bool Scene::isAllocatedID(const ItemID& id) {
 
 /// Enqueue change batch to the scene
 void Scene::enqueuePendingChanges(const PendingChanges& pendingChanges) {
-    _changeQueueMutex.lock();
-    _changeQueue.push(pendingChanges);
-    _changeQueueMutex.unlock();
-}
+    if (pendingChanges.empty()) {
+        return;
+    }
 
-void consolidateChangeQueue(PendingChangesQueue& queue, PendingChanges& singleBatch) {
-    while (!queue.empty()) {
-        auto pendingChanges = queue.front();
-        singleBatch.merge(pendingChanges);
-        queue.pop();
-    };
+    auto node = new PendingChangesNode();
+    node->_changes = pendingChanges;
+    node->_next = _changeStack.load(std::memory_order_relaxed);
+    while (!_changeStack.compare_exchange_weak(node->_next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
 }
  
 void Scene::processPendingChangesQueue() {
     PROFILE_RANGE(__FUNCTION__);
-    _changeQueueMutex.lock();
-    PendingChanges consolidatedPendingChanges;
-    consolidateChangeQueue(_changeQueue, consolidatedPendingChanges);
-    _changeQueueMutex.unlock();
-    
+
+    // Take every enqueued batch, and put them back in the order they were enqueued
+    std::vector<PendingChangesNode*> batches;
+    for (auto node = _changeStack.exchange(nullptr, std::memory_order_acquire); node; node = node->_next) {
+        batches.push_back(node);
+    }
+    std::reverse(batches.begin(), batches.end());
+
     _itemsMutex.lock();
         // Here we should be able to check the value of last ItemID allocated 
         // and allocate new items accordingly
@@ -89,23 +100,36 @@ void Scene::processPendingChangesQueue() {
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the pendingChanges
 
+        // The batches are applied in place rather than merged into one first,
+        // every reset goes through before any update and every update before any remove, as if they had been merged
+
         // resets and potential NEW items
-        resetItems(consolidatedPendingChanges._resetItems, consolidatedPendingChanges._resetPayloads);
+        for (auto batch : batches) {
+            resetItems(batch->_changes._resetItems, batch->_changes._resetPayloads);
+        }
 
         // Update the numItemsAtomic counter AFTER the reset changes went through
         _numAllocatedItems.exchange(maxID);
 
         // updates
-        updateItems(consolidatedPendingChanges._updatedItems, consolidatedPendingChanges._updateFunctors);
+        for (auto batch : batches) {
+            updateItems(batch->_changes._updatedItems, batch->_changes._updateFunctors);
+        }
 
         // removes
-        removeItems(consolidatedPendingChanges._removedItems);
+        for (auto batch : batches) {
+            removeItems(batch->_changes._removedItems);
+        }
 
         // Update the numItemsAtomic counter AFTER the pending changes went through
         _numAllocatedItems.exchange(maxID);
 
      // ready to go back to rendering activities
     _itemsMutex.unlock();
+
+    for (auto batch : batches) {
+        delete batch;
+    }
 }
 
 void Scene::resetItems(const ItemIDs& ids, Payloads& payloads) {
@@ -36,6 +36,8 @@ public:
 
     void merge(PendingChanges& changes);
 
+    bool empty() const { return _resetItems.empty() && _removedItems.empty() && _updatedItems.empty(); }
+
     ItemIDs _resetItems; 
     Payloads _resetPayloads;
     ItemIDs _removedItems;
@@ -44,7 +46,6 @@ public:
 
 protected:
 };
-typedef std::queue<PendingChanges> PendingChangesQueue;
 
 
 // Scene is a container for Items
@@ -55,7 +56,7 @@ typedef std::queue<PendingChanges> PendingChangesQueue;
 class Scene {
 public:
     Scene(glm::vec3 origin, float size);
-    ~Scene() {}
+    ~Scene();
 
     // This call is thread safe, can be called from anywhere to allocate a new ID
     ItemID allocateID();
@@ -66,7 +67,7 @@ public:
     // THis is the total number of allocated items, this a threadsafe call
     size_t getNumItems() const { return _numAllocatedItems.load(); }
 
-    // Enqueue change batch to the scene
+    // Enqueue change batch to the scene, this is a threadsafe call that takes no lock
     void enqueuePendingChanges(const PendingChanges& pendingChanges);
 
     // Process the penging changes equeued
@@ -88,8 +89,14 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _changeQueueMutex;
-    PendingChangesQueue _changeQueue;
+
+    // Enqueued change batches are pushed on a lock free stack, the newest on top,
+    // and processPendingChangesQueue takes the whole stack at once
+    struct PendingChangesNode {
+        PendingChanges _changes;
+        PendingChangesNode* _next { nullptr };
+    };
+    std::atomic<PendingChangesNode*> _changeStack { nullptr };
 
     // The actual database
     // database of items is protected for editing by a mutex
@@ -93,6 +93,19 @@ void ShapePlumber::addPipeline(const Filter& filter, const gpu::ShaderPointer& p
     addPipelineHelper(filter, key, 0, shapePipeline);
 }
 
+std::vector<gpu::PipelinePointer> ShapePlumber::getPipelines() const {
+    // many keys share the same pipeline
+    std::vector<gpu::PipelinePointer> pipelines;
+    std::unordered_set<gpu::PipelinePointer> added;
+    for (const auto& entry : _pipelineMap) {
+        const auto& pipeline = entry.second->pipeline;
+        if (pipeline && added.insert(pipeline).second) {
+            pipelines.push_back(pipeline);
+        }
+    }
+    return pipelines;
+}
+
 const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Key& key) const {
     assert(!_pipelineMap.empty());
     assert(args);
@@ -273,6 +273,9 @@ public:
 
     const PipelinePointer pickPipeline(RenderArgs* args, const Key& key) const;
 
+    // The distinct gpu pipelines of all the keys
+    std::vector<gpu::PipelinePointer> getPipelines() const;
+
 protected:
     void addPipelineHelper(const Filter& filter, Key key, int bit, const PipelinePointer& pipeline);
     PipelineMap _pipelineMap;
@@ -13,71 +13,81 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+#include <string.h>
+
+#include <FrameArena.h>
+#include <Radix2InplaceSort.h>
+#include <Radix2IntegerScanner.h>
 #include <ViewFrustum.h>
 
 using namespace render;
 
-struct ItemBoundSort {
-    float _centerDepth = 0.0f;
-    float _nearDepth = 0.0f;
-    float _farDepth = 0.0f;
-    ItemID _id = 0;
-    AABox _bounds;
+// The items of one or more lists are sorted together on a 64 bit key, the index of their list in the high bits
+// and their depth in the low 32, so a single radix sort pass orders every list at once
+struct ItemSortKey {
+    uint64_t _key { 0 };
+    const ItemBound* _item { nullptr };
 
-    ItemBoundSort() {}
-    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
+    ItemSortKey() {}
+    ItemSortKey(uint64_t key, const ItemBound* item) : _key(key), _item(item) {}
 };
 
-struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
-    }
-};
+class ItemSortKeyScanner : public Radix2IntegerScanner<uint64_t> {
+public:
+    explicit ItemSortKeyScanner(int bits) : Radix2IntegerScanner<uint64_t>(bits) {}
 
-struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
-    }
+    bool bit(const ItemSortKey& v, const state_type& s) const { return Radix2IntegerScanner<uint64_t>::bit(v._key, s); }
 };
 
-void render::depthSortItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, bool frontToBack, const ItemBounds& inItems, ItemBounds& outItems) {
-    assert(renderContext->args);
-    assert(renderContext->args->hasViewFrustum());
-
-    auto& scene = sceneContext->_scene;
-    RenderArgs* args = renderContext->args;
-
-
-    // Allocate and simply copy
-    outItems.clear();
-    outItems.reserve(inItems.size());
-
+static uint32_t depthSortBits(float depth, bool frontToBack) {
+    // the distance to the camera is never negative, and the bits of a positive float order the same as its value
+    uint32_t bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    return frontToBack ? bits : ~bits;
+}
 
-    // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
+static void depthSortItemLists(const RenderArgs* args, bool frontToBack,
+                               const std::vector<const ItemBounds*>& inLists, const std::vector<ItemBounds*>& outLists) {
+    assert(inLists.size() == outLists.size());
+    const auto& frustum = args->getViewFrustum();
 
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distance = args->getViewFrustum().distanceToCamera(bound.calcCenter());
+    size_t numItems = 0;
+    for (auto inItems : inLists) {
+        numItems += inItems->size();
+    }
 
-        itemBoundSorts.emplace_back(ItemBoundSort(distance, distance, distance, itemDetails.id, bound));
+    FrameArena::Scope frameScope;
+    FrameVector<ItemSortKey> sortKeys;
+    sortKeys.reserve(numItems);
+    for (size_t i = 0; i < inLists.size(); ++i) {
+        uint64_t listBits = (uint64_t)i << 32;
+        for (const auto& item : *inLists[i]) {
+            float distance = frustum.distanceToCamera(item.bound.calcCenter());
+            sortKeys.emplace_back(listBits | depthSortBits(distance, frontToBack), &item);
+        }
     }
 
-    // sort against Z
-    if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
-    } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
+    // only scan as many bits as the list index can have
+    int numKeyBits = 32;
+    while (((size_t)1 << (numKeyBits - 32)) < inLists.size()) {
+        ++numKeyBits;
     }
+    radix2InplaceSort(sortKeys.begin(), sortKeys.end(), ItemSortKeyScanner(numKeyBits));
 
-    // Finally once sorted result to a list of itemID
-    for (auto& item : itemBoundSorts) {
-       outItems.emplace_back(ItemBound(item._id, item._bounds));
+    for (size_t i = 0; i < outLists.size(); ++i) {
+        outLists[i]->clear();
+        outLists[i]->reserve(inLists[i]->size());
     }
+    for (const auto& sortKey : sortKeys) {
+        outLists[(size_t)(sortKey._key >> 32)]->push_back(*sortKey._item);
+    }
+}
+
+void render::depthSortItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, bool frontToBack, const ItemBounds& inItems, ItemBounds& outItems) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+
+    depthSortItemLists(renderContext->args, frontToBack, { &inItems }, { &outItems });
 }
 
 void PipelineSortShapes::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, ShapeBounds& outShapes) {
@@ -101,18 +111,23 @@ void PipelineSortShapes::run(const SceneContextPointer& sceneContext, const Rend
 }
 
 void DepthSortShapes::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+
     outShapes.clear();
     outShapes.reserve(inShapes.size());
 
+    // sort the items of every pipeline in one pass rather than one sort per pipeline
+    std::vector<const ItemBounds*> inLists;
+    std::vector<ItemBounds*> outLists;
+    inLists.reserve(inShapes.size());
+    outLists.reserve(inShapes.size());
     for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
-        }
-
-        depthSortItems(sceneContext, renderContext, _frontToBack, inItems, outItems->second);
+        inLists.push_back(&pipeline.second);
+        outLists.push_back(&outShapes[pipeline.first]);
     }
+
+    depthSortItemLists(renderContext->args, _frontToBack, inLists, outLists);
 }
 
 void DepthSortItems::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems) {
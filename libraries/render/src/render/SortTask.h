@@ -35,6 +35,7 @@ namespace render {
 
     class DepthSortItems {
     public:
+        typedef void is_concurrent_tag;
         using JobModel = Job::ModelIO<DepthSortItems, ItemBounds, ItemBounds>;
 
         bool _frontToBack;
@@ -9,8 +9,12 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <QtCore/QThread>
 
+#include <ParallelFor.h>
+
 #include "Task.h"
 
 using namespace render;
@@ -24,3 +28,72 @@ void TaskConfig::refresh() {
     _task->configure(*this);
 }
 
+
+void Task::addDependencies() {
+    std::unordered_set<const void*> inputs;
+    _jobs.back().getInput().getConcepts(inputs);
+
+    std::vector<size_t> dependencies;
+    for (size_t i = 0; i + 1 < _jobs.size(); i++) {
+        std::unordered_set<const void*> outputs;
+        _jobs[i].getOutput().getConcepts(outputs);
+        for (auto& concept : outputs) {
+            if (inputs.count(concept)) {
+                dependencies.push_back(i);
+                break;
+            }
+        }
+    }
+    _dependencies.push_back(dependencies);
+}
+
+void Task::runJobs(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    size_t i = 0;
+    while (i < _jobs.size()) {
+        size_t end = i;
+        while (end < _jobs.size() && _jobs[end].isConcurrent()) {
+            end++;
+        }
+
+        if (end - i > 1) {
+            runConcurrentJobs(i, end, sceneContext, renderContext);
+            i = end;
+        } else {
+            _jobs[i].run(sceneContext, renderContext);
+            i++;
+        }
+    }
+}
+
+void Task::runConcurrentJobs(size_t begin, size_t end, const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    // sort the jobs into waves, each job going in the wave after the last of the ones it takes input from
+    std::vector<std::vector<size_t>> waves;
+    std::vector<size_t> jobWaves(end - begin, 0);
+    for (size_t i = begin; i < end; i++) {
+        size_t wave = 0;
+        for (auto dependency : _dependencies[i]) {
+            if (dependency >= begin) {
+                wave = std::max(wave, jobWaves[dependency - begin] + 1);
+            }
+        }
+        jobWaves[i - begin] = wave;
+        if (wave >= waves.size()) {
+            waves.resize(wave + 1);
+        }
+        waves[wave].push_back(i);
+    }
+
+    std::vector<quint64> runUsecs(end - begin, 0);
+    for (auto& wave : waves) {
+        parallelFor((int)wave.size(), [&](int index) {
+            size_t job = wave[index];
+            // the job's config is handed to it through the render context, so each job needs a context of its own
+            auto jobContext = std::make_shared<RenderContext>(*renderContext);
+            runUsecs[job - begin] = _jobs[job].runConcurrently(sceneContext, jobContext);
+        });
+    }
+
+    for (size_t i = begin; i < end; i++) {
+        _jobs[i].setCPURunTime(runUsecs[i - begin]);
+    }
+}
@@ -12,6 +12,8 @@
 #ifndef hifi_render_Task_h
 #define hifi_render_Task_h
 #include <tuple>
+#include <type_traits>
+#include <unordered_set>
 
 #include <QtCore/qobject.h>
 
@@ -19,10 +21,12 @@
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qjsonvalue.h>
 #include <shared/JSONHelpers.h>
+#include <shared/Tracing.h>
 
 #include "SettingHandle.h"
 
 #include "Context.h"
+#include "JobProfiler.h"
 
 #include "gpu/Batch.h"
 #include <PerfStat.h>
@@ -31,6 +35,9 @@ namespace render {
 
 class Varying;
 
+// A VaryingSet or VaryingArray is tagged with is_proxy_tag, so the Varying holding one can reach the varyings in it
+template <class T, class = void> struct is_varying_set : std::false_type {};
+template <class T> struct is_varying_set<T, typename T::is_proxy_tag> : std::true_type {};
 
 // A varying piece of data, to be used as Job/Task I/O
 // TODO: Task IO
@@ -55,6 +62,16 @@ public:
     template <class T> Varying getN (uint8_t index) const { return get<T>()[index]; }
     template <class T> Varying editN (uint8_t index) { return edit<T>()[index]; }
 
+    // Collects the data held by this varying and by any varyings it is a set of.
+    // Two varyings share data when one was made from the other, which is how a task tells which jobs feed which.
+    void getConcepts(std::unordered_set<const void*>& concepts) const {
+        if (_concept && concepts.insert(_concept.get()).second) {
+            for (uint8_t i = 0; i < length(); i++) {
+                (*this)[i].getConcepts(concepts);
+            }
+        }
+    }
+
 protected:
     class Concept {
     public:
@@ -70,13 +87,16 @@ protected:
         Model(const Data& data) : _data(data) {}
         virtual ~Model() = default;
 
-        virtual Varying operator[] (uint8_t index) const override {
-            Varying var;
-            return var;
-        }
-        virtual uint8_t length() const override { return 0; }
+        virtual Varying operator[] (uint8_t index) const override { return at(_data, index, is_varying_set<T>()); }
+        virtual uint8_t length() const override { return length(_data, is_varying_set<T>()); }
 
         Data _data;
+
+    private:
+        static Varying at(const Data& data, uint8_t index, std::true_type) { return data[index]; }
+        static Varying at(const Data& data, uint8_t index, std::false_type) { return Varying(); }
+        static uint8_t length(const Data& data, std::true_type) { return data.length(); }
+        static uint8_t length(const Data& data, std::false_type) { return 0; }
     };
 
     std::shared_ptr<Concept> _concept;
@@ -116,6 +136,7 @@ template <class T0, class T1, class T2>
 class VaryingSet3 : public std::tuple<Varying, Varying,Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet3() : Parent(Varying(T0()), Varying(T1()), Varying(T2())) {}
     VaryingSet3(const VaryingSet3& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src)) {}
@@ -148,6 +169,7 @@ template <class T0, class T1, class T2, class T3>
 class VaryingSet4 : public std::tuple<Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet4() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3())) {}
     VaryingSet4(const VaryingSet4& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src)) {}
@@ -186,6 +208,7 @@ template <class T0, class T1, class T2, class T3, class T4>
 class VaryingSet5 : public std::tuple<Varying, Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet5() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4())) {}
     VaryingSet5(const VaryingSet5& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src)) {}
@@ -228,6 +251,7 @@ template <class T0, class T1, class T2, class T3, class T4, class T5>
 class VaryingSet6 : public std::tuple<Varying, Varying, Varying, Varying, Varying, Varying>{
 public:
     using Parent = std::tuple<Varying, Varying, Varying, Varying, Varying, Varying>;
+    typedef void is_proxy_tag;
 
     VaryingSet6() : Parent(Varying(T0()), Varying(T1()), Varying(T2()), Varying(T3()), Varying(T4()), Varying(T5())) {}
     VaryingSet6(const VaryingSet6& src) : Parent(std::get<0>(src), std::get<1>(src), std::get<2>(src), std::get<3>(src), std::get<4>(src), std::get<5>(src)) {}
@@ -251,23 +275,49 @@ public:
     const T5& get5() const { return std::get<5>((*this)).template get<T5>(); }
     T5& edit5() { return std::get<5>((*this)).template edit<T5>(); }
 
+    virtual Varying operator[] (uint8_t index) const {
+        if (index == 5) {
+            return std::get<5>((*this));
+        } else if (index == 4) {
+            return std::get<4>((*this));
+        } else if (index == 3) {
+            return std::get<3>((*this));
+        } else if (index == 2) {
+            return std::get<2>((*this));
+        } else if (index == 1) {
+            return std::get<1>((*this));
+        } else {
+            return std::get<0>((*this));
+        }
+    }
+    virtual uint8_t length() const { return 6; }
+
     Varying hasVarying() const { return Varying((*this)); }
 };
 
 template < class T, int NUM >
 class VaryingArray : public std::array<Varying, NUM> {
 public:
+    typedef void is_proxy_tag;
+
     VaryingArray() {
         for (size_t i = 0; i < NUM; i++) {
             (*this)[i] = Varying(T());
         }
     }
+
+    uint8_t length() const { return NUM; }
 };
 
 class Job;
 class Task;
 class JobNoIO {};
 
+// A job type that only reads the scene and the render args, and writes nothing but its output and its config,
+// is tagged with is_concurrent_tag; its task may then run it on a worker thread alongside others like it
+template <class T, class = void> struct is_concurrent_job : std::false_type {};
+template <class T> struct is_concurrent_job<T, typename T::is_concurrent_tag> : std::true_type {};
+
 template <class C> class PersistentConfig : public C {
 public:
     const QString DEFAULT = "Default";
@@ -476,6 +526,8 @@ public:
         virtual QConfigPointer& getConfiguration() { return _config; }
         virtual void applyConfiguration() = 0;
 
+        virtual bool isConcurrent() const { return false; }
+
         virtual void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) = 0;
 
     protected:
@@ -510,6 +562,8 @@ public:
             jobConfigure(_data, *std::static_pointer_cast<C>(_config));
         }
 
+        bool isConcurrent() const override { return is_concurrent_job<T>::value; }
+
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) override {
             renderContext->jobConfig = std::static_pointer_cast<Config>(_config);
             if (renderContext->jobConfig->alwaysEnabled || renderContext->jobConfig->isEnabled()) {
@@ -522,12 +576,13 @@ public:
     template <class T, class O, class C = Config> using ModelO = Model<T, C, None, O>;
     template <class T, class I, class O, class C = Config> using ModelIO = Model<T, C, I, O>;
 
-    Job(std::string name, ConceptPointer concept) : _concept(concept), _name(name) {}
+    Job(std::string name, ConceptPointer concept) : _concept(concept), _name(name), _traceName(Tracing::internName(name)) {}
 
     const Varying getInput() const { return _concept->getInput(); }
     const Varying getOutput() const { return _concept->getOutput(); }
     QConfigPointer& getConfiguration() const { return _concept->getConfiguration(); }
     void applyConfiguration() { return _concept->applyConfiguration(); }
+    bool isConcurrent() const { return _concept->isConcurrent(); }
 
     template <class T> T& edit() {
         auto concept = std::static_pointer_cast<typename T::JobModel>(_concept);
@@ -538,16 +593,41 @@ public:
     void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
         PerformanceTimer perfTimer(_name.c_str());
         PROFILE_RANGE(_name.c_str());
+        TraceScope traceScope(_traceName);
         auto start = usecTimestampNow();
 
+        auto profiler = renderContext->jobProfiler;
+        JobProfiler::JobToken profilerToken;
+        if (profiler) {
+            profilerToken = profiler->beginJob(_name, start, renderContext->args);
+        }
+
         _concept->run(sceneContext, renderContext);
 
-        _concept->setCPURunTime((double)(usecTimestampNow() - start) / 1000.0);
+        auto end = usecTimestampNow();
+        if (profiler) {
+            profiler->endJob(profilerToken, end, renderContext->args);
+        }
+        _concept->setCPURunTime((double)(end - start) / 1000.0);
     }
 
+    // Runs the job on a worker thread, returning how long it took in usecs. The PerformanceTimer and the config's
+    // stats signal belong to the render thread, so the task reports the time with setCPURunTime once it is back there.
+    quint64 runConcurrently(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+        PROFILE_RANGE(_name.c_str());
+        TraceScope traceScope(_traceName);
+        auto start = usecTimestampNow();
+
+        _concept->run(sceneContext, renderContext);
+
+        return usecTimestampNow() - start;
+    }
+    void setCPURunTime(quint64 usecs) { _concept->setCPURunTime((double)usecs / 1000.0); }
+
     protected:
     ConceptPointer _concept;
     std::string _name = "";
+    const char* _traceName;
 };
 
 // A task is a specialized job to run a collection of other jobs
@@ -601,6 +681,7 @@ public:
     // Create a new job in the container's queue; returns the job's output
     template <class T, class... A> const Varying addJob(std::string name, const Varying& input, A&&... args) {
         _jobs.emplace_back(name, std::make_shared<typename T::JobModel>(input, std::forward<A>(args)...));
+        addDependencies();
         QConfigPointer config = _jobs.back().getConfiguration();
         config->setParent(getConfiguration().get());
         config->setObjectName(name.c_str());
@@ -656,8 +737,18 @@ public:
 protected:
     template <class T, class C, class I, class O> friend class Model;
 
+    // Runs the jobs in the order they were added, except for runs of consecutive concurrent jobs.
+    // Those are spread over the worker threads, each job starting once the jobs it takes input from are done.
+    // Every other job, and so all GPU batch recording, stays on the calling thread and in order.
+    void runJobs(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext);
+
     QConfigPointer _config;
     Jobs _jobs;
+    std::vector<std::vector<size_t>> _dependencies; // for each job, the earlier jobs whose output it takes as input
+
+private:
+    void addDependencies(); // of the last job added
+    void runConcurrentJobs(size_t begin, size_t end, const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext);
 };
 
 }
@@ -18,31 +18,51 @@
 #include <MappingRequest.h>
 #include <NetworkLogging.h>
 
+#include "ScriptPromises.h"
+
 AssetScriptingInterface::AssetScriptingInterface(QScriptEngine* engine) :
     _engine(engine)
 {
 
 }
 
-void AssetScriptingInterface::uploadData(QString data, QScriptValue callback) {
+QScriptValue AssetScriptingInterface::uploadData(QString data, QScriptValue callback) {
+    QScriptValue promise, resolve, reject;
+    if (!callback.isFunction()) {
+        promise = newPromise(_engine, resolve, reject);
+        callback = resolve;
+    }
+
     QByteArray dataByteArray = data.toUtf8();
     auto upload = DependencyManager::get<AssetClient>()->createUpload(dataByteArray);
 
-    QObject::connect(upload, &AssetUpload::finished, this, [this, callback](AssetUpload* upload, const QString& hash) mutable {
-        if (callback.isFunction()) {
+    QObject::connect(upload, &AssetUpload::finished, this, [this, callback, reject](AssetUpload* upload, const QString& hash) mutable {
+        if (upload->getError() != AssetUpload::NoError && reject.isFunction()) {
+            reject.call(QScriptValue(), QScriptValueList { upload->getErrorString() });
+        } else if (callback.isFunction()) {
             QString url = "atp:" + hash;
             QScriptValueList args { url };
             callback.call(_engine->currentContext()->thisObject(), args);
         }
     });
     upload->start();
+    return promise;
 }
 
-void AssetScriptingInterface::downloadData(QString urlString, QScriptValue callback) {
+QScriptValue AssetScriptingInterface::downloadData(QString urlString, QScriptValue callback) {
     const QString ATP_SCHEME { "atp:" };
 
+    QScriptValue promise, resolve, reject;
+    if (!callback.isFunction()) {
+        promise = newPromise(_engine, resolve, reject);
+        callback = resolve;
+    }
+
     if (!urlString.startsWith(ATP_SCHEME)) {
-        return;
+        if (reject.isFunction()) {
+            reject.call(QScriptValue(), QScriptValueList { "Not an ATP URL: " + urlString });
+        }
+        return promise;
     }
 
     // Make request to atp
@@ -55,7 +75,7 @@ void AssetScriptingInterface::downloadData(QString urlString, QScriptValue callb
 
     _pendingRequests << assetRequest;
 
-    connect(assetRequest, &AssetRequest::finished, this, [this, callback](AssetRequest* request) mutable {
+    connect(assetRequest, &AssetRequest::finished, this, [this, callback, reject, urlString](AssetRequest* request) mutable {
         Q_ASSERT(request->getState() == AssetRequest::Finished);
 
         if (request->getError() == AssetRequest::Error::NoError) {
@@ -64,6 +84,8 @@ void AssetScriptingInterface::downloadData(QString urlString, QScriptValue callb
                 QScriptValueList args { data };
                 callback.call(_engine->currentContext()->thisObject(), args);
             }
+        } else if (reject.isFunction()) {
+            reject.call(QScriptValue(), QScriptValueList { "Asset download failed: " + urlString });
         }
 
         request->deleteLater();
@@ -71,4 +93,5 @@ void AssetScriptingInterface::downloadData(QString urlString, QScriptValue callb
     });
 
     assetRequest->start();
+    return promise;
 }
@@ -24,8 +24,9 @@ class AssetScriptingInterface : public QObject {
 public:
     AssetScriptingInterface(QScriptEngine* engine);
 
-    Q_INVOKABLE void uploadData(QString data, QScriptValue callback);
-    Q_INVOKABLE void downloadData(QString url, QScriptValue downloadComplete);
+    // Without a callback, these return a Promise of the URL of the upload or the data of the download
+    Q_INVOKABLE QScriptValue uploadData(QString data, QScriptValue callback = QScriptValue());
+    Q_INVOKABLE QScriptValue downloadData(QString url, QScriptValue downloadComplete = QScriptValue());
 
 protected:
     QSet<AssetRequest*> _pendingRequests;
@@ -33,6 +33,29 @@ ScriptCache::ScriptCache(QObject* parent) {
 void ScriptCache::clearCache() {
     Lock lock(_containerLock);
     _scriptCache.clear();
+    _correctSyntax.clear();
+    _validEntityScripts.clear();
+}
+
+void ScriptCache::addCorrectSyntax(const QString& contents) {
+    Lock lock(_containerLock);
+    _correctSyntax.insert(contents);
+}
+
+bool ScriptCache::hasCorrectSyntax(const QString& contents) {
+    Lock lock(_containerLock);
+    return _correctSyntax.contains(contents);
+}
+
+void ScriptCache::addValidEntityScript(const QString& scriptOrURL, const QString& contents) {
+    Lock lock(_containerLock);
+    _validEntityScripts[scriptOrURL] = contents;
+}
+
+bool ScriptCache::isValidEntityScript(const QString& scriptOrURL, const QString& contents) {
+    Lock lock(_containerLock);
+    auto validContents = _validEntityScripts.find(scriptOrURL);
+    return validContents != _validEntityScripts.end() && validContents.value() == contents;
 }
 
 QString ScriptCache::getScript(const QUrl& unnormalizedURL, ScriptUser* scriptUser, bool& isPending, bool reload) {
@@ -42,6 +42,13 @@ public:
     // FIXME - how do we remove a script from the bad script list in the case of a redownload?
     void addScriptToBadScriptList(const QUrl& url) { _badScripts.insert(url); }
     bool isInBadScriptList(const QUrl& url) { return _badScripts.contains(url); }
+
+    // The sources that passed the checks of an engine: the checks don't depend on the engine, every engine can skip
+    // them for the same contents. The entity scripts are by URL, with the contents they passed with.
+    void addCorrectSyntax(const QString& contents);
+    bool hasCorrectSyntax(const QString& contents);
+    void addValidEntityScript(const QString& scriptOrURL, const QString& contents);
+    bool isValidEntityScript(const QString& scriptOrURL, const QString& contents);
     
 private slots:
     void scriptDownloaded(); // old version
@@ -56,6 +63,8 @@ private:
     QHash<QUrl, QString> _scriptCache;
     QMultiMap<QUrl, ScriptUser*> _scriptUsers;
     QSet<QUrl> _badScripts;
+    QSet<QString> _correctSyntax;
+    QHash<QString, QString> _validEntityScripts;
 };
 
 #endif // hifi_ScriptCache_h
\ No newline at end of file
@@ -10,6 +10,7 @@
 //
 
 #include <chrono>
+#include <climits>
 #include <thread>
 
 #include <QtCore/QCoreApplication>
@@ -55,6 +56,7 @@
 #include "ScriptCache.h"
 #include "ScriptEngineLogging.h"
 #include "ScriptEngine.h"
+#include "ScriptPromises.h"
 #include "TypedArrays.h"
 #include "XMLHttpRequestClass.h"
 #include "WebSocketClass.h"
@@ -139,12 +141,18 @@ static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName
 
 ScriptEngine::ScriptEngine(const QString& scriptContents, const QString& fileNameString) :
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
     _fileNameString(fileNameString),
     _arrayBufferClass(new ArrayBufferClass(this))
 {
     DependencyManager::get<ScriptEngines>()->addScriptEngine(this);
 
+    // a child, so it moves to the thread of the script with the engine
+    _timerClock.start();
+    _timerWheelTicker = new QTimer(this);
+    _timerWheelTicker->setSingleShot(true);
+    _timerWheelTicker->setTimerType(Qt::PreciseTimer);
+    connect(_timerWheelTicker, &QTimer::timeout, this, &ScriptEngine::fireTimers);
+
     connect(this, &QScriptEngine::signalHandlerException, this, [this](const QScriptValue& exception) {
         hadUncaughtExceptions(*this, _fileNameString);
     });
@@ -468,7 +476,11 @@ void ScriptEngine::init() {
     qScriptRegisterMetaType(this, RayToEntityIntersectionResultToScriptValue, RayToEntityIntersectionResultFromScriptValue);
     qScriptRegisterMetaType(this, RayToAvatarIntersectionResultToScriptValue, RayToAvatarIntersectionResultFromScriptValue);
     qScriptRegisterSequenceMetaType<QVector<QUuid>>(this);
+    qScriptRegisterSequenceMetaType<QVector<QVector<QUuid>>>(this);
     qScriptRegisterSequenceMetaType<QVector<EntityItemID>>(this);
+    qScriptRegisterSequenceMetaType<QVector<PickRay>>(this);
+    qScriptRegisterSequenceMetaType<QVector<RayToEntityIntersectionResult>>(this);
+    qScriptRegisterSequenceMetaType<QVector<EntityItemProperties>>(this);
 
     qScriptRegisterSequenceMetaType<QVector<glm::vec2> >(this);
     qScriptRegisterSequenceMetaType<QVector<glm::quat> >(this);
@@ -526,6 +538,9 @@ void ScriptEngine::init() {
 
     registerGlobalObject("Assets", &_assetScriptingInterface);
     registerGlobalObject("Resources", DependencyManager::get<ResourceScriptingInterface>().data());
+
+    // after Script, the handlers of the promises run from its timers
+    registerPromises(this);
 }
 
 void ScriptEngine::registerValue(const QString& valueName, QScriptValue value) {
@@ -734,6 +749,21 @@ void ScriptEngine::addEventHandler(const EntityItemID& entityID, const QString&
             };
         };
 
+        // runs on the thread of the signal
+        auto makeCoalescedPointerHandler = [this](QString eventName) -> PointerHandler {
+            return [this, eventName](const EntityItemID& entityItemID, const PointerEvent& event) {
+                std::lock_guard<std::mutex> lock(_pendingPointerEventsMutex);
+                if (!_handledEventNames.contains(eventName)) {
+                    return;
+                }
+                _pendingPointerEvents[{ entityItemID, eventName }] = event;
+                if (!_arePointerEventsPending) {
+                    _arePointerEventsPending = true;
+                    QMetaObject::invokeMethod(this, "forwardPendingPointerEvents", Qt::QueuedConnection);
+                }
+            };
+        };
+
         using CollisionHandler = std::function<void(const EntityItemID&, const EntityItemID&, const Collision&)>;
         auto makeCollisionHandler = [this](QString eventName) -> CollisionHandler {
             return [this, eventName](const EntityItemID& idA, const EntityItemID& idB, const Collision& collision) {
@@ -746,15 +776,18 @@ void ScriptEngine::addEventHandler(const EntityItemID& entityID, const QString&
         connect(entities.data(), &EntityScriptingInterface::leaveEntity, this, makeSingleEntityHandler("leaveEntity"));
 
         connect(entities.data(), &EntityScriptingInterface::mousePressOnEntity, this, makePointerHandler("mousePressOnEntity"));
-        connect(entities.data(), &EntityScriptingInterface::mouseMoveOnEntity, this, makePointerHandler("mouseMoveOnEntity"));
+        connect(entities.data(), &EntityScriptingInterface::mouseMoveOnEntity, this,
+                makeCoalescedPointerHandler("mouseMoveOnEntity"), Qt::DirectConnection);
         connect(entities.data(), &EntityScriptingInterface::mouseReleaseOnEntity, this, makePointerHandler("mouseReleaseOnEntity"));
 
         connect(entities.data(), &EntityScriptingInterface::clickDownOnEntity, this, makePointerHandler("clickDownOnEntity"));
-        connect(entities.data(), &EntityScriptingInterface::holdingClickOnEntity, this, makePointerHandler("holdingClickOnEntity"));
+        connect(entities.data(), &EntityScriptingInterface::holdingClickOnEntity, this,
+                makeCoalescedPointerHandler("holdingClickOnEntity"), Qt::DirectConnection);
         connect(entities.data(), &EntityScriptingInterface::clickReleaseOnEntity, this, makePointerHandler("clickReleaseOnEntity"));
 
         connect(entities.data(), &EntityScriptingInterface::hoverEnterEntity, this, makePointerHandler("hoverEnterEntity"));
-        connect(entities.data(), &EntityScriptingInterface::hoverOverEntity, this, makePointerHandler("hoverOverEntity"));
+        connect(entities.data(), &EntityScriptingInterface::hoverOverEntity, this,
+                makeCoalescedPointerHandler("hoverOverEntity"), Qt::DirectConnection);
         connect(entities.data(), &EntityScriptingInterface::hoverLeaveEntity, this, makePointerHandler("hoverLeaveEntity"));
 
         connect(entities.data(), &EntityScriptingInterface::collisionWithEntity, this, makeCollisionHandler("collisionWithEntity"));
@@ -765,6 +798,23 @@ void ScriptEngine::addEventHandler(const EntityItemID& entityID, const QString&
     CallbackList& handlersForEvent = _registeredHandlers[entityID][eventName];
     CallbackData handlerData = {handler, currentEntityIdentifier, currentSandboxURL};
     handlersForEvent << handlerData; // Note that the same handler can be added many times. See removeEntityEventHandler().
+    {
+        std::lock_guard<std::mutex> lock(_pendingPointerEventsMutex);
+        _handledEventNames.insert(eventName);
+    }
+}
+
+void ScriptEngine::forwardPendingPointerEvents() {
+    QHash<QPair<EntityItemID, QString>, PointerEvent> pendingPointerEvents;
+    {
+        std::lock_guard<std::mutex> lock(_pendingPointerEventsMutex);
+        pendingPointerEvents.swap(_pendingPointerEvents);
+        _arePointerEventsPending = false;
+    }
+    for (auto pending = pendingPointerEvents.begin(); pending != pendingPointerEvents.end(); ++pending) {
+        const EntityItemID& entityID = pending.key().first;
+        forwardHandlerCall(entityID, pending.key().second, { entityID.toScriptValue(this), pending->toScriptValue(this) });
+    }
 }
 
 
@@ -787,10 +837,21 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
         return result;
     }
 
-    // Check syntax
+    // Check syntax, once for all the engines evaluating the same source, a library included by many scripts is
+    // parsed once per engine instead of twice
     const QScriptProgram program(sourceCode, fileName, lineNumber);
-    if (!hasCorrectSyntax(program)) {
-        return QScriptValue();
+    // (the assignment-client has no ScriptCache)
+    QSharedPointer<ScriptCache> scriptCache;
+    if (DependencyManager::isSet<ScriptCache>()) {
+        scriptCache = DependencyManager::get<ScriptCache>();
+    }
+    if (!scriptCache || !scriptCache->hasCorrectSyntax(sourceCode)) {
+        if (!hasCorrectSyntax(program)) {
+            return QScriptValue();
+        }
+        if (scriptCache) {
+            scriptCache->addCorrectSyntax(sourceCode);
+        }
     }
 
     ++_evaluatesPending;
@@ -901,14 +962,17 @@ void ScriptEngine::run() {
         qint64 now = usecTimestampNow();
 
         // we check for 'now' in the past in case people set their clock back
-        if (_emitScriptUpdates() && _lastUpdate < now) {
+        // without a handler for update, there is nothing to time either
+        static const QMetaMethod updateSignal = QMetaMethod::fromSignal(&ScriptEngine::update);
+        if (_emitScriptUpdates() && _lastUpdate < now && isSignalConnected(updateSignal)) {
             float deltaTime = (float) (now - _lastUpdate) / (float) USECS_PER_SECOND;
-            if (!_isFinished) {
+            if (!_isFinished && allowCall(EntityItemID())) {
                 auto preUpdate = clock::now();
                 emit update(deltaTime);
                 auto postUpdate = clock::now();
-                auto elapsed = (postUpdate - preUpdate);
-                totalUpdates += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+                auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(postUpdate - preUpdate);
+                totalUpdates += elapsed;
+                _profiler.record(QUuid(), "update", (quint64)elapsed.count());
             }
         }
         _lastUpdate = now;
@@ -948,29 +1012,21 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
-        stopTimer(timer);
-    }
+    _timers.clear();
+    _timerWheel.clear();
+    _dueTimers.clear();
+    _timerWheelTicker->stop();
 }
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
+     // We could maintain a separate map of entityID => timers, but someone will have to prove to me that it's worth the complexity. -HRS
+    // the wheel drops the timers that aren't in the map anymore when they come up
+    for (auto it = _timers.begin(); it != _timers.end();) {
+        if (it->callback.definingEntityIdentifier == entityID) {
+            it = _timers.erase(it);
+        } else {
+            ++it;
         }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
-    }
-    for (auto timer:toDelete) { // now reap 'em
-        stopTimer(timer);
     }
-
 }
 
 void ScriptEngine::stop(bool marshal) {
@@ -1020,68 +1076,113 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+void ScriptEngine::fireTimers() {
     if (DependencyManager::get<ScriptEngines>()->isStopped()) {
-        qCDebug(scriptengine) << "Script.timerFired() while shutting down is ignored... parent script:" << getFilename();
+        qCDebug(scriptengine) << "Script.fireTimers() while shutting down is ignored... parent script:" << getFilename();
         return; // bail early
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    _timerWheel.advance((quint64)_timerClock.elapsed(), _dueTimers);
+    std::vector<TimerWheel::TimerID> dueTimers;
+    dueTimers.swap(_dueTimers);
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
+    // an interval skips its turn, a timeout comes back once the script has had time to get under its budget
+    const int THROTTLED_TIMEOUT_RETRY_MSECS = 100;
+    for (auto timer : dueTimers) {
+        auto it = _timers.find(timer);
+        if (it == _timers.end()) {
+            // stopped since it was scheduled
+            continue;
+        }
+        TimerData timerData = it.value();
+        if (!allowCall(timerData.callback.definingEntityIdentifier)) {
+            scheduleTimer(timer, timerData.isSingleShot ? THROTTLED_TIMEOUT_RETRY_MSECS : timerData.intervalMsecs);
+            continue;
+        }
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+        // before the call, so the script can stop its interval from the call
+        if (timerData.isSingleShot) {
+            _timers.erase(it);
+        } else {
+            scheduleTimer(timer, timerData.intervalMsecs);
+        }
+
+        // call the associated JS function, if it exists
+        const auto& callback = timerData.callback;
+        if (callback.function.isValid()) {
+            QString functionName = callback.function.property("name").toString();
+            callWithEnvironment(callback.definingEntityIdentifier, callback.definingSandboxURL, callback.function, callback.function,
+                QScriptValueList(), functionName.isEmpty() ? QString("timer") : "timer " + functionName);
+        }
+        if (_isFinished) {
+            break;
+        }
     }
+    updateTimerWheelTicker();
 }
 
+void ScriptEngine::scheduleTimer(TimerWheel::TimerID timer, int delayMsecs) {
+    // the wheel is kept at now, the timers it finds due fire with the next tick
+    quint64 now = (quint64)_timerClock.elapsed();
+    _timerWheel.advance(now, _dueTimers);
+    _timerWheel.schedule(timer, now + (quint64)std::max(delayMsecs, 0));
+}
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
-
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
-
-    CallbackData timerData = {function, currentEntityIdentifier, currentSandboxURL};
-    _timerFunctionMap.insert(newTimer, timerData);
+void ScriptEngine::updateTimerWheelTicker() {
+    if (!_dueTimers.empty()) {
+        _timerWheelWakeup = 0;
+        _timerWheelTicker->start(0);
+        return;
+    }
+    quint64 wakeup = _timerWheel.getNextWakeup();
+    if (wakeup == 0) {
+        _timerWheelTicker->stop();
+        return;
+    }
+    if (_timerWheelTicker->isActive() && _timerWheelWakeup != 0 && _timerWheelWakeup <= wakeup) {
+        return;
+    }
+    _timerWheelWakeup = wakeup;
+    quint64 now = (quint64)_timerClock.elapsed();
+    _timerWheelTicker->start((wakeup > now) ? (int)std::min<quint64>(wakeup - now, INT_MAX) : 0);
+}
 
-    newTimer->start(intervalMS);
-    return newTimer;
+TimerWheel::TimerID ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    TimerWheel::TimerID timer = ++_lastTimerID;
+    if (timer == 0) {
+        timer = ++_lastTimerID;
+    }
+    CallbackData callback = {function, currentEntityIdentifier, currentSandboxURL};
+    _timers.insert(timer, { callback, std::max(intervalMS, 0), isSingleShot });
+    scheduleTimer(timer, intervalMS);
+    updateTimerWheelTicker();
+    return timer;
 }
 
-QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
+TimerWheel::TimerID ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
     if (DependencyManager::get<ScriptEngines>()->isStopped()) {
         qCDebug(scriptengine) << "Script.setInterval() while shutting down is ignored... parent script:" << getFilename();
-        return NULL; // bail early
+        return 0; // bail early
     }
 
     return setupTimerWithInterval(function, intervalMS, false);
 }
 
-QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
+TimerWheel::TimerID ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     if (DependencyManager::get<ScriptEngines>()->isStopped()) {
         qCDebug(scriptengine) << "Script.setTimeout() while shutting down is ignored... parent script:" << getFilename();
-        return NULL; // bail early
+        return 0; // bail early
     }
 
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
+void ScriptEngine::stopTimer(TimerWheel::TimerID timer) {
+    // the wheel drops it when it comes up
+    if (_timers.remove(timer) > 0 && _timers.isEmpty()) {
+        _timerWheel.clear();
+        _dueTimers.clear();
+        _timerWheelTicker->stop();
     }
 }
 
@@ -1196,7 +1297,7 @@ void ScriptEngine::include(const QStringList& includeFiles, QScriptValue callbac
         _parentURL = parentURL;
 
         if (callback.isFunction()) {
-            callWithEnvironment(capturedEntityIdentifier, capturedSandboxURL, QScriptValue(callback), QScriptValue(), QScriptValueList());
+            callWithEnvironment(capturedEntityIdentifier, capturedSandboxURL, QScriptValue(callback), QScriptValue(), QScriptValueList(), "include");
         }
 
         loader->deleteLater();
@@ -1228,6 +1329,17 @@ void ScriptEngine::include(const QString& includeFile, QScriptValue callback) {
     include(urls, callback);
 }
 
+QScriptValue ScriptEngine::includeAsync(const QStringList& includeFiles) {
+    QScriptValue resolve, reject;
+    QScriptValue promise = newPromise(this, resolve, reject);
+    include(includeFiles, resolve);
+    return promise;
+}
+
+QScriptValue ScriptEngine::includeAsync(const QString& includeFile) {
+    return includeAsync(QStringList(includeFile));
+}
+
 // NOTE: The load() command is similar to the include() command except that it loads the script
 // as a stand-alone script. To accomplish this, the ScriptEngine class just emits a signal which
 // the Application or other context will connect to in order to know to actually load the script
@@ -1274,7 +1386,7 @@ void ScriptEngine::forwardHandlerCall(const EntityItemID& entityID, const QStrin
             // and the entity scripts may be for entities other than the one this is a handler for.
             // Fortunately, the definingEntityIdentifier captured the entity script id (if any) when the handler was added.
             CallbackData& handler = handlersForEvent[i];
-            callWithEnvironment(handler.definingEntityIdentifier, handler.definingSandboxURL, handler.function, QScriptValue(), eventHandlerArgs);
+            callWithEnvironment(handler.definingEntityIdentifier, handler.definingSandboxURL, handler.function, QScriptValue(), eventHandlerArgs, eventName);
         }
     }
 }
@@ -1298,44 +1410,12 @@ void ScriptEngine::loadEntityScript(QWeakPointer<ScriptEngine> theEngine, const
     }, forceRedownload);
 }
 
-// since all of these operations can be asynch we will always do the actual work in the response handler
-// for the download
-void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, const QString& scriptOrURL, const QString& contents, bool isURL, bool success) {
-    if (QThread::currentThread() != thread()) {
-#ifdef THREAD_DEBUGGING
-        qDebug() << "*** WARNING *** ScriptEngine::entityScriptContentAvailable() called on wrong thread ["
-            << QThread::currentThread() << "], invoking on correct thread [" << thread()
-            << "]  " "entityID:" << entityID << "scriptOrURL:" << scriptOrURL << "contents:"
-            << contents << "isURL:" << isURL << "success:" << success;
-#endif
-
-        QMetaObject::invokeMethod(this, "entityScriptContentAvailable",
-                                  Q_ARG(const EntityItemID&, entityID),
-                                  Q_ARG(const QString&, scriptOrURL),
-                                  Q_ARG(const QString&, contents),
-                                  Q_ARG(bool, isURL),
-                                  Q_ARG(bool, success));
-        return;
-    }
-
-#ifdef THREAD_DEBUGGING
-    qDebug() << "ScriptEngine::entityScriptContentAvailable() thread [" << QThread::currentThread() << "] expected thread [" << thread() << "]";
-#endif
-
-    auto scriptCache = DependencyManager::get<ScriptCache>();
-    bool isFileUrl = isURL && scriptOrURL.startsWith("file://");
-    auto fileName = QString("(EntityID:%1, %2)").arg(entityID.toString(), isURL ? scriptOrURL : "EmbededEntityScript");
-
+// Whether an entity script parses, and evaluates in a sandbox engine, in time, to the constructor of its entities
+static bool testEntityScript(const EntityItemID& entityID, const QString& scriptOrURL, const QString& contents,
+                             const QString& fileName) {
     QScriptProgram program(contents, fileName);
     if (!hasCorrectSyntax(program)) {
-        if (!isFileUrl) {
-            scriptCache->addScriptToBadScriptList(scriptOrURL);
-        }
-        return; // done processing script
-    }
-
-    if (isURL) {
-        setParentURL(scriptOrURL);
+        return false;
     }
 
     const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
@@ -1346,7 +1426,7 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         QTimer timeout;
         timeout.setSingleShot(true);
         timeout.start(SANDBOX_TIMEOUT);
-        connect(&timeout, &QTimer::timeout, [&sandbox, SANDBOX_TIMEOUT]{
+        QObject::connect(&timeout, &QTimer::timeout, [&sandbox, SANDBOX_TIMEOUT]{
             auto context = sandbox.currentContext();
             if (context) {
                 // Guard against infinite loops and non-performant code
@@ -1356,7 +1436,7 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         testConstructor = sandbox.evaluate(program);
     }
     if (hadUncaughtExceptions(sandbox, program.fileName())) {
-        return;
+        return false;
     }
 
     if (!testConstructor.isFunction()) {
@@ -1374,11 +1454,52 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
                               << "," << testConstructorValue
                               << "," << scriptOrURL;
 
-        if (!isFileUrl) {
-            scriptCache->addScriptToBadScriptList(scriptOrURL);
+        return false;
+    }
+    return true;
+}
+
+// since all of these operations can be asynch we will always do the actual work in the response handler
+// for the download
+void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, const QString& scriptOrURL, const QString& contents, bool isURL, bool success) {
+    if (QThread::currentThread() != thread()) {
+#ifdef THREAD_DEBUGGING
+        qDebug() << "*** WARNING *** ScriptEngine::entityScriptContentAvailable() called on wrong thread ["
+            << QThread::currentThread() << "], invoking on correct thread [" << thread()
+            << "]  " "entityID:" << entityID << "scriptOrURL:" << scriptOrURL << "contents:"
+            << contents << "isURL:" << isURL << "success:" << success;
+#endif
+
+        QMetaObject::invokeMethod(this, "entityScriptContentAvailable",
+                                  Q_ARG(const EntityItemID&, entityID),
+                                  Q_ARG(const QString&, scriptOrURL),
+                                  Q_ARG(const QString&, contents),
+                                  Q_ARG(bool, isURL),
+                                  Q_ARG(bool, success));
+        return;
+    }
+
+#ifdef THREAD_DEBUGGING
+    qDebug() << "ScriptEngine::entityScriptContentAvailable() thread [" << QThread::currentThread() << "] expected thread [" << thread() << "]";
+#endif
+
+    auto scriptCache = DependencyManager::get<ScriptCache>();
+    bool isFileUrl = isURL && scriptOrURL.startsWith("file://");
+    auto fileName = QString("(EntityID:%1, %2)").arg(entityID.toString(), isURL ? scriptOrURL : "EmbededEntityScript");
+
+    // the script of many entities, or of the same entity loaded again, is checked once
+    if (!scriptCache->isValidEntityScript(scriptOrURL, contents)) {
+        if (!testEntityScript(entityID, scriptOrURL, contents, fileName)) {
+            if (!isFileUrl) {
+                scriptCache->addScriptToBadScriptList(scriptOrURL);
+            }
+            return; // done processing script
         }
+        scriptCache->addValidEntityScript(scriptOrURL, contents);
+    }
 
-        return; // done processing script
+    if (isURL) {
+        setParentURL(scriptOrURL);
     }
 
     int64_t lastModified = 0;
@@ -1511,11 +1632,26 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
 }
-void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args) {
+void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject,
+        QScriptValueList args, const QString& callName) {
     auto operation = [&]() {
         function.call(thisObject, args);
     };
+    auto start = usecTimestampNow();
     doWithEnvironment(entityID, sandboxURL, operation);
+    _profiler.record(entityID, callName, usecTimestampNow() - start);
+}
+
+bool ScriptEngine::allowCall(const EntityItemID& entityID) {
+    if (_profiler.allowCall(entityID)) {
+        return true;
+    }
+    if (!_throttledOwners.contains(entityID)) {
+        _throttledOwners.insert(entityID);
+        qCWarning(scriptengine) << "Script" << _fileNameString << (entityID.isInvalidID() ? QString() : "entity " + entityID.toString())
+            << "is over its budget of" << _profiler.getBudget() << "msecs per second, its updates and timers are throttled";
+    }
+    return false;
 }
 
 void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const QStringList& params) {
@@ -1544,7 +1680,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             QScriptValueList args;
             args << entityID.toScriptValue(this);
             args << qScriptValueFromSequence(this, params);
-            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
+            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args, methodName);
         }
 
     }
@@ -1576,7 +1712,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             QScriptValueList args;
             args << entityID.toScriptValue(this);
             args << event.toScriptValue(this);
-            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
+            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args, methodName);
         }
     }
 }
@@ -1610,7 +1746,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             args << entityID.toScriptValue(this);
             args << otherID.toScriptValue(this);
             args << collisionToScriptValue(this, collision);
-            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
+            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args, methodName);
         }
     }
 }
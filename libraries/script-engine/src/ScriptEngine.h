@@ -12,8 +12,10 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <mutex>
 #include <vector>
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QSet>
@@ -37,7 +39,9 @@
 #include "Quat.h"
 #include "Mat4.h"
 #include "ScriptCache.h"
+#include "ScriptProfiler.h"
 #include "ScriptUUID.h"
+#include "TimerWheel.h"
 #include "Vec3.h"
 
 class QScriptEngineDebugger;
@@ -53,6 +57,13 @@ public:
     QUrl definingSandboxURL;
 };
 
+class TimerData {
+public:
+    CallbackData callback;
+    int intervalMsecs;
+    bool isSingleShot;
+};
+
 typedef QList<CallbackData> CallbackList;
 typedef QHash<QString, CallbackList> RegisteredEventHandlers;
 
@@ -126,11 +137,15 @@ public:
     Q_INVOKABLE void load(const QString& loadfile);
     Q_INVOKABLE void include(const QStringList& includeFiles, QScriptValue callback = QScriptValue());
     Q_INVOKABLE void include(const QString& includeFile, QScriptValue callback = QScriptValue());
-
-    Q_INVOKABLE QObject* setInterval(const QScriptValue& function, int intervalMS);
-    Q_INVOKABLE QObject* setTimeout(const QScriptValue& function, int timeoutMS);
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    // Loads like an include with a callback, returns a Promise settled once the files have been evaluated
+    Q_INVOKABLE QScriptValue includeAsync(const QStringList& includeFiles);
+    Q_INVOKABLE QScriptValue includeAsync(const QString& includeFile);
+
+    // The timers are numbers, 0 is never a timer
+    Q_INVOKABLE TimerWheel::TimerID setInterval(const QScriptValue& function, int intervalMS);
+    Q_INVOKABLE TimerWheel::TimerID setTimeout(const QScriptValue& function, int timeoutMS);
+    Q_INVOKABLE void clearInterval(const QScriptValue& timer) { stopTimer((TimerWheel::TimerID)timer.toUInt32()); }
+    Q_INVOKABLE void clearTimeout(const QScriptValue& timer) { stopTimer((TimerWheel::TimerID)timer.toUInt32()); }
     Q_INVOKABLE void print(const QString& message);
     Q_INVOKABLE QUrl resolvePath(const QString& path) const;
 
@@ -145,6 +160,14 @@ public:
 
     Q_INVOKABLE void requestGarbageCollection() { collectGarbage(); }
 
+    // The time spent in the updates, timers, event handlers and entity methods of the scripts of this engine
+    Q_INVOKABLE QVariantMap getProfile() const { return _profiler.toVariantMap(); }
+    Q_INVOKABLE void resetProfile() { _profiler.reset(); }
+    // Past the msecs per second, the updates and timers of a script are skipped until it is back under, 0 for no budget.
+    // The budget is for each entity script in the engine of the entity scripts.
+    Q_INVOKABLE void setCpuBudget(float msecsPerSecond) { _profiler.setBudget(msecsPerSecond); }
+    Q_INVOKABLE float getCpuBudget() const { return _profiler.getBudget(); }
+
     bool isFinished() const { return _isFinished; } // used by Application and ScriptWidget
     bool isRunning() const { return _isRunning; } // used by ScriptWidget
 
@@ -191,6 +214,8 @@ signals:
     void doneRunning();
 
 protected:
+    friend class ScriptEngines;
+
     QString _scriptContents;
     QString _parentURL;
     std::atomic<bool> _isFinished { false };
@@ -198,7 +223,14 @@ protected:
     std::atomic<bool> _isStopping { false };
     int _evaluatesPending { 0 };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    // All the timers of the scripts are in one wheel, the ticker wakes up for the next of them
+    QHash<TimerWheel::TimerID, TimerData> _timers;
+    TimerWheel _timerWheel;
+    std::vector<TimerWheel::TimerID> _dueTimers;
+    QTimer* _timerWheelTicker { nullptr };
+    quint64 _timerWheelWakeup { 0 };
+    QElapsedTimer _timerClock;
+    TimerWheel::TimerID _lastTimerID { 0 };
     QSet<QUrl> _includedURLs;
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
     bool _isThreaded { false };
@@ -209,15 +241,17 @@ protected:
     void init();
 
     bool evaluatePending() const { return _evaluatesPending > 0; }
-    void timerFired();
+    void fireTimers();
+    void scheduleTimer(TimerWheel::TimerID timer, int delayMsecs);
+    void updateTimerWheelTicker();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
 
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
-    QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    TimerWheel::TimerID setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
+    void stopTimer(TimerWheel::TimerID timer);
 
     QString _fileNameString;
     Quat _quatLibrary;
@@ -233,12 +267,26 @@ protected:
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
+
+    // The pointer events that come many times a frame are only sent on to the thread of the engine when some script
+    // handles them, and only the last of them for each entity since the engine last took them
+    Q_INVOKABLE void forwardPendingPointerEvents();
+    std::mutex _pendingPointerEventsMutex;
+    QSet<QString> _handledEventNames;
+    QHash<QPair<EntityItemID, QString>, PointerEvent> _pendingPointerEvents;
+    bool _arePointerEventsPending { false };
     Q_INVOKABLE void entityScriptContentAvailable(const EntityItemID& entityID, const QString& scriptOrURL, const QString& contents, bool isURL, bool success);
 
     EntityItemID currentEntityIdentifier {}; // Contains the defining entity script entity id during execution, if any. Empty for interface script execution.
     QUrl currentSandboxURL {}; // The toplevel url string for the entity script that loaded the code being executed, else empty.
     void doWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, std::function<void()> operation);
-    void callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args);
+    void callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject,
+        QScriptValueList args, const QString& callName);
+
+    // False when the script of the entity, or the script of this engine for an invalid one, is over its budget
+    bool allowCall(const EntityItemID& entityID);
+    ScriptProfiler _profiler;
+    QSet<QUuid> _throttledOwners;
 
     std::function<bool()> _emitScriptUpdates{ [](){ return true; }  };
 
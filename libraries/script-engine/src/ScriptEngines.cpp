@@ -15,6 +15,7 @@
 #include <SettingHandle.h>
 #include <UserActivityLogger.h>
 #include <PathUtils.h>
+#include <shared/Tracing.h>
 
 #include "ScriptEngine.h"
 #include "ScriptEngineLogging.h"
@@ -31,7 +32,8 @@ ScriptsModel& getScriptsModel() {
 }
 
 ScriptEngines::ScriptEngines()
-    : _scriptsLocationHandle("scriptsLocation", DESKTOP_LOCATION)
+    : _scriptsLocationHandle("scriptsLocation", DESKTOP_LOCATION),
+      _cpuBudgetHandle("scriptCpuBudget", 0.0f)
 {
     _scriptsModelFilter.setSourceModel(&_scriptsModel);
     _scriptsModelFilter.sort(0, Qt::AscendingOrder);
@@ -124,6 +126,7 @@ void ScriptEngines::addScriptEngine(ScriptEngine* engine) {
     } else {
         QMutexLocker locker(&_allScriptsMutex);
         _allKnownScriptEngines.insert(engine);
+        engine->setCpuBudget(_cpuBudgetHandle.get());
     }
 }
 
@@ -134,12 +137,23 @@ void ScriptEngines::removeScriptEngine(ScriptEngine* engine) {
     if (!_isStopped) {
         QMutexLocker locker(&_allScriptsMutex);
         _allKnownScriptEngines.remove(engine);
+        // an engine can go before it's launched, its address can't pass for a pooled engine after it
+        _initializedScriptEngines.remove(engine);
     }
 }
 
 void ScriptEngines::shutdownScripting() {
     _isStopped = true;
     QMutexLocker locker(&_allScriptsMutex);
+
+    // the pooled engines never ran
+    for (auto scriptEngine : _scriptEnginePool) {
+        _allKnownScriptEngines.remove(scriptEngine);
+        _initializedScriptEngines.remove(scriptEngine);
+        scriptEngine->deleteLater();
+    }
+    _scriptEnginePool.clear();
+
     qCDebug(scriptengine) << "Stopping all scripts.... currently known scripts:" << _allKnownScriptEngines.size();
 
     QMutableSetIterator<ScriptEngine*> i(_allKnownScriptEngines);
@@ -229,6 +243,32 @@ QVariantList ScriptEngines::getLocal() {
     return result;
 }
 
+QVariantList ScriptEngines::getProfiles() {
+    QVariantList result;
+    QMutexLocker locker(&_allScriptsMutex);
+    for (auto engine : _allKnownScriptEngines) {
+        QVariantMap profile = engine->getProfile();
+        profile.insert("name", engine->getFilename());
+        result.append(profile);
+    }
+    return result;
+}
+
+void ScriptEngines::setCpuBudget(const QString& scriptHash, float msecsPerSecond) {
+    auto engine = getScriptEngine(QUrl(scriptHash));
+    if (engine) {
+        engine->setCpuBudget(msecsPerSecond);
+    }
+}
+
+void ScriptEngines::setDefaultCpuBudget(float msecsPerSecond) {
+    _cpuBudgetHandle.set(msecsPerSecond);
+    QMutexLocker locker(&_allScriptsMutex);
+    for (auto engine : _allKnownScriptEngines) {
+        engine->setCpuBudget(msecsPerSecond);
+    }
+}
+
 QVariantList ScriptEngines::getRunning() {
     QVariantList result;
     auto runningScripts = getRunningScripts();
@@ -269,6 +309,7 @@ void ScriptEngines::loadOneScript(const QString& scriptFilename) {
 }
 
 void ScriptEngines::loadScripts() {
+    TRACE_SCOPE("ScriptEngines::loadScripts");
     // check first run...
     Setting::Handle<bool> firstRun { Settings::firstRun, true };
     if (firstRun.get()) {
@@ -464,7 +505,7 @@ ScriptEngine* ScriptEngines::loadScript(const QUrl& scriptFilename, bool isUserL
         return scriptEngine;
     }
 
-    scriptEngine = new ScriptEngine(NO_SCRIPT, "");
+    scriptEngine = takeScriptEngine();
     scriptEngine->setUserLoaded(isUserLoaded);
     connect(scriptEngine, &ScriptEngine::doneRunning, this, [scriptEngine] {
         scriptEngine->deleteLater();
@@ -485,6 +526,50 @@ ScriptEngine* ScriptEngines::loadScript(const QUrl& scriptFilename, bool isUserL
     return scriptEngine;
 }
 
+// Setting up the globals of an engine is most of the cost of starting a script, the pool pays it ahead of time,
+// one engine at a time in the event loop of the main thread.
+// QtScript can't clone an engine, each of the pool is set up on its own but none of it is in the way of a script starting.
+static const size_t SCRIPT_ENGINE_POOL_SIZE = 2;
+
+ScriptEngine* ScriptEngines::takeScriptEngine() {
+    ScriptEngine* scriptEngine = nullptr;
+    if (!_scriptEnginePool.empty()) {
+        scriptEngine = _scriptEnginePool.front();
+        _scriptEnginePool.pop_front();
+    } else {
+        scriptEngine = new ScriptEngine(NO_SCRIPT, "");
+    }
+
+    if (!_isRefillingScriptEnginePool) {
+        _isRefillingScriptEnginePool = true;
+        QTimer::singleShot(0, this, &ScriptEngines::refillScriptEnginePool);
+    }
+    return scriptEngine;
+}
+
+void ScriptEngines::refillScriptEnginePool() {
+    _isRefillingScriptEnginePool = false;
+    if (_isStopped || _scriptEnginePool.size() >= SCRIPT_ENGINE_POOL_SIZE) {
+        return;
+    }
+
+    auto scriptEngine = new ScriptEngine(NO_SCRIPT, "");
+    scriptEngine->init();
+    for (auto initializer : _scriptInitializers) {
+        initializer(scriptEngine);
+    }
+    {
+        QMutexLocker locker(&_allScriptsMutex);
+        _initializedScriptEngines.insert(scriptEngine);
+    }
+    _scriptEnginePool.push_back(scriptEngine);
+
+    if (_scriptEnginePool.size() < SCRIPT_ENGINE_POOL_SIZE) {
+        _isRefillingScriptEnginePool = true;
+        QTimer::singleShot(0, this, &ScriptEngines::refillScriptEnginePool);
+    }
+}
+
 ScriptEngine* ScriptEngines::getScriptEngine(const QUrl& rawScriptURL) {
     ScriptEngine* result = nullptr;
     {
@@ -523,9 +608,16 @@ void ScriptEngines::launchScriptEngine(ScriptEngine* scriptEngine) {
         loadScript(scriptName, userLoaded, false, false, true);
     });
 
-    // register our application services and set it off on its own thread
-    for (auto initializer : _scriptInitializers) {
-        initializer(scriptEngine);
+    // register our application services and set it off on its own thread, a pooled engine has them already
+    bool isInitialized;
+    {
+        QMutexLocker locker(&_allScriptsMutex);
+        isInitialized = _initializedScriptEngines.remove(scriptEngine);
+    }
+    if (!isInitialized) {
+        for (auto initializer : _scriptInitializers) {
+            initializer(scriptEngine);
+        }
     }
     
     if (scriptEngine->isDebuggable() || (qApp->queryKeyboardModifiers() & Qt::ShiftModifier)) {
@@ -64,6 +64,14 @@ public:
     Q_INVOKABLE QVariantList getPublic();
     Q_INVOKABLE QVariantList getLocal();
 
+    // The profile of every script engine, see ScriptEngine::getProfile
+    Q_INVOKABLE QVariantList getProfiles();
+    // The msecs per second a script can spend in its updates and timers, 0 for no budget
+    Q_INVOKABLE void setCpuBudget(const QString& scriptHash, float msecsPerSecond);
+    // The budget of all the scripts, and of the scripts to come
+    Q_INVOKABLE float getDefaultCpuBudget() const { return _cpuBudgetHandle.get(); }
+    Q_INVOKABLE void setDefaultCpuBudget(float msecsPerSecond);
+
     Q_PROPERTY(QString defaultScriptsPath READ getDefaultScriptsLocation)
 
     // Called at shutdown time
@@ -88,12 +96,22 @@ protected:
     void onScriptEngineError(const QString& scriptFilename);
     void launchScriptEngine(ScriptEngine* engine);
 
+    // A pooled engine if there is one, with the globals of the engine and of the application services already
+    // registered, otherwise a new one
+    ScriptEngine* takeScriptEngine();
+    void refillScriptEnginePool();
+
     QReadWriteLock _scriptEnginesHashLock;
     QHash<QUrl, ScriptEngine*> _scriptEnginesHash;
     QSet<ScriptEngine*> _allKnownScriptEngines;
     QMutex _allScriptsMutex;
     std::list<ScriptInitializer> _scriptInitializers;
+    // the engines made ahead of the scripts that will run in them, and the ones of those given out but not launched yet
+    std::list<ScriptEngine*> _scriptEnginePool;
+    QSet<ScriptEngine*> _initializedScriptEngines;
+    bool _isRefillingScriptEnginePool { false };
     mutable Setting::Handle<QString> _scriptsLocationHandle;
+    mutable Setting::Handle<float> _cpuBudgetHandle;
     ScriptsModel _scriptsModel;
     ScriptsModelFilter _scriptsModelFilter;
     std::atomic<bool> _isStopped { false };
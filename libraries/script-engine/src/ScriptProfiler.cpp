@@ -0,0 +1,106 @@
+//
+//  ScriptProfiler.cpp
+//  libraries/script-engine/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+
+#include <QtCore/QVariantList>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+void ScriptProfiler::setBudget(float msecsPerSecond) {
+    _budgetUsecsPerSecond = (quint64)(std::max(msecsPerSecond, 0.0f) * USECS_PER_MSEC);
+}
+
+float ScriptProfiler::getBudget() const {
+    return (float)_budgetUsecsPerSecond / USECS_PER_MSEC;
+}
+
+void ScriptProfiler::drain(OwnerStats& owner, quint64 now) const {
+    if (owner.lastDrain != 0 && now > owner.lastDrain) {
+        quint64 drained = (_budgetUsecsPerSecond * (now - owner.lastDrain)) / USECS_PER_SECOND;
+        owner.debtUsecs = (owner.debtUsecs > drained) ? owner.debtUsecs - drained : 0;
+    }
+    owner.lastDrain = now;
+}
+
+void ScriptProfiler::record(const QUuid& owner, const QString& call, quint64 usecs) {
+    auto now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_since == 0) {
+        _since = now;
+    }
+    auto& ownerStats = _owners[owner];
+    ownerStats.usecs += usecs;
+    drain(ownerStats, now);
+    // without a budget nothing is owed, a budget set later doesn't throttle for the time used before it
+    if (_budgetUsecsPerSecond != 0) {
+        ownerStats.debtUsecs += usecs;
+    }
+
+    auto& callStats = ownerStats.calls[call];
+    callStats.count++;
+    callStats.usecs += usecs;
+    callStats.maxUsecs = std::max(callStats.maxUsecs, usecs);
+}
+
+bool ScriptProfiler::allowCall(const QUuid& owner) {
+    quint64 budget = _budgetUsecsPerSecond;
+    if (budget == 0) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto ownerStats = _owners.find(owner);
+    if (ownerStats == _owners.end()) {
+        return true;
+    }
+    drain(ownerStats.value(), usecTimestampNow());
+    if (ownerStats->debtUsecs <= budget) {
+        return true;
+    }
+    ownerStats->throttled++;
+    return false;
+}
+
+void ScriptProfiler::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _owners.clear();
+    _since = 0;
+}
+
+QVariantMap ScriptProfiler::toVariantMap() const {
+    QVariantMap result;
+    result["budget"] = getBudget();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    result["seconds"] = (_since == 0) ? 0.0 : (double)(usecTimestampNow() - _since) / USECS_PER_SECOND;
+    QVariantList owners;
+    for (auto owner = _owners.begin(); owner != _owners.end(); ++owner) {
+        QVariantMap ownerMap;
+        ownerMap["entityID"] = owner.key().isNull() ? QString() : owner.key().toString();
+        ownerMap["msecs"] = (double)owner->usecs / USECS_PER_MSEC;
+        ownerMap["throttled"] = owner->throttled;
+        QVariantMap calls;
+        for (auto call = owner->calls.begin(); call != owner->calls.end(); ++call) {
+            QVariantMap callMap;
+            callMap["count"] = call->count;
+            callMap["msecs"] = (double)call->usecs / USECS_PER_MSEC;
+            callMap["maxMsecs"] = (double)call->maxUsecs / USECS_PER_MSEC;
+            calls[call.key()] = callMap;
+        }
+        ownerMap["calls"] = calls;
+        owners.push_back(ownerMap);
+    }
+    result["owners"] = owners;
+    return result;
+}
@@ -0,0 +1,71 @@
+//
+//  ScriptProfiler.h
+//  libraries/script-engine/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ScriptProfiler_h
+#define hifi_ScriptProfiler_h
+
+#include <atomic>
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+#include <QtCore/QVariantMap>
+
+// The time a script engine spends in each of the calls into its scripts: the updates, the timers, the event handlers and
+// the methods of the entity scripts, by the script they belong to. The engine of the entity scripts runs the scripts
+// of many entities, each of them is an owner of its own, null is the owner of the script of the engine itself.
+//
+// An owner with a budget is throttled once it has used more than its budget: the time it used drains at the rate of
+// the budget, so a script can burst up to a second of its budget and keep to the budget after that.
+class ScriptProfiler {
+public:
+    // The msecs of every second an owner can spend in its scripts, 0 for no budget
+    void setBudget(float msecsPerSecond);
+    float getBudget() const;
+
+    void record(const QUuid& owner, const QString& call, quint64 usecs);
+
+    // False when the owner has to skip this call, the throttled calls are counted
+    bool allowCall(const QUuid& owner);
+
+    void reset();
+
+    // { budget, seconds, owners: [ { entityID, msecs, throttled, calls: { name: { count, msecs, maxMsecs } } } ] }
+    QVariantMap toVariantMap() const;
+
+private:
+    struct CallStats {
+        quint32 count { 0 };
+        quint64 usecs { 0 };
+        quint64 maxUsecs { 0 };
+    };
+
+    struct OwnerStats {
+        quint64 usecs { 0 };
+        quint32 throttled { 0 };
+        // the usecs left to drain from the budget, and when they were last drained
+        quint64 debtUsecs { 0 };
+        quint64 lastDrain { 0 };
+        QHash<QString, CallStats> calls;
+    };
+
+    void drain(OwnerStats& owner, quint64 now) const;
+
+    mutable std::mutex _mutex;
+    QHash<QUuid, OwnerStats> _owners;
+    quint64 _since { 0 };
+    std::atomic<quint64> _budgetUsecsPerSecond { 0 };
+};
+
+#endif // hifi_ScriptProfiler_h
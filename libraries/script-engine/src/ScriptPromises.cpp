@@ -0,0 +1,210 @@
+//
+//  ScriptPromises.cpp
+//  libraries/script-engine/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptPromises.h"
+
+#include <QtScript/QScriptContext>
+
+#include "ScriptEngineLogging.h"
+
+static const QString PROMISE_SOURCE = R"SCRIPT(
+(function (global, script) {
+    var PENDING = 0, FULFILLED = 1, REJECTED = 2;
+
+    function run(promise, handler) {
+        script.setTimeout(function () {
+            var fulfilled = promise._state === FULFILLED;
+            var callback = fulfilled ? handler.onFulfilled : handler.onRejected;
+            if (typeof callback !== "function") {
+                (fulfilled ? handler.resolve : handler.reject)(promise._value);
+                return;
+            }
+            var result;
+            try {
+                result = callback(promise._value);
+            } catch (e) {
+                handler.reject(e);
+                return;
+            }
+            handler.resolve(result);
+        }, 0);
+    }
+
+    function Promise(executor) {
+        var self = this;
+        self._state = PENDING;
+        self._value = undefined;
+        self._handlers = [];
+
+        function settle(state, value) {
+            if (self._state !== PENDING) {
+                return;
+            }
+            self._state = state;
+            self._value = value;
+            var handlers = self._handlers;
+            self._handlers = [];
+            handlers.forEach(function (handler) {
+                run(self, handler);
+            });
+        }
+
+        // only the first call to resolve or reject counts, a thenable it resolves to is followed
+        var done = false;
+        function resolve(value) {
+            if (done) {
+                return;
+            }
+            done = true;
+            follow(value);
+        }
+        function reject(reason) {
+            if (done) {
+                return;
+            }
+            done = true;
+            settle(REJECTED, reason);
+        }
+        function follow(value) {
+            if (value === self) {
+                settle(REJECTED, new TypeError("A promise cannot be resolved with itself"));
+                return;
+            }
+            if (value && (typeof value === "object" || typeof value === "function")) {
+                var then;
+                try {
+                    then = value.then;
+                } catch (e) {
+                    settle(REJECTED, e);
+                    return;
+                }
+                if (typeof then === "function") {
+                    var called = false;
+                    try {
+                        then.call(value, function (next) {
+                            if (!called) {
+                                called = true;
+                                follow(next);
+                            }
+                        }, function (reason) {
+                            if (!called) {
+                                called = true;
+                                settle(REJECTED, reason);
+                            }
+                        });
+                    } catch (e) {
+                        if (!called) {
+                            called = true;
+                            settle(REJECTED, e);
+                        }
+                    }
+                    return;
+                }
+            }
+            settle(FULFILLED, value);
+        }
+
+        try {
+            executor(resolve, reject);
+        } catch (e) {
+            reject(e);
+        }
+    }
+
+    Promise.prototype.then = function (onFulfilled, onRejected) {
+        var self = this;
+        return new Promise(function (resolve, reject) {
+            var handler = { onFulfilled: onFulfilled, onRejected: onRejected, resolve: resolve, reject: reject };
+            if (self._state === PENDING) {
+                self._handlers.push(handler);
+            } else {
+                run(self, handler);
+            }
+        });
+    };
+
+    Promise.prototype["catch"] = function (onRejected) {
+        return this.then(undefined, onRejected);
+    };
+
+    Promise.resolve = function (value) {
+        if (value instanceof Promise) {
+            return value;
+        }
+        return new Promise(function (resolve) {
+            resolve(value);
+        });
+    };
+
+    Promise.reject = function (reason) {
+        return new Promise(function (resolve, reject) {
+            reject(reason);
+        });
+    };
+
+    Promise.all = function (values) {
+        return new Promise(function (resolve, reject) {
+            var results = [];
+            var remaining = values.length;
+            if (remaining === 0) {
+                resolve(results);
+                return;
+            }
+            values.forEach(function (value, index) {
+                Promise.resolve(value).then(function (result) {
+                    results[index] = result;
+                    if (--remaining === 0) {
+                        resolve(results);
+                    }
+                }, reject);
+            });
+        });
+    };
+
+    Promise.race = function (values) {
+        return new Promise(function (resolve, reject) {
+            values.forEach(function (value) {
+                Promise.resolve(value).then(resolve, reject);
+            });
+        });
+    };
+
+    global.Promise = Promise;
+})
+)SCRIPT";
+
+void registerPromises(QScriptEngine* engine) {
+    QScriptValue global = engine->globalObject();
+    QScriptValue install = engine->evaluate(PROMISE_SOURCE, "Promise.js");
+    if (engine->hasUncaughtException()) {
+        qCWarning(scriptengine) << "Failed to register Promise:" << engine->uncaughtException().toString();
+        engine->clearExceptions();
+        return;
+    }
+    install.call(QScriptValue(), QScriptValueList() << global << global.property("Script"));
+}
+
+static QScriptValue captureSettlers(QScriptContext* context, QScriptEngine* engine) {
+    QScriptValue settlers = context->callee().data();
+    settlers.setProperty("resolve", context->argument(0));
+    settlers.setProperty("reject", context->argument(1));
+    return QScriptValue();
+}
+
+QScriptValue newPromise(QScriptEngine* engine, QScriptValue& resolve, QScriptValue& reject) {
+    QScriptValue settlers = engine->newObject();
+    QScriptValue executor = engine->newFunction(captureSettlers);
+    executor.setData(settlers);
+    QScriptValue promise = engine->globalObject().property("Promise").construct(QScriptValueList() << executor);
+    resolve = settlers.property("resolve");
+    reject = settlers.property("reject");
+    return promise;
+}
@@ -0,0 +1,28 @@
+//
+//  ScriptPromises.h
+//  libraries/script-engine/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ScriptPromises_h
+#define hifi_ScriptPromises_h
+
+#include <QtScript/QScriptEngine>
+#include <QtScript/QScriptValue>
+
+// QtScript has no Promise: each engine gets one written in script, with then, catch, Promise.resolve, Promise.reject,
+// Promise.all and Promise.race. The handlers run from Script.setTimeout, so after the code that settled the promise
+// returns, on the thread and the timers of the engine.
+void registerPromises(QScriptEngine* engine);
+
+// A pending promise, and the functions that settle it, for the native calls that finish later
+QScriptValue newPromise(QScriptEngine* engine, QScriptValue& resolve, QScriptValue& reject);
+
+#endif // hifi_ScriptPromises_h
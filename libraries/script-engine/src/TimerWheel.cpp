@@ -0,0 +1,99 @@
+//
+//  TimerWheel.cpp
+//  libraries/script-engine/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+void TimerWheel::schedule(TimerID id, quint64 deadlineMsecs) {
+    ++_count;
+    insert({ id, std::max(deadlineMsecs, _current + 1) }, nullptr);
+}
+
+void TimerWheel::insert(const Entry& entry, std::vector<TimerID>* due) {
+    if (due && entry.deadline <= _current) {
+        due->push_back(entry.id);
+        --_count;
+        return;
+    }
+    // a timer goes in the level of the highest slot index its deadline and now differ in,
+    // in the slot of its own index: the wheel gets to the slot before it gets to the deadline
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        int upperBits = SLOT_BITS * (level + 1);
+        if ((entry.deadline >> upperBits) == (_current >> upperBits)) {
+            _levels[level][getSlotIndex(entry.deadline, level)].push_back(entry);
+            return;
+        }
+    }
+    _overflow.push_back(entry);
+}
+
+void TimerWheel::cascade(Slot& slot, std::vector<TimerID>& due) {
+    if (slot.empty()) {
+        return;
+    }
+    Slot entries;
+    entries.swap(slot);
+    for (const auto& entry : entries) {
+        insert(entry, &due);
+    }
+}
+
+void TimerWheel::advance(quint64 nowMsecs, std::vector<TimerID>& due) {
+    while (_current < nowMsecs) {
+        if (_count == 0) {
+            _current = nowMsecs;
+            return;
+        }
+        ++_current;
+
+        // each time a level wraps around, the next slot of the level above comes down, the highest level first
+        int numWrapped = 0;
+        while (numWrapped < NUM_LEVELS && getSlotIndex(_current, numWrapped) == 0) {
+            ++numWrapped;
+        }
+        if (numWrapped == NUM_LEVELS) {
+            cascade(_overflow, due);
+        }
+        for (int level = std::min(numWrapped, NUM_LEVELS - 1); level > 0; --level) {
+            cascade(_levels[level][getSlotIndex(_current, level)], due);
+        }
+        cascade(_levels[0][getSlotIndex(_current, 0)], due);
+    }
+}
+
+quint64 TimerWheel::getNextWakeup() const {
+    if (_count == 0) {
+        return 0;
+    }
+    // the slots of a level before the one of now are empty, they have been brought down already
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        int shift = SLOT_BITS * level;
+        quint64 levelStart = (_current >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+        for (quint64 index = getSlotIndex(_current, level) + 1; index < NUM_SLOTS; ++index) {
+            if (!_levels[level][index].empty()) {
+                return levelStart + (index << shift);
+            }
+        }
+    }
+    int totalBits = SLOT_BITS * NUM_LEVELS;
+    return ((_current >> totalBits) + 1) << totalBits;
+}
+
+void TimerWheel::clear() {
+    for (auto& level : _levels) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    _overflow.clear();
+    _count = 0;
+}
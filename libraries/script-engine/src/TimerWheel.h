@@ -0,0 +1,69 @@
+//
+//  TimerWheel.h
+//  libraries/script-engine/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <array>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+// The deadlines of many timers, in msecs, in a hierarchical timing wheel: four levels of 64 slots, each slot of a level
+// as long as the whole level below it, so a timer is added in constant time and is moved down a level at most three
+// times before it is due. The deadlines further than the four levels can tell apart wait in an overflow list.
+//
+// Timers are never removed: the owner of the wheel forgets the ones it doesn't want anymore and drops them when they
+// come up due, which is what makes removing one free.
+class TimerWheel {
+public:
+    using TimerID = quint32;
+
+    static const int SLOT_BITS = 6;
+    static const int NUM_SLOTS = 1 << SLOT_BITS;
+    static const int NUM_LEVELS = 4;
+
+    TimerWheel(quint64 nowMsecs = 0) : _current(nowMsecs) {}
+
+    // A deadline already past is due at the next advance
+    void schedule(TimerID id, quint64 deadlineMsecs);
+
+    // Moves the wheel to now, and appends the timers that came up due to the list, soonest first
+    void advance(quint64 nowMsecs, std::vector<TimerID>& due);
+
+    // The earliest time the next advance can have timers due, or 0 if there are no timers
+    quint64 getNextWakeup() const;
+
+    bool isEmpty() const { return _count == 0; }
+    void clear();
+
+private:
+    struct Entry {
+        TimerID id;
+        quint64 deadline;
+    };
+    using Slot = std::vector<Entry>;
+
+    void insert(const Entry& entry, std::vector<TimerID>* due);
+    void cascade(Slot& slot, std::vector<TimerID>& due);
+
+    static quint64 getSlotIndex(quint64 time, int level) { return (time >> (SLOT_BITS * level)) & (NUM_SLOTS - 1); }
+
+    std::array<std::array<Slot, NUM_SLOTS>, NUM_LEVELS> _levels;
+    Slot _overflow;
+    // the last msec the wheel has been moved to
+    quint64 _current;
+    size_t _count { 0 };
+};
+
+#endif // hifi_TimerWheel_h
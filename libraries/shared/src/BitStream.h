@@ -0,0 +1,86 @@
+//
+//  BitStream.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BitStream_h
+#define hifi_BitStream_h
+
+#include <stdint.h>
+
+// Packs values of 1 to 32 bits back to back into a buffer, most significant bit first.
+// The buffer must have room for every bit written, rounded up to a whole byte.
+class BitWriter {
+public:
+    BitWriter(unsigned char* buffer) : _start(buffer), _position(buffer) {}
+
+    void write(uint32_t value, int numBits) {
+        _accumulator = (_accumulator << numBits) | (value & (((uint64_t)1 << numBits) - 1));
+        _numAccumulatedBits += numBits;
+
+        while (_numAccumulatedBits >= 8) {
+            _numAccumulatedBits -= 8;
+            *_position++ = (unsigned char)(_accumulator >> _numAccumulatedBits);
+        }
+    }
+
+    // writes out the last partial byte padded with zeros, returns the number of bytes written in all
+    int flush() {
+        if (_numAccumulatedBits > 0) {
+            *_position++ = (unsigned char)(_accumulator << (8 - _numAccumulatedBits));
+            _numAccumulatedBits = 0;
+        }
+        return (int)(_position - _start);
+    }
+
+private:
+    unsigned char* _start;
+    unsigned char* _position;
+    uint64_t _accumulator { 0 };
+    int _numAccumulatedBits { 0 };
+};
+
+// Reads back what a BitWriter wrote. Reading past the end of the buffer gives zeros and sets overflowed().
+class BitReader {
+public:
+    BitReader(const unsigned char* buffer, int size) : _start(buffer), _position(buffer), _end(buffer + size) {}
+
+    uint32_t read(int numBits) {
+        while (_numAccumulatedBits < numBits) {
+            unsigned char byte = 0;
+            if (_position < _end) {
+                byte = *_position++;
+            } else {
+                _overflowed = true;
+            }
+            _accumulator = (_accumulator << 8) | byte;
+            _numAccumulatedBits += 8;
+        }
+
+        _numAccumulatedBits -= numBits;
+        return (uint32_t)((_accumulator >> _numAccumulatedBits) & (((uint64_t)1 << numBits) - 1));
+    }
+
+    bool overflowed() const { return _overflowed; }
+
+    // the bytes consumed so far, a byte that has only been partly read counts as consumed
+    int bytesRead() const { return (int)(_position - _start); }
+
+private:
+    const unsigned char* _start;
+    const unsigned char* _position;
+    const unsigned char* _end;
+    uint64_t _accumulator { 0 };
+    int _numAccumulatedBits { 0 };
+    bool _overflowed { false };
+};
+
+#endif // hifi_BitStream_h
@@ -13,13 +13,17 @@
 #define hifi_CPUDetect_h
 
 //
-// Lightweight functions to detect SSE/AVX/AVX2 support
+// Lightweight functions to detect SSE/AVX/AVX2/NEON support
 //
 
 #if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
 #define ARCH_X86
 #endif
 
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define ARCH_ARM_NEON
+#endif
+
 #define MASK_SSE3   (1 << 0)                // SSE3
 #define MASK_SSSE3  (1 << 9)                // SSSE3
 #define MASK_SSE41  (1 << 19)               // SSE4.1
@@ -143,8 +147,12 @@ static inline bool cpuSupportsAVX2() {
     bool result = false;
     if (cpuSupportsAVX()) {
 
-        if (__get_cpuid(0x7, &eax, &ebx, &ecx, &edx) && ((ebx & MASK_AVX2) == MASK_AVX2)) {
-            result = true;
+        // leaf 7 needs subleaf 0 in ecx, which __get_cpuid leaves undefined
+        if (__get_cpuid_max(0, nullptr) >= 0x7) {
+            __cpuid_count(0x7, 0, eax, ebx, ecx, edx);
+            if ((ebx & MASK_AVX2) == MASK_AVX2) {
+                result = true;
+            }
         }
     }
     return result;    
@@ -178,4 +186,16 @@ static inline bool cpuSupportsAVX2() {
 
 #endif
 
+//
+// NEON is part of the target ABI when the compiler enables it (armv8, armv7 with -mfpu=neon),
+// so unlike the x86 extensions this is known at compile time
+//
+static inline bool cpuSupportsNEON() {
+#ifdef ARCH_ARM_NEON
+    return true;
+#else
+    return false;
+#endif
+}
+
 #endif // hifi_CPUDetect_h
@@ -102,11 +102,6 @@ void BoundingRectangle::printDebugDetails(const char* label) const {
 }
 
 
-long CubeProjectedPolygon::pointInside_calls = 0;
-long CubeProjectedPolygon::occludes_calls = 0;
-long CubeProjectedPolygon::intersects_calls = 0;
-
-
 CubeProjectedPolygon::CubeProjectedPolygon(const BoundingRectangle& box) :
     _vertexCount(4),
     _maxX(-FLT_MAX), _maxY(-FLT_MAX), _minX(FLT_MAX), _minY(FLT_MAX),
@@ -140,8 +135,6 @@ void CubeProjectedPolygon::setVertex(int vertex, const glm::vec2& point) {
 // can be optimized with new pointInside()
 bool CubeProjectedPolygon::occludes(const CubeProjectedPolygon& occludee, bool checkAllInView) const {
 
-    CubeProjectedPolygon::occludes_calls++;
-
     // if we are completely out of view, then we definitely don't occlude!
     // if the occludee is completely out of view, then we also don't occlude it
     //
@@ -238,8 +231,6 @@ bool CubeProjectedPolygon::matches(const BoundingRectangle& box) const {
 
 bool CubeProjectedPolygon::pointInside(const glm::vec2& point, bool* matchesVertex) const {
 
-    CubeProjectedPolygon::pointInside_calls++;
-
     // first check the bounding boxes, the point must be fully within the boounding box of this polygon
     if ((point.x > getMaxX()) ||
         (point.y > getMaxY()) ||
@@ -280,7 +271,6 @@ bool CubeProjectedPolygon::intersects(const BoundingRectangle& box) const {
 }
 
 bool CubeProjectedPolygon::intersects(const CubeProjectedPolygon& testee) const {
-    CubeProjectedPolygon::intersects_calls++;
     return intersectsOnAxes(testee) && testee.intersectsOnAxes(*this);
 }
 
@@ -114,10 +114,6 @@ public:
 
     void printDebugDetails() const;
 
-    static long pointInside_calls;
-    static long occludes_calls;
-    static long intersects_calls;
-
 private:
     int _vertexCount;
     ProjectedVertices _vertices;
@@ -17,7 +17,9 @@
 #include <QSharedPointer>
 #include <QWeakPointer>
 
+#include <atomic>
 #include <functional>
+#include <mutex>
 #include <typeinfo>
 
 #define SINGLETON_DEPENDENCY \
@@ -41,6 +43,7 @@ protected:
 
 // usage:
 //     auto instance = DependencyManager::get<T>();
+//     auto instance = DependencyManager::getRaw<T>();
 //     auto instance = DependencyManager::set<T>(Args... args);
 //     DependencyManager::destroy<T>();
 //     DependencyManager::registerInheritance<Base, Derived>();
@@ -48,6 +51,11 @@ class DependencyManager {
 public:
     template<typename T>
     static QSharedPointer<T> get();
+
+    // For the hot paths: no lookup and no reference counting, the pointer is kept per type until the next set or destroy.
+    // It doesn't keep the instance alive, so it is only for the dependencies that outlive their callers, like the NodeList.
+    template<typename T>
+    static T* getRaw();
     
     template<typename T>
     static bool isSet();
@@ -74,6 +82,9 @@ private:
     
     QHash<size_t, QSharedPointer<Dependency>> _instanceHash;
     QHash<size_t, size_t> _inheritanceHash;
+
+    // bumped by every set and destroy, which makes the pointers kept by getRaw stale
+    std::atomic<quint64> _generation { 1 };
 };
 
 template <typename T>
@@ -92,6 +103,26 @@ QSharedPointer<T> DependencyManager::get() {
     return instance.toStrongRef();
 }
 
+template <typename T>
+T* DependencyManager::getRaw() {
+    static std::atomic<T*> instance { nullptr };
+    static std::atomic<quint64> instanceGeneration { 0 };
+    static std::mutex refreshMutex;
+
+    auto& dependencyManager = manager();
+    if (instanceGeneration.load(std::memory_order_acquire) == dependencyManager._generation.load(std::memory_order_acquire)) {
+        return instance.load(std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(refreshMutex);
+    // the generation is read before the instance, a set that comes in between makes the next call refresh again
+    quint64 generation = dependencyManager._generation.load(std::memory_order_acquire);
+    T* pointer = get<T>().data();
+    instance.store(pointer, std::memory_order_relaxed);
+    instanceGeneration.store(generation, std::memory_order_release);
+    return pointer;
+}
+
 template <typename T>
 bool DependencyManager::isSet() {
     static size_t hashCode = manager().getHashCode<T>();
@@ -105,10 +136,12 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
     static size_t hashCode = manager().getHashCode<T>();
 
     QSharedPointer<Dependency>& instance = manager().safeGet(hashCode);
+    ++manager()._generation; // the pointers getRaw kept are going away with the old instance
     instance.clear(); // Clear instance before creation of new one to avoid edge cases
     QSharedPointer<T> newInstance(new T(args...), &T::customDeleter);
     QSharedPointer<Dependency> storedInstance = qSharedPointerCast<Dependency>(newInstance);
     instance.swap(storedInstance);
+    ++manager()._generation;
 
     return newInstance;
 }
@@ -118,10 +151,12 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
     static size_t hashCode = manager().getHashCode<T>();
 
     QSharedPointer<Dependency>& instance = manager().safeGet(hashCode);
+    ++manager()._generation; // the pointers getRaw kept are going away with the old instance
     instance.clear(); // Clear instance before creation of new one to avoid edge cases
     QSharedPointer<T> newInstance(new I(args...), &I::customDeleter);
     QSharedPointer<Dependency> storedInstance = qSharedPointerCast<Dependency>(newInstance);
     instance.swap(storedInstance);
+    ++manager()._generation;
 
     return newInstance;
 }
@@ -129,6 +164,7 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
 template <typename T>
 void DependencyManager::destroy() {
     static size_t hashCode = manager().getHashCode<T>();
+    ++manager()._generation;
     manager().safeGet(hashCode).clear();
 }
 
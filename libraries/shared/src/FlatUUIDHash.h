@@ -0,0 +1,194 @@
+//
+//  FlatUUIDHash.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_FlatUUIDHash_h
+#define hifi_FlatUUIDHash_h
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QUuid>
+
+#include "UUIDHasher.h"
+
+// A map from a QUuid to T, kept in flat arrays with Robin Hood open addressing, for lookups by ID that are made far
+// more often than anything is added or removed. A lookup hashes the ID once and then reads the slots after its home
+// slot in order, and it can stop as soon as a slot holds a key that is closer to its own home than the ID would be.
+// That keeps the probes short and in one or two cache lines even with thousands of entries, with no node to chase
+// the way QHash has.
+//
+// Removal shifts the slots after the removed one back, so there are no tombstones to slow lookups down over time.
+// Pointers to values are only good until the next insert or remove. The map is not thread safe, the owner guards it.
+template <typename T>
+class FlatUUIDHash {
+public:
+    FlatUUIDHash() {}
+
+    int size() const { return _size; }
+    bool isEmpty() const { return _size == 0; }
+
+    T* find(const QUuid& key) {
+        int index = findIndex(key);
+        return index >= 0 ? &_values[index] : nullptr;
+    }
+    const T* find(const QUuid& key) const {
+        int index = findIndex(key);
+        return index >= 0 ? &_values[index] : nullptr;
+    }
+    bool contains(const QUuid& key) const { return findIndex(key) >= 0; }
+
+    // adds the value for key, or replaces the value it already has
+    void insert(const QUuid& key, const T& value) {
+        int index = findIndex(key);
+        if (index >= 0) {
+            _values[index] = value;
+            return;
+        }
+        if ((_size + 1) * MAX_LOAD_DENOMINATOR > capacity() * MAX_LOAD_NUMERATOR) {
+            rehash(capacity() > 0 ? capacity() * 2 : (int)MIN_CAPACITY);
+        }
+        insertNew(key, value);
+        ++_size;
+    }
+
+    bool remove(const QUuid& key) {
+        int index = findIndex(key);
+        if (index < 0) {
+            return false;
+        }
+
+        // pull the slots after it back by one, until one of them is empty or already in its home slot
+        int next = (index + 1) & _mask;
+        while (_distances[next] > 1) {
+            _keys[index] = _keys[next];
+            _values[index] = std::move(_values[next]);
+            _distances[index] = _distances[next] - 1;
+            index = next;
+            next = (next + 1) & _mask;
+        }
+        _keys[index] = QUuid();
+        _values[index] = T();
+        _distances[index] = 0;
+        --_size;
+        return true;
+    }
+
+    void clear() {
+        _keys.clear();
+        _values.clear();
+        _distances.clear();
+        _size = 0;
+        _mask = -1;
+        _shift = 32;
+    }
+
+    void reserve(int size) {
+        int neededCapacity = MIN_CAPACITY;
+        while (size * MAX_LOAD_DENOMINATOR > neededCapacity * MAX_LOAD_NUMERATOR) {
+            neededCapacity *= 2;
+        }
+        if (neededCapacity > capacity()) {
+            rehash(neededCapacity);
+        }
+    }
+
+    // calls function with the key and value of every entry, in no particular order
+    template <typename F> void forEach(F function) const {
+        for (int i = 0; i < capacity(); i++) {
+            if (_distances[i] != 0) {
+                function(_keys[i], _values[i]);
+            }
+        }
+    }
+
+private:
+    static const int MIN_CAPACITY = 16;
+    static const int MAX_LOAD_NUMERATOR = 7;
+    static const int MAX_LOAD_DENOMINATOR = 8;
+
+    int capacity() const { return (int)_distances.size(); }
+
+    int homeIndex(const QUuid& key) const {
+        // the UUID hash only mixes the words of the UUID together, so spread its bits over the top of the word
+        // before they pick the slot
+        uint32_t hash = (uint32_t)UUIDHasher()(key) * 2654435769u;
+        return (int)(hash >> _shift);
+    }
+
+    int findIndex(const QUuid& key) const {
+        if (_size == 0) {
+            return -1;
+        }
+        int index = homeIndex(key);
+        for (int distance = 1; _distances[index] >= distance; distance++) {
+            if (_distances[index] == distance && _keys[index] == key) {
+                return index;
+            }
+            index = (index + 1) & _mask;
+        }
+        return -1;
+    }
+
+    // places a key that is not in the map yet
+    void insertNew(QUuid key, T value) {
+        int index = homeIndex(key);
+        int distance = 1;
+        while (_distances[index] != 0) {
+            // the entry closer to its home gives its slot up, and carries on looking in place of the one placed
+            if (_distances[index] < distance) {
+                std::swap(_keys[index], key);
+                std::swap(_values[index], value);
+                std::swap(_distances[index], distance);
+            }
+            index = (index + 1) & _mask;
+            distance++;
+        }
+        _keys[index] = key;
+        _values[index] = std::move(value);
+        _distances[index] = distance;
+    }
+
+    void rehash(int newCapacity) {
+        std::vector<QUuid> oldKeys;
+        std::vector<T> oldValues;
+        std::vector<int> oldDistances;
+        oldKeys.swap(_keys);
+        oldValues.swap(_values);
+        oldDistances.swap(_distances);
+        _keys.resize(newCapacity);
+        _values.resize(newCapacity);
+        _distances.assign(newCapacity, 0);
+
+        _mask = newCapacity - 1;
+        _shift = 32;
+        for (int bits = newCapacity; bits > 1; bits >>= 1) {
+            --_shift;
+        }
+
+        for (size_t i = 0; i < oldDistances.size(); i++) {
+            if (oldDistances[i] != 0) {
+                insertNew(oldKeys[i], std::move(oldValues[i]));
+            }
+        }
+    }
+
+    std::vector<QUuid> _keys;
+    std::vector<T> _values;
+    std::vector<int> _distances; // how far each slot is from the home slot of its key, plus one, 0 is empty
+    int _size { 0 };
+    int _mask { -1 };
+    int _shift { 32 };
+};
+
+#endif // hifi_FlatUUIDHash_h
@@ -0,0 +1,96 @@
+//
+//  FrameArena.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <stdint.h>
+
+#include <QtCore/QThreadStorage>
+
+static const size_t BLOCK_SIZE = 256 * 1024;
+
+static QThreadStorage<FrameArena*> threadArenas;
+static std::atomic<size_t> highWaterMark { 0 };
+
+FrameArena::Scope::Scope(FrameArena& arena) :
+    _arena(arena),
+    _blockIndex(arena._blockIndex),
+    _blockOffset(arena._blockOffset),
+    _bytesUsed(arena._bytesUsed)
+{
+    ++_arena._scopeDepth;
+}
+
+FrameArena::Scope::~Scope() {
+    _arena._blockIndex = _blockIndex;
+    _arena._blockOffset = _blockOffset;
+    _arena._bytesUsed = _bytesUsed;
+
+    if (--_arena._scopeDepth == 0) {
+        size_t highest = highWaterMark.load();
+        while (_arena._highWaterMark > highest && !highWaterMark.compare_exchange_weak(highest, _arena._highWaterMark)) {
+        }
+    }
+}
+
+FrameArena& FrameArena::forThisThread() {
+    if (!threadArenas.hasLocalData()) {
+        threadArenas.setLocalData(new FrameArena());
+    }
+    return *threadArenas.localData();
+}
+
+size_t FrameArena::getHighWaterMark() {
+    return highWaterMark.load();
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    // anything handed out outside of a scope would never be taken back
+    assert(_scopeDepth > 0);
+
+    if (!_blocks.empty()) {
+        void* pointer = allocateInBlock(size, alignment);
+        if (pointer) {
+            return pointer;
+        }
+
+        // what is left of the block goes unused until the scope ends
+        _bytesUsed += _blockSizes[_blockIndex] - _blockOffset;
+        ++_blockIndex;
+        _blockOffset = 0;
+    }
+
+    size_t neededSize = size + alignment;
+    if (_blockIndex == _blocks.size() || _blockSizes[_blockIndex] < neededSize) {
+        size_t blockSize = std::max(BLOCK_SIZE, neededSize);
+        _blocks.insert(_blocks.begin() + _blockIndex, std::unique_ptr<char[]>(new char[blockSize]));
+        _blockSizes.insert(_blockSizes.begin() + _blockIndex, blockSize);
+        _bytesReserved += blockSize;
+    }
+
+    return allocateInBlock(size, alignment);
+}
+
+void* FrameArena::allocateInBlock(size_t size, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(_blocks[_blockIndex].get());
+    size_t alignedOffset = ((base + _blockOffset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+    if (alignedOffset + size > _blockSizes[_blockIndex]) {
+        return nullptr;
+    }
+
+    _bytesUsed += alignedOffset + size - _blockOffset;
+    _blockOffset = alignedOffset + size;
+    _highWaterMark = std::max(_highWaterMark, _bytesUsed);
+    return _blocks[_blockIndex].get() + alignedOffset;
+}
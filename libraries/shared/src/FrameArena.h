@@ -0,0 +1,126 @@
+//
+//  FrameArena.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_FrameArena_h
+#define hifi_FrameArena_h
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// A bump allocator for the scratch data of a frame, one for each thread, that keeps its memory from one frame to the
+// next so that a frame in a steady state allocates nothing from the heap.
+//
+// Memory is handed out from inside a Scope, and all of it is taken back at once when the Scope ends:
+//
+//     FrameArena::Scope frameScope;
+//     FrameVector<ItemSortKey> sortKeys;
+//     sortKeys.reserve(numItems);
+//
+// The Scope has to be declared before the containers that use it, so that they are gone before it is, and none of
+// them can be kept or handed out past it. Scopes nest, an inner one only takes back what was handed out inside of it.
+//
+// An arena is not thread safe. A container made on one thread can be read and written in place by others, but only
+// its own thread may grow it, so workers filling a FrameVector need it to be reserved before they start.
+class FrameArena {
+public:
+    class Scope {
+    public:
+        Scope(FrameArena& arena = FrameArena::forThisThread());
+        ~Scope();
+
+    private:
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        FrameArena& _arena;
+        size_t _blockIndex;
+        size_t _blockOffset;
+        size_t _bytesUsed;
+    };
+
+    static FrameArena& forThisThread();
+
+    // the most any arena has had handed out at once, to size the blocks against and to report in stats
+    static size_t getHighWaterMark();
+
+    FrameArena() {}
+
+    void* allocate(size_t size, size_t alignment);
+
+    size_t getBytesUsed() const { return _bytesUsed; }
+    size_t getBytesReserved() const { return _bytesReserved; }
+    size_t getLocalHighWaterMark() const { return _highWaterMark; }
+
+private:
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocateInBlock(size_t size, size_t alignment);
+
+    // the blocks past the current one are free, and are used again before new ones are made
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    std::vector<size_t> _blockSizes;
+    size_t _blockIndex { 0 };
+    size_t _blockOffset { 0 };
+    size_t _bytesUsed { 0 };
+    size_t _bytesReserved { 0 };
+    size_t _highWaterMark { 0 };
+    int _scopeDepth { 0 };
+};
+
+// An STL allocator in the FrameArena of the thread that makes it. Deallocating does nothing, the memory goes back to
+// the arena with the Scope it was allocated in.
+template <typename T>
+class FrameAllocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <typename U> struct rebind { typedef FrameAllocator<U> other; };
+
+    FrameAllocator() : _arena(&FrameArena::forThisThread()) {}
+    FrameAllocator(FrameArena& arena) : _arena(&arena) {}
+    template <typename U> FrameAllocator(const FrameAllocator<U>& other) : _arena(other.getArena()) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(_arena->allocate(count * sizeof(T), std::alignment_of<T>::value));
+    }
+    void deallocate(T* pointer, size_t count) {}
+
+    FrameArena* getArena() const { return _arena; }
+
+private:
+    FrameArena* _arena;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T>& left, const FrameAllocator<U>& right) {
+    return left.getArena() == right.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T>& left, const FrameAllocator<U>& right) {
+    return left.getArena() != right.getArena();
+}
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif // hifi_FrameArena_h
@@ -10,7 +10,12 @@
 //
 
 #include "GLMHelpers.h"
+
+#include <algorithm>
+
 #include <glm/gtc/matrix_transform.hpp>
+
+#include "BitStream.h"
 #include "NumericalConstants.h"
 
 const vec3 Vectors::UNIT_X{ 1.0f, 0.0f, 0.0f };
@@ -215,6 +220,67 @@ int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& qu
     return 6;
 }
 
+void packOrientationQuatToBits(BitWriter& writer, const glm::quat& quatInput, int bitsPerComponent) {
+    uint8_t largestComponent = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabs(quatInput[i]) > fabs(quatInput[largestComponent])) {
+            largestComponent = i;
+        }
+    }
+
+    // ensure that the sign of the dropped component is always negative.
+    glm::quat q = quatInput[largestComponent] > 0 ? -quatInput : quatInput;
+
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const float RANGE = (float)((1 << bitsPerComponent) - 1);
+
+    writer.write(largestComponent, 2);
+    for (int i = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            float value = glm::clamp((q[i] + MAGNITUDE) / (2.0f * MAGNITUDE), 0.0f, 1.0f);
+            writer.write((uint32_t)(value * RANGE + 0.5f), bitsPerComponent);
+        }
+    }
+}
+
+glm::quat unpackOrientationQuatFromBits(BitReader& reader, int bitsPerComponent) {
+    uint8_t largestComponent = (uint8_t)reader.read(2);
+
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const float RANGE = (float)((1 << bitsPerComponent) - 1);
+
+    glm::quat quatOutput;
+    float sumOfSquares = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            float component = ((float)reader.read(bitsPerComponent) / RANGE) * (2.0f * MAGNITUDE) - MAGNITUDE;
+            quatOutput[i] = component;
+            sumOfSquares += component * component;
+        }
+    }
+
+    // the missing component is always negative, at low precision the others can add up to slightly more than one
+    quatOutput[largestComponent] = -sqrtf(std::max(0.0f, 1.0f - sumOfSquares));
+    return glm::normalize(quatOutput);
+}
+
+void packFloatVec3ToBits(BitWriter& writer, const glm::vec3& vector, float maxDimension, int bitsPerComponent) {
+    const float RANGE = (float)((1 << bitsPerComponent) - 1);
+    for (int i = 0; i < 3; i++) {
+        float value = maxDimension > 0.0f ? glm::clamp((vector[i] / maxDimension + 1.0f) * 0.5f, 0.0f, 1.0f) : 0.5f;
+        writer.write((uint32_t)(value * RANGE + 0.5f), bitsPerComponent);
+    }
+}
+
+glm::vec3 unpackFloatVec3FromBits(BitReader& reader, float maxDimension, int bitsPerComponent) {
+    const float RANGE = (float)((1 << bitsPerComponent) - 1);
+    glm::vec3 vector;
+    for (int i = 0; i < 3; i++) {
+        vector[i] = ((float)reader.read(bitsPerComponent) / RANGE * 2.0f - 1.0f) * maxDimension;
+    }
+    return vector;
+}
+
 
 //  Safe version of glm::eulerAngles; uses the factorization method described in David Eberly's
 //  http://www.geometrictools.com/Documentation/EulerAngles.pdf (via Clyde,
@@ -572,3 +638,37 @@ glm::mat4 orthoInverse(const glm::mat4& m) {
     r[3][3] = 1.0f;
     return r;
 }
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <xmmintrin.h>
+
+void multiplyMat4(const glm::mat4& a, const glm::mat4& b, glm::mat4& result) {
+    // each column of the result is the columns of a weighted by the components of the same column of b
+    const __m128 a0 = _mm_loadu_ps(&a[0][0]);
+    const __m128 a1 = _mm_loadu_ps(&a[1][0]);
+    const __m128 a2 = _mm_loadu_ps(&a[2][0]);
+    const __m128 a3 = _mm_loadu_ps(&a[3][0]);
+
+    __m128 columns[4];
+    for (int i = 0; i < 4; i++) {
+        const __m128 column = _mm_loadu_ps(&b[i][0]);
+        __m128 sum = _mm_mul_ps(a0, _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(a1, _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1))));
+        sum = _mm_add_ps(sum, _mm_mul_ps(a2, _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))));
+        sum = _mm_add_ps(sum, _mm_mul_ps(a3, _mm_shuffle_ps(column, column, _MM_SHUFFLE(3, 3, 3, 3))));
+        columns[i] = sum;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        _mm_storeu_ps(&result[i][0], columns[i]);
+    }
+}
+
+#else
+
+void multiplyMat4(const glm::mat4& a, const glm::mat4& b, glm::mat4& result) {
+    result = a * b;
+}
+
+#endif
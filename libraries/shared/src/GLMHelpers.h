@@ -18,6 +18,9 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+class BitReader;
+class BitWriter;
+
 // Bring the most commonly used GLM types into the default namespace
 using glm::ivec2;
 using glm::ivec3;
@@ -105,6 +108,15 @@ int unpackOrientationQuatFromBytes(const unsigned char* buffer, glm::quat& quatO
 int packOrientationQuatToSixBytes(unsigned char* buffer, const glm::quat& quatInput);
 int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& quatOutput);
 
+// the same smallest three compression at a chosen precision, for streams of many quaternions where the 15 bits are
+// more than needed. Each of the three components takes bitsPerComponent bits (at most 15), plus 2 bits for the omitted one.
+void packOrientationQuatToBits(BitWriter& writer, const glm::quat& quatInput, int bitsPerComponent);
+glm::quat unpackOrientationQuatFromBits(BitReader& reader, int bitsPerComponent);
+
+// a vec3 with every component in -maxDimension..maxDimension, quantized to bitsPerComponent bits (at most 16) each
+void packFloatVec3ToBits(BitWriter& writer, const glm::vec3& vector, float maxDimension, int bitsPerComponent);
+glm::vec3 unpackFloatVec3FromBits(BitReader& reader, float maxDimension, int bitsPerComponent);
+
 // Ratios need the be highly accurate when less than 10, but not very accurate above 10, and they
 // are never greater than 1000 to 1, this allows us to encode each component in 16bits
 int packFloatRatioToTwoByte(unsigned char* buffer, float ratio);
@@ -243,4 +255,8 @@ inline bool isNaN(const glm::quat& value) { return isNaN(value.w) || isNaN(value
 
 glm::mat4 orthoInverse(const glm::mat4& m);
 
+// result = a * b, with SSE where it's available. Both operands are read before the result is written, so it may be
+// either of them.
+void multiplyMat4(const glm::mat4& a, const glm::mat4& b, glm::mat4& result);
+
 #endif // hifi_GLMHelpers_h
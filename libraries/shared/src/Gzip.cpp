@@ -12,10 +12,25 @@
 #include <zlib.h>
 #include "Gzip.h"
 
+#include <climits>
+#include <vector>
+
+#include "ParallelFor.h"
+
 const int GZIP_WINDOWS_BIT = 31;
+const int RAW_DEFLATE_WINDOWS_BIT = -15;
 const int GZIP_CHUNK_SIZE = 4096;
 const int DEFAULT_MEM_LEVEL = 8;
 
+// how much a GzipDevice reads or writes of the other device at once
+const int GZIP_DEVICE_CHUNK_SIZE = 64 * 1024;
+
+// how much of the data each job compresses when a GzipDevice compresses in parallel
+const int PARALLEL_BLOCK_SIZE = 1024 * 1024;
+
+// the gzip header written before blocks compressed in parallel: deflate, no flags or time, unknown OS
+const char PARALLEL_GZIP_HEADER[] = { '\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\xff' };
+
 bool gunzip(QByteArray source, QByteArray &destination) {
     destination.clear();
     if (source.length() == 0) {
@@ -151,3 +166,295 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     deflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+struct GzipDevice::Stream {
+    z_stream strm;
+    bool isDeflating { false };
+    bool isInflating { false };
+};
+
+GzipDevice::GzipDevice(QIODevice* device, int compressionLevel, int numCompressionThreads) :
+    _device(device),
+    _compressionLevel(qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel))),
+    _numCompressionThreads(qMax(1, numCompressionThreads)),
+    _stream(new Stream())
+{
+}
+
+GzipDevice::~GzipDevice() {
+    if (isOpen()) {
+        close();
+    }
+}
+
+bool GzipDevice::open(OpenMode mode) {
+    OpenMode readWrite = mode & ReadWrite;
+    if (isOpen() || (readWrite != ReadOnly && readWrite != WriteOnly) || !_device || !_device->isOpen()) {
+        return false;
+    }
+
+    z_stream& strm = _stream->strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = Z_NULL;
+    strm.avail_in = 0;
+
+    _buffer.clear();
+    _isFinished = false;
+    _hasError = false;
+    _crc = crc32(0, Z_NULL, 0);
+    _uncompressedSize = 0;
+
+    if (readWrite == ReadOnly) {
+        if (inflateInit2(&strm, GZIP_WINDOWS_BIT) != Z_OK) {
+            return false;
+        }
+        _stream->isInflating = true;
+        _buffer.resize(GZIP_DEVICE_CHUNK_SIZE);
+    } else if (_numCompressionThreads == 1) {
+        if (deflateInit2(&strm, _compressionLevel, Z_DEFLATED, GZIP_WINDOWS_BIT, DEFAULT_MEM_LEVEL,
+                         Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        _stream->isDeflating = true;
+    } else if (_device->write(PARALLEL_GZIP_HEADER, sizeof(PARALLEL_GZIP_HEADER)) != sizeof(PARALLEL_GZIP_HEADER)) {
+        return false;
+    }
+
+    return QIODevice::open(mode & ~Append);
+}
+
+void GzipDevice::close() {
+    if (!isOpen()) {
+        return;
+    }
+
+    if ((openMode() & WriteOnly) && !_hasError) {
+        if (_stream->isDeflating) {
+            _stream->strm.next_in = Z_NULL;
+            _stream->strm.avail_in = 0;
+            deflateToDevice(Z_FINISH);
+        } else {
+            deflateBlocks(_buffer.constData(), _buffer.size(), true);
+        }
+    }
+
+    if (_stream->isDeflating) {
+        deflateEnd(&_stream->strm);
+        _stream->isDeflating = false;
+    }
+    if (_stream->isInflating) {
+        inflateEnd(&_stream->strm);
+        _stream->isInflating = false;
+    }
+    _buffer.clear();
+
+    QIODevice::close();
+}
+
+bool GzipDevice::atEnd() const {
+    return (_isFinished || _hasError || !(openMode() & ReadOnly)) && QIODevice::atEnd();
+}
+
+void GzipDevice::fail(const QString& error) {
+    _hasError = true;
+    setErrorString(error);
+}
+
+qint64 GzipDevice::readData(char* data, qint64 maxSize) {
+    if (_hasError || _isFinished) {
+        return -1;
+    }
+
+    z_stream& strm = _stream->strm;
+    strm.next_out = (unsigned char*)data;
+    strm.avail_out = (uInt)qMin(maxSize, (qint64)INT_MAX);
+
+    while (strm.avail_out > 0) {
+        if (strm.avail_in == 0) {
+            qint64 got = _device->read(_buffer.data(), _buffer.size());
+            if (got < 0) {
+                fail(_device->errorString());
+                return -1;
+            }
+            if (got == 0) {
+                // until the other device has more
+                break;
+            }
+            strm.next_in = (unsigned char*)_buffer.data();
+            strm.avail_in = (uInt)got;
+        }
+
+        int status = inflate(&strm, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) {
+            // gzip members can follow one another, and read as the data of all of them together
+            if (strm.avail_in == 0 && _device->atEnd()) {
+                _isFinished = true;
+                break;
+            }
+            inflateReset(&strm);
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            fail(strm.msg ? QString(strm.msg) : QString("data not in gzip format"));
+            return -1;
+        }
+    }
+
+    qint64 produced = (char*)strm.next_out - data;
+    if (produced == 0 && !_isFinished && _device->atEnd()) {
+        fail("gzip data ended before the stream did");
+        return -1;
+    }
+    return produced;
+}
+
+qint64 GzipDevice::writeData(const char* data, qint64 maxSize) {
+    if (_hasError) {
+        return -1;
+    }
+
+    if (_stream->isDeflating) {
+        z_stream& strm = _stream->strm;
+        qint64 remaining = maxSize;
+        while (remaining > 0) {
+            uInt chunkSize = (uInt)qMin(remaining, (qint64)INT_MAX);
+            strm.next_in = (unsigned char*)data;
+            strm.avail_in = chunkSize;
+            if (!deflateToDevice(Z_NO_FLUSH)) {
+                return -1;
+            }
+            data += chunkSize;
+            remaining -= chunkSize;
+        }
+        return maxSize;
+    }
+
+    // large writes are compressed in place, and the rest is kept until there is a block for each thread
+    int batchSize = _numCompressionThreads * PARALLEL_BLOCK_SIZE;
+    int remaining = (int)maxSize;
+    if (_buffer.isEmpty() && remaining >= batchSize) {
+        int consumed = deflateBlocks(data, remaining, false);
+        if (consumed < 0) {
+            return -1;
+        }
+        data += consumed;
+        remaining -= consumed;
+    }
+    _buffer.append(data, remaining);
+    if (_buffer.size() >= batchSize) {
+        int consumed = deflateBlocks(_buffer.constData(), _buffer.size(), false);
+        if (consumed < 0) {
+            return -1;
+        }
+        _buffer.remove(0, consumed);
+    }
+    return maxSize;
+}
+
+bool GzipDevice::deflateToDevice(int flush) {
+    z_stream& strm = _stream->strm;
+    char out[GZIP_DEVICE_CHUNK_SIZE];
+    for (;;) {
+        strm.next_out = (unsigned char*)out;
+        strm.avail_out = GZIP_DEVICE_CHUNK_SIZE;
+        int status = deflate(&strm, flush);
+        if (status == Z_STREAM_ERROR) {
+            fail("unable to gzip data");
+            return false;
+        }
+        qint64 available = GZIP_DEVICE_CHUNK_SIZE - strm.avail_out;
+        if (available > 0 && _device->write(out, available) != available) {
+            fail(_device->errorString());
+            return false;
+        }
+        if (strm.avail_out != 0 && (flush != Z_FINISH || status == Z_STREAM_END)) {
+            return true;
+        }
+    }
+}
+
+// deflates one block on its own, ending it on a byte boundary so that the next block can follow it, or ending the
+// deflate data with it when it is the last
+static bool deflateBlock(const char* data, int size, int level, bool isLast, QByteArray& destination) {
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    if (deflateInit2(&strm, level, Z_DEFLATED, RAW_DEFLATE_WINDOWS_BIT, DEFAULT_MEM_LEVEL,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    // the sync marker and end of the data are a few bytes past the bound of the blocks themselves
+    const int FLUSH_BYTES = 16;
+    destination.resize((int)deflateBound(&strm, size) + FLUSH_BYTES);
+    strm.next_in = (unsigned char*)data;
+    strm.avail_in = size;
+    strm.next_out = (unsigned char*)destination.data();
+    strm.avail_out = destination.size();
+
+    int flush = isLast ? Z_FINISH : Z_SYNC_FLUSH;
+    int status;
+    for (;;) {
+        status = deflate(&strm, flush);
+        if (status == Z_STREAM_ERROR || status == Z_STREAM_END || strm.avail_out != 0) {
+            break;
+        }
+        int used = destination.size();
+        destination.resize(used + GZIP_CHUNK_SIZE);
+        strm.next_out = (unsigned char*)destination.data() + used;
+        strm.avail_out = GZIP_CHUNK_SIZE;
+    }
+    destination.resize(destination.size() - strm.avail_out);
+    deflateEnd(&strm);
+    // a sync flush that was already done when the output filled up has nothing left to do the next time
+    return isLast ? status == Z_STREAM_END : (status == Z_OK || status == Z_BUF_ERROR);
+}
+
+int GzipDevice::deflateBlocks(const char* data, int dataSize, bool finish) {
+    int numBlocks = dataSize / PARALLEL_BLOCK_SIZE;
+    if (finish) {
+        // the last block takes what is left, and there is always one to end the deflate data with
+        numBlocks = qMax((dataSize + PARALLEL_BLOCK_SIZE - 1) / PARALLEL_BLOCK_SIZE, 1);
+    }
+
+    std::vector<QByteArray> compressed(numBlocks);
+    std::vector<uLong> crcs(numBlocks);
+    std::vector<char> succeeded(numBlocks, 0);
+    int level = _compressionLevel;
+    parallelFor(numBlocks, [&](int i) {
+        int offset = i * PARALLEL_BLOCK_SIZE;
+        int size = qMin(PARALLEL_BLOCK_SIZE, dataSize - offset);
+        bool isLast = finish && i == numBlocks - 1;
+        crcs[i] = crc32(crc32(0, Z_NULL, 0), (const Bytef*)data + offset, size);
+        succeeded[i] = deflateBlock(data + offset, size, level, isLast, compressed[i]);
+    });
+
+    for (int i = 0; i < numBlocks; i++) {
+        if (!succeeded[i]) {
+            fail("unable to gzip data");
+            return -1;
+        }
+        int size = qMin(PARALLEL_BLOCK_SIZE, dataSize - i * PARALLEL_BLOCK_SIZE);
+        _crc = crc32_combine(_crc, crcs[i], size);
+        _uncompressedSize += (quint32)size;
+        if (_device->write(compressed[i]) != compressed[i].size()) {
+            fail(_device->errorString());
+            return -1;
+        }
+    }
+
+    if (finish) {
+        // the trailer is the CRC and size of the uncompressed data, little endian
+        char trailer[8];
+        for (int i = 0; i < 4; i++) {
+            trailer[i] = (char)((_crc >> (8 * i)) & 0xff);
+            trailer[4 + i] = (char)((_uncompressedSize >> (8 * i)) & 0xff);
+        }
+        if (_device->write(trailer, sizeof(trailer)) != sizeof(trailer)) {
+            fail(_device->errorString());
+            return -1;
+        }
+    }
+    return qMin(dataSize, numBlocks * PARALLEL_BLOCK_SIZE);
+}
@@ -12,7 +12,10 @@
 #ifndef GZIP_H
 #define GZIP_H
 
+#include <memory>
+
 #include <QByteArray>
+#include <QIODevice>
 
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
 // 9: 1 gives best speed, 9 gives best compression, 0 gives no
@@ -24,4 +27,53 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// A QIODevice that streams gzip through another device a chunk at a time, so that the compressed and uncompressed
+// forms of some data never have to be in memory together. Opened ReadOnly it reads gzip data from the device and gives
+// it back uncompressed, opened WriteOnly it compresses what is written to it out to the device, and close() finishes
+// the gzip stream.
+//
+// When writing with more than one compression thread, the data is cut into blocks that are deflated side by side on
+// the global thread pool, the way pigz does without its dictionaries, which costs a little in size but still makes
+// a single gzip stream any reader can read.
+//
+// The other device has to be open for reading or writing as this one is, and outlive it.
+class GzipDevice : public QIODevice {
+public:
+    GzipDevice(QIODevice* device, int compressionLevel = -1, int numCompressionThreads = 1);
+    ~GzipDevice();
+
+    bool isSequential() const override { return true; }
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool atEnd() const override;
+
+    bool hasError() const { return _hasError; }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    GzipDevice(const GzipDevice&) = delete;
+    GzipDevice& operator=(const GzipDevice&) = delete;
+
+    bool deflateToDevice(int flush);
+    int deflateBlocks(const char* data, int dataSize, bool finish);
+    void fail(const QString& error);
+
+    struct Stream;
+
+    QIODevice* _device;
+    int _compressionLevel;
+    int _numCompressionThreads;
+    std::unique_ptr<Stream> _stream;
+    QByteArray _buffer; // what has been read from the device, or written but not yet compressed in parallel
+    bool _isFinished { false };
+    bool _hasError { false };
+
+    // for compressing blocks in parallel, the CRC and size of what has been compressed, for the gzip trailer
+    quint32 _crc { 0 };
+    quint32 _uncompressedSize { 0 };
+};
+
 #endif
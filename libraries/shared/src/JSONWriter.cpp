@@ -0,0 +1,238 @@
+//
+//  JSONWriter.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JSONWriter.h"
+
+#include <assert.h>
+#include <cmath>
+#include <string.h>
+
+static const int INDENT_SPACES = 4;
+
+void JSONWriter::beginObject() {
+    beginLevel(true, '{');
+}
+
+void JSONWriter::endObject() {
+    assert(!_levels.empty() && _levels.back().isObject && !_levels.back().isPending);
+    endLevel('}');
+}
+
+void JSONWriter::beginArray() {
+    beginLevel(false, '[');
+}
+
+void JSONWriter::endArray() {
+    assert(!_levels.empty() && !_levels.back().isObject);
+    endLevel(']');
+}
+
+void JSONWriter::beginGroup(const char* name) {
+    assert(!_levels.empty() && _levels.back().isObject && !_hasKey);
+    Level group;
+    group.isObject = true;
+    group.isEmpty = true;
+    group.isPending = true;
+    group.name = name;
+    _levels.push_back(group);
+}
+
+void JSONWriter::endGroup() {
+    assert(!_levels.empty() && _levels.back().isObject);
+    if (_levels.back().isPending) {
+        _levels.pop_back();
+    } else {
+        endLevel('}');
+    }
+}
+
+void JSONWriter::key(const char* name) {
+    openPendingGroups();
+    assert(!_levels.empty() && _levels.back().isObject && !_hasKey);
+    Level& level = _levels.back();
+    if (!level.isEmpty) {
+        _output += ',';
+    }
+    level.isEmpty = false;
+    newLine(_levels.size());
+    writeString(name, (int)strlen(name));
+    _output += ": ";
+    _hasKey = true;
+}
+
+void JSONWriter::writeNull() {
+    beginValue();
+    _output += "null";
+}
+
+void JSONWriter::write(bool value) {
+    beginValue();
+    _output += value ? "true" : "false";
+}
+
+void JSONWriter::write(int value) {
+    beginValue();
+    _output += QByteArray::number(value);
+}
+
+void JSONWriter::write(qint64 value) {
+    beginValue();
+    _output += QByteArray::number(value);
+}
+
+void JSONWriter::write(quint64 value) {
+    beginValue();
+    _output += QByteArray::number(value);
+}
+
+void JSONWriter::write(float value) {
+    beginValue();
+    if (!std::isfinite(value)) {
+        _output += "null";
+        return;
+    }
+    // the shortest text that reads back as the same float
+    QByteArray text;
+    for (int precision = 6; precision < 9; precision++) {
+        text = QByteArray::number(value, 'g', precision);
+        if (text.toFloat() == value) {
+            _output += text;
+            return;
+        }
+    }
+    _output += QByteArray::number(value, 'g', 9);
+}
+
+void JSONWriter::write(double value) {
+    beginValue();
+    if (!std::isfinite(value)) {
+        _output += "null";
+        return;
+    }
+    QByteArray text;
+    for (int precision = 15; precision < 17; precision++) {
+        text = QByteArray::number(value, 'g', precision);
+        if (text.toDouble() == value) {
+            _output += text;
+            return;
+        }
+    }
+    _output += QByteArray::number(value, 'g', 17);
+}
+
+void JSONWriter::write(const char* value) {
+    beginValue();
+    writeString(value, (int)strlen(value));
+}
+
+void JSONWriter::write(const QString& value) {
+    beginValue();
+    QByteArray utf8 = value.toUtf8();
+    writeString(utf8.constData(), utf8.size());
+}
+
+void JSONWriter::beginValue() {
+    openPendingGroups();
+    if (_hasKey) {
+        _hasKey = false;
+        return;
+    }
+    if (!_levels.empty()) {
+        Level& level = _levels.back();
+        assert(!level.isObject);
+        if (!level.isEmpty) {
+            _output += ',';
+        }
+        level.isEmpty = false;
+        newLine(_levels.size());
+    }
+}
+
+void JSONWriter::openPendingGroups() {
+    if (_levels.empty() || !_levels.back().isPending) {
+        return;
+    }
+    size_t first = _levels.size() - 1;
+    while (first > 0 && _levels[first - 1].isPending) {
+        --first;
+    }
+    for (size_t i = first; i < _levels.size(); i++) {
+        Level& parent = _levels[i - 1];
+        if (!parent.isEmpty) {
+            _output += ',';
+        }
+        parent.isEmpty = false;
+        newLine(i);
+        writeString(_levels[i].name, (int)strlen(_levels[i].name));
+        _output += ": {";
+        _levels[i].isPending = false;
+    }
+}
+
+void JSONWriter::beginLevel(bool isObject, char open) {
+    beginValue();
+    _output += open;
+    Level level;
+    level.isObject = isObject;
+    level.isEmpty = true;
+    level.isPending = false;
+    level.name = nullptr;
+    _levels.push_back(level);
+}
+
+void JSONWriter::endLevel(char close) {
+    bool isEmpty = _levels.back().isEmpty;
+    _levels.pop_back();
+    if (!isEmpty) {
+        newLine(_levels.size());
+    }
+    _output += close;
+    if (_levels.empty()) {
+        _output += '\n';
+    }
+}
+
+void JSONWriter::newLine(size_t depth) {
+    _output += '\n';
+    _output.append(QByteArray((int)depth * INDENT_SPACES, ' '));
+}
+
+void JSONWriter::writeString(const char* value, int length) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    _output += '"';
+    // the runs of characters that need no escape go out in one append
+    int runStart = 0;
+    for (int i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)value[i];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        _output.append(value + runStart, i - runStart);
+        runStart = i + 1;
+        switch (c) {
+            case '"': _output += "\\\""; break;
+            case '\\': _output += "\\\\"; break;
+            case '\b': _output += "\\b"; break;
+            case '\f': _output += "\\f"; break;
+            case '\n': _output += "\\n"; break;
+            case '\r': _output += "\\r"; break;
+            case '\t': _output += "\\t"; break;
+            default:
+                _output += "\\u00";
+                _output += HEX_DIGITS[c >> 4];
+                _output += HEX_DIGITS[c & 0xf];
+                break;
+        }
+    }
+    _output.append(value + runStart, length - runStart);
+    _output += '"';
+}
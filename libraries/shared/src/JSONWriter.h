@@ -0,0 +1,76 @@
+//
+//  JSONWriter.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_JSONWriter_h
+#define hifi_JSONWriter_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+// Writes JSON straight to a byte array as it goes, laid out the way QJsonDocument::Indented lays it out, for data that
+// is too large to build a QJsonDocument or a QVariant of first.
+//
+// Members of an object are written with key() followed by the value. A group is an object member that is only written
+// if something is written in it, for the sets of properties that are left out when all of them are.
+class JSONWriter {
+public:
+    JSONWriter(QByteArray& output) : _output(output) {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    void beginGroup(const char* name);
+    void endGroup();
+
+    void key(const char* name);
+
+    void writeNull();
+    void write(bool value);
+    void write(int value);
+    void write(qint64 value);
+    void write(quint64 value);
+    void write(float value);
+    void write(double value);
+    void write(const char* value);
+    void write(const QString& value);
+
+    template <typename T> void writeMember(const char* name, const T& value) {
+        key(name);
+        write(value);
+    }
+
+private:
+    struct Level {
+        bool isObject;
+        bool isEmpty;
+        bool isPending; // a group nothing has been written in yet
+        const char* name;
+    };
+
+    void beginValue();
+    void openPendingGroups();
+    void beginLevel(bool isObject, char open);
+    void endLevel(char close);
+    void newLine(size_t depth);
+    void writeString(const char* value, int length);
+
+    QByteArray& _output;
+    std::vector<Level> _levels;
+    bool _hasKey { false };
+};
+
+#endif // hifi_JSONWriter_h
@@ -10,17 +10,141 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <qcoreapplication.h>
 
 #include <QDateTime>
 #include <QDebug>
 #include <QTimer>
 #include <QThread>
+#include <QThreadStorage>
 #include <QMutexLocker>
 #include <QRegExp>
 
 #include "LogHandler.h"
 
+// number of messages a thread can have queued before the log thread writes them out
+static const uint32_t NUM_THREAD_LOG_ENTRIES = 1024;
+// number of messages a thread can queue each second, the ones past it are dropped
+static const int MAX_THREAD_LOG_ENTRIES_PER_SECOND = 500;
+static const qint64 LOG_RATE_WINDOW_MSECS = 1000;
+static const std::chrono::milliseconds LOG_WRITE_INTERVAL { 50 };
+
+namespace {
+
+struct LogEntry {
+    LogMsgType type { LogDebug };
+    QString message;
+    qint64 timestamp { 0 };
+    size_t threadID { 0 };
+    quint64 sequence { 0 };
+};
+
+// written by its thread only, read by the log thread only
+struct ThreadLogQueue {
+    std::array<LogEntry, NUM_THREAD_LOG_ENTRIES> entries;
+    std::atomic<uint32_t> head { 0 };
+    std::atomic<uint32_t> tail { 0 };
+    std::atomic<quint64> numOverflowed { 0 };
+    std::atomic<quint64> numRateLimited { 0 };
+    std::atomic<bool> hasExited { false };
+
+    // the rate limit of the thread, only it touches these
+    qint64 rateWindowStart { 0 };
+    int numInRateWindow { 0 };
+};
+using ThreadLogQueuePointer = std::shared_ptr<ThreadLogQueue>;
+
+struct AsyncLog {
+    std::atomic<bool> isEnabled { false };
+    // the threads between checking isEnabled and having queued their message, turning it off waits for them
+    std::atomic<int> numQueueing { 0 };
+    std::atomic<quint64> nextSequence { 0 };
+
+    std::mutex queuesMutex;
+    std::vector<ThreadLogQueuePointer> queues;
+
+    // held while writing, so the log thread and a fatal message don't interleave their output
+    std::mutex writeMutex;
+
+    std::mutex threadMutex;
+    std::condition_variable threadCondition;
+    std::thread thread;
+    bool isRunning { false };
+};
+
+AsyncLog& asyncLog() {
+    // intentionally leaked so that it outlives the thread storage of threads torn down during shutdown
+    static AsyncLog* log = new AsyncLog;
+    return *log;
+}
+
+// the thread storage owns a reference, the log another one, so whatever is left is written after the thread is gone
+struct ThreadLogQueueHandle {
+    ThreadLogQueuePointer queue;
+
+    ~ThreadLogQueueHandle() { queue->hasExited = true; }
+};
+
+QThreadStorage<ThreadLogQueueHandle*> threadLogQueues;
+
+ThreadLogQueue& localLogQueue() {
+    if (!threadLogQueues.hasLocalData()) {
+        auto handle = new ThreadLogQueueHandle;
+        handle->queue = std::make_shared<ThreadLogQueue>();
+
+        auto& log = asyncLog();
+        {
+            std::lock_guard<std::mutex> lock(log.queuesMutex);
+            log.queues.push_back(handle->queue);
+        }
+        threadLogQueues.setLocalData(handle);
+    }
+    return *threadLogQueues.localData()->queue;
+}
+
+void queueMessage(LogMsgType type, const QString& message) {
+    auto& queue = localLogQueue();
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    if (now - queue.rateWindowStart >= LOG_RATE_WINDOW_MSECS) {
+        queue.rateWindowStart = now;
+        queue.numInRateWindow = 0;
+    }
+    if (queue.numInRateWindow >= MAX_THREAD_LOG_ENTRIES_PER_SECOND) {
+        queue.numRateLimited.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ++queue.numInRateWindow;
+
+    uint32_t head = queue.head.load(std::memory_order_relaxed);
+    uint32_t tail = queue.tail.load(std::memory_order_acquire);
+    if (head - tail >= NUM_THREAD_LOG_ENTRIES) {
+        queue.numOverflowed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // the message is implicitly shared, this copies a pointer
+    LogEntry& entry = queue.entries[head % NUM_THREAD_LOG_ENTRIES];
+    entry.type = type;
+    entry.message = message;
+    entry.timestamp = now;
+    entry.threadID = (size_t)QThread::currentThreadId();
+    entry.sequence = asyncLog().nextSequence.fetch_add(1, std::memory_order_relaxed);
+    queue.head.store(head + 1, std::memory_order_release);
+}
+
+}
+
 LogHandler& LogHandler::getInstance() {
     static LogHandler staticInstance;
     return staticInstance;
@@ -38,6 +162,10 @@ LogHandler::LogHandler()
     printf("%s\n", qPrintable(timezoneString));
 }
 
+LogHandler::~LogHandler() {
+    setShouldLogAsynchronously(false);
+}
+
 const char* stringForLogType(LogMsgType msgType) {
     switch (msgType) {
         case LogInfo:
@@ -81,11 +209,7 @@ void LogHandler::flushRepeatedMessages() {
     }
 }
 
-QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
-    if (message.isEmpty()) {
-        return QString();
-    }
-
+bool LogHandler::shouldPrintMessage(LogMsgType type, const QString& message) {
     if (type == LogDebug) {
         // for debug messages, check if this matches any of our regexes for repeated log messages
         QMutexLocker locker(&_repeatedMessageLock);
@@ -105,7 +229,7 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
                     _lastRepeatedMessage[regexString] = message;
 
                     // return out, we're not printing this one
-                    return QString();
+                    return false;
                 }
             }
         }
@@ -123,12 +247,16 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
                     break;
                 } else {
                     // We've already printed this message, don't print it again.
-                    return QString();
+                    return false;
                 }
             }
         }
     }
 
+    return true;
+}
+
+QString LogHandler::formatMessage(LogMsgType type, const QString& message, qint64 timestampMsecs, size_t threadID) const {
     // log prefix is in the following format
     // [TIMESTAMP] [DEBUG] [PID] [TID] [TARGET] logged string
 
@@ -137,16 +265,15 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
         dateFormatPtr = &DATE_STRING_FORMAT_WITH_MILLISECONDS;
     }
 
-    QString prefixString = QString("[%1]").arg(QDateTime::currentDateTime().toString(*dateFormatPtr));
+    QString prefixString = QString("[%1]").arg(QDateTime::fromMSecsSinceEpoch(timestampMsecs).toString(*dateFormatPtr));
 
     prefixString.append(QString(" [%1]").arg(stringForLogType(type)));
 
     if (_shouldOutputProcessID) {
-        prefixString.append(QString(" [%1]").arg(QCoreApplication::instance()->applicationPid()));
+        prefixString.append(QString(" [%1]").arg(QCoreApplication::applicationPid()));
     }
 
     if (_shouldOutputThreadID) {
-        size_t threadID = (size_t)QThread::currentThreadId();
         prefixString.append(QString(" [%1]").arg(threadID));
     }
 
@@ -154,12 +281,131 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
         prefixString.append(QString(" [%1]").arg(_targetName));
     }
 
-    QString logMessage = QString("%1 %2").arg(prefixString, message.split("\n").join("\n" + prefixString + " "));
+    return QString("%1 %2").arg(prefixString, message.split("\n").join("\n" + prefixString + " "));
+}
+
+QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
+    if (message.isEmpty() || !shouldPrintMessage(type, message)) {
+        return QString();
+    }
+
+    QString logMessage = formatMessage(type, message, QDateTime::currentMSecsSinceEpoch(),
+                                       (size_t)QThread::currentThreadId());
     fprintf(stdout, "%s\n", qPrintable(logMessage));
     return logMessage;
 }
 
+void LogHandler::writeQueuedMessages() {
+    auto& log = asyncLog();
+    std::lock_guard<std::mutex> writeLock(log.writeMutex);
+
+    std::vector<LogEntry> entries;
+    quint64 numOverflowed = 0;
+    quint64 numRateLimited = 0;
+    {
+        std::lock_guard<std::mutex> lock(log.queuesMutex);
+        for (auto it = log.queues.begin(); it != log.queues.end();) {
+            ThreadLogQueue& queue = **it;
+            bool hasExited = queue.hasExited;
+            uint32_t tail = queue.tail.load(std::memory_order_relaxed);
+            uint32_t head = queue.head.load(std::memory_order_acquire);
+
+            for (; tail != head; ++tail) {
+                entries.push_back(std::move(queue.entries[tail % NUM_THREAD_LOG_ENTRIES]));
+            }
+            queue.tail.store(tail, std::memory_order_release);
+            numOverflowed += queue.numOverflowed.exchange(0, std::memory_order_relaxed);
+            numRateLimited += queue.numRateLimited.exchange(0, std::memory_order_relaxed);
+
+            if (hasExited) {
+                // everything the thread logged was in before it exited
+                it = log.queues.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // each thread's messages are in order already, the sequence puts the threads' back in the order they were logged
+    std::sort(entries.begin(), entries.end(), [](const LogEntry& a, const LogEntry& b) {
+        return a.sequence < b.sequence;
+    });
+
+    for (const auto& entry : entries) {
+        if (shouldPrintMessage(entry.type, entry.message)) {
+            fprintf(stdout, "%s\n", qPrintable(formatMessage(entry.type, entry.message, entry.timestamp, entry.threadID)));
+        }
+    }
+
+    if (numOverflowed > 0 || numRateLimited > 0) {
+        QString droppedMessage = QString("Dropped %1 log entries - %2 over the rate limit of %3 per second per thread,"
+                                         " %4 logged faster than they could be written")
+            .arg(numOverflowed + numRateLimited).arg(numRateLimited).arg(MAX_THREAD_LOG_ENTRIES_PER_SECOND).arg(numOverflowed);
+        fprintf(stdout, "%s\n", qPrintable(formatMessage(LogSuppressed, droppedMessage, QDateTime::currentMSecsSinceEpoch(),
+                                                           (size_t)QThread::currentThreadId())));
+    }
+    fflush(stdout);
+}
+
+void LogHandler::setShouldLogAsynchronously(bool shouldLogAsynchronously) {
+    auto& log = asyncLog();
+    std::unique_lock<std::mutex> threadLock(log.threadMutex);
+    if (shouldLogAsynchronously == log.isRunning) {
+        return;
+    }
+
+    log.isRunning = shouldLogAsynchronously;
+    log.isEnabled = shouldLogAsynchronously;
+
+    if (shouldLogAsynchronously) {
+        log.thread = std::thread([this] {
+            auto& log = asyncLog();
+            std::unique_lock<std::mutex> threadLock(log.threadMutex);
+            while (log.isRunning) {
+                log.threadCondition.wait_for(threadLock, LOG_WRITE_INTERVAL);
+                threadLock.unlock();
+                writeQueuedMessages();
+                threadLock.lock();
+            }
+        });
+    } else {
+        threadLock.unlock();
+        log.threadCondition.notify_one();
+        log.thread.join();
+
+        // a thread that saw the switch still on may not be done queueing, its message goes out with the rest
+        while (log.numQueueing.load() > 0) {
+            std::this_thread::yield();
+        }
+
+        // what was queued before the switch
+        writeQueuedMessages();
+    }
+}
+
 void LogHandler::verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+    auto& log = asyncLog();
+
+    // counted before the switch is checked, so that turning it off either waits for this message or is seen here
+    log.numQueueing.fetch_add(1);
+    bool isAsynchronous = log.isEnabled.load();
+    bool isQueued = false;
+    if (isAsynchronous && type != QtFatalMsg) {
+        if (!message.isEmpty()) {
+            queueMessage((LogMsgType) type, message);
+        }
+        isQueued = true;
+    }
+    log.numQueueing.fetch_sub(1);
+
+    if (isQueued) {
+        return;
+    }
+
+    if (isAsynchronous) {
+        // the process aborts right after a fatal message, what led up to it goes out first
+        getInstance().writeQueuedMessages();
+    }
     getInstance().printMessage((LogMsgType) type, context, message);
 }
 
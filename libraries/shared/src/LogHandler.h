@@ -46,6 +46,11 @@ public:
 
     QString printMessage(LogMsgType type, const QMessageLogContext& context, const QString &message);
 
+    /// the messages of the verboseMessageHandler are queued by the thread that logs them and written by a log thread,
+    /// so logging never waits on the output. A thread that logs faster than its rate limit or faster than the log thread
+    /// keeps up drops the extra messages, the log thread reports how many. Turning it off writes out what is queued.
+    void setShouldLogAsynchronously(bool shouldLogAsynchronously);
+
     /// a qtMessageHandler that can be hooked up to a target that links to Qt
     /// prints various process, message type, and time information
     static void verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString &message);
@@ -54,9 +59,15 @@ public:
     const QString& addOnlyOnceMessageRegex(const QString& regexString);
 private:
     LogHandler();
+    ~LogHandler();
 
     void flushRepeatedMessages();
 
+    // false when the message is one of the repeated or only once messages and isn't to be printed now
+    bool shouldPrintMessage(LogMsgType type, const QString& message);
+    QString formatMessage(LogMsgType type, const QString& message, qint64 timestampMsecs, size_t threadID) const;
+    void writeQueuedMessages();
+
     QString _targetName;
     bool _shouldOutputProcessID { false };
     bool _shouldOutputThreadID { false };
@@ -0,0 +1,278 @@
+//
+//  Metrics.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QMap>
+#include <QtCore/QRegExp>
+
+static const QString JSON_KEY_TYPE = "type";
+static const QString JSON_KEY_HELP = "help";
+static const QString JSON_KEY_VALUE = "value";
+static const QString JSON_KEY_BOUNDS = "bounds";
+static const QString JSON_KEY_COUNTS = "counts";
+static const QString JSON_KEY_SUM = "sum";
+
+static const QString TYPE_NAME_COUNTER = "counter";
+static const QString TYPE_NAME_GAUGE = "gauge";
+static const QString TYPE_NAME_HISTOGRAM = "histogram";
+
+namespace {
+
+struct MetricsRegistry {
+    std::mutex mutex;
+    QHash<QString, Metric*> metrics;
+};
+
+MetricsRegistry& metricsRegistry() {
+    // intentionally leaked along with the metrics, so that a reference to one is good until the process is gone
+    static MetricsRegistry* registry = new MetricsRegistry;
+    return *registry;
+}
+
+bool isValidName(const QString& name) {
+    return QRegExp("[a-zA-Z_:][a-zA-Z0-9_:]*").exactMatch(name);
+}
+
+// the metric of that name and type, made by makeMetric if there is none yet
+template <typename T, typename F>
+T& findOrMakeMetric(const QString& name, Metric::Type type, F makeMetric) {
+    Q_ASSERT(isValidName(name));
+
+    auto& registry = metricsRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    Metric* metric = registry.metrics.value(name);
+    if (!metric) {
+        metric = makeMetric();
+        registry.metrics.insert(name, metric);
+    }
+    Q_ASSERT(metric->getType() == type);
+    return *static_cast<T*>(metric);
+}
+
+QByteArray formatValue(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    } else if (std::isinf(value)) {
+        return value > 0.0 ? "+Inf" : "-Inf";
+    }
+    // counts are whole, and are written that way for as long as a double holds them exactly
+    const double MAX_EXACT_INTEGER = 9007199254740992.0;
+    if (value == std::floor(value) && std::abs(value) < MAX_EXACT_INTEGER) {
+        return QByteArray::number((qint64)value);
+    }
+    return QByteArray::number(value, 'g', 15);
+}
+
+QByteArray escapeLabelValue(const QString& value) {
+    QString escaped = value;
+    escaped.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
+    return escaped.toUtf8();
+}
+
+QByteArray escapeHelp(const QString& help) {
+    QString escaped = help;
+    escaped.replace('\\', "\\\\").replace('\n', "\\n");
+    return escaped.toUtf8();
+}
+
+// name{labels} value, where labels are already escaped and extraLabel is added after them when it is given
+void appendSample(QByteArray& samples, const QString& name, const QByteArray& labels, const QByteArray& extraLabel,
+                  double value) {
+    samples += name.toUtf8();
+    if (!labels.isEmpty() || !extraLabel.isEmpty()) {
+        samples += '{';
+        samples += labels;
+        if (!labels.isEmpty() && !extraLabel.isEmpty()) {
+            samples += ',';
+        }
+        samples += extraLabel;
+        samples += '}';
+    }
+    samples += ' ';
+    samples += formatValue(value);
+    samples += '\n';
+}
+
+struct MetricFamily {
+    QString type;
+    QString help;
+    QByteArray samples;
+};
+
+}
+
+QJsonObject MetricsCounter::toJson() const {
+    QJsonObject object;
+    object[JSON_KEY_TYPE] = TYPE_NAME_COUNTER;
+    object[JSON_KEY_HELP] = getHelp();
+    object[JSON_KEY_VALUE] = (double)get();
+    return object;
+}
+
+QJsonObject MetricsGauge::toJson() const {
+    QJsonObject object;
+    object[JSON_KEY_TYPE] = TYPE_NAME_GAUGE;
+    object[JSON_KEY_HELP] = getHelp();
+    object[JSON_KEY_VALUE] = get();
+    return object;
+}
+
+MetricsHistogram::MetricsHistogram(const QString& help, const std::vector<double>& bounds) :
+    Metric(HistogramType, help),
+    _bounds(bounds),
+    _counts(new std::atomic<uint64_t>[bounds.size() + 1]),
+    _sum(0.0)
+{
+    Q_ASSERT(std::is_sorted(_bounds.begin(), _bounds.end()));
+    for (size_t i = 0; i <= _bounds.size(); ++i) {
+        _counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricsHistogram::observe(double value) {
+    size_t index = std::lower_bound(_bounds.begin(), _bounds.end(), value) - _bounds.begin();
+    _counts[index].fetch_add(1, std::memory_order_relaxed);
+
+    double sum = _sum.load(std::memory_order_relaxed);
+    while (!_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t MetricsHistogram::getCount() const {
+    uint64_t count = 0;
+    for (size_t i = 0; i <= _bounds.size(); ++i) {
+        count += _counts[i].load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+QJsonObject MetricsHistogram::toJson() const {
+    QJsonArray bounds;
+    QJsonArray counts;
+    uint64_t count = 0;
+    // the counts go out the way Prometheus has them, each with the values at or below its bound, the last with all
+    for (size_t i = 0; i <= _bounds.size(); ++i) {
+        if (i < _bounds.size()) {
+            bounds.append(_bounds[i]);
+        }
+        count += _counts[i].load(std::memory_order_relaxed);
+        counts.append((double)count);
+    }
+
+    QJsonObject object;
+    object[JSON_KEY_TYPE] = TYPE_NAME_HISTOGRAM;
+    object[JSON_KEY_HELP] = getHelp();
+    object[JSON_KEY_BOUNDS] = bounds;
+    object[JSON_KEY_COUNTS] = counts;
+    object[JSON_KEY_SUM] = getSum();
+    return object;
+}
+
+MetricsCounter& Metrics::counter(const QString& name, const QString& help) {
+    return findOrMakeMetric<MetricsCounter>(name, Metric::CounterType, [&] { return new MetricsCounter(help); });
+}
+
+MetricsGauge& Metrics::gauge(const QString& name, const QString& help) {
+    return findOrMakeMetric<MetricsGauge>(name, Metric::GaugeType, [&] { return new MetricsGauge(help); });
+}
+
+MetricsHistogram& Metrics::histogram(const QString& name, const QString& help, const std::vector<double>& bounds) {
+    auto& histogram = findOrMakeMetric<MetricsHistogram>(name, Metric::HistogramType, [&] {
+        return new MetricsHistogram(help, bounds);
+    });
+    Q_ASSERT(histogram.getBounds() == bounds);
+    return histogram;
+}
+
+std::vector<double> Metrics::secondsBounds() {
+    return { 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0 };
+}
+
+QJsonObject Metrics::toJson() {
+    auto& registry = metricsRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    QJsonObject object;
+    for (auto it = registry.metrics.constBegin(); it != registry.metrics.constEnd(); ++it) {
+        object[it.key()] = it.value()->toJson();
+    }
+    return object;
+}
+
+QByteArray Metrics::toPrometheusText(const QList<Source>& sources) {
+    // the samples of a family have to be together, so they are gathered from all of the sources before any goes out
+    QMap<QString, MetricFamily> families;
+
+    for (const auto& source : sources) {
+        QByteArray labels;
+        for (const auto& label : source.labels) {
+            if (!labels.isEmpty()) {
+                labels += ',';
+            }
+            labels += label.first.toUtf8() + "=\"" + escapeLabelValue(label.second) + '"';
+        }
+
+        for (auto it = source.metrics.constBegin(); it != source.metrics.constEnd(); ++it) {
+            // the metrics of the other processes come in over the network, so nothing unexpected goes into the text
+            const QString& name = it.key();
+            QJsonObject metric = it.value().toObject();
+            QString type = metric[JSON_KEY_TYPE].toString();
+            if (!isValidName(name)
+                || (type != TYPE_NAME_COUNTER && type != TYPE_NAME_GAUGE && type != TYPE_NAME_HISTOGRAM)) {
+                continue;
+            }
+
+            auto familyIt = families.find(name);
+            if (familyIt == families.end()) {
+                familyIt = families.insert(name, MetricFamily { type, metric[JSON_KEY_HELP].toString(), QByteArray() });
+            } else if (familyIt->type != type) {
+                // a source that has another type for the name can't be in the same family, leave it out
+                continue;
+            }
+            QByteArray& samples = familyIt->samples;
+
+            if (type == TYPE_NAME_HISTOGRAM) {
+                QJsonArray bounds = metric[JSON_KEY_BOUNDS].toArray();
+                QJsonArray counts = metric[JSON_KEY_COUNTS].toArray();
+                if (counts.size() != bounds.size() + 1) {
+                    continue;
+                }
+                for (int i = 0; i < counts.size(); ++i) {
+                    double bound = i < bounds.size() ? bounds[i].toDouble() : INFINITY;
+                    appendSample(samples, name + "_bucket", labels, "le=\"" + formatValue(bound) + '"',
+                                 counts[i].toDouble());
+                }
+                appendSample(samples, name + "_sum", labels, QByteArray(), metric[JSON_KEY_SUM].toDouble());
+                appendSample(samples, name + "_count", labels, QByteArray(), counts.last().toDouble());
+            } else {
+                appendSample(samples, name, labels, QByteArray(), metric[JSON_KEY_VALUE].toDouble());
+            }
+        }
+    }
+
+    QByteArray text;
+    for (auto it = families.constBegin(); it != families.constEnd(); ++it) {
+        if (it->samples.isEmpty()) {
+            continue;
+        }
+        text += "# HELP " + it.key().toUtf8() + ' ' + escapeHelp(it->help) + '\n';
+        text += "# TYPE " + it.key().toUtf8() + ' ' + it->type.toUtf8() + '\n';
+        text += it->samples;
+    }
+    return text;
+}
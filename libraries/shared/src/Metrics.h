@@ -0,0 +1,135 @@
+//
+//  Metrics.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_Metrics_h
+#define hifi_Metrics_h
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+
+#include "ShardedCounter.h"
+
+// Counters, gauges and histograms of a process, for the servers to be watched and alerted on over time.
+// A metric is made once, by name, and its reference kept by whatever updates it:
+//
+//     _frameOverruns(Metrics::counter("hifi_audio_mixer_frame_overruns_total", "Frames that took longer than theirs"))
+//
+// Updating one takes no lock, so they can go in the frames of the mixers and the send threads. Making one takes a
+// lock, it belongs in a constructor and not a loop.
+//
+// The assignment clients send the JSON of their metrics to the domain-server with the rest of their stats, and it
+// puts those of all of the nodes out together in the Prometheus text format, with a label for each assignment.
+class Metric {
+public:
+    enum Type {
+        CounterType,
+        GaugeType,
+        HistogramType
+    };
+
+    Metric(Type type, const QString& help) : _type(type), _help(help) {}
+    virtual ~Metric() {}
+
+    Type getType() const { return _type; }
+    const QString& getHelp() const { return _help; }
+
+    virtual QJsonObject toJson() const = 0;
+
+private:
+    Metric(const Metric&) = delete;
+    Metric& operator=(const Metric&) = delete;
+
+    Type _type;
+    QString _help;
+};
+
+// A count that only goes up, like the frames mixed or the bytes sent
+class MetricsCounter : public Metric {
+public:
+    MetricsCounter(const QString& help) : Metric(CounterType, help) {}
+
+    void add(uint64_t amount = 1) { _count.add(amount); }
+    uint64_t get() const { return _count.get(); }
+
+    QJsonObject toJson() const override;
+
+private:
+    ShardedCounter _count;
+};
+
+// A value that goes up and down, like the number of listeners, set to what it is whenever it is known
+class MetricsGauge : public Metric {
+public:
+    MetricsGauge(const QString& help) : Metric(GaugeType, help), _value(0.0) {}
+
+    void set(double value) { _value.store(value, std::memory_order_relaxed); }
+    double get() const { return _value.load(std::memory_order_relaxed); }
+
+    QJsonObject toJson() const override;
+
+private:
+    std::atomic<double> _value;
+};
+
+// How many values fell in each of a set of buckets, like the time taken by each frame. A value goes in the first
+// bucket with a bound at least as large, or in the one past the last bound.
+class MetricsHistogram : public Metric {
+public:
+    MetricsHistogram(const QString& help, const std::vector<double>& bounds);
+
+    void observe(double value);
+
+    const std::vector<double>& getBounds() const { return _bounds; }
+    uint64_t getCount() const;
+    double getSum() const { return _sum.load(std::memory_order_relaxed); }
+
+    QJsonObject toJson() const override;
+
+private:
+    std::vector<double> _bounds; // in increasing order
+    std::unique_ptr<std::atomic<uint64_t>[]> _counts; // one for each bound, and one for the values past the last
+    std::atomic<double> _sum;
+};
+
+class Metrics {
+public:
+    // The labels that tell the samples of one process apart from those of the others, and the JSON of its metrics
+    struct Source {
+        QList<QPair<QString, QString>> labels;
+        QJsonObject metrics;
+    };
+
+    // The metric is made the first time its name is asked for, and lives as long as the process. The name has to be
+    // a valid Prometheus name, and can't be asked for again as another type of metric or with other bounds.
+    static MetricsCounter& counter(const QString& name, const QString& help);
+    static MetricsGauge& gauge(const QString& name, const QString& help);
+    static MetricsHistogram& histogram(const QString& name, const QString& help, const std::vector<double>& bounds);
+
+    // the bounds of a histogram of seconds, from a tenth of a millisecond to a second
+    static std::vector<double> secondsBounds();
+
+    // The values of all of the metrics of this process, by name
+    static QJsonObject toJson();
+
+    // The text exposition format of Prometheus, with the metrics of every source, each family of samples once
+    static QByteArray toPrometheusText(const QList<Source>& sources);
+};
+
+#endif // hifi_Metrics_h
@@ -0,0 +1,91 @@
+//
+//  ParallelFor.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QWaitCondition>
+
+namespace {
+
+struct ParallelForState {
+    ParallelForState(int count, const std::function<void(int)>& function) : count(count), function(function) {}
+
+    void runJobs() {
+        int index;
+        while ((index = nextIndex++) < count) {
+            function(index);
+        }
+    }
+
+    const int count;
+    const std::function<void(int)> function;
+    std::atomic<int> nextIndex { 0 };
+
+    QMutex mutex;
+    QWaitCondition finished;
+    int numActiveJobs { 0 };
+};
+
+// the state is shared since a job may only get a thread after the loop it was started for has returned,
+// it will find no indices left and exit
+class ParallelForJob : public QRunnable {
+public:
+    ParallelForJob(const std::shared_ptr<ParallelForState>& state) : _state(state) {}
+
+    void run() override {
+        {
+            QMutexLocker lock(&_state->mutex);
+            ++_state->numActiveJobs;
+        }
+
+        _state->runJobs();
+
+        QMutexLocker lock(&_state->mutex);
+        if (--_state->numActiveJobs == 0) {
+            _state->finished.wakeAll();
+        }
+    }
+
+private:
+    std::shared_ptr<ParallelForState> _state;
+};
+
+}
+
+void parallelFor(int count, const std::function<void(int)>& function, QThreadPool* pool) {
+    int numJobs = std::min(count, pool->maxThreadCount()) - 1;
+    if (numJobs <= 0) {
+        for (int i = 0; i < count; ++i) {
+            function(i);
+        }
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>(count, function);
+    for (int i = 0; i < numJobs; ++i) {
+        pool->start(new ParallelForJob(state));
+    }
+
+    state->runJobs();
+
+    // every index has been taken, wait for the jobs still running one
+    // a job that starts from here on takes no index so it can be left behind
+    QMutexLocker lock(&state->mutex);
+    while (state->numActiveJobs > 0) {
+        state->finished.wait(&state->mutex);
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  ParallelFor.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ParallelFor_h
+#define hifi_ParallelFor_h
+
+#include <functional>
+
+#include <QtCore/QThreadPool>
+
+// Calls function once for every index in [0, count) and returns when all of the calls are done.
+// The calling thread takes indices along with up to maxThreadCount - 1 jobs on pool, so this never waits
+// on a pool that is busy with other work, it just has less help.
+void parallelFor(int count, const std::function<void(int)>& function,
+                 QThreadPool* pool = QThreadPool::globalInstance());
+
+#endif // hifi_ParallelFor_h
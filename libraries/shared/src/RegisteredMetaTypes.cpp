@@ -33,6 +33,18 @@ int pickRayMetaTypeId = qRegisterMetaType<PickRay>();
 int collisionMetaTypeId = qRegisterMetaType<Collision>();
 int qMapURLStringMetaTypeId = qRegisterMetaType<QMap<QUrl,QString>>();
 
+// The names of the components, made once: a QString from a literal is allocated and decoded each time it's made
+static const QString X_NAME("x");
+static const QString Y_NAME("y");
+static const QString Z_NAME("z");
+static const QString W_NAME("w");
+
+// Most components a script hands over are numbers already, those don't need to go through a QVariant
+static float componentFromScriptValue(const QScriptValue& object, const QString& name) {
+    QScriptValue component = object.property(name);
+    return component.isNumber() ? (float)component.toNumber() : component.toVariant().toFloat();
+}
+
 void registerMetaTypes(QScriptEngine* engine) {
     qScriptRegisterMetaType(engine, mat4toScriptValue, mat4FromScriptValue);
     qScriptRegisterMetaType(engine, vec4toScriptValue, vec4FromScriptValue);
@@ -96,18 +108,18 @@ void mat4FromScriptValue(const QScriptValue& object, glm::mat4& mat4) {
 
 QScriptValue vec4toScriptValue(QScriptEngine* engine, const glm::vec4& vec4) {
     QScriptValue obj = engine->newObject();
-    obj.setProperty("x", vec4.x);
-    obj.setProperty("y", vec4.y);
-    obj.setProperty("z", vec4.z);
-    obj.setProperty("w", vec4.w);
+    obj.setProperty(X_NAME, vec4.x);
+    obj.setProperty(Y_NAME, vec4.y);
+    obj.setProperty(Z_NAME, vec4.z);
+    obj.setProperty(W_NAME, vec4.w);
     return obj;
 }
 
 void vec4FromScriptValue(const QScriptValue& object, glm::vec4& vec4) {
-    vec4.x = object.property("x").toVariant().toFloat();
-    vec4.y = object.property("y").toVariant().toFloat();
-    vec4.z = object.property("z").toVariant().toFloat();
-    vec4.w = object.property("w").toVariant().toFloat();
+    vec4.x = componentFromScriptValue(object, X_NAME);
+    vec4.y = componentFromScriptValue(object, Y_NAME);
+    vec4.z = componentFromScriptValue(object, Z_NAME);
+    vec4.w = componentFromScriptValue(object, W_NAME);
 }
 
 QScriptValue vec3toScriptValue(QScriptEngine* engine, const glm::vec3 &vec3) {
@@ -116,16 +128,16 @@ QScriptValue vec3toScriptValue(QScriptEngine* engine, const glm::vec3 &vec3) {
         // if vec3 contains a NaN don't try to convert it
         return obj;
     }
-    obj.setProperty("x", vec3.x);
-    obj.setProperty("y", vec3.y);
-    obj.setProperty("z", vec3.z);
+    obj.setProperty(X_NAME, vec3.x);
+    obj.setProperty(Y_NAME, vec3.y);
+    obj.setProperty(Z_NAME, vec3.z);
     return obj;
 }
 
 void vec3FromScriptValue(const QScriptValue &object, glm::vec3 &vec3) {
-    vec3.x = object.property("x").toVariant().toFloat();
-    vec3.y = object.property("y").toVariant().toFloat();
-    vec3.z = object.property("z").toVariant().toFloat();
+    vec3.x = componentFromScriptValue(object, X_NAME);
+    vec3.y = componentFromScriptValue(object, Y_NAME);
+    vec3.z = componentFromScriptValue(object, Z_NAME);
 }
 
 QVariant vec3toVariant(const glm::vec3& vec3) {
@@ -249,18 +261,18 @@ QScriptValue quatToScriptValue(QScriptEngine* engine, const glm::quat& quat) {
         // if quat contains a NaN don't try to convert it
         return obj;
     }
-    obj.setProperty("x", quat.x);
-    obj.setProperty("y", quat.y);
-    obj.setProperty("z", quat.z);
-    obj.setProperty("w", quat.w);
+    obj.setProperty(X_NAME, quat.x);
+    obj.setProperty(Y_NAME, quat.y);
+    obj.setProperty(Z_NAME, quat.z);
+    obj.setProperty(W_NAME, quat.w);
     return obj;
 }
 
 void quatFromScriptValue(const QScriptValue& object, glm::quat &quat) {
-    quat.x = object.property("x").toVariant().toFloat();
-    quat.y = object.property("y").toVariant().toFloat();
-    quat.z = object.property("z").toVariant().toFloat();
-    quat.w = object.property("w").toVariant().toFloat();
+    quat.x = componentFromScriptValue(object, X_NAME);
+    quat.y = componentFromScriptValue(object, Y_NAME);
+    quat.z = componentFromScriptValue(object, Z_NAME);
+    quat.w = componentFromScriptValue(object, W_NAME);
 }
 
 glm::quat quatFromVariant(const QVariant &object, bool& isValid) {
@@ -440,14 +452,14 @@ void qVectorBoolFromScriptValue(const QScriptValue& array, QVector<bool>& vector
 
 QScriptValue vec2toScriptValue(QScriptEngine* engine, const glm::vec2 &vec2) {
     QScriptValue obj = engine->newObject();
-    obj.setProperty("x", vec2.x);
-    obj.setProperty("y", vec2.y);
+    obj.setProperty(X_NAME, vec2.x);
+    obj.setProperty(Y_NAME, vec2.y);
     return obj;
 }
 
 void vec2FromScriptValue(const QScriptValue &object, glm::vec2 &vec2) {
-    vec2.x = object.property("x").toVariant().toFloat();
-    vec2.y = object.property("y").toVariant().toFloat();
+    vec2.x = componentFromScriptValue(object, X_NAME);
+    vec2.y = componentFromScriptValue(object, Y_NAME);
 }
 
 QVariant vec2toVariant(const glm::vec2 &vec2) {
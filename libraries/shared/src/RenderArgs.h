@@ -50,8 +50,18 @@ public:
         int _rendered = 0;
     };
 
+    // the full mesh and the levels simplified from it
+    static const int MAX_MESH_LODS = 4;
+
+    RenderDetails() {
+        for (int i = 0; i < MAX_MESH_LODS; ++i) {
+            _lodTrianglesRendered[i] = 0;
+        }
+    }
+
     int _materialSwitches = 0;
     int _trianglesRendered = 0;
+    int _lodTrianglesRendered[MAX_MESH_LODS]; // the share of _trianglesRendered drawn by model parts at each LOD
 
     Item _item;
     Item _shadow;
@@ -34,6 +34,7 @@ Settings::~Settings() {
 void Settings::remove(const QString& key) {
     if (key == "" || _manager->contains(key)) {
         _manager->remove(key);
+        _manager->forgetValues(key);
     }
 }
 
@@ -85,6 +86,7 @@ void Settings::endGroup() {
 void Settings::setValue(const QString& name, const QVariant& value) {
     if (_manager->value(name) != value) {
         _manager->setValue(name, value);
+        _manager->cacheValue(name, value);
     }
 }
 
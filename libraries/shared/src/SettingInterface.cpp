@@ -14,6 +14,7 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
 #include <QThread>
 
 #include "PathUtils.h"
@@ -61,6 +62,17 @@ namespace Setting {
             bool deleted = settingsLockFile.remove();
             qCDebug(shared) << (deleted ? "Deleted" : "Failed to delete") << "settings lock file" << settingsLockFilename;
         }
+
+        // A crash while the settings were written out can leave them empty or cut short, in which case go back to
+        // the copy of the last time they were written out whole.
+        QFileInfo settingsInfo(settings.fileName());
+        QString backupFilename = settings.fileName() + Manager::BACKUP_EXTENSION;
+        bool isDamaged = settings.status() == QSettings::FormatError || (settingsInfo.exists() && settingsInfo.size() == 0);
+        if (isDamaged && QFileInfo(backupFilename).size() > 0) {
+            QFile::remove(settings.fileName());
+            bool restored = QFile::copy(backupFilename, settings.fileName());
+            qCDebug(shared) << (restored ? "Restored" : "Failed to restore") << "settings file from" << backupFilename;
+        }
     }
     
     // Sets up the settings private instance. Should only be run once at startup. preInit() must be run beforehand,
@@ -11,6 +11,8 @@
 
 #include <QtCore/QThread>
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
 #include <QtCore/QUuid>
 
 #include "SettingInterface.h"
@@ -18,6 +20,14 @@
 
 namespace Setting {
 
+    const QString Manager::BACKUP_EXTENSION { ".bak" };
+
+    Manager::Manager() {
+        for (const auto& key : allKeys()) {
+            _values.insert(key, value(key));
+        }
+    }
+
     Manager::~Manager() {
         // Cleanup timer
         stopTimer();
@@ -51,17 +61,13 @@ namespace Setting {
 
     void Manager::loadSetting(Interface* handle) {
         const auto& key = handle->getKey();
-        withWriteLock([&] {
-            QVariant loadedValue;
-            if (_pendingChanges.contains(key) && _pendingChanges[key] != UNSET_VALUE) {
-                loadedValue = _pendingChanges[key];
-            } else {
-                loadedValue = value(key);
-            }
-            if (loadedValue.isValid()) {
-                handle->setVariant(loadedValue);
-            }
+        QVariant loadedValue;
+        withReadLock([&] {
+            loadedValue = _values.value(key);
         });
+        if (loadedValue.isValid()) {
+            handle->setVariant(loadedValue);
+        }
     }
 
 
@@ -73,10 +79,49 @@ namespace Setting {
         }
 
         withWriteLock([&] {
+            // repeated saves of a key before the next write out only leave the last value to write
             _pendingChanges[key] = handleValue;
+            if (handleValue == UNSET_VALUE) {
+                _values.remove(key);
+            } else {
+                _values[key] = handleValue;
+            }
+        });
+    }
+
+    void Manager::cacheValue(const QString& key, const QVariant& value) {
+        withWriteLock([&] {
+            _values[groupKey(key)] = value;
         });
     }
 
+    void Manager::forgetValues(const QString& key) {
+        withWriteLock([&] {
+            // like QSettings::remove, an empty key is the whole of the current group
+            QString fullKey = groupKey(key);
+            if (fullKey.isEmpty()) {
+                _values.clear();
+                return;
+            }
+            QString childPrefix = fullKey + "/";
+            for (auto it = _values.begin(); it != _values.end();) {
+                if (it.key() == fullKey || it.key().startsWith(childPrefix)) {
+                    it = _values.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        });
+    }
+
+    QString Manager::groupKey(const QString& key) const {
+        QString prefix = group();
+        if (prefix.isEmpty()) {
+            return key;
+        }
+        return key.isEmpty() ? prefix : prefix + "/" + key;
+    }
+
     static const int SAVE_INTERVAL_MSEC = 5 * 1000; // 5 sec
     void Manager::startTimer() {
         if (!_saveTimer) {
@@ -97,6 +142,7 @@ namespace Setting {
 
     void Manager::saveAll() {
         bool forceSync = false;
+        // QSettings only holds the changes in memory until it syncs, so the lock is not held while the file is written
         withWriteLock([&] {
             for (auto key : _pendingChanges.keys()) {
                 auto newValue = _pendingChanges[key];
@@ -117,6 +163,9 @@ namespace Setting {
 
         if (forceSync) {
             sync();
+            if (status() == QSettings::NoError) {
+                backupSettingsFile();
+            }
         }
 
         // Restart timer
@@ -124,4 +173,21 @@ namespace Setting {
             _saveTimer->start();
         }
     }
+
+    void Manager::backupSettingsFile() {
+        QFile settingsFile(fileName());
+        if (!settingsFile.open(QIODevice::ReadOnly)) {
+            return;
+        }
+        QByteArray contents = settingsFile.readAll();
+        if (contents.isEmpty()) {
+            return;
+        }
+
+        // the backup replaces the last one in a single rename, so there is always one that is whole
+        QSaveFile backupFile(fileName() + BACKUP_EXTENSION);
+        if (!backupFile.open(QIODevice::WriteOnly) || backupFile.write(contents) != contents.size() || !backupFile.commit()) {
+            qWarning() << "Setting::Manager::backupSettingsFile(): Failed to write" << backupFile.fileName();
+        }
+    }
 }
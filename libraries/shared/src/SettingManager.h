@@ -20,13 +20,22 @@
 #include "DependencyManager.h"
 #include "shared/ReadWriteLockable.h"
 
+class Settings;
+
 namespace Setting {
     class Interface;
 
+    // The handles read and write an in-memory copy of the settings. Their changes are collected, one per key, and
+    // written out together from the settings thread, so that the threads using them never wait on the settings file.
     class Manager : public QSettings, public ReadWriteLockable, public Dependency {
         Q_OBJECT
 
     public:
+        // a copy of the settings file as of the last time it was written out whole, to recover from a crash while it is
+        static const QString BACKUP_EXTENSION;
+
+        Manager();
+
         void customDeleter() override;
 
     protected:
@@ -37,6 +46,10 @@ namespace Setting {
         void loadSetting(Interface* handle);
         void saveSetting(Interface* handle);
 
+        // keeps the in-memory copy up to date with what Settings writes to the QSettings straight
+        void cacheValue(const QString& key, const QVariant& value);
+        void forgetValues(const QString& key);
+
     private slots:
         void startTimer();
         void stopTimer();
@@ -44,12 +57,17 @@ namespace Setting {
         void saveAll();
 
     private:
+        QString groupKey(const QString& key) const;
+        void backupSettingsFile();
+
         QHash<QString, Interface*> _handles;
         QPointer<QTimer> _saveTimer = nullptr;
         const QVariant UNSET_VALUE { QUuid::createUuid() };
         QHash<QString, QVariant> _pendingChanges;
+        QHash<QString, QVariant> _values;
 
         friend class Interface;
+        friend class ::Settings;
         friend void cleanupPrivateInstance();
         friend void setupPrivateInstance();
     };
@@ -66,6 +66,7 @@ public:
     void setOffset(const glm::vec3& offset);
 
     int getType() const { return _type; }
+    const QUrl& getUrl() const { return _url; }
 
     const glm::vec3& getHalfExtents() const { return _halfExtents; }
     const glm::vec3& getOffset() const { return _offset; }
@@ -0,0 +1,46 @@
+//
+//  ShardedCounter.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShardedCounter.h"
+
+#include <functional>
+#include <new>
+#include <thread>
+
+ShardedCounter::ShardedCounter() :
+    _shardStorage(new char[NUM_SHARDS * sizeof(Shard) + CACHE_LINE_SIZE])
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(_shardStorage.get());
+    uintptr_t alignedAddress = (address + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1);
+    _shards = reinterpret_cast<Shard*>(alignedAddress);
+
+    for (int i = 0; i < NUM_SHARDS; ++i) {
+        new (&_shards[i]) Shard;
+        _shards[i].value.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t ShardedCounter::get() const {
+    uint64_t sum = 0;
+    for (int i = 0; i < NUM_SHARDS; ++i) {
+        sum += _shards[i].value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+int ShardedCounter::getShardIndex() {
+    // the hash of a thread ID can be the ID itself, mix its bits so that the low ones differ from thread to thread
+    uint64_t hash = (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (int)(hash % NUM_SHARDS);
+}
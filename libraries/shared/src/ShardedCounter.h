@@ -0,0 +1,53 @@
+//
+//  ShardedCounter.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ShardedCounter_h
+#define hifi_ShardedCounter_h
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+
+// A count that any number of threads add to at once, without a lock. Each thread adds to one of a few shards picked
+// by its ID, each on a cache line of its own, so that threads on different cores rarely write to the same line, and a
+// read adds the shards up. The shards are kept in a block of their own aligned to the cache lines, since the objects
+// that hold a counter have no such alignment. It is for counts that are added to far more often than they are read, like the packets and
+// bytes of a connection, counted on the network threads and read by the stats once in a while.
+class ShardedCounter {
+public:
+    ShardedCounter();
+
+    void add(uint64_t amount) { _shards[getShardIndex()].value.fetch_add(amount, std::memory_order_relaxed); }
+
+    // the sum of everything added so far, a thread adding at the same time may or may not be in it yet
+    uint64_t get() const;
+
+private:
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    static const int NUM_SHARDS = 8;
+    static const int CACHE_LINE_SIZE = 64;
+
+    struct Shard {
+        std::atomic<uint64_t> value;
+        char padding[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)];
+    };
+
+    static int getShardIndex();
+
+    std::unique_ptr<char[]> _shardStorage; // one line more than the shards need, to align them in
+    Shard* _shards;
+};
+
+#endif // hifi_ShardedCounter_h
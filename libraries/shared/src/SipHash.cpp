@@ -0,0 +1,138 @@
+//
+//  SipHash.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SipHash.h"
+
+#include <assert.h>
+
+static const int COMPRESSION_ROUNDS = 2;
+static const int FINALIZATION_ROUNDS = 4;
+
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t readLittleEndian64(const uint8_t* bytes) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static inline void writeLittleEndian64(uint64_t value, uint8_t* bytes) {
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static inline void sipRound(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) {
+    v0 += v1;
+    v1 = rotateLeft(v1, 13);
+    v1 ^= v0;
+    v0 = rotateLeft(v0, 32);
+    v2 += v3;
+    v3 = rotateLeft(v3, 16);
+    v3 ^= v2;
+    v0 += v3;
+    v3 = rotateLeft(v3, 21);
+    v3 ^= v0;
+    v2 += v1;
+    v1 = rotateLeft(v1, 17);
+    v1 ^= v2;
+    v2 = rotateLeft(v2, 32);
+}
+
+SipHash::SipHash(const uint8_t* key, Output output) :
+    SipHash(readLittleEndian64(key), readLittleEndian64(key + 8), output)
+{
+}
+
+SipHash::SipHash(uint64_t k0, uint64_t k1, Output output) :
+    _k0(k0),
+    _k1(k1),
+    _output(output)
+{
+    reset();
+}
+
+void SipHash::reset() {
+    _v0 = _k0 ^ 0x736f6d6570736575ULL;
+    _v1 = _k1 ^ 0x646f72616e646f6dULL;
+    _v2 = _k0 ^ 0x6c7967656e657261ULL;
+    _v3 = _k1 ^ 0x7465646279746573ULL;
+    if (_output == Output128) {
+        _v1 ^= 0xee;
+    }
+    _tail = 0;
+    _tailSize = 0;
+    _length = 0;
+}
+
+void SipHash::addData(const char* data, int length) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    const uint8_t* end = bytes + length;
+    _length += length;
+
+    // top up the word left over from the last call first
+    while (_tailSize > 0 && bytes < end) {
+        _tail |= (uint64_t)*bytes++ << (8 * _tailSize);
+        if (++_tailSize == 8) {
+            compress(_tail);
+            _tail = 0;
+            _tailSize = 0;
+        }
+    }
+
+    for (; end - bytes >= 8; bytes += 8) {
+        compress(readLittleEndian64(bytes));
+    }
+
+    for (; bytes < end; bytes++) {
+        _tail |= (uint64_t)*bytes << (8 * _tailSize++);
+    }
+}
+
+uint64_t SipHash::result() {
+    assert(_output == Output64);
+    finish();
+    _v2 ^= 0xff;
+    return finalize();
+}
+
+void SipHash::result128(uint8_t* result) {
+    assert(_output == Output128);
+    finish();
+    _v2 ^= 0xee;
+    writeLittleEndian64(finalize(), result);
+    _v1 ^= 0xdd;
+    writeLittleEndian64(finalize(), result + 8);
+}
+
+void SipHash::compress(uint64_t word) {
+    _v3 ^= word;
+    for (int i = 0; i < COMPRESSION_ROUNDS; i++) {
+        sipRound(_v0, _v1, _v2, _v3);
+    }
+    _v0 ^= word;
+}
+
+void SipHash::finish() {
+    // the last word has the low byte of the length at the top
+    compress(_tail | (_length << 56));
+}
+
+uint64_t SipHash::finalize() {
+    for (int i = 0; i < FINALIZATION_ROUNDS; i++) {
+        sipRound(_v0, _v1, _v2, _v3);
+    }
+    return _v0 ^ _v1 ^ _v2 ^ _v3;
+}
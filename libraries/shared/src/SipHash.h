@@ -0,0 +1,65 @@
+//
+//  SipHash.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SipHash_h
+#define hifi_SipHash_h
+
+#include <stdint.h>
+
+// SipHash-2-4, a keyed hash that is quick over the short messages a packet carries. It keeps no state off the stack,
+// so one can be made for every message, or reset() to hash another message with the same key.
+//
+// The 128 bit output is the variant of the reference implementation with the same name, its value is not the 64 bit
+// output with more bits.
+class SipHash {
+public:
+    static const int KEY_SIZE = 16;
+
+    enum Output {
+        Output64,
+        Output128
+    };
+
+    // the key is read as two little endian words, as the reference implementation reads it
+    SipHash(const uint8_t* key, Output output = Output64);
+    SipHash(uint64_t k0, uint64_t k1, Output output = Output64);
+
+    void reset();
+
+    void addData(const char* data, int length);
+
+    // the result ends the message, reset() before adding to another
+    uint64_t result();
+    void result128(uint8_t* result); // 16 bytes, in the byte order of the reference implementation
+
+private:
+    void compress(uint64_t word);
+    void finish();
+    uint64_t finalize();
+
+    uint64_t _k0;
+    uint64_t _k1;
+    Output _output;
+
+    uint64_t _v0;
+    uint64_t _v1;
+    uint64_t _v2;
+    uint64_t _v3;
+
+    // the bytes of the message that don't make a full word yet
+    uint64_t _tail;
+    int _tailSize;
+    uint64_t _length;
+};
+
+#endif // hifi_SipHash_h
@@ -28,6 +28,7 @@ SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
 
 SpatiallyNestable::~SpatiallyNestable() {
     forEachChild([&](SpatiallyNestablePointer object) {
+        object->invalidateWorldTransform();
         object->parentDeleted();
     });
 }
@@ -59,12 +60,17 @@ const QUuid SpatiallyNestable::getParentID() const {
 }
 
 void SpatiallyNestable::setParentID(const QUuid& parentID) {
+    bool changed = false;
     _idLock.withWriteLock([&] {
         if (_parentID != parentID) {
             _parentID = parentID;
             _parentKnowsMe = false;
+            changed = true;
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
 }
 
 Transform SpatiallyNestable::getParentTransform(bool& success, int depth) const {
@@ -141,7 +147,10 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 }
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
-    _parentJointIndex = parentJointIndex;
+    if (_parentJointIndex != parentJointIndex) {
+        _parentJointIndex = parentJointIndex;
+        invalidateWorldTransform();
+    }
 }
 
 glm::vec3 SpatiallyNestable::worldToLocal(const glm::vec3& position,
@@ -399,6 +408,9 @@ void SpatiallyNestable::setPosition(const glm::vec3& position, bool& success, bo
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -451,6 +463,9 @@ void SpatiallyNestable::setOrientation(const glm::quat& orientation, bool& succe
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -466,6 +481,34 @@ void SpatiallyNestable::setOrientation(const glm::quat& orientation) {
     #endif
 }
 
+void SpatiallyNestable::setPositionAndOrientation(const glm::vec3& position, const glm::quat& orientation,
+                                                  bool& success, bool tellPhysics) {
+    // guard against introducing NaN into the transform
+    if (isNaN(position) || isNaN(orientation)) {
+        success = false;
+        return;
+    }
+
+    bool changed = false;
+    Transform parentTransform = getParentTransform(success);
+    Transform myWorldTransform;
+    _transformLock.withWriteLock([&] {
+        Transform::mult(myWorldTransform, parentTransform, _transform);
+        if (myWorldTransform.getTranslation() != position || myWorldTransform.getRotation() != orientation) {
+            changed = true;
+            myWorldTransform.setTranslation(position);
+            myWorldTransform.setRotation(orientation);
+            Transform::inverseMult(_transform, parentTransform, myWorldTransform);
+        }
+    });
+    if (changed) {
+        invalidateWorldTransform();
+    }
+    if (success && changed) {
+        locationChanged(tellPhysics);
+    }
+}
+
 glm::vec3 SpatiallyNestable::getVelocity(bool& success) const {
     glm::vec3 result;
     Transform parentTransform = getParentTransform(success);
@@ -586,14 +629,54 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
+    quint64 version = _worldTransformVersion;
+    bool cached = false;
+    _transformLock.withReadLock([&] {
+        if (_worldTransformCachedVersion == version) {
+            result = _worldTransform;
+            cached = true;
+        }
+    });
+    if (cached) {
+        success = true;
+        return result;
+    }
+
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    // it is only kept if the parent's is kept as well, and doesn't hang off joints that move without telling us
+    SpatiallyNestablePointer parent = _parent.lock();
+    if (success && (!parent || (!parent->hasAnimatedJoints() && parent->isWorldTransformCached()))) {
+        _transformLock.withWriteLock([&] {
+            // a change that came in while this was computed bumped the version, what we have may be stale already
+            if (_worldTransformVersion == version) {
+                _worldTransform = result;
+                _worldTransformCachedVersion = version;
+            }
+        });
+    }
     return result;
 }
 
+bool SpatiallyNestable::isWorldTransformCached() const {
+    bool cached = false;
+    _transformLock.withReadLock([&] {
+        cached = (_worldTransformCachedVersion == _worldTransformVersion);
+    });
+    return cached;
+}
+
+void SpatiallyNestable::invalidateWorldTransform() {
+    ++_worldTransformVersion;
+    forEachDescendant([&](SpatiallyNestablePointer descendant) {
+        ++descendant->_worldTransformVersion;
+    });
+}
+
 const Transform SpatiallyNestable::getTransform() const {
     bool success;
     Transform result = getTransform(success);
@@ -649,6 +732,9 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             changed = true;
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
     if (success && changed) {
         locationChanged();
     }
@@ -689,6 +775,9 @@ void SpatiallyNestable::setScale(const glm::vec3& scale) {
             changed = true;
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
     if (changed) {
         dimensionsChanged();
     }
@@ -710,6 +799,9 @@ void SpatiallyNestable::setScale(float value) {
             changed = true;
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
 
     if (changed) {
         dimensionsChanged();
@@ -738,6 +830,9 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
             changed = true;
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
 
     if (changed) {
         locationChanged();
@@ -765,6 +860,9 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
             changed = true;
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
     if (changed) {
         locationChanged(tellPhysics);
     }
@@ -791,6 +889,9 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
             changed = true;
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
     if (changed) {
         locationChanged();
     }
@@ -848,6 +949,9 @@ void SpatiallyNestable::setLocalScale(const glm::vec3& scale) {
             changed = true;
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
     dimensionsChanged();
 }
 
@@ -1055,6 +1159,9 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
             changed = true;
         }
     });
+    if (changed) {
+        invalidateWorldTransform();
+    }
     // linear velocity
     _velocityLock.withWriteLock([&] {
         _velocity = localVelocity;
@@ -12,6 +12,8 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -61,6 +63,7 @@ public:
                                                  const QUuid& parentID, int parentJointIndex, bool& success);
 
     // world frame
+    // The world transform is kept from one call to the next until this object or one of its ancestors moves
     virtual const Transform getTransform(bool& success, int depth = 0) const;
     virtual const Transform getTransform() const;
     virtual void setTransform(const Transform& transform, bool& success);
@@ -79,6 +82,10 @@ public:
     virtual void setOrientation(const glm::quat& orientation, bool& success, bool tellPhysics = true);
     virtual void setOrientation(const glm::quat& orientation);
 
+    // both at once, looking up the parent's transform and taking the transform lock only once
+    void setPositionAndOrientation(const glm::vec3& position, const glm::quat& orientation, bool& success,
+                                   bool tellPhysics = true);
+
     // these are here because some older code uses rotation rather than orientation
     virtual const glm::quat getRotation() const { return getOrientation(); }
     virtual void setRotation(glm::quat orientation) { setOrientation(orientation); }
@@ -143,6 +150,8 @@ public:
     virtual glm::vec3 getAbsoluteJointTranslationInObjectFrame(int index) const { return glm::vec3(); }
     virtual bool setAbsoluteJointRotationInObjectFrame(int index, const glm::quat& rotation) { return false; }
     virtual bool setAbsoluteJointTranslationInObjectFrame(int index, const glm::vec3& translation) {return false; }
+    // true when the joints move without a locationChanged, the world transforms of the children are then never kept
+    virtual bool hasAnimatedJoints() const { return false; }
 
     SpatiallyNestablePointer getThisPointer() const;
 
@@ -196,6 +205,10 @@ protected:
     bool _missingAncestor { false };
 
 private:
+    bool isWorldTransformCached() const;
+    // makes the kept world transforms of this object and all of its descendants stale
+    void invalidateWorldTransform();
+
     mutable ReadWriteLockable _transformLock;
     mutable ReadWriteLockable _idLock;
     mutable ReadWriteLockable _velocityLock;
@@ -203,6 +216,10 @@ private:
     Transform _transform; // this is to be combined with parent's world-transform to produce this' world-transform.
     glm::vec3 _velocity;
     glm::vec3 _angularVelocity;
+    // the world transform, kept as of the version it was computed at
+    mutable Transform _worldTransform;
+    mutable quint64 _worldTransformCachedVersion { 0 };
+    std::atomic<quint64> _worldTransformVersion { 1 };
     mutable bool _parentKnowsMe { false };
     bool _isDead { false };
 };
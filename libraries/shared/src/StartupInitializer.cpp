@@ -0,0 +1,206 @@
+//
+//  StartupInitializer.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StartupInitializer.h"
+
+#include <string.h>
+
+#include <QtCore/QDebug>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QWaitCondition>
+
+#include "shared/Tracing.h"
+
+struct StartupInitializer::State {
+    enum StepState { Waiting, Queued, Running, Done };
+
+    struct Step {
+        const char* name;
+        std::function<void()> function;
+        std::vector<int> dependencies;
+        StepState state;
+        uint64_t beginNsecs;
+        uint64_t endNsecs;
+    };
+
+    QThreadPool* pool;
+    QMutex mutex;
+    QWaitCondition stepFinished;
+    std::vector<Step> steps;
+    std::vector<int> finishOrder;
+};
+
+namespace {
+
+using State = StartupInitializer::State;
+
+void queueReadySteps(const std::shared_ptr<State>& state);
+
+int findStep(const State& state, const char* name) {
+    for (int i = 0; i < (int)state.steps.size(); ++i) {
+        if (strcmp(state.steps[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// runs a step that is queued, with the mutex locked, which is unlocked while the step runs
+void runStep(const std::shared_ptr<State>& state, int index, QMutexLocker& lock) {
+    State::Step& step = state->steps[index];
+    step.state = State::Running;
+    step.beginNsecs = Tracing::now();
+    std::function<void()> function = step.function;
+    lock.unlock();
+
+    function();
+    uint64_t endNsecs = Tracing::now();
+
+    lock.relock();
+    State::Step& doneStep = state->steps[index];
+    doneStep.state = State::Done;
+    doneStep.endNsecs = endNsecs;
+    doneStep.function = nullptr;
+    if (Tracing::isEnabled()) {
+        Tracing::record(doneStep.name, doneStep.beginNsecs, endNsecs);
+    }
+    state->finishOrder.push_back(index);
+    queueReadySteps(state);
+    state->stepFinished.wakeAll();
+}
+
+class StartupStepJob : public QRunnable {
+public:
+    StartupStepJob(const std::shared_ptr<State>& state, int index) : _state(state), _index(index) {}
+
+    void run() override {
+        QMutexLocker lock(&_state->mutex);
+        // the thread waiting for it may have run it already
+        if (_state->steps[_index].state == State::Queued) {
+            runStep(_state, _index, lock);
+        }
+    }
+
+private:
+    std::shared_ptr<State> _state;
+    int _index;
+};
+
+// with the mutex locked
+void queueReadySteps(const std::shared_ptr<State>& state) {
+    for (int i = 0; i < (int)state->steps.size(); ++i) {
+        State::Step& step = state->steps[i];
+        if (step.state != State::Waiting) {
+            continue;
+        }
+        bool isReady = true;
+        for (int dependency : step.dependencies) {
+            if (state->steps[dependency].state != State::Done) {
+                isReady = false;
+                break;
+            }
+        }
+        if (isReady) {
+            step.state = State::Queued;
+            state->pool->start(new StartupStepJob(state, i));
+        }
+    }
+}
+
+// a step that index needs done and that nothing has picked up yet, or -1, with the mutex locked
+int findQueuedDependency(const State& state, int index) {
+    const State::Step& step = state.steps[index];
+    if (step.state == State::Queued) {
+        return index;
+    }
+    if (step.state == State::Waiting) {
+        for (int dependency : step.dependencies) {
+            int queued = findQueuedDependency(state, dependency);
+            if (queued >= 0) {
+                return queued;
+            }
+        }
+    }
+    return -1;
+}
+
+void waitForStep(const std::shared_ptr<State>& state, int index, QMutexLocker& lock) {
+    while (state->steps[index].state != State::Done) {
+        int queued = findQueuedDependency(*state, index);
+        if (queued >= 0) {
+            runStep(state, queued, lock);
+        } else {
+            state->stepFinished.wait(&state->mutex);
+        }
+    }
+}
+
+}
+
+StartupInitializer::StartupInitializer(QThreadPool* pool) : _state(std::make_shared<State>()) {
+    _state->pool = pool;
+}
+
+StartupInitializer::~StartupInitializer() {
+    waitForAll();
+}
+
+void StartupInitializer::startStep(const char* name, std::function<void()> function,
+                                   const std::vector<const char*>& dependencies) {
+    QMutexLocker lock(&_state->mutex);
+    Q_ASSERT(findStep(*_state, name) < 0);
+
+    State::Step step;
+    step.name = name;
+    step.function = function;
+    step.state = State::Waiting;
+    step.beginNsecs = 0;
+    step.endNsecs = 0;
+    for (const char* dependencyName : dependencies) {
+        int dependency = findStep(*_state, dependencyName);
+        if (dependency < 0) {
+            qWarning() << "Startup step" << name << "depends on" << dependencyName << "which was not started before it";
+            continue;
+        }
+        step.dependencies.push_back(dependency);
+    }
+    _state->steps.push_back(step);
+    queueReadySteps(_state);
+}
+
+void StartupInitializer::waitFor(const char* name) {
+    QMutexLocker lock(&_state->mutex);
+    int index = findStep(*_state, name);
+    if (index < 0) {
+        qWarning() << "Waiting for startup step" << name << "which was never started";
+        return;
+    }
+    waitForStep(_state, index, lock);
+}
+
+void StartupInitializer::waitForAll() {
+    QMutexLocker lock(&_state->mutex);
+    for (int i = 0; i < (int)_state->steps.size(); ++i) {
+        waitForStep(_state, i, lock);
+    }
+}
+
+std::vector<StartupInitializer::StepTiming> StartupInitializer::getTimings() const {
+    QMutexLocker lock(&_state->mutex);
+    std::vector<StepTiming> timings;
+    for (int index : _state->finishOrder) {
+        const State::Step& step = _state->steps[index];
+        StepTiming timing = { step.name, step.beginNsecs, step.endNsecs };
+        timings.push_back(timing);
+    }
+    return timings;
+}
@@ -0,0 +1,62 @@
+//
+//  StartupInitializer.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_StartupInitializer_h
+#define hifi_StartupInitializer_h
+
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QThreadPool>
+
+// Runs the steps of a startup that don't need the thread starting up on a pool, each one as soon as the steps it
+// depends on are done, while that thread gets on with the rest. The thread waits for a step only where it needs what
+// the step did, and runs the step itself if the pool hasn't got to it yet, so a busy pool never holds it up.
+//
+// Each step is traced under its name, and its time is kept for the startup log.
+class StartupInitializer {
+public:
+    struct StepTiming {
+        const char* name;
+        uint64_t beginNsecs;
+        uint64_t endNsecs;
+    };
+
+    StartupInitializer(QThreadPool* pool = QThreadPool::globalInstance());
+    // waits for every step
+    ~StartupInitializer();
+
+    // The name has to outlive the initializer, use a string literal. The dependencies are the names of steps
+    // started before this one.
+    void startStep(const char* name, std::function<void()> function,
+                   const std::vector<const char*>& dependencies = std::vector<const char*>());
+
+    void waitFor(const char* name);
+    void waitForAll();
+
+    // the steps that are done, in the order they finished
+    std::vector<StepTiming> getTimings() const;
+
+    struct State;
+
+private:
+    StartupInitializer(const StartupInitializer&) = delete;
+    StartupInitializer& operator=(const StartupInitializer&) = delete;
+
+    // the jobs on the pool share the state, one can be picked up after the step it was started for has been run
+    std::shared_ptr<State> _state;
+};
+
+#endif // hifi_StartupInitializer_h
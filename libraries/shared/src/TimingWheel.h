@@ -0,0 +1,152 @@
+//
+//  TimingWheel.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_TimingWheel_h
+#define hifi_TimingWheel_h
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+// Buckets items by the fixed-size time slot they are due in, so that everything due in a slot comes out as one batch.
+// The first level covers one turn of the wheel, items due further out wait in a second level with one slot per turn
+// and move down as the wheel reaches them. Items due beyond the second level are held at its far end.
+//
+// The slot that was current at the last popDue stays open, items inserted into it come out on the next popDue.
+template <typename T>
+class TimingWheel {
+public:
+    static const int NUM_SLOTS = 64;
+
+    TimingWheel(quint64 slotUsecs) : _slotUsecs(slotUsecs) {}
+
+    quint64 getSlotUsecs() const { return _slotUsecs; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    // items that are already due go in the current slot
+    // nowUsecs catches the wheel up to the present when it has been sitting empty
+    void insert(quint64 nowUsecs, quint64 dueUsecs, T item) {
+        if (_size == 0) {
+            _currentTick = std::max(_currentTick, nowUsecs / _slotUsecs);
+        }
+        insertAtTick(std::max(dueUsecs / _slotUsecs, _currentTick), std::move(item));
+        ++_size;
+    }
+
+    // start of the earliest slot holding an item, or the max quint64 when there is none
+    quint64 nextSlotUsecs() const {
+        for (quint64 tick = _currentTick; tick < _currentTick + NUM_SLOTS; ++tick) {
+            if (!_slots[tick % NUM_SLOTS].empty()) {
+                return tick * _slotUsecs;
+            }
+        }
+
+        quint64 turn = _currentTick / NUM_SLOTS;
+        for (quint64 nextTurn = turn + 1; nextTurn < turn + NUM_SLOTS; ++nextTurn) {
+            auto& turnSlot = _turns[nextTurn % NUM_SLOTS];
+            if (!turnSlot.empty()) {
+                auto earliest = std::min_element(turnSlot.begin(), turnSlot.end(),
+                    [](const TickItemPair& a, const TickItemPair& b) { return a.first < b.first; });
+                return earliest->first * _slotUsecs;
+            }
+        }
+
+        return std::numeric_limits<quint64>::max();
+    }
+
+    // moves the items of every slot that has started by nowUsecs onto the end of batch, earliest slot first
+    // returns the number of items added
+    int popDue(quint64 nowUsecs, std::vector<T>& batch) {
+        auto batchStart = batch.size();
+        quint64 nowTick = std::max(nowUsecs / _slotUsecs, _currentTick);
+
+        if (_size == 0) {
+            _currentTick = nowTick;
+            return 0;
+        }
+
+        popSlot(_currentTick, batch);
+        while (_currentTick < nowTick && _size > 0) {
+            ++_currentTick;
+
+            if (_currentTick % NUM_SLOTS == 0) {
+                // a new turn of the wheel, its items are now close enough for the first level
+                auto& turnSlot = _turns[(_currentTick / NUM_SLOTS) % NUM_SLOTS];
+                for (auto& tickItemPair : turnSlot) {
+                    insertAtTick(tickItemPair.first, std::move(tickItemPair.second));
+                }
+                turnSlot.clear();
+            }
+
+            popSlot(_currentTick, batch);
+        }
+        _currentTick = nowTick;
+
+        return (int)(batch.size() - batchStart);
+    }
+
+    // calls function with every item and empties the wheel
+    template <typename F>
+    void clear(F function) {
+        for (auto& slot : _slots) {
+            for (auto& item : slot) {
+                function(item);
+            }
+            slot.clear();
+        }
+        for (auto& turnSlot : _turns) {
+            for (auto& tickItemPair : turnSlot) {
+                function(tickItemPair.second);
+            }
+            turnSlot.clear();
+        }
+        _size = 0;
+    }
+
+private:
+    using TickItemPair = std::pair<quint64, T>;
+
+    void insertAtTick(quint64 tick, T&& item) {
+        if (tick - _currentTick < (quint64)NUM_SLOTS) {
+            _slots[tick % NUM_SLOTS].push_back(std::move(item));
+            return;
+        }
+
+        // the turn the current tick is in has already moved down, so the last turn held is NUM_SLOTS - 1 ahead
+        quint64 lastTick = (_currentTick / NUM_SLOTS + NUM_SLOTS) * NUM_SLOTS - 1;
+        tick = std::min(tick, lastTick);
+        _turns[(tick / NUM_SLOTS) % NUM_SLOTS].emplace_back(tick, std::move(item));
+    }
+
+    void popSlot(quint64 tick, std::vector<T>& batch) {
+        auto& slot = _slots[tick % NUM_SLOTS];
+        for (auto& item : slot) {
+            batch.push_back(std::move(item));
+        }
+        _size -= slot.size();
+        slot.clear();
+    }
+
+    quint64 _slotUsecs;
+    quint64 _currentTick { 0 };
+    size_t _size { 0 };
+
+    std::vector<T> _slots[NUM_SLOTS];           // one per tick, for the turn ahead of the current tick
+    std::vector<TickItemPair> _turns[NUM_SLOTS]; // one per turn of the first level
+};
+
+#endif // hifi_TimingWheel_h
@@ -0,0 +1,289 @@
+//
+//  TriangleBVH.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleBVH.h"
+
+#include <algorithm>
+#include <limits>
+#include <string.h>
+
+// the most triangles a leaf is left with, two blocks of them
+static const int MAX_LEAF_TRIANGLES = 8;
+// deeper than a median split of any mesh can go
+static const int MAX_DEPTH = 64;
+
+void TriangleBVH::build(const std::vector<Triangle>& triangles) {
+    _nodes.clear();
+    _blocks.clear();
+    if (triangles.empty()) {
+        return;
+    }
+
+    std::vector<int> order(triangles.size());
+    std::vector<glm::vec3> centers(triangles.size());
+    for (size_t i = 0; i < triangles.size(); i++) {
+        order[i] = (int)i;
+        centers[i] = (triangles[i].v0 + triangles[i].v1 + triangles[i].v2) / 3.0f;
+    }
+    size_t numLeaves = (triangles.size() + MAX_LEAF_TRIANGLES - 1) / MAX_LEAF_TRIANGLES;
+    _nodes.reserve(4 * numLeaves);
+    _blocks.reserve(2 * numLeaves + triangles.size() / BLOCK_SIZE);
+    buildNode(triangles, order, centers, 0, (int)triangles.size());
+}
+
+void TriangleBVH::buildNode(const std::vector<Triangle>& triangles, std::vector<int>& order,
+                            const std::vector<glm::vec3>& centers, int begin, int end) {
+    int index = (int)_nodes.size();
+    _nodes.push_back(Node());
+
+    glm::vec3 minimum(std::numeric_limits<float>::max());
+    glm::vec3 maximum(-std::numeric_limits<float>::max());
+    glm::vec3 minimumCenter = minimum;
+    glm::vec3 maximumCenter = maximum;
+    for (int i = begin; i < end; i++) {
+        const Triangle& triangle = triangles[order[i]];
+        minimum = glm::min(minimum, glm::min(triangle.v0, glm::min(triangle.v1, triangle.v2)));
+        maximum = glm::max(maximum, glm::max(triangle.v0, glm::max(triangle.v1, triangle.v2)));
+        minimumCenter = glm::min(minimumCenter, centers[order[i]]);
+        maximumCenter = glm::max(maximumCenter, centers[order[i]]);
+    }
+    _nodes[index].minimum = minimum;
+    _nodes[index].maximum = maximum;
+
+    if (end - begin <= MAX_LEAF_TRIANGLES) {
+        _nodes[index].first = (int)_blocks.size();
+        _nodes[index].numBlocks = (end - begin + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        for (int i = begin; i < end; i += BLOCK_SIZE) {
+            TriangleBlock block;
+            memset(&block, 0, sizeof(block));
+            for (int lane = 0; lane < BLOCK_SIZE && i + lane < end; lane++) {
+                const Triangle& triangle = triangles[order[i + lane]];
+                for (int axis = 0; axis < 3; axis++) {
+                    block.v0[axis][lane] = triangle.v0[axis];
+                    block.v1[axis][lane] = triangle.v1[axis];
+                    block.v2[axis][lane] = triangle.v2[axis];
+                }
+            }
+            _blocks.push_back(block);
+        }
+        return;
+    }
+
+    // split at the median of the centers, along the axis they spread the most on
+    glm::vec3 spread = maximumCenter - minimumCenter;
+    int axis = (spread.x > spread.y && spread.x > spread.z) ? 0 : (spread.y > spread.z ? 1 : 2);
+    int middle = (begin + end) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](int a, int b) {
+        return centers[a][axis] < centers[b][axis];
+    });
+    buildNode(triangles, order, centers, begin, middle);
+    _nodes[index].first = (int)_nodes.size();
+    _nodes[index].numBlocks = 0;
+    buildNode(triangles, order, centers, middle, end);
+}
+
+// the distance the ray enters the box at, if it does before maxDistance
+static bool findRayBoxEntry(const glm::vec3& origin, const glm::vec3& inverseDirection,
+                            const glm::vec3& minimum, const glm::vec3& maximum, float maxDistance, float& entry) {
+    glm::vec3 t0 = (minimum - origin) * inverseDirection;
+    glm::vec3 t1 = (maximum - origin) * inverseDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    entry = glm::max(glm::max(glm::max(tNear.x, tNear.y), tNear.z), 0.0f);
+    float exit = glm::min(glm::min(glm::min(tFar.x, tFar.y), tFar.z), maxDistance);
+    return entry <= exit;
+}
+
+bool TriangleBVH::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, float& distance,
+                                      Triangle& triangle, bool mirrored) const {
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    // a zero component becomes a huge one rather than an infinity, which would make 0 * inf a NaN on the box's edge
+    const float TINY = 1.0e-20f;
+    glm::vec3 inverseDirection;
+    for (int i = 0; i < 3; i++) {
+        float component = (fabsf(direction[i]) < TINY) ? (direction[i] < 0.0f ? -TINY : TINY) : direction[i];
+        inverseDirection[i] = 1.0f / component;
+    }
+
+    float bestDistance = distance;
+    const TriangleBlock* bestBlock = nullptr;
+    int bestLane = 0;
+
+    float entry;
+    if (!findRayBoxEntry(origin, inverseDirection, _nodes[0].minimum, _nodes[0].maximum, bestDistance, entry)) {
+        return false;
+    }
+    int stack[MAX_DEPTH];
+    float stackEntries[MAX_DEPTH];
+    int stackSize = 0;
+    stack[stackSize] = 0;
+    stackEntries[stackSize++] = entry;
+
+    while (stackSize > 0) {
+        --stackSize;
+        if (stackEntries[stackSize] > bestDistance) {
+            continue; // a closer hit was found since it was pushed
+        }
+        const Node& node = _nodes[stack[stackSize]];
+
+        if (node.numBlocks > 0) {
+            for (int i = node.first; i < node.first + node.numBlocks; i++) {
+                int lane;
+                if (findBlockIntersection(_blocks[i], origin, direction, bestDistance, lane, mirrored)) {
+                    bestBlock = &_blocks[i];
+                    bestLane = lane;
+                }
+            }
+            continue;
+        }
+
+        // the closer child goes on the top of the stack, so it's tested first
+        int left = (int)(&node - &_nodes[0]) + 1;
+        int right = node.first;
+        float leftEntry, rightEntry;
+        bool hitsLeft = findRayBoxEntry(origin, inverseDirection, _nodes[left].minimum, _nodes[left].maximum,
+                                        bestDistance, leftEntry);
+        bool hitsRight = findRayBoxEntry(origin, inverseDirection, _nodes[right].minimum, _nodes[right].maximum,
+                                         bestDistance, rightEntry);
+        if (hitsLeft && hitsRight && leftEntry < rightEntry) {
+            std::swap(left, right);
+            std::swap(leftEntry, rightEntry);
+        }
+        if (hitsLeft) {
+            stack[stackSize] = left;
+            stackEntries[stackSize++] = leftEntry;
+        }
+        if (hitsRight) {
+            stack[stackSize] = right;
+            stackEntries[stackSize++] = rightEntry;
+        }
+    }
+
+    if (!bestBlock) {
+        return false;
+    }
+    distance = bestDistance;
+    for (int axis = 0; axis < 3; axis++) {
+        triangle.v0[axis] = bestBlock->v0[axis][bestLane];
+        triangle.v1[axis] = bestBlock->v1[axis][bestLane];
+        triangle.v2[axis] = bestBlock->v2[axis][bestLane];
+    }
+    return true;
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <xmmintrin.h>
+
+// the same steps as findRayTriangleIntersection, on four triangles at a time
+bool TriangleBVH::findBlockIntersection(const TriangleBlock& block, const glm::vec3& origin, const glm::vec3& direction,
+                                        float& distance, int& lane, bool mirrored) const {
+    // turning a triangle around is the same as swapping two of its vertices
+    const float (*p0)[BLOCK_SIZE] = mirrored ? block.v2 : block.v0;
+    const float (*p2)[BLOCK_SIZE] = mirrored ? block.v0 : block.v2;
+    const __m128 v0x = _mm_loadu_ps(p0[0]), v0y = _mm_loadu_ps(p0[1]), v0z = _mm_loadu_ps(p0[2]);
+    const __m128 v1x = _mm_loadu_ps(block.v1[0]), v1y = _mm_loadu_ps(block.v1[1]), v1z = _mm_loadu_ps(block.v1[2]);
+    const __m128 v2x = _mm_loadu_ps(p2[0]), v2y = _mm_loadu_ps(p2[1]), v2z = _mm_loadu_ps(p2[2]);
+    const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y), oz = _mm_set1_ps(origin.z);
+    const __m128 dx = _mm_set1_ps(direction.x), dy = _mm_set1_ps(direction.y), dz = _mm_set1_ps(direction.z);
+    const __m128 zero = _mm_setzero_ps();
+
+    // firstSide = v0 - v1, secondSide = v2 - v1, normal = cross(secondSide, firstSide)
+    __m128 fx = _mm_sub_ps(v0x, v1x), fy = _mm_sub_ps(v0y, v1y), fz = _mm_sub_ps(v0z, v1z);
+    __m128 sx = _mm_sub_ps(v2x, v1x), sy = _mm_sub_ps(v2y, v1y), sz = _mm_sub_ps(v2z, v1z);
+    __m128 nx = _mm_sub_ps(_mm_mul_ps(sy, fz), _mm_mul_ps(fy, sz));
+    __m128 ny = _mm_sub_ps(_mm_mul_ps(sz, fx), _mm_mul_ps(fz, sx));
+    __m128 nz = _mm_sub_ps(_mm_mul_ps(sx, fy), _mm_mul_ps(fx, sy));
+
+    // dividend = dot(normal, v1) - dot(origin, normal), above the plane and facing it
+    __m128 dividend = _mm_sub_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, v1x), _mm_mul_ps(ny, v1y)), _mm_mul_ps(nz, v1z)),
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(ox, nx), _mm_mul_ps(oy, ny)), _mm_mul_ps(oz, nz)));
+    __m128 divisor = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, dx), _mm_mul_ps(ny, dy)), _mm_mul_ps(nz, dz));
+    __m128 mask = _mm_and_ps(_mm_cmple_ps(dividend, zero), _mm_cmplt_ps(divisor, zero));
+    if (_mm_movemask_ps(mask) == 0) {
+        return false;
+    }
+
+    __m128 t = _mm_div_ps(dividend, divisor);
+    mask = _mm_and_ps(mask, _mm_cmplt_ps(t, _mm_set1_ps(distance)));
+
+    // the point on the plane has to be inside each of the three sides
+    __m128 px = _mm_sub_ps(_mm_add_ps(ox, _mm_mul_ps(dx, t)), v1x);
+    __m128 py = _mm_sub_ps(_mm_add_ps(oy, _mm_mul_ps(dy, t)), v1y);
+    __m128 pz = _mm_sub_ps(_mm_add_ps(oz, _mm_mul_ps(dz, t)), v1z);
+
+    // dot(normal, cross(point - v1, firstSide)) > 0
+    __m128 cx = _mm_sub_ps(_mm_mul_ps(py, fz), _mm_mul_ps(fy, pz));
+    __m128 cy = _mm_sub_ps(_mm_mul_ps(pz, fx), _mm_mul_ps(fz, px));
+    __m128 cz = _mm_sub_ps(_mm_mul_ps(px, fy), _mm_mul_ps(fx, py));
+    __m128 side = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_mul_ps(nz, cz));
+    mask = _mm_and_ps(mask, _mm_cmpgt_ps(side, zero));
+
+    // dot(normal, cross(secondSide, point - v1)) > 0
+    cx = _mm_sub_ps(_mm_mul_ps(sy, pz), _mm_mul_ps(py, sz));
+    cy = _mm_sub_ps(_mm_mul_ps(sz, px), _mm_mul_ps(pz, sx));
+    cz = _mm_sub_ps(_mm_mul_ps(sx, py), _mm_mul_ps(px, sy));
+    side = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_mul_ps(nz, cz));
+    mask = _mm_and_ps(mask, _mm_cmpgt_ps(side, zero));
+
+    // dot(normal, cross(point - v0, v2 - v0)) > 0
+    px = _mm_sub_ps(_mm_add_ps(ox, _mm_mul_ps(dx, t)), v0x);
+    py = _mm_sub_ps(_mm_add_ps(oy, _mm_mul_ps(dy, t)), v0y);
+    pz = _mm_sub_ps(_mm_add_ps(oz, _mm_mul_ps(dz, t)), v0z);
+    __m128 ex = _mm_sub_ps(v2x, v0x), ey = _mm_sub_ps(v2y, v0y), ez = _mm_sub_ps(v2z, v0z);
+    cx = _mm_sub_ps(_mm_mul_ps(py, ez), _mm_mul_ps(ey, pz));
+    cy = _mm_sub_ps(_mm_mul_ps(pz, ex), _mm_mul_ps(ez, px));
+    cz = _mm_sub_ps(_mm_mul_ps(px, ey), _mm_mul_ps(ex, py));
+    side = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_mul_ps(nz, cz));
+    mask = _mm_and_ps(mask, _mm_cmpgt_ps(side, zero));
+
+    int hits = _mm_movemask_ps(mask);
+    if (hits == 0) {
+        return false;
+    }
+    float distances[BLOCK_SIZE];
+    _mm_storeu_ps(distances, t);
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        if ((hits & (1 << i)) && distances[i] < distance) {
+            distance = distances[i];
+            lane = i;
+        }
+    }
+    return true;
+}
+
+#else
+
+bool TriangleBVH::findBlockIntersection(const TriangleBlock& block, const glm::vec3& origin, const glm::vec3& direction,
+                                        float& distance, int& lane, bool mirrored) const {
+    bool hit = false;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        glm::vec3 v0(block.v0[0][i], block.v0[1][i], block.v0[2][i]);
+        glm::vec3 v1(block.v1[0][i], block.v1[1][i], block.v1[2][i]);
+        glm::vec3 v2(block.v2[0][i], block.v2[1][i], block.v2[2][i]);
+        if (mirrored) {
+            std::swap(v0, v2);
+        }
+        float thisDistance;
+        if (findRayTriangleIntersection(origin, direction, v0, v1, v2, thisDistance) && thisDistance < distance) {
+            distance = thisDistance;
+            lane = i;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+#endif
@@ -0,0 +1,66 @@
+//
+//  TriangleBVH.h
+//  libraries/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_TriangleBVH_h
+#define hifi_TriangleBVH_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "GeometryUtil.h"
+
+// A bounding volume hierarchy over the triangles of a mesh, for picking the closest triangle a ray hits without testing
+// them all. It is built once, in the frame of the mesh: a ray in another frame is brought into the mesh's frame by
+// the inverse of an affine transform, which keeps the distances along the ray as they are.
+//
+// The leaves hold their triangles by four, lane by lane, so they're tested four at a time.
+class TriangleBVH {
+public:
+    void build(const std::vector<Triangle>& triangles);
+    bool isEmpty() const { return _nodes.empty(); }
+
+    // The closest triangle the ray hits closer than distance, and its distance. Like findRayTriangleIntersection only
+    // the front faces are hit, unless the triangles are seen through a transform that mirrors them, which turns them
+    // around.
+    bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, float& distance, Triangle& triangle,
+                             bool mirrored = false) const;
+
+private:
+    static const int BLOCK_SIZE = 4;
+
+    struct Node {
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        // a leaf has blocks, it's the children that follow an inner node: the first one right after it, and this one
+        int first;
+        int numBlocks;
+    };
+
+    // the x, y and z of the vertices of four triangles, the unused lanes are degenerate and never hit
+    struct TriangleBlock {
+        float v0[3][BLOCK_SIZE];
+        float v1[3][BLOCK_SIZE];
+        float v2[3][BLOCK_SIZE];
+    };
+
+    void buildNode(const std::vector<Triangle>& triangles, std::vector<int>& order,
+                   const std::vector<glm::vec3>& centers, int begin, int end);
+    bool findBlockIntersection(const TriangleBlock& block, const glm::vec3& origin, const glm::vec3& direction,
+                               float& distance, int& lane, bool mirrored) const;
+
+    std::vector<Node> _nodes;
+    std::vector<TriangleBlock> _blocks;
+};
+
+#endif // hifi_TriangleBVH_h
@@ -10,6 +10,11 @@
 //
 
 #include <algorithm>
+#include <cmath>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#endif
 
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -27,6 +32,9 @@
 
 using namespace std;
 
+// position, packed orientation, two byte fov, aspect ratio and clips, center sphere radius
+const int SERIALIZED_FRUSTUM_BYTES = sizeof(glm::vec3) + 4 * sizeof(uint16_t) + 4 * sizeof(uint16_t) + sizeof(float);
+
 void ViewFrustum::setOrientation(const glm::quat& orientationAsQuaternion) {
     _orientation = orientationAsQuaternion;
     _right = glm::vec3(orientationAsQuaternion * glm::vec4(IDENTITY_RIGHT, 0.0f));
@@ -151,7 +159,7 @@ ViewFrustum::intersection ViewFrustum::calculateCubeFrustumIntersection(const AA
 
 const float HALF_SQRT_THREE = 0.8660254f;
 
-ViewFrustum::intersection ViewFrustum::calculateCubeKeyholeIntersection(const AACube& cube) const {
+ViewFrustum::intersection ViewFrustum::calculateCubeSphereIntersection(const AACube& cube) const {
     // check against centeral sphere
     ViewFrustum::intersection sphereResult = INTERSECT;
     glm::vec3 cubeOffset = cube.calcCenter() - _position;
@@ -169,6 +177,14 @@ ViewFrustum::intersection ViewFrustum::calculateCubeKeyholeIntersection(const AA
         // the cube is in center of sphere and its bounding radius is inside
         return INSIDE;
     }
+    return sphereResult;
+}
+
+ViewFrustum::intersection ViewFrustum::calculateCubeKeyholeIntersection(const AACube& cube) const {
+    ViewFrustum::intersection sphereResult = calculateCubeSphereIntersection(cube);
+    if (sphereResult == INSIDE) {
+        return INSIDE;
+    }
 
     // check against frustum
     ViewFrustum::intersection frustumResult = calculateCubeFrustumIntersection(cube);
@@ -176,6 +192,128 @@ ViewFrustum::intersection ViewFrustum::calculateCubeKeyholeIntersection(const AA
     return (frustumResult == OUTSIDE) ? sphereResult : frustumResult;
 }
 
+// A box is outside a plane when the corner farthest along the plane's normal is behind it, and straddles it when the
+// nearest corner is. Those corners are the center of the box moved by its half scale times |normal|, one way or the
+// other, so each plane takes the same few multiplies for every box and the boxes are tested side by side.
+static ViewFrustum::intersection classifyBox(const ::Plane* planes, float centerX, float centerY, float centerZ,
+        float halfX, float halfY, float halfZ) {
+    ViewFrustum::intersection result = ViewFrustum::INSIDE;
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+        const glm::vec3& normal = planes[i].getNormal();
+        float centerDistance = planes[i].getDCoefficient() + normal.x * centerX + normal.y * centerY +
+            normal.z * centerZ;
+        float reach = fabsf(normal.x) * halfX + fabsf(normal.y) * halfY + fabsf(normal.z) * halfZ;
+        if (centerDistance + reach < 0.0f) {
+            return ViewFrustum::OUTSIDE;
+        }
+        if (centerDistance - reach < 0.0f) {
+            result = ViewFrustum::INTERSECT;
+        }
+    }
+    return result;
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+static void classifyBoxes(const ::Plane* planes, int count, const float* cornerX, const float* cornerY,
+        const float* cornerZ, const float* scaleX, const float* scaleY, const float* scaleZ,
+        ViewFrustum::intersection* results) {
+    __m128 normalX[NUM_FRUSTUM_PLANES], normalY[NUM_FRUSTUM_PLANES], normalZ[NUM_FRUSTUM_PLANES];
+    __m128 absNormalX[NUM_FRUSTUM_PLANES], absNormalY[NUM_FRUSTUM_PLANES], absNormalZ[NUM_FRUSTUM_PLANES];
+    __m128 planeDistance[NUM_FRUSTUM_PLANES];
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+        const glm::vec3& normal = planes[i].getNormal();
+        normalX[i] = _mm_set1_ps(normal.x);
+        normalY[i] = _mm_set1_ps(normal.y);
+        normalZ[i] = _mm_set1_ps(normal.z);
+        absNormalX[i] = _mm_set1_ps(fabsf(normal.x));
+        absNormalY[i] = _mm_set1_ps(fabsf(normal.y));
+        absNormalZ[i] = _mm_set1_ps(fabsf(normal.z));
+        planeDistance[i] = _mm_set1_ps(planes[i].getDCoefficient());
+    }
+
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    int index = 0;
+    for (; index + 4 <= count; index += 4) {
+        __m128 halfX = _mm_mul_ps(half, _mm_loadu_ps(scaleX + index));
+        __m128 halfY = _mm_mul_ps(half, _mm_loadu_ps(scaleY + index));
+        __m128 halfZ = _mm_mul_ps(half, _mm_loadu_ps(scaleZ + index));
+        __m128 centerX = _mm_add_ps(_mm_loadu_ps(cornerX + index), halfX);
+        __m128 centerY = _mm_add_ps(_mm_loadu_ps(cornerY + index), halfY);
+        __m128 centerZ = _mm_add_ps(_mm_loadu_ps(cornerZ + index), halfZ);
+
+        __m128 outside = zero;
+        __m128 straddles = zero;
+        for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+            __m128 centerDistance = _mm_add_ps(planeDistance[i], _mm_mul_ps(normalX[i], centerX));
+            centerDistance = _mm_add_ps(centerDistance, _mm_mul_ps(normalY[i], centerY));
+            centerDistance = _mm_add_ps(centerDistance, _mm_mul_ps(normalZ[i], centerZ));
+            __m128 reach = _mm_mul_ps(absNormalX[i], halfX);
+            reach = _mm_add_ps(reach, _mm_mul_ps(absNormalY[i], halfY));
+            reach = _mm_add_ps(reach, _mm_mul_ps(absNormalZ[i], halfZ));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(centerDistance, reach), zero));
+            straddles = _mm_or_ps(straddles, _mm_cmplt_ps(_mm_sub_ps(centerDistance, reach), zero));
+        }
+
+        int outsideMask = _mm_movemask_ps(outside);
+        int straddlesMask = _mm_movemask_ps(straddles);
+        for (int lane = 0; lane < 4; lane++) {
+            int bit = 1 << lane;
+            results[index + lane] = (outsideMask & bit) ? ViewFrustum::OUTSIDE :
+                ((straddlesMask & bit) ? ViewFrustum::INTERSECT : ViewFrustum::INSIDE);
+        }
+    }
+
+    // the last few that don't fill a register
+    for (; index < count; index++) {
+        float halfX = 0.5f * scaleX[index];
+        float halfY = 0.5f * scaleY[index];
+        float halfZ = 0.5f * scaleZ[index];
+        results[index] = classifyBox(planes, cornerX[index] + halfX, cornerY[index] + halfY, cornerZ[index] + halfZ,
+            halfX, halfY, halfZ);
+    }
+}
+
+#else
+
+static void classifyBoxes(const ::Plane* planes, int count, const float* cornerX, const float* cornerY,
+        const float* cornerZ, const float* scaleX, const float* scaleY, const float* scaleZ,
+        ViewFrustum::intersection* results) {
+    for (int index = 0; index < count; index++) {
+        float halfX = 0.5f * scaleX[index];
+        float halfY = 0.5f * scaleY[index];
+        float halfZ = 0.5f * scaleZ[index];
+        results[index] = classifyBox(planes, cornerX[index] + halfX, cornerY[index] + halfY, cornerZ[index] + halfZ,
+            halfX, halfY, halfZ);
+    }
+}
+
+#endif
+
+void ViewFrustum::calculateBoxesFrustumIntersection(int count, const float* cornerX, const float* cornerY,
+        const float* cornerZ, const float* scaleX, const float* scaleY, const float* scaleZ,
+        intersection* results) const {
+    classifyBoxes(_planes, count, cornerX, cornerY, cornerZ, scaleX, scaleY, scaleZ, results);
+}
+
+void ViewFrustum::calculateCubesKeyholeIntersection(int count, const float* cornerX, const float* cornerY,
+        const float* cornerZ, const float* scale, intersection* results) const {
+    classifyBoxes(_planes, count, cornerX, cornerY, cornerZ, scale, scale, scale, results);
+
+    // the central sphere is tested a cube at a time, it holds the cubes it contains and the ones outside the frustum
+    // that touch it
+    for (int i = 0; i < count; i++) {
+        AACube cube(glm::vec3(cornerX[i], cornerY[i], cornerZ[i]), scale[i]);
+        ViewFrustum::intersection sphereResult = calculateCubeSphereIntersection(cube);
+        if (sphereResult == INSIDE) {
+            results[i] = INSIDE;
+        } else if (results[i] == OUTSIDE) {
+            results[i] = sphereResult;
+        }
+    }
+}
+
 bool ViewFrustum::pointIntersectsFrustum(const glm::vec3& point) const {
     // only check against frustum
     for(int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
@@ -536,16 +674,19 @@ const int hullVertexLookup[MAX_POSSIBLE_COMBINATIONS][MAX_PROJECTED_POLYGON_VERT
     {6, TOP_RIGHT_NEAR, TOP_RIGHT_FAR, BOTTOM_RIGHT_FAR, BOTTOM_LEFT_FAR, BOTTOM_LEFT_NEAR, TOP_LEFT_NEAR}, // back, top, left
 };
 
-CubeProjectedPolygon ViewFrustum::getProjectedPolygon(const AACube& box) const {
+// the outline of a cube or a box on the screen, the hull of the vertices of it the camera can see
+template <typename Box>
+static CubeProjectedPolygon projectHull(const ViewFrustum& frustum, const Box& box) {
+    const glm::vec3& position = frustum.getPosition();
     const glm::vec3& bottomNearRight = box.getCorner();
     glm::vec3 topFarLeft = box.calcTopFarLeft();
 
-    int lookUp = ((_position.x < bottomNearRight.x)     )   //  1 = right      |   compute 6-bit
-               + ((_position.x > topFarLeft.x     ) << 1)   //  2 = left       |         code to
-               + ((_position.y < bottomNearRight.y) << 2)   //  4 = bottom     | classify camera
-               + ((_position.y > topFarLeft.y     ) << 3)   //  8 = top        | with respect to
-               + ((_position.z < bottomNearRight.z) << 4)   // 16 = front/near |  the 6 defining
-               + ((_position.z > topFarLeft.z     ) << 5);  // 32 = back/far   |          planes
+    int lookUp = ((position.x < bottomNearRight.x)     )    //  1 = right      |   compute 6-bit
+               + ((position.x > topFarLeft.x     ) << 1)    //  2 = left       |         code to
+               + ((position.y < bottomNearRight.y) << 2)    //  4 = bottom     | classify camera
+               + ((position.y > topFarLeft.y     ) << 3)    //  8 = top        | with respect to
+               + ((position.z < bottomNearRight.z) << 4)    // 16 = front/near |  the 6 defining
+               + ((position.z > topFarLeft.z     ) << 5);   // 32 = back/far   |          planes
 
     int vertexCount = hullVertexLookup[lookUp][0];  //look up number of vertices
 
@@ -559,7 +700,7 @@ CubeProjectedPolygon ViewFrustum::getProjectedPolygon(const AACube& box) const {
         for(int i = 0; i < vertexCount; i++) {
             int vertexNum = hullVertexLookup[lookUp][i+1];
             glm::vec3 point = box.getVertex((BoxVertex)vertexNum);
-            glm::vec2 projectedPoint = projectPoint(point, pointInView);
+            glm::vec2 projectedPoint = frustum.projectPoint(point, pointInView);
             allPointsInView = allPointsInView && pointInView;
             anyPointsInView = anyPointsInView || pointInView;
             projectedPolygon.setVertex(i, projectedPoint);
@@ -592,7 +733,7 @@ CubeProjectedPolygon ViewFrustum::getProjectedPolygon(const AACube& box) const {
         ***/
     }
     // set the distance from our camera position, to the closest vertex
-    float distance = glm::distance(getPosition(), box.calcCenter());
+    float distance = glm::distance(position, box.calcCenter());
     projectedPolygon.setDistance(distance);
     projectedPolygon.setAnyInView(anyPointsInView);
     projectedPolygon.setAllInView(allPointsInView);
@@ -600,6 +741,14 @@ CubeProjectedPolygon ViewFrustum::getProjectedPolygon(const AACube& box) const {
     return projectedPolygon;
 }
 
+CubeProjectedPolygon ViewFrustum::getProjectedPolygon(const AACube& box) const {
+    return projectHull(*this, box);
+}
+
+CubeProjectedPolygon ViewFrustum::getProjectedPolygon(const AABox& box) const {
+    return projectHull(*this, box);
+}
+
 // Similar strategy to getProjectedPolygon() we use the knowledge of camera position relative to the
 // axis-aligned voxels to determine which of the voxels vertices must be the furthest. No need for
 // squares and square-roots. Just compares.
@@ -669,3 +818,52 @@ void ViewFrustum::invalidate() {
     }
     _centerSphereRadius = -1.0e6f; // -10^6 should be negative enough
 }
+
+QByteArray ViewFrustum::toByteArray() const {
+    QByteArray data(SERIALIZED_FRUSTUM_BYTES, 0);
+    unsigned char* destinationBuffer = reinterpret_cast<unsigned char*>(data.data());
+
+    memcpy(destinationBuffer, &_position, sizeof(_position));
+    destinationBuffer += sizeof(_position);
+    destinationBuffer += packOrientationQuatToBytes(destinationBuffer, _orientation);
+    destinationBuffer += packFloatAngleToTwoByte(destinationBuffer, _fieldOfView);
+    destinationBuffer += packFloatRatioToTwoByte(destinationBuffer, _aspectRatio);
+    destinationBuffer += packClipValueToTwoByte(destinationBuffer, _nearClip);
+    destinationBuffer += packClipValueToTwoByte(destinationBuffer, _farClip);
+    memcpy(destinationBuffer, &_centerSphereRadius, sizeof(_centerSphereRadius));
+
+    return data;
+}
+
+bool ViewFrustum::fromByteArray(const QByteArray& data) {
+    if (data.size() < SERIALIZED_FRUSTUM_BYTES) {
+        return false;
+    }
+
+    const unsigned char* sourceBuffer = reinterpret_cast<const unsigned char*>(data.constData());
+
+    glm::vec3 position;
+    glm::quat orientation;
+    float fieldOfView, aspectRatio, nearClip, farClip, centerSphereRadius;
+
+    memcpy(&position, sourceBuffer, sizeof(position));
+    sourceBuffer += sizeof(position);
+    sourceBuffer += unpackOrientationQuatFromBytes(sourceBuffer, orientation);
+    sourceBuffer += unpackFloatAngleFromTwoByte(reinterpret_cast<const uint16_t*>(sourceBuffer), &fieldOfView);
+    sourceBuffer += unpackFloatRatioFromTwoByte(sourceBuffer, aspectRatio);
+    sourceBuffer += unpackClipValueFromTwoByte(sourceBuffer, nearClip);
+    sourceBuffer += unpackClipValueFromTwoByte(sourceBuffer, farClip);
+    memcpy(&centerSphereRadius, sourceBuffer, sizeof(centerSphereRadius));
+
+    if (isNaN(position) || fieldOfView <= 0.0f || aspectRatio <= 0.0f || nearClip <= 0.0f || farClip <= nearClip) {
+        return false;
+    }
+
+    setPosition(position);
+    setOrientation(orientation);
+    setCenterRadius(centerSphereRadius);
+    setProjection(glm::perspective(glm::radians(fieldOfView), aspectRatio, nearClip, farClip));
+    calculate();
+
+    return true;
+}
@@ -17,6 +17,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include <QtCore/QByteArray>
+
 #include "AABox.h"
 #include "AACube.h"
 #include "CubeProjectedPolygon.h"
@@ -107,6 +109,14 @@ public:
     bool cubeIntersectsKeyhole(const AACube& cube) const;
     bool boxIntersectsKeyhole(const AABox& box) const;
 
+    // Batch forms of the frustum and keyhole tests, for many boxes at once, given as arrays of the parts of their
+    // corners and of their scales. They are tested four at a time with SSE where it is available, and each result is
+    // what the test above gives for that box, up to rounding on the boundary.
+    void calculateBoxesFrustumIntersection(int count, const float* cornerX, const float* cornerY, const float* cornerZ,
+        const float* scaleX, const float* scaleY, const float* scaleZ, intersection* results) const;
+    void calculateCubesKeyholeIntersection(int count, const float* cornerX, const float* cornerY, const float* cornerZ,
+        const float* scale, intersection* results) const;
+
     // some frustum comparisons
     bool matches(const ViewFrustum& compareTo, bool debug = false) const;
     bool matches(const ViewFrustum* compareTo, bool debug = false) const { return matches(*compareTo, debug); }
@@ -124,6 +134,7 @@ public:
 
     glm::vec2 projectPoint(glm::vec3 point, bool& pointInView) const;
     CubeProjectedPolygon getProjectedPolygon(const AACube& box) const;
+    CubeProjectedPolygon getProjectedPolygon(const AABox& box) const;
     void getFurthestPointFromCamera(const AACube& box, glm::vec3& furthestPoint) const;
 
     float distanceToCamera(const glm::vec3& point) const;
@@ -136,7 +147,17 @@ public:
     const ::Plane* getPlanes() const { return _planes; }
 
     void invalidate(); // causes all reasonable intersection tests to fail
+
+    // packs the camera and lens details, so that another node can rebuild this frustum
+    QByteArray toByteArray() const;
+
+    // rebuilds and calculates the frustum from toByteArray data
+    // returns false and leaves the frustum as it was when the data is short or describes no usable lens
+    bool fromByteArray(const QByteArray& data);
 private:
+    // INSIDE when the cube is within the central sphere, else INTERSECT or OUTSIDE for whether it touches it
+    ViewFrustum::intersection calculateCubeSphereIntersection(const AACube& cube) const;
+
     glm::mat4 _view;
     glm::mat4 _projection;
 
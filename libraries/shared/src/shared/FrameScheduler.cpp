@@ -0,0 +1,82 @@
+//
+//  FrameScheduler.cpp
+//  libraries/shared/src/shared
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameScheduler.h"
+
+#include "../SharedUtil.h"
+
+void FrameScheduler::post(const QString& key, Work work) {
+    auto now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!key.isEmpty()) {
+        auto keyed = _keyed.find(key);
+        if (keyed != _keyed.end()) {
+            keyed.value()->work = work;
+            return;
+        }
+    }
+    _queue.push_back({ key, work, now });
+    if (!key.isEmpty()) {
+        _keyed.insert(key, std::prev(_queue.end()));
+    }
+}
+
+void FrameScheduler::cancel(const QString& key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto keyed = _keyed.find(key);
+    if (keyed != _keyed.end()) {
+        _queue.erase(keyed.value());
+        _keyed.erase(keyed);
+    }
+}
+
+void FrameScheduler::run(uint64_t budgetUsecs) {
+    auto start = usecTimestampNow();
+    auto now = start;
+    uint32_t numRun = 0;
+    do {
+        Work work;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_queue.empty()) {
+                break;
+            }
+            auto& entry = _queue.front();
+            work.swap(entry.work);
+            if (!entry.key.isEmpty()) {
+                _keyed.remove(entry.key);
+            }
+            _queue.pop_front();
+        }
+        // the work may post more, the lock isn't held while it runs
+        if (work) {
+            work();
+        }
+        ++numRun;
+        now = usecTimestampNow();
+    } while (now - start < budgetUsecs);
+
+    _numRunLastFrame = numRun;
+    _usecsLastFrame = now - start;
+}
+
+size_t FrameScheduler::getBacklog() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queue.size();
+}
+
+uint64_t FrameScheduler::getOldestWait() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_queue.empty()) {
+        return 0;
+    }
+    return usecTimestampNow() - _queue.front().queuedTime;
+}
@@ -0,0 +1,69 @@
+//
+//  FrameScheduler.h
+//  libraries/shared/src/shared
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_Shared_FrameScheduler_h
+#define hifi_Shared_FrameScheduler_h
+
+#include <stdint.h>
+#include <functional>
+#include <list>
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+#include "../DependencyManager.h"
+
+// The work of the main thread that can wait for a later frame, run at the end of each update within a budget of time,
+// so a burst of it is spread over the next frames instead of dropping one.
+// Work is run oldest first and at least one item runs per frame, so none of it waits forever.
+class FrameScheduler : public Dependency {
+    SINGLETON_DEPENDENCY
+
+public:
+    using Work = std::function<void()>;
+
+    // Queues work for a frame to come.
+    // The work still queued under the same key is replaced, in its place in the queue: only the newest of it runs.
+    void post(const QString& key, Work work);
+    void post(Work work) { post(QString(), work); }
+    // Drops the work queued under the key, if it hasn't run yet
+    void cancel(const QString& key);
+
+    // On the main thread, once per frame
+    void run(uint64_t budgetUsecs);
+
+    size_t getBacklog() const;
+    // How long the oldest of the queued work has been waiting, in usecs
+    uint64_t getOldestWait() const;
+    // What the last run did
+    uint32_t getNumRunLastFrame() const { return _numRunLastFrame; }
+    uint64_t getUsecsLastFrame() const { return _usecsLastFrame; }
+
+private:
+    struct Entry {
+        QString key;
+        Work work;
+        uint64_t queuedTime;
+    };
+    using Queue = std::list<Entry>;
+
+    mutable std::mutex _mutex;
+    Queue _queue;
+    QHash<QString, Queue::iterator> _keyed;
+
+    uint32_t _numRunLastFrame { 0 };
+    uint64_t _usecsLastFrame { 0 };
+};
+
+#endif // hifi_Shared_FrameScheduler_h
@@ -0,0 +1,161 @@
+//
+//  FrameTimingRing.cpp
+//  libraries/shared/src/shared
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameTimingRing.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTextStream>
+
+#include "../SharedUtil.h"
+
+static const char* STAGE_NAMES[FrameTimingRing::NUM_STAGES] = {
+    "updateBegin",
+    "updateEnd",
+    "recordBegin",
+    "recordEnd",
+    "executeBegin",
+    "executeEnd",
+    "presentBegin",
+    "presentEnd",
+};
+
+// the stages of the trace, the stage they begin with is followed by the one they end with
+struct TraceSpan {
+    const char* name;
+    FrameTimingRing::Stage begin;
+    int thread;
+};
+static const TraceSpan TRACE_SPANS[] = {
+    { "update", FrameTimingRing::UPDATE_BEGIN, 1 },
+    { "record", FrameTimingRing::RECORD_BEGIN, 1 },
+    { "execute", FrameTimingRing::EXECUTE_BEGIN, 2 },
+    { "present", FrameTimingRing::PRESENT_BEGIN, 2 },
+};
+
+const char* FrameTimingRing::getStageName(Stage stage) {
+    return STAGE_NAMES[stage];
+}
+
+FrameTimingRing::FrameTiming& FrameTimingRing::getFrameTiming(uint32_t frameIndex) {
+    auto& frame = _frames[frameIndex % NUM_FRAMES];
+    if (frame.frameIndex != frameIndex) {
+        frame = FrameTiming();
+        frame.frameIndex = frameIndex;
+    }
+    return frame;
+}
+
+void FrameTimingRing::mark(uint32_t frameIndex, Stage stage) {
+    if (frameIndex == INVALID_FRAME) {
+        return;
+    }
+    auto now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& frame = getFrameTiming(frameIndex);
+    if (stage == PRESENT_END) {
+        frame.numPresents++;
+    }
+    if (frame.timestamps[stage] == 0) {
+        frame.timestamps[stage] = now;
+    }
+}
+
+void FrameTimingRing::markVsyncMiss(uint32_t frameIndex) {
+    if (frameIndex == INVALID_FRAME) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    getFrameTiming(frameIndex).numVsyncMisses++;
+}
+
+std::vector<FrameTimingRing::FrameTiming> FrameTimingRing::getFrameTimings() const {
+    std::vector<FrameTiming> result;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        result.reserve(NUM_FRAMES);
+        for (const auto& frame : _frames) {
+            if (frame.frameIndex != INVALID_FRAME) {
+                result.push_back(frame);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const FrameTiming& a, const FrameTiming& b) {
+        return a.frameIndex < b.frameIndex;
+    });
+    return result;
+}
+
+QString FrameTimingRing::toCSV() const {
+    QString result;
+    QTextStream stream(&result);
+    stream << "frame";
+    for (int stage = 0; stage < NUM_STAGES; stage++) {
+        stream << "," << STAGE_NAMES[stage];
+    }
+    stream << ",presents,vsyncMisses\n";
+
+    for (const auto& frame : getFrameTimings()) {
+        stream << frame.frameIndex;
+        for (int stage = 0; stage < NUM_STAGES; stage++) {
+            stream << "," << frame.timestamps[stage];
+        }
+        stream << "," << frame.numPresents << "," << frame.numVsyncMisses << "\n";
+    }
+    stream.flush();
+    return result;
+}
+
+QByteArray FrameTimingRing::toChromeTrace() const {
+    QJsonArray events;
+    for (const auto& frame : getFrameTimings()) {
+        for (const auto& span : TRACE_SPANS) {
+            quint64 begin = frame.timestamps[span.begin];
+            quint64 end = frame.timestamps[span.begin + 1];
+            if (begin == 0 || end < begin) {
+                continue;
+            }
+            QJsonObject event;
+            event["name"] = span.name;
+            event["ph"] = "X";
+            event["ts"] = (double)begin;
+            event["dur"] = (double)(end - begin);
+            event["pid"] = 1;
+            event["tid"] = span.thread;
+            QJsonObject args;
+            args["frame"] = (double)frame.frameIndex;
+            event["args"] = args;
+            events.append(event);
+        }
+        if (frame.numVsyncMisses > 0 && frame.timestamps[PRESENT_END] != 0) {
+            QJsonObject event;
+            event["name"] = "vsyncMiss";
+            event["ph"] = "i";
+            event["s"] = "p";
+            event["ts"] = (double)frame.timestamps[PRESENT_END];
+            event["pid"] = 1;
+            event["tid"] = 2;
+            QJsonObject args;
+            args["frame"] = (double)frame.frameIndex;
+            args["misses"] = (double)frame.numVsyncMisses;
+            event["args"] = args;
+            events.append(event);
+        }
+    }
+
+    QJsonObject trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ms";
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,81 @@
+//
+//  FrameTimingRing.h
+//  libraries/shared/src/shared
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_Shared_FrameTimingRing_h
+#define hifi_Shared_FrameTimingRing_h
+
+#include <stdint.h>
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "../DependencyManager.h"
+
+// The timestamps of the stages of the last frames, from the update on the main thread to the present on the present thread,
+// kept around so a stutter can be looked at after the fact without a profiler attached.
+// The main and the present threads both write to it, one frame at a time, so a single lock is enough.
+class FrameTimingRing : public Dependency {
+    SINGLETON_DEPENDENCY
+
+public:
+    enum Stage {
+        UPDATE_BEGIN = 0,
+        UPDATE_END,
+        RECORD_BEGIN,
+        RECORD_END,
+        EXECUTE_BEGIN,
+        EXECUTE_END,
+        PRESENT_BEGIN,
+        PRESENT_END,
+
+        NUM_STAGES,
+    };
+
+    static const uint32_t INVALID_FRAME = (uint32_t)(~0);
+    static const size_t NUM_FRAMES = 512;
+
+    struct FrameTiming {
+        uint32_t frameIndex { INVALID_FRAME };
+        // usecTimestampNow() of the first time each stage happened, 0 if it didn't
+        std::array<quint64, NUM_STAGES> timestamps;
+        // a frame is presented more than once when the next one isn't ready in time
+        uint32_t numPresents { 0 };
+        uint32_t numVsyncMisses { 0 };
+
+        FrameTiming() { timestamps.fill(0); }
+    };
+
+    void mark(uint32_t frameIndex, Stage stage);
+    void markVsyncMiss(uint32_t frameIndex);
+
+    // The frames still in the ring, oldest first
+    std::vector<FrameTiming> getFrameTimings() const;
+
+    // One line per frame, the timestamps in usecs
+    QString toCSV() const;
+    // The JSON of the Trace Event Format, chrome://tracing loads it
+    QByteArray toChromeTrace() const;
+
+    static const char* getStageName(Stage stage);
+
+private:
+    FrameTiming& getFrameTiming(uint32_t frameIndex);
+
+    mutable std::mutex _mutex;
+    std::array<FrameTiming, NUM_FRAMES> _frames;
+};
+
+#endif // hifi_Shared_FrameTimingRing_h
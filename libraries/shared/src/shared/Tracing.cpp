@@ -0,0 +1,267 @@
+//
+//  Tracing.cpp
+//  libraries/shared/src/shared
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Tracing.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+#include <QtCore/QThreadStorage>
+
+#include "../PortableHighResolutionClock.h"
+
+// number of scopes a thread can record before the drain gets to them
+static const uint32_t NUM_THREAD_EVENTS = 1 << 13;
+// number of drained scopes kept, the oldest go first
+static const size_t MAX_HISTORY_EVENTS = 1 << 20;
+static const std::chrono::milliseconds DRAIN_INTERVAL { 100 };
+
+std::atomic<bool> Tracing::_isEnabled { false };
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+};
+
+// written by its thread only, read by the drain only
+struct ThreadBuffer {
+    std::array<TraceEvent, NUM_THREAD_EVENTS> events;
+    std::atomic<uint32_t> head { 0 };
+    std::atomic<uint32_t> tail { 0 };
+    std::atomic<uint64_t> numDropped { 0 };
+    std::atomic<bool> hasExited { false };
+
+    int threadID { 0 };
+    QString threadName;
+};
+using ThreadBufferPointer = std::shared_ptr<ThreadBuffer>;
+
+struct HistoryEvent {
+    TraceEvent event;
+    int threadID;
+};
+
+struct TraceHistory {
+    std::mutex mutex;
+    std::vector<ThreadBufferPointer> buffers;
+    std::deque<HistoryEvent> events;
+    QHash<int, QString> threadNames;
+    int nextThreadID { 1 };
+    uint64_t numDropped { 0 };
+
+    std::mutex drainMutex;
+    std::condition_variable drainCondition;
+    std::thread drainThread;
+    bool isDraining { false };
+
+    std::mutex namesMutex;
+    std::unordered_set<std::string> names;
+};
+
+TraceHistory& traceHistory() {
+    // intentionally leaked so that it outlives the thread storage of threads torn down during shutdown
+    static TraceHistory* history = new TraceHistory;
+    return *history;
+}
+
+// the thread storage owns a reference, the history another one, so whatever is left is drained after the thread is gone
+struct ThreadBufferHandle {
+    ThreadBufferPointer buffer;
+
+    ~ThreadBufferHandle() { buffer->hasExited = true; }
+};
+
+QThreadStorage<ThreadBufferHandle*> threadBuffers;
+
+ThreadBuffer& localBuffer() {
+    if (!threadBuffers.hasLocalData()) {
+        auto handle = new ThreadBufferHandle;
+        handle->buffer = std::make_shared<ThreadBuffer>();
+
+        QThread* thread = QThread::currentThread();
+        auto& history = traceHistory();
+        std::lock_guard<std::mutex> lock(history.mutex);
+        handle->buffer->threadID = history.nextThreadID++;
+        handle->buffer->threadName = (thread && !thread->objectName().isEmpty()) ?
+            thread->objectName() : QString("Thread %1").arg(handle->buffer->threadID);
+        history.threadNames[handle->buffer->threadID] = handle->buffer->threadName;
+        history.buffers.push_back(handle->buffer);
+
+        threadBuffers.setLocalData(handle);
+    }
+
+    return *threadBuffers.localData()->buffer;
+}
+
+// the caller holds the history lock
+void drainBuffers(TraceHistory& history) {
+    for (auto it = history.buffers.begin(); it != history.buffers.end();) {
+        ThreadBuffer& buffer = **it;
+        bool hasExited = buffer.hasExited;
+        uint32_t tail = buffer.tail.load(std::memory_order_relaxed);
+        uint32_t head = buffer.head.load(std::memory_order_acquire);
+
+        for (; tail != head; ++tail) {
+            history.events.push_back({ buffer.events[tail % NUM_THREAD_EVENTS], buffer.threadID });
+        }
+        buffer.tail.store(tail, std::memory_order_release);
+        history.numDropped += buffer.numDropped.exchange(0, std::memory_order_relaxed);
+
+        if (hasExited) {
+            // everything the thread recorded was in before it exited
+            it = history.buffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    while (history.events.size() > MAX_HISTORY_EVENTS) {
+        history.events.pop_front();
+    }
+}
+
+void runDrain() {
+    auto& history = traceHistory();
+    std::unique_lock<std::mutex> drainLock(history.drainMutex);
+    while (history.isDraining) {
+        history.drainCondition.wait_for(drainLock, DRAIN_INTERVAL);
+
+        std::lock_guard<std::mutex> lock(history.mutex);
+        drainBuffers(history);
+    }
+}
+
+}
+
+void Tracing::setEnabled(bool enabled) {
+    auto& history = traceHistory();
+    std::unique_lock<std::mutex> drainLock(history.drainMutex);
+    if (enabled == history.isDraining) {
+        return;
+    }
+
+    history.isDraining = enabled;
+    _isEnabled.store(enabled);
+
+    if (enabled) {
+        history.drainThread = std::thread(runDrain);
+    } else {
+        drainLock.unlock();
+        history.drainCondition.notify_one();
+        history.drainThread.join();
+    }
+}
+
+uint64_t Tracing::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        p_high_resolution_clock::now().time_since_epoch()).count();
+}
+
+void Tracing::record(const char* name, uint64_t beginNsecs, uint64_t endNsecs) {
+    ThreadBuffer& buffer = localBuffer();
+    uint32_t head = buffer.head.load(std::memory_order_relaxed);
+    uint32_t tail = buffer.tail.load(std::memory_order_acquire);
+    if (head - tail >= NUM_THREAD_EVENTS) {
+        buffer.numDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[head % NUM_THREAD_EVENTS] = { name, beginNsecs, endNsecs };
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+const char* Tracing::internName(const std::string& name) {
+    auto& history = traceHistory();
+    std::lock_guard<std::mutex> lock(history.namesMutex);
+    // the elements of an unordered_set stay where they are when it rehashes
+    return history.names.insert(name).first->c_str();
+}
+
+QByteArray Tracing::toChromeTrace() {
+    auto& history = traceHistory();
+    std::lock_guard<std::mutex> lock(history.mutex);
+    drainBuffers(history);
+
+    static const double NSECS_PER_TRACE_USEC = 1000.0;
+
+    QJsonArray events;
+    for (auto it = history.threadNames.constBegin(); it != history.threadNames.constEnd(); ++it) {
+        QJsonObject event;
+        event["name"] = "thread_name";
+        event["ph"] = "M";
+        event["pid"] = 1;
+        event["tid"] = it.key();
+        QJsonObject args;
+        args["name"] = it.value();
+        event["args"] = args;
+        events.append(event);
+    }
+
+    for (const auto& historyEvent : history.events) {
+        QJsonObject event;
+        event["name"] = historyEvent.event.name;
+        event["ph"] = "X";
+        event["ts"] = (double)historyEvent.event.begin / NSECS_PER_TRACE_USEC;
+        event["dur"] = (double)(historyEvent.event.end - historyEvent.event.begin) / NSECS_PER_TRACE_USEC;
+        event["pid"] = 1;
+        event["tid"] = historyEvent.threadID;
+        events.append(event);
+    }
+
+    QJsonObject trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ns";
+    QJsonObject metadata;
+    metadata["dropped"] = (double)history.numDropped;
+    trace["otherData"] = metadata;
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
+bool Tracing::saveChromeTrace(const QString& filename) {
+    QByteArray data = toChromeTrace();
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Tracing: couldn't write" << filename;
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
+void Tracing::clear() {
+    auto& history = traceHistory();
+    std::lock_guard<std::mutex> lock(history.mutex);
+    drainBuffers(history);
+    history.events.clear();
+    history.numDropped = 0;
+}
+
+uint64_t Tracing::getNumDropped() {
+    auto& history = traceHistory();
+    std::lock_guard<std::mutex> lock(history.mutex);
+    return history.numDropped;
+}
@@ -0,0 +1,75 @@
+//
+//  Tracing.h
+//  libraries/shared/src/shared
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_Shared_Tracing_h
+#define hifi_Shared_Tracing_h
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+// Scopes timed to the nanosecond, cheap enough to leave in the frames of the mixers, the send threads and the render jobs.
+// Each thread records into a buffer of its own without taking a lock, a drain thread moves what they recorded into a
+// bounded history every so often while tracing is on, and the history goes out in the Trace Event Format.
+// The scopes nest by time on each thread, chrome://tracing and Perfetto show them as a hierarchy.
+//
+// A thread that records faster than the drain keeps up with drops the scopes that don't fit, they are counted.
+class Tracing {
+public:
+    // The drain thread runs while tracing is on, turning it off keeps what was recorded until the next clear
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return _isEnabled.load(std::memory_order_relaxed); }
+
+    // Nanoseconds of a steady clock
+    static uint64_t now();
+
+    // The name has to outlive the trace, only the pointer is kept: use a string literal
+    static void record(const char* name, uint64_t beginNsecs, uint64_t endNsecs);
+    // A copy of a name known only at runtime that lives as long as the process, to get once and keep
+    static const char* internName(const std::string& name);
+
+    // The JSON of the Trace Event Format, of the scopes in the history, oldest first
+    static QByteArray toChromeTrace();
+    static bool saveChromeTrace(const QString& filename);
+    static void clear();
+
+    static uint64_t getNumDropped();
+
+private:
+    static std::atomic<bool> _isEnabled;
+};
+
+// Records the time from its construction to its destruction, if tracing is on when it is constructed
+class TraceScope {
+public:
+    TraceScope(const char* name) : _name(name), _begin(Tracing::isEnabled() ? Tracing::now() : 0) {}
+    ~TraceScope() {
+        if (_begin != 0) {
+            Tracing::record(_name, _begin, Tracing::now());
+        }
+    }
+
+private:
+    const char* _name;
+    uint64_t _begin;
+};
+
+#define TRACE_SCOPE_CONCAT_INNER(a, b) a ## b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT_INNER(a, b)
+// The name is a string literal, as in TRACE_SCOPE("AvatarMixer::broadcastAvatarData")
+#define TRACE_SCOPE(name) TraceScope TRACE_SCOPE_CONCAT(traceScope, __LINE__)(name)
+
+#endif // hifi_Shared_Tracing_h
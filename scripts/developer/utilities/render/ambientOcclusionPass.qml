@@ -28,6 +28,7 @@ Column {
                     "Falloff Bias:falloffBias:0.2:false",
                     "Edge Sharpness:edgeSharpness:1.0:false",
                     "Blur Radius:blurRadius:10.0:false",
+                    "Temporal Blend:temporalBlend:1.0:false",
                 ]
                 ConfigSlider {
                     label: qsTr(modelData.split(":")[0])
@@ -46,7 +47,9 @@ Column {
                         "resolutionLevel:resolutionLevel",
                         "ditheringEnabled:ditheringEnabled",
                         "fetchMipsEnabled:fetchMipsEnabled",
-                        "borderingEnabled:borderingEnabled"
+                        "borderingEnabled:borderingEnabled",
+                        "temporalEnabled:temporalEnabled",
+                        "upsampleEnabled:upsampleEnabled"
                     ]
                     CheckBox {
                         text: qsTr(modelData.split(":")[0])
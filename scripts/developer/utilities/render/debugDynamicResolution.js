@@ -0,0 +1,19 @@
+//
+//  debugDynamicResolution.js
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or https://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+// Set up the qml ui
+var qml = Script.resolvePath('dynamicResolution.qml');
+var window = new OverlayWindow({
+    title: 'Dynamic Resolution',
+    source: qml,
+    width: 400, height: 250,
+});
+window.setPosition(250, 800);
+window.closed.connect(function() { Script.stop(); });
@@ -61,6 +61,7 @@ Column {
                      "Directional:LightingModel:enableDirectionalLight",
                      "Point:LightingModel:enablePointLight",
                      "Spot:LightingModel:enableSpotLight",
+                     "Clustered:LightingModel:enableClusteredLights",
                      "Light Contour:LightingModel:showLightContour"
                 ]
                 CheckBox {
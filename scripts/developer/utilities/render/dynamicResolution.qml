@@ -0,0 +1,78 @@
+//
+//  dynamicResolution.qml
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or https://www.apache.org/licenses/LICENSE-2.0.html
+//
+import QtQuick 2.5
+import QtQuick.Controls 1.4
+import "configSlider"
+import "../lib/plotperf"
+
+Column {
+    spacing: 8
+    Column {
+        id: dynamicResolution
+        spacing: 10
+
+        CheckBox {
+            text: "Auto Adjust"
+            checked: Render.getConfig("DynamicResolution")["autoAdjust"]
+            onCheckedChanged: { Render.getConfig("DynamicResolution")["autoAdjust"] = checked }
+        }
+
+        Column{
+            Repeater {
+                model: [
+                    "Scale:scale:1.0",
+                    "Min Scale:minScale:1.0",
+                    "Max Scale:maxScale:1.0",
+                    "Target GPU Time:targetGPUTime:30.0",
+                    "GPU Budget:gpuBudget:1.0",
+                ]
+                ConfigSlider {
+                    label: qsTr(modelData.split(":")[0])
+                    integral: false
+                    config: Render.getConfig("DynamicResolution")
+                    property: modelData.split(":")[1]
+                    max: modelData.split(":")[2]
+                    min: 0.0
+                }
+            }
+        }
+
+        PlotPerf {
+            title: "Scale"
+            height: 50
+            object: Render.getConfig("DynamicResolution")
+            valueScale: 1
+            valueNumDigits: "2"
+            plots: [
+            {
+                   prop: "currentScale",
+                   label: "scale",
+                   color: "#FFFFFF"
+               }
+            ]
+        }
+
+        PlotPerf {
+            title: "Timing"
+            height: 50
+            object: Render.getConfig("DynamicResolution")
+            valueUnit: "ms"
+            valueScale: 1
+            valueNumDigits: "3"
+            plots: [
+            {
+                   prop: "gpuRunTime",
+                   label: "gpu",
+                   color: "#FFFFFF"
+               }
+            ]
+        }
+    }
+}
@@ -84,6 +84,11 @@ Item {
                     prop: "textureGPUTransferCount",
                     label: "Transfer",
                     color: "#9495FF"
+                },
+                {
+                    prop: "textureGPUStreamingCount",
+                    label: "Streaming",
+                    color: "#E2334D"
                 }
             ]
         }
@@ -109,6 +114,11 @@ Item {
                     prop: "textureGPUVirtualMemoryUsage",
                     label: "GPU Virtual",
                     color: "#9495FF"
+                },
+                {
+                    prop: "textureGPUMeanResidentSize",
+                    label: "GPU Mean Resident",
+                    color: "#E2334D"
                 }
             ]
         }
@@ -173,6 +183,11 @@ Item {
                     prop: "frameSetPipelineCount",
                     label: "Pipelines",
                     color: "#E2334D"
+                },
+                {
+                    prop: "frameCompactedCommandCount",
+                    label: "Compacted",
+                    color: "#1AC567"
                 }
             ]
         }  
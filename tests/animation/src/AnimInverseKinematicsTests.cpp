@@ -28,7 +28,7 @@ const glm::quat identity = glm::quat();
 const glm::quat quaterTurnAroundZ = glm::angleAxis(0.5f * PI, zAxis);
 
 
-void makeTestFBXJoints(FBXGeometry& geometry) {
+void makeTestFBXJoints(FBXGeometry& geometry, int numJoints = 4) {
     FBXJoint joint;
     joint.isFree = false;
     joint.freeLineage.clear();
@@ -55,27 +55,14 @@ void makeTestFBXJoints(FBXGeometry& geometry) {
 
     // we make a list of joints that look like this:
     //
-    // A------>B------>C------>D
+    // A------>B------>C------>D  ...
 
-    joint.name = "A";
-    joint.parentIndex = -1;
-    joint.translation = origin;
-    geometry.joints.push_back(joint);
-
-    joint.name = "B";
-    joint.parentIndex = 0;
-    joint.translation = xAxis;
-    geometry.joints.push_back(joint);
-
-    joint.name = "C";
-    joint.parentIndex = 1;
-    joint.translation = xAxis;
-    geometry.joints.push_back(joint);
-
-    joint.name = "D";
-    joint.parentIndex = 2;
-    joint.translation = xAxis;
-    geometry.joints.push_back(joint);
+    for (int i = 0; i < numJoints; ++i) {
+        joint.name = QString(QChar('A' + i));
+        joint.parentIndex = i - 1;
+        joint.translation = (i == 0) ? origin : xAxis;
+        geometry.joints.push_back(joint);
+    }
 
     // compute each joint's transform
     for (int i = 1; i < (int)geometry.joints.size(); ++i) {
@@ -296,3 +283,65 @@ void AnimInverseKinematicsTests::testBar() {
     QCOMPARE_WITH_ABS_ERROR(expectedTransC, poseC.trans, EPSILON);
 }
 
+
+void AnimInverseKinematicsTests::testSolverTiming_data() {
+    QTest::addColumn<int>("solver");
+    QTest::newRow("ccd") << (int)AnimInverseKinematics::Solver::CyclicCoordinateDescent;
+    QTest::newRow("fabrik") << (int)AnimInverseKinematics::Solver::FABRIK;
+}
+
+void AnimInverseKinematicsTests::testSolverTiming() {
+    // a long straight chain with its tip pulled back toward the middle:
+    //
+    //                         t
+    //
+    //
+    //
+    // A------>B------>C------>D------>E------>F------>G------>H
+    //
+    const int NUM_JOINTS = 8;
+    FBXGeometry geometry;
+    makeTestFBXJoints(geometry, NUM_JOINTS);
+    AnimSkeleton::Pointer skeletonPtr = std::make_shared<AnimSkeleton>(geometry);
+
+    AnimPose pose;
+    pose.scale = glm::vec3(1.0f);
+    pose.rot = identity;
+    pose.trans = origin;
+    AnimPoseVec poses;
+    poses.push_back(pose);
+    pose.trans = xAxis;
+    for (int i = 1; i < NUM_JOINTS; ++i) {
+        poses.push_back(pose);
+    }
+
+    glm::vec3 targetPosition(4.0f, 3.0f, 0.0f);
+    AnimVariantMap varMap;
+    varMap.set("positionH", targetPosition);
+    varMap.set("rotationH", identity);
+    varMap.set("targetType", (int)IKTarget::Type::RotationAndPosition);
+
+    QFETCH(int, solver);
+    AnimInverseKinematics ikDoll("doll");
+    ikDoll.setSkeleton(skeletonPtr);
+    ikDoll.setSolver((AnimInverseKinematics::Solver)solver);
+    ikDoll.setTargetVars(QString("H"), QString("positionH"), QString("rotationH"), QString("targetType"));
+    ikDoll.loadPoses(poses);
+
+    AnimNode::Triggers triggers;
+    float dt = 1.0f / 60.0f;
+    QBENCHMARK {
+        ikDoll.overlay(varMap, dt, triggers, poses);
+    }
+
+    // the solver closes in on the target over frames, however few of them the benchmark ran
+    const int NUM_SETTLE_FRAMES = 1000;
+    for (int frame = 0; frame < NUM_SETTLE_FRAMES; ++frame) {
+        ikDoll.overlay(varMap, dt, triggers, poses);
+    }
+
+    AnimPoseVec absolutePoses = poses;
+    ikDoll.computeAbsolutePoses(absolutePoses);
+    QVERIFY(glm::length(absolutePoses[NUM_JOINTS - 1].trans - targetPosition) < ikDoll.getMaxError());
+    QCOMPARE_WITH_ABS_ERROR(absolutePoses[1].trans, xAxis, EPSILON);
+}
@@ -22,6 +22,8 @@ class AnimInverseKinematicsTests : public QObject {
 private slots:
     void testSingleChain();
     void testBar();
+    void testSolverTiming_data();
+    void testSolverTiming();
 };
 
 #endif // hifi_AnimInverseKinematicsTests_h
@@ -10,6 +10,7 @@
 #include "AnimTests.h"
 #include <AnimNodeLoader.h>
 #include <AnimClip.h>
+#include <AnimClipFrames.h>
 #include <AnimBlendLinear.h>
 #include <AnimationLogging.h>
 #include <AnimVariant.h>
@@ -422,6 +423,105 @@ void AnimTests::testAnimPose() {
     }
 }
 
+void AnimTests::testAnimPoseMultiply() {
+    const float PI = (float)M_PI;
+    std::vector<AnimPose> lhsPoses = {
+        AnimPose::identity,
+        AnimPose(glm::vec3(2.0f), glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(10.0f, 5.0f, 7.5f)),
+        AnimPose(glm::vec3(0.5f), glm::angleAxis(PI / 6.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))), glm::vec3(-1.0f, 2.0f, 0.0f))
+    };
+    std::vector<AnimPose> rhsPoses = {
+        AnimPose::identity,
+        AnimPose(glm::vec3(1.5f), glm::angleAxis(PI / 3.0f, glm::vec3(0.0f, 0.0f, 1.0f)), glm::vec3(0.0f, 1.0f, 0.0f)),
+        AnimPose(glm::vec3(2.0f, 0.5f, 1.5f), glm::angleAxis(-PI / 4.0f, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(3.0f, 0.0f, -2.0f))
+    };
+
+    // with a uniform scale on the left, composing poses has to agree with multiplying their matrices
+    for (auto& lhs : lhsPoses) {
+        for (auto& rhs : rhsPoses) {
+            glm::mat4 expected = static_cast<glm::mat4>(lhs) * static_cast<glm::mat4>(rhs);
+            glm::mat4 actual = lhs * rhs;
+            QCOMPARE_WITH_ABS_ERROR(actual, expected, EPSILON);
+        }
+    }
+}
+
+void AnimTests::testBlend() {
+    const float PI = (float)M_PI;
+    const int NUM_POSES = 11; // not a multiple of the poses blended at once
+    AnimPoseVec a, b;
+    for (int i = 0; i < NUM_POSES; i++) {
+        float angle = PI * (float)i / (float)NUM_POSES;
+        a.push_back(AnimPose(glm::vec3(1.0f + 0.1f * i), glm::angleAxis(angle, glm::vec3(1.0f, 0.0f, 0.0f)),
+                             glm::vec3((float)i, 0.0f, 1.0f)));
+        // every other pose of b is on the other side of the hypersphere, the blend has to take the short way
+        glm::quat rot = glm::angleAxis(angle + 0.5f, glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f)));
+        b.push_back(AnimPose(glm::vec3(2.0f, 1.0f, 0.5f), (i % 2) ? -rot : rot, glm::vec3(0.0f, (float)i, -1.0f)));
+    }
+
+    const float ALPHA = 0.3f;
+    AnimPoseVec result(NUM_POSES);
+    ::blend(NUM_POSES, &a[0], &b[0], ALPHA, &result[0]);
+
+    // blending in place gives the same poses
+    AnimPoseVec inPlace = a;
+    ::blend(NUM_POSES, &inPlace[0], &b[0], ALPHA, &inPlace[0]);
+
+    for (int i = 0; i < NUM_POSES; i++) {
+        glm::quat bRot = glm::dot(a[i].rot, b[i].rot) < 0.0f ? -b[i].rot : b[i].rot;
+        AnimPose expected(a[i].scale * (1.0f - ALPHA) + b[i].scale * ALPHA,
+                          glm::normalize(glm::lerp(a[i].rot, bRot, ALPHA)),
+                          a[i].trans * (1.0f - ALPHA) + b[i].trans * ALPHA);
+        QCOMPARE_WITH_ABS_ERROR(static_cast<glm::mat4>(result[i]), static_cast<glm::mat4>(expected), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(static_cast<glm::mat4>(inPlace[i]), static_cast<glm::mat4>(expected), EPSILON);
+    }
+}
+
+void AnimTests::testClipFrames() {
+    const float PI = (float)M_PI;
+    const int NUM_FRAMES = 60;
+    const int NUM_JOINTS = 20;
+
+    // joint 1 rotates, joint 2 moves and joint 3 grows over the clip, every other joint holds still
+    std::vector<AnimPoseVec> frames(NUM_FRAMES);
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        float t = (float)frame / (float)NUM_FRAMES;
+        for (int joint = 0; joint < NUM_JOINTS; joint++) {
+            frames[frame].push_back(AnimPose(glm::vec3(1.0f), glm::angleAxis(0.1f * joint, glm::vec3(0.0f, 1.0f, 0.0f)),
+                                             glm::vec3(0.0f, 0.1f * joint, 0.0f)));
+        }
+        frames[frame][1].rot = glm::angleAxis(2.0f * PI * t, glm::normalize(glm::vec3(1.0f, 2.0f, 0.5f)));
+        frames[frame][2].trans = glm::vec3(3.0f * t, -1.0f, 0.5f * sinf(2.0f * PI * t));
+        frames[frame][3].scale = glm::vec3(1.0f + t);
+    }
+
+    AnimClipFrames clipFrames(frames);
+    QCOMPARE(clipFrames.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(clipFrames.getNumJoints(), NUM_JOINTS);
+    QVERIFY(clipFrames.getMemorySize() < NUM_FRAMES * NUM_JOINTS * sizeof(AnimPose) / 10);
+
+    AnimPoseVec decoded(NUM_JOINTS);
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        clipFrames.decodeFrame(frame, &decoded[0]);
+        for (int joint = 0; joint < NUM_JOINTS; joint++) {
+            QCOMPARE_WITH_ABS_ERROR(static_cast<glm::mat4>(decoded[joint]), static_cast<glm::mat4>(frames[frame][joint]),
+                                    EPSILON);
+        }
+    }
+
+    // sampling between two frames is a blend of them
+    const float ALPHA = 0.25f;
+    AnimPoseVec sampled, scratch;
+    clipFrames.sample(10, 11, ALPHA, sampled, scratch);
+    QCOMPARE((int)sampled.size(), NUM_JOINTS);
+    AnimPoseVec expected(NUM_JOINTS);
+    ::blend(NUM_JOINTS, &frames[10][0], &frames[11][0], ALPHA, &expected[0]);
+    for (int joint = 0; joint < NUM_JOINTS; joint++) {
+        QCOMPARE_WITH_ABS_ERROR(static_cast<glm::mat4>(sampled[joint]), static_cast<glm::mat4>(expected[joint]),
+                                EPSILON);
+    }
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -27,6 +27,9 @@ private slots:
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testAnimPoseMultiply();
+    void testBlend();
+    void testClipFrames();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
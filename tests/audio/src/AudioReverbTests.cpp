@@ -0,0 +1,103 @@
+//
+//  AudioReverbTests.cpp
+//  tests/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioReverbTests.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioReverb.h>
+
+QTEST_MAIN(AudioReverbTests)
+
+static const int SAMPLE_RATE = 48000;
+
+// one second of noise, then enough silence to hear the tail
+static const int NUM_FRAMES = 3 * SAMPLE_RATE;
+
+// deterministic noise in [-1, 1)
+static std::vector<float> makeInput() {
+    std::vector<float> samples(2 * NUM_FRAMES, 0.0f);
+    uint32_t state = 12345;
+    for (int i = 0; i < 2 * SAMPLE_RATE; i++) {
+        state = state * 1664525 + 1013904223;
+        samples[i] = (int32_t)state * (1.0f / 2147483648.0f);
+    }
+    return samples;
+}
+
+static void setParameters(AudioReverb& reverb, float roomSize, float density) {
+    ReverbParameters p;
+    reverb.getParameters(&p);
+    p.roomSize = roomSize;
+    p.density = density;
+    p.wetDryMix = 70.0f;
+    reverb.setParameters(&p);
+}
+
+// renders in place, in blocks of blockSize frames, or of varying size when blockSize is 0
+static void render(AudioReverb& reverb, std::vector<float>& samples, int blockSize) {
+    int numFrames = (int)samples.size() / 2;
+    for (int i = 0, k = 0; i < numFrames; k++) {
+        int n = blockSize ? blockSize : 1 + (k * 37) % 300;
+        n = std::min(n, numFrames - i);
+        reverb.render(&samples[2 * i], &samples[2 * i], n);
+        i += n;
+    }
+}
+
+void AudioReverbTests::blockSizes() {
+    const std::vector<float> input = makeInput();
+
+    // the smallest room and density take the shortest delays, where less of the network is vectorized
+    const float settings[][2] = { { 50.0f, 100.0f }, { 0.0f, 0.0f }, { 100.0f, 30.0f } };
+
+    for (auto& setting : settings) {
+        AudioReverb reference(SAMPLE_RATE);
+        setParameters(reference, setting[0], setting[1]);
+        std::vector<float> expected = input;
+        render(reference, expected, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        // the output must not depend on how the frames are split up
+        const int blockSizes[] = { 1, 7, 240, 512, 0 };
+        for (int blockSize : blockSizes) {
+            AudioReverb reverb(SAMPLE_RATE);
+            setParameters(reverb, setting[0], setting[1]);
+            std::vector<float> output = input;
+            render(reverb, output, blockSize);
+            QVERIFY(memcmp(output.data(), expected.data(), output.size() * sizeof(float)) == 0);
+        }
+    }
+}
+
+void AudioReverbTests::renderBenchmark() {
+    const std::vector<float> input = makeInput();
+
+    // about one second of network frames, in the int16_t format the client renders
+    const int numFrames = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    const int numBlocks = SAMPLE_RATE / numFrames;
+
+    std::vector<int16_t> samples(2 * numFrames * numBlocks);
+    std::vector<int16_t> output(2 * numFrames * numBlocks);
+    for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = (int16_t)(input[i] * 16384.0f);
+    }
+
+    AudioReverb reverb(SAMPLE_RATE);
+    QBENCHMARK {
+        for (size_t i = 0; i < samples.size(); i += 2 * numFrames) {
+            reverb.render(&samples[i], &output[i], numFrames);
+        }
+    }
+}
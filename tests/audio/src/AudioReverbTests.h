@@ -0,0 +1,25 @@
+//
+//  AudioReverbTests.h
+//  tests/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioReverbTests_h
+#define hifi_AudioReverbTests_h
+
+#include <QtTest/QtTest>
+
+class AudioReverbTests : public QObject {
+    Q_OBJECT
+private slots:
+    void blockSizes();
+
+    void renderBenchmark();
+};
+
+#endif // hifi_AudioReverbTests_h
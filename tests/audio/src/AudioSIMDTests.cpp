@@ -0,0 +1,251 @@
+//
+//  AudioSIMDTests.cpp
+//  tests/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSIMDTests.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <AudioHRTF.h>
+#include <CPUDetect.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(AudioSIMDTests)
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#define HAVE_AVX2_KERNELS
+
+void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames);
+void interpolate_AVX2(float* dst, const float* src0, const float* src1, float frac, float gain);
+void peaklog2_stereo_AVX2(float* input, int32_t* output, const int32_t table[][3], int numFrames);
+void applyGain_stereo_AVX2(float* input, float* gain, float* dither, int16_t* output, int numFrames);
+
+#define SKIP_WITHOUT_AVX2() \
+    if (!cpuSupportsAVX2()) { \
+        QSKIP("CPU does not support AVX2"); \
+    }
+
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#define HAVE_NEON_KERNELS
+
+void FIR_1x4_NEON(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void crossfade_4x2_NEON(float* src, float* dst, const float* win, int numFrames);
+void interpolate_NEON(float* dst, const float* src0, const float* src1, float frac, float gain);
+void applyGain_stereo_NEON(float* input, float* gain, float* dither, int16_t* output, int numFrames);
+
+#endif
+
+static const float EPSILON = 1.0e-5f;
+
+// deterministic noise in [-1, 1)
+static float noise() {
+    static uint32_t state = 12345;
+    state = state * 1664525 + 1013904223;
+    return (int32_t)state * (1.0f / 2147483648.0f);
+}
+
+static float maxError(const float* a, const float* b, int count) {
+    float error = 0.0f;
+    for (int i = 0; i < count; i++) {
+        error = std::max(error, fabsf(a[i] - b[i]));
+    }
+    return error;
+}
+
+void AudioSIMDTests::hrtfFIR() {
+#if defined(HAVE_AVX2_KERNELS) || defined(HAVE_NEON_KERNELS)
+    const int numFrames = HRTF_BLOCK;
+
+    float input[HRTF_TAPS - 1 + numFrames];
+    float coef[4][HRTF_TAPS];
+    for (auto& x : input) {
+        x = noise();
+    }
+    for (int k = 0; k < HRTF_TAPS; k++) {
+        for (int ch = 0; ch < 4; ch++) {
+            coef[ch][k] = 0.1f * noise();
+        }
+    }
+    float* src = &input[HRTF_TAPS - 1];
+
+    float expected[4][numFrames];
+    for (int ch = 0; ch < 4; ch++) {
+        for (int i = 0; i < numFrames; i++) {
+            float sum = 0.0f;
+            for (int k = 0; k < HRTF_TAPS; k++) {
+                sum += coef[ch][k] * src[i - k];
+            }
+            expected[ch][i] = sum;
+        }
+    }
+
+    float actual[4][numFrames];
+#ifdef HAVE_AVX2_KERNELS
+    SKIP_WITHOUT_AVX2();
+    FIR_1x4_AVX2(src, actual[0], actual[1], actual[2], actual[3], coef, numFrames);
+#else
+    FIR_1x4_NEON(src, actual[0], actual[1], actual[2], actual[3], coef, numFrames);
+#endif
+
+    for (int ch = 0; ch < 4; ch++) {
+        QCOMPARE_WITH_ABS_ERROR(maxError(actual[ch], expected[ch], numFrames), 0.0f, EPSILON);
+    }
+#else
+    QSKIP("no vectorized kernels on this architecture");
+#endif
+}
+
+void AudioSIMDTests::hrtfCrossfade() {
+#if defined(HAVE_AVX2_KERNELS) || defined(HAVE_NEON_KERNELS)
+    const int numFrames = HRTF_BLOCK;
+
+    float src[4 * numFrames];
+    float win[numFrames];
+    float expected[2 * numFrames];
+    float actual[2 * numFrames];
+    for (auto& x : src) {
+        x = noise();
+    }
+    for (int i = 0; i < numFrames; i++) {
+        win[i] = (float)i / numFrames;
+        expected[2*i+0] = actual[2*i+0] = noise();
+        expected[2*i+1] = actual[2*i+1] = noise();
+    }
+
+    for (int i = 0; i < numFrames; i++) {
+        expected[2*i+0] += src[4*i+0] * win[i] + src[4*i+2] * (1.0f - win[i]);
+        expected[2*i+1] += src[4*i+1] * win[i] + src[4*i+3] * (1.0f - win[i]);
+    }
+
+#ifdef HAVE_AVX2_KERNELS
+    SKIP_WITHOUT_AVX2();
+    crossfade_4x2_AVX2(src, actual, win, numFrames);
+#else
+    crossfade_4x2_NEON(src, actual, win, numFrames);
+#endif
+
+    QCOMPARE_WITH_ABS_ERROR(maxError(actual, expected, 2 * numFrames), 0.0f, EPSILON);
+#else
+    QSKIP("no vectorized kernels on this architecture");
+#endif
+}
+
+void AudioSIMDTests::hrtfInterpolate() {
+#if defined(HAVE_AVX2_KERNELS) || defined(HAVE_NEON_KERNELS)
+    float src0[HRTF_TAPS];
+    float src1[HRTF_TAPS];
+    for (int k = 0; k < HRTF_TAPS; k++) {
+        src0[k] = noise();
+        src1[k] = noise();
+    }
+    const float frac = 0.3f;
+    const float gain = 0.8f;
+
+    float expected[HRTF_TAPS];
+    for (int k = 0; k < HRTF_TAPS; k++) {
+        expected[k] = HRTF_GAIN * gain * ((1.0f - frac) * src0[k] + frac * src1[k]);
+    }
+
+    float actual[HRTF_TAPS];
+#ifdef HAVE_AVX2_KERNELS
+    SKIP_WITHOUT_AVX2();
+    interpolate_AVX2(actual, src0, src1, frac, gain);
+#else
+    interpolate_NEON(actual, src0, src1, frac, gain);
+#endif
+
+    QCOMPARE_WITH_ABS_ERROR(maxError(actual, expected, HRTF_TAPS), 0.0f, EPSILON);
+#else
+    QSKIP("no vectorized kernels on this architecture");
+#endif
+}
+
+void AudioSIMDTests::limiterPeakLog2() {
+#ifdef HAVE_AVX2_KERNELS
+    SKIP_WITHOUT_AVX2();
+
+    // any table will do, the kernel has to match the scalar arithmetic exactly
+    int32_t table[16][3];
+    for (auto& row : table) {
+        row[0] = (int32_t)(0x40000000 * noise());
+        row[1] = (int32_t)(0x40000000 * noise());
+        row[2] = (int32_t)(0x40000000 * noise());
+    }
+
+    const int numFrames = 256;
+    float input[2 * numFrames];
+    for (int i = 0; i < 2 * numFrames; i++) {
+        // cover the saturated range too
+        input[i] = noise() * powf(2.0f, (float)(i % 40) - 24.0f);
+    }
+
+    int32_t actual[numFrames];
+    peaklog2_stereo_AVX2(input, actual, table, numFrames);
+
+    for (int n = 0; n < numFrames; n++) {
+        int32_t u0, u1;
+        memcpy(&u0, &input[2*n+0], sizeof(u0));
+        memcpy(&u1, &input[2*n+1], sizeof(u1));
+        int32_t peak = std::max(u0 & 0x7fffffff, u1 & 0x7fffffff);
+
+        int32_t e = 127 - (peak >> 23) + 15;
+        int32_t x = (peak << 8) & 0x7fffffff;
+        int32_t expected = 0x7fffffff;
+        if (e <= 31) {
+            int k = x >> 27;
+            int32_t c1 = table[k][1] + (int32_t)(((int64_t)table[k][0] * x) >> 32);
+            int32_t c2 = table[k][2] + (int32_t)(((int64_t)c1 * x) >> 32);
+            expected = (e << 26) - (c2 >> 3);
+        }
+        QCOMPARE(actual[n], expected);
+    }
+#else
+    QSKIP("no vectorized peak detection on this architecture");
+#endif
+}
+
+void AudioSIMDTests::limiterApplyGain() {
+#if defined(HAVE_AVX2_KERNELS) || defined(HAVE_NEON_KERNELS)
+    const int numFrames = 256;
+
+    float input[2 * numFrames];
+    float gain[numFrames];
+    float dither[numFrames];
+    for (int n = 0; n < numFrames; n++) {
+        input[2*n+0] = 32767.0f * noise();
+        input[2*n+1] = 32767.0f * noise();
+        gain[n] = 0.5f * (noise() + 1.0f);
+        dither[n] = noise();
+    }
+
+    int16_t actual[2 * numFrames];
+#ifdef HAVE_AVX2_KERNELS
+    SKIP_WITHOUT_AVX2();
+    applyGain_stereo_AVX2(input, gain, dither, actual, numFrames);
+#else
+    applyGain_stereo_NEON(input, gain, dither, actual, numFrames);
+#endif
+
+    // rounding may differ in the last bit
+    for (int i = 0; i < 2 * numFrames; i++) {
+        float expected = input[i] * gain[i/2] + dither[i/2];
+        QCOMPARE_WITH_ABS_ERROR((float)actual[i], expected, 0.5f + EPSILON * 32768.0f);
+    }
+#else
+    QSKIP("no vectorized kernels on this architecture");
+#endif
+}
@@ -0,0 +1,28 @@
+//
+//  AudioSIMDTests.h
+//  tests/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSIMDTests_h
+#define hifi_AudioSIMDTests_h
+
+#include <QtTest/QtTest>
+
+// checks the vectorized HRTF and limiter kernels against scalar reference code
+class AudioSIMDTests : public QObject {
+    Q_OBJECT
+private slots:
+    void hrtfFIR();
+    void hrtfCrossfade();
+    void hrtfInterpolate();
+    void limiterPeakLog2();
+    void limiterApplyGain();
+};
+
+#endif // hifi_AudioSIMDTests_h
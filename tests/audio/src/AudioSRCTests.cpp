@@ -0,0 +1,111 @@
+//
+//  AudioSRCTests.cpp
+//  tests/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSRCTests.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <AudioSRC.h>
+
+QTEST_MAIN(AudioSRCTests)
+
+// one second of deterministic noise at the input rate, in int16_t
+static std::vector<int16_t> makeInput(int sampleRate, int numChannels) {
+    std::vector<int16_t> samples(numChannels * sampleRate);
+    uint32_t state = 12345;
+    for (auto& sample : samples) {
+        state = state * 1664525 + 1013904223;
+        sample = (int16_t)((int32_t)state >> 17);
+    }
+    return samples;
+}
+
+// the rates the client and the injectors convert between: rational ratios both ways, and an irrational one
+static void addRateRows() {
+    QTest::addColumn<int>("inputRate");
+    QTest::addColumn<int>("outputRate");
+    QTest::addColumn<int>("numChannels");
+
+    const int rates[][2] = { { 24000, 48000 }, { 48000, 24000 }, { 44100, 48000 }, { 48000, 44100 }, { 48000, 47999 } };
+    for (auto& rate : rates) {
+        for (int numChannels = 1; numChannels <= 2; numChannels++) {
+            QString name = QString("%1-%2-%3ch").arg(rate[0]).arg(rate[1]).arg(numChannels);
+            QTest::newRow(name.toUtf8().constData()) << rate[0] << rate[1] << numChannels;
+        }
+    }
+}
+
+void AudioSRCTests::formatsAgree_data() {
+    addRateRows();
+}
+
+// the int16_t and float formats go through different conversions in front of the same filter,
+// so they must agree but for the rounding and dither of the int16_t output
+void AudioSRCTests::formatsAgree() {
+    QFETCH(int, inputRate);
+    QFETCH(int, outputRate);
+    QFETCH(int, numChannels);
+
+    const std::vector<int16_t> input = makeInput(inputRate, numChannels);
+    std::vector<float> inputFloat(input.size());
+    for (size_t i = 0; i < input.size(); i++) {
+        inputFloat[i] = input[i] * (1/32768.0f);
+    }
+
+    AudioSRC srcInt16(inputRate, outputRate, numChannels);
+    AudioSRC srcFloat(inputRate, outputRate, numChannels);
+
+    // blocks of odd sizes, to go through the remainders of the vector loops
+    const int blockFrames = 331;
+    const int numFrames = (int)input.size() / numChannels;
+    std::vector<int16_t> output(numChannels * srcInt16.getMaxOutput(blockFrames));
+    std::vector<float> outputFloat(numChannels * srcFloat.getMaxOutput(blockFrames));
+
+    int maxError = 0;
+    for (int i = 0; i < numFrames; i += blockFrames) {
+        int n = std::min(blockFrames, numFrames - i);
+        int no = srcInt16.render(&input[numChannels * i], output.data(), n);
+        QCOMPARE(srcFloat.render(&inputFloat[numChannels * i], outputFloat.data(), n), no);
+
+        for (int k = 0; k < numChannels * no; k++) {
+            float expected = std::max(std::min(outputFloat[k] * 32768.0f, 32767.0f), -32768.0f);
+            maxError = std::max(maxError, abs(output[k] - (int)expected));
+        }
+    }
+    QVERIFY(maxError <= 2);
+}
+
+void AudioSRCTests::renderBenchmark_data() {
+    addRateRows();
+}
+
+// one second of network frames, in the int16_t format the client and the injectors render
+void AudioSRCTests::renderBenchmark() {
+    QFETCH(int, inputRate);
+    QFETCH(int, outputRate);
+    QFETCH(int, numChannels);
+
+    const std::vector<int16_t> input = makeInput(inputRate, numChannels);
+    const int blockFrames = inputRate / 100;
+    const int numFrames = (int)input.size() / numChannels;
+
+    AudioSRC src(inputRate, outputRate, numChannels);
+    std::vector<int16_t> output(numChannels * src.getMaxOutput(blockFrames));
+
+    QBENCHMARK {
+        for (int i = 0; i < numFrames; i += blockFrames) {
+            src.render(&input[numChannels * i], output.data(), blockFrames);
+        }
+    }
+}
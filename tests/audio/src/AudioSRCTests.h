@@ -0,0 +1,27 @@
+//
+//  AudioSRCTests.h
+//  tests/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSRCTests_h
+#define hifi_AudioSRCTests_h
+
+#include <QtTest/QtTest>
+
+class AudioSRCTests : public QObject {
+    Q_OBJECT
+private slots:
+    void formatsAgree_data();
+    void formatsAgree();
+
+    void renderBenchmark_data();
+    void renderBenchmark();
+};
+
+#endif // hifi_AudioSRCTests_h
@@ -0,0 +1,26 @@
+//
+//  LockFreeAudioRingBufferTests.h
+//  tests/audio/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LockFreeAudioRingBufferTests_h
+#define hifi_LockFreeAudioRingBufferTests_h
+
+#include <QtTest/QtTest>
+
+class LockFreeAudioRingBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    void readWriteWrap();
+    void overflowDropsNewest();
+    void iteratorAndShift();
+    void producerConsumer();
+};
+
+#endif // hifi_LockFreeAudioRingBufferTests_h
@@ -0,0 +1,124 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <udt/LossList.h>
+
+using namespace udt;
+
+QTEST_MAIN(LossListTests)
+
+// number of single packet losses outstanding in the benchmarks - every other packet of a large burst
+static const int NUM_BENCHMARK_LOSSES = 10000;
+
+static LossList makeSparseLossList(int numLosses) {
+    LossList lossList;
+    for (int i = 0; i < numLosses; ++i) {
+        lossList.append(SequenceNumber(i * 2));
+    }
+    return lossList;
+}
+
+void LossListTests::insertTest() {
+    LossList lossList;
+
+    lossList.insert(SequenceNumber(10), SequenceNumber(19));
+    lossList.insert(SequenceNumber(30), SequenceNumber(39));
+    QCOMPARE(lossList.getLength(), 20);
+
+    // a range touching both existing ranges merges them into one
+    lossList.insert(SequenceNumber(20), SequenceNumber(29));
+    QCOMPARE(lossList.getLength(), 30);
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(10));
+
+    // overlapping inserts don't count sequence numbers twice
+    lossList.insert(SequenceNumber(5), SequenceNumber(15));
+    lossList.insert(SequenceNumber(35), SequenceNumber(44));
+    QCOMPARE(lossList.getLength(), 40);
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(5));
+
+    // a range before everything else
+    lossList.insert(SequenceNumber(0), SequenceNumber(2));
+    QCOMPARE(lossList.getLength(), 43);
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(0));
+}
+
+void LossListTests::removeTest() {
+    LossList lossList;
+    lossList.append(SequenceNumber(0), SequenceNumber(9));
+    lossList.append(SequenceNumber(20), SequenceNumber(29));
+
+    QVERIFY(!lossList.remove(SequenceNumber(15)));
+    QVERIFY(lossList.remove(SequenceNumber(5)));
+    QVERIFY(!lossList.remove(SequenceNumber(5)));
+    QCOMPARE(lossList.getLength(), 19);
+
+    // removing the first sequence number of a range
+    QVERIFY(lossList.remove(SequenceNumber(0)));
+    QCOMPARE(lossList.getFirstSequenceNumber(), SequenceNumber(1));
+
+    // a range spanning the gap trims one range and cuts into the next
+    lossList.remove(SequenceNumber(8), SequenceNumber(24));
+    QCOMPARE(lossList.getLength(), 4 + 2 + 5);
+
+    // a range inside a single range splits it
+    lossList.remove(SequenceNumber(26), SequenceNumber(27));
+    QCOMPARE(lossList.getLength(), 4 + 2 + 3);
+
+    lossList.remove(SequenceNumber(0), SequenceNumber(100));
+    QVERIFY(lossList.isEmpty());
+}
+
+void LossListTests::popFirstTest() {
+    LossList lossList;
+    lossList.insert(SequenceNumber(50), SequenceNumber(51));
+    lossList.insert(SequenceNumber(10), SequenceNumber(10));
+    lossList.insert(SequenceNumber(30), SequenceNumber(30));
+
+    QCOMPARE(lossList.popFirstSequenceNumber(), SequenceNumber(10));
+    QCOMPARE(lossList.popFirstSequenceNumber(), SequenceNumber(30));
+    QCOMPARE(lossList.popFirstSequenceNumber(), SequenceNumber(50));
+    QCOMPARE(lossList.popFirstSequenceNumber(), SequenceNumber(51));
+    QVERIFY(lossList.isEmpty());
+}
+
+void LossListTests::insertBenchmark() {
+    QBENCHMARK {
+        // NAKs for the odd sequence numbers arriving in reverse order, each landing in between existing ranges
+        LossList lossList = makeSparseLossList(NUM_BENCHMARK_LOSSES);
+        for (int i = NUM_BENCHMARK_LOSSES - 1; i >= 0; --i) {
+            lossList.insert(SequenceNumber(i * 2 + 1), SequenceNumber(i * 2 + 1));
+        }
+        QCOMPARE(lossList.getLength(), NUM_BENCHMARK_LOSSES * 2);
+    }
+}
+
+void LossListTests::removeBenchmark() {
+    QBENCHMARK {
+        // retransmissions arriving out of order on the receiving side
+        LossList lossList = makeSparseLossList(NUM_BENCHMARK_LOSSES);
+        for (int i = NUM_BENCHMARK_LOSSES - 1; i >= 0; --i) {
+            lossList.remove(SequenceNumber(i * 2));
+        }
+        QVERIFY(lossList.isEmpty());
+    }
+}
+
+void LossListTests::popFirstBenchmark() {
+    QBENCHMARK {
+        // the send queue popping the next packet to re-send
+        LossList lossList = makeSparseLossList(NUM_BENCHMARK_LOSSES);
+        while (!lossList.isEmpty()) {
+            lossList.popFirstSequenceNumber();
+        }
+    }
+}
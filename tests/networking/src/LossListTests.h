@@ -0,0 +1,37 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that inserted ranges merge with the ranges they overlap or touch
+    void insertTest();
+
+    // Test that removing sequence numbers and ranges splits and trims ranges correctly
+    void removeTest();
+
+    // Test that the first sequence number is always the smallest one outstanding
+    void popFirstTest();
+
+    // Benchmarks with thousands of outstanding losses, as seen after a burst of loss on a large transfer
+    void insertBenchmark();
+    void removeBenchmark();
+    void popFirstBenchmark();
+};
+
+#endif // hifi_LossListTests_h
@@ -0,0 +1,73 @@
+//
+//  PacketBufferPoolTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPoolTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <udt/Constants.h>
+#include <udt/PacketBufferPool.h>
+
+using namespace udt;
+
+QTEST_MAIN(PacketBufferPoolTests)
+
+static double poolStat(const QString& name) {
+    return PacketBufferPool::getStatsJson()[name].toDouble();
+}
+
+void PacketBufferPoolTests::recycleTest() {
+    auto buffer = PacketBufferPool::allocate(MAX_PACKET_SIZE);
+    QVERIFY(buffer.get() != nullptr);
+    QVERIFY(buffer.get_deleter().getSizeClass() != PacketBufferDeleter::UNPOOLED);
+
+    auto address = buffer.get();
+    buffer.reset();
+
+    auto hitsBefore = poolStat("hits");
+
+    auto recycled = PacketBufferPool::allocate(MAX_PACKET_SIZE);
+    QCOMPARE(recycled.get(), address);
+    QCOMPARE(poolStat("hits"), hitsBefore + 1);
+}
+
+void PacketBufferPoolTests::unpooledTest() {
+    auto unpooledBefore = poolStat("unpooled");
+
+    auto buffer = PacketBufferPool::allocate(MAX_PACKET_SIZE + 1);
+    QVERIFY(buffer.get() != nullptr);
+    QCOMPARE(buffer.get_deleter().getSizeClass(), PacketBufferDeleter::UNPOOLED);
+    QCOMPARE(poolStat("unpooled"), unpooledBefore + 1);
+}
+
+void PacketBufferPoolTests::crossThreadTest() {
+    // enough buffers for the releasing thread to overflow into the global list
+    const int NUM_BUFFERS = 1024;
+
+    std::vector<PacketBuffer> buffers;
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        buffers.push_back(PacketBufferPool::allocate(MAX_PACKET_SIZE));
+    }
+
+    std::thread releaser([&buffers] {
+        buffers.clear();
+    });
+    releaser.join();
+
+    auto hitsBefore = poolStat("hits");
+    auto missesBefore = poolStat("misses");
+
+    auto buffer = PacketBufferPool::allocate(MAX_PACKET_SIZE);
+    QVERIFY(buffer.get() != nullptr);
+    QCOMPARE(poolStat("hits"), hitsBefore + 1);
+    QCOMPARE(poolStat("misses"), missesBefore);
+}
@@ -0,0 +1,32 @@
+//
+//  PacketBufferPoolTests.h
+//  tests/networking/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketBufferPoolTests_h
+#define hifi_PacketBufferPoolTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketBufferPoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a released buffer is handed out again for the same size class
+    void recycleTest();
+
+    // Test that buffers larger than the biggest size class are not pooled
+    void unpooledTest();
+
+    // Test that buffers released on another thread make it back to the allocating thread
+    void crossThreadTest();
+};
+
+#endif // hifi_PacketBufferPoolTests_h
@@ -1345,3 +1345,50 @@ void ViewFrustumTests::testBoxIntersectsKeyhole() {
     box.setBox(boxCenter - halfScaleOffset, boxScale);
     QCOMPARE(view.boxIntersectsKeyhole(box), false); // outside back
 }
+
+void ViewFrustumTests::testByteArrayRoundTrip() {
+    float aspect = 16.0f / 9.0f;
+    float fovY = PI / 4.0f;
+    float nearClip = 0.1f;
+    float farClip = 500.0f;
+    float holeRadius = 3.0f;
+
+    glm::vec3 center = glm::vec3(12.3f, 4.56f, 89.7f);
+    glm::quat rotation = glm::angleAxis(PI / 7.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f)));
+
+    ViewFrustum view;
+    view.setProjection(glm::perspective(fovY, aspect, nearClip, farClip));
+    view.setPosition(center);
+    view.setOrientation(rotation);
+    view.setCenterRadius(holeRadius);
+    view.calculate();
+
+    // the lens details are packed into two bytes each, so they come back close rather than exact
+    const float ACCEPTABLE_PACKED_ERROR = 1.0e-3f;
+    const float ACCEPTABLE_PACKED_ANGLE_ERROR = 0.01f;
+
+    ViewFrustum copy;
+    QCOMPARE(copy.fromByteArray(view.toByteArray()), true);
+
+    QCOMPARE_WITH_ABS_ERROR(copy.getPosition(), center, ACCEPTABLE_FLOAT_ERROR);
+    float rotationDot = glm::abs(glm::dot(rotation, copy.getOrientation()));
+    QCOMPARE_WITH_ABS_ERROR(rotationDot, 1.0f, ACCEPTABLE_PACKED_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(copy.getFieldOfView(), view.getFieldOfView(), ACCEPTABLE_PACKED_ANGLE_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(copy.getAspectRatio(), aspect, ACCEPTABLE_PACKED_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(copy.getNearClip(), nearClip, ACCEPTABLE_PACKED_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(copy.getFarClip(), farClip, 1.0f);
+    QCOMPARE(copy.getCenterRadius(), holeRadius);
+
+    // the copy is calculated and ready for intersection tests
+    glm::vec3 ahead = center + rotation * (10.0f * localForward);
+    glm::vec3 behind = center - rotation * (10.0f * localForward);
+    QCOMPARE(copy.pointIntersectsFrustum(ahead), true);
+    QCOMPARE(copy.pointIntersectsFrustum(behind), false);
+
+    // short data is refused and leaves the frustum alone
+    ViewFrustum untouched;
+    QByteArray data = view.toByteArray();
+    data.chop(1);
+    QCOMPARE(untouched.fromByteArray(data), false);
+    QCOMPARE(untouched.getPosition(), glm::vec3(0.0f));
+}
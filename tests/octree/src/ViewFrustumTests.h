@@ -27,6 +27,7 @@ private slots:
     void testSphereIntersectsKeyhole();
     void testCubeIntersectsKeyhole();
     void testBoxIntersectsKeyhole();
+    void testByteArrayRoundTrip();
 };
 
 #endif // hifi_ViewFruxtumTests_h
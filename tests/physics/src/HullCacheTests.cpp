@@ -0,0 +1,99 @@
+//
+//  HullCacheTests.cpp
+//  tests/physics/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <QtCore/QTemporaryDir>
+
+#include <HullCache.h>
+#include <ShapeFactory.h>
+
+#include "HullCacheTests.h"
+
+QTEST_MAIN(HullCacheTests)
+
+static ShapeInfo makeCompoundInfo(float scale) {
+    ShapeInfo::PointList tetrahedron;
+    tetrahedron.push_back(scale * glm::vec3(1.0f, 1.0f, 1.0f));
+    tetrahedron.push_back(scale * glm::vec3(1.0f, -1.0f, -1.0f));
+    tetrahedron.push_back(scale * glm::vec3(-1.0f, 1.0f, -1.0f));
+    tetrahedron.push_back(scale * glm::vec3(-1.0f, -1.0f, 1.0f));
+
+    ShapeInfo::PointCollection pointCollection;
+    pointCollection.push_back(tetrahedron);
+    pointCollection.push_back(tetrahedron);
+
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(1.0f), "http://localhost/hulls.fbx");
+    info.setPointCollection(pointCollection);
+    return info;
+}
+
+void HullCacheTests::saveAndLoad() {
+    QTemporaryDir directory;
+    HullCache cache(directory.path());
+    ShapeInfo info = makeCompoundInfo(1.0f);
+
+    std::vector<HullCache::Hull> hulls;
+    QVERIFY(!cache.load(info, hulls));
+
+    HullCache::Hull hull;
+    hull.margin = 0.02f;
+    hull.points.push_back(btVector3(1.0f, 2.0f, 3.0f));
+    hull.points.push_back(btVector3(-1.0f, -2.0f, -3.0f));
+    hulls.push_back(hull);
+    cache.save(info, hulls);
+
+    std::vector<HullCache::Hull> loadedHulls;
+    QVERIFY(cache.load(info, loadedHulls));
+    QCOMPARE((int)loadedHulls.size(), 1);
+    QCOMPARE(loadedHulls[0].margin, hull.margin);
+    QCOMPARE((int)loadedHulls[0].points.size(), 2);
+    QVERIFY(loadedHulls[0].points[1] == hull.points[1]);
+}
+
+void HullCacheTests::changedPointsAreNotLoaded() {
+    QTemporaryDir directory;
+    HullCache cache(directory.path());
+
+    std::vector<HullCache::Hull> hulls(1);
+    hulls[0].points.push_back(btVector3(1.0f, 1.0f, 1.0f));
+    cache.save(makeCompoundInfo(1.0f), hulls);
+
+    // the same url and extents, so the same key, but the model has other points now
+    ShapeInfo changedInfo = makeCompoundInfo(0.5f);
+    QCOMPARE(changedInfo.getHash().getHash(), makeCompoundInfo(1.0f).getHash().getHash());
+    QVERIFY(!cache.load(changedInfo, hulls));
+}
+
+void HullCacheTests::compoundShapeUsesCache() {
+    QTemporaryDir directory;
+    HullCache cache(directory.path());
+    ShapeInfo info = makeCompoundInfo(1.0f);
+
+    // the first build saves its hulls, which the second build loads
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info, &cache);
+    std::vector<HullCache::Hull> hulls;
+    QVERIFY(cache.load(info, hulls));
+    QCOMPARE((int)hulls.size(), 2);
+
+    const btCollisionShape* cachedShape = ShapeFactory::createShapeFromInfo(info, &cache);
+    QCOMPARE(cachedShape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+    const btCompoundShape* cachedCompound = static_cast<const btCompoundShape*>(cachedShape);
+    QCOMPARE(cachedCompound->getNumChildShapes(), 2);
+
+    const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(compound->getChildShape(0));
+    const btConvexHullShape* cachedHull = static_cast<const btConvexHullShape*>(cachedCompound->getChildShape(0));
+    QCOMPARE(cachedHull->getNumPoints(), hull->getNumPoints());
+    QCOMPARE(cachedHull->getMargin(), hull->getMargin());
+
+    ShapeFactory::deleteShape(shape);
+    ShapeFactory::deleteShape(cachedShape);
+}
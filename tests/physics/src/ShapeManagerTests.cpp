@@ -10,6 +10,7 @@
 //
 
 #include <iostream>
+#include <QtCore/QThreadPool>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -243,3 +244,48 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::addCompoundShapeWhenReady() {
+    // a single tetrahedral hull
+    ShapeInfo::PointList pointList;
+    pointList.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
+    pointList.push_back(glm::vec3(1.0f, -1.0f, -1.0f));
+    pointList.push_back(glm::vec3(-1.0f, 1.0f, -1.0f));
+    pointList.push_back(glm::vec3(-1.0f, -1.0f, 1.0f));
+    ShapeInfo::PointCollection pointCollection;
+    pointCollection.push_back(pointList);
+
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(1.0f));
+    info.setPointCollection(pointCollection);
+
+    // the first request only starts the build
+    ShapeManager shapeManager;
+    const btCollisionShape* shape = shapeManager.getShapeWhenReady(info);
+    QVERIFY(shape == nullptr);
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 1);
+
+    // asking again once it's built hands it over to the manager
+    QThreadPool::globalInstance()->waitForDone();
+    shape = shapeManager.getShapeWhenReady(info);
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 0);
+    QCOMPARE(shapeManager.getNumShapes(), 1);
+    QCOMPARE(shapeManager.getNumReferences(info), 1);
+
+    // now that it's managed it's returned right away
+    QCOMPARE(shapeManager.getShapeWhenReady(info), shape);
+    QCOMPARE(shapeManager.getNumReferences(info), 2);
+
+    // a build nobody comes back for is collected as garbage
+    ShapeManager otherShapeManager;
+    QVERIFY(otherShapeManager.getShapeWhenReady(info) == nullptr);
+    QThreadPool::globalInstance()->waitForDone();
+    otherShapeManager.collectGarbage();
+    QCOMPARE(otherShapeManager.getNumPendingShapes(), 0);
+    QCOMPARE(otherShapeManager.getNumShapes(), 1);
+    QCOMPARE(otherShapeManager.getNumReferences(info), 0);
+    otherShapeManager.collectGarbage();
+    QCOMPARE(otherShapeManager.getNumShapes(), 0);
+}
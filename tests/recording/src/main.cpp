@@ -79,6 +79,48 @@ void testFilePersist() {
     QVERIFY(readClip->duration() == 5.0f);
 }
 
+void testChunkedPersist() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+    auto otherFrameType = Frame::registerFrameType(TEST_NAME + "Other");
+
+    // enough frames of two types for several chunks
+    auto writeClip = Clip::newClip();
+    const size_t FRAME_COUNT = Clip::MAX_CHUNK_FRAMES * 3;
+    for (size_t i = 0; i < FRAME_COUNT; ++i) {
+        QByteArray data = QByteArray::number((int)i).repeated(i % 7);
+        writeClip->addFrame(std::make_shared<Frame>((i % 3) ? TEST_FRAME_TYPE : otherFrameType, (float)i, data));
+    }
+    QVERIFY(writeClip->frameCount() == FRAME_COUNT);
+
+    Clip::toFile(fileName, writeClip);
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == FRAME_COUNT);
+    QVERIFY(readClip->duration() == writeClip->duration());
+
+    readClip->seek(0);
+    writeClip->seek(0);
+    size_t count = 0;
+    for (auto readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(); readFrame && writeFrame;
+        readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(), ++count) {
+        QVERIFY(readFrame->type == writeFrame->type);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+    QVERIFY(count == FRAME_COUNT);
+
+    // seeking back into a chunk that isn't the one read ahead
+    readClip->seek(writeClip->duration() / 2.0f);
+    writeClip->seek(writeClip->duration() / 2.0f);
+    QVERIFY(readClip->position() == writeClip->position());
+    QVERIFY(readClip->peekFrame()->data == writeClip->peekFrame()->data);
+}
+
 void testClipOrdering() {
     auto writeClip = Clip::newClip();
     // simulate our of order addition of frames
@@ -110,5 +152,6 @@ int main(int, const char**) {
 #endif
     testFrameTypeRegistration();
     testFilePersist();
+    testChunkedPersist();
     testClipOrdering();
 }
\ No newline at end of file
@@ -0,0 +1,279 @@
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSize>
+#include <QtCore/QString>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <ResourceCache.h>
+#include <SharedUtil.h>
+#include <gpu/Context.h>
+#include <render/Task.h>
+
+// The camera path of a benchmark, keyframes the camera is interpolated along:
+// { "keyframes": [ { "time": 0.0, "position": [ x, y, z ], "orientation": [ x, y, z, w ] }, ... ] }
+class CameraPath {
+public:
+    bool load(const QString& fileName) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        auto keyframes = QJsonDocument::fromJson(file.readAll()).object()["keyframes"].toArray();
+        _keyframes.clear();
+        for (const auto& value : keyframes) {
+            auto object = value.toObject();
+            auto position = object["position"].toArray();
+            auto orientation = object["orientation"].toArray();
+            if (position.size() != 3 || orientation.size() != 4) {
+                continue;
+            }
+            Keyframe keyframe;
+            keyframe.time = (float)object["time"].toDouble();
+            keyframe.position = vec3(position[0].toDouble(), position[1].toDouble(), position[2].toDouble());
+            keyframe.orientation = glm::normalize(quat((float)orientation[3].toDouble(), (float)orientation[0].toDouble(),
+                (float)orientation[1].toDouble(), (float)orientation[2].toDouble()));
+            _keyframes.push_back(keyframe);
+        }
+        std::sort(_keyframes.begin(), _keyframes.end(), [](const Keyframe& a, const Keyframe& b) {
+            return a.time < b.time;
+        });
+        return !_keyframes.empty();
+    }
+
+    float getDuration() const {
+        return _keyframes.empty() ? 0.0f : _keyframes.back().time - _keyframes.front().time;
+    }
+
+    // time is from the first keyframe
+    void evaluate(float time, vec3& position, quat& orientation) const {
+        if (_keyframes.empty()) {
+            return;
+        }
+        time += _keyframes.front().time;
+        auto next = std::find_if(_keyframes.begin(), _keyframes.end(), [time](const Keyframe& keyframe) {
+            return keyframe.time > time;
+        });
+        if (next == _keyframes.begin() || next == _keyframes.end()) {
+            const auto& keyframe = (next == _keyframes.end()) ? _keyframes.back() : _keyframes.front();
+            position = keyframe.position;
+            orientation = keyframe.orientation;
+            return;
+        }
+        const auto& previous = *(next - 1);
+        float alpha = (time - previous.time) / (next->time - previous.time);
+        position = glm::mix(previous.position, next->position, alpha);
+        orientation = safeMix(previous.orientation, next->orientation, alpha);
+    }
+
+private:
+    struct Keyframe {
+        float time;
+        vec3 position;
+        quat orientation;
+    };
+    std::vector<Keyframe> _keyframes;
+};
+
+// Draws a recorded scene along a camera path for a fixed number of frames, then writes the CPU and GPU time of
+// every job of the render engine and the draw statistics of the frames as JSON.
+// The frames are drawn to a hidden window without presenting them, so neither the vsync nor the window system is timed.
+class Benchmark {
+public:
+    struct Options {
+        QString scene;
+        QString cameraPath;
+        QString output; // stdout when empty
+        QSize size { 1920, 1080 };
+        int frames { 600 };
+        int warmupFrames { 60 };
+        int loadTimeoutSecs { 120 };
+    };
+
+    enum Phase {
+        LOADING = 0,
+        WARMUP,
+        MEASURING,
+        DONE,
+    };
+
+    Benchmark(const Options& options) : _options(options) {}
+
+    bool init() {
+        if (!_cameraPath.load(_options.cameraPath)) {
+            qWarning() << "Benchmark: no keyframes in the camera path" << _options.cameraPath;
+            return false;
+        }
+        _loadStart = usecTimestampNow();
+        return true;
+    }
+
+    const Options& getOptions() const { return _options; }
+    Phase getPhase() const { return _phase; }
+
+    // The pose of the camera for the next frame, the path is run through once over the measured frames
+    void getCameraPose(vec3& position, quat& orientation) const {
+        float time = 0.0f;
+        if (_phase == MEASURING && _options.frames > 1) {
+            time = _cameraPath.getDuration() * (float)_frameIndex / (float)(_options.frames - 1);
+        }
+        _cameraPath.evaluate(time, position, orientation);
+    }
+
+    // After each drawn frame, with the time the main thread took to draw it and the time the render thread
+    // took to execute the previous one
+    void frameDrawn(const render::EnginePointer& engine, const gpu::ContextPointer& context, uint64_t cpuUsecs, uint64_t executeUsecs) {
+        switch (_phase) {
+            case LOADING: {
+                bool loaded = ResourceCache::getLoadingRequests().isEmpty() && ResourceCache::getPendingRequestCount() == 0;
+                bool timedOut = (usecTimestampNow() - _loadStart) > (uint64_t)_options.loadTimeoutSecs * USECS_PER_SECOND;
+                if (loaded || timedOut) {
+                    _loadTimedOut = !loaded;
+                    if (_loadTimedOut) {
+                        qWarning() << "Benchmark: still loading after" << _options.loadTimeoutSecs << "seconds, measuring anyway";
+                    }
+                    _phase = WARMUP;
+                }
+                break;
+            }
+
+            case WARMUP:
+                if (++_frameIndex >= _options.warmupFrames) {
+                    _frameIndex = 0;
+                    _phase = MEASURING;
+                    context->getStats(_startStats);
+                    _jobs = engine->getConfiguration()->findChildren<render::JobConfig*>();
+                }
+                break;
+
+            case MEASURING:
+                _cpuFrameTimes.push_back(cpuUsecs);
+                _executeFrameTimes.push_back(executeUsecs);
+                for (auto job : _jobs) {
+                    auto& timing = _jobTimings[getJobPath(job, engine->getConfiguration().get())];
+                    timing.cpu += job->getCPURunTime();
+                    auto gpu = job->property("gpuRunTime");
+                    if (gpu.isValid()) {
+                        timing.hasGPU = true;
+                        timing.gpu += gpu.toDouble();
+                        timing.batch += job->property("batchRunTime").toDouble();
+                    }
+                }
+                if (++_frameIndex >= _options.frames) {
+                    context->getStats(_endStats);
+                    _phase = DONE;
+                }
+                break;
+
+            case DONE:
+                break;
+        }
+    }
+
+    QJsonObject getResults() const {
+        QJsonObject results;
+        results["scene"] = _options.scene;
+        results["cameraPath"] = _options.cameraPath;
+        results["width"] = _options.size.width();
+        results["height"] = _options.size.height();
+        results["frames"] = (int)_cpuFrameTimes.size();
+        results["loadTimedOut"] = _loadTimedOut;
+        results["cpuFrameTime"] = summarize(_cpuFrameTimes);
+        results["executeFrameTime"] = summarize(_executeFrameTimes);
+
+        double frames = std::max<double>(1.0, (double)_cpuFrameTimes.size());
+        QJsonObject stats;
+        stats["drawcalls"] = (_endStats._DSNumDrawcalls - _startStats._DSNumDrawcalls) / frames;
+        stats["apiDrawcalls"] = (_endStats._DSNumAPIDrawcalls - _startStats._DSNumAPIDrawcalls) / frames;
+        stats["triangles"] = (_endStats._DSNumTriangles - _startStats._DSNumTriangles) / frames;
+        stats["textureBinds"] = (_endStats._RSNumTextureBounded - _startStats._RSNumTextureBounded) / frames;
+        stats["pipelineChanges"] = (_endStats._PSNumSetPipelines - _startStats._PSNumSetPipelines) / frames;
+        stats["compactedCommands"] = (_endStats._CSNumCompactedCommands - _startStats._CSNumCompactedCommands) / frames;
+        results["statsPerFrame"] = stats;
+
+        // the mean over the measured frames, in msecs
+        QJsonObject jobs;
+        for (const auto& entry : _jobTimings) {
+            QJsonObject job;
+            job["cpu"] = entry.second.cpu / frames;
+            if (entry.second.hasGPU) {
+                job["gpu"] = entry.second.gpu / frames;
+                job["batch"] = entry.second.batch / frames;
+            }
+            jobs[entry.first] = job;
+        }
+        results["jobs"] = jobs;
+        return results;
+    }
+
+private:
+    struct JobTiming {
+        double cpu { 0.0 };
+        double gpu { 0.0 };
+        double batch { 0.0 };
+        bool hasGPU { false };
+    };
+
+    // The names of the tasks the job is in, down to its own
+    static QString getJobPath(const QObject* job, const QObject* root) {
+        QString path = job->objectName();
+        for (auto parent = job->parent(); parent && parent != root; parent = parent->parent()) {
+            path = parent->objectName() + "." + path;
+        }
+        return path;
+    }
+
+    // in msecs
+    static QJsonObject summarize(std::vector<uint64_t> usecs) {
+        QJsonObject summary;
+        if (usecs.empty()) {
+            return summary;
+        }
+        std::sort(usecs.begin(), usecs.end());
+        uint64_t total = 0;
+        for (auto time : usecs) {
+            total += time;
+        }
+        auto percentile = [&usecs](double fraction) {
+            size_t index = std::min(usecs.size() - 1, (size_t)(fraction * usecs.size()));
+            return (double)usecs[index] / USECS_PER_MSEC;
+        };
+        summary["mean"] = ((double)total / usecs.size()) / USECS_PER_MSEC;
+        summary["min"] = (double)usecs.front() / USECS_PER_MSEC;
+        summary["max"] = (double)usecs.back() / USECS_PER_MSEC;
+        summary["p50"] = percentile(0.5);
+        summary["p95"] = percentile(0.95);
+        summary["p99"] = percentile(0.99);
+        return summary;
+    }
+
+    const Options _options;
+    CameraPath _cameraPath;
+    Phase _phase { LOADING };
+    int _frameIndex { 0 };
+    uint64_t _loadStart { 0 };
+    bool _loadTimedOut { false };
+
+    QList<render::JobConfig*> _jobs;
+    std::map<QString, JobTiming> _jobTimings;
+    std::vector<uint64_t> _cpuFrameTimes;
+    std::vector<uint64_t> _executeFrameTimes;
+    gpu::ContextStats _startStats;
+    gpu::ContextStats _endStats;
+};
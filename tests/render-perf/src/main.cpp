@@ -14,6 +14,7 @@
 #include <gl/Config.h>
 #include <gl/Context.h>
 
+#include <QtCore/QCommandLineParser>
 #include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
@@ -62,6 +63,7 @@
 #include <AddressManager.h>
 #include <SceneScriptingInterface.h>
 
+#include "Benchmark.hpp"
 #include "Camera.hpp"
 #include "TextOverlay.hpp"
 
@@ -234,6 +236,10 @@ public:
     gpu::PipelinePointer _presentPipeline;
     gpu::ContextPointer _gpuContext; // initialized during window creation
     std::atomic<size_t> _presentCount;
+    // the time the last frame took to execute, in usecs
+    std::atomic<uint64_t> _lastFrameTime { 0 };
+    // frames are executed but never presented
+    bool _benchmarking { false };
     QElapsedTimer _elapsed;
     std::atomic<uint16_t> _fps{ 1 };
     RateCounter<200> _fpsCounter;
@@ -325,7 +331,7 @@ public:
         if (frame && !frame->batches.empty()) {
             _gpuContext->executeFrame(frame);
 
-            {
+            if (!_benchmarking) {
                 
                 auto geometryCache = DependencyManager::get<GeometryCache>();
                 gpu::Batch presentBatch;
@@ -341,7 +347,11 @@ public:
             (void)CHECK_GL_ERROR();
         }
         _context.makeCurrent();
-        _context.swapBuffers();
+        if (_benchmarking) {
+            glFlush();
+        } else {
+            _context.swapBuffers();
+        }
         _fpsCounter.increment();
         static size_t _frameCount{ 0 };
         ++_frameCount;
@@ -400,6 +410,7 @@ public:
             auto start = usecTimestampNow();
             renderFrame(_activeFrame);
             auto duration = usecTimestampNow() - start;
+            _lastFrameTime = duration;
             auto frameBufferIndex = _frameIndex % FRAME_TIME_BUFFER_SIZE;
             _frameTimes[frameBufferIndex] = duration;
             ++_frameIndex;
@@ -516,7 +527,7 @@ public:
         DependencyManager::set<SceneScriptingInterface>();
     }
 
-    QTestWindow() {
+    QTestWindow(const QSharedPointer<Benchmark>& benchmark = QSharedPointer<Benchmark>()) : _benchmark(benchmark) {
         installEventFilter(this);
         _camera.movementSpeed = 50.0f;
         QThreadPool::globalInstance()->setMaxThreadCount(2);
@@ -538,11 +549,15 @@ public:
         ResourceManager::init();
 
         setFlags(Qt::MSWindowsOwnDC | Qt::Window | Qt::Dialog | Qt::WindowMinMaxButtonsHint | Qt::WindowTitleHint);
-        _size = QSize(800, 600);
+        _size = _benchmark ? _benchmark->getOptions().size : QSize(800, 600);
         _renderThread._size = _size;
+        _renderThread._benchmarking = !_benchmark.isNull();
         setGeometry(QRect(QPoint(), _size));
         create();
-        show();
+        // a benchmark draws to the framebuffers only, the window is never shown
+        if (!_benchmark) {
+            show();
+        }
         QCoreApplication::processEvents();
         // Create the initial context
         _renderThread.initialize(this, _initContext);
@@ -589,8 +604,17 @@ public:
         _renderEngine->registerScene(_main3DScene);
 
         // Render engine library init
-        reloadScene();
-        restorePosition();
+        if (_benchmark) {
+            resizeWindow(_size);
+            if (!importScene(_benchmark->getOptions().scene, false)) {
+                qWarning() << "Benchmark: could not load the scene" << _benchmark->getOptions().scene;
+                QTimer::singleShot(0, [] { QCoreApplication::exit(1); });
+                return;
+            }
+        } else {
+            reloadScene();
+            restorePosition();
+        }
 
         QTimer* timer = new QTimer(this);
         timer->setInterval(0);
@@ -693,13 +717,14 @@ private:
         if (!_ready) {
             return;
         }
-        if (!isVisible()) {
+        if (!isVisible() && !_benchmark) {
             return;
         }
         if (_renderCount.load() != 0 && _renderCount.load() >= _renderThread._presentCount.load()) {
             return;
         }
         _renderCount = _renderThread._presentCount.load();
+        auto frameStart = usecTimestampNow();
         update();
 
         RenderArgs renderArgs(_renderThread._gpuContext, _octree.data(), DEFAULT_OCTREE_SIZE_SCALE,
@@ -746,6 +771,15 @@ private:
         // Final framebuffer that will be handled to the display-plugin
         render(&renderArgs);
 
+        if (_benchmark) {
+            _benchmark->frameDrawn(_renderEngine, _renderThread._gpuContext, usecTimestampNow() - frameStart,
+                _renderThread._lastFrameTime.load());
+            if (_benchmark->getPhase() == Benchmark::DONE) {
+                finishBenchmark();
+            }
+            return;
+        }
+
         if (_fps != _renderThread._fps) {
             _fps = _renderThread._fps;
             updateText();
@@ -756,8 +790,8 @@ private:
     class EntityUpdateOperator : public RecurseOctreeOperator {
     public:
         EntityUpdateOperator(const qint64& now) : now(now) {}
-        bool preRecursion(OctreeElementPointer element) override { return true; }
-        bool postRecursion(OctreeElementPointer element) override {
+        bool preRecursion(const OctreeElementPointer& element) override { return true; }
+        bool postRecursion(const OctreeElementPointer& element) override {
             EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
             entityTreeElement->forEachEntity([&](EntityItemPointer entityItem) {
                 if (!entityItem->isParentIDValid()) {
@@ -812,6 +846,14 @@ private:
             auto view = glm::inverse(_camera.matrices.view);
             _viewFrustum.setPosition(glm::vec3(view[3]));
             _viewFrustum.setOrientation(glm::quat_cast(view));
+            // the camera only yaws, the pose of a benchmark is set on the frustum directly
+            if (_benchmark) {
+                vec3 position;
+                quat orientation;
+                _benchmark->getCameraPose(position, orientation);
+                _viewFrustum.setPosition(position);
+                _viewFrustum.setOrientation(orientation);
+            }
             // Failing to do the calculation of the bound planes causes everything to be considered inside the frustum
             if (_cullingEnabled) {
                 _viewFrustum.calculate();
@@ -945,7 +987,7 @@ private:
         }
     }
 
-    void importScene(const QString& fileName) {
+    bool importScene(const QString& fileName, bool remember = true) {
         auto assetClient = DependencyManager::get<AssetClient>();
         QFileInfo fileInfo(fileName);
         QString atpPath = fileInfo.absolutePath() + "/" + fileInfo.baseName() + ".atp";
@@ -955,9 +997,11 @@ private:
             QString atpUrl = QUrl::fromLocalFile(atpPath).toString();
             ResourceManager::setUrlPrefixOverride("atp:/", atpUrl + "/");
         }
-        _settings.setValue(LAST_SCENE_KEY, fileName);
+        if (remember) {
+            _settings.setValue(LAST_SCENE_KEY, fileName);
+        }
         _octree->clear();
-        _octree->getTree()->readFromURL(fileName);
+        return _octree->getTree()->readFromURL(fileName);
     }
 
     void importScene() {
@@ -1037,6 +1081,22 @@ private:
         return _octree;
     }
 
+    void finishBenchmark() {
+        auto results = QJsonDocument(_benchmark->getResults()).toJson();
+        const auto& output = _benchmark->getOptions().output;
+        if (output.isEmpty()) {
+            std::cout << results.constData() << std::endl;
+        } else {
+            QFile file(output);
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(results) != results.size()) {
+                qWarning() << "Benchmark: could not write the results to" << output;
+                QCoreApplication::exit(1);
+                return;
+            }
+        }
+        QCoreApplication::exit(0);
+    }
+
 private:
     render::CullFunctor _cullFunctor { [&](const RenderArgs* args, const AABox& bounds)->bool{
         if (_cullingEnabled) {
@@ -1084,17 +1144,21 @@ private:
     };
     RenderMode _renderMode { NORMAL };
     QSharedPointer<EntityTreeRenderer> _octree;
+    QSharedPointer<Benchmark> _benchmark;
 };
 
 bool QTestWindow::_cullingEnabled = true;
 
+// the results of a benchmark go to stdout, so the log goes to stderr
+static bool logToStderr { false };
+
 void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
     if (!message.isEmpty()) {
 #ifdef Q_OS_WIN
         OutputDebugStringA(message.toLocal8Bit().constData());
         OutputDebugStringA("\n");
 #endif
-        std::cout << message.toLocal8Bit().constData() << std::endl;
+        (logToStderr ? std::cerr : std::cout) << message.toLocal8Bit().constData() << std::endl;
     }
 }
 
@@ -1108,12 +1172,49 @@ int main(int argc, char** argv) {
     QCoreApplication::setOrganizationName("High Fidelity");
     QCoreApplication::setOrganizationDomain("highfidelity.com");
 
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Draws a scene with the deferred renderer. "
+        "With a scene and a camera path, draws it for a number of frames and writes the timing of the render jobs as JSON.");
+    parser.addHelpOption();
+    QCommandLineOption sceneOption("scene", "The entities JSON of the scene to benchmark.", "file");
+    QCommandLineOption cameraPathOption("camera-path", "The keyframes JSON of the camera of the benchmark.", "file");
+    QCommandLineOption framesOption("frames", "The number of frames measured.", "count", "600");
+    QCommandLineOption warmupOption("warmup", "The number of frames drawn once the scene is loaded, before measuring.", "count", "60");
+    QCommandLineOption sizeOption("size", "The resolution of the frames.", "WxH", "1920x1080");
+    QCommandLineOption loadTimeoutOption("load-timeout", "The seconds to wait for the scene to load.", "seconds", "120");
+    QCommandLineOption outputOption("output", "The file the results are written to, stdout if not set.", "file");
+    parser.addOptions({ sceneOption, cameraPathOption, framesOption, warmupOption, sizeOption, loadTimeoutOption, outputOption });
+    parser.process(app);
+
+    QSharedPointer<Benchmark> benchmark;
+    if (parser.isSet(sceneOption) || parser.isSet(cameraPathOption)) {
+        Benchmark::Options options;
+        options.scene = parser.value(sceneOption);
+        options.cameraPath = parser.value(cameraPathOption);
+        options.output = parser.value(outputOption);
+        options.frames = std::max(1, parser.value(framesOption).toInt());
+        options.warmupFrames = std::max(0, parser.value(warmupOption).toInt());
+        options.loadTimeoutSecs = std::max(0, parser.value(loadTimeoutOption).toInt());
+        auto size = parser.value(sizeOption).split('x');
+        if (size.size() == 2 && size[0].toInt() > 0 && size[1].toInt() > 0) {
+            options.size = QSize(size[0].toInt(), size[1].toInt());
+        }
+        if (options.scene.isEmpty() || options.cameraPath.isEmpty()) {
+            std::cerr << "A benchmark needs both a --scene and a --camera-path" << std::endl;
+            return 1;
+        }
+        benchmark = QSharedPointer<Benchmark>::create(options);
+        if (!benchmark->init()) {
+            return 1;
+        }
+        logToStderr = options.output.isEmpty();
+    }
+
     qInstallMessageHandler(messageHandler);
     QLoggingCategory::setFilterRules(LOG_FILTER_RULES);
     QTestWindow::setup();
-    QTestWindow window;
-    app.exec();
-    return 0;
+    QTestWindow window(benchmark);
+    return app.exec();
 }
 
 #include "main.moc"
@@ -0,0 +1,120 @@
+//
+//  FlatUUIDHashTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FlatUUIDHashTests.h"
+
+#include <random>
+#include <vector>
+
+#include <FlatUUIDHash.h>
+
+QTEST_MAIN(FlatUUIDHashTests)
+
+static const int NUM_BENCHMARK_IDS = 100000;
+
+void FlatUUIDHashTests::insertFindRemove() {
+    FlatUUIDHash<int> map;
+    QUuid first = QUuid::createUuid();
+    QUuid second = QUuid::createUuid();
+
+    QVERIFY(!map.find(first));
+    map.insert(first, 1);
+    map.insert(second, 2);
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(*map.find(first), 1);
+    QCOMPARE(*map.find(second), 2);
+
+    // inserting a key again replaces its value
+    map.insert(first, 3);
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(*map.find(first), 3);
+
+    QVERIFY(map.remove(first));
+    QVERIFY(!map.remove(first));
+    QVERIFY(!map.contains(first));
+    QCOMPARE(*map.find(second), 2);
+    QCOMPARE(map.size(), 1);
+
+    map.clear();
+    QVERIFY(map.isEmpty());
+    QVERIFY(!map.find(second));
+}
+
+void FlatUUIDHashTests::matchesQHash() {
+    // random inserts and removes, with the shifts back after removes, have to leave the same entries as a QHash
+    std::mt19937 generator(1);
+    FlatUUIDHash<int> map;
+    QHash<QUuid, int> expected;
+    QVector<QUuid> ids;
+
+    for (int step = 0; step < 50000; step++) {
+        if (ids.isEmpty() || generator() % 3 != 0) {
+            QUuid id = QUuid::createUuid();
+            int value = (int)generator();
+            map.insert(id, value);
+            expected.insert(id, value);
+            ids.push_back(id);
+        } else {
+            int index = (int)(generator() % ids.size());
+            QCOMPARE(map.remove(ids[index]), expected.remove(ids[index]) > 0);
+            ids[index] = ids.back();
+            ids.pop_back();
+        }
+    }
+
+    QCOMPARE(map.size(), expected.size());
+    for (auto it = expected.constBegin(); it != expected.constEnd(); ++it) {
+        const int* value = map.find(it.key());
+        QVERIFY(value);
+        QCOMPARE(*value, it.value());
+    }
+
+    int numVisited = 0;
+    map.forEach([&](const QUuid& id, int value) {
+        QCOMPARE(expected.value(id), value);
+        numVisited++;
+    });
+    QCOMPARE(numVisited, expected.size());
+}
+
+void FlatUUIDHashTests::lookupBenchmark() {
+    FlatUUIDHash<int> map;
+    std::vector<QUuid> ids;
+    for (int i = 0; i < NUM_BENCHMARK_IDS; i++) {
+        ids.push_back(QUuid::createUuid());
+        map.insert(ids.back(), i);
+    }
+
+    int sum = 0;
+    QBENCHMARK {
+        for (const auto& id : ids) {
+            sum += *map.find(id);
+        }
+    }
+    QVERIFY(sum != 0);
+}
+
+void FlatUUIDHashTests::qHashLookupBenchmark() {
+    QHash<QUuid, int> map;
+    std::vector<QUuid> ids;
+    for (int i = 0; i < NUM_BENCHMARK_IDS; i++) {
+        ids.push_back(QUuid::createUuid());
+        map.insert(ids.back(), i);
+    }
+
+    int sum = 0;
+    QBENCHMARK {
+        for (const auto& id : ids) {
+            sum += map.value(id);
+        }
+    }
+    QVERIFY(sum != 0);
+}
@@ -0,0 +1,26 @@
+//
+//  FlatUUIDHashTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FlatUUIDHashTests_h
+#define hifi_FlatUUIDHashTests_h
+
+#include <QtTest/QtTest>
+
+class FlatUUIDHashTests : public QObject {
+    Q_OBJECT
+private slots:
+    void insertFindRemove();
+    void matchesQHash();
+    void lookupBenchmark();
+    void qHashLookupBenchmark();
+};
+
+#endif // hifi_FlatUUIDHashTests_h
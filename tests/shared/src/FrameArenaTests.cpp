@@ -0,0 +1,114 @@
+//
+//  FrameArenaTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameArenaTests.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <FrameArena.h>
+
+QTEST_MAIN(FrameArenaTests)
+
+void FrameArenaTests::alignment() {
+    FrameArena arena;
+    FrameArena::Scope scope(arena);
+
+    for (size_t alignment = 1; alignment <= 64; alignment *= 2) {
+        // an odd allocation first, so that the next one has to be moved up to its alignment
+        arena.allocate(1, 1);
+        void* pointer = arena.allocate(24, alignment);
+        QCOMPARE(reinterpret_cast<uintptr_t>(pointer) % alignment, (uintptr_t)0);
+    }
+}
+
+void FrameArenaTests::scopesTakeMemoryBack() {
+    FrameArena arena;
+    void* firstPointer;
+    {
+        FrameArena::Scope outerScope(arena);
+        firstPointer = arena.allocate(100, 8);
+        size_t outerBytes = arena.getBytesUsed();
+        {
+            FrameArena::Scope innerScope(arena);
+            arena.allocate(1000, 8);
+            QVERIFY(arena.getBytesUsed() > outerBytes);
+        }
+        // the inner scope only takes back what was allocated in it
+        QCOMPARE(arena.getBytesUsed(), outerBytes);
+    }
+    QCOMPARE(arena.getBytesUsed(), (size_t)0);
+    QVERIFY(arena.getLocalHighWaterMark() >= 1100);
+
+    // the next frame gets the same memory, without reserving more
+    size_t bytesReserved = arena.getBytesReserved();
+    {
+        FrameArena::Scope scope(arena);
+        QCOMPARE(arena.allocate(100, 8), firstPointer);
+    }
+    QCOMPARE(arena.getBytesReserved(), bytesReserved);
+    QVERIFY(FrameArena::getHighWaterMark() >= arena.getLocalHighWaterMark());
+}
+
+void FrameArenaTests::largeAllocations() {
+    FrameArena arena;
+    const size_t LARGE_SIZE = 4 * 1024 * 1024;
+    {
+        FrameArena::Scope scope(arena);
+        char* small = static_cast<char*>(arena.allocate(16, 8));
+        char* large = static_cast<char*>(arena.allocate(LARGE_SIZE, 16));
+        char* after = static_cast<char*>(arena.allocate(16, 8));
+        memset(large, 0xff, LARGE_SIZE);
+        memset(small, 0, 16);
+        memset(after, 0, 16);
+        QCOMPARE((unsigned char)large[0], (unsigned char)0xff);
+        QCOMPARE((unsigned char)large[LARGE_SIZE - 1], (unsigned char)0xff);
+        QVERIFY(arena.getBytesReserved() >= LARGE_SIZE);
+    }
+
+    // blocks are kept for the frames after, small and large
+    size_t bytesReserved = arena.getBytesReserved();
+    for (int frame = 0; frame < 10; frame++) {
+        FrameArena::Scope scope(arena);
+        arena.allocate(16, 8);
+        arena.allocate(LARGE_SIZE, 16);
+        arena.allocate(16, 8);
+    }
+    QCOMPARE(arena.getBytesReserved(), bytesReserved);
+}
+
+void FrameArenaTests::frameVector() {
+    FrameArena::Scope scope;
+    FrameVector<int> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(i);
+    }
+    for (int i = 0; i < 10000; i++) {
+        QCOMPARE(values[i], i);
+    }
+
+    FrameVector<std::pair<int, double>> pairs;
+    pairs.reserve(100);
+    pairs.emplace_back(1, 2.0);
+    QCOMPARE(pairs.back().second, 2.0);
+    QVERIFY(values.get_allocator() == pairs.get_allocator());
+}
+
+void FrameArenaTests::frameVectorBenchmark() {
+    QBENCHMARK {
+        FrameArena::Scope scope;
+        FrameVector<int> values;
+        values.reserve(1000);
+        for (int i = 0; i < 1000; i++) {
+            values.push_back(i);
+        }
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  FrameArenaTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrameArenaTests_h
+#define hifi_FrameArenaTests_h
+
+#include <QtTest/QtTest>
+
+class FrameArenaTests : public QObject {
+    Q_OBJECT
+private slots:
+    void alignment();
+    void scopesTakeMemoryBack();
+    void largeAllocations();
+    void frameVector();
+    void frameVectorBenchmark();
+};
+
+#endif // hifi_FrameArenaTests_h
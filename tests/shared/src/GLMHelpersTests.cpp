@@ -11,6 +11,7 @@
 
 #include "GLMHelpersTests.h"
 
+#include <BitStream.h>
 #include <NumericalConstants.h>
 #include <StreamUtils.h>
 
@@ -102,3 +103,99 @@ void GLMHelpersTests::testSixByteOrientationCompression() {
     testQuatCompression(-(ROT_Y_180 * ROT_Z_30 * ROT_X_90));
     testQuatCompression(-(ROT_Z_30 * ROT_X_90 * ROT_Y_180));
 }
+
+void GLMHelpersTests::testBitStream() {
+    uint8_t bytes[8];
+    memset(bytes, 0xff, sizeof(bytes));
+
+    BitWriter writer(bytes);
+    writer.write(0x5, 3);
+    writer.write(0x1234, 13);
+    writer.write(0x0, 1);
+    writer.write(0xdeadbeef, 32);
+    writer.write(0x3, 2);
+    QCOMPARE(writer.flush(), 7); // 51 bits
+
+    BitReader reader(bytes, 7);
+    QCOMPARE(reader.read(3), (uint32_t)0x5);
+    QCOMPARE(reader.read(13), (uint32_t)0x1234);
+    QCOMPARE(reader.read(1), (uint32_t)0x0);
+    QCOMPARE(reader.read(32), (uint32_t)0xdeadbeef);
+    QCOMPARE(reader.read(2), (uint32_t)0x3);
+    QCOMPARE(reader.overflowed(), false);
+
+    // the padding of the last byte reads as zeros, past it the reader overflows
+    QCOMPARE(reader.read(5), (uint32_t)0x0);
+    QCOMPARE(reader.overflowed(), false);
+    QCOMPARE(reader.read(1), (uint32_t)0x0);
+    QCOMPARE(reader.overflowed(), true);
+}
+
+static void testBitPackedQuatCompression(glm::quat testQuat, int bitsPerComponent) {
+    // the three packed components are off by at most half a step of the quantization, the largest one is rebuilt
+    // from them and normalizing spreads its error, so allow two steps
+    const float MAX_COMPONENT_ERROR = 2.0f * sqrtf(2.0f) / (float)((1 << bitsPerComponent) - 1);
+
+    uint8_t bytes[8];
+    BitWriter writer(bytes);
+    packOrientationQuatToBits(writer, testQuat, bitsPerComponent);
+    QCOMPARE(writer.flush(), (3 * bitsPerComponent + 2 + BITS_IN_BYTE - 1) / BITS_IN_BYTE);
+
+    BitReader reader(bytes, sizeof(bytes));
+    glm::quat q = unpackOrientationQuatFromBits(reader, bitsPerComponent);
+    if (glm::dot(q, testQuat) < 0.0f) {
+        q = -q;
+    }
+    QCOMPARE_WITH_ABS_ERROR(q.x, testQuat.x, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.y, testQuat.y, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.z, testQuat.z, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.w, testQuat.w, MAX_COMPONENT_ERROR);
+}
+
+void GLMHelpersTests::testBitPackedOrientationCompression() {
+    const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::quat ROT_Y_180 = glm::angleAxis(PI, glm::vec3(0.0f, 1.0, 0.0f));
+    const glm::quat ROT_Z_30 = glm::angleAxis(PI / 6.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+
+    const int BIT_DEPTHS[] = { 6, 10, 12, 15 };
+    for (int bitsPerComponent : BIT_DEPTHS) {
+        testBitPackedQuatCompression(glm::quat(), bitsPerComponent);
+        testBitPackedQuatCompression(ROT_X_90, bitsPerComponent);
+        testBitPackedQuatCompression(ROT_Y_180, bitsPerComponent);
+        testBitPackedQuatCompression(ROT_Z_30, bitsPerComponent);
+        testBitPackedQuatCompression(ROT_X_90 * ROT_Y_180 * ROT_Z_30, bitsPerComponent);
+        testBitPackedQuatCompression(-(ROT_Z_30 * ROT_X_90), bitsPerComponent);
+    }
+}
+
+void GLMHelpersTests::testBitPackedVec3Compression() {
+    const float MAX_DIMENSION = 1.5f;
+    const int BITS_PER_COMPONENT = 12;
+    const float MAX_COMPONENT_ERROR = MAX_DIMENSION / (float)((1 << BITS_PER_COMPONENT) - 1);
+
+    const glm::vec3 VECTORS[] = {
+        glm::vec3(0.0f), glm::vec3(MAX_DIMENSION, -MAX_DIMENSION, 0.25f), glm::vec3(-0.1f, 0.7f, -1.2f)
+    };
+
+    uint8_t bytes[32];
+    BitWriter writer(bytes);
+    for (auto& vector : VECTORS) {
+        packFloatVec3ToBits(writer, vector, MAX_DIMENSION, BITS_PER_COMPONENT);
+    }
+    QCOMPARE(writer.flush(), 3 * 3 * BITS_PER_COMPONENT / BITS_IN_BYTE);
+
+    BitReader reader(bytes, sizeof(bytes));
+    for (auto& vector : VECTORS) {
+        glm::vec3 unpacked = unpackFloatVec3FromBits(reader, MAX_DIMENSION, BITS_PER_COMPONENT);
+        QCOMPARE_WITH_ABS_ERROR(unpacked.x, vector.x, MAX_COMPONENT_ERROR);
+        QCOMPARE_WITH_ABS_ERROR(unpacked.y, vector.y, MAX_COMPONENT_ERROR);
+        QCOMPARE_WITH_ABS_ERROR(unpacked.z, vector.z, MAX_COMPONENT_ERROR);
+    }
+
+    // the extremes come back exactly, so that the largest translation is still the largest when it is packed again
+    BitReader extremesReader(bytes, sizeof(bytes));
+    unpackFloatVec3FromBits(extremesReader, MAX_DIMENSION, BITS_PER_COMPONENT);
+    glm::vec3 extremes = unpackFloatVec3FromBits(extremesReader, MAX_DIMENSION, BITS_PER_COMPONENT);
+    QCOMPARE(extremes.x, MAX_DIMENSION);
+    QCOMPARE(extremes.y, -MAX_DIMENSION);
+}
@@ -20,6 +20,9 @@ class GLMHelpersTests : public QObject {
 private slots:
     void testEulerDecomposition();
     void testSixByteOrientationCompression();
+    void testBitStream();
+    void testBitPackedOrientationCompression();
+    void testBitPackedVec3Compression();
 };
 
 float getErrorDifference(const float& a, const float& b);
@@ -0,0 +1,111 @@
+//
+//  GzipTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipTests.h"
+
+#include <QtCore/QBuffer>
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+namespace {
+
+// something like the JSON of a persist file, big enough to make a few of the blocks compressed in parallel
+QByteArray makeData(int size) {
+    QByteArray data;
+    data.reserve(size);
+    for (int i = 0; data.size() < size; ++i) {
+        data += "{ \"id\": " + QByteArray::number(i) + ", \"position\": [" + QByteArray::number(i % 97) + "] },\n";
+    }
+    data.resize(size);
+    return data;
+}
+
+QByteArray compress(const QByteArray& source, int numThreads, int writeSize) {
+    QByteArray compressed;
+    QBuffer buffer(&compressed);
+    buffer.open(QIODevice::WriteOnly);
+    GzipDevice gzipDevice(&buffer, -1, numThreads);
+    if (!gzipDevice.open(QIODevice::WriteOnly)) {
+        return QByteArray();
+    }
+    for (int offset = 0; offset < source.size(); offset += writeSize) {
+        gzipDevice.write(source.constData() + offset, qMin(writeSize, source.size() - offset));
+    }
+    gzipDevice.close();
+    return gzipDevice.hasError() ? QByteArray() : compressed;
+}
+
+QByteArray decompress(QByteArray compressed, bool* hasError = nullptr) {
+    QBuffer buffer(&compressed);
+    buffer.open(QIODevice::ReadOnly);
+    GzipDevice gzipDevice(&buffer);
+    QByteArray data;
+    if (gzipDevice.open(QIODevice::ReadOnly)) {
+        data = gzipDevice.readAll();
+    }
+    if (hasError) {
+        *hasError = !gzipDevice.isOpen() || gzipDevice.hasError();
+    }
+    return data;
+}
+
+}
+
+void GzipTests::streamsThroughDevice() {
+    for (int size : { 0, 1, 5000, 300 * 1000 }) {
+        QByteArray source = makeData(size);
+        QByteArray compressed = compress(source, 1, 777);
+        QVERIFY(!compressed.isEmpty());
+
+        QByteArray unzipped;
+        QVERIFY(gunzip(compressed, unzipped));
+        QCOMPARE(unzipped, source);
+
+        bool hasError = true;
+        QCOMPARE(decompress(compressed, &hasError), source);
+        QVERIFY(!hasError);
+    }
+}
+
+void GzipTests::compressesInParallel() {
+    for (int size : { 0, 100, 1024 * 1024, 5 * 1024 * 1024 + 17 }) {
+        QByteArray source = makeData(size);
+        for (int writeSize : { 4096, source.size() + 1 }) {
+            QByteArray compressed = compress(source, 4, writeSize);
+            QVERIFY(!compressed.isEmpty());
+
+            QByteArray unzipped;
+            QVERIFY(gunzip(compressed, unzipped));
+            QCOMPARE(unzipped, source);
+            QCOMPARE(decompress(compressed), source);
+        }
+    }
+}
+
+void GzipTests::readsConcatenatedMembers() {
+    QByteArray first;
+    QByteArray second;
+    QVERIFY(gzip("hello ", first));
+    QVERIFY(gzip("world", second));
+    QCOMPARE(decompress(first + second), QByteArray("hello world"));
+}
+
+void GzipTests::failsOnTruncatedData() {
+    QByteArray compressed;
+    QVERIFY(gzip(makeData(10000), compressed));
+    compressed.chop(3);
+
+    bool hasError = false;
+    decompress(compressed, &hasError);
+    QVERIFY(hasError);
+}
@@ -0,0 +1,26 @@
+//
+//  GzipTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GzipTests_h
+#define hifi_GzipTests_h
+
+#include <QtTest/QtTest>
+
+class GzipTests : public QObject {
+    Q_OBJECT
+private slots:
+    void streamsThroughDevice();
+    void compressesInParallel();
+    void readsConcatenatedMembers();
+    void failsOnTruncatedData();
+};
+
+#endif // hifi_GzipTests_h
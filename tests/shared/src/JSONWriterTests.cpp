@@ -0,0 +1,131 @@
+//
+//  JSONWriterTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JSONWriterTests.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <JSONWriter.h>
+
+QTEST_MAIN(JSONWriterTests)
+
+void JSONWriterTests::matchesQJsonDocument() {
+    QByteArray json;
+    JSONWriter writer(json);
+    writer.beginObject();
+    writer.writeMember("name", QString("box"));
+    writer.writeMember("visible", false);
+    writer.writeMember("count", 3);
+    writer.key("position");
+    writer.beginObject();
+    writer.writeMember("x", 1.5f);
+    writer.writeMember("y", -2.0f);
+    writer.endObject();
+    writer.key("list");
+    writer.beginArray();
+    writer.write(1);
+    writer.write("two");
+    writer.writeNull();
+    writer.endArray();
+    writer.key("empty");
+    writer.beginArray();
+    writer.endArray();
+    writer.endObject();
+
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QJsonObject expected;
+    expected["name"] = "box";
+    expected["visible"] = false;
+    expected["count"] = 3;
+    QJsonObject position;
+    position["x"] = 1.5;
+    position["y"] = -2.0;
+    expected["position"] = position;
+    expected["list"] = QJsonArray({ 1, "two", QJsonValue() });
+    expected["empty"] = QJsonArray();
+    QCOMPARE(document.object(), expected);
+}
+
+void JSONWriterTests::emptyGroupsAreLeftOut() {
+    QByteArray json;
+    JSONWriter writer(json);
+    writer.beginObject();
+    writer.beginGroup("unused");
+    writer.beginGroup("nested");
+    writer.endGroup();
+    writer.endGroup();
+    writer.beginGroup("outer");
+    writer.beginGroup("inner");
+    writer.writeMember("value", 1);
+    writer.endGroup();
+    writer.endGroup();
+    writer.endObject();
+
+    QJsonObject object = QJsonDocument::fromJson(json).object();
+    QCOMPARE(object.keys(), QStringList({ "outer" }));
+    QCOMPARE(object["outer"].toObject()["inner"].toObject()["value"].toInt(), 1);
+}
+
+void JSONWriterTests::escapesStrings() {
+    QString text = QString::fromUtf8("quote \" backslash \\ tab \t newline \n bell \x07 \xc3\xa9");
+    QByteArray json;
+    JSONWriter writer(json);
+    writer.beginArray();
+    writer.write(text);
+    writer.endArray();
+
+    QCOMPARE(QJsonDocument::fromJson(json).array().at(0).toString(), text);
+}
+
+void JSONWriterTests::floatsReadBack() {
+    const float values[] = { 0.1f, 1.0f / 3.0f, 123456.789f, 1.0e-20f, -3.4e38f, 0.0f };
+    for (float value : values) {
+        QByteArray json;
+        JSONWriter writer(json);
+        writer.beginArray();
+        writer.write(value);
+        writer.endArray();
+        QCOMPARE((float)QJsonDocument::fromJson(json).array().at(0).toDouble(), value);
+    }
+
+    // the shortest text that does it
+    QByteArray json;
+    JSONWriter writer(json);
+    writer.beginArray();
+    writer.write(0.1f);
+    writer.endArray();
+    QVERIFY(json.contains("0.1\n"));
+}
+
+void JSONWriterTests::writeBenchmark() {
+    QBENCHMARK {
+        QByteArray json;
+        JSONWriter writer(json);
+        writer.beginArray();
+        for (int i = 0; i < 10000; i++) {
+            writer.beginObject();
+            writer.writeMember("name", QString("entity"));
+            writer.key("position");
+            writer.beginObject();
+            writer.writeMember("x", (float)i * 0.25f);
+            writer.writeMember("y", 1.0f);
+            writer.writeMember("z", -(float)i);
+            writer.endObject();
+            writer.endObject();
+        }
+        writer.endArray();
+    }
+}
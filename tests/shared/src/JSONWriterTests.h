@@ -0,0 +1,27 @@
+//
+//  JSONWriterTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JSONWriterTests_h
+#define hifi_JSONWriterTests_h
+
+#include <QtTest/QtTest>
+
+class JSONWriterTests : public QObject {
+    Q_OBJECT
+private slots:
+    void matchesQJsonDocument();
+    void emptyGroupsAreLeftOut();
+    void escapesStrings();
+    void floatsReadBack();
+    void writeBenchmark();
+};
+
+#endif // hifi_JSONWriterTests_h
@@ -0,0 +1,94 @@
+//
+//  MetricsTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsTests.h"
+
+#include <QtCore/QJsonArray>
+
+#include <Metrics.h>
+
+QTEST_MAIN(MetricsTests)
+
+void MetricsTests::sameNameSameMetric() {
+    auto& counter = Metrics::counter("test_same_name_total", "A counter");
+    counter.add();
+    counter.add(4);
+
+    auto& again = Metrics::counter("test_same_name_total", "A counter");
+    QCOMPARE(&again, &counter);
+    QCOMPARE(again.get(), (uint64_t)5);
+
+    QJsonObject metric = Metrics::toJson()["test_same_name_total"].toObject();
+    QCOMPARE(metric["type"].toString(), QString("counter"));
+    QCOMPARE(metric["value"].toDouble(), 5.0);
+}
+
+void MetricsTests::histogramBuckets() {
+    auto& histogram = Metrics::histogram("test_buckets", "A histogram", { 1.0, 2.0 });
+    histogram.observe(0.5);
+    histogram.observe(1.0); // a bound is in its own bucket
+    histogram.observe(1.5);
+    histogram.observe(3.0);
+
+    QCOMPARE(histogram.getCount(), (uint64_t)4);
+    QCOMPARE(histogram.getSum(), 6.0);
+
+    QJsonArray counts = histogram.toJson()["counts"].toArray();
+    QCOMPARE(counts.size(), 3);
+    QCOMPARE(counts[0].toDouble(), 2.0);
+    QCOMPARE(counts[1].toDouble(), 3.0);
+    QCOMPARE(counts[2].toDouble(), 4.0);
+}
+
+void MetricsTests::prometheusText() {
+    QJsonObject mixerMetrics;
+    mixerMetrics["test_frames_total"] = QJsonObject { { "type", "counter" }, { "help", "Frames" }, { "value", 10 } };
+    mixerMetrics["test_frame_seconds"] = QJsonObject {
+        { "type", "histogram" }, { "help", "Frame time" },
+        { "bounds", QJsonArray { 0.01 } }, { "counts", QJsonArray { 3, 4 } }, { "sum", 0.5 }
+    };
+
+    QJsonObject otherMetrics;
+    otherMetrics["test_frames_total"] = QJsonObject { { "type", "counter" }, { "help", "Frames" }, { "value", 2 } };
+
+    QList<Metrics::Source> sources;
+    Metrics::Source mixer;
+    mixer.labels.append(qMakePair(QString("assignment"), QString("audio-mixer")));
+    mixer.metrics = mixerMetrics;
+    sources.append(mixer);
+    Metrics::Source other;
+    other.labels.append(qMakePair(QString("pool"), QString("a \"quoted\" pool")));
+    other.metrics = otherMetrics;
+    sources.append(other);
+
+    QByteArray expected =
+        "# HELP test_frame_seconds Frame time\n"
+        "# TYPE test_frame_seconds histogram\n"
+        "test_frame_seconds_bucket{assignment=\"audio-mixer\",le=\"0.01\"} 3\n"
+        "test_frame_seconds_bucket{assignment=\"audio-mixer\",le=\"+Inf\"} 4\n"
+        "test_frame_seconds_sum{assignment=\"audio-mixer\"} 0.5\n"
+        "test_frame_seconds_count{assignment=\"audio-mixer\"} 4\n"
+        "# HELP test_frames_total Frames\n"
+        "# TYPE test_frames_total counter\n"
+        "test_frames_total{assignment=\"audio-mixer\"} 10\n"
+        "test_frames_total{pool=\"a \\\"quoted\\\" pool\"} 2\n";
+    QCOMPARE(Metrics::toPrometheusText(sources), expected);
+}
+
+void MetricsTests::prometheusTextSkipsBadMetrics() {
+    QJsonObject metrics;
+    metrics["test bad name"] = QJsonObject { { "type", "counter" }, { "help", "" }, { "value", 1 } };
+    metrics["test_bad_type"] = QJsonObject { { "type", "summary" }, { "help", "" }, { "value", 1 } };
+
+    Metrics::Source source;
+    source.metrics = metrics;
+    QCOMPARE(Metrics::toPrometheusText({ source }), QByteArray());
+}
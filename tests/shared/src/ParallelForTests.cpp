@@ -0,0 +1,86 @@
+//
+//  ParallelForTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParallelForTests.h"
+
+#include <atomic>
+#include <vector>
+
+#include <QtCore/QSemaphore>
+
+#include <ParallelFor.h>
+
+QTEST_MAIN(ParallelForTests)
+
+namespace {
+
+// keeps a thread of the pool until it is released
+class BlockingJob : public QRunnable {
+public:
+    BlockingJob(QSemaphore& started, QSemaphore& release) : _started(started), _release(release) {}
+
+    void run() override {
+        _started.release();
+        _release.acquire();
+    }
+
+private:
+    QSemaphore& _started;
+    QSemaphore& _release;
+};
+
+}
+
+void ParallelForTests::callsEveryIndexOnce() {
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    const int COUNT = 1000;
+    std::vector<std::atomic<int>> calls(COUNT);
+    for (auto& call : calls) {
+        call = 0;
+    }
+
+    for (int run = 0; run < 20; ++run) {
+        parallelFor(COUNT, [&](int index) { ++calls[index]; }, &pool);
+    }
+
+    for (int i = 0; i < COUNT; ++i) {
+        QCOMPARE(calls[i].load(), 20);
+    }
+}
+
+void ParallelForTests::emptyRange() {
+    QThreadPool pool;
+    bool called = false;
+    parallelFor(0, [&](int index) { called = true; }, &pool);
+    QVERIFY(!called);
+}
+
+void ParallelForTests::busyPool() {
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+
+    // hold every thread of the pool, the calling thread has to do all of the work on its own
+    QSemaphore started;
+    QSemaphore release;
+    for (int i = 0; i < pool.maxThreadCount(); ++i) {
+        pool.start(new BlockingJob(started, release));
+    }
+    started.acquire(pool.maxThreadCount());
+
+    int sum = 0;
+    parallelFor(10, [&](int index) { sum += index; }, &pool);
+    QCOMPARE(sum, 45);
+
+    release.release(pool.maxThreadCount());
+    pool.waitForDone();
+}
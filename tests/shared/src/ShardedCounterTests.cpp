@@ -0,0 +1,54 @@
+//
+//  ShardedCounterTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShardedCounterTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <ShardedCounter.h>
+
+QTEST_MAIN(ShardedCounterTests)
+
+void ShardedCounterTests::startsAtZero() {
+    ShardedCounter counter;
+    QCOMPARE(counter.get(), (uint64_t)0);
+}
+
+void ShardedCounterTests::addsOnOneThread() {
+    ShardedCounter counter;
+    counter.add(5);
+    counter.add(0);
+    counter.add(1500);
+    QCOMPARE(counter.get(), (uint64_t)1505);
+}
+
+void ShardedCounterTests::addsOnManyThreads() {
+    const int NUM_THREADS = 16;
+    const int ADDS_PER_THREAD = 100000;
+
+    ShardedCounter counter;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&counter, i] {
+            for (int j = 0; j < ADDS_PER_THREAD; ++j) {
+                counter.add(i + 1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // every thread adds 1 more each time than the one before it
+    uint64_t expected = (uint64_t)ADDS_PER_THREAD * NUM_THREADS * (NUM_THREADS + 1) / 2;
+    QCOMPARE(counter.get(), expected);
+}
@@ -0,0 +1,25 @@
+//
+//  ShardedCounterTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShardedCounterTests_h
+#define hifi_ShardedCounterTests_h
+
+#include <QtTest/QtTest>
+
+class ShardedCounterTests : public QObject {
+    Q_OBJECT
+private slots:
+    void startsAtZero();
+    void addsOnOneThread();
+    void addsOnManyThreads();
+};
+
+#endif // hifi_ShardedCounterTests_h
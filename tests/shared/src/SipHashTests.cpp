@@ -0,0 +1,100 @@
+//
+//  SipHashTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SipHashTests.h"
+
+#include <SipHash.h>
+
+QTEST_MAIN(SipHashTests)
+
+// the key and the messages of the reference test vectors are the bytes 0, 1, 2, ...
+static void referenceKey(uint8_t* key) {
+    for (int i = 0; i < SipHash::KEY_SIZE; i++) {
+        key[i] = (uint8_t)i;
+    }
+}
+
+static QByteArray referenceMessage(int length) {
+    QByteArray message(length, 0);
+    for (int i = 0; i < length; i++) {
+        message[i] = (char)i;
+    }
+    return message;
+}
+
+void SipHashTests::referenceVectors() {
+    uint8_t key[SipHash::KEY_SIZE];
+    referenceKey(key);
+
+    SipHash hash(key);
+    QCOMPARE(hash.result(), (uint64_t)0x726fdb47dd0e0e31ULL);
+
+    hash.reset();
+    QByteArray message = referenceMessage(15);
+    hash.addData(message.constData(), message.size());
+    QCOMPARE(hash.result(), (uint64_t)0xa129ca6149be45e5ULL);
+}
+
+void SipHashTests::referenceVectors128() {
+    uint8_t key[SipHash::KEY_SIZE];
+    referenceKey(key);
+
+    static const uint8_t EMPTY_MESSAGE_HASH[16] = {
+        0xa3, 0x81, 0x7f, 0x04, 0xba, 0x25, 0xa8, 0xe6, 0x6d, 0xf6, 0x72, 0x14, 0xc7, 0x55, 0x02, 0x93
+    };
+    static const uint8_t MESSAGE_15_HASH[16] = {
+        0x54, 0x93, 0xe9, 0x99, 0x33, 0xb0, 0xa8, 0x11, 0x7e, 0x08, 0xec, 0x0f, 0x97, 0xcf, 0xc3, 0xd9
+    };
+
+    SipHash hash(key, SipHash::Output128);
+    uint8_t result[16];
+    hash.result128(result);
+    QVERIFY(memcmp(result, EMPTY_MESSAGE_HASH, sizeof(result)) == 0);
+
+    hash.reset();
+    QByteArray message = referenceMessage(15);
+    hash.addData(message.constData(), message.size());
+    hash.result128(result);
+    QVERIFY(memcmp(result, MESSAGE_15_HASH, sizeof(result)) == 0);
+}
+
+void SipHashTests::splitMessages() {
+    uint8_t key[SipHash::KEY_SIZE];
+    referenceKey(key);
+    QByteArray message = referenceMessage(64);
+
+    SipHash whole(key);
+    whole.addData(message.constData(), message.size());
+    uint64_t expected = whole.result();
+
+    // the words of the message may be split anywhere across the calls
+    for (int split = 0; split <= message.size(); split++) {
+        SipHash parts(key);
+        parts.addData(message.constData(), split / 3);
+        parts.addData(message.constData() + split / 3, split - split / 3);
+        parts.addData(message.constData() + split, message.size() - split);
+        QCOMPARE(parts.result(), expected);
+    }
+}
+
+void SipHashTests::hashBenchmark() {
+    uint8_t key[SipHash::KEY_SIZE];
+    referenceKey(key);
+    // about the payload of an audio packet
+    QByteArray message = referenceMessage(1000);
+    uint8_t result[16];
+
+    QBENCHMARK {
+        SipHash hash(key, SipHash::Output128);
+        hash.addData(message.constData(), message.size());
+        hash.result128(result);
+    }
+}
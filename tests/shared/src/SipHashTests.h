@@ -0,0 +1,26 @@
+//
+//  SipHashTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SipHashTests_h
+#define hifi_SipHashTests_h
+
+#include <QtTest/QtTest>
+
+class SipHashTests : public QObject {
+    Q_OBJECT
+private slots:
+    void referenceVectors();
+    void referenceVectors128();
+    void splitMessages();
+    void hashBenchmark();
+};
+
+#endif // hifi_SipHashTests_h
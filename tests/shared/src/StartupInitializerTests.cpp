@@ -0,0 +1,98 @@
+//
+//  StartupInitializerTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StartupInitializerTests.h"
+
+#include <atomic>
+
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+
+#include <StartupInitializer.h>
+
+QTEST_MAIN(StartupInitializerTests)
+
+namespace {
+
+// keeps a thread of the pool until it is released
+class BlockingJob : public QRunnable {
+public:
+    BlockingJob(QSemaphore& started, QSemaphore& release) : _started(started), _release(release) {}
+
+    void run() override {
+        _started.release();
+        _release.acquire();
+    }
+
+private:
+    QSemaphore& _started;
+    QSemaphore& _release;
+};
+
+}
+
+void StartupInitializerTests::runsAfterDependencies() {
+    QThreadPool pool;
+    pool.setMaxThreadCount(3);
+
+    for (int run = 0; run < 50; ++run) {
+        std::atomic<int> nextOrder { 0 };
+        int first = -1;
+        int second = -1;
+        int combined = -1;
+        int last = -1;
+
+        StartupInitializer startup(&pool);
+        startup.startStep("first", [&] {
+            QThread::usleep(100);
+            first = nextOrder++;
+        });
+        startup.startStep("second", [&] { second = nextOrder++; });
+        startup.startStep("combined", [&] { combined = nextOrder++; }, { "first", "second" });
+        startup.startStep("last", [&] { last = nextOrder++; }, { "combined" });
+
+        startup.waitFor("combined");
+        QVERIFY(first >= 0 && second >= 0);
+        QVERIFY(combined > first && combined > second);
+
+        startup.waitForAll();
+        QVERIFY(last > combined);
+
+        auto timings = startup.getTimings();
+        QCOMPARE((int)timings.size(), 4);
+        QCOMPARE(QString(timings.back().name), QString("last"));
+        for (auto& timing : timings) {
+            QVERIFY(timing.endNsecs >= timing.beginNsecs);
+        }
+    }
+}
+
+void StartupInitializerTests::waitingRunsQueuedStep() {
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    // with the only thread of the pool held, the waiting thread has to run the step itself
+    QSemaphore started;
+    QSemaphore release;
+    pool.start(new BlockingJob(started, release));
+    started.acquire();
+
+    bool ran = false;
+    {
+        StartupInitializer startup(&pool);
+        startup.startStep("step", [&] { ran = true; });
+        startup.waitFor("step");
+        QVERIFY(ran);
+    }
+
+    release.release();
+    pool.waitForDone();
+}
@@ -0,0 +1,24 @@
+//
+//  StartupInitializerTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_StartupInitializerTests_h
+#define hifi_StartupInitializerTests_h
+
+#include <QtTest/QtTest>
+
+class StartupInitializerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void runsAfterDependencies();
+    void waitingRunsQueuedStep();
+};
+
+#endif // hifi_StartupInitializerTests_h
@@ -0,0 +1,129 @@
+//
+//  TimingWheelTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimingWheelTests.h"
+
+#include <TimingWheel.h>
+
+QTEST_MAIN(TimingWheelTests)
+
+using Wheel = TimingWheel<int>;
+
+static const quint64 SLOT_USECS = 10 * 1000;
+static const quint64 START_USECS = 1000 * SLOT_USECS + 123;
+static const quint64 TURN_USECS = Wheel::NUM_SLOTS * SLOT_USECS;
+
+void TimingWheelTests::batchesBySlot() {
+    Wheel wheel(SLOT_USECS);
+    wheel.insert(START_USECS, START_USECS + 2 * SLOT_USECS, 3);
+    wheel.insert(START_USECS, START_USECS, 1);
+    wheel.insert(START_USECS, START_USECS + 1000, 2);
+    wheel.insert(START_USECS, START_USECS + SLOT_USECS + 5000, 4);
+    QCOMPARE(wheel.size(), (size_t)4);
+
+    // everything in the slot START_USECS is in comes out together
+    std::vector<int> batch;
+    QCOMPARE(wheel.popDue(START_USECS, batch), 2);
+    QCOMPARE(batch, std::vector<int>({ 1, 2 }));
+
+    // the next slot starts at its boundary, not at the due time of its item
+    quint64 nextSlot = (START_USECS / SLOT_USECS + 1) * SLOT_USECS;
+    QCOMPARE(wheel.nextSlotUsecs(), nextSlot);
+    QCOMPARE(wheel.popDue(nextSlot - 1, batch), 0);
+
+    // a late pop picks up every slot it passed, earliest first
+    batch.clear();
+    QCOMPARE(wheel.popDue(nextSlot + 5 * SLOT_USECS, batch), 2);
+    QCOMPARE(batch, std::vector<int>({ 4, 3 }));
+    QVERIFY(wheel.empty());
+}
+
+void TimingWheelTests::overdueGoesInOpenSlot() {
+    Wheel wheel(SLOT_USECS);
+    wheel.insert(START_USECS, START_USECS, 1);
+
+    std::vector<int> batch;
+    QCOMPARE(wheel.popDue(START_USECS, batch), 1);
+
+    // items due now or earlier land in the slot that was just popped, and come out on the next pop
+    wheel.insert(START_USECS, START_USECS - 3 * SLOT_USECS, 2);
+    wheel.insert(START_USECS, START_USECS, 3);
+    QVERIFY(wheel.nextSlotUsecs() <= START_USECS);
+
+    batch.clear();
+    QCOMPARE(wheel.popDue(START_USECS, batch), 2);
+    QCOMPARE(batch, std::vector<int>({ 2, 3 }));
+}
+
+void TimingWheelTests::secondLevel() {
+    Wheel wheel(SLOT_USECS);
+
+    // far enough out to wait in the second level
+    quint64 dueUsecs = START_USECS + 3 * TURN_USECS + 7 * SLOT_USECS;
+    quint64 dueSlot = dueUsecs / SLOT_USECS * SLOT_USECS;
+    wheel.insert(START_USECS, dueUsecs, 1);
+    wheel.insert(START_USECS, START_USECS + SLOT_USECS, 2);
+    QCOMPARE(wheel.nextSlotUsecs(), (START_USECS / SLOT_USECS + 1) * SLOT_USECS);
+
+    std::vector<int> batch;
+    QCOMPARE(wheel.popDue(START_USECS + SLOT_USECS, batch), 1);
+    QCOMPARE(batch, std::vector<int>({ 2 }));
+    QCOMPARE(wheel.nextSlotUsecs(), dueSlot);
+
+    // stepping the wheel a slot at a time only gives the item up once its own slot starts
+    batch.clear();
+    for (quint64 now = START_USECS + SLOT_USECS; now < dueSlot; now += SLOT_USECS) {
+        QCOMPARE(wheel.popDue(now, batch), 0);
+    }
+    QCOMPARE(wheel.nextSlotUsecs(), dueSlot);
+    QCOMPARE(wheel.popDue(dueSlot, batch), 1);
+    QCOMPARE(batch, std::vector<int>({ 1 }));
+    QVERIFY(wheel.empty());
+}
+
+void TimingWheelTests::farFutureIsClamped() {
+    Wheel wheel(SLOT_USECS);
+    wheel.insert(START_USECS, START_USECS + 1000 * TURN_USECS, 1);
+
+    // held at the far end of the second level
+    auto nextSlot = wheel.nextSlotUsecs();
+    QVERIFY(nextSlot > START_USECS + (Wheel::NUM_SLOTS - 2) * TURN_USECS);
+    QVERIFY(nextSlot <= START_USECS + Wheel::NUM_SLOTS * TURN_USECS);
+
+    std::vector<int> batch;
+    QCOMPARE(wheel.popDue(nextSlot - 1, batch), 0);
+    QCOMPARE(wheel.popDue(nextSlot, batch), 1);
+}
+
+void TimingWheelTests::catchesUpWhenIdle() {
+    Wheel wheel(SLOT_USECS);
+    std::vector<int> batch;
+    wheel.popDue(START_USECS, batch);
+
+    // an item inserted long after the last pop is still scheduled against its own due time
+    quint64 laterUsecs = START_USECS + 100 * TURN_USECS;
+    wheel.insert(laterUsecs, laterUsecs + 2 * SLOT_USECS, 1);
+    QCOMPARE(wheel.nextSlotUsecs(), (laterUsecs / SLOT_USECS + 2) * SLOT_USECS);
+    QCOMPARE(wheel.popDue(laterUsecs, batch), 0);
+    QCOMPARE(wheel.popDue(laterUsecs + 2 * SLOT_USECS, batch), 1);
+}
+
+void TimingWheelTests::clear() {
+    Wheel wheel(SLOT_USECS);
+    wheel.insert(START_USECS, START_USECS, 1);
+    wheel.insert(START_USECS, START_USECS + 2 * TURN_USECS, 2);
+
+    int sum = 0;
+    wheel.clear([&](int& item) { sum += item; });
+    QCOMPARE(sum, 3);
+    QVERIFY(wheel.empty());
+    QCOMPARE(wheel.nextSlotUsecs(), std::numeric_limits<quint64>::max());
+}
@@ -0,0 +1,28 @@
+//
+//  TimingWheelTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimingWheelTests_h
+#define hifi_TimingWheelTests_h
+
+#include <QtTest/QtTest>
+
+class TimingWheelTests : public QObject {
+    Q_OBJECT
+private slots:
+    void batchesBySlot();
+    void overdueGoesInOpenSlot();
+    void secondLevel();
+    void farFutureIsClamped();
+    void catchesUpWhenIdle();
+    void clear();
+};
+
+#endif // hifi_TimingWheelTests_h
@@ -0,0 +1,141 @@
+//
+//  TriangleBVHTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleBVHTests.h"
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <TriangleBVH.h>
+
+QTEST_MAIN(TriangleBVHTests)
+
+namespace {
+
+// small triangles of any orientation scattered through a 10m cube
+std::vector<Triangle> makeTriangles(int count, std::mt19937& random) {
+    std::uniform_real_distribution<float> position(0.0f, 10.0f);
+    std::uniform_real_distribution<float> corner(-0.25f, 0.25f);
+    std::vector<Triangle> triangles;
+    for (int i = 0; i < count; ++i) {
+        glm::vec3 center(position(random), position(random), position(random));
+        Triangle triangle;
+        triangle.v0 = center + glm::vec3(corner(random), corner(random), corner(random));
+        triangle.v1 = center + glm::vec3(corner(random), corner(random), corner(random));
+        triangle.v2 = center + glm::vec3(corner(random), corner(random), corner(random));
+        triangles.push_back(triangle);
+    }
+    return triangles;
+}
+
+// the index of the closest triangle hit, testing them all, or -1
+int findClosestLinear(const std::vector<Triangle>& triangles, const glm::vec3& origin, const glm::vec3& direction,
+                      float& distance, bool mirrored) {
+    int closest = -1;
+    distance = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const Triangle& triangle = triangles[i];
+        float thisDistance;
+        bool hit = mirrored ?
+            findRayTriangleIntersection(origin, direction, triangle.v2, triangle.v1, triangle.v0, thisDistance) :
+            findRayTriangleIntersection(origin, direction, triangle, thisDistance);
+        if (hit && thisDistance < distance) {
+            distance = thisDistance;
+            closest = (int)i;
+        }
+    }
+    return closest;
+}
+
+void compareWithLinear(bool mirrored) {
+    std::mt19937 random(mirrored ? 11 : 7);
+    std::vector<Triangle> triangles = makeTriangles(5000, random);
+    TriangleBVH bvh;
+    bvh.build(triangles);
+
+    std::uniform_real_distribution<float> position(-2.0f, 12.0f);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    int numHits = 0;
+    for (int i = 0; i < 1000; ++i) {
+        glm::vec3 origin(position(random), position(random), position(random));
+        // some rays along the axes, which have zero components
+        glm::vec3 direction = (i % 5 == 0) ? glm::vec3(0.0f, 0.0f, component(random)) :
+            glm::vec3(component(random), component(random), component(random));
+
+        float expectedDistance;
+        int expected = findClosestLinear(triangles, origin, direction, expectedDistance, mirrored);
+
+        float distance = std::numeric_limits<float>::max();
+        Triangle triangle;
+        bool hit = bvh.findRayIntersection(origin, direction, distance, triangle, mirrored);
+        QCOMPARE(hit, expected != -1);
+        if (hit) {
+            ++numHits;
+            QCOMPARE(distance, expectedDistance);
+            QVERIFY(triangle.v0 == triangles[expected].v0);
+            QVERIFY(triangle.v1 == triangles[expected].v1);
+            QVERIFY(triangle.v2 == triangles[expected].v2);
+
+            // only hits closer than the distance passed in count
+            float closer = expectedDistance;
+            QVERIFY(!bvh.findRayIntersection(origin, direction, closer, triangle, mirrored));
+        }
+    }
+    QVERIFY(numHits > 0);
+}
+
+}
+
+void TriangleBVHTests::closestHitMatchesLinear() {
+    compareWithLinear(false);
+}
+
+void TriangleBVHTests::mirroredHitsBackFaces() {
+    compareWithLinear(true);
+
+    Triangle triangle = { glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    TriangleBVH bvh;
+    bvh.build({ triangle });
+    glm::vec3 origin(0.25f, 0.25f, 1.0f);
+    glm::vec3 direction(0.0f, 0.0f, -1.0f);
+    // the same side of the triangle is hit one way and not the other
+    float distance = std::numeric_limits<float>::max();
+    Triangle hit;
+    bool frontHit = bvh.findRayIntersection(origin, direction, distance, hit, false);
+    distance = std::numeric_limits<float>::max();
+    bool mirroredHit = bvh.findRayIntersection(origin, direction, distance, hit, true);
+    QVERIFY(frontHit != mirroredHit);
+}
+
+void TriangleBVHTests::emptyMesh() {
+    TriangleBVH bvh;
+    bvh.build(std::vector<Triangle>());
+    QVERIFY(bvh.isEmpty());
+    float distance = std::numeric_limits<float>::max();
+    Triangle triangle;
+    QVERIFY(!bvh.findRayIntersection(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), distance, triangle));
+}
+
+void TriangleBVHTests::pickBenchmark() {
+    std::mt19937 random(3);
+    std::vector<Triangle> triangles = makeTriangles(100000, random);
+    TriangleBVH bvh;
+    bvh.build(triangles);
+
+    glm::vec3 origin(-1.0f, 5.0f, 5.0f);
+    glm::vec3 direction = glm::normalize(glm::vec3(1.0f, 0.1f, 0.05f));
+    QBENCHMARK {
+        float distance = std::numeric_limits<float>::max();
+        Triangle triangle;
+        bvh.findRayIntersection(origin, direction, distance, triangle);
+    }
+}
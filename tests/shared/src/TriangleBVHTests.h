@@ -0,0 +1,26 @@
+//
+//  TriangleBVHTests.h
+//  tests/shared/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TriangleBVHTests_h
+#define hifi_TriangleBVHTests_h
+
+#include <QtTest/QtTest>
+
+class TriangleBVHTests : public QObject {
+    Q_OBJECT
+private slots:
+    void closestHitMatchesLinear();
+    void mirroredHitsBackFaces();
+    void emptyMesh();
+    void pickBenchmark();
+};
+
+#endif // hifi_TriangleBVHTests_h
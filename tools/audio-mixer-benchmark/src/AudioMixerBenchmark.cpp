@@ -0,0 +1,330 @@
+//
+//  AudioMixerBenchmark.cpp
+//  tools/audio-mixer-benchmark/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDebug>
+#include <QtCore/QJsonObject>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <Assignment.h>
+#include <AudioConstants.h>
+#include <LogHandler.h>
+#include <NLPacket.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <ReceivedMessage.h>
+#include <SharedUtil.h>
+#include <plugins/PluginManager.h>
+
+#include "AudioMixer.h"
+#include "AudioMixerClientData.h"
+
+const QCommandLineOption SOURCES_OPTION {
+    "sources", "number of clients sending a tone (default is 20)", "count"
+};
+const QCommandLineOption LISTENERS_OPTION {
+    "listeners", "number of clients receiving a mix (default is 20)", "count"
+};
+const QCommandLineOption FRAMES_OPTION {
+    "frames", "number of frames to time (default is 1000)", "count"
+};
+const QCommandLineOption THREADS_OPTION {
+    "threads", "number of mixing threads (default is 1)", "count", "1"
+};
+const QCommandLineOption CODEC_OPTION {
+    "codec", "codec plugin the clients negotiate, by name (default is none)", "name"
+};
+const QCommandLineOption NO_HRTF_OPTION {
+    "no-hrtf", "sources send stereo, which the mixer adds without the HRTF"
+};
+const QCommandLineOption HRTF_BUDGET_OPTION {
+    "hrtf-budget", "max sources HRTF rendered per listener, the rest go in the panned bed (default is 0, no limit)", "count"
+};
+const QCommandLineOption SPREAD_OPTION {
+    "spread", "side of the cube the clients are placed in (default is 20)", "meters"
+};
+const QCommandLineOption SEED_OPTION {
+    "seed", "seed for the client positions (default is 742272)", "integer"
+};
+
+const float SOURCE_AMPLITUDE = 0.25f * AudioConstants::MAX_SAMPLE_VALUE;
+const float MIN_SOURCE_FREQUENCY = 110.0f;
+const float MAX_SOURCE_FREQUENCY = 880.0f;
+
+AudioMixerBenchmark::AudioMixerBenchmark(int& argc, char** argv) :
+    QCoreApplication(argc, argv)
+{
+    qInstallMessageHandler(LogHandler::verboseMessageHandler);
+
+    // the mixer only needs a node list to walk, nothing is sent
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::AudioMixer);
+}
+
+AudioMixerBenchmark::~AudioMixerBenchmark() {
+    for (auto& client : _clients) {
+        if (client.encoder) {
+            _codec->releaseEncoder(client.encoder);
+        }
+    }
+
+    DependencyManager::get<NodeList>()->eraseAllNodes();
+    _mixer.reset();
+}
+
+int AudioMixerBenchmark::run() {
+    if (!parseArguments() || !setupCodec()) {
+        return 1;
+    }
+
+    // the mixer is built from an assignment and configured with domain settings, like the assignment-client would
+    Assignment assignment(Assignment::CreateCommand, Assignment::AudioMixerType);
+    auto assignmentPacket = NLPacket::create(PacketType::CreateAssignment);
+    QDataStream assignmentStream(assignmentPacket.get());
+    assignmentStream << assignment;
+    assignmentPacket->seek(0);
+
+    ReceivedMessage assignmentMessage(*assignmentPacket);
+    _mixer.reset(new AudioMixer(assignmentMessage));
+
+    QJsonObject threadingGroup;
+    threadingGroup["num_threads"] = _argumentParser.value(THREADS_OPTION);
+    QJsonObject envGroup;
+    envGroup["codec_preference_order"] = _codecName;
+    if (_argumentParser.isSet(HRTF_BUDGET_OPTION)) {
+        envGroup["hrtf_source_budget"] = _argumentParser.value(HRTF_BUDGET_OPTION);
+    }
+
+    QJsonObject settingsObject;
+    settingsObject["audio_threading"] = threadingGroup;
+    settingsObject["audio_env"] = envGroup;
+    _mixer->parseSettingsObject(settingsObject);
+
+    for (int i = 0; i < _numSources; ++i) {
+        addClient(true);
+    }
+    for (int i = 0; i < _numListeners; ++i) {
+        addClient(false);
+    }
+
+    qDebug() << "Mixing" << _numSources << "source(s) for" << _numListeners << "listener(s) with codec"
+        << (_codecName.isEmpty() ? "none" : _codecName) << "and the HRTF" << (_isHRTFEnabled ? "on" : "off");
+
+    for (int i = 0; i < _numWarmupFrames; ++i) {
+        mixFrame();
+    }
+
+    _frameUsecs.reserve(_numFrames);
+    quint64 totalUsecs = 0;
+    for (int i = 0; i < _numFrames; ++i) {
+        quint64 frameUsecs = mixFrame();
+        _frameUsecs.push_back(frameUsecs);
+        totalUsecs += frameUsecs;
+    }
+
+    reportResults(totalUsecs);
+    return 0;
+}
+
+bool AudioMixerBenchmark::parseArguments() {
+    _argumentParser.addOptions({
+        SOURCES_OPTION, LISTENERS_OPTION, FRAMES_OPTION, THREADS_OPTION, CODEC_OPTION,
+        NO_HRTF_OPTION, HRTF_BUDGET_OPTION, SPREAD_OPTION, SEED_OPTION
+    });
+    const QCommandLineOption helpOption = _argumentParser.addHelpOption();
+
+    if (!_argumentParser.parse(arguments())) {
+        qCritical() << _argumentParser.errorText();
+        _argumentParser.showHelp();
+        return false;
+    }
+
+    if (_argumentParser.isSet(helpOption)) {
+        _argumentParser.showHelp();
+    }
+
+    if (_argumentParser.isSet(SOURCES_OPTION)) {
+        _numSources = _argumentParser.value(SOURCES_OPTION).toInt();
+    }
+    if (_argumentParser.isSet(LISTENERS_OPTION)) {
+        _numListeners = _argumentParser.value(LISTENERS_OPTION).toInt();
+    }
+    if (_argumentParser.isSet(FRAMES_OPTION)) {
+        _numFrames = _argumentParser.value(FRAMES_OPTION).toInt();
+    }
+    if (_argumentParser.isSet(SPREAD_OPTION)) {
+        _spread = _argumentParser.value(SPREAD_OPTION).toFloat();
+    }
+
+    if (_numSources < 0 || _numListeners < 1 || _numFrames < 1) {
+        qCritical() << "Need at least one listener and one frame, and no fewer than zero sources.";
+        return false;
+    }
+
+    _codecName = _argumentParser.value(CODEC_OPTION);
+    _isHRTFEnabled = !_argumentParser.isSet(NO_HRTF_OPTION);
+
+    const unsigned int DEFAULT_SEED = 742272;
+    _generator.seed(_argumentParser.isSet(SEED_OPTION) ? _argumentParser.value(SEED_OPTION).toUInt() : DEFAULT_SEED);
+
+    return true;
+}
+
+bool AudioMixerBenchmark::setupCodec() {
+    if (_codecName.isEmpty()) {
+        return true;
+    }
+
+    // codecs are runtime plugins, they are loaded from beside the executable like they are for the assignment-client
+    QStringList availableCodecs;
+    for (auto& plugin : PluginManager::getInstance()->getCodecPlugins()) {
+        if (plugin->getName() == _codecName) {
+            _codec = plugin;
+            return true;
+        }
+        availableCodecs << plugin->getName();
+    }
+
+    qCritical() << "Codec" << _codecName << "is not available, the available codecs are" << availableCodecs;
+    return false;
+}
+
+void AudioMixerBenchmark::addClient(bool isSource) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // every client gets a port of its own, the sockets are never used
+    HifiSockAddr clientSocket { QHostAddress::LocalHost, (quint16) (_clients.size() + 1) };
+    auto node = nodeList->addOrUpdateNode(QUuid::createUuid(), NodeType::Agent, clientSocket, clientSocket);
+    node->activatePublicSocket();
+
+    auto clientData = new AudioMixerClientData(node->getUUID());
+    node->setLinkedData(std::unique_ptr<NodeData> { clientData });
+    clientData->setupCodec(_codec, _codecName);
+
+    std::uniform_real_distribution<float> positionDistribution { -0.5f * _spread, 0.5f * _spread };
+    std::uniform_real_distribution<float> yawDistribution { -PI, PI };
+    std::uniform_real_distribution<float> frequencyDistribution { MIN_SOURCE_FREQUENCY, MAX_SOURCE_FREQUENCY };
+
+    Client client;
+    client.node = node;
+    client.isSource = isSource;
+    client.position = glm::vec3(positionDistribution(_generator), 0.0f, positionDistribution(_generator));
+    client.orientation = glm::angleAxis(yawDistribution(_generator), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    if (isSource) {
+        client.phaseStep = TWO_PI * frequencyDistribution(_generator) / AudioConstants::SAMPLE_RATE;
+
+        if (_codec) {
+            client.encoder = _codec->createEncoder(AudioConstants::SAMPLE_RATE,
+                                                   _isHRTFEnabled ? AudioConstants::MONO : AudioConstants::STEREO);
+        }
+    } else {
+        _listeners.push_back(node);
+    }
+
+    _clients.push_back(client);
+}
+
+void AudioMixerBenchmark::sendFrame(Client& client) {
+    auto audioPacket = NLPacket::create(client.isSource ? PacketType::MicrophoneAudioNoEcho : PacketType::SilentAudioFrame);
+    audioPacket->writePrimitive(client.sequenceNumber++);
+    audioPacket->writeString(_codecName);
+
+    if (client.isSource) {
+        quint8 isStereo = _isHRTFEnabled ? 0 : 1;
+        audioPacket->writePrimitive(isStereo);
+    } else {
+        quint16 numSilentSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+        audioPacket->writePrimitive(numSilentSamples);
+    }
+
+    audioPacket->writePrimitive(client.position);
+    audioPacket->writePrimitive(client.orientation);
+
+    if (client.isSource) {
+        int numChannels = _isHRTFEnabled ? AudioConstants::MONO : AudioConstants::STEREO;
+        QByteArray decodedBuffer(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * numChannels * sizeof(int16_t), 0);
+        int16_t* samples = reinterpret_cast<int16_t*>(decodedBuffer.data());
+
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+            int16_t sample = (int16_t) (SOURCE_AMPLITUDE * sinf(client.phase));
+            for (int channel = 0; channel < numChannels; ++channel) {
+                samples[i * numChannels + channel] = sample;
+            }
+
+            client.phase += client.phaseStep;
+            if (client.phase > TWO_PI) {
+                client.phase -= TWO_PI;
+            }
+        }
+
+        if (client.encoder) {
+            QByteArray encodedBuffer;
+            client.encoder->encode(decodedBuffer, encodedBuffer);
+            audioPacket->write(encodedBuffer);
+        } else {
+            audioPacket->write(decodedBuffer);
+        }
+    }
+
+    audioPacket->seek(0);
+    ReceivedMessage message(*audioPacket);
+    client.node->getLinkedData()->parseData(message);
+}
+
+quint64 AudioMixerBenchmark::mixFrame() {
+    // the packets for the frame arrive before it is timed, only the mixer's own work counts
+    for (auto& client : _clients) {
+        sendFrame(client);
+    }
+
+    auto start = usecTimestampNow();
+
+    for (auto& client : _clients) {
+        static_cast<AudioMixerClientData*>(client.node->getLinkedData())->checkBuffersBeforeFrameSend();
+    }
+
+    std::vector<AudioMixer::ListenerMix> mixes(_listeners.size());
+    _mixer->mixFrame(_listeners, mixes);
+
+    return usecTimestampNow() - start;
+}
+
+void AudioMixerBenchmark::reportResults(quint64 totalUsecs) {
+    std::vector<quint64> sortedUsecs = _frameUsecs;
+    std::sort(sortedUsecs.begin(), sortedUsecs.end());
+
+    auto percentile = [&](float fraction) {
+        int index = std::min((int) (fraction * sortedUsecs.size()), (int) sortedUsecs.size() - 1);
+        return sortedUsecs[index];
+    };
+
+    float totalSeconds = std::max(totalUsecs, (quint64) 1) / (float) USECS_PER_SECOND;
+    float framesPerSecond = _numFrames / totalSeconds;
+    float mixesPerSecond = framesPerSecond * _numListeners;
+    float usecsPerListener = totalUsecs / (float) (_numFrames * _numListeners);
+
+    qDebug() << "Mixed" << _numFrames << "frame(s) in" << totalSeconds << "s with" << _mixer->_slavePool.numThreads()
+        << "thread(s)";
+    qDebug() << "    mixes/s:" << mixesPerSecond << "(" << framesPerSecond << "frames/s )";
+    qDebug() << "    per listener:" << usecsPerListener << "us";
+    qDebug() << "    frame time: p50" << percentile(0.50f) << "us, p99" << percentile(0.99f) << "us, max"
+        << sortedUsecs.back() << "us";
+    qDebug() << "    real-time budget:" << AudioConstants::NETWORK_FRAME_USECS << "us per frame, p99 uses"
+        << 100.0f * percentile(0.99f) / AudioConstants::NETWORK_FRAME_USECS << "%";
+}
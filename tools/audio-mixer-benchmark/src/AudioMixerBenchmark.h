@@ -0,0 +1,86 @@
+//
+//  AudioMixerBenchmark.h
+//  tools/audio-mixer-benchmark/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AudioMixerBenchmark_h
+#define hifi_AudioMixerBenchmark_h
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+
+#include <Node.h>
+#include <plugins/CodecPlugin.h>
+
+class AudioMixer;
+
+// Runs the audio-mixer's frame mix against synthetic clients, back to back and without a network.
+// Sources talk with a steady tone, listeners only send silent frames and receive the mix.
+class AudioMixerBenchmark : public QCoreApplication {
+public:
+    AudioMixerBenchmark(int& argc, char** argv);
+    ~AudioMixerBenchmark();
+
+    // returns the exit code for the process
+    int run();
+
+private:
+    struct Client {
+        SharedNodePointer node;
+        bool isSource;
+        glm::vec3 position;
+        glm::quat orientation;
+        float phase { 0.0f };
+        float phaseStep { 0.0f }; // radians per sample of the source's tone
+        quint16 sequenceNumber { 0 };
+        Encoder* encoder { nullptr };
+    };
+
+    bool parseArguments();
+    bool setupCodec();
+    void addClient(bool isSource);
+
+    // feeds the client's next frame into its streams, the way handleNodeAudioPacket would
+    void sendFrame(Client& client);
+
+    // pops and mixes one frame for every listener, returns the usecs it took
+    quint64 mixFrame();
+
+    void reportResults(quint64 totalUsecs);
+
+    QCommandLineParser _argumentParser;
+
+    int _numSources { 20 };
+    int _numListeners { 20 };
+    int _numFrames { 1000 };
+    int _numWarmupFrames { 50 }; // mixed before timing starts, so the jitter buffers have filled
+    float _spread { 20.0f }; // clients are placed at random in a cube this many meters on a side
+    bool _isHRTFEnabled { true };
+
+    QString _codecName;
+    CodecPluginPointer _codec;
+
+    std::unique_ptr<AudioMixer> _mixer;
+    std::vector<Client> _clients;
+    std::vector<SharedNodePointer> _listeners;
+    std::vector<quint64> _frameUsecs;
+
+    std::mt19937 _generator;
+};
+
+#endif // hifi_AudioMixerBenchmark_h
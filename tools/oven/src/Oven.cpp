@@ -0,0 +1,439 @@
+//
+//  Oven.cpp
+//  tools/oven/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Oven.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDebug>
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QUrl>
+#include <QtGui/QImage>
+
+#include <FBXContainer.h>
+#include <FSTReader.h>
+#include <Gzip.h>
+#include <gpu/TextureContainer.h>
+#include <LogHandler.h>
+
+const QCommandLineOption INPUT_OPTION {
+    "input", "directory of the models, textures and entity files to bake", "directory"
+};
+const QCommandLineOption OUTPUT_OPTION {
+    "output", "directory the baked tree is written to, outside of the input directory", "directory"
+};
+
+static const QString ENTITIES_KEY = "Entities";
+static const QString MODEL_URL_KEY = "modelURL";
+
+// the part of a baked texture's name that tells the ways one image is read apart
+static QString textureTypeName(NetworkTexture::Type type) {
+    switch (type) {
+        case NetworkTexture::ALBEDO_TEXTURE:
+            return "albedo";
+        case NetworkTexture::NORMAL_TEXTURE:
+            return "normal";
+        case NetworkTexture::BUMP_TEXTURE:
+            return "bump";
+        case NetworkTexture::METALLIC_TEXTURE:
+            return "metallic";
+        case NetworkTexture::ROUGHNESS_TEXTURE:
+            return "roughness";
+        case NetworkTexture::GLOSS_TEXTURE:
+            return "gloss";
+        case NetworkTexture::EMISSIVE_TEXTURE:
+            return "emissive";
+        case NetworkTexture::OCCLUSION_TEXTURE:
+            return "occlusion";
+        case NetworkTexture::LIGHTMAP_TEXTURE:
+            return "lightmap";
+        default:
+            return "texture";
+    }
+}
+
+Oven::Oven(int& argc, char** argv) :
+    QCoreApplication(argc, argv)
+{
+    qInstallMessageHandler(LogHandler::verboseMessageHandler);
+}
+
+int Oven::run() {
+    if (!parseArguments()) {
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QStringList fstPaths;
+    QStringList modelPaths;
+    QStringList entitiesPaths;
+    QDirIterator files(_inputDirectory.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+    while (files.hasNext()) {
+        QString path = files.next();
+        QString lowerPath = path.toLower();
+        if (lowerPath.endsWith(".fst")) {
+            fstPaths << path;
+        } else if (lowerPath.endsWith(".fbx")) {
+            modelPaths << path;
+        } else if (lowerPath.endsWith(".json") || lowerPath.endsWith(".json.gz")) {
+            entitiesPaths << path;
+        }
+    }
+    fstPaths.sort();
+    modelPaths.sort();
+    entitiesPaths.sort();
+
+    // the models of the FSTs are baked with their mappings, they are not baked again on their own
+    QSet<QString> fstModelPaths;
+    for (const auto& path : fstPaths) {
+        if (!bakeFST(path, fstModelPaths)) {
+            _numFailures++;
+        }
+    }
+    for (const auto& path : modelPaths) {
+        if (fstModelPaths.contains(path)) {
+            continue;
+        }
+        QFileInfo modelInfo(path);
+        QString bakedPath = modelInfo.dir().absoluteFilePath(modelInfo.completeBaseName() + FBX_CONTAINER_EXTENSION);
+        if (bakeModel(path, QVariantHash(), modelInfo.dir(), bakedPath)) {
+            _bakedModels.insert(_inputDirectory.relativeFilePath(path), _inputDirectory.relativeFilePath(bakedPath));
+        } else {
+            _numFailures++;
+        }
+    }
+
+    // the entities are pointed at the baked models once all of them are there
+    for (const auto& path : entitiesPaths) {
+        if (!rewriteEntities(path)) {
+            _numFailures++;
+        }
+    }
+
+    qDebug() << "Baked" << _numModels << "model(s) and" << _numTextures << "texture(s), and pointed"
+        << _numEntityFiles << "entity file(s) at them, in" << timer.elapsed() / 1000.0f << "s";
+    qDebug() << "    wrote" << _bakedBytes << "bytes to" << _outputDirectory.absolutePath();
+    if (_numFailures > 0) {
+        qWarning() << _numFailures << "asset(s) could not be baked, what uses them keeps its originals";
+        return 1;
+    }
+    return 0;
+}
+
+bool Oven::parseArguments() {
+    _argumentParser.addOptions({ INPUT_OPTION, OUTPUT_OPTION });
+    const QCommandLineOption helpOption = _argumentParser.addHelpOption();
+
+    if (!_argumentParser.parse(arguments())) {
+        qCritical() << _argumentParser.errorText();
+        _argumentParser.showHelp();
+        return false;
+    }
+    if (_argumentParser.isSet(helpOption)) {
+        _argumentParser.showHelp();
+    }
+
+    if (!_argumentParser.isSet(INPUT_OPTION) || !_argumentParser.isSet(OUTPUT_OPTION)) {
+        qCritical() << "Need an input and an output directory.";
+        _argumentParser.showHelp();
+        return false;
+    }
+    _inputDirectory = QDir(QDir::cleanPath(QDir::current().absoluteFilePath(_argumentParser.value(INPUT_OPTION))));
+    _outputDirectory = QDir(QDir::cleanPath(QDir::current().absoluteFilePath(_argumentParser.value(OUTPUT_OPTION))));
+    if (!_inputDirectory.exists()) {
+        qCritical() << "There is no input directory" << _inputDirectory.path();
+        return false;
+    }
+
+    // the rewritten FSTs and entity files would be baked again on the next run
+    QString inputPath = _inputDirectory.absolutePath() + "/";
+    if ((_outputDirectory.absolutePath() + "/").startsWith(inputPath)) {
+        qCritical() << "The output directory" << _outputDirectory.path() << "is inside the input directory.";
+        return false;
+    }
+    return true;
+}
+
+bool Oven::bakeFST(const QString& fstPath, QSet<QString>& fstModelPaths) {
+    QFile file(fstPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not read" << fstPath;
+        return false;
+    }
+    QVariantHash mapping = FSTReader::readMapping(file.readAll());
+
+    QString filename = mapping.value(FILENAME_FIELD).toString();
+    if (filename.isEmpty()) {
+        qWarning() << "Mapping file" << fstPath << "has no \"filename\" field";
+        return false;
+    }
+
+    // the paths are resolved the way GeometryMappingResource resolves them against the URL of the FST
+    QDir fstDirectory = QFileInfo(fstPath).dir();
+    QString modelPath = QDir::cleanPath(fstDirectory.absoluteFilePath(filename));
+    fstModelPaths.insert(modelPath);
+    if (!modelPath.toLower().endsWith(".fbx")) {
+        qDebug() << "Only FBX models are baked, leaving" << fstPath << "as it is";
+        return true;
+    }
+
+    QString texdir = mapping.value(TEXDIR_FIELD).toString();
+    QDir textureDirectory = texdir.isNull() ? QFileInfo(modelPath).dir() : QDir(fstDirectory.absoluteFilePath(texdir));
+
+    QString bakedModelPath = fstDirectory.absoluteFilePath(QFileInfo(fstPath).completeBaseName() + FBX_CONTAINER_EXTENSION);
+    if (!bakeModel(modelPath, mapping, textureDirectory, bakedModelPath)) {
+        return false;
+    }
+
+    // the mapping is in the baked model already, the rest of the FST is still read for the avatar and the animations
+    mapping[FILENAME_FIELD] = QFileInfo(bakedModelPath).fileName();
+    return writeBakedFile(bakedFilePath(fstPath), FSTReader::writeMapping(mapping));
+}
+
+bool Oven::bakeModel(const QString& modelPath, const QVariantHash& mapping, const QDir& textureDirectory,
+        const QString& bakedPath) {
+    if (_bakedModelPaths.contains(bakedPath)) {
+        qWarning() << "Another model was baked to" << _inputDirectory.relativeFilePath(bakedPath) << ", not baking"
+            << modelPath;
+        return false;
+    }
+
+    QFile file(modelPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not read" << modelPath;
+        return false;
+    }
+    QByteArray data = file.readAll();
+
+    FBXGeometry::Pointer geometry;
+    try {
+        geometry.reset(readFBX(data, mapping, modelPath));
+    } catch (const QString& error) {
+        qWarning() << "Error reading" << modelPath << ":" << error;
+        return false;
+    }
+    if (geometry->meshes.size() == 0 && geometry->joints.size() == 0) {
+        qWarning() << "Empty geometry in" << modelPath << ", possibly due to an unsupported FBX version";
+        return false;
+    }
+
+    for (auto& material : geometry->materials) {
+        bakeMaterialTextures(material, textureDirectory);
+    }
+
+    QByteArray container = FBXContainer::serialize(*geometry);
+    if (!writeBakedFile(bakedFilePath(bakedPath), container)) {
+        return false;
+    }
+    _bakedModelPaths.insert(bakedPath);
+    _numModels++;
+    qDebug() << "Baked" << _inputDirectory.relativeFilePath(modelPath) << "to"
+        << _inputDirectory.relativeFilePath(bakedPath) << "," << data.size() << "bytes to" << container.size();
+    return true;
+}
+
+void Oven::bakeMaterialTextures(FBXMaterial& material, const QDir& textureDirectory) {
+    // the textures are baked for the types NetworkMaterial reads them as, the ones it does not read are left alone
+    QByteArray albedoFilename = material.albedoTexture.filename;
+    bakeTexture(material.albedoTexture, NetworkTexture::ALBEDO_TEXTURE, textureDirectory);
+    if (!material.opacityTexture.filename.isEmpty() && material.opacityTexture.filename == albedoFilename) {
+        // the opacity is only read as the alpha of the albedo, when they are the same image
+        material.opacityTexture.filename = material.albedoTexture.filename;
+        material.opacityTexture.content = material.albedoTexture.content;
+    }
+
+    bakeTexture(material.normalTexture,
+        material.normalTexture.isBumpmap ? NetworkTexture::BUMP_TEXTURE : NetworkTexture::NORMAL_TEXTURE, textureDirectory);
+
+    if (!material.roughnessTexture.filename.isEmpty()) {
+        bakeTexture(material.roughnessTexture, NetworkTexture::ROUGHNESS_TEXTURE, textureDirectory);
+    } else {
+        bakeTexture(material.glossTexture, NetworkTexture::GLOSS_TEXTURE, textureDirectory);
+    }
+
+    if (!material.metallicTexture.filename.isEmpty()) {
+        bakeTexture(material.metallicTexture, NetworkTexture::METALLIC_TEXTURE, textureDirectory);
+    } else {
+        bakeTexture(material.specularTexture, NetworkTexture::SPECULAR_TEXTURE, textureDirectory);
+    }
+
+    bakeTexture(material.occlusionTexture, NetworkTexture::OCCLUSION_TEXTURE, textureDirectory);
+    bakeTexture(material.emissiveTexture, NetworkTexture::EMISSIVE_TEXTURE, textureDirectory);
+    bakeTexture(material.scatteringTexture, NetworkTexture::SCATTERING_TEXTURE, textureDirectory);
+    bakeTexture(material.lightmapTexture, NetworkTexture::LIGHTMAP_TEXTURE, textureDirectory);
+}
+
+void Oven::bakeTexture(FBXTexture& texture, NetworkTexture::Type type, const QDir& textureDirectory) {
+    if (texture.filename.isEmpty()) {
+        return;
+    }
+    QString name = QString::fromUtf8(texture.filename);
+    QByteArray content = texture.content;
+
+    // An embedded texture is known by its content and baked into the texture directory. An external one is looked for
+    // where the client would look for it, then by its name alone in the texture directory, as ModelPackager does.
+    QString sourcePath;
+    QString key;
+    if (content.isEmpty()) {
+        sourcePath = QDir::cleanPath(textureDirectory.absoluteFilePath(name));
+        if (!QFileInfo(sourcePath).isFile()) {
+            sourcePath = textureDirectory.absoluteFilePath(QFileInfo(name).fileName());
+        }
+        key = sourcePath;
+    } else {
+        key = QCryptographicHash::hash(content, QCryptographicHash::Md5).toHex();
+    }
+    key += '#' + QString::number((int)type);
+
+    if (_failedTextures.contains(key)) {
+        return;
+    }
+    QString bakedPath = _bakedTextures.value(key);
+    if (bakedPath.isEmpty()) {
+        if (content.isEmpty()) {
+            QFile file(sourcePath);
+            if (!file.open(QIODevice::ReadOnly)) {
+                qWarning() << "Could not find texture" << name << "in" << textureDirectory.path();
+                _failedTextures.insert(key);
+                _numFailures++;
+                return;
+            }
+            content = file.readAll();
+        }
+
+        // as in ImageReader, the extension helps QImage with some files
+        QImage image = QImage::fromData(content, QFileInfo(name).suffix().toLatin1().constData());
+        if (image.isNull()) {
+            qWarning() << "Could not read the image of texture" << name;
+            _failedTextures.insert(key);
+            _numFailures++;
+            return;
+        }
+        gpu::TexturePointer processed(NetworkTexture::getTextureLoaderForType(type)(image, name.toStdString()));
+        QByteArray baked = processed ? NetworkTexture::serializeBaked(*processed, image.width(), image.height()) : QByteArray();
+        if (baked.isEmpty()) {
+            qWarning() << "Could not bake texture" << name << "as" << textureTypeName(type);
+            _failedTextures.insert(key);
+            _numFailures++;
+            return;
+        }
+
+        // images of the same name from different directories, or embedded in different models, still get files of their own
+        QDir bakedDirectory = sourcePath.isEmpty() ? textureDirectory : QFileInfo(sourcePath).dir();
+        QString bakedBasePath = bakedDirectory.absoluteFilePath(QFileInfo(name).completeBaseName() + "." + textureTypeName(type));
+        bakedPath = bakedBasePath + gpu::TEXTURE_CONTAINER_EXTENSION;
+        for (int i = 2; _bakedTextureSources.contains(bakedPath); i++) {
+            bakedPath = bakedBasePath + "-" + QString::number(i) + gpu::TEXTURE_CONTAINER_EXTENSION;
+        }
+        if (!writeBakedFile(bakedFilePath(bakedPath), baked)) {
+            _failedTextures.insert(key);
+            _numFailures++;
+            return;
+        }
+        _bakedTextures.insert(key, bakedPath);
+        _bakedTextureSources.insert(bakedPath, key);
+        _numTextures++;
+    }
+
+    // the client resolves the name against the texture directory, and downloads it since there is no content
+    texture.filename = textureDirectory.relativeFilePath(bakedPath).toUtf8();
+    texture.content.clear();
+}
+
+bool Oven::rewriteEntities(const QString& entitiesPath) {
+    QFile file(entitiesPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not read" << entitiesPath;
+        return false;
+    }
+    QByteArray data = file.readAll();
+    bool isCompressed = entitiesPath.toLower().endsWith(".gz");
+    if (isCompressed) {
+        QByteArray uncompressed;
+        if (!gunzip(data, uncompressed)) {
+            qWarning() << "Could not uncompress" << entitiesPath;
+            return false;
+        }
+        data = uncompressed;
+    }
+
+    // other JSON is not for the oven
+    QJsonDocument document = QJsonDocument::fromJson(data);
+    if (!document.isObject() || !document.object().value(ENTITIES_KEY).isArray()) {
+        return true;
+    }
+
+    QJsonObject root = document.object();
+    int numRewritten = 0;
+    root[ENTITIES_KEY] = rewriteModelURLs(root.value(ENTITIES_KEY).toArray(), numRewritten);
+    if (numRewritten == 0) {
+        return true;
+    }
+
+    QByteArray rewritten = QJsonDocument(root).toJson();
+    if (isCompressed) {
+        QByteArray compressed;
+        gzip(rewritten, compressed);
+        rewritten = compressed;
+    }
+    if (!writeBakedFile(bakedFilePath(entitiesPath), rewritten)) {
+        return false;
+    }
+    _numEntityFiles++;
+    qDebug() << "Pointed" << numRewritten << "model URL(s) of" << _inputDirectory.relativeFilePath(entitiesPath)
+        << "at baked models";
+    return true;
+}
+
+QJsonArray Oven::rewriteModelURLs(const QJsonArray& entities, int& numRewritten) const {
+    QJsonArray rewritten;
+    for (const auto& value : entities) {
+        QJsonObject entity = value.toObject();
+        QString modelURL = entity.value(MODEL_URL_KEY).toString();
+        if (!modelURL.isEmpty()) {
+            // the input tree may be hosted anywhere, so it is the end of the path that has to match a baked model
+            QUrl url(modelURL);
+            QString path = url.path();
+            for (auto model = _bakedModels.constBegin(); model != _bakedModels.constEnd(); ++model) {
+                if (path == model.key() || path.endsWith("/" + model.key())) {
+                    path.replace(path.size() - model.key().size(), model.key().size(), model.value());
+                    url.setPath(path);
+                    entity[MODEL_URL_KEY] = url.toString();
+                    numRewritten++;
+                    break;
+                }
+            }
+        }
+        rewritten.append(entity);
+    }
+    return rewritten;
+}
+
+QString Oven::bakedFilePath(const QString& path) const {
+    return _outputDirectory.absoluteFilePath(_inputDirectory.relativeFilePath(path));
+}
+
+bool Oven::writeBakedFile(const QString& path, const QByteArray& data) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qWarning() << "Could not write" << path;
+        return false;
+    }
+    _bakedBytes += data.size();
+    return true;
+}
@@ -0,0 +1,76 @@
+//
+//  Oven.h
+//  tools/oven/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_Oven_h
+#define hifi_Oven_h
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QSet>
+
+#include <FBXReader.h>
+#include <TextureCache.h>
+
+// Bakes the FBX models and their textures under a directory into the containers the client otherwise makes for its
+// own disk cache, so an asset server can host them and clients load them without parsing or processing anything.
+//
+// The baked tree mirrors the input tree, to be uploaded over it:
+// - an FST gets its model baked with its mapping applied, as <fst name>.hfmd next to it, and a copy that points at it
+// - an FBX no FST refers to is baked as it is, as <fbx name>.hfmd
+// - each texture a model reads is baked once for the way it is read, as <image name>.<type>.hftx in its directory
+// - entity files (.json, .json.gz) get a copy whose model URLs point at the baked models, if any of them do
+class Oven : public QCoreApplication {
+public:
+    Oven(int& argc, char** argv);
+
+    // returns the exit code for the process
+    int run();
+
+private:
+    bool parseArguments();
+
+    bool bakeFST(const QString& fstPath, QSet<QString>& fstModelPaths);
+    bool bakeModel(const QString& modelPath, const QVariantHash& mapping, const QDir& textureDirectory,
+        const QString& bakedPath);
+    void bakeMaterialTextures(FBXMaterial& material, const QDir& textureDirectory);
+    void bakeTexture(FBXTexture& texture, NetworkTexture::Type type, const QDir& textureDirectory);
+    bool rewriteEntities(const QString& entitiesPath);
+    QJsonArray rewriteModelURLs(const QJsonArray& entities, int& numRewritten) const;
+
+    // the place in the baked tree of a path in the input tree
+    QString bakedFilePath(const QString& path) const;
+    bool writeBakedFile(const QString& path, const QByteArray& data);
+
+    QCommandLineParser _argumentParser;
+    QDir _inputDirectory;
+    QDir _outputDirectory;
+
+    // the paths, relative to the input, of the models baked and of the models they were baked to
+    QHash<QString, QString> _bakedModels;
+    QSet<QString> _bakedModelPaths;
+    // the baked textures by the image and type they were baked from, and the other way around
+    QHash<QString, QString> _bakedTextures;
+    QHash<QString, QString> _bakedTextureSources;
+    QSet<QString> _failedTextures;
+
+    int _numModels { 0 };
+    int _numTextures { 0 };
+    int _numEntityFiles { 0 };
+    int _numFailures { 0 };
+    qint64 _bakedBytes { 0 };
+};
+
+#endif // hifi_Oven_h
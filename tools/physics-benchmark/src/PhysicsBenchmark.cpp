@@ -0,0 +1,373 @@
+//
+//  PhysicsBenchmark.cpp
+//  tools/physics-benchmark/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QDebug>
+#include <QtCore/QThread>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <EntityEditPacketSender.h>
+#include <EntityTypes.h>
+#include <LogHandler.h>
+#include <ModelEntityItem.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <ObjectMotionState.h>
+#include <SharedUtil.h>
+
+const QCommandLineOption SCENE_OPTION {
+    "scene", "boxes falling on a floor, piles of compound shapes, or kinematic boxes (default is boxes)",
+    "boxes|piles|kinematic"
+};
+const QCommandLineOption ENTITIES_OPTION {
+    "entities", "number of entities in the scene, not counting the floor (default is 1000)", "count"
+};
+const QCommandLineOption FRAMES_OPTION {
+    "frames", "number of frames to time (default is 1000)", "count"
+};
+const QCommandLineOption SEED_OPTION {
+    "seed", "seed for the entity placement (default is 742272)", "integer"
+};
+
+const float FRAME_SECONDS = 1.0f / 60.0f;
+const float LATTICE_SPACING = 1.0f; // meters between the starting places of the entities
+const float BOX_SIZE = 0.5f;
+const float PILE_SIZE = 0.6f;
+const float KINEMATIC_SPEED = 1.0f;
+const glm::vec3 GRAVITY { 0.0f, -9.8f, 0.0f };
+const quint64 MAX_SHAPE_BUILD_USECS = 30 * USECS_PER_SECOND;
+
+// A model entity whose collision hulls are made up on the spot, rather than loaded with its collision model.
+// Each one is a jack of three crossed bars, which tangle up when they fall on each other.
+class PileEntityItem : public ModelEntityItem {
+public:
+    static EntityItemPointer factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
+        EntityItemPointer entity { new PileEntityItem(entityID) };
+        entity->setProperties(properties);
+        return entity;
+    }
+
+    PileEntityItem(const EntityItemID& entityItemID) : ModelEntityItem(entityItemID) {}
+
+    void computeShapeInfo(ShapeInfo& shapeInfo) override {
+        const float BAR_THICKNESS = 0.1f; // as a fraction of the dimensions
+        glm::vec3 dimensions = getDimensions();
+
+        ShapeInfo::PointCollection pointCollection;
+        for (int axis = 0; axis < 3; ++axis) {
+            glm::vec3 halfExtents(0.5f * BAR_THICKNESS);
+            halfExtents[axis] = 0.5f;
+
+            ShapeInfo::PointList points;
+            for (int corner = 0; corner < 8; ++corner) {
+                glm::vec3 sign((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f);
+                points << sign * halfExtents * dimensions;
+            }
+            pointCollection << points;
+        }
+        shapeInfo.setPointCollection(pointCollection);
+        shapeInfo.setParams(SHAPE_TYPE_COMPOUND, dimensions, getCompoundShapeURL());
+    }
+};
+
+PhysicsBenchmark::PhysicsBenchmark(int& argc, char** argv) :
+    QCoreApplication(argc, argv)
+{
+    qInstallMessageHandler(LogHandler::verboseMessageHandler);
+
+    // the entity tree and edit sender want a node list, nothing is sent
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+
+    REGISTER_ENTITY_TYPE_WITH_FACTORY(Model, PileEntityItem::factory)
+}
+
+PhysicsBenchmark::~PhysicsBenchmark() {
+    // the motion states go before the shape manager they hold shapes from
+    if (_entitySimulation) {
+        _entitySimulation->clearEntities();
+        _tree->setSimulation(nullptr);
+    }
+}
+
+int PhysicsBenchmark::run() {
+    if (!parseArguments()) {
+        return 1;
+    }
+
+    // set up like Application::init(), there is no session so no entity is owned and nothing is sent
+    ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine = std::make_shared<PhysicsEngine>(Vectors::ZERO);
+    _physicsEngine->init();
+
+    _tree = std::make_shared<EntityTree>();
+    _tree->createRootElement();
+    // the tree stands in for one the entities came to from a server we are allowed to rez on
+    _tree->setIsServer(true);
+
+    _entityEditSender.reset(new EntityEditPacketSender());
+    _entitySimulation = std::make_shared<PhysicalEntitySimulation>();
+    _entitySimulation->init(_tree, _physicsEngine, _entityEditSender.get());
+    _tree->setSimulation(_entitySimulation);
+
+    buildScene();
+
+    // shapes that take a while are built off the main thread, don't time the frames spent waiting for them
+    quint64 buildStart = usecTimestampNow();
+    prepareFrame();
+    while (_shapeManager.getNumPendingShapes() > 0) {
+        if (usecTimestampNow() - buildStart > MAX_SHAPE_BUILD_USECS) {
+            qCritical() << "Gave up waiting for" << _shapeManager.getNumPendingShapes() << "shape(s) to be built.";
+            return 1;
+        }
+        QThread::msleep(1);
+        prepareFrame();
+    }
+    qDebug() << "Built" << _shapeManager.getNumShapes() << "shape(s) in"
+        << (usecTimestampNow() - buildStart) / (float) USECS_PER_MSEC << "ms";
+
+    for (int i = 0; i < _numWarmupFrames; ++i) {
+        stepFrame();
+    }
+
+    _frameStats.reserve(_numFrames);
+    quint64 totalUsecs = 0;
+    for (int i = 0; i < _numFrames; ++i) {
+        FrameStats stats = stepFrame();
+        _frameStats.push_back(stats);
+        totalUsecs += stats.prepareUsecs + stats.stepUsecs + stats.syncUsecs;
+    }
+
+    reportResults(totalUsecs);
+    return 0;
+}
+
+bool PhysicsBenchmark::parseArguments() {
+    _argumentParser.addOptions({ SCENE_OPTION, ENTITIES_OPTION, FRAMES_OPTION, SEED_OPTION });
+    const QCommandLineOption helpOption = _argumentParser.addHelpOption();
+
+    if (!_argumentParser.parse(arguments())) {
+        qCritical() << _argumentParser.errorText();
+        _argumentParser.showHelp();
+        return false;
+    }
+    if (_argumentParser.isSet(helpOption)) {
+        _argumentParser.showHelp();
+    }
+
+    if (_argumentParser.isSet(SCENE_OPTION)) {
+        QString sceneName = _argumentParser.value(SCENE_OPTION);
+        if (sceneName == "boxes") {
+            _scene = Scene::Boxes;
+        } else if (sceneName == "piles") {
+            _scene = Scene::Piles;
+        } else if (sceneName == "kinematic") {
+            _scene = Scene::Kinematic;
+        } else {
+            qCritical() << "Unknown scene" << sceneName;
+            return false;
+        }
+    }
+    if (_argumentParser.isSet(ENTITIES_OPTION)) {
+        _numEntities = _argumentParser.value(ENTITIES_OPTION).toInt();
+    }
+    if (_argumentParser.isSet(FRAMES_OPTION)) {
+        _numFrames = _argumentParser.value(FRAMES_OPTION).toInt();
+    }
+    if (_numEntities < 1 || _numFrames < 1) {
+        qCritical() << "Need at least one entity and one frame.";
+        return false;
+    }
+
+    const unsigned int DEFAULT_SEED = 742272;
+    _generator.seed(_argumentParser.isSet(SEED_OPTION) ? _argumentParser.value(SEED_OPTION).toUInt() : DEFAULT_SEED);
+    return true;
+}
+
+void PhysicsBenchmark::buildScene() {
+    QVector<EntityItemID> entityIDs;
+    QVector<EntityItemProperties> properties;
+    entityIDs.reserve(_numEntities + 1);
+    properties.reserve(_numEntities + 1);
+
+    // the entities start out on a lattice with a base twice as wide as it is high, jittered by the seed
+    int side = std::max((int) ceilf(powf(0.25f * _numEntities, 1.0f / 3.0f)), 1);
+    int baseSide = 2 * side;
+    std::uniform_real_distribution<float> jitterDistribution { -0.2f * LATTICE_SPACING, 0.2f * LATTICE_SPACING };
+    std::uniform_real_distribution<float> unitDistribution { -1.0f, 1.0f };
+    auto randomDirection = [&] {
+        glm::vec3 direction(unitDistribution(_generator), unitDistribution(_generator), unitDistribution(_generator));
+        float length = glm::length(direction);
+        return length > EPSILON ? direction / length : Vectors::UNIT_Y;
+    };
+
+    if (_scene != Scene::Kinematic) {
+        addFloor(entityIDs, properties);
+    }
+
+    for (int i = 0; i < _numEntities; ++i) {
+        int x = i % baseSide;
+        int z = (i / baseSide) % baseSide;
+        int y = i / (baseSide * baseSide);
+        glm::vec3 position = LATTICE_SPACING * (glm::vec3(x, y, z) - 0.5f * glm::vec3(baseSide, 0.0f, baseSide));
+        position += glm::vec3(jitterDistribution(_generator), jitterDistribution(_generator), jitterDistribution(_generator));
+
+        EntityItemProperties entityProperties;
+        switch (_scene) {
+            case Scene::Boxes:
+                entityProperties.setType(EntityTypes::Box);
+                entityProperties.setDimensions(glm::vec3(BOX_SIZE));
+                entityProperties.setDynamic(true);
+                entityProperties.setGravity(GRAVITY);
+                entityProperties.setAngularVelocity(randomDirection());
+                position.y += 2.0f * LATTICE_SPACING;
+                break;
+            case Scene::Piles:
+                entityProperties.setType(EntityTypes::Model);
+                entityProperties.setShapeType(SHAPE_TYPE_COMPOUND);
+                // every pile entity has the same hulls, the url only has to be there
+                entityProperties.setCompoundShapeURL("benchmark://pile");
+                entityProperties.setDimensions(glm::vec3(PILE_SIZE));
+                entityProperties.setDynamic(true);
+                entityProperties.setGravity(GRAVITY);
+                entityProperties.setAngularVelocity(randomDirection());
+                position.y += 2.0f * LATTICE_SPACING;
+                break;
+            case Scene::Kinematic:
+                // a kinematic entity keeps moving, so every one of them is synced every frame
+                entityProperties.setType(EntityTypes::Box);
+                entityProperties.setDimensions(glm::vec3(BOX_SIZE));
+                entityProperties.setVelocity(KINEMATIC_SPEED * randomDirection());
+                entityProperties.setAngularVelocity(randomDirection());
+                entityProperties.setDamping(0.0f);
+                entityProperties.setAngularDamping(0.0f);
+                break;
+        }
+        entityProperties.setPosition(position);
+
+        entityIDs << EntityItemID(QUuid::createUuid());
+        properties << entityProperties;
+    }
+
+    _tree->withWriteLock([&] {
+        _tree->addEntities(entityIDs, properties);
+    });
+
+    const char* sceneNames[] = { "boxes", "piles", "kinematic" };
+    qDebug() << "Scene" << sceneNames[(int) _scene] << "with" << _numEntities << "entities";
+}
+
+void PhysicsBenchmark::addFloor(QVector<EntityItemID>& entityIDs, QVector<EntityItemProperties>& properties) {
+    const float FLOOR_SIZE = 200.0f;
+    const float FLOOR_THICKNESS = 1.0f;
+
+    EntityItemProperties floorProperties;
+    floorProperties.setType(EntityTypes::Box);
+    floorProperties.setDimensions(glm::vec3(FLOOR_SIZE, FLOOR_THICKNESS, FLOOR_SIZE));
+    floorProperties.setPosition(glm::vec3(0.0f, -0.5f * FLOOR_THICKNESS, 0.0f));
+
+    entityIDs << EntityItemID(QUuid::createUuid());
+    properties << floorProperties;
+}
+
+void PhysicsBenchmark::prepareFrame() {
+    VectorOfMotionStates motionStates;
+    _entitySimulation->getObjectsToRemoveFromPhysics(motionStates);
+    _physicsEngine->removeObjects(motionStates);
+    _entitySimulation->deleteObjectsRemovedFromPhysics();
+
+    _tree->withReadLock([&] {
+        _entitySimulation->getObjectsToAddToPhysics(motionStates);
+        _physicsEngine->addObjects(motionStates);
+    });
+    _tree->withReadLock([&] {
+        _entitySimulation->getObjectsToChange(motionStates);
+        VectorOfMotionStates stillNeedChange = _physicsEngine->changeObjects(motionStates);
+        _entitySimulation->setObjectsToChange(stillNeedChange);
+    });
+
+    _entitySimulation->applyActionChanges();
+}
+
+PhysicsBenchmark::FrameStats PhysicsBenchmark::stepFrame() {
+    FrameStats stats;
+
+    quint64 start = usecTimestampNow();
+    prepareFrame();
+    quint64 prepared = usecTimestampNow();
+    stats.prepareUsecs = prepared - start;
+
+    _tree->withWriteLock([&] {
+        _physicsEngine->stepSimulation(FRAME_SECONDS);
+    });
+    quint64 stepped = usecTimestampNow();
+    stats.stepUsecs = stepped - prepared;
+
+    // what Application::update() does with the results, short of running entity scripts
+    if (_physicsEngine->hasOutgoingChanges()) {
+        _tree->withWriteLock([&] {
+            const VectorOfMotionStates& outgoingChanges = _physicsEngine->getOutgoingChanges();
+            _entitySimulation->handleOutgoingChanges(outgoingChanges);
+        });
+        stats.numSyncedMotionStates = _physicsEngine->getNumSyncedMotionStates();
+        _entitySimulation->handleCollisionEvents(_physicsEngine->getCollisionEvents());
+        _tree->update();
+    }
+    stats.syncUsecs = usecTimestampNow() - stepped;
+    stats.numContacts = _physicsEngine->getNumContacts();
+
+    return stats;
+}
+
+void PhysicsBenchmark::reportResults(quint64 totalUsecs) {
+    auto reportTime = [&](const char* name, quint64 FrameStats::* usecs) {
+        std::vector<quint64> sortedUsecs;
+        sortedUsecs.reserve(_frameStats.size());
+        for (auto& stats : _frameStats) {
+            sortedUsecs.push_back(stats.*usecs);
+        }
+        std::sort(sortedUsecs.begin(), sortedUsecs.end());
+
+        auto percentile = [&](float fraction) {
+            int index = std::min((int) (fraction * sortedUsecs.size()), (int) sortedUsecs.size() - 1);
+            return sortedUsecs[index];
+        };
+        qDebug() << "   " << name << "time: p50" << percentile(0.50f) << "us, p99" << percentile(0.99f) << "us, max"
+            << sortedUsecs.back() << "us";
+    };
+
+    auto reportCount = [&](const char* name, int FrameStats::* count) {
+        quint64 total = 0;
+        int maxCount = 0;
+        for (auto& stats : _frameStats) {
+            total += stats.*count;
+            maxCount = std::max(maxCount, stats.*count);
+        }
+        qDebug() << "   " << name << ": average" << total / (float) _frameStats.size() << ", max" << maxCount;
+    };
+
+    float totalSeconds = std::max(totalUsecs, (quint64) 1) / (float) USECS_PER_SECOND;
+    float simulatedSeconds = _numFrames * FRAME_SECONDS;
+
+    qDebug() << "Stepped" << _numFrames << "frame(s) in" << totalSeconds << "s, simulating" << simulatedSeconds << "s";
+    qDebug() << "    real-time factor:" << simulatedSeconds / totalSeconds;
+    reportTime("prepare", &FrameStats::prepareUsecs);
+    reportTime("step", &FrameStats::stepUsecs);
+    reportTime("sync", &FrameStats::syncUsecs);
+    reportCount("contacts", &FrameStats::numContacts);
+    reportCount("synced motion states", &FrameStats::numSyncedMotionStates);
+}
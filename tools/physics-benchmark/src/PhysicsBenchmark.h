@@ -0,0 +1,82 @@
+//
+//  PhysicsBenchmark.h
+//  tools/physics-benchmark/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PhysicsBenchmark_h
+#define hifi_PhysicsBenchmark_h
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+
+#include <EntityTree.h>
+#include <PhysicalEntitySimulation.h>
+#include <PhysicsEngine.h>
+#include <ShapeManager.h>
+
+class EntityEditPacketSender;
+
+// Steps the interface's physics loop over a generated scene of entities, back to back and without rendering.
+// Every frame is a fixed 1/60 s, so a scene and seed always play out the same way.
+class PhysicsBenchmark : public QCoreApplication {
+public:
+    enum class Scene { Boxes, Piles, Kinematic };
+
+    PhysicsBenchmark(int& argc, char** argv);
+    ~PhysicsBenchmark();
+
+    // returns the exit code for the process
+    int run();
+
+private:
+    struct FrameStats {
+        quint64 prepareUsecs { 0 }; // pulling entity changes into the engine
+        quint64 stepUsecs { 0 };
+        quint64 syncUsecs { 0 }; // pushing the results back to the entities
+        int numContacts { 0 };
+        int numSyncedMotionStates { 0 };
+    };
+
+    bool parseArguments();
+
+    // adds the scene's entities to the tree, they go into the engine with the next frame
+    void buildScene();
+    void addFloor(QVector<EntityItemID>& entityIDs, QVector<EntityItemProperties>& properties);
+
+    // the pre-step part of Application::update()
+    void prepareFrame();
+    FrameStats stepFrame();
+
+    void reportResults(quint64 totalUsecs);
+
+    QCommandLineParser _argumentParser;
+
+    Scene _scene { Scene::Boxes };
+    int _numEntities { 1000 };
+    int _numFrames { 1000 };
+    int _numWarmupFrames { 10 }; // stepped before timing starts, once the shapes have been built
+
+    ShapeManager _shapeManager;
+    EntityTreePointer _tree;
+    PhysicsEnginePointer _physicsEngine;
+    PhysicalEntitySimulationPointer _entitySimulation;
+    std::unique_ptr<EntityEditPacketSender> _entityEditSender;
+
+    std::vector<FrameStats> _frameStats;
+
+    std::mt19937 _generator;
+};
+
+#endif // hifi_PhysicsBenchmark_h
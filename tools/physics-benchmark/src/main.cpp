@@ -0,0 +1,17 @@
+//
+//  main.cpp
+//  tools/physics-benchmark/src
+//
+//  Created by agent on 2026-10-14.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsBenchmark.h"
+
+int main(int argc, char* argv[]) {
+    PhysicsBenchmark app(argc, argv);
+    return app.run();
+}
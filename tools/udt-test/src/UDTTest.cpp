@@ -11,13 +11,21 @@
 
 #include "UDTTest.h"
 
+#include <algorithm>
+
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 
+#include <udt/Connection.h>
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
 
 #include <LogHandler.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 const QCommandLineOption PORT_OPTION { "p", "listening port for socket (defaults to random)", "port", 0 };
 const QCommandLineOption TARGET_OPTION {
@@ -55,6 +63,36 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption BBR_CONGESTION_CONTROL {
+    "bbr", "use BBR congestion control (default is UDT)"
+};
+const QCommandLineOption SEND_MIX {
+    "mix", "send a mix of reliable packets, unreliable packets and small ordered messages, in the given proportions "
+    "(e.g. 60:30:10)", "reliable:unreliable:ordered"
+};
+const QCommandLineOption CONNECTIONS {
+    "connections", "number of sockets to send from, each its own connection to the target - 200 loads a receiver "
+    "the way the peers of a mixer do (default is 1)", "count"
+};
+const QCommandLineOption LOSS {
+    "loss", "percentage of received datagrams to drop, to emulate a lossy link (default is 0)", "percent"
+};
+const QCommandLineOption LATENCY {
+    "latency", "milliseconds to hold received datagrams for, to emulate a longer link (default is 0)", "milliseconds"
+};
+const QCommandLineOption DURATION {
+    "duration", "seconds to run for before reporting the results and quitting, a receiver counts from the first data "
+    "it receives (default is to run until stopped)", "seconds"
+};
+const QCommandLineOption RESULTS {
+    "results", "file to write the JSON results of a timed run to (default is the log)", "path"
+};
+
+// the ordered messages of a mix are small, about the size of an entity edit or a chunk of an asset
+static const int MIX_MESSAGE_PACKETS = 8;
+
+// the most packets that delivery latency is kept for, a uniform sample of all of them beyond that
+static const int MAX_LATENCY_SAMPLES = 100000;
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -75,9 +113,22 @@ UDTTest::UDTTest(int& argc, char** argv) :
     
     parseArguments();
     
+    if (_argumentParser.isSet(LOSS)) {
+        _lossPercent = _argumentParser.value(LOSS).toFloat();
+    }
+    
+    if (_argumentParser.isSet(LATENCY)) {
+        _latencyMsecs = _argumentParser.value(LATENCY).toInt();
+    }
+    
+    _releaseTimer.setSingleShot(true);
+    _releaseTimer.setTimerType(Qt::PreciseTimer);
+    connect(&_releaseTimer, &QTimer::timeout, this, &UDTTest::releaseHeldDatagrams);
+    
     // randomize the seed for packet size randomization
     srand(time(NULL));
 
+    setupSocket(_socket);
     _socket.bind(QHostAddress::AnyIPv4, _argumentParser.value(PORT_OPTION).toUInt());
     qDebug() << "Test socket is listening on" << _socket.localPort();
     
@@ -147,6 +198,28 @@ UDTTest::UDTTest(int& argc, char** argv) :
         _sendOrdered = true;
     }
     
+    if (_argumentParser.isSet(SEND_MIX)) {
+        QStringList weights = _argumentParser.value(SEND_MIX).split(':');
+        
+        for (const auto& weight : weights) {
+            _sendMix.push_back(std::max(weight.toInt(), 0));
+        }
+        
+        if (_sendMix.size() != NumSendKinds || _sendMix[Reliable] + _sendMix[Ordered] == 0) {
+            // the reliable sends are what keeps the queue of a connection full, a mix needs some of them
+            qCritical() << "Could not parse a mix of reliable, unreliable and ordered sends from"
+                << _argumentParser.value(SEND_MIX);
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+            _sendMix.clear();
+        } else {
+            _sendKindDistribution = std::discrete_distribution<int>(_sendMix.begin(), _sendMix.end());
+            
+            if (_argumentParser.isSet(UNRELIABLE_PACKETS) || _argumentParser.isSet(ORDERED_PACKETS)) {
+                qWarning() << "unreliable and ordered have no effect when sending a mix - they will be ignored";
+            }
+        }
+    }
+    
     if (_argumentParser.isSet(MESSAGE_SIZE)) {
         if (_argumentParser.isSet(ORDERED_PACKETS)) {
             static const double BYTES_PER_MEGABYTE = 1000000;
@@ -172,7 +245,29 @@ UDTTest::UDTTest(int& argc, char** argv) :
     _generator.seed(messageSeed);
     
     if (!_target.isNull()) {
-        sendInitialPackets();
+        int numConnections = 1;
+        if (_argumentParser.isSet(CONNECTIONS)) {
+            numConnections = std::max(_argumentParser.value(CONNECTIONS).toInt(), 1);
+        }
+        
+        for (int i = 1; i < numConnections; ++i) {
+            auto socket = std::unique_ptr<udt::Socket>(new udt::Socket());
+            setupSocket(*socket);
+            socket->bind(QHostAddress::AnyIPv4);
+            _extraSockets.push_back(std::move(socket));
+        }
+        
+        if (numConnections > 1) {
+            qDebug() << "Sending from" << numConnections << "sockets";
+        }
+        
+        _runTimer.start();
+        _runStartCPU = std::clock();
+        
+        sendInitialPackets(_socket);
+        for (auto& socket : _extraSockets) {
+            sendInitialPackets(*socket);
+        }
     } else {
         // this is a receiver - in case there are ordered packets (messages) being sent to us make sure that we handle them
         // so that they can be verified
@@ -200,12 +295,11 @@ UDTTest::UDTTest(int& argc, char** argv) :
                 }
 
         });
+        
+        _socket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+            handlePacket(std::move(packet));
+        });
     }
-    _socket.setMessageFailureHandler(
-        [this](HifiSockAddr from, udt::Packet::MessageNumber messageNumber) {
-            _pendingMessages.erase(messageNumber);
-        }
-    );
     
     // the sender reports stats every 100 milliseconds, unless passed a custom value
     
@@ -213,9 +307,34 @@ UDTTest::UDTTest(int& argc, char** argv) :
         _statsInterval = _argumentParser.value(STATS_INTERVAL).toInt();
     }
     
+    if (_argumentParser.isSet(RESULTS)) {
+        _resultsPath = _argumentParser.value(RESULTS);
+    }
+    
     QTimer* statsTimer = new QTimer(this);
     connect(statsTimer, &QTimer::timeout, this, &UDTTest::sampleStats);
     statsTimer->start(_statsInterval);
+    
+    if (!_target.isNull() && _argumentParser.isSet(DURATION)) {
+        QTimer::singleShot(_argumentParser.value(DURATION).toInt() * (int) MSECS_PER_SECOND, this, &UDTTest::finish);
+    }
+}
+
+void UDTTest::setupSocket(udt::Socket& socket) {
+    if (_argumentParser.isSet(BBR_CONGESTION_CONTROL)) {
+        socket.setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::BBRCC>()));
+    }
+    
+    socket.setMessageFailureHandler(
+        [this](HifiSockAddr from, udt::Packet::MessageNumber messageNumber) {
+            _pendingMessages.erase(messageNumber);
+        }
+    );
+    
+    if (_lossPercent > 0.0f || _latencyMsecs > 0) {
+        emulateLink(socket);
+    }
 }
 
 void UDTTest::parseArguments() {
@@ -228,7 +347,8 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, BBR_CONGESTION_CONTROL,
+        SEND_MIX, CONNECTIONS, LOSS, LATENCY, DURATION, RESULTS
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -243,31 +363,55 @@ void UDTTest::parseArguments() {
     }
 }
 
-void UDTTest::sendInitialPackets() {
+void UDTTest::sendInitialPackets(udt::Socket& socket) {
     static const int NUM_INITIAL_PACKETS = 500;
     
     int numPackets = std::max(NUM_INITIAL_PACKETS, _maxSendPackets);
     
     for (int i = 0; i < numPackets; ++i) {
-        sendPacket();
+        sendPacket(socket);
     }
     
     if (numPackets == NUM_INITIAL_PACKETS) {
         // we've put 500 initial packets in the queue, everytime we hear one has gone out we should add a new one
-        _socket.connectToSendSignal(_target, this, SLOT(refillPacket()));
+        auto it = socket._connectionsHash.find(_target);
+        if (it != socket._connectionsHash.end()) {
+            udt::Socket* sendingSocket = &socket;
+            connect(it->second.get(), &udt::Connection::packetSent, this, [this, sendingSocket] {
+                sendPacket(*sendingSocket);
+            });
+        }
+    }
+}
+
+UDTTest::SendKind UDTTest::nextSendKind() {
+    if (_sendMix.empty()) {
+        return _sendOrdered ? Ordered : (_sendReliable ? Reliable : Unreliable);
     }
+    return (SendKind) _sendKindDistribution(_generator);
+}
+
+void UDTTest::sendPacket(udt::Socket& socket) {
+    // the unreliable packets of a mix don't go through the connection, nothing would refill the queue after them
+    SendKind kind;
+    do {
+        kind = nextSendKind();
+        if (!sendPacket(socket, kind)) {
+            return;
+        }
+    } while (kind == Unreliable && !_sendMix.empty());
 }
 
-void UDTTest::sendPacket() {
+bool UDTTest::sendPacket(udt::Socket& socket, SendKind kind) {
     
     if (_maxSendPackets != -1 && _totalQueuedPackets > _maxSendPackets) {
         // don't send more packets, we've hit max
-        return;
+        return false;
     }
     
     if (_maxSendBytes != -1 && _totalQueuedBytes > _maxSendBytes) {
         // don't send more packets, we've hit max
-        return;
+        return false;
     }
     
     // we're good to send a new packet, construct it now
@@ -284,68 +428,99 @@ void UDTTest::sendPacket() {
         packetPayloadSize = randomPacketSize - udt::Packet::localHeaderSize(false);
     }
 
-    if (_sendOrdered) {
+    if (kind == Ordered && _sendMix.empty()) {
         // check if it is time to add another message - we do this every time 95% of the message size has been sent
         static int call = 0;
-        static int packetSize = udt::Packet::maxPayloadSize(true);
         static int messageSizePackets = (int) ceil(_messageSize / udt::Packet::maxPayloadSize(true));
         
         static int refillCount = (int) (messageSizePackets * 0.95);
         
         if (call++ % refillCount == 0) {
-            // construct a reliable and ordered packet list
-            auto packetList = udt::PacketList::create(PacketType::BulkAvatarData, QByteArray(), true, true);
-            
-            // fill the packet list with random data according to the constant seed (so receiver can verify)
-            for (int i = 0; i < messageSizePackets; ++i) {
-                // setup a QByteArray full of zeros for our random padded data
-                QByteArray randomPaddedData { packetSize, 0 };
-                
-                // generate a random integer for the first 8 bytes of the random data
-                uint64_t randomInt = _distribution(_generator);
-                randomPaddedData.replace(0, sizeof(randomInt), reinterpret_cast<char*>(&randomInt), sizeof(randomInt));
-                
-                // write this data to the PacketList
-                packetList->write(randomPaddedData);
-            }
-            
-            packetList->closeCurrentPacket();
-            
-            _totalQueuedBytes += (int)packetList->getDataSize();
-            _totalQueuedPackets += (int)packetList->getNumPackets();
-            
-            _socket.writePacketList(std::move(packetList), _target);
+            sendMessage(socket, messageSizePackets);
+            ++_sendKindCounts[Ordered];
         }
         
+    } else if (kind == Ordered) {
+        sendMessage(socket, MIX_MESSAGE_PACKETS);
+        ++_sendKindCounts[Ordered];
     } else {
-        auto newPacket = udt::Packet::create(packetPayloadSize, _sendReliable);
+        bool isReliable = kind == Reliable;
+        auto newPacket = udt::Packet::create(packetPayloadSize, isReliable);
         newPacket->setPayloadSize(packetPayloadSize);
         
+        // lead with the time it was queued at, for the receiver to measure the delivery latency with
+        quint64 queueTime = usecTimestampNow();
+        if (packetPayloadSize >= (int) sizeof(queueTime)) {
+            memcpy(newPacket->getPayload(), &queueTime, sizeof(queueTime));
+        }
+        
         _totalQueuedBytes += newPacket->getDataSize();
         
         // queue or send this packet by calling write packet on the socket for our target
-        if (_sendReliable) {
-            _socket.writePacket(std::move(newPacket), _target);
+        if (isReliable) {
+            socket.writePacket(std::move(newPacket), _target);
         } else {
-            _socket.writePacket(*newPacket, _target);
+            socket.writePacket(*newPacket, _target);
         }
         
         ++_totalQueuedPackets;
+        ++_sendKindCounts[kind];
     }
     
+    return true;
+}
+
+void UDTTest::sendMessage(udt::Socket& socket, int numPackets) {
+    static int packetSize = udt::Packet::maxPayloadSize(true);
+    
+    // construct a reliable and ordered packet list
+    auto packetList = udt::PacketList::create(PacketType::BulkAvatarData, QByteArray(), true, true);
+    
+    // the message leads with the seed of its own random data, so that the receiver can verify messages in any order
+    uint64_t messageSeed = _distribution(_generator);
+    std::mt19937 messageGenerator((std::mt19937::result_type) messageSeed);
+    
+    // fill the packet list with random data according to the seed
+    for (int i = 0; i < numPackets; ++i) {
+        // setup a QByteArray full of zeros for our random padded data
+        QByteArray randomPaddedData { packetSize, 0 };
+        
+        // generate a random integer for the first 8 bytes of the random data
+        uint64_t randomInt = (i == 0) ? messageSeed : _distribution(messageGenerator);
+        randomPaddedData.replace(0, sizeof(randomInt), reinterpret_cast<char*>(&randomInt), sizeof(randomInt));
+        
+        // write this data to the PacketList
+        packetList->write(randomPaddedData);
+    }
+    
+    packetList->closeCurrentPacket();
+    
+    _totalQueuedBytes += (int)packetList->getDataSize();
+    _totalQueuedPackets += (int)packetList->getNumPackets();
+    
+    socket.writePacketList(std::move(packetList), _target);
 }
 
 void UDTTest::handleMessage(std::unique_ptr<Message> message) {
-    // generate the byte array that should match this message - using the same seed the sender did
+    // generate the byte array that should match this message - using the seed the message leads with
     
     int packetSize = udt::Packet::maxPayloadSize(true);
     int messageSize = message->data.size();
     
+    if (messageSize < (int) sizeof(uint64_t)) {
+        ++_numMessagesMismatched;
+        return;
+    }
+    
+    uint64_t messageSeed;
+    memcpy(&messageSeed, message->data.constData(), sizeof(messageSeed));
+    std::mt19937 messageGenerator((std::mt19937::result_type) messageSeed);
+    
     QByteArray messageData(messageSize, 0);
    
     for (int i = 0; i < messageSize; i += packetSize) {
         // generate the random 64-bit unsigned integer that should lead this packet
-        uint64_t randomInt = _distribution(_generator);
+        uint64_t randomInt = (i == 0) ? messageSeed : _distribution(messageGenerator);
         
         messageData.replace(i, sizeof(randomInt), reinterpret_cast<char*>(&randomInt), sizeof(randomInt));
     }
@@ -358,6 +533,101 @@ void UDTTest::handleMessage(std::unique_ptr<Message> message) {
     if (!dataMatch) {
         qCritical() << "UDTTest::handleMessage" << "received message did not match expected message"
             << "(from seeded random number generation).";
+        ++_numMessagesMismatched;
+    } else {
+        ++_numMessagesVerified;
+    }
+}
+
+void UDTTest::handlePacket(std::unique_ptr<udt::Packet> packet) {
+    quint64 queueTime;
+    if (packet->getPayloadSize() < (qint64) sizeof(queueTime)) {
+        return;
+    }
+    
+    memcpy(&queueTime, packet->getPayload(), sizeof(queueTime));
+    
+    // the sender's clock is only ours when it runs on the same host, anything from the future is from another clock
+    quint64 now = usecTimestampNow();
+    if (queueTime <= now) {
+        recordLatency(now - queueTime);
+    }
+}
+
+void UDTTest::recordLatency(quint64 latency) {
+    ++_numLatencyPackets;
+    
+    quint32 sample = (quint32) std::min(latency, (quint64) UINT32_MAX);
+    if (_latencySamples.size() < MAX_LATENCY_SAMPLES) {
+        _latencySamples.push_back(sample);
+    } else {
+        // reservoir sampling, every packet has the same chance of being among the samples
+        std::uniform_int_distribution<qint64> slotDistribution(0, _numLatencyPackets - 1);
+        qint64 slot = slotDistribution(_linkGenerator);
+        if (slot < MAX_LATENCY_SAMPLES) {
+            _latencySamples[slot] = sample;
+        }
+    }
+}
+
+void UDTTest::emulateLink(udt::Socket& socket) {
+    disconnect(&socket._udpSocket, &QUdpSocket::readyRead, &socket, &udt::Socket::readPendingDatagrams);
+    
+    udt::Socket* receivingSocket = &socket;
+    connect(&socket._udpSocket, &QUdpSocket::readyRead, this, [this, receivingSocket] {
+        readEmulatedDatagrams(*receivingSocket);
+    });
+}
+
+void UDTTest::readEmulatedDatagrams(udt::Socket& socket) {
+    auto latency = std::chrono::milliseconds(_latencyMsecs);
+    
+    qint64 packetSizeWithHeader = -1;
+    while ((packetSizeWithHeader = socket._udpSocket.pendingDatagramSize()) != -1) {
+        HifiSockAddr senderSockAddr;
+        auto buffer = udt::PacketBufferPool::allocate(packetSizeWithHeader);
+        
+        auto sizeRead = socket._udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
+                                                       senderSockAddr.getAddressPointer(),
+                                                       senderSockAddr.getPortPointer());
+        auto receiveTime = p_high_resolution_clock::now();
+        
+        if (sizeRead <= 0) {
+            continue;
+        }
+        
+        if (_lossPercent > 0.0f && _lossDistribution(_linkGenerator) < _lossPercent) {
+            ++_numEmulatedDrops;
+            continue;
+        }
+        
+        if (_latencyMsecs == 0) {
+            socket.processDatagram(std::move(buffer), sizeRead, senderSockAddr, receiveTime);
+        } else {
+            // every datagram is held for as long, so they come due in the order they arrived
+            HeldDatagram held { &socket, std::move(buffer), sizeRead, senderSockAddr, receiveTime + latency };
+            _heldDatagrams.push_back(std::move(held));
+        }
+    }
+    
+    if (!_heldDatagrams.empty() && !_releaseTimer.isActive()) {
+        releaseHeldDatagrams();
+    }
+}
+
+void UDTTest::releaseHeldDatagrams() {
+    auto now = p_high_resolution_clock::now();
+    
+    while (!_heldDatagrams.empty() && _heldDatagrams.front().releaseTime <= now) {
+        auto& held = _heldDatagrams.front();
+        held.socket->processDatagram(std::move(held.buffer), held.size, held.senderSockAddr, now);
+        _heldDatagrams.pop_front();
+    }
+    
+    if (!_heldDatagrams.empty()) {
+        // rounded up, a timer that fires early would only spin until the datagram is due
+        auto wait = std::chrono::duration_cast<std::chrono::microseconds>(_heldDatagrams.front().releaseTime - now);
+        _releaseTimer.start((int) ((wait.count() + USECS_PER_MSEC - 1) / USECS_PER_MSEC));
     }
 }
 
@@ -376,7 +646,33 @@ void UDTTest::sampleStats() {
             first = false;
         }
         
-        udt::ConnectionStats::Stats stats = _socket.sampleStatsForConnection(_target);
+        auto allStats = _socket.sampleStatsForAllConnections();
+        for (auto& socket : _extraSockets) {
+            auto socketStats = socket->sampleStatsForAllConnections();
+            allStats.insert(allStats.end(), socketStats.begin(), socketStats.end());
+        }
+        
+        for (const auto& connectionStats : allStats) {
+            const auto& stats = connectionStats.second;
+            _totalBytes += stats.sentBytes + stats.sentUnreliableBytes;
+            _totalUtilBytes += stats.sentUtilBytes + stats.sentUnreliableUtilBytes;
+            _totalPackets += stats.sentPackets + stats.sentUnreliablePackets;
+            _totalRetransmits += stats.events[udt::ConnectionStats::Stats::Retransmission];
+            _totalNAKs += stats.events[udt::ConnectionStats::Stats::ReceivedNAK]
+                + stats.events[udt::ConnectionStats::Stats::ReceivedTimeoutNAK];
+            if (stats.rtt > 0) {
+                _rttSamples.push_back(stats.rtt);
+            }
+        }
+        
+        // the table is for the connection of the first socket
+        udt::ConnectionStats::Stats stats;
+        for (const auto& connectionStats : allStats) {
+            if (connectionStats.first == _target) {
+                stats = connectionStats.second;
+                break;
+            }
+        }
         
         int headerIndex = -1;
         
@@ -406,9 +702,34 @@ void UDTTest::sampleStats() {
             first = false;
         }
         
-        auto sockets = _socket.getConnectionSockAddrs();
-        if (sockets.size() > 0) {
-            udt::ConnectionStats::Stats stats = _socket.sampleStatsForConnection(sockets.front());
+        auto allStats = _socket.sampleStatsForAllConnections();
+        
+        for (const auto& connectionStats : allStats) {
+            const auto& stats = connectionStats.second;
+            _totalBytes += stats.receivedBytes + stats.receivedUnreliableBytes;
+            _totalUtilBytes += stats.receivedUtilBytes + stats.receivedUnreliableUtilBytes;
+            _totalPackets += stats.receivedPackets + stats.receivedUnreliablePackets;
+            _totalDuplicates += stats.events[udt::ConnectionStats::Stats::Duplicate];
+            _totalNAKs += stats.events[udt::ConnectionStats::Stats::SentNAK]
+                + stats.events[udt::ConnectionStats::Stats::SentTimeoutNAK];
+            if (stats.rtt > 0) {
+                _rttSamples.push_back(stats.rtt);
+            }
+        }
+        
+        if (!_runTimer.isValid() && _totalBytes > 0) {
+            // a receiver's run starts with the first data it gets
+            _runTimer.start();
+            _runStartCPU = std::clock();
+            
+            if (_argumentParser.isSet(DURATION)) {
+                QTimer::singleShot(_argumentParser.value(DURATION).toInt() * (int) MSECS_PER_SECOND, this, &UDTTest::finish);
+            }
+        }
+        
+        if (allStats.size() > 0) {
+            // the table is for the first connection, the totals are for all of them
+            const auto& stats = allStats.front().second;
             
             int headerIndex = -1;
             
@@ -434,3 +755,90 @@ void UDTTest::sampleStats() {
         }
     }
 }
+
+void UDTTest::finish() {
+    // the last part of an interval
+    sampleStats();
+    
+    writeResults();
+    quit();
+}
+
+void UDTTest::writeResults() {
+    double seconds = std::max(_runTimer.isValid() ? _runTimer.elapsed() / (double) MSECS_PER_SECOND : 0.0, 1e-6);
+    double cpuSeconds = (std::clock() - _runStartCPU) / (double) CLOCKS_PER_SEC;
+    double gigabits = _totalBytes * BITS_IN_BYTE / 1.0e9;
+    
+    auto percentiles = [](std::vector<quint32> samples) {
+        QJsonObject result;
+        if (samples.empty()) {
+            return result;
+        }
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&](float fraction) {
+            int index = std::min((int) (fraction * samples.size()), (int) samples.size() - 1);
+            return samples[index] / (double) USECS_PER_MSEC;
+        };
+        result["p50"] = percentile(0.50f);
+        result["p99"] = percentile(0.99f);
+        result["max"] = samples.back() / (double) USECS_PER_MSEC;
+        result["samples"] = (int) samples.size();
+        return result;
+    };
+    
+    bool isSender = !_target.isNull();
+    
+    QJsonObject results;
+    results["role"] = isSender ? "sender" : "receiver";
+    results["seconds"] = seconds;
+    results["congestionControl"] = _argumentParser.isSet(BBR_CONGESTION_CONTROL) ? "bbr" : "udt";
+    results["connections"] = isSender ? (int) _extraSockets.size() + 1 : (int) _socket.getConnectionSockAddrs().size();
+    results["emulatedLossPercent"] = _lossPercent;
+    results["emulatedLatencyMs"] = _latencyMsecs;
+    results["emulatedDrops"] = (double) _numEmulatedDrops;
+    
+    results["bytes"] = (double) _totalBytes;
+    results["packets"] = (double) _totalPackets;
+    results["throughputMbps"] = _totalBytes * BITS_IN_BYTE / seconds / 1.0e6;
+    results["goodputMbps"] = _totalUtilBytes * BITS_IN_BYTE / seconds / 1.0e6;
+    results["cpuSeconds"] = cpuSeconds;
+    if (gigabits > 0.0) {
+        results["cpuSecondsPerGbit"] = cpuSeconds / gigabits;
+    }
+    results["naks"] = (double) _totalNAKs;
+    
+    std::vector<quint32> rttSamples(_rttSamples.begin(), _rttSamples.end());
+    results["rttMs"] = percentiles(rttSamples);
+    
+    if (isSender) {
+        results["retransmits"] = (double) _totalRetransmits;
+        
+        QJsonObject sends;
+        sends["reliable"] = (double) _sendKindCounts[Reliable];
+        sends["unreliable"] = (double) _sendKindCounts[Unreliable];
+        sends["ordered"] = (double) _sendKindCounts[Ordered];
+        results["sends"] = sends;
+    } else {
+        results["duplicates"] = (double) _totalDuplicates;
+        results["messagesVerified"] = _numMessagesVerified;
+        results["messagesMismatched"] = _numMessagesMismatched;
+        
+        // from the time the sender queued the packet, against the sender's clock
+        results["deliveryLatencyMs"] = percentiles(_latencySamples);
+    }
+    
+    QByteArray json = QJsonDocument(results).toJson();
+    
+    if (_resultsPath.isEmpty()) {
+        qDebug().noquote() << json;
+        return;
+    }
+    
+    QFile file(_resultsPath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(json);
+        qDebug() << "Wrote the results to" << _resultsPath;
+    } else {
+        qCritical() << "Could not write the results to" << _resultsPath;
+    }
+}
@@ -15,10 +15,15 @@
 #define hifi_UDTTest_h
 
 
+#include <ctime>
+#include <deque>
 #include <random>
+#include <vector>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
 
 #include <udt/Constants.h>
 #include <udt/Socket.h>
@@ -36,41 +41,98 @@ public:
     UDTTest(int& argc, char** argv);
 
 public slots:
-    void refillPacket() { sendPacket(); } // adds a new packet to the queue when we are told one is sent
     void sampleStats();
-    
+    void finish(); // reports the results of a timed run and quits
+
 private:
+    enum SendKind { Reliable, Unreliable, Ordered, NumSendKinds };
+
+    // a received datagram held back to emulate the latency of a longer link
+    struct HeldDatagram {
+        udt::Socket* socket;
+        udt::PacketBuffer buffer;
+        qint64 size;
+        HifiSockAddr senderSockAddr;
+        p_high_resolution_clock::time_point releaseTime;
+    };
+
     void parseArguments();
+    void setupSocket(udt::Socket& socket);
     void handleMessage(std::unique_ptr<Message> message);
-    
-    void sendInitialPackets(); // fills the queue with packets to start
-    void sendPacket(); // constructs and sends a packet according to the test parameters
-    
+    void handlePacket(std::unique_ptr<udt::Packet> packet);
+
+    void sendInitialPackets(udt::Socket& socket); // fills the queue with packets to start
+    void sendPacket(udt::Socket& socket); // constructs and sends a packet according to the test parameters
+    bool sendPacket(udt::Socket& socket, SendKind kind); // false once the max has been sent
+    void sendMessage(udt::Socket& socket, int numPackets);
+    SendKind nextSendKind();
+
+    // takes the reads of the socket from it, to drop and delay datagrams before the socket sees them
+    void emulateLink(udt::Socket& socket);
+    void readEmulatedDatagrams(udt::Socket& socket);
+    void releaseHeldDatagrams();
+
+    void recordLatency(quint64 latency);
+    void writeResults();
+
     QCommandLineParser _argumentParser;
     udt::Socket _socket;
-    
+
+    // the sockets of a sender beyond the first, each its own connection to the target
+    std::vector<std::unique_ptr<udt::Socket>> _extraSockets;
+
     HifiSockAddr _target; // the target for sent packets
-    
+
     int _minPacketSize { udt::MAX_PACKET_SIZE };
     int _maxPacketSize { udt::MAX_PACKET_SIZE };
     int _maxSendBytes { -1 }; // the number of bytes to send to the target before stopping
     int _maxSendPackets { -1 }; // the number of packets to send to the target before stopping
-    
+
     bool _sendReliable { true }; // whether packets are sent reliably or unreliably
     bool _sendOrdered { false }; // whether to send ordered packets
-    
+
     int _messageSize { 10000000 }; // number of bytes per message while sending ordered
 
+    // the weights of the kinds of send for a mix, none at all when not sending a mix
+    std::vector<int> _sendMix;
+    std::discrete_distribution<int> _sendKindDistribution;
+    std::vector<qint64> _sendKindCounts { std::vector<qint64>(NumSendKinds, 0) };
+
     std::unordered_map<udt::Packet::MessageNumber, std::unique_ptr<Message>> _pendingMessages;
-    
+
     std::random_device _randomDevice;
     std::mt19937 _generator { _randomDevice() }; // random number generator for ordered data testing
     std::uniform_int_distribution<uint64_t> _distribution { 1, UINT64_MAX }; // producer of random integer values
-    
+    int _numMessagesVerified { 0 };
+    int _numMessagesMismatched { 0 };
+
     int _totalQueuedPackets { 0 }; // keeps track of the number of packets we have already queued
     int _totalQueuedBytes { 0 }; // keeps track of the number of bytes we have already queued
-    
+
     int _statsInterval { 100 }; // recording interval for stats in milliseconds
+
+    // link emulation for the datagrams this side receives
+    float _lossPercent { 0.0f };
+    int _latencyMsecs { 0 };
+    std::mt19937 _linkGenerator { _randomDevice() };
+    std::uniform_real_distribution<float> _lossDistribution { 0.0f, 100.0f };
+    std::deque<HeldDatagram> _heldDatagrams;
+    QTimer _releaseTimer;
+    qint64 _numEmulatedDrops { 0 };
+
+    // the totals of a run, over all of its connections
+    QString _resultsPath;
+    QElapsedTimer _runTimer;
+    std::clock_t _runStartCPU { 0 };
+    qint64 _totalBytes { 0 };
+    qint64 _totalUtilBytes { 0 };
+    qint64 _totalPackets { 0 };
+    qint64 _totalRetransmits { 0 };
+    qint64 _totalDuplicates { 0 };
+    qint64 _totalNAKs { 0 };
+    std::vector<int> _rttSamples; // usecs, one per connection for each stats interval
+    std::vector<quint32> _latencySamples; // usecs, a uniform sample of the packets received
+    qint64 _numLatencyPackets { 0 };
 };
 
 #endif // hifi_UDTTest_h
@@ -11,10 +11,24 @@
 
 #include "VHACDUtil.h"
 
+#include <algorithm>
+#include <numeric>
 #include <unordered_map>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThreadPool>
 #include <QVector>
 
 #include <NumericalConstants.h>
+#include <ParallelFor.h>
+
+// the hulls of a mesh are cached by the hash of the mesh and the settings, the version goes into the hash
+static const qint32 HULL_CACHE_VERSION = 1;
+static const QString HULL_CACHE_EXTENSION = ".hulls";
 
 
 // FBXReader jumbles the order of the meshes by reading them back out of a hashtable.  This will put
@@ -304,135 +318,192 @@ bool vhacd::VHACDUtil::computeVHACD(FBXGeometry& geometry,
         qDebug() << "total parts =" << numParts;
     }
 
-    VHACD::IVHACD * convexifier = VHACD::CreateVHACD();
+    // the progress of V-HACD itself can't be shown for several meshes at once
+    QThreadPool pool;
+    pool.setMaxThreadCount(_numThreads);
+    if (_numThreads > 1) {
+        params.m_callback = nullptr;
+    }
+
+    // everything that changes the hulls of a mesh other than the mesh itself
+    QByteArray settingsKey;
+    {
+        QDataStream stream(&settingsKey, QIODevice::WriteOnly);
+        stream << HULL_CACHE_VERSION << params.m_resolution << params.m_depth << params.m_concavity
+            << params.m_planeDownsampling << params.m_convexhullDownsampling << params.m_alpha << params.m_beta
+            << params.m_gamma << params.m_delta << params.m_pca << params.m_mode << params.m_maxNumVerticesPerCH
+            << params.m_minVolumePerCH << params.m_convexhullApproximation << minimumMeshSize << maximumMeshSize;
+    }
 
+    // The meshes are decomposed independently, each by a job of its own, the largest first so that one of them isn't
+    // left running on its own at the end
+    const int numMeshes = geometry.meshes.size();
+    std::vector<int> meshOrder(numMeshes);
+    std::iota(meshOrder.begin(), meshOrder.end(), 0);
+    std::stable_sort(meshOrder.begin(), meshOrder.end(), [&](int a, int b) {
+        return geometry.meshes[a].vertices.size() > geometry.meshes[b].vertices.size();
+    });
+
+    std::vector<FBXMesh> meshHulls(numMeshes);
+    std::vector<int> validPartsFound(numMeshes, 0);
+    QMutex progressMutex;
+    int numMeshesDone = 0;
+    int numMeshesCached = 0;
+    parallelFor(numMeshes, [&](int i) {
+        int meshIndex = meshOrder[i];
+        bool wasCached = false;
+        validPartsFound[meshIndex] = computeMeshHulls(geometry, meshIndex, params, settingsKey,
+            minimumMeshSize, maximumMeshSize, meshHulls[meshIndex], wasCached);
+
+        QMutexLocker lock(&progressMutex);
+        ++numMeshesDone;
+        if (wasCached) {
+            ++numMeshesCached;
+        }
+        std::cout << "\rdecomposed " << numMeshesDone << "/" << numMeshes << " meshes ("
+            << numMeshesCached << " from cache)" << std::flush;
+        if (numMeshesDone == numMeshes) {
+            std::cout << std::endl;
+        }
+    }, &pool);
+
+    // the hulls go out in the order of the meshes
     result.meshExtents.reset();
     result.meshes.append(FBXMesh());
     FBXMesh &resultMesh = result.meshes.last();
+    int totalValidPartsFound = 0;
+    for (int meshIndex = 0; meshIndex < numMeshes; ++meshIndex) {
+        const FBXMesh& hulls = meshHulls[meshIndex];
+        int hullIndexStart = resultMesh.vertices.size();
+        resultMesh.vertices += hulls.vertices;
+        foreach (FBXMeshPart hull, hulls.parts) {
+            for (auto& index : hull.triangleIndices) {
+                index += hullIndexStart;
+            }
+            resultMesh.parts.append(hull);
+        }
+        totalValidPartsFound += validPartsFound[meshIndex];
+    }
+
+    return totalValidPartsFound > 0;
+}
 
+int vhacd::VHACDUtil::computeMeshHulls(const FBXGeometry& geometry, int meshIndex,
+                                       const VHACD::IVHACD::Parameters& params, const QByteArray& settingsKey,
+                                       float minimumMeshSize, float maximumMeshSize,
+                                       FBXMesh& hulls, bool& wasCached) const {
     const uint32_t POINT_STRIDE = 3;
     const uint32_t TRIANGLE_STRIDE = 3;
 
-    int meshIndex = 0;
-    int validPartsFound = 0;
-    foreach (const FBXMesh& mesh, geometry.meshes) {
+    const FBXMesh& mesh = geometry.meshes[meshIndex];
 
-        // find duplicate points
-        int numDupes = 0;
-        std::vector<int> dupeIndexMap;
-        dupeIndexMap.reserve(mesh.vertices.size());
-        for (int i = 0; i < mesh.vertices.size(); ++i) {
-            dupeIndexMap.push_back(i);
-            for (int j = 0; j < i; ++j) {
-                float distance = glm::distance2(mesh.vertices[i], mesh.vertices[j]);
-                const float MAX_DUPE_DISTANCE_SQUARED = 0.000001f;
-                if (distance < MAX_DUPE_DISTANCE_SQUARED) {
-                    dupeIndexMap[i] = j;
-                    ++numDupes;
-                    break;
-                }
-            }
-        }
+    // each mesh has its own transform to move it to model-space
+    std::vector<glm::vec3> vertices;
+    glm::mat4 totalTransform = geometry.offset * mesh.modelTransform;
+    foreach (glm::vec3 vertex, mesh.vertices) {
+        vertices.push_back(glm::vec3(totalTransform * glm::vec4(vertex, 1.0f)));
+    }
+    uint32_t numVertices = (uint32_t)vertices.size();
 
-        // each mesh has its own transform to move it to model-space
-        std::vector<glm::vec3> vertices;
-        glm::mat4 totalTransform = geometry.offset * mesh.modelTransform;
-        foreach (glm::vec3 vertex, mesh.vertices) {
-            vertices.push_back(glm::vec3(totalTransform * glm::vec4(vertex, 1.0f)));
-        }
-        uint32_t numVertices = (uint32_t)vertices.size();
+    std::vector<std::vector<int>> partTriangleIndices(mesh.parts.size());
+    for (int partIndex = 0; partIndex < mesh.parts.size(); ++partIndex) {
+        getTrianglesInMeshPart(mesh.parts[partIndex], partTriangleIndices[partIndex]);
+    }
 
-        if (_verbose) {
-            qDebug() << "mesh" << meshIndex << ": "
-                << " parts =" << mesh.parts.size() << " clusters =" << mesh.clusters.size()
-                << " vertices =" << numVertices;
+    // the hulls of a mesh only change with its triangles where they are in the model, or with the settings
+    QString cachePath;
+    if (!_cacheDirectory.isEmpty()) {
+        QCryptographicHash hash(QCryptographicHash::Md5);
+        hash.addData(settingsKey);
+        hash.addData((const char*)vertices.data(), (int)(vertices.size() * sizeof(glm::vec3)));
+        for (const auto& triangleIndices : partTriangleIndices) {
+            int numIndices = (int)triangleIndices.size();
+            hash.addData((const char*)&numIndices, sizeof(numIndices));
+            hash.addData((const char*)triangleIndices.data(), (int)(triangleIndices.size() * sizeof(int)));
         }
-        ++meshIndex;
+        cachePath = QDir(_cacheDirectory).absoluteFilePath(hash.result().toHex() + HULL_CACHE_EXTENSION);
 
-        std::vector<int> openParts;
-
-        int partIndex = 0;
-        std::vector<int> triangleIndices;
-        foreach (const FBXMeshPart &meshPart, mesh.parts) {
-            triangleIndices.clear();
-            getTrianglesInMeshPart(meshPart, triangleIndices);
-
-            // only process meshes with triangles
-            if (triangleIndices.size() <= 0) {
-                if (_verbose) {
-                    qDebug() << "  skip part" << partIndex << "(zero triangles)";
-                }
-                ++partIndex;
-                continue;
+        int validPartsFound = 0;
+        if (readCachedHulls(cachePath, hulls, validPartsFound)) {
+            if (_verbose) {
+                qDebug() << "mesh" << meshIndex << ": hulls =" << hulls.parts.size() << "(cached)";
             }
+            wasCached = true;
+            return validPartsFound;
+        }
+    }
 
-            // collapse dupe indices
-            for (auto& index : triangleIndices) {
-                index = dupeIndexMap[index];
+    // find duplicate points
+    int numDupes = 0;
+    std::vector<int> dupeIndexMap;
+    dupeIndexMap.reserve(mesh.vertices.size());
+    for (int i = 0; i < mesh.vertices.size(); ++i) {
+        dupeIndexMap.push_back(i);
+        for (int j = 0; j < i; ++j) {
+            float distance = glm::distance2(mesh.vertices[i], mesh.vertices[j]);
+            const float MAX_DUPE_DISTANCE_SQUARED = 0.000001f;
+            if (distance < MAX_DUPE_DISTANCE_SQUARED) {
+                dupeIndexMap[i] = j;
+                ++numDupes;
+                break;
             }
+        }
+    }
 
-            AABox aaBox = getAABoxForMeshPart(mesh, meshPart);
-            const float largestDimension = aaBox.getLargestDimension();
+    if (_verbose) {
+        qDebug() << "mesh" << meshIndex << ": "
+            << " parts =" << mesh.parts.size() << " clusters =" << mesh.clusters.size()
+            << " vertices =" << numVertices;
+    }
 
-            if (largestDimension < minimumMeshSize) {
-                if (_verbose) {
-                    qDebug() << "  skip part" << partIndex << ":  dimension =" << largestDimension << "(too small)";
-                }
-                ++partIndex;
-                continue;
-            }
+    // each job has a decomposer of its own, they hold the state of their computation
+    VHACD::IVHACD * convexifier = VHACD::CreateVHACD();
 
-            if (maximumMeshSize > 0.0f && largestDimension > maximumMeshSize) {
-                if (_verbose) {
-                    qDebug() << "  skip part" << partIndex << ":  dimension =" << largestDimension << "(too large)";
-                }
-                ++partIndex;
-                continue;
-            }
+    std::vector<int> openParts;
 
-            // figure out if the mesh is a closed manifold or not
-            bool closed = isClosedManifold(triangleIndices);
-            if (closed) {
-                uint32_t triangleCount = (uint32_t)(triangleIndices.size()) / TRIANGLE_STRIDE;
-                if (_verbose) {
-                    qDebug() << "  process closed part" << partIndex << ": " << " triangles =" << triangleCount;
-                }
-
-                // compute approximate convex decomposition
-                bool success = convexifier->Compute(&vertices[0].x, POINT_STRIDE, numVertices,
-                        &triangleIndices[0], TRIANGLE_STRIDE, triangleCount, params);
-                if (success) {
-                    getConvexResults(convexifier, resultMesh);
-                } else if (_verbose) {
-                    qDebug() << "  failed to convexify";
-                }
-            } else {
-                if (_verbose) {
-                    qDebug() << "  postpone open part" << partIndex;
-                }
-                openParts.push_back(partIndex);
+    int validPartsFound = 0;
+    for (int partIndex = 0; partIndex < mesh.parts.size(); ++partIndex) {
+        const FBXMeshPart &meshPart = mesh.parts[partIndex];
+        std::vector<int>& triangleIndices = partTriangleIndices[partIndex];
+
+        // only process meshes with triangles
+        if (triangleIndices.size() <= 0) {
+            if (_verbose) {
+                qDebug() << "  mesh" << meshIndex << "skip part" << partIndex << "(zero triangles)";
             }
-            ++partIndex;
-            ++validPartsFound;
+            continue;
         }
-        if (! openParts.empty()) {
-            // combine open meshes in an attempt to produce a closed mesh
 
-            triangleIndices.clear();
-            for (auto index : openParts) {
-                const FBXMeshPart &meshPart = mesh.parts[index];
-                getTrianglesInMeshPart(meshPart, triangleIndices);
+        // collapse dupe indices
+        for (auto& index : triangleIndices) {
+            index = dupeIndexMap[index];
+        }
+
+        AABox aaBox = getAABoxForMeshPart(mesh, meshPart);
+        const float largestDimension = aaBox.getLargestDimension();
+
+        if (largestDimension < minimumMeshSize) {
+            if (_verbose) {
+                qDebug() << "  mesh" << meshIndex << "skip part" << partIndex << ":  dimension =" << largestDimension
+                    << "(too small)";
             }
+            continue;
+        }
 
-            // collapse dupe indices
-            for (auto& index : triangleIndices) {
-                index = dupeIndexMap[index];
+        if (maximumMeshSize > 0.0f && largestDimension > maximumMeshSize) {
+            if (_verbose) {
+                qDebug() << "  mesh" << meshIndex << "skip part" << partIndex << ":  dimension =" << largestDimension
+                    << "(too large)";
             }
+            continue;
+        }
 
-            // this time we don't care if the parts are closed or not
+        // figure out if the mesh is a closed manifold or not
+        bool closed = isClosedManifold(triangleIndices);
+        if (closed) {
             uint32_t triangleCount = (uint32_t)(triangleIndices.size()) / TRIANGLE_STRIDE;
             if (_verbose) {
-                qDebug() << "  process remaining open parts =" << openParts.size() << ": "
+                qDebug() << "  mesh" << meshIndex << "process closed part" << partIndex << ": "
                     << " triangles =" << triangleCount;
             }
 
@@ -440,10 +511,40 @@ bool vhacd::VHACDUtil::computeVHACD(FBXGeometry& geometry,
             bool success = convexifier->Compute(&vertices[0].x, POINT_STRIDE, numVertices,
                     &triangleIndices[0], TRIANGLE_STRIDE, triangleCount, params);
             if (success) {
-                getConvexResults(convexifier, resultMesh);
+                getConvexResults(convexifier, hulls);
             } else if (_verbose) {
-                qDebug() << "  failed to convexify";
+                qDebug() << "  mesh" << meshIndex << "failed to convexify";
+            }
+        } else {
+            if (_verbose) {
+                qDebug() << "  mesh" << meshIndex << "postpone open part" << partIndex;
             }
+            openParts.push_back(partIndex);
+        }
+        ++validPartsFound;
+    }
+    if (! openParts.empty()) {
+        // combine open meshes in an attempt to produce a closed mesh, their dupe indices are collapsed already
+        std::vector<int> triangleIndices;
+        for (auto index : openParts) {
+            triangleIndices.insert(triangleIndices.end(), partTriangleIndices[index].begin(),
+                partTriangleIndices[index].end());
+        }
+
+        // this time we don't care if the parts are closed or not
+        uint32_t triangleCount = (uint32_t)(triangleIndices.size()) / TRIANGLE_STRIDE;
+        if (_verbose) {
+            qDebug() << "  mesh" << meshIndex << "process remaining open parts =" << openParts.size() << ": "
+                << " triangles =" << triangleCount;
+        }
+
+        // compute approximate convex decomposition
+        bool success = convexifier->Compute(&vertices[0].x, POINT_STRIDE, numVertices,
+                &triangleIndices[0], TRIANGLE_STRIDE, triangleCount, params);
+        if (success) {
+            getConvexResults(convexifier, hulls);
+        } else if (_verbose) {
+            qDebug() << "  mesh" << meshIndex << "failed to convexify";
         }
     }
 
@@ -451,7 +552,62 @@ bool vhacd::VHACDUtil::computeVHACD(FBXGeometry& geometry,
     convexifier->Clean();
     convexifier->Release();
 
-    return validPartsFound > 0;
+    if (!cachePath.isEmpty()) {
+        writeCachedHulls(cachePath, hulls, validPartsFound);
+    }
+    return validPartsFound;
+}
+
+bool vhacd::VHACDUtil::readCachedHulls(const QString& path, FBXMesh& hulls, int& validPartsFound) const {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream stream(&file);
+    qint32 numVertices = 0;
+    qint32 numHulls = 0;
+    stream >> validPartsFound >> numVertices;
+    if (stream.status() != QDataStream::Ok || numVertices < 0) {
+        return false;
+    }
+    hulls.vertices.resize(numVertices);
+    stream.readRawData((char*)hulls.vertices.data(), numVertices * sizeof(glm::vec3));
+    stream >> numHulls;
+    for (qint32 i = 0; i < numHulls && stream.status() == QDataStream::Ok; ++i) {
+        qint32 numIndices = 0;
+        stream >> numIndices;
+        if (numIndices < 0) {
+            return false;
+        }
+        FBXMeshPart hull;
+        hull.triangleIndices.resize(numIndices);
+        stream.readRawData((char*)hull.triangleIndices.data(), numIndices * sizeof(int));
+        hulls.parts.append(hull);
+    }
+    if (stream.status() != QDataStream::Ok || !stream.atEnd()) {
+        hulls = FBXMesh();
+        return false;
+    }
+    return true;
+}
+
+void vhacd::VHACDUtil::writeCachedHulls(const QString& path, const FBXMesh& hulls, int validPartsFound) const {
+    // another run may be writing the same hulls, QSaveFile only replaces the entry once it is complete
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream << (qint32)validPartsFound << (qint32)hulls.vertices.size();
+    stream.writeRawData((const char*)hulls.vertices.constData(), hulls.vertices.size() * sizeof(glm::vec3));
+    stream << (qint32)hulls.parts.size();
+    foreach (const FBXMeshPart& hull, hulls.parts) {
+        stream << (qint32)hull.triangleIndices.size();
+        stream.writeRawData((const char*)hull.triangleIndices.constData(), hull.triangleIndices.size() * sizeof(int));
+    }
+    if (!file.commit()) {
+        qWarning() << "unable to write cached hulls to" << path;
+    }
 }
 
 vhacd::VHACDUtil:: ~VHACDUtil(){
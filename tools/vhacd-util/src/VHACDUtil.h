@@ -27,6 +27,12 @@ namespace vhacd {
     public:
         void setVerbose(bool verbose) { _verbose = verbose; }
 
+        // the number of meshes that are decomposed at once
+        void setNumThreads(int numThreads) { _numThreads = numThreads; }
+
+        // where the hulls of each mesh are kept, so that only the meshes that changed are decomposed again
+        void setCacheDirectory(const QString& cacheDirectory) { _cacheDirectory = cacheDirectory; }
+
         bool loadFBX(const QString filename, FBXGeometry& result);
 
         void fattenMesh(const FBXMesh& mesh, const glm::mat4& gometryOffset, FBXMesh& result) const;
@@ -41,7 +47,17 @@ namespace vhacd {
         ~VHACDUtil();
 
     private:
+        // returns the number of parts of the mesh that were decomposed, the hulls have vertex indices of their own
+        int computeMeshHulls(const FBXGeometry& geometry, int meshIndex, const VHACD::IVHACD::Parameters& params,
+                             const QByteArray& settingsKey, float minimumMeshSize, float maximumMeshSize,
+                             FBXMesh& hulls, bool& wasCached) const;
+
+        bool readCachedHulls(const QString& path, FBXMesh& hulls, int& validPartsFound) const;
+        void writeCachedHulls(const QString& path, const FBXMesh& hulls, int validPartsFound) const;
+
         bool _verbose { false };
+        int _numThreads { 1 };
+        QString _cacheDirectory;
     };
 
     class ProgressCallback : public VHACD::IVHACD::IUserCallback {
@@ -10,6 +10,9 @@
 //
 
 #include <QCommandLineParser>
+#include <QDir>
+#include <QStandardPaths>
+#include <QThread>
 #include <VHACD.h>
 #include "VHACDUtilApp.h"
 #include "VHACDUtil.h"
@@ -180,6 +183,18 @@ VHACDUtilApp::VHACDUtilApp(int argc, char* argv[]) :
     // minVolumePerCH
     // convexhullApproximation
 
+    const QCommandLineOption threadsOption("threads", "number of meshes to decompose at once (default is one per core)",
+                                           "count");
+    parser.addOption(threadsOption);
+
+    const QCommandLineOption cacheOption("cache", "directory the hulls of each mesh are kept in, so that only changed "
+                                         "meshes are decomposed again (default is the user's cache directory)",
+                                         "directory");
+    parser.addOption(cacheOption);
+
+    const QCommandLineOption noCacheOption("no-cache", "decompose every mesh, without reading or writing cached hulls");
+    parser.addOption(noCacheOption);
+
 
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
@@ -284,6 +299,22 @@ VHACDUtilApp::VHACDUtilApp(int argc, char* argv[]) :
         vHacdMaxVerticesPerCH = parser.value(vHacdMaxVerticesPerCHOption).toInt();
     }
 
+    int numThreads = QThread::idealThreadCount();
+    if (parser.isSet(threadsOption)) {
+        numThreads = parser.value(threadsOption).toInt();
+    }
+    vUtil.setNumThreads(std::max(numThreads, 1));
+
+    if (!parser.isSet(noCacheOption)) {
+        QString cacheDirectory = parser.isSet(cacheOption) ? parser.value(cacheOption) :
+            QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).absoluteFilePath("hulls");
+        if (QDir().mkpath(cacheDirectory)) {
+            vUtil.setCacheDirectory(cacheDirectory);
+        } else {
+            qWarning() << "unable to create cache directory" << cacheDirectory << ", hulls are not cached";
+        }
+    }
+
     if (!splitModel && !generateHulls && !fattenFaces) {
         cerr << "\nNothing to do!  Use -g or -f or --split\n\n";
         parser.showHelp();